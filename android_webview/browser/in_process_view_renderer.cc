@@ -16,6 +16,7 @@
 #include "base/logging.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/stringprintf.h"
+#include "base/time/time.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/web_contents.h"
 #include "content/public/common/content_switches.h"
@@ -391,6 +392,7 @@ bool InProcessViewRenderer::InitializeHwDraw() {
 
 void InProcessViewRenderer::DrawGL(AwDrawGLInfo* draw_info) {
   TRACE_EVENT0("android_webview", "InProcessViewRenderer::DrawGL");
+  const base::TimeTicks draw_start = base::TimeTicks::HighResNow();
 
   manager_key_ = g_view_renderer_manager.Get().DidDrawGL(manager_key_, this);
 
@@ -404,8 +406,12 @@ void InProcessViewRenderer::DrawGL(AwDrawGLInfo* draw_info) {
   }
 
   ScopedAppGLStateRestore state_restore(ScopedAppGLStateRestore::MODE_DRAW);
-  if (g_service.Get())
+  if (g_service.Get()) {
+    // GPU work queued by other threads runs here, on the app's render
+    // thread, so account for it separately from compositing.
+    TRACE_EVENT0("android_webview", "RunDeferredGpuTasks");
     g_service.Get()->RunTasks();
+  }
   ScopedAllowGL allow_gl;
 
   if (!attached_to_window_) {
@@ -493,15 +499,23 @@ void InProcessViewRenderer::DrawGL(AwDrawGLInfo* draw_info) {
   }
 
   block_invalidates_ = true;
-  // TODO(joth): Check return value.
-  compositor_->DemandDrawHw(gfx::Size(draw_info->width, draw_info->height),
-                            transform,
-                            viewport_rect,
-                            clip_rect,
-                            state_restore.stencil_enabled());
+  {
+    TRACE_EVENT0("android_webview", "DemandDrawHw");
+    // TODO(joth): Check return value.
+    compositor_->DemandDrawHw(gfx::Size(draw_info->width, draw_info->height),
+                              transform,
+                              viewport_rect,
+                              clip_rect,
+                              state_restore.stencil_enabled());
+  }
   block_invalidates_ = false;
   gl_surface_->ResetBackingFrameBufferObject();
 
+  // Time spent inside the app's draw for this frame, so that traces show how
+  // much of the app's frame budget WebView takes.
+  TRACE_COUNTER1("android_webview", "DrawGLTimeUs",
+                 (base::TimeTicks::HighResNow() - draw_start).InMicroseconds());
+
   EnsureContinuousInvalidation(draw_info, !drew_full_visible_rect);
 }
 
@@ -462,6 +462,9 @@
         'callback_unittest.nc',
         'cancelable_callback_unittest.cc',
         'command_line_unittest.cc',
+        'containers/flat_hash_map_unittest.cc',
+        'containers/flat_map_unittest.cc',
+        'containers/flat_set_unittest.cc',
         'containers/hash_tables_unittest.cc',
         'containers/linked_list_unittest.cc',
         'containers/mru_cache_unittest.cc',
@@ -472,6 +475,7 @@
         'debug/leak_tracker_unittest.cc',
         'debug/proc_maps_linux_unittest.cc',
         'debug/stack_trace_unittest.cc',
+        'debug/trace_event_binary_unittest.cc',
         'debug/trace_event_memory_unittest.cc',
         'debug/trace_event_synthetic_delay_unittest.cc',
         'debug/trace_event_system_stats_monitor_unittest.cc',
@@ -486,10 +490,13 @@
         'files/file_path_unittest.cc',
         'files/file_unittest.cc',
         'files/file_util_proxy_unittest.cc',
+        'files/important_file_commit_coordinator_unittest.cc',
         'files/important_file_writer_unittest.cc',
+        'files/memory_mapped_file_unittest.cc',
         'files/scoped_temp_dir_unittest.cc',
         'gmock_unittest.cc',
         'guid_unittest.cc',
+        'hash_unittest.cc',
         'id_map_unittest.cc',
         'i18n/break_iterator_unittest.cc',
         'i18n/char_iterator_unittest.cc',
@@ -522,6 +529,7 @@
         'md5_unittest.cc',
         'memory/aligned_memory_unittest.cc',
         'memory/discardable_memory_allocator_android_unittest.cc',
+        'memory/discardable_memory_allocator_linux_unittest.cc',
         'memory/discardable_memory_unittest.cc',
         'memory/discardable_memory_provider_unittest.cc',
         'memory/linked_ptr_unittest.cc',
@@ -532,6 +540,7 @@
         'memory/scoped_vector_unittest.cc',
         'memory/shared_memory_unittest.cc',
         'memory/singleton_unittest.cc',
+        'memory/small_object_allocator_unittest.cc',
         'memory/weak_ptr_unittest.cc',
         'memory/weak_ptr_unittest.nc',
         'message_loop/message_loop_proxy_impl_unittest.cc',
@@ -542,6 +551,7 @@
         'message_loop/message_pump_libevent_unittest.cc',
         'metrics/sample_map_unittest.cc',
         'metrics/sample_vector_unittest.cc',
+        'metrics/shared_histogram_allocator_unittest.cc',
         'metrics/bucket_ranges_unittest.cc',
         'metrics/field_trial_unittest.cc',
         'metrics/histogram_base_unittest.cc',
@@ -819,6 +829,38 @@
         }],
       ],  # target_conditions
     },
+    {
+      'target_name': 'base_perftests',
+      'type': '<(gtest_target_type)',
+      'dependencies': [
+        'test_support_base',
+        'test_support_perf',
+        '../testing/gtest.gyp:gtest',
+        '../testing/perf/perf_test.gyp:perf_test',
+        'base',
+      ],
+      'sources': [
+        'callback_perftest.cc',
+        'containers/flat_hash_map_perftest.cc',
+        'containers/flat_map_perftest.cc',
+        'debug/trace_event_perftest.cc',
+        'files/memory_mapped_file_perftest.cc',
+        'hash_perftest.cc',
+        'json/json_reader_perftest.cc',
+        'memory/small_object_allocator_perftest.cc',
+        'message_loop/message_loop_perftest.cc',
+        'metrics/statistics_recorder_perftest.cc',
+        'strings/utf_string_conversions_perftest.cc',
+      ],
+      'conditions': [
+        ['OS=="win"', {
+          'sources!': [
+            # Uses getrusage() to count page faults.
+            'files/memory_mapped_file_perftest.cc',
+          ],
+        }],
+      ],
+    },
     {
       'target_name': 'base_i18n_perftests',
       'type': '<(gtest_target_type)',
@@ -61,6 +61,15 @@ const char kProfilerTiming[]                = "profiler-timing";
 // Value of the --profiler-timing flag that will disable timing information for
 // chrome://profiler.
 const char kProfilerTimingDisabledValue[]   = "0";
+// Value of the --profiler-timing flag that will measure the run time of tasks
+// in thread time rather than wall time, where that is supported. Queueing
+// times are not measured then.
+const char kProfilerTimingThreadValue[]     = "thread";
+
+// Makes chrome://profiler time only one run in N of the tasks posted from each
+// location, making profiling cheaper. The total times are then estimated from
+// the timed runs.
+const char kProfilerSamplingInterval[]      = "profiler-sampling-interval";
 
 #if defined(OS_POSIX)
 // Used for turning on Breakpad crash reporting in a debug environment where
@@ -17,8 +17,10 @@ extern const char kEnableCrashReporter[];
 extern const char kEnableDCHECK[];
 extern const char kFullMemoryCrashReport[];
 extern const char kNoErrorDialogs[];
+extern const char kProfilerSamplingInterval[];
 extern const char kProfilerTiming[];
 extern const char kProfilerTimingDisabledValue[];
+extern const char kProfilerTimingThreadValue[];
 extern const char kTestChildProcess[];
 extern const char kTraceToConsole[];
 extern const char kV[];
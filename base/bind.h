@@ -68,7 +68,12 @@ Bind(Functor functor) {
   typedef internal::BindState<RunnableType, RunType, void()> BindState;
 
 
-  return Callback<typename BindState::UnboundRunType>(
+  typedef Callback<typename BindState::UnboundRunType> CallbackType;
+  if (internal::StoresInline<BindState>::value) {
+    return CallbackType(internal::InlineBindStateTag(),
+        BindState(internal::MakeRunnable(functor)));
+  }
+  return CallbackType(
       new BindState(internal::MakeRunnable(functor)));
 }
 
@@ -114,7 +119,12 @@ Bind(Functor functor, const P1& p1) {
       void(typename internal::CallbackParamTraits<P1>::StorageType)> BindState;
 
 
-  return Callback<typename BindState::UnboundRunType>(
+  typedef Callback<typename BindState::UnboundRunType> CallbackType;
+  if (internal::StoresInline<BindState>::value) {
+    return CallbackType(internal::InlineBindStateTag(),
+        BindState(internal::MakeRunnable(functor), p1));
+  }
+  return CallbackType(
       new BindState(internal::MakeRunnable(functor), p1));
 }
 
@@ -165,7 +175,12 @@ Bind(Functor functor, const P1& p1, const P2& p2) {
       typename internal::CallbackParamTraits<P2>::StorageType)> BindState;
 
 
-  return Callback<typename BindState::UnboundRunType>(
+  typedef Callback<typename BindState::UnboundRunType> CallbackType;
+  if (internal::StoresInline<BindState>::value) {
+    return CallbackType(internal::InlineBindStateTag(),
+        BindState(internal::MakeRunnable(functor), p1, p2));
+  }
+  return CallbackType(
       new BindState(internal::MakeRunnable(functor), p1, p2));
 }
 
@@ -221,7 +236,12 @@ Bind(Functor functor, const P1& p1, const P2& p2, const P3& p3) {
       typename internal::CallbackParamTraits<P3>::StorageType)> BindState;
 
 
-  return Callback<typename BindState::UnboundRunType>(
+  typedef Callback<typename BindState::UnboundRunType> CallbackType;
+  if (internal::StoresInline<BindState>::value) {
+    return CallbackType(internal::InlineBindStateTag(),
+        BindState(internal::MakeRunnable(functor), p1, p2, p3));
+  }
+  return CallbackType(
       new BindState(internal::MakeRunnable(functor), p1, p2, p3));
 }
 
@@ -282,7 +302,12 @@ Bind(Functor functor, const P1& p1, const P2& p2, const P3& p3, const P4& p4) {
       typename internal::CallbackParamTraits<P4>::StorageType)> BindState;
 
 
-  return Callback<typename BindState::UnboundRunType>(
+  typedef Callback<typename BindState::UnboundRunType> CallbackType;
+  if (internal::StoresInline<BindState>::value) {
+    return CallbackType(internal::InlineBindStateTag(),
+        BindState(internal::MakeRunnable(functor), p1, p2, p3, p4));
+  }
+  return CallbackType(
       new BindState(internal::MakeRunnable(functor), p1, p2, p3, p4));
 }
 
@@ -350,7 +375,12 @@ Bind(Functor functor, const P1& p1, const P2& p2, const P3& p3, const P4& p4,
       typename internal::CallbackParamTraits<P5>::StorageType)> BindState;
 
 
-  return Callback<typename BindState::UnboundRunType>(
+  typedef Callback<typename BindState::UnboundRunType> CallbackType;
+  if (internal::StoresInline<BindState>::value) {
+    return CallbackType(internal::InlineBindStateTag(),
+        BindState(internal::MakeRunnable(functor), p1, p2, p3, p4, p5));
+  }
+  return CallbackType(
       new BindState(internal::MakeRunnable(functor), p1, p2, p3, p4, p5));
 }
 
@@ -423,7 +453,12 @@ Bind(Functor functor, const P1& p1, const P2& p2, const P3& p3, const P4& p4,
       typename internal::CallbackParamTraits<P6>::StorageType)> BindState;
 
 
-  return Callback<typename BindState::UnboundRunType>(
+  typedef Callback<typename BindState::UnboundRunType> CallbackType;
+  if (internal::StoresInline<BindState>::value) {
+    return CallbackType(internal::InlineBindStateTag(),
+        BindState(internal::MakeRunnable(functor), p1, p2, p3, p4, p5, p6));
+  }
+  return CallbackType(
       new BindState(internal::MakeRunnable(functor), p1, p2, p3, p4, p5, p6));
 }
 
@@ -501,7 +536,13 @@ Bind(Functor functor, const P1& p1, const P2& p2, const P3& p3, const P4& p4,
       typename internal::CallbackParamTraits<P7>::StorageType)> BindState;
 
 
-  return Callback<typename BindState::UnboundRunType>(
+  typedef Callback<typename BindState::UnboundRunType> CallbackType;
+  if (internal::StoresInline<BindState>::value) {
+    return CallbackType(internal::InlineBindStateTag(),
+        BindState(internal::MakeRunnable(functor), p1, p2, p3, p4, p5, p6,
+            p7));
+  }
+  return CallbackType(
       new BindState(internal::MakeRunnable(functor), p1, p2, p3, p4, p5, p6,
           p7));
 }
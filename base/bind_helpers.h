@@ -143,6 +143,8 @@
 #ifndef BASE_BIND_HELPERS_H_
 #define BASE_BIND_HELPERS_H_
 
+#include <string.h>
+
 #include "base/basictypes.h"
 #include "base/callback.h"
 #include "base/memory/weak_ptr.h"
@@ -433,6 +435,56 @@ struct UnwrapTraits<PassedWrapper<T> > {
   }
 };
 
+// InlineStorageTraits<> whitelists the bound argument types that may be
+// stored in a Callback's inline storage.  An inline bind state is copied,
+// rather than shared, when its Callback is copied, and it is destroyed in
+// place, so this only admits types whose copies are indistinguishable from
+// the original and whose destructors cannot delete the Callback: scalars,
+// enums, raw pointers, and the Unretained(), ConstRef() and WeakPtr<>
+// wrappers.  Equals() compares two bound values for Callback::Equals().
+template <typename T,
+          bool is_scalar = !is_class<T>::value &&
+                           (is_pointer<T>::value ||
+                            is_convertible<T, int>::value)>
+struct InlineStorageTraits {
+  static const bool value = false;
+  static bool Equals(const T& a, const T& b) { return false; }
+};
+
+template <typename T>
+struct InlineStorageTraits<T, true> {
+  static const bool value = true;
+  static bool Equals(const T& a, const T& b) { return a == b; }
+};
+
+template <typename T>
+struct InlineStorageTraits<UnretainedWrapper<T>, false> {
+  static const bool value = true;
+  static bool Equals(const UnretainedWrapper<T>& a,
+                     const UnretainedWrapper<T>& b) {
+    return a.get() == b.get();
+  }
+};
+
+template <typename T>
+struct InlineStorageTraits<ConstRefWrapper<T>, false> {
+  static const bool value = true;
+  static bool Equals(const ConstRefWrapper<T>& a,
+                     const ConstRefWrapper<T>& b) {
+    return &a.get() == &b.get();
+  }
+};
+
+template <typename T>
+struct InlineStorageTraits<WeakPtr<T>, false> {
+  static const bool value = true;
+  // WeakPtr<>::get() may only be called on the WeakPtr's thread, so compare
+  // the flag and pointer it holds directly.
+  static bool Equals(const WeakPtr<T>& a, const WeakPtr<T>& b) {
+    return memcmp(&a, &b, sizeof(WeakPtr<T>)) == 0;
+  }
+};
+
 // Utility for handling different refcounting semantics in the Bind()
 // function.
 template <bool is_method, typename T>
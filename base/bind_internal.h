@@ -10,8 +10,13 @@
 #ifndef BASE_BIND_INTERNAL_H_
 #define BASE_BIND_INTERNAL_H_
 
+#include <string.h>
+
+#include <new>
+
 #include "base/bind_helpers.h"
 #include "base/callback_internal.h"
+#include "base/compiler_specific.h"
 #include "base/memory/raw_scoped_refptr_mismatch_checker.h"
 #include "base/memory/weak_ptr.h"
 #include "base/template_util.h"
@@ -723,6 +728,15 @@ struct FunctionTraits<R(A1, A2, A3, A4, A5, A6, A7)> {
 };
 
 
+// IsRunnableAdapter<>
+//
+// True for the RunnableAdapter<> of a plain function or method pointer.
+template <typename T>
+struct IsRunnableAdapter : false_type {};
+
+template <typename T>
+struct IsRunnableAdapter<RunnableAdapter<T> > : true_type {};
+
 // ForceVoidReturn<>
 //
 // Set of templates that support forcing the function return type to void.
@@ -2537,12 +2551,36 @@ struct BindState<Runnable, RunType, void()> : public BindStateBase {
   typedef false_type IsWeakCall;
   typedef Invoker<0, BindState, RunType> InvokerType;
   typedef typename InvokerType::UnboundRunType UnboundRunType;
+
+  // See StoresInline<>.
+  static const bool kBoundArgsStoreInline = true;
   explicit BindState(const Runnable& runnable)
       : runnable_(runnable) {
   }
 
+  BindState(const BindState& other)
+      : BindStateBase(),
+        runnable_(other.runnable_) {
+  }
+
   virtual ~BindState() {  }
 
+  virtual BindStateBase* CopyTo(void* storage) const OVERRIDE {
+    return ::new (storage) BindState(*this);
+  }
+
+  virtual bool BoundStateEquals(const BindStateBase* other) const OVERRIDE {
+    if (other->TypeId() != TypeId())
+      return false;
+    const BindState* state = static_cast<const BindState*>(other);
+    return memcmp(&runnable_, &state->runnable_, sizeof(runnable_)) == 0;
+  }
+
+  virtual const void* TypeId() const OVERRIDE {
+    static char type_id;
+    return &type_id;
+  }
+
   RunnableType runnable_;
 };
 
@@ -2553,6 +2591,11 @@ struct BindState<Runnable, RunType, void(P1)> : public BindStateBase {
   typedef Invoker<1, BindState, RunType> InvokerType;
   typedef typename InvokerType::UnboundRunType UnboundRunType;
 
+  // See StoresInline<>.
+  static const bool kBoundArgsStoreInline =
+      !(HasIsMethodTag<Runnable>::value && is_pointer<P1>::value) &&
+      InlineStorageTraits<P1>::value;
+
   // Convenience typedefs for bound argument types.
   typedef UnwrapTraits<P1> Bound1UnwrapTraits;
 
@@ -2562,9 +2605,33 @@ struct BindState<Runnable, RunType, void(P1)> : public BindStateBase {
     MaybeRefcount<HasIsMethodTag<Runnable>::value, P1>::AddRef(p1_);
   }
 
+  BindState(const BindState& other)
+      : BindStateBase(),
+        runnable_(other.runnable_),
+        p1_(other.p1_) {
+    MaybeRefcount<HasIsMethodTag<Runnable>::value, P1>::AddRef(p1_);
+  }
+
   virtual ~BindState() {    MaybeRefcount<HasIsMethodTag<Runnable>::value,
       P1>::Release(p1_);  }
 
+  virtual BindStateBase* CopyTo(void* storage) const OVERRIDE {
+    return ::new (storage) BindState(*this);
+  }
+
+  virtual bool BoundStateEquals(const BindStateBase* other) const OVERRIDE {
+    if (other->TypeId() != TypeId())
+      return false;
+    const BindState* state = static_cast<const BindState*>(other);
+    return memcmp(&runnable_, &state->runnable_, sizeof(runnable_)) == 0 &&
+        InlineStorageTraits<P1>::Equals(p1_, state->p1_);
+  }
+
+  virtual const void* TypeId() const OVERRIDE {
+    static char type_id;
+    return &type_id;
+  }
+
   RunnableType runnable_;
   P1 p1_;
 };
@@ -2576,6 +2643,12 @@ struct BindState<Runnable, RunType, void(P1, P2)> : public BindStateBase {
   typedef Invoker<2, BindState, RunType> InvokerType;
   typedef typename InvokerType::UnboundRunType UnboundRunType;
 
+  // See StoresInline<>.
+  static const bool kBoundArgsStoreInline =
+      !(HasIsMethodTag<Runnable>::value && is_pointer<P1>::value) &&
+      InlineStorageTraits<P1>::value &&
+      InlineStorageTraits<P2>::value;
+
   // Convenience typedefs for bound argument types.
   typedef UnwrapTraits<P1> Bound1UnwrapTraits;
   typedef UnwrapTraits<P2> Bound2UnwrapTraits;
@@ -2587,9 +2660,35 @@ struct BindState<Runnable, RunType, void(P1, P2)> : public BindStateBase {
     MaybeRefcount<HasIsMethodTag<Runnable>::value, P1>::AddRef(p1_);
   }
 
+  BindState(const BindState& other)
+      : BindStateBase(),
+        runnable_(other.runnable_),
+        p1_(other.p1_),
+        p2_(other.p2_) {
+    MaybeRefcount<HasIsMethodTag<Runnable>::value, P1>::AddRef(p1_);
+  }
+
   virtual ~BindState() {    MaybeRefcount<HasIsMethodTag<Runnable>::value,
       P1>::Release(p1_);  }
 
+  virtual BindStateBase* CopyTo(void* storage) const OVERRIDE {
+    return ::new (storage) BindState(*this);
+  }
+
+  virtual bool BoundStateEquals(const BindStateBase* other) const OVERRIDE {
+    if (other->TypeId() != TypeId())
+      return false;
+    const BindState* state = static_cast<const BindState*>(other);
+    return memcmp(&runnable_, &state->runnable_, sizeof(runnable_)) == 0 &&
+        InlineStorageTraits<P1>::Equals(p1_, state->p1_) &&
+        InlineStorageTraits<P2>::Equals(p2_, state->p2_);
+  }
+
+  virtual const void* TypeId() const OVERRIDE {
+    static char type_id;
+    return &type_id;
+  }
+
   RunnableType runnable_;
   P1 p1_;
   P2 p2_;
@@ -2603,6 +2702,13 @@ struct BindState<Runnable, RunType, void(P1, P2, P3)> : public BindStateBase {
   typedef Invoker<3, BindState, RunType> InvokerType;
   typedef typename InvokerType::UnboundRunType UnboundRunType;
 
+  // See StoresInline<>.
+  static const bool kBoundArgsStoreInline =
+      !(HasIsMethodTag<Runnable>::value && is_pointer<P1>::value) &&
+      InlineStorageTraits<P1>::value &&
+      InlineStorageTraits<P2>::value &&
+      InlineStorageTraits<P3>::value;
+
   // Convenience typedefs for bound argument types.
   typedef UnwrapTraits<P1> Bound1UnwrapTraits;
   typedef UnwrapTraits<P2> Bound2UnwrapTraits;
@@ -2616,9 +2722,37 @@ struct BindState<Runnable, RunType, void(P1, P2, P3)> : public BindStateBase {
     MaybeRefcount<HasIsMethodTag<Runnable>::value, P1>::AddRef(p1_);
   }
 
+  BindState(const BindState& other)
+      : BindStateBase(),
+        runnable_(other.runnable_),
+        p1_(other.p1_),
+        p2_(other.p2_),
+        p3_(other.p3_) {
+    MaybeRefcount<HasIsMethodTag<Runnable>::value, P1>::AddRef(p1_);
+  }
+
   virtual ~BindState() {    MaybeRefcount<HasIsMethodTag<Runnable>::value,
       P1>::Release(p1_);  }
 
+  virtual BindStateBase* CopyTo(void* storage) const OVERRIDE {
+    return ::new (storage) BindState(*this);
+  }
+
+  virtual bool BoundStateEquals(const BindStateBase* other) const OVERRIDE {
+    if (other->TypeId() != TypeId())
+      return false;
+    const BindState* state = static_cast<const BindState*>(other);
+    return memcmp(&runnable_, &state->runnable_, sizeof(runnable_)) == 0 &&
+        InlineStorageTraits<P1>::Equals(p1_, state->p1_) &&
+        InlineStorageTraits<P2>::Equals(p2_, state->p2_) &&
+        InlineStorageTraits<P3>::Equals(p3_, state->p3_);
+  }
+
+  virtual const void* TypeId() const OVERRIDE {
+    static char type_id;
+    return &type_id;
+  }
+
   RunnableType runnable_;
   P1 p1_;
   P2 p2_;
@@ -2634,6 +2768,14 @@ struct BindState<Runnable, RunType, void(P1, P2, P3,
   typedef Invoker<4, BindState, RunType> InvokerType;
   typedef typename InvokerType::UnboundRunType UnboundRunType;
 
+  // See StoresInline<>.
+  static const bool kBoundArgsStoreInline =
+      !(HasIsMethodTag<Runnable>::value && is_pointer<P1>::value) &&
+      InlineStorageTraits<P1>::value &&
+      InlineStorageTraits<P2>::value &&
+      InlineStorageTraits<P3>::value &&
+      InlineStorageTraits<P4>::value;
+
   // Convenience typedefs for bound argument types.
   typedef UnwrapTraits<P1> Bound1UnwrapTraits;
   typedef UnwrapTraits<P2> Bound2UnwrapTraits;
@@ -2650,9 +2792,39 @@ struct BindState<Runnable, RunType, void(P1, P2, P3,
     MaybeRefcount<HasIsMethodTag<Runnable>::value, P1>::AddRef(p1_);
   }
 
+  BindState(const BindState& other)
+      : BindStateBase(),
+        runnable_(other.runnable_),
+        p1_(other.p1_),
+        p2_(other.p2_),
+        p3_(other.p3_),
+        p4_(other.p4_) {
+    MaybeRefcount<HasIsMethodTag<Runnable>::value, P1>::AddRef(p1_);
+  }
+
   virtual ~BindState() {    MaybeRefcount<HasIsMethodTag<Runnable>::value,
       P1>::Release(p1_);  }
 
+  virtual BindStateBase* CopyTo(void* storage) const OVERRIDE {
+    return ::new (storage) BindState(*this);
+  }
+
+  virtual bool BoundStateEquals(const BindStateBase* other) const OVERRIDE {
+    if (other->TypeId() != TypeId())
+      return false;
+    const BindState* state = static_cast<const BindState*>(other);
+    return memcmp(&runnable_, &state->runnable_, sizeof(runnable_)) == 0 &&
+        InlineStorageTraits<P1>::Equals(p1_, state->p1_) &&
+        InlineStorageTraits<P2>::Equals(p2_, state->p2_) &&
+        InlineStorageTraits<P3>::Equals(p3_, state->p3_) &&
+        InlineStorageTraits<P4>::Equals(p4_, state->p4_);
+  }
+
+  virtual const void* TypeId() const OVERRIDE {
+    static char type_id;
+    return &type_id;
+  }
+
   RunnableType runnable_;
   P1 p1_;
   P2 p2_;
@@ -2669,6 +2841,15 @@ struct BindState<Runnable, RunType, void(P1, P2, P3, P4,
   typedef Invoker<5, BindState, RunType> InvokerType;
   typedef typename InvokerType::UnboundRunType UnboundRunType;
 
+  // See StoresInline<>.
+  static const bool kBoundArgsStoreInline =
+      !(HasIsMethodTag<Runnable>::value && is_pointer<P1>::value) &&
+      InlineStorageTraits<P1>::value &&
+      InlineStorageTraits<P2>::value &&
+      InlineStorageTraits<P3>::value &&
+      InlineStorageTraits<P4>::value &&
+      InlineStorageTraits<P5>::value;
+
   // Convenience typedefs for bound argument types.
   typedef UnwrapTraits<P1> Bound1UnwrapTraits;
   typedef UnwrapTraits<P2> Bound2UnwrapTraits;
@@ -2687,9 +2868,41 @@ struct BindState<Runnable, RunType, void(P1, P2, P3, P4,
     MaybeRefcount<HasIsMethodTag<Runnable>::value, P1>::AddRef(p1_);
   }
 
+  BindState(const BindState& other)
+      : BindStateBase(),
+        runnable_(other.runnable_),
+        p1_(other.p1_),
+        p2_(other.p2_),
+        p3_(other.p3_),
+        p4_(other.p4_),
+        p5_(other.p5_) {
+    MaybeRefcount<HasIsMethodTag<Runnable>::value, P1>::AddRef(p1_);
+  }
+
   virtual ~BindState() {    MaybeRefcount<HasIsMethodTag<Runnable>::value,
       P1>::Release(p1_);  }
 
+  virtual BindStateBase* CopyTo(void* storage) const OVERRIDE {
+    return ::new (storage) BindState(*this);
+  }
+
+  virtual bool BoundStateEquals(const BindStateBase* other) const OVERRIDE {
+    if (other->TypeId() != TypeId())
+      return false;
+    const BindState* state = static_cast<const BindState*>(other);
+    return memcmp(&runnable_, &state->runnable_, sizeof(runnable_)) == 0 &&
+        InlineStorageTraits<P1>::Equals(p1_, state->p1_) &&
+        InlineStorageTraits<P2>::Equals(p2_, state->p2_) &&
+        InlineStorageTraits<P3>::Equals(p3_, state->p3_) &&
+        InlineStorageTraits<P4>::Equals(p4_, state->p4_) &&
+        InlineStorageTraits<P5>::Equals(p5_, state->p5_);
+  }
+
+  virtual const void* TypeId() const OVERRIDE {
+    static char type_id;
+    return &type_id;
+  }
+
   RunnableType runnable_;
   P1 p1_;
   P2 p2_;
@@ -2707,6 +2920,16 @@ struct BindState<Runnable, RunType, void(P1, P2, P3, P4, P5,
   typedef Invoker<6, BindState, RunType> InvokerType;
   typedef typename InvokerType::UnboundRunType UnboundRunType;
 
+  // See StoresInline<>.
+  static const bool kBoundArgsStoreInline =
+      !(HasIsMethodTag<Runnable>::value && is_pointer<P1>::value) &&
+      InlineStorageTraits<P1>::value &&
+      InlineStorageTraits<P2>::value &&
+      InlineStorageTraits<P3>::value &&
+      InlineStorageTraits<P4>::value &&
+      InlineStorageTraits<P5>::value &&
+      InlineStorageTraits<P6>::value;
+
   // Convenience typedefs for bound argument types.
   typedef UnwrapTraits<P1> Bound1UnwrapTraits;
   typedef UnwrapTraits<P2> Bound2UnwrapTraits;
@@ -2727,9 +2950,43 @@ struct BindState<Runnable, RunType, void(P1, P2, P3, P4, P5,
     MaybeRefcount<HasIsMethodTag<Runnable>::value, P1>::AddRef(p1_);
   }
 
+  BindState(const BindState& other)
+      : BindStateBase(),
+        runnable_(other.runnable_),
+        p1_(other.p1_),
+        p2_(other.p2_),
+        p3_(other.p3_),
+        p4_(other.p4_),
+        p5_(other.p5_),
+        p6_(other.p6_) {
+    MaybeRefcount<HasIsMethodTag<Runnable>::value, P1>::AddRef(p1_);
+  }
+
   virtual ~BindState() {    MaybeRefcount<HasIsMethodTag<Runnable>::value,
       P1>::Release(p1_);  }
 
+  virtual BindStateBase* CopyTo(void* storage) const OVERRIDE {
+    return ::new (storage) BindState(*this);
+  }
+
+  virtual bool BoundStateEquals(const BindStateBase* other) const OVERRIDE {
+    if (other->TypeId() != TypeId())
+      return false;
+    const BindState* state = static_cast<const BindState*>(other);
+    return memcmp(&runnable_, &state->runnable_, sizeof(runnable_)) == 0 &&
+        InlineStorageTraits<P1>::Equals(p1_, state->p1_) &&
+        InlineStorageTraits<P2>::Equals(p2_, state->p2_) &&
+        InlineStorageTraits<P3>::Equals(p3_, state->p3_) &&
+        InlineStorageTraits<P4>::Equals(p4_, state->p4_) &&
+        InlineStorageTraits<P5>::Equals(p5_, state->p5_) &&
+        InlineStorageTraits<P6>::Equals(p6_, state->p6_);
+  }
+
+  virtual const void* TypeId() const OVERRIDE {
+    static char type_id;
+    return &type_id;
+  }
+
   RunnableType runnable_;
   P1 p1_;
   P2 p2_;
@@ -2748,6 +3005,17 @@ struct BindState<Runnable, RunType, void(P1, P2, P3, P4, P5, P6,
   typedef Invoker<7, BindState, RunType> InvokerType;
   typedef typename InvokerType::UnboundRunType UnboundRunType;
 
+  // See StoresInline<>.
+  static const bool kBoundArgsStoreInline =
+      !(HasIsMethodTag<Runnable>::value && is_pointer<P1>::value) &&
+      InlineStorageTraits<P1>::value &&
+      InlineStorageTraits<P2>::value &&
+      InlineStorageTraits<P3>::value &&
+      InlineStorageTraits<P4>::value &&
+      InlineStorageTraits<P5>::value &&
+      InlineStorageTraits<P6>::value &&
+      InlineStorageTraits<P7>::value;
+
   // Convenience typedefs for bound argument types.
   typedef UnwrapTraits<P1> Bound1UnwrapTraits;
   typedef UnwrapTraits<P2> Bound2UnwrapTraits;
@@ -2770,9 +3038,45 @@ struct BindState<Runnable, RunType, void(P1, P2, P3, P4, P5, P6,
     MaybeRefcount<HasIsMethodTag<Runnable>::value, P1>::AddRef(p1_);
   }
 
+  BindState(const BindState& other)
+      : BindStateBase(),
+        runnable_(other.runnable_),
+        p1_(other.p1_),
+        p2_(other.p2_),
+        p3_(other.p3_),
+        p4_(other.p4_),
+        p5_(other.p5_),
+        p6_(other.p6_),
+        p7_(other.p7_) {
+    MaybeRefcount<HasIsMethodTag<Runnable>::value, P1>::AddRef(p1_);
+  }
+
   virtual ~BindState() {    MaybeRefcount<HasIsMethodTag<Runnable>::value,
       P1>::Release(p1_);  }
 
+  virtual BindStateBase* CopyTo(void* storage) const OVERRIDE {
+    return ::new (storage) BindState(*this);
+  }
+
+  virtual bool BoundStateEquals(const BindStateBase* other) const OVERRIDE {
+    if (other->TypeId() != TypeId())
+      return false;
+    const BindState* state = static_cast<const BindState*>(other);
+    return memcmp(&runnable_, &state->runnable_, sizeof(runnable_)) == 0 &&
+        InlineStorageTraits<P1>::Equals(p1_, state->p1_) &&
+        InlineStorageTraits<P2>::Equals(p2_, state->p2_) &&
+        InlineStorageTraits<P3>::Equals(p3_, state->p3_) &&
+        InlineStorageTraits<P4>::Equals(p4_, state->p4_) &&
+        InlineStorageTraits<P5>::Equals(p5_, state->p5_) &&
+        InlineStorageTraits<P6>::Equals(p6_, state->p6_) &&
+        InlineStorageTraits<P7>::Equals(p7_, state->p7_);
+  }
+
+  virtual const void* TypeId() const OVERRIDE {
+    static char type_id;
+    return &type_id;
+  }
+
   RunnableType runnable_;
   P1 p1_;
   P2 p2_;
@@ -2783,6 +3087,22 @@ struct BindState<Runnable, RunType, void(P1, P2, P3, P4, P5, P6,
   P7 p7_;
 };
 
+// StoresInline<>
+//
+// True for the bind states that Bind() copies into the Callback's inline
+// storage instead of allocating on the heap: those that fit, that bind a
+// plain function or method, and whose bound arguments InlineStorageTraits<>
+// allows.  Methods bound to a raw pointer are excluded, because the bind
+// state holds a reference to the receiver and releasing it could destroy the
+// Callback from within its own bind state's destructor.
+template <typename BindStateType>
+struct StoresInline {
+  static const bool value =
+      sizeof(BindStateType) <= kInlineBindStateSize &&
+      IsRunnableAdapter<typename BindStateType::RunnableType>::value &&
+      BindStateType::kBoundArgsStoreInline;
+};
+
 }  // namespace internal
 }  // namespace base
 
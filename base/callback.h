@@ -390,6 +390,18 @@ class Callback<R(void)> : public internal::CallbackBase {
     polymorphic_invoke_ = reinterpret_cast<InvokeFuncStorage>(invoke_func);
   }
 
+  // Used by Bind() for bind states that are stored inline.
+  template <typename Runnable, typename BindRunType, typename BoundArgsType>
+  Callback(internal::InlineBindStateTag tag,
+           const internal::BindState<Runnable, BindRunType,
+                                     BoundArgsType>& bind_state)
+      : CallbackBase(tag, bind_state) {
+    PolymorphicInvoke invoke_func =
+        &internal::BindState<Runnable, BindRunType, BoundArgsType>
+            ::InvokerType::Run;
+    polymorphic_invoke_ = reinterpret_cast<InvokeFuncStorage>(invoke_func);
+  }
+
   bool Equals(const Callback& other) const {
     return CallbackBase::Equals(other);
   }
@@ -398,7 +410,7 @@ class Callback<R(void)> : public internal::CallbackBase {
     PolymorphicInvoke f =
         reinterpret_cast<PolymorphicInvoke>(polymorphic_invoke_);
 
-    return f(bind_state_.get());
+    return f(bind_state_);
   }
 
  private:
@@ -430,6 +442,18 @@ class Callback<R(A1)> : public internal::CallbackBase {
     polymorphic_invoke_ = reinterpret_cast<InvokeFuncStorage>(invoke_func);
   }
 
+  // Used by Bind() for bind states that are stored inline.
+  template <typename Runnable, typename BindRunType, typename BoundArgsType>
+  Callback(internal::InlineBindStateTag tag,
+           const internal::BindState<Runnable, BindRunType,
+                                     BoundArgsType>& bind_state)
+      : CallbackBase(tag, bind_state) {
+    PolymorphicInvoke invoke_func =
+        &internal::BindState<Runnable, BindRunType, BoundArgsType>
+            ::InvokerType::Run;
+    polymorphic_invoke_ = reinterpret_cast<InvokeFuncStorage>(invoke_func);
+  }
+
   bool Equals(const Callback& other) const {
     return CallbackBase::Equals(other);
   }
@@ -438,7 +462,7 @@ class Callback<R(A1)> : public internal::CallbackBase {
     PolymorphicInvoke f =
         reinterpret_cast<PolymorphicInvoke>(polymorphic_invoke_);
 
-    return f(bind_state_.get(), internal::CallbackForward(a1));
+    return f(bind_state_, internal::CallbackForward(a1));
   }
 
  private:
@@ -471,6 +495,18 @@ class Callback<R(A1, A2)> : public internal::CallbackBase {
     polymorphic_invoke_ = reinterpret_cast<InvokeFuncStorage>(invoke_func);
   }
 
+  // Used by Bind() for bind states that are stored inline.
+  template <typename Runnable, typename BindRunType, typename BoundArgsType>
+  Callback(internal::InlineBindStateTag tag,
+           const internal::BindState<Runnable, BindRunType,
+                                     BoundArgsType>& bind_state)
+      : CallbackBase(tag, bind_state) {
+    PolymorphicInvoke invoke_func =
+        &internal::BindState<Runnable, BindRunType, BoundArgsType>
+            ::InvokerType::Run;
+    polymorphic_invoke_ = reinterpret_cast<InvokeFuncStorage>(invoke_func);
+  }
+
   bool Equals(const Callback& other) const {
     return CallbackBase::Equals(other);
   }
@@ -480,7 +516,7 @@ class Callback<R(A1, A2)> : public internal::CallbackBase {
     PolymorphicInvoke f =
         reinterpret_cast<PolymorphicInvoke>(polymorphic_invoke_);
 
-    return f(bind_state_.get(), internal::CallbackForward(a1),
+    return f(bind_state_, internal::CallbackForward(a1),
              internal::CallbackForward(a2));
   }
 
@@ -515,6 +551,18 @@ class Callback<R(A1, A2, A3)> : public internal::CallbackBase {
     polymorphic_invoke_ = reinterpret_cast<InvokeFuncStorage>(invoke_func);
   }
 
+  // Used by Bind() for bind states that are stored inline.
+  template <typename Runnable, typename BindRunType, typename BoundArgsType>
+  Callback(internal::InlineBindStateTag tag,
+           const internal::BindState<Runnable, BindRunType,
+                                     BoundArgsType>& bind_state)
+      : CallbackBase(tag, bind_state) {
+    PolymorphicInvoke invoke_func =
+        &internal::BindState<Runnable, BindRunType, BoundArgsType>
+            ::InvokerType::Run;
+    polymorphic_invoke_ = reinterpret_cast<InvokeFuncStorage>(invoke_func);
+  }
+
   bool Equals(const Callback& other) const {
     return CallbackBase::Equals(other);
   }
@@ -525,7 +573,7 @@ class Callback<R(A1, A2, A3)> : public internal::CallbackBase {
     PolymorphicInvoke f =
         reinterpret_cast<PolymorphicInvoke>(polymorphic_invoke_);
 
-    return f(bind_state_.get(), internal::CallbackForward(a1),
+    return f(bind_state_, internal::CallbackForward(a1),
              internal::CallbackForward(a2),
              internal::CallbackForward(a3));
   }
@@ -562,6 +610,18 @@ class Callback<R(A1, A2, A3, A4)> : public internal::CallbackBase {
     polymorphic_invoke_ = reinterpret_cast<InvokeFuncStorage>(invoke_func);
   }
 
+  // Used by Bind() for bind states that are stored inline.
+  template <typename Runnable, typename BindRunType, typename BoundArgsType>
+  Callback(internal::InlineBindStateTag tag,
+           const internal::BindState<Runnable, BindRunType,
+                                     BoundArgsType>& bind_state)
+      : CallbackBase(tag, bind_state) {
+    PolymorphicInvoke invoke_func =
+        &internal::BindState<Runnable, BindRunType, BoundArgsType>
+            ::InvokerType::Run;
+    polymorphic_invoke_ = reinterpret_cast<InvokeFuncStorage>(invoke_func);
+  }
+
   bool Equals(const Callback& other) const {
     return CallbackBase::Equals(other);
   }
@@ -573,7 +633,7 @@ class Callback<R(A1, A2, A3, A4)> : public internal::CallbackBase {
     PolymorphicInvoke f =
         reinterpret_cast<PolymorphicInvoke>(polymorphic_invoke_);
 
-    return f(bind_state_.get(), internal::CallbackForward(a1),
+    return f(bind_state_, internal::CallbackForward(a1),
              internal::CallbackForward(a2),
              internal::CallbackForward(a3),
              internal::CallbackForward(a4));
@@ -613,6 +673,18 @@ class Callback<R(A1, A2, A3, A4, A5)> : public internal::CallbackBase {
     polymorphic_invoke_ = reinterpret_cast<InvokeFuncStorage>(invoke_func);
   }
 
+  // Used by Bind() for bind states that are stored inline.
+  template <typename Runnable, typename BindRunType, typename BoundArgsType>
+  Callback(internal::InlineBindStateTag tag,
+           const internal::BindState<Runnable, BindRunType,
+                                     BoundArgsType>& bind_state)
+      : CallbackBase(tag, bind_state) {
+    PolymorphicInvoke invoke_func =
+        &internal::BindState<Runnable, BindRunType, BoundArgsType>
+            ::InvokerType::Run;
+    polymorphic_invoke_ = reinterpret_cast<InvokeFuncStorage>(invoke_func);
+  }
+
   bool Equals(const Callback& other) const {
     return CallbackBase::Equals(other);
   }
@@ -625,7 +697,7 @@ class Callback<R(A1, A2, A3, A4, A5)> : public internal::CallbackBase {
     PolymorphicInvoke f =
         reinterpret_cast<PolymorphicInvoke>(polymorphic_invoke_);
 
-    return f(bind_state_.get(), internal::CallbackForward(a1),
+    return f(bind_state_, internal::CallbackForward(a1),
              internal::CallbackForward(a2),
              internal::CallbackForward(a3),
              internal::CallbackForward(a4),
@@ -667,6 +739,18 @@ class Callback<R(A1, A2, A3, A4, A5, A6)> : public internal::CallbackBase {
     polymorphic_invoke_ = reinterpret_cast<InvokeFuncStorage>(invoke_func);
   }
 
+  // Used by Bind() for bind states that are stored inline.
+  template <typename Runnable, typename BindRunType, typename BoundArgsType>
+  Callback(internal::InlineBindStateTag tag,
+           const internal::BindState<Runnable, BindRunType,
+                                     BoundArgsType>& bind_state)
+      : CallbackBase(tag, bind_state) {
+    PolymorphicInvoke invoke_func =
+        &internal::BindState<Runnable, BindRunType, BoundArgsType>
+            ::InvokerType::Run;
+    polymorphic_invoke_ = reinterpret_cast<InvokeFuncStorage>(invoke_func);
+  }
+
   bool Equals(const Callback& other) const {
     return CallbackBase::Equals(other);
   }
@@ -680,7 +764,7 @@ class Callback<R(A1, A2, A3, A4, A5, A6)> : public internal::CallbackBase {
     PolymorphicInvoke f =
         reinterpret_cast<PolymorphicInvoke>(polymorphic_invoke_);
 
-    return f(bind_state_.get(), internal::CallbackForward(a1),
+    return f(bind_state_, internal::CallbackForward(a1),
              internal::CallbackForward(a2),
              internal::CallbackForward(a3),
              internal::CallbackForward(a4),
@@ -724,6 +808,18 @@ class Callback<R(A1, A2, A3, A4, A5, A6, A7)> : public internal::CallbackBase {
     polymorphic_invoke_ = reinterpret_cast<InvokeFuncStorage>(invoke_func);
   }
 
+  // Used by Bind() for bind states that are stored inline.
+  template <typename Runnable, typename BindRunType, typename BoundArgsType>
+  Callback(internal::InlineBindStateTag tag,
+           const internal::BindState<Runnable, BindRunType,
+                                     BoundArgsType>& bind_state)
+      : CallbackBase(tag, bind_state) {
+    PolymorphicInvoke invoke_func =
+        &internal::BindState<Runnable, BindRunType, BoundArgsType>
+            ::InvokerType::Run;
+    polymorphic_invoke_ = reinterpret_cast<InvokeFuncStorage>(invoke_func);
+  }
+
   bool Equals(const Callback& other) const {
     return CallbackBase::Equals(other);
   }
@@ -738,7 +834,7 @@ class Callback<R(A1, A2, A3, A4, A5, A6, A7)> : public internal::CallbackBase {
     PolymorphicInvoke f =
         reinterpret_cast<PolymorphicInvoke>(polymorphic_invoke_);
 
-    return f(bind_state_.get(), internal::CallbackForward(a1),
+    return f(bind_state_, internal::CallbackForward(a1),
              internal::CallbackForward(a2),
              internal::CallbackForward(a3),
              internal::CallbackForward(a4),
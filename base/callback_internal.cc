@@ -10,28 +10,86 @@ namespace base {
 namespace internal {
 
 bool CallbackBase::is_null() const {
-  return bind_state_.get() == NULL;
+  return bind_state_ == NULL;
 }
 
 void CallbackBase::Reset() {
   polymorphic_invoke_ = NULL;
+  if (bind_state_is_inline_) {
+    // Inline bind states only hold bound arguments whose destruction cannot
+    // run arbitrary code, so unlike below we cannot be deleted by this.
+    bind_state_->DestroyInline();
+    bind_state_ = NULL;
+    bind_state_is_inline_ = false;
+    return;
+  }
   // NULL the bind_state_ last, since it may be holding the last ref to whatever
   // object owns us, and we may be deleted after that.
+  BindStateBase* bind_state = bind_state_;
   bind_state_ = NULL;
+  if (bind_state)
+    bind_state->Release();
 }
 
 bool CallbackBase::Equals(const CallbackBase& other) const {
-  return bind_state_.get() == other.bind_state_.get() &&
-         polymorphic_invoke_ == other.polymorphic_invoke_;
+  if (polymorphic_invoke_ != other.polymorphic_invoke_)
+    return false;
+  if (bind_state_is_inline_ && other.bind_state_is_inline_)
+    return bind_state_->BoundStateEquals(other.bind_state_);
+  return bind_state_ == other.bind_state_;
 }
 
 CallbackBase::CallbackBase(BindStateBase* bind_state)
     : bind_state_(bind_state),
-      polymorphic_invoke_(NULL) {
-  DCHECK(!bind_state_.get() || bind_state_->HasOneRef());
+      polymorphic_invoke_(NULL),
+      bind_state_is_inline_(false) {
+  if (bind_state_) {
+    bind_state_->AddRef();
+    DCHECK(bind_state_->HasOneRef());
+  }
+}
+
+CallbackBase::CallbackBase(InlineBindStateTag tag,
+                           const BindStateBase& bind_state)
+    : bind_state_(bind_state.CopyTo(&inline_storage_)),
+      polymorphic_invoke_(NULL),
+      bind_state_is_inline_(true) {
+  DCHECK(bind_state_);
+  bind_state.MarkReleasedForInlineDestruction();
+}
+
+CallbackBase::CallbackBase(const CallbackBase& other)
+    : bind_state_(NULL),
+      polymorphic_invoke_(NULL),
+      bind_state_is_inline_(false) {
+  CopyStateFrom(other);
+}
+
+CallbackBase& CallbackBase::operator=(const CallbackBase& other) {
+  if (this == &other)
+    return *this;
+  // Dropping our bind state may destroy |other|, so take a copy first.
+  CallbackBase copy(other);
+  Reset();
+  CopyStateFrom(copy);
+  return *this;
 }
 
 CallbackBase::~CallbackBase() {
+  Reset();
+}
+
+void CallbackBase::CopyStateFrom(const CallbackBase& other) {
+  DCHECK(!bind_state_);
+  polymorphic_invoke_ = other.polymorphic_invoke_;
+  bind_state_is_inline_ = other.bind_state_is_inline_;
+  if (bind_state_is_inline_) {
+    bind_state_ = other.bind_state_->CopyTo(&inline_storage_);
+  } else {
+    bind_state_ = other.bind_state_;
+    if (bind_state_)
+      bind_state_->AddRef();
+  }
 }
 
 }  // namespace internal
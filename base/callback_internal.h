@@ -11,8 +11,10 @@
 #include <stddef.h>
 
 #include "base/base_export.h"
+#include "base/basictypes.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/memory/small_object_allocator.h"
 
 template <typename T>
 class ScopedVector;
@@ -20,6 +22,17 @@ class ScopedVector;
 namespace base {
 namespace internal {
 
+// Size of the storage that every Callback reserves for a bind state.  Bind
+// states that fit, and whose bound arguments can safely be copied (see
+// StoresInline<> in bind_internal.h), are constructed in this storage instead
+// of on the heap.  On 64-bit platforms this fits a method bound to a
+// WeakPtr<>.
+const size_t kInlineBindStateSize = 6 * sizeof(void*);
+
+// Tag for the Callback constructors that copy a bind state into the inline
+// storage.
+struct InlineBindStateTag {};
+
 // BindStateBase is used to provide an opaque handle that the Callback
 // class can use to represent a function object with bound arguments.  It
 // behaves as an existential type that is used by a corresponding
@@ -27,6 +40,49 @@ namespace internal {
 // us to shield the Callback class from the types of the bound argument via
 // "type erasure."
 class BindStateBase : public RefCountedThreadSafe<BindStateBase> {
+ public:
+  // A bind state is created for every Bind() call, typically to be destroyed
+  // as soon as the task it is posted with has run, so it is allocated from
+  // the per-thread small object caches rather than directly from the heap.
+  static void* operator new(size_t size) {
+    return SmallObjectAllocator::Allocate(size);
+  }
+  static void operator delete(void* ptr, size_t size) {
+    SmallObjectAllocator::Free(ptr, size);
+  }
+
+  // Copy-constructs this bind state in |storage|, which must hold at least
+  // kInlineBindStateSize bytes, and returns the copy.  Only called for bind
+  // states that are stored inline.
+  virtual BindStateBase* CopyTo(void* storage) const { return NULL; }
+
+  // Returns true if |other| is the same type of bind state, and binds the
+  // same function and argument values.  Inline bind states are copied along
+  // with their Callback, so this is what makes copies compare equal.
+  virtual bool BoundStateEquals(const BindStateBase* other) const {
+    return false;
+  }
+
+  // Returns a value that is distinct for every bind state type.
+  virtual const void* TypeId() const { return NULL; }
+
+  // Destroys a bind state that was constructed by CopyTo(), without
+  // releasing its storage.
+  void DestroyInline() {
+    MarkReleasedForInlineDestruction();
+    this->~BindStateBase();
+  }
+
+  // Inline bind states, and the temporaries Bind() copies them from, are
+  // destroyed without ever being released.  This satisfies the destructor's
+  // check that they were.
+  void MarkReleasedForInlineDestruction() const {
+#ifndef NDEBUG
+    AddRef();
+    subtle::RefCountedThreadSafeBase::Release();
+#endif
+  }
+
  protected:
   friend class RefCountedThreadSafe<BindStateBase>;
   virtual ~BindStateBase() {}
@@ -52,19 +108,42 @@ class BASE_EXPORT CallbackBase {
   // Returns true if this callback equals |other|. |other| may be null.
   bool Equals(const CallbackBase& other) const;
 
-  // Allow initializing of |bind_state_| via the constructor to avoid default
-  // initialization of the scoped_refptr.  We do not also initialize
-  // |polymorphic_invoke_| here because doing a normal assignment in the
-  // derived Callback templates makes for much nicer compiler errors.
+  // Takes a reference to the newly allocated |bind_state|.  We do not also
+  // initialize |polymorphic_invoke_| here because doing a normal assignment
+  // in the derived Callback templates makes for much nicer compiler errors.
   explicit CallbackBase(BindStateBase* bind_state);
 
+  // Copies |bind_state| into the inline storage.
+  CallbackBase(InlineBindStateTag tag, const BindStateBase& bind_state);
+
+  // Copying a Callback shares a heap bind state, and copies an inline one.
+  CallbackBase(const CallbackBase& other);
+  CallbackBase& operator=(const CallbackBase& other);
+
   // Force the destructor to be instantiated inside this translation unit so
   // that our subclasses will not get inlined versions.  Avoids more template
   // bloat.
   ~CallbackBase();
 
-  scoped_refptr<BindStateBase> bind_state_;
+  // Either holds a reference to a heap bind state, or points into
+  // |inline_storage_|.
+  BindStateBase* bind_state_;
   InvokeFuncStorage polymorphic_invoke_;
+
+ private:
+  // Takes on the bind state of |other|.  |bind_state_| must be NULL.
+  void CopyStateFrom(const CallbackBase& other);
+
+  bool bind_state_is_inline_;
+
+  // Aligned for any of the bound argument types allowed inline.  This avoids
+  // ALIGNAS, which MSVC does not allow for types passed by value.
+  union {
+    char bytes_[kInlineBindStateSize];
+    void* align_pointer_;
+    double align_double_;
+    int64 align_int64_;
+  } inline_storage_;
 };
 
 // A helper template to determine if given type is non-const move-only-type,
@@ -2,12 +2,15 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <string>
+
 #include "base/bind.h"
 #include "base/callback.h"
 #include "base/callback_helpers.h"
 #include "base/callback_internal.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/memory/weak_ptr.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace base {
@@ -170,6 +173,98 @@ class CallbackOwner : public base::RefCounted<CallbackOwner> {
   bool* deleted_;
 };
 
+void Increment(int* value) {
+  ++*value;
+}
+
+void IncrementBy(int* value, int amount) {
+  *value += amount;
+}
+
+void AppendString(std::string* value, const std::string& suffix) {
+  value->append(suffix);
+}
+
+class Counter : public SupportsWeakPtr<Counter> {
+ public:
+  Counter() : count_(0) {}
+  void Increment() { ++count_; }
+  int count() const { return count_; }
+
+ private:
+  int count_;
+};
+
+TEST_F(CallbackTest, InlineBindStateOutlivesOriginal) {
+  int value = 0;
+  Closure copy;
+  {
+    Closure original = Bind(&IncrementBy, &value, 2);
+    copy = original;
+    original.Run();
+  }
+  copy.Run();
+  EXPECT_EQ(4, value);
+}
+
+TEST_F(CallbackTest, InlineBindStateEquals) {
+  int value = 0;
+  Closure a = Bind(&IncrementBy, &value, 1);
+  Closure a2 = a;
+  Closure b = Bind(&IncrementBy, &value, 2);
+  Closure c = Bind(&Increment, &value);
+  EXPECT_TRUE(a.Equals(a2));
+  EXPECT_FALSE(a.Equals(b));
+  EXPECT_FALSE(a.Equals(c));
+  EXPECT_FALSE(a.Equals(null_callback_));
+
+  // Inline callbacks are compared by value, since copies are indistinguishable
+  // from separately bound callbacks.
+  EXPECT_TRUE(a.Equals(Bind(&IncrementBy, &value, 1)));
+
+  // Callbacks that can't be stored inline are still compared by instance.
+  std::string string;
+  Closure d = Bind(&AppendString, &string, std::string("x"));
+  Closure d2 = d;
+  Closure e = Bind(&AppendString, &string, std::string("x"));
+  EXPECT_TRUE(d.Equals(d2));
+  EXPECT_FALSE(d.Equals(e));
+}
+
+TEST_F(CallbackTest, InlineBindStateWithWeakPtr) {
+  scoped_ptr<Counter> counter(new Counter);
+  Counter other_counter;
+  Closure callback = Bind(&Counter::Increment, counter->AsWeakPtr());
+  Closure copy = callback;
+  EXPECT_TRUE(callback.Equals(copy));
+  EXPECT_FALSE(callback.Equals(
+      Bind(&Counter::Increment, other_counter.AsWeakPtr())));
+  callback.Run();
+  copy.Run();
+  EXPECT_EQ(2, counter->count());
+
+  // Both copies are cancelled when the target goes away.
+  counter.reset();
+  callback.Run();
+  copy.Run();
+}
+
+TEST_F(CallbackTest, AssignBetweenInlineAndHeapBindStates) {
+  int value = 0;
+  std::string string;
+  Closure callback = Bind(&Increment, &value);
+  callback = Bind(&AppendString, &string, std::string("a"));
+  callback.Run();
+  callback = Bind(&Increment, &value);
+  callback.Run();
+  callback = callback;
+  callback.Run();
+  callback = null_callback_;
+  EXPECT_TRUE(callback.is_null());
+  EXPECT_EQ("a", string);
+  EXPECT_EQ(2, value);
+}
+
 TEST_F(CallbackTest, CallbackHasLastRefOnContainingObject) {
   bool deleted = false;
   CallbackOwner* owner = new CallbackOwner(&deleted);
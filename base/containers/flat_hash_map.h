@@ -0,0 +1,430 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_FLAT_HASH_MAP_H_
+#define BASE_CONTAINERS_FLAT_HASH_MAP_H_
+
+#include <stddef.h>
+#include <string.h>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <utility>
+
+#include "base/basictypes.h"
+#include "base/containers/hash_tables.h"
+#include "base/logging.h"
+
+namespace base {
+
+namespace internal {
+
+// Hashes keys with the hash function of base::hash_map.
+template <typename Key>
+struct FlatHashMapDefaultHash {
+  size_t operator()(const Key& key) const {
+#if defined(COMPILER_MSVC)
+    return BASE_HASH_NAMESPACE::hash_compare<Key, std::less<Key> >()(key);
+#else
+    return BASE_HASH_NAMESPACE::hash<Key>()(key);
+#endif
+  }
+};
+
+}  // namespace internal
+
+// FlatHashMap is a hash map with the interface of base::hash_map, which keeps
+// its elements in a single array instead of allocating a node for each one.
+// Lookups probe neighbouring slots of that array (linear probing), so they
+// touch few cache lines, and inserting doesn't allocate until the table grows.
+//
+// Differences with base::hash_map:
+//  - Inserting may move the elements and invalidates all iterators and
+//    references, like std::vector. Erasing only invalidates iterators and
+//    references to the erased element, so erase(it++) loops work.
+//  - Keys and values must be copyable; elements are copied when the table
+//    grows.
+//  - Erased slots are reused by later inserts, and the table is rebuilt once
+//    too many of them accumulate, so iteration order changes on inserts.
+//
+// Use it for hot maps of small keys and values. Prefer base::hash_map for
+// large values, or when references to elements must survive inserts.
+template <typename Key,
+          typename Value,
+          typename Hash = internal::FlatHashMapDefaultHash<Key>,
+          typename KeyEqual = std::equal_to<Key> >
+class FlatHashMap {
+ private:
+  template <typename MapType, typename ValueType>
+  class Iterator;
+
+ public:
+  typedef Key key_type;
+  typedef Value mapped_type;
+  typedef std::pair<const Key, Value> value_type;
+  typedef Hash hasher;
+  typedef KeyEqual key_equal;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  typedef value_type& reference;
+  typedef const value_type& const_reference;
+  typedef value_type* pointer;
+  typedef const value_type* const_pointer;
+  typedef Iterator<FlatHashMap, value_type> iterator;
+  typedef Iterator<const FlatHashMap, const value_type> const_iterator;
+
+  explicit FlatHashMap(const Hash& hash = Hash(),
+                       const KeyEqual& key_equal = KeyEqual())
+      : hash_(hash),
+        key_equal_(key_equal),
+        slots_(NULL),
+        states_(NULL),
+        capacity_(0),
+        size_(0),
+        num_erased_(0) {
+  }
+
+  template <typename InputIterator>
+  FlatHashMap(InputIterator first, InputIterator last)
+      : slots_(NULL),
+        states_(NULL),
+        capacity_(0),
+        size_(0),
+        num_erased_(0) {
+    insert(first, last);
+  }
+
+  FlatHashMap(const FlatHashMap& other)
+      : hash_(other.hash_),
+        key_equal_(other.key_equal_),
+        slots_(NULL),
+        states_(NULL),
+        capacity_(0),
+        size_(0),
+        num_erased_(0) {
+    reserve(other.size());
+    insert(other.begin(), other.end());
+  }
+
+  ~FlatHashMap() {
+    DestroyAll();
+  }
+
+  FlatHashMap& operator=(const FlatHashMap& other) {
+    if (this != &other) {
+      FlatHashMap copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  iterator begin() { return iterator(this, NextFull(0)); }
+  iterator end() { return iterator(this, capacity_); }
+  const_iterator begin() const { return const_iterator(this, NextFull(0)); }
+  const_iterator end() const { return const_iterator(this, capacity_); }
+
+  bool empty() const { return size_ == 0; }
+  size_type size() const { return size_; }
+
+  // The number of slots, which bounds the number of elements the map holds
+  // before it grows.
+  size_type bucket_count() const { return capacity_; }
+
+  hasher hash_function() const { return hash_; }
+  key_equal key_eq() const { return key_equal_; }
+
+  // Makes room for |count| elements without growing again.
+  void reserve(size_type count) {
+    size_type capacity = kMinCapacity;
+    while (!FitsInCapacity(count, capacity))
+      capacity *= 2;
+    if (capacity > capacity_)
+      Rehash(capacity);
+  }
+
+  // The name of reserve() on hash_map.
+  void resize(size_type count) { reserve(count); }
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    size_t index;
+    if (FindForInsert(value.first, &index))
+      return std::make_pair(iterator(this, index), false);
+    new (&slots_[index]) value_type(value);
+    return std::make_pair(iterator(this, index), true);
+  }
+
+  template <typename InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    for (; first != last; ++first)
+      insert(*first);
+  }
+
+  Value& operator[](const Key& key) {
+    size_t index;
+    if (!FindForInsert(key, &index))
+      new (&slots_[index]) value_type(key, Value());
+    return slots_[index].second;
+  }
+
+  iterator find(const Key& key) {
+    return iterator(this, Find(key));
+  }
+
+  const_iterator find(const Key& key) const {
+    return const_iterator(this, Find(key));
+  }
+
+  size_type count(const Key& key) const {
+    return Find(key) == capacity_ ? 0 : 1;
+  }
+
+  void erase(iterator position) {
+    DCHECK(position.map_ == this);
+    EraseAt(position.index_);
+  }
+
+  void erase(iterator first, iterator last) {
+    while (first != last)
+      erase(first++);
+  }
+
+  size_type erase(const Key& key) {
+    size_t index = Find(key);
+    if (index == capacity_)
+      return 0;
+    EraseAt(index);
+    return 1;
+  }
+
+  void clear() {
+    for (size_t i = 0; i < capacity_; ++i) {
+      if (states_[i] == FULL)
+        slots_[i].~value_type();
+    }
+    if (states_)
+      memset(states_, EMPTY, capacity_);
+    size_ = 0;
+    num_erased_ = 0;
+  }
+
+  void swap(FlatHashMap& other) {
+    std::swap(hash_, other.hash_);
+    std::swap(key_equal_, other.key_equal_);
+    std::swap(slots_, other.slots_);
+    std::swap(states_, other.states_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+    std::swap(num_erased_, other.num_erased_);
+  }
+
+ private:
+  enum SlotState {
+    EMPTY = 0,
+    FULL,
+    // Erased slots keep probe sequences going, and are reused by inserts.
+    ERASED
+  };
+
+  static const size_t kMinCapacity = 8;
+
+  // The table grows once three quarters of its slots are full or erased.
+  static bool FitsInCapacity(size_t count, size_t capacity) {
+    return count <= capacity - capacity / 4;
+  }
+
+  template <typename MapType, typename ValueType>
+  class Iterator {
+   public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef ValueType value_type;
+    typedef ptrdiff_t difference_type;
+    typedef ValueType* pointer;
+    typedef ValueType& reference;
+
+    Iterator() : map_(NULL), index_(0) {}
+
+    // Allows converting an iterator to a const_iterator.
+    template <typename OtherMapType, typename OtherValueType>
+    Iterator(const Iterator<OtherMapType, OtherValueType>& other)
+        : map_(other.map_), index_(other.index_) {
+    }
+
+    ValueType& operator*() const { return map_->slots_[index_]; }
+    ValueType* operator->() const { return &map_->slots_[index_]; }
+
+    Iterator& operator++() {
+      index_ = map_->NextFull(index_ + 1);
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator result(*this);
+      ++*this;
+      return result;
+    }
+
+    template <typename OtherMapType, typename OtherValueType>
+    bool operator==(const Iterator<OtherMapType, OtherValueType>& other) const {
+      return index_ == other.index_;
+    }
+
+    template <typename OtherMapType, typename OtherValueType>
+    bool operator!=(const Iterator<OtherMapType, OtherValueType>& other) const {
+      return index_ != other.index_;
+    }
+
+   private:
+    friend class FlatHashMap;
+    template <typename OtherMapType, typename OtherValueType>
+    friend class Iterator;
+
+    Iterator(MapType* map, size_t index) : map_(map), index_(index) {}
+
+    MapType* map_;
+    size_t index_;
+  };
+
+  // Returns the slot where probing for a key with |hash| starts. The hash is
+  // multiplied by a large odd constant first, so that hash functions that
+  // return the key itself, like those of integers, don't cluster keys.
+  size_t FirstSlot(size_t hash) const {
+    const uint64 kMultiplier = 0x9e3779b97f4a7c15ULL;
+    return static_cast<size_t>((static_cast<uint64>(hash) * kMultiplier) >>
+                               32) & (capacity_ - 1);
+  }
+
+  // Returns the index of |key|, or capacity_ if it isn't in the map.
+  size_t Find(const Key& key) const {
+    if (!size_)
+      return capacity_;
+    size_t mask = capacity_ - 1;
+    for (size_t index = FirstSlot(hash_(key));; index = (index + 1) & mask) {
+      if (states_[index] == EMPTY)
+        return capacity_;
+      if (states_[index] == FULL && key_equal_(slots_[index].first, key))
+        return index;
+    }
+  }
+
+  // Returns true and sets |index| to the slot of |key| if it is in the map.
+  // Otherwise returns false and sets |index| to the free slot where it should
+  // be constructed, growing the table first if needed; the slot is counted as
+  // full.
+  bool FindForInsert(const Key& key, size_t* index) {
+    if (!FitsInCapacity(size_ + num_erased_ + 1, capacity_)) {
+      // Rebuild at the same size if the elements fill at most half of the
+      // table, so that erased slots are reclaimed instead of growing it.
+      size_t capacity = capacity_;
+      if (!capacity)
+        capacity = kMinCapacity;
+      else if (2 * (size_ + 1) > capacity)
+        capacity *= 2;
+      Rehash(capacity);
+    }
+
+    size_t mask = capacity_ - 1;
+    size_t free_index = capacity_;
+    size_t probe = FirstSlot(hash_(key));
+    for (;; probe = (probe + 1) & mask) {
+      if (states_[probe] == EMPTY)
+        break;
+      if (states_[probe] == ERASED) {
+        if (free_index == capacity_)
+          free_index = probe;
+      } else if (key_equal_(slots_[probe].first, key)) {
+        *index = probe;
+        return true;
+      }
+    }
+
+    if (free_index == capacity_) {
+      free_index = probe;
+    } else {
+      --num_erased_;
+    }
+    states_[free_index] = FULL;
+    ++size_;
+    *index = free_index;
+    return false;
+  }
+
+  void EraseAt(size_t index) {
+    DCHECK(states_[index] == FULL);
+    slots_[index].~value_type();
+    --size_;
+    size_t mask = capacity_ - 1;
+    if (states_[(index + 1) & mask] != EMPTY) {
+      states_[index] = ERASED;
+      ++num_erased_;
+      return;
+    }
+
+    // No probe sequence goes through a slot followed by an empty one, so it
+    // can be emptied, and so can the erased slots before it.
+    states_[index] = EMPTY;
+    for (index = (index - 1) & mask; states_[index] == ERASED;
+         index = (index - 1) & mask) {
+      states_[index] = EMPTY;
+      --num_erased_;
+    }
+  }
+
+  // Returns the first full slot at or after |index|, or capacity_.
+  size_t NextFull(size_t index) const {
+    while (index < capacity_ && states_[index] != FULL)
+      ++index;
+    return index;
+  }
+
+  void Rehash(size_t capacity) {
+    DCHECK_EQ(0u, capacity & (capacity - 1));
+    value_type* old_slots = slots_;
+    uint8* old_states = states_;
+    size_t old_capacity = capacity_;
+
+    slots_ = static_cast<value_type*>(
+        ::operator new(capacity * sizeof(value_type)));
+    states_ = new uint8[capacity];
+    memset(states_, EMPTY, capacity);
+    capacity_ = capacity;
+    num_erased_ = 0;
+
+    size_t mask = capacity_ - 1;
+    for (size_t i = 0; i < old_capacity; ++i) {
+      if (old_states[i] != FULL)
+        continue;
+      size_t index = FirstSlot(hash_(old_slots[i].first));
+      while (states_[index] != EMPTY)
+        index = (index + 1) & mask;
+      new (&slots_[index]) value_type(old_slots[i]);
+      states_[index] = FULL;
+      old_slots[i].~value_type();
+    }
+    ::operator delete(old_slots);
+    delete[] old_states;
+  }
+
+  void DestroyAll() {
+    clear();
+    ::operator delete(slots_);
+    delete[] states_;
+  }
+
+  Hash hash_;
+  KeyEqual key_equal_;
+
+  // |capacity_| slots, a power of two, and the SlotState of each.
+  value_type* slots_;
+  uint8* states_;
+  size_t capacity_;
+
+  size_t size_;
+  size_t num_erased_;
+};
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_HASH_MAP_H_
@@ -0,0 +1,95 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/flat_hash_map.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/containers/hash_tables.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+// Does about this many operations of each kind for each map size.
+const size_t kOperationsPerSize = 4 * 1000 * 1000;
+
+const size_t kMapSizes[] = {1000, 10000, 100000, 1000000};
+
+// Returns |count| distinct keys in a scrambled order.
+std::vector<int> MakeKeys(size_t count) {
+  std::vector<int> keys(count);
+  for (size_t i = 0; i < count; ++i)
+    keys[i] = static_cast<int>(i * 2654435761u);
+  return keys;
+}
+
+template <typename MapType>
+void RunTest(const std::string& name) {
+  for (size_t i = 0; i < arraysize(kMapSizes); ++i) {
+    size_t size = kMapSizes[i];
+    size_t rounds = std::max<size_t>(1, kOperationsPerSize / size);
+    std::vector<int> keys = MakeKeys(size);
+    std::string trace = name + "_" + Uint64ToString(size);
+
+    // Each round fills the map, looks up every key and one missing key for
+    // each, then erases them all.
+    TimeDelta insert_time, lookup_time, erase_time;
+    int sum = 0;
+    for (size_t round = 0; round < rounds; ++round) {
+      MapType map;
+      TimeTicks start = TimeTicks::HighResNow();
+      for (size_t j = 0; j < size; ++j)
+        map[keys[j]] = static_cast<int>(j);
+      insert_time += TimeTicks::HighResNow() - start;
+
+      start = TimeTicks::HighResNow();
+      for (size_t j = 0; j < size; ++j) {
+        typename MapType::const_iterator it = map.find(keys[j]);
+        if (it != map.end())
+          sum += it->second;
+        sum += static_cast<int>(map.count(keys[j] + 1));
+      }
+      lookup_time += TimeTicks::HighResNow() - start;
+
+      start = TimeTicks::HighResNow();
+      for (size_t j = 0; j < size; ++j)
+        map.erase(keys[j]);
+      erase_time += TimeTicks::HighResNow() - start;
+      EXPECT_TRUE(map.empty());
+    }
+    EXPECT_NE(0, sum);
+
+    double operations = rounds * size;
+    perf_test::PrintResult("insert", "", trace,
+                           operations / insert_time.InMillisecondsF() / 1000,
+                           "ops/us", true);
+    perf_test::PrintResult("lookup", "", trace,
+                           2 * operations / lookup_time.InMillisecondsF() /
+                               1000,
+                           "ops/us", true);
+    perf_test::PrintResult("erase", "", trace,
+                           operations / erase_time.InMillisecondsF() / 1000,
+                           "ops/us", true);
+  }
+}
+
+}  // namespace
+
+TEST(FlatHashMapPerfTest, HashMap) {
+  RunTest<hash_map<int, int> >("hash_map");
+}
+
+TEST(FlatHashMapPerfTest, FlatHashMap) {
+  RunTest<FlatHashMap<int, int> >("flat_hash_map");
+}
+
+}  // namespace base
@@ -0,0 +1,259 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/flat_hash_map.h"
+
+#include <map>
+#include <string>
+
+#include "base/basictypes.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+// Counts the live instances, to check the map destroys every element it
+// constructs.
+class Counted {
+ public:
+  Counted() : value_(0) { ++live_; }
+  explicit Counted(int value) : value_(value) { ++live_; }
+  Counted(const Counted& other) : value_(other.value_) { ++live_; }
+  ~Counted() { --live_; }
+
+  Counted& operator=(const Counted& other) {
+    value_ = other.value_;
+    return *this;
+  }
+
+  int value() const { return value_; }
+
+  static int live() { return live_; }
+
+ private:
+  int value_;
+
+  static int live_;
+};
+
+int Counted::live_ = 0;
+
+// Sends every key to the same slot, so that all probe sequences collide.
+struct CollidingHash {
+  size_t operator()(int key) const { return 0; }
+};
+
+}  // namespace
+
+TEST(FlatHashMapTest, Basic) {
+  FlatHashMap<int, int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(0u, map.size());
+  EXPECT_TRUE(map.begin() == map.end());
+  EXPECT_TRUE(map.find(1) == map.end());
+  EXPECT_EQ(0u, map.count(1));
+  EXPECT_EQ(0u, map.erase(1));
+
+  std::pair<FlatHashMap<int, int>::iterator, bool> result =
+      map.insert(std::make_pair(1, 10));
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(1, result.first->first);
+  EXPECT_EQ(10, result.first->second);
+
+  result = map.insert(std::make_pair(1, 20));
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(10, result.first->second);
+
+  map[2] = 20;
+  EXPECT_EQ(20, map[2]);
+  EXPECT_EQ(0, map[3]);
+  EXPECT_EQ(3u, map.size());
+  EXPECT_FALSE(map.empty());
+
+  FlatHashMap<int, int>::const_iterator it = map.find(2);
+  ASSERT_TRUE(it != map.end());
+  EXPECT_EQ(20, it->second);
+  EXPECT_EQ(1u, map.count(3));
+
+  EXPECT_EQ(1u, map.erase(2));
+  EXPECT_EQ(0u, map.erase(2));
+  EXPECT_TRUE(map.find(2) == map.end());
+  EXPECT_EQ(2u, map.size());
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.begin() == map.end());
+  EXPECT_TRUE(map.find(1) == map.end());
+}
+
+TEST(FlatHashMapTest, StringKeys) {
+  FlatHashMap<std::string, std::string> map;
+  map["one"] = "1";
+  map["two"] = "2";
+  map.insert(std::make_pair(std::string("three"), std::string("3")));
+
+  EXPECT_EQ("1", map["one"]);
+  EXPECT_EQ("2", map.find("two")->second);
+  EXPECT_EQ(1u, map.count("three"));
+  EXPECT_EQ(0u, map.count("four"));
+}
+
+TEST(FlatHashMapTest, Iterate) {
+  FlatHashMap<int, int> map;
+  std::map<int, int> expected;
+  for (int i = 0; i < 100; ++i) {
+    map[i * 7] = i;
+    expected[i * 7] = i;
+  }
+
+  std::map<int, int> seen(map.begin(), map.end());
+  EXPECT_EQ(expected, seen);
+
+  const FlatHashMap<int, int>& const_map = map;
+  size_t count = 0;
+  for (FlatHashMap<int, int>::const_iterator it = const_map.begin();
+       it != const_map.end(); ++it) {
+    EXPECT_EQ(expected[it->first], it->second);
+    ++count;
+  }
+  EXPECT_EQ(expected.size(), count);
+}
+
+TEST(FlatHashMapTest, EraseWhileIterating) {
+  FlatHashMap<int, int> map;
+  for (int i = 0; i < 1000; ++i)
+    map[i] = i;
+
+  for (FlatHashMap<int, int>::iterator it = map.begin(); it != map.end();) {
+    if (it->first % 2)
+      map.erase(it++);
+    else
+      ++it;
+  }
+
+  EXPECT_EQ(500u, map.size());
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(i % 2 ? 0u : 1u, map.count(i)) << i;
+
+  map.erase(map.begin(), map.end());
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(FlatHashMapTest, Grow) {
+  FlatHashMap<int, int> map;
+  for (int i = 0; i < 10000; ++i) {
+    map[i] = -i;
+    // The table never fills more than three quarters of its slots.
+    EXPECT_LE(map.size() * 4, map.bucket_count() * 3);
+  }
+  EXPECT_EQ(10000u, map.size());
+  for (int i = 0; i < 10000; ++i)
+    EXPECT_EQ(-i, map[i]);
+}
+
+TEST(FlatHashMapTest, Reserve) {
+  FlatHashMap<int, int> map;
+  map.reserve(1000);
+  size_t bucket_count = map.bucket_count();
+  for (int i = 0; i < 1000; ++i)
+    map[i] = i;
+  EXPECT_EQ(bucket_count, map.bucket_count());
+
+  // Reserving less than the current size doesn't shrink the table.
+  map.reserve(10);
+  EXPECT_EQ(bucket_count, map.bucket_count());
+  EXPECT_EQ(1000u, map.size());
+}
+
+TEST(FlatHashMapTest, ChurnDoesNotGrow) {
+  // Inserting and erasing keeps the same number of elements, so the erased
+  // slots must be reclaimed instead of the table growing.
+  FlatHashMap<int, int> map;
+  for (int i = 0; i < 100; ++i)
+    map[i] = i;
+  size_t bucket_count = map.bucket_count();
+
+  for (int i = 100; i < 100000; ++i) {
+    map[i] = i;
+    EXPECT_EQ(1u, map.erase(i - 100));
+  }
+  EXPECT_EQ(100u, map.size());
+  EXPECT_EQ(bucket_count, map.bucket_count());
+  for (int i = 100000 - 100; i < 100000; ++i)
+    EXPECT_EQ(i, map[i]);
+}
+
+TEST(FlatHashMapTest, Collisions) {
+  FlatHashMap<int, int, CollidingHash> map;
+  for (int i = 0; i < 50; ++i)
+    map[i] = i;
+  for (int i = 0; i < 50; i += 3)
+    EXPECT_EQ(1u, map.erase(i));
+
+  // The keys after the erased ones in the probe sequence are still found.
+  for (int i = 0; i < 50; ++i) {
+    FlatHashMap<int, int, CollidingHash>::iterator it = map.find(i);
+    if (i % 3 == 0) {
+      EXPECT_TRUE(it == map.end()) << i;
+    } else {
+      ASSERT_TRUE(it != map.end()) << i;
+      EXPECT_EQ(i, it->second);
+    }
+  }
+
+  // Reinserting reuses the erased slots.
+  for (int i = 0; i < 50; i += 3)
+    EXPECT_TRUE(map.insert(std::make_pair(i, -i)).second);
+  EXPECT_EQ(50u, map.size());
+  EXPECT_EQ(-3, map[3]);
+}
+
+TEST(FlatHashMapTest, CopyAndSwap) {
+  FlatHashMap<int, std::string> map;
+  map[1] = "one";
+  map[2] = "two";
+
+  FlatHashMap<int, std::string> copy(map);
+  map[1] = "uno";
+  EXPECT_EQ(2u, copy.size());
+  EXPECT_EQ("one", copy[1]);
+
+  FlatHashMap<int, std::string> assigned;
+  assigned[3] = "three";
+  assigned = map;
+  EXPECT_EQ(2u, assigned.size());
+  EXPECT_EQ("uno", assigned[1]);
+  EXPECT_EQ(0u, assigned.count(3));
+
+  FlatHashMap<int, std::string> other;
+  other[4] = "four";
+  other.swap(copy);
+  EXPECT_EQ(1u, copy.size());
+  EXPECT_EQ("four", copy[4]);
+  EXPECT_EQ(2u, other.size());
+  EXPECT_EQ("two", other[2]);
+}
+
+TEST(FlatHashMapTest, DestroysElements) {
+  {
+    FlatHashMap<int, Counted> map;
+    for (int i = 0; i < 1000; ++i)
+      map[i] = Counted(i);
+    EXPECT_EQ(1000, Counted::live());
+
+    for (int i = 0; i < 1000; i += 2)
+      map.erase(i);
+    EXPECT_EQ(500, Counted::live());
+
+    FlatHashMap<int, Counted> copy(map);
+    EXPECT_EQ(1000, Counted::live());
+    copy.clear();
+    EXPECT_EQ(500, Counted::live());
+    EXPECT_EQ(501, map[501].value());
+  }
+  EXPECT_EQ(0, Counted::live());
+}
+
+}  // namespace base
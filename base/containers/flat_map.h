@@ -0,0 +1,85 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_FLAT_MAP_H_
+#define BASE_CONTAINERS_FLAT_MAP_H_
+
+#include <functional>
+#include <utility>
+
+#include "base/containers/flat_tree.h"
+
+namespace base {
+
+namespace internal {
+
+template <typename Key, typename Mapped>
+struct GetKeyFromMapValue {
+  const Key& operator()(const std::pair<Key, Mapped>& value) const {
+    return value.first;
+  }
+};
+
+}  // namespace internal
+
+// FlatMap is a std::map with its elements in a sorted vector. Lookups are
+// binary searches over contiguous memory, and the map does a single
+// allocation instead of one per element, but inserting or erasing a single
+// element is linear in the size of the map.
+//
+// Use it for maps which are built once, or in bulk, and read often: build
+// it with the range constructor, the vector constructor, or the range
+// insert(), which sort all the new elements at once. Prefer std::map when
+// elements are added or removed one at a time after the map is built.
+//
+// Differences with std::map:
+//  - Inserting or erasing invalidates all iterators and references, like
+//    std::vector.
+//  - value_type is std::pair<Key, Mapped>, not std::pair<const Key, Mapped>,
+//    since the vector must be able to assign elements. Don't change the keys
+//    through iterators.
+template <typename Key, typename Mapped, typename Compare = std::less<Key> >
+class FlatMap
+    : public internal::FlatTree<Key,
+                                std::pair<Key, Mapped>,
+                                internal::GetKeyFromMapValue<Key, Mapped>,
+                                Compare> {
+ private:
+  typedef internal::FlatTree<Key,
+                             std::pair<Key, Mapped>,
+                             internal::GetKeyFromMapValue<Key, Mapped>,
+                             Compare> Tree;
+
+ public:
+  typedef Mapped mapped_type;
+  typedef typename Tree::container_type container_type;
+  typedef typename Tree::value_type value_type;
+  typedef typename Tree::iterator iterator;
+
+  explicit FlatMap(const Compare& compare = Compare()) : Tree(compare) {}
+
+  template <typename InputIterator>
+  FlatMap(InputIterator first,
+          InputIterator last,
+          const Compare& compare = Compare())
+      : Tree(first, last, compare) {
+  }
+
+  explicit FlatMap(container_type* values, const Compare& compare = Compare())
+      : Tree(values, compare) {
+  }
+
+  // Returns the value of |key|, inserting a default constructed one if there
+  // is none.
+  Mapped& operator[](const Key& key) {
+    iterator position = this->lower_bound(key);
+    if (position == this->end() || this->key_comp()(key, position->first))
+      position = this->insert(position, value_type(key, Mapped()));
+    return position->second;
+  }
+};
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_MAP_H_
@@ -0,0 +1,115 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/flat_map.h"
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+// Does about this many lookups for each map size.
+const size_t kLookupsPerSize = 4 * 1000 * 1000;
+
+const size_t kMapSizes[] = {16, 256, 4096, 65536};
+
+// Returns the key for |i| in a scrambled order. Odd |i| are never in the
+// maps, which hold the keys of even |i|.
+int MakeKey(int i, int*) {
+  return static_cast<int>(i * 2654435761u);
+}
+
+std::string MakeKey(int i, std::string*) {
+  return StringPrintf("header-%08x", i * 2654435761u);
+}
+
+double Rate(size_t operations, const TimeTicks& start) {
+  return operations /
+      ((TimeTicks::HighResNow() - start).InMillisecondsF() * 1000);
+}
+
+// Builds maps with the keys of every size once, then looks up keys which are
+// half in the map, and iterates over the map; the workload of maps which
+// are filled at startup and then read.
+template <typename MapType>
+void RunTest(const std::string& name) {
+  typedef typename MapType::key_type Key;
+  for (size_t i = 0; i < arraysize(kMapSizes); ++i) {
+    size_t size = kMapSizes[i];
+    std::vector<std::pair<Key, int> > values;
+    std::vector<Key> lookups;
+    for (size_t j = 0; j < size; ++j) {
+      values.push_back(std::make_pair(MakeKey(2 * j, static_cast<Key*>(NULL)),
+                                      static_cast<int>(j)));
+      lookups.push_back(MakeKey(j, static_cast<Key*>(NULL)));
+    }
+    std::string trace = name + "_" + Uint64ToString(size);
+
+    size_t builds = std::max<size_t>(1, kLookupsPerSize / size / 16);
+    TimeTicks start = TimeTicks::HighResNow();
+    for (size_t j = 0; j < builds; ++j) {
+      MapType map(values.begin(), values.end());
+      EXPECT_EQ(size, map.size());
+    }
+    perf_test::PrintResult("build", "", trace, Rate(builds * size, start),
+                           "elements/us", true);
+
+    MapType map(values.begin(), values.end());
+    size_t rounds = std::max<size_t>(1, kLookupsPerSize / size);
+    int sum = 0;
+    start = TimeTicks::HighResNow();
+    for (size_t j = 0; j < rounds; ++j) {
+      for (size_t k = 0; k < size; ++k) {
+        typename MapType::const_iterator it = map.find(lookups[k]);
+        if (it != map.end())
+          sum += it->second;
+      }
+    }
+    perf_test::PrintResult("lookup", "", trace, Rate(rounds * size, start),
+                           "lookups/us", true);
+
+    start = TimeTicks::HighResNow();
+    for (size_t j = 0; j < rounds; ++j) {
+      for (typename MapType::const_iterator it = map.begin(); it != map.end();
+           ++it) {
+        sum += it->second;
+      }
+    }
+    perf_test::PrintResult("iterate", "", trace, Rate(rounds * size, start),
+                           "elements/us", true);
+    EXPECT_NE(0, sum);
+  }
+}
+
+}  // namespace
+
+TEST(FlatMapPerfTest, IntMap) {
+  RunTest<std::map<int, int> >("std_map_int");
+}
+
+TEST(FlatMapPerfTest, IntFlatMap) {
+  RunTest<FlatMap<int, int> >("flat_map_int");
+}
+
+TEST(FlatMapPerfTest, StringMap) {
+  RunTest<std::map<std::string, int> >("std_map_string");
+}
+
+TEST(FlatMapPerfTest, StringFlatMap) {
+  RunTest<FlatMap<std::string, int> >("flat_map_string");
+}
+
+}  // namespace base
@@ -0,0 +1,89 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/flat_map.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+typedef FlatMap<int, std::string> IntStringMap;
+
+TEST(FlatMapTest, RangeConstructorKeepsFirst) {
+  std::vector<std::pair<int, std::string> > values;
+  values.push_back(std::make_pair(2, std::string("two")));
+  values.push_back(std::make_pair(1, std::string("one")));
+  values.push_back(std::make_pair(2, std::string("deux")));
+  IntStringMap map(values.begin(), values.end());
+
+  ASSERT_EQ(2u, map.size());
+  EXPECT_EQ(1, map.begin()->first);
+  EXPECT_EQ("two", map.find(2)->second);
+
+  IntStringMap swapped(&values);
+  EXPECT_TRUE(values.empty());
+  EXPECT_TRUE(map == swapped);
+}
+
+TEST(FlatMapTest, Subscript) {
+  IntStringMap map;
+  map[3] = "three";
+  map[1] = "one";
+  map[2] = "two";
+  map[1] = "uno";
+
+  ASSERT_EQ(3u, map.size());
+  IntStringMap::const_iterator it = map.begin();
+  EXPECT_EQ(1, it->first);
+  EXPECT_EQ("uno", it->second);
+  ++it;
+  EXPECT_EQ(2, it->first);
+  ++it;
+  EXPECT_EQ(3, it->first);
+
+  EXPECT_EQ("", map[4]);
+  EXPECT_EQ(4u, map.size());
+}
+
+TEST(FlatMapTest, InsertDoesNotReplace) {
+  IntStringMap map;
+  EXPECT_TRUE(map.insert(std::make_pair(1, std::string("one"))).second);
+  std::pair<IntStringMap::iterator, bool> result =
+      map.insert(std::make_pair(1, std::string("uno")));
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ("one", result.first->second);
+
+  // The range insert keeps the existing values too.
+  std::vector<std::pair<int, std::string> > values;
+  values.push_back(std::make_pair(0, std::string("zero")));
+  values.push_back(std::make_pair(1, std::string("eins")));
+  map.insert(values.begin(), values.end());
+  EXPECT_EQ(2u, map.size());
+  EXPECT_EQ("zero", map[0]);
+  EXPECT_EQ("one", map[1]);
+}
+
+TEST(FlatMapTest, FindAndErase) {
+  IntStringMap map;
+  for (int i = 0; i < 100; ++i)
+    map.insert(map.end(), std::make_pair(i, std::string(1, 'a' + i % 26)));
+  EXPECT_EQ(100u, map.size());
+
+  for (int i = 0; i < 100; i += 2)
+    EXPECT_EQ(1u, map.erase(i));
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(i % 2 ? 1u : 0u, map.count(i));
+    if (i % 2) {
+      EXPECT_EQ(std::string(1, 'a' + i % 26), map.find(i)->second);
+    }
+  }
+  EXPECT_EQ(51, map.lower_bound(50)->first);
+}
+
+}  // namespace base
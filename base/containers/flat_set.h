@@ -0,0 +1,65 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_FLAT_SET_H_
+#define BASE_CONTAINERS_FLAT_SET_H_
+
+#include <functional>
+
+#include "base/containers/flat_tree.h"
+
+namespace base {
+
+namespace internal {
+
+template <typename Key>
+struct GetKeyFromSetValue {
+  const Key& operator()(const Key& key) const { return key; }
+};
+
+}  // namespace internal
+
+// FlatSet is a std::set with its elements in a sorted vector. Lookups are
+// binary searches over contiguous memory, and the set does a single
+// allocation instead of one per element, but inserting or erasing a single
+// element is linear in the size of the set.
+//
+// Use it for sets which are built once, or in bulk, and read often: build
+// it with the range constructor, the vector constructor, or the range
+// insert(), which sort all the new elements at once. Prefer std::set when
+// elements are added or removed one at a time after the set is built.
+//
+// Unlike std::set, inserting or erasing invalidates all iterators and
+// references, like std::vector.
+template <typename Key, typename Compare = std::less<Key> >
+class FlatSet : public internal::FlatTree<Key,
+                                          Key,
+                                          internal::GetKeyFromSetValue<Key>,
+                                          Compare> {
+ private:
+  typedef internal::FlatTree<Key,
+                             Key,
+                             internal::GetKeyFromSetValue<Key>,
+                             Compare> Tree;
+
+ public:
+  typedef typename Tree::container_type container_type;
+
+  explicit FlatSet(const Compare& compare = Compare()) : Tree(compare) {}
+
+  template <typename InputIterator>
+  FlatSet(InputIterator first,
+          InputIterator last,
+          const Compare& compare = Compare())
+      : Tree(first, last, compare) {
+  }
+
+  explicit FlatSet(container_type* values, const Compare& compare = Compare())
+      : Tree(values, compare) {
+  }
+};
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_SET_H_
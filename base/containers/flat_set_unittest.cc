@@ -0,0 +1,151 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/flat_set.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+std::vector<int> ToVector(const FlatSet<int>& set) {
+  return std::vector<int>(set.begin(), set.end());
+}
+
+}  // namespace
+
+TEST(FlatSetTest, Empty) {
+  FlatSet<int> set;
+  EXPECT_TRUE(set.empty());
+  EXPECT_EQ(0u, set.size());
+  EXPECT_TRUE(set.begin() == set.end());
+  EXPECT_TRUE(set.find(1) == set.end());
+  EXPECT_EQ(0u, set.count(1));
+  EXPECT_EQ(0u, set.erase(1));
+}
+
+TEST(FlatSetTest, RangeConstructor) {
+  const int kValues[] = {5, 3, 8, 3, 1, 5, 9};
+  FlatSet<int> set(kValues, kValues + arraysize(kValues));
+
+  const int kExpected[] = {1, 3, 5, 8, 9};
+  EXPECT_EQ(std::vector<int>(kExpected, kExpected + arraysize(kExpected)),
+            ToVector(set));
+}
+
+TEST(FlatSetTest, VectorConstructor) {
+  std::vector<int> values;
+  values.push_back(3);
+  values.push_back(1);
+  values.push_back(3);
+  values.push_back(2);
+  FlatSet<int> set(&values);
+
+  EXPECT_TRUE(values.empty());
+  EXPECT_EQ(3u, set.size());
+  EXPECT_EQ(1, *set.begin());
+  EXPECT_EQ(3, *set.rbegin());
+}
+
+TEST(FlatSetTest, Insert) {
+  FlatSet<int> set;
+  EXPECT_TRUE(set.insert(2).second);
+  EXPECT_TRUE(set.insert(1).second);
+  EXPECT_TRUE(set.insert(3).second);
+
+  std::pair<FlatSet<int>::iterator, bool> result = set.insert(2);
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(2, *result.first);
+  EXPECT_EQ(3u, set.size());
+
+  // A wrong hint still inserts at the right place.
+  EXPECT_EQ(0, *set.insert(set.end(), 0));
+  EXPECT_EQ(4, *set.insert(set.end(), 4));
+  EXPECT_EQ(2, *set.insert(set.begin(), 2));
+
+  const int kExpected[] = {0, 1, 2, 3, 4};
+  EXPECT_EQ(std::vector<int>(kExpected, kExpected + arraysize(kExpected)),
+            ToVector(set));
+}
+
+TEST(FlatSetTest, InsertRange) {
+  const int kValues[] = {10, 20, 30};
+  FlatSet<int> set(kValues, kValues + arraysize(kValues));
+
+  const int kMore[] = {25, 5, 20, 25, 40};
+  set.insert(kMore, kMore + arraysize(kMore));
+
+  const int kExpected[] = {5, 10, 20, 25, 30, 40};
+  EXPECT_EQ(std::vector<int>(kExpected, kExpected + arraysize(kExpected)),
+            ToVector(set));
+}
+
+TEST(FlatSetTest, Bounds) {
+  const int kValues[] = {10, 20, 30};
+  const FlatSet<int> set(kValues, kValues + arraysize(kValues));
+
+  EXPECT_EQ(20, *set.find(20));
+  EXPECT_TRUE(set.find(15) == set.end());
+  EXPECT_EQ(20, *set.lower_bound(20));
+  EXPECT_EQ(30, *set.upper_bound(20));
+  EXPECT_EQ(20, *set.lower_bound(15));
+  EXPECT_TRUE(set.lower_bound(31) == set.end());
+
+  std::pair<FlatSet<int>::const_iterator, FlatSet<int>::const_iterator>
+      range = set.equal_range(20);
+  EXPECT_EQ(1, range.second - range.first);
+  range = set.equal_range(25);
+  EXPECT_TRUE(range.first == range.second);
+  EXPECT_EQ(30, *range.first);
+}
+
+TEST(FlatSetTest, Erase) {
+  const int kValues[] = {1, 2, 3, 4, 5};
+  FlatSet<int> set(kValues, kValues + arraysize(kValues));
+
+  EXPECT_EQ(1u, set.erase(3));
+  EXPECT_EQ(0u, set.erase(3));
+  EXPECT_EQ(4, *set.erase(set.find(2)));
+  set.erase(set.begin(), set.find(5));
+  EXPECT_EQ(1u, set.size());
+  EXPECT_EQ(5, *set.begin());
+
+  set.clear();
+  EXPECT_TRUE(set.empty());
+}
+
+TEST(FlatSetTest, Compare) {
+  const char* kValues[] = {"b", "c", "a"};
+  FlatSet<std::string, std::greater<std::string> > set(
+      kValues, kValues + arraysize(kValues));
+
+  std::vector<std::string> values(set.begin(), set.end());
+  ASSERT_EQ(3u, values.size());
+  EXPECT_EQ("c", values[0]);
+  EXPECT_EQ("a", values[2]);
+  EXPECT_EQ(1u, set.count("b"));
+}
+
+TEST(FlatSetTest, SwapAndEquality) {
+  const int kValues[] = {1, 2};
+  FlatSet<int> a(kValues, kValues + arraysize(kValues));
+  FlatSet<int> b;
+  EXPECT_TRUE(a != b);
+
+  b.swap(a);
+  EXPECT_TRUE(a.empty());
+  EXPECT_EQ(2u, b.size());
+
+  a.insert(2);
+  a.insert(1);
+  EXPECT_TRUE(a == b);
+}
+
+}  // namespace base
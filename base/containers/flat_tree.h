@@ -0,0 +1,259 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_FLAT_TREE_H_
+#define BASE_CONTAINERS_FLAT_TREE_H_
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace base {
+namespace internal {
+
+// The implementation of FlatSet and FlatMap: a vector kept sorted by key,
+// without duplicate keys. |GetKey| is a functor returning the key of a
+// |Value|.
+template <typename Key, typename Value, typename GetKey, typename Compare>
+class FlatTree {
+ public:
+  typedef Key key_type;
+  typedef Value value_type;
+  typedef Compare key_compare;
+  typedef std::vector<Value> container_type;
+  typedef typename container_type::size_type size_type;
+  typedef typename container_type::difference_type difference_type;
+  typedef typename container_type::reference reference;
+  typedef typename container_type::const_reference const_reference;
+  typedef typename container_type::pointer pointer;
+  typedef typename container_type::const_pointer const_pointer;
+  typedef typename container_type::iterator iterator;
+  typedef typename container_type::const_iterator const_iterator;
+  typedef typename container_type::reverse_iterator reverse_iterator;
+  typedef typename container_type::const_reverse_iterator
+      const_reverse_iterator;
+
+  // Orders values by their keys.
+  class value_compare {
+   public:
+    explicit value_compare(const Compare& compare) : compare_(compare) {}
+
+    bool operator()(const Value& a, const Value& b) const {
+      return compare_(GetKey()(a), GetKey()(b));
+    }
+
+   private:
+    Compare compare_;
+  };
+
+  explicit FlatTree(const Compare& compare = Compare())
+      : compare_(compare) {
+  }
+
+  // Builds the tree from [first, last) with a single sort. When several
+  // values have the same key, the first one is kept.
+  template <typename InputIterator>
+  FlatTree(InputIterator first,
+           InputIterator last,
+           const Compare& compare = Compare())
+      : values_(first, last),
+        compare_(compare) {
+    SortAndUnique(values_.begin());
+  }
+
+  // Builds the tree from the values of |*values|, which is left empty. This
+  // avoids copying the values for trees built in a local vector first.
+  explicit FlatTree(container_type* values,
+                    const Compare& compare = Compare())
+      : compare_(compare) {
+    values_.swap(*values);
+    SortAndUnique(values_.begin());
+  }
+
+  iterator begin() { return values_.begin(); }
+  iterator end() { return values_.end(); }
+  const_iterator begin() const { return values_.begin(); }
+  const_iterator end() const { return values_.end(); }
+  reverse_iterator rbegin() { return values_.rbegin(); }
+  reverse_iterator rend() { return values_.rend(); }
+  const_reverse_iterator rbegin() const { return values_.rbegin(); }
+  const_reverse_iterator rend() const { return values_.rend(); }
+
+  bool empty() const { return values_.empty(); }
+  size_type size() const { return values_.size(); }
+  size_type capacity() const { return values_.capacity(); }
+  void reserve(size_type count) { values_.reserve(count); }
+
+  // Frees the memory reserved beyond size().
+  void shrink_to_fit() { container_type(values_).swap(values_); }
+
+  void clear() { values_.clear(); }
+
+  key_compare key_comp() const { return compare_; }
+  value_compare value_comp() const { return value_compare(compare_); }
+
+  // Inserts |value| unless there already is a value with its key. This
+  // shifts the values after it, so prefer the range constructor or insert()
+  // to add many values.
+  std::pair<iterator, bool> insert(const Value& value) {
+    iterator position = lower_bound(GetKey()(value));
+    if (position != end() && !compare_(GetKey()(value), GetKey()(*position)))
+      return std::make_pair(position, false);
+    return std::make_pair(values_.insert(position, value), true);
+  }
+
+  // Like insert(value), but skips the search when |value| belongs just
+  // before |hint|. Appending sorted values at end() is constant time.
+  iterator insert(iterator hint, const Value& value) {
+    const Key& key = GetKey()(value);
+    if ((hint == begin() || compare_(GetKey()(*(hint - 1)), key)) &&
+        (hint == end() || compare_(key, GetKey()(*hint)))) {
+      return values_.insert(hint, value);
+    }
+    return insert(value).first;
+  }
+
+  // Inserts the values of [first, last) whose keys aren't in the tree yet,
+  // sorting only the new values and merging them in.
+  template <typename InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    size_type old_size = size();
+    values_.insert(values_.end(), first, last);
+    SortAndUnique(values_.begin() + old_size);
+  }
+
+  iterator erase(iterator position) { return values_.erase(position); }
+
+  iterator erase(iterator first, iterator last) {
+    return values_.erase(first, last);
+  }
+
+  size_type erase(const Key& key) {
+    std::pair<iterator, iterator> range = equal_range(key);
+    size_type count = range.second - range.first;
+    values_.erase(range.first, range.second);
+    return count;
+  }
+
+  iterator find(const Key& key) {
+    iterator position = lower_bound(key);
+    if (position == end() || compare_(key, GetKey()(*position)))
+      return end();
+    return position;
+  }
+
+  const_iterator find(const Key& key) const {
+    const_iterator position = lower_bound(key);
+    if (position == end() || compare_(key, GetKey()(*position)))
+      return end();
+    return position;
+  }
+
+  size_type count(const Key& key) const {
+    return find(key) == end() ? 0 : 1;
+  }
+
+  iterator lower_bound(const Key& key) {
+    return std::lower_bound(begin(), end(), key, ValueKeyCompare(compare_));
+  }
+
+  const_iterator lower_bound(const Key& key) const {
+    return std::lower_bound(begin(), end(), key, ValueKeyCompare(compare_));
+  }
+
+  iterator upper_bound(const Key& key) {
+    return std::upper_bound(begin(), end(), key, KeyValueCompare(compare_));
+  }
+
+  const_iterator upper_bound(const Key& key) const {
+    return std::upper_bound(begin(), end(), key, KeyValueCompare(compare_));
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key& key) {
+    iterator position = lower_bound(key);
+    if (position == end() || compare_(key, GetKey()(*position)))
+      return std::make_pair(position, position);
+    return std::make_pair(position, position + 1);
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(const Key& key) const {
+    const_iterator position = lower_bound(key);
+    if (position == end() || compare_(key, GetKey()(*position)))
+      return std::make_pair(position, position);
+    return std::make_pair(position, position + 1);
+  }
+
+  void swap(FlatTree& other) {
+    values_.swap(other.values_);
+    std::swap(compare_, other.compare_);
+  }
+
+  bool operator==(const FlatTree& other) const {
+    return values_ == other.values_;
+  }
+
+  bool operator!=(const FlatTree& other) const {
+    return values_ != other.values_;
+  }
+
+ private:
+  // Compare values with keys for the binary searches. They are separate
+  // classes since Key and Value are the same type in a FlatSet.
+  class ValueKeyCompare {
+   public:
+    explicit ValueKeyCompare(const Compare& compare) : compare_(compare) {}
+
+    bool operator()(const Value& value, const Key& key) const {
+      return compare_(GetKey()(value), key);
+    }
+
+   private:
+    Compare compare_;
+  };
+
+  class KeyValueCompare {
+   public:
+    explicit KeyValueCompare(const Compare& compare) : compare_(compare) {}
+
+    bool operator()(const Key& key, const Value& value) const {
+      return compare_(key, GetKey()(value));
+    }
+
+   private:
+    Compare compare_;
+  };
+
+  // Returns true if |a| and |b|, with a <= b, have the same key.
+  class SameKey {
+   public:
+    explicit SameKey(const Compare& compare) : compare_(compare) {}
+
+    bool operator()(const Value& a, const Value& b) const {
+      return !compare_(GetKey()(a), GetKey()(b));
+    }
+
+   private:
+    Compare compare_;
+  };
+
+  // Sorts [middle, end()), merges it with the sorted values before it, and
+  // removes the values with duplicate keys, keeping the earliest one.
+  void SortAndUnique(iterator middle) {
+    value_compare compare(compare_);
+    std::stable_sort(middle, end(), compare);
+    std::inplace_merge(begin(), middle, end(), compare);
+    values_.erase(std::unique(begin(), end(), SameKey(compare_)), end());
+  }
+
+  container_type values_;
+  Compare compare_;
+};
+
+}  // namespace internal
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_TREE_H_
@@ -38,6 +38,7 @@ CPU::CPU()
     has_avx_(false),
     has_avx_hardware_(false),
     has_aesni_(false),
+    has_pclmul_(false),
     has_non_stop_time_stamp_counter_(false),
     cpu_vendor_("unknown") {
   Initialize();
@@ -133,6 +134,7 @@ void CPU::Initialize() {
         (cpu_info[2] & 0x08000000) != 0 /* OSXSAVE */ &&
         (_xgetbv(0) & 6) == 6 /* XSAVE enabled by kernel */;
     has_aesni_ = (cpu_info[2] & 0x02000000) != 0;
+    has_pclmul_ = (cpu_info[2] & 0x00000002) != 0;
   }
 
   // Get the brand string of the cpu.
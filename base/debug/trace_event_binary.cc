@@ -0,0 +1,125 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/debug/trace_event_binary.h"
+
+#include <string.h>
+
+#include "base/debug/trace_event_impl.h"
+#include "base/logging.h"
+
+namespace base {
+namespace debug {
+
+namespace {
+
+void AppendVarint(uint64 value, std::string* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+uint64 ZigZagEncode(int64 value) {
+  return (static_cast<uint64>(value) << 1) ^ static_cast<uint64>(value >> 63);
+}
+
+}  // namespace
+
+const char TraceEventBinaryWriter::kMagic[] = "CrTB";
+const int TraceEventBinaryWriter::kVersion = 1;
+
+TraceEventBinaryWriter::TraceEventBinaryWriter(int process_id)
+    : process_id_(process_id),
+      next_string_id_(0),
+      last_timestamp_(0) {
+}
+
+TraceEventBinaryWriter::~TraceEventBinaryWriter() {
+}
+
+void TraceEventBinaryWriter::AppendEvent(const TraceEvent& event) {
+  event.AppendAsBinary(this);
+}
+
+void TraceEventBinaryWriter::AppendSystemTrace(const std::string& data) {
+  WriteByte(RECORD_SYSTEM_TRACE);
+  WriteString(data);
+}
+
+void TraceEventBinaryWriter::FinishSegment(std::string* out) {
+  if (records_.empty())
+    return;
+
+  out->append(kMagic, strlen(kMagic));
+  AppendVarint(kVersion, out);
+  AppendVarint(ZigZagEncode(process_id_), out);
+  AppendVarint(records_.size(), out);
+  out->append(records_);
+
+  records_.clear();
+  next_string_id_ = 0;
+  last_timestamp_ = 0;
+  string_ids_.clear();
+  copied_string_ids_.clear();
+}
+
+uint32 TraceEventBinaryWriter::InternString(const char* str, bool copied) {
+  if (copied) {
+    std::pair<hash_map<std::string, uint32>::iterator, bool> result =
+        copied_string_ids_.insert(std::make_pair(str, next_string_id_));
+    if (result.second)
+      AddStringRecord(str);
+    return result.first->second;
+  }
+
+  std::pair<hash_map<uintptr_t, uint32>::iterator, bool> result =
+      string_ids_.insert(std::make_pair(reinterpret_cast<uintptr_t>(str),
+                                        next_string_id_));
+  if (result.second)
+    AddStringRecord(str);
+  return result.first->second;
+}
+
+void TraceEventBinaryWriter::WriteByte(unsigned char value) {
+  records_.push_back(static_cast<char>(value));
+}
+
+void TraceEventBinaryWriter::WriteVarint(uint64 value) {
+  AppendVarint(value, &records_);
+}
+
+void TraceEventBinaryWriter::WriteSignedVarint(int64 value) {
+  AppendVarint(ZigZagEncode(value), &records_);
+}
+
+void TraceEventBinaryWriter::WriteDouble(double value) {
+  COMPILE_ASSERT(sizeof(double) == sizeof(uint64), double_is_not_64_bits);
+  uint64 bits;
+  memcpy(&bits, &value, sizeof(bits));
+  for (size_t i = 0; i < sizeof(bits); ++i) {
+    records_.push_back(static_cast<char>(bits & 0xff));
+    bits >>= 8;
+  }
+}
+
+void TraceEventBinaryWriter::WriteString(const StringPiece& value) {
+  WriteVarint(value.size());
+  value.AppendToString(&records_);
+}
+
+void TraceEventBinaryWriter::WriteTimestamp(int64 timestamp) {
+  WriteSignedVarint(timestamp - last_timestamp_);
+  last_timestamp_ = timestamp;
+}
+
+void TraceEventBinaryWriter::AddStringRecord(const StringPiece& str) {
+  WriteByte(RECORD_STRING);
+  WriteString(str);
+  ++next_string_id_;
+}
+
+}  // namespace debug
+}  // namespace base
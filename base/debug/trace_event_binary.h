@@ -0,0 +1,127 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// TraceEventBinaryWriter encodes trace events in a compact binary format that
+// is much cheaper to produce than JSON.  Names, categories and argument names
+// are written once per segment and then referred to by id.
+//
+// A trace is a sequence of segments, each of which can be decoded on its own,
+// so that segments from different processes can be concatenated in any order.
+// tools/tracing/binary_trace_to_json.py converts a binary trace to the JSON
+// trace format.
+//
+// A segment is:
+//   "CrTB"  magic
+//   varint  format version (kVersion)
+//   svarint process id
+//   varint  size of the records that follow, in bytes
+//   records
+//
+// Each record starts with a RecordType byte.  varints are unsigned LEB128;
+// svarints are zigzag encoded varints.
+//
+// RECORD_STRING:
+//   varint length, bytes.  Defines the next string id, starting at 0.
+// RECORD_EVENT:
+//   byte    phase
+//   byte    flags (TRACE_EVENT_FLAG_*)
+//   byte    optional fields present (EventField bits)
+//   varint  category string id
+//   varint  name string id
+//   svarint thread id
+//   svarint timestamp, in microseconds, relative to the previous event of
+//           the segment
+//   then the present optional fields, in EventField order:
+//     svarint thread timestamp, svarint duration, svarint thread duration,
+//     varint id
+//   byte    number of arguments, then for each argument:
+//     varint name string id, byte TRACE_VALUE_TYPE_*, value:
+//       BOOL: byte; UINT, POINTER: varint; INT: svarint;
+//       DOUBLE: 8 bytes, little endian;
+//       STRING, COPY_STRING: varint length, bytes;
+//       CONVERTABLE: varint length, JSON text.
+// RECORD_SYSTEM_TRACE:
+//   varint length, bytes of system trace data.
+
+#ifndef BASE_DEBUG_TRACE_EVENT_BINARY_H_
+#define BASE_DEBUG_TRACE_EVENT_BINARY_H_
+
+#include <string>
+
+#include "base/base_export.h"
+#include "base/basictypes.h"
+#include "base/containers/hash_tables.h"
+#include "base/strings/string_piece.h"
+
+namespace base {
+namespace debug {
+
+class TraceEvent;
+
+class BASE_EXPORT TraceEventBinaryWriter {
+ public:
+  enum RecordType {
+    RECORD_STRING = 1,
+    RECORD_EVENT = 2,
+    RECORD_SYSTEM_TRACE = 3,
+  };
+
+  enum EventField {
+    FIELD_THREAD_TIMESTAMP = 1 << 0,
+    FIELD_DURATION = 1 << 1,
+    FIELD_THREAD_DURATION = 1 << 2,
+    FIELD_ID = 1 << 3,
+  };
+
+  static const char kMagic[];
+  static const int kVersion;
+
+  explicit TraceEventBinaryWriter(int process_id);
+  ~TraceEventBinaryWriter();
+
+  void AppendEvent(const TraceEvent& event);
+  void AppendSystemTrace(const std::string& data);
+
+  // Appends a segment holding the records added so far to |out|, and starts
+  // a new segment with an empty string table.  Does nothing if no records
+  // were added.
+  void FinishSegment(std::string* out);
+
+  bool empty() const { return records_.empty(); }
+
+  // The following are used by TraceEvent::AppendAsBinary().
+
+  // Returns the id of |str|, adding it to the string table first if needed.
+  // Strings are looked up by address unless |copied| is true, which is the
+  // case for strings held in the event's own storage.
+  uint32 InternString(const char* str, bool copied);
+
+  void WriteByte(unsigned char value);
+  void WriteVarint(uint64 value);
+  void WriteSignedVarint(int64 value);
+  void WriteDouble(double value);
+  void WriteString(const StringPiece& value);
+
+  // Writes |timestamp| relative to the previous one written.
+  void WriteTimestamp(int64 timestamp);
+
+ private:
+  void AddStringRecord(const StringPiece& str);
+
+  int process_id_;
+  std::string records_;
+  uint32 next_string_id_;
+  int64 last_timestamp_;
+
+  // String ids by address and by content.
+  hash_map<uintptr_t, uint32> string_ids_;
+  hash_map<std::string, uint32> copied_string_ids_;
+
+  DISALLOW_COPY_AND_ASSIGN(TraceEventBinaryWriter);
+};
+
+}  // namespace debug
+}  // namespace base
+
+#endif  // BASE_DEBUG_TRACE_EVENT_BINARY_H_
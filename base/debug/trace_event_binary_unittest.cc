@@ -0,0 +1,278 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/debug/trace_event_binary.h"
+
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/debug/trace_event.h"
+#include "base/memory/ref_counted_memory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace debug {
+
+namespace {
+
+struct DecodedEvent {
+  char phase;
+  std::string category;
+  std::string name;
+  int64 timestamp;
+  int64 duration;
+  std::vector<std::string> arg_names;
+  std::vector<unsigned char> arg_types;
+  std::vector<int64> int_values;
+  std::vector<std::string> string_values;
+};
+
+// Decodes the segments of a binary trace, as
+// tools/tracing/binary_trace_to_json.py does.
+class Decoder {
+ public:
+  explicit Decoder(const std::string& data)
+      : data_(data), pos_(0), ok_(true) {}
+
+  bool Decode(std::vector<DecodedEvent>* events) {
+    while (ok_ && pos_ < data_.size()) {
+      if (data_.compare(pos_, 4, TraceEventBinaryWriter::kMagic) != 0)
+        return false;
+      pos_ += 4;
+      if (ReadVarint() != static_cast<uint64>(TraceEventBinaryWriter::kVersion))
+        return false;
+      ReadSignedVarint();  // Process id.
+      size_t end = pos_ + ReadVarint();
+      if (end > data_.size())
+        return false;
+
+      std::vector<std::string> strings;
+      int64 timestamp = 0;
+      while (ok_ && pos_ < end) {
+        switch (ReadByte()) {
+          case TraceEventBinaryWriter::RECORD_STRING:
+            strings.push_back(ReadString());
+            break;
+          case TraceEventBinaryWriter::RECORD_EVENT:
+            events->push_back(ReadEvent(strings, &timestamp));
+            break;
+          default:
+            return false;
+        }
+      }
+    }
+    return ok_;
+  }
+
+ private:
+  DecodedEvent ReadEvent(const std::vector<std::string>& strings,
+                         int64* timestamp) {
+    DecodedEvent event;
+    event.phase = static_cast<char>(ReadByte());
+    ReadByte();  // Flags.
+    unsigned char fields = ReadByte();
+    event.category = strings[ReadVarint()];
+    event.name = strings[ReadVarint()];
+    ReadSignedVarint();  // Thread id.
+    *timestamp += ReadSignedVarint();
+    event.timestamp = *timestamp;
+    if (fields & TraceEventBinaryWriter::FIELD_THREAD_TIMESTAMP)
+      ReadSignedVarint();
+    event.duration = -1;
+    if (fields & TraceEventBinaryWriter::FIELD_DURATION)
+      event.duration = ReadSignedVarint();
+    if (fields & TraceEventBinaryWriter::FIELD_THREAD_DURATION)
+      ReadSignedVarint();
+    if (fields & TraceEventBinaryWriter::FIELD_ID)
+      ReadVarint();
+    int num_args = ReadByte();
+    for (int i = 0; i < num_args; ++i) {
+      event.arg_names.push_back(strings[ReadVarint()]);
+      unsigned char type = ReadByte();
+      event.arg_types.push_back(type);
+      event.int_values.push_back(0);
+      event.string_values.push_back(std::string());
+      switch (type) {
+        case TRACE_VALUE_TYPE_BOOL:
+          event.int_values.back() = ReadByte();
+          break;
+        case TRACE_VALUE_TYPE_UINT:
+        case TRACE_VALUE_TYPE_POINTER:
+          event.int_values.back() = static_cast<int64>(ReadVarint());
+          break;
+        case TRACE_VALUE_TYPE_INT:
+          event.int_values.back() = ReadSignedVarint();
+          break;
+        case TRACE_VALUE_TYPE_DOUBLE:
+          for (int j = 0; j < 8; ++j)
+            ReadByte();
+          break;
+        case TRACE_VALUE_TYPE_STRING:
+        case TRACE_VALUE_TYPE_COPY_STRING:
+        case TRACE_VALUE_TYPE_CONVERTABLE:
+          event.string_values.back() = ReadString();
+          break;
+        default:
+          ok_ = false;
+          break;
+      }
+    }
+    return event;
+  }
+
+  unsigned char ReadByte() {
+    if (pos_ >= data_.size()) {
+      ok_ = false;
+      return 0;
+    }
+    return static_cast<unsigned char>(data_[pos_++]);
+  }
+
+  uint64 ReadVarint() {
+    uint64 value = 0;
+    for (int shift = 0; ok_ && shift < 64; shift += 7) {
+      unsigned char byte = ReadByte();
+      value |= static_cast<uint64>(byte & 0x7f) << shift;
+      if (!(byte & 0x80))
+        break;
+    }
+    return value;
+  }
+
+  int64 ReadSignedVarint() {
+    uint64 value = ReadVarint();
+    return static_cast<int64>(value >> 1) ^ -static_cast<int64>(value & 1);
+  }
+
+  std::string ReadString() {
+    size_t length = ReadVarint();
+    if (length > data_.size() - pos_) {
+      ok_ = false;
+      return std::string();
+    }
+    pos_ += length;
+    return data_.substr(pos_ - length, length);
+  }
+
+  const std::string& data_;
+  size_t pos_;
+  bool ok_;
+};
+
+void AppendTraceData(std::string* trace,
+                     const scoped_refptr<RefCountedString>& events_str,
+                     bool has_more_events) {
+  trace->append(events_str->data());
+}
+
+class TraceEventBinaryTest : public testing::Test {
+ public:
+  virtual void SetUp() OVERRIDE {
+    TraceLog::DeleteForTesting();
+  }
+
+  virtual void TearDown() OVERRIDE {
+    TraceLog::DeleteForTesting();
+  }
+
+ protected:
+  void BeginTrace() {
+    TraceLog::GetInstance()->SetEnabled(
+        CategoryFilter("*"), TraceLog::RECORDING_MODE,
+        static_cast<TraceLog::Options>(TraceLog::RECORD_UNTIL_FULL |
+                                       TraceLog::BINARY_OUTPUT));
+  }
+
+  std::string EndTraceAndFlush() {
+    std::string trace;
+    TraceLog::GetInstance()->SetDisabled();
+    TraceLog::GetInstance()->Flush(Bind(&AppendTraceData, &trace));
+    return trace;
+  }
+
+  // Returns the events named |name|.
+  std::vector<DecodedEvent> FindEvents(const std::vector<DecodedEvent>& events,
+                                       const std::string& name) {
+    std::vector<DecodedEvent> found;
+    for (size_t i = 0; i < events.size(); ++i) {
+      if (events[i].name == name)
+        found.push_back(events[i]);
+    }
+    return found;
+  }
+};
+
+}  // namespace
+
+TEST(TraceEventBinaryWriterTest, InternsStrings) {
+  TraceEventBinaryWriter writer(1);
+  const char kName[] = "name";
+  std::string copy(kName);
+  EXPECT_EQ(0u, writer.InternString(kName, false));
+  EXPECT_EQ(0u, writer.InternString(kName, false));
+  EXPECT_EQ(1u, writer.InternString("other", false));
+  EXPECT_EQ(2u, writer.InternString(copy.c_str(), true));
+  copy = "another";
+  EXPECT_EQ(3u, writer.InternString(copy.c_str(), true));
+  copy = kName;
+  EXPECT_EQ(2u, writer.InternString(copy.c_str(), true));
+
+  // The string table restarts with each segment.
+  std::string segments;
+  writer.FinishSegment(&segments);
+  EXPECT_TRUE(writer.empty());
+  EXPECT_EQ(0u, writer.InternString("other", false));
+  writer.FinishSegment(&segments);
+
+  std::vector<DecodedEvent> events;
+  EXPECT_TRUE(Decoder(segments).Decode(&events));
+  EXPECT_TRUE(events.empty());
+}
+
+TEST_F(TraceEventBinaryTest, FlushAsBinary) {
+  BeginTrace();
+  {
+    TRACE_EVENT1("cat1", "complete", "count", -5);
+  }
+  std::string name = "copied";
+  TRACE_EVENT_COPY_INSTANT1("cat2", name.c_str(), TRACE_EVENT_SCOPE_THREAD,
+                            "text", "value");
+  TRACE_EVENT_COPY_INSTANT1("cat2", name.c_str(), TRACE_EVENT_SCOPE_THREAD,
+                            "text", "value");
+  std::string trace = EndTraceAndFlush();
+
+  std::vector<DecodedEvent> events;
+  ASSERT_TRUE(Decoder(trace).Decode(&events));
+
+  std::vector<DecodedEvent> complete = FindEvents(events, "complete");
+  ASSERT_EQ(1u, complete.size());
+  EXPECT_EQ(TRACE_EVENT_PHASE_COMPLETE, complete[0].phase);
+  EXPECT_EQ("cat1", complete[0].category);
+  EXPECT_LE(0, complete[0].duration);
+  ASSERT_EQ(1u, complete[0].arg_names.size());
+  EXPECT_EQ("count", complete[0].arg_names[0]);
+  EXPECT_EQ(TRACE_VALUE_TYPE_INT, complete[0].arg_types[0]);
+  EXPECT_EQ(-5, complete[0].int_values[0]);
+
+  std::vector<DecodedEvent> copied = FindEvents(events, "copied");
+  ASSERT_EQ(2u, copied.size());
+  for (size_t i = 0; i < copied.size(); ++i) {
+    EXPECT_EQ(TRACE_EVENT_PHASE_INSTANT, copied[i].phase);
+    EXPECT_EQ("cat2", copied[i].category);
+    ASSERT_EQ(1u, copied[i].arg_names.size());
+    EXPECT_EQ("text", copied[i].arg_names[0]);
+    EXPECT_EQ(TRACE_VALUE_TYPE_COPY_STRING, copied[i].arg_types[0]);
+    EXPECT_EQ("value", copied[i].string_values[0]);
+  }
+  EXPECT_LE(complete[0].timestamp, copied[0].timestamp);
+  EXPECT_LE(copied[0].timestamp, copied[1].timestamp);
+
+  // The strings of the events are only written once.
+  EXPECT_EQ(std::string::npos,
+            trace.find("copied", trace.find("copied") + 1));
+}
+
+}  // namespace debug
+}  // namespace base
@@ -11,6 +11,7 @@
 #include "base/command_line.h"
 #include "base/debug/leak_annotations.h"
 #include "base/debug/trace_event.h"
+#include "base/debug/trace_event_binary.h"
 #include "base/debug/trace_event_synthetic_delay.h"
 #include "base/float_util.h"
 #include "base/format_macros.h"
@@ -761,6 +762,88 @@ void TraceEvent::AppendAsJSON(std::string* out) const {
   *out += "}";
 }
 
+void TraceEvent::AppendAsBinary(TraceEventBinaryWriter* writer) const {
+  // Strings have to be in the string table before the event refers to them.
+  bool copy = !!(flags_ & TRACE_EVENT_FLAG_COPY);
+  uint32 category_id = writer->InternString(
+      TraceLog::GetCategoryGroupName(category_group_enabled_), false);
+  uint32 name_id = writer->InternString(name_, copy);
+  int num_args = 0;
+  uint32 arg_name_ids[kTraceMaxNumArgs];
+  for (; num_args < kTraceMaxNumArgs && arg_names_[num_args]; ++num_args)
+    arg_name_ids[num_args] = writer->InternString(arg_names_[num_args], copy);
+
+  unsigned char fields = 0;
+  if (!thread_timestamp_.is_null())
+    fields |= TraceEventBinaryWriter::FIELD_THREAD_TIMESTAMP;
+  if (phase_ == TRACE_EVENT_PHASE_COMPLETE) {
+    if (duration_.ToInternalValue() != -1)
+      fields |= TraceEventBinaryWriter::FIELD_DURATION;
+    if (!thread_timestamp_.is_null() &&
+        thread_duration_.ToInternalValue() != -1) {
+      fields |= TraceEventBinaryWriter::FIELD_THREAD_DURATION;
+    }
+  }
+  if (flags_ & TRACE_EVENT_FLAG_HAS_ID)
+    fields |= TraceEventBinaryWriter::FIELD_ID;
+
+  writer->WriteByte(TraceEventBinaryWriter::RECORD_EVENT);
+  writer->WriteByte(phase_);
+  writer->WriteByte(flags_);
+  writer->WriteByte(fields);
+  writer->WriteVarint(category_id);
+  writer->WriteVarint(name_id);
+  writer->WriteSignedVarint(thread_id_);
+  writer->WriteTimestamp(timestamp_.ToInternalValue());
+  if (fields & TraceEventBinaryWriter::FIELD_THREAD_TIMESTAMP)
+    writer->WriteSignedVarint(thread_timestamp_.ToInternalValue());
+  if (fields & TraceEventBinaryWriter::FIELD_DURATION)
+    writer->WriteSignedVarint(duration_.ToInternalValue());
+  if (fields & TraceEventBinaryWriter::FIELD_THREAD_DURATION)
+    writer->WriteSignedVarint(thread_duration_.ToInternalValue());
+  if (fields & TraceEventBinaryWriter::FIELD_ID)
+    writer->WriteVarint(id_);
+
+  writer->WriteByte(static_cast<unsigned char>(num_args));
+  for (int i = 0; i < num_args; ++i) {
+    writer->WriteVarint(arg_name_ids[i]);
+    writer->WriteByte(arg_types_[i]);
+    const TraceValue& value = arg_values_[i];
+    switch (arg_types_[i]) {
+      case TRACE_VALUE_TYPE_BOOL:
+        writer->WriteByte(value.as_bool ? 1 : 0);
+        break;
+      case TRACE_VALUE_TYPE_UINT:
+        writer->WriteVarint(value.as_uint);
+        break;
+      case TRACE_VALUE_TYPE_INT:
+        writer->WriteSignedVarint(value.as_int);
+        break;
+      case TRACE_VALUE_TYPE_DOUBLE:
+        writer->WriteDouble(value.as_double);
+        break;
+      case TRACE_VALUE_TYPE_POINTER:
+        writer->WriteVarint(static_cast<uint64>(
+            reinterpret_cast<uintptr_t>(value.as_pointer)));
+        break;
+      case TRACE_VALUE_TYPE_STRING:
+      case TRACE_VALUE_TYPE_COPY_STRING:
+        writer->WriteString(value.as_string ? value.as_string : "NULL");
+        break;
+      case TRACE_VALUE_TYPE_CONVERTABLE: {
+        std::string json;
+        convertable_values_[i]->AppendAsTraceFormat(&json);
+        writer->WriteString(json);
+        break;
+      }
+      default:
+        NOTREACHED() << "Don't know how to write this value";
+        writer->WriteString("");
+        break;
+    }
+  }
+}
+
 void TraceEvent::AppendPrettyPrinted(std::ostringstream* out) const {
   *out << name_ << "[";
   *out << TraceLog::GetCategoryGroupName(category_group_enabled_);
@@ -990,6 +1073,10 @@ class TraceLog::ThreadLocalEventBuffer
 
   int generation() const { return generation_; }
 
+  // Returns true if the next AddTraceEvent() takes a new chunk from the main
+  // buffer.
+  bool NeedsNewChunk() const { return !chunk_ || chunk_->IsFull(); }
+
  private:
   // MessageLoop::DestructionObserver
   virtual void WillDestroyCurrentMessageLoop() OVERRIDE;
@@ -1053,13 +1140,11 @@ TraceEvent* TraceLog::ThreadLocalEventBuffer::AddTraceEvent(
     TraceEventHandle* handle) {
   CheckThisIsCurrentBuffer();
 
-  if (chunk_ && chunk_->IsFull()) {
+  if (NeedsNewChunk()) {
+    // Returns the full chunk and takes a new one under a single acquisition
+    // of the lock, which is the only time a thread with a buffer takes it.
     AutoLock lock(trace_log_->lock_);
     FlushWhileLocked();
-    chunk_.reset();
-  }
-  if (!chunk_) {
-    AutoLock lock(trace_log_->lock_);
     chunk_ = trace_log_->logged_events_->GetChunk(&chunk_index_);
     trace_log_->CheckIfBufferIsFullWhileLocked();
   }
@@ -1600,10 +1685,13 @@ void TraceLog::ConvertTraceEventsToTraceFormat(
 
   // The callback need to be called at least once even if there is no events
   // to let the caller know the completion of flush.
+  // Each batch of binary output is a segment of its own, so that the caller
+  // can mix the batches of several processes.
+  bool binary = !!(trace_options() & BINARY_OUTPUT);
   bool has_more_events = true;
   do {
-    scoped_refptr<RefCountedString> json_events_str_ptr =
-        new RefCountedString();
+    scoped_refptr<RefCountedString> events_str_ptr = new RefCountedString();
+    TraceEventBinaryWriter binary_writer(process_id_);
 
     for (size_t i = 0; i < kTraceEventBatchChunks; ++i) {
       const TraceBufferChunk* chunk = logged_events->NextChunk();
@@ -1612,13 +1700,18 @@ void TraceLog::ConvertTraceEventsToTraceFormat(
         break;
       }
       for (size_t j = 0; j < chunk->size(); ++j) {
+        if (binary) {
+          binary_writer.AppendEvent(*chunk->GetEventAt(j));
+          continue;
+        }
         if (i > 0 || j > 0)
-          json_events_str_ptr->data().append(",");
-        chunk->GetEventAt(j)->AppendAsJSON(&(json_events_str_ptr->data()));
+          events_str_ptr->data().append(",");
+        chunk->GetEventAt(j)->AppendAsJSON(&(events_str_ptr->data()));
       }
     }
+    binary_writer.FinishSegment(&events_str_ptr->data());
 
-    flush_output_callback.Run(json_events_str_ptr, has_more_events);
+    flush_output_callback.Run(events_str_ptr, has_more_events);
   } while (has_more_events);
 }
 
@@ -1788,8 +1881,12 @@ TraceEventHandle TraceLog::AddTraceEventWithThreadIdAndTimestamp(
   }
 
   // Check and update the current thread name only if the event is for the
-  // current thread to avoid locks in most cases.
-  if (thread_id == static_cast<int>(PlatformThread::CurrentId())) {
+  // current thread to avoid locks in most cases.  A thread with a local event
+  // buffer only checks when it takes a new chunk, so that filling a chunk
+  // takes no locks at all.
+  if (thread_id == static_cast<int>(PlatformThread::CurrentId()) &&
+      (!thread_local_event_buffer ||
+       thread_local_event_buffer->NeedsNewChunk())) {
     const char* new_name = ThreadIdNameManager::GetInstance()->
         GetName(thread_id);
     // Check if the thread name has been set or changed since the previous
@@ -87,6 +87,8 @@ struct TraceEventHandle {
 
 const int kTraceMaxNumArgs = 2;
 
+class TraceEventBinaryWriter;
+
 class BASE_EXPORT TraceEvent {
  public:
   union TraceValue {
@@ -126,6 +128,8 @@ class BASE_EXPORT TraceEvent {
 
   // Serialize event data to JSON
   void AppendAsJSON(std::string* out) const;
+  // Serialize event data in the format of TraceEventBinaryWriter.
+  void AppendAsBinary(TraceEventBinaryWriter* writer) const;
   void AppendPrettyPrinted(std::ostringstream* out) const;
 
   static void AppendValueAsJSON(unsigned char type,
@@ -385,6 +389,9 @@ class BASE_EXPORT TraceLog {
 
     // Echo to console. Events are discarded.
     ECHO_TO_CONSOLE = 1 << 3,
+
+    // Flush in the binary format of TraceEventBinaryWriter instead of JSON.
+    BINARY_OUTPUT = 1 << 4,
   };
 
   // The pointer returned from GetCategoryGroupEnabledInternal() points to a
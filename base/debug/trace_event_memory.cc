@@ -199,8 +199,11 @@ void TraceMemoryController::StartProfiling() {
   if (!InitThreadLocalStorage())
     return;
   ScopedTraceMemory::set_enabled(true);
-  // Call ::HeapProfilerWithPseudoStackStart().
-  heap_profiler_start_function_(&GetPseudoStack);
+  // Call ::HeapProfilerWithPseudoStackStartSampled(). Sampling keeps the
+  // profiler cheap enough to leave on, while still attributing most of the
+  // memory to the right trace scopes.
+  const size_t kSamplingIntervalBytes = 128 * 1024;
+  heap_profiler_start_function_(&GetPseudoStack, kSamplingIntervalBytes);
   const int kDumpIntervalSeconds = 5;
   dump_timer_.Start(FROM_HERE,
                     TimeDelta::FromSeconds(kDumpIntervalSeconds),
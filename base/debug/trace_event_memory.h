@@ -31,7 +31,8 @@ class BASE_EXPORT TraceMemoryController
     : public TraceLog::EnabledStateObserver {
  public:
   typedef int (*StackGeneratorFunction)(int skip_count, void** stack);
-  typedef void (*HeapProfilerStartFunction)(StackGeneratorFunction callback);
+  typedef void (*HeapProfilerStartFunction)(StackGeneratorFunction callback,
+                                            size_t sampling_interval);
   typedef void (*HeapProfilerStopFunction)();
   typedef char* (*GetHeapProfileFunction)();
 
@@ -43,7 +43,7 @@ TEST_F(TraceMemoryTest, TraceMemoryController) {
   scoped_ptr<TraceMemoryController> controller(
       new TraceMemoryController(
           message_loop.message_loop_proxy(),
-          ::HeapProfilerWithPseudoStackStart,
+          ::HeapProfilerWithPseudoStackStartSampled,
           ::HeapProfilerStop,
           ::GetHeapProfile));
   EXPECT_EQ(1u, TraceLog::GetInstance()->GetObserverCountForTest());
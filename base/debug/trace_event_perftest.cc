@@ -0,0 +1,134 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures the cost of a TRACE_EVENT0 while recording, on threads that fill
+// a thread local event buffer and on threads without a message loop, which
+// add their events to the main buffer under TraceLog's lock.
+
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/bind.h"
+#include "base/debug/trace_event.h"
+#include "base/message_loop/message_loop.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/simple_thread.h"
+#include "base/threading/thread.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+namespace debug {
+
+namespace {
+
+const int kEventsPerThread = 200000;
+const int kNumThreads = 4;
+
+void AddEvents() {
+  for (int i = 0; i < kEventsPerThread; ++i) {
+    TRACE_EVENT0("perftest", "TraceEventPerfTest");
+  }
+}
+
+void AddEventsAndSignal(WaitableEvent* done) {
+  AddEvents();
+  done->Signal();
+}
+
+class AddEventsDelegate : public DelegateSimpleThread::Delegate {
+ public:
+  virtual void Run() OVERRIDE {
+    AddEvents();
+  }
+};
+
+class TraceEventPerfTest : public testing::Test {
+ public:
+  virtual void SetUp() OVERRIDE {
+    TraceLog::GetInstance()->SetEnabled(CategoryFilter("perftest"),
+                                        TraceLog::RECORDING_MODE,
+                                        TraceLog::RECORD_CONTINUOUSLY);
+    start_ = TimeTicks::HighResNow();
+  }
+
+  virtual void TearDown() OVERRIDE {
+    TraceLog::GetInstance()->SetDisabled();
+  }
+
+ protected:
+  void PrintResult(const std::string& trace, int num_threads) {
+    double elapsed_ns = (TimeTicks::HighResNow() - start_).InMillisecondsF() *
+        1e6;
+    perf_test::PrintResult("trace_event0", "", trace,
+                           elapsed_ns / kEventsPerThread, "ns", true);
+    perf_test::PrintResult("trace_event0_throughput", "", trace,
+                           num_threads * kEventsPerThread /
+                               (elapsed_ns / 1e6),
+                           "events/ms", true);
+  }
+
+ private:
+  TimeTicks start_;
+};
+
+}  // namespace
+
+TEST_F(TraceEventPerfTest, ThreadLocalBuffer) {
+  MessageLoop message_loop;
+  AddEvents();
+  PrintResult("thread_local_buffer", 1);
+}
+
+TEST_F(TraceEventPerfTest, SharedBuffer) {
+  AddEventsDelegate delegate;
+  DelegateSimpleThread thread(&delegate, "TraceEventPerfTest");
+  thread.Start();
+  thread.Join();
+  PrintResult("shared_buffer", 1);
+}
+
+TEST_F(TraceEventPerfTest, ContendedThreadLocalBuffers) {
+  std::vector<Thread*> threads;
+  std::vector<WaitableEvent*> done;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.push_back(new Thread("TraceEventPerfTest"));
+    ASSERT_TRUE(threads[i]->Start());
+    done.push_back(new WaitableEvent(false, false));
+    threads[i]->message_loop()->PostTask(
+        FROM_HERE, Bind(&AddEventsAndSignal, done[i]));
+  }
+  for (int i = 0; i < kNumThreads; ++i) {
+    done[i]->Wait();
+    delete done[i];
+  }
+  PrintResult(StringPrintf("%d_thread_local_buffers", kNumThreads),
+              kNumThreads);
+  for (int i = 0; i < kNumThreads; ++i)
+    delete threads[i];
+}
+
+TEST_F(TraceEventPerfTest, ContendedSharedBuffer) {
+  std::vector<AddEventsDelegate*> delegates;
+  std::vector<DelegateSimpleThread*> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    delegates.push_back(new AddEventsDelegate);
+    threads.push_back(new DelegateSimpleThread(delegates[i],
+                                               "TraceEventPerfTest"));
+    threads[i]->Start();
+  }
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads[i]->Join();
+    delete threads[i];
+    delete delegates[i];
+  }
+  PrintResult(StringPrintf("%d_threads_shared_buffer", kNumThreads),
+              kNumThreads);
+}
+
+}  // namespace debug
+}  // namespace base
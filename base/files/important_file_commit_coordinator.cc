@@ -0,0 +1,167 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/important_file_commit_coordinator.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/critical_closure.h"
+#include "base/files/important_file_writer.h"
+#include "base/location.h"
+#include "base/logging.h"
+#include "base/memory/scoped_vector.h"
+#include "base/sequenced_task_runner.h"
+
+namespace base {
+
+namespace {
+
+typedef std::pair<FilePath, std::string> FileData;
+
+struct DueCommit {
+  TimeTicks deadline;
+  FileData file;
+  Callback<void(bool)> callback;
+};
+
+bool DeadlineLess(const DueCommit* a, const DueCommit* b) {
+  return a->deadline < b->deadline;
+}
+
+}  // namespace
+
+ImportantFileCommitCoordinator::ImportantFileCommitCoordinator(
+    SequencedTaskRunner* task_runner,
+    const TimeDelta& batch_window)
+    : task_runner_(task_runner),
+      batch_window_(batch_window) {
+  DCHECK(task_runner_.get());
+}
+
+ImportantFileCommitCoordinator::~ImportantFileCommitCoordinator() {
+}
+
+void ImportantFileCommitCoordinator::Commit(
+    const FilePath& path,
+    const std::string& data,
+    const TimeTicks& deadline,
+    const Callback<void(bool)>& callback) {
+  AutoLock lock(lock_);
+  std::pair<PendingCommitMap::iterator, bool> result =
+      pending_commits_.insert(std::make_pair(path, PendingCommit()));
+  PendingCommit& commit = result.first->second;
+  commit.data = data;
+  commit.callback = callback;
+  if (result.second || deadline < commit.deadline)
+    commit.deadline = deadline;
+  ScheduleWriteLocked(commit.deadline);
+}
+
+void ImportantFileCommitCoordinator::CommitNow(const FilePath& path) {
+  AutoLock lock(lock_);
+  PendingCommitMap::iterator it = pending_commits_.find(path);
+  if (it == pending_commits_.end())
+    return;
+  it->second.deadline = TimeTicks::Now();
+  ScheduleWriteLocked(it->second.deadline);
+}
+
+bool ImportantFileCommitCoordinator::HasPendingCommits() const {
+  AutoLock lock(lock_);
+  return !pending_commits_.empty();
+}
+
+bool ImportantFileCommitCoordinator::HasPendingCommit(
+    const FilePath& path) const {
+  AutoLock lock(lock_);
+  return pending_commits_.find(path) != pending_commits_.end();
+}
+
+void ImportantFileCommitCoordinator::ScheduleWriteLocked(
+    const TimeTicks& deadline) {
+  lock_.AssertAcquired();
+  if (!scheduled_write_.is_null() && scheduled_write_ <= deadline)
+    return;
+
+  scheduled_write_ = deadline;
+  TimeDelta delay = std::max(TimeDelta(), deadline - TimeTicks::Now());
+  if (!task_runner_->PostDelayedTask(
+          FROM_HERE,
+          MakeCriticalClosure(
+              Bind(&ImportantFileCommitCoordinator::WriteDueCommits, this)),
+          delay)) {
+    // Posting the task to the background message loop is not expected to
+    // fail, but if it does the commits stay pending until the next one is
+    // posted successfully.
+    NOTREACHED();
+    scheduled_write_ = TimeTicks();
+  }
+}
+
+void ImportantFileCommitCoordinator::WriteDueCommits() {
+  DCHECK(task_runner_->RunsTasksOnCurrentThread());
+
+  ScopedVector<DueCommit> due;
+  {
+    AutoLock lock(lock_);
+    TimeTicks now = TimeTicks::Now();
+    if (scheduled_write_ <= now)
+      scheduled_write_ = TimeTicks();
+
+    TimeTicks cutoff = now + batch_window_;
+    TimeTicks next_deadline;
+    for (PendingCommitMap::iterator it = pending_commits_.begin();
+         it != pending_commits_.end();) {
+      if (it->second.deadline > cutoff) {
+        if (next_deadline.is_null() || it->second.deadline < next_deadline)
+          next_deadline = it->second.deadline;
+        ++it;
+        continue;
+      }
+      DueCommit* commit = new DueCommit;
+      commit->deadline = it->second.deadline;
+      commit->file.first = it->first;
+      commit->file.second.swap(it->second.data);
+      commit->callback = it->second.callback;
+      due.push_back(commit);
+      pending_commits_.erase(it++);
+    }
+    if (!next_deadline.is_null())
+      ScheduleWriteLocked(next_deadline);
+  }
+
+  // Write the directories in the order of their earliest deadline, and the
+  // files of each directory in deadline order.
+  std::sort(due.begin(), due.end(), &DeadlineLess);
+  std::vector<std::vector<FileData> > groups;
+  std::vector<std::vector<const DueCommit*> > group_commits;
+  std::map<FilePath, size_t> group_index;
+  for (size_t i = 0; i < due.size(); ++i) {
+    FilePath dir = due[i]->file.first.DirName();
+    std::pair<std::map<FilePath, size_t>::iterator, bool> result =
+        group_index.insert(std::make_pair(dir, groups.size()));
+    if (result.second) {
+      groups.push_back(std::vector<FileData>());
+      group_commits.push_back(std::vector<const DueCommit*>());
+    }
+    std::vector<FileData>& group = groups[result.first->second];
+    group.push_back(FileData());
+    group.back().first = due[i]->file.first;
+    group.back().second.swap(due[i]->file.second);
+    group_commits[result.first->second].push_back(due[i]);
+  }
+  for (size_t i = 0; i < groups.size(); ++i) {
+    std::vector<bool> saved;
+    ImportantFileWriter::WriteFilesAtomically(groups[i], &saved);
+    for (size_t j = 0; j < group_commits[i].size(); ++j) {
+      if (!group_commits[i][j]->callback.is_null())
+        group_commits[i][j]->callback.Run(saved[j]);
+    }
+  }
+}
+
+}  // namespace base
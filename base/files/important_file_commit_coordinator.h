@@ -0,0 +1,100 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_FILES_IMPORTANT_FILE_COMMIT_COORDINATOR_H_
+#define BASE_FILES_IMPORTANT_FILE_COMMIT_COORDINATOR_H_
+
+#include <map>
+#include <string>
+
+#include "base/base_export.h"
+#include "base/basictypes.h"
+#include "base/callback.h"
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+
+namespace base {
+
+class SequencedTaskRunner;
+
+// Saves files for many ImportantFileWriters, so that the flushes of files
+// written at about the same time are done together instead of each writer
+// hitting the disk on its own.
+//
+// Each commit has a deadline. When the earliest deadline is reached, every
+// commit due within |batch_window| of it is written too. The commits are
+// written in deadline order, grouped by directory, each group with
+// ImportantFileWriter::WriteFilesAtomically(), so every file is still
+// replaced atomically. A commit for a path that already has one pending
+// replaces its data, and keeps the earlier of the two deadlines.
+//
+// Commit() may be called on any thread; the files are written on
+// |task_runner|.
+class BASE_EXPORT ImportantFileCommitCoordinator
+    : public RefCountedThreadSafe<ImportantFileCommitCoordinator> {
+ public:
+  ImportantFileCommitCoordinator(SequencedTaskRunner* task_runner,
+                                 const TimeDelta& batch_window);
+
+  SequencedTaskRunner* task_runner() const { return task_runner_.get(); }
+  const TimeDelta& batch_window() const { return batch_window_; }
+
+  // Saves |data| to |path| once |deadline| is reached, or earlier if another
+  // commit is written within |batch_window| of it. Commits with a deadline in
+  // the future are lost if |task_runner| shuts down before they are due.
+  // Unless the commit is replaced by a later one for |path| first, |callback|
+  // is run on |task_runner| with whether |data| was saved, if it is not null.
+  void Commit(const FilePath& path,
+              const std::string& data,
+              const TimeTicks& deadline,
+              const Callback<void(bool)>& callback);
+
+  // Makes the pending commit for |path|, if there is one, due now.
+  void CommitNow(const FilePath& path);
+
+  // Returns true if there are commits which have not been written yet.
+  bool HasPendingCommits() const;
+
+  // Returns true if the commit for |path| has not been written yet.
+  bool HasPendingCommit(const FilePath& path) const;
+
+ private:
+  friend class RefCountedThreadSafe<ImportantFileCommitCoordinator>;
+
+  struct PendingCommit {
+    std::string data;
+    TimeTicks deadline;
+    Callback<void(bool)> callback;
+  };
+  typedef std::map<FilePath, PendingCommit> PendingCommitMap;
+
+  ~ImportantFileCommitCoordinator();
+
+  // Makes sure WriteDueCommits() runs by |deadline|. |lock_| must be held.
+  void ScheduleWriteLocked(const TimeTicks& deadline);
+
+  // Writes the commits due by now plus |batch_window_|. Runs on
+  // |task_runner_|.
+  void WriteDueCommits();
+
+  const scoped_refptr<SequencedTaskRunner> task_runner_;
+  const TimeDelta batch_window_;
+
+  // Protects the members below.
+  mutable Lock lock_;
+
+  PendingCommitMap pending_commits_;
+
+  // The earliest time a WriteDueCommits() task is posted for, or null if
+  // none is.
+  TimeTicks scheduled_write_;
+
+  DISALLOW_COPY_AND_ASSIGN(ImportantFileCommitCoordinator);
+};
+
+}  // namespace base
+
+#endif  // BASE_FILES_IMPORTANT_FILE_COMMIT_COORDINATOR_H_
@@ -0,0 +1,179 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/important_file_commit_coordinator.h"
+
+#include <string>
+
+#include "base/file_util.h"
+#include "base/files/file_path.h"
+#include "base/files/important_file_writer.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+std::string GetFileContent(const FilePath& path) {
+  std::string content;
+  if (!ReadFileToString(path, &content))
+    return "<missing>";
+  return content;
+}
+
+class ImportantFileCommitCoordinatorTest : public testing::Test {
+ public:
+  virtual void SetUp() OVERRIDE {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    ASSERT_TRUE(CreateDirectory(temp_dir_.path().AppendASCII("a")));
+    ASSERT_TRUE(CreateDirectory(temp_dir_.path().AppendASCII("b")));
+  }
+
+ protected:
+  FilePath GetPath(const char* name) {
+    return temp_dir_.path().AppendASCII(name);
+  }
+
+  // Runs the message loop for |delay|.
+  void RunFor(const TimeDelta& delay) {
+    MessageLoop::current()->PostDelayedTask(
+        FROM_HERE, MessageLoop::QuitWhenIdleClosure(), delay);
+    MessageLoop::current()->Run();
+  }
+
+  MessageLoop loop_;
+  ScopedTempDir temp_dir_;
+};
+
+class Serializer : public ImportantFileWriter::DataSerializer {
+ public:
+  explicit Serializer(const std::string& data) : data_(data) {}
+
+  virtual bool SerializeData(std::string* output) OVERRIDE {
+    output->assign(data_);
+    return true;
+  }
+
+ private:
+  const std::string data_;
+};
+
+}  // namespace
+
+TEST_F(ImportantFileCommitCoordinatorTest, CommitNow) {
+  scoped_refptr<ImportantFileCommitCoordinator> coordinator(
+      new ImportantFileCommitCoordinator(MessageLoopProxy::current().get(),
+                                         TimeDelta()));
+  coordinator->Commit(GetPath("a/1"), "a1", TimeTicks::Now(),
+                      Callback<void(bool)>());
+  coordinator->Commit(GetPath("b/1"), "b1", TimeTicks::Now(),
+                      Callback<void(bool)>());
+  coordinator->Commit(GetPath("a/2"), "a2", TimeTicks::Now(),
+                      Callback<void(bool)>());
+  EXPECT_TRUE(coordinator->HasPendingCommits());
+  RunLoop().RunUntilIdle();
+
+  EXPECT_FALSE(coordinator->HasPendingCommits());
+  EXPECT_EQ("a1", GetFileContent(GetPath("a/1")));
+  EXPECT_EQ("a2", GetFileContent(GetPath("a/2")));
+  EXPECT_EQ("b1", GetFileContent(GetPath("b/1")));
+}
+
+TEST_F(ImportantFileCommitCoordinatorTest, LatestDataEarliestDeadline) {
+  scoped_refptr<ImportantFileCommitCoordinator> coordinator(
+      new ImportantFileCommitCoordinator(MessageLoopProxy::current().get(),
+                                         TimeDelta()));
+  TimeTicks now = TimeTicks::Now();
+  coordinator->Commit(GetPath("a/1"), "first", now,
+                      Callback<void(bool)>());
+  coordinator->Commit(GetPath("a/1"), "second", now + TimeDelta::FromDays(1),
+                      Callback<void(bool)>());
+  RunLoop().RunUntilIdle();
+
+  EXPECT_FALSE(coordinator->HasPendingCommits());
+  EXPECT_EQ("second", GetFileContent(GetPath("a/1")));
+}
+
+TEST_F(ImportantFileCommitCoordinatorTest, BatchWindow) {
+  scoped_refptr<ImportantFileCommitCoordinator> coordinator(
+      new ImportantFileCommitCoordinator(MessageLoopProxy::current().get(),
+                                         TimeDelta::FromHours(1)));
+  TimeTicks now = TimeTicks::Now();
+  coordinator->Commit(GetPath("a/late"), "late",
+                      now + TimeDelta::FromMinutes(30),
+                      Callback<void(bool)>());
+  coordinator->Commit(GetPath("b/later"), "later",
+                      now + TimeDelta::FromDays(1),
+                      Callback<void(bool)>());
+  coordinator->Commit(GetPath("a/now"), "now", now,
+                      Callback<void(bool)>());
+  RunLoop().RunUntilIdle();
+
+  // The commit due within the batch window of the first one is written with
+  // it, the other one waits.
+  EXPECT_EQ("now", GetFileContent(GetPath("a/now")));
+  EXPECT_EQ("late", GetFileContent(GetPath("a/late")));
+  EXPECT_FALSE(PathExists(GetPath("b/later")));
+  EXPECT_TRUE(coordinator->HasPendingCommits());
+}
+
+TEST_F(ImportantFileCommitCoordinatorTest, WaitsForDeadline) {
+  scoped_refptr<ImportantFileCommitCoordinator> coordinator(
+      new ImportantFileCommitCoordinator(MessageLoopProxy::current().get(),
+                                         TimeDelta()));
+  coordinator->Commit(GetPath("a/1"), "a1",
+                      TimeTicks::Now() + TimeDelta::FromMilliseconds(50),
+                      Callback<void(bool)>());
+  RunLoop().RunUntilIdle();
+  EXPECT_FALSE(PathExists(GetPath("a/1")));
+
+  RunFor(TimeDelta::FromMilliseconds(200));
+  EXPECT_FALSE(coordinator->HasPendingCommits());
+  EXPECT_EQ("a1", GetFileContent(GetPath("a/1")));
+}
+
+TEST_F(ImportantFileCommitCoordinatorTest, Writers) {
+  scoped_refptr<ImportantFileCommitCoordinator> coordinator(
+      new ImportantFileCommitCoordinator(MessageLoopProxy::current().get(),
+                                         TimeDelta::FromSeconds(1)));
+  ImportantFileWriter writer1(GetPath("a/1"), coordinator.get());
+  ImportantFileWriter writer2(GetPath("a/2"), coordinator.get());
+  writer1.WriteNow("foo");
+  writer2.WriteNow("bar");
+  RunLoop().RunUntilIdle();
+
+  EXPECT_FALSE(coordinator->HasPendingCommits());
+  EXPECT_EQ("foo", GetFileContent(GetPath("a/1")));
+  EXPECT_EQ("bar", GetFileContent(GetPath("a/2")));
+}
+
+TEST_F(ImportantFileCommitCoordinatorTest, ScheduledWriteDeadline) {
+  scoped_refptr<ImportantFileCommitCoordinator> coordinator(
+      new ImportantFileCommitCoordinator(MessageLoopProxy::current().get(),
+                                         TimeDelta::FromSeconds(10)));
+  ImportantFileWriter writer(GetPath("a/1"), coordinator.get());
+  writer.set_commit_interval(TimeDelta::FromSeconds(10));
+  Serializer serializer("foo");
+  writer.ScheduleWrite(&serializer);
+
+  // The data is handed over a batch window before its deadline, and waits
+  // for it in the coordinator.
+  RunFor(TimeDelta::FromMilliseconds(50));
+  EXPECT_TRUE(writer.HasPendingWrite());
+  EXPECT_TRUE(coordinator->HasPendingCommits());
+  EXPECT_FALSE(PathExists(GetPath("a/1")));
+
+  // Flushing the writer makes the commit due now.
+  writer.DoScheduledWrite();
+  RunLoop().RunUntilIdle();
+  EXPECT_FALSE(writer.HasPendingWrite());
+  EXPECT_FALSE(coordinator->HasPendingCommits());
+  EXPECT_EQ("foo", GetFileContent(GetPath("a/1")));
+}
+
+}  // namespace base
@@ -11,18 +11,26 @@
 #include "base/files/important_file_writer.h"
 
 #include <stdio.h>
+#include <string.h>
 
+#include <algorithm>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/critical_closure.h"
 #include "base/file_util.h"
 #include "base/files/file.h"
 #include "base/files/file_path.h"
+#include "base/files/important_file_commit_coordinator.h"
 #include "base/logging.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
 #include "base/metrics/histogram.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/task_runner.h"
+#include "base/thread_task_runner_handle.h"
 #include "base/threading/thread.h"
 #include "base/time/time.h"
 
@@ -49,48 +57,98 @@ void LogFailure(const FilePath& path, TempFileFailure failure_code,
                  << " : " << message;
 }
 
+// Runs |callback| with |result| on |task_runner|.
+void PostWriteResult(const scoped_refptr<SingleThreadTaskRunner>& task_runner,
+                     const Callback<void(bool)>& callback,
+                     bool result) {
+  task_runner->PostTask(FROM_HERE, Bind(callback, result));
+}
+
+// Saves |data| to |path| and runs |callback| with whether it was saved.
+void WriteFileAndReply(const FilePath& path,
+                       const std::string& data,
+                       const Callback<void(bool)>& callback) {
+  callback.Run(ImportantFileWriter::WriteFileAtomically(path, data));
+}
+
 }  // namespace
 
 // static
 bool ImportantFileWriter::WriteFileAtomically(const FilePath& path,
                                               const std::string& data) {
-  // Write the data to a temp file then rename to avoid data loss if we crash
-  // while writing the file. Ensure that the temp file is on the same volume
-  // as target file, so it can be moved in one step, and that the temp file
-  // is securely created.
-  FilePath tmp_file_path;
-  if (!base::CreateTemporaryFileInDir(path.DirName(), &tmp_file_path)) {
-    LogFailure(path, FAILED_CREATING, "could not create temporary file");
-    return false;
-  }
+  std::vector<std::pair<FilePath, std::string> > files(
+      1, std::make_pair(path, data));
+  return WriteFilesAtomically(files, NULL) == 1;
+}
 
-  File tmp_file(tmp_file_path, File::FLAG_OPEN | File::FLAG_WRITE);
-  if (!tmp_file.IsValid()) {
-    LogFailure(path, FAILED_OPENING, "could not open temporary file");
-    return false;
-  }
+// static
+size_t ImportantFileWriter::WriteFilesAtomically(
+    const std::vector<std::pair<FilePath, std::string> >& files,
+    std::vector<bool>* saved) {
+  // Write the data to temp files then rename to avoid data loss if we crash
+  // while writing the files. Ensure that each temp file is on the same volume
+  // as its target file, so it can be moved in one step, and that the temp
+  // files are securely created.
+  std::vector<FilePath> tmp_file_paths(files.size());
+  // The temp files that were written, or NULL.
+  ScopedVector<File> tmp_files;
+  tmp_files.resize(files.size());
+  for (size_t i = 0; i < files.size(); ++i) {
+    const FilePath& path = files[i].first;
+    const std::string& data = files[i].second;
+    if (!base::CreateTemporaryFileInDir(path.DirName(), &tmp_file_paths[i])) {
+      LogFailure(path, FAILED_CREATING, "could not create temporary file");
+      continue;
+    }
+
+    scoped_ptr<File> tmp_file(
+        new File(tmp_file_paths[i], File::FLAG_OPEN | File::FLAG_WRITE));
+    if (!tmp_file->IsValid()) {
+      LogFailure(path, FAILED_OPENING, "could not open temporary file");
+      continue;
+    }
 
-  // If this happens in the wild something really bad is going on.
-  CHECK_LE(data.length(), static_cast<size_t>(kint32max));
-  int bytes_written = tmp_file.Write(0, data.data(),
-                                     static_cast<int>(data.length()));
-  tmp_file.Flush();  // Ignore return value.
-  tmp_file.Close();
-
-  if (bytes_written < static_cast<int>(data.length())) {
-    LogFailure(path, FAILED_WRITING, "error writing, bytes_written=" +
-               IntToString(bytes_written));
-    base::DeleteFile(tmp_file_path, false);
-    return false;
+    // If this happens in the wild something really bad is going on.
+    CHECK_LE(data.length(), static_cast<size_t>(kint32max));
+    int bytes_written = tmp_file->Write(0, data.data(),
+                                        static_cast<int>(data.length()));
+
+    if (bytes_written < static_cast<int>(data.length())) {
+      tmp_file->Close();
+      LogFailure(path, FAILED_WRITING, "error writing, bytes_written=" +
+                 IntToString(bytes_written));
+      base::DeleteFile(tmp_file_paths[i], false);
+      continue;
+    }
+    tmp_files[i] = tmp_file.release();
   }
 
-  if (!base::ReplaceFile(tmp_file_path, path, NULL)) {
-    LogFailure(path, FAILED_RENAMING, "could not rename temporary file");
-    base::DeleteFile(tmp_file_path, false);
-    return false;
+  // Flush the temp files only once they have all been written, so that the
+  // file system can commit them to disk together.
+  for (size_t i = 0; i < tmp_files.size(); ++i) {
+    if (!tmp_files[i])
+      continue;
+    tmp_files[i]->Flush();  // Ignore return value.
+    tmp_files[i]->Close();
   }
 
-  return true;
+  if (saved)
+    saved->assign(files.size(), false);
+  size_t replaced = 0;
+  for (size_t i = 0; i < files.size(); ++i) {
+    if (!tmp_files[i])
+      continue;
+    if (!base::ReplaceFile(tmp_file_paths[i], files[i].first, NULL)) {
+      LogFailure(files[i].first, FAILED_RENAMING,
+                 "could not rename temporary file");
+      base::DeleteFile(tmp_file_paths[i], false);
+      continue;
+    }
+    if (saved)
+      (*saved)[i] = true;
+    ++replaced;
+  }
+  return replaced;
 }
 
 ImportantFileWriter::ImportantFileWriter(
@@ -99,7 +157,27 @@ ImportantFileWriter::ImportantFileWriter(
           task_runner_(task_runner),
           serializer_(NULL),
           commit_interval_(TimeDelta::FromMilliseconds(
-              kDefaultCommitIntervalMs)) {
+              kDefaultCommitIntervalMs)),
+          write_id_(0),
+          has_last_write_(false),
+          last_write_length_(0),
+          weak_factory_(this) {
+  DCHECK(CalledOnValidThread());
+  DCHECK(task_runner_.get());
+}
+
+ImportantFileWriter::ImportantFileWriter(
+    const FilePath& path, ImportantFileCommitCoordinator* coordinator)
+        : path_(path),
+          task_runner_(coordinator->task_runner()),
+          coordinator_(coordinator),
+          serializer_(NULL),
+          commit_interval_(TimeDelta::FromMilliseconds(
+              kDefaultCommitIntervalMs)),
+          write_id_(0),
+          has_last_write_(false),
+          last_write_length_(0),
+          weak_factory_(this) {
   DCHECK(CalledOnValidThread());
   DCHECK(task_runner_.get());
 }
@@ -113,30 +191,54 @@ ImportantFileWriter::~ImportantFileWriter() {
 
 bool ImportantFileWriter::HasPendingWrite() const {
   DCHECK(CalledOnValidThread());
-  return timer_.IsRunning();
+  return timer_.IsRunning() ||
+      (coordinator_.get() && coordinator_->HasPendingCommit(path_));
 }
 
 void ImportantFileWriter::WriteNow(const std::string& data) {
+  Write(data, TimeTicks::Now());
+}
+
+void ImportantFileWriter::Write(const std::string& data,
+                                const TimeTicks& deadline) {
   DCHECK(CalledOnValidThread());
   if (data.length() > static_cast<size_t>(kint32max)) {
     NOTREACHED();
     return;
   }
 
-  if (HasPendingWrite())
+  if (timer_.IsRunning())
     timer_.Stop();
 
+  // The data is only recorded as written once the write has succeeded, so
+  // that a failed write is retried by the next scheduled write.
+  has_last_write_ = false;
+  ++write_id_;
+  MD5Digest digest;
+  MD5Sum(data.data(), data.length(), &digest);
+  Callback<void(bool)> on_write_done =
+      Bind(&ImportantFileWriter::OnWriteDone, weak_factory_.GetWeakPtr(),
+           write_id_, digest, data.length());
+
+  if (coordinator_.get()) {
+    coordinator_->Commit(
+        path_, data, deadline,
+        Bind(&PostWriteResult, ThreadTaskRunnerHandle::Get(), on_write_done));
+    return;
+  }
+
   if (!task_runner_->PostTask(
           FROM_HERE,
           MakeCriticalClosure(
-              Bind(IgnoreResult(&ImportantFileWriter::WriteFileAtomically),
-                   path_, data)))) {
+              Bind(&WriteFileAndReply, path_, data,
+                   Bind(&PostWriteResult, ThreadTaskRunnerHandle::Get(),
+                        on_write_done))))) {
     // Posting the task to background message loop is not expected
     // to fail, but if it does, avoid losing data and just hit the disk
     // on the current thread.
     NOTREACHED();
 
-    WriteFileAtomically(path_, data);
+    on_write_done.Run(WriteFileAtomically(path_, data));
   }
 }
 
@@ -147,16 +249,47 @@ void ImportantFileWriter::ScheduleWrite(DataSerializer* serializer) {
   serializer_ = serializer;
 
   if (!timer_.IsRunning()) {
-    timer_.Start(FROM_HERE, commit_interval_, this,
-                 &ImportantFileWriter::DoScheduledWrite);
+    commit_deadline_ = TimeTicks::Now() + commit_interval_;
+    TimeDelta delay = commit_interval_;
+    if (coordinator_.get()) {
+      // Hand the data to the coordinator one batch window before it is due,
+      // so that it can be written together with the other commits due by
+      // then.
+      delay = std::max(TimeDelta(),
+                       commit_interval_ - coordinator_->batch_window());
+    }
+    timer_.Start(FROM_HERE, delay, this,
+                 &ImportantFileWriter::CommitScheduledWrite);
   }
 }
 
 void ImportantFileWriter::DoScheduledWrite() {
+  DCHECK(CalledOnValidThread());
+  if (!timer_.IsRunning() && coordinator_.get()) {
+    // The data was handed to the coordinator already, if it still has it.
+    coordinator_->CommitNow(path_);
+    return;
+  }
+  SerializeAndWrite(TimeTicks::Now());
+}
+
+void ImportantFileWriter::CommitScheduledWrite() {
+  SerializeAndWrite(commit_deadline_);
+}
+
+void ImportantFileWriter::SerializeAndWrite(const TimeTicks& deadline) {
   DCHECK(serializer_);
   std::string data;
   if (serializer_->SerializeData(&data)) {
-    WriteNow(data);
+    MD5Digest digest;
+    MD5Sum(data.data(), data.length(), &digest);
+    if (has_last_write_ && data.length() == last_write_length_ &&
+        memcmp(digest.a, last_write_digest_.a, sizeof(digest.a)) == 0) {
+      // The file already has this data.
+      timer_.Stop();
+    } else {
+      Write(data, deadline);
+    }
   } else {
     DLOG(WARNING) << "failed to serialize data to be saved in "
                   << path_.value().c_str();
@@ -164,4 +297,16 @@ void ImportantFileWriter::DoScheduledWrite() {
   serializer_ = NULL;
 }
 
+void ImportantFileWriter::OnWriteDone(int write_id,
+                                      const MD5Digest& digest,
+                                      size_t length,
+                                      bool success) {
+  DCHECK(CalledOnValidThread());
+  if (write_id != write_id_ || !success)
+    return;
+  has_last_write_ = true;
+  last_write_digest_ = digest;
+  last_write_length_ = length;
+}
+
 }  // namespace base
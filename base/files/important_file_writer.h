@@ -6,17 +6,22 @@
 #define BASE_FILES_IMPORTANT_FILE_WRITER_H_
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/base_export.h"
 #include "base/basictypes.h"
 #include "base/files/file_path.h"
+#include "base/md5.h"
 #include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
 #include "base/threading/non_thread_safe.h"
 #include "base/time/time.h"
 #include "base/timer/timer.h"
 
 namespace base {
 
+class ImportantFileCommitCoordinator;
 class SequencedTaskRunner;
 class Thread;
 
@@ -56,6 +61,16 @@ class BASE_EXPORT ImportantFileWriter : public NonThreadSafe {
   static bool WriteFileAtomically(const FilePath& path,
                                   const std::string& data);
 
+  // Saves each (path, data) pair of |files| in an atomic manner, like
+  // WriteFileAtomically(). All the temporary files are written before any is
+  // flushed, so that the file system can commit the flushes together; this
+  // works best for files in the same directory. Blocks and writes data on the
+  // current thread. Returns the number of files saved. If |saved| is not NULL,
+  // it is set to whether each of |files| was saved.
+  static size_t WriteFilesAtomically(
+      const std::vector<std::pair<FilePath, std::string> >& files,
+      std::vector<bool>* saved);
+
   // Initialize the writer.
   // |path| is the name of file to write.
   // |task_runner| is the SequencedTaskRunner instance where on which we will
@@ -64,6 +79,12 @@ class BASE_EXPORT ImportantFileWriter : public NonThreadSafe {
   ImportantFileWriter(const FilePath& path,
                       base::SequencedTaskRunner* task_runner);
 
+  // As above, but the writes are handed to |coordinator|, which batches them
+  // with the writes of the other writers sharing it, and does the file I/O on
+  // its task runner.
+  ImportantFileWriter(const FilePath& path,
+                      ImportantFileCommitCoordinator* coordinator);
+
   // You have to ensure that there are no pending writes at the moment
   // of destruction.
   ~ImportantFileWriter();
@@ -71,7 +92,7 @@ class BASE_EXPORT ImportantFileWriter : public NonThreadSafe {
   const FilePath& path() const { return path_; }
 
   // Returns true if there is a scheduled write pending which has not yet
-  // been started.
+  // been started, or whose data waits for its deadline in the coordinator.
   bool HasPendingWrite() const;
 
   // Save |data| to target filename. Does not block. If there is a pending write
@@ -83,10 +104,16 @@ class BASE_EXPORT ImportantFileWriter : public NonThreadSafe {
   // before that, only one serialization and write to disk will happen, and
   // the most recent |serializer| will be used. This operation does not block.
   // |serializer| should remain valid through the lifetime of
-  // ImportantFileWriter.
+  // ImportantFileWriter. With a coordinator, the data is serialized a batch
+  // window before the end of the commit interval, and handed over with that
+  // as its deadline.
   void ScheduleWrite(DataSerializer* serializer);
 
-  // Serialize data pending to be saved and execute write on backend thread.
+  // Serialize data pending to be saved and execute write on backend thread
+  // right away, or have the coordinator write data handed to it already.
+  // The write is skipped if the data is the same as the data of the last
+  // successful write by this writer, as callers often schedule writes for
+  // changes that turn out not to change the serialized data.
   void DoScheduledWrite();
 
   TimeDelta commit_interval() const {
@@ -98,12 +125,33 @@ class BASE_EXPORT ImportantFileWriter : public NonThreadSafe {
   }
 
  private:
+  // Hands |data| to the coordinator to be written by |deadline|, or posts
+  // its write to |task_runner_|.
+  void Write(const std::string& data, const TimeTicks& deadline);
+
+  // Runs when the commit interval of a ScheduleWrite is up.
+  void CommitScheduledWrite();
+
+  // Serializes the data of |serializer_| and writes it by |deadline|, unless
+  // it is the data of the last write.
+  void SerializeAndWrite(const TimeTicks& deadline);
+
+  // Records the data of the write |write_id| as the data of the last write if
+  // it is still the latest write and |success| is true.
+  void OnWriteDone(int write_id,
+                   const MD5Digest& digest,
+                   size_t length,
+                   bool success);
+
   // Path being written to.
   const FilePath path_;
 
   // TaskRunner for the thread on which file I/O can be done.
   const scoped_refptr<base::SequencedTaskRunner> task_runner_;
 
+  // Writes data for this writer instead of task_runner_, if not NULL.
+  const scoped_refptr<ImportantFileCommitCoordinator> coordinator_;
+
   // Timer used to schedule commit after ScheduleWrite.
   OneShotTimer<ImportantFileWriter> timer_;
 
@@ -113,6 +161,21 @@ class BASE_EXPORT ImportantFileWriter : public NonThreadSafe {
   // Time delta after which scheduled data will be written to disk.
   TimeDelta commit_interval_;
 
+  // When the data of the scheduled write is due.
+  TimeTicks commit_deadline_;
+
+  // Incremented by each write, so that only the result of the latest write is
+  // recorded.
+  int write_id_;
+
+  // Digest and length of the data of the last write, valid if
+  // |has_last_write_| is true. Only set once the write has succeeded.
+  bool has_last_write_;
+  MD5Digest last_write_digest_;
+  size_t last_write_length_;
+
+  WeakPtrFactory<ImportantFileWriter> weak_factory_;
+
   DISALLOW_COPY_AND_ASSIGN(ImportantFileWriter);
 };
 
@@ -119,4 +119,58 @@ TEST_F(ImportantFileWriterTest, BatchingWrites) {
   EXPECT_EQ("baz", GetFileContent(writer.path()));
 }
 
+TEST_F(ImportantFileWriterTest, UnchangedScheduledWriteIsSkipped) {
+  ImportantFileWriter writer(file_, MessageLoopProxy::current().get());
+  writer.WriteNow("foo");
+  RunLoop().RunUntilIdle();
+  ASSERT_TRUE(PathExists(writer.path()));
+
+  // Delete the file so that a write would be noticed.
+  ASSERT_TRUE(DeleteFile(writer.path(), false));
+  DataSerializer foo("foo");
+  writer.ScheduleWrite(&foo);
+  writer.DoScheduledWrite();
+  RunLoop().RunUntilIdle();
+  EXPECT_FALSE(writer.HasPendingWrite());
+  EXPECT_FALSE(PathExists(writer.path()));
+
+  DataSerializer bar("bar");
+  writer.ScheduleWrite(&bar);
+  writer.DoScheduledWrite();
+  RunLoop().RunUntilIdle();
+  ASSERT_TRUE(PathExists(writer.path()));
+  EXPECT_EQ("bar", GetFileContent(writer.path()));
+}
+
+TEST_F(ImportantFileWriterTest, FailedWriteIsRetried) {
+  FilePath path = file_.DirName().AppendASCII("missing").AppendASCII("file");
+  ImportantFileWriter writer(path, MessageLoopProxy::current().get());
+  writer.WriteNow("foo");
+  RunLoop().RunUntilIdle();
+  EXPECT_FALSE(PathExists(path));
+
+  // The data was not saved, so a scheduled write of the same data isn't
+  // skipped.
+  ASSERT_TRUE(CreateDirectory(path.DirName()));
+  DataSerializer foo("foo");
+  writer.ScheduleWrite(&foo);
+  writer.DoScheduledWrite();
+  RunLoop().RunUntilIdle();
+  ASSERT_TRUE(PathExists(path));
+  EXPECT_EQ("foo", GetFileContent(path));
+}
+
+TEST_F(ImportantFileWriterTest, WriteFilesAtomically) {
+  std::vector<std::pair<FilePath, std::string> > files;
+  files.push_back(std::make_pair(file_, std::string("foo")));
+  files.push_back(std::make_pair(file_.DirName().AppendASCII("other"),
+                                 std::string("bar")));
+  files.push_back(std::make_pair(file_.DirName().AppendASCII("missing/file"),
+                                 std::string("baz")));
+  EXPECT_EQ(2u, ImportantFileWriter::WriteFilesAtomically(files, NULL));
+  EXPECT_EQ("foo", GetFileContent(files[0].first));
+  EXPECT_EQ("bar", GetFileContent(files[1].first));
+  EXPECT_FALSE(PathExists(files[2].first));
+}
+
 }  // namespace base
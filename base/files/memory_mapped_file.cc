@@ -4,11 +4,31 @@
 
 #include "base/files/memory_mapped_file.h"
 
+#include <algorithm>
+
+#include "base/bind.h"
 #include "base/files/file_path.h"
+#include "base/location.h"
 #include "base/logging.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/task_runner.h"
 
 namespace base {
 
+namespace {
+
+// The size of the reads done by PrefetchOnTaskRunner().
+const int kPrefetchChunkSize = 64 * 1024;
+
+}  // namespace
+
+const MemoryMappedFile::Region MemoryMappedFile::Region::kWholeFile = {0, -1};
+
+bool MemoryMappedFile::Region::operator==(
+    const MemoryMappedFile::Region& other) const {
+  return other.offset == offset && other.size == size;
+}
+
 MemoryMappedFile::~MemoryMappedFile() {
   CloseHandles();
 }
@@ -24,7 +44,7 @@ bool MemoryMappedFile::Initialize(const FilePath& file_name) {
     return false;
   }
 
-  if (!MapFileToMemory()) {
+  if (!MapFileToMemory(Region::kWholeFile)) {
     CloseHandles();
     return false;
   }
@@ -33,12 +53,21 @@ bool MemoryMappedFile::Initialize(const FilePath& file_name) {
 }
 
 bool MemoryMappedFile::Initialize(File file) {
+  return Initialize(file.Pass(), Region::kWholeFile);
+}
+
+bool MemoryMappedFile::Initialize(File file, const Region& region) {
   if (IsValid())
     return false;
 
+  if (!(region == Region::kWholeFile)) {
+    DCHECK_GE(region.offset, 0);
+    DCHECK_GT(region.size, 0);
+  }
+
   file_ = file.Pass();
 
-  if (!MapFileToMemory()) {
+  if (!MapFileToMemory(region)) {
     CloseHandles();
     return false;
   }
@@ -50,4 +79,31 @@ bool MemoryMappedFile::IsValid() const {
   return data_ != NULL;
 }
 
+bool MemoryMappedFile::PrefetchOnTaskRunner(TaskRunner* task_runner) {
+  if (!IsValid())
+    return false;
+
+  File file = DuplicateFile();
+  if (!file.IsValid())
+    return false;
+
+  return task_runner->PostTask(
+      FROM_HERE,
+      Bind(&MemoryMappedFile::PrefetchRegion, Passed(&file), region_));
+}
+
+// static
+void MemoryMappedFile::PrefetchRegion(File file, const Region& region) {
+  scoped_ptr<char[]> buffer(new char[kPrefetchChunkSize]);
+  int64 end = region.offset + region.size;
+  for (int64 offset = region.offset; offset < end;) {
+    int size = static_cast<int>(std::min<int64>(kPrefetchChunkSize,
+                                                end - offset));
+    int read = file.Read(offset, buffer.get(), size);
+    if (read <= 0)
+      return;
+    offset += read;
+  }
+}
+
 }  // namespace base
@@ -17,9 +17,31 @@
 namespace base {
 
 class FilePath;
+class TaskRunner;
 
 class BASE_EXPORT MemoryMappedFile {
  public:
+  // A part of a file, in bytes. This is a POD so that kWholeFile needs no
+  // static initializer.
+  struct BASE_EXPORT Region {
+    static const Region kWholeFile;
+
+    bool operator==(const Region& other) const;
+
+    int64 offset;
+    int64 size;
+  };
+
+  // How the mapped memory is going to be read, see SetAccessPattern().
+  enum AccessPattern {
+    ACCESS_NORMAL,
+    // Pages are read in order, so read ahead aggressively and drop pages soon
+    // after they are read.
+    ACCESS_SEQUENTIAL,
+    // Pages are read in no particular order, so don't read ahead.
+    ACCESS_RANDOM,
+  };
+
   // The default constructor sets all members to invalid/null values.
   MemoryMappedFile();
   ~MemoryMappedFile();
@@ -35,6 +57,10 @@ class BASE_EXPORT MemoryMappedFile {
   // ownership of |file| and closes it when done.
   bool Initialize(File file);
 
+  // As above, but only maps |region| of |file|. The region doesn't need to be
+  // page aligned, and must lie within the file.
+  bool Initialize(File file, const Region& region);
+
 #if defined(OS_WIN)
   // Opens an existing file and maps it as an image section. Please refer to
   // the Initialize function above for additional information.
@@ -47,10 +73,33 @@ class BASE_EXPORT MemoryMappedFile {
   // Is file_ a valid file handle that points to an open, memory mapped file?
   bool IsValid() const;
 
+  // Tells the OS how the mapped memory will be read, so it can tune read
+  // ahead. Returns false if the hint was not applied, which is always the case
+  // on platforms without such hints.
+  bool SetAccessPattern(AccessPattern pattern);
+
+  // Tells the OS that [offset, offset + length) of data() will be read soon,
+  // so it can start reading it from disk without blocking the caller. Returns
+  // false if the hint was not applied.
+  bool WillNeed(size_t offset, size_t length);
+
+  // Reads the mapped region of the file on |task_runner|, so that the page
+  // faults taken when data() is later read are served from the page cache
+  // instead of the disk. The task reads through its own handle to the file, so
+  // this object may be destroyed before it runs. Returns false if the task
+  // could not be posted.
+  bool PrefetchOnTaskRunner(TaskRunner* task_runner);
+
  private:
+  // Reads |region| of |file| and discards the data.
+  static void PrefetchRegion(File file, const Region& region);
+
   // Map the file to memory, set data_ to that memory address. Return true on
   // success, false on any kind of failure. This is a helper for Initialize().
-  bool MapFileToMemory();
+  bool MapFileToMemory(const Region& region);
+
+  // Returns a new handle to file_, or an invalid File on failure.
+  File DuplicateFile();
 
   // Closes all open handles.
   void CloseHandles();
@@ -59,6 +108,11 @@ class BASE_EXPORT MemoryMappedFile {
   uint8* data_;
   size_t length_;
 
+  // The mapped region of file_. data_ points |data_offset_| bytes after the
+  // start of the mapping, which is aligned as the platform requires.
+  Region region_;
+  size_t data_offset_;
+
 #if defined(OS_WIN)
   win::ScopedHandle file_mapping_;
   bool image_;  // Map as an image.
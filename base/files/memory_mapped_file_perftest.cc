@@ -0,0 +1,112 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Counts the page faults taken to read a mapped file with each access hint.
+// The file is usually in the page cache when the test runs, so the counts are
+// mostly minor faults; on a cold disk each would also be a read from disk.
+
+#include "base/files/memory_mapped_file.h"
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "base/file_util.h"
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/message_loop/message_loop_proxy.h"
+#include "base/threading/thread.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+const int kFileSize = 32 * 1024 * 1024;
+
+long PageFaults() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_minflt + usage.ru_majflt;
+}
+
+class MemoryMappedFilePerfTest : public testing::Test {
+ protected:
+  virtual void SetUp() OVERRIDE {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    path_ = temp_dir_.path().AppendASCII("mapped");
+    std::string data(kFileSize, 'a');
+    ASSERT_EQ(kFileSize,
+              file_util::WriteFile(path_, data.data(), data.size()));
+  }
+
+  // Reads a byte of every page of |map|, in order and then in a strided order
+  // that defeats read ahead, and prints the number of page faults taken.
+  void ReadAndPrintFaults(const MemoryMappedFile& map,
+                          const std::string& trace) {
+    size_t page_size = getpagesize();
+    size_t num_pages = map.length() / page_size;
+    long faults = PageFaults();
+    int sum = 0;
+    for (size_t i = 0; i < num_pages / 2; ++i)
+      sum += map.data()[i * page_size];
+    for (size_t i = 0; i < num_pages / 2; ++i)
+      sum += map.data()[(num_pages / 2 + (i * 97) % (num_pages / 2)) *
+                        page_size];
+    EXPECT_NE(0, sum);
+    perf_test::PrintResult("page_faults", "", trace,
+                           static_cast<size_t>(PageFaults() - faults),
+                           "faults", true);
+  }
+
+  File OpenFile() {
+    return File(path_, File::FLAG_OPEN | File::FLAG_READ);
+  }
+
+  ScopedTempDir temp_dir_;
+  FilePath path_;
+};
+
+}  // namespace
+
+TEST_F(MemoryMappedFilePerfTest, Normal) {
+  MemoryMappedFile map;
+  ASSERT_TRUE(map.Initialize(OpenFile()));
+  ReadAndPrintFaults(map, "normal");
+}
+
+TEST_F(MemoryMappedFilePerfTest, Sequential) {
+  MemoryMappedFile map;
+  ASSERT_TRUE(map.Initialize(OpenFile()));
+  EXPECT_TRUE(map.SetAccessPattern(MemoryMappedFile::ACCESS_SEQUENTIAL));
+  ReadAndPrintFaults(map, "sequential");
+}
+
+TEST_F(MemoryMappedFilePerfTest, Random) {
+  MemoryMappedFile map;
+  ASSERT_TRUE(map.Initialize(OpenFile()));
+  EXPECT_TRUE(map.SetAccessPattern(MemoryMappedFile::ACCESS_RANDOM));
+  ReadAndPrintFaults(map, "random");
+}
+
+TEST_F(MemoryMappedFilePerfTest, WillNeed) {
+  MemoryMappedFile map;
+  ASSERT_TRUE(map.Initialize(OpenFile()));
+  EXPECT_TRUE(map.WillNeed(0, map.length()));
+  ReadAndPrintFaults(map, "will_need");
+}
+
+TEST_F(MemoryMappedFilePerfTest, Prefetch) {
+  Thread thread("MemoryMappedFilePerfTest");
+  ASSERT_TRUE(thread.Start());
+  MemoryMappedFile map;
+  ASSERT_TRUE(map.Initialize(OpenFile()));
+  EXPECT_TRUE(map.PrefetchOnTaskRunner(thread.message_loop_proxy()));
+  thread.Stop();
+  ReadAndPrintFaults(map, "prefetch");
+}
+
+}  // namespace base
@@ -8,15 +8,37 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <limits>
+
 #include "base/logging.h"
+#include "base/posix/eintr_wrapper.h"
 #include "base/threading/thread_restrictions.h"
 
 namespace base {
 
-MemoryMappedFile::MemoryMappedFile() : data_(NULL), length_(0) {
+namespace {
+
+// Returns the page aligned range of the mapping that holds
+// [data + offset, data + offset + length).
+void GetPageRange(uint8* data,
+                  size_t offset,
+                  size_t length,
+                  uint8** start,
+                  size_t* size) {
+  uintptr_t page_mask = static_cast<uintptr_t>(getpagesize()) - 1;
+  uintptr_t begin = reinterpret_cast<uintptr_t>(data) + offset;
+  uintptr_t aligned_begin = begin & ~page_mask;
+  *start = reinterpret_cast<uint8*>(aligned_begin);
+  *size = length + (begin - aligned_begin);
 }
 
-bool MemoryMappedFile::MapFileToMemory() {
+}  // namespace
+
+MemoryMappedFile::MemoryMappedFile()
+    : data_(NULL), length_(0), region_(Region::kWholeFile), data_offset_(0) {
+}
+
+bool MemoryMappedFile::MapFileToMemory(const Region& region) {
   ThreadRestrictions::AssertIOAllowed();
 
   struct stat file_stat;
@@ -24,25 +46,91 @@ bool MemoryMappedFile::MapFileToMemory() {
     DPLOG(ERROR) << "fstat " << file_.GetPlatformFile();
     return false;
   }
-  length_ = file_stat.st_size;
 
-  data_ = static_cast<uint8*>(
-      mmap(NULL, length_, PROT_READ, MAP_SHARED, file_.GetPlatformFile(), 0));
-  if (data_ == MAP_FAILED)
+  region_ = region;
+  if (region_ == Region::kWholeFile) {
+    region_.offset = 0;
+    region_.size = file_stat.st_size;
+  } else if (region_.offset + region_.size > file_stat.st_size) {
+    DLOG(ERROR) << "Region " << region_.offset << "+" << region_.size
+                << " is beyond the end of the file";
+    return false;
+  }
+  if (static_cast<uint64>(region_.size) > std::numeric_limits<size_t>::max()) {
+    DLOG(ERROR) << "Region is too large to map";
+    return false;
+  }
+  length_ = static_cast<size_t>(region_.size);
+
+  // mmap() needs a page aligned offset, so map from the start of the page that
+  // holds the region.
+  int64 page_size = getpagesize();
+  int64 map_offset = region_.offset - region_.offset % page_size;
+  data_offset_ = static_cast<size_t>(region_.offset - map_offset);
+
+  void* mapping = mmap(NULL, length_ + data_offset_, PROT_READ, MAP_SHARED,
+                       file_.GetPlatformFile(), map_offset);
+  if (mapping == MAP_FAILED) {
     DPLOG(ERROR) << "mmap " << file_.GetPlatformFile();
+    data_ = NULL;
+    return false;
+  }
+  data_ = static_cast<uint8*>(mapping) + data_offset_;
+  return true;
+}
+
+bool MemoryMappedFile::SetAccessPattern(AccessPattern pattern) {
+  if (!IsValid())
+    return false;
+
+  int advice = MADV_NORMAL;
+  switch (pattern) {
+    case ACCESS_NORMAL:
+      advice = MADV_NORMAL;
+      break;
+    case ACCESS_SEQUENTIAL:
+      advice = MADV_SEQUENTIAL;
+      break;
+    case ACCESS_RANDOM:
+      advice = MADV_RANDOM;
+      break;
+  }
+  if (madvise(data_ - data_offset_, length_ + data_offset_, advice) != 0) {
+    DPLOG(ERROR) << "madvise";
+    return false;
+  }
+  return true;
+}
+
+bool MemoryMappedFile::WillNeed(size_t offset, size_t length) {
+  if (!IsValid() || offset > length_ || length > length_ - offset)
+    return false;
+
+  uint8* start;
+  size_t size;
+  GetPageRange(data_, offset, length, &start, &size);
+  if (madvise(start, size, MADV_WILLNEED) != 0) {
+    DPLOG(ERROR) << "madvise";
+    return false;
+  }
+  return true;
+}
 
-  return data_ != MAP_FAILED;
+File MemoryMappedFile::DuplicateFile() {
+  return File(HANDLE_EINTR(dup(file_.GetPlatformFile())));
 }
 
 void MemoryMappedFile::CloseHandles() {
   ThreadRestrictions::AssertIOAllowed();
 
   if (data_ != NULL)
-    munmap(data_, length_);
+    munmap(data_ - data_offset_, length_ + data_offset_);
   file_.Close();
 
   data_ = NULL;
   length_ = 0;
+  region_ = Region::kWholeFile;
+  data_offset_ = 0;
 }
 
 }  // namespace base
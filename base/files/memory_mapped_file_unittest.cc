@@ -0,0 +1,155 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/memory_mapped_file.h"
+
+#include <string>
+
+#include "base/file_util.h"
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/message_loop/message_loop_proxy.h"
+#include "base/threading/thread.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+#include <vector>
+
+#include "base/debug/proc_maps_linux.h"
+#endif
+
+namespace base {
+
+namespace {
+
+// Larger than the Windows allocation granularity, and unaligned.
+const int kFileSize = 3 * 65536 + 123;
+
+char ContentAt(int64 offset) {
+  return static_cast<char>(offset % 251);
+}
+
+class MemoryMappedFileTest : public testing::Test {
+ protected:
+  virtual void SetUp() OVERRIDE {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    path_ = temp_dir_.path().AppendASCII("mapped");
+    std::string data;
+    for (int i = 0; i < kFileSize; ++i)
+      data.push_back(ContentAt(i));
+    ASSERT_EQ(kFileSize,
+              file_util::WriteFile(path_, data.data(), data.size()));
+  }
+
+  File OpenFile() {
+    return File(path_, File::FLAG_OPEN | File::FLAG_READ);
+  }
+
+  void CheckContent(const MemoryMappedFile& map, int64 offset) {
+    for (size_t i = 0; i < map.length(); ++i) {
+      if (map.data()[i] != static_cast<uint8>(ContentAt(offset + i))) {
+        ADD_FAILURE() << "Wrong data at " << offset + i;
+        return;
+      }
+    }
+  }
+
+  ScopedTempDir temp_dir_;
+  FilePath path_;
+};
+
+}  // namespace
+
+TEST_F(MemoryMappedFileTest, MapWholeFile) {
+  MemoryMappedFile map;
+  ASSERT_TRUE(map.Initialize(path_));
+  EXPECT_TRUE(map.IsValid());
+  ASSERT_EQ(static_cast<size_t>(kFileSize), map.length());
+  CheckContent(map, 0);
+
+  // A mapped file can't be initialized again.
+  EXPECT_FALSE(map.Initialize(OpenFile()));
+}
+
+TEST_F(MemoryMappedFileTest, MapRegions) {
+  const MemoryMappedFile::Region kRegions[] = {
+    {0, 100},
+    {65536, 65536},
+    {70001, 12345},
+    {kFileSize - 1, 1},
+    {1, kFileSize - 1},
+  };
+  for (size_t i = 0; i < arraysize(kRegions); ++i) {
+    MemoryMappedFile map;
+    ASSERT_TRUE(map.Initialize(OpenFile(), kRegions[i]));
+    ASSERT_EQ(static_cast<size_t>(kRegions[i].size), map.length());
+    CheckContent(map, kRegions[i].offset);
+  }
+}
+
+TEST_F(MemoryMappedFileTest, MapRegionBeyondEnd) {
+  MemoryMappedFile::Region region = {kFileSize - 10, 11};
+  MemoryMappedFile map;
+  EXPECT_FALSE(map.Initialize(OpenFile(), region));
+  EXPECT_FALSE(map.IsValid());
+}
+
+#if defined(OS_POSIX)
+TEST_F(MemoryMappedFileTest, AccessHints) {
+  MemoryMappedFile::Region region = {4097, 10000};
+  MemoryMappedFile map;
+  ASSERT_TRUE(map.Initialize(OpenFile(), region));
+  EXPECT_TRUE(map.SetAccessPattern(MemoryMappedFile::ACCESS_SEQUENTIAL));
+  EXPECT_TRUE(map.SetAccessPattern(MemoryMappedFile::ACCESS_RANDOM));
+  EXPECT_TRUE(map.SetAccessPattern(MemoryMappedFile::ACCESS_NORMAL));
+  EXPECT_TRUE(map.WillNeed(0, map.length()));
+  EXPECT_TRUE(map.WillNeed(5000, 1));
+  EXPECT_FALSE(map.WillNeed(5000, map.length()));
+  CheckContent(map, region.offset);
+}
+#endif  // defined(OS_POSIX)
+
+TEST_F(MemoryMappedFileTest, PrefetchOnTaskRunner) {
+  Thread thread("MemoryMappedFileTest");
+  ASSERT_TRUE(thread.Start());
+  {
+    MemoryMappedFile map;
+    ASSERT_TRUE(map.Initialize(path_));
+    EXPECT_TRUE(map.PrefetchOnTaskRunner(thread.message_loop_proxy()));
+    // |map| goes away before the prefetch is done.
+  }
+  thread.Stop();
+
+  MemoryMappedFile unmapped;
+  EXPECT_FALSE(unmapped.PrefetchOnTaskRunner(thread.message_loop_proxy()));
+}
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+// Only the pages holding the region are mapped.
+TEST_F(MemoryMappedFileTest, RegionMappingSize) {
+  MemoryMappedFile::Region region = {2 * 4096 + 10, 4096};
+  MemoryMappedFile map;
+  ASSERT_TRUE(map.Initialize(OpenFile(), region));
+
+  std::string proc_maps;
+  ASSERT_TRUE(debug::ReadProcMaps(&proc_maps));
+  std::vector<debug::MappedMemoryRegion> regions;
+  ASSERT_TRUE(debug::ParseProcMaps(proc_maps, &regions));
+
+  uintptr_t address = reinterpret_cast<uintptr_t>(map.data());
+  bool found = false;
+  for (size_t i = 0; i < regions.size(); ++i) {
+    if (address < regions[i].start || address >= regions[i].end)
+      continue;
+    found = true;
+    EXPECT_EQ(2 * 4096u, regions[i].offset);
+    EXPECT_EQ(2 * 4096u, regions[i].end - regions[i].start);
+    EXPECT_EQ(region.offset - 2 * 4096,
+              static_cast<int64>(address - regions[i].start));
+  }
+  EXPECT_TRUE(found);
+}
+#endif  // defined(OS_LINUX) || defined(OS_ANDROID)
+
+}  // namespace base
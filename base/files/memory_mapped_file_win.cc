@@ -10,7 +10,12 @@
 
 namespace base {
 
-MemoryMappedFile::MemoryMappedFile() : data_(NULL), length_(0), image_(false) {
+MemoryMappedFile::MemoryMappedFile()
+    : data_(NULL),
+      length_(0),
+      region_(Region::kWholeFile),
+      data_offset_(0),
+      image_(false) {
 }
 
 bool MemoryMappedFile::InitializeAsImageSection(const FilePath& file_name) {
@@ -18,7 +23,7 @@ bool MemoryMappedFile::InitializeAsImageSection(const FilePath& file_name) {
   return Initialize(file_name);
 }
 
-bool MemoryMappedFile::MapFileToMemory() {
+bool MemoryMappedFile::MapFileToMemory(const Region& region) {
   ThreadRestrictions::AssertIOAllowed();
 
   if (!file_.IsValid())
@@ -27,7 +32,15 @@ bool MemoryMappedFile::MapFileToMemory() {
   int64 len = file_.GetLength();
   if (len <= 0 || len > kint32max)
     return false;
-  length_ = static_cast<size_t>(len);
+
+  region_ = region;
+  if (region_ == Region::kWholeFile) {
+    region_.offset = 0;
+    region_.size = len;
+  } else if (image_ || region_.offset + region_.size > len) {
+    return false;
+  }
+  length_ = static_cast<size_t>(region_.size);
 
   int flags = image_ ? SEC_IMAGE | PAGE_READONLY : PAGE_READONLY;
 
@@ -36,14 +49,47 @@ bool MemoryMappedFile::MapFileToMemory() {
   if (!file_mapping_.IsValid())
     return false;
 
-  data_ = static_cast<uint8*>(::MapViewOfFile(file_mapping_.Get(),
-                                              FILE_MAP_READ, 0, 0, 0));
-  return data_ != NULL;
+  // Views must start at a multiple of the allocation granularity, so map from
+  // the start of the granule that holds the region.
+  SYSTEM_INFO system_info;
+  ::GetSystemInfo(&system_info);
+  int64 granularity = system_info.dwAllocationGranularity;
+  int64 map_offset = region_.offset - region_.offset % granularity;
+  data_offset_ = static_cast<size_t>(region_.offset - map_offset);
+
+  void* view = ::MapViewOfFile(file_mapping_.Get(), FILE_MAP_READ,
+                               static_cast<DWORD>(map_offset >> 32),
+                               static_cast<DWORD>(map_offset),
+                               length_ + data_offset_);
+  if (!view)
+    return false;
+  data_ = static_cast<uint8*>(view) + data_offset_;
+  return true;
+}
+
+bool MemoryMappedFile::SetAccessPattern(AccessPattern pattern) {
+  // Windows has no read ahead hints for mapped views.
+  return false;
+}
+
+bool MemoryMappedFile::WillNeed(size_t offset, size_t length) {
+  // PrefetchVirtualMemory() needs Windows 8, use PrefetchOnTaskRunner().
+  return false;
+}
+
+File MemoryMappedFile::DuplicateFile() {
+  HANDLE handle = NULL;
+  if (!::DuplicateHandle(::GetCurrentProcess(), file_.GetPlatformFile(),
+                         ::GetCurrentProcess(), &handle, 0, FALSE,
+                         DUPLICATE_SAME_ACCESS)) {
+    return File();
+  }
+  return File(handle);
 }
 
 void MemoryMappedFile::CloseHandles() {
   if (data_)
-    ::UnmapViewOfFile(data_);
+    ::UnmapViewOfFile(data_ - data_offset_);
   if (file_mapping_.IsValid())
     file_mapping_.Close();
   if (file_.IsValid())
@@ -51,6 +97,8 @@ void MemoryMappedFile::CloseHandles() {
 
   data_ = NULL;
   length_ = 0;
+  region_ = Region::kWholeFile;
+  data_offset_ = 0;
 }
 
 }  // namespace base
@@ -26,6 +26,25 @@ inline uint32 Hash(const std::string& key) {
   return SuperFastHash(key.data(), static_cast<int>(key.size()));
 }
 
+// A fast 64-bit hash, not suitable for cryptographic use or for input chosen
+// by an attacker. Each |seed| gives a different hash function of the family.
+// The result is the same on all platforms and CPUs, so it may be persisted.
+// It is computed with the crc32 instructions of SSE4.2 or ARMv8 where the
+// CPU has them.
+BASE_EXPORT uint64 Hash64WithSeed(const char* data, size_t length, uint64 seed);
+
+inline uint64 Hash64(const char* data, size_t length) {
+  return Hash64WithSeed(data, length, 0);
+}
+
+inline uint64 Hash64(const std::string& key) {
+  return Hash64WithSeed(key.data(), key.size(), 0);
+}
+
+// Returns the CRC-32C (Castagnoli) of |data|, continuing from |crc|, which is
+// 0 for the first block. Uses the crc32 instructions where available.
+BASE_EXPORT uint32 Crc32c(uint32 crc, const char* data, size_t length);
+
 }  // namespace base
 
 #endif  // BASE_HASH_H_
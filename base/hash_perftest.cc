@@ -0,0 +1,71 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/hash.h"
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+// Hashes about this many bytes for each key size.
+const size_t kBytesPerSize = 64 * 1024 * 1024;
+
+const size_t kKeySizes[] = {8, 16, 64, 256, 1024, 4096, 16384, 65536};
+
+template <typename Function>
+void RunTest(const std::string& name, Function hash) {
+  std::string data(kKeySizes[arraysize(kKeySizes) - 1] + 1, 'x');
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>(i * 131);
+
+  for (size_t i = 0; i < arraysize(kKeySizes); ++i) {
+    size_t size = kKeySizes[i];
+    size_t iterations = kBytesPerSize / size;
+    uint64 sum = 0;
+    TimeTicks start = TimeTicks::HighResNow();
+    for (size_t j = 0; j < iterations; ++j)
+      sum += hash(data.data() + (j & 1), size);
+    double elapsed_us =
+        (TimeTicks::HighResNow() - start).InMillisecondsF() * 1000;
+    EXPECT_NE(0u, sum);
+    perf_test::PrintResult(name, "", Uint64ToString(size) + "_bytes",
+                           size * iterations / elapsed_us, "bytes/us", true);
+  }
+}
+
+uint64 SuperFastHashFunction(const char* data, size_t size) {
+  return Hash(data, size);
+}
+
+uint64 Hash64Function(const char* data, size_t size) {
+  return Hash64(data, size);
+}
+
+uint64 Crc32cFunction(const char* data, size_t size) {
+  return Crc32c(0, data, size);
+}
+
+}  // namespace
+
+TEST(HashPerfTest, SuperFastHash) {
+  RunTest("super_fast_hash", &SuperFastHashFunction);
+}
+
+TEST(HashPerfTest, Hash64) {
+  RunTest("hash64", &Hash64Function);
+}
+
+TEST(HashPerfTest, Crc32c) {
+  RunTest("crc32c", &Crc32cFunction);
+}
+
+}  // namespace base
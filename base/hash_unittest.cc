@@ -0,0 +1,127 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/hash.h"
+
+#include <set>
+#include <string>
+
+#include "base/strings/stringprintf.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+// CRC-32C a bit at a time.
+uint32 ReferenceCrc32c(uint32 crc, const std::string& data) {
+  crc = ~crc;
+  for (size_t i = 0; i < data.size(); ++i) {
+    crc ^= static_cast<uint8>(data[i]);
+    for (int bit = 0; bit < 8; ++bit)
+      crc = (crc >> 1) ^ (0x82f63b78 & (0 - (crc & 1)));
+  }
+  return ~crc;
+}
+
+const char* const kKeys[] = {
+  "",
+  "a",
+  "hello",
+  "0123456789abcdef",
+  "The quick brown fox jumps over the lazy dog",
+};
+
+}  // namespace
+
+// Hash() is persisted by some of its users, so it must not change.
+TEST(HashTest, SuperFastHashIsStable) {
+  const uint32 kExpected[] = {
+    0x00000000,
+    0x115ea782,
+    0xb09dc87b,
+    0xa4e2281c,
+    0x05bf7ce3,
+  };
+  for (size_t i = 0; i < arraysize(kKeys); ++i)
+    EXPECT_EQ(kExpected[i], Hash(std::string(kKeys[i]))) << kKeys[i];
+}
+
+TEST(HashTest, Crc32c) {
+  EXPECT_EQ(0u, Crc32c(0, NULL, 0));
+  EXPECT_EQ(0xe3069283, Crc32c(0, "123456789", 9));
+  std::string zeros(32, '\0');
+  EXPECT_EQ(0x8a9136aa, Crc32c(0, zeros.data(), zeros.size()));
+
+  // Every length and alignment, which take the word and byte loops.
+  std::string data;
+  for (int i = 0; i < 100; ++i)
+    data.push_back(static_cast<char>(i * 37));
+  for (size_t offset = 0; offset < 8; ++offset) {
+    for (size_t length = 0; length + offset <= data.size(); ++length) {
+      std::string block = data.substr(offset, length);
+      EXPECT_EQ(ReferenceCrc32c(0, block),
+                Crc32c(0, block.data(), block.size()));
+    }
+  }
+
+  // A CRC can be computed in pieces.
+  uint32 crc = Crc32c(0, data.data(), 13);
+  EXPECT_EQ(Crc32c(0, data.data(), data.size()),
+            Crc32c(crc, data.data() + 13, data.size() - 13));
+}
+
+// Hash64() may be persisted, and must be the same whether or not the CPU has
+// crc32 instructions.
+TEST(HashTest, Hash64IsStable) {
+  const uint64 kExpected[] = {
+    0x79b39e42c630264fULL,
+    0xa6c3bd46a24fc120ULL,
+    0x43b68f29b8c4e0b8ULL,
+    0x821cdfdb29720b0cULL,
+    0x78c724d98ad4e6a2ULL,
+  };
+  const uint64 kExpectedWithSeed[] = {
+    0xa24eabcbd60aac25ULL,
+    0xc68b5f79f595e405ULL,
+    0x585782463bdf3b3dULL,
+    0x9fbbb8e45f6ff9baULL,
+    0x406472921737d957ULL,
+  };
+  for (size_t i = 0; i < arraysize(kKeys); ++i) {
+    std::string key(kKeys[i]);
+    EXPECT_EQ(kExpected[i], Hash64(key)) << key;
+    EXPECT_EQ(kExpected[i], Hash64(key.data(), key.size())) << key;
+    EXPECT_EQ(kExpectedWithSeed[i], Hash64WithSeed(key.data(), key.size(), 42))
+        << key;
+  }
+}
+
+TEST(HashTest, Hash64Collisions) {
+  std::set<uint64> hashes;
+  std::set<uint32> high_halves;
+  const int kNumKeys = 100000;
+  for (int i = 0; i < kNumKeys; ++i) {
+    uint64 hash = Hash64(StringPrintf("key%d", i));
+    hashes.insert(hash);
+    high_halves.insert(static_cast<uint32>(hash >> 32));
+  }
+  EXPECT_EQ(static_cast<size_t>(kNumKeys), hashes.size());
+  // About one collision is expected among 100000 random 32-bit values.
+  EXPECT_LE(static_cast<size_t>(kNumKeys - 10), high_halves.size());
+
+  // Keys that only differ by trailing zeros or length.
+  std::string key("abc");
+  hashes.clear();
+  for (int i = 0; i < 20; ++i) {
+    hashes.insert(Hash64(key));
+    key.push_back('\0');
+  }
+  EXPECT_EQ(20u, hashes.size());
+
+  // Seeds give different functions.
+  EXPECT_NE(Hash64WithSeed("abc", 3, 1), Hash64WithSeed("abc", 3, 2));
+}
+
+}  // namespace base
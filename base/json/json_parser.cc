@@ -186,6 +186,7 @@ class StackMarker {
 
 JSONParser::JSONParser(int options)
     : options_(options),
+      handler_(NULL),
       start_pos_(NULL),
       pos_(NULL),
       end_pos_(NULL),
@@ -208,28 +209,9 @@ Value* JSONParser::Parse(const StringPiece& input) {
   // be used anywhere.
   if (!(options_ & JSON_DETACHABLE_CHILDREN)) {
     input_copy.reset(new std::string(input.as_string()));
-    start_pos_ = input_copy->data();
+    StartParsing(input_copy->data(), input.length());
   } else {
-    start_pos_ = input.data();
-  }
-  pos_ = start_pos_;
-  end_pos_ = start_pos_ + input.length();
-  index_ = 0;
-  line_number_ = 1;
-  index_last_line_ = 0;
-
-  error_code_ = JSONReader::JSON_NO_ERROR;
-  error_line_ = 0;
-  error_column_ = 0;
-
-  // When the input JSON string starts with a UTF-8 Byte-Order-Mark
-  // <0xEF 0xBB 0xBF>, advance the start position to avoid the
-  // ParseNextToken function mis-treating a Unicode BOM as an invalid
-  // character and returning NULL.
-  if (CanConsume(3) && static_cast<uint8>(*pos_) == 0xEF &&
-      static_cast<uint8>(*(pos_ + 1)) == 0xBB &&
-      static_cast<uint8>(*(pos_ + 2)) == 0xBF) {
-    NextNChars(3);
+    StartParsing(input.data(), input.length());
   }
 
   // Parse the first and any nested tokens.
@@ -237,13 +219,8 @@ Value* JSONParser::Parse(const StringPiece& input) {
   if (!root.get())
     return NULL;
 
-  // Make sure the input stream is at an end.
-  if (GetNextToken() != T_END_OF_INPUT) {
-    if (!CanConsume(1) || (NextChar() && GetNextToken() != T_END_OF_INPUT)) {
-      ReportError(JSONReader::JSON_UNEXPECTED_DATA_AFTER_ROOT, 1);
-      return NULL;
-    }
-  }
+  if (!CheckEndOfInput())
+    return NULL;
 
   // Dictionaries and lists can contain JSONStringValues, so wrap them in a
   // hidden root.
@@ -264,6 +241,15 @@ Value* JSONParser::Parse(const StringPiece& input) {
   return root.release();
 }
 
+bool JSONParser::Parse(const StringPiece& input, JSONReader::Handler* handler) {
+  // Nothing outlives this call, so the input never needs to be copied.
+  StartParsing(input.data(), input.length());
+  handler_ = handler;
+  bool result = ReportNextToken() && CheckEndOfInput();
+  handler_ = NULL;
+  return result;
+}
+
 JSONReader::JsonParseError JSONParser::error_code() const {
   return error_code_;
 }
@@ -336,6 +322,39 @@ const std::string& JSONParser::StringBuilder::AsString() {
 
 // JSONParser private //////////////////////////////////////////////////////////
 
+void JSONParser::StartParsing(const char* start, size_t length) {
+  start_pos_ = start;
+  pos_ = start_pos_;
+  end_pos_ = start_pos_ + length;
+  index_ = 0;
+  line_number_ = 1;
+  index_last_line_ = 0;
+
+  error_code_ = JSONReader::JSON_NO_ERROR;
+  error_line_ = 0;
+  error_column_ = 0;
+
+  // When the input JSON string starts with a UTF-8 Byte-Order-Mark
+  // <0xEF 0xBB 0xBF>, advance the start position to avoid the
+  // ParseNextToken function mis-treating a Unicode BOM as an invalid
+  // character and returning NULL.
+  if (CanConsume(3) && static_cast<uint8>(*pos_) == 0xEF &&
+      static_cast<uint8>(*(pos_ + 1)) == 0xBB &&
+      static_cast<uint8>(*(pos_ + 2)) == 0xBF) {
+    NextNChars(3);
+  }
+}
+
+bool JSONParser::CheckEndOfInput() {
+  if (GetNextToken() != T_END_OF_INPUT) {
+    if (!CanConsume(1) || (NextChar() && GetNextToken() != T_END_OF_INPUT)) {
+      ReportError(JSONReader::JSON_UNEXPECTED_DATA_AFTER_ROOT, 1);
+      return false;
+    }
+  }
+  return true;
+}
+
 inline bool JSONParser::CanConsume(int length) {
   return pos_ + length <= end_pos_;
 }
@@ -489,7 +508,9 @@ Value* JSONParser::ConsumeDictionary() {
     return NULL;
   }
 
-  scoped_ptr<DictionaryValue> dict(new DictionaryValue);
+  scoped_ptr<DictionaryValue> dict(new DictionaryValue(
+      (options_ & JSON_COMPACT_DICTIONARIES) ? DictionaryValue::STORAGE_FLAT :
+                                               DictionaryValue::STORAGE_MAP));
 
   NextChar();
   Token token = GetNextToken();
@@ -804,6 +825,19 @@ void JSONParser::DecodeUTF8(const int32& point, StringBuilder* dest) {
 }
 
 Value* JSONParser::ConsumeNumber() {
+  bool is_int;
+  int num_int;
+  double num_double;
+  if (!ConsumeNumberRaw(&is_int, &num_int, &num_double))
+    return NULL;
+  if (is_int)
+    return new FundamentalValue(num_int);
+  return new FundamentalValue(num_double);
+}
+
+bool JSONParser::ConsumeNumberRaw(bool* is_int,
+                                  int* int_value,
+                                  double* double_value) {
   const char* num_start = pos_;
   const int start_index = index_;
   int end_index = start_index;
@@ -813,7 +847,7 @@ Value* JSONParser::ConsumeNumber() {
 
   if (!ReadInt(false)) {
     ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-    return NULL;
+    return false;
   }
   end_index = index_;
 
@@ -821,12 +855,12 @@ Value* JSONParser::ConsumeNumber() {
   if (*pos_ == '.') {
     if (!CanConsume(1)) {
       ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-      return NULL;
+      return false;
     }
     NextChar();
     if (!ReadInt(true)) {
       ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-      return NULL;
+      return false;
     }
     end_index = index_;
   }
@@ -838,7 +872,7 @@ Value* JSONParser::ConsumeNumber() {
       NextChar();
     if (!ReadInt(true)) {
       ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-      return NULL;
+      return false;
     }
     end_index = index_;
   }
@@ -858,7 +892,7 @@ Value* JSONParser::ConsumeNumber() {
       break;
     default:
       ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-      return NULL;
+      return false;
   }
 
   pos_ = exit_pos;
@@ -866,17 +900,12 @@ Value* JSONParser::ConsumeNumber() {
 
   StringPiece num_string(num_start, end_index - start_index);
 
-  int num_int;
-  if (StringToInt(num_string, &num_int))
-    return new FundamentalValue(num_int);
-
-  double num_double;
-  if (base::StringToDouble(num_string.as_string(), &num_double) &&
-      IsFinite(num_double)) {
-    return new FundamentalValue(num_double);
-  }
+  *is_int = StringToInt(num_string, int_value);
+  if (*is_int)
+    return true;
 
-  return NULL;
+  return base::StringToDouble(num_string.as_string(), double_value) &&
+      IsFinite(*double_value);
 }
 
 bool JSONParser::ReadInt(bool allow_leading_zeros) {
@@ -900,45 +929,166 @@ bool JSONParser::ReadInt(bool allow_leading_zeros) {
 
 Value* JSONParser::ConsumeLiteral() {
   switch (*pos_) {
-    case 't': {
-      const char* kTrueLiteral = "true";
-      const int kTrueLen = static_cast<int>(strlen(kTrueLiteral));
-      if (!CanConsume(kTrueLen - 1) ||
-          !StringsAreEqual(pos_, kTrueLiteral, kTrueLen)) {
-        ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
+    case 't':
+      if (!ConsumeLiteralRaw("true"))
         return NULL;
-      }
-      NextNChars(kTrueLen - 1);
       return new FundamentalValue(true);
-    }
-    case 'f': {
-      const char* kFalseLiteral = "false";
-      const int kFalseLen = static_cast<int>(strlen(kFalseLiteral));
-      if (!CanConsume(kFalseLen - 1) ||
-          !StringsAreEqual(pos_, kFalseLiteral, kFalseLen)) {
-        ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
+    case 'f':
+      if (!ConsumeLiteralRaw("false"))
         return NULL;
-      }
-      NextNChars(kFalseLen - 1);
       return new FundamentalValue(false);
-    }
-    case 'n': {
-      const char* kNullLiteral = "null";
-      const int kNullLen = static_cast<int>(strlen(kNullLiteral));
-      if (!CanConsume(kNullLen - 1) ||
-          !StringsAreEqual(pos_, kNullLiteral, kNullLen)) {
-        ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
+    case 'n':
+      if (!ConsumeLiteralRaw("null"))
         return NULL;
-      }
-      NextNChars(kNullLen - 1);
       return Value::CreateNullValue();
-    }
     default:
       ReportError(JSONReader::JSON_UNEXPECTED_TOKEN, 1);
       return NULL;
   }
 }
 
+bool JSONParser::ConsumeLiteralRaw(const char* literal) {
+  const int length = static_cast<int>(strlen(literal));
+  if (!CanConsume(length - 1) || !StringsAreEqual(pos_, literal, length)) {
+    ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
+    return false;
+  }
+  NextNChars(length - 1);
+  return true;
+}
+
+bool JSONParser::ReportNextToken() {
+  return ReportToken(GetNextToken());
+}
+
+bool JSONParser::ReportToken(Token token) {
+  switch (token) {
+    case T_OBJECT_BEGIN:
+      return ReportDictionary();
+    case T_ARRAY_BEGIN:
+      return ReportList();
+    case T_STRING: {
+      StringBuilder string;
+      if (!ConsumeStringRaw(&string))
+        return false;
+      if (string.CanBeStringPiece())
+        return handler_->OnString(string.AsStringPiece());
+      return handler_->OnString(string.AsString());
+    }
+    case T_NUMBER: {
+      bool is_int;
+      int num_int;
+      double num_double;
+      if (!ConsumeNumberRaw(&is_int, &num_int, &num_double))
+        return false;
+      if (is_int)
+        return handler_->OnInteger(num_int);
+      return handler_->OnDouble(num_double);
+    }
+    case T_BOOL_TRUE:
+      return ConsumeLiteralRaw("true") && handler_->OnBoolean(true);
+    case T_BOOL_FALSE:
+      return ConsumeLiteralRaw("false") && handler_->OnBoolean(false);
+    case T_NULL:
+      return ConsumeLiteralRaw("null") && handler_->OnNull();
+    default:
+      ReportError(JSONReader::JSON_UNEXPECTED_TOKEN, 1);
+      return false;
+  }
+}
+
+bool JSONParser::ReportDictionary() {
+  StackMarker depth_check(&stack_depth_);
+  if (depth_check.IsTooDeep()) {
+    ReportError(JSONReader::JSON_TOO_MUCH_NESTING, 1);
+    return false;
+  }
+
+  if (!handler_->OnDictionaryBegin())
+    return false;
+
+  NextChar();
+  Token token = GetNextToken();
+  while (token != T_OBJECT_END) {
+    if (token != T_STRING) {
+      ReportError(JSONReader::JSON_UNQUOTED_DICTIONARY_KEY, 1);
+      return false;
+    }
+
+    StringBuilder key;
+    if (!ConsumeStringRaw(&key))
+      return false;
+
+    NextChar();
+    token = GetNextToken();
+    if (token != T_OBJECT_PAIR_SEPARATOR) {
+      ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
+      return false;
+    }
+
+    // Only report the key once it is known to be followed by a value.
+    if (!handler_->OnDictionaryKey(key.CanBeStringPiece() ?
+                                       key.AsStringPiece() :
+                                       StringPiece(key.AsString()))) {
+      return false;
+    }
+
+    NextChar();
+    if (!ReportNextToken())
+      return false;
+
+    NextChar();
+    token = GetNextToken();
+    if (token == T_LIST_SEPARATOR) {
+      NextChar();
+      token = GetNextToken();
+      if (token == T_OBJECT_END && !(options_ & JSON_ALLOW_TRAILING_COMMAS)) {
+        ReportError(JSONReader::JSON_TRAILING_COMMA, 1);
+        return false;
+      }
+    } else if (token != T_OBJECT_END) {
+      ReportError(JSONReader::JSON_SYNTAX_ERROR, 0);
+      return false;
+    }
+  }
+
+  return handler_->OnDictionaryEnd();
+}
+
+bool JSONParser::ReportList() {
+  StackMarker depth_check(&stack_depth_);
+  if (depth_check.IsTooDeep()) {
+    ReportError(JSONReader::JSON_TOO_MUCH_NESTING, 1);
+    return false;
+  }
+
+  if (!handler_->OnListBegin())
+    return false;
+
+  NextChar();
+  Token token = GetNextToken();
+  while (token != T_ARRAY_END) {
+    if (!ReportToken(token))
+      return false;
+
+    NextChar();
+    token = GetNextToken();
+    if (token == T_LIST_SEPARATOR) {
+      NextChar();
+      token = GetNextToken();
+      if (token == T_ARRAY_END && !(options_ & JSON_ALLOW_TRAILING_COMMAS)) {
+        ReportError(JSONReader::JSON_TRAILING_COMMA, 1);
+        return false;
+      }
+    } else if (token != T_ARRAY_END) {
+      ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
+      return false;
+    }
+  }
+
+  return handler_->OnListEnd();
+}
+
 // static
 bool JSONParser::StringsAreEqual(const char* one, const char* two, size_t len) {
   return strncmp(one, two, len) == 0;
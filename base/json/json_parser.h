@@ -66,6 +66,11 @@ class BASE_EXPORT_PRIVATE JSONParser {
   // result as a Value owned by the caller.
   Value* Parse(const StringPiece& input);
 
+  // Parses the input string according to the set options and reports its
+  // contents to |handler|.  Returns false on error or if |handler| stopped
+  // the parse.
+  bool Parse(const StringPiece& input, JSONReader::Handler* handler);
+
   // Returns the error code.
   JSONReader::JsonParseError error_code() const;
 
@@ -143,6 +148,14 @@ class BASE_EXPORT_PRIVATE JSONParser {
     std::string* string_;
   };
 
+  // Resets the parser to the start of the |length| bytes at |start|, skipping
+  // a UTF-8 Byte-Order-Mark.
+  void StartParsing(const char* start, size_t length);
+
+  // Returns true if the input stream is at an end, and reports an error
+  // otherwise.
+  bool CheckEndOfInput();
+
   // Quick check that the stream has capacity to consume |length| more bytes.
   bool CanConsume(int length);
 
@@ -202,6 +215,10 @@ class BASE_EXPORT_PRIVATE JSONParser {
   // Assuming that the parser is wound to the start of a valid JSON number,
   // this parses and converts it to either an int or double value.
   Value* ConsumeNumber();
+
+  // Helper for ConsumeNumber() that parses the number and sets |*is_int| and
+  // either |*int_value| or |*double_value|.  Returns false on failure.
+  bool ConsumeNumberRaw(bool* is_int, int* int_value, double* double_value);
   // Helper that reads characters that are ints. Returns true if a number was
   // read and false on error.
   bool ReadInt(bool allow_leading_zeros);
@@ -210,6 +227,18 @@ class BASE_EXPORT_PRIVATE JSONParser {
   // parser is wound to the first character of any of those.
   Value* ConsumeLiteral();
 
+  // Helper for ConsumeLiteral() that consumes |literal|, assuming the parser
+  // is wound to its first character.  Returns false on failure.
+  bool ConsumeLiteralRaw(const char* literal);
+
+  // Counterparts of ParseNextToken(), ParseToken(), ConsumeDictionary() and
+  // ConsumeList() that report values to |handler_| instead of building them.
+  // Each returns false on error or if |handler_| stopped the parse.
+  bool ReportNextToken();
+  bool ReportToken(Token token);
+  bool ReportDictionary();
+  bool ReportList();
+
   // Compares two string buffers of a given length.
   static bool StringsAreEqual(const char* left, const char* right, size_t len);
 
@@ -226,6 +255,9 @@ class BASE_EXPORT_PRIVATE JSONParser {
   // base::JSONParserOptions that control parsing.
   int options_;
 
+  // The handler that Parse(input, handler) reports to.  Weak.
+  JSONReader::Handler* handler_;
+
   // Pointer to the start of the input data.
   const char* start_pos_;
 
@@ -103,6 +103,10 @@ Value* JSONReader::ReadToValue(const std::string& json) {
   return parser_->Parse(json);
 }
 
+bool JSONReader::ReadToHandler(const StringPiece& json, Handler* handler) {
+  return parser_->Parse(json, handler);
+}
+
 JSONReader::JsonParseError JSONReader::error_code() const {
   return parser_->error_code();
 }
@@ -3,7 +3,8 @@
 // found in the LICENSE file.
 //
 // A JSON parser.  Converts strings of JSON into a Value object (see
-// base/values.h).
+// base/values.h), or reports their contents to a JSONReader::Handler without
+// building a Value tree.
 // http://www.ietf.org/rfc/rfc4627.txt?number=4627
 //
 // Known limitations/deviations from the RFC:
@@ -58,6 +59,11 @@ enum JSONParserOptions {
   // if the child is Remove()d from root, it would result in use-after-free
   // unless it is DeepCopy()ed or this option is used.
   JSON_DETACHABLE_CHILDREN = 1 << 1,
+
+  // Produces DictionaryValues with DictionaryValue::STORAGE_FLAT, which saves
+  // memory for large documents whose keys are mostly in sorted order, such as
+  // those written by JSONWriter.
+  JSON_COMPACT_DICTIONARIES = 1 << 2,
 };
 
 class BASE_EXPORT JSONReader {
@@ -86,6 +92,30 @@ class BASE_EXPORT JSONReader {
   static const char* kUnsupportedEncoding;
   static const char* kUnquotedDictionaryKey;
 
+  // Receives the contents of a JSON document from ReadToHandler() in document
+  // order.  Every method returns true to continue parsing or false to stop.
+  // The StringPieces passed to the handler point into the input, or into a
+  // temporary buffer if the string contained escape sequences, and are only
+  // valid for the duration of the call.
+  class BASE_EXPORT Handler {
+   public:
+    virtual bool OnDictionaryBegin() = 0;
+    // Called for each key of a dictionary, followed by the events for its
+    // value.
+    virtual bool OnDictionaryKey(const StringPiece& key) = 0;
+    virtual bool OnDictionaryEnd() = 0;
+    virtual bool OnListBegin() = 0;
+    virtual bool OnListEnd() = 0;
+    virtual bool OnString(const StringPiece& value) = 0;
+    virtual bool OnInteger(int value) = 0;
+    virtual bool OnDouble(double value) = 0;
+    virtual bool OnBoolean(bool value) = 0;
+    virtual bool OnNull() = 0;
+
+   protected:
+    virtual ~Handler() {}
+  };
+
   // Constructs a reader with the default options, JSON_PARSE_RFC.
   JSONReader();
 
@@ -119,8 +149,16 @@ class BASE_EXPORT JSONReader {
   // Parses an input string into a Value that is owned by the caller.
   Value* ReadToValue(const std::string& json);
 
-  // Returns the error code if the last call to ReadToValue() failed.
-  // Returns JSON_NO_ERROR otherwise.
+  // Parses |json| and reports its contents to |handler| as they are parsed,
+  // which avoids holding the whole document as a Value tree in memory.
+  // Returns true if all of |json| was parsed.  Returns false if |json| is not
+  // properly formed, in which case |handler| may already have seen some of
+  // its contents, or if |handler| stopped the parse, in which case
+  // error_code() is JSON_NO_ERROR.  JSON_DETACHABLE_CHILDREN has no effect.
+  bool ReadToHandler(const StringPiece& json, Handler* handler);
+
+  // Returns the error code if the last call to ReadToValue() or
+  // ReadToHandler() failed.  Returns JSON_NO_ERROR otherwise.
   JsonParseError error_code() const;
 
   // Converts error_code_ to a human-readable string, including line and column
@@ -0,0 +1,167 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Compares the time and peak memory of building a Value tree with
+// JSONReader::Read(), with and without JSON_COMPACT_DICTIONARIES, against
+// scanning the same document with JSONReader::ReadToHandler(), for a 20 MB
+// document shaped like a Preferences file.
+
+#include "build/build_config.h"
+
+#if defined(OS_LINUX)
+#include <malloc.h>
+#endif
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/file_util.h"
+#include "base/files/file_path.h"
+#include "base/json/json_reader.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/process/process_metrics.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+const size_t kDocumentSize = 20 * 1024 * 1024;
+
+// Builds a document of at least |size| bytes that resembles a Preferences
+// file: nested dictionaries of per-site and per-extension settings holding
+// strings, numbers, booleans and lists.  Like a file written by JSONWriter,
+// the keys of every dictionary are sorted.
+std::string MakePreferencesDocument(size_t size) {
+  std::string json;
+  json.reserve(size + 4096);
+  json += "{\"browser\": {\"window_placement\": {\"bottom\": 1050, "
+          "\"left\": 10, \"maximized\": false}},\n \"extensions\": {"
+          "\"settings\": {";
+  for (int i = 0; json.size() < size / 2; ++i) {
+    StringAppendF(&json,
+                  "%s\"%032d\": {\"active_permissions\": {\"api\": "
+                  "[\"storage\", \"tabs\", \"webRequest\"], \"explicit_host\":"
+                  " [\"http://*/*\", \"https://*/*\"]}, \"from_webstore\": "
+                  "true, \"install_time\": \"130%015d\", \"manifest\": {"
+                  "\"name\": \"Extension \\u00e9 %d\", \"version\": "
+                  "\"1.0.%d\"}, \"state\": 1}",
+                  i ? ",\n  " : "", i, i, i, i);
+  }
+  json += "}},\n \"profile\": {\"content_settings\": {\"exceptions\": {";
+  for (int i = 0; json.size() < size; ++i) {
+    StringAppendF(&json,
+                  "%s\"https://www%08d.example.com:443,*\": {\"last_used\": "
+                  "%d.%d, \"per_resource\": {}, \"setting\": %d}",
+                  i ? ",\n  " : "", i, 1400000000 + i, i % 1000, i % 3);
+  }
+  json += "}}}}\n";
+  return json;
+}
+
+// Counts the scalar values of a document without keeping any of it.
+class CountingHandler : public JSONReader::Handler {
+ public:
+  CountingHandler() : count_(0) {}
+
+  virtual bool OnDictionaryBegin() OVERRIDE { return true; }
+  virtual bool OnDictionaryKey(const StringPiece& key) OVERRIDE {
+    return true;
+  }
+  virtual bool OnDictionaryEnd() OVERRIDE { return true; }
+  virtual bool OnListBegin() OVERRIDE { return true; }
+  virtual bool OnListEnd() OVERRIDE { return true; }
+  virtual bool OnString(const StringPiece& value) OVERRIDE { return Count(); }
+  virtual bool OnInteger(int value) OVERRIDE { return Count(); }
+  virtual bool OnDouble(double value) OVERRIDE { return Count(); }
+  virtual bool OnBoolean(bool value) OVERRIDE { return Count(); }
+  virtual bool OnNull() OVERRIDE { return Count(); }
+
+  int count() const { return count_; }
+
+ private:
+  bool Count() {
+    ++count_;
+    return true;
+  }
+
+  int count_;
+};
+
+class JSONReaderPerfTest : public testing::Test {
+ public:
+  JSONReaderPerfTest()
+      : metrics_(ProcessMetrics::CreateProcessMetrics(
+            GetCurrentProcessHandle())) {
+  }
+
+  virtual void SetUp() OVERRIDE {
+    document_ = MakePreferencesDocument(kDocumentSize);
+  }
+
+ protected:
+  // Starts measuring time and the resident set growth of a parse.
+  void StartMeasuring() {
+#if defined(OS_LINUX)
+    // Returns memory freed by earlier tests to the system, so that it does
+    // not hide the growth of this one, and resets the resident set high water
+    // mark of the process if the kernel supports it.  Otherwise the peak
+    // numbers below are upper bounds.
+    malloc_trim(0);
+    file_util::WriteFile(FilePath("/proc/self/clear_refs"), "5", 1);
+#endif
+    start_rss_ = metrics_->GetWorkingSetSize();
+    start_time_ = TimeTicks::HighResNow();
+  }
+
+  void PrintResults(const std::string& trace) {
+    double elapsed_ms = (TimeTicks::HighResNow() - start_time_).
+        InMillisecondsF();
+    size_t peak_rss = metrics_->GetPeakWorkingSetSize();
+    perf_test::PrintResult("json_parse_time", "", trace, elapsed_ms, "ms",
+                           true);
+    size_t growth = peak_rss > start_rss_ ? peak_rss - start_rss_ : 0;
+    perf_test::PrintResult("json_parse_peak_rss_growth", "", trace,
+                           growth / 1024, "KB", true);
+  }
+
+  std::string document_;
+
+ private:
+  scoped_ptr<ProcessMetrics> metrics_;
+  size_t start_rss_;
+  TimeTicks start_time_;
+};
+
+}  // namespace
+
+TEST_F(JSONReaderPerfTest, ReadToHandler) {
+  StartMeasuring();
+  JSONReader reader;
+  CountingHandler handler;
+  EXPECT_TRUE(reader.ReadToHandler(document_, &handler));
+  PrintResults("read_to_handler");
+  EXPECT_LT(0, handler.count());
+}
+
+TEST_F(JSONReaderPerfTest, ReadToValue) {
+  StartMeasuring();
+  scoped_ptr<Value> root(JSONReader::Read(document_));
+  PrintResults("read_to_value");
+  EXPECT_TRUE(root.get());
+}
+
+TEST_F(JSONReaderPerfTest, ReadToCompactValue) {
+  StartMeasuring();
+  scoped_ptr<Value> root(
+      JSONReader::Read(document_, JSON_COMPACT_DICTIONARIES));
+  PrintResults("read_to_compact_value");
+  EXPECT_TRUE(root.get());
+}
+
+}  // namespace base
@@ -10,6 +10,7 @@
 #include "base/memory/scoped_ptr.h"
 #include "base/path_service.h"
 #include "base/strings/string_piece.h"
+#include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/values.h"
 #include "build/build_config.h"
@@ -17,6 +18,128 @@
 
 namespace base {
 
+namespace {
+
+// Records the events of JSONReader::ReadToHandler() as a string, and stops
+// the parse after |max_events| of them.
+class RecordingHandler : public JSONReader::Handler {
+ public:
+  explicit RecordingHandler(int max_events = -1) : max_events_(max_events) {}
+
+  virtual bool OnDictionaryBegin() OVERRIDE { return Record("{"); }
+  virtual bool OnDictionaryKey(const StringPiece& key) OVERRIDE {
+    return Record("k:" + key.as_string());
+  }
+  virtual bool OnDictionaryEnd() OVERRIDE { return Record("}"); }
+  virtual bool OnListBegin() OVERRIDE { return Record("["); }
+  virtual bool OnListEnd() OVERRIDE { return Record("]"); }
+  virtual bool OnString(const StringPiece& value) OVERRIDE {
+    return Record("s:" + value.as_string());
+  }
+  virtual bool OnInteger(int value) OVERRIDE {
+    return Record(StringPrintf("i:%d", value));
+  }
+  virtual bool OnDouble(double value) OVERRIDE {
+    return Record(StringPrintf("d:%g", value));
+  }
+  virtual bool OnBoolean(bool value) OVERRIDE {
+    return Record(value ? "true" : "false");
+  }
+  virtual bool OnNull() OVERRIDE { return Record("null"); }
+
+  const std::string& events() const { return events_; }
+
+ private:
+  bool Record(const std::string& event) {
+    if (!events_.empty())
+      events_ += " ";
+    events_ += event;
+    return max_events_ < 0 || --max_events_ > 0;
+  }
+
+  int max_events_;
+  std::string events_;
+};
+
+}  // namespace
+
+TEST(JSONReaderTest, ReadToHandler) {
+  JSONReader reader;
+  RecordingHandler handler;
+  EXPECT_TRUE(reader.ReadToHandler(
+      "{\"a\": [1, -2.5, \"x\\ny\"], \"\\u00e9\": {}, \"b\": true,"
+      " \"c\": false, \"d\": null, \"e\": []} // comment",
+      &handler));
+  EXPECT_EQ(JSONReader::JSON_NO_ERROR, reader.error_code());
+  EXPECT_EQ("{ k:a [ i:1 d:-2.5 s:x\ny ] k:\xC3\xA9 { } k:b true k:c false"
+            " k:d null k:e [ ] }",
+            handler.events());
+
+  RecordingHandler scalar_handler;
+  EXPECT_TRUE(reader.ReadToHandler("\xEF\xBB\xBF 42 ", &scalar_handler));
+  EXPECT_EQ("i:42", scalar_handler.events());
+}
+
+TEST(JSONReaderTest, ReadToHandlerErrors) {
+  const struct {
+    const char* json;
+    JSONReader::JsonParseError error;
+    const char* events;
+  } kCases[] = {
+    {"[1, 2,]", JSONReader::JSON_TRAILING_COMMA, "[ i:1 i:2"},
+    {"{\"a\" 1}", JSONReader::JSON_SYNTAX_ERROR, "{"},
+    {"{a: 1}", JSONReader::JSON_UNQUOTED_DICTIONARY_KEY, "{"},
+    {"[tru]", JSONReader::JSON_SYNTAX_ERROR, "["},
+    {"[1] 2", JSONReader::JSON_UNEXPECTED_DATA_AFTER_ROOT, "[ i:1 ]"},
+    {"", JSONReader::JSON_UNEXPECTED_TOKEN, ""},
+  };
+  for (size_t i = 0; i < arraysize(kCases); ++i) {
+    JSONReader reader;
+    RecordingHandler handler;
+    EXPECT_FALSE(reader.ReadToHandler(kCases[i].json, &handler)) << i;
+    EXPECT_EQ(kCases[i].error, reader.error_code()) << i;
+    EXPECT_EQ(kCases[i].events, handler.events()) << i;
+  }
+
+  // The same limits as for ReadToValue() apply.
+  JSONReader reader;
+  RecordingHandler handler;
+  EXPECT_FALSE(reader.ReadToHandler(std::string(101, '[') +
+                                        std::string(101, ']'),
+                                    &handler));
+  EXPECT_EQ(JSONReader::JSON_TOO_MUCH_NESTING, reader.error_code());
+
+  JSONReader lenient_reader(JSON_ALLOW_TRAILING_COMMAS);
+  RecordingHandler lenient_handler;
+  EXPECT_TRUE(lenient_reader.ReadToHandler("[1, 2,]", &lenient_handler));
+  EXPECT_EQ("[ i:1 i:2 ]", lenient_handler.events());
+}
+
+TEST(JSONReaderTest, ReadToHandlerStops) {
+  JSONReader reader;
+  RecordingHandler handler(3);
+  EXPECT_FALSE(reader.ReadToHandler("{\"a\": [1, 2, 3]}", &handler));
+  EXPECT_EQ(JSONReader::JSON_NO_ERROR, reader.error_code());
+  EXPECT_EQ("{ k:a [", handler.events());
+}
+
+TEST(JSONReaderTest, CompactDictionaries) {
+  const char kJson[] = "{\"b\": {\"y\": 1, \"x\": [{}]}, \"a\": true}";
+  scoped_ptr<Value> compact(
+      JSONReader::Read(kJson, JSON_COMPACT_DICTIONARIES));
+  ASSERT_TRUE(compact.get());
+  const DictionaryValue* dict = NULL;
+  ASSERT_TRUE(compact->GetAsDictionary(&dict));
+  EXPECT_EQ(DictionaryValue::STORAGE_FLAT, dict->storage());
+  const DictionaryValue* child = NULL;
+  ASSERT_TRUE(dict->GetDictionary("b", &child));
+  EXPECT_EQ(DictionaryValue::STORAGE_FLAT, child->storage());
+
+  scoped_ptr<Value> regular(JSONReader::Read(kJson));
+  ASSERT_TRUE(regular.get());
+  EXPECT_TRUE(regular->Equals(compact.get()));
+}
+
 TEST(JSONReaderTest, Reading) {
   // some whitespace checking
   scoped_ptr<Value> root;
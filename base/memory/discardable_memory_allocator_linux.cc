@@ -0,0 +1,358 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/discardable_memory_allocator_linux.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "base/atomicops.h"
+#include "base/logging.h"
+#include "base/memory/discardable_memory.h"
+
+// Older headers don't know about MADV_FREE.
+#if !defined(MADV_FREE)
+#define MADV_FREE 8
+#endif
+
+// The allocator consists of three parts (classes):
+// - DiscardableMemoryAllocatorLinux: entry point of all allocations, which are
+// dispatched to the Region instances it owns.
+// - Region: manages the chunks of a single large anonymous mapping.
+// - DiscardableChunk: implements the DiscardableMemory interface for the
+// client on a page-aligned subrange of a region.
+//
+// Detecting purges: once the kernel reclaims a page given to MADV_FREE, the
+// next access to it maps a fresh zero page. A write to a page that wasn't
+// reclaimed yet cancels MADV_FREE for that page. So Unlock() records the first
+// nonzero word of each page, and Lock() does an atomic read-modify-write of
+// that word that leaves its value alone: the write keeps the page from being
+// reclaimed from then on, and the value read back tells whether it already
+// was. A page without any nonzero word loses nothing when it is reclaimed.
+
+namespace base {
+namespace {
+
+size_t GetPageSize() {
+  return static_cast<size_t>(getpagesize());
+}
+
+// Returns 0 if the provided size is too high to be aligned.
+size_t AlignToNextPage(size_t size) {
+  const size_t page_size = GetPageSize();
+  if (size > std::numeric_limits<size_t>::max() - page_size + 1)
+    return 0;
+  return (size + page_size - 1) & ~(page_size - 1);
+}
+
+}  // namespace
+
+namespace internal {
+
+class DiscardableMemoryAllocatorLinux::DiscardableChunk
+    : public DiscardableMemory {
+ public:
+  // Note that |region| must outlive |this|.
+  DiscardableChunk(Region* region, char* address, size_t size)
+      : region_(region),
+        address_(address),
+        size_(size),
+        locked_(true) {
+  }
+
+  // Implemented below Region since this requires the full definition of
+  // Region.
+  virtual ~DiscardableChunk();
+
+  // DiscardableMemory:
+  virtual DiscardableMemoryLockStatus Lock() OVERRIDE {
+    DCHECK(!locked_);
+#if !defined(NDEBUG)
+    if (mprotect(address_, size_, PROT_READ | PROT_WRITE)) {
+      DPLOG(ERROR) << "mprotect";
+      return DISCARDABLE_MEMORY_LOCK_STATUS_FAILED;
+    }
+#endif
+    locked_ = true;
+
+    bool purged = false;
+    const size_t page_size = GetPageSize();
+    for (size_t i = 0; i < witnesses_.size(); ++i) {
+      subtle::Atomic32* word =
+          reinterpret_cast<subtle::Atomic32*>(address_ + i * page_size) +
+          witnesses_[i].index;
+      if (subtle::NoBarrier_AtomicIncrement(word, 0) != witnesses_[i].value)
+        purged = true;
+    }
+    return purged ? DISCARDABLE_MEMORY_LOCK_STATUS_PURGED :
+                    DISCARDABLE_MEMORY_LOCK_STATUS_SUCCESS;
+  }
+
+  virtual void Unlock() OVERRIDE {
+    DCHECK(locked_);
+    locked_ = false;
+
+    const size_t page_size = GetPageSize();
+    const size_t words_per_page = page_size / sizeof(subtle::Atomic32);
+    witnesses_.resize(size_ / page_size);
+    for (size_t i = 0; i < witnesses_.size(); ++i) {
+      const subtle::Atomic32* page =
+          reinterpret_cast<const subtle::Atomic32*>(address_ + i * page_size);
+      size_t index = 0;
+      while (index + 1 < words_per_page && !page[index])
+        ++index;
+      witnesses_[i].index = static_cast<uint32>(index);
+      witnesses_[i].value = page[index];
+    }
+
+    if (madvise(address_, size_, MADV_FREE))
+      DPLOG(ERROR) << "madvise(MADV_FREE)";
+#if !defined(NDEBUG)
+    // Make accesses to unlocked memory crash.
+    if (mprotect(address_, size_, PROT_NONE))
+      DPLOG(ERROR) << "mprotect";
+#endif
+  }
+
+  virtual void* Memory() const OVERRIDE {
+    return address_;
+  }
+
+  char* address() const { return address_; }
+  size_t size() const { return size_; }
+
+  void PurgeForTesting() {
+    if (!locked_ && madvise(address_, size_, MADV_DONTNEED))
+      DPLOG(ERROR) << "madvise(MADV_DONTNEED)";
+  }
+
+ private:
+  // A word of a page and its value when the chunk was unlocked.
+  struct PageWitness {
+    uint32 index;
+    subtle::Atomic32 value;
+  };
+
+  Region* const region_;
+  char* const address_;
+  const size_t size_;
+  bool locked_;
+  std::vector<PageWitness> witnesses_;
+
+  DISALLOW_COPY_AND_ASSIGN(DiscardableChunk);
+};
+
+class DiscardableMemoryAllocatorLinux::Region {
+ public:
+  // Note that |allocator| must outlive |this|.
+  static scoped_ptr<Region> Create(size_t size,
+                                   DiscardableMemoryAllocatorLinux* allocator) {
+    DCHECK_EQ(size, AlignToNextPage(size));
+    void* base = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+      DPLOG(ERROR) << "Failed to map memory.";
+      return scoped_ptr<Region>();
+    }
+    return make_scoped_ptr(
+        new Region(static_cast<char*>(base), size, allocator));
+  }
+
+  ~Region() {
+    DCHECK(chunks_.empty());
+    if (munmap(base_, size_))
+      DPLOG(ERROR) << "munmap";
+  }
+
+  // Returns a new chunk of |size| bytes, a multiple of the page size, or NULL
+  // if this region has no free chunk that large. The smallest free chunk that
+  // fits is split.
+  scoped_ptr<DiscardableMemory> Allocate_Locked(size_t size) {
+    allocator_->lock_.AssertAcquired();
+    const SizeToFreeChunkMap::iterator best_fit =
+        free_chunks_by_size_.lower_bound(size);
+    if (best_fit == free_chunks_by_size_.end())
+      return scoped_ptr<DiscardableMemory>();
+
+    char* const start = best_fit->second;
+    const size_t free_size = best_fit->first;
+    RemoveFreeChunk_Locked(free_chunks_.find(start));
+    if (free_size > size)
+      AddFreeChunk_Locked(start + size, free_size - size);
+
+    DiscardableChunk* chunk = new DiscardableChunk(this, start, size);
+    chunks_.insert(chunk);
+    return scoped_ptr<DiscardableMemory>(chunk);
+  }
+
+  void OnChunkDeletion(DiscardableChunk* chunk) {
+    AutoLock auto_lock(allocator_->lock_);
+    chunks_.erase(chunk);
+
+    // Give the pages back now rather than when the kernel gets to them.
+    char* start = chunk->address();
+    size_t size = chunk->size();
+    if (madvise(start, size, MADV_DONTNEED))
+      DPLOG(ERROR) << "madvise(MADV_DONTNEED)";
+
+    if (chunks_.empty()) {
+      allocator_->DeleteRegion_Locked(this);  // Deletes |this|.
+      return;
+    }
+
+    // Merge with the free chunks before and after it, if any.
+    const FreeChunkMap::iterator next = free_chunks_.find(start + size);
+    if (next != free_chunks_.end()) {
+      size += next->second;
+      RemoveFreeChunk_Locked(next);
+    }
+    FreeChunkMap::iterator previous = free_chunks_.lower_bound(start);
+    if (previous != free_chunks_.begin()) {
+      --previous;
+      if (previous->first + previous->second == start) {
+        start = previous->first;
+        size += previous->second;
+        RemoveFreeChunk_Locked(previous);
+      }
+    }
+    AddFreeChunk_Locked(start, size);
+  }
+
+  void PurgeForTesting_Locked() {
+    allocator_->lock_.AssertAcquired();
+    for (std::set<DiscardableChunk*>::iterator it = chunks_.begin();
+         it != chunks_.end(); ++it) {
+      (*it)->PurgeForTesting();
+    }
+  }
+
+ private:
+  // Free chunks, by start address for merging and by size for allocating.
+  typedef std::map<char*, size_t> FreeChunkMap;
+  typedef std::multimap<size_t, char*> SizeToFreeChunkMap;
+
+  // Note that |allocator| must outlive |this|.
+  Region(char* base, size_t size, DiscardableMemoryAllocatorLinux* allocator)
+      : base_(base),
+        size_(size),
+        allocator_(allocator) {
+    DCHECK(base);
+    DCHECK(allocator);
+    AddFreeChunk_Locked(base_, size_);
+  }
+
+  void AddFreeChunk_Locked(char* start, size_t size) {
+    free_chunks_.insert(std::make_pair(start, size));
+    free_chunks_by_size_.insert(std::make_pair(size, start));
+  }
+
+  void RemoveFreeChunk_Locked(FreeChunkMap::iterator it) {
+    DCHECK(it != free_chunks_.end());
+    std::pair<SizeToFreeChunkMap::iterator, SizeToFreeChunkMap::iterator>
+        same_size = free_chunks_by_size_.equal_range(it->second);
+    for (SizeToFreeChunkMap::iterator size_it = same_size.first;
+         size_it != same_size.second; ++size_it) {
+      if (size_it->second == it->first) {
+        free_chunks_by_size_.erase(size_it);
+        break;
+      }
+    }
+    free_chunks_.erase(it);
+  }
+
+  char* const base_;
+  const size_t size_;
+  DiscardableMemoryAllocatorLinux* const allocator_;
+  FreeChunkMap free_chunks_;
+  SizeToFreeChunkMap free_chunks_by_size_;
+  std::set<DiscardableChunk*> chunks_;
+
+  DISALLOW_COPY_AND_ASSIGN(Region);
+};
+
+DiscardableMemoryAllocatorLinux::DiscardableChunk::~DiscardableChunk() {
+#if !defined(NDEBUG)
+  if (!locked_ && mprotect(address_, size_, PROT_READ | PROT_WRITE))
+    DPLOG(ERROR) << "mprotect";
+#endif
+  region_->OnChunkDeletion(this);
+}
+
+DiscardableMemoryAllocatorLinux::DiscardableMemoryAllocatorLinux(
+    size_t region_size)
+    : region_size_(AlignToNextPage(region_size)) {
+  DCHECK(region_size_);
+}
+
+DiscardableMemoryAllocatorLinux::~DiscardableMemoryAllocatorLinux() {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  DCHECK(regions_.empty());
+}
+
+// static
+bool DiscardableMemoryAllocatorLinux::IsSupported() {
+  const size_t page_size = GetPageSize();
+  void* page = mmap(NULL, page_size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (page == MAP_FAILED)
+    return false;
+  // Older kernels fail with EINVAL, and the sandbox with EPERM.
+  const bool supported = !madvise(page, page_size, MADV_FREE);
+  munmap(page, page_size);
+  return supported;
+}
+
+scoped_ptr<DiscardableMemory> DiscardableMemoryAllocatorLinux::Allocate(
+    size_t size) {
+  const size_t aligned_size = AlignToNextPage(size);
+  if (!aligned_size)
+    return scoped_ptr<DiscardableMemory>();
+
+  AutoLock auto_lock(lock_);
+  for (ScopedVector<Region>::iterator it = regions_.begin();
+       it != regions_.end(); ++it) {
+    scoped_ptr<DiscardableMemory> memory((*it)->Allocate_Locked(aligned_size));
+    if (memory)
+      return memory.Pass();
+  }
+
+  scoped_ptr<Region> new_region(
+      Region::Create(std::max(region_size_, aligned_size), this));
+  if (!new_region)
+    return scoped_ptr<DiscardableMemory>();
+  regions_.push_back(new_region.release());
+  return regions_.back()->Allocate_Locked(aligned_size);
+}
+
+void DiscardableMemoryAllocatorLinux::PurgeForTesting() {
+  AutoLock auto_lock(lock_);
+  for (ScopedVector<Region>::iterator it = regions_.begin();
+       it != regions_.end(); ++it) {
+    (*it)->PurgeForTesting_Locked();
+  }
+}
+
+size_t DiscardableMemoryAllocatorLinux::region_count() const {
+  AutoLock auto_lock(lock_);
+  return regions_.size();
+}
+
+void DiscardableMemoryAllocatorLinux::DeleteRegion_Locked(Region* region) {
+  lock_.AssertAcquired();
+  const ScopedVector<Region>::iterator it =
+      std::find(regions_.begin(), regions_.end(), region);
+  DCHECK(it != regions_.end());
+  std::swap(*it, regions_.back());
+  regions_.pop_back();
+}
+
+}  // namespace internal
+}  // namespace base
@@ -0,0 +1,77 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_MEMORY_DISCARDABLE_MEMORY_ALLOCATOR_LINUX_H_
+#define BASE_MEMORY_DISCARDABLE_MEMORY_ALLOCATOR_LINUX_H_
+
+#include "base/base_export.h"
+#include "base/basictypes.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/thread_checker.h"
+
+namespace base {
+
+class DiscardableMemory;
+
+namespace internal {
+
+// On Linux, discardable memory is anonymous memory given to
+// madvise(MADV_FREE) while it is unlocked: the kernel reclaims those pages
+// only when it runs short of memory, and they read back as zeros afterwards.
+// Lock() detects that by checking one word of each page against its value at
+// Unlock() time (see discardable_memory_allocator_linux.cc). Pages which only
+// held zeros lose nothing, so reclaiming them isn't reported as a purge.
+//
+// Like the Android allocator, this allocator hands out page-aligned chunks of
+// large mappings ("regions") so that allocations don't each cost an mmap()
+// and its own kernel VMA. Unlike ashmem, the pages of a freed chunk are given
+// back to the kernel immediately.
+//
+// Threading: The allocator must be deleted on the thread it was constructed on
+// although its Allocate() method can be invoked on any thread. See
+// discardable_memory.h for DiscardableMemory's threading guarantees.
+class BASE_EXPORT_PRIVATE DiscardableMemoryAllocatorLinux {
+ public:
+  // |region_size| is the size of the regions the chunks are carved from.
+  // Larger allocations get a region of their own.
+  explicit DiscardableMemoryAllocatorLinux(size_t region_size);
+
+  ~DiscardableMemoryAllocatorLinux();
+
+  // Returns true if the kernel supports MADV_FREE (Linux 4.5 and later) and
+  // the process is allowed to use it.
+  static bool IsSupported();
+
+  // Note that the allocator must outlive the returned DiscardableMemory
+  // instance.
+  scoped_ptr<DiscardableMemory> Allocate(size_t size);
+
+  // Discards the pages of all the unlocked chunks, like the kernel would under
+  // memory pressure. Use only for testing!
+  void PurgeForTesting();
+
+  // Returns the number of regions currently mapped. This is used for testing
+  // only.
+  size_t region_count() const;
+
+ private:
+  class Region;
+  class DiscardableChunk;
+
+  void DeleteRegion_Locked(Region* region);
+
+  ThreadChecker thread_checker_;
+  const size_t region_size_;
+  mutable Lock lock_;
+  ScopedVector<Region> regions_;
+
+  DISALLOW_COPY_AND_ASSIGN(DiscardableMemoryAllocatorLinux);
+};
+
+}  // namespace internal
+}  // namespace base
+
+#endif  // BASE_MEMORY_DISCARDABLE_MEMORY_ALLOCATOR_LINUX_H_
@@ -0,0 +1,183 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/discardable_memory_allocator_linux.h"
+
+#include <string.h>
+#include <unistd.h>
+
+#include <limits>
+
+#include "base/memory/discardable_memory.h"
+#include "base/memory/scoped_ptr.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace internal {
+
+const size_t kRegionSizeForTesting = 32 * 1024 * 1024;
+
+class DiscardableMemoryAllocatorLinuxTest : public testing::Test {
+ protected:
+  DiscardableMemoryAllocatorLinuxTest()
+      : page_size_(getpagesize()),
+        allocator_(kRegionSizeForTesting) {
+  }
+
+  const size_t page_size_;
+  DiscardableMemoryAllocatorLinux allocator_;
+};
+
+TEST_F(DiscardableMemoryAllocatorLinuxTest, Basic) {
+  const size_t size = 128;
+  scoped_ptr<DiscardableMemory> memory(allocator_.Allocate(size));
+  ASSERT_TRUE(memory);
+  memset(memory->Memory(), 'a', size);
+  EXPECT_EQ(1u, allocator_.region_count());
+}
+
+TEST_F(DiscardableMemoryAllocatorLinuxTest, ZeroAllocationIsNotSupported) {
+  scoped_ptr<DiscardableMemory> memory(allocator_.Allocate(0));
+  ASSERT_FALSE(memory);
+}
+
+TEST_F(DiscardableMemoryAllocatorLinuxTest, TooLargeAllocationFails) {
+  // Page-alignment would have caused an overflow resulting in a small
+  // allocation if the input size wasn't checked correctly.
+  scoped_ptr<DiscardableMemory> memory(
+      allocator_.Allocate(std::numeric_limits<size_t>::max() - 1));
+  ASSERT_FALSE(memory);
+  EXPECT_EQ(0u, allocator_.region_count());
+}
+
+TEST_F(DiscardableMemoryAllocatorLinuxTest, ChunksArePageAligned) {
+  scoped_ptr<DiscardableMemory> memory1(allocator_.Allocate(1));
+  scoped_ptr<DiscardableMemory> memory2(allocator_.Allocate(1));
+  ASSERT_TRUE(memory1);
+  ASSERT_TRUE(memory2);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(memory1->Memory()) % page_size_);
+  EXPECT_EQ(static_cast<char*>(memory1->Memory()) + page_size_,
+            memory2->Memory());
+}
+
+TEST_F(DiscardableMemoryAllocatorLinuxTest, LargeAllocationGetsOwnRegion) {
+  scoped_ptr<DiscardableMemory> small(allocator_.Allocate(page_size_));
+  ASSERT_TRUE(small);
+  scoped_ptr<DiscardableMemory> large(
+      allocator_.Allocate(kRegionSizeForTesting + 1));
+  ASSERT_TRUE(large);
+  EXPECT_EQ(2u, allocator_.region_count());
+
+  // Freeing the only chunk of a region unmaps it.
+  large.reset();
+  EXPECT_EQ(1u, allocator_.region_count());
+  small.reset();
+  EXPECT_EQ(0u, allocator_.region_count());
+}
+
+TEST_F(DiscardableMemoryAllocatorLinuxTest, AllocateUsesBestFitAlgorithm) {
+  scoped_ptr<DiscardableMemory> memory1(allocator_.Allocate(3 * page_size_));
+  scoped_ptr<DiscardableMemory> memory2(allocator_.Allocate(2 * page_size_));
+  scoped_ptr<DiscardableMemory> memory3(allocator_.Allocate(1 * page_size_));
+  scoped_ptr<DiscardableMemory> memory4(allocator_.Allocate(1 * page_size_));
+  ASSERT_TRUE(memory1);
+  ASSERT_TRUE(memory2);
+  ASSERT_TRUE(memory3);
+  ASSERT_TRUE(memory4);
+  void* const address_3 = memory3->Memory();
+  memory1.reset();
+  // Don't free |memory2| and |memory4| to avoid merging the blocks together.
+  memory3.reset();
+  memory1 = allocator_.Allocate(1 * page_size_);
+  ASSERT_TRUE(memory1);
+  // The chunk whose size is closest to the requested size should be reused.
+  EXPECT_EQ(address_3, memory1->Memory());
+}
+
+TEST_F(DiscardableMemoryAllocatorLinuxTest, MergeFreeChunks) {
+  scoped_ptr<DiscardableMemory> memory1(allocator_.Allocate(page_size_));
+  scoped_ptr<DiscardableMemory> memory2(allocator_.Allocate(page_size_));
+  scoped_ptr<DiscardableMemory> memory3(allocator_.Allocate(page_size_));
+  scoped_ptr<DiscardableMemory> memory4(allocator_.Allocate(page_size_));
+  ASSERT_TRUE(memory4);
+  void* const memory1_address = memory1->Memory();
+  memory1.reset();
+  memory3.reset();
+  // Freeing |memory2| (located between memory1 and memory3) should merge the
+  // three free blocks together.
+  memory2.reset();
+  memory1 = allocator_.Allocate(3 * page_size_);
+  ASSERT_TRUE(memory1);
+  EXPECT_EQ(memory1_address, memory1->Memory());
+}
+
+TEST_F(DiscardableMemoryAllocatorLinuxTest, FreedChunksAreCleared) {
+  scoped_ptr<DiscardableMemory> memory(allocator_.Allocate(page_size_));
+  // Keeps the region alive.
+  scoped_ptr<DiscardableMemory> other(allocator_.Allocate(page_size_));
+  ASSERT_TRUE(memory);
+  void* const address = memory->Memory();
+  memset(address, 'a', page_size_);
+  memory.reset();
+
+  // The pages of the freed chunk were given back to the kernel.
+  memory = allocator_.Allocate(page_size_);
+  ASSERT_TRUE(memory);
+  ASSERT_EQ(address, memory->Memory());
+  EXPECT_EQ(0, static_cast<char*>(memory->Memory())[0]);
+}
+
+TEST_F(DiscardableMemoryAllocatorLinuxTest, LockKeepsData) {
+  if (!DiscardableMemoryAllocatorLinux::IsSupported())
+    return;
+
+  const size_t size = 4 * page_size_;
+  scoped_ptr<DiscardableMemory> memory(allocator_.Allocate(size));
+  ASSERT_TRUE(memory);
+  memset(memory->Memory(), 'a', size);
+  // Leave a page without any nonzero word.
+  memset(static_cast<char*>(memory->Memory()) + page_size_, 0, page_size_);
+
+  memory->Unlock();
+  ASSERT_EQ(DISCARDABLE_MEMORY_LOCK_STATUS_SUCCESS, memory->Lock());
+  EXPECT_EQ('a', static_cast<char*>(memory->Memory())[0]);
+  EXPECT_EQ('a', static_cast<char*>(memory->Memory())[size - 1]);
+  memory->Unlock();
+}
+
+TEST_F(DiscardableMemoryAllocatorLinuxTest, PurgeIsDetected) {
+  if (!DiscardableMemoryAllocatorLinux::IsSupported())
+    return;
+
+  const size_t size = 2 * page_size_;
+  scoped_ptr<DiscardableMemory> purged(allocator_.Allocate(size));
+  scoped_ptr<DiscardableMemory> locked(allocator_.Allocate(size));
+  ASSERT_TRUE(purged);
+  ASSERT_TRUE(locked);
+  // Only the end of the last page is nonzero.
+  static_cast<char*>(purged->Memory())[size - 1] = 'a';
+  memset(locked->Memory(), 'b', size);
+
+  purged->Unlock();
+  allocator_.PurgeForTesting();
+  EXPECT_EQ(DISCARDABLE_MEMORY_LOCK_STATUS_PURGED, purged->Lock());
+  EXPECT_EQ(0, static_cast<char*>(purged->Memory())[size - 1]);
+
+  // Locked chunks are left alone.
+  EXPECT_EQ('b', static_cast<char*>(locked->Memory())[size - 1]);
+}
+
+TEST_F(DiscardableMemoryAllocatorLinuxTest, PurgedZeroPagesLoseNothing) {
+  if (!DiscardableMemoryAllocatorLinux::IsSupported())
+    return;
+
+  scoped_ptr<DiscardableMemory> memory(allocator_.Allocate(page_size_));
+  ASSERT_TRUE(memory);
+  memory->Unlock();
+  allocator_.PurgeForTesting();
+  EXPECT_EQ(DISCARDABLE_MEMORY_LOCK_STATUS_SUCCESS, memory->Lock());
+}
+
+}  // namespace internal
+}  // namespace base
@@ -4,11 +4,32 @@
 
 #include "base/memory/discardable_memory.h"
 
+#include "base/lazy_instance.h"
 #include "base/logging.h"
+#include "base/memory/discardable_memory_allocator_linux.h"
 #include "base/memory/discardable_memory_emulated.h"
 #include "base/memory/discardable_memory_malloc.h"
 
 namespace base {
+namespace {
+
+const size_t kRegionSize = 32 * 1024 * 1024;
+
+struct DiscardableMemoryAllocatorWrapper {
+  DiscardableMemoryAllocatorWrapper()
+      : is_supported(internal::DiscardableMemoryAllocatorLinux::IsSupported()),
+        allocator(kRegionSize) {
+  }
+
+  // Whether the kernel can reclaim unlocked memory by itself.
+  const bool is_supported;
+  internal::DiscardableMemoryAllocatorLinux allocator;
+};
+
+LazyInstance<DiscardableMemoryAllocatorWrapper>::Leaky g_context =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
 
 // static
 void DiscardableMemory::RegisterMemoryPressureListeners() {
@@ -24,10 +45,14 @@ void DiscardableMemory::UnregisterMemoryPressureListeners() {
 void DiscardableMemory::GetSupportedTypes(
     std::vector<DiscardableMemoryType>* types) {
   const DiscardableMemoryType supported_types[] = {
+    DISCARDABLE_MEMORY_TYPE_LINUX,
     DISCARDABLE_MEMORY_TYPE_EMULATED,
     DISCARDABLE_MEMORY_TYPE_MALLOC
   };
-  types->assign(supported_types, supported_types + arraysize(supported_types));
+  // The native type needs MADV_FREE, which is decided at runtime.
+  const size_t first_type = g_context.Get().is_supported ? 0 : 1;
+  types->assign(supported_types + first_type,
+                supported_types + arraysize(supported_types));
 }
 
 // static
@@ -38,6 +63,12 @@ scoped_ptr<DiscardableMemory> DiscardableMemory::CreateLockedMemoryWithType(
     case DISCARDABLE_MEMORY_TYPE_ANDROID:
     case DISCARDABLE_MEMORY_TYPE_MAC:
       return scoped_ptr<DiscardableMemory>();
+    case DISCARDABLE_MEMORY_TYPE_LINUX: {
+      if (!g_context.Get().is_supported)
+        return scoped_ptr<DiscardableMemory>();
+
+      return g_context.Get().allocator.Allocate(size);
+    }
     case DISCARDABLE_MEMORY_TYPE_EMULATED: {
       scoped_ptr<internal::DiscardableMemoryEmulated> memory(
           new internal::DiscardableMemoryEmulated(size));
@@ -67,6 +98,7 @@ bool DiscardableMemory::PurgeForTestingSupported() {
 
 // static
 void DiscardableMemory::PurgeForTesting() {
+  g_context.Get().allocator.PurgeForTesting();
   internal::DiscardableMemoryEmulated::PurgeForTesting();
 }
 
@@ -4,6 +4,8 @@
 
 #include "base/memory/discardable_memory.h"
 
+#include <string.h>
+
 #include <algorithm>
 
 #include "base/run_loop.h"
@@ -48,7 +50,8 @@ TEST_P(DiscardableMemoryTest, IsNamed) {
 bool IsNativeType(DiscardableMemoryType type) {
   return
       type == DISCARDABLE_MEMORY_TYPE_ANDROID ||
-      type == DISCARDABLE_MEMORY_TYPE_MAC;
+      type == DISCARDABLE_MEMORY_TYPE_MAC ||
+      type == DISCARDABLE_MEMORY_TYPE_LINUX;
 }
 
 TEST_P(DiscardableMemoryTest, SupportedNatively) {
@@ -58,11 +61,14 @@ TEST_P(DiscardableMemoryTest, SupportedNatively) {
   EXPECT_NE(0, std::count_if(supported_types.begin(),
                              supported_types.end(),
                              IsNativeType));
+#elif defined(OS_LINUX)
+  // Linux decides at runtime: the native type needs a kernel with MADV_FREE.
+  EXPECT_GE(1, std::count_if(supported_types.begin(),
+                             supported_types.end(),
+                             IsNativeType));
 #else
-  // If we ever have a platform that decides at runtime if it can support
-  // discardable memory natively, then we'll have to add a 'never supported
-  // natively' define for this case. At present, if it's not always supported
-  // natively, it's never supported.
+  // Other platforms that don't always support discardable memory natively
+  // never do.
   EXPECT_EQ(0, std::count_if(supported_types.begin(),
                              supported_types.end(),
                              IsNativeType));
@@ -98,6 +104,8 @@ TEST_P(DiscardableMemoryTest, Purge) {
 
   const scoped_ptr<DiscardableMemory> memory(CreateLockedMemory(kSize));
   ASSERT_TRUE(memory);
+  // Some types can only tell a purge from the data it lost.
+  memset(memory->Memory(), 0xff, kSize);
   memory->Unlock();
 
   DiscardableMemory::PurgeForTesting();
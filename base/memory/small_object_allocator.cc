@@ -0,0 +1,148 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/small_object_allocator.h"
+
+#include <new>
+
+#include "base/atomicops.h"
+#include "base/lazy_instance.h"
+#include "base/logging.h"
+#include "base/threading/thread_local_storage.h"
+
+namespace base {
+
+namespace {
+
+// Sizes are rounded up to a multiple of this, which is also the alignment
+// that blocks are guaranteed to have.
+const size_t kSizeClassGranularity = 16;
+const size_t kNumSizeClasses =
+    SmallObjectAllocator::kMaxCachedSize / kSizeClassGranularity;
+
+// Upper bound on the memory a single thread keeps cached per size class.
+const size_t kMaxCachedBytesPerSizeClass = 16 * 1024;
+
+#if defined(ADDRESS_SANITIZER) || defined(MEMORY_SANITIZER)
+const subtle::Atomic32 kEnabledByDefault = 0;
+#else
+const subtle::Atomic32 kEnabledByDefault = 1;
+#endif
+
+subtle::Atomic32 g_enabled = kEnabledByDefault;
+
+// A cached block.  The link is stored in the block itself.
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+struct ThreadCache {
+  FreeBlock* free_lists[kNumSizeClasses];
+  size_t free_counts[kNumSizeClasses];
+};
+
+size_t SizeClassIndex(size_t size) {
+  DCHECK_GT(size, 0u);
+  return (size - 1) / kSizeClassGranularity;
+}
+
+size_t SizeClassBytes(size_t index) {
+  return (index + 1) * kSizeClassGranularity;
+}
+
+// Returns every cached block of |cache| to the heap and deletes |cache|.
+void DestroyThreadCache(void* value) {
+  ThreadCache* cache = static_cast<ThreadCache*>(value);
+  for (size_t i = 0; i < kNumSizeClasses; ++i) {
+    FreeBlock* block = cache->free_lists[i];
+    while (block) {
+      FreeBlock* next = block->next;
+      ::operator delete(block);
+      block = next;
+    }
+  }
+  delete cache;
+}
+
+class ThreadCacheSlot {
+ public:
+  ThreadCacheSlot() : slot_(&DestroyThreadCache) {}
+
+  // Returns the calling thread's cache, creating it if necessary.  A thread
+  // that allocates again after its cache was destroyed at thread exit simply
+  // gets a new one, which the TLS teardown loop destroys in turn.
+  ThreadCache* GetOrCreate() {
+    ThreadCache* cache = static_cast<ThreadCache*>(slot_.Get());
+    if (!cache) {
+      cache = new ThreadCache();
+      slot_.Set(cache);
+    }
+    return cache;
+  }
+
+ private:
+  ThreadLocalStorage::Slot slot_;
+
+  DISALLOW_COPY_AND_ASSIGN(ThreadCacheSlot);
+};
+
+LazyInstance<ThreadCacheSlot>::Leaky g_thread_cache_slot =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+// static
+void* SmallObjectAllocator::Allocate(size_t size) {
+  if (size == 0)
+    size = 1;
+  if (size > kMaxCachedSize)
+    return ::operator new(size);
+
+  size_t index = SizeClassIndex(size);
+  if (subtle::NoBarrier_Load(&g_enabled)) {
+    ThreadCache* cache = g_thread_cache_slot.Get().GetOrCreate();
+    FreeBlock* block = cache->free_lists[index];
+    if (block) {
+      cache->free_lists[index] = block->next;
+      --cache->free_counts[index];
+      return block;
+    }
+  }
+  // Always allocate the full size class so that the block can be cached by
+  // Free() even if the caches get enabled in between.
+  return ::operator new(SizeClassBytes(index));
+}
+
+// static
+void SmallObjectAllocator::Free(void* ptr, size_t size) {
+  if (!ptr)
+    return;
+  if (size == 0)
+    size = 1;
+  if (size <= kMaxCachedSize && subtle::NoBarrier_Load(&g_enabled)) {
+    size_t index = SizeClassIndex(size);
+    ThreadCache* cache = g_thread_cache_slot.Get().GetOrCreate();
+    if (cache->free_counts[index] * SizeClassBytes(index) <
+        kMaxCachedBytesPerSizeClass) {
+      FreeBlock* block = static_cast<FreeBlock*>(ptr);
+      block->next = cache->free_lists[index];
+      cache->free_lists[index] = block;
+      ++cache->free_counts[index];
+      return;
+    }
+  }
+  ::operator delete(ptr);
+}
+
+// static
+void SmallObjectAllocator::SetEnabled(bool enabled) {
+  subtle::NoBarrier_Store(&g_enabled, enabled ? 1 : 0);
+}
+
+// static
+bool SmallObjectAllocator::IsEnabled() {
+  return subtle::NoBarrier_Load(&g_enabled) != 0;
+}
+
+}  // namespace base
@@ -0,0 +1,65 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// SmallObjectAllocator is a per-thread caching allocator for the short-lived,
+// fixed-size objects that are created for every posted task (callback bind
+// states, incoming queue nodes).  Requests are rounded up to one of a small
+// number of size classes and freed blocks are kept on a free list owned by
+// the thread that freed them, so that in the steady state a thread posting
+// and running tasks does not call into malloc at all.
+//
+// Blocks are allowed to be freed on a different thread from the one that
+// allocated them; they simply migrate to the freeing thread's cache.  Each
+// thread caches at most a few kilobytes per size class and the cache is
+// returned to the heap when the thread exits.
+//
+// To route a class through the allocator, give it class-specific operators:
+//
+//   static void* operator new(size_t size) {
+//     return SmallObjectAllocator::Allocate(size);
+//   }
+//   static void operator delete(void* ptr, size_t size) {
+//     SmallObjectAllocator::Free(ptr, size);
+//   }
+//
+// The sized form of operator delete is required so that the size class can
+// be recovered without a per-block header.  For polymorphic classes the
+// destructor must be virtual so that the dynamic size is passed.
+
+#ifndef BASE_MEMORY_SMALL_OBJECT_ALLOCATOR_H_
+#define BASE_MEMORY_SMALL_OBJECT_ALLOCATOR_H_
+
+#include <stddef.h>
+
+#include "base/base_export.h"
+#include "base/basictypes.h"
+
+namespace base {
+
+class BASE_EXPORT SmallObjectAllocator {
+ public:
+  // Requests larger than this are passed straight through to the heap.
+  static const size_t kMaxCachedSize = 256;
+
+  // Returns a block of at least |size| bytes.  Never returns NULL.
+  static void* Allocate(size_t size);
+
+  // Releases a block returned by Allocate().  |size| must be the size that
+  // was passed to Allocate().
+  static void Free(void* ptr, size_t size);
+
+  // Enables or disables the per-thread caches.  When disabled every
+  // Allocate() and Free() goes to the heap.  Blocks may be allocated and
+  // freed on either side of a change.  The caches are enabled by default
+  // except in ASan/MSan builds, where they would hide use-after-free bugs.
+  static void SetEnabled(bool enabled);
+  static bool IsEnabled();
+
+ private:
+  DISALLOW_IMPLICIT_CONSTRUCTORS(SmallObjectAllocator);
+};
+
+}  // namespace base
+
+#endif  // BASE_MEMORY_SMALL_OBJECT_ALLOCATOR_H_
@@ -0,0 +1,120 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Compares the per-task allocation cost with the small object caches enabled
+// and disabled.  base_perftests does not link the allocator shim, so the
+// "disabled" numbers are those of the system malloc rather than tcmalloc.
+
+#include "base/basictypes.h"
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/memory/small_object_allocator.h"
+#include "base/message_loop/message_loop.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+const int kIterations = 1000000;
+const int kTasksPerBatch = 1000;
+
+void Increment(int* counter) {
+  ++*counter;
+}
+
+class SmallObjectAllocatorPerfTest : public testing::Test {
+ public:
+  virtual void SetUp() OVERRIDE {
+    was_enabled_ = SmallObjectAllocator::IsEnabled();
+  }
+
+  virtual void TearDown() OVERRIDE {
+    SmallObjectAllocator::SetEnabled(was_enabled_);
+  }
+
+ protected:
+  static const char* Modifier(bool enabled) {
+    return enabled ? "_cached" : "_heap";
+  }
+
+  static void PrintRate(const char* measurement,
+                        bool enabled,
+                        int operations,
+                        TimeTicks start) {
+    double elapsed_ms = (TimeTicks::HighResNow() - start).InMillisecondsF();
+    perf_test::PrintResult(measurement, Modifier(enabled), "",
+                           operations / elapsed_ms, "ops/ms", true);
+  }
+
+  // Allocates and immediately frees blocks of a few typical bind state sizes.
+  void RunAllocateFree(bool enabled) {
+    SmallObjectAllocator::SetEnabled(enabled);
+    const size_t kSizes[] = {32, 48, 64, 96};
+    TimeTicks start = TimeTicks::HighResNow();
+    for (int i = 0; i < kIterations; ++i) {
+      size_t size = kSizes[i % arraysize(kSizes)];
+      SmallObjectAllocator::Free(SmallObjectAllocator::Allocate(size), size);
+    }
+    PrintRate("allocate_free", enabled, kIterations, start);
+  }
+
+  // Creates and destroys a bound closure.
+  void RunBindAndDestroy(bool enabled) {
+    SmallObjectAllocator::SetEnabled(enabled);
+    int counter = 0;
+    TimeTicks start = TimeTicks::HighResNow();
+    for (int i = 0; i < kIterations; ++i) {
+      Closure closure = Bind(&Increment, &counter);
+      closure.Run();
+    }
+    PrintRate("bind_and_destroy", enabled, kIterations, start);
+    EXPECT_EQ(kIterations, counter);
+  }
+
+  // Posts batches of tasks to the current loop and runs them.
+  void RunPostTask(bool enabled, bool lock_free) {
+    SmallObjectAllocator::SetEnabled(enabled);
+    MessageLoop::EnableLockFreeIncomingQueue(lock_free);
+    MessageLoop loop;
+    MessageLoop::EnableLockFreeIncomingQueue(false);
+
+    int counter = 0;
+    TimeTicks start = TimeTicks::HighResNow();
+    for (int i = 0; i < kIterations; i += kTasksPerBatch) {
+      for (int j = 0; j < kTasksPerBatch; ++j)
+        loop.PostTask(FROM_HERE, Bind(&Increment, &counter));
+      loop.RunUntilIdle();
+    }
+    PrintRate(lock_free ? "post_task_lock_free_queue" : "post_task",
+              enabled, kIterations, start);
+    EXPECT_EQ(kIterations, counter);
+  }
+
+ private:
+  bool was_enabled_;
+};
+
+}  // namespace
+
+TEST_F(SmallObjectAllocatorPerfTest, AllocateFree) {
+  RunAllocateFree(false);
+  RunAllocateFree(true);
+}
+
+TEST_F(SmallObjectAllocatorPerfTest, BindAndDestroy) {
+  RunBindAndDestroy(false);
+  RunBindAndDestroy(true);
+}
+
+TEST_F(SmallObjectAllocatorPerfTest, PostTask) {
+  RunPostTask(false, false);
+  RunPostTask(true, false);
+  RunPostTask(false, true);
+  RunPostTask(true, true);
+}
+
+}  // namespace base
@@ -0,0 +1,108 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/small_object_allocator.h"
+
+#include <string.h>
+
+#include "base/bind.h"
+#include "base/threading/thread.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+class SmallObjectAllocatorTest : public testing::Test {
+ protected:
+  virtual void SetUp() OVERRIDE {
+    was_enabled_ = SmallObjectAllocator::IsEnabled();
+    SmallObjectAllocator::SetEnabled(true);
+  }
+
+  virtual void TearDown() OVERRIDE {
+    SmallObjectAllocator::SetEnabled(was_enabled_);
+  }
+
+ private:
+  bool was_enabled_;
+};
+
+void AllocateBlock(size_t size, void** block) {
+  *block = SmallObjectAllocator::Allocate(size);
+}
+
+void FreeBlock(void* block, size_t size) {
+  SmallObjectAllocator::Free(block, size);
+}
+
+}  // namespace
+
+TEST_F(SmallObjectAllocatorTest, BlocksAreWritable) {
+  const size_t kSizes[] = {
+    0, 1, 15, 16, 17, 100, SmallObjectAllocator::kMaxCachedSize,
+    SmallObjectAllocator::kMaxCachedSize + 1, 4096
+  };
+  for (size_t i = 0; i < arraysize(kSizes); ++i) {
+    void* block = SmallObjectAllocator::Allocate(kSizes[i]);
+    ASSERT_TRUE(block);
+    memset(block, 0xAB, kSizes[i]);
+    SmallObjectAllocator::Free(block, kSizes[i]);
+  }
+}
+
+TEST_F(SmallObjectAllocatorTest, ReusesFreedBlockOfSameSizeClass) {
+  void* block = SmallObjectAllocator::Allocate(40);
+  SmallObjectAllocator::Free(block, 40);
+  void* reused = SmallObjectAllocator::Allocate(33);
+  EXPECT_EQ(block, reused);
+  SmallObjectAllocator::Free(reused, 33);
+}
+
+TEST_F(SmallObjectAllocatorTest, DistinctLiveBlocks) {
+  void* a = SmallObjectAllocator::Allocate(24);
+  void* b = SmallObjectAllocator::Allocate(24);
+  EXPECT_NE(a, b);
+  SmallObjectAllocator::Free(a, 24);
+  SmallObjectAllocator::Free(b, 24);
+}
+
+TEST_F(SmallObjectAllocatorTest, FreeOnAnotherThread) {
+  Thread thread("SmallObjectAllocatorTest");
+  ASSERT_TRUE(thread.Start());
+
+  // A block allocated on |thread| and freed here ends up in this thread's
+  // cache.
+  void* block = NULL;
+  thread.message_loop()->PostTask(FROM_HERE,
+                                  Bind(&AllocateBlock, 64, &block));
+  thread.Stop();
+  ASSERT_TRUE(block);
+  SmallObjectAllocator::Free(block, 64);
+  void* reused = SmallObjectAllocator::Allocate(64);
+  EXPECT_EQ(block, reused);
+
+  // And a block allocated here can be freed on another thread.
+  ASSERT_TRUE(thread.Start());
+  thread.message_loop()->PostTask(FROM_HERE, Bind(&FreeBlock, reused, 64));
+  thread.Stop();
+}
+
+TEST_F(SmallObjectAllocatorTest, ToggleWithOutstandingBlocks) {
+  SmallObjectAllocator::SetEnabled(false);
+  void* block = SmallObjectAllocator::Allocate(20);
+  SmallObjectAllocator::SetEnabled(true);
+
+  // A block allocated while disabled is still sized for its class, so it can
+  // be cached and handed out again for any size in the class.
+  SmallObjectAllocator::Free(block, 20);
+  void* reused = SmallObjectAllocator::Allocate(32);
+  EXPECT_EQ(block, reused);
+  memset(reused, 0, 32);
+
+  SmallObjectAllocator::SetEnabled(false);
+  SmallObjectAllocator::Free(reused, 32);
+}
+
+}  // namespace base
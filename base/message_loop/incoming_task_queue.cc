@@ -8,13 +8,23 @@
 #include "base/location.h"
 #include "base/message_loop/message_loop.h"
 #include "base/synchronization/waitable_event.h"
+#include "base/threading/platform_thread.h"
 
 namespace base {
 namespace internal {
 
-IncomingTaskQueue::IncomingTaskQueue(MessageLoop* message_loop)
-    : message_loop_(message_loop),
-      next_sequence_num_(0) {
+IncomingTaskQueue::IncomingTaskQueue(MessageLoop* message_loop,
+                                     bool lock_free)
+    :
+#if defined(OS_WIN)
+      high_resolution_timer_active_(0),
+#endif
+      message_loop_(message_loop),
+      next_sequence_num_(0),
+      lock_free_(lock_free),
+      incoming_list_head_(0),
+      active_posters_(0),
+      message_loop_destroyed_(0) {
 }
 
 bool IncomingTaskQueue::AddToIncomingQueue(
@@ -22,6 +32,12 @@ bool IncomingTaskQueue::AddToIncomingQueue(
     const Closure& task,
     TimeDelta delay,
     bool nestable) {
+  if (lock_free_) {
+    PendingTask pending_task(
+        from_here, task, CalculateDelayedRuntimeLockFree(delay), nestable);
+    return PostPendingTaskLockFree(&pending_task);
+  }
+
   AutoLock locked(incoming_queue_lock_);
   PendingTask pending_task(
       from_here, task, CalculateDelayedRuntime(delay), nestable);
@@ -37,6 +53,9 @@ bool IncomingTaskQueue::IsHighResolutionTimerEnabledForTesting() {
 }
 
 bool IncomingTaskQueue::IsIdleForTesting() {
+  if (lock_free_)
+    return subtle::Acquire_Load(&incoming_list_head_) == 0;
+
   AutoLock lock(incoming_queue_lock_);
   return incoming_queue_.empty();
 }
@@ -45,6 +64,32 @@ void IncomingTaskQueue::ReloadWorkQueue(TaskQueue* work_queue) {
   // Make sure no tasks are lost.
   DCHECK(work_queue->empty());
 
+  if (lock_free_) {
+    // Take the whole list at once. Only this thread ever removes nodes, so
+    // there is no ABA problem with the posters' compare-and-swap.
+    Node* node = reinterpret_cast<Node*>(
+        subtle::NoBarrier_AtomicExchange(&incoming_list_head_, 0));
+    // Pairs with the release in PostPendingTaskLockFree() so that the
+    // contents of the nodes are visible.
+    subtle::MemoryBarrier();
+
+    // The list is newest first; reverse it so that tasks run in post order.
+    Node* reversed = NULL;
+    while (node) {
+      Node* next = node->next;
+      node->next = reversed;
+      reversed = node;
+      node = next;
+    }
+    while (reversed) {
+      Node* next = reversed->next;
+      work_queue->push(reversed->task);
+      delete reversed;
+      reversed = next;
+    }
+    return;
+  }
+
   // Acquire all we can from the inter-thread queue with one lock acquisition.
   AutoLock lock(incoming_queue_lock_);
   if (!incoming_queue_.empty())
@@ -64,6 +109,16 @@ void IncomingTaskQueue::WillDestroyCurrentMessageLoop() {
   }
 #endif
 
+  if (lock_free_) {
+    // The barrier pairs with the one in PostPendingTaskLockFree(): either a
+    // poster sees |message_loop_destroyed_|, or we see it in
+    // |active_posters_| and wait for it to be done with |message_loop_|.
+    subtle::NoBarrier_Store(&message_loop_destroyed_, 1);
+    subtle::MemoryBarrier();
+    while (subtle::Acquire_Load(&active_posters_) != 0)
+      PlatformThread::YieldCurrentThread();
+  }
+
   AutoLock lock(incoming_queue_lock_);
   message_loop_ = NULL;
 }
@@ -71,6 +126,16 @@ void IncomingTaskQueue::WillDestroyCurrentMessageLoop() {
 IncomingTaskQueue::~IncomingTaskQueue() {
   // Verify that WillDestroyCurrentMessageLoop() has been called.
   DCHECK(!message_loop_);
+
+  // Delete the tasks that were posted after the message loop last reloaded
+  // its work queue.
+  Node* node = reinterpret_cast<Node*>(
+      subtle::Acquire_Load(&incoming_list_head_));
+  while (node) {
+    Node* next = node->next;
+    delete node;
+    node = next;
+  }
 }
 
 TimeTicks IncomingTaskQueue::CalculateDelayedRuntime(TimeDelta delay) {
@@ -92,6 +157,7 @@ TimeTicks IncomingTaskQueue::CalculateDelayedRuntime(TimeDelta delay) {
           high_resolution_timer_expiration_ = TimeTicks::Now() +
               TimeDelta::FromMilliseconds(
                   MessageLoop::kHighResolutionTimerModeLeaseTimeMs);
+          subtle::Release_Store(&high_resolution_timer_active_, 1);
         }
       }
     }
@@ -105,6 +171,7 @@ TimeTicks IncomingTaskQueue::CalculateDelayedRuntime(TimeDelta delay) {
     if (TimeTicks::Now() > high_resolution_timer_expiration_) {
       Time::ActivateHighResolutionTimer(false);
       high_resolution_timer_expiration_ = TimeTicks();
+      subtle::Release_Store(&high_resolution_timer_active_, 0);
     }
   }
 #endif
@@ -112,6 +179,20 @@ TimeTicks IncomingTaskQueue::CalculateDelayedRuntime(TimeDelta delay) {
   return delayed_run_time;
 }
 
+TimeTicks IncomingTaskQueue::CalculateDelayedRuntimeLockFree(TimeDelta delay) {
+#if defined(OS_WIN)
+  // The high resolution timer bookkeeping isn't thread-safe. Only immediate
+  // tasks posted while no high resolution timer lease is active can skip the
+  // lock, since CalculateDelayedRuntime() has nothing to update for them.
+  if (delay > TimeDelta() ||
+      subtle::Acquire_Load(&high_resolution_timer_active_)) {
+    AutoLock locked(incoming_queue_lock_);
+    return CalculateDelayedRuntime(delay);
+  }
+#endif
+  return CalculateDelayedRuntime(delay);
+}
+
 bool IncomingTaskQueue::PostPendingTask(PendingTask* pending_task) {
   // Warning: Don't try to short-circuit, and handle this thread's tasks more
   // directly, as it could starve handling of foreign threads.  Put every task
@@ -144,5 +225,46 @@ bool IncomingTaskQueue::PostPendingTask(PendingTask* pending_task) {
   return true;
 }
 
+bool IncomingTaskQueue::PostPendingTaskLockFree(PendingTask* pending_task) {
+  // See WillDestroyCurrentMessageLoop() for how this keeps |message_loop_|
+  // alive until we are done with it.
+  subtle::Barrier_AtomicIncrement(&active_posters_, 1);
+  if (subtle::Acquire_Load(&message_loop_destroyed_)) {
+    subtle::Barrier_AtomicIncrement(&active_posters_, -1);
+    pending_task->task.Reset();
+    return false;
+  }
+
+  pending_task->sequence_num =
+      subtle::NoBarrier_AtomicIncrement(&next_sequence_num_, 1) - 1;
+
+  TRACE_EVENT_FLOW_BEGIN0(TRACE_DISABLED_BY_DEFAULT("toplevel.flow"),
+      "MessageLoop::PostTask",
+      TRACE_ID_MANGLE(message_loop_->GetTaskTraceID(*pending_task)));
+
+  Node* node = new Node(*pending_task);
+  pending_task->task.Reset();
+
+  subtle::AtomicWord old_head = subtle::NoBarrier_Load(&incoming_list_head_);
+  while (true) {
+    node->next = reinterpret_cast<Node*>(old_head);
+    subtle::AtomicWord previous_head = subtle::Release_CompareAndSwap(
+        &incoming_list_head_, old_head,
+        reinterpret_cast<subtle::AtomicWord>(node));
+    if (previous_head == old_head)
+      break;
+    old_head = previous_head;
+  }
+
+  // Wake up the pump. As with the locked queue, this is only needed if the
+  // loop may have found its incoming queue empty. Unlike with the locked
+  // queue, ScheduleWork() may be called from several posters concurrently,
+  // which all pumps support.
+  message_loop_->ScheduleWork(old_head == 0);
+
+  subtle::Barrier_AtomicIncrement(&active_posters_, -1);
+  return true;
+}
+
 }  // namespace internal
 }  // namespace base
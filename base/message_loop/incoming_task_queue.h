@@ -5,8 +5,10 @@
 #ifndef BASE_MESSAGE_LOOP_INCOMING_TASK_QUEUE_H_
 #define BASE_MESSAGE_LOOP_INCOMING_TASK_QUEUE_H_
 
+#include "base/atomicops.h"
 #include "base/base_export.h"
 #include "base/memory/ref_counted.h"
+#include "base/memory/small_object_allocator.h"
 #include "base/pending_task.h"
 #include "base/synchronization/lock.h"
 #include "base/time/time.h"
@@ -21,10 +23,17 @@ namespace internal {
 // Implements a queue of tasks posted to the message loop running on the current
 // thread. This class takes care of synchronizing posting tasks from different
 // threads and together with MessageLoop ensures clean shutdown.
+//
+// By default posted tasks are kept in a TaskQueue protected by a lock. If
+// |lock_free| is passed to the constructor, they are instead pushed onto an
+// intrusive singly-linked list with a compare-and-swap, and the thread running
+// the loop takes the whole list with a single atomic exchange. Posting then
+// never blocks on other posters or on the loop's thread, which helps loops
+// that receive tasks from many threads (e.g. the IO thread).
 class BASE_EXPORT IncomingTaskQueue
     : public RefCountedThreadSafe<IncomingTaskQueue> {
  public:
-  explicit IncomingTaskQueue(MessageLoop* message_loop);
+  IncomingTaskQueue(MessageLoop* message_loop, bool lock_free);
 
   // Appends a task to the incoming queue. Posting of all tasks is routed though
   // AddToIncomingQueue() or TryAddToIncomingQueue() to make sure that posting
@@ -54,6 +63,25 @@ class BASE_EXPORT IncomingTaskQueue
 
  private:
   friend class RefCountedThreadSafe<IncomingTaskQueue>;
+
+  // A node of the lock-free incoming list.
+  struct Node {
+    explicit Node(const PendingTask& pending_task)
+        : task(pending_task), next(NULL) {}
+
+    // Nodes are allocated on the posting thread and freed on the loop's
+    // thread, once per task.
+    static void* operator new(size_t size) {
+      return SmallObjectAllocator::Allocate(size);
+    }
+    static void operator delete(void* ptr, size_t size) {
+      SmallObjectAllocator::Free(ptr, size);
+    }
+
+    PendingTask task;
+    Node* next;
+  };
+
   virtual ~IncomingTaskQueue();
 
   // Calculates the time at which a PendingTask should run.
@@ -65,8 +93,21 @@ class BASE_EXPORT IncomingTaskQueue
   // does not retain |pending_task->task| beyond this function call.
   bool PostPendingTask(PendingTask* pending_task);
 
+  // Same as PostPendingTask(), for the lock-free queue. Must be called
+  // without |incoming_queue_lock_| held.
+  bool PostPendingTaskLockFree(PendingTask* pending_task);
+
+  // Computes the delayed run time for a task posted to the lock-free queue.
+  // Takes |incoming_queue_lock_| only if the high resolution timer
+  // bookkeeping needs it.
+  TimeTicks CalculateDelayedRuntimeLockFree(TimeDelta delay);
+
 #if defined(OS_WIN)
   TimeTicks high_resolution_timer_expiration_;
+
+  // Non-zero while |high_resolution_timer_expiration_| is set. Lets posters
+  // to the lock-free queue skip the lock when there is nothing to update.
+  subtle::Atomic32 high_resolution_timer_active_;
 #endif
 
   // The lock that protects access to |incoming_queue_|, |message_loop_| and
@@ -81,8 +122,24 @@ class BASE_EXPORT IncomingTaskQueue
   // Points to the message loop that owns |this|.
   MessageLoop* message_loop_;
 
-  // The next sequence number to use for delayed tasks.
-  int next_sequence_num_;
+  // The next sequence number to use for delayed tasks. Atomically incremented
+  // by posters to the lock-free queue.
+  subtle::Atomic32 next_sequence_num_;
+
+  // True if tasks are posted to |incoming_list_head_| rather than
+  // |incoming_queue_|.
+  const bool lock_free_;
+
+  // Head of the lock-free list of posted tasks, newest first. Holds a Node*.
+  subtle::AtomicWord incoming_list_head_;
+
+  // Number of threads currently inside PostPendingTaskLockFree(). Together
+  // with |message_loop_destroyed_| this takes the place of the lock in
+  // keeping |message_loop_| alive while a poster uses it.
+  subtle::Atomic32 active_posters_;
+
+  // Set by WillDestroyCurrentMessageLoop() for the lock-free queue.
+  subtle::Atomic32 message_loop_destroyed_;
 
   DISALLOW_COPY_AND_ASSIGN(IncomingTaskQueue);
 };
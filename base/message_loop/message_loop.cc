@@ -86,6 +86,8 @@ const LinearHistogram::DescriptionPair event_descriptions_[] = {
 
 bool enable_histogrammer_ = false;
 
+bool enable_lock_free_incoming_queue_ = false;
+
 MessageLoop::MessagePumpFactory* message_pump_for_ui_factory_ = NULL;
 
 // Returns true if MessagePump::ScheduleWork() must be called one
@@ -189,6 +191,11 @@ void MessageLoop::EnableHistogrammer(bool enable) {
   enable_histogrammer_ = enable;
 }
 
+// static
+void MessageLoop::EnableLockFreeIncomingQueue(bool enable) {
+  enable_lock_free_incoming_queue_ = enable;
+}
+
 // static
 bool MessageLoop::InitMessagePumpForUIFactory(MessagePumpFactory* factory) {
   if (message_pump_for_ui_factory_)
@@ -374,7 +381,8 @@ void MessageLoop::Init() {
   DCHECK(!current()) << "should only have one message loop per thread";
   lazy_tls_ptr.Pointer()->Set(this);
 
-  incoming_task_queue_ = new internal::IncomingTaskQueue(this);
+  incoming_task_queue_ = new internal::IncomingTaskQueue(
+      this, enable_lock_free_incoming_queue_);
   message_loop_proxy_ =
       new internal::MessageLoopProxyImpl(incoming_task_queue_);
   thread_task_runner_handle_.reset(
@@ -449,7 +457,7 @@ void MessageLoop::RunTask(const PendingTask& pending_task) {
                     DidProcessTask(pending_task));
 
   tracked_objects::ThreadData::TallyRunOnNamedThreadIfTracking(pending_task,
-      start_time, tracked_objects::ThreadData::NowForEndOfRun());
+      start_time, tracked_objects::ThreadData::NowForEndOfRun(start_time));
 
   nestable_tasks_allowed_ = true;
 }
@@ -567,8 +575,12 @@ bool MessageLoop::DoWork() {
       if (!pending_task.delayed_run_time.is_null()) {
         AddToDelayedWorkQueue(pending_task);
         // If we changed the topmost task, then it is time to reschedule.
-        if (delayed_work_queue_.top().task.Equals(pending_task.task))
+        // Compare sequence numbers rather than the callbacks, since copies of
+        // two separately bound inline callbacks can compare equal.
+        if (delayed_work_queue_.top().sequence_num ==
+            pending_task.sequence_num) {
           pump_->ScheduleDelayedWork(pending_task.delayed_run_time);
+        }
       } else {
         if (DeferOrRunPendingTask(pending_task))
           return true;
@@ -154,6 +154,10 @@ class BASE_EXPORT MessageLoop : public MessagePump::Delegate {
 
   static void EnableHistogrammer(bool enable_histogrammer);
 
+  // Enables or disables the lock-free incoming task queue for MessageLoops
+  // constructed after this call. See internal::IncomingTaskQueue.
+  static void EnableLockFreeIncomingQueue(bool enable);
+
   typedef MessagePump* (MessagePumpFactory)();
   // Uses the given base::MessagePumpForUIFactory to override the default
   // MessagePump implementation for 'TYPE_UI'. Returns true if the factory
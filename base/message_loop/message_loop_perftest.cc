@@ -0,0 +1,116 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures how fast tasks can be posted to a MessageLoop from a number of
+// threads at once, with both the locked and the lock-free incoming task queue.
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/bind.h"
+#include "base/memory/scoped_vector.h"
+#include "base/message_loop/message_loop.h"
+#include "base/message_loop/message_loop_proxy.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/thread.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+const int kTasksPerProducer = 10000;
+const int kProducerCounts[] = {1, 2, 4, 8, 16, 32, 64};
+
+// Counts the tasks that ran on the consumer thread and signals |done_| once
+// all expected tasks have run.
+class TaskCounter {
+ public:
+  explicit TaskCounter(int expected_tasks)
+      : remaining_tasks_(expected_tasks),
+        done_(true, false) {}
+
+  // Must be called on the consumer thread.
+  void TaskRan() {
+    if (--remaining_tasks_ == 0)
+      done_.Signal();
+  }
+
+  void WaitUntilDone() { done_.Wait(); }
+
+ private:
+  int remaining_tasks_;
+  WaitableEvent done_;
+
+  DISALLOW_COPY_AND_ASSIGN(TaskCounter);
+};
+
+void PostTasksWhenSignaled(WaitableEvent* start,
+                           scoped_refptr<MessageLoopProxy> consumer,
+                           TaskCounter* counter) {
+  start->Wait();
+  for (int i = 0; i < kTasksPerProducer; ++i) {
+    consumer->PostTask(FROM_HERE,
+                       Bind(&TaskCounter::TaskRan, Unretained(counter)));
+  }
+}
+
+class MessageLoopPostTaskPerfTest : public testing::Test {
+ public:
+  // Posts kTasksPerProducer tasks from each of |num_producers| threads to a
+  // consumer thread and reports the rate at which they were delivered.
+  void RunBenchmark(int num_producers, bool lock_free) {
+    MessageLoop::EnableLockFreeIncomingQueue(lock_free);
+    Thread consumer("Consumer");
+    ASSERT_TRUE(consumer.Start());
+    MessageLoop::EnableLockFreeIncomingQueue(false);
+
+    TaskCounter counter(num_producers * kTasksPerProducer);
+    WaitableEvent start(true, false);
+    ScopedVector<Thread> producers;
+    for (int i = 0; i < num_producers; ++i) {
+      producers.push_back(new Thread(StringPrintf("Producer%d", i).c_str()));
+      ASSERT_TRUE(producers.back()->Start());
+      producers.back()->message_loop()->PostTask(
+          FROM_HERE,
+          Bind(&PostTasksWhenSignaled, &start,
+               consumer.message_loop_proxy(), &counter));
+    }
+
+    TimeTicks start_time = TimeTicks::HighResNow();
+    start.Signal();
+    counter.WaitUntilDone();
+    double elapsed_ms =
+        (TimeTicks::HighResNow() - start_time).InMillisecondsF();
+
+    for (int i = 0; i < num_producers; ++i)
+      producers[i]->Stop();
+    consumer.Stop();
+
+    perf_test::PrintResult(
+        "task_post_throughput",
+        lock_free ? "_lock_free" : "_locked",
+        StringPrintf("%d_producers", num_producers),
+        num_producers * kTasksPerProducer / elapsed_ms,
+        "tasks/ms",
+        true);
+  }
+};
+
+TEST_F(MessageLoopPostTaskPerfTest, LockedIncomingQueue) {
+  for (size_t i = 0; i < arraysize(kProducerCounts); ++i)
+    RunBenchmark(kProducerCounts[i], false);
+}
+
+TEST_F(MessageLoopPostTaskPerfTest, LockFreeIncomingQueue) {
+  for (size_t i = 0; i < arraysize(kProducerCounts); ++i)
+    RunBenchmark(kProducerCounts[i], true);
+}
+
+}  // namespace
+
+}  // namespace base
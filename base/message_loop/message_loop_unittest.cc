@@ -9,6 +9,7 @@
 #include "base/compiler_specific.h"
 #include "base/logging.h"
 #include "base/memory/ref_counted.h"
+#include "base/memory/scoped_vector.h"
 #include "base/message_loop/message_loop.h"
 #include "base/message_loop/message_loop_proxy_impl.h"
 #include "base/message_loop/message_loop_test.h"
@@ -951,6 +952,84 @@ TEST(MessageLoopTest, ThreadMainTaskRunner) {
   EXPECT_EQ(foo->result(), "a");
 }
 
+namespace {
+
+// Records that task |index| posted by |producer| ran, and whether it ran
+// after all tasks previously posted by the same producer.
+void RecordTaskFromProducer(std::vector<int>* next_index,
+                            bool* in_order,
+                            int producer,
+                            int index) {
+  if ((*next_index)[producer] != index)
+    *in_order = false;
+  (*next_index)[producer] = index + 1;
+}
+
+void PostTasksFromProducer(scoped_refptr<MessageLoopProxy> target,
+                           std::vector<int>* next_index,
+                           bool* in_order,
+                           int producer,
+                           int num_tasks) {
+  for (int i = 0; i < num_tasks; ++i) {
+    target->PostTask(FROM_HERE, Bind(&RecordTaskFromProducer, next_index,
+                                     in_order, producer, i));
+  }
+}
+
+}  // namespace
+
+// Verify that tasks posted from several threads to a loop using the lock-free
+// incoming queue all run, in post order for each posting thread.
+TEST(MessageLoopTest, LockFreeIncomingQueue) {
+  MessageLoop::EnableLockFreeIncomingQueue(true);
+  MessageLoop loop;
+  MessageLoop::EnableLockFreeIncomingQueue(false);
+
+  const int kNumProducers = 4;
+  const int kTasksPerProducer = 500;
+  std::vector<int> next_index(kNumProducers, 0);
+  bool in_order = true;
+
+  ScopedVector<Thread> producers;
+  for (int i = 0; i < kNumProducers; ++i) {
+    producers.push_back(new Thread("LockFreeIncomingQueueProducer"));
+    ASSERT_TRUE(producers.back()->Start());
+    producers.back()->message_loop()->PostTask(
+        FROM_HERE, Bind(&PostTasksFromProducer, loop.message_loop_proxy(),
+                        &next_index, &in_order, i, kTasksPerProducer));
+  }
+  for (int i = 0; i < kNumProducers; ++i)
+    producers[i]->Stop();
+
+  RunLoop().RunUntilIdle();
+  EXPECT_TRUE(in_order);
+  for (int i = 0; i < kNumProducers; ++i)
+    EXPECT_EQ(kTasksPerProducer, next_index[i]);
+  EXPECT_TRUE(loop.IsIdleForTesting());
+}
+
+// Verify that delayed tasks posted to a loop using the lock-free incoming
+// queue keep their ordering.
+TEST(MessageLoopTest, LockFreeIncomingQueueDelayedTasks) {
+  MessageLoop::EnableLockFreeIncomingQueue(true);
+  MessageLoop loop;
+  MessageLoop::EnableLockFreeIncomingQueue(false);
+
+  std::vector<int> next_index(1, 0);
+  bool in_order = true;
+  const TimeDelta kDelay = TimeDelta::FromMilliseconds(10);
+  for (int i = 0; i < 10; ++i) {
+    loop.PostDelayedTask(
+        FROM_HERE, Bind(&RecordTaskFromProducer, &next_index, &in_order, 0, i),
+        kDelay);
+  }
+  loop.PostDelayedTask(FROM_HERE, MessageLoop::QuitClosure(), kDelay * 2);
+  loop.Run();
+
+  EXPECT_TRUE(in_order);
+  EXPECT_EQ(10, next_index[0]);
+}
+
 TEST(MessageLoopTest, IsType) {
   MessageLoop loop(MessageLoop::TYPE_UI);
   EXPECT_TRUE(loop.IsType(MessageLoop::TYPE_UI));
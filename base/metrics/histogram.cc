@@ -18,6 +18,7 @@
 #include "base/debug/alias.h"
 #include "base/logging.h"
 #include "base/metrics/sample_vector.h"
+#include "base/metrics/shared_histogram_allocator.h"
 #include "base/metrics/statistics_recorder.h"
 #include "base/pickle.h"
 #include "base/strings/string_util.h"
@@ -105,6 +106,7 @@ HistogramBase* Histogram::FactoryGet(const string& name,
         new Histogram(name, minimum, maximum, registered_ranges);
 
     tentative_histogram->SetFlags(flags);
+    tentative_histogram->MoveSamplesToSharedMemory();
     histogram =
         StatisticsRecorder::RegisterOrDeleteDuplicate(tentative_histogram);
   }
@@ -314,6 +316,26 @@ Histogram::Histogram(const string& name,
 Histogram::~Histogram() {
 }
 
+void Histogram::MoveSamplesToSharedMemory() {
+  SharedHistogramAllocator* allocator = SharedHistogramAllocator::GetGlobal();
+  if (!allocator)
+    return;
+  DCHECK_EQ(0, samples_->redundant_count());
+
+  // Like HistogramDeltaSerialization, marks the histogram as one that is
+  // read by another process.
+  SetFlags(kIPCSerializationSourceFlag);
+  Pickle info;
+  if (!SerializeInfo(&info))
+    return;
+  scoped_ptr<SampleVector> samples =
+      allocator->AllocateSamples(info, bucket_ranges());
+  if (!samples)
+    return;
+  samples_ = samples.Pass();
+  SetFlags(kSharedMemorySamplesFlag);
+}
+
 bool Histogram::PrintEmptyBucket(size_t index) const {
   return true;
 }
@@ -562,6 +584,7 @@ HistogramBase* LinearHistogram::FactoryGetWithRangeDescription(
     }
 
     tentative_histogram->SetFlags(flags);
+    tentative_histogram->MoveSamplesToSharedMemory();
     histogram =
         StatisticsRecorder::RegisterOrDeleteDuplicate(tentative_histogram);
   }
@@ -658,6 +681,7 @@ HistogramBase* BooleanHistogram::FactoryGet(const string& name, int32 flags) {
         new BooleanHistogram(name, registered_ranges);
 
     tentative_histogram->SetFlags(flags);
+    tentative_histogram->MoveSamplesToSharedMemory();
     histogram =
         StatisticsRecorder::RegisterOrDeleteDuplicate(tentative_histogram);
   }
@@ -716,6 +740,7 @@ HistogramBase* CustomHistogram::FactoryGet(const string& name,
         new CustomHistogram(name, registered_ranges);
 
     tentative_histogram->SetFlags(flags);
+    tentative_histogram->MoveSamplesToSharedMemory();
 
     histogram =
         StatisticsRecorder::RegisterOrDeleteDuplicate(tentative_histogram);
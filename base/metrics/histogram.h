@@ -475,6 +475,11 @@ class BASE_EXPORT Histogram : public HistogramBase {
 
   virtual ~Histogram();
 
+  // Moves the (still empty) samples of a new histogram to the segment of the
+  // global SharedHistogramAllocator, if there is one and it has room.  Called
+  // by the factories before the histogram is registered.
+  void MoveSamplesToSharedMemory();
+
   // HistogramBase implementation:
   virtual bool SerializeInfoImpl(Pickle* pickle) const OVERRIDE;
 
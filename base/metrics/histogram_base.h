@@ -73,6 +73,11 @@ class BASE_EXPORT HistogramBase {
     // the source histogram!).
     kIPCSerializationSourceFlag = 0x10,
 
+    // Indicates that the samples of the histogram are kept in the segment of
+    // a SharedHistogramAllocator, which the receiving process reads directly,
+    // so they must not also be sent as pickled deltas.
+    kSharedMemorySamplesFlag = 0x20,
+
     // Only for Histogram and its sub classes: fancy bucket-naming support.
     kHexRangePrintingFlag = 0x8000,
   };
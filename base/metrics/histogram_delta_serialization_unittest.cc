@@ -51,4 +51,20 @@ TEST(HistogramDeltaSerializationTest, DeserializeHistogramAndAddSamples) {
   EXPECT_EQ(2, snapshot2->GetCount(1000));
 }
 
+TEST(HistogramDeltaSerializationTest, SkipsSharedMemoryHistograms) {
+  StatisticsRecorder statistic_recorder;
+  HistogramDeltaSerialization serializer("HistogramDeltaSerializationTest");
+
+  // The receiving process reads the samples of this histogram from shared
+  // memory, so they aren't serialized.
+  HistogramBase* histogram = Histogram::FactoryGet(
+      "SharedHistogram", 1, 1000, 10,
+      HistogramBase::kSharedMemorySamplesFlag);
+  histogram->Add(10);
+
+  std::vector<std::string> deltas;
+  serializer.PrepareAndSerializeDeltas(&deltas);
+  EXPECT_TRUE(deltas.empty());
+}
+
 }  // namespace base
@@ -19,7 +19,27 @@ class SampleCountIterator;
 // HistogramSamples is a container storing all samples of a histogram.
 class BASE_EXPORT HistogramSamples {
  public:
+  // The sum and redundant count of the samples.  These live in a separate
+  // struct so that the samples of a histogram can be kept in memory that is
+  // shared with another process; see SharedHistogramAllocator.
+  struct Metadata {
+    int64 sum;
+
+    // |redundant_count| helps identify memory corruption. It redundantly
+    // stores the total number of samples accumulated in the histogram. We can
+    // compare this count to the sum of the counts (TotalCount() function), and
+    // detect problems. Note, depending on the implementation of different
+    // histogram types, there might be races during histogram accumulation and
+    // snapshotting that we choose to accept. In this case, the tallies might
+    // mismatch even when no memory corruption has happened.
+    HistogramBase::AtomicCount redundant_count;
+  };
+
   HistogramSamples();
+  // Keeps the sum and redundant count in |meta|, which must be zeroed or
+  // hold the metadata of the samples already stored alongside it, and must
+  // outlive this object.
+  explicit HistogramSamples(Metadata* meta);
   virtual ~HistogramSamples();
 
   virtual void Accumulate(HistogramBase::Sample value,
@@ -38,9 +58,9 @@ class BASE_EXPORT HistogramSamples {
   virtual bool Serialize(Pickle* pickle) const;
 
   // Accessor fuctions.
-  int64 sum() const { return sum_; }
+  int64 sum() const { return meta_->sum; }
   HistogramBase::Count redundant_count() const {
-    return subtle::NoBarrier_Load(&redundant_count_);
+    return subtle::NoBarrier_Load(&meta_->redundant_count);
   }
 
  protected:
@@ -52,16 +72,11 @@ class BASE_EXPORT HistogramSamples {
   void IncreaseRedundantCount(HistogramBase::Count diff);
 
  private:
-  int64 sum_;
-
-  // |redundant_count_| helps identify memory corruption. It redundantly stores
-  // the total number of samples accumulated in the histogram. We can compare
-  // this count to the sum of the counts (TotalCount() function), and detect
-  // problems. Note, depending on the implementation of different histogram
-  // types, there might be races during histogram accumulation and snapshotting
-  // that we choose to accept. In this case, the tallies might mismatch even
-  // when no memory corruption has happened.
-  HistogramBase::AtomicCount redundant_count_;
+  // Used when the metadata is not provided by the creator.
+  Metadata local_meta_;
+
+  // Points at |local_meta_| or at the metadata passed to the constructor.
+  Metadata* meta_;
 };
 
 class BASE_EXPORT SampleCountIterator {
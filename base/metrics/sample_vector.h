@@ -23,6 +23,12 @@ class BucketRanges;
 class BASE_EXPORT_PRIVATE SampleVector : public HistogramSamples {
  public:
   explicit SampleVector(const BucketRanges* bucket_ranges);
+  // Uses the bucket_count() counts at |counts| and the metadata at |meta|
+  // instead of allocating them, so that the samples can live in memory that
+  // is shared with another process.  Both must outlive this object.
+  SampleVector(const BucketRanges* bucket_ranges,
+               HistogramBase::AtomicCount* counts,
+               Metadata* meta);
   virtual ~SampleVector();
 
   // HistogramSamples implementation:
@@ -46,7 +52,12 @@ class BASE_EXPORT_PRIVATE SampleVector : public HistogramSamples {
  private:
   FRIEND_TEST_ALL_PREFIXES(HistogramTest, CorruptSampleCounts);
 
-  std::vector<HistogramBase::AtomicCount> counts_;
+  // Storage for the counts when they are not provided by the creator.
+  std::vector<HistogramBase::AtomicCount> local_counts_;
+
+  // Points at |local_counts_| or at the counts passed to the constructor.
+  HistogramBase::AtomicCount* counts_;
+  const size_t counts_size_;
 
   // Shares the same BucketRanges with Histogram object.
   const BucketRanges* const bucket_ranges_;
@@ -58,6 +69,9 @@ class BASE_EXPORT_PRIVATE SampleVectorIterator : public SampleCountIterator {
  public:
   SampleVectorIterator(const std::vector<HistogramBase::AtomicCount>* counts,
                        const BucketRanges* bucket_ranges);
+  SampleVectorIterator(const HistogramBase::AtomicCount* counts,
+                       size_t counts_size,
+                       const BucketRanges* bucket_ranges);
   virtual ~SampleVectorIterator();
 
   // SampleCountIterator implementation:
@@ -73,7 +87,8 @@ class BASE_EXPORT_PRIVATE SampleVectorIterator : public SampleCountIterator {
  private:
   void SkipEmptyBuckets();
 
-  const std::vector<HistogramBase::AtomicCount>* counts_;
+  const HistogramBase::AtomicCount* counts_;
+  size_t counts_size_;
   const BucketRanges* bucket_ranges_;
 
   size_t index_;
@@ -0,0 +1,270 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/metrics/shared_histogram_allocator.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "base/atomicops.h"
+#include "base/logging.h"
+#include "base/metrics/bucket_ranges.h"
+#include "base/metrics/histogram.h"
+#include "base/metrics/histogram_samples.h"
+#include "base/metrics/sample_vector.h"
+#include "base/pickle.h"
+
+namespace base {
+
+namespace {
+
+// Identifies a segment formatted by SharedHistogramAllocator::Create().
+const uint32 kSegmentCookie = 0x48495354;  // "HIST"
+const uint32 kSegmentVersion = 1;
+
+// Set once a record is completely written.
+const subtle::Atomic32 kRecordReady = 1;
+
+// Records are aligned for the int64 sum of their metadata.
+const size_t kRecordAlignment = 8;
+
+size_t AlignRecordSize(size_t size) {
+  return (size + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+}
+
+subtle::AtomicWord g_allocator = 0;
+
+}  // namespace
+
+struct SharedHistogramAllocator::SegmentHeader {
+  uint32 cookie;
+  uint32 version;
+  uint32 size;
+
+  // The number of bytes in use, including this header.
+  subtle::Atomic32 used;
+};
+
+// A record is followed by |info_size| bytes of pickled histogram arguments,
+// padded to kRecordAlignment, and by |bucket_count| counts.
+struct SharedHistogramAllocator::RecordHeader {
+  // kRecordReady once the record can be read.
+  subtle::Atomic32 state;
+
+  // The size of the whole record.
+  uint32 size;
+
+  uint32 info_size;
+  uint32 bucket_count;
+  HistogramSamples::Metadata meta;
+};
+
+SharedHistogramAllocator::MergedRecord::MergedRecord()
+    : histogram(NULL),
+      samples(NULL),
+      merged_samples(NULL) {
+}
+
+SharedHistogramAllocator::SharedHistogramAllocator(
+    scoped_ptr<SharedMemory> shared_memory)
+    : shared_memory_(shared_memory.Pass()),
+      merge_offset_(sizeof(SegmentHeader)) {
+}
+
+SharedHistogramAllocator::~SharedHistogramAllocator() {
+  for (size_t i = 0; i < merged_records_.size(); ++i) {
+    delete merged_records_[i].samples;
+    delete merged_records_[i].merged_samples;
+  }
+}
+
+// static
+scoped_ptr<SharedHistogramAllocator> SharedHistogramAllocator::Create(
+    size_t size) {
+  scoped_ptr<SharedMemory> shared_memory(new SharedMemory());
+  if (size < sizeof(SegmentHeader) || size > kuint32max ||
+      !shared_memory->CreateAndMapAnonymous(size)) {
+    return scoped_ptr<SharedHistogramAllocator>();
+  }
+
+  // New anonymous memory is zeroed, so only the header needs to be written.
+  SegmentHeader* header =
+      static_cast<SegmentHeader*>(shared_memory->memory());
+  header->cookie = kSegmentCookie;
+  header->version = kSegmentVersion;
+  header->size = static_cast<uint32>(size);
+  subtle::Release_Store(&header->used, sizeof(SegmentHeader));
+  return scoped_ptr<SharedHistogramAllocator>(
+      new SharedHistogramAllocator(shared_memory.Pass()));
+}
+
+// static
+scoped_ptr<SharedHistogramAllocator> SharedHistogramAllocator::Open(
+    SharedMemoryHandle handle,
+    size_t size) {
+  scoped_ptr<SharedMemory> shared_memory(new SharedMemory(handle, false));
+  if (size < sizeof(SegmentHeader) || !shared_memory->Map(size))
+    return scoped_ptr<SharedHistogramAllocator>();
+
+  const SegmentHeader* header =
+      static_cast<const SegmentHeader*>(shared_memory->memory());
+  if (header->cookie != kSegmentCookie ||
+      header->version != kSegmentVersion ||
+      header->size != size) {
+    return scoped_ptr<SharedHistogramAllocator>();
+  }
+  return scoped_ptr<SharedHistogramAllocator>(
+      new SharedHistogramAllocator(shared_memory.Pass()));
+}
+
+// static
+void SharedHistogramAllocator::SetGlobal(
+    scoped_ptr<SharedHistogramAllocator> allocator) {
+  CHECK(!GetGlobal());
+  subtle::Release_Store(
+      &g_allocator, reinterpret_cast<subtle::AtomicWord>(allocator.release()));
+}
+
+// static
+SharedHistogramAllocator* SharedHistogramAllocator::GetGlobal() {
+  return reinterpret_cast<SharedHistogramAllocator*>(
+      subtle::Acquire_Load(&g_allocator));
+}
+
+scoped_ptr<SampleVector> SharedHistogramAllocator::AllocateSamples(
+    const Pickle& histogram_info,
+    const BucketRanges* ranges) {
+  size_t info_size = histogram_info.size();
+  size_t counts_offset = AlignRecordSize(sizeof(RecordHeader) + info_size);
+  size_t record_size = AlignRecordSize(
+      counts_offset + ranges->bucket_count() * sizeof(HistogramBase::Count));
+
+  // Reserve the space with a compare-and-swap so that histograms can be
+  // created on several threads.
+  SegmentHeader* segment = header();
+  subtle::Atomic32 offset = subtle::NoBarrier_Load(&segment->used);
+  while (true) {
+    if (record_size > segment->size ||
+        static_cast<size_t>(offset) > segment->size - record_size)
+      return scoped_ptr<SampleVector>();
+    subtle::Atomic32 previous = subtle::NoBarrier_CompareAndSwap(
+        &segment->used, offset, offset + record_size);
+    if (previous == offset)
+      break;
+    offset = previous;
+  }
+
+  RecordHeader* record = GetRecord(offset);
+  record->size = static_cast<uint32>(record_size);
+  record->info_size = static_cast<uint32>(info_size);
+  record->bucket_count = static_cast<uint32>(ranges->bucket_count());
+  char* record_data = reinterpret_cast<char*>(record);
+  memcpy(record_data + sizeof(RecordHeader), histogram_info.data(),
+         info_size);
+  HistogramBase::AtomicCount* counts =
+      reinterpret_cast<HistogramBase::AtomicCount*>(record_data +
+                                                    counts_offset);
+  subtle::Release_Store(&record->state, kRecordReady);
+
+  return scoped_ptr<SampleVector>(
+      new SampleVector(ranges, counts, &record->meta));
+}
+
+void SharedHistogramAllocator::MergeChangedSamples() {
+  // Pick up the records appended since the previous call.  A record that is
+  // not ready yet is being written, and is read by a later call.
+  size_t used = this->used();
+  while (merge_offset_ < used &&
+         used - merge_offset_ >= sizeof(RecordHeader)) {
+    RecordHeader* record = GetRecord(merge_offset_);
+    if (subtle::Acquire_Load(&record->state) != kRecordReady)
+      break;
+    size_t record_size = record->size;
+    if (record_size < sizeof(RecordHeader) ||
+        record_size > used - merge_offset_ ||
+        record_size % kRecordAlignment != 0) {
+      DLOG(ERROR) << "Corrupted histogram record.";
+      merge_offset_ = used;
+      break;
+    }
+    AddMergedRecord(merge_offset_);
+    merge_offset_ += record_size;
+  }
+
+  for (size_t i = 0; i < merged_records_.size(); ++i) {
+    MergedRecord& record = merged_records_[i];
+    if (!record.histogram ||
+        record.samples->redundant_count() ==
+            record.merged_samples->redundant_count()) {
+      continue;
+    }
+    SampleVector delta(record.histogram->bucket_ranges());
+    delta.Add(*record.samples);
+    delta.Subtract(*record.merged_samples);
+    record.histogram->AddSamples(delta);
+    record.merged_samples->Add(delta);
+  }
+}
+
+size_t SharedHistogramAllocator::used() const {
+  size_t used = subtle::Acquire_Load(&header()->used);
+  return std::min(used, shared_memory_->mapped_size());
+}
+
+SharedHistogramAllocator::SegmentHeader*
+SharedHistogramAllocator::header() const {
+  return static_cast<SegmentHeader*>(shared_memory_->memory());
+}
+
+SharedHistogramAllocator::RecordHeader* SharedHistogramAllocator::GetRecord(
+    size_t offset) const {
+  return reinterpret_cast<RecordHeader*>(
+      static_cast<char*>(shared_memory_->memory()) + offset);
+}
+
+void SharedHistogramAllocator::AddMergedRecord(size_t offset) {
+  merged_records_.push_back(MergedRecord());
+
+  // The writer of the segment is not trusted, so check that the record is
+  // consistent with its size before using it.
+  RecordHeader* record = GetRecord(offset);
+  size_t record_size = record->size;
+  size_t info_size = record->info_size;
+  size_t bucket_count = record->bucket_count;
+  if (info_size > record_size)
+    return;
+  size_t counts_offset = AlignRecordSize(sizeof(RecordHeader) + info_size);
+  if (counts_offset > record_size ||
+      bucket_count > (record_size - counts_offset) /
+          sizeof(HistogramBase::Count)) {
+    return;
+  }
+
+  char* record_data = reinterpret_cast<char*>(record);
+  Pickle info(record_data + sizeof(RecordHeader), static_cast<int>(info_size));
+  PickleIterator iter(info);
+  HistogramBase* histogram = DeserializeHistogramInfo(&iter);
+  if (!histogram || histogram->GetHistogramType() == SPARSE_HISTOGRAM)
+    return;
+  if (histogram->flags() & HistogramBase::kIPCSerializationSourceFlag) {
+    DVLOG(1) << "Single process mode, histogram observed and not copied: "
+             << histogram->histogram_name();
+    return;
+  }
+  Histogram* target = static_cast<Histogram*>(histogram);
+  if (target->bucket_count() != bucket_count)
+    return;
+
+  MergedRecord& merged = merged_records_.back();
+  merged.histogram = target;
+  merged.samples = new SampleVector(
+      target->bucket_ranges(),
+      reinterpret_cast<HistogramBase::AtomicCount*>(record_data +
+                                                    counts_offset),
+      &record->meta);
+  merged.merged_samples = new SampleVector(target->bucket_ranges());
+}
+
+}  // namespace base
@@ -0,0 +1,117 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// SharedHistogramAllocator keeps the samples of histograms in a SharedMemory
+// segment, so that the process that created the segment can read the
+// histograms of another process without any IPC.
+//
+// The browser creates a segment for each child process and hands its handle
+// to the child, which installs an allocator for it with SetGlobal().  From
+// then on, histograms created by the child keep their counts in the segment,
+// and the browser periodically calls MergeChangedSamples() to add what the
+// child recorded to its own histograms.  Only histograms whose samples
+// changed since the previous merge are copied, and the data survives a crash
+// of the child.
+//
+// The segment is a header followed by records that are only ever appended.
+// Each record holds the pickled construction arguments of one histogram, its
+// HistogramSamples::Metadata and its bucket counts.
+
+#ifndef BASE_METRICS_SHARED_HISTOGRAM_ALLOCATOR_H_
+#define BASE_METRICS_SHARED_HISTOGRAM_ALLOCATOR_H_
+
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/basictypes.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/shared_memory.h"
+
+class Pickle;
+
+namespace base {
+
+class BucketRanges;
+class Histogram;
+class SampleVector;
+
+class BASE_EXPORT SharedHistogramAllocator {
+ public:
+  ~SharedHistogramAllocator();
+
+  // Creates and formats a new segment of |size| bytes.  Returns NULL if the
+  // segment cannot be created or is too small.
+  static scoped_ptr<SharedHistogramAllocator> Create(size_t size);
+
+  // Maps a segment of |size| bytes that was created by Create(), possibly in
+  // another process.  Returns NULL if the segment cannot be mapped or was not
+  // formatted by Create().
+  static scoped_ptr<SharedHistogramAllocator> Open(SharedMemoryHandle handle,
+                                                   size_t size);
+
+  // Makes histograms created from now on in this process keep their samples
+  // in |allocator|.  Takes ownership of |allocator|, which is leaked at
+  // shutdown like the histograms using it.  Can only be called once.
+  static void SetGlobal(scoped_ptr<SharedHistogramAllocator> allocator);
+
+  // Returns the allocator set with SetGlobal(), or NULL.
+  static SharedHistogramAllocator* GetGlobal();
+
+  // Appends a record for a histogram with the construction arguments
+  // |histogram_info|, as written by HistogramBase::SerializeInfo(), and the
+  // bucket ranges |ranges|, and returns empty samples that are stored in it.
+  // Returns NULL if the segment is full.  Can be called on any thread.
+  scoped_ptr<SampleVector> AllocateSamples(const Pickle& histogram_info,
+                                           const BucketRanges* ranges);
+
+  // Adds the samples recorded in the segment since the previous call to the
+  // histograms of the same names in this process, creating them as needed.
+  // Histograms whose samples have not changed are skipped without looking at
+  // their buckets.  Must be called on a single thread.
+  void MergeChangedSamples();
+
+  SharedMemory* shared_memory() { return shared_memory_.get(); }
+
+  // Returns the number of bytes of the segment that are in use.
+  size_t used() const;
+
+ private:
+  struct SegmentHeader;
+  struct RecordHeader;
+
+  // The state kept by MergeChangedSamples() for each record it has seen.
+  struct MergedRecord {
+    MergedRecord();
+
+    // The histogram of this process that receives the samples, or NULL if
+    // the record could not be matched with one.
+    Histogram* histogram;
+
+    // The samples stored in the segment, and those of them that were already
+    // added to |histogram|.  Owned by the allocator.
+    SampleVector* samples;
+    SampleVector* merged_samples;
+  };
+
+  explicit SharedHistogramAllocator(scoped_ptr<SharedMemory> shared_memory);
+
+  SegmentHeader* header() const;
+  RecordHeader* GetRecord(size_t offset) const;
+
+  // Matches the record at |offset| with a histogram of this process.
+  void AddMergedRecord(size_t offset);
+
+  scoped_ptr<SharedMemory> shared_memory_;
+
+  // The records seen by MergeChangedSamples(), in segment order, and the
+  // offset of the first record that it has not seen yet.
+  std::vector<MergedRecord> merged_records_;
+  size_t merge_offset_;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedHistogramAllocator);
+};
+
+}  // namespace base
+
+#endif  // BASE_METRICS_SHARED_HISTOGRAM_ALLOCATOR_H_
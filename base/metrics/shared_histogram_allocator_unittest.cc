@@ -0,0 +1,152 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/metrics/shared_histogram_allocator.h"
+
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/shared_memory.h"
+#include "base/metrics/histogram.h"
+#include "base/metrics/histogram_base.h"
+#include "base/metrics/sample_vector.h"
+#include "base/metrics/statistics_recorder.h"
+#include "base/pickle.h"
+#include "base/process/process_handle.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+const size_t kSegmentSize = 64 * 1024;
+
+// Maps the segment of |allocator| a second time, as a child process would.
+scoped_ptr<SharedHistogramAllocator> OpenSegment(
+    SharedHistogramAllocator* allocator) {
+  SharedMemoryHandle handle;
+  if (!allocator->shared_memory()->ShareToProcess(GetCurrentProcessHandle(),
+                                                  &handle)) {
+    return scoped_ptr<SharedHistogramAllocator>();
+  }
+  return SharedHistogramAllocator::Open(handle, kSegmentSize);
+}
+
+// Allocates samples for |histogram| the way Histogram does when a global
+// allocator is set.  The histogram is then used as if it were in another
+// process, so kIPCSerializationSourceFlag is only set in the record.
+scoped_ptr<SampleVector> AllocateSamples(SharedHistogramAllocator* allocator,
+                                         Histogram* histogram) {
+  Pickle info;
+  histogram->SetFlags(HistogramBase::kIPCSerializationSourceFlag);
+  EXPECT_TRUE(histogram->SerializeInfo(&info));
+  histogram->ClearFlags(HistogramBase::kIPCSerializationSourceFlag);
+  return allocator->AllocateSamples(info, histogram->bucket_ranges());
+}
+
+}  // namespace
+
+class SharedHistogramAllocatorTest : public testing::Test {
+ protected:
+  SharedHistogramAllocatorTest() : statistics_recorder_(NULL) {}
+
+  virtual void SetUp() OVERRIDE {
+    ResetStatisticsRecorder();
+  }
+
+  virtual void TearDown() OVERRIDE {
+    delete statistics_recorder_;
+    statistics_recorder_ = NULL;
+  }
+
+  // Forgets the histograms created so far.
+  void ResetStatisticsRecorder() {
+    delete statistics_recorder_;
+    statistics_recorder_ = new StatisticsRecorder();
+  }
+
+  StatisticsRecorder* statistics_recorder_;
+};
+
+TEST_F(SharedHistogramAllocatorTest, MergeChangedSamples) {
+  scoped_ptr<SharedHistogramAllocator> browser =
+      SharedHistogramAllocator::Create(kSegmentSize);
+  ASSERT_TRUE(browser);
+  scoped_ptr<SharedHistogramAllocator> child = OpenSegment(browser.get());
+  ASSERT_TRUE(child);
+
+  // The child and the browser share the histogram of this process.
+  Histogram* histogram = static_cast<Histogram*>(Histogram::FactoryGet(
+      "SharedHistogram", 1, 1000, 10, HistogramBase::kNoFlags));
+  scoped_ptr<SampleVector> child_samples =
+      AllocateSamples(child.get(), histogram);
+  ASSERT_TRUE(child_samples);
+  EXPECT_EQ(browser->used(), child->used());
+
+  child_samples->Accumulate(10, 2);
+  child_samples->Accumulate(100, 1);
+  browser->MergeChangedSamples();
+  scoped_ptr<HistogramSamples> snapshot = histogram->SnapshotSamples();
+  EXPECT_EQ(2, snapshot->GetCount(10));
+  EXPECT_EQ(1, snapshot->GetCount(100));
+  EXPECT_EQ(120, snapshot->sum());
+
+  // Only the samples added since the previous merge are added again.
+  browser->MergeChangedSamples();
+  child_samples->Accumulate(10, 1);
+  browser->MergeChangedSamples();
+  snapshot = histogram->SnapshotSamples();
+  EXPECT_EQ(3, snapshot->GetCount(10));
+  EXPECT_EQ(1, snapshot->GetCount(100));
+  EXPECT_EQ(4, snapshot->redundant_count());
+  EXPECT_EQ(130, snapshot->sum());
+}
+
+TEST_F(SharedHistogramAllocatorTest, MergeCreatesHistograms) {
+  scoped_ptr<SharedHistogramAllocator> browser =
+      SharedHistogramAllocator::Create(kSegmentSize);
+  ASSERT_TRUE(browser);
+  scoped_ptr<SharedHistogramAllocator> child = OpenSegment(browser.get());
+  ASSERT_TRUE(child);
+
+  // Forgets the child's histogram before merging, so that the browser has to
+  // create its own.
+  Histogram* child_histogram =
+      static_cast<Histogram*>(LinearHistogram::FactoryGet(
+          "ChildHistogram", 1, 10, 11, HistogramBase::kNoFlags));
+  scoped_ptr<SampleVector> child_samples =
+      AllocateSamples(child.get(), child_histogram);
+  ASSERT_TRUE(child_samples);
+  child_samples->Accumulate(3, 5);
+
+  ResetStatisticsRecorder();
+  browser->MergeChangedSamples();
+  HistogramBase* histogram =
+      StatisticsRecorder::FindHistogram("ChildHistogram");
+  ASSERT_TRUE(histogram);
+  EXPECT_EQ(LINEAR_HISTOGRAM, histogram->GetHistogramType());
+  EXPECT_NE(child_histogram, histogram);
+  EXPECT_EQ(5, histogram->SnapshotSamples()->GetCount(3));
+}
+
+TEST_F(SharedHistogramAllocatorTest, SegmentFull) {
+  scoped_ptr<SharedHistogramAllocator> allocator =
+      SharedHistogramAllocator::Create(512);
+  ASSERT_TRUE(allocator);
+
+  Histogram* histogram = static_cast<Histogram*>(Histogram::FactoryGet(
+      "LargeHistogram", 1, 1000, 200, HistogramBase::kNoFlags));
+  size_t used = allocator->used();
+  EXPECT_FALSE(AllocateSamples(allocator.get(), histogram));
+  EXPECT_EQ(used, allocator->used());
+}
+
+TEST_F(SharedHistogramAllocatorTest, OpenRejectsUnformattedSegment) {
+  SharedMemory shared_memory;
+  ASSERT_TRUE(shared_memory.CreateAndMapAnonymous(kSegmentSize));
+  SharedMemoryHandle handle;
+  ASSERT_TRUE(shared_memory.ShareToProcess(GetCurrentProcessHandle(),
+                                           &handle));
+  EXPECT_FALSE(SharedHistogramAllocator::Open(handle, kSegmentSize));
+}
+
+}  // namespace base
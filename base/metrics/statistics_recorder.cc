@@ -6,6 +6,7 @@
 
 #include "base/at_exit.h"
 #include "base/debug/leak_annotations.h"
+#include "base/hash.h"
 #include "base/json/string_escape.h"
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
@@ -25,6 +26,118 @@ base::LazyInstance<base::StatisticsRecorder>::Leaky g_statistics_recorder_ =
 
 namespace base {
 
+// An insert-only hash table from histogram name to histogram.  The names are
+// split over a fixed number of shards, each an open-addressed table with
+// linear probing that grows independently of the others.  Lookups take no
+// lock: a slot is published with Release_Store() only once it holds a fully
+// constructed histogram, and registered histograms are never deleted.  A
+// table that is outgrown stays alive until the index is destroyed, so
+// readers still probing it are safe.  Insertions must be serialized by the
+// caller.
+class StatisticsRecorder::HistogramIndex {
+ public:
+  HistogramIndex() {
+    for (size_t i = 0; i < kNumShards; ++i)
+      shards_[i] =
+          reinterpret_cast<subtle::AtomicWord>(NewTable(kMinCapacity));
+  }
+
+  ~HistogramIndex() {
+    for (size_t i = 0; i < kNumShards; ++i)
+      DeleteTable(GetShard(i));
+    for (size_t i = 0; i < retired_tables_.size(); ++i)
+      DeleteTable(retired_tables_[i]);
+  }
+
+  HistogramBase* Find(const std::string& name) const {
+    uint32 hash = base::Hash(name);
+    const Table* table = GetShard(hash);
+    // The load factor is kept below one, so there is always an empty slot.
+    for (size_t slot = ProbeStart(hash, table);;
+         slot = (slot + 1) & table->mask) {
+      HistogramBase* histogram = reinterpret_cast<HistogramBase*>(
+          subtle::Acquire_Load(&table->slots[slot]));
+      if (!histogram)
+        return NULL;
+      if (histogram->histogram_name() == name)
+        return histogram;
+    }
+  }
+
+  // |histogram| must not be in the index yet.
+  void Insert(HistogramBase* histogram) {
+    uint32 hash = base::Hash(histogram->histogram_name());
+    Table* table = GetShard(hash);
+    // Keep the load factor at or below one half.
+    if (2 * (table->size + 1) > table->mask + 1) {
+      Table* grown = NewTable(2 * (table->mask + 1));
+      for (size_t i = 0; i <= table->mask; ++i) {
+        HistogramBase* entry = reinterpret_cast<HistogramBase*>(
+            subtle::NoBarrier_Load(&table->slots[i]));
+        if (entry)
+          InsertIntoTable(grown, base::Hash(entry->histogram_name()), entry);
+      }
+      subtle::Release_Store(&shards_[hash & (kNumShards - 1)],
+                            reinterpret_cast<subtle::AtomicWord>(grown));
+      retired_tables_.push_back(table);
+      table = grown;
+    }
+    InsertIntoTable(table, hash, histogram);
+  }
+
+ private:
+  static const size_t kNumShards = 16;
+  static const size_t kMinCapacity = 16;
+
+  struct Table {
+    size_t mask;  // The capacity minus one.  The capacity is a power of two.
+    size_t size;  // Only accessed by writers.
+    subtle::AtomicWord* slots;
+  };
+
+  static Table* NewTable(size_t capacity) {
+    Table* table = new Table;
+    table->mask = capacity - 1;
+    table->size = 0;
+    table->slots = new subtle::AtomicWord[capacity]();
+    return table;
+  }
+
+  static void DeleteTable(Table* table) {
+    delete[] table->slots;
+    delete table;
+  }
+
+  // The low bits of a hash select the shard, and the remaining ones the
+  // first slot to probe.
+  static size_t ProbeStart(uint32 hash, const Table* table) {
+    return (hash / kNumShards) & table->mask;
+  }
+
+  static void InsertIntoTable(Table* table,
+                              uint32 hash,
+                              HistogramBase* histogram) {
+    size_t slot = ProbeStart(hash, table);
+    while (subtle::NoBarrier_Load(&table->slots[slot]))
+      slot = (slot + 1) & table->mask;
+    subtle::Release_Store(&table->slots[slot],
+                          reinterpret_cast<subtle::AtomicWord>(histogram));
+    ++table->size;
+  }
+
+  Table* GetShard(uint32 hash) const {
+    return reinterpret_cast<Table*>(
+        subtle::Acquire_Load(&shards_[hash & (kNumShards - 1)]));
+  }
+
+  subtle::AtomicWord shards_[kNumShards];
+
+  // Tables replaced by bigger ones.  Only accessed by writers.
+  std::vector<Table*> retired_tables_;
+
+  DISALLOW_COPY_AND_ASSIGN(HistogramIndex);
+};
+
 // static
 void StatisticsRecorder::Initialize() {
   // Ensure that an instance of the StatisticsRecorder object is created.
@@ -64,6 +177,8 @@ HistogramBase* StatisticsRecorder::RegisterOrDeleteDuplicate(
       HistogramMap::iterator it = histograms_->find(name);
       if (histograms_->end() == it) {
         (*histograms_)[name] = histogram;
+        reinterpret_cast<HistogramIndex*>(
+            subtle::NoBarrier_Load(&histogram_index_))->Insert(histogram);
         ANNOTATE_LEAKING_OBJECT_PTR(histogram);  // see crbug.com/79322
         histogram_to_return = histogram;
       } else if (histogram == it->second) {
@@ -234,16 +349,11 @@ void StatisticsRecorder::GetBucketRanges(
 
 // static
 HistogramBase* StatisticsRecorder::FindHistogram(const std::string& name) {
-  if (lock_ == NULL)
-    return NULL;
-  base::AutoLock auto_lock(*lock_);
-  if (histograms_ == NULL)
+  const HistogramIndex* index = reinterpret_cast<const HistogramIndex*>(
+      subtle::Acquire_Load(&histogram_index_));
+  if (!index)
     return NULL;
-
-  HistogramMap::iterator it = histograms_->find(name);
-  if (histograms_->end() == it)
-    return NULL;
-  return it->second;
+  return index->Find(name);
 }
 
 // private static
@@ -280,6 +390,8 @@ StatisticsRecorder::StatisticsRecorder() {
   base::AutoLock auto_lock(*lock_);
   histograms_ = new HistogramMap;
   ranges_ = new RangesMap;
+  subtle::Release_Store(&histogram_index_, reinterpret_cast<subtle::AtomicWord>(
+      new HistogramIndex));
 
   if (VLOG_IS_ON(1))
     AtExitManager::RegisterCallback(&DumpHistogramsToVlog, this);
@@ -301,14 +413,20 @@ StatisticsRecorder::~StatisticsRecorder() {
   // Clean up.
   scoped_ptr<HistogramMap> histograms_deleter;
   scoped_ptr<RangesMap> ranges_deleter;
+  // The index is read without the lock, so, as for the recorder as a whole,
+  // there must be no concurrent FindHistogram() calls at this point.
+  scoped_ptr<HistogramIndex> index_deleter;
   // We don't delete lock_ on purpose to avoid having to properly protect
   // against it going away after we checked for NULL in the static methods.
   {
     base::AutoLock auto_lock(*lock_);
     histograms_deleter.reset(histograms_);
     ranges_deleter.reset(ranges_);
+    index_deleter.reset(reinterpret_cast<HistogramIndex*>(
+        subtle::NoBarrier_Load(&histogram_index_)));
     histograms_ = NULL;
     ranges_ = NULL;
+    subtle::NoBarrier_Store(&histogram_index_, 0);
   }
   // We are going to leak the histograms and the ranges.
 }
@@ -320,5 +438,7 @@ StatisticsRecorder::HistogramMap* StatisticsRecorder::histograms_ = NULL;
 StatisticsRecorder::RangesMap* StatisticsRecorder::ranges_ = NULL;
 // static
 base::Lock* StatisticsRecorder::lock_ = NULL;
+// static
+subtle::AtomicWord StatisticsRecorder::histogram_index_ = 0;
 
 }  // namespace base
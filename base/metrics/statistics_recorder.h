@@ -15,6 +15,7 @@
 #include <string>
 #include <vector>
 
+#include "base/atomicops.h"
 #include "base/base_export.h"
 #include "base/basictypes.h"
 #include "base/gtest_prod_util.h"
@@ -66,7 +67,8 @@ class BASE_EXPORT StatisticsRecorder {
   static void GetBucketRanges(std::vector<const BucketRanges*>* output);
 
   // Find a histogram by name. It matches the exact name. This method is thread
-  // safe.  It returns NULL if a matching histogram is not found.
+  // safe and does not take a lock.  It returns NULL if a matching histogram is
+  // not found.
   static HistogramBase* FindHistogram(const std::string& name);
 
   // GetSnapshot copies some of the pointers to registered histograms into the
@@ -79,6 +81,10 @@ class BASE_EXPORT StatisticsRecorder {
   // We keep all registered histograms in a map, from name to histogram.
   typedef std::map<std::string, HistogramBase*> HistogramMap;
 
+  // An index of the histograms in |histograms_| that FindHistogram() reads
+  // without taking |lock_|.
+  class HistogramIndex;
+
   // We keep all |bucket_ranges_| in a map, from checksum to a list of
   // |bucket_ranges_|.  Checksum is calculated from the |ranges_| in
   // |bucket_ranges_|.
@@ -88,11 +94,15 @@ class BASE_EXPORT StatisticsRecorder {
   friend class HistogramBaseTest;
   friend class HistogramSnapshotManagerTest;
   friend class HistogramTest;
+  friend class SharedHistogramAllocatorTest;
   friend class SparseHistogramTest;
   friend class StatisticsDeltaReaderTest;
+  friend class StatisticsRecorderPerfTest;
   friend class StatisticsRecorderTest;
   FRIEND_TEST_ALL_PREFIXES(HistogramDeltaSerializationTest,
                            DeserializeHistogramAndAddSamples);
+  FRIEND_TEST_ALL_PREFIXES(HistogramDeltaSerializationTest,
+                           SkipsSharedMemoryHistograms);
 
   // The constructor just initializes static members. Usually client code should
   // use Initialize to do this. But in test code, you can friend this class and
@@ -105,9 +115,14 @@ class BASE_EXPORT StatisticsRecorder {
   static HistogramMap* histograms_;
   static RangesMap* ranges_;
 
-  // Lock protects access to above maps.
+  // Lock protects access to above maps, and serializes changes to
+  // |histogram_index_|.
   static base::Lock* lock_;
 
+  // The HistogramIndex* of the current |histograms_|, or NULL.  Read with
+  // Acquire_Load() and without |lock_|.
+  static subtle::AtomicWord histogram_index_;
+
   DISALLOW_COPY_AND_ASSIGN(StatisticsRecorder);
 };
 
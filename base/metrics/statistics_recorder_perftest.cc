@@ -0,0 +1,104 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures Histogram::FactoryGet() throughput with 16 threads looking up a
+// mix of histogram names at runtime, as code with dynamically built names
+// does.  Most lookups hit already registered histograms; a few register new
+// ones.
+
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/metrics/histogram.h"
+#include "base/metrics/statistics_recorder.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/simple_thread.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+const int kNumThreads = 16;
+const int kLookupsPerThread = 200000;
+const int kNumSharedNames = 500;
+// One lookup in this many registers a name that is new to the thread.
+const int kNewNameInterval = 1000;
+
+class FactoryGetThread : public DelegateSimpleThread::Delegate {
+ public:
+  FactoryGetThread(int index, const std::vector<std::string>* shared_names)
+      : index_(index), shared_names_(shared_names) {}
+
+  virtual void Run() OVERRIDE {
+    size_t name = index_;
+    for (int i = 0; i < kLookupsPerThread; ++i) {
+      HistogramBase* histogram;
+      if (i % kNewNameInterval == 0) {
+        histogram = Histogram::FactoryGet(
+            StringPrintf("PerfTest.Thread%d.%d", index_, i), 1, 1000, 50,
+            HistogramBase::kNoFlags);
+      } else {
+        name = (name * 31 + 7) % shared_names_->size();
+        histogram = Histogram::FactoryGet((*shared_names_)[name], 1, 1000, 50,
+                                          HistogramBase::kNoFlags);
+      }
+      histogram->Add(i);
+    }
+  }
+
+ private:
+  const int index_;
+  const std::vector<std::string>* shared_names_;
+};
+
+}  // namespace
+
+class StatisticsRecorderPerfTest : public testing::Test {
+ protected:
+  virtual void SetUp() OVERRIDE {
+    statistics_recorder_ = new StatisticsRecorder();
+  }
+
+  virtual void TearDown() OVERRIDE {
+    delete statistics_recorder_;
+    statistics_recorder_ = NULL;
+  }
+
+  StatisticsRecorder* statistics_recorder_;
+};
+
+TEST_F(StatisticsRecorderPerfTest, ContendedFactoryGet) {
+  std::vector<std::string> shared_names;
+  for (int i = 0; i < kNumSharedNames; ++i) {
+    shared_names.push_back(StringPrintf("PerfTest.Shared.%d", i));
+    Histogram::FactoryGet(shared_names.back(), 1, 1000, 50,
+                          HistogramBase::kNoFlags);
+  }
+
+  std::vector<FactoryGetThread*> delegates;
+  std::vector<DelegateSimpleThread*> threads;
+  TimeTicks start = TimeTicks::HighResNow();
+  for (int i = 0; i < kNumThreads; ++i) {
+    delegates.push_back(new FactoryGetThread(i, &shared_names));
+    threads.push_back(new DelegateSimpleThread(delegates[i], "FactoryGet"));
+    threads[i]->Start();
+  }
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads[i]->Join();
+    delete threads[i];
+    delete delegates[i];
+  }
+  double elapsed_ms = (TimeTicks::HighResNow() - start).InMillisecondsF();
+
+  perf_test::PrintResult("factory_get", "",
+                         StringPrintf("%d_threads", kNumThreads),
+                         kNumThreads * kLookupsPerThread / elapsed_ms,
+                         "lookups/ms", true);
+}
+
+}  // namespace base
@@ -8,6 +8,8 @@
 #include "base/memory/scoped_ptr.h"
 #include "base/metrics/histogram.h"
 #include "base/metrics/statistics_recorder.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/simple_thread.h"
 #include "base/values.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -151,6 +153,81 @@ TEST_F(StatisticsRecorderTest, FindHistogram) {
   EXPECT_TRUE(StatisticsRecorder::FindHistogram("TestHistogram") == NULL);
 }
 
+TEST_F(StatisticsRecorderTest, FindManyHistograms) {
+  // Enough histograms to grow every shard of the lookup index several times.
+  const int kNumHistograms = 2000;
+  std::vector<HistogramBase*> histograms;
+  for (int i = 0; i < kNumHistograms; ++i) {
+    histograms.push_back(Histogram::FactoryGet(
+        StringPrintf("Many.%d", i), 1, 1000, 10, HistogramBase::kNoFlags));
+  }
+  for (int i = 0; i < kNumHistograms; ++i) {
+    EXPECT_EQ(histograms[i],
+              StatisticsRecorder::FindHistogram(StringPrintf("Many.%d", i)));
+  }
+  EXPECT_TRUE(StatisticsRecorder::FindHistogram("Many.") == NULL);
+  EXPECT_TRUE(StatisticsRecorder::FindHistogram(std::string()) == NULL);
+}
+
+namespace {
+
+// Registers histograms |offset|, |offset| + |stride|, ... and checks that
+// each one, and all histograms registered before it by this thread, can be
+// found.
+class RegisterAndFindThread : public DelegateSimpleThread::Delegate {
+ public:
+  RegisterAndFindThread(int offset, int stride, int count)
+      : offset_(offset), stride_(stride), count_(count), failures_(0) {}
+
+  virtual void Run() OVERRIDE {
+    for (int i = 0; i < count_; ++i) {
+      std::string name = StringPrintf("Concurrent.%d", offset_ + i * stride_);
+      HistogramBase* histogram = Histogram::FactoryGet(
+          name, 1, 1000, 10, HistogramBase::kNoFlags);
+      if (StatisticsRecorder::FindHistogram(name) != histogram)
+        ++failures_;
+      std::string first = StringPrintf("Concurrent.%d", offset_);
+      if (!StatisticsRecorder::FindHistogram(first))
+        ++failures_;
+    }
+  }
+
+  int failures() const { return failures_; }
+
+ private:
+  const int offset_;
+  const int stride_;
+  const int count_;
+  int failures_;
+};
+
+}  // namespace
+
+TEST_F(StatisticsRecorderTest, ConcurrentRegisterAndFind) {
+  const int kNumThreads = 4;
+  const int kHistogramsPerThread = 500;
+  std::vector<RegisterAndFindThread*> delegates;
+  std::vector<DelegateSimpleThread*> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    delegates.push_back(
+        new RegisterAndFindThread(i, kNumThreads, kHistogramsPerThread));
+    threads.push_back(
+        new DelegateSimpleThread(delegates[i], "RegisterAndFindThread"));
+    threads[i]->Start();
+  }
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads[i]->Join();
+    EXPECT_EQ(0, delegates[i]->failures());
+    delete threads[i];
+    delete delegates[i];
+  }
+
+  StatisticsRecorder::Histograms registered;
+  StatisticsRecorder::GetHistograms(&registered);
+  EXPECT_EQ(static_cast<size_t>(kNumThreads * kHistogramsPerThread),
+            registered.size());
+}
+
 TEST_F(StatisticsRecorderTest, GetSnapshot) {
   Histogram::FactoryGet("TestHistogram1", 1, 1000, 10, Histogram::kNoFlags);
   Histogram::FactoryGet("TestHistogram2", 1, 1000, 10, Histogram::kNoFlags);
@@ -6,6 +6,8 @@
 
 #include <stdlib.h>
 
+#include <string.h>
+
 #include <algorithm>  // for max()
 
 //------------------------------------------------------------------------------
@@ -20,7 +22,14 @@ static const size_t kCapacityReadOnly = static_cast<size_t>(-1);
 
 PickleIterator::PickleIterator(const Pickle& pickle)
     : read_ptr_(pickle.payload()),
-      read_end_ptr_(pickle.end_of_payload()) {
+      read_end_ptr_(pickle.end_of_payload()),
+      pickle_(NULL),
+      next_segment_(0) {
+  if (pickle.has_external_data()) {
+    pickle_ = &pickle;
+    pickle.GetPayloadSegment(0, &read_ptr_, &read_end_ptr_);
+    next_segment_ = 1;
+  }
 }
 
 template <typename Type>
@@ -37,9 +46,11 @@ inline bool PickleIterator::ReadBuiltinType(Type* result) {
 
 template<typename Type>
 inline const char* PickleIterator::GetReadPointerAndAdvance() {
-  const char* current_read_ptr = read_ptr_;
-  if (read_ptr_ + sizeof(Type) > read_end_ptr_)
+  if (read_ptr_ + sizeof(Type) > read_end_ptr_ &&
+      !AdvanceToNextSegment(sizeof(Type))) {
     return NULL;
+  }
+  const char* current_read_ptr = read_ptr_;
   if (sizeof(Type) < sizeof(uint32))
     read_ptr_ += AlignInt(sizeof(Type), sizeof(uint32));
   else
@@ -48,7 +59,9 @@ inline const char* PickleIterator::GetReadPointerAndAdvance() {
 }
 
 const char* PickleIterator::GetReadPointerAndAdvance(int num_bytes) {
-  if (num_bytes < 0 || read_end_ptr_ - read_ptr_ < num_bytes)
+  if (num_bytes < 0)
+    return NULL;
+  if (read_end_ptr_ - read_ptr_ < num_bytes && !AdvanceToNextSegment(num_bytes))
     return NULL;
   const char* current_read_ptr = read_ptr_;
   read_ptr_ += AlignInt(num_bytes, sizeof(uint32));
@@ -105,6 +118,17 @@ bool PickleIterator::ReadFloat(float* result) {
   return true;
 }
 
+bool PickleIterator::AdvanceToNextSegment(size_t num_bytes) {
+  if (!pickle_ || read_ptr_ < read_end_ptr_)
+    return false;
+  do {
+    if (!pickle_->GetPayloadSegment(next_segment_, &read_ptr_, &read_end_ptr_))
+      return false;
+    ++next_segment_;
+  } while (read_ptr_ == read_end_ptr_);
+  return static_cast<size_t>(read_end_ptr_ - read_ptr_) >= num_bytes;
+}
+
 bool PickleIterator::ReadString(std::string* result) {
   int len;
   if (!ReadInt(&len))
@@ -165,7 +189,8 @@ Pickle::Pickle()
     : header_(NULL),
       header_size_(sizeof(Header)),
       capacity_after_header_(0),
-      write_offset_(0) {
+      write_offset_(0),
+      external_data_size_(0) {
   Resize(kPayloadUnit);
   header_->payload_size = 0;
 }
@@ -174,7 +199,8 @@ Pickle::Pickle(int header_size)
     : header_(NULL),
       header_size_(AlignInt(header_size, sizeof(uint32))),
       capacity_after_header_(0),
-      write_offset_(0) {
+      write_offset_(0),
+      external_data_size_(0) {
   DCHECK_GE(static_cast<size_t>(header_size), sizeof(Header));
   DCHECK_LE(header_size, kPayloadUnit);
   Resize(kPayloadUnit);
@@ -185,7 +211,8 @@ Pickle::Pickle(const char* data, int data_len)
     : header_(reinterpret_cast<Header*>(const_cast<char*>(data))),
       header_size_(0),
       capacity_after_header_(kCapacityReadOnly),
-      write_offset_(0) {
+      write_offset_(0),
+      external_data_size_(0) {
   if (data_len >= static_cast<int>(sizeof(Header)))
     header_size_ = data_len - header_->payload_size;
 
@@ -204,8 +231,10 @@ Pickle::Pickle(const Pickle& other)
     : header_(NULL),
       header_size_(other.header_size_),
       capacity_after_header_(0),
-      write_offset_(other.write_offset_) {
-  size_t payload_size = header_size_ + other.header_->payload_size;
+      write_offset_(other.write_offset_),
+      external_data_(other.external_data_),
+      external_data_size_(other.external_data_size_) {
+  size_t payload_size = header_size_ + other.inline_payload_size();
   Resize(payload_size);
   memcpy(header_, other.header_, payload_size);
 }
@@ -229,10 +258,12 @@ Pickle& Pickle::operator=(const Pickle& other) {
     header_ = NULL;
     header_size_ = other.header_size_;
   }
-  Resize(other.header_->payload_size);
+  Resize(other.inline_payload_size());
   memcpy(header_, other.header_,
-         other.header_size_ + other.header_->payload_size);
+         other.header_size_ + other.inline_payload_size());
   write_offset_ = other.write_offset_;
+  external_data_ = other.external_data_;
+  external_data_size_ = other.external_data_size_;
   return *this;
 }
 
@@ -268,6 +299,81 @@ bool Pickle::WriteBytes(const void* data, int length) {
   return true;
 }
 
+bool Pickle::WriteExternalData(
+    const scoped_refptr<base::RefCountedMemory>& data) {
+  size_t length = data->size();
+  if (length > static_cast<size_t>(kint32max) ||
+      !WriteInt(static_cast<int>(length))) {
+    return false;
+  }
+  if (!length)
+    return true;
+
+  size_t data_len = AlignInt(length, sizeof(uint32));
+  DCHECK_LE(write_offset_ + external_data_size_, kuint32max - data_len);
+  ExternalData external = { write_offset_, data };
+  external_data_.push_back(external);
+  external_data_size_ += data_len;
+  // Like WriteBytesCommon(), this does not count the trailing padding.
+  header_->payload_size = static_cast<uint32>(
+      write_offset_ + external_data_size_ - (data_len - length));
+  return true;
+}
+
+void Pickle::GetSegments(std::vector<Segment>* segments) const {
+  static const char kPadding[sizeof(uint32)] = { 0 };
+  size_t remaining = size();
+  const char* begin;
+  const char* end;
+  for (size_t i = 0; remaining && GetPayloadSegment(i, &begin, &end); ++i) {
+    size_t length = end - begin;
+    size_t padding = 0;
+    if (i == 0) {
+      // The header is part of the first segment.
+      begin = reinterpret_cast<const char*>(header_);
+      length += header_size_;
+    } else if (i % 2) {
+      padding = AlignInt(length, sizeof(uint32)) - length;
+    }
+
+    Segment segment = { begin, std::min(length, remaining) };
+    if (segment.size)
+      segments->push_back(segment);
+    remaining -= segment.size;
+
+    Segment pad = { kPadding, std::min(padding, remaining) };
+    if (pad.size)
+      segments->push_back(pad);
+    remaining -= pad.size;
+  }
+  DCHECK_EQ(0u, remaining);
+}
+
+void Pickle::Flatten() {
+  if (external_data_.empty())
+    return;
+
+  std::vector<Segment> segments;
+  GetSegments(&segments);
+  size_t new_write_offset = write_offset_ + external_data_size_;
+  size_t new_capacity = AlignInt(new_write_offset, kPayloadUnit);
+  char* flat = static_cast<char*>(malloc(header_size_ + new_capacity));
+  CHECK(flat);
+  char* out = flat;
+  for (size_t i = 0; i < segments.size(); ++i) {
+    memcpy(out, segments[i].data, segments[i].size);
+    out += segments[i].size;
+  }
+  memset(out, 0, flat + header_size_ + new_write_offset - out);
+
+  free(header_);
+  header_ = reinterpret_cast<Header*>(flat);
+  capacity_after_header_ = new_capacity;
+  write_offset_ = new_write_offset;
+  external_data_.clear();
+  external_data_size_ = 0;
+}
+
 void Pickle::Reserve(size_t length) {
   size_t data_len = AlignInt(length, sizeof(uint32));
   DCHECK_GE(data_len, length);
@@ -290,6 +396,27 @@ void Pickle::Resize(size_t new_capacity) {
   capacity_after_header_ = new_capacity;
 }
 
+bool Pickle::GetPayloadSegment(size_t index,
+                               const char** begin,
+                               const char** end) const {
+  size_t block = index / 2;
+  if (index % 2) {
+    if (block >= external_data_.size())
+      return false;
+    const base::RefCountedMemory* memory = external_data_[block].data.get();
+    *begin = reinterpret_cast<const char*>(memory->front());
+    *end = *begin + memory->size();
+    return true;
+  }
+  if (block > external_data_.size())
+    return false;
+  *begin = payload() + (block ? external_data_[block - 1].offset : 0);
+  *end = payload() + (block < external_data_.size() ?
+                          external_data_[block].offset :
+                          inline_payload_size());
+  return true;
+}
+
 // static
 const char* Pickle::FindNext(size_t header_size,
                              const char* start,
@@ -323,7 +450,7 @@ inline void Pickle::WriteBytesCommon(const void* data, size_t length) {
 #ifdef ARCH_CPU_64_BITS
   DCHECK_LE(data_len, kuint32max);
 #endif
-  DCHECK_LE(write_offset_, kuint32max - data_len);
+  DCHECK_LE(write_offset_ + external_data_size_, kuint32max - data_len);
   size_t new_size = write_offset_ + data_len;
   if (new_size > capacity_after_header_) {
     Resize(std::max(capacity_after_header_ * 2, new_size));
@@ -332,6 +459,7 @@ inline void Pickle::WriteBytesCommon(const void* data, size_t length) {
   char* write = mutable_payload() + write_offset_;
   memcpy(write, data, length);
   memset(write + length, 0, data_len - length);
-  header_->payload_size = static_cast<uint32>(write_offset_ + length);
+  header_->payload_size =
+      static_cast<uint32>(write_offset_ + length + external_data_size_);
   write_offset_ = new_size;
 }
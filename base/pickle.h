@@ -6,12 +6,15 @@
 #define BASE_PICKLE_H__
 
 #include <string>
+#include <vector>
 
 #include "base/base_export.h"
 #include "base/basictypes.h"
 #include "base/compiler_specific.h"
 #include "base/gtest_prod_util.h"
 #include "base/logging.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/strings/string16.h"
 
 class Pickle;
@@ -20,7 +23,11 @@ class Pickle;
 // while the PickleIterator object is in use.
 class BASE_EXPORT PickleIterator {
  public:
-  PickleIterator() : read_ptr_(NULL), read_end_ptr_(NULL) {}
+  PickleIterator()
+      : read_ptr_(NULL),
+        read_end_ptr_(NULL),
+        pickle_(NULL),
+        next_segment_(0) {}
   explicit PickleIterator(const Pickle& pickle);
 
   // Methods for reading the payload of the Pickle. To read from the start of
@@ -76,10 +83,21 @@ class BASE_EXPORT PickleIterator {
   inline const char* GetReadPointerAndAdvance(int num_elements,
                                               size_t size_element);
 
-  // Pointers to the Pickle data.
+  // Called when the current segment of a pickle with external data does not
+  // hold |num_bytes| more bytes.  If the current segment has been read to its
+  // end, moves to the next non-empty segment and returns true if that holds
+  // |num_bytes|.  A single read never spans segments.
+  bool AdvanceToNextSegment(size_t num_bytes);
+
+  // Pointers to the Pickle data.  For a pickle with external data, these
+  // bound the current segment.
   const char* read_ptr_;
   const char* read_end_ptr_;
 
+  // Only set for pickles with external data.
+  const Pickle* pickle_;
+  size_t next_segment_;
+
   FRIEND_TEST_ALL_PREFIXES(PickleTest, GetReadPointerAndAdvance);
 };
 
@@ -100,6 +118,12 @@ class BASE_EXPORT PickleIterator {
 // space is controlled by the header_size parameter passed to the Pickle
 // constructor.
 //
+// Large blobs can be added with WriteExternalData(), which references a
+// RefCountedMemory instead of copying it into the Pickle's buffer.  The data
+// of such a Pickle is then made up of several segments, which GetSegments()
+// enumerates; data() may only be used once the Pickle has been Flatten()ed.
+// Reading such a Pickle with a PickleIterator works as usual.
+//
 class BASE_EXPORT Pickle {
  public:
   // Initialize a Pickle object using the default header size.
@@ -132,8 +156,30 @@ class BASE_EXPORT Pickle {
   // Returns the size of the Pickle's data.
   size_t size() const { return header_size_ + header_->payload_size; }
 
-  // Returns the data for this Pickle.
-  const void* data() const { return header_; }
+  // Returns the data for this Pickle.  The Pickle must not hold external
+  // data.
+  const void* data() const {
+    DCHECK(external_data_.empty()) << "call Flatten() first";
+    return header_;
+  }
+
+  // A contiguous part of the Pickle's data.
+  struct Segment {
+    const char* data;
+    size_t size;
+  };
+
+  // Appends the segments that together hold the size() bytes of this Pickle's
+  // data to |segments|, in order.  A Pickle without external data consists of
+  // a single segment.
+  void GetSegments(std::vector<Segment>* segments) const;
+
+  // Returns true if the Pickle references data written by
+  // WriteExternalData().
+  bool has_external_data() const { return !external_data_.empty(); }
+
+  // Copies any external data into the Pickle's own buffer.
+  void Flatten();
 
   // For compatibility, these older style read methods pass through to the
   // PickleIterator methods.
@@ -251,6 +297,9 @@ class BASE_EXPORT Pickle {
   // when reading and writing. It is normally used to serialize PoD types of a
   // known size. See also WriteData.
   bool WriteBytes(const void* data, int length);
+  // Like WriteData, but references |data| rather than copying it.  The data is
+  // read back with ReadData as usual.
+  bool WriteExternalData(const scoped_refptr<base::RefCountedMemory>& data);
 
   // Reserves space for upcoming writes when multiple writes will be made and
   // their sizes are computed in advance. It can be significantly faster to call
@@ -284,10 +333,11 @@ class BASE_EXPORT Pickle {
   }
 
   // Returns the address of the byte immediately following the currently valid
-  // header + payload.
+  // header + payload.  For a Pickle with external data, this is the end of
+  // the part of the payload that is held in the Pickle's own buffer.
   const char* end_of_payload() const {
     // This object may be invalid.
-    return header_ ? payload() + payload_size() : NULL;
+    return header_ ? payload() + inline_payload_size() : NULL;
   }
 
  protected:
@@ -326,9 +376,36 @@ class BASE_EXPORT Pickle {
   // doesn't count the header.
   size_t capacity_after_header_;
   // The offset at which we will write the next field. Note: this doesn't count
-  // the header.
+  // the header, or external data.
   size_t write_offset_;
 
+  // A block written by WriteExternalData().  It logically follows the first
+  // |offset| bytes of the payload held in the Pickle's own buffer, and is
+  // padded to a multiple of sizeof(uint32) with zeros.
+  struct ExternalData {
+    size_t offset;
+    scoped_refptr<base::RefCountedMemory> data;
+  };
+  std::vector<ExternalData> external_data_;
+  // Total size of |external_data_|, including padding.
+  size_t external_data_size_;
+
+  // Returns the size of the part of the payload held in |header_|.
+  size_t inline_payload_size() const {
+    if (external_data_.empty())
+      return header_->payload_size;
+    if (external_data_.back().offset == write_offset_)
+      return write_offset_;
+    return header_->payload_size - external_data_size_;
+  }
+
+  // Sets |*begin| and |*end| to segment |index| of the payload, counting the
+  // inline and external parts separately.  Returns false if there is no such
+  // segment.
+  bool GetPayloadSegment(size_t index,
+                         const char** begin,
+                         const char** end) const;
+
   // Just like WriteBytes, but with a compile-time size, for performance.
   template<size_t length> void WriteBytesStatic(const void* data);
 
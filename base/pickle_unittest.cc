@@ -3,8 +3,10 @@
 // found in the LICENSE file.
 
 #include <string>
+#include <vector>
 
 #include "base/basictypes.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/pickle.h"
 #include "base/strings/string16.h"
@@ -362,3 +364,152 @@ TEST(PickleTest, ReadBytes) {
   memcpy(&outdata, outdata_char, sizeof(outdata));
   EXPECT_EQ(data, outdata);
 }
+
+namespace {
+
+scoped_refptr<base::RefCountedMemory> MakeExternalData(const std::string& s) {
+  std::string copy(s);
+  return base::RefCountedString::TakeString(&copy);
+}
+
+// Returns the concatenation of |pickle|'s segments.
+std::string JoinSegments(const Pickle& pickle) {
+  std::vector<Pickle::Segment> segments;
+  pickle.GetSegments(&segments);
+  std::string result;
+  for (size_t i = 0; i < segments.size(); ++i)
+    result.append(segments[i].data, segments[i].size);
+  return result;
+}
+
+void WriteMixedPickle(Pickle* pickle, bool external) {
+  const std::string kBlob1(1001, 'a');
+  const std::string kBlob2(64, 'b');
+  EXPECT_TRUE(pickle->WriteInt(testint));
+  if (external)
+    EXPECT_TRUE(pickle->WriteExternalData(MakeExternalData(kBlob1)));
+  else
+    EXPECT_TRUE(pickle->WriteData(kBlob1.data(), kBlob1.size()));
+  EXPECT_TRUE(pickle->WriteString(teststr));
+  if (external)
+    EXPECT_TRUE(pickle->WriteExternalData(MakeExternalData(kBlob2)));
+  else
+    EXPECT_TRUE(pickle->WriteData(kBlob2.data(), kBlob2.size()));
+  if (external)
+    EXPECT_TRUE(pickle->WriteExternalData(MakeExternalData(std::string())));
+  else
+    EXPECT_TRUE(pickle->WriteData(NULL, 0));
+  EXPECT_TRUE(pickle->WriteBool(true));
+}
+
+void VerifyMixedPickle(const Pickle& pickle) {
+  PickleIterator iter(pickle);
+  int outint;
+  EXPECT_TRUE(pickle.ReadInt(&iter, &outint));
+  EXPECT_EQ(testint, outint);
+
+  const char* data;
+  int length;
+  EXPECT_TRUE(pickle.ReadData(&iter, &data, &length));
+  EXPECT_EQ(std::string(1001, 'a'), std::string(data, length));
+
+  std::string outstr;
+  EXPECT_TRUE(pickle.ReadString(&iter, &outstr));
+  EXPECT_EQ(teststr, outstr);
+
+  EXPECT_TRUE(pickle.ReadData(&iter, &data, &length));
+  EXPECT_EQ(std::string(64, 'b'), std::string(data, length));
+
+  EXPECT_TRUE(pickle.ReadData(&iter, &data, &length));
+  EXPECT_EQ(0, length);
+
+  bool outbool;
+  EXPECT_TRUE(pickle.ReadBool(&iter, &outbool));
+  EXPECT_TRUE(outbool);
+
+  EXPECT_FALSE(pickle.ReadInt(&iter, &outint));
+}
+
+}  // namespace
+
+TEST(PickleTest, ExternalData) {
+  Pickle pickle;
+  WriteMixedPickle(&pickle, true);
+  EXPECT_TRUE(pickle.has_external_data());
+  VerifyMixedPickle(pickle);
+
+  // The segments hold the same bytes as a pickle with the data copied in.
+  Pickle inline_pickle;
+  WriteMixedPickle(&inline_pickle, false);
+  EXPECT_FALSE(inline_pickle.has_external_data());
+  EXPECT_EQ(inline_pickle.size(), pickle.size());
+  EXPECT_EQ(std::string(static_cast<const char*>(inline_pickle.data()),
+                        inline_pickle.size()),
+            JoinSegments(pickle));
+}
+
+TEST(PickleTest, ExternalDataAtEnd) {
+  Pickle pickle;
+  EXPECT_TRUE(pickle.WriteInt(testint));
+  EXPECT_TRUE(pickle.WriteExternalData(MakeExternalData(teststr)));
+
+  PickleIterator iter(pickle);
+  int outint;
+  EXPECT_TRUE(pickle.ReadInt(&iter, &outint));
+  const char* data;
+  int length;
+  EXPECT_TRUE(pickle.ReadData(&iter, &data, &length));
+  EXPECT_EQ(teststr, std::string(data, length));
+  EXPECT_FALSE(pickle.ReadInt(&iter, &outint));
+
+  // Trailing padding is not part of size(), as for WriteData().
+  Pickle inline_pickle;
+  EXPECT_TRUE(inline_pickle.WriteInt(testint));
+  EXPECT_TRUE(inline_pickle.WriteData(teststr.data(), teststr.size()));
+  EXPECT_EQ(inline_pickle.size(), pickle.size());
+  EXPECT_EQ(inline_pickle.size(), JoinSegments(pickle).size());
+}
+
+TEST(PickleTest, ReadDoesNotSpanSegments) {
+  Pickle pickle;
+  EXPECT_TRUE(pickle.WriteExternalData(MakeExternalData("12345678")));
+
+  PickleIterator iter(pickle);
+  int length;
+  EXPECT_TRUE(pickle.ReadInt(&iter, &length));
+  EXPECT_EQ(8, length);
+  const char* data;
+  EXPECT_TRUE(pickle.ReadBytes(&iter, &data, 4));
+  EXPECT_EQ("1234", std::string(data, 4));
+  EXPECT_FALSE(pickle.ReadBytes(&iter, &data, 8));
+}
+
+TEST(PickleTest, FlattenExternalData) {
+  Pickle pickle;
+  WriteMixedPickle(&pickle, true);
+  std::string joined = JoinSegments(pickle);
+
+  pickle.Flatten();
+  EXPECT_FALSE(pickle.has_external_data());
+  EXPECT_EQ(joined,
+            std::string(static_cast<const char*>(pickle.data()), pickle.size()));
+  VerifyMixedPickle(pickle);
+
+  // The flattened pickle can still be written to.
+  EXPECT_TRUE(pickle.WriteInt(testint));
+  EXPECT_EQ(joined.size() + sizeof(int), pickle.size());
+}
+
+TEST(PickleTest, CopyExternalData) {
+  Pickle pickle;
+  WriteMixedPickle(&pickle, true);
+
+  Pickle copy(pickle);
+  EXPECT_TRUE(copy.has_external_data());
+  VerifyMixedPickle(copy);
+
+  Pickle assigned;
+  assigned = pickle;
+  VerifyMixedPickle(assigned);
+  EXPECT_EQ(JoinSegments(pickle), JoinSegments(assigned));
+}
@@ -154,6 +154,15 @@ class BASE_EXPORT ProcessMetrics {
   // usage in bytes, as per definition of WorkingSetBytes.
   bool GetWorkingSetKBytes(WorkingSetKBytes* ws_usage) const;
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  // Fills |private_dirty_kb| with the memory the process has written to and
+  // does not share with any other process, from /proc/<pid>/smaps. Unlike
+  // the private working set from statm, this leaves out pages still shared
+  // copy-on-write with a parent such as the zygote. Parsing smaps is slow, so
+  // this should not be called often.
+  bool GetPrivateDirtyKBytes(size_t* private_dirty_kb) const;
+#endif
+
   // Computes the current process available memory for allocation.
   // It does a linear scan of the address space querying each memory region
   // for its free (unallocated) status. It is useful for estimating the memory
@@ -296,6 +305,12 @@ BASE_EXPORT bool ParseProcMeminfo(const std::string& input,
 BASE_EXPORT bool ParseProcVmstat(const std::string& input,
                                  SystemMemoryInfoKB* meminfo);
 
+// Parses a string containing the contents of /proc/<pid>/smaps and sums the
+// Private_Dirty sizes of all the mappings into |private_dirty_kb|.
+// Returns true on success or false for a parsing error.
+BASE_EXPORT bool ParseProcSmapsPrivateDirty(const std::string& input,
+                                            size_t* private_dirty_kb);
+
 // Retrieves data from /proc/meminfo and /proc/vmstat
 // about system-wide memory consumption.
 // Fills in the provided |meminfo| structure. Returns true on success.
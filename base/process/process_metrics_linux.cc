@@ -376,6 +376,18 @@ bool ProcessMetrics::GetWorkingSetKBytesStatm(WorkingSetKBytes* ws_usage)
   return ret;
 }
 
+bool ProcessMetrics::GetPrivateDirtyKBytes(size_t* private_dirty_kb) const {
+  std::string smaps_data;
+  {
+    FilePath smaps_file = internal::GetProcPidDir(process_).Append("smaps");
+    // Synchronously reading files in /proc is safe.
+    ThreadRestrictions::ScopedAllowIO allow_io;
+    if (!ReadFileToString(smaps_file, &smaps_data) || smaps_data.empty())
+      return false;
+  }
+  return ParseProcSmapsPrivateDirty(smaps_data, private_dirty_kb);
+}
+
 size_t GetSystemCommitCharge() {
   SystemMemoryInfoKB meminfo;
   if (!GetSystemMemoryInfo(&meminfo))
@@ -511,6 +523,34 @@ scoped_ptr<Value> SystemMemoryInfoKB::ToValue() const {
   return res.PassAs<Value>();
 }
 
+// exposed for testing
+bool ParseProcSmapsPrivateDirty(const std::string& smaps_data,
+                                size_t* private_dirty_kb) {
+  // /proc/<pid>/smaps has a header line for each mapping, followed by lines
+  // of sizes such as:
+  //
+  // Private_Clean:         4 kB
+  // Private_Dirty:      1096 kB
+  *private_dirty_kb = 0;
+  bool found = false;
+
+  std::vector<std::string> smaps_lines;
+  Tokenize(smaps_data, "\n", &smaps_lines);
+  for (std::vector<std::string>::iterator it = smaps_lines.begin();
+       it != smaps_lines.end(); ++it) {
+    if (!StartsWithASCII(*it, "Private_Dirty:", true))
+      continue;
+    std::vector<std::string> tokens;
+    SplitStringAlongWhitespace(*it, &tokens);
+    size_t size_kb = 0;
+    if (tokens.size() != 3 || !StringToSizeT(tokens[1], &size_kb))
+      return false;
+    *private_dirty_kb += size_kb;
+    found = true;
+  }
+  return found;
+}
+
 // exposed for testing
 bool ParseProcMeminfo(const std::string& meminfo_data,
                       SystemMemoryInfoKB* meminfo) {
@@ -168,6 +168,34 @@ TEST_F(SystemMetricsTest, ParseMeminfo) {
   EXPECT_TRUE(meminfo.dirty == 4);
 }
 
+TEST_F(SystemMetricsTest, ParseSmapsPrivateDirty) {
+  size_t private_dirty_kb = 1;
+  EXPECT_FALSE(ParseProcSmapsPrivateDirty("", &private_dirty_kb));
+  EXPECT_FALSE(ParseProcSmapsPrivateDirty("Private_Dirty: abc kB\n",
+                                          &private_dirty_kb));
+
+  std::string valid_input =
+    "00400000-0040b000 r-xp 00000000 08:01 1311264    /bin/cat\n"
+    "Size:                 44 kB\n"
+    "Rss:                  20 kB\n"
+    "Shared_Clean:         20 kB\n"
+    "Shared_Dirty:          0 kB\n"
+    "Private_Clean:         0 kB\n"
+    "Private_Dirty:         0 kB\n"
+    "01f1c000-01f3d000 rw-p 00000000 00:00 0          [heap]\n"
+    "Size:                132 kB\n"
+    "Rss:                 108 kB\n"
+    "Shared_Clean:          0 kB\n"
+    "Shared_Dirty:         96 kB\n"
+    "Private_Clean:         0 kB\n"
+    "Private_Dirty:        12 kB\n"
+    "7fff4c1e4000-7fff4c205000 rw-p 00000000 00:00 0  [stack]\n"
+    "Size:                136 kB\n"
+    "Private_Dirty:         8 kB\n";
+  EXPECT_TRUE(ParseProcSmapsPrivateDirty(valid_input, &private_dirty_kb));
+  EXPECT_EQ(20u, private_dirty_kb);
+}
+
 TEST_F(SystemMetricsTest, ParseVmstat) {
   struct SystemMemoryInfoKB meminfo;
   // part of vmstat from a 3.2 kernel with numa enabled
@@ -14,7 +14,8 @@ namespace tracked_objects {
 
 enum TimeSourceType {
   TIME_SOURCE_TYPE_WALL_TIME,
-  TIME_SOURCE_TYPE_TCMALLOC
+  TIME_SOURCE_TYPE_TCMALLOC,
+  TIME_SOURCE_TYPE_THREAD_TIME
 };
 
 // Provide type for an alternate timer function.
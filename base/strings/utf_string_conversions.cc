@@ -7,11 +7,107 @@
 #include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversion_utils.h"
+#include "build/build_config.h"
+
+#if defined(ARCH_CPU_X86_FAMILY) && (defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define UTF_CONVERSIONS_USE_SSE2
+#include <emmintrin.h>
+#elif defined(ARCH_CPU_ARM_FAMILY) && \
+    (defined(__ARM_NEON__) || defined(__ARM_NEON))
+#define UTF_CONVERSIONS_USE_NEON
+#include <arm_neon.h>
+#endif
 
 namespace base {
 
 namespace {
 
+// ASCII runs ------------------------------------------------------------------
+
+// Number of characters converted at a time by AppendASCIIBlocks().
+const size_t kASCIIBlockSize = 16;
+
+// Appends the blocks of kASCIIBlockSize ASCII characters at the start of
+// |src| to |output| and returns the number of characters appended, which is
+// less than |src_len| if a block holds a non-ASCII character or is too short.
+// There is no fast path for this pair of types, so nothing is appended.
+template<typename SRC_CHAR, typename DEST_STRING>
+size_t AppendASCIIBlocks(const SRC_CHAR* src,
+                         size_t src_len,
+                         DEST_STRING* output) {
+  return 0;
+}
+
+#if defined(UTF_CONVERSIONS_USE_SSE2) || defined(UTF_CONVERSIONS_USE_NEON)
+
+// UTF-8 to UTF-16: widens each byte.
+size_t AppendASCIIBlocks(const char* src, size_t src_len, string16* output) {
+  char16 block[kASCIIBlockSize];
+  size_t i = 0;
+  for (; i + kASCIIBlockSize <= src_len; i += kASCIIBlockSize) {
+#if defined(UTF_CONVERSIONS_USE_SSE2)
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    if (_mm_movemask_epi8(bytes))
+      break;
+    __m128i zero = _mm_setzero_si128();
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(block),
+                     _mm_unpacklo_epi8(bytes, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(block + 8),
+                     _mm_unpackhi_epi8(bytes, zero));
+#else
+    uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8*>(src + i));
+    uint8x8_t high = vorr_u8(vget_low_u8(bytes), vget_high_u8(bytes));
+    if (vget_lane_u64(vreinterpret_u64_u8(high), 0) & 0x8080808080808080ULL)
+      break;
+    vst1q_u16(reinterpret_cast<uint16*>(block),
+              vmovl_u8(vget_low_u8(bytes)));
+    vst1q_u16(reinterpret_cast<uint16*>(block + 8),
+              vmovl_u8(vget_high_u8(bytes)));
+#endif
+    output->append(block, kASCIIBlockSize);
+  }
+  return i;
+}
+
+// UTF-16 to UTF-8: narrows each code unit.
+size_t AppendASCIIBlocks(const char16* src,
+                         size_t src_len,
+                         std::string* output) {
+  char block[kASCIIBlockSize];
+  size_t i = 0;
+  for (; i + kASCIIBlockSize <= src_len; i += kASCIIBlockSize) {
+#if defined(UTF_CONVERSIONS_USE_SSE2)
+    __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i high =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8));
+    __m128i non_ascii = _mm_and_si128(_mm_or_si128(low, high),
+                                      _mm_set1_epi16(-0x80));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi16(non_ascii, _mm_setzero_si128())) !=
+        0xffff) {
+      break;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(block),
+                     _mm_packus_epi16(low, high));
+#else
+    uint16x8_t low = vld1q_u16(reinterpret_cast<const uint16*>(src + i));
+    uint16x8_t high = vld1q_u16(reinterpret_cast<const uint16*>(src + i + 8));
+    uint16x8_t units = vorrq_u16(low, high);
+    uint64x2_t words = vreinterpretq_u64_u16(units);
+    if ((vgetq_lane_u64(words, 0) | vgetq_lane_u64(words, 1)) &
+        0xff80ff80ff80ff80ULL) {
+      break;
+    }
+    vst1_u8(reinterpret_cast<uint8*>(block), vmovn_u16(low));
+    vst1_u8(reinterpret_cast<uint8*>(block + 8), vmovn_u16(high));
+#endif
+    output->append(block, kASCIIBlockSize);
+  }
+  return i;
+}
+
+#endif  // UTF_CONVERSIONS_USE_SSE2 || UTF_CONVERSIONS_USE_NEON
+
 // Generalized Unicode converter -----------------------------------------------
 
 // Converts the given source Unicode character type to the given destination
@@ -25,13 +121,29 @@ bool ConvertUnicode(const SRC_CHAR* src,
   // ICU requires 32-bit numbers.
   bool success = true;
   int32 src_len32 = static_cast<int32>(src_len);
+  // Copy runs of ASCII in bulk, and convert the rest one code point at a
+  // time. After a run ends, look for the next one only once a block's worth
+  // of ASCII characters went through the slow path, so that text with short
+  // runs, like accented Latin or CJK separated by spaces, doesn't pay for
+  // checks that fail.
+  size_t ascii_run = kASCIIBlockSize;
   for (int32 i = 0; i < src_len32; i++) {
+    if (ascii_run >= kASCIIBlockSize) {
+      i += static_cast<int32>(
+          AppendASCIIBlocks(src + i, src_len32 - i, output));
+      if (i == src_len32)
+        break;
+      ascii_run = 0;
+    }
+
     uint32 code_point;
     if (ReadUnicodeCharacter(src, src_len32, &i, &code_point)) {
       WriteUnicodeCharacter(code_point, output);
+      ascii_run = code_point < 0x80 ? ascii_run + 1 : 0;
     } else {
       WriteUnicodeCharacter(0xFFFD, output);
       success = false;
+      ascii_run = 0;
     }
   }
 
@@ -0,0 +1,75 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/strings/string16.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+const int kIterations = 2000;
+const size_t kInputSize = 16 * 1024;
+
+// Repeats |utf8| up to about kInputSize bytes.
+std::string MakeInput(const char* utf8) {
+  std::string input;
+  while (input.size() < kInputSize)
+    input.append(utf8);
+  return input;
+}
+
+void RunTest(const std::string& trace, const std::string& utf8) {
+  string16 utf16 = UTF8ToUTF16(utf8);
+
+  TimeTicks start = TimeTicks::HighResNow();
+  for (int i = 0; i < kIterations; ++i) {
+    string16 output;
+    UTF8ToUTF16(utf8.data(), utf8.size(), &output);
+  }
+  double elapsed_us = (TimeTicks::HighResNow() - start).InMillisecondsF() *
+      1000;
+  perf_test::PrintResult("utf8_to_utf16", "", trace,
+                         utf8.size() * kIterations / elapsed_us, "bytes/us",
+                         true);
+
+  start = TimeTicks::HighResNow();
+  for (int i = 0; i < kIterations; ++i) {
+    std::string output;
+    UTF16ToUTF8(utf16.data(), utf16.size(), &output);
+  }
+  elapsed_us = (TimeTicks::HighResNow() - start).InMillisecondsF() * 1000;
+  perf_test::PrintResult("utf16_to_utf8", "", trace,
+                         utf8.size() * kIterations / elapsed_us, "bytes/us",
+                         true);
+}
+
+}  // namespace
+
+TEST(UTFStringConversionsPerfTest, ASCII) {
+  RunTest("ascii",
+          MakeInput("http://www.example.com/search?q=chromium+base&hl=en "));
+}
+
+TEST(UTFStringConversionsPerfTest, MixedLatin) {
+  // "Très bientôt, l'été à Zürich et à Genève. "
+  RunTest("mixed_latin",
+          MakeInput("Tr\xc3\xa8s bient\xc3\xb4t, l'\xc3\xa9t\xc3\xa9 \xc3\xa0 "
+                    "Z\xc3\xbcrich et \xc3\xa0 Gen\xc3\xa8ve. "));
+}
+
+TEST(UTFStringConversionsPerfTest, CJK) {
+  // "网页 图片 资讯更多 "
+  RunTest("cjk",
+          MakeInput("\xe7\xbd\x91\xe9\xa1\xb5 \xe5\x9b\xbe\xe7\x89\x87 "
+                    "\xe8\xb5\x84\xe8\xae\xaf\xe6\x9b\xb4\xe5\xa4\x9a "));
+}
+
+}  // namespace base
@@ -208,4 +208,40 @@ TEST(UTFStringConversionsTest, ConvertMultiString) {
   EXPECT_EQ(expected, converted);
 }
 
+// Non-ASCII characters at every position of strings long enough to take the
+// bulk ASCII paths.
+TEST(UTFStringConversionsTest, ConvertAroundASCIIRuns) {
+  const struct {
+    const char* utf8;
+    const char16 utf16[3];
+    bool valid;
+  } kCases[] = {
+    {"\xc3\xa9", {0xe9, 0}, true},
+    {"\xe7\xbd\x91", {0x7f51, 0}, true},
+    {"\xf0\x90\x8c\x80", {0xd800, 0xdf00, 0}, true},
+    {"\xff", {0xfffd, 0}, false},
+  };
+  for (size_t i = 0; i < arraysize(kCases); ++i) {
+    for (size_t length = 0; length < 40; ++length) {
+      for (size_t pos = 0; pos <= length; ++pos) {
+        std::string utf8(length, 'a');
+        utf8.insert(pos, kCases[i].utf8);
+        string16 utf16(length, 'a');
+        utf16.insert(pos, kCases[i].utf16);
+
+        string16 converted16;
+        EXPECT_EQ(kCases[i].valid,
+                  UTF8ToUTF16(utf8.data(), utf8.length(), &converted16));
+        EXPECT_EQ(utf16, converted16) << i << " " << length << " " << pos;
+
+        if (!kCases[i].valid)
+          continue;
+        std::string converted8;
+        EXPECT_TRUE(UTF16ToUTF8(utf16.data(), utf16.length(), &converted8));
+        EXPECT_EQ(utf8, converted8) << i << " " << length << " " << pos;
+      }
+    }
+  }
+}
+
 }  // base
@@ -139,6 +139,15 @@ struct is_class
                             sizeof(internal::YesType)> {
 };
 
+// Inherits from true_type if T can be copied with memcpy(), false_type
+// otherwise. GCC, Clang and MSVC all provide the intrinsics this relies on.
+template <typename T>
+struct is_trivially_copyable
+    : integral_constant<bool,
+                        __has_trivial_copy(T) && __has_trivial_assign(T) &&
+                            __has_trivial_destructor(T)> {
+};
+
 template<bool B, class T = void>
 struct enable_if {};
 
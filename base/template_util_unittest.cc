@@ -17,6 +17,14 @@ enum AnEnum {};
 class Parent {};
 class Child : public Parent {};
 
+struct WithDestructor {
+  ~WithDestructor() {}
+};
+struct WithCopyConstructor {
+  WithCopyConstructor() {}
+  WithCopyConstructor(const WithCopyConstructor& other) {}
+};
+
 // is_pointer<Type>
 COMPILE_ASSERT(!is_pointer<int>::value, IsPointer);
 COMPILE_ASSERT(!is_pointer<int&>::value, IsPointer);
@@ -126,5 +134,15 @@ COMPILE_ASSERT(!is_member_function_pointer<
                  int (AStruct::*)(int, int, int, int, int) const>::value,
                IsMemberFunctionPointer);
 
+// is_trivially_copyable<Type>
+COMPILE_ASSERT(is_trivially_copyable<int>::value, IsTriviallyCopyable);
+COMPILE_ASSERT(is_trivially_copyable<int*>::value, IsTriviallyCopyable);
+COMPILE_ASSERT(is_trivially_copyable<AStruct>::value, IsTriviallyCopyable);
+COMPILE_ASSERT(is_trivially_copyable<AnEnum>::value, IsTriviallyCopyable);
+COMPILE_ASSERT(!is_trivially_copyable<WithDestructor>::value,
+               IsTriviallyCopyable);
+COMPILE_ASSERT(!is_trivially_copyable<WithCopyConstructor>::value,
+               IsTriviallyCopyable);
+
 }  // namespace
 }  // namespace base
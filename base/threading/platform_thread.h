@@ -85,6 +85,40 @@ enum ThreadPriority{
   kThreadPriority_Background
 };
 
+// The scheduling policy of a thread, on top of its ThreadPriority.
+enum ThreadSchedulerClass {
+  kThreadSchedulerClass_Default,
+  // Suitable for long-running CPU-bound work which should get a slightly
+  // smaller share of the CPU and fewer preemptions. Linux and Android only.
+  kThreadSchedulerClass_Batch,
+  // Suitable for work that should only run when nothing else wants the CPU
+  // (or, on Windows and Mac, which should also get low I/O priority).
+  kThreadSchedulerClass_Background
+};
+
+// How a thread is scheduled. The defaults leave the thread as the OS creates
+// it.
+struct ThreadSchedulingParams {
+  ThreadSchedulingParams()
+      : priority(kThreadPriority_Normal),
+        scheduler_class(kThreadSchedulerClass_Default),
+        cpu_affinity_mask(0) {
+  }
+
+  ThreadPriority priority;
+
+  ThreadSchedulerClass scheduler_class;
+
+  // Bit N allows the thread to run on CPU N. 0 allows every CPU. Not
+  // supported on Mac.
+  uint64 cpu_affinity_mask;
+
+  // For kThreadPriority_RealtimeAudio, the interval at which the thread
+  // processes a buffer, e.g. 128 frames at 44.1 kHz. Zero picks a default.
+  // Only used by the Mac time-constraint policy.
+  TimeDelta realtime_period;
+};
+
 // A namespace for low-level thread functions.
 class BASE_EXPORT PlatformThread {
  public:
@@ -138,6 +172,13 @@ class BASE_EXPORT PlatformThread {
                                  PlatformThreadHandle* thread_handle,
                                  ThreadPriority priority);
 
+  // CreateWithSchedulingParams() does the same thing as Create() except the
+  // new thread applies |params| to itself before running |delegate|. Failing
+  // to apply them, e.g. for lack of permission, doesn't fail the creation.
+  static bool CreateWithSchedulingParams(size_t stack_size, Delegate* delegate,
+                                         PlatformThreadHandle* thread_handle,
+                                         const ThreadSchedulingParams& params);
+
   // CreateNonJoinable() does the same thing as Create() except the thread
   // cannot be Join()'d.  Therefore, it also does not output a
   // PlatformThreadHandle.
@@ -151,6 +192,11 @@ class BASE_EXPORT PlatformThread {
   static void SetThreadPriority(PlatformThreadHandle handle,
                                 ThreadPriority priority);
 
+  // Applies |params| to the calling thread. Returns false if some of them
+  // are not supported on this platform or could not be applied.
+  static bool SetCurrentThreadSchedulingParams(
+      const ThreadSchedulingParams& params);
+
  private:
   DISALLOW_IMPLICIT_CONSTRUCTORS(PlatformThread);
 };
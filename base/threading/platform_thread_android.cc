@@ -92,6 +92,10 @@ void PlatformThread::SetName(const char* name) {
     DPLOG(ERROR) << "prctl(PR_SET_NAME)";
 }
 
+void SetCurrentThreadPriority(ThreadPriority priority,
+                              TimeDelta realtime_period) {
+  PlatformThread::SetThreadPriority(PlatformThread::CurrentHandle(), priority);
+}
 
 void InitThreading() {
 }
@@ -93,6 +93,11 @@ void PlatformThread::SetThreadPriority(PlatformThreadHandle handle,
 #endif  //  !defined(OS_NACL)
 }
 
+void SetCurrentThreadPriority(ThreadPriority priority,
+                              TimeDelta realtime_period) {
+  PlatformThread::SetThreadPriority(PlatformThread::CurrentHandle(), priority);
+}
+
 void InitThreading() {}
 
 void InitOnThread() {}
@@ -79,8 +79,9 @@ void SetPriorityNormal(mach_port_t mach_thread_id) {
 }
 
 // Enables time-contraint policy and priority suitable for low-latency,
-// glitch-resistant audio.
-void SetPriorityRealtimeAudio(mach_port_t mach_thread_id) {
+// glitch-resistant audio. |period| is the audio buffer duration, or zero for
+// the default.
+void SetPriorityRealtimeAudio(mach_port_t mach_thread_id, TimeDelta period) {
   kern_return_t result;
 
   // Increase thread priority to real-time.
@@ -127,8 +128,9 @@ void SetPriorityRealtimeAudio(mach_port_t mach_thread_id) {
   // Define constants determining how much time the audio thread can
   // use in a given time quantum.  All times are in milliseconds.
 
-  // About 128 frames @44.1KHz
-  const double kTimeQuantum = 2.9;
+  // About 128 frames @44.1KHz, unless the caller knows better.
+  const double kTimeQuantum =
+      period > TimeDelta() ? period.InMillisecondsF() : 2.9;
 
   // Time guaranteed each quantum.
   const double kAudioTimeNeeded = kGuaranteedAudioDutyCycle * kTimeQuantum;
@@ -168,11 +170,15 @@ void PlatformThread::SetThreadPriority(PlatformThreadHandle handle,
   mach_port_t mach_thread_id = pthread_mach_thread_np(handle.handle_);
 
   switch (priority) {
+    // The standard policy has no finer levels for display and background
+    // threads; use kThreadSchedulerClass_Background to deprioritize one.
     case kThreadPriority_Normal:
+    case kThreadPriority_Display:
+    case kThreadPriority_Background:
       SetPriorityNormal(mach_thread_id);
       break;
     case kThreadPriority_RealtimeAudio:
-      SetPriorityRealtimeAudio(mach_thread_id);
+      SetPriorityRealtimeAudio(mach_thread_id, TimeDelta());
       break;
     default:
       NOTREACHED() << "Unknown priority.";
@@ -180,6 +186,17 @@ void PlatformThread::SetThreadPriority(PlatformThreadHandle handle,
   }
 }
 
+void SetCurrentThreadPriority(ThreadPriority priority,
+                              TimeDelta realtime_period) {
+  mach_port_t mach_thread_id = pthread_mach_thread_np(pthread_self());
+  if (priority == kThreadPriority_RealtimeAudio) {
+    SetPriorityRealtimeAudio(mach_thread_id, realtime_period);
+  } else {
+    PlatformThread::SetThreadPriority(PlatformThread::CurrentHandle(),
+                                      priority);
+  }
+}
+
 size_t GetDefaultThreadStackSize(const pthread_attr_t& attributes) {
 #if defined(OS_IOS)
   return 0;
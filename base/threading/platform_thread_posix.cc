@@ -35,6 +35,8 @@ void InitThreading();
 void InitOnThread();
 void TerminateOnThread();
 size_t GetDefaultThreadStackSize(const pthread_attr_t& attributes);
+void SetCurrentThreadPriority(ThreadPriority priority,
+                              TimeDelta realtime_period);
 
 namespace {
 
@@ -42,14 +44,13 @@ struct ThreadParams {
   ThreadParams()
       : delegate(NULL),
         joinable(false),
-        priority(kThreadPriority_Normal),
         handle(NULL),
         handle_set(false, false) {
   }
 
   PlatformThread::Delegate* delegate;
   bool joinable;
-  ThreadPriority priority;
+  ThreadSchedulingParams scheduling;
   PlatformThreadHandle* handle;
   WaitableEvent handle_set;
 };
@@ -62,10 +63,7 @@ void* ThreadFunc(void* params) {
   if (!thread_params->joinable)
     base::ThreadRestrictions::SetSingletonAllowed(false);
 
-  if (thread_params->priority != kThreadPriority_Normal) {
-    PlatformThread::SetThreadPriority(PlatformThread::CurrentHandle(),
-                                      thread_params->priority);
-  }
+  PlatformThread::SetCurrentThreadSchedulingParams(thread_params->scheduling);
 
   // Stash the id in the handle so the calling thread has a complete
   // handle, and unblock the parent thread.
@@ -90,7 +88,7 @@ void* ThreadFunc(void* params) {
 bool CreateThread(size_t stack_size, bool joinable,
                   PlatformThread::Delegate* delegate,
                   PlatformThreadHandle* thread_handle,
-                  ThreadPriority priority) {
+                  const ThreadSchedulingParams& scheduling) {
   base::InitThreading();
 
   bool success = false;
@@ -113,7 +111,7 @@ bool CreateThread(size_t stack_size, bool joinable,
   ThreadParams params;
   params.delegate = delegate;
   params.joinable = joinable;
-  params.priority = priority;
+  params.scheduling = scheduling;
   params.handle = thread_handle;
 
   pthread_t handle = 0;
@@ -138,6 +136,58 @@ bool CreateThread(size_t stack_size, bool joinable,
   return success;
 }
 
+bool SetCurrentThreadSchedulerClass(ThreadSchedulerClass scheduler_class) {
+  if (scheduler_class == kThreadSchedulerClass_Default)
+    return true;
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  // Unlike raising the priority, an unprivileged thread may always switch to
+  // these policies.
+  const struct sched_param kParam = { 0 };
+  int policy = scheduler_class == kThreadSchedulerClass_Batch ? SCHED_BATCH :
+                                                                SCHED_IDLE;
+  int err = pthread_setschedparam(pthread_self(), policy, &kParam);
+  if (err) {
+    errno = err;
+    DPLOG(ERROR) << "pthread_setschedparam";
+    return false;
+  }
+  return true;
+#elif defined(OS_MACOSX) && defined(PRIO_DARWIN_THREAD)
+  // Darwin background threads get both low CPU and low I/O priority.
+  if (scheduler_class != kThreadSchedulerClass_Background)
+    return false;
+  if (setpriority(PRIO_DARWIN_THREAD, 0, PRIO_DARWIN_BG)) {
+    DPLOG(ERROR) << "setpriority(PRIO_DARWIN_BG)";
+    return false;
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool SetCurrentThreadAffinity(uint64 cpu_affinity_mask) {
+  if (!cpu_affinity_mask)
+    return true;
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  for (int cpu = 0; cpu < 64 && cpu < CPU_SETSIZE; ++cpu) {
+    if (cpu_affinity_mask & (GG_UINT64_C(1) << cpu))
+      CPU_SET(cpu, &cpus);
+  }
+  // A pid of 0 is the calling thread, not the whole process.
+  if (sched_setaffinity(0, sizeof(cpus), &cpus)) {
+    DPLOG(ERROR) << "sched_setaffinity";
+    return false;
+  }
+  return true;
+#else
+  // Mac only offers affinity tags, which group threads rather than pin them.
+  return false;
+#endif
+}
+
 }  // namespace
 
 // static
@@ -197,16 +247,28 @@ bool PlatformThread::Create(size_t stack_size, Delegate* delegate,
                             PlatformThreadHandle* thread_handle) {
   base::ThreadRestrictions::ScopedAllowWait allow_wait;
   return CreateThread(stack_size, true /* joinable thread */,
-                      delegate, thread_handle, kThreadPriority_Normal);
+                      delegate, thread_handle, ThreadSchedulingParams());
 }
 
 // static
 bool PlatformThread::CreateWithPriority(size_t stack_size, Delegate* delegate,
                                         PlatformThreadHandle* thread_handle,
                                         ThreadPriority priority) {
+  ThreadSchedulingParams params;
+  params.priority = priority;
+  return CreateWithSchedulingParams(stack_size, delegate, thread_handle,
+                                    params);
+}
+
+// static
+bool PlatformThread::CreateWithSchedulingParams(
+    size_t stack_size,
+    Delegate* delegate,
+    PlatformThreadHandle* thread_handle,
+    const ThreadSchedulingParams& params) {
   base::ThreadRestrictions::ScopedAllowWait allow_wait;
   return CreateThread(stack_size, true,  // joinable thread
-                      delegate, thread_handle, priority);
+                      delegate, thread_handle, params);
 }
 
 // static
@@ -215,10 +277,25 @@ bool PlatformThread::CreateNonJoinable(size_t stack_size, Delegate* delegate) {
 
   base::ThreadRestrictions::ScopedAllowWait allow_wait;
   bool result = CreateThread(stack_size, false /* non-joinable thread */,
-                             delegate, &unused, kThreadPriority_Normal);
+                             delegate, &unused, ThreadSchedulingParams());
   return result;
 }
 
+// static
+bool PlatformThread::SetCurrentThreadSchedulingParams(
+    const ThreadSchedulingParams& params) {
+  // The realtime policies don't combine with another scheduler class.
+  DCHECK(params.priority != kThreadPriority_RealtimeAudio ||
+         params.scheduler_class == kThreadSchedulerClass_Default);
+
+  bool success = SetCurrentThreadSchedulerClass(params.scheduler_class);
+  if (!SetCurrentThreadAffinity(params.cpu_affinity_mask))
+    success = false;
+  if (params.priority != kThreadPriority_Normal)
+    SetCurrentThreadPriority(params.priority, params.realtime_period);
+  return success;
+}
+
 // static
 void PlatformThread::Join(PlatformThreadHandle thread_handle) {
   // Joining another thread may block the current thread for a long time, since
@@ -7,6 +7,10 @@
 
 #include "testing/gtest/include/gtest/gtest.h"
 
+#if defined(OS_LINUX)
+#include <sched.h>
+#endif
+
 namespace base {
 
 // Trivial tests that thread runs and doesn't crash on create and join ---------
@@ -118,4 +122,62 @@ TEST(PlatformThreadTest, FunctionTimesTen) {
   EXPECT_EQ(main_thread_id, PlatformThread::CurrentId());
 }
 
+// Tests of scheduling parameters ----------------------------------------------
+
+#if defined(OS_LINUX)
+
+class SchedulingTestThread : public PlatformThread::Delegate {
+ public:
+  SchedulingTestThread() : policy_(-1), allowed_cpus_(-1) {}
+
+  virtual void ThreadMain() OVERRIDE {
+    policy_ = sched_getscheduler(0);
+    cpu_set_t cpus;
+    if (sched_getaffinity(0, sizeof(cpus), &cpus) == 0)
+      allowed_cpus_ = CPU_COUNT(&cpus);
+  }
+
+  int policy() const { return policy_; }
+  int allowed_cpus() const { return allowed_cpus_; }
+
+ private:
+  int policy_;
+  int allowed_cpus_;
+
+  DISALLOW_COPY_AND_ASSIGN(SchedulingTestThread);
+};
+
+TEST(PlatformThreadTest, SchedulingParams) {
+  SchedulingTestThread thread;
+  PlatformThreadHandle handle;
+  ThreadSchedulingParams params;
+  params.scheduler_class = kThreadSchedulerClass_Batch;
+  params.cpu_affinity_mask = 1;
+  ASSERT_TRUE(PlatformThread::CreateWithSchedulingParams(0, &thread, &handle,
+                                                         params));
+  PlatformThread::Join(handle);
+  EXPECT_EQ(SCHED_BATCH, thread.policy());
+  EXPECT_EQ(1, thread.allowed_cpus());
+
+  // The defaults leave the new thread alone.
+  SchedulingTestThread default_thread;
+  ASSERT_TRUE(PlatformThread::CreateWithSchedulingParams(
+      0, &default_thread, &handle, ThreadSchedulingParams()));
+  PlatformThread::Join(handle);
+  EXPECT_EQ(sched_getscheduler(0), default_thread.policy());
+}
+
+TEST(PlatformThreadTest, BackgroundSchedulerClass) {
+  SchedulingTestThread thread;
+  PlatformThreadHandle handle;
+  ThreadSchedulingParams params;
+  params.scheduler_class = kThreadSchedulerClass_Background;
+  ASSERT_TRUE(PlatformThread::CreateWithSchedulingParams(0, &thread, &handle,
+                                                         params));
+  PlatformThread::Join(handle);
+  EXPECT_EQ(SCHED_IDLE, thread.policy());
+}
+
+#endif  // defined(OS_LINUX)
+
 }  // namespace base
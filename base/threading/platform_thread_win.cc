@@ -46,6 +46,7 @@ void SetNameInternal(PlatformThreadId thread_id, const char* name) {
 struct ThreadParams {
   PlatformThread::Delegate* delegate;
   bool joinable;
+  ThreadSchedulingParams scheduling;
 };
 
 DWORD __stdcall ThreadFunc(void* params) {
@@ -54,6 +55,9 @@ DWORD __stdcall ThreadFunc(void* params) {
   if (!thread_params->joinable)
     base::ThreadRestrictions::SetSingletonAllowed(false);
 
+  // Background mode can only be entered by the thread itself.
+  PlatformThread::SetCurrentThreadSchedulingParams(thread_params->scheduling);
+
   // Retrieve a copy of the thread handle to use as the key in the
   // thread name mapping.
   PlatformThreadHandle::Handle platform_handle;
@@ -86,12 +90,13 @@ DWORD __stdcall ThreadFunc(void* params) {
   return NULL;
 }
 
-// CreateThreadInternal() matches PlatformThread::Create(), except that
-// |out_thread_handle| may be NULL, in which case a non-joinable thread is
-// created.
+// CreateThreadInternal() matches PlatformThread::CreateWithSchedulingParams(),
+// except that |out_thread_handle| may be NULL, in which case a non-joinable
+// thread is created.
 bool CreateThreadInternal(size_t stack_size,
                           PlatformThread::Delegate* delegate,
-                          PlatformThreadHandle* out_thread_handle) {
+                          PlatformThreadHandle* out_thread_handle,
+                          const ThreadSchedulingParams& scheduling) {
   unsigned int flags = 0;
   if (stack_size > 0 && base::win::GetVersion() >= base::win::VERSION_XP) {
     flags = STACK_SIZE_PARAM_IS_A_RESERVATION;
@@ -102,6 +107,7 @@ bool CreateThreadInternal(size_t stack_size,
   ThreadParams* params = new ThreadParams;
   params->delegate = delegate;
   params->joinable = out_thread_handle != NULL;
+  params->scheduling = scheduling;
 
   // Using CreateThread here vs _beginthreadex makes thread creation a bit
   // faster and doesn't require the loader lock to be available.  Our code will
@@ -182,22 +188,34 @@ const char* PlatformThread::GetName() {
 bool PlatformThread::Create(size_t stack_size, Delegate* delegate,
                             PlatformThreadHandle* thread_handle) {
   DCHECK(thread_handle);
-  return CreateThreadInternal(stack_size, delegate, thread_handle);
+  return CreateThreadInternal(stack_size, delegate, thread_handle,
+                              ThreadSchedulingParams());
 }
 
 // static
 bool PlatformThread::CreateWithPriority(size_t stack_size, Delegate* delegate,
                                         PlatformThreadHandle* thread_handle,
                                         ThreadPriority priority) {
-  bool result = Create(stack_size, delegate, thread_handle);
-  if (result)
-    SetThreadPriority(*thread_handle, priority);
-  return result;
+  ThreadSchedulingParams params;
+  params.priority = priority;
+  return CreateWithSchedulingParams(stack_size, delegate, thread_handle,
+                                    params);
+}
+
+// static
+bool PlatformThread::CreateWithSchedulingParams(
+    size_t stack_size,
+    Delegate* delegate,
+    PlatformThreadHandle* thread_handle,
+    const ThreadSchedulingParams& params) {
+  DCHECK(thread_handle);
+  return CreateThreadInternal(stack_size, delegate, thread_handle, params);
 }
 
 // static
 bool PlatformThread::CreateNonJoinable(size_t stack_size, Delegate* delegate) {
-  return CreateThreadInternal(stack_size, delegate, NULL);
+  return CreateThreadInternal(stack_size, delegate, NULL,
+                              ThreadSchedulingParams());
 }
 
 // static
@@ -237,10 +255,49 @@ void PlatformThread::SetThreadPriority(PlatformThreadHandle handle,
     case kThreadPriority_RealtimeAudio:
       ::SetThreadPriority(handle.handle_, THREAD_PRIORITY_TIME_CRITICAL);
       break;
+    case kThreadPriority_Display:
+      ::SetThreadPriority(handle.handle_, THREAD_PRIORITY_ABOVE_NORMAL);
+      break;
+    case kThreadPriority_Background:
+      ::SetThreadPriority(handle.handle_, THREAD_PRIORITY_LOWEST);
+      break;
     default:
       NOTREACHED() << "Unknown priority.";
       break;
   }
 }
 
+// static
+bool PlatformThread::SetCurrentThreadSchedulingParams(
+    const ThreadSchedulingParams& params) {
+  bool success = true;
+  HANDLE thread = ::GetCurrentThread();
+
+  if (params.priority != kThreadPriority_Normal)
+    SetThreadPriority(PlatformThreadHandle(thread), params.priority);
+
+  switch (params.scheduler_class) {
+    case kThreadSchedulerClass_Default:
+      break;
+    case kThreadSchedulerClass_Background:
+      // Lowers the I/O and memory priority as well as the CPU priority.
+      if (base::win::GetVersion() < base::win::VERSION_VISTA ||
+          !::SetThreadPriority(thread, THREAD_MODE_BACKGROUND_BEGIN)) {
+        success = false;
+      }
+      break;
+    default:
+      success = false;
+      break;
+  }
+
+  if (params.cpu_affinity_mask &&
+      !::SetThreadAffinityMask(
+          thread, static_cast<DWORD_PTR>(params.cpu_affinity_mask))) {
+    DPLOG(ERROR) << "SetThreadAffinityMask";
+    success = false;
+  }
+  return success;
+}
+
 }  // namespace base
@@ -4,6 +4,7 @@
 
 #include "base/threading/sequenced_worker_pool.h"
 
+#include <deque>
 #include <list>
 #include <map>
 #include <set>
@@ -11,6 +12,7 @@
 #include <vector>
 
 #include "base/atomic_sequence_num.h"
+#include "base/atomicops.h"
 #include "base/callback.h"
 #include "base/compiler_specific.h"
 #include "base/critical_closure.h"
@@ -18,7 +20,9 @@
 #include "base/lazy_instance.h"
 #include "base/logging.h"
 #include "base/memory/linked_ptr.h"
+#include "base/memory/scoped_vector.h"
 #include "base/message_loop/message_loop_proxy.h"
+#include "base/profiler/scoped_profile.h"
 #include "base/stl_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/synchronization/condition_variable.h"
@@ -238,6 +242,9 @@ class SequencedWorkerPool::Worker : public SimpleThread {
   // SimpleThread implementation. This actually runs the background thread.
   virtual void Run() OVERRIDE;
 
+  // Returns the 1-based number of this worker.
+  int thread_number() const { return thread_number_; }
+
   void set_running_task_info(SequenceToken token,
                              WorkerShutdown shutdown_behavior) {
     running_sequence_ = token;
@@ -254,6 +261,7 @@ class SequencedWorkerPool::Worker : public SimpleThread {
 
  private:
   scoped_refptr<SequencedWorkerPool> worker_pool_;
+  const int thread_number_;
   SequenceToken running_sequence_;
   WorkerShutdown running_shutdown_behavior_;
 
@@ -268,6 +276,7 @@ class SequencedWorkerPool::Inner {
   // by it).
   Inner(SequencedWorkerPool* worker_pool, size_t max_threads,
         const std::string& thread_name_prefix,
+        SchedulingMode scheduling_mode,
         TestingObserver* observer);
 
   ~Inner();
@@ -318,6 +327,14 @@ class SequencedWorkerPool::Inner {
     CLEANUP_DONE,
   };
 
+  // A queue of unsequenced, non-delayed tasks owned by one worker in
+  // WORK_STEALING mode. The owner takes tasks from the front; other workers
+  // steal from the back.
+  struct StealableQueue {
+    Lock lock;
+    std::deque<SequencedTask> tasks;
+  };
+
   // Called from within the lock, this converts the given token name into a
   // token ID, creating a new one if necessary.
   int LockedGetNamedTokenID(const std::string& name);
@@ -385,6 +402,39 @@ class SequencedWorkerPool::Inner {
   // Signal |has_work_| and increment |has_work_signal_count_|.
   void SignalHasWork();
 
+  // WORK_STEALING mode only. Queues |task| on one of the stealable queues
+  // without taking |lock_|. Returns false if shutdown has started, in which
+  // case the caller must fall back to the regular locked posting path so
+  // that the shutdown rules are applied.
+  bool PostStealableTask(SequencedTask* task);
+
+  // Returns true if any stealable queue may have a task in it. Can be called
+  // with or without |lock_| held.
+  bool HasStealableWork() const;
+
+  // Takes a task from the stealable queue at |queue_index|, or steals one
+  // from another worker's queue if that one is empty. Returns false if no
+  // stealable task was found. Must be called without |lock_| held. If the
+  // returned task doesn't have CONTINUE_ON_SHUTDOWN behavior it is counted
+  // as running until DidRunStealableTask() is called.
+  bool TakeStealableTask(size_t queue_index, SequencedTask* task);
+
+  // Pops one task off the stealable queue at |queue_index|, from the front
+  // if |from_front| and from the back otherwise. Updates the stealable task
+  // counts accordingly.
+  bool TakeFromStealableQueue(size_t queue_index,
+                              bool from_front,
+                              SequencedTask* task);
+
+  // Runs (or, if shutdown has started and they don't block shutdown,
+  // deletes) stealable tasks until all stealable queues are empty. Must be
+  // called without |lock_| held.
+  void RunStealableTasks(Worker* this_worker);
+
+  // Counterpart of TakeStealableTask(), called once |task| has been run or
+  // deleted. Must be called without |lock_| held.
+  void DidRunStealableTask(const SequencedTask& task);
+
   // Checks whether there is work left that's blocking shutdown. Must be
   // called inside the lock.
   bool CanShutdown() const;
@@ -454,7 +504,9 @@ class SequencedWorkerPool::Inner {
   std::set<int> current_sequences_;
 
   // An ID for each posted task to distinguish the task from others in traces.
-  int trace_id_;
+  // Atomically incremented, so that stealable tasks can be posted without
+  // |lock_|.
+  subtle::Atomic32 trace_id_;
 
   // Set when Shutdown is called and no further tasks should be
   // allowed, though we may still be running existing tasks.
@@ -471,6 +523,37 @@ class SequencedWorkerPool::Inner {
 
   TestingObserver* const testing_observer_;
 
+  // WORK_STEALING mode state. |stealable_queues_| has one queue per possible
+  // worker and is not modified after construction; each queue is protected
+  // by its own lock. The counters below are accessed atomically, without
+  // |lock_|.
+  const bool work_stealing_;
+  ScopedVector<StealableQueue> stealable_queues_;
+
+  // Mirrors |shutdown_called_| for readers that don't hold |lock_|.
+  subtle::Atomic32 shutdown_flag_;
+
+  // Mirrors |waiting_thread_count_|, so that posters of stealable tasks only
+  // need to take |lock_| to wake up a worker if one may be waiting.
+  subtle::Atomic32 atomic_waiting_thread_count_;
+
+  // Set once |max_threads_| workers have been created, after which posters
+  // of stealable tasks no longer need |lock_| to start additional threads.
+  subtle::Atomic32 all_threads_created_;
+
+  // Round-robin counter used to pick the stealable queue for a new task.
+  subtle::Atomic32 next_stealable_queue_;
+
+  // Number of tasks in all stealable queues.
+  subtle::Atomic32 stealable_task_count_;
+
+  // Number of BLOCK_SHUTDOWN tasks in all stealable queues.
+  subtle::Atomic32 stealable_blocking_shutdown_pending_count_;
+
+  // Number of workers currently running stealable tasks that have the
+  // BLOCK_SHUTDOWN or SKIP_ON_SHUTDOWN flag set.
+  subtle::Atomic32 stealable_blocking_shutdown_running_count_;
+
   DISALLOW_COPY_AND_ASSIGN(Inner);
 };
 
@@ -483,6 +566,7 @@ SequencedWorkerPool::Worker::Worker(
     : SimpleThread(
           prefix + StringPrintf("Worker%d", thread_number).c_str()),
       worker_pool_(worker_pool),
+      thread_number_(thread_number),
       running_shutdown_behavior_(CONTINUE_ON_SHUTDOWN) {
   Start();
 }
@@ -511,6 +595,7 @@ SequencedWorkerPool::Inner::Inner(
     SequencedWorkerPool* worker_pool,
     size_t max_threads,
     const std::string& thread_name_prefix,
+    SchedulingMode scheduling_mode,
     TestingObserver* observer)
     : worker_pool_(worker_pool),
       lock_(),
@@ -529,7 +614,20 @@ SequencedWorkerPool::Inner::Inner(
       cleanup_state_(CLEANUP_DONE),
       cleanup_idlers_(0),
       cleanup_cv_(&lock_),
-      testing_observer_(observer) {}
+      testing_observer_(observer),
+      work_stealing_(scheduling_mode == WORK_STEALING),
+      shutdown_flag_(0),
+      atomic_waiting_thread_count_(0),
+      all_threads_created_(0),
+      next_stealable_queue_(0),
+      stealable_task_count_(0),
+      stealable_blocking_shutdown_pending_count_(0),
+      stealable_blocking_shutdown_running_count_(0) {
+  if (work_stealing_) {
+    for (size_t i = 0; i < max_threads_; ++i)
+      stealable_queues_.push_back(new StealableQueue);
+  }
+}
 
 SequencedWorkerPool::Inner::~Inner() {
   // You must call Shutdown() before destroying the pool.
@@ -575,9 +673,19 @@ bool SequencedWorkerPool::Inner::PostTask(
       base::MakeCriticalClosure(task) : task;
   sequenced.time_to_run = TimeTicks::Now() + delay;
 
+  // Unsequenced tasks without a delay don't need the ordering provided by
+  // |pending_tasks_|, so in WORK_STEALING mode they bypass |lock_|.
+  if (work_stealing_ && !optional_token_name && !sequence_token.IsValid() &&
+      delay == TimeDelta() && PostStealableTask(&sequenced)) {
+    return true;
+  }
+
   int create_thread_id = 0;
   {
     AutoLock lock(lock_);
+    tracked_objects::ScopedProfile lock_held_profile(
+        FROM_HERE_WITH_EXPLICIT_FUNCTION(
+            "SequencedWorkerPool::LockHeldForPostTask"));
     if (shutdown_called_) {
       if (shutdown_behavior != BLOCK_SHUTDOWN ||
           LockedCurrentThreadShutdownBehavior() == CONTINUE_ON_SHUTDOWN) {
@@ -591,7 +699,7 @@ bool SequencedWorkerPool::Inner::PostTask(
     }
 
     // The trace_id is used for identifying the task in about:tracing.
-    sequenced.trace_id = trace_id_++;
+    sequenced.trace_id = subtle::NoBarrier_AtomicIncrement(&trace_id_, 1) - 1;
 
     TRACE_EVENT_FLOW_BEGIN0(TRACE_DISABLED_BY_DEFAULT("toplevel.flow"),
         "SequencedWorkerPool::PostTask",
@@ -642,7 +750,8 @@ void SequencedWorkerPool::Inner::CleanupForTesting() {
   CHECK_EQ(CLEANUP_DONE, cleanup_state_);
   if (shutdown_called_)
     return;
-  if (pending_tasks_.empty() && waiting_thread_count_ == threads_.size())
+  if (pending_tasks_.empty() && !HasStealableWork() &&
+      waiting_thread_count_ == threads_.size())
     return;
   cleanup_state_ = CLEANUP_REQUESTED;
   cleanup_idlers_ = 0;
@@ -667,6 +776,21 @@ void SequencedWorkerPool::Inner::Shutdown(
     shutdown_called_ = true;
     max_blocking_tasks_after_shutdown_ = max_new_blocking_tasks_after_shutdown;
 
+    if (work_stealing_) {
+      // The barrier pairs with the ones in TakeFromStealableQueue() and
+      // DidRunStealableTask() so that either CanShutdown() below sees a
+      // stealable task as running, or its worker sees |shutdown_flag_| (and
+      // deletes the task or signals |can_shutdown_cv_|).
+      subtle::NoBarrier_Store(&shutdown_flag_, 1);
+      subtle::MemoryBarrier();
+
+      // Posters check |shutdown_flag_| with their queue's lock held, so once
+      // every queue lock has been cycled, any stealable task posted before
+      // shutdown is reflected in the counts that CanShutdown() looks at.
+      for (size_t i = 0; i < stealable_queues_.size(); ++i)
+        AutoLock queue_lock(stealable_queues_[i]->lock);
+    }
+
     // Tickle the threads. This will wake up a waiting one so it will know that
     // it can exit, which in turn will wake up any other waiting ones.
     SignalHasWork();
@@ -712,6 +836,8 @@ void SequencedWorkerPool::Inner::ThreadLoop(Worker* this_worker) {
         threads_.insert(
             std::make_pair(this_worker->tid(), make_linked_ptr(this_worker)));
     DCHECK(result.second);
+    if (threads_.size() == max_threads_)
+      subtle::Release_Store(&all_threads_created_, 1);
 
     while (true) {
 #if defined(OS_MACOSX)
@@ -720,6 +846,16 @@ void SequencedWorkerPool::Inner::ThreadLoop(Worker* this_worker) {
 
       HandleCleanup();
 
+      // Stealable tasks are run without |lock_|. Go back to the top of the
+      // loop afterwards since the cleanup state may have changed meanwhile.
+      if (HasStealableWork()) {
+        {
+          AutoUnlock unlock(lock_);
+          RunStealableTasks(this_worker);
+        }
+        continue;
+      }
+
       // See GetWork for what delete_these_outside_lock is doing.
       SequencedTask task;
       TimeDelta wait_time;
@@ -756,7 +892,8 @@ void SequencedWorkerPool::Inner::ThreadLoop(Worker* this_worker) {
           task.task.Run();
 
           tracked_objects::ThreadData::TallyRunOnNamedThreadIfTracking(task,
-              start_time, tracked_objects::ThreadData::NowForEndOfRun());
+              start_time,
+              tracked_objects::ThreadData::NowForEndOfRun(start_time));
 
           // Make sure our task is erased outside the lock for the
           // same reason we do this with delete_these_oustide_lock.
@@ -778,6 +915,9 @@ void SequencedWorkerPool::Inner::ThreadLoop(Worker* this_worker) {
             break;
           case GET_WORK_NOT_FOUND:
             CHECK(delete_these_outside_lock.empty());
+            // Stealable tasks are picked up at the top of the loop.
+            if (HasStealableWork())
+              break;
             cleanup_state_ = CLEANUP_FINISHING;
             cleanup_cv_.Broadcast();
             break;
@@ -794,20 +934,31 @@ void SequencedWorkerPool::Inner::ThreadLoop(Worker* this_worker) {
         // ones with the same sequence token, but additional threads won't
         // help this case.
         if (shutdown_called_ &&
-            blocking_shutdown_pending_task_count_ == 0)
+            blocking_shutdown_pending_task_count_ == 0 &&
+            subtle::Acquire_Load(
+                &stealable_blocking_shutdown_pending_count_) == 0)
           break;
         waiting_thread_count_++;
 
-        switch (status) {
-          case GET_WORK_NOT_FOUND:
-            has_work_cv_.Wait();
-            break;
-          case GET_WORK_WAIT:
-            has_work_cv_.TimedWait(wait_time);
-            break;
-          default:
-            NOTREACHED();
+        // Posters of stealable tasks only take |lock_| to signal if they see
+        // a waiting worker, so publish that we're about to wait and then
+        // check the stealable queues once more before doing so.
+        if (work_stealing_)
+          subtle::Barrier_AtomicIncrement(&atomic_waiting_thread_count_, 1);
+        if (!HasStealableWork()) {
+          switch (status) {
+            case GET_WORK_NOT_FOUND:
+              has_work_cv_.Wait();
+              break;
+            case GET_WORK_WAIT:
+              has_work_cv_.TimedWait(wait_time);
+              break;
+            default:
+              NOTREACHED();
+          }
         }
+        if (work_stealing_)
+          subtle::NoBarrier_AtomicIncrement(&atomic_waiting_thread_count_, -1);
         waiting_thread_count_--;
       }
     }
@@ -897,6 +1048,9 @@ SequencedWorkerPool::Inner::GetWorkStatus SequencedWorkerPool::Inner::GetWork(
     TimeDelta* wait_time,
     std::vector<Closure>* delete_these_outside_lock) {
   lock_.AssertAcquired();
+  tracked_objects::ScopedProfile lock_held_profile(
+      FROM_HERE_WITH_EXPLICIT_FUNCTION(
+          "SequencedWorkerPool::LockHeldForGetWork"));
 
 #if !defined(OS_NACL)
   UMA_HISTOGRAM_COUNTS_100("SequencedWorkerPool.TaskCount",
@@ -1081,6 +1235,10 @@ int SequencedWorkerPool::Inner::PrepareToStartAdditionalThreadIfHelpful() {
       threads_.size() < max_threads_ &&
       waiting_thread_count_ == 0) {
     // We could use an additional thread if there's work to be done.
+    if (HasStealableWork()) {
+      thread_being_created_ = true;
+      return static_cast<int>(threads_.size() + 1);
+    }
     for (PendingTaskSet::const_iterator i = pending_tasks_.begin();
          i != pending_tasks_.end(); ++i) {
       if (IsSequenceTokenRunnable(i->sequence_token_id)) {
@@ -1113,9 +1271,191 @@ void SequencedWorkerPool::Inner::SignalHasWork() {
 bool SequencedWorkerPool::Inner::CanShutdown() const {
   lock_.AssertAcquired();
   // See PrepareToStartAdditionalThreadIfHelpful for how thread creation works.
+  // The pending count must be read before the running count: a worker
+  // taking a stealable BLOCK_SHUTDOWN task counts it as running before it
+  // stops counting it as pending.
   return !thread_being_created_ &&
          blocking_shutdown_thread_count_ == 0 &&
-         blocking_shutdown_pending_task_count_ == 0;
+         blocking_shutdown_pending_task_count_ == 0 &&
+         subtle::Acquire_Load(
+             &stealable_blocking_shutdown_pending_count_) == 0 &&
+         subtle::Acquire_Load(
+             &stealable_blocking_shutdown_running_count_) == 0;
+}
+
+bool SequencedWorkerPool::Inner::PostStealableTask(SequencedTask* task) {
+  DCHECK(work_stealing_);
+  const size_t queue_index =
+      static_cast<uint32>(
+          subtle::NoBarrier_AtomicIncrement(&next_stealable_queue_, 1)) %
+      stealable_queues_.size();
+  StealableQueue* queue = stealable_queues_[queue_index];
+  {
+    AutoLock queue_lock(queue->lock);
+    // See Shutdown() for why this is checked with the queue lock held.
+    if (subtle::NoBarrier_Load(&shutdown_flag_))
+      return false;
+
+    task->trace_id = subtle::NoBarrier_AtomicIncrement(&trace_id_, 1) - 1;
+    TRACE_EVENT_FLOW_BEGIN0(TRACE_DISABLED_BY_DEFAULT("toplevel.flow"),
+        "SequencedWorkerPool::PostTask",
+        TRACE_ID_MANGLE(GetTaskTraceID(*task, static_cast<void*>(this))));
+
+    queue->tasks.push_back(*task);
+    if (task->shutdown_behavior == BLOCK_SHUTDOWN) {
+      subtle::NoBarrier_AtomicIncrement(
+          &stealable_blocking_shutdown_pending_count_, 1);
+    }
+    // The barrier pairs with the one in ThreadLoop() so that either the
+    // waiting worker sees this task, or we see the waiting worker below.
+    subtle::Barrier_AtomicIncrement(&stealable_task_count_, 1);
+  }
+
+  // Busy workers will get to the task on their own. Only take |lock_| if a
+  // worker may be waiting or another worker may need to be started.
+  if (subtle::Acquire_Load(&atomic_waiting_thread_count_) == 0 &&
+      subtle::Acquire_Load(&all_threads_created_)) {
+    return true;
+  }
+
+  int create_thread_id = 0;
+  {
+    AutoLock lock(lock_);
+    create_thread_id = PrepareToStartAdditionalThreadIfHelpful();
+  }
+  if (create_thread_id)
+    FinishStartingAdditionalThread(create_thread_id);
+  else
+    SignalHasWork();
+  return true;
+}
+
+bool SequencedWorkerPool::Inner::HasStealableWork() const {
+  return work_stealing_ && subtle::Acquire_Load(&stealable_task_count_) > 0;
+}
+
+bool SequencedWorkerPool::Inner::TakeStealableTask(size_t queue_index,
+                                                   SequencedTask* task) {
+  DCHECK(work_stealing_);
+  if (!HasStealableWork())
+    return false;
+
+  if (TakeFromStealableQueue(queue_index, true, task))
+    return true;
+
+  const tracked_objects::TrackedTime steal_start =
+      tracked_objects::ThreadData::Now();
+  for (size_t i = 1; i < stealable_queues_.size(); ++i) {
+    if (TakeFromStealableQueue((queue_index + i) % stealable_queues_.size(),
+                               false, task)) {
+      tracked_objects::ThreadData::TallyRunInAScopedRegionIfTracking(
+          tracked_objects::ThreadData::TallyABirthIfActive(
+              FROM_HERE_WITH_EXPLICIT_FUNCTION(
+                  "SequencedWorkerPool::StealTask")),
+          steal_start, tracked_objects::ThreadData::Now());
+      return true;
+    }
+  }
+  return false;
+}
+
+bool SequencedWorkerPool::Inner::TakeFromStealableQueue(size_t queue_index,
+                                                        bool from_front,
+                                                        SequencedTask* task) {
+  StealableQueue* queue = stealable_queues_[queue_index];
+  AutoLock queue_lock(queue->lock);
+  if (queue->tasks.empty())
+    return false;
+
+  if (from_front) {
+    *task = queue->tasks.front();
+    queue->tasks.pop_front();
+  } else {
+    *task = queue->tasks.back();
+    queue->tasks.pop_back();
+  }
+
+  // Count the task as running before it stops being counted as pending, so
+  // that CanShutdown() never sees neither. The barrier pairs with the one in
+  // Shutdown(), see RunStealableTasks().
+  if (task->shutdown_behavior != CONTINUE_ON_SHUTDOWN) {
+    subtle::Barrier_AtomicIncrement(
+        &stealable_blocking_shutdown_running_count_, 1);
+  }
+  if (task->shutdown_behavior == BLOCK_SHUTDOWN) {
+    subtle::Barrier_AtomicIncrement(
+        &stealable_blocking_shutdown_pending_count_, -1);
+  }
+  subtle::NoBarrier_AtomicIncrement(&stealable_task_count_, -1);
+  return true;
+}
+
+void SequencedWorkerPool::Inner::RunStealableTasks(Worker* this_worker) {
+  const size_t queue_index = this_worker->thread_number() - 1;
+  DCHECK_LT(queue_index, stealable_queues_.size());
+
+  SequencedTask task;
+  while (TakeStealableTask(queue_index, &task)) {
+    if (subtle::Acquire_Load(&shutdown_flag_) &&
+        task.shutdown_behavior != BLOCK_SHUTDOWN) {
+      // Same as in GetWork(), tasks that don't block shutdown are deleted
+      // instead of run once shutdown has started. No locks are held here, so
+      // it is safe to do so right away.
+      task.task = Closure();
+      DidRunStealableTask(task);
+      continue;
+    }
+
+    // See WillRunWorkerTask() for why this is done before running the task.
+    int new_thread_id = 0;
+    if (!subtle::Acquire_Load(&all_threads_created_) && HasStealableWork()) {
+      AutoLock lock(lock_);
+      new_thread_id = PrepareToStartAdditionalThreadIfHelpful();
+    }
+    if (new_thread_id)
+      FinishStartingAdditionalThread(new_thread_id);
+
+    TRACE_EVENT_FLOW_END0(TRACE_DISABLED_BY_DEFAULT("toplevel.flow"),
+        "SequencedWorkerPool::PostTask",
+        TRACE_ID_MANGLE(GetTaskTraceID(task, static_cast<void*>(this))));
+    TRACE_EVENT2("toplevel", "SequencedWorkerPool::ThreadLoop",
+                 "src_file", task.posted_from.file_name(),
+                 "src_func", task.posted_from.function_name());
+
+    this_worker->set_running_task_info(SequenceToken(),
+                                       task.shutdown_behavior);
+
+    tracked_objects::TrackedTime start_time =
+        tracked_objects::ThreadData::NowForStartOfRun(task.birth_tally);
+
+    task.task.Run();
+
+    tracked_objects::ThreadData::TallyRunOnNamedThreadIfTracking(task,
+        start_time, tracked_objects::ThreadData::NowForEndOfRun(start_time));
+
+    // As in ThreadLoop(), destroy the task before clearing the running task
+    // info so that sequence checks from its destructor still work.
+    task.task = Closure();
+
+    this_worker->set_running_task_info(SequenceToken(), CONTINUE_ON_SHUTDOWN);
+    DidRunStealableTask(task);
+  }
+}
+
+void SequencedWorkerPool::Inner::DidRunStealableTask(
+    const SequencedTask& task) {
+  if (task.shutdown_behavior == CONTINUE_ON_SHUTDOWN)
+    return;
+
+  // The barrier pairs with the one in Shutdown(): either Shutdown() sees
+  // this task as done, or we see |shutdown_flag_| and wake it up. Taking
+  // |lock_| ensures that the signal isn't lost.
+  subtle::Barrier_AtomicIncrement(
+      &stealable_blocking_shutdown_running_count_, -1);
+  if (subtle::Acquire_Load(&shutdown_flag_)) {
+    AutoLock lock(lock_);
+    can_shutdown_cv_.Signal();
+  }
 }
 
 base::StaticAtomicSequenceNumber
@@ -1140,15 +1480,36 @@ SequencedWorkerPool::SequencedWorkerPool(
     size_t max_threads,
     const std::string& thread_name_prefix)
     : constructor_message_loop_(MessageLoopProxy::current()),
-      inner_(new Inner(this, max_threads, thread_name_prefix, NULL)) {
+      inner_(new Inner(this, max_threads, thread_name_prefix, SHARED_QUEUE,
+                       NULL)) {
+}
+
+SequencedWorkerPool::SequencedWorkerPool(
+    size_t max_threads,
+    const std::string& thread_name_prefix,
+    TestingObserver* observer)
+    : constructor_message_loop_(MessageLoopProxy::current()),
+      inner_(new Inner(this, max_threads, thread_name_prefix, SHARED_QUEUE,
+                       observer)) {
+}
+
+SequencedWorkerPool::SequencedWorkerPool(
+    size_t max_threads,
+    const std::string& thread_name_prefix,
+    SchedulingMode scheduling_mode)
+    : constructor_message_loop_(MessageLoopProxy::current()),
+      inner_(new Inner(this, max_threads, thread_name_prefix, scheduling_mode,
+                       NULL)) {
 }
 
 SequencedWorkerPool::SequencedWorkerPool(
     size_t max_threads,
     const std::string& thread_name_prefix,
+    SchedulingMode scheduling_mode,
     TestingObserver* observer)
     : constructor_message_loop_(MessageLoopProxy::current()),
-      inner_(new Inner(this, max_threads, thread_name_prefix, observer)) {
+      inner_(new Inner(this, max_threads, thread_name_prefix, scheduling_mode,
+                       observer)) {
 }
 
 SequencedWorkerPool::~SequencedWorkerPool() {}
@@ -118,6 +118,25 @@ class BASE_EXPORT SequencedWorkerPool : public TaskRunner {
     BLOCK_SHUTDOWN,
   };
 
+  // Defines how workers find tasks to run.
+  enum SchedulingMode {
+    // All tasks live in a single pending set protected by one lock. This is
+    // the default.
+    SHARED_QUEUE,
+
+    // Unsequenced tasks posted without a delay are distributed over
+    // per-worker queues, each with its own lock, and idle workers steal from
+    // the other workers' queues before falling back to the shared pending
+    // set. This keeps posting and running such tasks off the pool-wide lock,
+    // which helps pools that receive many blocking tasks from many threads.
+    // Sequenced and delayed tasks are scheduled exactly as in SHARED_QUEUE,
+    // and all shutdown behaviors are honored.
+    //
+    // Steals, and the time spent holding the pool-wide lock, are recorded as
+    // scoped regions with tracked_objects so they show up in about:profiler.
+    WORK_STEALING,
+  };
+
   // Opaque identifier that defines sequencing of tasks posted to the worker
   // pool.
   class SequenceToken {
@@ -171,6 +190,18 @@ class BASE_EXPORT SequencedWorkerPool : public TaskRunner {
                       const std::string& thread_name_prefix,
                       TestingObserver* observer);
 
+  // Like above, but allows the |scheduling_mode| to be specified.
+  SequencedWorkerPool(size_t max_threads,
+                      const std::string& thread_name_prefix,
+                      SchedulingMode scheduling_mode);
+
+  // Like above, but with |observer| for testing.  Does not take
+  // ownership of |observer|.
+  SequencedWorkerPool(size_t max_threads,
+                      const std::string& thread_name_prefix,
+                      SchedulingMode scheduling_mode,
+                      TestingObserver* observer);
+
   // Returns a unique token that can be used to sequence tasks posted to
   // PostSequencedWorkerTask(). Valid tokens are always nonzero.
   SequenceToken GetSequenceToken();
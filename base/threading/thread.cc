@@ -51,13 +51,19 @@ struct Thread::StartupData {
 
 Thread::Options::Options()
     : message_loop_type(MessageLoop::TYPE_DEFAULT),
-      stack_size(0) {
+      stack_size(0),
+      priority(kThreadPriority_Normal),
+      scheduler_class(kThreadSchedulerClass_Default),
+      cpu_affinity_mask(0) {
 }
 
 Thread::Options::Options(MessageLoop::Type type,
                          size_t size)
     : message_loop_type(type),
-      stack_size(size) {
+      stack_size(size),
+      priority(kThreadPriority_Normal),
+      scheduler_class(kThreadSchedulerClass_Default),
+      cpu_affinity_mask(0) {
 }
 
 Thread::Options::~Options() {
@@ -103,7 +109,13 @@ bool Thread::StartWithOptions(const Options& options) {
   StartupData startup_data(options);
   startup_data_ = &startup_data;
 
-  if (!PlatformThread::Create(options.stack_size, this, &thread_)) {
+  ThreadSchedulingParams scheduling;
+  scheduling.priority = options.priority;
+  scheduling.scheduler_class = options.scheduler_class;
+  scheduling.cpu_affinity_mask = options.cpu_affinity_mask;
+  scheduling.realtime_period = options.realtime_period;
+  if (!PlatformThread::CreateWithSchedulingParams(options.stack_size, this,
+                                                  &thread_, scheduling)) {
     DLOG(ERROR) << "failed to create thread";
     startup_data_ = NULL;
     return false;
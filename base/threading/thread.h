@@ -54,6 +54,13 @@ class BASE_EXPORT Thread : PlatformThread::Delegate {
     // This does not necessarily correspond to the thread's initial stack size.
     // A value of 0 indicates that the default maximum should be used.
     size_t stack_size;
+
+    // How the thread is scheduled; see ThreadSchedulingParams. These are
+    // applied by the thread itself before its message loop is created.
+    ThreadPriority priority;
+    ThreadSchedulerClass scheduler_class;
+    uint64 cpu_affinity_mask;
+    TimeDelta realtime_period;
   };
 
   // Constructor.
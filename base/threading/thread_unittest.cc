@@ -12,6 +12,10 @@
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/platform_test.h"
 
+#if defined(OS_LINUX)
+#include <sched.h>
+#endif
+
 using base::Thread;
 
 typedef PlatformTest ThreadTest;
@@ -24,6 +28,12 @@ void ToggleValue(bool* value) {
   *value = !*value;
 }
 
+#if defined(OS_LINUX)
+void GetSchedulerPolicy(int* policy) {
+  *policy = sched_getscheduler(0);
+}
+#endif
+
 class SleepInsideInitThread : public Thread {
  public:
   SleepInsideInitThread() : Thread("none") {
@@ -158,6 +168,21 @@ TEST_F(ThreadTest, StartWithOptions_StackSize) {
   EXPECT_TRUE(was_invoked);
 }
 
+#if defined(OS_LINUX)
+TEST_F(ThreadTest, StartWithOptions_SchedulerClass) {
+  Thread a("StartWithOptions_SchedulerClass");
+  Thread::Options options;
+  options.scheduler_class = base::kThreadSchedulerClass_Batch;
+  EXPECT_TRUE(a.StartWithOptions(options));
+
+  int policy = -1;
+  a.message_loop()->PostTask(FROM_HERE,
+                             base::Bind(&GetSchedulerPolicy, &policy));
+  a.Stop();
+  EXPECT_EQ(SCHED_BATCH, policy);
+}
+#endif
+
 TEST_F(ThreadTest, TwoTasks) {
   bool was_invoked = false;
   {
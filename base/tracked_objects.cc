@@ -5,8 +5,11 @@
 #include "base/tracked_objects.h"
 
 #include <limits.h>
+#include <math.h>
 #include <stdlib.h>
 
+#include <algorithm>
+
 #include "base/atomicops.h"
 #include "base/base_switches.h"
 #include "base/command_line.h"
@@ -15,6 +18,7 @@
 #include "base/logging.h"
 #include "base/process/process_handle.h"
 #include "base/profiler/alternate_timer.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/stringprintf.h"
 #include "base/third_party/valgrind/memcheck.h"
 #include "base/tracking_info.h"
@@ -80,6 +84,72 @@ inline bool IsProfilerTimingEnabled() {
   return current_timing_enabled == ENABLED_TIMING;
 }
 
+// The interval set by ThreadData::SetSamplingInterval(), or 0 until it is set
+// or read from the command line.
+base::subtle::Atomic32 g_sampling_interval = 0;
+
+int GetSamplingInterval() {
+  // As above, racing initializations all store the same value.
+  base::subtle::Atomic32 interval =
+      base::subtle::NoBarrier_Load(&g_sampling_interval);
+  if (interval)
+    return interval;
+  if (!CommandLine::InitializedForCurrentProcess())
+    return 1;
+  int value = 0;
+  if (!base::StringToInt(CommandLine::ForCurrentProcess()->GetSwitchValueASCII(
+                             switches::kProfilerSamplingInterval),
+                         &value) ||
+      value < 1) {
+    value = 1;
+  }
+  base::subtle::NoBarrier_Store(&g_sampling_interval, value);
+  return value;
+}
+
+// Returns true if --profiler-timing asks for the run durations to be measured
+// in thread time.
+bool IsThreadTimingRequested() {
+  return CommandLine::InitializedForCurrentProcess() &&
+         CommandLine::ForCurrentProcess()->GetSwitchValueASCII(
+             switches::kProfilerTiming) == switches::kProfilerTimingThreadValue;
+}
+
+// The NowFunction for thread time.
+unsigned int ThreadNowInMilliseconds() {
+  return static_cast<unsigned int>(
+      (base::TimeTicks::ThreadNow() - base::TimeTicks()).InMilliseconds());
+}
+
+// Estimates the total of |count| durations from the |sum| of |timed_count| of
+// them. A negative |timed_count| means every run was timed, for snapshots
+// filled in by hand.
+int32 EstimateSum(int64 sum, int timed_count, int count) {
+  if (timed_count <= 0 || timed_count >= count)
+    return static_cast<int32>(sum);
+  int64 estimate = sum * count / timed_count;
+  return static_cast<int32>(std::min<int64>(estimate, kint32max));
+}
+
+// Returns the half width of the 95% confidence interval of EstimateSum(),
+// treating the timed durations as a simple random sample of all of them.
+int32 EstimateSumError(int64 sum,
+                       int64 sum_of_squares,
+                       int timed_count,
+                       int count) {
+  if (timed_count < 0 || timed_count >= count)
+    return 0;
+  if (timed_count < 2)
+    return EstimateSum(sum, timed_count, count);
+  double n = timed_count;
+  double mean = sum / n;
+  double variance =
+      std::max(0.0, (sum_of_squares - n * mean * mean) / (n - 1));
+  // The standard error of the total, with the finite population correction.
+  double error = 1.96 * count * sqrt(variance / n * (1 - n / count));
+  return static_cast<int32>(std::min<double>(error, kint32max));
+}
+
 }  // namespace
 
 //------------------------------------------------------------------------------
@@ -110,8 +180,14 @@ void DeathData::RecordDeath(const int32 queue_duration,
   // We'll just clamp at INT_MAX, but we should note this in the UI as such.
   if (count_ < INT_MAX)
     ++count_;
+  if (timed_count_ < INT_MAX)
+    ++timed_count_;
   queue_duration_sum_ += queue_duration;
   run_duration_sum_ += run_duration;
+  queue_duration_sum_of_squares_ +=
+      static_cast<int64>(queue_duration) * queue_duration;
+  run_duration_sum_of_squares_ +=
+      static_cast<int64>(run_duration) * run_duration;
 
   if (queue_duration_max_ < queue_duration)
     queue_duration_max_ = queue_duration;
@@ -119,20 +195,37 @@ void DeathData::RecordDeath(const int32 queue_duration,
     run_duration_max_ = run_duration;
 
   // Take a uniformly distributed sample over all durations ever supplied.
-  // The probability that we (instead) use this new sample is 1/count_.  This
-  // results in a completely uniform selection of the sample (at least when we
-  // don't clamp count_... but that should be inconsequentially likely).
+  // The probability that we (instead) use this new sample is 1/timed_count_.
+  // This results in a completely uniform selection of the sample (at least
+  // when we don't clamp timed_count_... but that should be inconsequentially
+  // likely).
   // We ignore the fact that we correlated our selection of a sample to the run
   // and queue times (i.e., we used them to generate random_number).
-  CHECK_GT(count_, 0);
-  if (0 == (random_number % count_)) {
+  CHECK_GT(timed_count_, 0);
+  if (0 == (random_number % timed_count_)) {
     queue_duration_sample_ = queue_duration;
     run_duration_sample_ = run_duration;
   }
 }
 
+void DeathData::RecordUntimedDeath() {
+  if (count_ < INT_MAX)
+    ++count_;
+}
+
+bool DeathData::ShouldTimeNextRun(int sampling_interval) {
+  if (runs_until_timed_ > 0) {
+    --runs_until_timed_;
+    return false;
+  }
+  runs_until_timed_ = sampling_interval - 1;
+  return true;
+}
+
 int DeathData::count() const { return count_; }
 
+int DeathData::timed_count() const { return timed_count_; }
+
 int32 DeathData::run_duration_sum() const { return run_duration_sum_; }
 
 int32 DeathData::run_duration_max() const { return run_duration_max_; }
@@ -153,6 +246,14 @@ int32 DeathData::queue_duration_sample() const {
   return queue_duration_sample_;
 }
 
+int64 DeathData::run_duration_sum_of_squares() const {
+  return run_duration_sum_of_squares_;
+}
+
+int64 DeathData::queue_duration_sum_of_squares() const {
+  return queue_duration_sum_of_squares_;
+}
+
 void DeathData::ResetMax() {
   run_duration_max_ = 0;
   queue_duration_max_ = 0;
@@ -160,39 +261,68 @@ void DeathData::ResetMax() {
 
 void DeathData::Clear() {
   count_ = 0;
+  timed_count_ = 0;
+  runs_until_timed_ = 0;
   run_duration_sum_ = 0;
   run_duration_max_ = 0;
   run_duration_sample_ = 0;
   queue_duration_sum_ = 0;
   queue_duration_max_ = 0;
   queue_duration_sample_ = 0;
+  run_duration_sum_of_squares_ = 0;
+  queue_duration_sum_of_squares_ = 0;
 }
 
 //------------------------------------------------------------------------------
 DeathDataSnapshot::DeathDataSnapshot()
     : count(-1),
+      timed_count(-1),
       run_duration_sum(-1),
       run_duration_max(-1),
       run_duration_sample(-1),
       queue_duration_sum(-1),
       queue_duration_max(-1),
-      queue_duration_sample(-1) {
+      queue_duration_sample(-1),
+      run_duration_sum_of_squares(-1),
+      queue_duration_sum_of_squares(-1) {
 }
 
 DeathDataSnapshot::DeathDataSnapshot(
     const tracked_objects::DeathData& death_data)
     : count(death_data.count()),
+      timed_count(death_data.timed_count()),
       run_duration_sum(death_data.run_duration_sum()),
       run_duration_max(death_data.run_duration_max()),
       run_duration_sample(death_data.run_duration_sample()),
       queue_duration_sum(death_data.queue_duration_sum()),
       queue_duration_max(death_data.queue_duration_max()),
-      queue_duration_sample(death_data.queue_duration_sample()) {
+      queue_duration_sample(death_data.queue_duration_sample()),
+      run_duration_sum_of_squares(death_data.run_duration_sum_of_squares()),
+      queue_duration_sum_of_squares(
+          death_data.queue_duration_sum_of_squares()) {
 }
 
 DeathDataSnapshot::~DeathDataSnapshot() {
 }
 
+int32 DeathDataSnapshot::EstimatedRunDurationSum() const {
+  return EstimateSum(run_duration_sum, timed_count, count);
+}
+
+int32 DeathDataSnapshot::EstimatedQueueDurationSum() const {
+  return EstimateSum(queue_duration_sum, timed_count, count);
+}
+
+int32 DeathDataSnapshot::RunDurationSumError() const {
+  return EstimateSumError(run_duration_sum, run_duration_sum_of_squares,
+                          timed_count, count);
+}
+
+int32 DeathDataSnapshot::QueueDurationSumError() const {
+  return EstimateSumError(queue_duration_sum, queue_duration_sum_of_squares,
+                          timed_count, count);
+}
+
 //------------------------------------------------------------------------------
 BirthOnThread::BirthOnThread(const Location& location,
                              const ThreadData& current)
@@ -433,6 +563,7 @@ Births* ThreadData::TallyABirth(const Location& location) {
 }
 
 void ThreadData::TallyADeath(const Births& birth,
+                             bool timed,
                              int32 queue_duration,
                              int32 run_duration) {
   // Stir in some randomness, plus add constant in case durations are zero.
@@ -447,15 +578,11 @@ void ThreadData::TallyADeath(const Births& birth,
   if (kAllowAlternateTimeSourceHandling && now_function_)
     queue_duration = 0;
 
-  DeathMap::iterator it = death_map_.find(&birth);
-  DeathData* death_data;
-  if (it != death_map_.end()) {
-    death_data = &it->second;
-  } else {
-    base::AutoLock lock(map_lock_);  // Lock as the map may get relocated now.
-    death_data = &death_map_[&birth];
-  }  // Release lock ASAP.
-  death_data->RecordDeath(queue_duration, run_duration, random_number_);
+  DeathData* death_data = GetDeathData(birth);
+  if (timed)
+    death_data->RecordDeath(queue_duration, run_duration, random_number_);
+  else
+    death_data->RecordUntimedDeath();
 
   if (!kTrackParentChildLinks)
     return;
@@ -465,6 +592,14 @@ void ThreadData::TallyADeath(const Births& birth,
   }
 }
 
+DeathData* ThreadData::GetDeathData(const Births& birth) {
+  DeathMap::iterator it = death_map_.find(&birth);
+  if (it != death_map_.end())
+    return &it->second;
+  base::AutoLock lock(map_lock_);  // Lock as the map may get relocated now.
+  return &death_map_[&birth];
+}
+
 // static
 Births* ThreadData::TallyABirthIfActive(const Location& location) {
   if (!kTrackAllTaskObjects)
@@ -496,20 +631,21 @@ void ThreadData::TallyRunOnNamedThreadIfTracking(
   if (!current_thread_data)
     return;
 
-  // Watch out for a race where status_ is changing, and hence one or both
-  // of start_of_run or end_of_run is zero.  In that case, we didn't bother to
-  // get a time value since we "weren't tracking" and we were trying to be
-  // efficient by not calling for a genuine time value. For simplicity, we'll
-  // use a default zero duration when we can't calculate a true value.
+  // One or both of start_of_run or end_of_run is zero when the run was not
+  // sampled, or in a race where status_ is changing.  In that case, we didn't
+  // bother to get a time value since we "weren't tracking" and we were trying
+  // to be efficient by not calling for a genuine time value, and only the
+  // death is counted.
+  bool timed = !start_of_run.is_null() && !end_of_run.is_null();
   int32 queue_duration = 0;
   int32 run_duration = 0;
-  if (!start_of_run.is_null()) {
+  if (timed) {
     queue_duration = (start_of_run - completed_task.EffectiveTimePosted())
         .InMilliseconds();
-    if (!end_of_run.is_null())
-      run_duration = (end_of_run - start_of_run).InMilliseconds();
+    run_duration = (end_of_run - start_of_run).InMilliseconds();
   }
-  current_thread_data->TallyADeath(*birth, queue_duration, run_duration);
+  current_thread_data->TallyADeath(*birth, timed, queue_duration,
+                                   run_duration);
 }
 
 // static
@@ -540,14 +676,15 @@ void ThreadData::TallyRunOnWorkerThreadIfTracking(
   if (!current_thread_data)
     return;
 
+  bool timed = !start_of_run.is_null() && !end_of_run.is_null();
   int32 queue_duration = 0;
   int32 run_duration = 0;
-  if (!start_of_run.is_null()) {
+  if (timed) {
     queue_duration = (start_of_run - time_posted).InMilliseconds();
-    if (!end_of_run.is_null())
-      run_duration = (end_of_run - start_of_run).InMilliseconds();
+    run_duration = (end_of_run - start_of_run).InMilliseconds();
   }
-  current_thread_data->TallyADeath(*birth, queue_duration, run_duration);
+  current_thread_data->TallyADeath(*birth, timed, queue_duration,
+                                   run_duration);
 }
 
 // static
@@ -568,11 +705,13 @@ void ThreadData::TallyRunInAScopedRegionIfTracking(
   if (!current_thread_data)
     return;
 
+  bool timed = !start_of_run.is_null() && !end_of_run.is_null();
   int32 queue_duration = 0;
   int32 run_duration = 0;
-  if (!start_of_run.is_null() && !end_of_run.is_null())
+  if (timed)
     run_duration = (end_of_run - start_of_run).InMilliseconds();
-  current_thread_data->TallyADeath(*birth, queue_duration, run_duration);
+  current_thread_data->TallyADeath(*birth, timed, queue_duration,
+                                   run_duration);
 }
 
 // static
@@ -610,6 +749,10 @@ void ThreadData::SnapshotExecutedTasks(bool reset_max,
 
   for (ThreadData::DeathMap::const_iterator it = death_map.begin();
        it != death_map.end(); ++it) {
+    // Sampling adds the DeathData of a task when its first run starts, before
+    // it has any deaths.
+    if (!it->second.count())
+      continue;
     process_data->tasks.push_back(
         TaskSnapshot(*it->first, it->second, thread_name()));
     (*birth_counts)[it->first] -= it->first->birth_count();
@@ -675,6 +818,12 @@ void ThreadData::Reset() {
 
 static void OptionallyInitializeAlternateTimer() {
   NowFunction* alternate_time_source = GetAlternateTimeSource();
+  if (!alternate_time_source && IsThreadTimingRequested() &&
+      base::TimeTicks::IsThreadNowSupported()) {
+    alternate_time_source = &ThreadNowInMilliseconds;
+    SetAlternateTimeSource(alternate_time_source,
+                           TIME_SOURCE_TYPE_THREAD_TIME);
+  }
   if (alternate_time_source)
     ThreadData::SetAlternateTimeSource(alternate_time_source);
 }
@@ -759,19 +908,44 @@ bool ThreadData::TrackingParentChildStatus() {
 
 // static
 TrackedTime ThreadData::NowForStartOfRun(const Births* parent) {
+  ThreadData* current_thread_data = NULL;
   if (kTrackParentChildLinks && parent && status_ > PROFILING_ACTIVE) {
-    ThreadData* current_thread_data = Get();
+    current_thread_data = Get();
     if (current_thread_data)
       current_thread_data->parent_stack_.push(parent);
   }
+
+  int interval = GetSamplingInterval();
+  if (kTrackAllTaskObjects && parent && interval > 1 && TrackingStatus()) {
+    if (!current_thread_data)
+      current_thread_data = Get();
+    if (current_thread_data &&
+        !current_thread_data->GetDeathData(*parent)->ShouldTimeNextRun(
+            interval)) {
+      return TrackedTime();
+    }
+  }
   return Now();
 }
 
 // static
-TrackedTime ThreadData::NowForEndOfRun() {
+TrackedTime ThreadData::NowForEndOfRun(const TrackedTime& start_of_run) {
+  if (start_of_run.is_null())
+    return TrackedTime();  // The run is not timed.
   return Now();
 }
 
+// static
+void ThreadData::SetSamplingInterval(int interval) {
+  DCHECK_GE(interval, 1);
+  base::subtle::NoBarrier_Store(&g_sampling_interval, interval);
+}
+
+// static
+int ThreadData::sampling_interval() {
+  return GetSamplingInterval();
+}
+
 // static
 void ThreadData::SetAlternateTimeSource(NowFunction* now_function) {
   DCHECK(now_function);
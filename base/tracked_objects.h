@@ -275,14 +275,26 @@ class BASE_EXPORT DeathData {
                    const int32 run_duration,
                    int random_number);
 
+  // Update stats for a task destruction (death) whose run was not timed,
+  // because it was not sampled or timing is disabled.
+  void RecordUntimedDeath();
+
+  // Returns true if the next run should be timed when only one run in
+  // |sampling_interval| is timed. The first run is always timed, so that
+  // rarely run tasks have durations.
+  bool ShouldTimeNextRun(int sampling_interval);
+
   // Metrics accessors, used only for serialization and in tests.
   int count() const;
+  int timed_count() const;
   int32 run_duration_sum() const;
   int32 run_duration_max() const;
   int32 run_duration_sample() const;
   int32 queue_duration_sum() const;
   int32 queue_duration_max() const;
   int32 queue_duration_sample() const;
+  int64 run_duration_sum_of_squares() const;
+  int64 queue_duration_sum_of_squares() const;
 
   // Reset the max values to zero.
   void ResetMax();
@@ -293,8 +305,13 @@ class BASE_EXPORT DeathData {
  private:
   // Members are ordered from most regularly read and updated, to least
   // frequently used.  This might help a bit with cache lines.
-  // Number of runs seen (divisor for calculating averages).
+  // Number of runs seen.
   int count_;
+  // Number of those runs which were timed (divisor for calculating averages).
+  // The durations below are only those of timed runs.
+  int timed_count_;
+  // Number of runs left to skip before timing one, when sampling.
+  int runs_until_timed_;
   // Basic tallies, used to compute averages.
   int32 run_duration_sum_;
   int32 queue_duration_sum_;
@@ -306,6 +323,10 @@ class BASE_EXPORT DeathData {
   // and rarely updated.
   int32 run_duration_sample_;
   int32 queue_duration_sample_;
+  // Sums of squared durations, used to compute the error of the totals
+  // estimated from sampled runs.
+  int64 run_duration_sum_of_squares_;
+  int64 queue_duration_sum_of_squares_;
 };
 
 //------------------------------------------------------------------------------
@@ -316,13 +337,28 @@ struct BASE_EXPORT DeathDataSnapshot {
   explicit DeathDataSnapshot(const DeathData& death_data);
   ~DeathDataSnapshot();
 
+  // The totals of the durations of all |count| runs, estimated from the
+  // |timed_count| runs which were timed. They are the plain sums when every
+  // run was timed.
+  int32 EstimatedRunDurationSum() const;
+  int32 EstimatedQueueDurationSum() const;
+
+  // The half widths of the 95% confidence intervals of the estimated totals
+  // above. They are zero when every run was timed, and as large as the
+  // estimate when too few runs were timed to tell.
+  int32 RunDurationSumError() const;
+  int32 QueueDurationSumError() const;
+
   int count;
+  int timed_count;
   int32 run_duration_sum;
   int32 run_duration_max;
   int32 run_duration_sample;
   int32 queue_duration_sum;
   int32 queue_duration_max;
   int32 queue_duration_sample;
+  int64 run_duration_sum_of_squares;
+  int64 queue_duration_sum_of_squares;
 };
 
 //------------------------------------------------------------------------------
@@ -465,9 +501,20 @@ class BASE_EXPORT ThreadData {
   // side effects when we are tracking, so that we can deduce the amount of time
   // accumulated outside of execution of tracked runs.
   // The task that will be tracked is passed in as |parent| so that parent-child
-  // relationships can be (optionally) calculated.
+  // relationships can be (optionally) calculated, and so that only one run in
+  // sampling_interval() of each task is timed.  Runs which are not timed get a
+  // null |start_of_run|, and then NowForEndOfRun() doesn't read the time
+  // either.
   static TrackedTime NowForStartOfRun(const Births* parent);
-  static TrackedTime NowForEndOfRun();
+  static TrackedTime NowForEndOfRun(const TrackedTime& start_of_run);
+
+  // Times only one run in |interval| of the tasks born at each location on
+  // each thread, instead of every run, to make profiling cheaper.  The totals
+  // of the durations are then estimated from the timed runs.  The default is
+  // the value of the --profiler-sampling-interval switch, or 1 (timing every
+  // run) without it.
+  static void SetSamplingInterval(int interval);
+  static int sampling_interval();
 
   // Provide a time function that does nothing (runs fast) when we don't have
   // the profiler enabled.  It will generally be optimized away when it is
@@ -522,8 +569,16 @@ class BASE_EXPORT ThreadData {
   // In this thread's data, record a new birth.
   Births* TallyABirth(const Location& location);
 
-  // Find a place to record a death on this thread.
-  void TallyADeath(const Births& birth, int32 queue_duration, int32 duration);
+  // Find a place to record a death on this thread.  |timed| is false if the
+  // run was not timed, and the durations are then ignored.
+  void TallyADeath(const Births& birth,
+                   bool timed,
+                   int32 queue_duration,
+                   int32 duration);
+
+  // Returns the DeathData of the runs of |birth| on this thread, creating it
+  // if needed.
+  DeathData* GetDeathData(const Births& birth);
 
   // Snapshot (under a lock) the profiled data for the tasks in each ThreadData
   // instance.  Also updates the |birth_counts| tally for each task to keep
@@ -167,7 +167,7 @@ TEST_F(TrackedObjectsTest, TinyStartupShutdown) {
   base::TrackingInfo pending_task(location, kBogusBirthTime);
   TrackedTime start_time(pending_task.time_posted);
   // Finally conclude the outer run.
-  TrackedTime end_time = ThreadData::NowForEndOfRun();
+  TrackedTime end_time = ThreadData::NowForEndOfRun(start_time);
   ThreadData::TallyRunOnNamedThreadIfTracking(pending_task, start_time,
                                               end_time);
 
@@ -261,12 +261,59 @@ TEST_F(TrackedObjectsTest, DeathDataTest) {
 
   DeathDataSnapshot snapshot(*data);
   EXPECT_EQ(2, snapshot.count);
+  EXPECT_EQ(2, snapshot.timed_count);
   EXPECT_EQ(2 * run_ms, snapshot.run_duration_sum);
   EXPECT_EQ(run_ms, snapshot.run_duration_max);
   EXPECT_EQ(run_ms, snapshot.run_duration_sample);
   EXPECT_EQ(2 * queue_ms, snapshot.queue_duration_sum);
   EXPECT_EQ(queue_ms, snapshot.queue_duration_max);
   EXPECT_EQ(queue_ms, snapshot.queue_duration_sample);
+  EXPECT_EQ(2 * run_ms * run_ms, snapshot.run_duration_sum_of_squares);
+  EXPECT_EQ(2 * queue_ms * queue_ms, snapshot.queue_duration_sum_of_squares);
+  EXPECT_EQ(2 * run_ms, snapshot.EstimatedRunDurationSum());
+  EXPECT_EQ(0, snapshot.RunDurationSumError());
+}
+
+TEST_F(TrackedObjectsTest, DeathDataEstimateTest) {
+  DeathData data;
+  const int kUnrandomInt = 0;
+  data.RecordDeath(0, 10, kUnrandomInt);
+  data.RecordDeath(0, 30, kUnrandomInt);
+  data.RecordUntimedDeath();
+  data.RecordUntimedDeath();
+  EXPECT_EQ(4, data.count());
+  EXPECT_EQ(2, data.timed_count());
+  EXPECT_EQ(40, data.run_duration_sum());
+  EXPECT_EQ(30, data.run_duration_max());
+
+  DeathDataSnapshot snapshot(data);
+  EXPECT_EQ(80, snapshot.EstimatedRunDurationSum());
+  EXPECT_EQ(0, snapshot.EstimatedQueueDurationSum());
+  // The variance of the timed runs is 200, so the error of the total is
+  // 1.96 * 4 * sqrt(200 / 2 * (1 - 2 / 4)).
+  EXPECT_EQ(55, snapshot.RunDurationSumError());
+  EXPECT_EQ(0, snapshot.QueueDurationSumError());
+
+  // With a single timed run, the error is as large as the estimate.
+  DeathData single;
+  single.RecordDeath(0, 10, kUnrandomInt);
+  single.RecordUntimedDeath();
+  DeathDataSnapshot single_snapshot(single);
+  EXPECT_EQ(20, single_snapshot.EstimatedRunDurationSum());
+  EXPECT_EQ(20, single_snapshot.RunDurationSumError());
+}
+
+TEST_F(TrackedObjectsTest, ShouldTimeNextRunTest) {
+  DeathData data;
+  const int kInterval = 3;
+  EXPECT_TRUE(data.ShouldTimeNextRun(kInterval));
+  EXPECT_FALSE(data.ShouldTimeNextRun(kInterval));
+  EXPECT_FALSE(data.ShouldTimeNextRun(kInterval));
+  EXPECT_TRUE(data.ShouldTimeNextRun(kInterval));
+
+  DeathData every_run;
+  EXPECT_TRUE(every_run.ShouldTimeNextRun(1));
+  EXPECT_TRUE(every_run.ShouldTimeNextRun(1));
 }
 
 TEST_F(TrackedObjectsTest, DeactivatedBirthOnlyToSnapshotWorkerThread) {
@@ -581,4 +628,53 @@ TEST_F(TrackedObjectsTest, DifferentLives) {
   EXPECT_EQ(base::GetCurrentProcId(), process_data.process_id);
 }
 
+TEST_F(TrackedObjectsTest, SampledLives) {
+  if (!ThreadData::InitializeAndSetTrackingStatus(
+          ThreadData::PROFILING_CHILDREN_ACTIVE))
+    return;
+  ThreadData::SetSamplingInterval(3);
+
+  const char kFunction[] = "SampledLives";
+  Location location(kFunction, kFile, kLineNumber, NULL);
+  TallyABirth(location, kMainThreadName);
+
+  const base::TimeTicks kTimePosted = base::TimeTicks() +
+      base::TimeDelta::FromMilliseconds(1);
+  const base::TimeTicks kDelayedStartTime = base::TimeTicks();
+  const TrackedTime kStartOfRun = TrackedTime() +
+      Duration::FromMilliseconds(5);
+  const TrackedTime kEndOfRun = TrackedTime() + Duration::FromMilliseconds(7);
+  for (int i = 0; i < 6; ++i) {
+    // TrackingInfo will call TallyABirth() during construction.
+    base::TrackingInfo pending_task(location, kDelayedStartTime);
+    pending_task.time_posted = kTimePosted;  // Overwrite implied Now().
+
+    // Only the first run of every three is timed.
+    TrackedTime start_of_run =
+        ThreadData::NowForStartOfRun(pending_task.birth_tally);
+    EXPECT_EQ(i % 3 != 0, start_of_run.is_null()) << i;
+    EXPECT_EQ(i % 3 != 0, ThreadData::NowForEndOfRun(start_of_run).is_null());
+    if (start_of_run.is_null()) {
+      ThreadData::TallyRunOnNamedThreadIfTracking(pending_task, TrackedTime(),
+                                                  TrackedTime());
+    } else {
+      ThreadData::TallyRunOnNamedThreadIfTracking(pending_task, kStartOfRun,
+                                                  kEndOfRun);
+    }
+  }
+  ThreadData::SetSamplingInterval(1);
+
+  ProcessDataSnapshot process_data;
+  ThreadData::Snapshot(false, &process_data);
+  ASSERT_EQ(1u, process_data.tasks.size());
+  const DeathDataSnapshot& death_data = process_data.tasks[0].death_data;
+  EXPECT_EQ(6, death_data.count);
+  EXPECT_EQ(2, death_data.timed_count);
+  EXPECT_EQ(4, death_data.run_duration_sum);
+  EXPECT_EQ(2, death_data.run_duration_max);
+  EXPECT_EQ(12, death_data.EstimatedRunDurationSum());
+  EXPECT_EQ(24, death_data.EstimatedQueueDurationSum());
+  EXPECT_EQ(0, death_data.RunDurationSumError());
+}
+
 }  // namespace tracked_objects
@@ -44,7 +44,7 @@ Value* CopyWithoutEmptyChildren(const Value* node) {
 
     case Value::TYPE_DICTIONARY: {
       const DictionaryValue* dict = static_cast<const DictionaryValue*>(node);
-      DictionaryValue* copy = new DictionaryValue;
+      DictionaryValue* copy = new DictionaryValue(dict->storage());
       for (DictionaryValue::Iterator it(*dict); !it.IsAtEnd(); it.Advance()) {
         Value* child_copy = CopyWithoutEmptyChildren(&it.value());
         if (child_copy)
@@ -63,6 +63,14 @@ Value* CopyWithoutEmptyChildren(const Value* node) {
   }
 }
 
+// Orders the entries of a FlatValueMap by key, for std::lower_bound.
+struct FlatValueMapKeyLess {
+  bool operator()(const FlatValueMap::value_type& entry,
+                  const std::string& key) const {
+    return entry.first < key;
+  }
+};
+
 // A small functor for comparing Values for std::find_if and similar.
 class ValueEquals {
  public:
@@ -360,7 +368,13 @@ bool BinaryValue::Equals(const Value* other) const {
 ///////////////////// DictionaryValue ////////////////////
 
 DictionaryValue::DictionaryValue()
-    : Value(TYPE_DICTIONARY) {
+    : Value(TYPE_DICTIONARY),
+      storage_(STORAGE_MAP) {
+}
+
+DictionaryValue::DictionaryValue(Storage storage)
+    : Value(TYPE_DICTIONARY),
+      storage_(storage) {
 }
 
 DictionaryValue::~DictionaryValue() {
@@ -381,9 +395,9 @@ bool DictionaryValue::GetAsDictionary(const DictionaryValue** out_value) const {
 
 bool DictionaryValue::HasKey(const std::string& key) const {
   DCHECK(IsStringUTF8(key));
-  ValueMap::const_iterator current_entry = dictionary_.find(key);
-  DCHECK((current_entry == dictionary_.end()) || current_entry->second);
-  return current_entry != dictionary_.end();
+  Value* const* entry = FindEntry(key);
+  DCHECK(!entry || *entry);
+  return entry != NULL;
 }
 
 void DictionaryValue::Clear() {
@@ -392,8 +406,11 @@ void DictionaryValue::Clear() {
     delete dict_iterator->second;
     ++dict_iterator;
   }
+  for (size_t i = 0; i < flat_dictionary_.size(); ++i)
+    delete flat_dictionary_[i].second;
 
   dictionary_.clear();
+  flat_dictionary_.clear();
 }
 
 void DictionaryValue::Set(const std::string& path, Value* in_value) {
@@ -409,7 +426,7 @@ void DictionaryValue::Set(const std::string& path, Value* in_value) {
     std::string key(current_path, 0, delimiter_position);
     DictionaryValue* child_dictionary = NULL;
     if (!current_dictionary->GetDictionary(key, &child_dictionary)) {
-      child_dictionary = new DictionaryValue;
+      child_dictionary = new DictionaryValue(current_dictionary->storage_);
       current_dictionary->SetWithoutPathExpansion(key, child_dictionary);
     }
 
@@ -444,6 +461,26 @@ void DictionaryValue::SetString(const std::string& path,
 
 void DictionaryValue::SetWithoutPathExpansion(const std::string& key,
                                               Value* in_value) {
+  if (storage_ == STORAGE_FLAT) {
+    // Appending in key order, as when parsing or copying a sorted
+    // dictionary, is the common case.
+    if (flat_dictionary_.empty() || flat_dictionary_.back().first < key) {
+      flat_dictionary_.push_back(std::make_pair(key, in_value));
+      return;
+    }
+    FlatValueMap::iterator it =
+        std::lower_bound(flat_dictionary_.begin(), flat_dictionary_.end(),
+                         key, FlatValueMapKeyLess());
+    if (it != flat_dictionary_.end() && it->first == key) {
+      DCHECK_NE(it->second, in_value);  // This would be bogus
+      delete it->second;
+      it->second = in_value;
+    } else {
+      flat_dictionary_.insert(it, std::make_pair(key, in_value));
+    }
+    return;
+  }
+
   // If there's an existing value here, we need to delete it, because
   // we own all our children.
   std::pair<ValueMap::iterator, bool> ins_res =
@@ -628,13 +665,12 @@ bool DictionaryValue::GetList(const std::string& path, ListValue** out_value) {
 bool DictionaryValue::GetWithoutPathExpansion(const std::string& key,
                                               const Value** out_value) const {
   DCHECK(IsStringUTF8(key));
-  ValueMap::const_iterator entry_iterator = dictionary_.find(key);
-  if (entry_iterator == dictionary_.end())
+  Value* const* entry = FindEntry(key);
+  if (!entry)
     return false;
 
-  const Value* entry = entry_iterator->second;
   if (out_value)
-    *out_value = entry;
+    *out_value = *entry;
   return true;
 }
 
@@ -757,16 +793,27 @@ bool DictionaryValue::Remove(const std::string& path,
 bool DictionaryValue::RemoveWithoutPathExpansion(const std::string& key,
                                                  scoped_ptr<Value>* out_value) {
   DCHECK(IsStringUTF8(key));
-  ValueMap::iterator entry_iterator = dictionary_.find(key);
-  if (entry_iterator == dictionary_.end())
-    return false;
+  Value* entry;
+  if (storage_ == STORAGE_FLAT) {
+    FlatValueMap::iterator it =
+        std::lower_bound(flat_dictionary_.begin(), flat_dictionary_.end(),
+                         key, FlatValueMapKeyLess());
+    if (it == flat_dictionary_.end() || it->first != key)
+      return false;
+    entry = it->second;
+    flat_dictionary_.erase(it);
+  } else {
+    ValueMap::iterator entry_iterator = dictionary_.find(key);
+    if (entry_iterator == dictionary_.end())
+      return false;
+    entry = entry_iterator->second;
+    dictionary_.erase(entry_iterator);
+  }
 
-  Value* entry = entry_iterator->second;
   if (out_value)
     out_value->reset(entry);
   else
     delete entry;
-  dictionary_.erase(entry_iterator);
   return true;
 }
 
@@ -792,7 +839,8 @@ bool DictionaryValue::RemovePath(const std::string& path,
 
 DictionaryValue* DictionaryValue::DeepCopyWithoutEmptyChildren() const {
   Value* copy = CopyWithoutEmptyChildren(this);
-  return copy ? static_cast<DictionaryValue*>(copy) : new DictionaryValue;
+  return copy ? static_cast<DictionaryValue*>(copy) :
+      new DictionaryValue(storage_);
 }
 
 void DictionaryValue::MergeDictionary(const DictionaryValue* dictionary) {
@@ -813,23 +861,40 @@ void DictionaryValue::MergeDictionary(const DictionaryValue* dictionary) {
 }
 
 void DictionaryValue::Swap(DictionaryValue* other) {
+  std::swap(storage_, other->storage_);
   dictionary_.swap(other->dictionary_);
+  flat_dictionary_.swap(other->flat_dictionary_);
+}
+
+Value* const* DictionaryValue::FindEntry(const std::string& key) const {
+  if (storage_ == STORAGE_FLAT) {
+    FlatValueMap::const_iterator it =
+        std::lower_bound(flat_dictionary_.begin(), flat_dictionary_.end(),
+                         key, FlatValueMapKeyLess());
+    if (it == flat_dictionary_.end() || it->first != key)
+      return NULL;
+    return &it->second;
+  }
+
+  ValueMap::const_iterator it = dictionary_.find(key);
+  if (it == dictionary_.end())
+    return NULL;
+  return &it->second;
 }
 
 DictionaryValue::Iterator::Iterator(const DictionaryValue& target)
     : target_(target),
-      it_(target.dictionary_.begin()) {}
+      it_(target.dictionary_.begin()),
+      flat_it_(target.flat_dictionary_.begin()) {}
 
 DictionaryValue::Iterator::~Iterator() {}
 
 DictionaryValue* DictionaryValue::DeepCopy() const {
-  DictionaryValue* result = new DictionaryValue;
+  DictionaryValue* result = new DictionaryValue(storage_);
+  result->flat_dictionary_.reserve(flat_dictionary_.size());
 
-  for (ValueMap::const_iterator current_entry(dictionary_.begin());
-       current_entry != dictionary_.end(); ++current_entry) {
-    result->SetWithoutPathExpansion(current_entry->first,
-                                    current_entry->second->DeepCopy());
-  }
+  for (Iterator it(*this); !it.IsAtEnd(); it.Advance())
+    result->SetWithoutPathExpansion(it.key(), it.value().DeepCopy());
 
   return result;
 }
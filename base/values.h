@@ -41,6 +41,8 @@ class Value;
 
 typedef std::vector<Value*> ValueVector;
 typedef std::map<std::string, Value*> ValueMap;
+// The entries of a compact DictionaryValue, sorted by key.
+typedef std::vector<std::pair<std::string, Value*> > FlatValueMap;
 
 // The Value class is the base class for Values. A Value can be instantiated
 // via the Create*Value() factory methods, or by directly creating instances of
@@ -208,9 +210,24 @@ class BASE_EXPORT BinaryValue: public Value {
 // are |std::string|s and should be UTF-8 encoded.
 class BASE_EXPORT DictionaryValue : public Value {
  public:
+  // How the entries are stored.  STORAGE_FLAT keeps them in a vector sorted
+  // by key, which takes far less memory than the std::map of STORAGE_MAP and
+  // is faster to look up and iterate, but inserting anywhere but after the
+  // last key is O(size()).  It suits large dictionaries that are built in key
+  // order and then mostly read, such as parsed preferences.  Dictionaries
+  // created by Set() and DeepCopy() use the storage of the dictionary they
+  // are created from.
+  enum Storage {
+    STORAGE_MAP,
+    STORAGE_FLAT
+  };
+
   DictionaryValue();
+  explicit DictionaryValue(Storage storage);
   virtual ~DictionaryValue();
 
+  Storage storage() const { return storage_; }
+
   // Overridden from Value:
   virtual bool GetAsDictionary(DictionaryValue** out_value) OVERRIDE;
   virtual bool GetAsDictionary(
@@ -220,10 +237,13 @@ class BASE_EXPORT DictionaryValue : public Value {
   bool HasKey(const std::string& key) const;
 
   // Returns the number of Values in this dictionary.
-  size_t size() const { return dictionary_.size(); }
+  size_t size() const {
+    return storage_ == STORAGE_FLAT ? flat_dictionary_.size() :
+                                      dictionary_.size();
+  }
 
   // Returns whether the dictionary is empty.
-  bool empty() const { return dictionary_.empty(); }
+  bool empty() const { return size() == 0; }
 
   // Clears any current contents of this dictionary.
   void Clear();
@@ -351,15 +371,30 @@ class BASE_EXPORT DictionaryValue : public Value {
     explicit Iterator(const DictionaryValue& target);
     ~Iterator();
 
-    bool IsAtEnd() const { return it_ == target_.dictionary_.end(); }
-    void Advance() { ++it_; }
-
-    const std::string& key() const { return it_->first; }
-    const Value& value() const { return *it_->second; }
+    bool IsAtEnd() const {
+      return flat() ? flat_it_ == target_.flat_dictionary_.end() :
+                      it_ == target_.dictionary_.end();
+    }
+    void Advance() {
+      if (flat())
+        ++flat_it_;
+      else
+        ++it_;
+    }
+
+    const std::string& key() const {
+      return flat() ? flat_it_->first : it_->first;
+    }
+    const Value& value() const {
+      return flat() ? *flat_it_->second : *it_->second;
+    }
 
    private:
+    bool flat() const { return target_.storage_ == STORAGE_FLAT; }
+
     const DictionaryValue& target_;
     ValueMap::const_iterator it_;
+    FlatValueMap::const_iterator flat_it_;
   };
 
   // Overridden from Value:
@@ -367,7 +402,13 @@ class BASE_EXPORT DictionaryValue : public Value {
   virtual bool Equals(const Value* other) const OVERRIDE;
 
  private:
+  // Returns the value slot for |key|, or NULL if there is none.
+  Value* const* FindEntry(const std::string& key) const;
+
+  // Only the container selected by |storage_| is used.
+  Storage storage_;
   ValueMap dictionary_;
+  FlatValueMap flat_dictionary_;
 
   DISALLOW_COPY_AND_ASSIGN(DictionaryValue);
 };
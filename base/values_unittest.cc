@@ -809,4 +809,63 @@ TEST(ValuesTest, DictionaryIterator) {
   EXPECT_TRUE(seen2);
 }
 
+TEST(ValuesTest, FlatDictionary) {
+  DictionaryValue dict(DictionaryValue::STORAGE_FLAT);
+  EXPECT_TRUE(dict.empty());
+
+  // Insert out of order, replace an entry and expand a path.
+  dict.SetInteger("b", 2);
+  dict.SetInteger("c", 3);
+  dict.SetInteger("a", 1);
+  dict.SetInteger("b", 20);
+  dict.SetString("d.e", "nested");
+  EXPECT_EQ(4u, dict.size());
+
+  const char* const kKeys[] = { "a", "b", "c", "d" };
+  size_t i = 0;
+  for (DictionaryValue::Iterator it(dict); !it.IsAtEnd(); it.Advance(), ++i) {
+    ASSERT_LT(i, arraysize(kKeys));
+    EXPECT_EQ(kKeys[i], it.key());
+  }
+  EXPECT_EQ(arraysize(kKeys), i);
+
+  int value = 0;
+  EXPECT_TRUE(dict.GetInteger("b", &value));
+  EXPECT_EQ(20, value);
+  EXPECT_FALSE(dict.HasKey("e"));
+  const DictionaryValue* child = NULL;
+  ASSERT_TRUE(dict.GetDictionary("d", &child));
+  EXPECT_EQ(DictionaryValue::STORAGE_FLAT, child->storage());
+  std::string nested;
+  EXPECT_TRUE(dict.GetString("d.e", &nested));
+  EXPECT_EQ("nested", nested);
+
+  // Copies keep the storage, and compare equal to the same map dictionary.
+  scoped_ptr<DictionaryValue> copy(dict.DeepCopy());
+  EXPECT_EQ(DictionaryValue::STORAGE_FLAT, copy->storage());
+  EXPECT_TRUE(dict.Equals(copy.get()));
+  DictionaryValue map_dict;
+  map_dict.MergeDictionary(&dict);
+  EXPECT_TRUE(map_dict.Equals(&dict));
+  EXPECT_TRUE(dict.Equals(&map_dict));
+
+  scoped_ptr<Value> removed;
+  EXPECT_TRUE(dict.Remove("b", &removed));
+  EXPECT_TRUE(removed->GetAsInteger(&value));
+  EXPECT_EQ(20, value);
+  EXPECT_FALSE(dict.Remove("b", NULL));
+  EXPECT_TRUE(dict.RemovePath("d.e", NULL));
+  EXPECT_EQ(2u, dict.size());
+  EXPECT_FALSE(dict.Equals(&map_dict));
+
+  dict.Swap(&map_dict);
+  EXPECT_EQ(DictionaryValue::STORAGE_MAP, dict.storage());
+  EXPECT_EQ(DictionaryValue::STORAGE_FLAT, map_dict.storage());
+  EXPECT_EQ(4u, dict.size());
+  EXPECT_EQ(2u, map_dict.size());
+
+  map_dict.Clear();
+  EXPECT_TRUE(map_dict.empty());
+}
+
 }  // namespace base
@@ -54,4 +54,27 @@ void AnimationRegistrar::UnregisterAnimationController(
   DidDeactivateAnimationController(controller);
 }
 
+void AnimationRegistrar::AnimateControllers(double monotonic_time) {
+  CopyActiveControllersToTick();
+  for (size_t i = 0; i < controllers_to_tick_.size(); ++i)
+    controllers_to_tick_[i]->Animate(monotonic_time);
+}
+
+void AnimationRegistrar::UpdateControllersState(
+    bool start_ready_animations,
+    AnimationEventsVector* events) {
+  CopyActiveControllersToTick();
+  for (size_t i = 0; i < controllers_to_tick_.size(); ++i)
+    controllers_to_tick_[i]->UpdateState(start_ready_animations, events);
+}
+
+void AnimationRegistrar::CopyActiveControllersToTick() {
+  controllers_to_tick_.clear();
+  for (AnimationControllerMap::const_iterator iter =
+           active_animation_controllers_.begin();
+       iter != active_animation_controllers_.end();
+       ++iter)
+    controllers_to_tick_.push_back(iter->second);
+}
+
 }  // namespace cc
@@ -5,9 +5,12 @@
 #ifndef CC_ANIMATION_ANIMATION_REGISTRAR_H_
 #define CC_ANIMATION_ANIMATION_REGISTRAR_H_
 
+#include <vector>
+
 #include "base/containers/hash_tables.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
+#include "cc/animation/animation_events.h"
 #include "cc/base/cc_export.h"
 
 namespace cc {
@@ -43,6 +46,14 @@ class CC_EXPORT AnimationRegistrar {
   // Unregisters the given controller as alive.
   void UnregisterAnimationController(LayerAnimationController* controller);
 
+  // Ticks the animations of all the active controllers.
+  void AnimateControllers(double monotonic_time);
+
+  // Updates the state of the animations of all the active controllers, which
+  // may deactivate some of them.
+  void UpdateControllersState(bool start_ready_animations,
+                              AnimationEventsVector* events);
+
   const AnimationControllerMap& active_animation_controllers() const {
     return active_animation_controllers_;
   }
@@ -54,9 +65,16 @@ class CC_EXPORT AnimationRegistrar {
  private:
   AnimationRegistrar();
 
+  // Copies the active controllers to |controllers_to_tick_|, so that they can
+  // deactivate while they are ticked.
+  void CopyActiveControllersToTick();
+
   AnimationControllerMap active_animation_controllers_;
   AnimationControllerMap all_animation_controllers_;
 
+  // Kept between frames to reuse its storage.
+  std::vector<LayerAnimationController*> controllers_to_tick_;
+
   DISALLOW_COPY_AND_ASSIGN(AnimationRegistrar);
 };
 
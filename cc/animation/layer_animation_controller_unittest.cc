@@ -180,6 +180,58 @@ TEST(LayerAnimationControllerTest, Activation) {
   controller_impl->SetAnimationRegistrar(NULL);
 }
 
+// Tests that the registrar ticks all the active controllers, and keeps
+// ticking the others when some of them deactivate.
+TEST(LayerAnimationControllerTest, RegistrarTicksActiveControllers) {
+  scoped_ptr<AnimationRegistrar> registrar = AnimationRegistrar::Create();
+  scoped_ptr<AnimationEventsVector> events(
+      make_scoped_ptr(new AnimationEventsVector));
+
+  FakeLayerAnimationValueObserver short_dummy;
+  scoped_refptr<LayerAnimationController> short_controller(
+      LayerAnimationController::Create(1));
+  short_controller->AddValueObserver(&short_dummy);
+  short_controller->SetAnimationRegistrar(registrar.get());
+  FakeLayerAnimationValueObserver long_dummy;
+  scoped_refptr<LayerAnimationController> long_controller(
+      LayerAnimationController::Create(2));
+  long_controller->AddValueObserver(&long_dummy);
+  long_controller->SetAnimationRegistrar(registrar.get());
+
+  scoped_ptr<Animation> short_animation(CreateAnimation(
+      scoped_ptr<AnimationCurve>(new FakeFloatTransition(1.0, 0.f, 1.f)),
+      1,
+      Animation::Opacity));
+  short_animation->set_is_impl_only(true);
+  short_controller->AddAnimation(short_animation.Pass());
+  scoped_ptr<Animation> long_animation(CreateAnimation(
+      scoped_ptr<AnimationCurve>(new FakeFloatTransition(2.0, 0.f, 1.f)),
+      2,
+      Animation::Opacity));
+  long_animation->set_is_impl_only(true);
+  long_controller->AddAnimation(long_animation.Pass());
+  EXPECT_EQ(2u, registrar->active_animation_controllers().size());
+
+  registrar->AnimateControllers(kInitialTickTime);
+  registrar->UpdateControllersState(true, events.get());
+  EXPECT_EQ(0.f, short_dummy.opacity());
+  EXPECT_EQ(0.f, long_dummy.opacity());
+
+  registrar->AnimateControllers(kInitialTickTime + 1.0);
+  registrar->UpdateControllersState(true, events.get());
+  EXPECT_EQ(1.f, short_dummy.opacity());
+  EXPECT_EQ(0.5f, long_dummy.opacity());
+  EXPECT_EQ(1u, registrar->active_animation_controllers().size());
+
+  registrar->AnimateControllers(kInitialTickTime + 2.0);
+  registrar->UpdateControllersState(true, events.get());
+  EXPECT_EQ(1.f, long_dummy.opacity());
+  EXPECT_EQ(0u, registrar->active_animation_controllers().size());
+
+  short_controller->SetAnimationRegistrar(NULL);
+  long_controller->SetAnimationRegistrar(NULL);
+}
+
 TEST(LayerAnimationControllerTest, SyncPause) {
   FakeLayerAnimationValueObserver dummy_impl;
   scoped_refptr<LayerAnimationController> controller_impl(
@@ -34,6 +34,10 @@ LatencyInfoSwapPromise::~LatencyInfoSwapPromise() {
 
 void LatencyInfoSwapPromise::DidSwap(CompositorFrameMetadata* metadata) {
   DCHECK(!latency_.terminated);
+  // Split the input-to-display latency at the compositor swap, so that the
+  // traced InputLatency shows how long scheduling and drawing took.
+  latency_.AddLatencyNumber(ui::INPUT_EVENT_LATENCY_RENDERER_SWAP_COMPONENT,
+                            0, 0);
   metadata->latency_info.push_back(latency_);
 }
 
@@ -147,6 +147,11 @@ const char kCCRebaselinePixeltests[] = "cc-rebaseline-pixeltests";
 // Disable textures using RGBA_4444 layout.
 const char kDisable4444Textures[] = "disable-4444-textures";
 
+// Compress opaque tiles far from the viewport to ETC1 when the GPU supports
+// it, to save memory.
+const char kEnableCompressedPrepaintTiles[] =
+    "enable-compressed-prepaint-tiles";
+
 // Disable touch hit testing in the compositor.
 const char kDisableCompositorTouchHitTesting[] =
     "disable-compositor-touch-hit-testing";
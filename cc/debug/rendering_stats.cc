@@ -10,7 +10,8 @@ namespace cc {
 MainThreadRenderingStats::MainThreadRenderingStats()
     : frame_count(0),
       painted_pixel_count(0),
-      recorded_pixel_count(0) {}
+      recorded_pixel_count(0),
+      recorded_picture_count(0) {}
 
 scoped_refptr<base::debug::ConvertableToTraceFormat>
 MainThreadRenderingStats::AsTraceableData() const {
@@ -20,6 +21,7 @@ MainThreadRenderingStats::AsTraceableData() const {
   record_data->SetInteger("painted_pixel_count", painted_pixel_count);
   record_data->SetDouble("record_time", record_time.InSecondsF());
   record_data->SetInteger("recorded_pixel_count", recorded_pixel_count);
+  record_data->SetInteger("recorded_picture_count", recorded_picture_count);
   return TracedValue::FromValue(record_data.release());
 }
 
@@ -29,11 +31,13 @@ void MainThreadRenderingStats::Add(const MainThreadRenderingStats& other) {
   painted_pixel_count += other.painted_pixel_count;
   record_time += other.record_time;
   recorded_pixel_count += other.recorded_pixel_count;
+  recorded_picture_count += other.recorded_picture_count;
 }
 
 ImplThreadRenderingStats::ImplThreadRenderingStats()
     : frame_count(0),
-      rasterized_pixel_count(0) {}
+      rasterized_pixel_count(0),
+      draw_call_count(0) {}
 
 scoped_refptr<base::debug::ConvertableToTraceFormat>
 ImplThreadRenderingStats::AsTraceableData() const {
@@ -41,6 +45,7 @@ ImplThreadRenderingStats::AsTraceableData() const {
   record_data->SetInteger("frame_count", frame_count);
   record_data->SetDouble("rasterize_time", rasterize_time.InSecondsF());
   record_data->SetInteger("rasterized_pixel_count", rasterized_pixel_count);
+  record_data->SetInteger("draw_call_count", draw_call_count);
   return TracedValue::FromValue(record_data.release());
 }
 
@@ -49,6 +54,7 @@ void ImplThreadRenderingStats::Add(const ImplThreadRenderingStats& other) {
   rasterize_time += other.rasterize_time;
   analysis_time += other.analysis_time;
   rasterized_pixel_count += other.rasterized_pixel_count;
+  draw_call_count += other.draw_call_count;
 }
 
 void RenderingStats::Add(const RenderingStats& other) {
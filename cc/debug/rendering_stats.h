@@ -21,6 +21,7 @@ struct CC_EXPORT MainThreadRenderingStats {
   int64 painted_pixel_count;
   base::TimeDelta record_time;
   int64 recorded_pixel_count;
+  int64 recorded_picture_count;
 
   MainThreadRenderingStats();
   scoped_refptr<base::debug::ConvertableToTraceFormat> AsTraceableData() const;
@@ -35,6 +36,7 @@ struct CC_EXPORT ImplThreadRenderingStats {
   base::TimeDelta rasterize_time;
   base::TimeDelta analysis_time;
   int64 rasterized_pixel_count;
+  int64 draw_call_count;
 
   ImplThreadRenderingStats();
   scoped_refptr<base::debug::ConvertableToTraceFormat> AsTraceableData() const;
@@ -87,6 +87,7 @@ void RenderingStatsInstrumentation::AddRecord(base::TimeDelta duration,
   base::AutoLock scoped_lock(lock_);
   main_stats_.record_time += duration;
   main_stats_.recorded_pixel_count += pixels;
+  main_stats_.recorded_picture_count++;
 }
 
 void RenderingStatsInstrumentation::AddRaster(base::TimeDelta duration,
@@ -108,4 +109,12 @@ void RenderingStatsInstrumentation::AddAnalysis(base::TimeDelta duration,
   impl_stats_.analysis_time += duration;
 }
 
+void RenderingStatsInstrumentation::AddDrawCalls(int64 count) {
+  if (!record_rendering_stats_)
+    return;
+
+  base::AutoLock scoped_lock(lock_);
+  impl_stats_.draw_call_count += count;
+}
+
 }  // namespace cc
@@ -261,6 +261,10 @@ void DelegatedRendererLayerImpl::AppendContributingRenderPasses(
         render_passes_in_draw_order_[i]->Copy(output_render_pass_id);
     copy_pass->transform_to_root_target.ConcatTransform(
         delegated_frame_to_root_transform);
+    // The damage of the pass is relative to the previous frame of the child,
+    // which may never have been drawn, so it can't tell whether the contents
+    // drawn for the pass can be reused.
+    copy_pass->damage_rect = copy_pass->output_rect;
     render_pass_sink->AppendRenderPass(copy_pass.Pass());
   }
 }
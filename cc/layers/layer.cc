@@ -36,6 +36,7 @@ scoped_refptr<Layer> Layer::Create() {
 Layer::Layer()
     : needs_push_properties_(false),
       num_dependents_need_push_properties_(false),
+      changed_properties_(ALL_PROPERTIES_CHANGED),
       stacking_order_changed_(false),
       layer_id_(s_next_layer_id++),
       ignore_set_needs_commit_(false),
@@ -485,6 +486,7 @@ void Layer::SetFilters(const FilterOperations& filters) {
   if (filters_ == filters)
     return;
   filters_ = filters;
+  NotePropertyChanged(FILTERS_CHANGED);
   SetNeedsCommit();
   SetNeedsFilterContextIfNeeded();
 }
@@ -498,6 +500,7 @@ void Layer::SetBackgroundFilters(const FilterOperations& filters) {
   if (background_filters_ == filters)
     return;
   background_filters_ = filters;
+  NotePropertyChanged(BACKGROUND_FILTERS_CHANGED);
   SetNeedsCommit();
   SetNeedsFilterContextIfNeeded();
 }
@@ -632,6 +635,7 @@ void Layer::AddScrollChild(Layer* child) {
   if (!scroll_children_)
     scroll_children_.reset(new std::set<Layer*>);
   scroll_children_->insert(child);
+  NotePropertyChanged(SCROLL_CHILDREN_CHANGED);
   SetNeedsCommit();
 }
 
@@ -639,6 +643,7 @@ void Layer::RemoveScrollChild(Layer* child) {
   scroll_children_->erase(child);
   if (scroll_children_->empty())
     scroll_children_.reset();
+  NotePropertyChanged(SCROLL_CHILDREN_CHANGED);
   SetNeedsCommit();
 }
 
@@ -662,6 +667,7 @@ void Layer::AddClipChild(Layer* child) {
   if (!clip_children_)
     clip_children_.reset(new std::set<Layer*>);
   clip_children_->insert(child);
+  NotePropertyChanged(CLIP_CHILDREN_CHANGED);
   SetNeedsCommit();
 }
 
@@ -669,6 +675,7 @@ void Layer::RemoveClipChild(Layer* child) {
   clip_children_->erase(child);
   if (clip_children_->empty())
     clip_children_.reset();
+  NotePropertyChanged(CLIP_CHILDREN_CHANGED);
   SetNeedsCommit();
 }
 
@@ -774,6 +781,7 @@ void Layer::SetNonFastScrollableRegion(const Region& region) {
   if (non_fast_scrollable_region_ == region)
     return;
   non_fast_scrollable_region_ = region;
+  NotePropertyChanged(NON_FAST_SCROLLABLE_REGION_CHANGED);
   SetNeedsCommit();
 }
 
@@ -782,6 +790,7 @@ void Layer::SetTouchEventHandlerRegion(const Region& region) {
   if (touch_event_handler_region_ == region)
     return;
   touch_event_handler_region_ = region;
+  NotePropertyChanged(TOUCH_EVENT_HANDLER_REGION_CHANGED);
   SetNeedsCommit();
 }
 
@@ -927,15 +936,23 @@ void Layer::PushPropertiesTo(LayerImpl* layer) {
   layer->SetForceRenderSurface(force_render_surface_);
   layer->SetDrawsContent(DrawsContent());
   layer->SetHideLayerAndSubtree(hide_layer_and_subtree_);
-  if (!layer->FilterIsAnimatingOnImplOnly() && !FilterIsAnimating())
+  // The filters are only pushed once their animation finished, so they stay
+  // marked as changed until then.
+  if (PropertyChanged(FILTERS_CHANGED) &&
+      !layer->FilterIsAnimatingOnImplOnly() && !FilterIsAnimating()) {
     layer->SetFilters(filters_);
+    changed_properties_ &= ~FILTERS_CHANGED;
+  }
   DCHECK(!(FilterIsAnimating() && layer->FilterIsAnimatingOnImplOnly()));
-  layer->SetBackgroundFilters(background_filters());
+  if (PropertyChanged(BACKGROUND_FILTERS_CHANGED))
+    layer->SetBackgroundFilters(background_filters());
   layer->SetMasksToBounds(masks_to_bounds_);
   layer->SetShouldScrollOnMainThread(should_scroll_on_main_thread_);
   layer->SetHaveWheelEventHandlers(have_wheel_event_handlers_);
-  layer->SetNonFastScrollableRegion(non_fast_scrollable_region_);
-  layer->SetTouchEventHandlerRegion(touch_event_handler_region_);
+  if (PropertyChanged(NON_FAST_SCROLLABLE_REGION_CHANGED))
+    layer->SetNonFastScrollableRegion(non_fast_scrollable_region_);
+  if (PropertyChanged(TOUCH_EVENT_HANDLER_REGION_CHANGED))
+    layer->SetTouchEventHandlerRegion(touch_event_handler_region_);
   layer->SetContentsOpaque(contents_opaque_);
   if (!layer->OpacityIsAnimatingOnImplOnly() && !OpacityIsAnimating())
     layer->SetOpacity(opacity_);
@@ -963,7 +980,7 @@ void Layer::PushPropertiesTo(LayerImpl* layer) {
     scroll_parent = layer->layer_tree_impl()->LayerById(scroll_parent_->id());
 
   layer->SetScrollParent(scroll_parent);
-  if (scroll_children_) {
+  if (scroll_children_ && PropertyChanged(SCROLL_CHILDREN_CHANGED)) {
     std::set<LayerImpl*>* scroll_children = new std::set<LayerImpl*>;
     for (std::set<Layer*>::iterator it = scroll_children_->begin();
         it != scroll_children_->end(); ++it)
@@ -978,7 +995,7 @@ void Layer::PushPropertiesTo(LayerImpl* layer) {
   }
 
   layer->SetClipParent(clip_parent);
-  if (clip_children_) {
+  if (clip_children_ && PropertyChanged(CLIP_CHILDREN_CHANGED)) {
     std::set<LayerImpl*>* clip_children = new std::set<LayerImpl*>;
     for (std::set<Layer*>::iterator it = clip_children_->begin();
         it != clip_children_->end(); ++it) {
@@ -1035,11 +1052,26 @@ void Layer::PushPropertiesTo(LayerImpl* layer) {
   // Reset any state that should be cleared for the next update.
   stacking_order_changed_ = false;
   update_rect_ = gfx::RectF();
+  changed_properties_ &= FILTERS_CHANGED;
 
   needs_push_properties_ = false;
   num_dependents_need_push_properties_ = 0;
 }
 
+void Layer::DidSynchronizeLayerImpl(bool layer_impl_created) {
+  if (layer_impl_created) {
+    changed_properties_ = ALL_PROPERTIES_CHANGED;
+    return;
+  }
+
+  // The LayerImpls of the children may have been destroyed and recreated,
+  // and destroyed LayerImpls remove themselves from the sets of their parents.
+  if (scroll_children_)
+    NotePropertyChanged(SCROLL_CHILDREN_CHANGED);
+  if (clip_children_)
+    NotePropertyChanged(CLIP_CHILDREN_CHANGED);
+}
+
 scoped_ptr<LayerImpl> Layer::CreateLayerImpl(LayerTreeImpl* tree_impl) {
   return LayerImpl::Create(tree_impl, layer_id_);
 }
@@ -1098,6 +1130,7 @@ gfx::Vector2dF Layer::ScrollOffsetForAnimation() const {
 // set directly rather than by calling Set<Property>.
 void Layer::OnFilterAnimated(const FilterOperations& filters) {
   filters_ = filters;
+  NotePropertyChanged(FILTERS_CHANGED);
 }
 
 void Layer::OnOpacityAnimated(float opacity) {
@@ -445,6 +445,11 @@ class CC_EXPORT Layer : public base::RefCounted<Layer>,
     return num_dependents_need_push_properties_ > 0;
   }
 
+  // Called by the TreeSynchronizer after it matched this layer with a
+  // LayerImpl. A LayerImpl that was just created needs every property pushed,
+  // and the scroll and clip children of this layer may have new LayerImpls.
+  void DidSynchronizeLayerImpl(bool layer_impl_created);
+
   virtual void RunMicroBenchmark(MicroBenchmark* benchmark);
 
  protected:
@@ -485,6 +490,28 @@ class CC_EXPORT Layer : public base::RefCounted<Layer>,
 
   bool IsPropertyChangeAllowed() const;
 
+  // The properties which are expensive to push, and so are only pushed to the
+  // LayerImpl when they changed since the last push.
+  enum ChangedProperty {
+    FILTERS_CHANGED = 1 << 0,
+    BACKGROUND_FILTERS_CHANGED = 1 << 1,
+    NON_FAST_SCROLLABLE_REGION_CHANGED = 1 << 2,
+    TOUCH_EVENT_HANDLER_REGION_CHANGED = 1 << 3,
+    SCROLL_CHILDREN_CHANGED = 1 << 4,
+    CLIP_CHILDREN_CHANGED = 1 << 5,
+    // The contents pushed by subclasses, like the pile of a PictureLayer.
+    CONTENTS_CHANGED = 1 << 6,
+    ALL_PROPERTIES_CHANGED = (1 << 7) - 1
+  };
+  void NotePropertyChanged(ChangedProperty property) {
+    changed_properties_ |= property;
+  }
+  // Subclasses need to check this before calling Layer::PushPropertiesTo(),
+  // which forgets about the changes.
+  bool PropertyChanged(ChangedProperty property) const {
+    return (changed_properties_ & property) != 0;
+  }
+
   // If this layer has a scroll parent, it removes |this| from its list of
   // scroll children.
   void RemoveFromScrollTree();
@@ -504,6 +531,9 @@ class CC_EXPORT Layer : public base::RefCounted<Layer>,
   // side.
   int num_dependents_need_push_properties_;
 
+  // The ChangedProperty bits of the properties to push.
+  unsigned changed_properties_;
+
   // Tracks whether this layer may have changed stacking order with its
   // siblings.
   bool stacking_order_changed_;
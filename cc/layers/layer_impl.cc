@@ -53,6 +53,7 @@ LayerImpl::LayerImpl(LayerTreeImpl* tree_impl, int id)
       double_sided_(true),
       should_flatten_transform_(true),
       layer_property_changed_(false),
+      subtree_structure_changed_(true),
       masks_to_bounds_(false),
       contents_opaque_(false),
       is_root_for_isolated_group_(false),
@@ -69,7 +70,10 @@ LayerImpl::LayerImpl(LayerTreeImpl* tree_impl, int id)
       draw_depth_(0.f),
       needs_push_properties_(false),
       num_dependents_need_push_properties_(0),
-      current_draw_mode_(DRAW_MODE_NONE) {
+      current_draw_mode_(DRAW_MODE_NONE),
+      transform_tree_index_(-1),
+      clip_tree_index_(-1),
+      effect_tree_index_(-1) {
   DCHECK_GT(layer_id_, 0);
   DCHECK(layer_tree_impl_);
   layer_tree_impl_->RegisterLayer(this);
@@ -119,6 +123,7 @@ void LayerImpl::AddChild(scoped_ptr<LayerImpl> child) {
   child->SetParent(this);
   DCHECK_EQ(layer_tree_impl(), child->layer_tree_impl());
   children_.push_back(child.Pass());
+  NoteSubtreeStructureChanged();
   layer_tree_impl()->set_needs_update_draw_properties();
 }
 
@@ -129,6 +134,7 @@ scoped_ptr<LayerImpl> LayerImpl::RemoveChild(LayerImpl* child) {
     if (*it == child) {
       scoped_ptr<LayerImpl> ret = children_.take(it);
       children_.erase(it);
+      NoteSubtreeStructureChanged();
       layer_tree_impl()->set_needs_update_draw_properties();
       return ret.Pass();
     }
@@ -151,6 +157,7 @@ void LayerImpl::ClearChildList() {
     return;
 
   children_.clear();
+  NoteSubtreeStructureChanged();
   layer_tree_impl()->set_needs_update_draw_properties();
 }
 
@@ -177,6 +184,7 @@ void LayerImpl::SetScrollParent(LayerImpl* parent) {
     scroll_parent_->RemoveScrollChild(this);
 
   scroll_parent_ = parent;
+  NoteSubtreeStructureChanged();
   SetNeedsPushProperties();
 }
 
@@ -209,6 +217,7 @@ void LayerImpl::SetClipParent(LayerImpl* ancestor) {
     clip_parent_->RemoveClipChild(this);
 
   clip_parent_ = ancestor;
+  NoteSubtreeStructureChanged();
   SetNeedsPushProperties();
 }
 
@@ -216,6 +225,7 @@ void LayerImpl::SetClipChildren(std::set<LayerImpl*>* children) {
   if (clip_children_.get() == children)
     return;
   clip_children_.reset(children);
+  NoteSubtreeStructureChanged();
   SetNeedsPushProperties();
 }
 
@@ -237,6 +247,7 @@ void LayerImpl::PassCopyRequests(ScopedPtrVector<CopyOutputRequest>* requests) {
 
   if (was_empty && layer_tree_impl()->IsActiveTree())
     layer_tree_impl()->AddLayerWithCopyOutputRequest(this);
+  NoteSubtreeStructureChanged();
   NoteLayerPropertyChangedForSubtree();
 }
 
@@ -248,6 +259,7 @@ void LayerImpl::TakeCopyRequestsAndTransformToTarget(
   size_t first_inserted_request = requests->size();
   requests->insert_and_take(requests->end(), copy_requests_);
   copy_requests_.clear();
+  NoteSubtreeStructureChanged();
 
   for (size_t i = first_inserted_request; i < requests->size(); ++i) {
     CopyOutputRequest* request = requests->at(i);
@@ -680,6 +692,14 @@ void LayerImpl::NoteLayerPropertyChangedForSubtree() {
   SetNeedsPushProperties();
 }
 
+void LayerImpl::NoteSubtreeStructureChanged() {
+  // The ancestors of a marked layer are always marked, so stop at the first
+  // one.
+  for (LayerImpl* layer = this; layer && !layer->subtree_structure_changed_;
+       layer = layer->parent())
+    layer->subtree_structure_changed_ = true;
+}
+
 void LayerImpl::NoteLayerPropertyChangedForDescendantsInternal() {
   layer_property_changed_ = true;
   for (size_t i = 0; i < children_.size(); ++i)
@@ -824,6 +844,7 @@ void LayerImpl::SetDrawsContent(bool draws_content) {
     return;
 
   draws_content_ = draws_content;
+  NoteSubtreeStructureChanged();
   NoteLayerPropertyChanged();
 }
 
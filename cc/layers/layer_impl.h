@@ -47,6 +47,8 @@ namespace cc {
 class LayerTreeHostImpl;
 class LayerTreeImpl;
 class MicroBenchmarkImpl;
+template <typename LayerType, typename SurfaceType>
+class OcclusionTrackerBase;
 class QuadSink;
 class Renderer;
 class ScrollbarAnimationController;
@@ -179,7 +181,11 @@ class CC_EXPORT LayerImpl : public LayerAnimationValueObserver,
   virtual RenderPass::Id FirstContributingRenderPassId() const;
   virtual RenderPass::Id NextContributingRenderPassId(RenderPass::Id id) const;
 
-  virtual void UpdateTilePriorities() {}
+  // |occlusion_tracker| is at this layer in a front-to-back traversal of the
+  // layers, or NULL if occlusion isn't taken into account.
+  virtual void UpdateTilePriorities(
+      const OcclusionTrackerBase<LayerImpl, RenderSurfaceImpl>*
+          occlusion_tracker) {}
 
   virtual ScrollbarLayerImplBase* ToScrollbarLayer();
 
@@ -290,6 +296,15 @@ class CC_EXPORT LayerImpl : public LayerAnimationValueObserver,
     return draw_properties_;
   }
 
+  // The nodes of the layer tree's PropertyTrees that apply to this layer, or
+  // -1 if they haven't been built. See PropertyTreeBuilder.
+  void set_transform_tree_index(int index) { transform_tree_index_ = index; }
+  int transform_tree_index() const { return transform_tree_index_; }
+  void set_clip_tree_index(int index) { clip_tree_index_ = index; }
+  int clip_tree_index() const { return clip_tree_index_; }
+  void set_effect_tree_index(int index) { effect_tree_index_ = index; }
+  int effect_tree_index() const { return effect_tree_index_; }
+
   // The following are shortcut accessors to get various information from
   // draw_properties_
   const gfx::Transform& draw_transform() const {
@@ -455,6 +470,15 @@ class CC_EXPORT LayerImpl : public LayerAnimationValueObserver,
 
   void ResetAllChangeTrackingForSubtree();
 
+  // Tracks whether the children, clip and scroll relationships, DrawsContent()
+  // or copy requests of this layer or one of its descendants changed since
+  // LayerTreeHostCommon last computed the draw properties that summarize
+  // them (like num_descendants_that_draw_content). Noting a change marks this
+  // layer and all its ancestors.
+  void NoteSubtreeStructureChanged();
+  bool subtree_structure_changed() const { return subtree_structure_changed_; }
+  void ClearSubtreeStructureChanged() { subtree_structure_changed_ = false; }
+
   virtual bool LayerIsAlwaysDamaged() const;
 
   LayerAnimationController* layer_animation_controller() {
@@ -590,6 +614,7 @@ class CC_EXPORT LayerImpl : public LayerAnimationValueObserver,
 
   // Tracks if drawing-related properties have changed since last redraw.
   bool layer_property_changed_ : 1;
+  bool subtree_structure_changed_ : 1;
 
   bool masks_to_bounds_ : 1;
   bool contents_opaque_ : 1;
@@ -663,6 +688,10 @@ class CC_EXPORT LayerImpl : public LayerAnimationValueObserver,
   // hierarchy before layers can be drawn.
   DrawProperties<LayerImpl> draw_properties_;
 
+  int transform_tree_index_;
+  int clip_tree_index_;
+  int effect_tree_index_;
+
   scoped_refptr<base::debug::ConvertableToTraceFormat> debug_info_;
 
   DISALLOW_COPY_AND_ASSIGN(LayerImpl);
@@ -764,6 +764,32 @@ TEST_F(LayerTest,
   EXPECT_FALSE(impl_layer->LayerPropertyChanged());
 }
 
+TEST_F(LayerTest, PushPropertiesOnlyPushesChangedRegions) {
+  scoped_refptr<Layer> test_layer = Layer::Create();
+  scoped_ptr<LayerImpl> impl_layer =
+      LayerImpl::Create(host_impl_.active_tree(), 1);
+
+  EXPECT_SET_NEEDS_FULL_TREE_SYNC(1,
+                                  layer_tree_host_->SetRootLayer(test_layer));
+
+  Region region(gfx::Rect(0, 0, 10, 10));
+  EXPECT_SET_NEEDS_COMMIT(1, test_layer->SetTouchEventHandlerRegion(region));
+  test_layer->PushPropertiesTo(impl_layer.get());
+  EXPECT_EQ(region, impl_layer->touch_event_handler_region());
+
+  // An unchanged region isn't pushed again, so the LayerImpl keeps its value.
+  Region impl_region(gfx::Rect(5, 5, 10, 10));
+  impl_layer->SetTouchEventHandlerRegion(impl_region);
+  EXPECT_SET_NEEDS_COMMIT(1, test_layer->SetOpacity(0.5f));
+  test_layer->PushPropertiesTo(impl_layer.get());
+  EXPECT_EQ(impl_region, impl_layer->touch_event_handler_region());
+
+  // A new LayerImpl gets every property.
+  test_layer->DidSynchronizeLayerImpl(true);
+  test_layer->PushPropertiesTo(impl_layer.get());
+  EXPECT_EQ(region, impl_layer->touch_event_handler_region());
+}
+
 TEST_F(LayerTest, MaskAndReplicaHasParent) {
   scoped_refptr<Layer> parent = Layer::Create();
   scoped_refptr<Layer> child = Layer::Create();
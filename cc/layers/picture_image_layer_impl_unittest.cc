@@ -100,7 +100,7 @@ TEST_F(PictureImageLayerImplTest, AreVisibleResourcesReady) {
   layer->CalculateContentsScale(2.f, 3.f, 4.f, false,
                                 &contents_scale_x, &contents_scale_y,
                                 &content_bounds);
-  layer->UpdateTilePriorities();
+  layer->UpdateTilePriorities(NULL);
 
   EXPECT_TRUE(layer->AreVisibleResourcesReady());
 }
@@ -35,6 +35,9 @@ scoped_ptr<LayerImpl> PictureLayer::CreateLayerImpl(LayerTreeImpl* tree_impl) {
 }
 
 void PictureLayer::PushPropertiesTo(LayerImpl* base_layer) {
+  // The pile is only copied when it changed since the last push, or when
+  // |base_layer| was just created. Otherwise |base_layer| keeps its copy.
+  bool pile_changed = PropertyChanged(CONTENTS_CHANGED);
   Layer::PushPropertiesTo(base_layer);
   PictureLayerImpl* layer_impl = static_cast<PictureLayerImpl*>(base_layer);
 
@@ -44,6 +47,7 @@ void PictureLayer::PushPropertiesTo(LayerImpl* base_layer) {
     // may disagree and either one could have been pushed to layer_impl.
     pile_->Resize(gfx::Size());
     pile_->UpdateRecordedRegion();
+    pile_changed = true;
   } else if (update_source_frame_number_ ==
              layer_tree_host()->source_frame_number()) {
     // If update called, then pile size must match bounds pushed to impl layer.
@@ -51,22 +55,28 @@ void PictureLayer::PushPropertiesTo(LayerImpl* base_layer) {
   }
 
   layer_impl->SetIsMask(is_mask_);
+  layer_impl->SetShouldUseGpuRasterization(
+      layer_tree_host()->settings().gpu_rasterization &&
+      pile_->is_suitable_for_gpu_rasterization());
   // Unlike other properties, invalidation must always be set on layer_impl.
   // See PictureLayerImpl::PushPropertiesTo for more details.
   layer_impl->invalidation_.Clear();
   layer_impl->invalidation_.Swap(&pile_invalidation_);
-  layer_impl->pile_ = PicturePileImpl::CreateFromOther(pile_.get());
+  if (pile_changed)
+    layer_impl->pile_ = PicturePileImpl::CreateFromOther(pile_.get());
 }
 
 void PictureLayer::SetLayerTreeHost(LayerTreeHost* host) {
   Layer::SetLayerTreeHost(host);
   if (host) {
+    NotePropertyChanged(CONTENTS_CHANGED);
     pile_->SetMinContentsScale(host->settings().minimum_contents_scale);
     pile_->SetTileGridSize(host->settings().default_tile_size);
     pile_->set_slow_down_raster_scale_factor(
         host->debug_state().slow_down_raster_scale_factor);
     pile_->set_show_debug_picture_borders(
         host->debug_state().show_picture_borders);
+    pile_->set_analyze_for_gpu_rasterization(host->settings().gpu_rasterization);
   }
 }
 
@@ -97,6 +107,7 @@ bool PictureLayer::Update(ResourceUpdateQueue* queue,
                layer_tree_host()->source_frame_number());
 
   pile_->Resize(paint_properties().bounds);
+  NotePropertyChanged(CONTENTS_CHANGED);
 
   // Calling paint in WebKit can sometimes cause invalidations, so save
   // off the invalidation prior to calling update.
@@ -22,6 +22,7 @@
 #include "cc/quads/tile_draw_quad.h"
 #include "cc/resources/tile_manager.h"
 #include "cc/trees/layer_tree_impl.h"
+#include "cc/trees/occlusion_tracker.h"
 #include "ui/gfx/quad_f.h"
 #include "ui/gfx/rect_conversions.h"
 #include "ui/gfx/size_conversions.h"
@@ -91,6 +92,8 @@ void PictureLayerImpl::PushPropertiesTo(LayerImpl* base_layer) {
 
   layer_impl->SetIsMask(is_mask_);
   layer_impl->pile_ = pile_;
+  // The tilings pushed below were created for this layer's raster mode.
+  layer_impl->should_use_gpu_rasterization_ = should_use_gpu_rasterization_;
 
   // Tilings would be expensive to push, so we swap.  This optimization requires
   // an extra invalidation in SyncFromActiveLayer.
@@ -251,7 +254,7 @@ void PictureLayerImpl::AppendQuads(QuadSink* quad_sink,
                      opaque_rect,
                      tile_version.get_resource_id(),
                      texture_rect,
-                     iter.texture_size(),
+                     tile_version.get_resource_size(),
                      tile_version.contents_swizzled());
         draw_quad = quad.PassAs<DrawQuad>();
         break;
@@ -303,7 +306,8 @@ void PictureLayerImpl::AppendQuads(QuadSink* quad_sink,
   CleanUpTilingsOnActiveLayer(seen_tilings);
 }
 
-void PictureLayerImpl::UpdateTilePriorities() {
+void PictureLayerImpl::UpdateTilePriorities(
+    const OcclusionTrackerImpl* occlusion_tracker) {
   DCHECK(!needs_post_commit_initialization_);
   CHECK(should_update_tile_priorities_);
 
@@ -353,7 +357,10 @@ void PictureLayerImpl::UpdateTilePriorities() {
   tilings_->UpdateTilePriorities(tree,
                                  visible_rect_in_content_space,
                                  contents_scale_x(),
-                                 current_frame_time_in_seconds);
+                                 current_frame_time_in_seconds,
+                                 occlusion_tracker,
+                                 render_target(),
+                                 draw_transform());
 
   if (layer_tree_impl()->IsPendingTree())
     MarkVisibleResourcesAsRequired();
@@ -469,6 +476,9 @@ scoped_refptr<Tile> PictureLayerImpl::CreateTile(PictureLayerTiling* tiling,
     flags |= Tile::USE_LCD_TEXT;
   if (should_use_gpu_rasterization())
     flags |= Tile::USE_GPU_RASTERIZATION;
+  // Masks are sampled over their whole texture.
+  if (is_mask_)
+    flags |= Tile::NEEDS_EXACT_SIZE_RESOURCE;
   return layer_tree_impl()->tile_manager()->CreateTile(
       pile_.get(),
       content_rect.size(),
@@ -635,7 +645,7 @@ void PictureLayerImpl::SyncTiling(
   // we can create tiles for this tiling immediately.
   if (!layer_tree_impl()->needs_update_draw_properties() &&
       should_update_tile_priorities_)
-    UpdateTilePriorities();
+    UpdateTilePriorities(NULL);
 }
 
 void PictureLayerImpl::SetIsMask(bool is_mask) {
@@ -794,6 +804,10 @@ bool PictureLayerImpl::MarkVisibleTilesAsRequired(
     if (!missing_region.Intersects(iter.geometry_rect()))
       continue;
 
+    // Occluded tiles aren't drawn, so they aren't needed either.
+    if (tile->is_occluded(PENDING_TREE))
+      continue;
+
     // If the twin tile doesn't exist (i.e. missing recording or so far away
     // that it is outside the visible tile rect) or this tile is shared between
     // with the twin, then this tile isn't required to prevent flashing.
@@ -4,6 +4,7 @@
 
 #include "cc/layers/picture_layer_impl.h"
 
+#include <limits>
 #include <utility>
 
 #include "cc/layers/append_quads_data.h"
@@ -311,7 +312,7 @@ TEST_F(PictureLayerImplTest, SuppressUpdateTilePriorities) {
                                         &dummy_content_bounds);
 
   EXPECT_TRUE(host_impl_.manage_tiles_needed());
-  active_layer_->UpdateTilePriorities();
+  active_layer_->UpdateTilePriorities(NULL);
   host_impl_.ManageTiles();
   EXPECT_FALSE(host_impl_.manage_tiles_needed());
 
@@ -324,7 +325,7 @@ TEST_F(PictureLayerImplTest, SuppressUpdateTilePriorities) {
                                         gfx::Rect(layer_bounds),
                                         gfx::Rect(layer_bounds),
                                         valid_for_tile_management);
-  active_layer_->UpdateTilePriorities();
+  active_layer_->UpdateTilePriorities(NULL);
   EXPECT_FALSE(host_impl_.manage_tiles_needed());
 
   time_ticks += base::TimeDelta::FromMilliseconds(200);
@@ -335,7 +336,7 @@ TEST_F(PictureLayerImplTest, SuppressUpdateTilePriorities) {
                                         gfx::Rect(layer_bounds),
                                         gfx::Rect(layer_bounds),
                                         valid_for_tile_management);
-  active_layer_->UpdateTilePriorities();
+  active_layer_->UpdateTilePriorities(NULL);
   EXPECT_TRUE(host_impl_.manage_tiles_needed());
 }
 
@@ -1512,6 +1513,65 @@ TEST_F(PictureLayerImplTest, PinchingTooSmall) {
                   pending_layer_->HighResTiling()->contents_scale());
 }
 
+class OcclusionTrackingSettings : public ImplSidePaintingSettings {
+ public:
+  OcclusionTrackingSettings() { use_occlusion_for_tile_prioritization = true; }
+};
+
+class OcclusionTrackingPictureLayerImplTest : public PictureLayerImplTest {
+ public:
+  OcclusionTrackingPictureLayerImplTest()
+      : PictureLayerImplTest(OcclusionTrackingSettings()) {}
+};
+
+TEST_F(OcclusionTrackingPictureLayerImplTest, OccludedTilesAreNotRequired) {
+  gfx::Size tile_size(100, 100);
+  gfx::Size layer_bounds(400, 400);
+  host_impl_.SetViewportSize(layer_bounds);
+
+  scoped_refptr<FakePicturePileImpl> pending_pile =
+      FakePicturePileImpl::CreateFilledPile(tile_size, layer_bounds);
+  SetupPendingTree(pending_pile);
+  pending_layer_->set_fixed_tile_size(tile_size);
+
+  // An opaque layer, like a fixed header, covering the bottom of the layer.
+  gfx::Rect occluded_rect(0, 190, 400, 210);
+  scoped_ptr<LayerImpl> occluder =
+      LayerImpl::Create(host_impl_.pending_tree(), id_ + 1);
+  occluder->SetBounds(occluded_rect.size());
+  occluder->SetPosition(occluded_rect.origin());
+  occluder->SetContentsOpaque(true);
+  occluder->SetDrawsContent(true);
+  pending_layer_->AddChild(occluder.Pass());
+
+  PictureLayerTiling* tiling = pending_layer_->AddTiling(1.f);
+  host_impl_.pending_tree()->UpdateDrawProperties();
+
+  int num_occluded = 0;
+  int num_visible = 0;
+  std::vector<Tile*> tiles = tiling->AllTilesForTesting();
+  for (size_t i = 0; i < tiles.size(); ++i) {
+    const Tile* tile = tiles[i];
+    TilePriority priority = tile->priority(PENDING_TREE);
+    if (occluded_rect.Contains(tile->content_rect())) {
+      EXPECT_TRUE(tile->is_occluded(PENDING_TREE));
+      EXPECT_EQ(TilePriority::EVENTUALLY, priority.priority_bin);
+      EXPECT_EQ(std::numeric_limits<float>::infinity(),
+                priority.distance_to_visible);
+      EXPECT_FALSE(tile->required_for_activation());
+      num_occluded++;
+    } else {
+      EXPECT_FALSE(tile->is_occluded(PENDING_TREE));
+      EXPECT_EQ(TilePriority::NOW, priority.priority_bin);
+      EXPECT_TRUE(tile->required_for_activation());
+      num_visible++;
+    }
+  }
+
+  EXPECT_GT(num_occluded, 0);
+  EXPECT_GT(num_visible, 0);
+}
+
 class DeferredInitPictureLayerImplTest : public PictureLayerImplTest {
  public:
   DeferredInitPictureLayerImplTest()
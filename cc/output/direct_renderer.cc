@@ -133,7 +133,9 @@ DirectRenderer::DirectRenderer(RendererClient* client,
                                ResourceProvider* resource_provider)
     : Renderer(client, settings),
       output_surface_(output_surface),
-      resource_provider_(resource_provider) {}
+      resource_provider_(resource_provider),
+      overlay_processor_(
+          new OverlayProcessor(output_surface, resource_provider)) {}
 
 DirectRenderer::~DirectRenderer() {}
 
@@ -180,8 +182,10 @@ void DirectRenderer::DecideRenderPassAllocationsForFrame(
 
   // Delete RenderPass textures from the previous frame that will not be used
   // again.
-  for (size_t i = 0; i < passes_to_delete.size(); ++i)
+  for (size_t i = 0; i < passes_to_delete.size(); ++i) {
     render_pass_textures_.erase(passes_to_delete[i]);
+    complete_render_pass_textures_.erase(passes_to_delete[i]);
+  }
 
   for (size_t i = 0; i < render_passes_in_draw_order.size(); ++i) {
     if (!render_pass_textures_.contains(render_passes_in_draw_order[i]->id)) {
@@ -208,6 +212,8 @@ void DirectRenderer::DrawFrame(RenderPassList* render_passes_in_draw_order,
   DCHECK(root_render_pass);
 
   DrawingFrame frame;
+  overlay_processor_->ProcessForOverlays(render_passes_in_draw_order,
+                                         &frame.overlay_list);
   frame.root_render_pass = root_render_pass;
   frame.root_damage_rect =
       Capabilities().using_partial_swap && allow_partial_swap
@@ -228,8 +234,13 @@ void DirectRenderer::DrawFrame(RenderPassList* render_passes_in_draw_order,
   output_surface_->Reshape(device_viewport_rect.size(), device_scale_factor);
 
   BeginDrawingFrame(&frame);
+  int reused_render_pass_count = 0;
   for (size_t i = 0; i < render_passes_in_draw_order->size(); ++i) {
     RenderPass* pass = render_passes_in_draw_order->at(i);
+    if (CanReuseRenderPassTexture(pass)) {
+      reused_render_pass_count++;
+      continue;
+    }
     DrawRenderPass(&frame, pass, allow_partial_swap);
 
     for (ScopedPtrVector<CopyOutputRequest>::iterator it =
@@ -245,6 +256,10 @@ void DirectRenderer::DrawFrame(RenderPassList* render_passes_in_draw_order,
     }
   }
   FinishDrawingFrame(&frame);
+  TRACE_COUNTER_ID1("cc",
+                    "ReusedRenderPassCount",
+                    this,
+                    reused_render_pass_count);
 
   render_passes_in_draw_order->clear();
 }
@@ -388,6 +403,20 @@ void DirectRenderer::DrawRenderPass(DrawingFrame* frame,
       DoDrawQuad(frame, *it);
   }
   FinishDrawingQuadList();
+
+  if (render_pass == frame->root_render_pass)
+    return;
+
+  // Only textures that were drawn everywhere can be reused.
+  if (settings_->cache_render_pass_contents && draw_rect_covers_full_surface) {
+    CompleteRenderPassTexture& complete_texture =
+        complete_render_pass_textures_[render_pass->id];
+    complete_texture.resource_id =
+        render_pass_textures_.get(render_pass->id)->id();
+    complete_texture.output_rect = render_pass->output_rect;
+  } else {
+    complete_render_pass_textures_.erase(render_pass->id);
+  }
 }
 
 bool DirectRenderer::UseRenderPass(DrawingFrame* frame,
@@ -418,6 +447,26 @@ bool DirectRenderer::UseRenderPass(DrawingFrame* frame,
   return BindFramebufferToTexture(frame, texture, render_pass->output_rect);
 }
 
+bool DirectRenderer::CanReuseRenderPassTexture(
+    const RenderPass* render_pass) const {
+  if (!settings_->cache_render_pass_contents ||
+      !render_pass->damage_rect.IsEmpty() ||
+      !render_pass->copy_requests.empty())
+    return false;
+
+  base::hash_map<RenderPass::Id, CompleteRenderPassTexture>::const_iterator it =
+      complete_render_pass_textures_.find(render_pass->id);
+  if (it == complete_render_pass_textures_.end())
+    return false;
+
+  // The texture is reallocated when it's freed, and resource ids aren't
+  // reused.
+  ScopedResource* texture = render_pass_textures_.get(render_pass->id);
+  return texture && texture->id() &&
+         texture->id() == it->second.resource_id &&
+         render_pass->output_rect == it->second.output_rect;
+}
+
 void DirectRenderer::RunOnDemandRasterTask(
     internal::Task* on_demand_raster_task) {
   internal::TaskGraphRunner* task_graph_runner =
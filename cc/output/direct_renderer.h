@@ -7,8 +7,10 @@
 
 #include "base/basictypes.h"
 #include "base/callback.h"
+#include "base/containers/hash_tables.h"
 #include "base/containers/scoped_ptr_hash_map.h"
 #include "cc/base/cc_export.h"
+#include "cc/output/overlay_processor.h"
 #include "cc/output/renderer.h"
 #include "cc/resources/resource_provider.h"
 #include "cc/resources/scoped_resource.h"
@@ -58,6 +60,10 @@ class CC_EXPORT DirectRenderer : public Renderer {
     ContextProvider* offscreen_context_provider;
 
     bool disable_picture_quad_image_filtering;
+
+    // The planes shown along with the framebuffer. Empty unless a quad was
+    // promoted to an overlay, and then the main plane comes first.
+    OverlayCandidateList overlay_list;
   };
 
   void SetEnlargePassTextureAmountForTesting(const gfx::Vector2d& amount);
@@ -97,6 +103,10 @@ class CC_EXPORT DirectRenderer : public Renderer {
                       bool allow_partial_swap);
   bool UseRenderPass(DrawingFrame* frame, const RenderPass* render_pass);
 
+  // Returns true if the texture of |render_pass| still holds what was drawn
+  // for it, so that it doesn't need to be drawn again.
+  bool CanReuseRenderPassTexture(const RenderPass* render_pass) const;
+
   void RunOnDemandRasterTask(internal::Task* on_demand_raster_task);
 
   virtual void BindFramebufferToOutputSurface(DrawingFrame* frame) = 0;
@@ -126,6 +136,7 @@ class CC_EXPORT DirectRenderer : public Renderer {
   base::ScopedPtrHashMap<RenderPass::Id, ScopedResource> render_pass_textures_;
   OutputSurface* output_surface_;
   ResourceProvider* resource_provider_;
+  scoped_ptr<OverlayProcessor> overlay_processor_;
 
   // For use in coordinate conversion, this stores the output rect, viewport
   // rect (= unflipped version of glViewport rect), and the size of target
@@ -137,6 +148,15 @@ class CC_EXPORT DirectRenderer : public Renderer {
   gfx::Size current_surface_size_;
 
  private:
+  // The texture that was completely drawn for a render pass, and the output
+  // rect of the pass it was drawn for.
+  struct CompleteRenderPassTexture {
+    ResourceProvider::ResourceId resource_id;
+    gfx::Rect output_rect;
+  };
+  base::hash_map<RenderPass::Id, CompleteRenderPassTexture>
+      complete_render_pass_textures_;
+
   gfx::Vector2d enlarge_pass_texture_amount_;
 
   internal::NamespaceToken on_demand_task_namespace_;
@@ -210,6 +210,7 @@ GLRenderer::GLRenderer(RendererClient* client,
       blend_shadow_(false),
       highp_threshold_min_(highp_threshold_min),
       highp_threshold_cache_(0),
+      draw_calls_for_frame_(0),
       on_demand_tile_raster_resource_id_(0) {
   DCHECK(gl_);
   DCHECK(context_support_);
@@ -293,6 +294,10 @@ void GLRenderer::SendManagedMemoryStats(size_t bytes_visible,
   context_support_->SendManagedMemoryStats(stats);
 }
 
+size_t GLRenderer::DrawCallsForLastFrame() const {
+  return draw_calls_for_frame_;
+}
+
 void GLRenderer::ReleaseRenderPassTextures() { render_pass_textures_.clear(); }
 
 void GLRenderer::DiscardPixels(bool has_external_stencil_test,
@@ -338,6 +343,7 @@ void GLRenderer::ClearFramebuffer(DrawingFrame* frame,
 }
 
 void GLRenderer::BeginDrawingFrame(DrawingFrame* frame) {
+  draw_calls_for_frame_ = 0;
   if (frame->device_viewport_rect.IsEmpty())
     return;
 
@@ -357,6 +363,9 @@ void GLRenderer::DoDrawQuad(DrawingFrame* frame, const DrawQuad* quad) {
   if (quad->material != DrawQuad::TEXTURE_CONTENT) {
     FlushTextureQuadCache();
   }
+  if (quad->material != DrawQuad::SOLID_COLOR) {
+    FlushSolidColorQuadCache();
+  }
 
   switch (quad->material) {
     case DrawQuad::INVALID:
@@ -480,6 +489,7 @@ void GLRenderer::DrawDebugBorderQuad(const DrawingFrame* frame,
   // The indices for the line are stored in the same array as the triangle
   // indices.
   GLC(gl_, gl_->DrawElements(GL_LINE_LOOP, 4, GL_UNSIGNED_SHORT, 0));
+  ++draw_calls_for_frame_;
 }
 
 static SkBitmap ApplyImageFilter(GLRenderer* renderer,
@@ -1351,11 +1361,16 @@ void GLRenderer::DrawSolidColorQuad(const DrawingFrame* frame,
       settings_->allow_antialiasing && !quad->force_anti_aliasing_off &&
       SetupQuadForAntialiasing(device_transform, quad, &local_quad, edge);
 
+  // Quads without anti-aliasing only need their color and transform, so they
+  // can be drawn together with the next ones.
+  if (!use_aa) {
+    EnqueueSolidColorQuad(frame, quad, alpha);
+    return;
+  }
+  FlushSolidColorQuadCache();
+
   SolidColorProgramUniforms uniforms;
-  if (use_aa)
-    SolidColorUniformLocation(GetSolidColorProgramAA(), &uniforms);
-  else
-    SolidColorUniformLocation(GetSolidColorProgram(), &uniforms);
+  SolidColorUniformLocation(GetSolidColorProgramAA(), &uniforms);
   SetUseProgram(uniforms.program);
 
   GLC(gl_,
@@ -1364,18 +1379,15 @@ void GLRenderer::DrawSolidColorQuad(const DrawingFrame* frame,
                      (SkColorGetG(color) * (1.0f / 255.0f)) * alpha,
                      (SkColorGetB(color) * (1.0f / 255.0f)) * alpha,
                      alpha));
-  if (use_aa) {
-    float viewport[4] = {static_cast<float>(viewport_.x()),
-                         static_cast<float>(viewport_.y()),
-                         static_cast<float>(viewport_.width()),
-                         static_cast<float>(viewport_.height()), };
-    GLC(gl_, gl_->Uniform4fv(uniforms.viewport_location, 1, viewport));
-    GLC(gl_, gl_->Uniform3fv(uniforms.edge_location, 8, edge));
-  }
+  float viewport[4] = {static_cast<float>(viewport_.x()),
+                       static_cast<float>(viewport_.y()),
+                       static_cast<float>(viewport_.width()),
+                       static_cast<float>(viewport_.height()), };
+  GLC(gl_, gl_->Uniform4fv(uniforms.viewport_location, 1, viewport));
+  GLC(gl_, gl_->Uniform3fv(uniforms.edge_location, 8, edge));
 
-  // Enable blending when the quad properties require it or if we decided
-  // to use antialiasing.
-  SetBlendEnabled(quad->ShouldDrawWithBlending() || use_aa);
+  // Antialiasing always needs blending.
+  SetBlendEnabled(true);
 
   // Normalize to tile_rect.
   local_quad.Scale(1.0f / tile_rect.width(), 1.0f / tile_rect.height());
@@ -1393,6 +1405,68 @@ void GLRenderer::DrawSolidColorQuad(const DrawingFrame* frame,
       frame, quad->quadTransform(), centered_rect, uniforms.matrix_location);
 }
 
+void GLRenderer::EnqueueSolidColorQuad(const DrawingFrame* frame,
+                                       const SolidColorDrawQuad* quad,
+                                       float alpha) {
+  if (solid_color_draw_cache_.needs_blending !=
+          quad->ShouldDrawWithBlending() ||
+      solid_color_draw_cache_.matrix_data.size() >= 8) {
+    FlushSolidColorQuadCache();
+    solid_color_draw_cache_.needs_blending = quad->ShouldDrawWithBlending();
+  }
+
+  SkColor color = quad->color;
+  Float4 premultiplied_color = {
+      {(SkColorGetR(color) * (1.0f / 255.0f)) * alpha,
+       (SkColorGetG(color) * (1.0f / 255.0f)) * alpha,
+       (SkColorGetB(color) * (1.0f / 255.0f)) * alpha,
+       alpha}};
+  solid_color_draw_cache_.color_data.push_back(premultiplied_color);
+
+  gfx::Transform quad_rect_matrix;
+  QuadRectTransform(&quad_rect_matrix,
+                    quad->quadTransform(),
+                    gfx::RectF(quad->visible_rect));
+  quad_rect_matrix = frame->projection_matrix * quad_rect_matrix;
+
+  Float16 m;
+  quad_rect_matrix.matrix().asColMajorf(m.data);
+  solid_color_draw_cache_.matrix_data.push_back(m);
+}
+
+void GLRenderer::FlushSolidColorQuadCache() {
+  if (solid_color_draw_cache_.matrix_data.empty())
+    return;
+
+  const BatchedSolidColorProgram* program = GetBatchedSolidColorProgram();
+  SetBlendEnabled(solid_color_draw_cache_.needs_blending);
+  SetUseProgram(program->program());
+
+  GLC(gl_,
+      gl_->UniformMatrix4fv(
+          program->vertex_shader().matrix_location(),
+          static_cast<int>(solid_color_draw_cache_.matrix_data.size()),
+          false,
+          reinterpret_cast<float*>(
+              &solid_color_draw_cache_.matrix_data.front())));
+  GLC(gl_,
+      gl_->Uniform4fv(
+          program->vertex_shader().color_location(),
+          static_cast<int>(solid_color_draw_cache_.color_data.size()),
+          reinterpret_cast<float*>(
+              &solid_color_draw_cache_.color_data.front())));
+
+  GLC(gl_,
+      gl_->DrawElements(GL_TRIANGLES,
+                        6 * solid_color_draw_cache_.matrix_data.size(),
+                        GL_UNSIGNED_SHORT,
+                        0));
+  ++draw_calls_for_frame_;
+
+  solid_color_draw_cache_.color_data.resize(0);
+  solid_color_draw_cache_.matrix_data.resize(0);
+}
+
 struct TileProgramUniforms {
   unsigned program;
   unsigned matrix_location;
@@ -1871,6 +1945,7 @@ void GLRenderer::FlushTextureQuadCache() {
                         6 * draw_cache_.matrix_data.size(),
                         GL_UNSIGNED_SHORT,
                         0));
+  ++draw_calls_for_frame_;
 
   // Clear the cache.
   draw_cache_.program_id = 0;
@@ -1996,9 +2071,14 @@ void GLRenderer::FinishDrawingFrame(DrawingFrame* frame) {
 
   GLC(gl_, gl_->Disable(GL_BLEND));
   blend_shadow_ = false;
+
+  ScheduleOverlays(frame);
 }
 
-void GLRenderer::FinishDrawingQuadList() { FlushTextureQuadCache(); }
+void GLRenderer::FinishDrawingQuadList() {
+  FlushTextureQuadCache();
+  FlushSolidColorQuadCache();
+}
 
 bool GLRenderer::FlippedFramebuffer() const { return true; }
 
@@ -2007,6 +2087,7 @@ void GLRenderer::EnsureScissorTestEnabled() {
     return;
 
   FlushTextureQuadCache();
+  FlushSolidColorQuadCache();
   GLC(gl_, gl_->Enable(GL_SCISSOR_TEST));
   is_scissor_enabled_ = true;
 }
@@ -2016,6 +2097,7 @@ void GLRenderer::EnsureScissorTestDisabled() {
     return;
 
   FlushTextureQuadCache();
+  FlushSolidColorQuadCache();
   GLC(gl_, gl_->Disable(GL_SCISSOR_TEST));
   is_scissor_enabled_ = false;
 }
@@ -2094,6 +2176,7 @@ void GLRenderer::DrawQuadGeometry(const DrawingFrame* frame,
   GLC(gl_, gl_->UniformMatrix4fv(matrix_location, 1, false, &gl_matrix[0]));
 
   GLC(gl_, gl_->DrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0));
+  ++draw_calls_for_frame_;
 }
 
 void GLRenderer::CopyTextureToFramebuffer(const DrawingFrame* frame,
@@ -2167,6 +2250,10 @@ void GLRenderer::SwapBuffers(const CompositorFrameMetadata& metadata) {
   }
   output_surface_->SwapBuffers(&compositor_frame);
 
+  // The overlays of the previous frame are no longer on screen.
+  in_use_overlay_resources_.swap(pending_overlay_resources_);
+  pending_overlay_resources_.clear();
+
   swap_buffer_rect_ = gfx::Rect();
 
   // We don't have real fences, so we mark read fences as passed
@@ -2178,6 +2265,24 @@ void GLRenderer::SwapBuffers(const CompositorFrameMetadata& metadata) {
   resource_provider_->SetReadLockFence(new SimpleSwapFence());
 }
 
+void GLRenderer::ScheduleOverlays(DrawingFrame* frame) {
+  for (OverlayCandidateList::iterator it = frame->overlay_list.begin();
+       it != frame->overlay_list.end();
+       ++it) {
+    const OverlayCandidate& overlay = *it;
+    // The main plane is the framebuffer itself.
+    if (!overlay.plane_z_order)
+      continue;
+
+    DCHECK(overlay.overlay_handled);
+    ResourceProvider::ScopedReadLockGL* lock =
+        new ResourceProvider::ScopedReadLockGL(resource_provider_,
+                                               overlay.resource_id);
+    pending_overlay_resources_.push_back(make_scoped_ptr(lock));
+    output_surface_->ScheduleOverlayPlane(overlay, lock->texture_id());
+  }
+}
+
 void GLRenderer::EnforceMemoryPolicy() {
   if (!visible_) {
     TRACE_EVENT0("cc", "GLRenderer::EnforceMemoryPolicy dropping resources");
@@ -2581,6 +2686,7 @@ void GLRenderer::SetScissorTestRect(const gfx::Rect& scissor_rect) {
 
   scissor_rect_ = scissor_rect;
   FlushTextureQuadCache();
+  FlushSolidColorQuadCache();
   GLC(gl_,
       gl_->Scissor(scissor_rect.x(),
                    scissor_rect.y(),
@@ -2650,6 +2756,18 @@ const GLRenderer::SolidColorProgramAA* GLRenderer::GetSolidColorProgramAA() {
   return &solid_color_program_aa_;
 }
 
+const GLRenderer::BatchedSolidColorProgram*
+GLRenderer::GetBatchedSolidColorProgram() {
+  if (!batched_solid_color_program_.initialized()) {
+    TRACE_EVENT0("cc", "GLRenderer::batchedSolidColorProgram::initialize");
+    batched_solid_color_program_.Initialize(
+        output_surface_->context_provider(),
+        TexCoordPrecisionNA,
+        SamplerTypeNA);
+  }
+  return &batched_solid_color_program_;
+}
+
 const GLRenderer::RenderPassProgram* GLRenderer::GetRenderPassProgram(
     TexCoordPrecision precision) {
   DCHECK_GE(precision, 0);
@@ -3008,6 +3126,7 @@ void GLRenderer::CleanupSharedObjects() {
   debug_border_program_.Cleanup(gl_);
   solid_color_program_.Cleanup(gl_);
   solid_color_program_aa_.Cleanup(gl_);
+  batched_solid_color_program_.Cleanup(gl_);
 
   if (offscreen_framebuffer_id_)
     GLC(gl_, gl_->DeleteFramebuffers(1, &offscreen_framebuffer_id_));
@@ -73,6 +73,8 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
                                       size_t bytes_visible_and_nearby,
                                       size_t bytes_allocated) OVERRIDE;
 
+  virtual size_t DrawCallsForLastFrame() const OVERRIDE;
+
   static void DebugGLCall(gpu::gles2::GLES2Interface* gl,
                           const char* command,
                           const char* file,
@@ -157,6 +159,14 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
   void DrawRenderPassQuad(DrawingFrame* frame, const RenderPassDrawQuad* quad);
   void DrawSolidColorQuad(const DrawingFrame* frame,
                           const SolidColorDrawQuad* quad);
+  void EnqueueSolidColorQuad(const DrawingFrame* frame,
+                             const SolidColorDrawQuad* quad,
+                             float alpha);
+  void FlushSolidColorQuadCache();
+
+  // Hands the overlay planes of |frame| to the output surface, keeping their
+  // resources locked while they are on screen.
+  void ScheduleOverlays(DrawingFrame* frame);
   void DrawStreamVideoQuad(const DrawingFrame* frame,
                            const StreamVideoDrawQuad* quad);
   void EnqueueTextureQuad(const DrawingFrame* frame,
@@ -298,6 +308,8 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
       SolidColorProgram;
   typedef ProgramBinding<VertexShaderQuadAA, FragmentShaderColorAA>
       SolidColorProgramAA;
+  typedef ProgramBinding<VertexShaderPosColor, FragmentShaderVaryingColor>
+      BatchedSolidColorProgram;
 
   const TileProgram* GetTileProgram(
       TexCoordPrecision precision, SamplerType sampler);
@@ -352,6 +364,7 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
   const DebugBorderProgram* GetDebugBorderProgram();
   const SolidColorProgram* GetSolidColorProgram();
   const SolidColorProgramAA* GetSolidColorProgramAA();
+  const BatchedSolidColorProgram* GetBatchedSolidColorProgram();
 
   TileProgram tile_program_[NumTexCoordPrecisions][NumSamplerTypes];
   TileProgramOpaque
@@ -395,6 +408,7 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
   DebugBorderProgram debug_border_program_;
   SolidColorProgram solid_color_program_;
   SolidColorProgramAA solid_color_program_aa_;
+  BatchedSolidColorProgram batched_solid_color_program_;
 
   gpu::gles2::GLES2Interface* gl_;
   gpu::ContextSupport* context_support_;
@@ -416,6 +430,8 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
   bool blend_shadow_;
   unsigned program_shadow_;
   TexturedQuadDrawCache draw_cache_;
+  SolidColorQuadDrawCache solid_color_draw_cache_;
+  size_t draw_calls_for_frame_;
   int highp_threshold_min_;
   int highp_threshold_cache_;
 
@@ -424,6 +440,13 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
 
   scoped_ptr<ResourceProvider::ScopedWriteLockGL> current_framebuffer_lock_;
 
+  typedef ScopedPtrVector<ResourceProvider::ScopedReadLockGL>
+      OverlayResourceLockList;
+  // The resources of the overlays scheduled for the next swap, and of the
+  // ones shown since the last swap.
+  OverlayResourceLockList pending_overlay_resources_;
+  OverlayResourceLockList in_use_overlay_resources_;
+
   scoped_refptr<ResourceProvider::Fence> last_swap_fence_;
 
   SkBitmap on_demand_tile_raster_bitmap_;
@@ -11,4 +11,9 @@ TexturedQuadDrawCache::TexturedQuadDrawCache()
 
 TexturedQuadDrawCache::~TexturedQuadDrawCache() {}
 
+SolidColorQuadDrawCache::SolidColorQuadDrawCache()
+    : needs_blending(false) {}
+
+SolidColorQuadDrawCache::~SolidColorQuadDrawCache() {}
+
 }  // namespace cc
@@ -381,6 +381,13 @@ void OutputSurface::BindFramebuffer() {
   context_provider_->ContextGL()->BindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
+void OutputSurface::ScheduleOverlayPlane(const OverlayCandidate& overlay,
+                                         unsigned texture_id) {
+  // Surfaces with an OverlayCandidateValidator need to show the planes it
+  // accepts.
+  NOTREACHED();
+}
+
 void OutputSurface::SwapBuffers(CompositorFrame* frame) {
   if (frame->software_frame_data) {
     PostSwapBuffersComplete();
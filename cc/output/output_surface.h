@@ -14,6 +14,7 @@
 #include "cc/base/cc_export.h"
 #include "cc/base/rolling_time_delta_history.h"
 #include "cc/output/context_provider.h"
+#include "cc/output/overlay_candidate_validator.h"
 #include "cc/output/software_output_device.h"
 #include "cc/scheduler/frame_rate_controller.h"
 
@@ -124,6 +125,19 @@ class CC_EXPORT OutputSurface : public FrameRateControllerClient {
   // itself).
   virtual void SwapBuffers(CompositorFrame* frame);
 
+  // Returns the platform hook which decides what the display hardware can show
+  // as overlay planes, or NULL if overlays aren't supported.
+  OverlayCandidateValidator* overlay_candidate_validator() const {
+    return overlay_candidate_validator_.get();
+  }
+
+  // Called by the renderer before SwapBuffers() for each candidate that the
+  // validator accepted, with the GL texture backing it, which stays valid
+  // until the frame after the next one is swapped. The plane has to be shown
+  // along with the swapped framebuffer, since the renderer didn't draw it.
+  virtual void ScheduleOverlayPlane(const OverlayCandidate& overlay,
+                                    unsigned texture_id);
+
   // Notifies frame-rate smoothness preference. If true, all non-critical
   // processing should be stopped, or lowered in priority.
   virtual void UpdateSmoothnessTakesPriority(bool prefer_smoothness) {}
@@ -154,6 +168,7 @@ class CC_EXPORT OutputSurface : public FrameRateControllerClient {
   struct OutputSurface::Capabilities capabilities_;
   scoped_refptr<ContextProvider> context_provider_;
   scoped_ptr<SoftwareOutputDevice> software_device_;
+  scoped_ptr<OverlayCandidateValidator> overlay_candidate_validator_;
   gfx::Size surface_size_;
   float device_scale_factor_;
 
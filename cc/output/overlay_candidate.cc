@@ -0,0 +1,42 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/output/overlay_candidate.h"
+
+#include "cc/base/math_util.h"
+#include "ui/gfx/rect_conversions.h"
+#include "ui/gfx/transform.h"
+
+namespace cc {
+
+OverlayCandidate::OverlayCandidate()
+    : transform(NONE),
+      format(RGBA_8888),
+      uv_rect(0.f, 0.f, 1.f, 1.f),
+      resource_id(0),
+      plane_z_order(0),
+      overlay_handled(false) {}
+
+OverlayCandidate::~OverlayCandidate() {}
+
+// static
+OverlayCandidate::OverlayTransform OverlayCandidate::GetOverlayTransform(
+    const gfx::Transform& quad_transform,
+    bool flipped) {
+  if (!quad_transform.IsPositiveScaleOrTranslation())
+    return INVALID;
+
+  return flipped ? FLIP_VERTICAL : NONE;
+}
+
+// static
+gfx::Rect OverlayCandidate::GetOverlayRect(const gfx::Transform& quad_transform,
+                                           const gfx::Rect& rect) {
+  DCHECK(quad_transform.IsPositiveScaleOrTranslation());
+
+  return gfx::ToEnclosingRect(
+      MathUtil::MapClippedRect(quad_transform, gfx::RectF(rect)));
+}
+
+}  // namespace cc
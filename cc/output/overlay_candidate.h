@@ -0,0 +1,68 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_OUTPUT_OVERLAY_CANDIDATE_H_
+#define CC_OUTPUT_OVERLAY_CANDIDATE_H_
+
+#include <vector>
+
+#include "cc/base/cc_export.h"
+#include "cc/resources/resource_format.h"
+#include "ui/gfx/rect.h"
+#include "ui/gfx/rect_f.h"
+
+namespace gfx {
+class Transform;
+}
+
+namespace cc {
+
+// A texture which could be shown by the display hardware as a plane of its
+// own instead of being drawn into the framebuffer by the renderer.
+class CC_EXPORT OverlayCandidate {
+ public:
+  enum OverlayTransform {
+    INVALID,
+    NONE,
+    FLIP_VERTICAL,
+  };
+
+  // Returns how the hardware needs to transform the contents of a texture
+  // drawn with |quad_transform|, which is INVALID unless the quad only gets
+  // scaled and translated. |flipped| is true for upside-down textures.
+  static OverlayTransform GetOverlayTransform(
+      const gfx::Transform& quad_transform,
+      bool flipped);
+
+  // Returns the rect, in the target space of |quad_transform|, that |rect|
+  // covers on screen.
+  static gfx::Rect GetOverlayRect(const gfx::Transform& quad_transform,
+                                  const gfx::Rect& rect);
+
+  OverlayCandidate();
+  ~OverlayCandidate();
+
+  // How the contents are flipped when they are scanned out.
+  OverlayTransform transform;
+  // Format of the texture.
+  ResourceFormat format;
+  // Rect on the output surface, in device pixels from its top left corner.
+  gfx::Rect display_rect;
+  // The part of the texture shown in |display_rect|, in normalized coordinates.
+  gfx::RectF uv_rect;
+  // The texture, which is 0 for the main plane holding the framebuffer.
+  unsigned resource_id;
+  // Stacking order: the main plane is at 0 and overlays above it are positive.
+  int plane_z_order;
+
+  // Set by the OverlayCandidateValidator when the hardware can show the
+  // candidate as it is described.
+  bool overlay_handled;
+};
+
+typedef std::vector<OverlayCandidate> OverlayCandidateList;
+
+}  // namespace cc
+
+#endif  // CC_OUTPUT_OVERLAY_CANDIDATE_H_
@@ -0,0 +1,29 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_OUTPUT_OVERLAY_CANDIDATE_VALIDATOR_H_
+#define CC_OUTPUT_OVERLAY_CANDIDATE_VALIDATOR_H_
+
+#include "cc/base/cc_export.h"
+#include "cc/output/overlay_candidate.h"
+
+namespace cc {
+
+// The platform hook that decides which overlay candidates the display
+// hardware can show, which is implemented by the OutputSurface of each
+// platform that supports overlays.
+class CC_EXPORT OverlayCandidateValidator {
+ public:
+  // Sets |overlay_handled| on the candidates of |surfaces| which can be shown
+  // as planes of their own. The first candidate is the main plane, which the
+  // framebuffer is scanned out from, and must be supported for any of the
+  // others to be.
+  virtual void CheckOverlaySupport(OverlayCandidateList* surfaces) = 0;
+
+  virtual ~OverlayCandidateValidator() {}
+};
+
+}  // namespace cc
+
+#endif  // CC_OUTPUT_OVERLAY_CANDIDATE_VALIDATOR_H_
@@ -0,0 +1,147 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/output/overlay_processor.h"
+
+#include "cc/base/math_util.h"
+#include "cc/output/output_surface.h"
+#include "cc/output/overlay_candidate_validator.h"
+#include "cc/quads/draw_quad.h"
+#include "cc/quads/shared_quad_state.h"
+#include "cc/quads/stream_video_draw_quad.h"
+#include "cc/quads/texture_draw_quad.h"
+#include "cc/resources/resource_provider.h"
+#include "ui/gfx/transform.h"
+
+namespace cc {
+
+namespace {
+
+bool IsOpaque(const DrawQuad& draw_quad) {
+  return !draw_quad.ShouldDrawWithBlending() &&
+         draw_quad.shared_quad_state->blend_mode == SkXfermode::kSrcOver_Mode;
+}
+
+}  // namespace
+
+OverlayProcessor::OverlayProcessor(OutputSurface* surface,
+                                   ResourceProvider* resource_provider)
+    : surface_(surface), resource_provider_(resource_provider) {}
+
+OverlayProcessor::~OverlayProcessor() {}
+
+void OverlayProcessor::ProcessForOverlays(
+    RenderPassList* render_passes_in_draw_order,
+    OverlayCandidateList* candidate_list) {
+  OverlayCandidateValidator* validator =
+      surface_->overlay_candidate_validator();
+  if (!validator || !resource_provider_ || render_passes_in_draw_order->empty())
+    return;
+
+  // Only the quads of the root pass, which end up on the output surface
+  // without going through another render pass, can be scanned out directly.
+  RenderPass* root_render_pass = render_passes_in_draw_order->back();
+  // Copies of the root pass need to include everything that is on screen.
+  if (!root_render_pass->copy_requests.empty())
+    return;
+
+  QuadList& quad_list = root_render_pass->quad_list;
+
+  // The overlay is shown on top of the framebuffer, so none of the quads in
+  // front of the candidate may draw over it.
+  gfx::RectF covered_rect;
+  for (QuadList::iterator it = quad_list.begin(); it != quad_list.end();
+       ++it) {
+    const DrawQuad& draw_quad = *(*it);
+    gfx::RectF quad_rect = MathUtil::MapClippedRect(
+        draw_quad.quadTransform(), gfx::RectF(draw_quad.visible_rect));
+
+    OverlayCandidate candidate;
+    if (!GetCandidateQuadInfo(draw_quad, &candidate) ||
+        covered_rect.Intersects(quad_rect)) {
+      covered_rect.Union(quad_rect);
+      continue;
+    }
+
+    OverlayCandidate main_plane;
+    main_plane.display_rect = root_render_pass->output_rect;
+
+    OverlayCandidateList candidates;
+    candidates.push_back(main_plane);
+    candidates.push_back(candidate);
+    validator->CheckOverlaySupport(&candidates);
+
+    // Only a single overlay is tried, so the search stops at the first
+    // candidate whether the hardware accepts it or not.
+    if (candidates[0].overlay_handled && candidates[1].overlay_handled) {
+      quad_list.erase(it);
+      candidate_list->swap(candidates);
+    }
+    return;
+  }
+}
+
+bool OverlayProcessor::GetCandidateQuadInfo(const DrawQuad& draw_quad,
+                                            OverlayCandidate* candidate) {
+  if (!IsOpaque(draw_quad) || draw_quad.shared_quad_state->is_clipped)
+    return false;
+
+  unsigned resource_id = 0;
+  bool flipped = false;
+  gfx::RectF uv_rect(0.f, 0.f, 1.f, 1.f);
+  switch (draw_quad.material) {
+    case DrawQuad::TEXTURE_CONTENT: {
+      const TextureDrawQuad* quad = TextureDrawQuad::MaterialCast(&draw_quad);
+      if (quad->background_color != SK_ColorTRANSPARENT)
+        return false;
+      for (size_t i = 0; i < 4; ++i) {
+        if (quad->vertex_opacity[i] != 1.f)
+          return false;
+      }
+      resource_id = quad->resource_id;
+      flipped = quad->flipped;
+      uv_rect = gfx::RectF(quad->uv_top_left.x(),
+                           quad->uv_top_left.y(),
+                           quad->uv_bottom_right.x() - quad->uv_top_left.x(),
+                           quad->uv_bottom_right.y() - quad->uv_top_left.y());
+      break;
+    }
+    case DrawQuad::STREAM_VIDEO_CONTENT: {
+      const StreamVideoDrawQuad* quad =
+          StreamVideoDrawQuad::MaterialCast(&draw_quad);
+      // The texture matrix of the stream can't be applied by the hardware.
+      if (!quad->matrix.IsIdentity())
+        return false;
+      resource_id = quad->resource_id;
+      break;
+    }
+    default:
+      return false;
+  }
+
+  // Software resources can't be scanned out.
+  if (resource_provider_->GetResourceType(resource_id) !=
+      ResourceProvider::GLTexture)
+    return false;
+
+  OverlayCandidate::OverlayTransform transform =
+      OverlayCandidate::GetOverlayTransform(draw_quad.quadTransform(), flipped);
+  if (transform == OverlayCandidate::INVALID)
+    return false;
+
+  // The quad is scanned out whole, so it can't be partially occluded.
+  if (draw_quad.visible_rect != draw_quad.rect)
+    return false;
+
+  candidate->transform = transform;
+  candidate->display_rect =
+      OverlayCandidate::GetOverlayRect(draw_quad.quadTransform(),
+                                       draw_quad.rect);
+  candidate->uv_rect = uv_rect;
+  candidate->resource_id = resource_id;
+  candidate->plane_z_order = 1;
+  return true;
+}
+
+}  // namespace cc
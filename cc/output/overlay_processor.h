@@ -0,0 +1,49 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_OUTPUT_OVERLAY_PROCESSOR_H_
+#define CC_OUTPUT_OVERLAY_PROCESSOR_H_
+
+#include "base/basictypes.h"
+#include "cc/base/cc_export.h"
+#include "cc/output/overlay_candidate.h"
+#include "cc/quads/render_pass.h"
+
+namespace cc {
+
+class DrawQuad;
+class OutputSurface;
+class ResourceProvider;
+
+// Promotes video and texture quads to hardware overlay planes, which the
+// display scans out on top of the framebuffer, so that the renderer doesn't
+// have to draw them.
+class CC_EXPORT OverlayProcessor {
+ public:
+  OverlayProcessor(OutputSurface* surface, ResourceProvider* resource_provider);
+  ~OverlayProcessor();
+
+  // Looks for the topmost quad of the root render pass that could be an
+  // overlay, and asks the OverlayCandidateValidator of the output surface
+  // whether the hardware can show it. If it can, the quad is removed from the
+  // pass, and |candidate_list| is set to the main plane followed by the
+  // overlay. Otherwise the render passes and |candidate_list| are left alone.
+  void ProcessForOverlays(RenderPassList* render_passes_in_draw_order,
+                          OverlayCandidateList* candidate_list);
+
+ private:
+  // Fills in |candidate| from |draw_quad| if it is a texture or video quad
+  // which the hardware could show instead of drawing it.
+  bool GetCandidateQuadInfo(const DrawQuad& draw_quad,
+                            OverlayCandidate* candidate);
+
+  OutputSurface* surface_;
+  ResourceProvider* resource_provider_;
+
+  DISALLOW_COPY_AND_ASSIGN(OverlayProcessor);
+};
+
+}  // namespace cc
+
+#endif  // CC_OUTPUT_OVERLAY_PROCESSOR_H_
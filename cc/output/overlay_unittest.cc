@@ -0,0 +1,342 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/base/scoped_ptr_vector.h"
+#include "cc/output/compositor_frame_metadata.h"
+#include "cc/output/copy_output_request.h"
+#include "cc/output/gl_renderer.h"
+#include "cc/output/output_surface.h"
+#include "cc/output/overlay_candidate_validator.h"
+#include "cc/output/overlay_processor.h"
+#include "cc/quads/render_pass.h"
+#include "cc/quads/solid_color_draw_quad.h"
+#include "cc/quads/stream_video_draw_quad.h"
+#include "cc/quads/texture_draw_quad.h"
+#include "cc/resources/resource_provider.h"
+#include "cc/test/fake_output_surface_client.h"
+#include "cc/test/test_context_provider.h"
+#include "cc/trees/layer_tree_settings.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/khronos/GLES2/gl2.h"
+#include "ui/gfx/transform.h"
+
+namespace cc {
+namespace {
+
+const gfx::Rect kOverlayRect(0, 0, 128, 128);
+const gfx::PointF kUVTopLeft(0.1f, 0.2f);
+const gfx::PointF kUVBottomRight(1.f, 1.f);
+
+class SingleOverlayValidator : public OverlayCandidateValidator {
+ public:
+  virtual void CheckOverlaySupport(OverlayCandidateList* surfaces) OVERRIDE {
+    ASSERT_EQ(2U, surfaces->size());
+
+    OverlayCandidate& candidate = surfaces->back();
+    EXPECT_EQ(kOverlayRect.ToString(), candidate.display_rect.ToString());
+    EXPECT_EQ(gfx::RectF(kUVTopLeft, kUVBottomRight - kUVTopLeft).ToString(),
+              candidate.uv_rect.ToString());
+    surfaces->front().overlay_handled = true;
+    candidate.overlay_handled = true;
+  }
+};
+
+class OverlayOutputSurface : public OutputSurface {
+ public:
+  explicit OverlayOutputSurface(scoped_refptr<ContextProvider> context_provider)
+      : OutputSurface(context_provider), scheduled_plane_count_(0) {
+    overlay_candidate_validator_.reset(new SingleOverlayValidator);
+  }
+
+  virtual void ScheduleOverlayPlane(const OverlayCandidate& overlay,
+                                    unsigned texture_id) OVERRIDE {
+    EXPECT_NE(0u, texture_id);
+    EXPECT_EQ(1, overlay.plane_z_order);
+    ++scheduled_plane_count_;
+  }
+
+  int scheduled_plane_count() const { return scheduled_plane_count_; }
+
+ private:
+  int scheduled_plane_count_;
+};
+
+scoped_ptr<RenderPass> CreateRenderPass() {
+  RenderPass::Id id(1, 0);
+  gfx::Rect output_rect(0, 0, 256, 256);
+  bool has_transparent_background = true;
+
+  scoped_ptr<RenderPass> pass = RenderPass::Create();
+  pass->SetAll(id,
+               output_rect,
+               output_rect,
+               gfx::Transform(),
+               has_transparent_background);
+
+  scoped_ptr<SharedQuadState> shared_state = SharedQuadState::Create();
+  shared_state->opacity = 1.f;
+  pass->shared_quad_state_list.push_back(shared_state.Pass());
+  return pass.Pass();
+}
+
+ResourceProvider::ResourceId CreateResource(
+    ResourceProvider* resource_provider) {
+  ResourceProvider::ResourceId resource_id =
+      resource_provider->CreateResource(kOverlayRect.size(),
+                                        GL_CLAMP_TO_EDGE,
+                                        ResourceProvider::TextureUsageAny,
+                                        RGBA_8888);
+  resource_provider->AllocateForTesting(resource_id);
+  return resource_id;
+}
+
+scoped_ptr<TextureDrawQuad> CreateCandidateQuad(
+    ResourceProvider* resource_provider,
+    const SharedQuadState* shared_quad_state) {
+  float vertex_opacity[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+  bool premultiplied_alpha = false;
+  bool flipped = false;
+
+  scoped_ptr<TextureDrawQuad> overlay_quad = TextureDrawQuad::Create();
+  overlay_quad->SetNew(shared_quad_state,
+                       kOverlayRect,
+                       kOverlayRect,
+                       CreateResource(resource_provider),
+                       premultiplied_alpha,
+                       kUVTopLeft,
+                       kUVBottomRight,
+                       SK_ColorTRANSPARENT,
+                       vertex_opacity,
+                       flipped);
+  return overlay_quad.Pass();
+}
+
+scoped_ptr<DrawQuad> CreateCheckeredQuad(
+    const SharedQuadState* shared_quad_state,
+    const gfx::Rect& rect) {
+  scoped_ptr<SolidColorDrawQuad> quad = SolidColorDrawQuad::Create();
+  quad->SetNew(shared_quad_state, rect, SK_ColorLTGRAY, false);
+  return quad.PassAs<DrawQuad>();
+}
+
+class OverlayTest : public testing::Test {
+ protected:
+  virtual void SetUp() {
+    provider_ = TestContextProvider::Create();
+    output_surface_.reset(new OverlayOutputSurface(provider_));
+    EXPECT_TRUE(output_surface_->BindToClient(&client_));
+
+    resource_provider_ =
+        ResourceProvider::Create(output_surface_.get(), NULL, 0, false, 1);
+    overlay_processor_.reset(new OverlayProcessor(output_surface_.get(),
+                                                  resource_provider_.get()));
+  }
+
+  scoped_refptr<TestContextProvider> provider_;
+  scoped_ptr<OverlayOutputSurface> output_surface_;
+  FakeOutputSurfaceClient client_;
+  scoped_ptr<ResourceProvider> resource_provider_;
+  scoped_ptr<OverlayProcessor> overlay_processor_;
+};
+
+TEST_F(OverlayTest, NoValidatorNoOverlay) {
+  scoped_ptr<OutputSurface> output_surface(
+      new OutputSurface(TestContextProvider::Create()));
+  FakeOutputSurfaceClient client;
+  EXPECT_TRUE(output_surface->BindToClient(&client));
+  EXPECT_FALSE(output_surface->overlay_candidate_validator());
+
+  scoped_ptr<RenderPass> pass = CreateRenderPass();
+  pass->quad_list.push_back(
+      CreateCandidateQuad(resource_provider_.get(),
+                          pass->shared_quad_state_list.back())
+          .PassAs<DrawQuad>());
+
+  RenderPassList pass_list;
+  pass_list.push_back(pass.Pass());
+
+  OverlayProcessor overlay_processor(output_surface.get(),
+                                     resource_provider_.get());
+  OverlayCandidateList candidate_list;
+  overlay_processor.ProcessForOverlays(&pass_list, &candidate_list);
+  EXPECT_EQ(1U, pass_list.back()->quad_list.size());
+  EXPECT_EQ(0U, candidate_list.size());
+}
+
+TEST_F(OverlayTest, SuccessfulOverlay) {
+  scoped_ptr<RenderPass> pass = CreateRenderPass();
+  scoped_ptr<TextureDrawQuad> original_quad = CreateCandidateQuad(
+      resource_provider_.get(), pass->shared_quad_state_list.back());
+  unsigned original_resource_id = original_quad->resource_id;
+
+  pass->quad_list.push_back(original_quad.PassAs<DrawQuad>());
+  pass->quad_list.push_back(CreateCheckeredQuad(
+      pass->shared_quad_state_list.back(), pass->output_rect));
+
+  RenderPassList pass_list;
+  pass_list.push_back(pass.Pass());
+
+  OverlayCandidateList candidate_list;
+  overlay_processor_->ProcessForOverlays(&pass_list, &candidate_list);
+
+  // The texture quad was removed, and nothing but the checkered quad under it
+  // is left to draw.
+  ASSERT_EQ(1U, pass_list.size());
+  ASSERT_EQ(1U, pass_list.back()->quad_list.size());
+  EXPECT_EQ(DrawQuad::SOLID_COLOR,
+            pass_list.back()->quad_list.front()->material);
+
+  ASSERT_EQ(2U, candidate_list.size());
+  EXPECT_EQ(0, candidate_list[0].plane_z_order);
+  EXPECT_TRUE(candidate_list[0].overlay_handled);
+  EXPECT_EQ(1, candidate_list[1].plane_z_order);
+  EXPECT_EQ(original_resource_id, candidate_list[1].resource_id);
+  EXPECT_EQ(OverlayCandidate::NONE, candidate_list[1].transform);
+}
+
+TEST_F(OverlayTest, OccludedCandidateIsNotPromoted) {
+  scoped_ptr<RenderPass> pass = CreateRenderPass();
+  pass->quad_list.push_back(CreateCheckeredQuad(
+      pass->shared_quad_state_list.back(), gfx::Rect(64, 64, 128, 128)));
+  pass->quad_list.push_back(
+      CreateCandidateQuad(resource_provider_.get(),
+                          pass->shared_quad_state_list.back())
+          .PassAs<DrawQuad>());
+
+  RenderPassList pass_list;
+  pass_list.push_back(pass.Pass());
+
+  OverlayCandidateList candidate_list;
+  overlay_processor_->ProcessForOverlays(&pass_list, &candidate_list);
+  EXPECT_EQ(2U, pass_list.back()->quad_list.size());
+  EXPECT_EQ(0U, candidate_list.size());
+}
+
+TEST_F(OverlayTest, QuadInFrontThatDoesNotOverlapAllowsOverlay) {
+  scoped_ptr<RenderPass> pass = CreateRenderPass();
+  pass->quad_list.push_back(CreateCheckeredQuad(
+      pass->shared_quad_state_list.back(), gfx::Rect(128, 128, 64, 64)));
+  pass->quad_list.push_back(
+      CreateCandidateQuad(resource_provider_.get(),
+                          pass->shared_quad_state_list.back())
+          .PassAs<DrawQuad>());
+
+  RenderPassList pass_list;
+  pass_list.push_back(pass.Pass());
+
+  OverlayCandidateList candidate_list;
+  overlay_processor_->ProcessForOverlays(&pass_list, &candidate_list);
+  EXPECT_EQ(1U, pass_list.back()->quad_list.size());
+  EXPECT_EQ(2U, candidate_list.size());
+}
+
+TEST_F(OverlayTest, RejectBlending) {
+  scoped_ptr<RenderPass> pass = CreateRenderPass();
+  pass->shared_quad_state_list.back()->opacity = 0.5f;
+  pass->quad_list.push_back(
+      CreateCandidateQuad(resource_provider_.get(),
+                          pass->shared_quad_state_list.back())
+          .PassAs<DrawQuad>());
+
+  RenderPassList pass_list;
+  pass_list.push_back(pass.Pass());
+
+  OverlayCandidateList candidate_list;
+  overlay_processor_->ProcessForOverlays(&pass_list, &candidate_list);
+  EXPECT_EQ(1U, pass_list.back()->quad_list.size());
+  EXPECT_EQ(0U, candidate_list.size());
+}
+
+TEST_F(OverlayTest, RejectNonAxisAlignedTransform) {
+  scoped_ptr<RenderPass> pass = CreateRenderPass();
+  pass->shared_quad_state_list.back()->content_to_target_transform.Rotate(45.0);
+  pass->quad_list.push_back(
+      CreateCandidateQuad(resource_provider_.get(),
+                          pass->shared_quad_state_list.back())
+          .PassAs<DrawQuad>());
+
+  RenderPassList pass_list;
+  pass_list.push_back(pass.Pass());
+
+  OverlayCandidateList candidate_list;
+  overlay_processor_->ProcessForOverlays(&pass_list, &candidate_list);
+  EXPECT_EQ(1U, pass_list.back()->quad_list.size());
+  EXPECT_EQ(0U, candidate_list.size());
+}
+
+TEST_F(OverlayTest, RejectStreamVideoWithTextureMatrix) {
+  scoped_ptr<RenderPass> pass = CreateRenderPass();
+  gfx::Transform matrix;
+  matrix.Scale(1.f, -1.f);
+  scoped_ptr<StreamVideoDrawQuad> video_quad = StreamVideoDrawQuad::Create();
+  video_quad->SetNew(pass->shared_quad_state_list.back(),
+                     kOverlayRect,
+                     kOverlayRect,
+                     CreateResource(resource_provider_.get()),
+                     matrix);
+  pass->quad_list.push_back(video_quad.PassAs<DrawQuad>());
+
+  RenderPassList pass_list;
+  pass_list.push_back(pass.Pass());
+
+  OverlayCandidateList candidate_list;
+  overlay_processor_->ProcessForOverlays(&pass_list, &candidate_list);
+  EXPECT_EQ(1U, pass_list.back()->quad_list.size());
+  EXPECT_EQ(0U, candidate_list.size());
+}
+
+TEST_F(OverlayTest, RejectWhenRootPassIsCopied) {
+  scoped_ptr<RenderPass> pass = CreateRenderPass();
+  pass->quad_list.push_back(
+      CreateCandidateQuad(resource_provider_.get(),
+                          pass->shared_quad_state_list.back())
+          .PassAs<DrawQuad>());
+  pass->copy_requests.push_back(CopyOutputRequest::CreateEmptyRequest());
+
+  RenderPassList pass_list;
+  pass_list.push_back(pass.Pass());
+
+  OverlayCandidateList candidate_list;
+  overlay_processor_->ProcessForOverlays(&pass_list, &candidate_list);
+  EXPECT_EQ(1U, pass_list.back()->quad_list.size());
+  EXPECT_EQ(0U, candidate_list.size());
+}
+
+class OverlayRendererClient : public RendererClient {
+ public:
+  virtual void SetFullRootLayerDamage() OVERRIDE {}
+};
+
+TEST_F(OverlayTest, GLRendererSchedulesOverlayPlanes) {
+  LayerTreeSettings settings;
+  OverlayRendererClient renderer_client;
+  scoped_ptr<GLRenderer> renderer = GLRenderer::Create(&renderer_client,
+                                                       &settings,
+                                                       output_surface_.get(),
+                                                       resource_provider_.get(),
+                                                       NULL,
+                                                       0);
+
+  scoped_ptr<RenderPass> pass = CreateRenderPass();
+  pass->quad_list.push_back(
+      CreateCandidateQuad(resource_provider_.get(),
+                          pass->shared_quad_state_list.back())
+          .PassAs<DrawQuad>());
+  pass->quad_list.push_back(CreateCheckeredQuad(
+      pass->shared_quad_state_list.back(), pass->output_rect));
+
+  RenderPassList pass_list;
+  pass_list.push_back(pass.Pass());
+
+  gfx::Rect viewport_rect(256, 256);
+  renderer->DecideRenderPassAllocationsForFrame(pass_list);
+  renderer->DrawFrame(
+      &pass_list, NULL, 1.f, viewport_rect, viewport_rect, false, false);
+  EXPECT_EQ(1, output_surface_->scheduled_plane_count());
+
+  renderer->SwapBuffers(CompositorFrameMetadata());
+}
+
+}  // namespace
+}  // namespace cc
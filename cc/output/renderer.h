@@ -87,6 +87,10 @@ class CC_EXPORT Renderer {
                                       size_t bytes_visible_and_nearby,
                                       size_t bytes_allocated) = 0;
 
+  // The number of draw calls issued by the last DrawFrame(), for renderers
+  // which draw with a graphics API.
+  virtual size_t DrawCallsForLastFrame() const { return 0; }
+
  protected:
   explicit Renderer(RendererClient* client, const LayerTreeSettings* settings)
       : client_(client), settings_(settings) {}
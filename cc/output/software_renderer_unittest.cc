@@ -436,5 +436,58 @@ TEST_F(SoftwareRendererTest, RenderPassVisibleRect) {
                             interior_visible_rect.bottom() - 1));
 }
 
+TEST_F(SoftwareRendererTest, ReuseUndamagedRenderPass) {
+  float device_scale_factor = 1.f;
+  gfx::Rect viewport_rect(0, 0, 100, 100);
+  settings_.cache_render_pass_contents = true;
+  InitializeRenderer(make_scoped_ptr(new SoftwareOutputDevice));
+
+  SkBitmap output;
+  output.setConfig(SkBitmap::kARGB_8888_Config,
+                   viewport_rect.width(),
+                   viewport_rect.height());
+  output.allocPixels();
+
+  gfx::Rect smaller_rect(20, 20, 60, 60);
+  RenderPass::Id smaller_pass_id(2, 0);
+  RenderPass::Id root_pass_id(1, 0);
+  const SkColor pass_colors[] = {SK_ColorMAGENTA, SK_ColorYELLOW,
+                                 SK_ColorYELLOW};
+  // The pass is only damaged in the first and last frames.
+  const bool pass_damaged[] = {true, false, true};
+  // The pass isn't drawn again without damage, so it keeps its old color.
+  const SkColor expected_colors[] = {SK_ColorMAGENTA, SK_ColorMAGENTA,
+                                     SK_ColorYELLOW};
+
+  for (size_t i = 0; i < arraysize(pass_colors); ++i) {
+    RenderPassList list;
+    TestRenderPass* smaller_pass =
+        AddRenderPass(&list, smaller_pass_id, smaller_rect, gfx::Transform());
+    AddQuad(smaller_pass, smaller_rect, pass_colors[i]);
+    if (!pass_damaged[i])
+      smaller_pass->damage_rect = gfx::RectF();
+
+    TestRenderPass* root_pass =
+        AddRenderPass(&list, root_pass_id, viewport_rect, gfx::Transform());
+    AddRenderPassQuad(root_pass, smaller_pass);
+    AddQuad(root_pass, viewport_rect, SK_ColorGREEN);
+
+    renderer()->DecideRenderPassAllocationsForFrame(list);
+    renderer()->DrawFrame(&list,
+                          NULL,
+                          device_scale_factor,
+                          viewport_rect,
+                          viewport_rect,
+                          true,
+                          false);
+    renderer()->GetFramebufferPixels(output.getPixels(), viewport_rect);
+
+    EXPECT_EQ(SK_ColorGREEN, output.getColor(0, 0)) << "frame " << i;
+    EXPECT_EQ(expected_colors[i],
+              output.getColor(smaller_rect.x(), smaller_rect.y()))
+        << "frame " << i;
+  }
+}
+
 }  // namespace
 }  // namespace cc
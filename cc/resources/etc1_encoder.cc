@@ -0,0 +1,239 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/resources/etc1_encoder.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "base/logging.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkColorPriv.h"
+#include "ui/gfx/size.h"
+
+namespace cc {
+
+namespace {
+
+const int kBlockSize = 4;
+const int kBlockPixels = kBlockSize * kBlockSize;
+const int kBytesPerBlock = 8;
+const int kNumModifierTables = 8;
+
+// The small and large modifiers of each table. Pixel indices 0 to 3 select
+// +small, +large, -small and -large.
+const int kModifierTables[kNumModifierTables][2] = {
+    {2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106},
+    {47, 183}};
+
+int Modifier(int table, int pixel_index) {
+  int modifier = kModifierTables[table][pixel_index & 1];
+  return (pixel_index & 2) ? -modifier : modifier;
+}
+
+struct SubblockFit {
+  int64 error;
+  int table;
+  // The pixel indices of the pixels of the subblock, by block position.
+  int pixel_indices[kBlockPixels];
+};
+
+// Block positions are in the column-major order of ETC1, where the pixel at
+// (x, y) has position 4 * x + y. |flip| selects two 4x2 subblocks instead of
+// two 2x4 ones.
+bool IsInSecondSubblock(int position, bool flip) {
+  return flip ? (position % kBlockSize) >= 2 : (position / kBlockSize) >= 2;
+}
+
+// Picks the modifier table and the pixel indices that best fit the pixels of
+// |subblock| to |base|. The modifiers are added to all the channels, so the
+// best one for a pixel is the one closest to the mean of its differences to
+// |base|. Clamping of the decoded channels is ignored.
+void FitSubblock(const int pixels[kBlockPixels][3],
+                 bool flip,
+                 int subblock,
+                 const int base[3],
+                 SubblockFit* fit) {
+  int64 base_error = 0;
+  int sum_of_differences[kBlockPixels];
+  for (int i = 0; i < kBlockPixels; ++i) {
+    if (IsInSecondSubblock(i, flip) != (subblock == 1))
+      continue;
+    sum_of_differences[i] = 0;
+    for (int c = 0; c < 3; ++c) {
+      int difference = pixels[i][c] - base[c];
+      sum_of_differences[i] += difference;
+      base_error += difference * difference;
+    }
+  }
+
+  // With a modifier m, the error of a pixel is its base error plus
+  // 3 * m * m - 2 * m * sum_of_differences.
+  fit->error = std::numeric_limits<int64>::max();
+  for (int table = 0; table < kNumModifierTables; ++table) {
+    int64 error = base_error;
+    int pixel_indices[kBlockPixels] = {0};
+    for (int i = 0; i < kBlockPixels; ++i) {
+      if (IsInSecondSubblock(i, flip) != (subblock == 1))
+        continue;
+      int best_error = std::numeric_limits<int>::max();
+      for (int pixel_index = 0; pixel_index < 4; ++pixel_index) {
+        int modifier = Modifier(table, pixel_index);
+        int modifier_error =
+            modifier * (3 * modifier - 2 * sum_of_differences[i]);
+        if (modifier_error < best_error) {
+          best_error = modifier_error;
+          pixel_indices[i] = pixel_index;
+        }
+      }
+      error += best_error;
+    }
+    if (error < fit->error) {
+      fit->error = error;
+      fit->table = table;
+      std::copy(pixel_indices, pixel_indices + kBlockPixels,
+                fit->pixel_indices);
+    }
+  }
+}
+
+int Quantize(int value, int max_quantized) {
+  return (value * max_quantized + 127) / 255;
+}
+
+int Expand4(int quantized) { return (quantized << 4) | quantized; }
+
+int Expand5(int quantized) { return (quantized << 3) | (quantized >> 2); }
+
+// The encoding of a block in one of the modes.
+struct BlockEncoding {
+  int64 error;
+  uint32 high;
+  uint32 low;
+};
+
+void EncodeWithBaseColors(const int pixels[kBlockPixels][3],
+                          bool flip,
+                          const int base[2][3],
+                          uint32 base_color_bits,
+                          bool differential,
+                          BlockEncoding* encoding) {
+  SubblockFit fits[2];
+  FitSubblock(pixels, flip, 0, base[0], &fits[0]);
+  FitSubblock(pixels, flip, 1, base[1], &fits[1]);
+
+  encoding->error = fits[0].error + fits[1].error;
+  encoding->high = base_color_bits | (fits[0].table << 5) |
+                   (fits[1].table << 2) | (differential << 1) | flip;
+  encoding->low = 0;
+  for (int i = 0; i < kBlockPixels; ++i) {
+    int pixel_index = fits[IsInSecondSubblock(i, flip)].pixel_indices[i];
+    encoding->low |= (pixel_index >> 1) << (16 + i);
+    encoding->low |= (pixel_index & 1) << i;
+  }
+}
+
+void EncodeBlock(const int pixels[kBlockPixels][3], uint8_t* dst) {
+  BlockEncoding best;
+  best.error = std::numeric_limits<int64>::max();
+
+  for (int flip = 0; flip < 2; ++flip) {
+    int average[2][3] = {{0, 0, 0}, {0, 0, 0}};
+    for (int i = 0; i < kBlockPixels; ++i) {
+      for (int c = 0; c < 3; ++c)
+        average[IsInSecondSubblock(i, flip)][c] += pixels[i][c];
+    }
+    for (int subblock = 0; subblock < 2; ++subblock) {
+      for (int c = 0; c < 3; ++c)
+        average[subblock][c] = (average[subblock][c] + 4) / 8;
+    }
+
+    // Individual mode, with two 4-bit base colors.
+    int base[2][3];
+    uint32 base_color_bits = 0;
+    for (int c = 0; c < 3; ++c) {
+      int first = Quantize(average[0][c], 15);
+      int second = Quantize(average[1][c], 15);
+      base[0][c] = Expand4(first);
+      base[1][c] = Expand4(second);
+      base_color_bits |= ((first << 4) | second) << (24 - 8 * c);
+    }
+    BlockEncoding encoding;
+    EncodeWithBaseColors(pixels, flip, base, base_color_bits, false, &encoding);
+    if (encoding.error < best.error)
+      best = encoding;
+
+    // Differential mode, with a 5-bit base color and a 3-bit signed offset
+    // to the second one, which is more precise when the subblocks are close.
+    bool can_use_differential = true;
+    base_color_bits = 0;
+    for (int c = 0; c < 3; ++c) {
+      int first = Quantize(average[0][c], 31);
+      int second = Quantize(average[1][c], 31);
+      int offset = second - first;
+      if (offset < -4 || offset > 3) {
+        can_use_differential = false;
+        break;
+      }
+      base[0][c] = Expand5(first);
+      base[1][c] = Expand5(second);
+      base_color_bits |= ((first << 3) | (offset & 7)) << (24 - 8 * c);
+    }
+    if (!can_use_differential)
+      continue;
+    EncodeWithBaseColors(pixels, flip, base, base_color_bits, true, &encoding);
+    if (encoding.error < best.error)
+      best = encoding;
+  }
+
+  dst[0] = best.high >> 24;
+  dst[1] = best.high >> 16;
+  dst[2] = best.high >> 8;
+  dst[3] = best.high;
+  dst[4] = best.low >> 24;
+  dst[5] = best.low >> 16;
+  dst[6] = best.low >> 8;
+  dst[7] = best.low;
+}
+
+int BlocksForPixels(int pixels) {
+  return (pixels + kBlockSize - 1) / kBlockSize;
+}
+
+}  // namespace
+
+// static
+size_t ETC1Encoder::EncodedSizeInBytes(const gfx::Size& size) {
+  return BlocksForPixels(size.width()) * BlocksForPixels(size.height()) *
+         kBytesPerBlock;
+}
+
+// static
+void ETC1Encoder::Encode(const SkBitmap& bitmap, uint8_t* dst) {
+  DCHECK_EQ(SkBitmap::kARGB_8888_Config, bitmap.config());
+  SkAutoLockPixels lock_pixels(bitmap);
+
+  int width = bitmap.width();
+  int height = bitmap.height();
+  for (int block_y = 0; block_y < height; block_y += kBlockSize) {
+    for (int block_x = 0; block_x < width; block_x += kBlockSize) {
+      int pixels[kBlockPixels][3];
+      for (int x = 0; x < kBlockSize; ++x) {
+        for (int y = 0; y < kBlockSize; ++y) {
+          SkPMColor color = *bitmap.getAddr32(
+              std::min(block_x + x, width - 1),
+              std::min(block_y + y, height - 1));
+          int* pixel = pixels[kBlockSize * x + y];
+          pixel[0] = SkGetPackedR32(color);
+          pixel[1] = SkGetPackedG32(color);
+          pixel[2] = SkGetPackedB32(color);
+        }
+      }
+      EncodeBlock(pixels, dst);
+      dst += kBytesPerBlock;
+    }
+  }
+}
+
+}  // namespace cc
@@ -0,0 +1,43 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_RESOURCES_ETC1_ENCODER_H_
+#define CC_RESOURCES_ETC1_ENCODER_H_
+
+#include "base/basictypes.h"
+#include "cc/base/cc_export.h"
+
+class SkBitmap;
+
+namespace gfx {
+class Size;
+}
+
+namespace cc {
+
+// Compresses bitmaps to the ETC1 format of GL_OES_compressed_ETC1_RGB8_texture,
+// which stores each block of 4x4 pixels in 8 bytes, a sixth of the memory
+// used by RGBA_8888. ETC1 has no alpha channel, so only opaque bitmaps should
+// be compressed.
+class CC_EXPORT ETC1Encoder {
+ public:
+  // The size of the compressed data of a texture of |size|. Textures whose
+  // dimensions aren't multiples of 4 use partial blocks on the edges.
+  static size_t EncodedSizeInBytes(const gfx::Size& size);
+
+  // Compresses |bitmap|, which must be a kARGB_8888_Config bitmap, to |dst|,
+  // which must hold EncodedSizeInBytes() of the bitmap's size. The blocks are
+  // written in rows, and the pixels of partial blocks are padded with the
+  // edges of the bitmap.
+  static void Encode(const SkBitmap& bitmap, uint8_t* dst);
+
+ private:
+  ETC1Encoder();  // Not instantiable.
+
+  DISALLOW_COPY_AND_ASSIGN(ETC1Encoder);
+};
+
+}  // namespace cc
+
+#endif  // CC_RESOURCES_ETC1_ENCODER_H_
@@ -0,0 +1,135 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/resources/etc1_encoder.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkColor.h"
+#include "ui/gfx/size.h"
+
+namespace cc {
+namespace {
+
+const int kModifierTables[8][2] = {{2, 8}, {5, 17}, {9, 29}, {13, 42},
+                                   {18, 60}, {24, 80}, {33, 106}, {47, 183}};
+
+int Clamp(int value) { return std::min(255, std::max(0, value)); }
+
+// Decodes the pixel at (|x|, |y|) of the 8 byte ETC1 |block|.
+SkColor DecodePixel(const uint8_t* block, int x, int y) {
+  uint32 high = (block[0] << 24) | (block[1] << 16) | (block[2] << 8) |
+                block[3];
+  uint32 low = (block[4] << 24) | (block[5] << 16) | (block[6] << 8) |
+               block[7];
+  bool flip = high & 1;
+  bool differential = high & 2;
+  int subblock = flip ? y >= 2 : x >= 2;
+
+  int base[3];
+  for (int c = 0; c < 3; ++c) {
+    int bits = (high >> (24 - 8 * c)) & 0xff;
+    if (differential) {
+      int first = bits >> 3;
+      int offset = bits & 4 ? (bits & 7) - 8 : bits & 7;
+      int value = subblock ? first + offset : first;
+      base[c] = (value << 3) | (value >> 2);
+    } else {
+      int value = subblock ? bits & 0xf : bits >> 4;
+      base[c] = (value << 4) | value;
+    }
+  }
+
+  int table = subblock ? (high >> 2) & 7 : (high >> 5) & 7;
+  int position = 4 * x + y;
+  int pixel_index = (((low >> (16 + position)) & 1) << 1) |
+                    ((low >> position) & 1);
+  int modifier = kModifierTables[table][pixel_index & 1];
+  if (pixel_index & 2)
+    modifier = -modifier;
+  return SkColorSetRGB(Clamp(base[0] + modifier),
+                       Clamp(base[1] + modifier),
+                       Clamp(base[2] + modifier));
+}
+
+SkColor DecodeBitmapPixel(const std::vector<uint8_t>& data,
+                          const gfx::Size& size,
+                          int x,
+                          int y) {
+  int blocks_per_row = (size.width() + 3) / 4;
+  const uint8_t* block = &data[8 * ((y / 4) * blocks_per_row + x / 4)];
+  return DecodePixel(block, x % 4, y % 4);
+}
+
+int MaxChannelDifference(SkColor a, SkColor b) {
+  return std::max(
+      std::abs(static_cast<int>(SkColorGetR(a)) -
+               static_cast<int>(SkColorGetR(b))),
+      std::max(std::abs(static_cast<int>(SkColorGetG(a)) -
+                        static_cast<int>(SkColorGetG(b))),
+               std::abs(static_cast<int>(SkColorGetB(a)) -
+                        static_cast<int>(SkColorGetB(b)))));
+}
+
+void ExpectEncodedBitmapNear(const SkBitmap& bitmap, int tolerance) {
+  gfx::Size size(bitmap.width(), bitmap.height());
+  std::vector<uint8_t> data(ETC1Encoder::EncodedSizeInBytes(size));
+  ETC1Encoder::Encode(bitmap, &data[0]);
+
+  SkAutoLockPixels lock_pixels(bitmap);
+  for (int y = 0; y < size.height(); ++y) {
+    for (int x = 0; x < size.width(); ++x) {
+      EXPECT_GE(tolerance,
+                MaxChannelDifference(bitmap.getColor(x, y),
+                                     DecodeBitmapPixel(data, size, x, y)))
+          << "at " << x << ", " << y;
+    }
+  }
+}
+
+TEST(ETC1EncoderTest, EncodedSizeInBytes) {
+  EXPECT_EQ(8u, ETC1Encoder::EncodedSizeInBytes(gfx::Size(4, 4)));
+  EXPECT_EQ(32768u, ETC1Encoder::EncodedSizeInBytes(gfx::Size(256, 256)));
+  EXPECT_EQ(32u, ETC1Encoder::EncodedSizeInBytes(gfx::Size(5, 7)));
+}
+
+TEST(ETC1EncoderTest, SolidColor) {
+  SkBitmap bitmap;
+  bitmap.setConfig(SkBitmap::kARGB_8888_Config, 8, 8);
+  bitmap.allocPixels();
+  bitmap.eraseColor(SkColorSetRGB(0x40, 0x80, 0xc0));
+
+  ExpectEncodedBitmapNear(bitmap, 6);
+}
+
+TEST(ETC1EncoderTest, SubblocksWithDistantColors) {
+  // The halves are too far apart for the differential mode, and are split
+  // horizontally in one block and vertically in the other.
+  SkBitmap bitmap;
+  bitmap.setConfig(SkBitmap::kARGB_8888_Config, 8, 4);
+  bitmap.allocPixels();
+  bitmap.eraseColor(SK_ColorWHITE);
+  bitmap.eraseArea(SkIRect::MakeXYWH(0, 0, 2, 4), SK_ColorBLACK);
+  bitmap.eraseArea(SkIRect::MakeXYWH(4, 2, 4, 2), SK_ColorBLACK);
+
+  ExpectEncodedBitmapNear(bitmap, 8);
+}
+
+TEST(ETC1EncoderTest, PartialBlocks) {
+  SkBitmap bitmap;
+  bitmap.setConfig(SkBitmap::kARGB_8888_Config, 6, 5);
+  bitmap.allocPixels();
+  bitmap.eraseColor(SkColorSetRGB(0x10, 0x20, 0x30));
+  bitmap.eraseArea(SkIRect::MakeXYWH(4, 0, 2, 5),
+                   SkColorSetRGB(0xa0, 0xb0, 0xc0));
+
+  ExpectEncodedBitmapNear(bitmap, 8);
+}
+
+}  // namespace
+}  // namespace cc
@@ -29,7 +29,8 @@ ImageRasterWorkerPool::ImageRasterWorkerPool(
     : RasterWorkerPool(task_graph_runner, resource_provider),
       texture_target_(texture_target),
       raster_tasks_pending_(false),
-      raster_tasks_required_for_activation_pending_(false) {}
+      raster_tasks_required_for_activation_pending_(false),
+      bytes_rasterized_without_upload_(0) {}
 
 ImageRasterWorkerPool::~ImageRasterWorkerPool() {}
 
@@ -139,6 +140,16 @@ void ImageRasterWorkerPool::OnRasterCompleted(
     internal::RasterWorkerPoolTask* task,
     const PicturePileImpl::Analysis& analysis) {
   resource_provider()->UnmapImageRasterBuffer(task->resource()->id());
+
+  // Solid color tiles aren't uploaded by the other pools either.
+  if (analysis.is_solid_color)
+    return;
+
+  bytes_rasterized_without_upload_ += task->resource()->bytes();
+  TRACE_COUNTER_ID1("cc",
+                    "bytes_rasterized_without_upload",
+                    this,
+                    bytes_rasterized_without_upload_);
 }
 
 void ImageRasterWorkerPool::OnRasterTasksFinished() {
@@ -166,6 +177,8 @@ scoped_ptr<base::Value> ImageRasterWorkerPool::StateAsValue() const {
 
   state->SetBoolean("tasks_required_for_activation_pending",
                     raster_tasks_required_for_activation_pending_);
+  state->SetDouble("bytes_rasterized_without_upload",
+                   static_cast<double>(bytes_rasterized_without_upload_));
   return state.PassAs<base::Value>();
 }
 
@@ -51,6 +51,10 @@ class CC_EXPORT ImageRasterWorkerPool : public RasterWorkerPool {
   bool raster_tasks_pending_;
   bool raster_tasks_required_for_activation_pending_;
 
+  // Bytes of tiles rasterized straight into images, which the other raster
+  // worker pools would have uploaded from pixel buffers.
+  int64 bytes_rasterized_without_upload_;
+
   // Task graph used when scheduling tasks and vector used to gather
   // completed tasks.
   internal::TaskGraph graph_;
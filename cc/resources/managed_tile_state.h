@@ -54,6 +54,15 @@ class CC_EXPORT ManagedTileState {
       return resource_->id();
     }
 
+    // The resource may be larger than the tile, with the contents of the
+    // tile in its top left corner.
+    gfx::Size get_resource_size() const {
+      DCHECK(mode_ == RESOURCE_MODE);
+      DCHECK(resource_);
+
+      return resource_->size();
+    }
+
     SkColor get_solid_color() const {
       DCHECK(mode_ == SOLID_COLOR_MODE);
 
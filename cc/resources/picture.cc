@@ -16,6 +16,7 @@
 #include "cc/debug/traced_picture.h"
 #include "cc/debug/traced_value.h"
 #include "cc/layers/content_layer_client.h"
+#include "skia/ext/analysis_canvas.h"
 #include "skia/ext/pixel_ref_utils.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkData.h"
@@ -32,6 +33,10 @@ namespace cc {
 
 namespace {
 
+// Pictures with more anti-aliased concave paths than this are faster to
+// rasterize in software.
+const int kMaxSlowPathsForGpuRasterization = 5;
+
 SkData* EncodeBitmap(size_t* offset, const SkBitmap& bm) {
   const int kJpegQuality = 80;
   std::vector<unsigned char> data;
@@ -347,6 +352,39 @@ int Picture::Raster(
   return bounds.width() * bounds.height();
 }
 
+bool Picture::IsSuitableForGpuRasterization() const {
+  TRACE_EVENT0("cc", "Picture::IsSuitableForGpuRasterization");
+  DCHECK(picture_);
+
+  SkBitmap empty_bitmap;
+  empty_bitmap.setConfig(SkBitmap::kNo_Config,
+                         layer_rect_.width(),
+                         layer_rect_.height());
+  skia::AnalysisDevice device(empty_bitmap);
+  skia::AnalysisCanvas canvas(&device);
+  picture_->draw(&canvas);
+
+  return canvas.GetSlowPathCount() <= kMaxSlowPathsForGpuRasterization;
+}
+
+bool Picture::GetColorIfSolidInRect(const gfx::Rect& layer_rect,
+                                    SkColor* color) const {
+  TRACE_EVENT0("cc", "Picture::GetColorIfSolidInRect");
+  DCHECK(picture_);
+
+  SkBitmap empty_bitmap;
+  empty_bitmap.setConfig(SkBitmap::kNo_Config,
+                         layer_rect.width(),
+                         layer_rect.height());
+  skia::AnalysisDevice device(empty_bitmap);
+  skia::AnalysisCanvas canvas(&device);
+  canvas.translate(layer_rect_.x() - layer_rect.x(),
+                   layer_rect_.y() - layer_rect.y());
+  picture_->draw(&canvas, &canvas);
+
+  return canvas.GetColorIfSolid(color);
+}
+
 void Picture::Replay(SkCanvas* canvas) {
   DCHECK(raster_thread_checker_.CalledOnValidThread());
   TRACE_EVENT_BEGIN0("cc", "Picture::Replay");
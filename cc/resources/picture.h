@@ -20,6 +20,7 @@
 #include "cc/base/cc_export.h"
 #include "cc/base/region.h"
 #include "skia/ext/refptr.h"
+#include "third_party/skia/include/core/SkColor.h"
 #include "third_party/skia/include/core/SkTileGridPicture.h"
 #include "ui/gfx/rect.h"
 
@@ -113,6 +114,16 @@ class CC_EXPORT Picture
 
   bool WillPlayBackBitmaps() const { return picture_->willPlayBackBitmaps(); }
 
+  // Plays back the recording to find out if it rasterizes well on the GPU,
+  // which is slow at anti-aliased concave paths. This costs about as much
+  // as gathering pixel refs.
+  bool IsSuitableForGpuRasterization() const;
+
+  // Plays back the part |layer_rect| of the recording to find out if it
+  // rasterizes to a single color, which is then stored in |color|.
+  bool GetColorIfSolidInRect(const gfx::Rect& layer_rect,
+                             SkColor* color) const;
+
  private:
   explicit Picture(const gfx::Rect& layer_rect);
   // This constructor assumes SkPicture is already ref'd and transfers
@@ -10,6 +10,7 @@
 
 #include "base/debug/trace_event.h"
 #include "cc/base/math_util.h"
+#include "cc/trees/occlusion_tracker.h"
 #include "ui/gfx/point_conversions.h"
 #include "ui/gfx/rect_conversions.h"
 #include "ui/gfx/safe_integer_conversions.h"
@@ -391,7 +392,10 @@ void PictureLayerTiling::UpdateTilePriorities(
     WhichTree tree,
     const gfx::Rect& visible_layer_rect,
     float layer_contents_scale,
-    double current_frame_time_in_seconds) {
+    double current_frame_time_in_seconds,
+    const OcclusionTrackerImpl* occlusion_tracker,
+    const LayerImpl* render_target,
+    const gfx::Transform& draw_transform) {
   if (!NeedsUpdateForFrameAtTime(current_frame_time_in_seconds)) {
     // This should never be zero for the purposes of has_ever_been_updated().
     DCHECK_NE(current_frame_time_in_seconds, 0.0);
@@ -430,8 +434,15 @@ void PictureLayerTiling::UpdateTilePriorities(
   last_impl_frame_time_in_seconds_ = current_frame_time_in_seconds;
   last_visible_rect_in_content_space_ = visible_rect_in_content_space;
 
-  // Assign now priority to all visible tiles.
+  // Assign now priority to all visible tiles, except the ones that are fully
+  // occluded, which won't be drawn and so aren't rasterized at all.
   TilePriority now_priority(resolution_, TilePriority::NOW, 0);
+  TilePriority occluded_priority(resolution_,
+                                 TilePriority::EVENTUALLY,
+                                 std::numeric_limits<float>::infinity());
+  gfx::Transform tiling_to_target = draw_transform;
+  tiling_to_target.Scale(layer_contents_scale / contents_scale_,
+                         layer_contents_scale / contents_scale_);
   for (TilingData::Iterator iter(&tiling_data_, visible_rect_in_content_space);
        iter;
        ++iter) {
@@ -440,7 +451,12 @@ void PictureLayerTiling::UpdateTilePriorities(
       continue;
     Tile* tile = find->second.get();
 
-    tile->SetPriority(tree, now_priority);
+    bool is_occluded =
+        occlusion_tracker &&
+        occlusion_tracker->Occluded(
+            render_target, tile->content_rect(), tiling_to_target, false);
+    tile->set_is_occluded(tree, is_occluded);
+    tile->SetPriority(tree, is_occluded ? occluded_priority : now_priority);
   }
 
   // Assign soon priority to all tiles in the skewport that are not visible.
@@ -539,6 +555,9 @@ void PictureLayerTiling::DidBecomeActive() {
   for (TileMap::const_iterator it = tiles_.begin(); it != tiles_.end(); ++it) {
     it->second->SetPriority(ACTIVE_TREE, it->second->priority(PENDING_TREE));
     it->second->SetPriority(PENDING_TREE, TilePriority());
+    it->second->set_is_occluded(ACTIVE_TREE,
+                                it->second->is_occluded(PENDING_TREE));
+    it->second->set_is_occluded(PENDING_TREE, false);
 
     // Tile holds a ref onto a picture pile. If the tile never gets invalidated
     // and recreated, then that picture pile ref could exist indefinitely.  To
@@ -17,10 +17,15 @@
 #include "cc/resources/tile.h"
 #include "cc/resources/tile_priority.h"
 #include "ui/gfx/rect.h"
+#include "ui/gfx/transform.h"
 
 namespace cc {
 
+template <typename LayerType, typename SurfaceType>
+class OcclusionTrackerBase;
 class PictureLayerTiling;
+class LayerImpl;
+class RenderSurfaceImpl;
 
 class CC_EXPORT PictureLayerTilingClient {
  public:
@@ -136,10 +141,19 @@ class CC_EXPORT PictureLayerTiling {
 
   void Reset();
 
-  void UpdateTilePriorities(WhichTree tree,
-                            const gfx::Rect& visible_layer_rect,
-                            float layer_contents_scale,
-                            double current_frame_time_in_seconds);
+  // Visible tiles which |occlusion_tracker| reports as occluded get the
+  // lowest priority instead of the NOW priority. |render_target| and
+  // |draw_transform| are those of the layer, for its content space at
+  // |layer_contents_scale|. |occlusion_tracker| may be NULL.
+  void UpdateTilePriorities(
+      WhichTree tree,
+      const gfx::Rect& visible_layer_rect,
+      float layer_contents_scale,
+      double current_frame_time_in_seconds,
+      const OcclusionTrackerBase<LayerImpl, RenderSurfaceImpl>*
+          occlusion_tracker,
+      const LayerImpl* render_target,
+      const gfx::Transform& draw_transform);
 
   // Copies the src_tree priority into the dst_tree priority for all tiles.
   // The src_tree priority is reset to the lowest priority possible.  This
@@ -6,6 +6,8 @@
 
 #include <limits>
 
+#include "cc/trees/occlusion_tracker.h"
+
 namespace cc {
 
 namespace {
@@ -305,7 +307,10 @@ void PictureLayerTilingSet::UpdateTilePriorities(
     WhichTree tree,
     const gfx::Rect& visible_content_rect,
     float layer_contents_scale,
-    double current_frame_time_in_seconds) {
+    double current_frame_time_in_seconds,
+    const OcclusionTrackerImpl* occlusion_tracker,
+    const LayerImpl* render_target,
+    const gfx::Transform& draw_transform) {
   gfx::Rect visible_layer_rect = gfx::ScaleToEnclosingRect(
       visible_content_rect, 1.f / layer_contents_scale);
 
@@ -313,7 +318,10 @@ void PictureLayerTilingSet::UpdateTilePriorities(
     tilings_[i]->UpdateTilePriorities(tree,
                                       visible_layer_rect,
                                       layer_contents_scale,
-                                      current_frame_time_in_seconds);
+                                      current_frame_time_in_seconds,
+                                      occlusion_tracker,
+                                      render_target,
+                                      draw_transform);
   }
 }
 
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <map>
 #include <vector>
 
 #include "cc/base/region.h"
@@ -141,7 +142,7 @@ float ClusterTiles(const std::vector<gfx::Rect>& invalid_tiles,
 
 namespace cc {
 
-PicturePile::PicturePile() {
+PicturePile::PicturePile() : analyze_for_gpu_rasterization_(false) {
 }
 
 PicturePile::~PicturePile() {
@@ -165,21 +166,61 @@ bool PicturePile::Update(
       -kPixelDistanceToRecord,
       -kPixelDistanceToRecord);
 
-  bool invalidated = false;
+  // Split the invalidation across tile boundaries, to find out how much of
+  // each tile it touches.
+  std::map<PictureMapKey, gfx::Rect> invalid_rects_in_cells;
   for (Region::Iterator i(invalidation); i.has_rect(); i.next()) {
     gfx::Rect invalidation = i.rect();
-    // Split this inflated invalidation across tile boundaries and apply it
-    // to all tiles that it touches.
     for (TilingData::Iterator iter(&tiling_, invalidation);
          iter; ++iter) {
       const PictureMapKey& key = iter.index();
-
-      PictureMap::iterator picture_it = picture_map_.find(key);
-      if (picture_it == picture_map_.end())
+      if (picture_map_.find(key) == picture_map_.end())
         continue;
 
-      // Inform the grid cell that it has been invalidated in this frame.
-      invalidated = picture_it->second.Invalidate(frame_number) || invalidated;
+      gfx::Rect invalid_rect = invalidation;
+      invalid_rect.Intersect(PaddedRect(key));
+      if (!invalid_rect.IsEmpty())
+        invalid_rects_in_cells[key].Union(invalid_rect);
+    }
+  }
+
+  // Cells near the viewport with a small invalidated part will be patched.
+  // Inform the other grid cells that they have been invalidated in this
+  // frame, which drops their pictures.
+  bool invalidated = false;
+  std::vector<PictureMapKey> cells_to_patch;
+  std::vector<gfx::Rect> patch_rects;
+  for (std::map<PictureMapKey, gfx::Rect>::iterator it =
+           invalid_rects_in_cells.begin();
+       it != invalid_rects_in_cells.end();
+       ++it) {
+    PictureInfo& info = picture_map_[it->first];
+    gfx::Rect cell_rect = PaddedRect(it->first);
+    if (cell_rect.Intersects(interest_rect) &&
+        info.CanPatch(it->second, cell_rect)) {
+      cells_to_patch.push_back(it->first);
+      patch_rects.push_back(it->second);
+      invalidated = true;
+      continue;
+    }
+    invalidated = info.Invalidate(frame_number) || invalidated;
+  }
+
+  // Record the patches, clustered like the invalid tiles below, and put each
+  // over the cells whose invalidated parts it contains.
+  std::vector<gfx::Rect> patch_record_rects;
+  ClusterTiles(patch_rects, &patch_record_rects);
+  std::vector<bool> patched(cells_to_patch.size(), false);
+  for (std::vector<gfx::Rect>::iterator it = patch_record_rects.begin();
+       it != patch_record_rects.end();
+       ++it) {
+    scoped_refptr<Picture> patch =
+        RecordPicture(painter, PadRect(*it), stats_instrumentation);
+    for (size_t i = 0; i < cells_to_patch.size(); ++i) {
+      if (patched[i] || !it->Contains(patch_rects[i]))
+        continue;
+      picture_map_[cells_to_patch[i]].AddPatch(frame_number, patch);
+      patched[i] = true;
     }
   }
 
@@ -217,34 +258,8 @@ bool PicturePile::Update(
     gfx::Rect record_rect = *it;
     record_rect = PadRect(record_rect);
 
-    int repeat_count = std::max(1, slow_down_raster_scale_factor_for_debug_);
-    scoped_refptr<Picture> picture;
-    int num_raster_threads = RasterWorkerPool::GetNumRasterThreads();
-
-    // Note: Currently, gathering of pixel refs when using a single
-    // raster thread doesn't provide any benefit. This might change
-    // in the future but we avoid it for now to reduce the cost of
-    // Picture::Create.
-    bool gather_pixel_refs = num_raster_threads > 1;
-
-    {
-      base::TimeDelta best_duration = base::TimeDelta::FromInternalValue(
-          std::numeric_limits<int64>::max());
-      for (int i = 0; i < repeat_count; i++) {
-        base::TimeTicks start_time = stats_instrumentation->StartRecording();
-        picture = Picture::Create(record_rect,
-                                  painter,
-                                  tile_grid_info_,
-                                  gather_pixel_refs,
-                                  num_raster_threads);
-        base::TimeDelta duration =
-            stats_instrumentation->EndRecording(start_time);
-        best_duration = std::min(duration, best_duration);
-      }
-      int recorded_pixel_count =
-          picture->LayerRect().width() * picture->LayerRect().height();
-      stats_instrumentation->AddRecord(best_duration, recorded_pixel_count);
-    }
+    scoped_refptr<Picture> picture =
+        RecordPicture(painter, record_rect, stats_instrumentation);
 
     for (TilingData::Iterator it(&tiling_, record_rect);
         it; ++it) {
@@ -253,6 +268,15 @@ bool PicturePile::Update(
       if (record_rect.Contains(tile)) {
         PictureInfo& info = picture_map_[key];
         info.SetPicture(picture);
+
+        // Finding out now whether the cell is a single color saves tiles
+        // within it from being analyzed, or rasterized, later.
+        gfx::Rect analysis_rect = tile;
+        analysis_rect.Intersect(gfx::Rect(tiling_.total_size()));
+        SkColor solid_color;
+        if (!analysis_rect.IsEmpty() &&
+            picture->GetColorIfSolidInRect(analysis_rect, &solid_color))
+          info.SetSolidColor(solid_color);
       }
     }
   }
@@ -261,4 +285,43 @@ bool PicturePile::Update(
   return true;
 }
 
+scoped_refptr<Picture> PicturePile::RecordPicture(
+    ContentLayerClient* painter,
+    const gfx::Rect& record_rect,
+    RenderingStatsInstrumentation* stats_instrumentation) {
+  int repeat_count = std::max(1, slow_down_raster_scale_factor_for_debug_);
+  scoped_refptr<Picture> picture;
+  int num_raster_threads = RasterWorkerPool::GetNumRasterThreads();
+
+  // Note: Currently, gathering of pixel refs when using a single
+  // raster thread doesn't provide any benefit. This might change
+  // in the future but we avoid it for now to reduce the cost of
+  // Picture::Create.
+  bool gather_pixel_refs = num_raster_threads > 1;
+
+  base::TimeDelta best_duration =
+      base::TimeDelta::FromInternalValue(std::numeric_limits<int64>::max());
+  for (int i = 0; i < repeat_count; i++) {
+    base::TimeTicks start_time = stats_instrumentation->StartRecording();
+    picture = Picture::Create(record_rect,
+                              painter,
+                              tile_grid_info_,
+                              gather_pixel_refs,
+                              num_raster_threads);
+    base::TimeDelta duration = stats_instrumentation->EndRecording(start_time);
+    best_duration = std::min(duration, best_duration);
+  }
+  int recorded_pixel_count =
+      picture->LayerRect().width() * picture->LayerRect().height();
+  stats_instrumentation->AddRecord(best_duration, recorded_pixel_count);
+
+  // Once content unsuitable for GPU rasterization showed up, keep the
+  // pile in software so that its layer doesn't switch back and forth.
+  if (analyze_for_gpu_rasterization_ && is_suitable_for_gpu_rasterization_)
+    is_suitable_for_gpu_rasterization_ =
+        picture->IsSuitableForGpuRasterization();
+
+  return picture;
+}
+
 }  // namespace cc
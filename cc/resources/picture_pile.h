@@ -18,7 +18,8 @@ class CC_EXPORT PicturePile : public PicturePileBase {
   PicturePile();
 
   // Re-record parts of the picture that are invalid.
-  // Invalidations are in layer space.
+  // Invalidations are in layer space. Cells with only a small part
+  // invalidated keep their pictures, and get a patch recorded over that part.
   // Return true iff the pile was modified.
   bool Update(
       ContentLayerClient* painter,
@@ -37,12 +38,26 @@ class CC_EXPORT PicturePile : public PicturePileBase {
     show_debug_picture_borders_ = show;
   }
 
+  // Analyze new recordings to find out if the pile is suitable for GPU
+  // rasterization.
+  void set_analyze_for_gpu_rasterization(bool analyze) {
+    analyze_for_gpu_rasterization_ = analyze;
+  }
+
  protected:
   virtual ~PicturePile();
 
  private:
   friend class PicturePileImpl;
 
+  // Records |record_rect| and reports the cost to |stats_instrumentation|.
+  scoped_refptr<Picture> RecordPicture(
+      ContentLayerClient* painter,
+      const gfx::Rect& record_rect,
+      RenderingStatsInstrumentation* stats_instrumentation);
+
+  bool analyze_for_gpu_rasterization_;
+
   DISALLOW_COPY_AND_ASSIGN(PicturePile);
 };
 
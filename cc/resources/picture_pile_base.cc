@@ -34,6 +34,11 @@ const bool kDefaultClearCanvasSetting = true;
 const float kInvalidationFrequencyThreshold = 0.75f;
 const int kFrequentInvalidationDistanceThreshold = 512;
 
+// Invalidations covering at most this fraction of a cell are recorded into
+// patches over its pictures, until the cell has PictureInfo::MAX_PATCHES of
+// them. At that point the whole cell is recorded again, dropping the patches.
+const float kMaxPatchAreaFraction = 0.25f;
+
 }  // namespace
 
 namespace cc {
@@ -44,7 +49,8 @@ PicturePileBase::PicturePileBase()
       slow_down_raster_scale_factor_for_debug_(0),
       contents_opaque_(false),
       show_debug_picture_borders_(false),
-      clear_canvas_with_debug_color_(kDefaultClearCanvasSetting) {
+      clear_canvas_with_debug_color_(kDefaultClearCanvasSetting),
+      is_suitable_for_gpu_rasterization_(true) {
   tiling_.SetMaxTextureSize(gfx::Size(kBasePictureSize, kBasePictureSize));
   tile_grid_info_.fTileInterval.setEmpty();
   tile_grid_info_.fMargin.setEmpty();
@@ -62,7 +68,9 @@ PicturePileBase::PicturePileBase(const PicturePileBase* other)
           other->slow_down_raster_scale_factor_for_debug_),
       contents_opaque_(other->contents_opaque_),
       show_debug_picture_borders_(other->show_debug_picture_borders_),
-      clear_canvas_with_debug_color_(other->clear_canvas_with_debug_color_) {
+      clear_canvas_with_debug_color_(other->clear_canvas_with_debug_color_),
+      is_suitable_for_gpu_rasterization_(
+          other->is_suitable_for_gpu_rasterization_) {
 }
 
 PicturePileBase::PicturePileBase(
@@ -76,7 +84,9 @@ PicturePileBase::PicturePileBase(
           other->slow_down_raster_scale_factor_for_debug_),
       contents_opaque_(other->contents_opaque_),
       show_debug_picture_borders_(other->show_debug_picture_borders_),
-      clear_canvas_with_debug_color_(other->clear_canvas_with_debug_color_) {
+      clear_canvas_with_debug_color_(other->clear_canvas_with_debug_color_),
+      is_suitable_for_gpu_rasterization_(
+          other->is_suitable_for_gpu_rasterization_) {
   for (PictureMap::const_iterator it = other->picture_map_.begin();
        it != other->picture_map_.end();
        ++it) {
@@ -217,16 +227,22 @@ scoped_ptr<base::Value> PicturePileBase::AsValue() const {
     if (map_iter == picture_map_.end())
       continue;
 
-    Picture* picture = map_iter->second.GetPicture();
-    if (picture && (appended_pictures.count(picture) == 0)) {
-      appended_pictures.insert(picture);
-      pictures->Append(TracedValue::CreateIDRef(picture).release());
+    const PictureInfo& info = map_iter->second;
+    for (size_t i = 0; i < info.num_pictures(); ++i) {
+      Picture* picture = info.GetPictureAt(i);
+      if (appended_pictures.count(picture) == 0) {
+        appended_pictures.insert(picture);
+        pictures->Append(TracedValue::CreateIDRef(picture).release());
+      }
     }
   }
   return pictures.PassAs<base::Value>();
 }
 
-PicturePileBase::PictureInfo::PictureInfo() : last_frame_number_(0) {}
+PicturePileBase::PictureInfo::PictureInfo()
+    : last_frame_number_(0),
+      is_solid_color_(false),
+      solid_color_(SK_ColorTRANSPARENT) {}
 
 PicturePileBase::PictureInfo::~PictureInfo() {}
 
@@ -246,9 +262,28 @@ bool PicturePileBase::PictureInfo::Invalidate(int frame_number) {
 
   bool did_invalidate = !!picture_;
   picture_ = NULL;
+  patches_.clear();
+  is_solid_color_ = false;
   return did_invalidate;
 }
 
+bool PicturePileBase::PictureInfo::CanPatch(const gfx::Rect& invalid_rect,
+                                            const gfx::Rect& cell_rect) const {
+  if (!picture_ || patches_.size() >= static_cast<size_t>(MAX_PATCHES))
+    return false;
+  return invalid_rect.size().GetArea() <=
+         kMaxPatchAreaFraction * cell_rect.size().GetArea();
+}
+
+void PicturePileBase::PictureInfo::AddPatch(int frame_number,
+                                            scoped_refptr<Picture> patch) {
+  DCHECK(picture_);
+  AdvanceInvalidationHistory(frame_number);
+  invalidation_history_.set(0);
+  patches_.push_back(patch);
+  is_solid_color_ = false;
+}
+
 bool PicturePileBase::PictureInfo::NeedsRecording(int frame_number,
                                                   int distance_to_visible) {
   AdvanceInvalidationHistory(frame_number);
@@ -264,17 +299,39 @@ bool PicturePileBase::PictureInfo::NeedsRecording(int frame_number,
 
 void PicturePileBase::PictureInfo::SetPicture(scoped_refptr<Picture> picture) {
   picture_ = picture;
+  patches_.clear();
+  is_solid_color_ = false;
 }
 
 Picture* PicturePileBase::PictureInfo::GetPicture() const {
   return picture_.get();
 }
 
+Picture* PicturePileBase::PictureInfo::GetPictureAt(size_t index) const {
+  DCHECK_LT(index, num_pictures());
+  return index ? patches_[index - 1].get() : picture_.get();
+}
+
+void PicturePileBase::PictureInfo::SetSolidColor(SkColor color) {
+  DCHECK(picture_);
+  is_solid_color_ = true;
+  solid_color_ = color;
+}
+
+bool PicturePileBase::PictureInfo::GetSolidColor(SkColor* color) const {
+  if (!is_solid_color_)
+    return false;
+  *color = solid_color_;
+  return true;
+}
+
 PicturePileBase::PictureInfo PicturePileBase::PictureInfo::CloneForThread(
     int thread_index) const {
   PictureInfo info = *this;
   if (picture_.get())
     info.picture_ = picture_->GetCloneForDrawingOnThread(thread_index);
+  for (size_t i = 0; i < patches_.size(); ++i)
+    info.patches_[i] = patches_[i]->GetCloneForDrawingOnThread(thread_index);
   return info;
 }
 
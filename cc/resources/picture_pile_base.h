@@ -8,6 +8,7 @@
 #include <bitset>
 #include <list>
 #include <utility>
+#include <vector>
 
 #include "base/containers/hash_tables.h"
 #include "base/memory/ref_counted.h"
@@ -15,6 +16,7 @@
 #include "cc/base/region.h"
 #include "cc/base/tiling_data.h"
 #include "cc/resources/picture.h"
+#include "third_party/skia/include/core/SkColor.h"
 #include "ui/gfx/size.h"
 
 namespace base {
@@ -48,13 +50,20 @@ class CC_EXPORT PicturePileBase : public base::RefCounted<PicturePileBase> {
   void SetTileGridSize(const gfx::Size& tile_grid_size);
   TilingData& tiling() { return tiling_; }
 
+  // False once a recording of the pile was found to rasterize poorly on
+  // the GPU. Only tracked when analyzing for GPU rasterization.
+  bool is_suitable_for_gpu_rasterization() const {
+    return is_suitable_for_gpu_rasterization_;
+  }
+
   scoped_ptr<base::Value> AsValue() const;
 
  protected:
   class CC_EXPORT PictureInfo {
    public:
     enum {
-      INVALIDATION_FRAMES_TRACKED = 32
+      INVALIDATION_FRAMES_TRACKED = 32,
+      MAX_PATCHES = 4
     };
 
     PictureInfo();
@@ -66,6 +75,28 @@ class CC_EXPORT PicturePileBase : public base::RefCounted<PicturePileBase> {
     void SetPicture(scoped_refptr<Picture> picture);
     Picture* GetPicture() const;
 
+    // Whether the part |invalid_rect| of the cell |cell_rect| can be recorded
+    // into a patch over the cell's pictures, instead of recording the whole
+    // cell again. Patches are only worth it for small parts of the cell.
+    bool CanPatch(const gfx::Rect& invalid_rect,
+                  const gfx::Rect& cell_rect) const;
+    // Notes the invalidation in |frame_number| like Invalidate(), but keeps
+    // the pictures and adds |patch| over them, for its layer rect.
+    void AddPatch(int frame_number, scoped_refptr<Picture> patch);
+
+    // The pictures of the cell, the one set by SetPicture() followed by the
+    // patches in the order they were added. Each covers the ones before it.
+    size_t num_pictures() const {
+      return picture_.get() ? patches_.size() + 1 : 0;
+    }
+    Picture* GetPictureAt(size_t index) const;
+
+    // Notes that the pictures of the cell rasterize to |color| over all of
+    // the cell, which was found when recording them. Reset when the pictures
+    // change.
+    void SetSolidColor(SkColor color);
+    bool GetSolidColor(SkColor* color) const;
+
     float GetInvalidationFrequencyForTesting() const {
       return GetInvalidationFrequency();
     }
@@ -76,6 +107,9 @@ class CC_EXPORT PicturePileBase : public base::RefCounted<PicturePileBase> {
 
     int last_frame_number_;
     scoped_refptr<Picture> picture_;
+    std::vector<scoped_refptr<Picture> > patches_;
+    bool is_solid_color_;
+    SkColor solid_color_;
     std::bitset<INVALIDATION_FRAMES_TRACKED> invalidation_history_;
   };
 
@@ -106,6 +140,7 @@ class CC_EXPORT PicturePileBase : public base::RefCounted<PicturePileBase> {
   bool contents_opaque_;
   bool show_debug_picture_borders_;
   bool clear_canvas_with_debug_color_;
+  bool is_suitable_for_gpu_rasterization_;
 
  private:
   void SetBufferPixels(int buffer_pixels);
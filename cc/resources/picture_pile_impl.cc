@@ -170,39 +170,54 @@ void PicturePileImpl::CoalesceRasters(const gfx::Rect& canvas_rect,
   // that and subtract chunk rects to get the region that we need to subtract
   // from the canvas. Then, we can use clipRect with difference op to subtract
   // each rect in the region.
+  //
+  // The patches of a chunk cover the pictures before them, so each picture of
+  // the chunk is only drawn in the part of the chunk not covered by the
+  // patches after it. The regions where the pictures are drawn are collected
+  // first, and negated once complete.
   for (TilingData::Iterator tile_iter(&tiling_, layer_rect);
        tile_iter; ++tile_iter) {
     PictureMap::iterator map_iter = picture_map_.find(tile_iter.index());
     if (map_iter == picture_map_.end())
       continue;
     PictureInfo& info = map_iter->second;
-    Picture* picture = info.GetPicture();
-    if (!picture)
+    if (!info.num_pictures())
       continue;
 
     // This is intentionally *enclosed* rect, so that the clip is aligned on
     // integral post-scale content pixels and does not extend past the edges
     // of the picture chunk's layer rect.  The min_contents_scale enforces that
     // enough buffer pixels have been added such that the enclosed rect
-    // encompasses all invalidated pixels at any larger scale level.
+    // encompasses all invalidated pixels at any larger scale level. Patches
+    // are recorded with the same padding.
     gfx::Rect chunk_rect = PaddedRect(tile_iter.index());
     gfx::Rect content_clip =
         gfx::ScaleToEnclosedRect(chunk_rect, contents_scale);
     DCHECK(!content_clip.IsEmpty()) << "Layer rect: "
-                                    << picture->LayerRect().ToString()
+                                    << info.GetPicture()->LayerRect().ToString()
                                     << "Contents scale: " << contents_scale;
     content_clip.Intersect(canvas_rect);
 
-    PictureRegionMap::iterator it = results->find(picture);
-    if (it == results->end()) {
-      Region& region = (*results)[picture];
-      region = content_rect;
-      region.Subtract(content_clip);
-      continue;
+    Region uncovered_clip = content_clip;
+    for (size_t i = info.num_pictures(); i-- > 0;) {
+      Picture* picture = info.GetPictureAt(i);
+      Region clip = uncovered_clip;
+      if (i) {
+        gfx::Rect patch_clip =
+            gfx::ScaleToEnclosedRect(picture->LayerRect(), contents_scale);
+        clip.Intersect(patch_clip);
+        uncovered_clip.Subtract(patch_clip);
+      }
+      (*results)[picture].Union(clip);
     }
+  }
 
-    Region& region = it->second;
-    region.Subtract(content_clip);
+  for (PictureRegionMap::iterator it = results->begin();
+       it != results->end();
+       ++it) {
+    Region negated_clip = content_rect;
+    negated_clip.Subtract(it->second);
+    it->second.Swap(&negated_clip);
   }
 }
 
@@ -325,6 +340,13 @@ void PicturePileImpl::AnalyzeInRect(
   DCHECK(analysis);
   TRACE_EVENT0("cc", "PicturePileImpl::AnalyzeInRect");
 
+  if (GetSolidColorFromRecording(
+          content_rect, contents_scale, &analysis->solid_color)) {
+    analysis->is_solid_color = true;
+    analysis->has_text = false;
+    return;
+  }
+
   gfx::Rect layer_rect = gfx::ScaleToEnclosingRect(
       content_rect, 1.0f / contents_scale);
 
@@ -343,6 +365,40 @@ void PicturePileImpl::AnalyzeInRect(
   analysis->has_text = canvas.HasText();
 }
 
+bool PicturePileImpl::GetSolidColorFromRecording(
+    const gfx::Rect& content_rect,
+    float contents_scale,
+    SkColor* color) const {
+  gfx::Rect layer_rect = gfx::ScaleToEnclosingRect(
+      content_rect, 1.0f / contents_scale);
+  layer_rect.Intersect(gfx::Rect(tiling_.total_size()));
+  if (layer_rect.IsEmpty())
+    return false;
+
+  // Every pixel of the rect is rasterized from one of the cells under it,
+  // so it is solid if all of them are, in the same color.
+  bool has_color = false;
+  SkColor solid_color = SK_ColorTRANSPARENT;
+  for (TilingData::Iterator tile_iter(&tiling_, layer_rect);
+       tile_iter; ++tile_iter) {
+    PictureMap::const_iterator map_iter = picture_map_.find(tile_iter.index());
+    if (map_iter == picture_map_.end())
+      return false;
+    SkColor cell_color;
+    if (!map_iter->second.GetSolidColor(&cell_color))
+      return false;
+    if (has_color && cell_color != solid_color)
+      return false;
+    has_color = true;
+    solid_color = cell_color;
+  }
+
+  if (!has_color)
+    return false;
+  *color = solid_color;
+  return true;
+}
+
 PicturePileImpl::Analysis::Analysis()
     : is_solid_color(false),
       has_text(false) {
@@ -358,7 +414,8 @@ PicturePileImpl::PixelRefIterator::PixelRefIterator(
     : picture_pile_(picture_pile),
       layer_rect_(gfx::ScaleToEnclosingRect(
           content_rect, 1.f / contents_scale)),
-      tile_iterator_(&picture_pile_->tiling_, layer_rect_) {
+      tile_iterator_(&picture_pile_->tiling_, layer_rect_),
+      picture_index_(0) {
   // Early out if there isn't a single tile.
   if (!tile_iterator_)
     return;
@@ -375,7 +432,7 @@ PicturePileImpl::PixelRefIterator&
   if (pixel_ref_iterator_)
     return *this;
 
-  ++tile_iterator_;
+  ++picture_index_;
   AdvanceToTilePictureWithPixelRefs();
   return *this;
 }
@@ -387,15 +444,19 @@ void PicturePileImpl::PixelRefIterator::AdvanceToTilePictureWithPixelRefs() {
     if (it == picture_pile_->picture_map_.end())
       continue;
 
-    const Picture* picture = it->second.GetPicture();
-    if (!picture || (processed_pictures_.count(picture) != 0) ||
-        !picture->WillPlayBackBitmaps())
-      continue;
-
-    processed_pictures_.insert(picture);
-    pixel_ref_iterator_ = Picture::PixelRefIterator(layer_rect_, picture);
-    if (pixel_ref_iterator_)
-      break;
+    const PictureInfo& info = it->second;
+    for (; picture_index_ < info.num_pictures(); ++picture_index_) {
+      const Picture* picture = info.GetPictureAt(picture_index_);
+      if ((processed_pictures_.count(picture) != 0) ||
+          !picture->WillPlayBackBitmaps())
+        continue;
+
+      processed_pictures_.insert(picture);
+      pixel_ref_iterator_ = Picture::PixelRefIterator(layer_rect_, picture);
+      if (pixel_ref_iterator_)
+        return;
+    }
+    picture_index_ = 0;
   }
 }
 
@@ -405,10 +466,13 @@ void PicturePileImpl::DidBeginTracing() {
   for (PictureMap::iterator it = picture_map_.begin();
        it != picture_map_.end();
        ++it) {
-    Picture* picture = it->second.GetPicture();
-    if (picture && (processed_pictures.count(picture) == 0)) {
-      picture->EmitTraceSnapshot();
-      processed_pictures.insert(picture);
+    const PictureInfo& info = it->second;
+    for (size_t i = 0; i < info.num_pictures(); ++i) {
+      Picture* picture = info.GetPictureAt(i);
+      if (processed_pictures.count(picture) == 0) {
+        picture->EmitTraceSnapshot();
+        processed_pictures.insert(picture);
+      }
     }
   }
 }
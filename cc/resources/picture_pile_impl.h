@@ -80,6 +80,13 @@ class CC_EXPORT PicturePileImpl : public PicturePileBase {
                      Analysis* analysis,
                      RenderingStatsInstrumentation* stats_instrumentation);
 
+  // Returns true if the cells under |content_rect| were all found to be the
+  // same color when they were recorded, so that neither analyzing nor
+  // rasterizing the rect is needed to know its |color|.
+  bool GetSolidColorFromRecording(const gfx::Rect& content_rect,
+                                  float contents_scale,
+                                  SkColor* color) const;
+
   class CC_EXPORT PixelRefIterator {
    public:
     PixelRefIterator(const gfx::Rect& content_rect,
@@ -98,6 +105,8 @@ class CC_EXPORT PicturePileImpl : public PicturePileBase {
     const PicturePileImpl* picture_pile_;
     gfx::Rect layer_rect_;
     TilingData::Iterator tile_iterator_;
+    // The index of the current picture of the current tile.
+    size_t picture_index_;
     Picture::PixelRefIterator pixel_ref_iterator_;
     std::set<const void*> processed_pictures_;
   };
@@ -6,6 +6,7 @@
 #include <utility>
 
 #include "cc/resources/picture_pile.h"
+#include "cc/resources/picture_pile_impl.h"
 #include "cc/test/fake_content_layer_client.h"
 #include "cc/test/fake_rendering_stats_instrumentation.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -299,5 +300,178 @@ TEST(PicturePileTest, StopRecordingOffscreenInvalidations) {
   }
 }
 
+TEST(PicturePileTest, SmallInvalidateIsPatched) {
+  FakeContentLayerClient client;
+  FakeRenderingStatsInstrumentation stats_instrumentation;
+  scoped_refptr<TestPicturePile> pile = new TestPicturePile;
+  SkColor background_color = SK_ColorBLUE;
+
+  float min_scale = 0.125;
+  gfx::Size layer_size = pile->tiling().max_texture_size();
+  pile->Resize(layer_size);
+  pile->SetTileGridSize(gfx::Size(1000, 1000));
+  pile->SetMinContentsScale(min_scale);
+
+  pile->Update(&client,
+               background_color,
+               false,
+               gfx::Rect(layer_size),
+               gfx::Rect(layer_size),
+               1,
+               &stats_instrumentation);
+
+  TestPicturePile::PictureInfo& picture_info =
+      pile->picture_map().find(TestPicturePile::PictureMapKey(0, 0))->second;
+  Picture* base_picture = picture_info.GetPicture();
+  ASSERT_TRUE(base_picture);
+  EXPECT_EQ(1u, picture_info.num_pictures());
+
+  // An invalidation of a small part of the cell only records that part, over
+  // the picture of the whole cell.
+  gfx::Rect invalidate_rect(50, 50, 10, 10);
+  pile->Update(&client,
+               background_color,
+               false,
+               invalidate_rect,
+               gfx::Rect(layer_size),
+               2,
+               &stats_instrumentation);
+
+  EXPECT_EQ(base_picture, picture_info.GetPicture());
+  ASSERT_EQ(2u, picture_info.num_pictures());
+  gfx::Rect patch_rect = picture_info.GetPictureAt(1)->LayerRect();
+  EXPECT_TRUE(patch_rect.Contains(invalidate_rect)) << patch_rect.ToString();
+  EXPECT_FALSE(gfx::ScaleToEnclosedRect(patch_rect, min_scale).IsEmpty());
+  EXPECT_FLOAT_EQ(
+      2.0f / TestPicturePile::PictureInfo::INVALIDATION_FRAMES_TRACKED,
+      picture_info.GetInvalidationFrequencyForTesting());
+
+  // An invalidation of a large part of the cell records the whole cell again.
+  pile->Update(&client,
+               background_color,
+               false,
+               gfx::Rect(layer_size.width() / 2, layer_size.height()),
+               gfx::Rect(layer_size),
+               3,
+               &stats_instrumentation);
+
+  EXPECT_NE(base_picture, picture_info.GetPicture());
+  EXPECT_EQ(1u, picture_info.num_pictures());
+}
+
+TEST(PicturePileTest, TooManyPatchesRecordCellAgain) {
+  FakeContentLayerClient client;
+  FakeRenderingStatsInstrumentation stats_instrumentation;
+  scoped_refptr<TestPicturePile> pile = new TestPicturePile;
+  SkColor background_color = SK_ColorBLUE;
+
+  gfx::Size layer_size = pile->tiling().max_texture_size();
+  pile->Resize(layer_size);
+  pile->SetTileGridSize(gfx::Size(1000, 1000));
+  pile->SetMinContentsScale(0.125);
+
+  pile->Update(&client,
+               background_color,
+               false,
+               gfx::Rect(layer_size),
+               gfx::Rect(layer_size),
+               0,
+               &stats_instrumentation);
+
+  TestPicturePile::PictureInfo& picture_info =
+      pile->picture_map().find(TestPicturePile::PictureMapKey(0, 0))->second;
+  Picture* base_picture = picture_info.GetPicture();
+
+  int frame;
+  for (frame = 1; frame <= TestPicturePile::PictureInfo::MAX_PATCHES;
+       ++frame) {
+    pile->Update(&client,
+                 background_color,
+                 false,
+                 gfx::Rect(10 * frame, 10 * frame, 5, 5),
+                 gfx::Rect(layer_size),
+                 frame,
+                 &stats_instrumentation);
+    EXPECT_EQ(base_picture, picture_info.GetPicture());
+    EXPECT_EQ(static_cast<size_t>(frame) + 1, picture_info.num_pictures());
+  }
+
+  pile->Update(&client,
+               background_color,
+               false,
+               gfx::Rect(10 * frame, 10 * frame, 5, 5),
+               gfx::Rect(layer_size),
+               frame,
+               &stats_instrumentation);
+  EXPECT_NE(base_picture, picture_info.GetPicture());
+  EXPECT_EQ(1u, picture_info.num_pictures());
+}
+
+TEST(PicturePileTest, SolidColorIsFoundWhenRecording) {
+  FakeContentLayerClient client;
+  FakeRenderingStatsInstrumentation stats_instrumentation;
+  scoped_refptr<TestPicturePile> pile = new TestPicturePile;
+  SkColor background_color = SK_ColorBLUE;
+
+  gfx::Size base_picture_size = pile->tiling().max_texture_size();
+  gfx::Size layer_size =
+      gfx::ToFlooredSize(gfx::ScaleSize(base_picture_size, 2.f));
+  pile->Resize(layer_size);
+  pile->SetTileGridSize(gfx::Size(1000, 1000));
+  pile->SetMinContentsScale(0.125);
+
+  // Fill the layer with red, except for a corner of the last cell.
+  SkPaint red_paint;
+  red_paint.setColor(SK_ColorRED);
+  client.add_draw_rect(gfx::RectF(layer_size), red_paint);
+  SkPaint green_paint;
+  green_paint.setColor(SK_ColorGREEN);
+  client.add_draw_rect(
+      gfx::RectF(layer_size.width() - 10, layer_size.height() - 10, 10, 10),
+      green_paint);
+
+  pile->Update(&client,
+               background_color,
+               false,
+               gfx::Rect(layer_size),
+               gfx::Rect(layer_size),
+               1,
+               &stats_instrumentation);
+
+  int last_x = pile->tiling().num_tiles_x() - 1;
+  int last_y = pile->tiling().num_tiles_y() - 1;
+  SkColor color;
+  EXPECT_TRUE(pile->picture_map()[TestPicturePile::PictureMapKey(0, 0)]
+                  .GetSolidColor(&color));
+  EXPECT_EQ(SK_ColorRED, color);
+  EXPECT_FALSE(
+      pile->picture_map()[TestPicturePile::PictureMapKey(last_x, last_y)]
+          .GetSolidColor(&color));
+
+  scoped_refptr<PicturePileImpl> pile_impl =
+      PicturePileImpl::CreateFromOther(pile.get());
+  EXPECT_TRUE(pile_impl->GetSolidColorFromRecording(
+      gfx::Rect(0, 0, 20, 20), 1.f, &color));
+  EXPECT_EQ(SK_ColorRED, color);
+  EXPECT_FALSE(pile_impl->GetSolidColorFromRecording(
+      gfx::Rect(layer_size), 1.f, &color));
+
+  PicturePileImpl::Analysis analysis;
+  pile_impl->AnalyzeInRect(gfx::Rect(0, 0, 20, 20), 1.f, &analysis);
+  EXPECT_TRUE(analysis.is_solid_color);
+  EXPECT_EQ(SK_ColorRED, analysis.solid_color);
+
+  // Patching a cell drops what was found about it.
+  pile->Update(&client,
+               background_color,
+               false,
+               gfx::Rect(5, 5, 5, 5),
+               gfx::Rect(layer_size),
+               2,
+               &stats_instrumentation);
+  EXPECT_FALSE(pile->picture_map()[TestPicturePile::PictureMapKey(0, 0)]
+                   .GetSolidColor(&color));
+}
+
 }  // namespace
 }  // namespace cc
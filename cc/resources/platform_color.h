@@ -38,13 +38,14 @@ class PlatformColor {
   }
 
   // Return true if the given texture format has the same component order
-  // as the color on this platform.
+  // as the color on this platform. ETC1 textures are compressed from the
+  // components of the colors, whatever their order.
   static bool SameComponentOrder(ResourceFormat format) {
     switch (Format()) {
       case SOURCE_FORMAT_RGBA8:
-        return format == RGBA_8888 || format == RGBA_4444;
+        return format == RGBA_8888 || format == RGBA_4444 || format == ETC1;
       case SOURCE_FORMAT_BGRA8:
-        return format == BGRA_8888;
+        return format == BGRA_8888 || format == ETC1;
     }
     NOTREACHED();
     return false;
@@ -42,6 +42,54 @@ namespace {
 
 typedef std::vector<Tile*> TileVector;
 
+// Smaller bins are cheap enough to sort from scratch.
+const size_t kMinTilesToMergeSortedRuns = 64;
+
+// Merging more runs than this is no faster than sorting.
+const size_t kMaxSortedRunsToMerge = 16;
+
+// TileManager inserts tiles in the order of the previous prioritization, so
+// the tiles that stayed in a bin are still sorted, and the tiles that moved
+// in from each other bin are too. This merges those sorted runs, which costs
+// a single pass when the order didn't change, and only sorts the bin when
+// there are too many runs.
+void SortTiles(TileVector* tiles) {
+  BinComparator comparator;
+
+  if (tiles->size() >= kMinTilesToMergeSortedRuns) {
+    std::vector<size_t> run_bounds(1, 0u);
+    for (size_t i = 1;
+         i < tiles->size() && run_bounds.size() <= kMaxSortedRunsToMerge;
+         ++i) {
+      if (comparator((*tiles)[i], (*tiles)[i - 1]))
+        run_bounds.push_back(i);
+    }
+
+    if (run_bounds.size() <= kMaxSortedRunsToMerge) {
+      run_bounds.push_back(tiles->size());
+
+      // Merge pairs of neighboring runs until one is left.
+      while (run_bounds.size() > 2u) {
+        std::vector<size_t> merged_run_bounds(1, 0u);
+        for (size_t i = 2; i < run_bounds.size(); i += 2) {
+          std::inplace_merge(tiles->begin() + run_bounds[i - 2],
+                             tiles->begin() + run_bounds[i - 1],
+                             tiles->begin() + run_bounds[i],
+                             comparator);
+          merged_run_bounds.push_back(run_bounds[i]);
+        }
+        // The last run has nothing to merge with when there's an odd number.
+        if (run_bounds.size() % 2 == 0)
+          merged_run_bounds.push_back(run_bounds.back());
+        run_bounds.swap(merged_run_bounds);
+      }
+      return;
+    }
+  }
+
+  std::sort(tiles->begin(), tiles->end(), comparator);
+}
+
 void SortBinTiles(ManagedTileBin bin, TileVector* tiles) {
   switch (bin) {
     case NOW_AND_READY_TO_DRAW_BIN:
@@ -53,7 +101,7 @@ void SortBinTiles(ManagedTileBin bin, TileVector* tiles) {
     case EVENTUALLY_BIN:
     case AT_LAST_AND_ACTIVE_BIN:
     case AT_LAST_BIN:
-      std::sort(tiles->begin(), tiles->end(), BinComparator());
+      SortTiles(tiles);
       break;
     default:
       NOTREACHED();
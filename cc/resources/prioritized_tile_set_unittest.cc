@@ -65,9 +65,14 @@ class PrioritizedTileSetTest : public testing::Test {
   }
 
   scoped_refptr<Tile> CreateTile() {
+    return CreateTileWithContentRect(gfx::Rect());
+  }
+
+  scoped_refptr<Tile> CreateTileWithContentRect(
+      const gfx::Rect& content_rect) {
     return tile_manager_->CreateTile(picture_pile_.get(),
                                      settings_.default_tile_size,
-                                     gfx::Rect(),
+                                     content_rect,
                                      gfx::Rect(),
                                      1.0,
                                      0,
@@ -634,6 +639,34 @@ TEST_F(PrioritizedTileSetTest, ManyTilesForEachBinDisablePriority) {
   EXPECT_FALSE(it);
 }
 
+TEST_F(PrioritizedTileSetTest, LargeBinWithSortedRuns) {
+  // Ensure that a large bin made of sorted runs, like the bins TileManager
+  // builds from the previous order, is sorted according to BinComparator.
+
+  PrioritizedTileSet set;
+  std::vector<scoped_refptr<Tile> > tiles;
+  for (int run = 0; run < 5; ++run) {
+    for (int i = 0; i < 40; ++i) {
+      scoped_refptr<Tile> tile =
+          CreateTileWithContentRect(gfx::Rect(run, i * 5 + run, 1, 1));
+      tiles.push_back(tile);
+      set.InsertTile(tile, SOON_BIN);
+    }
+  }
+
+  // Tiles should appear in BinComparator order.
+  std::sort(tiles.begin(), tiles.end(), BinComparator());
+
+  int i = 0;
+  for (PrioritizedTileSet::Iterator it(&set, true);
+       it;
+       ++it) {
+    EXPECT_TRUE(*it == tiles[i].get());
+    ++i;
+  }
+  EXPECT_EQ(200, i);
+}
+
 TEST_F(PrioritizedTileSetTest, TilesForFirstAndLastBins) {
   // Make sure that if we have empty lists between two non-empty lists,
   // we just get two tiles from the iterator.
@@ -397,8 +397,12 @@ class RasterRequiredForActivationFinishedWorkerPoolTaskImpl
 class RasterTaskGraphRunner : public internal::TaskGraphRunner {
  public:
   RasterTaskGraphRunner()
-      : internal::TaskGraphRunner(RasterWorkerPool::GetNumRasterThreads(),
-                                  "CompositorRaster") {}
+      : internal::TaskGraphRunner(
+            RasterWorkerPool::GetNumRasterThreads(),
+            "CompositorRaster",
+            RasterWorkerPool::GetUseWorkStealing()
+                ? internal::TaskGraphRunner::QUEUEING_MODE_WORK_STEALING
+                : internal::TaskGraphRunner::QUEUEING_MODE_SHARED) {}
 };
 base::LazyInstance<RasterTaskGraphRunner>::Leaky g_task_graph_runner =
     LAZY_INSTANCE_INITIALIZER;
@@ -407,6 +411,8 @@ const int kDefaultNumRasterThreads = 1;
 
 int g_num_raster_threads = 0;
 
+bool g_use_work_stealing = false;
+
 }  // namespace
 
 namespace internal {
@@ -508,6 +514,14 @@ int RasterWorkerPool::GetNumRasterThreads() {
   return g_num_raster_threads;
 }
 
+// static
+void RasterWorkerPool::SetUseWorkStealing(bool use_work_stealing) {
+  g_use_work_stealing = use_work_stealing;
+}
+
+// static
+bool RasterWorkerPool::GetUseWorkStealing() { return g_use_work_stealing; }
+
 // static
 internal::TaskGraphRunner* RasterWorkerPool::GetTaskGraphRunner() {
   return g_task_graph_runner.Pointer();
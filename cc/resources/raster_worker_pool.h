@@ -137,6 +137,11 @@ class CC_EXPORT RasterWorkerPool : public internal::WorkerPoolTaskClient {
   static void SetNumRasterThreads(int num_threads);
   static int GetNumRasterThreads();
 
+  // Makes the raster threads use a work stealing task graph runner. Must be
+  // called before the first call to GetTaskGraphRunner().
+  static void SetUseWorkStealing(bool use_work_stealing);
+  static bool GetUseWorkStealing();
+
   static internal::TaskGraphRunner* GetTaskGraphRunner();
 
   static unsigned kOnDemandRasterTaskPriority;
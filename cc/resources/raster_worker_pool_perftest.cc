@@ -4,6 +4,7 @@
 
 #include "cc/resources/raster_worker_pool.h"
 
+#include "base/strings/stringprintf.h"
 #include "base/time/time.h"
 #include "cc/resources/direct_raster_worker_pool.h"
 #include "cc/resources/image_raster_worker_pool.h"
@@ -31,6 +32,8 @@ static const int kTimeLimitMillis = 2000;
 static const int kWarmupRuns = 5;
 static const int kTimeCheckInterval = 10;
 
+static const size_t kNumThreads[] = {1, 2, 4, 8, 16};
+
 class PerfWorkerPoolTaskImpl : public internal::WorkerPoolTask {
  public:
   PerfWorkerPoolTaskImpl() {}
@@ -96,7 +99,8 @@ class PerfRasterWorkerPoolTaskImpl : public internal::RasterWorkerPoolTask {
 
 class PerfTaskGraphRunnerImpl : public internal::TaskGraphRunner {
  public:
-  PerfTaskGraphRunnerImpl() : internal::TaskGraphRunner(0, "Perf") {}
+  PerfTaskGraphRunnerImpl(size_t num_threads, QueueingMode queueing_mode)
+      : internal::TaskGraphRunner(num_threads, "Perf", queueing_mode) {}
 };
 
 class PerfPixelBufferRasterWorkerPoolImpl : public PixelBufferRasterWorkerPool {
@@ -134,7 +138,9 @@ class RasterWorkerPoolPerfTest
 
   RasterWorkerPoolPerfTest()
       : context_provider_(TestContextProvider::Create()),
-        task_graph_runner_(new PerfTaskGraphRunnerImpl),
+        task_graph_runner_(new PerfTaskGraphRunnerImpl(
+            0, internal::TaskGraphRunner::QUEUEING_MODE_SHARED)),
+        num_threads_(0u),
         timer_(kWarmupRuns,
                base::TimeDelta::FromMilliseconds(kTimeLimitMillis),
                kTimeCheckInterval) {
@@ -144,6 +150,11 @@ class RasterWorkerPoolPerfTest
     resource_provider_ = ResourceProvider::Create(
                              output_surface_.get(), NULL, 0, false, 1).Pass();
 
+    CreateRasterWorkerPool();
+  }
+  virtual ~RasterWorkerPoolPerfTest() { resource_provider_.reset(); }
+
+  void CreateRasterWorkerPool() {
     switch (GetParam()) {
       case RASTER_WORKER_POOL_TYPE_PIXEL_BUFFER:
         raster_worker_pool_.reset(new PerfPixelBufferRasterWorkerPoolImpl(
@@ -162,7 +173,21 @@ class RasterWorkerPoolPerfTest
     DCHECK(raster_worker_pool_);
     raster_worker_pool_->SetClient(this);
   }
-  virtual ~RasterWorkerPoolPerfTest() { resource_provider_.reset(); }
+
+  // Replaces the raster worker pool with one that runs tasks on
+  // |num_threads| worker threads.
+  void ResetRasterWorkerPool(
+      size_t num_threads,
+      internal::TaskGraphRunner::QueueingMode queueing_mode) {
+    raster_worker_pool_->Shutdown();
+    raster_worker_pool_->CheckForCompletedTasks();
+    raster_worker_pool_.reset();
+
+    task_graph_runner_.reset(
+        new PerfTaskGraphRunnerImpl(num_threads, queueing_mode));
+    num_threads_ = num_threads;
+    CreateRasterWorkerPool();
+  }
 
   // Overridden from testing::Test:
   virtual void TearDown() OVERRIDE {
@@ -182,8 +207,10 @@ class RasterWorkerPoolPerfTest
   virtual void DidFinishRunningTasksRequiredForActivation() OVERRIDE {}
 
   void RunMessageLoopUntilAllTasksHaveCompleted() {
-    while (task_graph_runner_->RunTaskForTesting())
-      continue;
+    if (!num_threads_) {
+      while (task_graph_runner_->RunTaskForTesting())
+        continue;
+    }
     base::MessageLoop::current()->Run();
   }
 
@@ -321,7 +348,63 @@ class RasterWorkerPoolPerfTest
                            true);
   }
 
+  // Runs the tasks on worker pools with each number of threads in
+  // |kNumThreads|, to show how |queueing_mode| scales with the number of
+  // threads.
+  void RunScheduleAndExecuteTasksOnThreadsTest(
+      const std::string& test_name,
+      internal::TaskGraphRunner::QueueingMode queueing_mode,
+      unsigned num_raster_tasks,
+      unsigned num_image_decode_tasks) {
+    internal::WorkerPoolTask::Vector image_decode_tasks;
+    RasterTaskVector raster_tasks;
+    CreateImageDecodeTasks(num_image_decode_tasks, &image_decode_tasks);
+    CreateRasterTasks(num_raster_tasks, image_decode_tasks, &raster_tasks);
+
+    // Avoid unnecessary heap allocations by reusing the same queue.
+    RasterTaskQueue queue;
+
+    for (size_t i = 0; i < arraysize(kNumThreads); ++i) {
+      ResetRasterWorkerPool(kNumThreads[i], queueing_mode);
+
+      timer_.Reset();
+      do {
+        queue.Reset();
+        BuildTaskQueue(&queue, raster_tasks);
+        raster_worker_pool_->ScheduleTasks(&queue);
+        RunMessageLoopUntilAllTasksHaveCompleted();
+        timer_.NextLap();
+      } while (!timer_.HasTimeLimitExpired());
+
+      RasterTaskQueue empty;
+      raster_worker_pool_->ScheduleTasks(&empty);
+      RunMessageLoopUntilAllTasksHaveCompleted();
+
+      perf_test::PrintResult(
+          "schedule_and_execute_tasks_on_threads",
+          TestModifierString() + QueueingModeString(queueing_mode),
+          base::StringPrintf("%s_%u_threads",
+                             test_name.c_str(),
+                             static_cast<unsigned>(kNumThreads[i])),
+          timer_.LapsPerSecond(),
+          "runs/s",
+          true);
+    }
+  }
+
  private:
+  static std::string QueueingModeString(
+      internal::TaskGraphRunner::QueueingMode queueing_mode) {
+    switch (queueing_mode) {
+      case internal::TaskGraphRunner::QUEUEING_MODE_SHARED:
+        return std::string("_shared");
+      case internal::TaskGraphRunner::QUEUEING_MODE_WORK_STEALING:
+        return std::string("_work_stealing");
+    }
+    NOTREACHED();
+    return std::string();
+  }
+
   std::string TestModifierString() const {
     switch (GetParam()) {
       case RASTER_WORKER_POOL_TYPE_PIXEL_BUFFER:
@@ -340,6 +423,7 @@ class RasterWorkerPoolPerfTest
   scoped_ptr<FakeOutputSurface> output_surface_;
   scoped_ptr<ResourceProvider> resource_provider_;
   scoped_ptr<internal::TaskGraphRunner> task_graph_runner_;
+  size_t num_threads_;
   scoped_ptr<RasterWorkerPool> raster_worker_pool_;
   LapTimer timer_;
 };
@@ -371,6 +455,22 @@ TEST_P(RasterWorkerPoolPerfTest, ScheduleAndExecuteTasks) {
   RunScheduleAndExecuteTasksTest("32_4", 32, 4);
 }
 
+TEST_P(RasterWorkerPoolPerfTest, ScheduleAndExecuteTasksOnThreads) {
+  // Direct raster worker pools run tasks on the origin thread.
+  if (GetParam() == RASTER_WORKER_POOL_TYPE_DIRECT)
+    return;
+
+  const internal::TaskGraphRunner::QueueingMode kQueueingModes[] = {
+      internal::TaskGraphRunner::QUEUEING_MODE_SHARED,
+      internal::TaskGraphRunner::QUEUEING_MODE_WORK_STEALING};
+  for (size_t i = 0; i < arraysize(kQueueingModes); ++i) {
+    RunScheduleAndExecuteTasksOnThreadsTest("32_1", kQueueingModes[i], 32, 1);
+    RunScheduleAndExecuteTasksOnThreadsTest("32_4", kQueueingModes[i], 32, 4);
+    RunScheduleAndExecuteTasksOnThreadsTest(
+        "256_4", kQueueingModes[i], 256, 4);
+  }
+}
+
 INSTANTIATE_TEST_CASE_P(RasterWorkerPoolPerfTests,
                         RasterWorkerPoolPerfTest,
                         ::testing::Values(RASTER_WORKER_POOL_TYPE_PIXEL_BUFFER,
@@ -9,12 +9,21 @@
 
 namespace cc {
 
-ResourcePool::ResourcePool(ResourceProvider* resource_provider,
-                           GLenum target,
-                           ResourceFormat format)
+namespace {
+
+// Unused resources are only reused for smaller sizes while they have at most
+// twice the area that is needed.
+const int kMaxReusedResourceAreaRatio = 2;
+
+int64 Area(const gfx::Size& size) {
+  return static_cast<int64>(size.width()) * size.height();
+}
+
+}  // namespace
+
+ResourcePool::ResourcePool(ResourceProvider* resource_provider, GLenum target)
     : resource_provider_(resource_provider),
       target_(target),
-      format_(format),
       max_memory_usage_bytes_(0),
       max_unused_memory_usage_bytes_(0),
       max_resource_count_(0),
@@ -36,7 +45,8 @@ ResourcePool::~ResourcePool() {
 }
 
 scoped_ptr<ScopedResource> ResourcePool::AcquireResource(
-    const gfx::Size& size) {
+    const gfx::Size& size,
+    ResourceFormat format) {
   for (ResourceList::iterator it = unused_resources_.begin();
        it != unused_resources_.end();
        ++it) {
@@ -45,16 +55,52 @@ scoped_ptr<ScopedResource> ResourcePool::AcquireResource(
 
     if (resource->size() != size)
       continue;
+    if (resource->format() != format)
+      continue;
 
-    unused_resources_.erase(it);
-    unused_memory_usage_bytes_ -= resource->bytes();
-    return make_scoped_ptr(resource);
+    return TakeUnusedResource(it);
+  }
+
+  return CreateResource(size, format);
+}
+
+scoped_ptr<ScopedResource> ResourcePool::AcquireResourceOfAtLeastSize(
+    const gfx::Size& size,
+    ResourceFormat format) {
+  ResourceList::iterator best = unused_resources_.end();
+  for (ResourceList::iterator it = unused_resources_.begin();
+       it != unused_resources_.end();
+       ++it) {
+    ScopedResource* resource = *it;
+    DCHECK(resource_provider_->CanLockForWrite(resource->id()));
+
+    if (resource->format() != format)
+      continue;
+    if (resource->size() == size)
+      return TakeUnusedResource(it);
+    if (resource->size().width() < size.width() ||
+        resource->size().height() < size.height())
+      continue;
+    if (Area(resource->size()) > kMaxReusedResourceAreaRatio * Area(size))
+      continue;
+
+    if (best == unused_resources_.end() ||
+        Area(resource->size()) < Area((*best)->size()))
+      best = it;
   }
 
-  // Create new resource.
+  if (best != unused_resources_.end())
+    return TakeUnusedResource(best);
+
+  return CreateResource(size, format);
+}
+
+scoped_ptr<ScopedResource> ResourcePool::CreateResource(
+    const gfx::Size& size,
+    ResourceFormat format) {
   scoped_ptr<ScopedResource> resource =
       ScopedResource::Create(resource_provider_);
-  resource->AllocateManaged(size, target_, format_);
+  resource->AllocateManaged(size, target_, format);
 
   // Extend all read locks on all resources until the resource is
   // finished being used, such that we know when resources are
@@ -66,6 +112,14 @@ scoped_ptr<ScopedResource> ResourcePool::AcquireResource(
   return resource.Pass();
 }
 
+scoped_ptr<ScopedResource> ResourcePool::TakeUnusedResource(
+    ResourceList::iterator it) {
+  ScopedResource* resource = *it;
+  unused_resources_.erase(it);
+  unused_memory_usage_bytes_ -= resource->bytes();
+  return make_scoped_ptr(resource);
+}
+
 void ResourcePool::ReleaseResource(scoped_ptr<ScopedResource> resource) {
   busy_resources_.push_back(resource.release());
 }
@@ -19,14 +19,23 @@ class ScopedResource;
 class CC_EXPORT ResourcePool {
  public:
   static scoped_ptr<ResourcePool> Create(ResourceProvider* resource_provider,
-                                         GLenum target,
-                                         ResourceFormat format) {
-    return make_scoped_ptr(new ResourcePool(resource_provider, target, format));
+                                         GLenum target) {
+    return make_scoped_ptr(new ResourcePool(resource_provider, target));
   }
 
   virtual ~ResourcePool();
 
-  scoped_ptr<ScopedResource> AcquireResource(const gfx::Size& size);
+  // Returns an unused resource of |size| and |format|, or a new one.
+  // Resources of all formats count towards the same limits.
+  scoped_ptr<ScopedResource> AcquireResource(const gfx::Size& size,
+                                             ResourceFormat format);
+  // Like AcquireResource(), but may return an unused resource that is larger
+  // than |size|, for users that only use its top left |size| part. Resources
+  // of |size| are preferred, and larger ones are only reused while they don't
+  // waste too much memory.
+  scoped_ptr<ScopedResource> AcquireResourceOfAtLeastSize(
+      const gfx::Size& size,
+      ResourceFormat format);
   void ReleaseResource(scoped_ptr<ScopedResource>);
 
   void SetResourceUsageLimits(size_t max_memory_usage_bytes,
@@ -45,18 +54,20 @@ class CC_EXPORT ResourcePool {
   }
 
  protected:
-  ResourcePool(ResourceProvider* resource_provider,
-               GLenum target,
-               ResourceFormat format);
+  ResourcePool(ResourceProvider* resource_provider, GLenum target);
 
   bool ResourceUsageTooHigh();
 
  private:
+  typedef std::list<ScopedResource*> ResourceList;
+
+  scoped_ptr<ScopedResource> CreateResource(const gfx::Size& size,
+                                            ResourceFormat format);
+  scoped_ptr<ScopedResource> TakeUnusedResource(ResourceList::iterator it);
   void DidFinishUsingResource(ScopedResource* resource);
 
   ResourceProvider* resource_provider_;
   const GLenum target_;
-  const ResourceFormat format_;
   size_t max_memory_usage_bytes_;
   size_t max_unused_memory_usage_bytes_;
   size_t max_resource_count_;
@@ -64,7 +75,6 @@ class CC_EXPORT ResourcePool {
   size_t unused_memory_usage_bytes_;
   size_t resource_count_;
 
-  typedef std::list<ScopedResource*> ResourceList;
   ResourceList unused_resources_;
   ResourceList busy_resources_;
 
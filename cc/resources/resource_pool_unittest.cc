@@ -0,0 +1,102 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/resources/resource_pool.h"
+
+#include <limits>
+
+#include "cc/resources/resource_provider.h"
+#include "cc/resources/scoped_resource.h"
+#include "cc/test/fake_output_surface.h"
+#include "cc/test/fake_output_surface_client.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace cc {
+namespace {
+
+class ResourcePoolTest : public testing::Test {
+ public:
+  ResourcePoolTest() {
+    output_surface_ = FakeOutputSurface::Create3d().Pass();
+    CHECK(output_surface_->BindToClient(&output_surface_client_));
+    resource_provider_ =
+        ResourceProvider::Create(output_surface_.get(), NULL, 0, false, 1)
+            .Pass();
+    resource_pool_ =
+        ResourcePool::Create(resource_provider_.get(), GL_TEXTURE_2D);
+    resource_pool_->SetResourceUsageLimits(std::numeric_limits<size_t>::max(),
+                                           std::numeric_limits<size_t>::max(),
+                                           std::numeric_limits<size_t>::max());
+  }
+
+  // Releases a resource of |size| to the pool, so that it can be reused.
+  ResourceProvider::ResourceId AddUnusedResource(const gfx::Size& size) {
+    scoped_ptr<ScopedResource> resource =
+        resource_pool_->AcquireResource(size, RGBA_8888);
+    ResourceProvider::ResourceId id = resource->id();
+    resource_pool_->ReleaseResource(resource.Pass());
+    resource_pool_->CheckBusyResources();
+    return id;
+  }
+
+ protected:
+  FakeOutputSurfaceClient output_surface_client_;
+  scoped_ptr<FakeOutputSurface> output_surface_;
+  scoped_ptr<ResourceProvider> resource_provider_;
+  scoped_ptr<ResourcePool> resource_pool_;
+};
+
+TEST_F(ResourcePoolTest, AcquireResourceOnlyReusesSameSize) {
+  ResourceProvider::ResourceId large_id =
+      AddUnusedResource(gfx::Size(256, 256));
+
+  scoped_ptr<ScopedResource> resource =
+      resource_pool_->AcquireResource(gfx::Size(192, 192), RGBA_8888);
+  EXPECT_NE(large_id, resource->id());
+  EXPECT_EQ(gfx::Size(192, 192), resource->size());
+  resource_pool_->ReleaseResource(resource.Pass());
+}
+
+TEST_F(ResourcePoolTest, ReuseSmallestLargerResource) {
+  AddUnusedResource(gfx::Size(256, 256));
+  ResourceProvider::ResourceId smaller_id =
+      AddUnusedResource(gfx::Size(256, 192));
+
+  scoped_ptr<ScopedResource> resource =
+      resource_pool_->AcquireResourceOfAtLeastSize(gfx::Size(192, 192),
+                                                   RGBA_8888);
+  EXPECT_EQ(smaller_id, resource->id());
+  EXPECT_EQ(gfx::Size(256, 192), resource->size());
+  resource_pool_->ReleaseResource(resource.Pass());
+}
+
+TEST_F(ResourcePoolTest, PreferResourceOfSameSize) {
+  AddUnusedResource(gfx::Size(256, 256));
+  ResourceProvider::ResourceId same_size_id =
+      AddUnusedResource(gfx::Size(192, 192));
+
+  scoped_ptr<ScopedResource> resource =
+      resource_pool_->AcquireResourceOfAtLeastSize(gfx::Size(192, 192),
+                                                   RGBA_8888);
+  EXPECT_EQ(same_size_id, resource->id());
+  resource_pool_->ReleaseResource(resource.Pass());
+}
+
+TEST_F(ResourcePoolTest, DontReuseResourcesThatWasteTooMuchMemory) {
+  ResourceProvider::ResourceId large_id =
+      AddUnusedResource(gfx::Size(256, 256));
+  AddUnusedResource(gfx::Size(64, 256));
+
+  // The large resource is more than twice the area of the requested size,
+  // and the narrow one is too small.
+  scoped_ptr<ScopedResource> resource =
+      resource_pool_->AcquireResourceOfAtLeastSize(gfx::Size(128, 128),
+                                                   RGBA_8888);
+  EXPECT_NE(large_id, resource->id());
+  EXPECT_EQ(gfx::Size(128, 128), resource->size());
+  resource_pool_->ReleaseResource(resource.Pass());
+}
+
+}  // namespace
+}  // namespace cc
@@ -14,6 +14,7 @@
 #include "base/strings/string_util.h"
 #include "cc/base/util.h"
 #include "cc/output/gl_renderer.h"  // For the GLC() macro.
+#include "cc/resources/etc1_encoder.h"
 #include "cc/resources/platform_color.h"
 #include "cc/resources/returned_resource.h"
 #include "cc/resources/shared_bitmap_manager.h"
@@ -109,6 +110,13 @@ GrPixelConfig ToGrPixelConfig(ResourceFormat format) {
   return kSkia8888_GrPixelConfig;
 }
 
+size_t PixelBufferSizeInBytes(ResourceFormat format, const gfx::Size& size) {
+  if (format == ETC1)
+    return ETC1Encoder::EncodedSizeInBytes(size);
+  unsigned bytes_per_pixel = BitsPerPixel(format) / 8;
+  return size.height() * RoundUp(bytes_per_pixel * size.width(), 4u);
+}
+
 class IdentityAllocator : public SkBitmap::Allocator {
  public:
   explicit IdentityAllocator(void* buffer) : buffer_(buffer) {}
@@ -468,8 +476,9 @@ SkCanvas* ResourceProvider::BitmapRasterBuffer::DoLockForWrite() {
 
   switch (resource()->format) {
     case RGBA_4444:
+    case ETC1:
       // Use the default stride if we will eventually convert this
-      // bitmap to 4444.
+      // bitmap to 4444 or compress it to ETC1.
       raster_bitmap_.setConfig(SkBitmap::kARGB_8888_Config,
                                resource()->size.width(),
                                resource()->size.height());
@@ -485,7 +494,6 @@ SkCanvas* ResourceProvider::BitmapRasterBuffer::DoLockForWrite() {
       break;
     case LUMINANCE_8:
     case RGB_565:
-    case ETC1:
       NOTREACHED();
       break;
   }
@@ -498,9 +506,13 @@ SkCanvas* ResourceProvider::BitmapRasterBuffer::DoLockForWrite() {
 void ResourceProvider::BitmapRasterBuffer::DoUnlockForWrite() {
   raster_canvas_.clear();
 
-  SkBitmap::Config buffer_config = SkBitmapConfig(resource()->format);
-  if (mapped_buffer_ && (buffer_config != raster_bitmap_.config()))
-    CopyBitmap(raster_bitmap_, mapped_buffer_, buffer_config);
+  if (mapped_buffer_ && resource()->format == ETC1) {
+    ETC1Encoder::Encode(raster_bitmap_, mapped_buffer_);
+  } else {
+    SkBitmap::Config buffer_config = SkBitmapConfig(resource()->format);
+    if (mapped_buffer_ && (buffer_config != raster_bitmap_.config()))
+      CopyBitmap(raster_bitmap_, mapped_buffer_, buffer_config);
+  }
   raster_bitmap_.reset();
 
   UnmapBuffer();
@@ -1750,7 +1762,6 @@ void ResourceProvider::AcquirePixelBuffer(Resource* resource) {
   DCHECK(resource->origin == Resource::Internal);
   DCHECK_EQ(resource->exported_count, 0);
   DCHECK(!resource->image_id);
-  DCHECK_NE(ETC1, resource->format);
 
   if (resource->type == GLTexture) {
     GLES2Interface* gl = ContextGL();
@@ -1759,10 +1770,8 @@ void ResourceProvider::AcquirePixelBuffer(Resource* resource) {
       resource->gl_pixel_buffer_id = buffer_id_allocator_->NextId();
     gl->BindBuffer(GL_PIXEL_UNPACK_TRANSFER_BUFFER_CHROMIUM,
                    resource->gl_pixel_buffer_id);
-    unsigned bytes_per_pixel = BitsPerPixel(resource->format) / 8;
     gl->BufferData(GL_PIXEL_UNPACK_TRANSFER_BUFFER_CHROMIUM,
-                   resource->size.height() *
-                       RoundUp(bytes_per_pixel * resource->size.width(), 4u),
+                   PixelBufferSizeInBytes(resource->format, resource->size),
                    NULL,
                    GL_DYNAMIC_DRAW);
     gl->BindBuffer(GL_PIXEL_UNPACK_TRANSFER_BUFFER_CHROMIUM, 0);
@@ -1905,7 +1914,20 @@ void ResourceProvider::BeginSetPixels(ResourceId id) {
       gl->GenQueriesEXT(1, &resource->gl_upload_query_id);
     gl->BeginQueryEXT(GL_ASYNC_PIXEL_UNPACK_COMPLETED_CHROMIUM,
                       resource->gl_upload_query_id);
-    if (allocate) {
+    if (resource->format == ETC1) {
+      // There are no async uploads of compressed textures, and ETC1 doesn't
+      // support sub-image updates, so the whole texture is specified from
+      // the pixel buffer. The query then completes with the upload.
+      gl->CompressedTexImage2D(
+          GL_TEXTURE_2D,
+          0, /* level */
+          GLInternalFormat(resource->format),
+          resource->size.width(),
+          resource->size.height(),
+          0, /* border */
+          PixelBufferSizeInBytes(resource->format, resource->size),
+          NULL);
+    } else if (allocate) {
       gl->AsyncTexImage2DCHROMIUM(GL_TEXTURE_2D,
                                   0, /* level */
                                   GLInternalFormat(resource->format),
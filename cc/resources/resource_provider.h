@@ -88,6 +88,9 @@ class CC_EXPORT ResourceProvider {
     return use_rgba_4444_texture_format_ ? RGBA_4444 : best_texture_format_;
   }
   ResourceFormat best_texture_format() const { return best_texture_format_; }
+  bool use_compressed_texture_etc1() const {
+    return use_compressed_texture_etc1_;
+  }
   size_t num_resources() const { return resources_.size(); }
 
   // Checks whether a resource is in use by a consumer.
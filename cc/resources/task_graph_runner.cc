@@ -127,8 +127,13 @@ TaskGraphRunner::TaskNamespace::TaskNamespace() : num_running_tasks(0u) {}
 
 TaskGraphRunner::TaskNamespace::~TaskNamespace() {}
 
+TaskGraphRunner::WorkerQueue::WorkerQueue() : top_priority(-1) {}
+
+TaskGraphRunner::WorkerQueue::~WorkerQueue() {}
+
 TaskGraphRunner::TaskGraphRunner(size_t num_threads,
-                                 const std::string& thread_name_prefix)
+                                 const std::string& thread_name_prefix,
+                                 QueueingMode queueing_mode)
     : lock_(),
       has_ready_to_run_tasks_cv_(&lock_),
       has_namespaces_with_finished_running_tasks_cv_(&lock_),
@@ -136,9 +141,16 @@ TaskGraphRunner::TaskGraphRunner(size_t num_threads,
       next_thread_index_(0u),
       // |num_threads| can be 0 for test.
       running_tasks_(std::max(num_threads, static_cast<size_t>(1)), NULL),
-      shutdown_(false) {
+      shutdown_(false),
+      queueing_mode_(queueing_mode),
+      next_worker_queue_index_(0u) {
   base::AutoLock lock(lock_);
 
+  if (queueing_mode_ == QUEUEING_MODE_WORK_STEALING) {
+    while (worker_queues_.size() < running_tasks_.size())
+      worker_queues_.push_back(make_scoped_ptr(new WorkerQueue));
+  }
+
   while (workers_.size() < num_threads) {
     scoped_ptr<base::DelegateSimpleThread> worker =
         make_scoped_ptr(new base::DelegateSimpleThread(
@@ -228,6 +240,12 @@ void TaskGraphRunner::SetTaskGraph(NamespaceToken token, TaskGraph* graph) {
 
     DCHECK(!shutdown_);
 
+    // Worker threads take tasks from their queues without holding |lock_|.
+    if (queueing_mode_ == QUEUEING_MODE_WORK_STEALING) {
+      for (size_t i = 0; i < worker_queues_.size(); ++i)
+        worker_queues_[i]->lock.Acquire();
+    }
+
     TaskNamespace& task_namespace = namespaces_[token.id_];
 
     // First adjust number of dependencies to reflect completed tasks.
@@ -307,6 +325,13 @@ void TaskGraphRunner::SetTaskGraph(NamespaceToken token, TaskGraph* graph) {
       task_namespace.completed_tasks.push_back(node.task);
     }
 
+    if (queueing_mode_ == QUEUEING_MODE_WORK_STEALING) {
+      QueueReadyToRunTasksWithLocksAcquired(&task_namespace);
+      for (size_t i = 0; i < worker_queues_.size(); ++i)
+        worker_queues_[i]->lock.Release();
+      return;
+    }
+
     // Build new "ready to run" task namespaces queue.
     ready_to_run_namespaces_.clear();
     for (TaskNamespaceMap::iterator it = namespaces_.begin();
@@ -357,6 +382,9 @@ void TaskGraphRunner::CollectCompletedTasks(NamespaceToken token,
 }
 
 bool TaskGraphRunner::RunTaskForTesting() {
+  if (queueing_mode_ == QUEUEING_MODE_WORK_STEALING)
+    return RunQueuedTask(0);
+
   base::AutoLock lock(lock_);
 
   if (ready_to_run_namespaces_.empty())
@@ -372,6 +400,12 @@ void TaskGraphRunner::Run() {
   // Get a unique thread index.
   int thread_index = next_thread_index_++;
 
+  if (queueing_mode_ == QUEUEING_MODE_WORK_STEALING) {
+    base::AutoUnlock unlock(lock_);
+    RunWithWorkStealing(thread_index);
+    return;
+  }
+
   while (true) {
     if (ready_to_run_namespaces_.empty()) {
       // Exit when shutdown is set and no more tasks are pending.
@@ -495,5 +529,225 @@ void TaskGraphRunner::RunTaskWithLockAcquired(int thread_index) {
     has_namespaces_with_finished_running_tasks_cv_.Signal();
 }
 
+void TaskGraphRunner::RunWithWorkStealing(int thread_index) {
+  while (true) {
+    if (RunQueuedTask(thread_index))
+      continue;
+
+    base::AutoLock lock(lock_);
+
+    // Tasks are only queued while holding |lock_|, so checking for them
+    // again before waiting can't miss a signal.
+    if (HasQueuedTasksWithLockAcquired())
+      continue;
+
+    if (shutdown_) {
+      // Wake up the next worker so it knows it should exit as well.
+      has_ready_to_run_tasks_cv_.Signal();
+      return;
+    }
+
+    // Wait for more tasks.
+    has_ready_to_run_tasks_cv_.Wait();
+  }
+}
+
+bool TaskGraphRunner::RunQueuedTask(int thread_index) {
+  DCHECK_LT(static_cast<size_t>(thread_index), worker_queues_.size());
+
+  QueuedTask queued_task(NULL, 0u, NULL);
+  if (!TakeQueuedTask(worker_queues_[thread_index], thread_index,
+                      &queued_task)) {
+    // Steal the top priority task of the other queues. The chosen queue may
+    // have changed before it is locked, so try again until all are empty.
+    while (true) {
+      WorkerQueue* victim = NULL;
+      int victim_priority = -1;
+      for (size_t i = 1; i < worker_queues_.size(); ++i) {
+        WorkerQueue* queue =
+            worker_queues_[(thread_index + i) % worker_queues_.size()];
+        int priority = base::subtle::NoBarrier_Load(&queue->top_priority);
+        if (priority < 0)
+          continue;
+        if (!victim || priority < victim_priority) {
+          victim = queue;
+          victim_priority = priority;
+        }
+      }
+      if (!victim)
+        return false;
+      if (TakeQueuedTask(victim, thread_index, &queued_task))
+        break;
+    }
+  }
+
+  TRACE_EVENT1("cc", "TaskGraphRunner::RunTask", "thread_index", thread_index);
+
+  scoped_refptr<Task> task(queued_task.task);
+  TaskNamespace* task_namespace = queued_task.task_namespace;
+
+  task->RunOnWorkerThread(thread_index);
+
+  base::AutoLock lock(lock_);
+
+  // This will mark task as finished running.
+  task->DidRun();
+
+  // Decrement running task count for task namespace.
+  DCHECK_LT(0u, task_namespace->num_running_tasks);
+  task_namespace->num_running_tasks--;
+
+  // Queue the dependents that are ready to run on this worker, where the
+  // data produced by |task| is most likely to still be in cache.
+  size_t num_ready_dependents = 0u;
+  {
+    WorkerQueue* queue = worker_queues_[thread_index];
+    base::AutoLock queue_lock(queue->lock);
+
+    // Remove task from |running_tasks_|.
+    running_tasks_[thread_index] = NULL;
+
+    for (DependentIterator it(&task_namespace->graph, task.get()); it; ++it) {
+      TaskGraph::Node& dependent_node = *it;
+
+      DCHECK_LT(0u, dependent_node.dependencies);
+      dependent_node.dependencies--;
+      if (dependent_node.dependencies)
+        continue;
+
+      queue->ready_to_run_tasks.push_back(QueuedTask(
+          dependent_node.task, dependent_node.priority, task_namespace));
+      std::push_heap(queue->ready_to_run_tasks.begin(),
+                     queue->ready_to_run_tasks.end(),
+                     CompareQueuedTaskPriority);
+      task_namespace->num_running_tasks++;
+      num_ready_dependents++;
+    }
+    UpdateTopPriority(queue);
+  }
+
+  // This worker runs one of the dependents next, other workers can steal the
+  // rest.
+  if (num_ready_dependents > 1u)
+    has_ready_to_run_tasks_cv_.Signal();
+
+  // Finally add task to |completed_tasks_|. The reference of this thread
+  // is released while holding |lock_|, so that the last one is released on
+  // the origin thread.
+  task_namespace->completed_tasks.push_back(task);
+  task = NULL;
+
+  // If namespace has finished running all tasks, wake up origin thread.
+  if (HasFinishedRunningTasksInNamespace(task_namespace))
+    has_namespaces_with_finished_running_tasks_cv_.Signal();
+
+  return true;
+}
+
+bool TaskGraphRunner::TakeQueuedTask(WorkerQueue* queue,
+                                     int thread_index,
+                                     QueuedTask* task) {
+  if (base::subtle::NoBarrier_Load(&queue->top_priority) < 0)
+    return false;
+
+  base::AutoLock queue_lock(queue->lock);
+
+  if (queue->ready_to_run_tasks.empty())
+    return false;
+
+  std::pop_heap(queue->ready_to_run_tasks.begin(),
+                queue->ready_to_run_tasks.end(),
+                CompareQueuedTaskPriority);
+  *task = queue->ready_to_run_tasks.back();
+  queue->ready_to_run_tasks.pop_back();
+  UpdateTopPriority(queue);
+
+  // Add task to |running_tasks_|. SetTaskGraph() holds all worker queue locks
+  // when checking it, so the task can't be scheduled again as it starts.
+  DCHECK(!running_tasks_[thread_index]);
+  running_tasks_[thread_index] = task->task;
+
+  // Call WillRun() before releasing the queue lock and running task.
+  task->task->WillRun();
+  return true;
+}
+
+void TaskGraphRunner::QueueReadyToRunTasksWithLocksAcquired(
+    TaskNamespace* task_namespace) {
+  lock_.AssertAcquired();
+
+  // Remove the tasks of |task_namespace| that were queued for the previous
+  // graph. The tasks still ready to run are in |ready_to_run_tasks|.
+  for (size_t i = 0; i < worker_queues_.size(); ++i) {
+    QueuedTask::Vector& tasks = worker_queues_[i]->ready_to_run_tasks;
+    size_t old_size = tasks.size();
+    QueuedTask::Vector::iterator end = tasks.begin();
+    for (QueuedTask::Vector::iterator it = tasks.begin(); it != tasks.end();
+         ++it) {
+      if (it->task_namespace != task_namespace)
+        *end++ = *it;
+    }
+    tasks.erase(end, tasks.end());
+    if (tasks.size() == old_size)
+      continue;
+
+    DCHECK_LE(old_size - tasks.size(), task_namespace->num_running_tasks);
+    task_namespace->num_running_tasks -= old_size - tasks.size();
+    std::make_heap(tasks.begin(), tasks.end(), CompareQueuedTaskPriority);
+    UpdateTopPriority(worker_queues_[i]);
+  }
+
+  // Deal the ready to run tasks out in priority order, so that the top
+  // priority tasks are at the front of different queues.
+  PrioritizedTask::Vector& ready_to_run_tasks =
+      task_namespace->ready_to_run_tasks;
+  std::sort_heap(
+      ready_to_run_tasks.begin(), ready_to_run_tasks.end(), CompareTaskPriority);
+  for (PrioritizedTask::Vector::reverse_iterator it =
+           ready_to_run_tasks.rbegin();
+       it != ready_to_run_tasks.rend();
+       ++it) {
+    WorkerQueue* queue = worker_queues_[next_worker_queue_index_];
+    queue->ready_to_run_tasks.push_back(
+        QueuedTask(it->task, it->priority, task_namespace));
+    std::push_heap(queue->ready_to_run_tasks.begin(),
+                   queue->ready_to_run_tasks.end(),
+                   CompareQueuedTaskPriority);
+    UpdateTopPriority(queue);
+    next_worker_queue_index_ =
+        (next_worker_queue_index_ + 1) % worker_queues_.size();
+  }
+  task_namespace->num_running_tasks += ready_to_run_tasks.size();
+
+  if (ready_to_run_tasks.size() > 1u)
+    has_ready_to_run_tasks_cv_.Broadcast();
+  else if (!ready_to_run_tasks.empty())
+    has_ready_to_run_tasks_cv_.Signal();
+  ready_to_run_tasks.clear();
+}
+
+bool TaskGraphRunner::HasQueuedTasksWithLockAcquired() const {
+  lock_.AssertAcquired();
+
+  // Tasks are queued while holding |lock_|, so a queue that looks empty
+  // here can't get a task before |lock_| is released.
+  for (size_t i = 0; i < worker_queues_.size(); ++i) {
+    if (base::subtle::NoBarrier_Load(&worker_queues_[i]->top_priority) >= 0)
+      return true;
+  }
+  return false;
+}
+
+// static
+void TaskGraphRunner::UpdateTopPriority(WorkerQueue* queue) {
+  queue->lock.AssertAcquired();
+
+  base::subtle::NoBarrier_Store(
+      &queue->top_priority,
+      queue->ready_to_run_tasks.empty()
+          ? -1
+          : static_cast<int>(queue->ready_to_run_tasks.front().priority));
+}
+
 }  // namespace internal
 }  // namespace cc
@@ -9,11 +9,13 @@
 #include <string>
 #include <vector>
 
+#include "base/atomicops.h"
 #include "base/memory/ref_counted.h"
 #include "base/synchronization/condition_variable.h"
 #include "base/threading/simple_thread.h"
 #include "cc/base/cc_export.h"
 #include "cc/base/scoped_ptr_deque.h"
+#include "cc/base/scoped_ptr_vector.h"
 
 namespace cc {
 namespace internal {
@@ -104,7 +106,21 @@ class CC_EXPORT NamespaceToken {
 // might block and should not be used on a thread that needs to be responsive.
 class CC_EXPORT TaskGraphRunner : public base::DelegateSimpleThread::Delegate {
  public:
-  TaskGraphRunner(size_t num_threads, const std::string& thread_name_prefix);
+  enum QueueingMode {
+    // All workers take ready to run tasks from the same queues, in priority
+    // order across all namespaces.
+    QUEUEING_MODE_SHARED,
+    // Each worker has its own queue of ready to run tasks and runs them in
+    // priority order. Worker threads don't need |lock_| to take a task, and
+    // the dependents of a task are queued on the worker that ran it. A worker
+    // without tasks steals the top priority task of the other queues. With
+    // one worker, this is the same order as QUEUEING_MODE_SHARED.
+    QUEUEING_MODE_WORK_STEALING
+  };
+
+  TaskGraphRunner(size_t num_threads,
+                  const std::string& thread_name_prefix,
+                  QueueingMode queueing_mode);
   virtual ~TaskGraphRunner();
 
   // Returns a unique token that can be used to pass a task graph to
@@ -156,10 +172,43 @@ class CC_EXPORT TaskGraphRunner : public base::DelegateSimpleThread::Delegate {
     // Completed tasks not yet collected by origin thread.
     Task::Vector completed_tasks;
 
-    // Number of currently running tasks.
+    // Number of currently running tasks. In QUEUEING_MODE_WORK_STEALING,
+    // this includes the tasks in |worker_queues_|.
     size_t num_running_tasks;
   };
 
+  struct QueuedTask {
+    typedef std::vector<QueuedTask> Vector;
+
+    QueuedTask(Task* task, unsigned priority, TaskNamespace* task_namespace)
+        : task(task), priority(priority), task_namespace(task_namespace) {}
+
+    Task* task;
+    unsigned priority;
+    TaskNamespace* task_namespace;
+  };
+
+  // The ready to run tasks of a worker in QUEUEING_MODE_WORK_STEALING.
+  struct WorkerQueue {
+    WorkerQueue();
+    ~WorkerQueue();
+
+    // Protects |ready_to_run_tasks|. Workers also set their entry in
+    // |running_tasks_| while holding it, so SetTaskGraph() holds all worker
+    // queue locks while checking for running tasks. It can be acquired while
+    // holding |lock_|, but |lock_| or another worker queue lock can't be
+    // acquired while holding it.
+    base::Lock lock;
+
+    // Ordered set of tasks that are ready to run.
+    QueuedTask::Vector ready_to_run_tasks;
+
+    // Priority of the top task of |ready_to_run_tasks|, or -1 if it is
+    // empty. It is updated while holding |lock|, and read without it to find
+    // a queue to steal from.
+    base::subtle::Atomic32 top_priority;
+  };
+
   typedef std::map<int, TaskNamespace> TaskNamespaceMap;
 
   static bool CompareTaskPriority(const PrioritizedTask& a,
@@ -168,6 +217,11 @@ class CC_EXPORT TaskGraphRunner : public base::DelegateSimpleThread::Delegate {
     return a.priority > b.priority;
   }
 
+  static bool CompareQueuedTaskPriority(const QueuedTask& a,
+                                        const QueuedTask& b) {
+    return a.priority > b.priority;
+  }
+
   static bool CompareTaskNamespacePriority(const TaskNamespace* a,
                                            const TaskNamespace* b) {
     DCHECK(!a->ready_to_run_tasks.empty());
@@ -193,6 +247,30 @@ class CC_EXPORT TaskGraphRunner : public base::DelegateSimpleThread::Delegate {
   // function and make sure at least one task is ready to run.
   void RunTaskWithLockAcquired(int thread_index);
 
+  // Worker thread loop of QUEUEING_MODE_WORK_STEALING.
+  void RunWithWorkStealing(int thread_index);
+
+  // Takes the next task of the worker at |thread_index| from its own queue,
+  // or from another queue if its own is empty, and runs it. Caller must not
+  // hold |lock_|. Returns false if there are no ready to run tasks.
+  bool RunQueuedTask(int thread_index);
+
+  // Pops the top priority task of |queue| into |task| and adds it to
+  // |running_tasks_|. Returns false if |queue| is empty.
+  bool TakeQueuedTask(WorkerQueue* queue, int thread_index, QueuedTask* task);
+
+  // Distributes the ready to run tasks of |task_namespace| over the worker
+  // queues, and cancels the tasks of |task_namespace| in the queues that are
+  // no longer ready to run. Caller must hold |lock_| and all worker queue
+  // locks.
+  void QueueReadyToRunTasksWithLocksAcquired(TaskNamespace* task_namespace);
+
+  // Returns true if any worker queue has a task. Caller must hold |lock_|.
+  bool HasQueuedTasksWithLockAcquired() const;
+
+  // Updates |queue->top_priority|. Caller must hold |queue->lock|.
+  static void UpdateTopPriority(WorkerQueue* queue);
+
   // This lock protects all members of this class. Do not read or modify
   // anything without holding this lock. Do not block while holding this
   // lock.
@@ -228,6 +306,16 @@ class CC_EXPORT TaskGraphRunner : public base::DelegateSimpleThread::Delegate {
   // are pending.
   bool shutdown_;
 
+  const QueueingMode queueing_mode_;
+
+  // The ready to run tasks of each worker, indexed like |running_tasks_|.
+  // Only used in QUEUEING_MODE_WORK_STEALING. Tasks are only added while
+  // holding |lock_|.
+  ScopedPtrVector<WorkerQueue> worker_queues_;
+
+  // Worker queue that gets the next task distributed by SetTaskGraph().
+  size_t next_worker_queue_index_;
+
   ScopedPtrDeque<base::DelegateSimpleThread> workers_;
 
   DISALLOW_COPY_AND_ASSIGN(TaskGraphRunner);
@@ -6,6 +6,7 @@
 
 #include <vector>
 
+#include "base/strings/stringprintf.h"
 #include "base/time/time.h"
 #include "cc/base/completion_event.h"
 #include "cc/test/lap_timer.h"
@@ -19,6 +20,8 @@ static const int kTimeLimitMillis = 2000;
 static const int kWarmupRuns = 5;
 static const int kTimeCheckInterval = 10;
 
+static const size_t kNumThreads[] = {1, 2, 4, 8, 16};
+
 class PerfTaskImpl : public internal::Task {
  public:
   typedef std::vector<scoped_refptr<PerfTaskImpl> > Vector;
@@ -45,9 +48,11 @@ class TaskGraphRunnerPerfTest : public testing::Test {
 
   // Overridden from testing::Test:
   virtual void SetUp() OVERRIDE {
-    task_graph_runner_ =
-        make_scoped_ptr(new internal::TaskGraphRunner(0,  // 0 worker threads
-                                                      "PerfTest"));
+    task_graph_runner_ = make_scoped_ptr(
+        new internal::TaskGraphRunner(0,  // 0 worker threads
+                                      "PerfTest",
+                                      internal::TaskGraphRunner::
+                                          QUEUEING_MODE_SHARED));
     namespace_token_ = task_graph_runner_->GetNamespaceToken();
   }
   virtual void TearDown() OVERRIDE { task_graph_runner_.reset(); }
@@ -211,11 +216,76 @@ class TaskGraphRunnerPerfTest : public testing::Test {
                            true);
   }
 
+  // Runs the tasks on a thread pool of each size in |kNumThreads|, to show how
+  // |queueing_mode| scales with the number of threads.
+  void RunExecuteTasksOnThreadsTest(
+      const std::string& test_name,
+      internal::TaskGraphRunner::QueueingMode queueing_mode,
+      int num_top_level_tasks,
+      int num_tasks,
+      int num_leaf_tasks) {
+    PerfTaskImpl::Vector top_level_tasks;
+    PerfTaskImpl::Vector tasks;
+    PerfTaskImpl::Vector leaf_tasks;
+    CreateTasks(num_top_level_tasks, &top_level_tasks);
+    CreateTasks(num_tasks, &tasks);
+    CreateTasks(num_leaf_tasks, &leaf_tasks);
+
+    for (size_t i = 0; i < arraysize(kNumThreads); ++i) {
+      internal::TaskGraphRunner task_graph_runner(
+          kNumThreads[i], "PerfTest", queueing_mode);
+      internal::NamespaceToken namespace_token =
+          task_graph_runner.GetNamespaceToken();
+
+      // Avoid unnecessary heap allocations by reusing the same graph and
+      // completed tasks vector.
+      internal::TaskGraph graph;
+      internal::Task::Vector completed_tasks;
+
+      timer_.Reset();
+      do {
+        graph.Reset();
+        BuildTaskGraph(top_level_tasks, tasks, leaf_tasks, &graph);
+        task_graph_runner.SetTaskGraph(namespace_token, &graph);
+        task_graph_runner.WaitForTasksToFinishRunning(namespace_token);
+        task_graph_runner.CollectCompletedTasks(namespace_token,
+                                                &completed_tasks);
+        completed_tasks.clear();
+        ResetTasks(&top_level_tasks);
+        ResetTasks(&tasks);
+        ResetTasks(&leaf_tasks);
+        timer_.NextLap();
+      } while (!timer_.HasTimeLimitExpired());
+
+      perf_test::PrintResult(
+          "execute_tasks_on_threads",
+          TestModifierString(queueing_mode),
+          base::StringPrintf("%s_%u_threads",
+                             test_name.c_str(),
+                             static_cast<unsigned>(kNumThreads[i])),
+          timer_.LapsPerSecond(),
+          "runs/s",
+          true);
+    }
+  }
+
  private:
   static std::string TestModifierString() {
     return std::string("_task_graph_runner");
   }
 
+  static std::string TestModifierString(
+      internal::TaskGraphRunner::QueueingMode queueing_mode) {
+    switch (queueing_mode) {
+      case internal::TaskGraphRunner::QUEUEING_MODE_SHARED:
+        return std::string("_task_graph_runner_shared");
+      case internal::TaskGraphRunner::QUEUEING_MODE_WORK_STEALING:
+        return std::string("_task_graph_runner_work_stealing");
+    }
+    NOTREACHED();
+    return std::string();
+  }
+
   void CreateTasks(int num_tasks, PerfTaskImpl::Vector* tasks) {
     for (int i = 0; i < num_tasks; ++i)
       tasks->push_back(make_scoped_refptr(new PerfTaskImpl));
@@ -320,5 +390,17 @@ TEST_F(TaskGraphRunnerPerfTest, ScheduleAndExecuteTasks) {
   RunScheduleAndExecuteTasksTest("2_32_1", 2, 32, 1);
 }
 
+TEST_F(TaskGraphRunnerPerfTest, ExecuteTasksOnThreads) {
+  const internal::TaskGraphRunner::QueueingMode kQueueingModes[] = {
+      internal::TaskGraphRunner::QUEUEING_MODE_SHARED,
+      internal::TaskGraphRunner::QUEUEING_MODE_WORK_STEALING};
+  for (size_t i = 0; i < arraysize(kQueueingModes); ++i) {
+    RunExecuteTasksOnThreadsTest("0_32_0", kQueueingModes[i], 0, 32, 0);
+    RunExecuteTasksOnThreadsTest("0_256_0", kQueueingModes[i], 0, 256, 0);
+    RunExecuteTasksOnThreadsTest("2_32_1", kQueueingModes[i], 2, 32, 1);
+    RunExecuteTasksOnThreadsTest("2_256_32", kQueueingModes[i], 2, 256, 32);
+  }
+}
+
 }  // namespace
 }  // namespace cc
@@ -4,6 +4,7 @@
 
 #include "cc/resources/task_graph_runner.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "base/bind.h"
@@ -158,13 +159,19 @@ class TaskGraphRunnerTestBase {
   std::vector<unsigned> on_task_completed_ids_[kNamespaceCount];
 };
 
-class TaskGraphRunnerTest : public TaskGraphRunnerTestBase,
-                            public testing::TestWithParam<int> {
+typedef std::tr1::tuple<int, internal::TaskGraphRunner::QueueingMode>
+    TaskGraphRunnerTestParam;
+
+class TaskGraphRunnerTest
+    : public TaskGraphRunnerTestBase,
+      public testing::TestWithParam<TaskGraphRunnerTestParam> {
  public:
   // Overridden from testing::Test:
   virtual void SetUp() OVERRIDE {
-    task_graph_runner_ =
-        make_scoped_ptr(new internal::TaskGraphRunner(GetParam(), "Test"));
+    task_graph_runner_ = make_scoped_ptr(
+        new internal::TaskGraphRunner(std::tr1::get<0>(GetParam()),
+                                      "Test",
+                                      std::tr1::get<1>(GetParam())));
     for (int i = 0; i < kNamespaceCount; ++i)
       namespace_token_[i] = task_graph_runner_->GetNamespaceToken();
   }
@@ -252,24 +259,58 @@ TEST_P(TaskGraphRunnerTest, Dependencies) {
   }
 }
 
-INSTANTIATE_TEST_CASE_P(TaskGraphRunnerTests,
-                        TaskGraphRunnerTest,
-                        ::testing::Range(1, 5));
+TEST_P(TaskGraphRunnerTest, Cancel) {
+  const unsigned kNumTasks = 100u;
+
+  for (int i = 0; i < kNamespaceCount; ++i) {
+    std::vector<Task> tasks;
+    for (unsigned j = 0; j < kNumTasks; ++j)
+      tasks.push_back(Task(i, j, 0u, 0u, j));
+    ScheduleTasks(i, tasks);
+  }
 
-class TaskGraphRunnerSingleThreadTest : public TaskGraphRunnerTestBase,
-                                        public testing::Test {
+  // Replacing the graph cancels the tasks that haven't started running yet.
+  for (int i = 0; i < kNamespaceCount; ++i)
+    ScheduleTasks(i, std::vector<Task>(1, Task(i, kNumTasks, 0u, 0u, 0u)));
+
+  for (int i = 0; i < kNamespaceCount; ++i) {
+    RunAllTasks(i);
+
+    // Canceled tasks are completed without running.
+    EXPECT_LE(1u, run_task_ids(i).size());
+    EXPECT_GE(kNumTasks + 1u, run_task_ids(i).size());
+    EXPECT_NE(run_task_ids(i).end(),
+              std::find(run_task_ids(i).begin(),
+                        run_task_ids(i).end(),
+                        kNumTasks));
+    EXPECT_EQ(kNumTasks + 1u, on_task_completed_ids(i).size());
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    TaskGraphRunnerTests,
+    TaskGraphRunnerTest,
+    ::testing::Combine(
+        ::testing::Range(1, 5),
+        ::testing::Values(
+            internal::TaskGraphRunner::QUEUEING_MODE_SHARED,
+            internal::TaskGraphRunner::QUEUEING_MODE_WORK_STEALING)));
+
+class TaskGraphRunnerSingleThreadTest
+    : public TaskGraphRunnerTestBase,
+      public testing::TestWithParam<internal::TaskGraphRunner::QueueingMode> {
  public:
   // Overridden from testing::Test:
   virtual void SetUp() OVERRIDE {
-    task_graph_runner_ =
-        make_scoped_ptr(new internal::TaskGraphRunner(1, "Test"));
+    task_graph_runner_ = make_scoped_ptr(
+        new internal::TaskGraphRunner(1, "Test", GetParam()));
     for (int i = 0; i < kNamespaceCount; ++i)
       namespace_token_[i] = task_graph_runner_->GetNamespaceToken();
   }
   virtual void TearDown() OVERRIDE { task_graph_runner_.reset(); }
 };
 
-TEST_F(TaskGraphRunnerSingleThreadTest, Priority) {
+TEST_P(TaskGraphRunnerSingleThreadTest, Priority) {
   for (int i = 0; i < kNamespaceCount; ++i) {
     Task tasks[] = {Task(i, 0u, 2u, 1u, 1u),  // Priority 1
                     Task(i, 1u, 3u, 1u, 0u)   // Priority 0
@@ -292,5 +333,11 @@ TEST_F(TaskGraphRunnerSingleThreadTest, Priority) {
   }
 }
 
+INSTANTIATE_TEST_CASE_P(
+    TaskGraphRunnerSingleThreadTests,
+    TaskGraphRunnerSingleThreadTest,
+    ::testing::Values(internal::TaskGraphRunner::QUEUEING_MODE_SHARED,
+                      internal::TaskGraphRunner::QUEUEING_MODE_WORK_STEALING));
+
 }  // namespace
 }  // namespace cc
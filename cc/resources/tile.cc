@@ -33,6 +33,8 @@ Tile::Tile(TileManager* tile_manager,
     flags_(flags),
     id_(s_next_id_++) {
   set_picture_pile(picture_pile);
+  for (int tree = 0; tree < NUM_TREES; ++tree)
+    is_occluded_[tree] = false;
 }
 
 Tile::~Tile() {
@@ -23,7 +23,10 @@ class CC_EXPORT Tile : public RefCountedManaged<Tile> {
  public:
   enum TileRasterFlags {
     USE_LCD_TEXT = 1 << 0,
-    USE_GPU_RASTERIZATION = 1 << 1
+    USE_GPU_RASTERIZATION = 1 << 1,
+    // The resource of the tile must be exactly its size, rather than a larger
+    // resource that is only partially used.
+    NEEDS_EXACT_SIZE_RESOURCE = 1 << 2
   };
 
   typedef uint64 Id;
@@ -57,6 +60,13 @@ class CC_EXPORT Tile : public RefCountedManaged<Tile> {
     return priority_[PENDING_TREE].required_for_activation;
   }
 
+  // Whether the tile is visible but fully occluded by opaque layers in front
+  // of it, in which case it doesn't need to be rasterized.
+  bool is_occluded(WhichTree tree) const { return is_occluded_[tree]; }
+  void set_is_occluded(WhichTree tree, bool is_occluded) {
+    is_occluded_[tree] = is_occluded;
+  }
+
   void set_can_use_lcd_text(bool can_use_lcd_text) {
     if (can_use_lcd_text)
       flags_ |= USE_LCD_TEXT;
@@ -79,6 +89,10 @@ class CC_EXPORT Tile : public RefCountedManaged<Tile> {
     return !!(flags_ & USE_GPU_RASTERIZATION);
   }
 
+  bool needs_exact_size_resource() const {
+    return !!(flags_ & NEEDS_EXACT_SIZE_RESOURCE);
+  }
+
   scoped_ptr<base::Value> AsValue() const;
 
   inline bool IsReadyToDraw() const {
@@ -155,6 +169,7 @@ class CC_EXPORT Tile : public RefCountedManaged<Tile> {
   gfx::Rect opaque_rect_;
 
   TilePriority priority_[NUM_TREES];
+  bool is_occluded_[NUM_TREES];
   ManagedTileState managed_state_;
   int layer_id_;
   int source_frame_number_;
@@ -130,6 +130,21 @@ inline ManagedTileBin BinFromTilePriority(const TilePriority& prio) {
   return EVENTUALLY_BIN;
 }
 
+// Returns true for the tiles in |sorted_released_tiles|.
+class IsReleasedTile {
+ public:
+  explicit IsReleasedTile(const std::vector<Tile*>& sorted_released_tiles)
+      : sorted_released_tiles_(sorted_released_tiles) {}
+
+  bool operator()(Tile* tile) const {
+    return std::binary_search(
+        sorted_released_tiles_.begin(), sorted_released_tiles_.end(), tile);
+  }
+
+ private:
+  const std::vector<Tile*>& sorted_released_tiles_;
+};
+
 }  // namespace
 
 RasterTaskCompletionStats::RasterTaskCompletionStats()
@@ -153,7 +168,8 @@ scoped_ptr<TileManager> TileManager::Create(
     bool use_rasterize_on_demand,
     size_t max_transfer_buffer_usage_bytes,
     size_t max_raster_usage_bytes,
-    unsigned map_image_texture_target) {
+    unsigned map_image_texture_target,
+    bool use_compressed_prepaint_tiles) {
   return make_scoped_ptr(new TileManager(
       client,
       resource_provider,
@@ -165,7 +181,10 @@ scoped_ptr<TileManager> TileManager::Create(
       DirectRasterWorkerPool::Create(resource_provider, context_provider),
       max_raster_usage_bytes,
       rendering_stats_instrumentation,
-      use_rasterize_on_demand));
+      use_rasterize_on_demand,
+      // Compressed textures can only be uploaded from pixel buffers.
+      use_compressed_prepaint_tiles && !use_map_image &&
+          resource_provider->use_compressed_texture_etc1()));
 }
 
 TileManager::TileManager(
@@ -176,13 +195,13 @@ TileManager::TileManager(
     scoped_ptr<RasterWorkerPool> direct_raster_worker_pool,
     size_t max_raster_usage_bytes,
     RenderingStatsInstrumentation* rendering_stats_instrumentation,
-    bool use_rasterize_on_demand)
+    bool use_rasterize_on_demand,
+    bool use_compressed_prepaint_tiles)
     : client_(client),
       context_provider_(context_provider),
       resource_pool_(
           ResourcePool::Create(resource_provider,
-                               raster_worker_pool->GetResourceTarget(),
-                               raster_worker_pool->GetResourceFormat())),
+                               raster_worker_pool->GetResourceTarget())),
       raster_worker_pool_(raster_worker_pool.Pass()),
       direct_raster_worker_pool_(direct_raster_worker_pool.Pass()),
       prioritized_tiles_dirty_(false),
@@ -197,7 +216,8 @@ TileManager::TileManager(
       rendering_stats_instrumentation_(rendering_stats_instrumentation),
       did_initialize_visible_tile_(false),
       did_check_for_completed_tasks_since_last_schedule_tasks_(true),
-      use_rasterize_on_demand_(use_rasterize_on_demand) {
+      use_rasterize_on_demand_(use_rasterize_on_demand),
+      use_compressed_prepaint_tiles_(use_compressed_prepaint_tiles) {
   RasterWorkerPool* raster_worker_pools[NUM_RASTER_WORKER_POOL_TYPES] = {
       raster_worker_pool_.get(),        // RASTER_WORKER_POOL_TYPE_DEFAULT
       direct_raster_worker_pool_.get()  // RASTER_WORKER_POOL_TYPE_DIRECT
@@ -240,6 +260,17 @@ bool TileManager::ShouldForceTasksRequiredForActivationToComplete() const {
 }
 
 void TileManager::CleanUpReleasedTiles() {
+  if (released_tiles_.empty())
+    return;
+
+  TileVector sorted_released_tiles(released_tiles_);
+  std::sort(sorted_released_tiles.begin(), sorted_released_tiles.end());
+  tiles_in_priority_order_.erase(
+      std::remove_if(tiles_in_priority_order_.begin(),
+                     tiles_in_priority_order_.end(),
+                     IsReleasedTile(sorted_released_tiles)),
+      tiles_in_priority_order_.end());
+
   for (std::vector<Tile*>::iterator it = released_tiles_.begin();
        it != released_tiles_.end();
        ++it) {
@@ -255,7 +286,7 @@ void TileManager::CleanUpReleasedTiles() {
     DCHECK_GT(layer_it->second, 0);
     if (--layer_it->second == 0) {
       used_layer_counts_.erase(layer_it);
-      image_decode_tasks_.erase(tile->layer_id());
+      ReleaseImageDecodeTasksForLayer(tile->layer_id());
     }
 
     delete tile;
@@ -273,6 +304,21 @@ void TileManager::UpdatePrioritizedTileSetIfNeeded() {
   prioritized_tiles_.Clear();
   GetTilesWithAssignedBins(&prioritized_tiles_);
   prioritized_tiles_dirty_ = false;
+
+  // Remember the new order for the next update. Tiles in the NEVER bin
+  // aren't in |prioritized_tiles_| and keep their relative order at the end.
+  TileVector tiles_in_priority_order;
+  tiles_in_priority_order.reserve(tiles_in_priority_order_.size());
+  for (PrioritizedTileSet::Iterator it(&prioritized_tiles_, true); it; ++it)
+    tiles_in_priority_order.push_back(*it);
+  for (TileVector::const_iterator it = tiles_in_priority_order_.begin();
+       it != tiles_in_priority_order_.end();
+       ++it) {
+    if ((*it)->managed_state().bin == NEVER_BIN)
+      tiles_in_priority_order.push_back(*it);
+  }
+  DCHECK_EQ(tiles_.size(), tiles_in_priority_order.size());
+  tiles_in_priority_order_.swap(tiles_in_priority_order);
 }
 
 void TileManager::DidFinishRunningTasks() {
@@ -346,9 +392,12 @@ void TileManager::GetTilesWithAssignedBins(PrioritizedTileSet* tiles) {
   const TileMemoryLimitPolicy memory_policy = global_state_.memory_limit_policy;
   const TreePriority tree_priority = global_state_.tree_priority;
 
-  // For each tree, bin into different categories of tiles.
-  for (TileMap::const_iterator it = tiles_.begin(); it != tiles_.end(); ++it) {
-    Tile* tile = it->second;
+  // For each tree, bin into different categories of tiles. Visiting the tiles
+  // in their last priority order keeps the bins nearly sorted.
+  for (TileVector::const_iterator it = tiles_in_priority_order_.begin();
+       it != tiles_in_priority_order_.end();
+       ++it) {
+    Tile* tile = *it;
     ManagedTileState& mts = tile->managed_state();
 
     const ManagedTileState::TileVersion& tile_version =
@@ -402,9 +451,11 @@ void TileManager::GetTilesWithAssignedBins(PrioritizedTileSet* tiles) {
       ManagedTileBin gpu_memmgr_stats_bin = combined_bin;
       if ((gpu_memmgr_stats_bin == NOW_BIN) ||
           (gpu_memmgr_stats_bin == NOW_AND_READY_TO_DRAW_BIN))
-        memory_required_bytes_ += BytesConsumedIfAllocated(tile);
+        memory_required_bytes_ +=
+            BytesConsumedIfAllocated(tile, DetermineResourceFormat(tile));
       if (gpu_memmgr_stats_bin != NEVER_BIN)
-        memory_nice_to_have_bytes_ += BytesConsumedIfAllocated(tile);
+        memory_nice_to_have_bytes_ +=
+            BytesConsumedIfAllocated(tile, DetermineResourceFormat(tile));
     }
 
     ManagedTileBin tree_bin[NUM_TREES];
@@ -589,6 +640,20 @@ RasterMode TileManager::DetermineRasterMode(const Tile* tile) const {
   return std::min(raster_mode, current_mode);
 }
 
+ResourceFormat TileManager::DetermineResourceFormat(const Tile* tile) const {
+  // ETC1 has no alpha channel, and its artifacts are only acceptable for
+  // tiles far from the viewport, which are likely to be rasterized again
+  // before they're seen. Only tiles made of whole 4x4 blocks are compressed.
+  if (use_compressed_prepaint_tiles_ &&
+      tile->managed_state().bin >= EVENTUALLY_AND_ACTIVE_BIN &&
+      !tile->use_gpu_rasterization() &&
+      tile->opaque_rect().Contains(tile->content_rect()) &&
+      tile->size().width() % 4 == 0 && tile->size().height() % 4 == 0)
+    return ETC1;
+
+  return raster_worker_pool_->GetResourceFormat();
+}
+
 void TileManager::AssignGpuMemoryToTiles(
     PrioritizedTileSet* tiles,
     TileVector* tiles_that_need_to_be_rasterized) {
@@ -662,8 +727,31 @@ void TileManager::AssignGpuMemoryToTiles(
       continue;
     }
 
+    // Tiles of content that was found to be a single color when it was
+    // recorded don't need to be rasterized.
+    SkColor solid_color;
+    if (!tile_version.raster_task_ &&
+        tile->picture_pile()->GetSolidColorFromRecording(
+            tile->content_rect(), tile->contents_scale(), &solid_color)) {
+      tile_version.set_has_text(false);
+      tile_version.set_solid_color(solid_color);
+      FreeUnusedResourcesForTile(tile);
+      if (tile->priority(ACTIVE_TREE).distance_to_visible == 0.f)
+        did_initialize_visible_tile_ = true;
+      continue;
+    }
+
+    const ResourceFormat format = DetermineResourceFormat(tile);
+
+    // Compressed tiles are rasterized again in the regular format once they
+    // get close to the viewport. Tiles that are already on screen keep their
+    // compressed resource, since dropping it would checkerboard.
+    if (tile_version.resource_ && tile_version.resource_->format() == ETC1 &&
+        format != ETC1 && !mts.visible_and_ready_to_draw)
+      FreeResourceForTile(tile, mts.raster_mode);
+
     const bool tile_uses_hard_limit = mts.bin <= NOW_BIN;
-    const size_t bytes_if_allocated = BytesConsumedIfAllocated(tile);
+    const size_t bytes_if_allocated = BytesConsumedIfAllocated(tile, format);
     const size_t raster_bytes_if_rastered = raster_bytes + bytes_if_allocated;
     const size_t tile_bytes_left =
         (tile_uses_hard_limit) ? hard_bytes_left : soft_bytes_left;
@@ -674,7 +762,8 @@ void TileManager::AssignGpuMemoryToTiles(
     // It costs to maintain a resource.
     for (int mode = 0; mode < NUM_RASTER_MODES; ++mode) {
       if (mts.tile_versions[mode].resource_) {
-        tile_bytes += bytes_if_allocated;
+        tile_bytes += BytesConsumedIfAllocated(
+            tile, mts.tile_versions[mode].resource_->format());
         tile_resources++;
       }
     }
@@ -760,12 +849,14 @@ void TileManager::AssignGpuMemoryToTiles(
 void TileManager::FreeResourceForTile(Tile* tile, RasterMode mode) {
   ManagedTileState& mts = tile->managed_state();
   if (mts.tile_versions[mode].resource_) {
+    size_t bytes = BytesConsumedIfAllocated(
+        tile, mts.tile_versions[mode].resource_->format());
     resource_pool_->ReleaseResource(mts.tile_versions[mode].resource_.Pass());
 
-    DCHECK_GE(bytes_releasable_, BytesConsumedIfAllocated(tile));
+    DCHECK_GE(bytes_releasable_, bytes);
     DCHECK_GE(resources_releasable_, 1u);
 
-    bytes_releasable_ -= BytesConsumedIfAllocated(tile);
+    bytes_releasable_ -= bytes;
     --resources_releasable_;
   }
 }
@@ -852,21 +943,46 @@ scoped_refptr<internal::WorkerPoolTask> TileManager::CreateImageDecodeTask(
       rendering_stats_instrumentation_,
       base::Bind(&TileManager::OnImageDecodeTaskCompleted,
                  base::Unretained(this),
-                 tile->layer_id(),
                  base::Unretained(pixel_ref)));
 }
 
+void TileManager::ReleaseImageDecodeTasksForLayer(int layer_id) {
+  LayerPixelRefIdMap::iterator layer_it = layer_pixel_ref_ids_.find(layer_id);
+  if (layer_it == layer_pixel_ref_ids_.end())
+    return;
+
+  const PixelRefIdSet& pixel_ref_ids = layer_it->second;
+  for (PixelRefIdSet::const_iterator it = pixel_ref_ids.begin();
+       it != pixel_ref_ids.end();
+       ++it) {
+    PixelRefLayerCountMap::iterator count_it =
+        pixel_ref_layer_counts_.find(*it);
+    DCHECK(count_it != pixel_ref_layer_counts_.end());
+    DCHECK_GT(count_it->second, 0);
+    if (--count_it->second == 0) {
+      pixel_ref_layer_counts_.erase(count_it);
+      image_decode_tasks_.erase(*it);
+    }
+  }
+
+  layer_pixel_ref_ids_.erase(layer_it);
+}
+
 scoped_refptr<internal::RasterWorkerPoolTask> TileManager::CreateRasterTask(
     Tile* tile) {
   ManagedTileState& mts = tile->managed_state();
 
   scoped_ptr<ScopedResource> resource =
-      resource_pool_->AcquireResource(tile->tile_size_.size());
+      tile->needs_exact_size_resource()
+          ? resource_pool_->AcquireResource(tile->tile_size_.size(),
+                                            DetermineResourceFormat(tile))
+          : resource_pool_->AcquireResourceOfAtLeastSize(
+                tile->tile_size_.size(), DetermineResourceFormat(tile));
   const ScopedResource* const_resource = resource.get();
 
   // Create and queue all image decode tasks that this tile depends on.
   internal::WorkerPoolTask::Vector decode_tasks;
-  PixelRefTaskMap& existing_pixel_refs = image_decode_tasks_[tile->layer_id()];
+  PixelRefIdSet& layer_pixel_ref_ids = layer_pixel_ref_ids_[tile->layer_id()];
   for (PicturePileImpl::PixelRefIterator iter(
            tile->content_rect(), tile->contents_scale(), tile->picture_pile());
        iter;
@@ -874,9 +990,14 @@ scoped_refptr<internal::RasterWorkerPoolTask> TileManager::CreateRasterTask(
     SkPixelRef* pixel_ref = *iter;
     uint32_t id = pixel_ref->getGenerationID();
 
-    // Append existing image decode task if available.
-    PixelRefTaskMap::iterator decode_task_it = existing_pixel_refs.find(id);
-    if (decode_task_it != existing_pixel_refs.end()) {
+    // Keep the decode task alive as long as this layer has tiles.
+    if (layer_pixel_ref_ids.insert(id).second)
+      pixel_ref_layer_counts_[id]++;
+
+    // Append existing image decode task if available. It may have been
+    // created for a tile of another layer.
+    PixelRefTaskMap::iterator decode_task_it = image_decode_tasks_.find(id);
+    if (decode_task_it != image_decode_tasks_.end()) {
       decode_tasks.push_back(decode_task_it->second);
       continue;
     }
@@ -885,7 +1006,7 @@ scoped_refptr<internal::RasterWorkerPoolTask> TileManager::CreateRasterTask(
     scoped_refptr<internal::WorkerPoolTask> decode_task =
         CreateImageDecodeTask(tile, pixel_ref);
     decode_tasks.push_back(decode_task);
-    existing_pixel_refs[id] = decode_task;
+    image_decode_tasks_[id] = decode_task;
   }
 
   return RasterWorkerPool::CreateRasterTask(
@@ -908,25 +1029,18 @@ scoped_refptr<internal::RasterWorkerPoolTask> TileManager::CreateRasterTask(
       context_provider_);
 }
 
-void TileManager::OnImageDecodeTaskCompleted(int layer_id,
-                                             SkPixelRef* pixel_ref,
+void TileManager::OnImageDecodeTaskCompleted(SkPixelRef* pixel_ref,
                                              bool was_canceled) {
   // If the task was canceled, we need to clean it up
   // from |image_decode_tasks_|.
   if (!was_canceled)
     return;
 
-  LayerPixelRefTaskMap::iterator layer_it = image_decode_tasks_.find(layer_id);
-
-  if (layer_it == image_decode_tasks_.end())
-    return;
-
-  PixelRefTaskMap& pixel_ref_tasks = layer_it->second;
   PixelRefTaskMap::iterator task_it =
-      pixel_ref_tasks.find(pixel_ref->getGenerationID());
+      image_decode_tasks_.find(pixel_ref->getGenerationID());
 
-  if (task_it != pixel_ref_tasks.end())
-    pixel_ref_tasks.erase(task_it);
+  if (task_it != image_decode_tasks_.end())
+    image_decode_tasks_.erase(task_it);
 }
 
 void TileManager::OnRasterTaskCompleted(
@@ -964,7 +1078,8 @@ void TileManager::OnRasterTaskCompleted(
     tile_version.set_use_resource();
     tile_version.resource_ = resource.Pass();
 
-    bytes_releasable_ += BytesConsumedIfAllocated(tile);
+    bytes_releasable_ +=
+        BytesConsumedIfAllocated(tile, tile_version.resource_->format());
     ++resources_releasable_;
   }
 
@@ -993,6 +1108,7 @@ scoped_refptr<Tile> TileManager::CreateTile(PicturePileImpl* picture_pile,
   DCHECK(tiles_.find(tile->id()) == tiles_.end());
 
   tiles_[tile->id()] = tile;
+  tiles_in_priority_order_.push_back(tile);
   used_layer_counts_[tile->layer_id()]++;
   prioritized_tiles_dirty_ = true;
   return tile;
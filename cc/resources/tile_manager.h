@@ -59,7 +59,8 @@ class CC_EXPORT TileManager : public RasterWorkerPoolClient,
       bool use_rasterize_on_demand,
       size_t max_transfer_buffer_usage_bytes,
       size_t max_raster_usage_bytes,
-      unsigned map_image_texture_target);
+      unsigned map_image_texture_target,
+      bool use_compressed_prepaint_tiles);
   virtual ~TileManager();
 
   void ManageTiles(const GlobalStateThatImpactsTilePriority& state);
@@ -95,9 +96,11 @@ class CC_EXPORT TileManager : public RasterWorkerPoolClient,
       ManagedTileState::TileVersion& tile_version =
           mts.tile_versions[HIGH_QUALITY_NO_LCD_RASTER_MODE];
 
-      tile_version.resource_ = resource_pool_->AcquireResource(gfx::Size(1, 1));
+      tile_version.resource_ = resource_pool_->AcquireResource(
+          gfx::Size(1, 1), raster_worker_pool_->GetResourceFormat());
 
-      bytes_releasable_ += BytesConsumedIfAllocated(tiles[i]);
+      bytes_releasable_ += BytesConsumedIfAllocated(
+          tiles[i], raster_worker_pool_->GetResourceFormat());
       ++resources_releasable_;
     }
   }
@@ -124,7 +127,8 @@ class CC_EXPORT TileManager : public RasterWorkerPoolClient,
               scoped_ptr<RasterWorkerPool> direct_raster_worker_pool,
               size_t max_raster_usage_bytes,
               RenderingStatsInstrumentation* rendering_stats_instrumentation,
-              bool use_rasterize_on_demand);
+              bool use_rasterize_on_demand,
+              bool use_compressed_prepaint_tiles);
 
   // Methods called by Tile
   friend class Tile;
@@ -158,21 +162,21 @@ class CC_EXPORT TileManager : public RasterWorkerPoolClient,
     NUM_RASTER_WORKER_POOL_TYPES
   };
 
-  void OnImageDecodeTaskCompleted(int layer_id,
-                                  SkPixelRef* pixel_ref,
-                                  bool was_canceled);
+  void OnImageDecodeTaskCompleted(SkPixelRef* pixel_ref, bool was_canceled);
+  void ReleaseImageDecodeTasksForLayer(int layer_id);
   void OnRasterTaskCompleted(Tile::Id tile,
                              scoped_ptr<ScopedResource> resource,
                              RasterMode raster_mode,
                              const PicturePileImpl::Analysis& analysis,
                              bool was_canceled);
 
-  inline size_t BytesConsumedIfAllocated(const Tile* tile) const {
-    return Resource::MemorySizeBytes(tile->size(),
-                                     raster_worker_pool_->GetResourceFormat());
+  inline size_t BytesConsumedIfAllocated(const Tile* tile,
+                                         ResourceFormat format) const {
+    return Resource::MemorySizeBytes(tile->size(), format);
   }
 
   RasterMode DetermineRasterMode(const Tile* tile) const;
+  ResourceFormat DetermineResourceFormat(const Tile* tile) const;
   void FreeResourceForTile(Tile* tile, RasterMode mode);
   void FreeResourcesForTile(Tile* tile);
   void FreeUnusedResourcesForTile(Tile* tile);
@@ -194,6 +198,11 @@ class CC_EXPORT TileManager : public RasterWorkerPoolClient,
   typedef base::hash_map<Tile::Id, Tile*> TileMap;
   TileMap tiles_;
 
+  // All the tiles in |tiles_|, in the order of the last prioritization.
+  // Binning the tiles in this order leaves each bin nearly sorted when few
+  // priorities changed, which PrioritizedTileSet sorts in linear time.
+  TileVector tiles_in_priority_order_;
+
   PrioritizedTileSet prioritized_tiles_;
   bool prioritized_tiles_dirty_;
 
@@ -215,10 +224,21 @@ class CC_EXPORT TileManager : public RasterWorkerPoolClient,
   bool did_initialize_visible_tile_;
   bool did_check_for_completed_tasks_since_last_schedule_tasks_;
 
+  // Image decode tasks are shared by all the layers, so an image used by
+  // many tiles or layers is decoded once into its pixel ref's discardable
+  // memory, by a task that all their raster tasks depend on.
   typedef base::hash_map<uint32_t, scoped_refptr<internal::WorkerPoolTask> >
       PixelRefTaskMap;
-  typedef base::hash_map<int, PixelRefTaskMap> LayerPixelRefTaskMap;
-  LayerPixelRefTaskMap image_decode_tasks_;
+  PixelRefTaskMap image_decode_tasks_;
+
+  // The ids of the pixel refs that each layer's tiles have decoded, and the
+  // number of layers that decoded each of them. A decode task is dropped
+  // once no layer with tiles uses its pixel ref.
+  typedef base::hash_set<uint32_t> PixelRefIdSet;
+  typedef base::hash_map<int, PixelRefIdSet> LayerPixelRefIdMap;
+  LayerPixelRefIdMap layer_pixel_ref_ids_;
+  typedef base::hash_map<uint32_t, int> PixelRefLayerCountMap;
+  PixelRefLayerCountMap pixel_ref_layer_counts_;
 
   typedef base::hash_map<int, int> LayerCountMap;
   LayerCountMap used_layer_counts_;
@@ -229,6 +249,9 @@ class CC_EXPORT TileManager : public RasterWorkerPoolClient,
 
   bool use_rasterize_on_demand_;
 
+  // Whether opaque tiles far from the viewport are compressed to ETC1.
+  bool use_compressed_prepaint_tiles_;
+
   // Queues used when scheduling raster tasks.
   RasterTaskQueue raster_queue_[NUM_RASTER_WORKER_POOL_TYPES];
 
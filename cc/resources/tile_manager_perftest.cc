@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+
 #include "base/time/time.h"
 #include "cc/resources/tile.h"
 #include "cc/resources/tile_priority.h"
@@ -24,6 +26,12 @@ static const int kTimeLimitMillis = 2000;
 static const int kWarmupRuns = 5;
 static const int kTimeCheckInterval = 10;
 
+// Layout of the tiles in the scrolling tests.
+static const int kTileColumns = 10;
+static const int kViewportHeight = 1024;
+static const int kScrollDeltaPixels = 16;
+static const float kSoonBorderPixels = 1000.0f;
+
 class TileManagerPerfTest : public testing::Test {
  public:
   typedef std::vector<std::pair<scoped_refptr<Tile>, ManagedTileBin> >
@@ -133,6 +141,69 @@ class TileManagerPerfTest : public testing::Test {
     CreateBinTiles(count - 3 * count_per_bin, NEVER_BIN, tiles);
   }
 
+  void CreateTileGrid(int count, std::vector<scoped_refptr<Tile> >* tiles) {
+    gfx::Size tile_size = settings_.default_tile_size;
+    for (int i = 0; i < count; ++i) {
+      gfx::Point origin((i % kTileColumns) * tile_size.width(),
+                        (i / kTileColumns) * tile_size.height());
+      gfx::Rect content_rect(origin, tile_size);
+      tiles->push_back(tile_manager_->CreateTile(picture_pile_.get(),
+                                                 tile_size,
+                                                 content_rect,
+                                                 gfx::Rect(),
+                                                 1.0,
+                                                 0,
+                                                 0,
+                                                 Tile::USE_LCD_TEXT));
+    }
+  }
+
+  TilePriority GetTilePriorityForScrollOffset(const Tile* tile,
+                                              int scroll_offset) {
+    gfx::Rect content_rect = tile->content_rect();
+    float distance_to_visible = std::max(
+        0, std::max(content_rect.y() - (scroll_offset + kViewportHeight),
+                    scroll_offset - content_rect.bottom()));
+    TilePriority::PriorityBin priority_bin = TilePriority::EVENTUALLY;
+    if (distance_to_visible == 0.0f)
+      priority_bin = TilePriority::NOW;
+    else if (distance_to_visible < kSoonBorderPixels)
+      priority_bin = TilePriority::SOON;
+    return TilePriority(HIGH_RESOLUTION, priority_bin, distance_to_visible);
+  }
+
+  void RunManageTilesWithScrollTest(const std::string& test_name,
+                                    int tile_count) {
+    std::vector<scoped_refptr<Tile> > tiles;
+    CreateTileGrid(tile_count, &tiles);
+    int content_height =
+        (tile_count / kTileColumns + 1) * settings_.default_tile_size.height();
+    int scroll_offset = 0;
+    timer_.Reset();
+    do {
+      // Each frame scrolls a bit further, which changes the distance of
+      // every tile but moves few of them to another bin.
+      scroll_offset = (scroll_offset + kScrollDeltaPixels) % content_height;
+      for (size_t i = 0; i < tiles.size(); ++i) {
+        TilePriority priority =
+            GetTilePriorityForScrollOffset(tiles[i].get(), scroll_offset);
+        tiles[i]->SetPriority(ACTIVE_TREE, priority);
+        tiles[i]->SetPriority(PENDING_TREE, priority);
+      }
+
+      tile_manager_->ManageTiles(GlobalStateForTest());
+      tile_manager_->UpdateVisibleTiles();
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    perf_test::PrintResult("manage_tiles_with_scroll",
+                           "",
+                           test_name,
+                           timer_.LapsPerSecond(),
+                           "runs/s",
+                           true);
+  }
+
   void RunManageTilesTest(const std::string& test_name,
                           unsigned tile_count,
                           int priority_change_percent) {
@@ -186,6 +257,12 @@ TEST_F(TileManagerPerfTest, ManageTiles) {
   RunManageTilesTest("10000_100", 10000, 100);
 }
 
+TEST_F(TileManagerPerfTest, ManageTilesWithScroll) {
+  RunManageTilesWithScrollTest("100", 100);
+  RunManageTilesWithScrollTest("1000", 1000);
+  RunManageTilesWithScrollTest("10000", 10000);
+}
+
 }  // namespace
 
 }  // namespace cc
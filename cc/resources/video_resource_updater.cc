@@ -27,7 +27,8 @@ VideoFrameExternalResources::~VideoFrameExternalResources() {}
 VideoResourceUpdater::VideoResourceUpdater(ContextProvider* context_provider,
                                            ResourceProvider* resource_provider)
     : context_provider_(context_provider),
-      resource_provider_(resource_provider) {
+      resource_provider_(resource_provider),
+      last_frame_upload_id_(0) {
 }
 
 VideoResourceUpdater::~VideoResourceUpdater() {
@@ -161,8 +162,13 @@ VideoFrameExternalResources VideoResourceUpdater::CreateForSoftwarePlanes(
   int max_resource_size = resource_provider_->max_texture_size();
   gfx::Size coded_frame_size = video_frame->coded_size();
 
+  // Resources tagged with this id already hold the planes of |video_frame|.
+  const uint32 frame_upload_id =
+      video_frame == last_uploaded_frame_ ? last_frame_upload_id_ : 0;
+
   std::vector<PlaneResource> plane_resources;
   bool allocation_success = true;
+  bool needs_upload = false;
 
   for (size_t i = 0; i < output_plane_count; ++i) {
     gfx::Size output_plane_resource_size =
@@ -180,20 +186,37 @@ VideoFrameExternalResources VideoResourceUpdater::CreateForSoftwarePlanes(
     ResourceProvider::ResourceId resource_id = 0;
     gpu::Mailbox mailbox;
 
-    // Try recycle a previously-allocated resource.
-    for (size_t i = 0; i < recycled_resources_.size(); ++i) {
+    // Try recycle a previously-allocated resource, preferring one that already
+    // holds this plane of |video_frame|.
+    size_t recycled_index = recycled_resources_.size();
+    for (size_t j = 0; j < recycled_resources_.size(); ++j) {
       bool resource_matches =
-          recycled_resources_[i].resource_format == output_resource_format &&
-          recycled_resources_[i].resource_size == output_plane_resource_size;
+          recycled_resources_[j].resource_format == output_resource_format &&
+          recycled_resources_[j].resource_size == output_plane_resource_size;
       bool not_in_use =
           !software_compositor || !resource_provider_->InUseByConsumer(
-                                       recycled_resources_[i].resource_id);
-      if (resource_matches && not_in_use) {
-        resource_id = recycled_resources_[i].resource_id;
-        mailbox = recycled_resources_[i].mailbox;
-        recycled_resources_.erase(recycled_resources_.begin() + i);
+                                       recycled_resources_[j].resource_id);
+      if (!resource_matches || !not_in_use)
+        continue;
+      if (frame_upload_id &&
+          recycled_resources_[j].frame_upload_id == frame_upload_id &&
+          recycled_resources_[j].plane_index == i) {
+        recycled_index = j;
         break;
       }
+      if (recycled_index == recycled_resources_.size())
+        recycled_index = j;
+    }
+    if (recycled_index < recycled_resources_.size()) {
+      const PlaneResource& recycled = recycled_resources_[recycled_index];
+      resource_id = recycled.resource_id;
+      mailbox = recycled.mailbox;
+      if (!frame_upload_id || recycled.frame_upload_id != frame_upload_id ||
+          recycled.plane_index != i)
+        needs_upload = true;
+      recycled_resources_.erase(recycled_resources_.begin() + recycled_index);
+    } else {
+      needs_upload = true;
     }
 
     if (resource_id == 0) {
@@ -233,7 +256,9 @@ VideoFrameExternalResources VideoResourceUpdater::CreateForSoftwarePlanes(
     plane_resources.push_back(PlaneResource(resource_id,
                                             output_plane_resource_size,
                                             output_resource_format,
-                                            mailbox));
+                                            mailbox,
+                                            frame_upload_id,
+                                            i));
   }
 
   if (!allocation_success) {
@@ -242,6 +267,18 @@ VideoFrameExternalResources VideoResourceUpdater::CreateForSoftwarePlanes(
     return VideoFrameExternalResources();
   }
 
+  // Planes are only uploaded together, so if any resource doesn't hold its
+  // plane of |video_frame| yet, all of them are written under a new id.
+  if (needs_upload) {
+    last_uploaded_frame_ = video_frame;
+    last_frame_upload_id_++;
+    // Skip 0, which marks resources holding no frame.
+    if (!last_frame_upload_id_)
+      last_frame_upload_id_++;
+    for (size_t i = 0; i < plane_resources.size(); ++i)
+      plane_resources[i].frame_upload_id = last_frame_upload_id_;
+  }
+
   VideoFrameExternalResources external_resources;
 
   if (software_compositor) {
@@ -252,7 +289,7 @@ VideoFrameExternalResources VideoResourceUpdater::CreateForSoftwarePlanes(
     if (!video_renderer_)
       video_renderer_.reset(new media::SkCanvasVideoRenderer);
 
-    {
+    if (needs_upload) {
       ResourceProvider::ScopedWriteLockSoftware lock(
           resource_provider_, plane_resources[0].resource_id);
       video_renderer_->Paint(video_frame.get(),
@@ -265,7 +302,9 @@ VideoFrameExternalResources VideoResourceUpdater::CreateForSoftwarePlanes(
       plane_resources[0].resource_id,
       plane_resources[0].resource_size,
       plane_resources[0].resource_format,
-      gpu::Mailbox()
+      gpu::Mailbox(),
+      plane_resources[0].frame_upload_id,
+      plane_resources[0].plane_index
     };
     external_resources.software_resources.push_back(
         plane_resources[0].resource_id);
@@ -280,24 +319,28 @@ VideoFrameExternalResources VideoResourceUpdater::CreateForSoftwarePlanes(
     // Update each plane's resource id with its content.
     DCHECK_EQ(plane_resources[i].resource_format, kYUVResourceFormat);
 
-    const uint8_t* input_plane_pixels = video_frame->data(i);
-
-    gfx::Rect image_rect(0,
-                         0,
-                         video_frame->stride(i),
-                         plane_resources[i].resource_size.height());
-    gfx::Rect source_rect(plane_resources[i].resource_size);
-    resource_provider_->SetPixels(plane_resources[i].resource_id,
-                                  input_plane_pixels,
-                                  image_rect,
-                                  source_rect,
-                                  gfx::Vector2d());
+    if (needs_upload) {
+      const uint8_t* input_plane_pixels = video_frame->data(i);
+
+      gfx::Rect image_rect(0,
+                           0,
+                           video_frame->stride(i),
+                           plane_resources[i].resource_size.height());
+      gfx::Rect source_rect(plane_resources[i].resource_size);
+      resource_provider_->SetPixels(plane_resources[i].resource_id,
+                                    input_plane_pixels,
+                                    image_rect,
+                                    source_rect,
+                                    gfx::Vector2d());
+    }
 
     RecycleResourceData recycle_data = {
       plane_resources[i].resource_id,
       plane_resources[i].resource_size,
       plane_resources[i].resource_format,
-      plane_resources[i].mailbox
+      plane_resources[i].mailbox,
+      plane_resources[i].frame_upload_id,
+      plane_resources[i].plane_index
     };
 
     external_resources.mailboxes.push_back(
@@ -387,7 +430,9 @@ void VideoResourceUpdater::RecycleResource(
   PlaneResource recycled_resource(data.resource_id,
                                   data.resource_size,
                                   data.resource_format,
-                                  data.mailbox);
+                                  data.mailbox,
+                                  data.frame_upload_id,
+                                  data.plane_index);
   updater->recycled_resources_.push_back(recycled_resource);
 }
 
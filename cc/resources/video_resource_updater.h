@@ -78,15 +78,23 @@ class CC_EXPORT VideoResourceUpdater
     gfx::Size resource_size;
     ResourceFormat resource_format;
     gpu::Mailbox mailbox;
+    // The upload that last wrote the contents of the resource, and the plane
+    // of that frame that it holds.
+    uint32 frame_upload_id;
+    size_t plane_index;
 
     PlaneResource(unsigned resource_id,
                   const gfx::Size& resource_size,
                   ResourceFormat resource_format,
-                  gpu::Mailbox mailbox)
+                  gpu::Mailbox mailbox,
+                  uint32 frame_upload_id,
+                  size_t plane_index)
         : resource_id(resource_id),
           resource_size(resource_size),
           resource_format(resource_format),
-          mailbox(mailbox) {}
+          mailbox(mailbox),
+          frame_upload_id(frame_upload_id),
+          plane_index(plane_index) {}
   };
 
   void DeleteResource(unsigned resource_id);
@@ -101,6 +109,8 @@ class CC_EXPORT VideoResourceUpdater
     gfx::Size resource_size;
     ResourceFormat resource_format;
     gpu::Mailbox mailbox;
+    uint32 frame_upload_id;
+    size_t plane_index;
   };
   static void RecycleResource(base::WeakPtr<VideoResourceUpdater> updater,
                               RecycleResourceData data,
@@ -114,6 +124,13 @@ class CC_EXPORT VideoResourceUpdater
   std::vector<unsigned> all_resources_;
   std::vector<PlaneResource> recycled_resources_;
 
+  // The last software frame whose contents were uploaded.  Resources tagged
+  // with |last_frame_upload_id_| still hold its planes, so drawing it again
+  // doesn't need another upload.  Upload ids are never reused, so holding a
+  // reference to the frame is enough to identify it.
+  scoped_refptr<media::VideoFrame> last_uploaded_frame_;
+  uint32 last_frame_upload_id_;
+
   DISALLOW_COPY_AND_ASSIGN(VideoResourceUpdater);
 };
 
@@ -15,15 +15,37 @@
 namespace cc {
 namespace {
 
+class UploadCountingContext : public TestWebGraphicsContext3D {
+ public:
+  UploadCountingContext() : upload_count_(0) {}
+
+  virtual void texSubImage2D(GLenum target,
+                             GLint level,
+                             GLint xoffset,
+                             GLint yoffset,
+                             GLsizei width,
+                             GLsizei height,
+                             GLenum format,
+                             GLenum type,
+                             const void* pixels) OVERRIDE {
+    ++upload_count_;
+  }
+
+  int upload_count() const { return upload_count_; }
+
+ private:
+  int upload_count_;
+};
+
 class VideoResourceUpdaterTest : public testing::Test {
  protected:
   VideoResourceUpdaterTest() {
-    scoped_ptr<TestWebGraphicsContext3D> context3d =
-        TestWebGraphicsContext3D::Create();
+    scoped_ptr<UploadCountingContext> context3d(new UploadCountingContext);
     context3d_ = context3d.get();
 
     output_surface3d_ =
-        FakeOutputSurface::Create3d(context3d.Pass());
+        FakeOutputSurface::Create3d(
+            context3d.PassAs<TestWebGraphicsContext3D>());
     CHECK(output_surface3d_->BindToClient(&client_));
     resource_provider3d_ =
         ResourceProvider::Create(output_surface3d_.get(), NULL, 0, false, 1);
@@ -51,7 +73,7 @@ class VideoResourceUpdaterTest : public testing::Test {
         base::Closure());         // no_longer_needed_cb
   }
 
-  TestWebGraphicsContext3D* context3d_;
+  UploadCountingContext* context3d_;
   FakeOutputSurfaceClient client_;
   scoped_ptr<FakeOutputSurface> output_surface3d_;
   scoped_ptr<ResourceProvider> resource_provider3d_;
@@ -67,5 +89,35 @@ TEST_F(VideoResourceUpdaterTest, SoftwareFrame) {
   EXPECT_EQ(VideoFrameExternalResources::YUV_RESOURCE, resources.type);
 }
 
+TEST_F(VideoResourceUpdaterTest, SameSoftwareFrameIsNotUploadedTwice) {
+  VideoResourceUpdater updater(output_surface3d_->context_provider().get(),
+                               resource_provider3d_.get());
+  scoped_refptr<media::VideoFrame> video_frame = CreateTestYUVVideoFrame();
+
+  VideoFrameExternalResources resources =
+      updater.CreateExternalResourcesFromVideoFrame(video_frame);
+  EXPECT_EQ(VideoFrameExternalResources::YUV_RESOURCE, resources.type);
+  ASSERT_EQ(3u, resources.release_callbacks.size());
+  EXPECT_EQ(3, context3d_->upload_count());
+  for (size_t i = 0; i < resources.release_callbacks.size(); ++i)
+    resources.release_callbacks[i].Run(0, false);
+
+  // The recycled resources still hold the planes of |video_frame|.
+  resources = updater.CreateExternalResourcesFromVideoFrame(video_frame);
+  EXPECT_EQ(VideoFrameExternalResources::YUV_RESOURCE, resources.type);
+  ASSERT_EQ(3u, resources.release_callbacks.size());
+  EXPECT_EQ(3, context3d_->upload_count());
+  for (size_t i = 0; i < resources.release_callbacks.size(); ++i)
+    resources.release_callbacks[i].Run(0, false);
+
+  // A different frame is uploaded into the same resources.
+  resources = updater.CreateExternalResourcesFromVideoFrame(
+      CreateTestYUVVideoFrame());
+  EXPECT_EQ(VideoFrameExternalResources::YUV_RESOURCE, resources.type);
+  EXPECT_EQ(6, context3d_->upload_count());
+  for (size_t i = 0; i < resources.release_callbacks.size(); ++i)
+    resources.release_callbacks[i].Run(0, false);
+}
+
 }  // namespace
 }  // namespace cc
@@ -236,13 +236,31 @@ void Scheduler::BeginImplFrame(const BeginFrameArgs& args) {
     // so the sychronous renderer compositor can take advantage of splitting
     // up the BeginImplFrame and deadline as well.
     OnBeginImplFrameDeadline();
-  } else if (state_machine_.ShouldTriggerBeginImplFrameDeadlineEarly()) {
+  } else {
+    PostBeginImplFrameDeadline(AdjustedBeginImplFrameDeadline());
+  }
+}
+
+base::TimeTicks Scheduler::AdjustedBeginImplFrameDeadline() const {
+  if (state_machine_.ShouldTriggerBeginImplFrameDeadlineEarly()) {
     // We are ready to draw a new active tree immediately.
-    PostBeginImplFrameDeadline(base::TimeTicks());
+    return base::TimeTicks();
   } else if (state_machine_.needs_redraw()) {
     // We have an animation or fast input path on the impl thread that wants
-    // to draw, so don't wait too long for a new active tree.
-    PostBeginImplFrameDeadline(last_begin_impl_frame_args_.deadline);
+    // to draw, so don't wait too long for a new active tree. There's no point
+    // in waiting at all for the main frame sent by this BeginImplFrame, which
+    // is the one in progress when the main thread is in low latency mode, if
+    // it isn't expected to be activated before the deadline: it will be drawn
+    // by the next frame anyway.
+    if (state_machine_.CommitPending() &&
+        !state_machine_.MainThreadIsInHighLatencyMode() &&
+        !CanCommitAndActivateBeforeDeadline()) {
+      TRACE_EVENT_INSTANT0("cc",
+                           "Scheduler::MainFrameExpectedToMissDeadline",
+                           TRACE_EVENT_SCOPE_THREAD);
+      return base::TimeTicks();
+    }
+    return last_begin_impl_frame_args_.deadline;
   } else {
     // The impl thread doesn't have anything it wants to draw and we are just
     // waiting for a new active tree, so post the deadline for the next
@@ -251,8 +269,8 @@ void Scheduler::BeginImplFrame(const BeginFrameArgs& args) {
     // BeginImplFrame.
     // TODO(brianderson): Handle long deadlines (that are past the next frame's
     // frame time) properly instead of using this hack.
-    PostBeginImplFrameDeadline(last_begin_impl_frame_args_.frame_time +
-                               last_begin_impl_frame_args_.interval);
+    return last_begin_impl_frame_args_.frame_time +
+           last_begin_impl_frame_args_.interval;
   }
 }
 
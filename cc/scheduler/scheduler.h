@@ -123,6 +123,9 @@ class CC_EXPORT Scheduler {
             const SchedulerSettings& scheduler_settings,
             int layer_tree_host_id);
 
+  // Returns when the deadline of the current BeginImplFrame should run, which
+  // is a null time to run it immediately.
+  base::TimeTicks AdjustedBeginImplFrameDeadline() const;
   void PostBeginImplFrameDeadline(base::TimeTicks deadline);
   void SetupNextBeginImplFrameIfNeeded();
   void ActivatePendingTree();
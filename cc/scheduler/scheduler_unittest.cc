@@ -1107,11 +1107,21 @@ class SchedulerClientWithFixedEstimates : public FakeSchedulerClient {
   virtual base::TimeDelta CommitToActivateDurationEstimate() OVERRIDE {
     return commit_to_activate_duration_;
   }
+  virtual void PostBeginImplFrameDeadline(const base::Closure& closure,
+                                          base::TimeTicks deadline) OVERRIDE {
+    FakeSchedulerClient::PostBeginImplFrameDeadline(closure, deadline);
+    last_posted_deadline_ = deadline;
+  }
+
+  base::TimeTicks last_posted_deadline() const {
+    return last_posted_deadline_;
+  }
 
  private:
     base::TimeDelta draw_duration_;
     base::TimeDelta begin_main_frame_to_commit_duration_;
     base::TimeDelta commit_to_activate_duration_;
+    base::TimeTicks last_posted_deadline_;
 };
 
 void MainFrameInHighLatencyMode(int64 begin_main_frame_to_commit_estimate_in_ms,
@@ -1174,6 +1184,43 @@ TEST(SchedulerTest, NotSkipMainFrameIfHighLatencyAndCanActivateTooLong) {
   MainFrameInHighLatencyMode(1, 10, true);
 }
 
+void ImplFrameDeadlineWithMainFrameInFlight(
+    int64 begin_main_frame_to_commit_estimate_in_ms,
+    bool should_post_immediate_deadline) {
+  SchedulerClientWithFixedEstimates client(
+      base::TimeDelta::FromMilliseconds(1),
+      base::TimeDelta::FromMilliseconds(
+          begin_main_frame_to_commit_estimate_in_ms),
+      base::TimeDelta::FromMilliseconds(1));
+  Scheduler* scheduler = client.CreateScheduler(SchedulerSettings());
+  scheduler->SetCanStart();
+  scheduler->SetVisible(true);
+  scheduler->SetCanDraw(true);
+  InitializeOutputSurfaceAndFirstCommit(scheduler);
+
+  // The impl thread wants to draw, and a main frame is sent along with it.
+  client.Reset();
+  scheduler->SetNeedsCommit();
+  scheduler->SetNeedsRedraw();
+  scheduler->BeginImplFrame(BeginFrameArgs::CreateForTesting());
+  EXPECT_TRUE(client.HasAction("ScheduledActionSendBeginMainFrame"));
+  EXPECT_TRUE(client.HasAction("PostBeginImplFrameDeadlineTask"));
+  EXPECT_EQ(should_post_immediate_deadline,
+            client.last_posted_deadline().is_null());
+}
+
+TEST(SchedulerTest, WaitForMainFrameIfItCanBeActivatedBeforeDeadline) {
+  // The commit and activation are expected to finish before the deadline
+  // (~8ms by default), so the draw waits for them.
+  ImplFrameDeadlineWithMainFrameInFlight(1, false);
+}
+
+TEST(SchedulerTest, DrawImmediatelyIfMainFrameWillMissDeadline) {
+  // The commit isn't expected to finish before the deadline, so the impl
+  // thread draws without waiting for it.
+  ImplFrameDeadlineWithMainFrameInFlight(10, true);
+}
+
 void SpinForMillis(int millis) {
   base::RunLoop run_loop;
   base::MessageLoop::current()->PostDelayedTask(
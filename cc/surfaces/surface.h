@@ -29,6 +29,10 @@ class CC_SURFACES_EXPORT Surface {
   // Returns the most recent frame that is eligible to be rendered.
   CompositorFrame* GetEligibleFrame();
 
+  // Incremented for every frame queued, so that the damage of the current
+  // frame can be known to be relative to the previously drawn one.
+  int frame_index() const { return frame_index_; }
+
  private:
   SurfaceManager* manager_;
   SurfaceClient* client_;
@@ -36,6 +40,7 @@ class CC_SURFACES_EXPORT Surface {
   int surface_id_;
   // TODO(jamesr): Support multiple frames in flight.
   scoped_ptr<CompositorFrame> current_frame_;
+  int frame_index_;
 
   DISALLOW_COPY_AND_ASSIGN(Surface);
 };
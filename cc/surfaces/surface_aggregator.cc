@@ -6,6 +6,7 @@
 
 #include "base/containers/hash_tables.h"
 #include "base/logging.h"
+#include "cc/base/math_util.h"
 #include "cc/output/compositor_frame.h"
 #include "cc/output/delegated_frame_data.h"
 #include "cc/quads/draw_quad.h"
@@ -85,6 +86,9 @@ void SurfaceAggregator::HandleSurfaceQuad(const SurfaceDrawQuad* surface_quad,
     return;
   std::set<int>::iterator it = referenced_surfaces_.insert(surface_id).first;
 
+  Surface* surface = manager_->GetSurfaceForID(surface_id);
+  contained_surfaces_[surface_id] = surface->frame_index();
+
   const RenderPassList& referenced_passes = referenced_data->render_pass_list;
   for (size_t j = 0; j + 1 < referenced_passes.size(); ++j) {
     const RenderPass& source = *referenced_passes[j];
@@ -93,9 +97,12 @@ void SurfaceAggregator::HandleSurfaceQuad(const SurfaceDrawQuad* surface_quad,
 
     RenderPass::Id remapped_pass_id = RemapPassId(source.id, surface_id);
 
+    // The damage of the pass is relative to the previous frame of the
+    // surface, which may not be the last one drawn, so the pass is damaged
+    // everywhere.
     copy_pass->SetAll(remapped_pass_id,
                       source.output_rect,
-                      source.damage_rect,
+                      source.output_rect,
                       source.transform_to_root_target,
                       source.has_transparent_background);
 
@@ -127,6 +134,12 @@ void SurfaceAggregator::HandleSurfaceQuad(const SurfaceDrawQuad* surface_quad,
                   dest_pass,
                   surface_id);
 
+  // The quads of the root pass end up in |dest_pass|, so it is damaged where
+  // the surface changed.
+  dest_pass->damage_rect.Union(
+      MathUtil::MapClippedRect(surface_quad->quadTransform(),
+                               DamageRectForSurface(surface, last_pass)));
+
   referenced_surfaces_.erase(it);
 }
 
@@ -191,7 +204,8 @@ void SurfaceAggregator::CopyQuadsToPass(
 }
 
 void SurfaceAggregator::CopyPasses(const RenderPassList& source_pass_list,
-                                   int surface_id) {
+                                   const Surface* surface) {
+  int surface_id = surface->surface_id();
   for (size_t i = 0; i < source_pass_list.size(); ++i) {
     const RenderPass& source = *source_pass_list[i];
 
@@ -199,12 +213,19 @@ void SurfaceAggregator::CopyPasses(const RenderPassList& source_pass_list,
 
     RenderPass::Id remapped_pass_id = RemapPassId(source.id, surface_id);
 
+    // Like the passes of referenced surfaces, the passes other than the root
+    // one are damaged everywhere. The damage of the root pass is relative to
+    // the last aggregated frame rather than to the previous frame of the
+    // surface.
     copy_pass->SetAll(remapped_pass_id,
                       source.output_rect,
-                      source.damage_rect,
+                      source.output_rect,
                       source.transform_to_root_target,
                       source.has_transparent_background);
 
+    if (i + 1 == source_pass_list.size())
+      copy_pass->damage_rect = DamageRectForSurface(surface, source);
+
     CopyQuadsToPass(source.quad_list,
                     source.shared_quad_state_list,
                     gfx::Transform(),
@@ -215,6 +236,21 @@ void SurfaceAggregator::CopyPasses(const RenderPassList& source_pass_list,
   }
 }
 
+gfx::RectF SurfaceAggregator::DamageRectForSurface(
+    const Surface* surface,
+    const RenderPass& source_pass) {
+  SurfaceIndexMap::const_iterator it =
+      previous_contained_surfaces_.find(surface->surface_id());
+  if (it != previous_contained_surfaces_.end()) {
+    int previous_index = it->second;
+    if (previous_index == surface->frame_index())
+      return gfx::RectF();
+    if (previous_index == surface->frame_index() - 1)
+      return source_pass.damage_rect;
+  }
+  return gfx::RectF(source_pass.output_rect);
+}
+
 scoped_ptr<CompositorFrame> SurfaceAggregator::Aggregate(int surface_id) {
   Surface* surface = manager_->GetSurfaceForID(surface_id);
   if (!surface)
@@ -234,11 +270,15 @@ scoped_ptr<CompositorFrame> SurfaceAggregator::Aggregate(int surface_id) {
   std::set<int>::iterator it = referenced_surfaces_.insert(surface_id).first;
 
   dest_pass_list_ = &frame->delegated_frame_data->render_pass_list;
-  CopyPasses(source_pass_list, surface_id);
+  CopyPasses(source_pass_list, surface);
 
   referenced_surfaces_.erase(it);
   DCHECK(referenced_surfaces_.empty());
 
+  contained_surfaces_[surface_id] = surface->frame_index();
+  previous_contained_surfaces_.swap(contained_surfaces_);
+  contained_surfaces_.clear();
+
   dest_pass_list_ = NULL;
 
   // TODO(jamesr): Aggregate all resource references into the returned frame's
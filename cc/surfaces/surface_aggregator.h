@@ -5,6 +5,7 @@
 #ifndef CC_SURFACES_SURFACE_AGGREGATOR_H_
 #define CC_SURFACES_SURFACE_AGGREGATOR_H_
 
+#include <map>
 #include <set>
 
 #include "base/containers/scoped_ptr_hash_map.h"
@@ -16,6 +17,7 @@ namespace cc {
 
 class CompositorFrame;
 class DelegatedFrameData;
+class Surface;
 class SurfaceDrawQuad;
 class SurfaceManager;
 
@@ -41,7 +43,16 @@ class CC_SURFACES_EXPORT SurfaceAggregator {
                        const gfx::Transform& content_to_target_transform,
                        RenderPass* dest_pass,
                        int surface_id);
-  void CopyPasses(const RenderPassList& source_pass_list, int surface_id);
+  void CopyPasses(const RenderPassList& source_pass_list,
+                  const Surface* surface);
+
+  // Returns the damage of the root pass of |surface|, for which |source_pass|
+  // is the root pass of the eligible frame, since the last Aggregate() call.
+  // This is the damage of the frame when it directly follows the one which
+  // was drawn then, and the whole pass when frames were skipped or the
+  // surface wasn't drawn.
+  gfx::RectF DamageRectForSurface(const Surface* surface,
+                                  const RenderPass& source_pass);
 
   SurfaceManager* manager_;
 
@@ -50,6 +61,10 @@ class CC_SURFACES_EXPORT SurfaceAggregator {
       RenderPassIdAllocatorMap;
   RenderPassIdAllocatorMap render_pass_allocator_map_;
 
+  // The frame index of each surface drawn by the last Aggregate() call.
+  typedef std::map<int, int> SurfaceIndexMap;
+  SurfaceIndexMap previous_contained_surfaces_;
+
   // The following state is only valid for the duration of one Aggregate call
   // and is only stored on the class to avoid having to pass through every
   // function call.
@@ -58,6 +73,9 @@ class CC_SURFACES_EXPORT SurfaceAggregator {
   // detect cycles.
   std::set<int> referenced_surfaces_;
 
+  // The frame index of each surface drawn so far.
+  SurfaceIndexMap contained_surfaces_;
+
   // This is the pass list for the aggregated frame.
   RenderPassList* dest_pass_list_;
 
@@ -694,6 +694,91 @@ TEST_F(SurfaceAggregatorValidSurfaceTest, AggregateMultiplePassWithTransform) {
   }
 }
 
+void SubmitChildFrameWithDamage(const gfx::RectF& damage_rect,
+                                Surface* child_surface) {
+  test::Quad child_quads[] = {test::Quad::SolidColorQuad(SK_ColorGREEN)};
+  test::Pass child_passes[] = {
+      test::Pass(child_quads, arraysize(child_quads))};
+
+  RenderPassList child_pass_list;
+  AddPasses(&child_pass_list,
+            gfx::Rect(child_surface->size()),
+            child_passes,
+            arraysize(child_passes));
+  child_pass_list.back()->damage_rect = damage_rect;
+
+  scoped_ptr<DelegatedFrameData> child_frame_data(new DelegatedFrameData);
+  child_pass_list.swap(child_frame_data->render_pass_list);
+
+  scoped_ptr<CompositorFrame> child_frame(new CompositorFrame);
+  child_frame->delegated_frame_data = child_frame_data.Pass();
+
+  child_surface->QueueFrame(child_frame.Pass());
+}
+
+// Tests that the damage of the aggregated root pass is the damage of the
+// surfaces since the last aggregation, in the space of the root pass.
+TEST_F(SurfaceAggregatorValidSurfaceTest, AggregateDamageRect) {
+  gfx::Size surface_size(5, 5);
+
+  Surface child_surface(&manager_, NULL, surface_size);
+  SubmitChildFrameWithDamage(gfx::RectF(surface_size), &child_surface);
+
+  test::Quad root_quads[] = {
+      test::Quad::SolidColorQuad(1),
+      test::Quad::SurfaceQuad(child_surface.surface_id())};
+  test::Pass root_passes[] = {test::Pass(root_quads, arraysize(root_quads))};
+
+  RenderPassList root_pass_list;
+  AddPasses(&root_pass_list,
+            gfx::Rect(surface_size),
+            root_passes,
+            arraysize(root_passes));
+  root_pass_list.at(0)
+      ->shared_quad_state_list[1]
+      ->content_to_target_transform.Translate(2, 3);
+
+  scoped_ptr<DelegatedFrameData> root_frame_data(new DelegatedFrameData);
+  root_pass_list.swap(root_frame_data->render_pass_list);
+
+  scoped_ptr<CompositorFrame> root_frame(new CompositorFrame);
+  root_frame->delegated_frame_data = root_frame_data.Pass();
+
+  root_surface_.QueueFrame(root_frame.Pass());
+
+  // Everything is damaged the first time the surfaces are drawn.
+  scoped_ptr<CompositorFrame> aggregated_frame =
+      aggregator_.Aggregate(root_surface_.surface_id());
+  ASSERT_TRUE(aggregated_frame);
+  EXPECT_EQ(gfx::RectF(0, 0, 7, 8).ToString(),
+            aggregated_frame->delegated_frame_data->render_pass_list.back()
+                ->damage_rect.ToString());
+
+  // Nothing is damaged when none of the surfaces has a new frame.
+  aggregated_frame = aggregator_.Aggregate(root_surface_.surface_id());
+  ASSERT_TRUE(aggregated_frame);
+  EXPECT_TRUE(aggregated_frame->delegated_frame_data->render_pass_list.back()
+                  ->damage_rect.IsEmpty());
+
+  // The damage of the next frame of the child surface is mapped to the root
+  // pass.
+  SubmitChildFrameWithDamage(gfx::RectF(1, 1, 1, 1), &child_surface);
+  aggregated_frame = aggregator_.Aggregate(root_surface_.surface_id());
+  ASSERT_TRUE(aggregated_frame);
+  EXPECT_EQ(gfx::RectF(3, 4, 1, 1).ToString(),
+            aggregated_frame->delegated_frame_data->render_pass_list.back()
+                ->damage_rect.ToString());
+
+  // The damage of frames that weren't drawn is unknown, so skipping one
+  // damages the whole surface.
+  SubmitChildFrameWithDamage(gfx::RectF(1, 1, 1, 1), &child_surface);
+  SubmitChildFrameWithDamage(gfx::RectF(1, 1, 1, 1), &child_surface);
+  aggregated_frame = aggregator_.Aggregate(root_surface_.surface_id());
+  ASSERT_TRUE(aggregated_frame);
+  EXPECT_EQ(gfx::RectF(2, 3, 5, 5).ToString(),
+            aggregated_frame->delegated_frame_data->render_pass_list.back()
+                ->damage_rect.ToString());
+}
+
 }  // namespace
 }  // namespace cc
-
@@ -77,7 +77,8 @@ FakeTileManager::FakeTileManager(TileManagerClient* client)
                   make_scoped_ptr<RasterWorkerPool>(new FakeRasterWorkerPool),
                   std::numeric_limits<unsigned>::max(),
                   NULL,
-                  true) {}
+                  true,
+                  false) {}
 
 FakeTileManager::FakeTileManager(TileManagerClient* client,
                                  ResourceProvider* resource_provider)
@@ -88,7 +89,8 @@ FakeTileManager::FakeTileManager(TileManagerClient* client,
                   make_scoped_ptr<RasterWorkerPool>(new FakeRasterWorkerPool),
                   std::numeric_limits<unsigned>::max(),
                   NULL,
-                  true) {}
+                  true,
+                  false) {}
 
 FakeTileManager::FakeTileManager(TileManagerClient* client,
                                  ResourceProvider* resource_provider,
@@ -100,7 +102,8 @@ FakeTileManager::FakeTileManager(TileManagerClient* client,
                   make_scoped_ptr<RasterWorkerPool>(new FakeRasterWorkerPool),
                   std::numeric_limits<unsigned>::max(),
                   NULL,
-                  allow_on_demand_raster) {}
+                  allow_on_demand_raster,
+                  false) {}
 
 FakeTileManager::FakeTileManager(TileManagerClient* client,
                                  ResourceProvider* resource_provider,
@@ -112,7 +115,8 @@ FakeTileManager::FakeTileManager(TileManagerClient* client,
                   make_scoped_ptr<RasterWorkerPool>(new FakeRasterWorkerPool),
                   raster_task_limit_bytes,
                   NULL,
-                  true) {}
+                  true,
+                  false) {}
 
 FakeTileManager::~FakeTileManager() {}
 
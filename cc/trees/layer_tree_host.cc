@@ -1207,15 +1207,9 @@ void LayerTreeHost::AnimateLayers(base::TimeTicks time) {
 
   double monotonic_time = (time - base::TimeTicks()).InSecondsF();
 
-  AnimationRegistrar::AnimationControllerMap copy =
-      animation_registrar_->active_animation_controllers();
-  for (AnimationRegistrar::AnimationControllerMap::iterator iter = copy.begin();
-       iter != copy.end();
-       ++iter) {
-    (*iter).second->Animate(monotonic_time);
-    bool start_ready_animations = true;
-    (*iter).second->UpdateState(start_ready_animations, NULL);
-  }
+  animation_registrar_->AnimateControllers(monotonic_time);
+  bool start_ready_animations = true;
+  animation_registrar_->UpdateControllersState(start_ready_animations, NULL);
 }
 
 UIResourceId LayerTreeHost::CreateUIResource(UIResourceClient* client) {
@@ -1053,12 +1053,36 @@ struct PreCalculateMetaInformationRecursiveData {
   }
 };
 
+// Layers are only told about changes to the structure of their subtree on the
+// impl thread, where the tree usually stays the same for many frames.
+static inline bool SubtreeStructureChanged(Layer* layer) { return true; }
+
+static inline bool SubtreeStructureChanged(LayerImpl* layer) {
+  return layer->subtree_structure_changed();
+}
+
+static inline void ClearSubtreeStructureChanged(Layer* layer) {}
+
+static inline void ClearSubtreeStructureChanged(LayerImpl* layer) {
+  layer->ClearSubtreeStructureChanged();
+}
+
 // Recursively walks the layer tree to compute any information that is needed
 // before doing the main recursion.
 template <typename LayerType>
 static void PreCalculateMetaInformation(
     LayerType* layer,
     PreCalculateMetaInformationRecursiveData* recursive_data) {
+  // The information computed last time is still valid for subtrees whose
+  // structure didn't change, so there is no need to walk them again.
+  if (!SubtreeStructureChanged(layer)) {
+    recursive_data->num_unclipped_descendants =
+        layer->draw_properties().num_unclipped_descendants;
+    recursive_data->layer_or_descendant_has_copy_request =
+        layer->draw_properties().layer_or_descendant_has_copy_request;
+    return;
+  }
+
   bool has_delegated_content = layer->HasDelegatedContent();
   int num_descendants_that_draw_content = 0;
 
@@ -1070,7 +1094,6 @@ static void PreCalculateMetaInformation(
     num_descendants_that_draw_content = 1000;
   }
 
-  layer->draw_properties().sorted_for_recursion = false;
   layer->draw_properties().has_child_with_a_scroll_parent = false;
 
   if (layer->clip_parent())
@@ -1107,6 +1130,7 @@ static void PreCalculateMetaInformation(
       recursive_data->num_unclipped_descendants;
   layer->draw_properties().layer_or_descendant_has_copy_request =
       recursive_data->layer_or_descendant_has_copy_request;
+  ClearSubtreeStructureChanged(layer);
 }
 
 static void RoundTranslationComponents(gfx::Transform* transform) {
@@ -1235,6 +1259,11 @@ static bool SortChildrenForRecursion(std::vector<LayerType*>* out,
     AddScrollParentChain(out, parent, current);
   }
 
+  // Reset the flags for the next sort here rather than in
+  // PreCalculateMetaInformation, which doesn't visit every layer.
+  for (size_t i = 0; i < out->size(); ++i)
+    (*out)[i]->draw_properties().sorted_for_recursion = false;
+
   DCHECK_EQ(parent.children().size(), out->size());
   return order_changed;
 }
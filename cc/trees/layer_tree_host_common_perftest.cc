@@ -13,6 +13,7 @@
 #include "base/threading/thread.h"
 #include "base/time/time.h"
 #include "cc/layers/layer.h"
+#include "cc/layers/layer_impl.h"
 #include "cc/test/fake_content_layer_client.h"
 #include "cc/test/fake_layer_tree_host_client.h"
 #include "cc/test/lap_timer.h"
@@ -122,6 +123,8 @@ class CalcDrawPropsImplTest : public LayerTreeHostCommonPerfTest {
     LayerTreeImpl* active_tree = host_impl->active_tree();
 
     do {
+      ChangeTreeForLap(active_tree, timer_.NumLaps());
+
       bool can_render_to_separate_surface = true;
       int max_texture_size = 8096;
       LayerImplList update_list;
@@ -144,6 +147,41 @@ class CalcDrawPropsImplTest : public LayerTreeHostCommonPerfTest {
 
     EndTest();
   }
+
+ protected:
+  // Called before computing the draw properties for each lap.
+  virtual void ChangeTreeForLap(LayerTreeImpl* active_tree, int lap) {}
+};
+
+// Measures the frames where only a part of the tree changed, like when a
+// single layer has a transform animation.
+class CalcDrawPropsImplPartialChangeTest : public CalcDrawPropsImplTest {
+ public:
+  CalcDrawPropsImplPartialChangeTest() : change_deepest_layer_(true) {}
+
+  // Changes the transform of the deepest layer if |deepest|, or else of the
+  // first child of the root, which moves most of the tree.
+  void set_change_deepest_layer(bool deepest) {
+    change_deepest_layer_ = deepest;
+  }
+
+ protected:
+  virtual void ChangeTreeForLap(LayerTreeImpl* active_tree, int lap) OVERRIDE {
+    LayerImpl* layer = active_tree->root_layer();
+    if (change_deepest_layer_) {
+      while (!layer->children().empty())
+        layer = layer->children().back();
+    } else if (!layer->children().empty()) {
+      layer = layer->children()[0];
+    }
+
+    gfx::Transform transform;
+    transform.Translate(lap % 10, 0);
+    layer->SetTransform(transform);
+  }
+
+ private:
+  bool change_deepest_layer_;
 };
 
 TEST_F(CalcDrawPropsMainTest, TenTen) {
@@ -194,5 +232,26 @@ TEST_F(CalcDrawPropsImplTest, TouchRegionHeavy) {
   RunCalcDrawProps();
 }
 
+TEST_F(CalcDrawPropsImplPartialChangeTest, HeavyPageDeepLayerChange) {
+  SetTestName("heavy_page_deep_layer_change");
+  ReadTestFile("heavy_layer_tree");
+  set_change_deepest_layer(true);
+  RunCalcDrawProps();
+}
+
+TEST_F(CalcDrawPropsImplPartialChangeTest, HeavyPageRootChildChange) {
+  SetTestName("heavy_page_root_child_change");
+  ReadTestFile("heavy_layer_tree");
+  set_change_deepest_layer(false);
+  RunCalcDrawProps();
+}
+
+TEST_F(CalcDrawPropsImplPartialChangeTest, TouchRegionHeavyDeepLayerChange) {
+  SetTestName("touch_region_heavy_deep_layer_change");
+  ReadTestFile("touch_region_heavy");
+  set_change_deepest_layer(true);
+  RunCalcDrawProps();
+}
+
 }  // namespace
 }  // namespace cc
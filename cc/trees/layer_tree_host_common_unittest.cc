@@ -9607,5 +9607,71 @@ TEST_F(LayerTreeHostCommonTest, ScrollCompensationWithRounding) {
   }
 }
 
+TEST_F(LayerTreeHostCommonTest, SubtreeStructureChangesAreNoticed) {
+  FakeImplProxy proxy;
+  FakeLayerTreeHostImpl host_impl(&proxy);
+  host_impl.CreatePendingTree();
+  const gfx::Transform identity_matrix;
+
+  scoped_ptr<LayerImpl> root = LayerImpl::Create(host_impl.pending_tree(), 1);
+  SetLayerPropertiesForTesting(root.get(),
+                               identity_matrix,
+                               gfx::PointF(),
+                               gfx::PointF(),
+                               gfx::Size(50, 50),
+                               true,
+                               false);
+  root->SetDrawsContent(true);
+
+  scoped_ptr<LayerImpl> parent = LayerImpl::Create(host_impl.pending_tree(), 2);
+  SetLayerPropertiesForTesting(parent.get(),
+                               identity_matrix,
+                               gfx::PointF(),
+                               gfx::PointF(),
+                               gfx::Size(40, 40),
+                               true,
+                               false);
+  parent->SetDrawsContent(true);
+  parent->SetOpacity(0.5f);
+
+  scoped_ptr<LayerImpl> child = LayerImpl::Create(host_impl.pending_tree(), 3);
+  SetLayerPropertiesForTesting(child.get(),
+                               identity_matrix,
+                               gfx::PointF(),
+                               gfx::PointF(),
+                               gfx::Size(30, 30),
+                               true,
+                               false);
+
+  LayerImpl* parent_layer = parent.get();
+  LayerImpl* child_layer = child.get();
+  parent->AddChild(child.Pass());
+  root->AddChild(parent.Pass());
+
+  ExecuteCalculateDrawProperties(root.get());
+
+  // Only the parent draws content in its subtree, so it doesn't need a
+  // surface for its opacity.
+  EXPECT_FALSE(root->subtree_structure_changed());
+  EXPECT_FALSE(child_layer->subtree_structure_changed());
+  EXPECT_FALSE(parent_layer->render_surface());
+
+  child_layer->SetDrawsContent(true);
+  EXPECT_TRUE(root->subtree_structure_changed());
+  EXPECT_TRUE(parent_layer->subtree_structure_changed());
+  EXPECT_TRUE(child_layer->subtree_structure_changed());
+
+  ExecuteCalculateDrawProperties(root.get());
+  EXPECT_FALSE(root->subtree_structure_changed());
+  EXPECT_TRUE(parent_layer->render_surface());
+
+  scoped_ptr<LayerImpl> removed_child = parent_layer->RemoveChild(child_layer);
+  EXPECT_TRUE(root->subtree_structure_changed());
+  EXPECT_FALSE(removed_child->subtree_structure_changed());
+
+  ExecuteCalculateDrawProperties(root.get());
+  EXPECT_FALSE(parent_layer->render_surface());
+}
+
 }  // namespace
 }  // namespace cc
@@ -252,6 +252,7 @@ LayerTreeHostImpl::LayerTreeHostImpl(
       overdraw_bottom_height_(0.f),
       device_viewport_valid_for_tile_management_(true),
       external_stencil_test_enabled_(false),
+      damage_all_render_surfaces_(false),
       animation_registrar_(AnimationRegistrar::Create()),
       rendering_stats_instrumentation_(rendering_stats_instrumentation),
       micro_benchmark_controller_(this),
@@ -513,6 +514,10 @@ void LayerTreeHostImpl::TrackDamageForAllSurfaces(
     LayerImpl* render_surface_layer = render_surface_layer_list[surface_index];
     RenderSurfaceImpl* render_surface = render_surface_layer->render_surface();
     DCHECK(render_surface);
+    if (damage_all_render_surfaces_) {
+      render_surface->damage_tracker()->AddDamageNextUpdate(
+          render_surface->content_rect());
+    }
     render_surface->damage_tracker()->UpdateDamageTrackingState(
         render_surface->layer_list(),
         render_surface_layer->id(),
@@ -521,6 +526,7 @@ void LayerTreeHostImpl::TrackDamageForAllSurfaces(
         render_surface_layer->mask_layer(),
         render_surface_layer->filters());
   }
+  damage_all_render_surfaces_ = false;
 }
 
 scoped_ptr<base::Value> LayerTreeHostImpl::FrameData::AsValue() const {
@@ -1419,6 +1425,8 @@ void LayerTreeHostImpl::DrawLayers(FrameData* frame,
                          DeviceClip(),
                          allow_partial_swap,
                          false);
+    rendering_stats_instrumentation_->AddDrawCalls(
+        renderer_->DrawCallsForLastFrame());
   }
   // The render passes should be consumed by the renderer.
   DCHECK(frame->render_passes.empty());
@@ -1756,7 +1764,8 @@ void LayerTreeHostImpl::CreateAndSetTileManager(
                           allow_rasterize_on_demand,
                           GetMaxTransferBufferUsageBytes(context_provider),
                           GetMaxRasterTasksUsageBytes(context_provider),
-                          GetMapImageTextureTarget(context_provider));
+                          GetMapImageTextureTarget(context_provider),
+                          settings_.use_compressed_prepaint_tiles);
 
   UpdateTileManagerMemoryPolicy(ActualManagedMemoryPolicy());
   need_to_update_visible_tiles_before_draw_ = false;
@@ -2588,6 +2597,7 @@ scoped_ptr<ScrollAndScaleSet> LayerTreeHostImpl::ProcessScrollDeltas() {
 
 void LayerTreeHostImpl::SetFullRootLayerDamage() {
   SetViewportDamage(gfx::Rect(DrawViewportSize()));
+  damage_all_render_surfaces_ = true;
 }
 
 void LayerTreeHostImpl::ScrollViewportBy(gfx::Vector2dF scroll_delta) {
@@ -2656,12 +2666,7 @@ void LayerTreeHostImpl::AnimateLayers(base::TimeTicks monotonic_time,
   last_animation_time_ = wall_clock_time;
   double monotonic_seconds = (monotonic_time - base::TimeTicks()).InSecondsF();
 
-  AnimationRegistrar::AnimationControllerMap copy =
-      animation_registrar_->active_animation_controllers();
-  for (AnimationRegistrar::AnimationControllerMap::iterator iter = copy.begin();
-       iter != copy.end();
-       ++iter)
-    (*iter).second->Animate(monotonic_seconds);
+  animation_registrar_->AnimateControllers(monotonic_seconds);
 
   SetNeedsRedraw();
 }
@@ -2675,12 +2680,8 @@ void LayerTreeHostImpl::UpdateAnimationState(bool start_ready_animations) {
   TRACE_EVENT0("cc", "LayerTreeHostImpl::UpdateAnimationState");
   scoped_ptr<AnimationEventsVector> events =
       make_scoped_ptr(new AnimationEventsVector);
-  AnimationRegistrar::AnimationControllerMap copy =
-      animation_registrar_->active_animation_controllers();
-  for (AnimationRegistrar::AnimationControllerMap::iterator iter = copy.begin();
-       iter != copy.end();
-       ++iter)
-    (*iter).second->UpdateState(start_ready_animations, events.get());
+  animation_registrar_->UpdateControllersState(start_ready_animations,
+                                               events.get());
 
   if (!events->empty()) {
     client_->PostAnimationEventsToMainThreadOnImplThread(events.Pass(),
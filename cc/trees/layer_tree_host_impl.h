@@ -636,6 +636,10 @@ class CC_EXPORT LayerTreeHostImpl
   bool external_stencil_test_enabled_;
 
   gfx::Rect viewport_damage_rect_;
+  // Set when the contents of all the surfaces may have changed without their
+  // layers being damaged, like when tiles are initialized, so that render
+  // passes whose contents are cached are drawn again.
+  bool damage_all_render_surfaces_;
 
   base::TimeTicks current_frame_timeticks_;
   base::Time current_frame_time_;
@@ -4,18 +4,23 @@
 
 #include "cc/trees/layer_tree_host.h"
 
+#include <algorithm>
 #include <sstream>
+#include <vector>
 
 #include "base/file_util.h"
 #include "base/files/file_path.h"
 #include "base/path_service.h"
 #include "base/strings/string_piece.h"
 #include "base/time/time.h"
+#include "cc/debug/rendering_stats_instrumentation.h"
 #include "cc/layers/content_layer.h"
 #include "cc/layers/nine_patch_layer.h"
+#include "cc/layers/picture_layer.h"
 #include "cc/layers/solid_color_layer.h"
 #include "cc/layers/texture_layer.h"
 #include "cc/resources/texture_mailbox.h"
+#include "cc/resources/tile_manager.h"
 #include "cc/test/fake_content_layer_client.h"
 #include "cc/test/lap_timer.h"
 #include "cc/test/layer_tree_json_parser.h"
@@ -31,6 +36,27 @@ static const int kTimeLimitMillis = 2000;
 static const int kWarmupRuns = 5;
 static const int kTimeCheckInterval = 10;
 
+// Prints the 50th, 90th and 99th percentiles of |samples| in microseconds.
+void PrintPercentiles(const std::string& measurement,
+                      const std::string& trace,
+                      std::vector<base::TimeDelta>* samples) {
+  if (samples->empty())
+    return;
+  std::sort(samples->begin(), samples->end());
+  const int percentiles[] = {50, 90, 99};
+  for (size_t i = 0; i < arraysize(percentiles); ++i) {
+    size_t index = (samples->size() - 1) * percentiles[i] / 100;
+    std::ostringstream modifier;
+    modifier << "_" << percentiles[i] << "th_percentile";
+    perf_test::PrintResult(measurement,
+                           modifier.str(),
+                           trace,
+                           1000 * (*samples)[index].InMillisecondsF(),
+                           "us",
+                           true);
+  }
+}
+
 class LayerTreeHostPerfTest : public LayerTreeTest {
  public:
   LayerTreeHostPerfTest()
@@ -40,7 +66,8 @@ class LayerTreeHostPerfTest : public LayerTreeTest {
         commit_timer_(0, base::TimeDelta(), 1),
         full_damage_each_frame_(false),
         animation_driven_drawing_(false),
-        measure_commit_cost_(false) {
+        measure_commit_cost_(false),
+        max_memory_used_bytes_(0) {
     fake_content_layer_client_.set_paint_all_opaque(true);
   }
 
@@ -69,9 +96,19 @@ class LayerTreeHostPerfTest : public LayerTreeTest {
     }
   }
 
+  virtual DrawSwapReadbackResult::DrawResult PrepareToDrawOnThread(
+      LayerTreeHostImpl* host_impl,
+      LayerTreeHostImpl::FrameData* frame_data,
+      DrawSwapReadbackResult::DrawResult draw_result) OVERRIDE {
+    prepare_to_draw_time_ = base::TimeTicks::HighResNow();
+    return draw_result;
+  }
+
   virtual void DrawLayersOnThread(LayerTreeHostImpl* impl) OVERRIDE {
     if (TestEnded() || CleanUpStarted())
       return;
+    if (draw_timer_.IsWarmedUp())
+      RecordFrameStats(impl);
     draw_timer_.NextLap();
     if (draw_timer_.HasTimeLimitExpired()) {
       CleanUpAndEndTest(impl);
@@ -97,9 +134,41 @@ class LayerTreeHostPerfTest : public LayerTreeTest {
       perf_test::PrintResult("layer_tree_host_commit_time", "", test_name_,
                              1000 * commit_timer_.MsPerLap(), "us", true);
     }
+    perf_test::PrintResult("layer_tree_host_frames_per_second", "",
+                           test_name_, draw_timer_.LapsPerSecond(), "fps",
+                           true);
+    PrintPercentiles("layer_tree_host_frame_time", test_name_, &frame_times_);
+    PrintPercentiles("layer_tree_host_draw_time", test_name_, &draw_times_);
+    perf_test::PrintResult("layer_tree_host_memory_used", "", test_name_,
+                           max_memory_used_bytes_ / 1024, "kb", false);
   }
 
  protected:
+  // Records how long the frame took since the previous one, how long drawing
+  // it took after it was prepared, and how much memory the tiles use.
+  void RecordFrameStats(LayerTreeHostImpl* impl) {
+    base::TimeTicks now = base::TimeTicks::HighResNow();
+    if (!last_draw_time_.is_null())
+      frame_times_.push_back(now - last_draw_time_);
+    last_draw_time_ = now;
+    if (!prepare_to_draw_time_.is_null())
+      draw_times_.push_back(now - prepare_to_draw_time_);
+
+    if (!impl->tile_manager())
+      return;
+    size_t memory_required_bytes;
+    size_t memory_nice_to_have_bytes;
+    size_t memory_allocated_bytes;
+    size_t memory_used_bytes;
+    impl->tile_manager()->GetMemoryStats(&memory_required_bytes,
+                                         &memory_nice_to_have_bytes,
+                                         &memory_allocated_bytes,
+                                         &memory_used_bytes);
+    max_memory_used_bytes_ =
+        std::max(max_memory_used_bytes_, memory_used_bytes);
+  }
+
+
   LapTimer draw_timer_;
   LapTimer commit_timer_;
 
@@ -109,6 +178,13 @@ class LayerTreeHostPerfTest : public LayerTreeTest {
   bool animation_driven_drawing_;
 
   bool measure_commit_cost_;
+
+ private:
+  base::TimeTicks prepare_to_draw_time_;
+  base::TimeTicks last_draw_time_;
+  std::vector<base::TimeDelta> frame_times_;
+  std::vector<base::TimeDelta> draw_times_;
+  size_t max_memory_used_bytes_;
 };
 
 
@@ -328,5 +404,134 @@ TEST_F(LayerTreeHostPerfTestJsonReader, HeavyPageThreadedImplSide) {
   RunTestWithImplSidePainting();
 }
 
+// Moves every layer of a tree with 5000 layers on each frame, which keep their
+// contents and input regions.
+class LayerTreeHostPerfTestManyLayers : public LayerTreeHostPerfTest {
+ public:
+  LayerTreeHostPerfTestManyLayers() : offset_(0) {}
+
+  void SetTestName(const std::string& name) {
+    test_name_ = name;
+  }
+
+  virtual void BuildTree() OVERRIDE {
+    static const int kNumContainers = 50;
+    static const int kNumLayersPerContainer = 99;
+
+    gfx::Size viewport = gfx::Size(720, 1038);
+    layer_tree_host()->SetViewportSize(viewport);
+    scoped_refptr<Layer> root = Layer::Create();
+    root->SetBounds(viewport);
+
+    Region touch_region;
+    for (int i = 0; i < 4; ++i)
+      touch_region.Union(gfx::Rect(i * 5, i * 5, 2, 2));
+
+    for (int i = 0; i < kNumContainers; ++i) {
+      scoped_refptr<Layer> container = Layer::Create();
+      container->SetBounds(viewport);
+      container->SetNonFastScrollableRegion(touch_region);
+      root->AddChild(container);
+      for (int j = 0; j < kNumLayersPerContainer; ++j) {
+        scoped_refptr<PictureLayer> layer =
+            PictureLayer::Create(&fake_content_layer_client_);
+        layer->SetBounds(gfx::Size(20, 20));
+        layer->SetIsDrawable(true);
+        layer->SetTouchEventHandlerRegion(touch_region);
+        container->AddChild(layer);
+        layers_.push_back(layer.get());
+      }
+    }
+    layer_tree_host()->SetRootLayer(root);
+  }
+
+  virtual void Layout() OVERRIDE {
+    offset_ = (offset_ + 1) % 100;
+    for (size_t i = 0; i < layers_.size(); ++i) {
+      layers_[i]->SetPosition(
+          gfx::PointF((i % 30) * 24.f, (i / 30 % 40) * 24.f + offset_));
+    }
+  }
+
+ private:
+  std::vector<Layer*> layers_;
+  int offset_;
+};
+
+TEST_F(LayerTreeHostPerfTestManyLayers, MoveAllLayersThreadedImplSide) {
+  measure_commit_cost_ = true;
+  SetTestName("5000_layers_move_all_threaded_impl_side");
+  RunTestWithImplSidePainting();
+}
+
+// Covers a 2560x1600 viewport with solid color layers, and reports the number
+// of draw calls used for each frame.
+class SolidColorLayersPerfTest : public LayerTreeHostPerfTest {
+ public:
+  SolidColorLayersPerfTest() : draw_calls_per_frame_(0.0) {}
+
+  void SetTestName(const std::string& name) {
+    test_name_ = name;
+  }
+
+  virtual void InitializeSettings(LayerTreeSettings* settings) OVERRIDE {
+    LayerTreeHostPerfTest::InitializeSettings(settings);
+    settings->initial_debug_state.SetRecordRenderingStats(true);
+  }
+
+  virtual void BuildTree() OVERRIDE {
+    static const int kLayerSize = 64;
+
+    gfx::Size viewport = gfx::Size(2560, 1600);
+    layer_tree_host()->SetViewportSize(viewport);
+    scoped_refptr<Layer> root = Layer::Create();
+    root->SetBounds(viewport);
+    for (int y = 0; y < viewport.height(); y += kLayerSize) {
+      for (int x = 0; x < viewport.width(); x += kLayerSize) {
+        scoped_refptr<SolidColorLayer> layer = SolidColorLayer::Create();
+        layer->SetPosition(gfx::PointF(x, y));
+        layer->SetBounds(gfx::Size(kLayerSize, kLayerSize));
+        layer->SetIsDrawable(true);
+        layer->SetBackgroundColor(SkColorSetRGB(x % 256, y % 256, 128));
+        root->AddChild(layer);
+      }
+    }
+    layer_tree_host()->SetRootLayer(root);
+  }
+
+  virtual void CleanUpAndEndTest(LayerTreeHostImpl* host_impl) OVERRIDE {
+    RenderingStats stats = layer_tree_host()
+                               ->rendering_stats_instrumentation()
+                               ->GetRenderingStats();
+    if (stats.impl_stats.frame_count) {
+      draw_calls_per_frame_ =
+          static_cast<double>(stats.impl_stats.draw_call_count) /
+          stats.impl_stats.frame_count;
+    }
+    EndTest();
+  }
+
+  virtual void AfterTest() OVERRIDE {
+    LayerTreeHostPerfTest::AfterTest();
+    perf_test::PrintResult("layer_tree_host_draw_calls", "", test_name_,
+                           draw_calls_per_frame_, "draw_calls/frame", true);
+  }
+
+ private:
+  double draw_calls_per_frame_;
+};
+
+TEST_F(SolidColorLayersPerfTest, FullDamageEachFrameSingleThread) {
+  full_damage_each_frame_ = true;
+  SetTestName("2560x1600_solid_color_layers_single_thread");
+  RunTest(false, false, false);
+}
+
+TEST_F(SolidColorLayersPerfTest, FullDamageEachFrameThreadedImplSide) {
+  full_damage_each_frame_ = true;
+  SetTestName("2560x1600_solid_color_layers_threaded_impl_side");
+  RunTestWithImplSidePainting();
+}
+
 }  // namespace
 }  // namespace cc
@@ -16,6 +16,7 @@
 #include "cc/layers/layer_impl.h"
 #include "cc/output/renderer.h"
 #include "cc/resources/ui_resource_client.h"
+#include "cc/trees/property_tree.h"
 
 #if defined(COMPILER_GCC)
 namespace BASE_HASH_NAMESPACE {
@@ -104,6 +105,10 @@ class CC_EXPORT LayerTreeImpl {
   void SetRootLayer(scoped_ptr<LayerImpl>);
   scoped_ptr<LayerImpl> DetachLayerTree();
 
+  // The transform, clip and effect trees of the layers, which are built by
+  // PropertyTreeBuilder.
+  PropertyTrees* property_trees() { return &property_trees_; }
+
   void PushPropertiesTo(LayerTreeImpl* tree_impl);
 
   int source_frame_number() const { return source_frame_number_; }
@@ -276,6 +281,8 @@ class CC_EXPORT LayerTreeImpl {
 
   std::vector<LayerImpl*> layers_with_copy_output_request_;
 
+  PropertyTrees property_trees_;
+
   // Persisted state for non-impl-side-painting.
   int scrolling_layer_id_from_previous_tree_;
 
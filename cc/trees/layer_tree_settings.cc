@@ -17,6 +17,7 @@ LayerTreeSettings::LayerTreeSettings()
       allow_antialiasing(true),
       throttle_frame_production(true),
       begin_impl_frame_scheduling_enabled(false),
+      switch_to_low_latency_if_possible(false),
       using_synchronous_renderer_compositor(false),
       per_tile_painting_enabled(false),
       partial_swap_enabled(false),
@@ -58,6 +59,9 @@ LayerTreeSettings::LayerTreeSettings()
       use_map_image(false),
       ignore_root_layer_flings(false),
       use_rgba_4444_textures(false),
+      use_compressed_prepaint_tiles(false),
+      use_occlusion_for_tile_prioritization(false),
+      cache_render_pass_contents(false),
       touch_hit_testing(true),
       texture_id_allocation_chunk_size(64) {}
 
@@ -22,6 +22,9 @@ class CC_EXPORT LayerTreeSettings {
   bool allow_antialiasing;
   bool throttle_frame_production;
   bool begin_impl_frame_scheduling_enabled;
+  // Whether the scheduler skips a BeginMainFrame to get the main thread out
+  // of high latency mode when it is expected to catch up within a frame.
+  bool switch_to_low_latency_if_possible;
   bool using_synchronous_renderer_compositor;
   bool per_tile_painting_enabled;
   bool partial_swap_enabled;
@@ -68,6 +71,9 @@ class CC_EXPORT LayerTreeSettings {
   bool use_map_image;
   bool ignore_root_layer_flings;
   bool use_rgba_4444_textures;
+  bool use_compressed_prepaint_tiles;
+  bool use_occlusion_for_tile_prioritization;
+  bool cache_render_pass_contents;
   bool touch_hit_testing;
   size_t texture_id_allocation_chunk_size;
 
@@ -0,0 +1,144 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/trees/property_tree.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "cc/base/math_util.h"
+
+namespace cc {
+
+template <typename T>
+PropertyTree<T>::PropertyTree()
+    : needs_update_(false) {}
+
+template <typename T>
+PropertyTree<T>::~PropertyTree() {}
+
+template <typename T>
+int PropertyTree<T>::Insert(const T& data, int parent_id) {
+  int id = static_cast<int>(nodes_.size());
+  DCHECK_GE(parent_id, -1);
+  DCHECK_LT(parent_id, id);
+  DCHECK(parent_id != -1 || nodes_.empty());
+
+  nodes_.push_back(TreeNode<T>());
+  TreeNode<T>& node = nodes_.back();
+  node.id = id;
+  node.parent_id = parent_id;
+  node.data = data;
+  node_needs_update_.push_back(true);
+  needs_update_ = true;
+  return id;
+}
+
+template <typename T>
+void PropertyTree<T>::SetNeedsUpdate(int id) {
+  DCHECK_LT(static_cast<size_t>(id), nodes_.size());
+  node_needs_update_[id] = true;
+  needs_update_ = true;
+}
+
+template <typename T>
+void PropertyTree<T>::clear() {
+  nodes_.clear();
+  node_needs_update_.clear();
+  needs_update_ = false;
+}
+
+template <typename T>
+void PropertyTree<T>::TakeNodesNeedingUpdate(std::vector<int>* ids) {
+  if (!needs_update_)
+    return;
+
+  // Since parents come first, their flags are final when their children are
+  // visited.
+  for (size_t id = 0; id < nodes_.size(); ++id) {
+    int parent_id = nodes_[id].parent_id;
+    if (parent_id != -1 && node_needs_update_[parent_id])
+      node_needs_update_[id] = true;
+    if (node_needs_update_[id])
+      ids->push_back(static_cast<int>(id));
+  }
+  std::fill(node_needs_update_.begin(), node_needs_update_.end(), false);
+  needs_update_ = false;
+}
+
+template class PropertyTree<TransformNodeData>;
+template class PropertyTree<ClipNodeData>;
+template class PropertyTree<EffectNodeData>;
+
+TransformNodeData::TransformNodeData()
+    : owner_id(-1),
+      flattens(false),
+      is_animated(false),
+      to_screen_is_animated(false) {}
+
+TransformNodeData::~TransformNodeData() {}
+
+void TransformTree::UpdateTransforms() {
+  std::vector<int> ids;
+  TakeNodesNeedingUpdate(&ids);
+
+  for (size_t i = 0; i < ids.size(); ++i) {
+    TransformNodeData* node = Node(ids[i]);
+    int parent = parent_id(ids[i]);
+    if (parent == -1) {
+      node->to_screen = node->to_parent;
+      node->to_screen_is_animated = node->is_animated;
+      continue;
+    }
+
+    const TransformNodeData* parent_node = Node(parent);
+    node->to_screen = parent_node->to_screen;
+    if (parent_node->flattens)
+      node->to_screen.FlattenTo2d();
+    node->to_screen.PreconcatTransform(node->to_parent);
+    node->to_screen_is_animated =
+        node->is_animated || parent_node->to_screen_is_animated;
+  }
+}
+
+ClipNodeData::ClipNodeData() : transform_id(-1) {}
+
+void ClipTree::UpdateClips(const TransformTree& transform_tree) {
+  DCHECK(!transform_tree.needs_update());
+
+  // The changed nodes are recomputed along with the others below.
+  std::vector<int> ids;
+  TakeNodesNeedingUpdate(&ids);
+
+  for (int id = 0; id < static_cast<int>(size()); ++id) {
+    ClipNodeData* node = Node(id);
+    node->combined_clip = MathUtil::MapClippedRect(
+        transform_tree.Node(node->transform_id)->to_screen, node->clip);
+    int parent = parent_id(id);
+    if (parent != -1)
+      node->combined_clip.Intersect(Node(parent)->combined_clip);
+  }
+}
+
+EffectNodeData::EffectNodeData()
+    : opacity(1.f), screen_space_opacity(1.f) {}
+
+void EffectTree::UpdateEffects() {
+  std::vector<int> ids;
+  TakeNodesNeedingUpdate(&ids);
+
+  for (size_t i = 0; i < ids.size(); ++i) {
+    EffectNodeData* node = Node(ids[i]);
+    int parent = parent_id(ids[i]);
+    node->screen_space_opacity = node->opacity;
+    if (parent != -1)
+      node->screen_space_opacity *= Node(parent)->screen_space_opacity;
+  }
+}
+
+PropertyTrees::PropertyTrees() {}
+
+PropertyTrees::~PropertyTrees() {}
+
+}  // namespace cc
@@ -0,0 +1,152 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_TREES_PROPERTY_TREE_H_
+#define CC_TREES_PROPERTY_TREE_H_
+
+#include <vector>
+
+#include "base/basictypes.h"
+#include "cc/base/cc_export.h"
+#include "ui/gfx/rect_f.h"
+#include "ui/gfx/transform.h"
+
+namespace cc {
+
+// A node of a PropertyTree. Parents always have smaller ids than their
+// children.
+template <typename T>
+struct TreeNode {
+  TreeNode() : id(-1), parent_id(-1) {}
+
+  int id;
+  int parent_id;
+  T data;
+};
+
+// The properties that layers used to inherit from their ancestors in the
+// layer hierarchy, kept in a compact tree of their own. Many layers can point
+// to the same node, and layers only get a node of their own when they change
+// the property. Updating the tree after SetNeedsUpdate() only recomputes the
+// changed nodes and their descendants.
+template <typename T>
+class CC_EXPORT PropertyTree {
+ public:
+  PropertyTree();
+  virtual ~PropertyTree();
+
+  // Adds a node under |parent_id|, which must be an existing node, or -1 for
+  // the root, and returns its id. New nodes need to be updated.
+  int Insert(const T& data, int parent_id);
+
+  T* Node(int id) { return &nodes_[id].data; }
+  const T* Node(int id) const { return &nodes_[id].data; }
+  int parent_id(int id) const { return nodes_[id].parent_id; }
+
+  // Notes that the data of the node with |id| changed, so it and its
+  // descendants need to be updated.
+  void SetNeedsUpdate(int id);
+  bool needs_update() const { return needs_update_; }
+
+  void clear();
+  size_t size() const { return nodes_.size(); }
+
+ protected:
+  // Appends the ids of the nodes that need to be updated to |ids|, parents
+  // first, and forgets about them. This only costs a flag check for each of
+  // the other nodes.
+  void TakeNodesNeedingUpdate(std::vector<int>* ids);
+
+ private:
+  std::vector<TreeNode<T> > nodes_;
+  std::vector<bool> node_needs_update_;
+  bool needs_update_;
+};
+
+struct CC_EXPORT TransformNodeData {
+  TransformNodeData();
+  ~TransformNodeData();
+
+  // The id of the layer which created this node, or -1.
+  int owner_id;
+
+  // The transform from the space of this node to the one of its parent.
+  gfx::Transform to_parent;
+
+  // Computed from the ancestors: the transform from the space of this node to
+  // the screen.
+  gfx::Transform to_screen;
+
+  // Whether the space given to the children, unlike this node's own, is
+  // flattened to 2d.
+  bool flattens;
+
+  bool is_animated;
+
+  // Computed: whether this node or one of its ancestors is animated.
+  bool to_screen_is_animated;
+};
+
+typedef TreeNode<TransformNodeData> TransformNode;
+
+class CC_EXPORT TransformTree : public PropertyTree<TransformNodeData> {
+ public:
+  // Recomputes the screen space transforms of the nodes which changed and of
+  // their descendants.
+  void UpdateTransforms();
+};
+
+struct CC_EXPORT ClipNodeData {
+  ClipNodeData();
+
+  // The clip rect, in the space of the transform node |transform_id|.
+  gfx::RectF clip;
+  int transform_id;
+
+  // Computed: the intersection of the clip rects of this node and its
+  // ancestors, in screen space.
+  gfx::RectF combined_clip;
+};
+
+typedef TreeNode<ClipNodeData> ClipNode;
+
+class CC_EXPORT ClipTree : public PropertyTree<ClipNodeData> {
+ public:
+  // Recomputes the combined clips of all the nodes, since any of their
+  // transforms may have changed. Only the layers that clip their subtree add
+  // clip nodes, so there are few of them. |transform_tree| must be updated.
+  void UpdateClips(const TransformTree& transform_tree);
+};
+
+struct CC_EXPORT EffectNodeData {
+  EffectNodeData();
+
+  float opacity;
+
+  // Computed: the product of the opacities of this node and its ancestors.
+  float screen_space_opacity;
+};
+
+typedef TreeNode<EffectNodeData> EffectNode;
+
+class CC_EXPORT EffectTree : public PropertyTree<EffectNodeData> {
+ public:
+  // Recomputes the screen space opacities of the nodes which changed and of
+  // their descendants.
+  void UpdateEffects();
+};
+
+// The property trees of a layer tree.
+struct CC_EXPORT PropertyTrees {
+  PropertyTrees();
+  ~PropertyTrees();
+
+  TransformTree transform_tree;
+  ClipTree clip_tree;
+  EffectTree effect_tree;
+};
+
+}  // namespace cc
+
+#endif  // CC_TREES_PROPERTY_TREE_H_
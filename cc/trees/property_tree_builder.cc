@@ -0,0 +1,196 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/trees/property_tree_builder.h"
+
+#include "cc/layers/layer_impl.h"
+#include "cc/trees/property_tree.h"
+#include "ui/gfx/rect.h"
+#include "ui/gfx/transform.h"
+
+namespace cc {
+
+namespace {
+
+struct DataForRecursion {
+  PropertyTrees* property_trees;
+  const LayerImpl* page_scale_application_layer;
+  float page_scale_factor;
+  int transform_tree_parent;
+  int clip_tree_parent;
+  int effect_tree_parent;
+};
+
+// Returns the transform from the space of |layer| to the one of its parent.
+gfx::Transform LocalTransform(const LayerImpl& layer) {
+  gfx::Size bounds = layer.bounds();
+  gfx::PointF anchor_point = layer.anchor_point();
+  gfx::PointF position = layer.position() - layer.TotalScrollOffset();
+
+  gfx::Transform local_transform;
+  local_transform.Translate3d(
+      position.x() + anchor_point.x() * bounds.width(),
+      position.y() + anchor_point.y() * bounds.height(),
+      layer.anchor_point_z());
+  local_transform.PreconcatTransform(layer.transform());
+  local_transform.Translate3d(-anchor_point.x() * bounds.width(),
+                              -anchor_point.y() * bounds.height(),
+                              -layer.anchor_point_z());
+  return local_transform;
+}
+
+void AddTransformNodeIfNeeded(const DataForRecursion& data_from_ancestor,
+                              LayerImpl* layer,
+                              DataForRecursion* data_for_children) {
+  TransformTree& transform_tree =
+      data_from_ancestor.property_trees->transform_tree;
+  const TransformNodeData* parent_node =
+      transform_tree.Node(data_from_ancestor.transform_tree_parent);
+
+  gfx::Transform local_transform = LocalTransform(*layer);
+  bool is_animated = layer->TransformIsAnimating();
+  bool is_page_scale_application_layer =
+      layer == data_from_ancestor.page_scale_application_layer;
+
+  // Layers that don't move their subtree or change how it's flattened use
+  // the node of their parent.
+  if (local_transform.IsIdentity() && !is_animated &&
+      !is_page_scale_application_layer &&
+      layer->should_flatten_transform() == parent_node->flattens) {
+    layer->set_transform_tree_index(data_from_ancestor.transform_tree_parent);
+    return;
+  }
+
+  TransformNodeData node;
+  node.owner_id = layer->id();
+  node.to_parent = local_transform;
+  node.flattens = layer->should_flatten_transform();
+  node.is_animated = is_animated;
+  int id =
+      transform_tree.Insert(node, data_from_ancestor.transform_tree_parent);
+  layer->set_transform_tree_index(id);
+  data_for_children->transform_tree_parent = id;
+
+  // The page scale applies to the descendants of the layer, but not to the
+  // layer itself.
+  if (is_page_scale_application_layer) {
+    TransformNodeData page_scale_node;
+    page_scale_node.to_parent.Scale(data_from_ancestor.page_scale_factor,
+                                    data_from_ancestor.page_scale_factor);
+    page_scale_node.flattens = node.flattens;
+    data_for_children->transform_tree_parent =
+        transform_tree.Insert(page_scale_node, id);
+  }
+}
+
+void AddClipNodeIfNeeded(const DataForRecursion& data_from_ancestor,
+                         LayerImpl* layer,
+                         DataForRecursion* data_for_children) {
+  // Clip children aren't clipped by the layers between them and their clip
+  // parent.
+  int parent_id = layer->clip_parent()
+                      ? layer->clip_parent()->clip_tree_index()
+                      : data_from_ancestor.clip_tree_parent;
+  DCHECK_NE(-1, parent_id);
+
+  if (!layer->masks_to_bounds()) {
+    layer->set_clip_tree_index(parent_id);
+    data_for_children->clip_tree_parent = parent_id;
+    return;
+  }
+
+  ClipNodeData node;
+  node.clip = gfx::RectF(layer->bounds());
+  node.transform_id = layer->transform_tree_index();
+  int id = data_from_ancestor.property_trees->clip_tree.Insert(node, parent_id);
+  layer->set_clip_tree_index(id);
+  data_for_children->clip_tree_parent = id;
+}
+
+void AddEffectNodeIfNeeded(const DataForRecursion& data_from_ancestor,
+                           LayerImpl* layer,
+                           DataForRecursion* data_for_children) {
+  if (layer->opacity() == 1.f && !layer->OpacityIsAnimating()) {
+    layer->set_effect_tree_index(data_from_ancestor.effect_tree_parent);
+    return;
+  }
+
+  EffectNodeData node;
+  node.opacity = layer->opacity();
+  int id = data_from_ancestor.property_trees->effect_tree.Insert(
+      node, data_from_ancestor.effect_tree_parent);
+  layer->set_effect_tree_index(id);
+  data_for_children->effect_tree_parent = id;
+}
+
+void BuildPropertyTreesInternal(LayerImpl* layer,
+                                const DataForRecursion& data_from_ancestor) {
+  DataForRecursion data_for_children(data_from_ancestor);
+
+  AddTransformNodeIfNeeded(data_from_ancestor, layer, &data_for_children);
+  AddClipNodeIfNeeded(data_from_ancestor, layer, &data_for_children);
+  AddEffectNodeIfNeeded(data_from_ancestor, layer, &data_for_children);
+
+  for (size_t i = 0; i < layer->children().size(); ++i)
+    BuildPropertyTreesInternal(layer->children()[i], data_for_children);
+}
+
+}  // namespace
+
+void PropertyTreeBuilder::BuildPropertyTrees(
+    LayerImpl* root_layer,
+    const LayerImpl* page_scale_application_layer,
+    float page_scale_factor,
+    const gfx::Transform& device_transform,
+    const gfx::Rect& device_viewport_rect,
+    PropertyTrees* property_trees) {
+  TransformTree& transform_tree = property_trees->transform_tree;
+  ClipTree& clip_tree = property_trees->clip_tree;
+  EffectTree& effect_tree = property_trees->effect_tree;
+  transform_tree.clear();
+  clip_tree.clear();
+  effect_tree.clear();
+
+  // The screen space, which the device transform maps the root layer to.
+  int screen_id = transform_tree.Insert(TransformNodeData(), -1);
+  TransformNodeData device_node;
+  device_node.to_parent = device_transform;
+  int device_id = transform_tree.Insert(device_node, screen_id);
+
+  ClipNodeData viewport_clip;
+  viewport_clip.clip = gfx::RectF(device_viewport_rect);
+  viewport_clip.transform_id = screen_id;
+
+  DataForRecursion data_for_recursion;
+  data_for_recursion.property_trees = property_trees;
+  data_for_recursion.page_scale_application_layer =
+      page_scale_application_layer;
+  data_for_recursion.page_scale_factor = page_scale_factor;
+  data_for_recursion.transform_tree_parent = device_id;
+  data_for_recursion.clip_tree_parent = clip_tree.Insert(viewport_clip, -1);
+  data_for_recursion.effect_tree_parent =
+      effect_tree.Insert(EffectNodeData(), -1);
+  BuildPropertyTreesInternal(root_layer, data_for_recursion);
+
+  transform_tree.UpdateTransforms();
+  clip_tree.UpdateClips(transform_tree);
+  effect_tree.UpdateEffects();
+}
+
+bool PropertyTreeBuilder::UpdateLayerTransform(LayerImpl* layer,
+                                               PropertyTrees* property_trees) {
+  int id = layer->transform_tree_index();
+  if (id == -1)
+    return false;
+
+  TransformNodeData* node = property_trees->transform_tree.Node(id);
+  if (node->owner_id != layer->id())
+    return false;
+
+  node->to_parent = LocalTransform(*layer);
+  property_trees->transform_tree.SetNeedsUpdate(id);
+  return true;
+}
+
+}  // namespace cc
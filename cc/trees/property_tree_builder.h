@@ -0,0 +1,53 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_TREES_PROPERTY_TREE_BUILDER_H_
+#define CC_TREES_PROPERTY_TREE_BUILDER_H_
+
+#include "base/basictypes.h"
+#include "cc/base/cc_export.h"
+
+namespace gfx {
+class Rect;
+class Transform;
+}
+
+namespace cc {
+
+class LayerImpl;
+struct PropertyTrees;
+
+class CC_EXPORT PropertyTreeBuilder {
+ public:
+  // Rebuilds |property_trees| from the layer hierarchy under |root_layer|, and
+  // points every layer of the hierarchy to its nodes. The transform tree maps
+  // layer space to screen space, like the screen space transforms computed by
+  // LayerTreeHostCommon, but without the scales to content space, the
+  // adjustments of fixed position layers and the snapping of scrolled layers
+  // to pixels. The root clip node is |device_viewport_rect|, in screen space.
+  // Mask and replica layers aren't given nodes.
+  static void BuildPropertyTrees(LayerImpl* root_layer,
+                                 const LayerImpl* page_scale_application_layer,
+                                 float page_scale_factor,
+                                 const gfx::Transform& device_transform,
+                                 const gfx::Rect& device_viewport_rect,
+                                 PropertyTrees* property_trees);
+
+  // Updates the transform node of |layer| after its transform, position,
+  // anchor point or scroll offset changed, so that only the node and its
+  // descendants are recomputed by the next TransformTree::UpdateTransforms().
+  // Returns false if |layer| shares the node of its parent, in which case the
+  // trees need to be rebuilt.
+  static bool UpdateLayerTransform(LayerImpl* layer,
+                                   PropertyTrees* property_trees);
+
+ private:
+  PropertyTreeBuilder();  // Not instantiable.
+
+  DISALLOW_COPY_AND_ASSIGN(PropertyTreeBuilder);
+};
+
+}  // namespace cc
+
+#endif  // CC_TREES_PROPERTY_TREE_BUILDER_H_
@@ -0,0 +1,177 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/trees/property_tree.h"
+
+#include "cc/layers/layer_impl.h"
+#include "cc/test/fake_impl_proxy.h"
+#include "cc/test/fake_layer_tree_host_impl.h"
+#include "cc/test/geometry_test_utils.h"
+#include "cc/trees/property_tree_builder.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "ui/gfx/rect.h"
+#include "ui/gfx/transform.h"
+
+namespace cc {
+namespace {
+
+TransformNodeData TranslationNode(float x, float y) {
+  TransformNodeData node;
+  node.to_parent.Translate(x, y);
+  return node;
+}
+
+TEST(PropertyTreeTest, ComputeScreenSpaceTransforms) {
+  TransformTree tree;
+  int root = tree.Insert(TranslationNode(1.f, 2.f), -1);
+  int child = tree.Insert(TranslationNode(3.f, 4.f), root);
+  int grand_child = tree.Insert(TranslationNode(5.f, 6.f), child);
+  EXPECT_TRUE(tree.needs_update());
+
+  tree.UpdateTransforms();
+  EXPECT_FALSE(tree.needs_update());
+
+  gfx::Transform expected;
+  expected.Translate(9.f, 12.f);
+  EXPECT_TRANSFORMATION_MATRIX_EQ(expected, tree.Node(grand_child)->to_screen);
+}
+
+TEST(PropertyTreeTest, OnlyChangedSubtreesAreUpdated) {
+  TransformTree tree;
+  int root = tree.Insert(TransformNodeData(), -1);
+  int changed = tree.Insert(TranslationNode(1.f, 0.f), root);
+  int changed_child = tree.Insert(TranslationNode(1.f, 0.f), changed);
+  int sibling = tree.Insert(TranslationNode(0.f, 1.f), root);
+  tree.UpdateTransforms();
+
+  // Values which an update of |sibling| would overwrite.
+  gfx::Transform stale_transform;
+  stale_transform.Scale(2.f, 2.f);
+  tree.Node(sibling)->to_screen = stale_transform;
+
+  tree.Node(changed)->to_parent.MakeIdentity();
+  tree.Node(changed)->to_parent.Translate(2.f, 0.f);
+  tree.SetNeedsUpdate(changed);
+  tree.UpdateTransforms();
+
+  gfx::Transform expected;
+  expected.Translate(3.f, 0.f);
+  EXPECT_TRANSFORMATION_MATRIX_EQ(expected,
+                                  tree.Node(changed_child)->to_screen);
+  EXPECT_TRANSFORMATION_MATRIX_EQ(stale_transform,
+                                  tree.Node(sibling)->to_screen);
+}
+
+TEST(PropertyTreeTest, FlatteningAppliesToChildren) {
+  TransformTree tree;
+  TransformNodeData root_node;
+  root_node.to_parent.RotateAboutXAxis(30.0);
+  root_node.flattens = true;
+  int root = tree.Insert(root_node, -1);
+  int child = tree.Insert(TransformNodeData(), root);
+  tree.UpdateTransforms();
+
+  gfx::Transform flattened = root_node.to_parent;
+  flattened.FlattenTo2d();
+  EXPECT_TRANSFORMATION_MATRIX_EQ(root_node.to_parent,
+                                  tree.Node(root)->to_screen);
+  EXPECT_TRANSFORMATION_MATRIX_EQ(flattened, tree.Node(child)->to_screen);
+}
+
+TEST(PropertyTreeTest, ComputeCombinedClipsAndOpacities) {
+  TransformTree transform_tree;
+  int root_transform = transform_tree.Insert(TransformNodeData(), -1);
+  int child_transform =
+      transform_tree.Insert(TranslationNode(10.f, 10.f), root_transform);
+  transform_tree.UpdateTransforms();
+
+  ClipTree clip_tree;
+  ClipNodeData root_clip;
+  root_clip.clip = gfx::RectF(0.f, 0.f, 50.f, 50.f);
+  root_clip.transform_id = root_transform;
+  ClipNodeData child_clip;
+  child_clip.clip = gfx::RectF(0.f, 0.f, 100.f, 20.f);
+  child_clip.transform_id = child_transform;
+  int child = clip_tree.Insert(child_clip, clip_tree.Insert(root_clip, -1));
+  clip_tree.UpdateClips(transform_tree);
+  EXPECT_RECT_EQ(gfx::RectF(10.f, 10.f, 40.f, 20.f),
+                 clip_tree.Node(child)->combined_clip);
+
+  EffectTree effect_tree;
+  EffectNodeData effect;
+  effect.opacity = 0.5f;
+  int child_effect =
+      effect_tree.Insert(effect, effect_tree.Insert(effect, -1));
+  effect_tree.UpdateEffects();
+  EXPECT_FLOAT_EQ(0.25f, effect_tree.Node(child_effect)->screen_space_opacity);
+}
+
+TEST(PropertyTreeTest, BuildFromLayers) {
+  FakeImplProxy proxy;
+  FakeLayerTreeHostImpl host_impl(&proxy);
+  scoped_ptr<LayerImpl> root = LayerImpl::Create(host_impl.active_tree(), 1);
+  root->SetBounds(gfx::Size(100, 100));
+  scoped_ptr<LayerImpl> clip_layer =
+      LayerImpl::Create(host_impl.active_tree(), 2);
+  clip_layer->SetBounds(gfx::Size(50, 50));
+  clip_layer->SetPosition(gfx::PointF(10.f, 10.f));
+  clip_layer->SetMasksToBounds(true);
+  clip_layer->SetOpacity(0.5f);
+  scoped_ptr<LayerImpl> plain_layer =
+      LayerImpl::Create(host_impl.active_tree(), 3);
+  plain_layer->SetBounds(gfx::Size(80, 80));
+
+  LayerImpl* clip = clip_layer.get();
+  LayerImpl* plain = plain_layer.get();
+  clip->AddChild(plain_layer.Pass());
+  root->AddChild(clip_layer.Pass());
+
+  PropertyTrees property_trees;
+  PropertyTreeBuilder::BuildPropertyTrees(root.get(),
+                                          NULL,
+                                          1.f,
+                                          gfx::Transform(),
+                                          gfx::Rect(100, 100),
+                                          &property_trees);
+
+  // A layer which doesn't move, clip or fade its subtree shares the nodes of
+  // its parent.
+  EXPECT_EQ(clip->transform_tree_index(), plain->transform_tree_index());
+  EXPECT_EQ(clip->clip_tree_index(), plain->clip_tree_index());
+  EXPECT_EQ(clip->effect_tree_index(), plain->effect_tree_index());
+  EXPECT_NE(root->transform_tree_index(), clip->transform_tree_index());
+  EXPECT_NE(root->clip_tree_index(), clip->clip_tree_index());
+  EXPECT_NE(root->effect_tree_index(), clip->effect_tree_index());
+
+  gfx::Transform expected;
+  expected.Translate(10.f, 10.f);
+  EXPECT_TRANSFORMATION_MATRIX_EQ(
+      expected,
+      property_trees.transform_tree.Node(plain->transform_tree_index())
+          ->to_screen);
+  EXPECT_RECT_EQ(
+      gfx::RectF(10.f, 10.f, 50.f, 50.f),
+      property_trees.clip_tree.Node(plain->clip_tree_index())->combined_clip);
+  EXPECT_FLOAT_EQ(
+      0.5f,
+      property_trees.effect_tree.Node(plain->effect_tree_index())
+          ->screen_space_opacity);
+
+  // Moving a layer with a node of its own only needs its subtree updated.
+  clip->SetPosition(gfx::PointF(20.f, 10.f));
+  EXPECT_TRUE(PropertyTreeBuilder::UpdateLayerTransform(clip, &property_trees));
+  EXPECT_FALSE(
+      PropertyTreeBuilder::UpdateLayerTransform(plain, &property_trees));
+  property_trees.transform_tree.UpdateTransforms();
+
+  expected.MakeIdentity();
+  expected.Translate(20.f, 10.f);
+  EXPECT_TRANSFORMATION_MATRIX_EQ(
+      expected,
+      property_trees.transform_tree.Node(plain->transform_tree_index())
+          ->to_screen);
+}
+
+}  // namespace
+}  // namespace cc
@@ -82,6 +82,12 @@ scoped_ptr<LayerImpl> TreeSynchronizer::SynchronizeTrees(
       layer_root, old_layer_impl_root.Pass(), tree_impl);
 }
 
+void DidSynchronizeLayerImpl(Layer* layer, bool layer_impl_created) {
+  layer->DidSynchronizeLayerImpl(layer_impl_created);
+}
+
+void DidSynchronizeLayerImpl(LayerImpl* layer, bool layer_impl_created) {}
+
 template <typename LayerType>
 scoped_ptr<LayerImpl> ReuseOrCreateLayerImpl(RawPtrLayerImplMap* new_layers,
                                              ScopedPtrLayerImplMap* old_layers,
@@ -89,8 +95,10 @@ scoped_ptr<LayerImpl> ReuseOrCreateLayerImpl(RawPtrLayerImplMap* new_layers,
                                              LayerTreeImpl* tree_impl) {
   scoped_ptr<LayerImpl> layer_impl = old_layers->take(layer->id());
 
-  if (!layer_impl)
+  bool layer_impl_created = !layer_impl;
+  if (layer_impl_created)
     layer_impl = layer->CreateLayerImpl(tree_impl);
+  DidSynchronizeLayerImpl(layer, layer_impl_created);
 
   (*new_layers)[layer->id()] = layer_impl.get();
   return layer_impl.Pass();
@@ -258,8 +258,21 @@ void AutocompleteController::Start(const AutocompleteInput& input) {
   in_zero_suggest_ = false;
   in_start_ = true;
   base::TimeTicks start_time = base::TimeTicks::Now();
+  // The HistoryURLProvider hands its full history search to the history
+  // thread from within Start(), so start it first: that search then runs
+  // while the synchronous providers do their work on this thread, instead of
+  // only starting once they are all done.  The order in which matches are
+  // merged into |result_| is unaffected.
+  ACProviders start_order;
+  if (history_url_provider_)
+    start_order.push_back(history_url_provider_);
   for (ACProviders::iterator i(providers_.begin()); i != providers_.end();
        ++i) {
+    if (*i != history_url_provider_)
+      start_order.push_back(*i);
+  }
+  for (ACProviders::iterator i(start_order.begin()); i != start_order.end();
+       ++i) {
     // TODO(mpearson): Remove timing code once bugs 178705 / 237703 / 168933
     // are resolved.
     base::TimeTicks provider_start_time = base::TimeTicks::Now();
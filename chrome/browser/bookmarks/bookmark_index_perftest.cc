@@ -0,0 +1,98 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/bookmarks/bookmark_index.h"
+
+#include <string>
+#include <vector>
+
+#include "base/memory/scoped_ptr.h"
+#include "base/rand_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/time/time.h"
+#include "chrome/browser/bookmarks/bookmark_model.h"
+#include "chrome/browser/bookmarks/bookmark_title_match.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+#include "url/gurl.h"
+
+using base::ASCIIToUTF16;
+
+namespace {
+
+// A large bookmark collection.
+const int kNumBookmarks = 50 * 1000;
+const int kWordsPerTitle = 5;
+const int kNumQueries = 200;
+
+// The words titles are made of. There are few of them so that, like real
+// titles, each word and each prefix matches many bookmarks.
+const char* const kWords[] = {
+  "news", "newsletter", "newspaper", "network", "networking", "recipe",
+  "recipes", "review", "reviews", "search", "searching", "shopping", "shop",
+  "travel", "traveling", "weather", "wiki", "wikipedia", "video", "videos",
+  "music", "musician", "photo", "photos", "photography", "research",
+  "reference", "report", "reports", "blog", "blogger", "forum", "forums",
+};
+
+std::string RandomWords(int num_words) {
+  std::string words;
+  for (int i = 0; i < num_words; ++i) {
+    if (i)
+      words += " ";
+    words += kWords[base::RandGenerator(arraysize(kWords))];
+  }
+  return words;
+}
+
+class BookmarkIndexPerfTest : public testing::Test {
+ protected:
+  virtual void SetUp() {
+    model_.reset(new BookmarkModel(NULL));
+    for (int i = 0; i < kNumBookmarks; ++i) {
+      model_->AddURL(model_->other_node(), i,
+                     ASCIIToUTF16(RandomWords(kWordsPerTitle)),
+                     GURL(base::StringPrintf("http://example.com/%d", i)));
+    }
+  }
+
+  // Runs |kNumQueries| queries of |num_terms| prefixes of title words and
+  // reports the distribution of the time per query.
+  void MeasureQueries(int num_terms, const std::string& trace) {
+    std::vector<base::string16> queries;
+    for (int i = 0; i < kNumQueries; ++i) {
+      std::string query;
+      for (int j = 0; j < num_terms; ++j) {
+        if (j)
+          query += " ";
+        query += std::string(kWords[base::RandGenerator(arraysize(kWords))])
+            .substr(0, 4);
+      }
+      queries.push_back(ASCIIToUTF16(query));
+    }
+
+    std::vector<double> durations_ms;
+    for (size_t i = 0; i < queries.size(); ++i) {
+      std::vector<BookmarkTitleMatch> matches;
+      base::TimeTicks start = base::TimeTicks::HighResNow();
+      model_->GetBookmarksWithTitlesMatching(queries[i], 10, &matches);
+      durations_ms.push_back(
+          (base::TimeTicks::HighResNow() - start).InMillisecondsF());
+    }
+
+    perf_test::PrintResultSummary("bookmark_index_query", "", trace,
+                                  durations_ms, "ms", true);
+  }
+
+  scoped_ptr<BookmarkModel> model_;
+};
+
+TEST_F(BookmarkIndexPerfTest, Queries) {
+  MeasureQueries(1, "1_term");
+  MeasureQueries(2, "2_terms");
+  MeasureQueries(3, "3_terms");
+}
+
+}  // namespace
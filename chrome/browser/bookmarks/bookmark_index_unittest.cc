@@ -125,6 +125,9 @@ TEST_F(BookmarkIndexTest, Tests) {
     // Prefix match, multiple terms.
     { "abcd cdef;abcd;abcd cdefg",  "abc cde",  "abcd cdef;abcd cdefg"},
 
+    // Prefix matching several words of the same title.
+    { "abcd abce cdef;abcd;cdef",   "abc cde",  "abcd abce cdef"},
+
     // Exact and prefix match.
     { "ab cdef;abcd;abcd cdefg",    "ab cdef",  "ab cdef"},
 
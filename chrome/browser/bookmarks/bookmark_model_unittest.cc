@@ -969,6 +969,40 @@ TEST_F(BookmarkModelTestWithProfile, CreateAndRestore) {
   }
 }
 
+// Makes sure the url lookups of a loaded model find all the loaded nodes,
+// including nodes that share a url.
+TEST_F(BookmarkModelTestWithProfile, GetNodesByURLAfterLoad) {
+  profile_.reset(new TestingProfile());
+  profile_->CreateBookmarkModel(true);
+  ASSERT_TRUE(profile_->CreateHistoryService(true, false));
+  BlockTillBookmarkModelLoaded();
+
+  const GURL url_a("http://a.com/");
+  const GURL url_b("http://b.com/");
+  const base::string16 title(ASCIIToUTF16("blah"));
+  bb_model_->AddURL(bb_model_->bookmark_bar_node(), 0, title, url_b);
+  bb_model_->AddURL(bb_model_->bookmark_bar_node(), 1, title, url_a);
+  const BookmarkNode* folder = bb_model_->AddFolder(
+      bb_model_->other_node(), 0, ASCIIToUTF16("folder"));
+  bb_model_->AddURL(folder, 0, title, url_a);
+
+  profile_->CreateBookmarkModel(false);
+  BlockTillBookmarkModelLoaded();
+
+  std::vector<const BookmarkNode*> nodes;
+  bb_model_->GetNodesByURL(url_a, &nodes);
+  ASSERT_EQ(2U, nodes.size());
+  EXPECT_EQ(url_a, nodes[0]->url());
+  EXPECT_EQ(url_a, nodes[1]->url());
+  EXPECT_NE(nodes[0], nodes[1]);
+
+  nodes.clear();
+  bb_model_->GetNodesByURL(url_b, &nodes);
+  ASSERT_EQ(1U, nodes.size());
+  EXPECT_EQ(bb_model_->bookmark_bar_node()->GetChild(0), nodes[0]);
+  EXPECT_FALSE(bb_model_->IsBookmarked(GURL("http://c.com/")));
+}
+
 TEST_F(BookmarkModelTest, Sort) {
   // Populate the bookmark bar node with nodes for 'B', 'a', 'd' and 'C'.
   // 'C' and 'a' are folders.
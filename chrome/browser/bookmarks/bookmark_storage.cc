@@ -4,10 +4,13 @@
 
 #include "chrome/browser/bookmarks/bookmark_storage.h"
 
+#include <algorithm>
+
 #include "base/bind.h"
 #include "base/compiler_specific.h"
 #include "base/file_util.h"
 #include "base/files/file_path.h"
+#include "base/files/important_file_commit_coordinator.h"
 #include "base/json/json_file_value_serializer.h"
 #include "base/json/json_string_value_serializer.h"
 #include "base/metrics/histogram.h"
@@ -31,15 +34,20 @@ const base::FilePath::CharType kBackupExtension[] = FILE_PATH_LITERAL("bak");
 // How often we save.
 const int kSaveDelayMS = 2500;
 
+// How much earlier than planned a save may be done to batch it with others.
+const int kSaveBatchWindowMS = 1000;
+
 void BackupCallback(const base::FilePath& path) {
   base::FilePath backup_path = path.ReplaceExtension(kBackupExtension);
   base::CopyFile(path, backup_path);
 }
 
-// Adds node to the model's index, recursing through all children as well.
+// Adds node to the model's index and to the url nodes of |details|, recursing
+// through all children as well.
 void AddBookmarksToIndex(BookmarkLoadDetails* details,
                          BookmarkNode* node) {
   if (node->is_url()) {
+    details->url_nodes()->push_back(node);
     if (node->url().is_valid())
       details->index()->Add(node);
   } else {
@@ -48,6 +56,10 @@ void AddBookmarksToIndex(BookmarkLoadDetails* details,
   }
 }
 
+bool NodeURLLess(const BookmarkNode* n1, const BookmarkNode* n2) {
+  return n1->url() < n2->url();
+}
+
 void LoadCallback(const base::FilePath& path,
                   BookmarkStorage* storage,
                   BookmarkLoadDetails* details) {
@@ -76,12 +88,21 @@ void LoadCallback(const base::FilePath& path,
       UMA_HISTOGRAM_TIMES("Bookmarks.DecodeTime",
                           TimeTicks::Now() - start_time);
 
+      // The nodes don't refer to the parsed file, so free it before building
+      // the index rather than holding both at once.
+      root.reset();
+
       start_time = TimeTicks::Now();
       AddBookmarksToIndex(details, details->bb_node());
       AddBookmarksToIndex(details, details->other_folder_node());
       AddBookmarksToIndex(details, details->mobile_folder_node());
       UMA_HISTOGRAM_TIMES("Bookmarks.CreateBookmarkIndexTime",
                           TimeTicks::Now() - start_time);
+
+      // The sort is stable so that nodes with the same url keep the order a
+      // walk of the tree would insert them in.
+      std::stable_sort(details->url_nodes()->begin(),
+                       details->url_nodes()->end(), NodeURLLess);
     }
   }
 
@@ -121,7 +142,9 @@ BookmarkStorage::BookmarkStorage(
     base::SequencedTaskRunner* sequenced_task_runner)
     : model_(model),
       writer_(context->GetPath().Append(chrome::kBookmarksFileName),
-              sequenced_task_runner) {
+              new base::ImportantFileCommitCoordinator(
+                  sequenced_task_runner,
+                  base::TimeDelta::FromMilliseconds(kSaveBatchWindowMS))) {
   sequenced_task_runner_ = sequenced_task_runner;
   writer_.set_commit_interval(base::TimeDelta::FromMilliseconds(kSaveDelayMS));
   sequenced_task_runner_->PostTask(FROM_HERE,
@@ -5,6 +5,8 @@
 #ifndef CHROME_BROWSER_BOOKMARKS_BOOKMARK_STORAGE_H_
 #define CHROME_BROWSER_BOOKMARKS_BOOKMARK_STORAGE_H_
 
+#include <vector>
+
 #include "base/files/important_file_writer.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
@@ -56,6 +58,11 @@ class BookmarkLoadDetails {
   BookmarkIndex* index() { return index_.get(); }
   BookmarkIndex* release_index() { return index_.release(); }
 
+  // The url nodes of the loaded bookmarks, sorted by url. These are sorted on
+  // the background thread so that BookmarkModel can fill its url set without
+  // comparing urls on the UI thread.
+  std::vector<BookmarkNode*>* url_nodes() { return &url_nodes_; }
+
   const BookmarkNode::MetaInfoMap& model_meta_info_map() const {
     return model_meta_info_map_;
   }
@@ -98,6 +105,7 @@ class BookmarkLoadDetails {
   scoped_ptr<BookmarkPermanentNode> other_folder_node_;
   scoped_ptr<BookmarkPermanentNode> mobile_folder_node_;
   scoped_ptr<BookmarkIndex> index_;
+  std::vector<BookmarkNode*> url_nodes_;
   BookmarkNode::MetaInfoMap model_meta_info_map_;
   int64 model_sync_transaction_version_;
   int64 max_id_;
@@ -13,6 +13,7 @@
 #include "base/command_line.h"
 #include "base/debug/alias.h"
 #include "base/debug/leak_annotations.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "base/path_service.h"
 #include "base/prefs/json_pref_store.h"
 #include "base/prefs/pref_registry_simple.h"
@@ -44,6 +45,7 @@
 #include "chrome/browser/intranet_redirect_detector.h"
 #include "chrome/browser/io_thread.h"
 #include "chrome/browser/lifetime/application_lifetime.h"
+#include "chrome/browser/memory_purger.h"
 #include "chrome/browser/metrics/metrics_service.h"
 #include "chrome/browser/metrics/thread_watcher.h"
 #include "chrome/browser/metrics/variations/variations_service.h"
@@ -237,6 +239,9 @@ void BrowserProcessImpl::StartTearDown() {
   // those things during teardown.
   notification_ui_manager_.reset();
 
+  // The purger walks the profiles.
+  memory_pressure_listener_.reset();
+
   // Need to clear profiles (download managers) before the io_thread_.
   {
     TRACE_EVENT0("shutdown",
@@ -946,6 +951,9 @@ void BrowserProcessImpl::PreMainMessageLoopRun() {
   StorageMonitor::Create();
 #endif
 
+  memory_pressure_listener_.reset(new base::MemoryPressureListener(
+      base::Bind(&MemoryPurger::OnMemoryPressure)));
+
   platform_part_->PreMainMessageLoopRun();
 }
 
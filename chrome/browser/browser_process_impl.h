@@ -33,6 +33,7 @@ class PluginsResourceService;
 #endif
 
 namespace base {
+class MemoryPressureListener;
 class SequencedTaskRunner;
 }
 
@@ -165,6 +166,9 @@ class BrowserProcessImpl : public BrowserProcess,
 
   scoped_ptr<IOThread> io_thread_;
 
+  // Purges memory in the browser and the renderers on memory pressure.
+  scoped_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+
   bool created_watchdog_thread_;
   scoped_ptr<WatchDogThread> watchdog_thread_;
 
@@ -14,6 +14,7 @@
 
 #include "base/at_exit.h"
 #include "base/bind.h"
+#include "base/bind_helpers.h"
 #include "base/command_line.h"
 #include "base/debug/crash_logging.h"
 #include "base/debug/debugger.h"
@@ -90,6 +91,7 @@
 #include "chrome/browser/profiles/profile_manager.h"
 #include "chrome/browser/profiles/profiles_state.h"
 #include "chrome/browser/shell_integration.h"
+#include "chrome/browser/startup_task_scheduler.h"
 #include "chrome/browser/three_d_api_observer.h"
 #include "chrome/browser/translate/translate_service.h"
 #include "chrome/browser/ui/app_list/app_list_service.h"
@@ -1427,10 +1429,18 @@ int ChromeBrowserMainParts::PreMainMessageLoopRunImpl() {
   browser_process_->metrics_service()->RecordBreakpadHasDebugger(
       base::debug::BeingDebugged());
 
-  language_usage_metrics::LanguageUsageMetrics::RecordAcceptLanguages(
-      profile_->GetPrefs()->GetString(prefs::kAcceptLanguages));
-  language_usage_metrics::LanguageUsageMetrics::RecordApplicationLanguage(
-      browser_process_->GetApplicationLocale());
+  startup_task_scheduler_.reset(new StartupTaskScheduler);
+
+  startup_task_scheduler_->AddTask(
+      StartupTaskScheduler::IDLE,
+      base::Bind(
+          &language_usage_metrics::LanguageUsageMetrics::RecordAcceptLanguages,
+          profile_->GetPrefs()->GetString(prefs::kAcceptLanguages)));
+  startup_task_scheduler_->AddTask(
+      StartupTaskScheduler::IDLE,
+      base::Bind(&language_usage_metrics::LanguageUsageMetrics::
+                     RecordApplicationLanguage,
+                 browser_process_->GetApplicationLocale()));
 
   // The extension service may be available at this point. If the command line
   // specifies --uninstall-extension, attempt the uninstall extension startup
@@ -1464,7 +1474,12 @@ int ChromeBrowserMainParts::PreMainMessageLoopRunImpl() {
   // TODO(torne): this should maybe be done with
   // BrowserContextKeyedServiceFactory::ServiceIsCreatedWithBrowserContext()
   // instead?
-  CloudPrintProxyServiceFactory::GetForProfile(profile_);
+  // Checking on the service process can wait until the first page is shown.
+  startup_task_scheduler_->AddTask(
+      StartupTaskScheduler::AFTER_FIRST_PAINT,
+      base::Bind(
+          base::IgnoreResult(&CloudPrintProxyServiceFactory::GetForProfile),
+          profile_));
 #endif
 
   // Start watching all browser threads for responsiveness.
@@ -1652,6 +1667,9 @@ void ChromeBrowserMainParts::PostMainMessageLoopRun() {
   // Disarm the startup hang detector time bomb if it is still Arm'ed.
   startup_watcher_->Disarm();
 
+  // Drop the startup tasks that did not run yet; they use the profiles.
+  startup_task_scheduler_.reset();
+
   for (size_t i = 0; i < chrome_extra_parts_.size(); ++i)
     chrome_extra_parts_[i]->PostMainMessageLoopRun();
 
@@ -25,6 +25,7 @@ class MetricsService;
 class PrefService;
 class Profile;
 class StartupBrowserCreator;
+class StartupTaskScheduler;
 class StartupTimeBomb;
 class ShutdownWatcherHelper;
 class ThreeDAPIObserver;
@@ -178,6 +179,9 @@ class ChromeBrowserMainParts : public content::BrowserMainParts {
   ProcessSingleton::NotifyResult notify_result_;
   scoped_ptr<ThreeDAPIObserver> three_d_observer_;
 
+  // Runs the startup work that can wait until the first page has loaded.
+  scoped_ptr<StartupTaskScheduler> startup_task_scheduler_;
+
   // Initialized in SetupMetricsAndFieldTrials.
   scoped_refptr<FieldTrialSynchronizer> field_trial_synchronizer_;
 
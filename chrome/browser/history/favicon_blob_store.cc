@@ -0,0 +1,139 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/history/favicon_blob_store.h"
+
+#include "base/compiler_specific.h"
+#include "base/file_util.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/logging.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/sha1.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+
+namespace history {
+
+namespace {
+
+// Blob files are named by the hex encoded SHA-1 of their contents.
+const size_t kHashLength = base::kSHA1Length * 2;
+
+// A blob, mapped for as long as the memory is referenced.
+class MappedBlob : public base::RefCountedMemory {
+ public:
+  MappedBlob() {}
+
+  bool Init(const base::FilePath& path) {
+    return file_.Initialize(path) && file_.length() > 0;
+  }
+
+  // Overridden from RefCountedMemory:
+  virtual const unsigned char* front() const OVERRIDE {
+    return file_.data();
+  }
+  virtual size_t size() const OVERRIDE {
+    return file_.length();
+  }
+
+ private:
+  virtual ~MappedBlob() {}
+
+  base::MemoryMappedFile file_;
+
+  DISALLOW_COPY_AND_ASSIGN(MappedBlob);
+};
+
+}  // namespace
+
+FaviconBlobStore::FaviconBlobStore() {
+}
+
+FaviconBlobStore::~FaviconBlobStore() {
+}
+
+bool FaviconBlobStore::Init(const base::FilePath& directory) {
+  if (!base::CreateDirectory(directory))
+    return false;
+  directory_ = directory;
+  return true;
+}
+
+bool FaviconBlobStore::Put(const base::RefCountedMemory& data,
+                           std::string* hash) {
+  if (directory_.empty() || !data.size())
+    return false;
+
+  unsigned char digest[base::kSHA1Length];
+  base::SHA1HashBytes(data.front(), data.size(), digest);
+  std::string blob_hash = StringToLowerASCII(
+      base::HexEncode(digest, sizeof(digest)));
+
+  base::FilePath path = GetBlobPath(blob_hash);
+  if (!base::PathExists(path)) {
+    // Write to a temporary file first, so that a crash never leaves a
+    // partial blob under its final name.
+    base::FilePath temp_path;
+    if (!base::CreateTemporaryFileInDir(directory_, &temp_path))
+      return false;
+    int size = static_cast<int>(data.size());
+    if (file_util::WriteFile(temp_path, data.front_as<char>(), size) != size ||
+        !base::ReplaceFile(temp_path, path, NULL)) {
+      base::DeleteFile(temp_path, false);
+      return false;
+    }
+  }
+
+  hash->swap(blob_hash);
+  return true;
+}
+
+scoped_refptr<base::RefCountedMemory> FaviconBlobStore::Get(
+    const std::string& hash) const {
+  if (directory_.empty() || !IsValidHash(hash))
+    return NULL;
+
+  scoped_refptr<MappedBlob> blob(new MappedBlob());
+  if (!blob->Init(GetBlobPath(hash))) {
+    DLOG(WARNING) << "Missing favicon blob " << hash;
+    return NULL;
+  }
+  return blob;
+}
+
+void FaviconBlobStore::DeleteAllExcept(
+    const std::set<std::string>& hashes_to_keep) {
+  if (directory_.empty())
+    return;
+
+  base::FileEnumerator enumerator(directory_, false,
+                                  base::FileEnumerator::FILES);
+  for (base::FilePath path = enumerator.Next(); !path.empty();
+       path = enumerator.Next()) {
+    // Leftover temporary files don't have valid names, so are deleted too.
+    std::string hash = path.BaseName().MaybeAsASCII();
+    if (!hashes_to_keep.count(hash))
+      base::DeleteFile(path, false);
+  }
+}
+
+// static
+bool FaviconBlobStore::IsValidHash(const std::string& hash) {
+  if (hash.size() != kHashLength)
+    return false;
+  for (size_t i = 0; i < hash.size(); ++i) {
+    const char c = hash[i];
+    if (!(c >= '0' && c <= '9') && !(c >= 'a' && c <= 'f'))
+      return false;
+  }
+  return true;
+}
+
+base::FilePath FaviconBlobStore::GetBlobPath(const std::string& hash) const {
+  DCHECK(IsValidHash(hash));
+  return directory_.AppendASCII(hash);
+}
+
+}  // namespace history
@@ -0,0 +1,65 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CHROME_BROWSER_HISTORY_FAVICON_BLOB_STORE_H_
+#define CHROME_BROWSER_HISTORY_FAVICON_BLOB_STORE_H_
+
+#include <set>
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+
+namespace base {
+class RefCountedMemory;
+}
+
+namespace history {
+
+// Keeps favicon bitmaps which are too large to store inline in the thumbnail
+// database as files in a directory, named by the SHA-1 hash of their
+// contents. Identical bitmaps (such as the same touch icon used by many
+// pages) are only stored once, and blobs are memory mapped rather than read
+// when loaded.
+//
+// The store does not track which blobs are in use; the thumbnail database
+// records the hash of each stored bitmap and periodically deletes the blobs it
+// no longer references with DeleteAllExcept().
+class FaviconBlobStore {
+ public:
+  FaviconBlobStore();
+  ~FaviconBlobStore();
+
+  // Uses |directory| to store blobs, creating it if needed. Returns false if
+  // it can't be created, in which case Put() always fails.
+  bool Init(const base::FilePath& directory);
+
+  // Stores |data| unless a blob with the same contents is already stored, and
+  // returns the hash it can be loaded by in |hash|. Returns false if the blob
+  // could not be written.
+  bool Put(const base::RefCountedMemory& data, std::string* hash);
+
+  // Maps the blob stored under |hash|. Returns NULL if there is no such blob
+  // or it could not be mapped.
+  scoped_refptr<base::RefCountedMemory> Get(const std::string& hash) const;
+
+  // Deletes every blob whose hash is not in |hashes_to_keep|.
+  void DeleteAllExcept(const std::set<std::string>& hashes_to_keep);
+
+  // Returns true if |hash| is of the form returned by Put(). Hashes read from
+  // the database must be checked before being used as a file name.
+  static bool IsValidHash(const std::string& hash);
+
+ private:
+  base::FilePath GetBlobPath(const std::string& hash) const;
+
+  base::FilePath directory_;
+
+  DISALLOW_COPY_AND_ASSIGN(FaviconBlobStore);
+};
+
+}  // namespace history
+
+#endif  // CHROME_BROWSER_HISTORY_FAVICON_BLOB_STORE_H_
@@ -0,0 +1,80 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/history/favicon_blob_store.h"
+
+#include <set>
+#include <string>
+
+#include "base/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/ref_counted_memory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace history {
+
+class FaviconBlobStoreTest : public testing::Test {
+ protected:
+  virtual void SetUp() OVERRIDE {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    blob_dir_ = temp_dir_.path().AppendASCII("Blobs");
+    ASSERT_TRUE(store_.Init(blob_dir_));
+  }
+
+  static scoped_refptr<base::RefCountedMemory> MakeData(
+      const std::string& contents) {
+    std::string data(contents);
+    return base::RefCountedString::TakeString(&data);
+  }
+
+  base::ScopedTempDir temp_dir_;
+  base::FilePath blob_dir_;
+  FaviconBlobStore store_;
+};
+
+TEST_F(FaviconBlobStoreTest, PutAndGet) {
+  scoped_refptr<base::RefCountedMemory> data = MakeData("favicon data");
+  std::string hash;
+  ASSERT_TRUE(store_.Put(*data.get(), &hash));
+  EXPECT_TRUE(FaviconBlobStore::IsValidHash(hash));
+
+  scoped_refptr<base::RefCountedMemory> blob = store_.Get(hash);
+  ASSERT_TRUE(blob.get());
+  EXPECT_TRUE(blob->Equals(data));
+}
+
+TEST_F(FaviconBlobStoreTest, IdenticalDataIsStoredOnce) {
+  std::string hash1;
+  std::string hash2;
+  std::string hash3;
+  ASSERT_TRUE(store_.Put(*MakeData("same").get(), &hash1));
+  ASSERT_TRUE(store_.Put(*MakeData("same").get(), &hash2));
+  ASSERT_TRUE(store_.Put(*MakeData("other").get(), &hash3));
+  EXPECT_EQ(hash1, hash2);
+  EXPECT_NE(hash1, hash3);
+
+  // Only the blob kept survives.
+  std::set<std::string> hashes_to_keep;
+  hashes_to_keep.insert(hash3);
+  store_.DeleteAllExcept(hashes_to_keep);
+  EXPECT_FALSE(store_.Get(hash1).get());
+  EXPECT_TRUE(store_.Get(hash3).get());
+
+  store_.DeleteAllExcept(std::set<std::string>());
+  EXPECT_TRUE(base::IsDirectoryEmpty(blob_dir_));
+}
+
+TEST_F(FaviconBlobStoreTest, InvalidHashes) {
+  EXPECT_FALSE(FaviconBlobStore::IsValidHash(""));
+  EXPECT_FALSE(FaviconBlobStore::IsValidHash("../../../../etc/passwd"));
+  EXPECT_FALSE(FaviconBlobStore::IsValidHash(
+      "DA39A3EE5E6B4B0D3255BFEF95601890AFD80709"));
+  EXPECT_TRUE(FaviconBlobStore::IsValidHash(
+      "da39a3ee5e6b4b0d3255bfef95601890afd80709"));
+
+  // Corrupt hashes from the database don't reach the file system.
+  EXPECT_FALSE(store_.Get("../Blobs").get());
+}
+
+}  // namespace history
@@ -20,8 +20,10 @@
 #include "base/message_loop/message_loop.h"
 #include "base/metrics/histogram.h"
 #include "base/rand_util.h"
+#include "base/sequenced_task_runner.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/synchronization/waitable_event.h"
 #include "base/time/time.h"
 #include "chrome/browser/autocomplete/history_url_provider.h"
 #include "chrome/browser/bookmarks/bookmark_service.h"
@@ -30,6 +32,7 @@
 #include "chrome/browser/history/download_row.h"
 #include "chrome/browser/history/history_db_task.h"
 #include "chrome/browser/history/history_notifications.h"
+#include "chrome/browser/history/history_query_database.h"
 #include "chrome/browser/history/in_memory_history_backend.h"
 #include "chrome/browser/history/page_usage_data.h"
 #include "chrome/browser/history/select_favicon_frames.h"
@@ -119,6 +122,13 @@ MostVisitedURL MakeMostVisitedURL(const PageUsageData& page_data,
   return mv;
 }
 
+// Deletes |query_db| on the sequence it is used on and signals |closed|.
+void CloseQueryDatabase(HistoryQueryDatabase* query_db,
+                        base::WaitableEvent* closed) {
+  delete query_db;
+  closed->Signal();
+}
+
 // This task is run on a timer so that commits happen at regular intervals
 // so they are batched together. The important thing about this class is that
 // it supports canceling of the task so the reference to the backend will be
@@ -602,7 +612,18 @@ void HistoryBackend::InitImpl(const std::string& languages) {
                                                       // pointer.
   else
     delete mem_backend;  // Error case, run without the in-memory DB.
-  db_->BeginExclusiveMode();  // Must be after the mem backend read the data.
+
+  // The query connection reads while this one writes, so the file can only be
+  // locked exclusively without it.
+  if (query_task_runner_.get()) {
+    query_db_.reset(new HistoryQueryDatabase());
+    if (!query_db_->Init(history_name)) {
+      LOG(WARNING) << "Could not open the history query connection.";
+      query_db_.reset();
+    }
+  }
+  if (!query_db_)
+    db_->BeginExclusiveMode();  // Must be after the mem backend read the data.
 
   // Thumbnail database.
   // TODO(shess): "thumbnail database" these days only stores
@@ -689,6 +710,18 @@ void HistoryBackend::OnMemoryPressure(
 }
 
 void HistoryBackend::CloseAllDatabases() {
+  if (query_db_) {
+    // Wait for queries in flight so that the file is closed when this
+    // returns, as callers may delete it.
+    base::WaitableEvent closed(false, false);
+    HistoryQueryDatabase* query_db = query_db_.release();
+    if (query_task_runner_->PostTask(
+            FROM_HERE, base::Bind(&CloseQueryDatabase, query_db, &closed))) {
+      closed.Wait();
+    } else {
+      delete query_db;
+    }
+  }
   if (db_) {
     // Commit the long-running transaction.
     db_->CommitTransaction();
@@ -1240,8 +1273,22 @@ void HistoryBackend::QueryHistory(scoped_refptr<QueryHistoryRequest> request,
 
   if (db_) {
     if (text_query.empty()) {
+      if (query_db_) {
+        // Commit so that the query connection sees everything recorded so
+        // far, then let it run the query while we carry on writing.
+        Commit();
+        if (query_task_runner_->PostTask(
+                FROM_HERE,
+                base::Bind(&HistoryBackend::QueryHistoryBasicOnQueryDB,
+                           base::Unretained(query_db_.get()), request,
+                           options, first_recorded_time_, beginning_time))) {
+          return;
+        }
+      }
+
       // Basic history query for the main database.
-      QueryHistoryBasic(db_.get(), db_.get(), options, &request->value);
+      QueryHistoryBasic(db_.get(), db_.get(), options, first_recorded_time_,
+                        &request->value);
 
       // Now query the archived database. This is a bit tricky because we don't
       // want to query it if the queried time range isn't going to find anything
@@ -1268,10 +1315,30 @@ void HistoryBackend::QueryHistory(scoped_refptr<QueryHistoryRequest> request,
                       TimeTicks::Now() - beginning_time);
 }
 
+// static
+void HistoryBackend::QueryHistoryBasicOnQueryDB(
+    HistoryQueryDatabase* query_db,
+    scoped_refptr<QueryHistoryRequest> request,
+    const QueryOptions& options,
+    base::Time first_recorded_time,
+    base::TimeTicks beginning_time) {
+  if (request->canceled())
+    return;
+
+  QueryHistoryBasic(query_db, query_db, options, first_recorded_time,
+                    &request->value);
+  request->ForwardResult(request->handle(), &request->value);
+
+  UMA_HISTOGRAM_TIMES("History.QueryHistory",
+                      TimeTicks::Now() - beginning_time);
+}
+
 // Basic time-based querying of history.
+// static
 void HistoryBackend::QueryHistoryBasic(URLDatabase* url_db,
                                        VisitDatabase* visit_db,
                                        const QueryOptions& options,
+                                       base::Time first_recorded_time,
                                        QueryResults* result) {
   // First get all visits.
   VisitVector visits;
@@ -1297,16 +1364,6 @@ void HistoryBackend::QueryHistoryBasic(URLDatabase* url_db,
       continue;  // Don't report invalid URLs in case of corruption.
     }
 
-    // The archived database may be out of sync with respect to starring,
-    // titles, last visit date, etc. Therefore, we query the main DB if the
-    // current URL database is not the main one.
-    if (url_db == db_.get()) {
-      // Currently querying the archived DB, update with the main database to
-      // catch any interesting stuff. This will update it if it exists in the
-      // main DB, and do nothing otherwise.
-      db_->GetRowForURL(url_result.url(), &url_result);
-    }
-
     url_result.set_visit_time(visit.visit_time);
 
     // Set whether the visit was blocked for a managed user by looking at the
@@ -1319,7 +1376,7 @@ void HistoryBackend::QueryHistoryBasic(URLDatabase* url_db,
     result->AppendURLBySwapping(&url_result);
   }
 
-  if (!has_more_results && options.begin_time <= first_recorded_time_)
+  if (!has_more_results && options.begin_time <= first_recorded_time)
     result->set_reached_beginning(true);
 }
 
@@ -2591,7 +2648,8 @@ void HistoryBackend::ExpireHistoryForTimes(
   options.end_time = end_time;
   options.duplicate_policy = QueryOptions::KEEP_ALL_DUPLICATES;
   QueryResults results;
-  QueryHistoryBasic(db_.get(), db_.get(), options, &results);
+  QueryHistoryBasic(db_.get(), db_.get(), options, first_recorded_time_,
+                    &results);
 
   // 1st pass: find URLs that are visited at one of |times|.
   std::set<GURL> urls;
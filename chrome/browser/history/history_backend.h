@@ -14,6 +14,7 @@
 #include "base/files/file_path.h"
 #include "base/gtest_prod_util.h"
 #include "base/memory/memory_pressure_listener.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
 #include "chrome/browser/history/archived_database.h"
 #include "chrome/browser/history/expire_history_backend.h"
@@ -31,12 +32,17 @@ class TestingProfile;
 class TypedUrlSyncableService;
 struct ThumbnailScore;
 
+namespace base {
+class SequencedTaskRunner;
+}
+
 namespace history {
 #if defined(OS_ANDROID)
 class AndroidProviderBackend;
 #endif
 
 class CommitLaterTask;
+class HistoryQueryDatabase;
 class VisitFilter;
 struct DownloadRow;
 
@@ -131,6 +137,16 @@ class HistoryBackend : public base::RefCountedThreadSafe<HistoryBackend>,
   // |force_fail| can be set during unittests to unconditionally fail to init.
   void Init(const std::string& languages, bool force_fail);
 
+  // Lets QueryHistory() run queries without a text query on |task_runner|,
+  // over a second connection to the history database, so that they don't
+  // hold up the writes on the history thread. Falls back to querying on the
+  // history thread if that connection can't be opened. Must be called before
+  // Init().
+  void set_query_task_runner(
+      const scoped_refptr<base::SequencedTaskRunner>& task_runner) {
+    query_task_runner_ = task_runner;
+  }
+
   // Notification that the history system is shutting down. This will break
   // the refs owned by the delegate and any pending transaction so it will
   // actually be deleted.
@@ -613,14 +629,29 @@ class HistoryBackend : public base::RefCountedThreadSafe<HistoryBackend>,
   // The *Text() version performs a brute force query of the history DB to
   // search for results which match the given text query.
   // Both functions assume QueryHistory already checked the DB for validity.
-  void QueryHistoryBasic(URLDatabase* url_db, VisitDatabase* visit_db,
-                         const QueryOptions& options, QueryResults* result);
+  // |first_recorded_time| is the time of the first visit in the database,
+  // which tells whether the results reach back to the beginning of history.
+  static void QueryHistoryBasic(URLDatabase* url_db,
+                                VisitDatabase* visit_db,
+                                const QueryOptions& options,
+                                base::Time first_recorded_time,
+                                QueryResults* result);
   void QueryHistoryText(URLDatabase* url_db,
                         VisitDatabase* visit_db,
                         const base::string16& text_query,
                         const QueryOptions& options,
                         QueryResults* result);
 
+  // Runs QueryHistoryBasic() over |query_db| on |query_task_runner_| and
+  // forwards the results of |request|. |beginning_time| is when the request
+  // reached the history thread.
+  static void QueryHistoryBasicOnQueryDB(
+      HistoryQueryDatabase* query_db,
+      scoped_refptr<QueryHistoryRequest> request,
+      const QueryOptions& options,
+      base::Time first_recorded_time,
+      base::TimeTicks beginning_time);
+
   // Committing ----------------------------------------------------------------
 
   // We always keep a transaction open on the history database so that multiple
@@ -836,6 +867,12 @@ class HistoryBackend : public base::RefCountedThreadSafe<HistoryBackend>,
   // Stores old history in a larger, slower database.
   scoped_ptr<ArchivedDatabase> archived_db_;
 
+  // Where basic history queries run, and their connection to the history
+  // database. The connection is only used on |query_task_runner_| and is NULL
+  // if there is no task runner or it could not be opened.
+  scoped_refptr<base::SequencedTaskRunner> query_task_runner_;
+  scoped_ptr<HistoryQueryDatabase> query_db_;
+
   // Manages expiration between the various databases.
   ExpireHistoryBackend expirer_;
 
@@ -58,6 +58,12 @@ sql::InitStatus HistoryDatabase::Init(const base::FilePath& history_name) {
   // TODO(brettw) scale this value to the amount of available memory.
   db_.set_cache_size(1000);
 
+  // History is written on most navigations, so commit through a write-ahead
+  // log rather than rewriting the journal, and read the (typically large)
+  // file through a memory mapping.
+  db_.set_wal_mode();
+  db_.set_mmap_size(256 * 1024 * 1024);
+
   // Note that we don't set exclusive locking here. That's done by
   // BeginExclusiveMode below which is called later (we have to be in shared
   // mode to start out for the in-memory backend to read the data).
@@ -0,0 +1,51 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/history/history_query_database.h"
+
+#include "base/files/file_path.h"
+#include "base/logging.h"
+#include "sql/statement.h"
+
+namespace history {
+
+HistoryQueryDatabase::HistoryQueryDatabase() {
+}
+
+HistoryQueryDatabase::~HistoryQueryDatabase() {
+}
+
+bool HistoryQueryDatabase::Init(const base::FilePath& history_name) {
+  db_.set_histogram_tag("HistoryQuery");
+
+  // Queries walk large parts of the visits and urls tables, so use a cache
+  // about half the size of the main connection's.
+  db_.set_cache_size(500);
+  db_.set_wal_mode();
+  db_.set_mmap_size(256 * 1024 * 1024);
+
+  if (!db_.Open(history_name))
+    return false;
+
+  // In any other journal mode reading would take a lock which blocks the
+  // writes of the main connection, which is worse than not having this
+  // connection at all.
+  bool is_wal = false;
+  {
+    sql::Statement s(db_.GetUniqueStatement("PRAGMA journal_mode"));
+    is_wal = s.Step() && s.ColumnString(0) == "wal";
+  }
+  if (!is_wal) {
+    DLOG(WARNING) << "History database is not in WAL mode.";
+    db_.Close();
+    return false;
+  }
+  return true;
+}
+
+sql::Connection& HistoryQueryDatabase::GetDB() {
+  return db_;
+}
+
+}  // namespace history
@@ -0,0 +1,52 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CHROME_BROWSER_HISTORY_HISTORY_QUERY_DATABASE_H_
+#define CHROME_BROWSER_HISTORY_HISTORY_QUERY_DATABASE_H_
+
+#include "base/basictypes.h"
+#include "base/compiler_specific.h"
+#include "chrome/browser/history/url_database.h"
+#include "chrome/browser/history/visit_database.h"
+#include "sql/connection.h"
+
+namespace base {
+class FilePath;
+}
+
+namespace history {
+
+// A second connection to the main history database which is only used to
+// read from it, so that queries can run without waiting for the history
+// thread. This only works while the database is journaled with a write-ahead
+// log, which lets readers see the last committed state while the main
+// connection writes. Unlike HistoryDatabase it never creates or migrates
+// tables, so it must only be opened after HistoryDatabase::Init() succeeded.
+//
+// Like the other history databases this is not threadsafe, but it may be
+// used on a different thread (or sequence) than the one which opened it.
+class HistoryQueryDatabase : public URLDatabase,
+                             public VisitDatabase {
+ public:
+  // Must call Init() before using other members.
+  HistoryQueryDatabase();
+  virtual ~HistoryQueryDatabase();
+
+  // Opens the history database at |history_name|. Returns false if it could
+  // not be opened or is not in WAL mode, in which case the object must not
+  // be used.
+  bool Init(const base::FilePath& history_name);
+
+ private:
+  // Implemented for URLDatabase and VisitDatabase.
+  virtual sql::Connection& GetDB() OVERRIDE;
+
+  sql::Connection db_;
+
+  DISALLOW_COPY_AND_ASSIGN(HistoryQueryDatabase);
+};
+
+}  // namespace history
+
+#endif  // CHROME_BROWSER_HISTORY_HISTORY_QUERY_DATABASE_H_
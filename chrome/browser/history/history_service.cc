@@ -30,6 +30,7 @@
 #include "base/path_service.h"
 #include "base/prefs/pref_service.h"
 #include "base/thread_task_runner_handle.h"
+#include "base/threading/sequenced_worker_pool.h"
 #include "base/threading/thread.h"
 #include "base/time/time.h"
 #include "chrome/browser/autocomplete/history_url_provider.h"
@@ -1214,6 +1215,11 @@ void HistoryService::LoadBackendIfNecessary() {
                              base::ThreadTaskRunnerHandle::Get(),
                              profile_),
                          bookmark_service_));
+  // Let history page queries run on their own sequence so that they don't
+  // stall visit recording and expiration on the history thread.
+  base::SequencedWorkerPool* pool = content::BrowserThread::GetBlockingPool();
+  backend->set_query_task_runner(
+      pool->GetSequencedTaskRunner(pool->GetSequenceToken()));
   history_backend_.swap(backend);
 
   // There may not be a profile when unit testing.
@@ -5,12 +5,14 @@
 #include "chrome/browser/history/thumbnail_database.h"
 
 #include <algorithm>
+#include <set>
 #include <string>
 
 #include "base/bind.h"
 #include "base/debug/alias.h"
 #include "base/debug/dump_without_crashing.h"
 #include "base/file_util.h"
+#include "base/files/file_path.h"
 #include "base/format_macros.h"
 #include "base/memory/ref_counted_memory.h"
 #include "base/metrics/histogram.h"
@@ -61,9 +63,12 @@
 //  last_updated      The time at which this favicon was inserted into the
 //                    table. This is used to determine if it needs to be
 //                    redownloaded from the web.
-//  image_data        PNG encoded data of the favicon.
+//  image_data        PNG encoded data of the favicon, or NULL if it is
+//                    stored in a blob file.
 //  width             Pixel width of |image_data|.
 //  height            Pixel height of |image_data|.
+//  image_hash        SHA-1 of the PNG encoded data if it is stored in a
+//                    FaviconBlobStore file named by it, NULL otherwise.
 
 namespace {
 
@@ -75,6 +80,7 @@ namespace {
 // fatal (in fact, very old data may be expired immediately at startup
 // anyhow).
 
+// Version 8: adds favicon_bitmaps.image_hash for bitmaps in blob files.
 // Version 7: 911a634d/r209424 by qsr@chromium.org on 2013-07-01
 // Version 6: 610f923b/r152367 by pkotwicz@chromium.org on 2012-08-20
 // Version 5: e2ee8ae9/r105004 by groby@chromium.org on 2011-10-12
@@ -84,10 +90,21 @@ namespace {
 // Version number of the database.
 // NOTE(shess): When changing the version, add a new golden file for
 // the new version and a test to verify that Init() works with it.
-const int kCurrentVersionNumber = 7;
-const int kCompatibleVersionNumber = 7;
+const int kCurrentVersionNumber = 8;
+const int kCompatibleVersionNumber = 8;
 const int kDeprecatedVersionNumber = 4;  // and earlier.
 
+// Bitmaps at least this large are stored in blob files rather than inline.
+// Most favicons are much smaller, and a file per bitmap would take more space
+// and I/O than the row does.
+const size_t kMinBlobFileBytes = 4096;
+
+// Returns the directory the blob files of the database at |db_name| are kept
+// in.
+base::FilePath GetBlobDirectory(const base::FilePath& db_name) {
+  return base::FilePath(db_name.value() + FILE_PATH_LITERAL(" Blobs"));
+}
+
 void FillIconMapping(const sql::Statement& statement,
                      const GURL& page_url,
                      history::IconMapping* icon_mapping) {
@@ -308,7 +325,8 @@ bool InitTables(sql::Connection* db) {
       "last_updated INTEGER DEFAULT 0,"
       "image_data BLOB,"
       "width INTEGER DEFAULT 0,"
-      "height INTEGER DEFAULT 0"
+      "height INTEGER DEFAULT 0,"
+      "image_hash TEXT"
       ")";
   if (!db->Execute(kFaviconBitmapsSql))
     return false;
@@ -394,7 +412,7 @@ void RecoverDatabaseOrRaze(sql::Connection* db, const base::FilePath& db_path) {
   // NOTE(shess): This code is currently specific to the version
   // number.  I am working on simplifying things to loosen the
   // dependency, meanwhile contact me if you need to bump the version.
-  DCHECK_EQ(7, kCurrentVersionNumber);
+  DCHECK_EQ(8, kCurrentVersionNumber);
 
   // TODO(shess): Reset back after?
   db->reset_error_callback();
@@ -447,8 +465,9 @@ void RecoverDatabaseOrRaze(sql::Connection* db, const base::FilePath& db_path) {
   }
 
   // Earlier versions have been handled or deprecated, later versions should be
-  // impossible.
-  if (version != 7) {
+  // impossible.  Version 7 only lacks favicon_bitmaps.image_hash, which the
+  // recover virtual table fills in with NULL.
+  if (version != 7 && version != 8) {
     sql::Recovery::Unrecoverable(recovery.Pass());
     RecordRecoveryEvent(RECOVERY_EVENT_FAILED_META_WRONG_VERSION);
     return;
@@ -507,6 +526,8 @@ void RecoverDatabaseOrRaze(sql::Connection* db, const base::FilePath& db_path) {
   // This step is possibly not worth the effort necessary to develop
   // and sequence the statements, as it is basically a form of garbage
   // collection.
+  // Blob files are not touched here; the next Init() deletes those the
+  // recovered bitmaps no longer refer to.
 
   if (!sql::Recovery::Recovered(recovery.Pass())) {
     RecordRecoveryEvent(RECOVERY_EVENT_FAILED_COMMIT);
@@ -606,8 +627,14 @@ sql::InitStatus ThumbnailDatabase::Init(const base::FilePath& db_name) {
   sql::InitStatus status = sql::INIT_FAILURE;
   for (size_t i = 0; i < kAttempts; ++i) {
     status = InitImpl(db_name);
-    if (status == sql::INIT_OK)
+    if (status == sql::INIT_OK) {
+      // Without the blob store bitmaps are all stored inline.
+      if (blob_store_.Init(GetBlobDirectory(db_name)))
+        DeleteUnreferencedBlobs();
+      else
+        LOG(WARNING) << "Could not create the favicon blob directory.";
       return status;
+    }
 
     meta_table_.Reset();
     db_.Close();
@@ -673,8 +700,8 @@ bool ThumbnailDatabase::GetFaviconBitmaps(
     std::vector<FaviconBitmap>* favicon_bitmaps) {
   DCHECK(icon_id);
   sql::Statement statement(db_.GetCachedStatement(SQL_FROM_HERE,
-      "SELECT id, last_updated, image_data, width, height FROM favicon_bitmaps "
-      "WHERE icon_id=?"));
+      "SELECT id, last_updated, image_data, width, height, image_hash "
+      "FROM favicon_bitmaps WHERE icon_id=?"));
   statement.BindInt64(0, icon_id);
 
   bool result = false;
@@ -688,11 +715,7 @@ bool ThumbnailDatabase::GetFaviconBitmaps(
     favicon_bitmap.icon_id = icon_id;
     favicon_bitmap.last_updated =
         base::Time::FromInternalValue(statement.ColumnInt64(1));
-    if (statement.ColumnByteLength(2) > 0) {
-      scoped_refptr<base::RefCountedBytes> data(new base::RefCountedBytes());
-      statement.ColumnBlobAsVector(2, &data->data());
-      favicon_bitmap.bitmap_data = data;
-    }
+    favicon_bitmap.bitmap_data = GetBitmapData(statement, 2, 5);
     favicon_bitmap.pixel_size = gfx::Size(statement.ColumnInt(3),
                                           statement.ColumnInt(4));
     favicon_bitmaps->push_back(favicon_bitmap);
@@ -707,8 +730,8 @@ bool ThumbnailDatabase::GetFaviconBitmap(
     gfx::Size* pixel_size) {
   DCHECK(bitmap_id);
   sql::Statement statement(db_.GetCachedStatement(SQL_FROM_HERE,
-      "SELECT last_updated, image_data, width, height FROM favicon_bitmaps "
-      "WHERE id=?"));
+      "SELECT last_updated, image_data, width, height, image_hash "
+      "FROM favicon_bitmaps WHERE id=?"));
   statement.BindInt64(0, bitmap_id);
 
   if (!statement.Step())
@@ -717,10 +740,11 @@ bool ThumbnailDatabase::GetFaviconBitmap(
   if (last_updated)
     *last_updated = base::Time::FromInternalValue(statement.ColumnInt64(0));
 
-  if (png_icon_data && statement.ColumnByteLength(1) > 0) {
-    scoped_refptr<base::RefCountedBytes> data(new base::RefCountedBytes());
-    statement.ColumnBlobAsVector(1, &data->data());
-    *png_icon_data = data;
+  if (png_icon_data) {
+    scoped_refptr<base::RefCountedMemory> data =
+        GetBitmapData(statement, 1, 4);
+    if (data.get())
+      *png_icon_data = data;
   }
 
   if (pixel_size) {
@@ -738,14 +762,9 @@ FaviconBitmapID ThumbnailDatabase::AddFaviconBitmap(
   DCHECK(icon_id);
   sql::Statement statement(db_.GetCachedStatement(SQL_FROM_HERE,
       "INSERT INTO favicon_bitmaps (icon_id, image_data, last_updated, width, "
-      "height) VALUES (?, ?, ?, ?, ?)"));
+      "height, image_hash) VALUES (?, ?, ?, ?, ?, ?)"));
   statement.BindInt64(0, icon_id);
-  if (icon_data.get() && icon_data->size()) {
-    statement.BindBlob(1, icon_data->front(),
-                       static_cast<int>(icon_data->size()));
-  } else {
-    statement.BindNull(1);
-  }
+  BindBitmapData(&statement, 1, 5, icon_data);
   statement.BindInt64(2, time.ToInternalValue());
   statement.BindInt(3, pixel_size.width());
   statement.BindInt(4, pixel_size.height());
@@ -761,15 +780,11 @@ bool ThumbnailDatabase::SetFaviconBitmap(
     base::Time time) {
   DCHECK(bitmap_id);
   sql::Statement statement(db_.GetCachedStatement(SQL_FROM_HERE,
-      "UPDATE favicon_bitmaps SET image_data=?, last_updated=? WHERE id=?"));
-  if (bitmap_data.get() && bitmap_data->size()) {
-    statement.BindBlob(0, bitmap_data->front(),
-                       static_cast<int>(bitmap_data->size()));
-  } else {
-    statement.BindNull(0);
-  }
+      "UPDATE favicon_bitmaps SET image_data=?, last_updated=?, image_hash=? "
+      "WHERE id=?"));
+  BindBitmapData(&statement, 0, 2, bitmap_data);
   statement.BindInt64(1, time.ToInternalValue());
-  statement.BindInt64(2, bitmap_id);
+  statement.BindInt64(3, bitmap_id);
 
   return statement.Run();
 }
@@ -1076,9 +1091,9 @@ bool ThumbnailDatabase::RetainDataForPageUrls(
       "ALTER TABLE favicon_bitmaps RENAME TO old_favicon_bitmaps";
   const char kCopyFaviconBitmaps[] =
       "INSERT INTO favicon_bitmaps "
-      "  (icon_id, last_updated, image_data, width, height) "
+      "  (icon_id, last_updated, image_data, width, height, image_hash) "
       "SELECT mapping.new_icon_id, old.last_updated, "
-      "    old.image_data, old.width, old.height "
+      "    old.image_data, old.width, old.height, old.image_hash "
       "FROM old_favicon_bitmaps AS old "
       "JOIN temp.icon_id_mapping AS mapping "
       "ON (old.icon_id = mapping.old_icon_id)";
@@ -1122,7 +1137,11 @@ bool ThumbnailDatabase::RetainDataForPageUrls(
   if (!db_.Execute(kIconMappingDrop))
     return false;
 
-  return transaction.Commit();
+  if (!transaction.Commit())
+    return false;
+
+  DeleteUnreferencedBlobs();
+  return true;
 }
 
 sql::InitStatus ThumbnailDatabase::OpenDatabase(sql::Connection* db,
@@ -1141,6 +1160,10 @@ sql::InitStatus ThumbnailDatabase::OpenDatabase(sql::Connection* db,
   db->set_page_size(2048);
   db->set_cache_size(32);
 
+  // Favicons are read far more often than they are written, and the small
+  // cache above makes most reads go to the file.
+  db->set_mmap_size(64 * 1024 * 1024);
+
   // Run the database in exclusive mode. Nobody else should be accessing the
   // database while we're running, and this will give somewhat improved perf.
   db->set_exclusive_locking();
@@ -1237,6 +1260,12 @@ sql::InitStatus ThumbnailDatabase::InitImpl(const base::FilePath& db_name) {
       return CantUpgradeToVersion(cur_version);
   }
 
+  if (cur_version == 7) {
+    ++cur_version;
+    if (!UpgradeToVersion8())
+      return CantUpgradeToVersion(cur_version);
+  }
+
   LOG_IF(WARNING, cur_version < kCurrentVersionNumber) <<
       "Thumbnail database version " << cur_version << " is too old to handle.";
 
@@ -1317,8 +1346,72 @@ bool ThumbnailDatabase::UpgradeToVersion7() {
   return true;
 }
 
+bool ThumbnailDatabase::UpgradeToVersion8() {
+  // Tables created by this version's InitTables() already have the column.
+  if (!db_.DoesColumnExist("favicon_bitmaps", "image_hash") &&
+      !db_.Execute("ALTER TABLE favicon_bitmaps ADD COLUMN image_hash TEXT")) {
+    return false;
+  }
+
+  meta_table_.SetVersionNumber(8);
+  meta_table_.SetCompatibleVersionNumber(std::min(8, kCompatibleVersionNumber));
+  return true;
+}
+
 bool ThumbnailDatabase::IsFaviconDBStructureIncorrect() {
   return !db_.IsSQLValid("SELECT id, url, icon_type FROM favicons");
 }
 
+scoped_refptr<base::RefCountedMemory> ThumbnailDatabase::GetBitmapData(
+    const sql::Statement& statement,
+    int image_data_col,
+    int image_hash_col) {
+  std::string hash = statement.ColumnString(image_hash_col);
+  if (!hash.empty())
+    return blob_store_.Get(hash);
+
+  if (statement.ColumnByteLength(image_data_col) <= 0)
+    return NULL;
+  scoped_refptr<base::RefCountedBytes> data(new base::RefCountedBytes());
+  statement.ColumnBlobAsVector(image_data_col, &data->data());
+  return data;
+}
+
+void ThumbnailDatabase::BindBitmapData(
+    sql::Statement* statement,
+    int image_data_param,
+    int image_hash_param,
+    const scoped_refptr<base::RefCountedMemory>& bitmap_data) {
+  if (!bitmap_data.get() || !bitmap_data->size()) {
+    statement->BindNull(image_data_param);
+    statement->BindNull(image_hash_param);
+    return;
+  }
+
+  std::string hash;
+  if (bitmap_data->size() >= kMinBlobFileBytes &&
+      blob_store_.Put(*bitmap_data.get(), &hash)) {
+    statement->BindNull(image_data_param);
+    statement->BindString(image_hash_param, hash);
+    return;
+  }
+
+  statement->BindBlob(image_data_param, bitmap_data->front(),
+                      static_cast<int>(bitmap_data->size()));
+  statement->BindNull(image_hash_param);
+}
+
+void ThumbnailDatabase::DeleteUnreferencedBlobs() {
+  sql::Statement statement(db_.GetUniqueStatement(
+      "SELECT DISTINCT image_hash FROM favicon_bitmaps "
+      "WHERE image_hash IS NOT NULL"));
+  std::set<std::string> hashes;
+  while (statement.Step())
+    hashes.insert(statement.ColumnString(0));
+  // Don't delete everything because the table could not be read.
+  if (!statement.Succeeded())
+    return;
+  blob_store_.DeleteAllExcept(hashes);
+}
+
 }  // namespace history
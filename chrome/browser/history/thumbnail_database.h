@@ -9,6 +9,7 @@
 
 #include "base/gtest_prod_util.h"
 #include "base/memory/ref_counted.h"
+#include "chrome/browser/history/favicon_blob_store.h"
 #include "chrome/browser/history/history_types.h"
 #include "sql/connection.h"
 #include "sql/init_status.h"
@@ -230,12 +231,14 @@ class ThumbnailDatabase {
   bool RetainDataForPageUrls(const std::vector<GURL>& urls_to_keep);
 
  private:
+  FRIEND_TEST_ALL_PREFIXES(ThumbnailDatabaseTest, LargeBitmapsInBlobFiles);
   FRIEND_TEST_ALL_PREFIXES(ThumbnailDatabaseTest, RetainDataForPageUrls);
   FRIEND_TEST_ALL_PREFIXES(ThumbnailDatabaseTest, Version3);
   FRIEND_TEST_ALL_PREFIXES(ThumbnailDatabaseTest, Version4);
   FRIEND_TEST_ALL_PREFIXES(ThumbnailDatabaseTest, Version5);
   FRIEND_TEST_ALL_PREFIXES(ThumbnailDatabaseTest, Version6);
   FRIEND_TEST_ALL_PREFIXES(ThumbnailDatabaseTest, Version7);
+  FRIEND_TEST_ALL_PREFIXES(ThumbnailDatabaseTest, Version8);
   FRIEND_TEST_ALL_PREFIXES(ThumbnailDatabaseTest, WildSchema);
 
   // Open database on a given filename. If the file does not exist,
@@ -259,11 +262,36 @@ class ThumbnailDatabase {
   // Removes sizes column.
   bool UpgradeToVersion7();
 
+  // Adds the image_hash column for bitmaps stored in |blob_store_|.
+  bool UpgradeToVersion8();
+
   // Returns true if the |favicons| database is missing a column.
   bool IsFaviconDBStructureIncorrect();
 
+  // Returns the bitmap data of the current row of |statement|, which is either
+  // stored inline in |image_data_col| or in |blob_store_| under the hash in
+  // |image_hash_col|. Returns NULL if there is no data.
+  scoped_refptr<base::RefCountedMemory> GetBitmapData(
+      const sql::Statement& statement,
+      int image_data_col,
+      int image_hash_col);
+
+  // Binds |bitmap_data| to the image_data and image_hash parameters of
+  // |statement|. Large bitmaps are moved to |blob_store_|, leaving only their
+  // hash in the database.
+  void BindBitmapData(sql::Statement* statement,
+                      int image_data_param,
+                      int image_hash_param,
+                      const scoped_refptr<base::RefCountedMemory>& bitmap_data);
+
+  // Deletes the blobs which no bitmap refers to any more. Bitmaps don't
+  // release their blob when they are updated or deleted, so this runs after
+  // Init() and RetainDataForPageUrls().
+  void DeleteUnreferencedBlobs();
+
   sql::Connection db_;
   sql::MetaTable meta_table_;
+  FaviconBlobStore blob_store_;
 };
 
 }  // namespace history
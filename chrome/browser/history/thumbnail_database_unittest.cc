@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "base/basictypes.h"
+#include "base/file_util.h"
 #include "base/files/file_enumerator.h"
 #include "base/files/file_path.h"
 #include "base/files/scoped_temp_dir.h"
@@ -78,8 +79,9 @@ void VerifyTablesAndColumns(sql::Connection* db) {
   // [id], [url], and [icon_type].
   EXPECT_EQ(3u, sql::test::CountTableColumns(db, "favicons"));
 
-  // [id], [icon_id], [last_updated], [image_data], [width], and [height].
-  EXPECT_EQ(6u, sql::test::CountTableColumns(db, "favicon_bitmaps"));
+  // [id], [icon_id], [last_updated], [image_data], [width], [height], and
+  // [image_hash].
+  EXPECT_EQ(7u, sql::test::CountTableColumns(db, "favicon_bitmaps"));
 
   // [id], [page_url], and [icon_id].
   EXPECT_EQ(3u, sql::test::CountTableColumns(db, "icon_mapping"));
@@ -389,6 +391,72 @@ TEST_F(ThumbnailDatabaseTest, DeleteFavicon) {
   EXPECT_FALSE(db.GetFaviconBitmaps(id, NULL));
 }
 
+// Test that large bitmaps are stored once in a blob file, and that the file
+// is deleted once no bitmap refers to it.
+TEST_F(ThumbnailDatabaseTest, LargeBitmapsInBlobFiles) {
+  const base::FilePath blob_dir(
+      file_name_.value() + FILE_PATH_LITERAL(" Blobs"));
+  std::vector<unsigned char> data(8192, 'x');
+  scoped_refptr<base::RefCountedBytes> large_bitmap(
+      new base::RefCountedBytes(data));
+
+  chrome::FaviconID id1 = 0;
+  chrome::FaviconID id2 = 0;
+  {
+    ThumbnailDatabase db;
+    ASSERT_EQ(sql::INIT_OK, db.Init(file_name_));
+    id1 = db.AddFavicon(kIconUrl1, chrome::TOUCH_ICON, large_bitmap,
+                        base::Time::Now(), kLargeSize);
+    id2 = db.AddFavicon(kIconUrl3, chrome::TOUCH_ICON, large_bitmap,
+                        base::Time::Now(), kLargeSize);
+    ASSERT_NE(0, id1);
+    ASSERT_NE(0, id2);
+
+    // Only the hash is in the database.
+    sql::Statement statement(db.db_.GetUniqueStatement(
+        "SELECT COUNT(*) FROM favicon_bitmaps "
+        "WHERE image_data IS NULL AND image_hash IS NOT NULL"));
+    ASSERT_TRUE(statement.Step());
+    EXPECT_EQ(2, statement.ColumnInt(0));
+
+    std::vector<FaviconBitmap> favicon_bitmaps;
+    ASSERT_TRUE(db.GetFaviconBitmaps(id2, &favicon_bitmaps));
+    ASSERT_EQ(1u, favicon_bitmaps.size());
+    ASSERT_TRUE(favicon_bitmaps[0].bitmap_data.get());
+    EXPECT_TRUE(favicon_bitmaps[0].bitmap_data->Equals(large_bitmap));
+  }
+
+  // Both bitmaps share one file.
+  base::FileEnumerator enumerator(blob_dir, false,
+                                  base::FileEnumerator::FILES);
+  EXPECT_FALSE(enumerator.Next().empty());
+  EXPECT_TRUE(enumerator.Next().empty());
+
+  // The file stays while a bitmap refers to it.
+  {
+    ThumbnailDatabase db;
+    ASSERT_EQ(sql::INIT_OK, db.Init(file_name_));
+    EXPECT_TRUE(db.DeleteFavicon(id1));
+  }
+  {
+    ThumbnailDatabase db;
+    ASSERT_EQ(sql::INIT_OK, db.Init(file_name_));
+    std::vector<FaviconBitmap> favicon_bitmaps;
+    ASSERT_TRUE(db.GetFaviconBitmaps(id2, &favicon_bitmaps));
+    ASSERT_EQ(1u, favicon_bitmaps.size());
+    ASSERT_TRUE(favicon_bitmaps[0].bitmap_data.get());
+    EXPECT_TRUE(favicon_bitmaps[0].bitmap_data->Equals(large_bitmap));
+    EXPECT_TRUE(db.DeleteFavicon(id2));
+  }
+
+  // And is deleted by the next Init() once it is unreferenced.
+  {
+    ThumbnailDatabase db;
+    ASSERT_EQ(sql::INIT_OK, db.Init(file_name_));
+  }
+  EXPECT_TRUE(base::IsDirectoryEmpty(blob_dir));
+}
+
 TEST_F(ThumbnailDatabaseTest, GetIconMappingsForPageURLForReturnOrder) {
   ThumbnailDatabase db;
   ASSERT_EQ(sql::INIT_OK, db.Init(file_name_));
@@ -705,6 +773,22 @@ TEST_F(ThumbnailDatabaseTest, Version7) {
                                kIconUrl3, kLargeSize, sizeof(kBlob2), kBlob2));
 }
 
+// Test loading version 8 database.
+TEST_F(ThumbnailDatabaseTest, Version8) {
+  scoped_ptr<ThumbnailDatabase> db = LoadFromGolden("Favicons.v8.sql");
+  ASSERT_TRUE(db.get() != NULL);
+  VerifyTablesAndColumns(&db->db_);
+
+  EXPECT_TRUE(CheckPageHasIcon(db.get(), kPageUrl1, chrome::FAVICON,
+                               kIconUrl1, kLargeSize, sizeof(kBlob1), kBlob1));
+  EXPECT_TRUE(CheckPageHasIcon(db.get(), kPageUrl2, chrome::FAVICON,
+                               kIconUrl2, kLargeSize, sizeof(kBlob2), kBlob2));
+  EXPECT_TRUE(CheckPageHasIcon(db.get(), kPageUrl3, chrome::FAVICON,
+                               kIconUrl1, kLargeSize, sizeof(kBlob1), kBlob1));
+  EXPECT_TRUE(CheckPageHasIcon(db.get(), kPageUrl3, chrome::TOUCH_ICON,
+                               kIconUrl3, kLargeSize, sizeof(kBlob2), kBlob2));
+}
+
 TEST_F(ThumbnailDatabaseTest, Recovery) {
   // This code tests the recovery module in concert with Chromium's
   // custom recover virtual table.  Under USE_SYSTEM_SQLITE, this is
@@ -717,7 +801,7 @@ TEST_F(ThumbnailDatabaseTest, Recovery) {
 
   // Create an example database.
   {
-    EXPECT_TRUE(CreateDatabaseFromSQL(file_name_, "Favicons.v7.sql"));
+    EXPECT_TRUE(CreateDatabaseFromSQL(file_name_, "Favicons.v8.sql"));
 
     sql::Connection raw_db;
     EXPECT_TRUE(raw_db.Open(file_name_));
@@ -11,10 +11,12 @@
 #include "base/bind_helpers.h"
 #include "base/command_line.h"
 #include "base/compiler_specific.h"
+#include "base/files/file_path.h"
 #include "base/debug/leak_tracker.h"
 #include "base/debug/trace_event.h"
 #include "base/logging.h"
 #include "base/metrics/field_trial.h"
+#include "base/path_service.h"
 #include "base/prefs/pref_registry_simple.h"
 #include "base/prefs/pref_service.h"
 #include "base/stl_util.h"
@@ -39,7 +41,9 @@
 #include "chrome/browser/net/pref_proxy_config_tracker.h"
 #include "chrome/browser/net/proxy_service_factory.h"
 #include "chrome/browser/net/sdch_dictionary_fetcher.h"
+#include "chrome/browser/net/ssl_session_cache_persister.h"
 #include "chrome/browser/net/spdyproxy/http_auth_handler_spdyproxy.h"
+#include "chrome/common/chrome_paths.h"
 #include "chrome/common/chrome_switches.h"
 #include "chrome/common/chrome_version_info.h"
 #include "chrome/common/pref_names.h"
@@ -59,6 +63,7 @@
 #include "net/cert/multi_threaded_cert_verifier.h"
 #include "net/cookies/cookie_store.h"
 #include "net/dns/host_cache.h"
+#include "net/dns/host_cache_persister.h"
 #include "net/dns/host_resolver.h"
 #include "net/dns/mapped_host_resolver.h"
 #include "net/dns/mapped_ip_resolver.h"
@@ -130,6 +135,12 @@ const char kQuicFieldTrialPacketLengthSuffix[] = "BytePackets";
 const char kSpdyFieldTrialName[] = "SPDY";
 const char kSpdyFieldTrialDisabledGroupName[] = "SpdyDisabled";
 
+const base::FilePath::CharType kHostCacheFilename[] =
+    FILE_PATH_LITERAL("Host Cache");
+
+const base::FilePath::CharType kSSLSessionsFilename[] =
+    FILE_PATH_LITERAL("SSL Sessions");
+
 #if defined(OS_MACOSX) && !defined(OS_IOS)
 void ObserveKeychainEvents() {
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
@@ -187,6 +198,19 @@ scoped_ptr<net::HostResolver> CreateGlobalHostResolver(net::NetLog* net_log) {
     }
   }
 
+  // Serve expired cache entries to slow requests, if requested.
+  if (command_line.HasSwitch(switches::kHostResolverStaleDelayMs)) {
+    std::string s =
+        command_line.GetSwitchValueASCII(switches::kHostResolverStaleDelayMs);
+    // Parse the switch (it should be a positive integer).
+    int n;
+    if (base::StringToInt(s, &n) && n > 0) {
+      options.stale_result_delay = base::TimeDelta::FromMilliseconds(n);
+    } else {
+      LOG(ERROR) << "Invalid switch for host resolver stale delay: " << s;
+    }
+  }
+
   scoped_ptr<net::HostResolver> global_host_resolver(
       net::HostResolver::CreateSystemResolver(options, net_log));
 
@@ -565,6 +589,28 @@ void IOThread::InitAsync() {
   globals_->system_network_delegate.reset(network_delegate);
   globals_->host_resolver = CreateGlobalHostResolver(net_log_);
   UpdateDnsClientEnabled();
+  base::FilePath user_data_dir;
+  if (command_line.HasSwitch(switches::kHostResolverStaleDelayMs) &&
+      globals_->host_resolver->GetHostCache() &&
+      PathService::Get(chrome::DIR_USER_DATA, &user_data_dir)) {
+    base::SequencedWorkerPool* pool = BrowserThread::GetBlockingPool();
+    globals_->host_cache_persister.reset(new net::HostCachePersister(
+        globals_->host_resolver->GetHostCache(),
+        user_data_dir.Append(kHostCacheFilename),
+        pool->GetSequencedTaskRunnerWithShutdownBehavior(
+            pool->GetSequenceToken(),
+            base::SequencedWorkerPool::BLOCK_SHUTDOWN).get()));
+  }
+  if (command_line.HasSwitch(switches::kPersistSSLSessions) &&
+      PathService::Get(chrome::DIR_USER_DATA, &user_data_dir)) {
+    base::SequencedWorkerPool* pool = BrowserThread::GetBlockingPool();
+    globals_->ssl_session_cache_persister.reset(
+        new chrome_browser_net::SSLSessionCachePersister(
+            user_data_dir.Append(kSSLSessionsFilename),
+            pool->GetSequencedTaskRunnerWithShutdownBehavior(
+                pool->GetSequenceToken(),
+                base::SequencedWorkerPool::BLOCK_SHUTDOWN).get()));
+  }
 #if defined(OS_CHROMEOS)
   if (chromeos::UserManager::IsMultipleProfilesAllowed()) {
     // Creates a CertVerifyProc that doesn't allow any profile-provided certs.
@@ -31,6 +31,7 @@ class SystemURLRequestContextGetter;
 namespace chrome_browser_net {
 class DnsProbeService;
 class HttpPipeliningCompatibilityClient;
+class SSLSessionCachePersister;
 }
 
 namespace extensions {
@@ -42,6 +43,7 @@ class CertVerifier;
 class CookieStore;
 class CTVerifier;
 class FtpTransactionFactory;
+class HostCachePersister;
 class HostMappingRules;
 class HostResolver;
 class HttpAuthHandlerFactory;
@@ -111,6 +113,11 @@ class IOThread : public content::BrowserThreadDelegate {
     // The "system" NetworkDelegate, used for Profile-agnostic network events.
     scoped_ptr<net::NetworkDelegate> system_network_delegate;
     scoped_ptr<net::HostResolver> host_resolver;
+    // Saves the cache of |host_resolver| on shutdown, so it is destroyed
+    // first.
+    scoped_ptr<net::HostCachePersister> host_cache_persister;
+    scoped_ptr<chrome_browser_net::SSLSessionCachePersister>
+        ssl_session_cache_persister;
     scoped_ptr<net::CertVerifier> cert_verifier;
     // The ServerBoundCertService must outlive the HttpTransactionFactory.
     scoped_ptr<net::ServerBoundCertService> system_server_bound_cert_service;
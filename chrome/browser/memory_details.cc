@@ -81,6 +81,7 @@ std::string ProcessMemoryInformation::GetFullTypeNameInEnglish(
 
 ProcessMemoryInformation::ProcessMemoryInformation()
     : pid(0),
+      private_dirty(0),
       num_processes(0),
       is_diagnostics(false),
       process_type(content::PROCESS_TYPE_UNKNOWN),
@@ -412,6 +413,11 @@ void MemoryDetails::UpdateHistograms() {
           default:
             // TODO(erikkay): Should we bother splitting out the other subtypes?
             UMA_HISTOGRAM_MEMORY_KB("Memory.Renderer", sample);
+#if defined(OS_LINUX)
+            UMA_HISTOGRAM_MEMORY_KB(
+                "Memory.RendererPrivateDirty",
+                static_cast<int>(browser.processes[index].private_dirty));
+#endif
             renderer_count++;
             continue;
         }
@@ -45,6 +45,10 @@ struct ProcessMemoryInformation {
   base::ProcessId pid;
   // The working set information.
   base::WorkingSetKBytes working_set;
+  // The KB the process has written to and shares with no other process, so
+  // this leaves out pages still shared copy-on-write with the zygote.
+  // Linux only.
+  size_t private_dirty;
   // The committed bytes.
   base::CommittedKBytes committed;
   // The process version
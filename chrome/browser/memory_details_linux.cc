@@ -130,6 +130,7 @@ static ProcessData GetProcessDataMemoryInformation(
     base::ProcessMetrics* metrics =
         base::ProcessMetrics::CreateProcessMetrics(*iter);
     metrics->GetWorkingSetKBytes(&pmi.working_set);
+    metrics->GetPrivateDirtyKBytes(&pmi.private_dirty);
     delete metrics;
 
     process_data.processes.push_back(pmi);
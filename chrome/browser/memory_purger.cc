@@ -8,6 +8,9 @@
 
 #include "base/allocator/allocator_extension.h"
 #include "base/bind.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/metrics/histogram.h"
+#include "base/process/process_metrics.h"
 #include "base/threading/thread.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/browser/history/history_service.h"
@@ -27,10 +30,29 @@
 #include "net/url_request/url_request_context.h"
 #include "net/url_request/url_request_context_getter.h"
 
+#if defined(OS_CHROMEOS)
+#include "chrome/browser/browser_process_platform_part_chromeos.h"
+#include "chrome/browser/chromeos/memory/oom_priority_manager.h"
+#endif
+
 using content::BrowserContext;
 using content::BrowserThread;
 using content::ResourceContext;
 
+namespace {
+
+base::ProcessMetrics* CreateCurrentProcessMetrics() {
+#if !defined(OS_MACOSX)
+  return base::ProcessMetrics::CreateProcessMetrics(
+      base::GetCurrentProcessHandle());
+#else
+  return base::ProcessMetrics::CreateProcessMetrics(
+      base::GetCurrentProcessHandle(), NULL);
+#endif
+}
+
+}  // namespace
+
 // PurgeMemoryHelper -----------------------------------------------------------
 
 // This is a small helper class used to ensure that the objects we want to use
@@ -150,14 +172,75 @@ void MemoryPurger::PurgeRenderers() {
   // Concern: Telling a bunch of renderer processes to destroy their data may
   // cause them to page everything in to do it, which could take a lot of time/
   // cause jank.
-  for (content::RenderProcessHost::iterator i(
-          content::RenderProcessHost::AllHostsIterator());
-       !i.IsAtEnd(); i.Advance())
-    PurgeRendererForHost(i.GetCurrentValue());
+  PurgeRenderersForPressure(true);
 }
 
 // static
 void MemoryPurger::PurgeRendererForHost(content::RenderProcessHost* host) {
   // Direct the renderer to free everything it can.
-  host->Send(new ChromeViewMsg_PurgeMemory());
+  host->Send(new ChromeViewMsg_PurgeMemory(true));
+}
+
+// static
+void MemoryPurger::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  bool critical = memory_pressure_level ==
+      base::MemoryPressureListener::MEMORY_PRESSURE_CRITICAL;
+
+  // Only the work done on this thread is measured; the IO thread and the
+  // renderers purge asynchronously (the renderers record their own share).
+  scoped_ptr<base::ProcessMetrics> metrics(CreateCurrentProcessMetrics());
+  size_t working_set_before = metrics->GetWorkingSetSize();
+
+  if (critical)
+    PurgeBrowser();
+  else
+    PurgeBrowserCaches();
+  PurgeRenderersForPressure(critical);
+
+  size_t working_set_after = metrics->GetWorkingSetSize();
+  int purged_kb = working_set_before > working_set_after ?
+      static_cast<int>((working_set_before - working_set_after) / 1024) : 0;
+  if (critical)
+    UMA_HISTOGRAM_MEMORY_KB("Memory.Browser.PurgedKB.Critical", purged_kb);
+  else
+    UMA_HISTOGRAM_MEMORY_KB("Memory.Browser.PurgedKB.Moderate", purged_kb);
+
+#if defined(OS_CHROMEOS)
+  // Purging caches is not enough when the pressure is critical; give up the
+  // least valuable background tab too.
+  if (critical)
+    g_browser_process->platform_part()->oom_priority_manager()->DiscardTab();
+#endif
+}
+
+// static
+void MemoryPurger::PurgeBrowserCaches() {
+  // Dump the backing stores.
+  content::RenderWidgetHost::RemoveAllBackingStores();
+
+  // Let the IO thread purge what it can. The history and web databases stay
+  // loaded, since reopening them is expensive.
+  scoped_refptr<PurgeMemoryIOHelper> purge_memory_io_helper(
+      new PurgeMemoryIOHelper());
+  ProfileManager* profile_manager = g_browser_process->profile_manager();
+  std::vector<Profile*> profiles(profile_manager->GetLoadedProfiles());
+  for (size_t i = 0; i < profiles.size(); ++i) {
+    purge_memory_io_helper->AddRequestContextGetter(
+        make_scoped_refptr(profiles[i]->GetRequestContext()));
+  }
+  BrowserThread::PostTask(
+      BrowserThread::IO, FROM_HERE,
+      base::Bind(&PurgeMemoryIOHelper::PurgeMemoryOnIOThread,
+                 purge_memory_io_helper.get()));
+
+  base::allocator::ReleaseFreeMemory();
+}
+
+// static
+void MemoryPurger::PurgeRenderersForPressure(bool critical) {
+  for (content::RenderProcessHost::iterator i(
+          content::RenderProcessHost::AllHostsIterator());
+       !i.IsAtEnd(); i.Advance())
+    i.GetCurrentValue()->Send(new ChromeViewMsg_PurgeMemory(critical));
 }
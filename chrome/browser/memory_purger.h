@@ -14,6 +14,7 @@
 #define CHROME_BROWSER_MEMORY_PURGER_H_
 
 #include "base/basictypes.h"
+#include "base/memory/memory_pressure_listener.h"
 
 namespace content {
 class RenderProcessHost;
@@ -27,7 +28,21 @@ class MemoryPurger {
   static void PurgeRenderers();
   static void PurgeRendererForHost(content::RenderProcessHost* host);
 
+  // Purges memory in tiers, for use as a base::MemoryPressureListener
+  // callback. Moderate pressure only drops caches that are cheap to rebuild,
+  // in the browser and in the renderers. Critical pressure purges as much as
+  // PurgeAll() does and, where supported, discards a background tab. The
+  // memory reclaimed in the browser is recorded per tier.
+  static void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+
  private:
+  // Drops the browser caches that are cheap to rebuild.
+  static void PurgeBrowserCaches();
+
+  // Tells the renderers to purge, all of their caches if |critical|.
+  static void PurgeRenderersForPressure(bool critical);
+
   DISALLOW_IMPLICIT_CONSTRUCTORS(MemoryPurger);
 };
 
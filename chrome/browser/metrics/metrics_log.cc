@@ -293,9 +293,10 @@ void WriteProfilerData(const ProcessDataSnapshot& profiler_data,
         MetricsLogBase::Hash(it->birth.location.function_name));
     tracked_object->set_source_line_number(it->birth.location.line_number);
     tracked_object->set_exec_count(death_data.count);
-    tracked_object->set_exec_time_total(death_data.run_duration_sum);
+    tracked_object->set_exec_time_total(death_data.EstimatedRunDurationSum());
     tracked_object->set_exec_time_sampled(death_data.run_duration_sample);
-    tracked_object->set_queue_time_total(death_data.queue_duration_sum);
+    tracked_object->set_queue_time_total(
+        death_data.EstimatedQueueDurationSum());
     tracked_object->set_queue_time_sampled(death_data.queue_duration_sample);
     tracked_object->set_process_type(AsProtobufProcessType(process_type));
     tracked_object->set_process_id(profiler_data.process_id);
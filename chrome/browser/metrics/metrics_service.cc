@@ -179,7 +179,9 @@
 #include "base/rand_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task_runner_util.h"
 #include "base/threading/platform_thread.h"
+#include "base/threading/sequenced_worker_pool.h"
 #include "base/threading/thread.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/tracked_objects.h"
@@ -1590,27 +1592,58 @@ void MetricsService::PrepareInitialMetricsLog(MetricsLog::LogType log_type) {
 void MetricsService::SendStagedLog() {
   DCHECK(log_manager_.has_staged_log());
 
-  PrepareFetchWithStagedLog();
+  DCHECK(!waiting_for_asynchronous_reporting_step_);
+  waiting_for_asynchronous_reporting_step_ = true;
+
+  std::string* compressed_log_text = new std::string;
+  base::PostTaskAndReplyWithResult(
+      BrowserThread::GetBlockingPool(),
+      FROM_HERE,
+      base::Bind(&chrome::GzipCompress,
+                 log_manager_.staged_log_text(),
+                 compressed_log_text),
+      base::Bind(&MetricsService::OnStagedLogCompressed,
+                 self_ptr_factory_.GetWeakPtr(),
+                 log_manager_.staged_log_hash(),
+                 base::Owned(compressed_log_text)));
+}
+
+void MetricsService::OnStagedLogCompressed(
+    const std::string& log_hash,
+    const std::string* compressed_log_text,
+    bool compression_successful) {
+  DCHECK(waiting_for_asynchronous_reporting_step_);
+  DCHECK(compression_successful);
+
+  if (!log_manager_.has_staged_log() ||
+      log_manager_.staged_log_hash() != log_hash) {
+    // The log was discarded or replaced while it was being compressed.
+    waiting_for_asynchronous_reporting_step_ = false;
+    scheduler_->UploadCancelled();
+    return;
+  }
+
+  if (compression_successful)
+    PrepareFetchWithStagedLog(*compressed_log_text);
 
   bool upload_created = (current_fetch_.get() != NULL);
   UMA_HISTOGRAM_BOOLEAN("UMA.UploadCreation", upload_created);
   if (!upload_created) {
     // Compression failed, and log discarded :-/.
     // Skip this upload and hope things work out next time.
+    waiting_for_asynchronous_reporting_step_ = false;
     log_manager_.DiscardStagedLog();
     scheduler_->UploadCancelled();
     return;
   }
 
-  DCHECK(!waiting_for_asynchronous_reporting_step_);
-  waiting_for_asynchronous_reporting_step_ = true;
-
   current_fetch_->Start();
 
   HandleIdleSinceLastTransmission(true);
 }
 
-void MetricsService::PrepareFetchWithStagedLog() {
+void MetricsService::PrepareFetchWithStagedLog(
+    const std::string& compressed_log_text) {
   DCHECK(log_manager_.has_staged_log());
 
   // Prepare the protobuf version.
@@ -1621,28 +1654,22 @@ void MetricsService::PrepareFetchWithStagedLog() {
     current_fetch_->SetRequestContext(
         g_browser_process->system_request_context());
 
-    std::string log_text = log_manager_.staged_log_text();
-    std::string compressed_log_text;
-    bool compression_successful = chrome::GzipCompress(log_text,
-                                                       &compressed_log_text);
-    DCHECK(compression_successful);
-    if (compression_successful) {
-      current_fetch_->SetUploadData(kMimeType, compressed_log_text);
-      // Tell the server that we're uploading gzipped protobufs.
-      current_fetch_->SetExtraRequestHeaders("content-encoding: gzip");
-      const std::string hash =
-          base::HexEncode(log_manager_.staged_log_hash().data(),
-                          log_manager_.staged_log_hash().size());
-      DCHECK(!hash.empty());
-      current_fetch_->AddExtraRequestHeader("X-Chrome-UMA-Log-SHA1: " + hash);
-      UMA_HISTOGRAM_PERCENTAGE(
-          "UMA.ProtoCompressionRatio",
-          100 * compressed_log_text.size() / log_text.size());
-      UMA_HISTOGRAM_CUSTOM_COUNTS(
-          "UMA.ProtoGzippedKBSaved",
-          (log_text.size() - compressed_log_text.size()) / 1024,
-          1, 2000, 50);
-    }
+    const std::string& log_text = log_manager_.staged_log_text();
+    current_fetch_->SetUploadData(kMimeType, compressed_log_text);
+    // Tell the server that we're uploading gzipped protobufs.
+    current_fetch_->SetExtraRequestHeaders("content-encoding: gzip");
+    const std::string hash =
+        base::HexEncode(log_manager_.staged_log_hash().data(),
+                        log_manager_.staged_log_hash().size());
+    DCHECK(!hash.empty());
+    current_fetch_->AddExtraRequestHeader("X-Chrome-UMA-Log-SHA1: " + hash);
+    UMA_HISTOGRAM_PERCENTAGE(
+        "UMA.ProtoCompressionRatio",
+        100 * compressed_log_text.size() / log_text.size());
+    UMA_HISTOGRAM_CUSTOM_COUNTS(
+        "UMA.ProtoGzippedKBSaved",
+        (log_text.size() - compressed_log_text.size()) / 1024,
+        1, 2000, 50);
 
     // We already drop cookies server-side, but we might as well strip them out
     // client-side as well.
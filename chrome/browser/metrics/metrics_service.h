@@ -434,13 +434,22 @@ class MetricsService
   // profiler data, as well as incremental stability-related metrics.
   void PrepareInitialMetricsLog(MetricsLog::LogType log_type);
 
-  // Uploads the currently staged log (which must be non-null).
+  // Uploads the currently staged log (which must be non-null). The log is
+  // first compressed on the blocking pool, so that compressing a large log
+  // doesn't jank the UI thread; the upload starts in OnStagedLogCompressed().
   void SendStagedLog();
 
+  // Called on the UI thread once the staged log, whose hash is |log_hash|, has
+  // been compressed to |compressed_log_text|. Starts the upload, or cancels it
+  // if compression failed or the staged log has changed in the meantime.
+  void OnStagedLogCompressed(const std::string& log_hash,
+                             const std::string* compressed_log_text,
+                             bool compression_successful);
+
   // Prepared the staged log to be passed to the server. Upon return,
-  // current_fetch_ should be reset with its upload data set to a compressed
-  // copy of the staged log.
-  void PrepareFetchWithStagedLog();
+  // current_fetch_ should be reset with its upload data set to
+  // |compressed_log_text|, the compressed copy of the staged log.
+  void PrepareFetchWithStagedLog(const std::string& compressed_log_text);
 
   // Implementation of net::URLFetcherDelegate. Called after transmission
   // completes (either successfully or with failure).
@@ -56,6 +56,12 @@ ChromeNetLog::ChromeNetLog()
     } else {
       scoped_ptr<base::Value> constants(NetInternalsUI::GetConstants());
       net_log_logger_.reset(new net::NetLogLogger(file, *constants));
+      int64 max_file_size;
+      if (base::StringToInt64(command_line->GetSwitchValueASCII(
+              switches::kNetLogMaxFileSize), &max_file_size) &&
+          max_file_size >= 0) {
+        net_log_logger_->set_max_file_size(max_file_size);
+      }
       net_log_logger_->StartObserving(this);
     }
   }
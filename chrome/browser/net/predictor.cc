@@ -50,6 +50,9 @@ namespace chrome_browser_net {
 // static
 const int Predictor::kPredictorReferrerVersion = 2;
 const double Predictor::kPreconnectWorthyExpectedValue = 0.8;
+const double Predictor::kMinPreconnectUsefulness = 0.1;
+const double Predictor::kPreconnectUsefulnessWeight = 0.25;
+const size_t Predictor::kMaxPreconnectUsefulnessHosts = 100;
 const double Predictor::kDNSPreresolutionWorthyExpectedValue = 0.1;
 const double Predictor::kDiscardableExpectedValue = 0.05;
 // The goal is of trimming is to to reduce the importance (number of expected
@@ -137,13 +140,21 @@ class Predictor::LookupRequest {
 // A preconnect trigger is considered as used iff a navigation including
 // access to the preconnected host occurs within a time period specified by
 // kMaxUnusedSocketLifetimeSecondsWithoutAGet.
+// The same triggers also feed a per-host estimate of how useful preconnecting
+// to the host has been recently, which scales the number of sockets opened.
 class Predictor::PreconnectUsage {
  public:
   PreconnectUsage();
   ~PreconnectUsage();
 
   // Record a preconnect trigger to |url|.
-  void ObservePreconnect(const GURL& url);
+  void ObservePreconnect(const GURL& url,
+                         UrlInfo::ResolutionMotivation motivation);
+
+  // Returns how many of the |count| sockets requested for |url| are worth
+  // opening, given how often preconnects to its host were wasted recently.
+  // Returns 0 if preconnecting to the host was not worth it at all lately.
+  int AdjustPreconnectCount(const GURL& url, int count) const;
 
   // Record a user navigation with its redirect history, |url_chain|.
   // We are uncertain if this is actually a link navigation.
@@ -158,24 +169,48 @@ class Predictor::PreconnectUsage {
   // This tracks whether a preconnect was used in some navigation or not
   class PreconnectPrecisionStat {
    public:
-    PreconnectPrecisionStat()
+    explicit PreconnectPrecisionStat(bool is_mouse_over)
         : timestamp_(base::TimeTicks::Now()),
-          was_used_(false) {
+          is_mouse_over_(is_mouse_over),
+          was_used_(false),
+          was_requested_(false) {
     }
 
     const base::TimeTicks& timestamp() { return timestamp_; }
 
+    // Only mouse over triggers are reported in Net.PreconnectTriggerUsed.
+    bool is_mouse_over() const { return is_mouse_over_; }
+
     void set_was_used() { was_used_ = true; }
     bool was_used() const { return was_used_; }
 
+    // Whether any request, not only a link navigation, went to the host.
+    void set_was_requested() { was_requested_ = true; }
+    bool was_requested() const { return was_requested_; }
+
    private:
     base::TimeTicks timestamp_;
+    bool is_mouse_over_;
     bool was_used_;
+    bool was_requested_;
   };
 
+  // Marks the preconnect trigger to |canonical_url| as requested, if there is
+  // one.
+  void ObserveRequest(const GURL& canonical_url);
+
+  // Folds the outcome of a preconnect to |canonical_url| into the usefulness
+  // of its host.
+  void UpdateUsefulness(const GURL& canonical_url, bool was_useful);
+
   typedef base::MRUCache<GURL, PreconnectPrecisionStat> MRUPreconnects;
   MRUPreconnects mru_preconnects_;
 
+  // The recent fraction of useful preconnects per host, as a moving average.
+  // Hosts without an entry are assumed to be worth preconnecting to.
+  typedef base::MRUCache<GURL, double> HostUsefulness;
+  HostUsefulness host_usefulness_;
+
   // The longest time an entry can persist in mru_preconnect_
   const base::TimeDelta max_duration_;
 
@@ -186,13 +221,16 @@ class Predictor::PreconnectUsage {
 
 Predictor::PreconnectUsage::PreconnectUsage()
     : mru_preconnects_(MRUPreconnects::NO_AUTO_EVICT),
+      host_usefulness_(kMaxPreconnectUsefulnessHosts),
       max_duration_(base::TimeDelta::FromSeconds(
           Predictor::kMaxUnusedSocketLifetimeSecondsWithoutAGet)) {
 }
 
 Predictor::PreconnectUsage::~PreconnectUsage() {}
 
-void Predictor::PreconnectUsage::ObservePreconnect(const GURL& url) {
+void Predictor::PreconnectUsage::ObservePreconnect(
+    const GURL& url,
+    UrlInfo::ResolutionMotivation motivation) {
   // Evict any overly old entries and record stats.
   base::TimeTicks now = base::TimeTicks::Now();
 
@@ -203,14 +241,54 @@ void Predictor::PreconnectUsage::ObservePreconnect(const GURL& url) {
     if (now - eldest_preconnect->second.timestamp() < max_duration_)
       break;
 
-    UMA_HISTOGRAM_BOOLEAN("Net.PreconnectTriggerUsed",
-                          eldest_preconnect->second.was_used());
+    if (eldest_preconnect->second.is_mouse_over()) {
+      UMA_HISTOGRAM_BOOLEAN("Net.PreconnectTriggerUsed",
+                            eldest_preconnect->second.was_used());
+    }
+    if (!eldest_preconnect->second.was_requested())
+      UpdateUsefulness(eldest_preconnect->first, false);
     eldest_preconnect = mru_preconnects_.Erase(eldest_preconnect);
   }
 
-  // Add new entry.
+  // Add new entry, unless an unexpired trigger to the host already waits for
+  // a request. Its sockets are still in the pool.
   GURL canonical_url(Predictor::CanonicalizeUrl(url));
-  mru_preconnects_.Put(canonical_url, PreconnectPrecisionStat());
+  bool is_mouse_over = motivation == UrlInfo::MOUSE_OVER_MOTIVATED;
+  MRUPreconnects::iterator it = mru_preconnects_.Peek(canonical_url);
+  if (it != mru_preconnects_.end() && !it->second.was_requested() &&
+      !is_mouse_over) {
+    return;
+  }
+  mru_preconnects_.Put(canonical_url, PreconnectPrecisionStat(is_mouse_over));
+}
+
+int Predictor::PreconnectUsage::AdjustPreconnectCount(const GURL& url,
+                                                      int count) const {
+  HostUsefulness::const_iterator it =
+      host_usefulness_.Peek(Predictor::CanonicalizeUrl(url));
+  if (it == host_usefulness_.end())
+    return count;
+  if (it->second < kMinPreconnectUsefulness)
+    return 0;
+  return std::max(1, static_cast<int>(std::ceil(count * it->second)));
+}
+
+void Predictor::PreconnectUsage::ObserveRequest(const GURL& canonical_url) {
+  MRUPreconnects::iterator it = mru_preconnects_.Peek(canonical_url);
+  if (it == mru_preconnects_.end() || it->second.was_requested())
+    return;
+  it->second.set_was_requested();
+  UpdateUsefulness(canonical_url, true);
+}
+
+void Predictor::PreconnectUsage::UpdateUsefulness(const GURL& canonical_url,
+                                                  bool was_useful) {
+  HostUsefulness::iterator it = host_usefulness_.Get(canonical_url);
+  double usefulness = it == host_usefulness_.end() ? 1.0 : it->second;
+  usefulness += kPreconnectUsefulnessWeight *
+      ((was_useful ? 1.0 : 0.0) - usefulness);
+  host_usefulness_.Put(canonical_url, usefulness);
+  UMA_HISTOGRAM_BOOLEAN("Net.PreconnectHostUseful", was_useful);
 }
 
 void Predictor::PreconnectUsage::ObserveNavigationChain(
@@ -226,6 +304,7 @@ void Predictor::PreconnectUsage::ObserveNavigationChain(
 
   MRUPreconnects::iterator itPreconnect = mru_preconnects_.Peek(canonical_url);
   bool was_preconnected = (itPreconnect != mru_preconnects_.end());
+  ObserveRequest(canonical_url);
 
   // This is an UMA which was named incorrectly. This actually measures the
   // ratio of URLRequests which have used a preconnected session.
@@ -253,6 +332,7 @@ void Predictor::PreconnectUsage::ObserveLinkNavigation(const GURL& url) {
     bool was_preconnected = (itPreconnect != mru_preconnects_.end());
     if (was_preconnected) {
       itPreconnect->second.set_was_used();
+      ObserveRequest(canonical_url);
       did_use_preconnect = true;
     }
   }
@@ -988,11 +1068,19 @@ void Predictor::PreconnectUrlOnIOThread(
     const GURL& first_party_for_cookies,
     UrlInfo::ResolutionMotivation motivation,
     int count) {
-  if (motivation == UrlInfo::MOUSE_OVER_MOTIVATED)
-    RecordPreconnectTrigger(url);
+  if (preconnect_usage_) {
+    count = preconnect_usage_->AdjustPreconnectCount(url, count);
+    // The trigger is observed even when no socket is opened for it, so that
+    // a host whose preconnects were wasted can become useful again.
+    preconnect_usage_->ObservePreconnect(url, motivation);
+  }
 
   AdviseProxy(url, motivation, true /* is_preconnect */);
 
+  UMA_HISTOGRAM_BOOLEAN("Net.PreconnectSkippedAsWasteful", count == 0);
+  if (count == 0)
+    return;
+
   PreconnectOnIOThread(url,
                        first_party_for_cookies,
                        motivation,
@@ -1000,12 +1088,6 @@ void Predictor::PreconnectUrlOnIOThread(
                        url_request_context_getter_.get());
 }
 
-void Predictor::RecordPreconnectTrigger(const GURL& url) {
-  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
-  if (preconnect_usage_)
-    preconnect_usage_->ObservePreconnect(url);
-}
-
 void Predictor::RecordPreconnectNavigationStat(
     const std::vector<GURL>& url_chain,
     bool is_subresource) {
@@ -100,6 +100,14 @@ class Predictor {
   // TODO(jar): We should do a persistent field trial to validate/optimize this.
   static const int kMaxUnusedSocketLifetimeSecondsWithoutAGet;
 
+  // Preconnects to a host are scaled down by a moving average of how many of
+  // them were followed by a request to the host in time.  Hosts whose average
+  // drops below kMinPreconnectUsefulness are not preconnected to at all, and
+  // the averages of at most kMaxPreconnectUsefulnessHosts hosts are kept.
+  static const double kMinPreconnectUsefulness;
+  static const double kPreconnectUsefulnessWeight;
+  static const size_t kMaxPreconnectUsefulnessHosts;
+
   // |max_concurrent| specifies how many concurrent (parallel) prefetches will
   // be performed. Host lookups will be issued through |host_resolver|.
   explicit Predictor(bool preconnect_enabled);
@@ -239,8 +247,6 @@ class Predictor {
                                UrlInfo::ResolutionMotivation motivation,
                                int count);
 
-  void RecordPreconnectTrigger(const GURL& url);
-
   void RecordPreconnectNavigationStat(const std::vector<GURL>& url_chain,
                                       bool is_subresource);
 
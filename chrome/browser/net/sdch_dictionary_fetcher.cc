@@ -7,6 +7,7 @@
 #include "base/bind.h"
 #include "base/compiler_specific.h"
 #include "base/message_loop/message_loop.h"
+#include "base/stl_util.h"
 #include "chrome/browser/profiles/profile.h"
 #include "net/base/load_flags.h"
 #include "net/url_request/url_fetcher.h"
@@ -23,6 +24,7 @@ SdchDictionaryFetcher::SdchDictionaryFetcher(
 
 SdchDictionaryFetcher::~SdchDictionaryFetcher() {
   DCHECK(CalledOnValidThread());
+  STLDeleteElements(&current_fetches_);
 }
 
 // static
@@ -52,8 +54,10 @@ void SdchDictionaryFetcher::Schedule(const GURL& dictionary_url) {
 }
 
 void SdchDictionaryFetcher::ScheduleDelayedRun() {
-  if (fetch_queue_.empty() || current_fetch_.get() || task_is_pending_)
+  if (fetch_queue_.empty() ||
+      current_fetches_.size() >= kMaxConcurrentFetches || task_is_pending_) {
     return;
+  }
   base::MessageLoop::current()->PostDelayedTask(FROM_HERE,
       base::Bind(&SdchDictionaryFetcher::StartFetching,
                  weak_factory_.GetWeakPtr()),
@@ -66,13 +70,17 @@ void SdchDictionaryFetcher::StartFetching() {
   task_is_pending_ = false;
 
   DCHECK(context_.get());
-  current_fetch_.reset(net::URLFetcher::Create(
-      fetch_queue_.front(), net::URLFetcher::GET, this));
-  fetch_queue_.pop();
-  current_fetch_->SetRequestContext(context_.get());
-  current_fetch_->SetLoadFlags(net::LOAD_DO_NOT_SEND_COOKIES |
-                               net::LOAD_DO_NOT_SAVE_COOKIES);
-  current_fetch_->Start();
+  while (!fetch_queue_.empty() &&
+         current_fetches_.size() < kMaxConcurrentFetches) {
+    net::URLFetcher* fetch = net::URLFetcher::Create(
+        fetch_queue_.front(), net::URLFetcher::GET, this);
+    fetch_queue_.pop();
+    current_fetches_.insert(fetch);
+    fetch->SetRequestContext(context_.get());
+    fetch->SetLoadFlags(net::LOAD_DO_NOT_SEND_COOKIES |
+                        net::LOAD_DO_NOT_SAVE_COOKIES);
+    fetch->Start();
+  }
 }
 
 void SdchDictionaryFetcher::OnURLFetchComplete(
@@ -83,6 +91,9 @@ void SdchDictionaryFetcher::OnURLFetchComplete(
     source->GetResponseAsString(&data);
     net::SdchManager::Global()->AddSdchDictionary(data, source->GetURL());
   }
-  current_fetch_.reset(NULL);
+  net::URLFetcher* fetch = const_cast<net::URLFetcher*>(source);
+  DCHECK(ContainsKey(current_fetches_, fetch));
+  current_fetches_.erase(fetch);
+  delete fetch;
   ScheduleDelayedRun();
 }
@@ -13,7 +13,6 @@
 #include <set>
 #include <string>
 
-#include "base/memory/scoped_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/threading/non_thread_safe.h"
 #include "net/base/sdch_manager.h"
@@ -48,11 +47,16 @@ class SdchDictionaryFetcher
   // page subresources (or tabs opened in parallel) all suggest the dictionary.
   static const int kMsDelayFromRequestTillDownload = 100;
 
+  // Maximum number of dictionary fetches that are outstanding at once. A page
+  // that advertises several dictionaries gets them all without waiting for
+  // each one in turn, while the fetches still can't crowd out the page load.
+  static const size_t kMaxConcurrentFetches = 3;
+
   // Ensure the download after the above delay.
   void ScheduleDelayedRun();
 
-  // Make sure we're processing (or waiting for) the the arrival of the next URL
-  // in the  |fetch_queue_|.
+  // Start fetching queued URLs from |fetch_queue_|, up to
+  // |kMaxConcurrentFetches| outstanding fetches.
   void StartFetching();
 
   // Implementation of net::URLFetcherDelegate. Called after transmission
@@ -61,9 +65,8 @@ class SdchDictionaryFetcher
 
   // A queue of URLs that are being used to download dictionaries.
   std::queue<GURL> fetch_queue_;
-  // The currently outstanding URL fetch of a dicitonary.
-  // If this is null, then there is no outstanding request.
-  scoped_ptr<net::URLFetcher> current_fetch_;
+  // The currently outstanding URL fetches of dictionaries, owned.
+  std::set<net::URLFetcher*> current_fetches_;
 
   // Always spread out the dictionary fetches, so that they don't steal
   // bandwidth from the actual page load.  Create delayed tasks to spread out
@@ -0,0 +1,79 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/net/ssl_session_cache_persister.h"
+
+#include "base/bind.h"
+#include "base/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/logging.h"
+#include "base/metrics/histogram.h"
+#include "base/sequenced_task_runner.h"
+#include "base/task_runner_util.h"
+#include "components/webdata/encryptor/encryptor.h"
+#include "net/socket/ssl_client_socket.h"
+
+namespace chrome_browser_net {
+
+namespace {
+
+std::string LoadSessionsFromFile(const base::FilePath& path) {
+  std::string encrypted;
+  if (!base::ReadFileToString(path, &encrypted))
+    return std::string();
+  std::string sessions;
+  if (!Encryptor::DecryptString(encrypted, &sessions))
+    return std::string();
+  return sessions;
+}
+
+void WriteSessionsToFile(const base::FilePath& path,
+                         const std::string& sessions) {
+  std::string encrypted;
+  if (!Encryptor::EncryptString(sessions, &encrypted)) {
+    // Never leave the sessions on disk unencrypted.
+    base::DeleteFile(path, false);
+    return;
+  }
+  base::ImportantFileWriter::WriteFileAtomically(path, encrypted);
+}
+
+}  // namespace
+
+SSLSessionCachePersister::SSLSessionCachePersister(
+    const base::FilePath& path,
+    base::SequencedTaskRunner* background_runner)
+    : path_(path),
+      background_runner_(background_runner),
+      weak_ptr_factory_(this) {
+  base::PostTaskAndReplyWithResult(
+      background_runner_.get(),
+      FROM_HERE,
+      base::Bind(&LoadSessionsFromFile, path_),
+      base::Bind(&SSLSessionCachePersister::CompleteLoad,
+                 weak_ptr_factory_.GetWeakPtr()));
+}
+
+SSLSessionCachePersister::~SSLSessionCachePersister() {
+  DCHECK(CalledOnValidThread());
+
+  std::string sessions;
+  if (!net::SSLClientSocket::SerializeSessionCache(&sessions))
+    return;
+  background_runner_->PostTask(
+      FROM_HERE, base::Bind(&WriteSessionsToFile, path_, sessions));
+}
+
+void SSLSessionCachePersister::CompleteLoad(const std::string& sessions) {
+  DCHECK(CalledOnValidThread());
+
+  if (sessions.empty())
+    return;
+
+  size_t restored = net::SSLClientSocket::RestoreSessionCache(sessions);
+  UMA_HISTOGRAM_COUNTS_10000("Net.SSLSessionsRestored",
+                             static_cast<int>(restored));
+}
+
+}  // namespace chrome_browser_net
@@ -0,0 +1,54 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CHROME_BROWSER_NET_SSL_SESSION_CACHE_PERSISTER_H_
+#define CHROME_BROWSER_NET_SSL_SESSION_CACHE_PERSISTER_H_
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/threading/non_thread_safe.h"
+
+namespace base {
+class SequencedTaskRunner;
+}
+
+namespace chrome_browser_net {
+
+// Keeps the SSL client session cache across restarts, so that the first
+// connection to a host after a restart can resume a session or present a
+// session ticket instead of doing a full handshake.
+//
+// The sessions hold the master secrets of their connections, so they are
+// encrypted with the Encryptor before they are written. The file is read and
+// decrypted on |background_runner| when the persister is created, and its
+// sessions are added to the cache once that completes. The cache is written
+// back, again from |background_runner|, when the persister is destroyed.
+//
+// The session cache is shared by all profiles, although the sessions of each
+// profile are kept apart by its session cache shard, so a single file holds
+// the sessions of all of them.
+class SSLSessionCachePersister : public base::NonThreadSafe {
+ public:
+  SSLSessionCachePersister(const base::FilePath& path,
+                           base::SequencedTaskRunner* background_runner);
+  ~SSLSessionCachePersister();
+
+ private:
+  void CompleteLoad(const std::string& sessions);
+
+  const base::FilePath path_;
+  scoped_refptr<base::SequencedTaskRunner> background_runner_;
+
+  base::WeakPtrFactory<SSLSessionCachePersister> weak_ptr_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(SSLSessionCachePersister);
+};
+
+}  // namespace chrome_browser_net
+
+#endif  // CHROME_BROWSER_NET_SSL_SESSION_CACHE_PERSISTER_H_
@@ -93,6 +93,15 @@ std::vector<base::FilePath>& ProfilesToDelete() {
   return profiles_to_delete;
 }
 
+// Reads the files that loading the profile at |path| reads synchronously, so
+// that they are in the OS cache by the time the UI thread needs them.
+void PrefetchProfileFiles(const base::FilePath& path) {
+  std::string contents;
+  base::ReadFileToString(path.Append(chrome::kPreferencesFilename), &contents);
+  base::ReadFileToString(path.Append(chrome::kManagedUserSettingsFilename),
+                         &contents);
+}
+
 int64 ComputeFilesSize(const base::FilePath& directory,
                        const base::FilePath::StringType& pattern) {
   int64 running_size = 0;
@@ -513,13 +522,32 @@ std::vector<Profile*> ProfileManager::GetLastOpenedProfiles(
         local_state->GetList(prefs::kProfilesLastActive)->DeepCopy());
     base::ListValue::const_iterator it;
     std::string profile;
+    std::vector<base::FilePath> paths;
     for (it = profile_list->begin(); it != profile_list->end(); ++it) {
       if (!(*it)->GetAsString(&profile) || profile.empty()) {
         LOG(WARNING) << "Invalid entry in " << prefs::kProfilesLastActive;
         continue;
       }
-      to_return.push_back(GetProfile(user_data_dir.AppendASCII(profile)));
+      paths.push_back(user_data_dir.AppendASCII(profile));
+    }
+
+    // The profiles are loaded synchronously one after the other. Meanwhile,
+    // read the files of all but the first one that is not loaded yet in
+    // parallel, so that their loads do not each wait on the disk.
+    bool skipped_first_unloaded = false;
+    for (size_t i = 0; i < paths.size(); ++i) {
+      if (GetProfileByPath(paths[i]))
+        continue;
+      if (!skipped_first_unloaded) {
+        skipped_first_unloaded = true;
+        continue;
+      }
+      BrowserThread::PostBlockingPoolTask(
+          FROM_HERE, base::Bind(&PrefetchProfileFiles, paths[i]));
     }
+
+    for (size_t i = 0; i < paths.size(); ++i)
+      to_return.push_back(GetProfile(paths[i]));
   }
   return to_return;
 }
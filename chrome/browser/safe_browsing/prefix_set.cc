@@ -8,6 +8,7 @@
 #include <math.h>
 
 #include "base/file_util.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/logging.h"
 #include "base/md5.h"
 #include "base/metrics/histogram.h"
@@ -39,7 +40,11 @@ bool PrefixSet::PrefixLess(const IndexPair& a, const IndexPair& b) {
   return a.first < b.first;
 }
 
-PrefixSet::PrefixSet(const std::vector<SBPrefix>& sorted_prefixes) {
+PrefixSet::PrefixSet(const std::vector<SBPrefix>& sorted_prefixes)
+    : index_data_(NULL),
+      index_size_(0),
+      deltas_data_(NULL),
+      deltas_size_(0) {
   if (sorted_prefixes.size()) {
     // Estimate the resulting vector sizes.  There will be strictly
     // more than |min_runs| entries in |index_|, but there generally
@@ -89,31 +94,51 @@ PrefixSet::PrefixSet(const std::vector<SBPrefix>& sorted_prefixes) {
                               bits_used / unique_prefixes,
                               kMaxBitsPerPrefix);
   }
+  UseVectors();
 }
 
 PrefixSet::PrefixSet(IndexVector* index, std::vector<uint16>* deltas) {
   DCHECK(index && deltas);
   index_.swap(*index);
   deltas_.swap(*deltas);
+  UseVectors();
+}
+
+PrefixSet::PrefixSet(scoped_ptr<base::MemoryMappedFile> mapped_file,
+                     const IndexPair* index, size_t index_size,
+                     const uint16* deltas, size_t deltas_size)
+    : mapped_file_(mapped_file.Pass()),
+      index_data_(index),
+      index_size_(index_size),
+      deltas_data_(deltas),
+      deltas_size_(deltas_size) {
 }
 
 PrefixSet::~PrefixSet() {}
 
+void PrefixSet::UseVectors() {
+  index_data_ = index_.empty() ? NULL : &index_[0];
+  index_size_ = index_.size();
+  deltas_data_ = deltas_.empty() ? NULL : &deltas_[0];
+  deltas_size_ = deltas_.size();
+}
+
 bool PrefixSet::Exists(SBPrefix prefix) const {
-  if (index_.empty())
+  if (!index_size_)
     return false;
 
-  // Find the first position after |prefix| in |index_|.
-  IndexVector::const_iterator iter =
-      std::upper_bound(index_.begin(), index_.end(),
+  // Find the first position after |prefix| in the index.
+  const IndexPair* const index_end = index_data_ + index_size_;
+  const IndexPair* iter =
+      std::upper_bound(index_data_, index_end,
                        IndexPair(prefix, 0), PrefixLess);
 
   // |prefix| comes before anything that's in the set.
-  if (iter == index_.begin())
+  if (iter == index_data_)
     return false;
 
   // Capture the upper bound of our target entry's deltas.
-  const size_t bound = (iter == index_.end() ? deltas_.size() : iter->second);
+  const size_t bound = (iter == index_end ? deltas_size_ : iter->second);
 
   // Back up to the entry our target is in.
   --iter;
@@ -125,25 +150,25 @@ bool PrefixSet::Exists(SBPrefix prefix) const {
 
   // Scan forward accumulating deltas while a match is possible.
   for (size_t di = iter->second; di < bound && current < prefix; ++di) {
-    current += deltas_[di];
+    current += deltas_data_[di];
   }
 
   return current == prefix;
 }
 
 void PrefixSet::GetPrefixes(std::vector<SBPrefix>* prefixes) const {
-  prefixes->reserve(index_.size() + deltas_.size());
+  prefixes->reserve(index_size_ + deltas_size_);
 
-  for (size_t ii = 0; ii < index_.size(); ++ii) {
-    // The deltas for this |index_| entry run to the next index entry,
+  for (size_t ii = 0; ii < index_size_; ++ii) {
+    // The deltas for this index entry run to the next index entry,
     // or the end of the deltas.
     const size_t deltas_end =
-        (ii + 1 < index_.size()) ? index_[ii + 1].second : deltas_.size();
+        (ii + 1 < index_size_) ? index_data_[ii + 1].second : deltas_size_;
 
-    SBPrefix current = index_[ii].first;
+    SBPrefix current = index_data_[ii].first;
     prefixes->push_back(current);
-    for (size_t di = index_[ii].second; di < deltas_end; ++di) {
-      current += deltas_[di];
+    for (size_t di = index_data_[ii].second; di < deltas_end; ++di) {
+      current += deltas_data_[di];
       prefixes->push_back(current);
     }
   }
@@ -151,122 +176,98 @@ void PrefixSet::GetPrefixes(std::vector<SBPrefix>* prefixes) const {
 
 // static
 PrefixSet* PrefixSet::LoadFile(const base::FilePath& filter_name) {
-  int64 size_64;
-  if (!base::GetFileSize(filter_name, &size_64))
+  scoped_ptr<base::MemoryMappedFile> mapped_file(new base::MemoryMappedFile);
+  if (!mapped_file->Initialize(filter_name))
     return NULL;
+  const uint8* data = mapped_file->data();
+  const size_t size = mapped_file->length();
   using base::MD5Digest;
-  if (size_64 < static_cast<int64>(sizeof(FileHeader) + sizeof(MD5Digest)))
-    return NULL;
-
-  file_util::ScopedFILE file(base::OpenFile(filter_name, "rb"));
-  if (!file.get())
+  if (size < sizeof(FileHeader) + sizeof(MD5Digest))
     return NULL;
 
   FileHeader header;
-  size_t read = fread(&header, sizeof(header), 1, file.get());
-  if (read != 1)
-    return NULL;
-
+  memcpy(&header, data, sizeof(header));
   if (header.magic != kMagic || header.version != kVersion)
     return NULL;
 
-  IndexVector index;
-  const size_t index_bytes = sizeof(index[0]) * header.index_size;
-
   // For a time, the second element of the index_ pair was a size_t rather than
-  // a fixed-size value.  This structure will be used to check, read and convert
-  // in case a 64-bit size_t was written.
-  std::vector<std::pair<SBPrefix,uint64> > alt_index;
-  const size_t alt_index_bytes = sizeof(alt_index[0]) * header.index_size;
-
-  std::vector<uint16> deltas;
-  const size_t deltas_bytes = sizeof(deltas[0]) * header.deltas_size;
-
-  // Check for bogus sizes before allocating any space.
-  const size_t expected_bytes =
+  // a fixed-size value.  This will be used to check, read and convert in case a
+  // 64-bit size_t was written.
+  typedef std::pair<SBPrefix,uint64> AltIndexPair;
+
+  // 64-bit arithmetic so that bogus sizes cannot wrap around.
+  const uint64 index_bytes =
+      static_cast<uint64>(sizeof(IndexPair)) * header.index_size;
+  const uint64 alt_index_bytes =
+      static_cast<uint64>(sizeof(AltIndexPair)) * header.index_size;
+  const uint64 deltas_bytes =
+      static_cast<uint64>(sizeof(uint16)) * header.deltas_size;
+
+  // Check for bogus sizes before touching the payload.
+  const uint64 expected_bytes =
       sizeof(header) + index_bytes + deltas_bytes + sizeof(MD5Digest);
   bool read_alt_index = false;
-  if (static_cast<int64>(expected_bytes) != size_64) {
-    const size_t alt_expected_bytes =
+  if (expected_bytes != size) {
+    const uint64 alt_expected_bytes =
         sizeof(header) + alt_index_bytes + deltas_bytes + sizeof(MD5Digest);
-    if (static_cast<int64>(alt_expected_bytes) != size_64)
+    if (alt_expected_bytes != size)
       return NULL;
 
     read_alt_index = true;
   }
 
-  // The file looks valid, start building the digest.
-  base::MD5Context context;
-  base::MD5Init(&context);
-  base::MD5Update(&context, base::StringPiece(reinterpret_cast<char*>(&header),
-                                              sizeof(header)));
+  // The digest covers everything before it.
+  const size_t digest_offset = size - sizeof(MD5Digest);
+  base::MD5Digest calculated_digest;
+  base::MD5Sum(data, digest_offset, &calculated_digest);
+  if (0 != memcmp(data + digest_offset, &calculated_digest,
+                  sizeof(calculated_digest))) {
+    return NULL;
+  }
 
-  // Read the index vector.  Herb Sutter indicates that vectors are
-  // guaranteed to be contiuguous, so reading to where element 0 lives
-  // is valid.
+  const uint8* index_start = data + sizeof(header);
   if (read_alt_index) {
-    alt_index.resize(header.index_size);
-    read = fread(&(alt_index[0]), sizeof(alt_index[0]), alt_index.size(),
-                 file.get());
-    if (read != alt_index.size())
-      return NULL;
-    base::MD5Update(&context,
-                    base::StringPiece(reinterpret_cast<char*>(&(alt_index[0])),
-                                      alt_index_bytes));
-
-    index.reserve(alt_index.size());
-    for (size_t i = 0; i < alt_index.size(); ++i) {
-      const uint32 ofs = static_cast<uint32>(alt_index[i].second);
-      if (static_cast<uint64>(ofs) != alt_index[i].second)
+    // Convert the old format into vectors on the heap.
+    IndexVector index;
+    index.reserve(header.index_size);
+    for (size_t i = 0; i < header.index_size; ++i) {
+      AltIndexPair alt_pair;
+      memcpy(&alt_pair, index_start + i * sizeof(alt_pair), sizeof(alt_pair));
+      const uint32 ofs = static_cast<uint32>(alt_pair.second);
+      if (static_cast<uint64>(ofs) != alt_pair.second)
         return NULL;
-      index.push_back(std::make_pair(alt_index[i].first, ofs));
+      index.push_back(std::make_pair(alt_pair.first, ofs));
     }
-  } else if (header.index_size) {
-    index.resize(header.index_size);
-    read = fread(&(index[0]), sizeof(index[0]), index.size(), file.get());
-    if (read != index.size())
-      return NULL;
-    base::MD5Update(&context,
-                    base::StringPiece(reinterpret_cast<char*>(&(index[0])),
-                                      index_bytes));
-  }
 
-  // Read vector of deltas.
-  if (header.deltas_size) {
-    deltas.resize(header.deltas_size);
-    read = fread(&(deltas[0]), sizeof(deltas[0]), deltas.size(), file.get());
-    if (read != deltas.size())
-      return NULL;
-    base::MD5Update(&context,
-                    base::StringPiece(reinterpret_cast<char*>(&(deltas[0])),
-                                      deltas_bytes));
-  }
-
-  base::MD5Digest calculated_digest;
-  base::MD5Final(&calculated_digest, &context);
-
-  base::MD5Digest file_digest;
-  read = fread(&file_digest, sizeof(file_digest), 1, file.get());
-  if (read != 1)
-    return NULL;
+    std::vector<uint16> deltas(header.deltas_size);
+    if (header.deltas_size) {
+      memcpy(&(deltas[0]), index_start + alt_index_bytes,
+             static_cast<size_t>(deltas_bytes));
+    }
 
-  if (0 != memcmp(&file_digest, &calculated_digest, sizeof(file_digest)))
-    return NULL;
+    // Steals contents of |index| and |deltas| via swap().
+    return new PrefixSet(&index, &deltas);
+  }
 
-  // Steals contents of |index| and |deltas| via swap().
-  return new PrefixSet(&index, &deltas);
+  // The index and deltas are aligned for their types within the
+  // page-aligned mapping, so they can be used in place.
+  const IndexPair* index = reinterpret_cast<const IndexPair*>(index_start);
+  const uint16* deltas =
+      reinterpret_cast<const uint16*>(index_start + index_bytes);
+  return new PrefixSet(mapped_file.Pass(), index, header.index_size,
+                       deltas, header.deltas_size);
 }
 
 bool PrefixSet::WriteFile(const base::FilePath& filter_name) const {
   FileHeader header;
   header.magic = kMagic;
   header.version = kVersion;
-  header.index_size = static_cast<uint32>(index_.size());
-  header.deltas_size = static_cast<uint32>(deltas_.size());
+  header.index_size = static_cast<uint32>(index_size_);
+  header.deltas_size = static_cast<uint32>(deltas_size_);
 
   // Sanity check that the 32-bit values never mess things up.
-  if (static_cast<size_t>(header.index_size) != index_.size() ||
-      static_cast<size_t>(header.deltas_size) != deltas_.size()) {
+  if (static_cast<size_t>(header.index_size) != index_size_ ||
+      static_cast<size_t>(header.deltas_size) != deltas_size_) {
     NOTREACHED();
     return false;
   }
@@ -286,29 +287,29 @@ bool PrefixSet::WriteFile(const base::FilePath& filter_name) const {
   base::MD5Update(&context, base::StringPiece(reinterpret_cast<char*>(&header),
                                               sizeof(header)));
 
-  // As for reads, the standard guarantees the ability to access the
-  // contents of the vector by a pointer to an element.
-  if (index_.size()) {
-    const size_t index_bytes = sizeof(index_[0]) * index_.size();
-    written = fwrite(&(index_[0]), sizeof(index_[0]), index_.size(),
+  // Whether the set was built or loaded, the index and deltas are
+  // each contiguous.
+  if (index_size_) {
+    const size_t index_bytes = sizeof(index_data_[0]) * index_size_;
+    written = fwrite(index_data_, sizeof(index_data_[0]), index_size_,
                      file.get());
-    if (written != index_.size())
+    if (written != index_size_)
       return false;
     base::MD5Update(&context,
                     base::StringPiece(
-                        reinterpret_cast<const char*>(&(index_[0])),
+                        reinterpret_cast<const char*>(index_data_),
                         index_bytes));
   }
 
-  if (deltas_.size()) {
-    const size_t deltas_bytes = sizeof(deltas_[0]) * deltas_.size();
-    written = fwrite(&(deltas_[0]), sizeof(deltas_[0]), deltas_.size(),
+  if (deltas_size_) {
+    const size_t deltas_bytes = sizeof(deltas_data_[0]) * deltas_size_;
+    written = fwrite(deltas_data_, sizeof(deltas_data_[0]), deltas_size_,
                      file.get());
-    if (written != deltas_.size())
+    if (written != deltas_size_)
       return false;
     base::MD5Update(&context,
                     base::StringPiece(
-                        reinterpret_cast<const char*>(&(deltas_[0])),
+                        reinterpret_cast<const char*>(deltas_data_),
                         deltas_bytes));
   }
 
@@ -45,16 +45,23 @@
 //     n * 8 byte |&index_[0]..&index_[n]|
 //     m * 2 byte |&deltas_[0]..&deltas_[m]|
 //        16 byte digest
+//
+// The index and deltas are naturally aligned within the file, so
+// |LoadFile()| maps the file and looks prefixes up in place rather than
+// copying it to the heap.  A set loaded this way must not be written
+// back over the file it was loaded from.
 
 #ifndef CHROME_BROWSER_SAFE_BROWSING_PREFIX_SET_H_
 #define CHROME_BROWSER_SAFE_BROWSING_PREFIX_SET_H_
 
 #include <vector>
 
+#include "base/memory/scoped_ptr.h"
 #include "chrome/browser/safe_browsing/safe_browsing_util.h"
 
 namespace base {
 class FilePath;
+class MemoryMappedFile;
 }
 
 namespace safe_browsing {
@@ -90,6 +97,16 @@ class PrefixSet {
   // |deltas| using |swap()|.
   PrefixSet(IndexVector* index, std::vector<uint16>* deltas);
 
+  // Helper for |LoadFile()|.  The set is read from |index_size| pairs
+  // at |index| and |deltas_size| deltas at |deltas|, which point into
+  // |mapped_file|.
+  PrefixSet(scoped_ptr<base::MemoryMappedFile> mapped_file,
+            const IndexPair* index, size_t index_size,
+            const uint16* deltas, size_t deltas_size);
+
+  // Points |index_data_| and |deltas_data_| at |index_| and |deltas_|.
+  void UseVectors();
+
   // Top-level index of prefix to offset in |deltas_|.  Each pair
   // indicates a base prefix and where the deltas from that prefix
   // begin in |deltas_|.  The deltas for a pair end at the next pair's
@@ -101,6 +118,17 @@ class PrefixSet {
   // |index_|, or the end of |deltas_| for the last |index_| pair.
   std::vector<uint16> deltas_;
 
+  // The file a loaded set is mapped from.  NULL if the set was built
+  // in memory, in which case |index_| and |deltas_| hold the data.
+  scoped_ptr<base::MemoryMappedFile> mapped_file_;
+
+  // The index and deltas used for lookups, in either |index_| and
+  // |deltas_| or |mapped_file_|.
+  const IndexPair* index_data_;
+  size_t index_size_;
+  const uint16* deltas_data_;
+  size_t deltas_size_;
+
   DISALLOW_COPY_AND_ASSIGN(PrefixSet);
 };
 
@@ -0,0 +1,106 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/safe_browsing/prefix_set.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/rand_util.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace {
+
+// Roughly the size of the browse prefix set.
+const size_t kNumPrefixes = 650 * 1000;
+const size_t kNumLookups = 1000 * 1000;
+const int kNumWarmupRuns = 1;
+const int kNumRuns = 5;
+
+// Looks up every prefix of |lookups| in |prefix_set| and sets |hits| to the
+// number found.
+void LookUp(const safe_browsing::PrefixSet* prefix_set,
+            const std::vector<SBPrefix>* lookups,
+            size_t* hits) {
+  *hits = 0;
+  for (size_t i = 0; i < lookups->size(); ++i) {
+    if (prefix_set->Exists((*lookups)[i]))
+      ++*hits;
+  }
+}
+
+class PrefixSetPerfTest : public testing::Test {
+ protected:
+  virtual void SetUp() {
+    for (size_t i = 0; i < kNumPrefixes; ++i)
+      prefixes_.push_back(static_cast<SBPrefix>(base::RandUint64()));
+    std::sort(prefixes_.begin(), prefixes_.end());
+
+    // Half of the lookups hit, like a run of subresources from the same
+    // listed sites would, and half are random misses.
+    for (size_t i = 0; i < kNumLookups; ++i) {
+      if (i % 2) {
+        lookups_.push_back(prefixes_[base::RandGenerator(prefixes_.size())]);
+      } else {
+        lookups_.push_back(static_cast<SBPrefix>(base::RandUint64()));
+      }
+    }
+  }
+
+  // Runs |lookups_| against |prefix_set| repeatedly and reports the
+  // distribution of the lookup rate.
+  void MeasureLookups(const safe_browsing::PrefixSet& prefix_set,
+                      const std::string& trace) {
+    size_t hits = 0;
+    std::vector<double> durations_ms;
+    perf_test::MeasureRepeatedly(
+        base::Bind(&LookUp, &prefix_set, &lookups_, &hits),
+        kNumWarmupRuns, kNumRuns, &durations_ms);
+    EXPECT_LE(lookups_.size() / 2, hits);
+
+    std::vector<double> rates;
+    for (size_t i = 0; i < durations_ms.size(); ++i)
+      rates.push_back(lookups_.size() / durations_ms[i]);
+    perf_test::PrintResultSummary("prefix_set_lookups", "", trace, rates,
+                                  "lookups/ms", true);
+  }
+
+  std::vector<SBPrefix> prefixes_;
+  std::vector<SBPrefix> lookups_;
+};
+
+TEST_F(PrefixSetPerfTest, Lookups) {
+  safe_browsing::PrefixSet prefix_set(prefixes_);
+  MeasureLookups(prefix_set, "built");
+}
+
+TEST_F(PrefixSetPerfTest, LoadAndLookups) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath filename =
+      temp_dir.path().AppendASCII("PrefixSetPerfTest");
+  {
+    safe_browsing::PrefixSet prefix_set(prefixes_);
+    ASSERT_TRUE(prefix_set.WriteFile(filename));
+  }
+
+  base::TimeTicks start = base::TimeTicks::HighResNow();
+  scoped_ptr<safe_browsing::PrefixSet> prefix_set(
+      safe_browsing::PrefixSet::LoadFile(filename));
+  base::TimeDelta elapsed = base::TimeTicks::HighResNow() - start;
+  ASSERT_TRUE(prefix_set.get());
+  perf_test::PrintResult("prefix_set_load", "", "load",
+                         elapsed.InMillisecondsF(), "ms", true);
+
+  MeasureLookups(*prefix_set, "loaded");
+}
+
+}  // namespace
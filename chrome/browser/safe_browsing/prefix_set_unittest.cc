@@ -367,6 +367,34 @@ TEST_F(PrefixSetTest, ReadWrite) {
   }
 }
 
+// Test that a set which is mapped from one file can be written to
+// another.
+TEST_F(PrefixSetTest, WriteLoadedSet) {
+  base::FilePath filename;
+  ASSERT_TRUE(GetPrefixSetFile(&filename));
+  scoped_ptr<safe_browsing::PrefixSet>
+      loaded_set(safe_browsing::PrefixSet::LoadFile(filename));
+  ASSERT_TRUE(loaded_set.get());
+
+  const base::FilePath copy_filename =
+      filename.AddExtension(FILE_PATH_LITERAL("copy"));
+  ASSERT_TRUE(loaded_set->WriteFile(copy_filename));
+  loaded_set.reset();
+
+  scoped_ptr<safe_browsing::PrefixSet>
+      prefix_set(safe_browsing::PrefixSet::LoadFile(copy_filename));
+  ASSERT_TRUE(prefix_set.get());
+  CheckPrefixes(*prefix_set, shared_prefixes_);
+
+  std::vector<SBPrefix> prefixes;
+  prefix_set->GetPrefixes(&prefixes);
+  std::vector<SBPrefix> unique_prefixes(shared_prefixes_);
+  unique_prefixes.erase(
+      std::unique(unique_prefixes.begin(), unique_prefixes.end()),
+      unique_prefixes.end());
+  EXPECT_EQ(unique_prefixes, prefixes);
+}
+
 // Check that |CleanChecksum()| makes an acceptable checksum.
 TEST_F(PrefixSetTest, CorruptionHelpers) {
   base::FilePath filename;
@@ -291,8 +291,9 @@ void UpdateChunkRanges(SafeBrowsingStore* store,
   }
 }
 
-// Helper for deleting chunks left over from obsolete lists.
-void DeleteChunksFromStore(SafeBrowsingStore* store, int listid){
+// Helper for deleting chunks left over from obsolete lists.  Returns
+// true if any chunks were deleted.
+bool DeleteChunksFromStore(SafeBrowsingStore* store, int listid){
   std::vector<int> add_chunks;
   size_t adds_deleted = 0;
   store->GetAddChunks(&add_chunks);
@@ -318,6 +319,8 @@ void DeleteChunksFromStore(SafeBrowsingStore* store, int listid){
   }
   if (subs_deleted > 0)
     UMA_HISTOGRAM_COUNTS("SB2.DownloadBinhashSubsDeleted", subs_deleted);
+
+  return adds_deleted > 0 || subs_deleted > 0;
 }
 
 // Order |SBAddFullHash| on the prefix part.  |SBAddPrefixLess()| from
@@ -477,8 +480,7 @@ SafeBrowsingDatabaseNew::SafeBrowsingDatabaseNew()
     : creation_loop_(base::MessageLoop::current()),
       browse_store_(new SafeBrowsingStoreFile),
       reset_factory_(this),
-      corruption_detected_(false),
-      change_detected_(false) {
+      corruption_detected_(false) {
   DCHECK(browse_store_.get());
   DCHECK(!download_store_.get());
   DCHECK(!csd_whitelist_store_.get());
@@ -655,6 +657,14 @@ void SafeBrowsingDatabaseNew::Init(const base::FilePath& filename_base) {
 bool SafeBrowsingDatabaseNew::ResetDatabase() {
   DCHECK_EQ(creation_loop_, base::MessageLoop::current());
 
+  // The prefix sets may be mapped from the files which are about to be
+  // deleted.
+  {
+    base::AutoLock locked(lookup_lock_);
+    browse_prefix_set_.reset();
+    side_effect_free_whitelist_prefix_set_.reset();
+  }
+
   // Delete files on disk.
   // TODO(shess): Hard to see where one might want to delete without a
   // reset.  Perhaps inline |Delete()|?
@@ -667,8 +677,6 @@ bool SafeBrowsingDatabaseNew::ResetDatabase() {
     full_browse_hashes_.clear();
     pending_browse_hashes_.clear();
     prefix_miss_cache_.clear();
-    browse_prefix_set_.reset();
-    side_effect_free_whitelist_prefix_set_.reset();
     ip_blacklist_.clear();
   }
   // Wants to acquire the lock itself.
@@ -1035,7 +1043,7 @@ void SafeBrowsingDatabaseNew::InsertChunks(const std::string& list_name,
   SafeBrowsingStore* store = GetStore(list_id);
   if (!store) return;
 
-  change_detected_ = true;
+  changed_stores_.insert(store);
 
   store->BeginChunk();
   if (chunks.front().is_add) {
@@ -1062,7 +1070,7 @@ void SafeBrowsingDatabaseNew::DeleteChunks(
   SafeBrowsingStore* store = GetStore(list_id);
   if (!store) return;
 
-  change_detected_ = true;
+  changed_stores_.insert(store);
 
   for (size_t i = 0; i < chunk_deletes.size(); ++i) {
     std::vector<int> chunk_numbers;
@@ -1117,6 +1125,8 @@ bool SafeBrowsingDatabaseNew::UpdateStarted(
   DCHECK_EQ(creation_loop_, base::MessageLoop::current());
   DCHECK(lists);
 
+  changed_stores_.clear();
+
   // If |BeginUpdate()| fails, reset the database.
   if (!browse_store_->BeginUpdate()) {
     RecordFailure(FAILURE_BROWSE_DATABASE_UPDATE_BEGIN);
@@ -1175,7 +1185,8 @@ bool SafeBrowsingDatabaseNew::UpdateStarted(
     // list, so this is very cheap if there are no kBinHashList chunks.
     const int listid =
         safe_browsing_util::GetListId(safe_browsing_util::kBinHashList);
-    DeleteChunksFromStore(download_store_.get(), listid);
+    if (DeleteChunksFromStore(download_store_.get(), listid))
+      changed_stores_.insert(download_store_.get());
 
     // The above marks the chunks for deletion, but they are not
     // actually deleted until the database is rewritten.  The
@@ -1234,7 +1245,6 @@ bool SafeBrowsingDatabaseNew::UpdateStarted(
   }
 
   corruption_detected_ = false;
-  change_detected_ = false;
   return true;
 }
 
@@ -1284,9 +1294,9 @@ void SafeBrowsingDatabaseNew::UpdateFinished(bool update_succeeded) {
   // Unroll the transaction if there was a protocol error or if the
   // transaction was empty.  This will leave the prefix set, the
   // pending hashes, and the prefix miss cache in place.
-  if (!update_succeeded || !change_detected_) {
+  if (!update_succeeded || changed_stores_.empty()) {
     // Track empty updates to answer questions at http://crbug.com/72216 .
-    if (update_succeeded && !change_detected_)
+    if (update_succeeded && changed_stores_.empty())
       UMA_HISTOGRAM_COUNTS("SB2.DatabaseUpdateKilobytes", 0);
     browse_store_->CancelUpdate();
     if (download_store_.get())
@@ -1304,7 +1314,18 @@ void SafeBrowsingDatabaseNew::UpdateFinished(bool update_succeeded) {
     return;
   }
 
-  if (download_store_) {
+  // The browse store also persists the full hashes cached since the last
+  // update, so it is rewritten whenever there are any.
+  {
+    base::AutoLock locked(lookup_lock_);
+    if (!pending_browse_hashes_.empty())
+      changed_stores_.insert(browse_store_.get());
+  }
+
+  // Only the stores which changed are rewritten below.  A rewrite reads
+  // and writes the whole store, and for the browse store also rebuilds
+  // the prefix set.
+  if (download_store_ && !CancelUpdateIfUnchanged(download_store_.get())) {
     int64 size_bytes = UpdateHashPrefixStore(
         download_filename_,
         download_store_.get(),
@@ -1313,7 +1334,8 @@ void SafeBrowsingDatabaseNew::UpdateFinished(bool update_succeeded) {
                          static_cast<int>(size_bytes / 1024));
   }
 
-  UpdateBrowseStore();
+  if (!CancelUpdateIfUnchanged(browse_store_.get()))
+    UpdateBrowseStore();
   UpdateWhitelistStore(csd_whitelist_filename_,
                        csd_whitelist_store_.get(),
                        &csd_whitelist_);
@@ -1321,7 +1343,8 @@ void SafeBrowsingDatabaseNew::UpdateFinished(bool update_succeeded) {
                        download_whitelist_store_.get(),
                        &download_whitelist_);
 
-  if (extension_blacklist_store_) {
+  if (extension_blacklist_store_ &&
+      !CancelUpdateIfUnchanged(extension_blacklist_store_.get())) {
     int64 size_bytes = UpdateHashPrefixStore(
         extension_blacklist_filename_,
         extension_blacklist_store_.get(),
@@ -1330,18 +1353,31 @@ void SafeBrowsingDatabaseNew::UpdateFinished(bool update_succeeded) {
                          static_cast<int>(size_bytes / 1024));
   }
 
-  if (side_effect_free_whitelist_store_)
+  if (side_effect_free_whitelist_store_ &&
+      !CancelUpdateIfUnchanged(side_effect_free_whitelist_store_.get())) {
     UpdateSideEffectFreeWhitelistStore();
+  }
 
-  if (ip_blacklist_store_)
+  if (ip_blacklist_store_ &&
+      !CancelUpdateIfUnchanged(ip_blacklist_store_.get())) {
     UpdateIpBlacklistStore();
+  }
+}
+
+bool SafeBrowsingDatabaseNew::CancelUpdateIfUnchanged(
+    SafeBrowsingStore* store) {
+  if (changed_stores_.count(store))
+    return false;
+
+  store->CancelUpdate();
+  return true;
 }
 
 void SafeBrowsingDatabaseNew::UpdateWhitelistStore(
     const base::FilePath& store_filename,
     SafeBrowsingStore* store,
     SBWhitelist* whitelist) {
-  if (!store)
+  if (!store || CancelUpdateIfUnchanged(store))
     return;
 
   // For the whitelists, we don't cache and save full hashes since all
@@ -1462,6 +1498,10 @@ void SafeBrowsingDatabaseNew::UpdateBrowseStore() {
     browse_prefix_set_.swap(prefix_set);
   }
 
+  // The old set may be mapped from the file which is about to be
+  // rewritten.
+  prefix_set.reset();
+
   DVLOG(1) << "SafeBrowsingDatabaseImpl built prefix set in "
            << (base::TimeTicks::Now() - before).InMilliseconds()
            << " ms total.  prefix count: " << add_prefixes.size();
@@ -1533,6 +1573,10 @@ void SafeBrowsingDatabaseNew::UpdateSideEffectFreeWhitelistStore() {
     side_effect_free_whitelist_prefix_set_.swap(prefix_set);
   }
 
+  // The old set may be mapped from the file which is about to be
+  // rewritten.
+  prefix_set.reset();
+
   const base::TimeTicks before = base::TimeTicks::Now();
   const bool write_ok = side_effect_free_whitelist_prefix_set_->WriteFile(
       side_effect_free_whitelist_prefix_set_filename_);
@@ -387,6 +387,11 @@ class SafeBrowsingDatabaseNew : public SafeBrowsingDatabase {
   void InsertSubChunks(safe_browsing_util::ListType list_id,
                        const SBChunkList& chunks);
 
+  // Cancels the update of |store| if no chunks were added to or deleted
+  // from it, which leaves its file alone.  Returns true if the update was
+  // cancelled.
+  bool CancelUpdateIfUnchanged(SafeBrowsingStore* store);
+
   // Returns the size in bytes of the store after the update.
   int64 UpdateHashPrefixStore(const base::FilePath& store_filename,
                                SafeBrowsingStore* store,
@@ -466,9 +471,10 @@ class SafeBrowsingDatabaseNew : public SafeBrowsingDatabase {
   // the next call to |UpdateStarted()|.
   bool corruption_detected_;
 
-  // Set to true if any chunks are added or deleted during an update.
-  // Used to optimize away database update.
-  bool change_detected_;
+  // The stores which had chunks added or deleted during an update.  Only
+  // these are rewritten when the update finishes, and the update is
+  // optimized away entirely if there are none.
+  std::set<SafeBrowsingStore*> changed_stores_;
 
   // Used to check if a prefix was in the browse database.
   base::FilePath browse_prefix_set_filename_;
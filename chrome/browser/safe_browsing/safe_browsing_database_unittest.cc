@@ -1675,6 +1675,79 @@ TEST_F(SafeBrowsingDatabaseTest, EmptyUpdate) {
   EXPECT_EQ(before_info.last_modified, after_info.last_modified);
 }
 
+// Test that an update only rewrites the stores it changed.
+TEST_F(SafeBrowsingDatabaseTest, UnchangedStoreNotRewritten) {
+  database_.reset();
+  base::MessageLoop loop;
+  database_.reset(new SafeBrowsingDatabaseNew(new SafeBrowsingStoreFile(),
+                                              new SafeBrowsingStoreFile(),
+                                              NULL,
+                                              NULL,
+                                              NULL,
+                                              NULL,
+                                              NULL));
+  database_->Init(database_filename_);
+
+  base::FilePath browse_filename =
+      database_->BrowseDBFilename(database_filename_);
+  base::FilePath download_filename =
+      database_->DownloadDBFilename(database_filename_);
+
+  // Prime both stores.
+  SBChunkList chunks;
+  SBChunk chunk;
+  std::vector<SBListChunkRanges> lists;
+  EXPECT_TRUE(database_->UpdateStarted(&lists));
+  InsertAddChunkHostPrefixUrl(&chunk, 1, "www.evil.com/",
+                              "www.evil.com/malware.html");
+  chunks.push_back(chunk);
+  database_->InsertChunks(safe_browsing_util::kMalwareList, chunks);
+  chunk.hosts.clear();
+  InsertAddChunkHostPrefixUrl(&chunk, 2, "www.evil.com/",
+                              "www.evil.com/download.exe");
+  chunks.clear();
+  chunks.push_back(chunk);
+  database_->InsertChunks(safe_browsing_util::kBinUrlList, chunks);
+  database_->UpdateFinished(true);
+
+  // Age both files so that a rewrite is detectable.
+  base::File::Info browse_before, browse_after;
+  base::File::Info download_before, download_after;
+  ASSERT_TRUE(base::GetFileInfo(browse_filename, &browse_before));
+  const base::Time old_last_modified =
+      browse_before.last_modified - base::TimeDelta::FromSeconds(10);
+  ASSERT_TRUE(base::TouchFile(browse_filename,
+                              old_last_modified, old_last_modified));
+  ASSERT_TRUE(base::TouchFile(download_filename,
+                              old_last_modified, old_last_modified));
+  ASSERT_TRUE(base::GetFileInfo(browse_filename, &browse_before));
+  ASSERT_TRUE(base::GetFileInfo(download_filename, &download_before));
+
+  // Changing only the download list leaves the browse store alone.
+  EXPECT_TRUE(database_->UpdateStarted(&lists));
+  chunk.hosts.clear();
+  InsertAddChunkHostPrefixUrl(&chunk, 3, "www.evil.com/",
+                              "www.evil.com/download2.exe");
+  chunks.clear();
+  chunks.push_back(chunk);
+  database_->InsertChunks(safe_browsing_util::kBinUrlList, chunks);
+  database_->UpdateFinished(true);
+  ASSERT_TRUE(base::GetFileInfo(browse_filename, &browse_after));
+  ASSERT_TRUE(base::GetFileInfo(download_filename, &download_after));
+  EXPECT_EQ(browse_before.last_modified, browse_after.last_modified);
+  EXPECT_LT(download_before.last_modified, download_after.last_modified);
+
+  // The browse data is still there.
+  std::vector<SBFullHashResult> full_hashes;
+  std::vector<SBPrefix> prefix_hits;
+  std::string matching_list;
+  EXPECT_TRUE(database_->ContainsBrowseUrl(
+      GURL("http://www.evil.com/malware.html"),
+      &matching_list, &prefix_hits, &full_hashes, Time::Now()));
+
+  database_.reset();
+}
+
 // Test that a filter file is written out during update and read back
 // in during setup.
 TEST_F(SafeBrowsingDatabaseTest, FilterFile) {
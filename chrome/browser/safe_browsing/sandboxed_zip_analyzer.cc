@@ -27,17 +27,26 @@ SandboxedZipAnalyzer::SandboxedZipAnalyzer(
     const base::FilePath& zip_file,
     const ResultCallback& result_callback)
     : zip_file_(zip_file),
+      zip_platform_file_(base::kInvalidPlatformFileValue),
       callback_(result_callback),
-      callback_called_(false) {
+      callback_called_(false),
+      zip_file_opened_(false),
+      utility_process_started_(false) {
 }
 
 void SandboxedZipAnalyzer::Start() {
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
-  // Starting the analyzer will block on opening the zip file, so run this
-  // on a worker thread.  The task does not need to block shutdown.
+  // Launching the utility process takes much longer than opening the zip
+  // file, so do both at once rather than one after the other.
+  BrowserThread::PostTask(
+      BrowserThread::IO, FROM_HERE,
+      base::Bind(&SandboxedZipAnalyzer::StartProcessOnIOThread, this));
+
+  // Opening the zip file blocks, so run this on a worker thread.  The task
+  // does not need to block shutdown.
   if (!BrowserThread::GetBlockingPool()->PostWorkerTaskWithShutdownBehavior(
           FROM_HERE,
-          base::Bind(&SandboxedZipAnalyzer::AnalyzeInSandbox, this),
+          base::Bind(&SandboxedZipAnalyzer::OpenZipFile, this),
           base::SequencedWorkerPool::CONTINUE_ON_SHUTDOWN)) {
     NOTREACHED();
   }
@@ -48,28 +57,22 @@ SandboxedZipAnalyzer::~SandboxedZipAnalyzer() {
   // the UI or IO thread.
 }
 
-void SandboxedZipAnalyzer::AnalyzeInSandbox() {
+void SandboxedZipAnalyzer::OpenZipFile() {
   zip_platform_file_ = base::CreatePlatformFile(
       zip_file_,
       base::PLATFORM_FILE_OPEN | base::PLATFORM_FILE_READ,
       NULL,   // created
       NULL);  // error_code
-  if (zip_platform_file_ == base::kInvalidPlatformFileValue) {
+  if (zip_platform_file_ == base::kInvalidPlatformFileValue)
     VLOG(1) << "Could not open zip file: " << zip_file_.value();
-    if (!BrowserThread::PostTask(
-            BrowserThread::IO, FROM_HERE,
-            base::Bind(&SandboxedZipAnalyzer::OnAnalyzeZipFileFinished, this,
-                       zip_analyzer::Results()))) {
-      NOTREACHED();
-    }
-    return;
-  }
 
-  BrowserThread::PostTask(
-      BrowserThread::IO, FROM_HERE,
-      base::Bind(&SandboxedZipAnalyzer::StartProcessOnIOThread, this));
   // The file will be closed on the IO thread once it has been handed
   // off to the child process.
+  if (!BrowserThread::PostTask(
+          BrowserThread::IO, FROM_HERE,
+          base::Bind(&SandboxedZipAnalyzer::OnZipFileOpened, this))) {
+    NOTREACHED();
+  }
 }
 
 bool SandboxedZipAnalyzer::OnMessageReceived(const IPC::Message& message) {
@@ -106,8 +109,28 @@ void SandboxedZipAnalyzer::StartProcessOnIOThread() {
   // utility process, so that we can dup the file handle.
 }
 
+void SandboxedZipAnalyzer::OnZipFileOpened() {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  zip_file_opened_ = true;
+  if (zip_platform_file_ == base::kInvalidPlatformFileValue)
+    OnAnalyzeZipFileFinished(zip_analyzer::Results());
+  StartAnalysisIfReady();
+}
+
 void SandboxedZipAnalyzer::OnUtilityProcessStarted() {
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  utility_process_started_ = true;
+  StartAnalysisIfReady();
+}
+
+void SandboxedZipAnalyzer::StartAnalysisIfReady() {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  if (!zip_file_opened_ || !utility_process_started_ || !utility_process_host_)
+    return;
+
+  // The utility process is sent the file even if it couldn't be opened: it
+  // fails the analysis of an invalid file, whose result is already reported,
+  // and exits as it would after any analysis.
   base::ProcessHandle utility_process =
       content::RenderProcessHost::run_renderer_in_process() ?
           base::GetCurrentProcessHandle() :
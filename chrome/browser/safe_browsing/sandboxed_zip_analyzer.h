@@ -42,9 +42,8 @@ class SandboxedZipAnalyzer : public content::UtilityProcessHostClient {
  private:
   virtual ~SandboxedZipAnalyzer();
 
-  // Creates the sandboxed utility process and tells it to start analysis.
-  // Runs on a worker thread.
-  void AnalyzeInSandbox();
+  // Opens the zip file for the utility process.  Runs on a worker thread.
+  void OpenZipFile();
 
   // content::UtilityProcessHostClient implementation.
   // These notifications run on the IO thread.
@@ -61,6 +60,13 @@ class SandboxedZipAnalyzer : public content::UtilityProcessHostClient {
   // Launches the utility process.  Must run on the IO thread.
   void StartProcessOnIOThread();
 
+  // Notification that OpenZipFile() is done.  Runs on the IO thread.
+  void OnZipFileOpened();
+
+  // Hands the zip file to the utility process once it is both opened and
+  // launched.  Runs on the IO thread.
+  void StartAnalysisIfReady();
+
   const base::FilePath zip_file_;
   // Once we have opened the file, we store the handle so that we can use it
   // once the utility process has launched.
@@ -69,6 +75,8 @@ class SandboxedZipAnalyzer : public content::UtilityProcessHostClient {
   const ResultCallback callback_;
   // Initialized on the UI thread, but only accessed on the IO thread.
   bool callback_called_;
+  bool zip_file_opened_;
+  bool utility_process_started_;
 
   DISALLOW_COPY_AND_ASSIGN(SandboxedZipAnalyzer);
 };
@@ -5,6 +5,7 @@
 #include "chrome/browser/sessions/session_backend.h"
 
 #include <limits>
+#include <string>
 
 #include "base/file_util.h"
 #include "base/memory/scoped_vector.h"
@@ -306,42 +307,38 @@ bool SessionBackend::ReadCurrentSessionCommandsImpl(
 
 bool SessionBackend::AppendCommandsToFile(net::FileStream* file,
     const std::vector<SessionCommand*>& commands) {
+  // Serialize all the commands first so that they are written with a single
+  // write rather than three per command.
+  std::string data;
   for (std::vector<SessionCommand*>::const_iterator i = commands.begin();
        i != commands.end(); ++i) {
-    int wrote;
     const size_type content_size = static_cast<size_type>((*i)->size());
     const size_type total_size =  content_size + sizeof(id_type);
     if (type_ == BaseSessionService::TAB_RESTORE)
       UMA_HISTOGRAM_COUNTS("TabRestore.command_size", total_size);
     else
       UMA_HISTOGRAM_COUNTS("SessionRestore.command_size", total_size);
-    wrote = file->WriteSync(reinterpret_cast<const char*>(&total_size),
-                            sizeof(total_size));
-    if (wrote != sizeof(total_size)) {
-      NOTREACHED() << "error writing";
-      return false;
-    }
+    data.append(reinterpret_cast<const char*>(&total_size),
+                sizeof(total_size));
     id_type command_id = (*i)->id();
-    wrote = file->WriteSync(reinterpret_cast<char*>(&command_id),
-                            sizeof(command_id));
-    if (wrote != sizeof(command_id)) {
-      NOTREACHED() << "error writing";
-      return false;
-    }
-    if (content_size > 0) {
-      wrote = file->WriteSync(reinterpret_cast<char*>((*i)->contents()),
-                              content_size);
-      if (wrote != content_size) {
-        NOTREACHED() << "error writing";
-        return false;
-      }
-    }
+    data.append(reinterpret_cast<const char*>(&command_id),
+                sizeof(command_id));
+    if (content_size > 0)
+      data.append((*i)->contents(), content_size);
+  }
+  if (data.empty())
+    return true;
+
+  int wrote = file->WriteSync(data.data(), static_cast<int>(data.size()));
+  if (wrote != static_cast<int>(data.size())) {
+    NOTREACHED() << "error writing";
+    return false;
+  }
 #if defined(OS_CHROMEOS)
-    // TODO(gspencer): Remove this once we find a better place to do it.
-    // See issue http://crbug.com/245015
-    file->FlushSync();
+  // TODO(gspencer): Remove this once we find a better place to do it.
+  // See issue http://crbug.com/245015
+  file->FlushSync();
 #endif
-  }
   return true;
 }
 
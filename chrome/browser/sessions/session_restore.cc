@@ -19,6 +19,7 @@
 #include "base/platform_file.h"
 #include "base/stl_util.h"
 #include "base/strings/stringprintf.h"
+#include "base/sys_info.h"
 #include "base/task/cancelable_task_tracker.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/browser/chrome_notification_types.h"
@@ -77,11 +78,18 @@ std::set<SessionRestoreImpl*>* active_session_restorers = NULL;
 // Initial delay (see class decription for details).
 static const int kInitialDelayTimerMS = 100;
 
+// Amount of physical memory per tab that may load in parallel, and the most
+// tabs that may load in parallel (see class description for details).
+static const int kPhysicalMemoryMBPerParallelTabLoad = 2048;
+static const size_t kMaxParallelTabLoads = 4;
+
 // TabLoader is responsible for loading tabs after session restore creates
 // tabs. New tabs are loaded after the current tab finishes loading, or a delay
 // is reached (initially kInitialDelayTimerMS). If the delay is reached before
 // a tab finishes loading a new tab is loaded and the time of the delay
-// doubled.
+// doubled. The number of tabs loading in parallel is capped by the amount of
+// physical memory, so that restoring many tabs doesn't thrash; once the cap
+// is reached the next tab is only loaded when a loading tab finishes.
 //
 // TabLoader keeps a reference to itself when it's loading. When it has finished
 // loading, it drops the reference. If another profile is restored while the
@@ -121,8 +129,9 @@ class TabLoader : public content::NotificationObserver,
   explicit TabLoader(base::TimeTicks restore_started);
   virtual ~TabLoader();
 
-  // Loads the next tab. If there are no more tabs to load this deletes itself,
-  // otherwise |force_load_timer_| is restarted.
+  // Loads the next tab, unless |max_parallel_tab_loads_allowed_| tabs are
+  // already loading. If there are more tabs to load and one was started,
+  // |force_load_timer_| is restarted.
   void LoadNextTab();
 
   // NotificationObserver method. Removes the specified tab and loads the next
@@ -190,6 +199,9 @@ class TabLoader : public content::NotificationObserver,
   // Max number of tabs that were loaded in parallel (for metrics).
   size_t max_parallel_tab_loads_;
 
+  // Max number of tabs that may load in parallel.
+  const size_t max_parallel_tab_loads_allowed_;
+
   // For keeping TabLoader alive while it's loading even if no
   // SessionRestoreImpls reference it.
   scoped_refptr<TabLoader> this_retainer_;
@@ -254,7 +266,11 @@ TabLoader::TabLoader(base::TimeTicks restore_started)
       got_first_paint_(false),
       tab_count_(0),
       restore_started_(restore_started),
-      max_parallel_tab_loads_(0) {
+      max_parallel_tab_loads_(0),
+      max_parallel_tab_loads_allowed_(std::max<size_t>(1, std::min<size_t>(
+          kMaxParallelTabLoads,
+          base::SysInfo::AmountOfPhysicalMemoryMB() /
+              kPhysicalMemoryMBPerParallelTabLoad))) {
 }
 
 TabLoader::~TabLoader() {
@@ -265,6 +281,13 @@ TabLoader::~TabLoader() {
 }
 
 void TabLoader::LoadNextTab() {
+  // The tabs that are loading take up all the parallel loads. The next tab is
+  // loaded when one of them finishes.
+  if (!tabs_to_load_.empty() &&
+      tabs_loading_.size() >= max_parallel_tab_loads_allowed_) {
+    return;
+  }
+
   if (!tabs_to_load_.empty()) {
     NavigationController* tab = tabs_to_load_.front();
     DCHECK(tab);
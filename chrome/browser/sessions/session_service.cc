@@ -83,7 +83,10 @@ static const SessionCommand::id_type kCommandSetTabUserAgentOverride = 18;
 static const SessionCommand::id_type kCommandSessionStorageAssociated = 19;
 static const SessionCommand::id_type kCommandSetActiveWindow = 20;
 
-// Every kWritesPerReset commands triggers recreating the file.
+// Every kWritesPerReset commands triggers recreating the file. If the last
+// reset wrote more commands than that, the next reset waits for as many
+// commands to be appended, so that resets of a large session at most double
+// the amount written.
 static const int kWritesPerReset = 250;
 
 namespace {
@@ -186,6 +189,7 @@ bool MigrateClosedPayload(const SessionCommand& command,
 SessionService::SessionService(Profile* profile)
     : BaseSessionService(SESSION_RESTORE, profile, base::FilePath()),
       has_open_trackable_browsers_(false),
+      commands_in_last_reset_(0),
       move_on_new_browser_(false),
       save_delay_in_millis_(base::TimeDelta::FromMilliseconds(2500)),
       save_delay_in_mins_(base::TimeDelta::FromMinutes(10)),
@@ -197,6 +201,7 @@ SessionService::SessionService(Profile* profile)
 SessionService::SessionService(const base::FilePath& save_path)
     : BaseSessionService(SESSION_RESTORE, NULL, save_path),
       has_open_trackable_browsers_(false),
+      commands_in_last_reset_(0),
       move_on_new_browser_(false),
       save_delay_in_millis_(base::TimeDelta::FromMilliseconds(2500)),
       save_delay_in_mins_(base::TimeDelta::FromMinutes(10)),
@@ -1409,6 +1414,7 @@ void SessionService::ScheduleReset() {
   windows_tracking_.clear();
   BuildCommandsFromBrowsers(&pending_commands(), &tab_to_available_range_,
                             &windows_tracking_);
+  commands_in_last_reset_ = pending_commands().size();
   if (!windows_tracking_.empty()) {
     // We're lazily created on startup and won't get an initial batch of
     // SetWindowType messages. Set these here to make sure our state is correct.
@@ -1482,6 +1488,7 @@ void SessionService::ScheduleCommand(SessionCommand* command) {
   // lose tabs/windows we want to restore from if we exit right after this.
   if (!pending_reset() && pending_window_close_ids_.empty() &&
       commands_since_reset() >= kWritesPerReset &&
+      static_cast<size_t>(commands_since_reset()) >= commands_in_last_reset_ &&
       (command->id() != kCommandTabClosed &&
        command->id() != kCommandWindowClosed)) {
     ScheduleReset();
@@ -485,6 +485,9 @@ class SessionService : public BaseSessionService,
   // Are there any open trackable browsers?
   bool has_open_trackable_browsers_;
 
+  // Number of commands the last reset rewrote the file with.
+  size_t commands_in_last_reset_;
+
   // If true and a new tabbed browser is created and there are no opened tabbed
   // browser (has_open_trackable_browsers_ is false), then the current session
   // is made the last session. See description above class for details on
@@ -0,0 +1,107 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/startup_task_scheduler.h"
+
+#include "base/bind.h"
+#include "base/debug/trace_event.h"
+#include "base/location.h"
+#include "base/logging.h"
+#include "base/message_loop/message_loop.h"
+#include "components/startup_metric_utils/startup_metric_utils.h"
+#include "content/public/browser/notification_service.h"
+#include "content/public/browser/notification_types.h"
+
+namespace {
+
+// How long to wait for the first page to load before running the tasks anyway.
+const int kStartTimeoutSeconds = 10;
+
+// How long after the AFTER_FIRST_PAINT tasks the IDLE tasks start.
+const int kIdleDelaySeconds = 5;
+
+}  // namespace
+
+StartupTaskScheduler::StartupTaskScheduler()
+    : started_(false),
+      idle_started_(false),
+      task_pending_(false),
+      idle_delay_(base::TimeDelta::FromSeconds(kIdleDelaySeconds)),
+      weak_factory_(this) {
+  registrar_.Add(this,
+                 content::NOTIFICATION_LOAD_COMPLETED_MAIN_FRAME,
+                 content::NotificationService::AllSources());
+  timeout_timer_.Start(FROM_HERE,
+                       base::TimeDelta::FromSeconds(kStartTimeoutSeconds),
+                       this,
+                       &StartupTaskScheduler::StartRunningTasks);
+}
+
+StartupTaskScheduler::~StartupTaskScheduler() {
+}
+
+void StartupTaskScheduler::AddTask(Priority priority,
+                                   const base::Closure& task) {
+  DCHECK_LT(priority, NUM_PRIORITIES);
+  tasks_[priority].push_back(task);
+  ScheduleNextTask();
+}
+
+void StartupTaskScheduler::StartRunningTasks() {
+  if (started_)
+    return;
+  started_ = true;
+  registrar_.RemoveAll();
+  timeout_timer_.Stop();
+  ScheduleNextTask();
+}
+
+void StartupTaskScheduler::Observe(
+    int type,
+    const content::NotificationSource& source,
+    const content::NotificationDetails& details) {
+  DCHECK_EQ(content::NOTIFICATION_LOAD_COMPLETED_MAIN_FRAME, type);
+  StartRunningTasks();
+}
+
+void StartupTaskScheduler::ScheduleNextTask() {
+  if (!started_ || task_pending_)
+    return;
+
+  base::TimeDelta delay;
+  if (tasks_[AFTER_FIRST_PAINT].empty()) {
+    if (tasks_[IDLE].empty())
+      return;
+    if (!idle_started_) {
+      idle_started_ = true;
+      delay = idle_delay_;
+    }
+  }
+
+  task_pending_ = true;
+  base::MessageLoop::current()->PostDelayedTask(
+      FROM_HERE,
+      base::Bind(&StartupTaskScheduler::RunNextTask,
+                 weak_factory_.GetWeakPtr()),
+      delay);
+}
+
+void StartupTaskScheduler::RunNextTask() {
+  task_pending_ = false;
+
+  Priority priority = tasks_[AFTER_FIRST_PAINT].empty() ?
+      IDLE : AFTER_FIRST_PAINT;
+  DCHECK(!tasks_[priority].empty());
+  base::Closure task = tasks_[priority].front();
+  tasks_[priority].pop_front();
+  {
+    TRACE_EVENT1("startup", "StartupTaskScheduler::RunNextTask",
+                 "priority", priority);
+    startup_metric_utils::ScopedSlowStartupUMA
+        scoped_timer("Startup.SlowStartupDeferredTask");
+    task.Run();
+  }
+
+  ScheduleNextTask();
+}
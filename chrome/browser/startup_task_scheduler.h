@@ -0,0 +1,85 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CHROME_BROWSER_STARTUP_TASK_SCHEDULER_H_
+#define CHROME_BROWSER_STARTUP_TASK_SCHEDULER_H_
+
+#include <deque>
+
+#include "base/basictypes.h"
+#include "base/callback.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "content/public/browser/notification_observer.h"
+#include "content/public/browser/notification_registrar.h"
+
+// Runs the startup work that the first browser window does not need once the
+// first page has loaded, so that it does not delay the first paint. If no page
+// loads, e.g. when the browser starts in the background, the tasks start after
+// a timeout instead.
+//
+// The tasks run one per message loop iteration, so that input is handled in
+// between, in the order of their priority and then of their addition. A task
+// that depends on another one is added after it, with the same or a lower
+// priority. Pending tasks are dropped when the scheduler is destroyed, so they
+// may bind objects that outlive it. Must be used on the UI thread.
+class StartupTaskScheduler : public content::NotificationObserver {
+ public:
+  enum Priority {
+    // Runs as soon as the first page has loaded.
+    AFTER_FIRST_PAINT,
+    // Runs a while after that, when the browser is likely to be idle.
+    IDLE,
+    NUM_PRIORITIES,
+  };
+
+  StartupTaskScheduler();
+  virtual ~StartupTaskScheduler();
+
+  // Queues |task| to run with |priority|.
+  void AddTask(Priority priority, const base::Closure& task);
+
+  // Starts running the queued tasks. This is called when the first page has
+  // loaded or the timeout expired; later calls do nothing.
+  void StartRunningTasks();
+
+  void set_idle_delay_for_testing(base::TimeDelta idle_delay) {
+    idle_delay_ = idle_delay;
+  }
+
+  // content::NotificationObserver:
+  virtual void Observe(int type,
+                       const content::NotificationSource& source,
+                       const content::NotificationDetails& details) OVERRIDE;
+
+ private:
+  // Posts RunNextTask() if tasks are ready to run and it is not posted yet.
+  void ScheduleNextTask();
+
+  // Runs the first task of the highest priority, then schedules the next one.
+  void RunNextTask();
+
+  std::deque<base::Closure> tasks_[NUM_PRIORITIES];
+
+  // Whether StartRunningTasks() was called.
+  bool started_;
+
+  // Whether the IDLE tasks may run, i.e. |idle_delay_| has passed since the
+  // AFTER_FIRST_PAINT tasks ran out.
+  bool idle_started_;
+
+  // Whether RunNextTask() is posted.
+  bool task_pending_;
+
+  base::TimeDelta idle_delay_;
+
+  content::NotificationRegistrar registrar_;
+  base::OneShotTimer<StartupTaskScheduler> timeout_timer_;
+  base::WeakPtrFactory<StartupTaskScheduler> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(StartupTaskScheduler);
+};
+
+#endif  // CHROME_BROWSER_STARTUP_TASK_SCHEDULER_H_
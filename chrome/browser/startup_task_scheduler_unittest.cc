@@ -0,0 +1,65 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/startup_task_scheduler.h"
+
+#include <vector>
+
+#include "base/bind.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/run_loop.h"
+#include "content/public/test/test_browser_thread_bundle.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+void AppendValue(std::vector<int>* values, int value) {
+  values->push_back(value);
+}
+
+class StartupTaskSchedulerTest : public testing::Test {
+ protected:
+  StartupTaskSchedulerTest() : scheduler_(new StartupTaskScheduler) {
+    scheduler_->set_idle_delay_for_testing(base::TimeDelta());
+  }
+
+  void AddTask(StartupTaskScheduler::Priority priority, int value) {
+    scheduler_->AddTask(priority, base::Bind(&AppendValue, &ran_, value));
+  }
+
+  content::TestBrowserThreadBundle thread_bundle_;
+  scoped_ptr<StartupTaskScheduler> scheduler_;
+  std::vector<int> ran_;
+};
+
+}  // namespace
+
+TEST_F(StartupTaskSchedulerTest, RunsByPriorityAfterStart) {
+  AddTask(StartupTaskScheduler::IDLE, 3);
+  AddTask(StartupTaskScheduler::AFTER_FIRST_PAINT, 1);
+  AddTask(StartupTaskScheduler::AFTER_FIRST_PAINT, 2);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(ran_.empty());
+
+  scheduler_->StartRunningTasks();
+  base::RunLoop().RunUntilIdle();
+  ASSERT_EQ(3u, ran_.size());
+  EXPECT_EQ(1, ran_[0]);
+  EXPECT_EQ(2, ran_[1]);
+  EXPECT_EQ(3, ran_[2]);
+
+  // Tasks added later run too.
+  AddTask(StartupTaskScheduler::IDLE, 4);
+  base::RunLoop().RunUntilIdle();
+  ASSERT_EQ(4u, ran_.size());
+  EXPECT_EQ(4, ran_[3]);
+}
+
+TEST_F(StartupTaskSchedulerTest, DestructionDropsPendingTasks) {
+  AddTask(StartupTaskScheduler::AFTER_FIRST_PAINT, 1);
+  scheduler_->StartRunningTasks();
+  scheduler_.reset();
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(ran_.empty());
+}
@@ -388,6 +388,8 @@ void DataTypeManagerImpl::OnSingleDataTypeAssociationDone(
     const syncer::DataTypeAssociationStats& association_stats) {
   DCHECK(!association_types_queue_.empty());
 
+  observer_->OnDataTypeAssociationDone(type, association_stats);
+
   if (!debug_info_listener_.IsInitialized())
     return;
 
@@ -97,6 +97,9 @@ class DataTypeManagerObserverMock : public DataTypeManagerObserver {
                void(const browser_sync::DataTypeManager::ConfigureResult&));
   MOCK_METHOD0(OnConfigureRetry, void());
   MOCK_METHOD0(OnConfigureStart, void());
+  MOCK_METHOD2(OnDataTypeAssociationDone,
+               void(syncer::ModelType,
+                    const syncer::DataTypeAssociationStats&));
 };
 
 class FakeDataTypeEncryptionHandler : public DataTypeEncryptionHandler {
@@ -288,6 +291,7 @@ TEST_F(SyncDataTypeManagerImplTest, ConfigureOne) {
   FinishDownload(*dtm_, ModelTypeSet(BOOKMARKS), ModelTypeSet());
   EXPECT_EQ(DataTypeManager::CONFIGURING, dtm_->state());
 
+  EXPECT_CALL(observer_, OnDataTypeAssociationDone(BOOKMARKS, _));
   GetController(BOOKMARKS)->FinishStart(DataTypeController::OK);
   EXPECT_EQ(DataTypeManager::CONFIGURED, dtm_->state());
 
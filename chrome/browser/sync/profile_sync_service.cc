@@ -82,6 +82,7 @@
 #include "sync/js/js_arg_list.h"
 #include "sync/js/js_event_details.h"
 #include "sync/util/cryptographer.h"
+#include "sync/util/data_type_histogram.h"
 #include "ui/base/l10n/l10n_util.h"
 #include "ui/base/l10n/time_format.h"
 
@@ -1472,6 +1473,19 @@ void ProfileSyncService::OnConfigureStart() {
   NotifyObservers();
 }
 
+void ProfileSyncService::OnDataTypeAssociationDone(
+    syncer::ModelType type,
+    const syncer::DataTypeAssociationStats& association_stats) {
+  // The association time itself is recorded by the controllers; the wait time
+  // shows how long a type was held up by model loading and by the types
+  // associating before it on the same thread.
+#define PER_DATA_TYPE_MACRO(type_str) \
+  UMA_HISTOGRAM_LONG_TIMES("Sync." type_str "AssociationWaitTime", \
+                           association_stats.association_wait_time);
+  SYNC_DATA_TYPE_HISTOGRAM(type);
+#undef PER_DATA_TYPE_MACRO
+}
+
 ProfileSyncService::SyncStatusSummary
       ProfileSyncService::QuerySyncStatusSummary() {
   if (HasUnrecoverableError()) {
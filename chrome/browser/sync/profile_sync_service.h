@@ -396,6 +396,9 @@ class ProfileSyncService
       const browser_sync::DataTypeManager::ConfigureResult& result) OVERRIDE;
   virtual void OnConfigureRetry() OVERRIDE;
   virtual void OnConfigureStart() OVERRIDE;
+  virtual void OnDataTypeAssociationDone(
+      syncer::ModelType type,
+      const syncer::DataTypeAssociationStats& association_stats) OVERRIDE;
 
   // DataTypeEncryptionHandler implementation.
   virtual bool IsPassphraseRequired() const OVERRIDE;
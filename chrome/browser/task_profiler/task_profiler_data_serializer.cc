@@ -54,13 +54,19 @@ void BirthOnThreadSnapshotToValue(const BirthOnThreadSnapshot& birth,
                   base::Value::CreateStringValue(birth.thread_name));
 }
 
-// Re-serializes the |death_data| into |dictionary|.
+// Re-serializes the |death_data| into |dictionary|.  When only some runs were
+// timed, the totals are estimated from them, and the "_error" values are the
+// half widths of their 95% confidence intervals.
 void DeathDataSnapshotToValue(const DeathDataSnapshot& death_data,
                               base::DictionaryValue* dictionary) {
   dictionary->Set("count",
                   base::Value::CreateIntegerValue(death_data.count));
   dictionary->Set("run_ms",
-                  base::Value::CreateIntegerValue(death_data.run_duration_sum));
+                  base::Value::CreateIntegerValue(
+                      death_data.EstimatedRunDurationSum()));
+  dictionary->Set("run_ms_error",
+                  base::Value::CreateIntegerValue(
+                      death_data.RunDurationSumError()));
   dictionary->Set("run_ms_max",
                   base::Value::CreateIntegerValue(death_data.run_duration_max));
   dictionary->Set("run_ms_sample",
@@ -68,7 +74,10 @@ void DeathDataSnapshotToValue(const DeathDataSnapshot& death_data,
                       death_data.run_duration_sample));
   dictionary->Set("queue_ms",
                   base::Value::CreateIntegerValue(
-                      death_data.queue_duration_sum));
+                      death_data.EstimatedQueueDurationSum()));
+  dictionary->Set("queue_ms_error",
+                  base::Value::CreateIntegerValue(
+                      death_data.QueueDurationSumError()));
   dictionary->Set("queue_ms_max",
                   base::Value::CreateIntegerValue(
                       death_data.queue_duration_max));
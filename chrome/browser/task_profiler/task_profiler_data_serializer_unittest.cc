@@ -129,9 +129,11 @@ TEST(TaskProfilerDataSerializerTest, SerializeProcessDataToJson) {
                              "\"death_data\":{"
                                 "\"count\":37,"
                                 "\"queue_ms\":79,"
+                                "\"queue_ms_error\":0,"
                                 "\"queue_ms_max\":53,"
                                 "\"queue_ms_sample\":13,"
                                 "\"run_ms\":17,"
+                                "\"run_ms_error\":0,"
                                 "\"run_ms_max\":5,"
                                 "\"run_ms_sample\":3"
                              "},"
@@ -146,9 +148,11 @@ TEST(TaskProfilerDataSerializerTest, SerializeProcessDataToJson) {
                              "\"death_data\":{"
                                 "\"count\":41,"
                                 "\"queue_ms\":2079,"
+                                "\"queue_ms_error\":0,"
                                 "\"queue_ms_max\":2053,"
                                 "\"queue_ms_sample\":2013,"
                                 "\"run_ms\":2017,"
+                                "\"run_ms_error\":0,"
                                 "\"run_ms_max\":205,"
                                 "\"run_ms_sample\":203"
                              "},"
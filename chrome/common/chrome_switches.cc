@@ -949,6 +949,13 @@ const char kHostResolverParallelism[]       = "host-resolver-parallelism";
 // to disable host resolver retry attempts.
 const char kHostResolverRetryAttempts[]     = "host-resolver-retry-attempts";
 
+// The number of milliseconds after which a host resolve request is answered
+// with an expired cache entry, if there is one. The resolution keeps running
+// to refresh the entry. This also saves the host cache to the user data
+// directory on shutdown, including the hosts resolved for incognito windows,
+// and loads it on startup.
+const char kHostResolverStaleDelayMs[]      = "host-resolver-stale-delay-ms";
+
 // Causes net::URLFetchers to ignore requests for SSL client certificates,
 // causing them to attempt an unauthenticated SSL/TLS session. This is intended
 // for use when testing various service URLs (eg: kPromoServerURL, kSbURLPrefix,
@@ -1035,6 +1042,11 @@ const char kNativeMessagingHosts[]          = "native-messaging-hosts";
 // Intended primarily for use with --log-net-log.
 const char kNetLogLevel[]                   = "net-log-level";
 
+// Caps the size in bytes of the file written by --log-net-log. Events that
+// arrive after the file reaches the cap are dropped, so that logging for a
+// long time costs neither unbounded disk nor time spent serializing events.
+const char kNetLogMaxFileSize[]             = "net-log-max-file-size";
+
 // Use new profile management system, including profile sign-out and new
 // choosers.
 const char kNewProfileManagement[]          = "new-profile-management";
@@ -1139,6 +1151,11 @@ const char kParentProfile[]                 = "parent-profile";
 // default interval is used).
 const char kPerformanceMonitorGathering[]   = "performance-monitor-gathering";
 
+// Saves the SSL session cache to the user data directory on shutdown,
+// encrypted, and loads it on startup, so that connections made right after
+// startup can resume their sessions.
+const char kPersistSSLSessions[]            = "persist-ssl-sessions";
+
 // Read previously recorded data from the cache. Only cached data is read.
 // See kRecordMode.
 const char kPlaybackMode[]                  = "playback-mode";
@@ -262,6 +262,7 @@ extern const char kHomePage[];
 extern const char kHostRules[];
 extern const char kHostResolverParallelism[];
 extern const char kHostResolverRetryAttempts[];
+extern const char kHostResolverStaleDelayMs[];
 extern const char kIgnoreUrlFetcherCertRequests[];
 extern const char kIncognito[];
 extern const char kInstallFromWebstore[];
@@ -284,6 +285,7 @@ extern const char kMetricsRecordingOnly[];
 extern const char kMultiProfiles[];
 extern const char kNativeMessagingHosts[];
 extern const char kNetLogLevel[];
+extern const char kNetLogMaxFileSize[];
 extern const char kNewProfileManagement[];
 extern const char kNoDefaultBrowserCheck[];
 extern const char kNoDisplayingInsecureContent[];
@@ -309,6 +311,7 @@ extern const char kPackExtension[];
 extern const char kPackExtensionKey[];
 extern const char kParentProfile[];
 extern const char kPerformanceMonitorGathering[];
+extern const char kPersistSSLSessions[];
 extern const char kPlaybackMode[];
 extern const char kPnaclDir[];
 extern const char kPpapiFlashPath[];
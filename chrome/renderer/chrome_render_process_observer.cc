@@ -18,6 +18,7 @@
 #include "base/metrics/statistics_recorder.h"
 #include "base/native_library.h"
 #include "base/path_service.h"
+#include "base/process/process_metrics.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/platform_thread.h"
 #include "chrome/common/child_process_logging.h"
@@ -411,10 +412,21 @@ void ChromeRenderProcessObserver::OnGetV8HeapStats() {
   HeapStatisticsCollector::Instance()->InitiateCollection();
 }
 
-void ChromeRenderProcessObserver::OnPurgeMemory() {
+void ChromeRenderProcessObserver::OnPurgeMemory(bool critical) {
   if (!webkit_initialized_)
     return;
 
+#if !defined(OS_MACOSX)
+  scoped_ptr<base::ProcessMetrics> metrics(
+      base::ProcessMetrics::CreateProcessMetrics(
+          base::GetCurrentProcessHandle()));
+#else
+  scoped_ptr<base::ProcessMetrics> metrics(
+      base::ProcessMetrics::CreateProcessMetrics(
+          base::GetCurrentProcessHandle(), NULL));
+#endif
+  size_t working_set_before = metrics->GetWorkingSetSize();
+
   // Clear the object cache (as much as possible; some live objects cannot be
   // freed).
   WebCache::clear();
@@ -430,13 +442,27 @@ void ChromeRenderProcessObserver::OnPurgeMemory() {
   while (sqlite3_release_memory(std::numeric_limits<int>::max()) > 0) {
   }
 
-  v8::V8::LowMemoryNotification();
+  if (critical) {
+    // A full garbage collection, which also drops compiled code, pauses the
+    // page for a while; only do it when memory is critically low.
+    v8::V8::LowMemoryNotification();
+  } else if (!v8::V8::IdleNotification()) {
+    v8::V8::IdleNotification();
+  }
 
   // Tell our allocator to release any free pages it's still holding.
   base::allocator::ReleaseFreeMemory();
 
-  if (client_)
+  if (critical && client_)
     client_->OnPurgeMemory();
+
+  size_t working_set_after = metrics->GetWorkingSetSize();
+  int purged_kb = working_set_before > working_set_after ?
+      static_cast<int>((working_set_before - working_set_after) / 1024) : 0;
+  if (critical)
+    UMA_HISTOGRAM_MEMORY_KB("Memory.Renderer.PurgedKB.Critical", purged_kb);
+  else
+    UMA_HISTOGRAM_MEMORY_KB("Memory.Renderer.PurgedKB.Moderate", purged_kb);
 }
 
 void ChromeRenderProcessObserver::ExecutePendingClearCache() {
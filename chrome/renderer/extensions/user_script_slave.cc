@@ -143,6 +143,7 @@ void UserScriptSlave::GetActiveExtensions(
 
 bool UserScriptSlave::UpdateScripts(base::SharedMemoryHandle shared_memory) {
   scripts_.clear();
+  script_sources_.clear();
 
   bool only_inject_incognito =
       ChromeRenderProcessObserver::is_incognito_process();
@@ -305,29 +306,19 @@ void UserScriptSlave::InjectScripts(WebFrame* frame,
 
     if (script->run_location() == location) {
       num_scripts += script->js_scripts().size();
-      for (size_t j = 0; j < script->js_scripts().size(); ++j) {
-        UserScript::File &file = script->js_scripts()[j];
-        std::string content = file.GetContent().as_string();
-
-        // We add this dumb function wrapper for standalone user script to
-        // emulate what Greasemonkey does.
-        // TODO(aa): I think that maybe "is_standalone" scripts don't exist
-        // anymore. Investigate.
-        if (script->is_standalone() || script->emulate_greasemonkey()) {
-          content.insert(0, kUserScriptHead);
-          content += kUserScriptTail;
-        }
-        sources.push_back(
-            WebScriptSource(WebString::fromUTF8(content), file.url()));
-      }
+      for (size_t j = 0; j < script->js_scripts().size(); ++j)
+        sources.push_back(GetScriptSource(*script, script->js_scripts()[j]));
     }
 
     if (!sources.empty()) {
       // Emulate Greasemonkey API for scripts that were converted to extensions
       // and "standalone" user scripts.
       if (script->is_standalone() || script->emulate_greasemonkey()) {
-        sources.insert(sources.begin(),
-            WebScriptSource(WebString::fromUTF8(api_js_.as_string())));
+        if (!api_js_source_) {
+          api_js_source_.reset(
+              new WebScriptSource(WebString::fromUTF8(api_js_.as_string())));
+        }
+        sources.insert(sources.begin(), *api_js_source_);
       }
 
       int isolated_world_id = GetIsolatedWorldIdForExtension(extension, frame);
@@ -378,4 +369,26 @@ void UserScriptSlave::InjectScripts(WebFrame* frame,
   }
 }
 
+const WebScriptSource& UserScriptSlave::GetScriptSource(
+    const UserScript& script,
+    const UserScript::File& file) {
+  ScriptSourceMap::iterator it = script_sources_.find(&file);
+  if (it != script_sources_.end())
+    return it->second;
+
+  std::string content = file.GetContent().as_string();
+
+  // We add this dumb function wrapper for standalone user script to
+  // emulate what Greasemonkey does.
+  // TODO(aa): I think that maybe "is_standalone" scripts don't exist
+  // anymore. Investigate.
+  if (script.is_standalone() || script.emulate_greasemonkey()) {
+    content.insert(0, kUserScriptHead);
+    content += kUserScriptTail;
+  }
+  return script_sources_.insert(std::make_pair(
+      &file,
+      WebScriptSource(WebString::fromUTF8(content), file.url()))).first->second;
+}
+
 }  // namespace extensions
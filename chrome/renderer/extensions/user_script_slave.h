@@ -67,6 +67,12 @@ class UserScriptSlave {
   static void InitializeIsolatedWorld(int isolated_world_id,
                                       const Extension* extension);
 
+  // Returns the source to inject for |file| of |script|. The UTF-16 source
+  // is built on first use and kept until the next UpdateScripts(), so that
+  // it is not decoded again for every matching frame.
+  const WebScriptSource& GetScriptSource(const UserScript& script,
+                                         const UserScript::File& file);
+
   // Shared memory containing raw script data.
   scoped_ptr<base::SharedMemory> shared_memory_;
 
@@ -77,6 +83,13 @@ class UserScriptSlave {
   // Greasemonkey API source that is injected with the scripts.
   base::StringPiece api_js_;
 
+  // The injected form of |api_js_|, created on first use.
+  scoped_ptr<WebScriptSource> api_js_source_;
+
+  // Sources of the content scripts in |scripts_| that have been injected.
+  typedef std::map<const UserScript::File*, WebScriptSource> ScriptSourceMap;
+  ScriptSourceMap script_sources_;
+
   // Extension metadata.
   const ExtensionSet* extensions_;
 
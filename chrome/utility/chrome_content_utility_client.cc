@@ -13,6 +13,8 @@
 #include "base/memory/ref_counted.h"
 #include "base/path_service.h"
 #include "base/scoped_native_library.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/thread.h"
 #include "base/time/time.h"
 #include "chrome/common/chrome_paths.h"
 #include "chrome/common/chrome_utility_messages.h"
@@ -89,6 +91,24 @@ void ReleaseProcessIfNeeded() {
   content::UtilityThread::Get()->ReleaseProcessIfNeeded();
 }
 
+// Encodes |image| as a PWG page and appends it to |bitmap_file|, then signals
+// |done|. Runs on the encoder thread while the next page is being rendered.
+void EncodeAndWritePWGPage(const cloud_print::PwgEncoder* encoder,
+                           const cloud_print::BitmapImage* image,
+                           int dpi,
+                           int total_page_count,
+                           base::PlatformFile bitmap_file,
+                           bool* succeeded,
+                           base::WaitableEvent* done) {
+  std::string pwg_page;
+  *succeeded =
+      encoder->EncodePage(*image, dpi, total_page_count, &pwg_page) &&
+      base::WritePlatformFileAtCurrentPos(bitmap_file, pwg_page.data(),
+                                          pwg_page.size()) ==
+          static_cast<int>(pwg_page.size());
+  done->Signal();
+}
+
 class PdfFunctionsBase {
  public:
   PdfFunctionsBase() : render_pdf_to_bitmap_func_(NULL),
@@ -691,25 +711,43 @@ bool ChromeContentUtilityClient::RenderPDFPagesToPWGRaster(
   if (bytes_written != static_cast<int>(pwg_header.size()))
     return false;
 
-  cloud_print::BitmapImage image(settings.area().size(),
-                                 cloud_print::BitmapImage::BGRA);
+  // The PDF library is not thread safe, so pages are rendered one at a time
+  // here while the previous page is encoded and written on |encoder_thread|.
+  // That keeps at most two page bitmaps in memory.
+  cloud_print::BitmapImage first_image(settings.area().size(),
+                                       cloud_print::BitmapImage::BGRA);
+  cloud_print::BitmapImage second_image(settings.area().size(),
+                                        cloud_print::BitmapImage::BGRA);
+  cloud_print::BitmapImage* images[] = { &first_image, &second_image };
+  base::WaitableEvent page_written(false, true);
+  bool write_succeeded = true;
+
+  // Declared last so that it is joined before the state it uses goes away.
+  base::Thread encoder_thread("PWGEncoderThread");
+  if (!encoder_thread.Start())
+    return false;
+
   for (int i = 0; i < total_page_count; ++i) {
-    if (!g_pdf_lib.Get().RenderPDFPageToBitmap(
-             data.data(), data.size(), i, image.pixel_data(),
-             image.size().width(), image.size().height(), settings.dpi(),
-             settings.dpi(), autoupdate)) {
-      return false;
-    }
-    std::string pwg_page;
-    if (!encoder.EncodePage(image, settings.dpi(), total_page_count, &pwg_page))
-      return false;
-    bytes_written = base::WritePlatformFileAtCurrentPos(bitmap_file,
-                                                        pwg_page.data(),
-                                                        pwg_page.size());
-    if (bytes_written != static_cast<int>(pwg_page.size()))
+    cloud_print::BitmapImage* image = images[i % 2];
+    bool rendered = g_pdf_lib.Get().RenderPDFPageToBitmap(
+        data.data(), data.size(), i, image->pixel_data(),
+        image->size().width(), image->size().height(), settings.dpi(),
+        settings.dpi(), autoupdate);
+
+    // The previous page must be written before this one, and before its
+    // bitmap is rendered into again.
+    page_written.Wait();
+    if (!rendered || !write_succeeded)
       return false;
+
+    encoder_thread.message_loop()->PostTask(
+        FROM_HERE,
+        base::Bind(&EncodeAndWritePWGPage, &encoder, image, settings.dpi(),
+                   total_page_count, bitmap_file, &write_succeeded,
+                   &page_written));
   }
-  return true;
+  page_written.Wait();
+  return write_succeeded;
 }
 
 void ChromeContentUtilityClient::OnRobustJPEGDecodeImage(
@@ -6,6 +6,7 @@
 
 #include "base/bind.h"
 #include "base/format_macros.h"
+#include "base/message_loop/message_loop.h"
 #include "base/stl_util.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
@@ -224,6 +225,19 @@ void ShillPropertyHandler::RequestProperties(ManagedState::ManagedType type,
 
 void ShillPropertyHandler::OnPropertyChanged(const std::string& key,
                                              const base::Value& value) {
+  if (key == shill::kServicesProperty ||
+      key == shill::kServiceCompleteListProperty ||
+      key == shill::kDevicesProperty) {
+    if (!pending_list_changes_) {
+      pending_list_changes_.reset(new base::DictionaryValue);
+      base::MessageLoop::current()->PostTask(
+          FROM_HERE,
+          base::Bind(&ShillPropertyHandler::ProcessPendingListChanges,
+                     AsWeakPtr()));
+    }
+    pending_list_changes_->SetWithoutPathExpansion(key, value.DeepCopy());
+    return;
+  }
   ManagerPropertyChanged(key, value);
   CheckPendingStateListUpdates(key);
 }
@@ -265,6 +279,24 @@ void ShillPropertyHandler::ManagerPropertiesCallback(
   CheckPendingStateListUpdates("");
 }
 
+void ShillPropertyHandler::ProcessPendingListChanges() {
+  scoped_ptr<base::DictionaryValue> changes = pending_list_changes_.Pass();
+  DCHECK(changes);
+  // Services must come before ServiceCompleteList, see UpdateProperties().
+  const char* kListProperties[] = {
+    shill::kServicesProperty,
+    shill::kServiceCompleteListProperty,
+    shill::kDevicesProperty,
+  };
+  for (size_t i = 0; i < arraysize(kListProperties); ++i) {
+    const base::Value* value = NULL;
+    if (!changes->GetWithoutPathExpansion(kListProperties[i], &value))
+      continue;
+    ManagerPropertyChanged(kListProperties[i], *value);
+    CheckPendingStateListUpdates(kListProperties[i]);
+  }
+}
+
 void ShillPropertyHandler::CheckPendingStateListUpdates(
     const std::string& key) {
   // Once there are no pending updates, signal the state list changed callbacks.
@@ -10,6 +10,7 @@
 #include <set>
 #include <string>
 
+#include "base/memory/scoped_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "chromeos/dbus/dbus_method_call_status.h"
 #include "chromeos/dbus/shill_property_changed_observer.h"
@@ -141,6 +142,9 @@ class CHROMEOS_EXPORT ShillPropertyHandler
   // has changed or an empty string if multiple lists may have changed.
   void CheckPendingStateListUpdates(const std::string& key);
 
+  // Processes the list properties collected in |pending_list_changes_|.
+  void ProcessPendingListChanges();
+
   // Called form OnPropertyChanged() and ManagerPropertiesCallback().
   void ManagerPropertyChanged(const std::string& key,
                               const base::Value& value);
@@ -214,6 +218,12 @@ class CHROMEOS_EXPORT ShillPropertyHandler
   // state type
   TypeRequestMap requested_updates_;
 
+  // Latest values of the Services, ServiceCompleteList and Devices properties
+  // received since ProcessPendingListChanges() was posted, or NULL if it is
+  // not pending. Shill sends bursts of these while scanning, and each one
+  // refetches every Device, so only the last value of each is handled.
+  scoped_ptr<base::DictionaryValue> pending_list_changes_;
+
   // List of network services with Shill property changed observers
   ShillPropertyObserverMap observed_networks_;
 
@@ -6,6 +6,7 @@
 
 #include <vector>
 
+#include "base/metrics/histogram.h"
 #include "base/prefs/pref_service.h"
 #include "base/strings/string16.h"
 #include "base/strings/utf_string_conversions.h"
@@ -56,6 +57,8 @@ void AutocompleteHistoryManager::OnWebDataServiceRequestDone(
     const WDTypedResult* result) {
   DCHECK(pending_query_handle_);
   pending_query_handle_ = 0;
+  UMA_HISTOGRAM_TIMES("Autofill.AutocompleteQueryTime",
+                      base::TimeTicks::Now() - pending_query_start_time_);
 
   if (!manager_delegate_->IsAutocompleteEnabled()) {
     SendSuggestions(NULL);
@@ -99,6 +102,7 @@ void AutocompleteHistoryManager::OnGetAutocompleteSuggestions(
   }
 
   if (database_.get()) {
+    pending_query_start_time_ = base::TimeTicks::Now();
     pending_query_handle_ = database_->GetFormValuesForElementName(
         name, prefix, kMaxAutocompleteMenuItems, this);
   }
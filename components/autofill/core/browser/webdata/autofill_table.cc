@@ -447,7 +447,7 @@ bool AutofillTable::GetFormValuesForElementName(
   sql::Statement s;
 
   if (prefix.empty()) {
-    s.Assign(db_->GetUniqueStatement(
+    s.Assign(db_->GetCachedStatement(SQL_FROM_HERE,
         "SELECT value FROM autofill "
         "WHERE name = ? "
         "ORDER BY count DESC "
@@ -459,7 +459,7 @@ bool AutofillTable::GetFormValuesForElementName(
     base::string16 next_prefix = prefix_lower;
     next_prefix[next_prefix.length() - 1]++;
 
-    s.Assign(db_->GetUniqueStatement(
+    s.Assign(db_->GetCachedStatement(SQL_FROM_HERE,
         "SELECT value FROM autofill "
         "WHERE name = ? AND "
         "value_lower >= ? AND "
@@ -668,7 +668,7 @@ bool AutofillTable::GetIDAndCountOfFormElement(
   DCHECK(pair_id);
   DCHECK(count);
 
-  sql::Statement s(db_->GetUniqueStatement(
+  sql::Statement s(db_->GetCachedStatement(SQL_FROM_HERE,
       "SELECT pair_id, count FROM autofill "
       "WHERE name = ? AND value = ?"));
   s.BindString16(0, element.name);
@@ -702,7 +702,7 @@ bool AutofillTable::GetCountOfFormElement(int64 pair_id, int* count) {
 }
 
 bool AutofillTable::SetCountOfFormElement(int64 pair_id, int count) {
-  sql::Statement s(db_->GetUniqueStatement(
+  sql::Statement s(db_->GetCachedStatement(SQL_FROM_HERE,
       "UPDATE autofill SET count = ? WHERE pair_id = ?"));
   s.BindInt(0, count);
   s.BindInt64(1, pair_id);
@@ -713,7 +713,7 @@ bool AutofillTable::SetCountOfFormElement(int64 pair_id, int count) {
 bool AutofillTable::InsertFormElement(const FormFieldData& element,
                                       int64* pair_id) {
   DCHECK(pair_id);
-  sql::Statement s(db_->GetUniqueStatement(
+  sql::Statement s(db_->GetCachedStatement(SQL_FROM_HERE,
       "INSERT INTO autofill (name, value, value_lower) VALUES (?,?,?)"));
   s.BindString16(0, element.name);
   s.BindString16(1, element.value);
@@ -728,7 +728,7 @@ bool AutofillTable::InsertFormElement(const FormFieldData& element,
 
 bool AutofillTable::InsertPairIDAndDate(int64 pair_id,
                                         const Time& date_created) {
-  sql::Statement s(db_->GetUniqueStatement(
+  sql::Statement s(db_->GetCachedStatement(SQL_FROM_HERE,
       "INSERT INTO autofill_dates "
       "(pair_id, date_created) VALUES (?, ?)"));
   s.BindInt64(0, pair_id);
@@ -740,7 +740,7 @@ bool AutofillTable::InsertPairIDAndDate(int64 pair_id,
 bool AutofillTable::DeleteLastAccess(int64 pair_id) {
   // Inner SELECT selects the newest |date_created| for a given |pair_id|.
   // DELETE deletes only that entry.
-  sql::Statement s(db_->GetUniqueStatement(
+  sql::Statement s(db_->GetCachedStatement(SQL_FROM_HERE,
       "DELETE FROM autofill_dates WHERE pair_id = ? and date_created IN "
       "(SELECT date_created FROM autofill_dates WHERE pair_id = ? "
       "ORDER BY date_created DESC LIMIT 1)"));
@@ -22,6 +22,10 @@
 namespace {
 // Maximum number of distilled pages in an article.
 const size_t kMaxPagesInArticle = 32;
+// Maximum number of pages of an article that are distilled at the same time.
+// Multi-page articles are a chain of next and previous page links, so two
+// distillations are enough to follow both directions from the starting page.
+const size_t kMaxConcurrentPageDistillations = 2;
 }
 
 namespace dom_distiller {
@@ -48,16 +52,19 @@ DistillerImpl::DistilledPageData::~DistilledPageData() {}
 DistillerImpl::DistillerImpl(
     const DistillerPageFactory& distiller_page_factory,
     const DistillerURLFetcherFactory& distiller_url_fetcher_factory)
-    : distiller_url_fetcher_factory_(distiller_url_fetcher_factory),
+    : distiller_page_factory_(distiller_page_factory),
+      distiller_url_fetcher_factory_(distiller_url_fetcher_factory),
       max_pages_in_article_(kMaxPagesInArticle) {
-  page_distiller_.reset(new PageDistiller(distiller_page_factory));
+  page_distillers_.push_back(new PageDistiller(distiller_page_factory_));
+  idle_page_distillers_.push_back(page_distillers_.back());
 }
 
 DistillerImpl::~DistillerImpl() { DCHECK(AreAllPagesFinished()); }
 
 void DistillerImpl::Init() {
   DCHECK(AreAllPagesFinished());
-  page_distiller_->Init();
+  for (size_t i = 0; i < page_distillers_.size(); ++i)
+    page_distillers_[i]->Init();
 }
 
 void DistillerImpl::SetMaxNumPagesInArticle(size_t max_num_pages) {
@@ -104,8 +111,25 @@ void DistillerImpl::DistillPage(const GURL& url,
   DistillNextPage();
 }
 
+PageDistiller* DistillerImpl::GetIdlePageDistiller() {
+  if (idle_page_distillers_.empty()) {
+    if (page_distillers_.size() >= kMaxConcurrentPageDistillations)
+      return NULL;
+    PageDistiller* page_distiller = new PageDistiller(distiller_page_factory_);
+    page_distiller->Init();
+    page_distillers_.push_back(page_distiller);
+    return page_distiller;
+  }
+  PageDistiller* page_distiller = idle_page_distillers_.back();
+  idle_page_distillers_.pop_back();
+  return page_distiller;
+}
+
 void DistillerImpl::DistillNextPage() {
-  if (!waiting_pages_.empty()) {
+  while (!waiting_pages_.empty()) {
+    PageDistiller* page_distiller = GetIdlePageDistiller();
+    if (!page_distiller)
+      return;
     std::map<int, GURL>::iterator front = waiting_pages_.begin();
     int page_num = front->first;
     const GURL url = front->second;
@@ -117,22 +141,25 @@ void DistillerImpl::DistillNextPage() {
     seen_urls_.insert(url.spec());
     pages_.push_back(new DistilledPageData());
     started_pages_index_[page_num] = pages_.size() - 1;
-    page_distiller_->DistillPage(
+    page_distiller->DistillPage(
         url,
         base::Bind(&DistillerImpl::OnPageDistillationFinished,
                    base::Unretained(this),
+                   base::Unretained(page_distiller),
                    page_num,
                    url));
   }
 }
 
 void DistillerImpl::OnPageDistillationFinished(
+    PageDistiller* page_distiller,
     int page_num,
     const GURL& page_url,
     scoped_ptr<DistilledPageInfo> distilled_page,
     bool distillation_successful) {
   DCHECK(distilled_page.get());
   DCHECK(started_pages_index_.find(page_num) != started_pages_index_.end());
+  idle_page_distillers_.push_back(page_distiller);
   if (distillation_successful) {
     DistilledPageData* page_data =
         GetPageAtIndex(started_pages_index_[page_num]);
@@ -168,7 +195,11 @@ void DistillerImpl::OnPageDistillationFinished(
     DistillNextPage();
   } else {
     started_pages_index_.erase(page_num);
-    RunDistillerCallbackIfDone();
+    // Pages found earlier in the other direction may still be waiting.
+    if (waiting_pages_.empty())
+      RunDistillerCallbackIfDone();
+    else
+      DistillNextPage();
   }
 }
 
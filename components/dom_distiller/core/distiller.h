@@ -6,6 +6,7 @@
 #define COMPONENTS_DOM_DISTILLER_CORE_DISTILLER_H_
 
 #include <string>
+#include <vector>
 
 #include "base/callback.h"
 #include "base/containers/hash_tables.h"
@@ -95,7 +96,8 @@ class DistillerImpl : public Distiller {
                         const std::string& id,
                         const std::string& response);
 
-  void OnPageDistillationFinished(int page_num,
+  void OnPageDistillationFinished(PageDistiller* page_distiller,
+                                  int page_num,
                                   const GURL& page_url,
                                   scoped_ptr<DistilledPageInfo> distilled_page,
                                   bool distillation_successful);
@@ -104,9 +106,15 @@ class DistillerImpl : public Distiller {
                           const std::string& image_id,
                           const std::string& item);
 
-  // Distills the next page.
+  // Starts distilling waiting pages, as long as there are page distillers to
+  // distill them with.
   void DistillNextPage();
 
+  // Returns a page distiller that isn't distilling a page, creating one if
+  // fewer than |kMaxConcurrentPageDistillations| exist, or NULL if all of them
+  // are busy.
+  PageDistiller* GetIdlePageDistiller();
+
   // Adds the |url| to |pages_to_be_distilled| if |page_num| is a valid relative
   // page number and |url| is valid. Ignores duplicate pages and urls.
   void AddToDistillationQueue(int page_num, const GURL& url);
@@ -132,8 +140,14 @@ class DistillerImpl : public Distiller {
 
   DistilledPageData* GetPageAtIndex(size_t index) const;
 
+  const DistillerPageFactory& distiller_page_factory_;
   const DistillerURLFetcherFactory& distiller_url_fetcher_factory_;
-  scoped_ptr<PageDistiller> page_distiller_;
+
+  // The page distillers created so far, and the ones of them that are not
+  // distilling a page. Both the next and the previous pages of the starting
+  // page are distilled at the same time, each with its own page distiller.
+  ScopedVector<PageDistiller> page_distillers_;
+  std::vector<PageDistiller*> idle_page_distillers_;
   DistillerCallback distillation_cb_;
 
   // Set of pages that are under distillation or have finished distillation.
@@ -359,6 +359,10 @@ void NaClBrowser::OnValidationCacheLoaded(const std::string *data) {
     Pickle pickle(data->data(), data->size());
     validation_cache_.Deserialize(&pickle);
   }
+  // Together with NaCl.ValidationCache.Query this shows whether misses come
+  // from an empty cache or from a cache that is too small.
+  UMA_HISTOGRAM_COUNTS_10000("NaCl.ValidationCache.LoadedSize",
+                             validation_cache_.size());
   validation_cache_state_ = NaClResourceReady;
   CheckWaiting();
 }
@@ -9,8 +9,10 @@
 
 namespace nacl {
 
-// For the moment, choose an arbitrary cache size.
-const size_t kValidationCacheCacheSize = 200;
+// Apps that dynamically link load a validated chunk per shared library, so a
+// couple of them were enough to thrash a cache of a few hundred entries. At
+// 32 bytes a signature, this keeps the file on disk around 72KB.
+const size_t kValidationCacheCacheSize = 2000;
 // Key size is equal to the block size (not the digest size) of SHA256.
 const size_t kValidationCacheKeySize = 64;
 // Entry size is equal to the digest size of SHA256.
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "base/pickle.h"
+#include "base/strings/stringprintf.h"
 #include "components/nacl/browser/nacl_validation_cache.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -151,6 +152,21 @@ TEST_F(NaClValidationCacheTest, SerializeDeserialize) {
   ASSERT_TRUE(IsIdentical(cache1, cache2));
 }
 
+TEST_F(NaClValidationCacheTest, SerializeDeserializeMany) {
+  // More signatures than a dynamically linked app needs, none evicted.
+  const int kNumSignatures = 1000;
+  for (int i = 0; i < kNumSignatures; ++i)
+    cache1.SetKnownToValidate(base::StringPrintf("%032d", i));
+  ASSERT_EQ(kNumSignatures, (int) cache1.size());
+  ASSERT_TRUE(cache1.QueryKnownToValidate(base::StringPrintf("%032d", 0),
+                                          true));
+
+  Pickle pickle;
+  cache1.Serialize(&pickle);
+  ASSERT_TRUE(cache2.Deserialize(&pickle));
+  ASSERT_TRUE(IsIdentical(cache1, cache2));
+}
+
 TEST_F(NaClValidationCacheTest, SerializeDeserializeTruncated) {
   std::string key(key2);
   cache1.SetValidationCacheKey(key);
@@ -28,6 +28,16 @@ const char* kProxyPolicies[] = {
   key::kProxyBypassList,
 };
 
+// Returns true if |policies| has any of the policies that
+// FixDeprecatedPolicies() maps to a newer policy.
+bool HasDeprecatedPolicies(const PolicyMap& policies) {
+  for (size_t i = 0; i < arraysize(kProxyPolicies); ++i) {
+    if (policies.Get(kProxyPolicies[i]))
+      return true;
+  }
+  return false;
+}
+
 void FixDeprecatedPolicies(PolicyMap* policies) {
   // Proxy settings have been configured by 5 policies that didn't mix well
   // together, and maps of policies had to take this into account when merging
@@ -183,8 +193,16 @@ void PolicyServiceImpl::MergeAndTriggerUpdates() {
   const PolicyNamespace chrome_namespace(POLICY_DOMAIN_CHROME, std::string());
   PolicyBundle bundle;
   for (Iterator it = providers_.begin(); it != providers_.end(); ++it) {
+    const PolicyBundle& policies = (*it)->policies();
+    if (!HasDeprecatedPolicies(policies.Get(chrome_namespace))) {
+      // Nothing to fix up, so merge straight from the provider instead of
+      // deep copying all of its policies first. Large lists such as the
+      // extension forcelist or 3rd party policies are then only copied once.
+      bundle.MergeFrom(policies);
+      continue;
+    }
     PolicyBundle provided_bundle;
-    provided_bundle.CopyFrom((*it)->policies());
+    provided_bundle.CopyFrom(policies);
     FixDeprecatedPolicies(&provided_bundle.Get(chrome_namespace));
     bundle.MergeFrom(provided_bundle);
   }
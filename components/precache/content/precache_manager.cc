@@ -60,6 +60,14 @@ void PrecacheManager::StartPrecaching(
                      "in progress.";
     return;
   }
+
+  if (net::NetworkChangeNotifier::IsConnectionCellular(
+          net::NetworkChangeNotifier::GetConnectionType())) {
+    // Precaching is meant to use otherwise idle, unmetered bandwidth.
+    DLOG(WARNING) << "Not precaching over a cellular connection.";
+    precache_completion_callback.Run();
+    return;
+  }
   is_precaching_ = true;
 
   BrowserThread::PostTask(
@@ -51,8 +51,9 @@ class PrecacheManager : public BrowserContextKeyedService,
 
   // Starts precaching resources that the user is predicted to fetch in the
   // future. If precaching is already currently in progress, then this method
-  // does nothing. The |precache_completion_callback| will be run when
-  // precaching finishes, but will not be run if precaching is canceled.
+  // does nothing. Precaching is skipped on cellular connections, in which case
+  // |precache_completion_callback| is run right away. Otherwise it will be run
+  // when precaching finishes, but will not be run if precaching is canceled.
   void StartPrecaching(
       const PrecacheCompletionCallback& precache_completion_callback,
       URLListProvider* url_list_provider);
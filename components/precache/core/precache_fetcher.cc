@@ -26,6 +26,9 @@ namespace precache {
 
 namespace {
 
+// The maximum number of resources that are fetched at the same time.
+const size_t kMaxParallelResourceFetches = 4;
+
 GURL GetConfigURL() {
   const CommandLine& command_line = *CommandLine::ForCurrentProcess();
   if (command_line.HasSwitch(switches::kPrecacheConfigSettingsURL)) {
@@ -108,6 +111,8 @@ class PrecacheFetcher::Fetcher : public net::URLFetcherDelegate {
   virtual ~Fetcher() {}
   virtual void OnURLFetchComplete(const URLFetcher* source) OVERRIDE;
 
+  const URLFetcher* url_fetcher() const { return url_fetcher_.get(); }
+
  private:
   const base::Callback<void(const URLFetcher&)> callback_;
   scoped_ptr<URLFetcher> url_fetcher_;
@@ -161,14 +166,19 @@ void PrecacheFetcher::Start() {
 }
 
 void PrecacheFetcher::StartNextFetch() {
-  if (!resource_urls_to_fetch_.empty()) {
+  while (!resource_urls_to_fetch_.empty() &&
+         resource_fetchers_.size() < kMaxParallelResourceFetches) {
     // Fetch the next resource URL.
-    fetcher_.reset(
+    resource_fetchers_.push_back(
         new Fetcher(request_context_, resource_urls_to_fetch_.front(),
                     base::Bind(&PrecacheFetcher::OnResourceFetchComplete,
                                base::Unretained(this))));
 
     resource_urls_to_fetch_.pop_front();
+  }
+  if (!resource_fetchers_.empty()) {
+    // Wait for the resources of the current manifest before fetching the next
+    // manifest.
     return;
   }
 
@@ -246,6 +256,13 @@ void PrecacheFetcher::OnManifestFetchComplete(const URLFetcher& source) {
 void PrecacheFetcher::OnResourceFetchComplete(const URLFetcher& source) {
   // The resource has already been put in the cache during the fetch process, so
   // nothing more needs to be done for the resource.
+  for (ScopedVector<Fetcher>::iterator it = resource_fetchers_.begin();
+       it != resource_fetchers_.end(); ++it) {
+    if ((*it)->url_fetcher() == &source) {
+      resource_fetchers_.erase(it);
+      break;
+    }
+  }
   StartNextFetch();
 }
 
@@ -10,6 +10,7 @@
 #include "base/basictypes.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
 #include "url/gurl.h"
 
 namespace net {
@@ -76,18 +77,20 @@ class PrecacheFetcher {
 
   virtual ~PrecacheFetcher();
 
-  // Starts fetching resources to precache. URLs are fetched sequentially. Can
-  // be called from any thread. Start should only be called once on a
-  // PrecacheFetcher instance.
+  // Starts fetching resources to precache. Manifests are fetched sequentially,
+  // and the resources of each manifest a few at a time. Can be called from any
+  // thread. Start should only be called once on a PrecacheFetcher instance.
   void Start();
 
  private:
   class Fetcher;
 
-  // Fetches the next resource or manifest URL, if any remain. Fetching is done
-  // sequentially and depth-first: all resources are fetched for a manifest
-  // before the next manifest is fetched. This is done to limit the length of
-  // the |resource_urls_to_fetch_| list, reducing the memory usage.
+  // Fetches the next resource or manifest URLs, if any remain. Fetching is done
+  // depth-first: all resources are fetched for a manifest before the next
+  // manifest is fetched. This is done to limit the length of the
+  // |resource_urls_to_fetch_| list, reducing the memory usage. Up to
+  // kMaxParallelResourceFetches resources are fetched at once, so that the
+  // round trip time of each resource doesn't add up over a whole manifest.
   void StartNextFetch();
 
   // Called when the precache configuration settings have been fetched.
@@ -114,8 +117,12 @@ class PrecacheFetcher {
   // Non-owning pointer. Should not be NULL.
   PrecacheDelegate* precache_delegate_;
 
+  // The current config or manifest fetch.
   scoped_ptr<Fetcher> fetcher_;
 
+  // The resource fetches in progress.
+  ScopedVector<Fetcher> resource_fetchers_;
+
   std::list<GURL> manifest_urls_to_fetch_;
   std::list<GURL> resource_urls_to_fetch_;
 
@@ -6,6 +6,8 @@
 #define COMPONENTS_SYNC_DRIVER_DATA_TYPE_MANAGER_OBSERVER_H_
 
 #include "components/sync_driver/data_type_manager.h"
+#include "sync/internal_api/public/base/model_type.h"
+#include "sync/internal_api/public/data_type_association_stats.h"
 
 namespace browser_sync {
 
@@ -17,6 +19,12 @@ class DataTypeManagerObserver {
       const browser_sync::DataTypeManager::ConfigureResult& result) = 0;
   virtual void OnConfigureRetry() = 0;
   virtual void OnConfigureStart() = 0;
+  // Called as each data type finishes model association during a
+  // configuration. Types that associate on their own model threads can finish
+  // in any order.
+  virtual void OnDataTypeAssociationDone(
+      syncer::ModelType type,
+      const syncer::DataTypeAssociationStats& association_stats) = 0;
 
  protected:
   virtual ~DataTypeManagerObserver() { }
@@ -9,6 +9,7 @@
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/third_party/icu/icu_utf.h"
 #include "base/time/time.h"
 #include "components/translate/core/common/translate_constants.h"
 #include "components/translate/core/common/translate_metrics.h"
@@ -195,6 +196,10 @@ bool CanCLDComplementSubCode(
 
 namespace translate {
 
+// A few thousand characters are plenty for CLD to recognize a language, and
+// its cost grows with the text length, so long pages are sampled.
+const size_t kMaxDetectionTextLength = 16 * 1024;
+
 std::string DeterminePageLanguage(const std::string& code,
                                   const std::string& html_lang,
                                   const base::string16& contents,
@@ -202,7 +207,8 @@ std::string DeterminePageLanguage(const std::string& code,
                                   bool* is_cld_reliable_p) {
   base::TimeTicks begin_time = base::TimeTicks::Now();
   bool is_cld_reliable;
-  std::string cld_language = DetermineTextLanguage(contents, &is_cld_reliable);
+  std::string cld_language = DetermineTextLanguage(
+      SampleTextForDetection(contents), &is_cld_reliable);
   translate::ReportLanguageDetectionTime(begin_time, base::TimeTicks::Now());
 
   if (cld_language_p != NULL)
@@ -365,6 +371,32 @@ bool IsSameOrSimilarLanguages(const std::string& page_language,
   return match;
 }
 
+base::string16 SampleTextForDetection(const base::string16& text) {
+  if (text.length() <= kMaxDetectionTextLength)
+    return text;
+
+  // Take excerpts from the start, middle and end of the page, so that a long
+  // header or footer in another language doesn't decide the result alone.
+  const size_t kNumExcerpts = 4;
+  const size_t excerpt_length = kMaxDetectionTextLength / kNumExcerpts;
+  const size_t stride = (text.length() - excerpt_length) / (kNumExcerpts - 1);
+  base::string16 sample;
+  sample.reserve(kMaxDetectionTextLength + kNumExcerpts);
+  for (size_t i = 0; i < kNumExcerpts; ++i) {
+    size_t begin = i * stride;
+    size_t end = begin + excerpt_length;
+    // Don't split surrogate pairs.
+    if (begin > 0 && CBU16_IS_TRAIL(text[begin]))
+      ++begin;
+    if (CBU16_IS_LEAD(text[end - 1]))
+      --end;
+    if (i > 0)
+      sample.push_back(' ');
+    sample.append(text, begin, end - begin);
+  }
+  return sample;
+}
+
 bool MaybeServerWrongConfiguration(const std::string& page_language,
                                    const std::string& cld_language) {
   // If |page_language| is not "en-*", respect it and just return false here.
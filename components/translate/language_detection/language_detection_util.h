@@ -39,6 +39,15 @@ bool IsSameOrSimilarLanguages(const std::string& page_language,
 bool MaybeServerWrongConfiguration(const std::string& page_language,
                                    const std::string& cld_language);
 
+// The maximum number of characters handed to CLD for one page.
+extern const size_t kMaxDetectionTextLength;
+
+// Returns |text| if it is short enough for language detection, or else a
+// sample of it made of a few evenly spaced excerpts of at most
+// |kMaxDetectionTextLength| characters in total.
+// Called only by tests.
+base::string16 SampleTextForDetection(const base::string16& text);
+
 }  // namespace translate
 
 #endif  // COMPONENTS_TRANSLATE_LANGUAGE_DETECTION_LANGUAGE_DETECTION_UTIL_H_
@@ -6,6 +6,7 @@
 
 #include "base/strings/string16.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/third_party/icu/icu_utf.h"
 #include "components/translate/core/common/translate_constants.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -171,3 +172,40 @@ TEST_F(LanguageDetectionUtilTest, AdoptHtmlLang) {
   EXPECT_EQ("en", cld_language);
   EXPECT_TRUE(is_cld_reliable);
 }
+
+// Tests that long texts are sampled from their start, middle and end, and
+// that short texts are used as is.
+TEST_F(LanguageDetectionUtilTest, SampleTextForDetection) {
+  base::string16 short_text = base::ASCIIToUTF16("A short page.");
+  EXPECT_EQ(short_text, translate::SampleTextForDetection(short_text));
+
+  base::string16 long_text =
+      base::string16(translate::kMaxDetectionTextLength, 'a') +
+      base::string16(translate::kMaxDetectionTextLength, 'b') +
+      base::string16(translate::kMaxDetectionTextLength, 'c');
+  base::string16 sample = translate::SampleTextForDetection(long_text);
+  EXPECT_GE(translate::kMaxDetectionTextLength + 3, sample.length());
+  EXPECT_EQ('a', sample[0]);
+  EXPECT_NE(base::string16::npos, sample.find('b'));
+  EXPECT_EQ('c', sample[sample.length() - 1]);
+}
+
+// Tests that sampling doesn't split surrogate pairs.
+TEST_F(LanguageDetectionUtilTest, SampleTextForDetectionSurrogates) {
+  // U+1F600, which is a surrogate pair in UTF-16.
+  const base::char16 kPair[] = { 0xD83D, 0xDE00, 0 };
+  base::string16 long_text;
+  while (long_text.length() < 3 * translate::kMaxDetectionTextLength + 1)
+    long_text += kPair;
+  long_text += 'x';
+  base::string16 sample = translate::SampleTextForDetection(long_text);
+  for (size_t i = 0; i < sample.length(); ++i) {
+    if (CBU16_IS_LEAD(sample[i])) {
+      ASSERT_LT(i + 1, sample.length());
+      EXPECT_TRUE(CBU16_IS_TRAIL(sample[i + 1]));
+    } else if (CBU16_IS_TRAIL(sample[i])) {
+      ASSERT_LT(0u, i);
+      EXPECT_TRUE(CBU16_IS_LEAD(sample[i - 1]));
+    }
+  }
+}
@@ -14,6 +14,11 @@ namespace url_matcher {
 
 namespace {
 
+// Compares the labels of AhoCorasickNode edges.
+bool CompareEdgeLabels(const std::pair<char, uint32>& edge, char label) {
+  return edge.first < label;
+}
+
 // Compare StringPattern instances based on their string patterns.
 bool ComparePatterns(const StringPattern* a, const StringPattern* b) {
   return a->pattern() < b->pattern();
@@ -76,6 +81,11 @@ void SubstringSetMatcher::UnregisterPatterns(
 void SubstringSetMatcher::RegisterAndUnregisterPatterns(
       const std::vector<const StringPattern*>& to_register,
       const std::vector<const StringPattern*>& to_unregister) {
+  // URLMatcher updates all its matchers when any condition changes, so there
+  // is often nothing to do here. Keep the tree rather than rebuilding it.
+  if (to_register.empty() && to_unregister.empty())
+    return;
+
   // Register patterns.
   for (std::vector<const StringPattern*>::const_iterator i =
       to_register.begin(); i != to_register.end(); ++i) {
@@ -123,8 +133,11 @@ bool SubstringSetMatcher::Match(const std::string& text,
     }
     if (edge_from_current != AhoCorasickNode::kNoSuchEdge) {
       current_node = edge_from_current;
-      matches->insert(tree_[current_node].matches().begin(),
-                      tree_[current_node].matches().end());
+      for (uint32 node = current_node; node != AhoCorasickNode::kNoSuchEdge;
+           node = tree_[node].output()) {
+        matches->insert(tree_[node].matches().begin(),
+                        tree_[node].matches().end());
+      }
     } else {
       DCHECK_EQ(0u, current_node);
     }
@@ -224,7 +237,16 @@ void SubstringSetMatcher::CreateFailureEdges() {
               ? edge_from_failure
               : 0;
       tree_[leads_to].set_failure(follow_in_case_of_failure);
-      tree_[leads_to].AddMatches(tree_[follow_in_case_of_failure].matches());
+      // The matches of the root are reported by Match() before it follows
+      // any edge. Nodes are visited in breadth first order, so the output edge
+      // of the failure node is already set.
+      if (follow_in_case_of_failure == 0) {
+        tree_[leads_to].set_output(AhoCorasickNode::kNoSuchEdge);
+      } else if (!tree_[follow_in_case_of_failure].matches().empty()) {
+        tree_[leads_to].set_output(follow_in_case_of_failure);
+      } else {
+        tree_[leads_to].set_output(tree_[follow_in_case_of_failure].output());
+      }
     }
   }
 }
@@ -232,7 +254,8 @@ void SubstringSetMatcher::CreateFailureEdges() {
 const uint32 SubstringSetMatcher::AhoCorasickNode::kNoSuchEdge = ~0;
 
 SubstringSetMatcher::AhoCorasickNode::AhoCorasickNode()
-    : failure_(kNoSuchEdge) {}
+    : failure_(kNoSuchEdge),
+      output_(kNoSuchEdge) {}
 
 SubstringSetMatcher::AhoCorasickNode::~AhoCorasickNode() {}
 
@@ -240,6 +263,7 @@ SubstringSetMatcher::AhoCorasickNode::AhoCorasickNode(
     const SubstringSetMatcher::AhoCorasickNode& other)
     : edges_(other.edges_),
       failure_(other.failure_),
+      output_(other.output_),
       matches_(other.matches_) {}
 
 SubstringSetMatcher::AhoCorasickNode&
@@ -247,26 +271,28 @@ SubstringSetMatcher::AhoCorasickNode::operator=(
     const SubstringSetMatcher::AhoCorasickNode& other) {
   edges_ = other.edges_;
   failure_ = other.failure_;
+  output_ = other.output_;
   matches_ = other.matches_;
   return *this;
 }
 
 uint32 SubstringSetMatcher::AhoCorasickNode::GetEdge(char c) const {
-  Edges::const_iterator i = edges_.find(c);
-  return i == edges_.end() ? kNoSuchEdge : i->second;
+  Edges::const_iterator i =
+      std::lower_bound(edges_.begin(), edges_.end(), c, CompareEdgeLabels);
+  return i == edges_.end() || i->first != c ? kNoSuchEdge : i->second;
 }
 
 void SubstringSetMatcher::AhoCorasickNode::SetEdge(char c, uint32 node) {
-  edges_[c] = node;
+  Edges::iterator i =
+      std::lower_bound(edges_.begin(), edges_.end(), c, CompareEdgeLabels);
+  if (i != edges_.end() && i->first == c)
+    i->second = node;
+  else
+    edges_.insert(i, std::make_pair(c, node));
 }
 
 void SubstringSetMatcher::AhoCorasickNode::AddMatch(StringPattern::ID id) {
   matches_.insert(id);
 }
 
-void SubstringSetMatcher::AhoCorasickNode::AddMatches(
-    const SubstringSetMatcher::AhoCorasickNode::Matches& matches) {
-  matches_.insert(matches.begin(), matches.end());
-}
-
 }  // namespace url_matcher
@@ -9,6 +9,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/basictypes.h"
@@ -79,10 +80,16 @@ class URL_MATCHER_EXPORT SubstringSetMatcher {
   // If your brain thinks "Forget it, let's go shopping.", don't worry.
   // Take a nap and read an introductory text on the Aho Corasick algorithm.
   // It will make sense. Eventually.
+  //
+  // A node only stores the IDs of the patterns that end at it. The patterns
+  // that end at a suffix of the node's label are found through output edges,
+  // which lead to the closest node on the failure path that has matches.
   class AhoCorasickNode {
    public:
-    // Key: label of the edge, value: node index in |tree_| of parent class.
-    typedef std::map<char, uint32> Edges;
+    // Pairs of the label of an edge and the node index in |tree_| of parent
+    // class, sorted by label. Most nodes have one or two edges, for which a
+    // sorted vector is smaller and faster to search than a map.
+    typedef std::vector<std::pair<char, uint32> > Edges;
     typedef std::set<StringPattern::ID> Matches;
 
     static const uint32 kNoSuchEdge;  // Represents an invalid node index.
@@ -99,8 +106,12 @@ class URL_MATCHER_EXPORT SubstringSetMatcher {
     uint32 failure() const { return failure_; }
     void set_failure(uint32 failure) { failure_ = failure; }
 
+    // Node index that the output edge leads to, or kNoSuchEdge if no node on
+    // the failure path other than the root has matches.
+    uint32 output() const { return output_; }
+    void set_output(uint32 output) { output_ = output; }
+
     void AddMatch(StringPattern::ID id);
-    void AddMatches(const Matches& matches);
     const Matches& matches() const { return matches_; }
 
    private:
@@ -110,6 +121,9 @@ class URL_MATCHER_EXPORT SubstringSetMatcher {
     // Node index that failure edge leads to.
     uint32 failure_;
 
+    // Node index that output edge leads to.
+    uint32 output_;
+
     // Identifiers of matches.
     Matches matches_;
   };
@@ -92,10 +92,11 @@ static bool WriteToFile(FILE* file,
 // This task executes on a background thread and executes a write. This
 // prevents us from blocking the UI thread doing I/O. Double pointer to FILE
 // is used because file may still not be opened by the time of scheduling
-// the task for execution.
-void AsyncWrite(FILE** file, int32 offset, const std::string& data) {
+// the task for execution. |data| is owned by the task, so that a write of the
+// whole table only needs the one copy made when the write is posted.
+void AsyncWrite(FILE** file, int32 offset, const std::string* data) {
   if (*file)
-    WriteToFile(*file, offset, data.data(), data.size());
+    WriteToFile(*file, offset, data->data(), data->size());
 }
 
 // Truncates the file to the current position asynchronously on a background
@@ -894,7 +895,8 @@ void VisitedLinkMaster::WriteToFile(FILE** file,
 #endif
   PostIOTask(FROM_HERE,
       base::Bind(&AsyncWrite, file, offset,
-                 std::string(static_cast<const char*>(data), data_size)));
+                 base::Owned(new std::string(static_cast<const char*>(data),
+                                             data_size))));
 }
 
 void VisitedLinkMaster::WriteUsedItemCountToFile() {
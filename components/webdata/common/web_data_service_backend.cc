@@ -6,6 +6,8 @@
 
 #include "base/bind.h"
 #include "base/location.h"
+#include "base/message_loop/message_loop.h"
+#include "base/time/time.h"
 #include "components/webdata/common/web_data_request_manager.h"
 #include "components/webdata/common/web_database.h"
 #include "components/webdata/common/web_database_table.h"
@@ -13,6 +15,13 @@
 using base::Bind;
 using base::FilePath;
 
+namespace {
+
+// How long writes are batched before they are committed.
+const int kCommitDelayMs = 100;
+
+}  // namespace
+
 WebDataServiceBackend::WebDataServiceBackend(
     const FilePath& path,
     Delegate* delegate,
@@ -22,7 +31,9 @@ WebDataServiceBackend::WebDataServiceBackend(
       request_manager_(new WebDataRequestManager()),
       init_status_(sql::INIT_FAILURE),
       init_complete_(false),
-      delegate_(delegate) {
+      delegate_(delegate),
+      commit_pending_(false),
+      weak_factory_(this) {
 }
 
 void WebDataServiceBackend::AddTable(scoped_ptr<WebDatabaseTable> table) {
@@ -64,6 +75,7 @@ sql::InitStatus WebDataServiceBackend::LoadDatabaseIfNecessary() {
 void WebDataServiceBackend::ShutdownDatabase(bool should_reinit) {
   if (db_ && init_status_ == sql::INIT_OK)
     db_->CommitTransaction();
+  commit_pending_ = false;
   db_.reset(NULL);
   init_complete_ = !should_reinit; // Setting init_complete_ to true will ensure
   // that the init sequence is not re-run.
@@ -87,7 +99,7 @@ void WebDataServiceBackend::ExecuteWriteTask(
   if (db_ && init_status_ == sql::INIT_OK) {
     WebDatabase::State state = task.Run(db_.get());
     if (state == WebDatabase::COMMIT_NEEDED)
-      Commit();
+      ScheduleCommit();
   }
 }
 
@@ -122,3 +134,21 @@ void WebDataServiceBackend::Commit() {
     NOTREACHED() << "Commit scheduled after Shutdown()";
   }
 }
+
+void WebDataServiceBackend::ScheduleCommit() {
+  if (commit_pending_)
+    return;
+  commit_pending_ = true;
+  base::MessageLoop::current()->PostDelayedTask(
+      FROM_HERE,
+      base::Bind(&WebDataServiceBackend::CommitPendingWrites,
+                 weak_factory_.GetWeakPtr()),
+      base::TimeDelta::FromMilliseconds(kCommitDelayMs));
+}
+
+void WebDataServiceBackend::CommitPendingWrites() {
+  if (!commit_pending_)
+    return;
+  commit_pending_ = false;
+  Commit();
+}
@@ -13,6 +13,7 @@
 #include "base/memory/ref_counted_delete_on_message_loop.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/memory/scoped_vector.h"
+#include "base/memory/weak_ptr.h"
 #include "components/webdata/common/web_database_service.h"
 #include "components/webdata/common/webdata_export.h"
 
@@ -95,6 +96,15 @@ class WEBDATA_EXPORT WebDataServiceBackend
   // Commit the current transaction.
   void Commit();
 
+  // Commits the current transaction a short while from now, so that the
+  // writes of all tasks that run in the meantime share a single commit
+  // (and a single sync to disk) instead of committing once per task.
+  void ScheduleCommit();
+
+  // Commits the writes batched by ScheduleCommit(), if they haven't already
+  // been committed by ShutdownDatabase().
+  void CommitPendingWrites();
+
   // Path to database file.
   base::FilePath db_path_;
 
@@ -124,6 +134,13 @@ class WEBDATA_EXPORT WebDataServiceBackend
   // Delegate. See the class definition above for more information.
   scoped_ptr<Delegate> delegate_;
 
+  // True if writes have been made since the last commit, and a task to commit
+  // them has been posted.
+  bool commit_pending_;
+
+  // Used on the DB thread to post CommitPendingWrites().
+  base::WeakPtrFactory<WebDataServiceBackend> weak_factory_;
+
   DISALLOW_COPY_AND_ASSIGN(WebDataServiceBackend);
 };
 
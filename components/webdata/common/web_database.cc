@@ -80,6 +80,11 @@ sql::InitStatus WebDatabase::Init(const base::FilePath& db_name) {
   // infrequent. So we go with a small cache size.
   db_.set_cache_size(32);
 
+  // Autofill and the keyword tables see many small transactions, which are
+  // much cheaper when appended to a write-ahead log.
+  db_.set_wal_mode();
+  db_.set_mmap_size(32 * 1024 * 1024);
+
   // Run the database in exclusive mode. Nobody else should be accessing the
   // database while we're running, and this will give somewhat improved perf.
   db_.set_exclusive_locking();
@@ -525,7 +525,7 @@ void BrowserMainLoop::MainMessageLoopStart() {
 #if defined(TCMALLOC_TRACE_MEMORY_SUPPORTED)
   trace_memory_controller_.reset(new base::debug::TraceMemoryController(
       base::MessageLoop::current()->message_loop_proxy(),
-      ::HeapProfilerWithPseudoStackStart,
+      ::HeapProfilerWithPseudoStackStartSampled,
       ::HeapProfilerStop,
       ::GetHeapProfile));
 #endif
@@ -615,8 +615,28 @@ int BrowserMainLoop::CreateThreads() {
   base::Thread::Options default_options;
   base::Thread::Options io_message_loop_options;
   io_message_loop_options.message_loop_type = base::MessageLoop::TYPE_IO;
-  base::Thread::Options ui_message_loop_options;
-  ui_message_loop_options.message_loop_type = base::MessageLoop::TYPE_UI;
+
+  // Work the user is blocked on goes to FILE_USER_BLOCKING, so the DB and
+  // FILE threads shouldn't compete with the UI, IO and compositor threads.
+  base::Thread::Options background_options;
+  background_options.priority = base::kThreadPriority_Background;
+  base::Thread::Options file_message_loop_options;
+  file_message_loop_options.priority = base::kThreadPriority_Background;
+#if defined(OS_WIN)
+  // On Windows, the FILE thread needs to be have a UI message loop
+  // which pumps messages in such a way that Google Update can
+  // communicate back to us.
+  file_message_loop_options.message_loop_type = base::MessageLoop::TYPE_UI;
+#else
+  file_message_loop_options.message_loop_type = base::MessageLoop::TYPE_IO;
+#endif
+
+  base::Thread::Options io_thread_options;
+  io_thread_options.message_loop_type = base::MessageLoop::TYPE_IO;
+#if defined(OS_ANDROID)
+  // The IO thread carries the IPCs of display tasks.
+  io_thread_options.priority = base::kThreadPriority_Display;
+#endif
 
   // Start threads in the order they occur in the BrowserThread::ID
   // enumeration, except for BrowserThread::UI which is the main
@@ -635,6 +655,7 @@ int BrowserMainLoop::CreateThreads() {
             "BrowserMainLoop::CreateThreads:start",
             "Thread", "BrowserThread::DB");
         thread_to_start = &db_thread_;
+        options = &background_options;
         break;
       case BrowserThread::FILE_USER_BLOCKING:
         TRACE_EVENT_BEGIN1("startup",
@@ -647,14 +668,7 @@ int BrowserMainLoop::CreateThreads() {
             "BrowserMainLoop::CreateThreads:start",
             "Thread", "BrowserThread::FILE");
         thread_to_start = &file_thread_;
-#if defined(OS_WIN)
-        // On Windows, the FILE thread needs to be have a UI message loop
-        // which pumps messages in such a way that Google Update can
-        // communicate back to us.
-        options = &ui_message_loop_options;
-#else
-        options = &io_message_loop_options;
-#endif
+        options = &file_message_loop_options;
         break;
       case BrowserThread::PROCESS_LAUNCHER:
         TRACE_EVENT_BEGIN1("startup",
@@ -674,7 +688,7 @@ int BrowserMainLoop::CreateThreads() {
             "BrowserMainLoop::CreateThreads:start",
             "Thread", "BrowserThread::IO");
         thread_to_start = &io_thread_;
-        options = &io_message_loop_options;
+        options = &io_thread_options;
         break;
       case BrowserThread::UI:
       case BrowserThread::ID_COUNT:
@@ -744,6 +758,10 @@ void BrowserMainLoop::ShutdownThreadsAndCleanUp() {
   if (RenderProcessHost::run_renderer_in_process())
     RenderProcessHostImpl::ShutDownInProcessRenderer();
 
+  // The spare renderer process must not outlive the browser contexts, which
+  // the embedder destroys in PostMainMessageLoopRun.
+  RenderProcessHostImpl::DiscardSpareHost();
+
   if (parts_) {
     TRACE_EVENT0("shutdown",
                  "BrowserMainLoop::Subsystem:PostMainMessageLoopRun");
@@ -930,9 +948,8 @@ int BrowserMainLoop::BrowserThreadsStarted() {
 #endif
 
 #if defined(OS_ANDROID)
-  // Up the priority of anything that touches with display tasks
-  // (this thread is UI thread, and io_thread_ is for IPCs).
-  io_thread_->SetPriority(base::kThreadPriority_Display);
+  // Up the priority of anything that touches with display tasks (this
+  // thread is UI thread; io_thread_ was started with that priority).
   base::PlatformThread::SetThreadPriority(
       base::PlatformThread::CurrentHandle(),
       base::kThreadPriority_Display);
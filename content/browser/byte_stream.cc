@@ -4,7 +4,9 @@
 
 #include "content/browser/byte_stream.h"
 
+#include <algorithm>
 #include <deque>
+#include <limits>
 #include <set>
 #include <utility>
 
@@ -62,19 +64,33 @@ class ByteStreamWriterImpl : public ByteStreamWriter {
   virtual void Close(int status) OVERRIDE;
   virtual void RegisterCallback(const base::Closure& source_callback) OVERRIDE;
   virtual size_t GetTotalBufferedBytes() const OVERRIDE;
+  virtual size_t GetBufferSize() const OVERRIDE;
+  virtual int GetStallCount() const OVERRIDE;
+  virtual base::TimeDelta GetStallTime() const OVERRIDE;
 
   // PostTask target from |ByteStreamReaderImpl::MaybeUpdateInput|.
+  // |sink_starved| says whether the reader ran out of data since its last
+  // update.
   static void UpdateWindow(scoped_refptr<LifetimeFlag> lifetime_flag,
                            ByteStreamWriterImpl* target,
-                           size_t bytes_consumed);
+                           size_t bytes_consumed,
+                           bool sink_starved);
 
  private:
   // Called from UpdateWindow when object existence has been validated.
-  void UpdateWindowInternal(size_t bytes_consumed);
+  void UpdateWindowInternal(size_t bytes_consumed, bool sink_starved);
 
   void PostToPeer(bool complete, int status);
 
-  const size_t total_buffer_size_;
+  // The current size of the buffer, and the most it grows to.
+  size_t total_buffer_size_;
+  const size_t max_buffer_size_;
+
+  // Flow control statistics.  |stall_start_time_| is null unless the
+  // stream is currently full.
+  int stall_count_;
+  base::TimeTicks stall_start_time_;
+  base::TimeDelta stall_time_;
 
   // All data objects in this class are only valid to access on
   // this task runner except as otherwise noted.
@@ -127,11 +143,13 @@ class ByteStreamReaderImpl : public ByteStreamReader {
   // static because it may be called after the object it is targeting
   // has been destroyed.  It may not access |*target|
   // if |*object_lifetime_flag| is false.
+  // |buffer_size| is the writer's current buffer size.
   static void TransferData(
       scoped_refptr<LifetimeFlag> object_lifetime_flag,
       ByteStreamReaderImpl* target,
       scoped_ptr<ContentVector> transfer_buffer,
       size_t transfer_buffer_bytes,
+      size_t buffer_size,
       bool source_complete,
       int status);
 
@@ -140,12 +158,18 @@ class ByteStreamReaderImpl : public ByteStreamReader {
   void TransferDataInternal(
       scoped_ptr<ContentVector> transfer_buffer,
       size_t transfer_buffer_bytes,
+      size_t buffer_size,
       bool source_complete,
       int status);
 
   void MaybeUpdateInput();
 
-  const size_t total_buffer_size_;
+  // Follows the writer's buffer size, so that window updates are sent at
+  // the same fraction of the buffer as it grows.
+  size_t total_buffer_size_;
+
+  // Whether Read() found the stream empty since the last window update.
+  bool starved_;
 
   scoped_refptr<base::SequencedTaskRunner> my_task_runner_;
 
@@ -184,6 +208,11 @@ ByteStreamWriterImpl::ByteStreamWriterImpl(
     scoped_refptr<LifetimeFlag> lifetime_flag,
     size_t buffer_size)
     : total_buffer_size_(buffer_size),
+      max_buffer_size_(
+          buffer_size <= std::numeric_limits<size_t>::max() /
+                             kMaxBufferSizeMultiplier ?
+          buffer_size * kMaxBufferSizeMultiplier : buffer_size),
+      stall_count_(0),
       my_task_runner_(task_runner),
       my_lifetime_flag_(lifetime_flag),
       input_contents_size_(0),
@@ -229,7 +258,12 @@ bool ByteStreamWriterImpl::Write(
   if (input_contents_size_ > total_buffer_size_ / kFractionBufferBeforeSending)
     PostToPeer(false, 0);
 
-  return GetTotalBufferedBytes() <= total_buffer_size_;
+  bool space_available = GetTotalBufferedBytes() <= total_buffer_size_;
+  if (!space_available && stall_start_time_.is_null()) {
+    ++stall_count_;
+    stall_start_time_ = base::TimeTicks::Now();
+  }
+  return space_available;
 }
 
 void ByteStreamWriterImpl::Flush() {
@@ -256,30 +290,58 @@ size_t ByteStreamWriterImpl::GetTotalBufferedBytes() const {
   return input_contents_size_ + output_size_used_;
 }
 
+size_t ByteStreamWriterImpl::GetBufferSize() const {
+  DCHECK(my_task_runner_->RunsTasksOnCurrentThread());
+  return total_buffer_size_;
+}
+
+int ByteStreamWriterImpl::GetStallCount() const {
+  DCHECK(my_task_runner_->RunsTasksOnCurrentThread());
+  return stall_count_;
+}
+
+base::TimeDelta ByteStreamWriterImpl::GetStallTime() const {
+  DCHECK(my_task_runner_->RunsTasksOnCurrentThread());
+  if (stall_start_time_.is_null())
+    return stall_time_;
+  return stall_time_ + (base::TimeTicks::Now() - stall_start_time_);
+}
+
 // static
 void ByteStreamWriterImpl::UpdateWindow(
     scoped_refptr<LifetimeFlag> lifetime_flag, ByteStreamWriterImpl* target,
-    size_t bytes_consumed) {
+    size_t bytes_consumed, bool sink_starved) {
   // If the target object isn't alive anymore, we do nothing.
   if (!lifetime_flag->is_alive) return;
 
-  target->UpdateWindowInternal(bytes_consumed);
+  target->UpdateWindowInternal(bytes_consumed, sink_starved);
 }
 
-void ByteStreamWriterImpl::UpdateWindowInternal(size_t bytes_consumed) {
+void ByteStreamWriterImpl::UpdateWindowInternal(size_t bytes_consumed,
+                                                bool sink_starved) {
   DCHECK(my_task_runner_->RunsTasksOnCurrentThread());
 
   bool was_above_limit = GetTotalBufferedBytes() > total_buffer_size_;
 
+  // The source is held back while the sink runs dry: the window doesn't
+  // cover the round trip between the two, so make it larger.
+  if (was_above_limit && sink_starved) {
+    total_buffer_size_ += std::min(total_buffer_size_,
+                                   max_buffer_size_ - total_buffer_size_);
+  }
+
   DCHECK_GE(output_size_used_, bytes_consumed);
   output_size_used_ -= bytes_consumed;
 
   // Callback if we were above the limit and we're now <= to it.
   bool no_longer_above_limit = GetTotalBufferedBytes() <= total_buffer_size_;
 
-  if (no_longer_above_limit && was_above_limit &&
-      !space_available_callback_.is_null())
-    space_available_callback_.Run();
+  if (no_longer_above_limit && was_above_limit) {
+    stall_time_ += base::TimeTicks::Now() - stall_start_time_;
+    stall_start_time_ = base::TimeTicks();
+    if (!space_available_callback_.is_null())
+      space_available_callback_.Run();
+  }
 }
 
 void ByteStreamWriterImpl::PostToPeer(bool complete, int status) {
@@ -303,6 +365,7 @@ void ByteStreamWriterImpl::PostToPeer(bool complete, int status) {
           peer_,
           base::Passed(&transfer_buffer),
           buffer_size,
+          total_buffer_size_,
           complete,
           status));
 }
@@ -312,6 +375,7 @@ ByteStreamReaderImpl::ByteStreamReaderImpl(
     scoped_refptr<LifetimeFlag> lifetime_flag,
     size_t buffer_size)
     : total_buffer_size_(buffer_size),
+      starved_(false),
       my_task_runner_(task_runner),
       my_lifetime_flag_(lifetime_flag),
       received_status_(false),
@@ -352,6 +416,7 @@ ByteStreamReaderImpl::Read(scoped_refptr<net::IOBuffer>* data,
   if (received_status_) {
     return STREAM_COMPLETE;
   }
+  starved_ = true;
   return STREAM_EMPTY;
 }
 
@@ -373,6 +438,7 @@ void ByteStreamReaderImpl::TransferData(
     scoped_refptr<LifetimeFlag> object_lifetime_flag,
     ByteStreamReaderImpl* target,
     scoped_ptr<ContentVector> transfer_buffer,
+    size_t transfer_buffer_bytes,
     size_t buffer_size,
     bool source_complete,
     int status) {
@@ -380,16 +446,20 @@ void ByteStreamReaderImpl::TransferData(
   if (!object_lifetime_flag->is_alive) return;
 
   target->TransferDataInternal(
-      transfer_buffer.Pass(), buffer_size, source_complete, status);
+      transfer_buffer.Pass(), transfer_buffer_bytes, buffer_size,
+      source_complete, status);
 }
 
 void ByteStreamReaderImpl::TransferDataInternal(
     scoped_ptr<ContentVector> transfer_buffer,
+    size_t transfer_buffer_bytes,
     size_t buffer_size,
     bool source_complete,
     int status) {
   DCHECK(my_task_runner_->RunsTasksOnCurrentThread());
 
+  total_buffer_size_ = buffer_size;
+
   bool was_empty = available_contents_.empty();
 
   if (transfer_buffer) {
@@ -426,13 +496,16 @@ void ByteStreamReaderImpl::MaybeUpdateInput() {
           &ByteStreamWriterImpl::UpdateWindow,
           peer_lifetime_flag_,
           peer_,
-          unreported_consumed_bytes_));
+          unreported_consumed_bytes_,
+          starved_));
   unreported_consumed_bytes_ = 0;
+  starved_ = false;
 }
 
 }  // namespace
 
 const int ByteStreamWriter::kFractionBufferBeforeSending = 3;
+const int ByteStreamWriter::kMaxBufferSizeMultiplier = 4;
 const int ByteStreamReader::kFractionReadBeforeWindowUpdate = 3;
 
 ByteStreamReader::~ByteStreamReader() { }
@@ -8,6 +8,7 @@
 #include "base/callback.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/time/time.h"
 #include "content/common/content_export.h"
 #include "net/base/io_buffer.h"
 
@@ -34,6 +35,15 @@ namespace content {
 // from the GetStatus() method. Source and sink must agree on the interpretation
 // of this int.
 //
+// The buffer size passed to |CreateByteStream| is where the stream starts.
+// When the source is held back by a full stream while the sink keeps
+// running out of data, the stream is too small to cover the round trip
+// between the two task runners, and it grows, up to
+// |ByteStreamWriter::kMaxBufferSizeMultiplier| times its initial size.  It
+// doesn't grow when the sink is the bottleneck, since more buffering
+// wouldn't speed it up.  The writer reports how long the source has been
+// held back; see |ByteStreamWriter::GetStallTime|.
+//
 // Normally the source is not managed after the relationship is setup;
 // it is expected to provide data and then close itself.  If an error
 // occurs on the sink, it is not signalled to the source via this
@@ -124,6 +134,9 @@ class CONTENT_EXPORT ByteStreamWriter {
   // a notification is sent to paired Reader that there's more data.
   static const int kFractionBufferBeforeSending;
 
+  // The most the stream buffer grows to, as a multiple of its initial size.
+  static const int kMaxBufferSizeMultiplier;
+
   virtual ~ByteStreamWriter() = 0;
 
   // Always adds the data passed into the ByteStream.  Returns true
@@ -157,6 +170,16 @@ class CONTENT_EXPORT ByteStreamWriter {
   // Returns the number of bytes sent to the reader but not yet reported by
   // the reader as read.
   virtual size_t GetTotalBufferedBytes() const = 0;
+
+  // Returns the current size of the stream buffer, which starts at the size
+  // passed to CreateByteStream().
+  virtual size_t GetBufferSize() const = 0;
+
+  // Returns how many times Write() has reported the stream full, and how
+  // long in total the stream has been full since, including the current
+  // stall if there is one.
+  virtual int GetStallCount() const = 0;
+  virtual base::TimeDelta GetStallTime() const = 0;
 };
 
 class CONTENT_EXPORT ByteStreamReader {
@@ -425,6 +425,67 @@ TEST_F(ByteStreamTest, ByteStream_SourceCallback) {
   EXPECT_EQ(1, num_callbacks);
 }
 
+// Confirm that the buffer grows when the source is held back while the
+// sink runs dry, but not when the sink is what holds the source back.
+TEST_F(ByteStreamTest, ByteStream_AdaptiveBuffer) {
+  scoped_ptr<ByteStreamWriter> byte_stream_input;
+  scoped_ptr<ByteStreamReader> byte_stream_output;
+  CreateByteStream(
+      message_loop_.message_loop_proxy(), message_loop_.message_loop_proxy(),
+      3000, &byte_stream_input, &byte_stream_output);
+
+  scoped_refptr<net::IOBuffer> output_io_buffer;
+  size_t output_length;
+  int num_callbacks = 0;
+  byte_stream_input->RegisterCallback(
+      base::Bind(CountCallbacks, &num_callbacks));
+
+  // The sink is waiting for data when the source fills the stream.
+  EXPECT_EQ(ByteStreamReader::STREAM_EMPTY,
+            byte_stream_output->Read(&output_io_buffer, &output_length));
+  EXPECT_TRUE(Write(byte_stream_input.get(), 1024));
+  EXPECT_TRUE(Write(byte_stream_input.get(), 1024));
+  EXPECT_FALSE(Write(byte_stream_input.get(), 1024));
+  EXPECT_EQ(1, byte_stream_input->GetStallCount());
+  message_loop_.RunUntilIdle();
+
+  EXPECT_EQ(ByteStreamReader::STREAM_HAS_DATA,
+            byte_stream_output->Read(&output_io_buffer, &output_length));
+  EXPECT_TRUE(ValidateIOBuffer(output_io_buffer, output_length));
+  message_loop_.RunUntilIdle();
+  EXPECT_EQ(1, num_callbacks);
+  EXPECT_EQ(6000U, byte_stream_input->GetBufferSize());
+
+  EXPECT_EQ(ByteStreamReader::STREAM_HAS_DATA,
+            byte_stream_output->Read(&output_io_buffer, &output_length));
+  EXPECT_TRUE(ValidateIOBuffer(output_io_buffer, output_length));
+  EXPECT_EQ(ByteStreamReader::STREAM_HAS_DATA,
+            byte_stream_output->Read(&output_io_buffer, &output_length));
+  EXPECT_TRUE(ValidateIOBuffer(output_io_buffer, output_length));
+  message_loop_.RunUntilIdle();
+  EXPECT_EQ(0U, byte_stream_input->GetTotalBufferedBytes());
+
+  // The sink hasn't run dry when the source fills the larger stream.
+  EXPECT_TRUE(Write(byte_stream_input.get(), 1024));
+  EXPECT_TRUE(Write(byte_stream_input.get(), 1024));
+  EXPECT_TRUE(Write(byte_stream_input.get(), 1024));
+  EXPECT_TRUE(Write(byte_stream_input.get(), 1024));
+  EXPECT_TRUE(Write(byte_stream_input.get(), 1024));
+  EXPECT_FALSE(Write(byte_stream_input.get(), 1024));
+  EXPECT_EQ(2, byte_stream_input->GetStallCount());
+  message_loop_.RunUntilIdle();
+
+  EXPECT_EQ(ByteStreamReader::STREAM_HAS_DATA,
+            byte_stream_output->Read(&output_io_buffer, &output_length));
+  EXPECT_TRUE(ValidateIOBuffer(output_io_buffer, output_length));
+  EXPECT_EQ(ByteStreamReader::STREAM_HAS_DATA,
+            byte_stream_output->Read(&output_io_buffer, &output_length));
+  EXPECT_TRUE(ValidateIOBuffer(output_io_buffer, output_length));
+  message_loop_.RunUntilIdle();
+  EXPECT_EQ(2, num_callbacks);
+  EXPECT_EQ(6000U, byte_stream_input->GetBufferSize());
+}
+
 // Confirm that racing a change to a sink callback with a post results
 // in the new callback being called.
 TEST_F(ByteStreamTest, ByteStream_SinkInterrupt) {
@@ -134,6 +134,13 @@ bool DOMStorageArea::SetItem(const base::string16& key,
   if (is_shutdown_)
     return false;
   InitialImportIfNeeded();
+  base::NullableString16 current_value = map_->GetItem(key);
+  if (!current_value.is_null() && current_value.string() == value) {
+    // Rewriting the same value neither unshares a map that is shared with a
+    // session storage clone nor needs to be committed.
+    *old_value = current_value;
+    return true;
+  }
   if (!map_->HasOneRef())
     map_ = map_->DeepCopy();
   bool success = map_->SetItem(key, value, old_value);
@@ -149,6 +156,8 @@ bool DOMStorageArea::RemoveItem(const base::string16& key,
   if (is_shutdown_)
     return false;
   InitialImportIfNeeded();
+  if (map_->GetItem(key).is_null())
+    return false;
   if (!map_->HasOneRef())
     map_ = map_->DeepCopy();
   bool success = map_->RemoveItem(key, old_value);
@@ -97,6 +97,12 @@ TEST_F(DOMStorageAreaTest, DOMStorageAreaBasics) {
   EXPECT_EQ(area->Key(0).string(), copy->Key(0).string());
   EXPECT_EQ(copy->map_.get(), area->map_.get());
 
+  // Writes that change nothing keep sharing the map.
+  EXPECT_TRUE(area->SetItem(kKey, kValue, &old_nullable_value));
+  EXPECT_EQ(kValue, old_nullable_value.string());
+  EXPECT_FALSE(area->RemoveItem(ASCIIToUTF16("missing"), &old_value));
+  EXPECT_EQ(copy->map_.get(), area->map_.get());
+
   // But will deep copy-on-write as needed.
   EXPECT_TRUE(area->RemoveItem(kKey, &old_value));
   EXPECT_NE(copy->map_.get(), area->map_.get());
@@ -235,6 +241,11 @@ TEST_F(DOMStorageAreaTest, CommitTasks) {
   EXPECT_EQ(2u, area->commit_batch_->changed_values.size());
   base::MessageLoop::current()->RunUntilIdle();
   EXPECT_FALSE(area->HasUncommittedChanges());
+
+  // Rewriting a value that is already stored is not committed again.
+  EXPECT_TRUE(area->SetItem(kKey, kValue, &old_value));
+  EXPECT_FALSE(area->commit_batch_.get());
+  EXPECT_FALSE(area->HasUncommittedChanges());
   EXPECT_FALSE(area->commit_batch_.get());
   EXPECT_EQ(0, area->commit_batches_in_flight_);
   // Verify the changes made it to the database.
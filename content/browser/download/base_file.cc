@@ -41,6 +41,7 @@ BaseFile::BaseFile(const base::FilePath& full_path,
       start_tick_(base::TimeTicks::Now()),
       calculate_hash_(calculate_hash),
       detached_(false),
+      sparse_(false),
       bound_net_log_(bound_net_log) {
   memcpy(sha256_hash_, kEmptySha256Hash, crypto::kSHA256Length);
   if (calculate_hash_) {
@@ -148,6 +149,29 @@ DownloadInterruptReason BaseFile::AppendDataToFile(const char* data,
   return DOWNLOAD_INTERRUPT_REASON_NONE;
 }
 
+DownloadInterruptReason BaseFile::WriteDataToFileAtOffset(const char* data,
+                                                          size_t data_len,
+                                                          int64 offset) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::FILE));
+  DCHECK(!detached_);
+
+  if (!file_stream_)
+    return LogInterruptReason("No file stream on write", 0,
+                              DOWNLOAD_INTERRUPT_REASON_FILE_FAILED);
+
+  if (!sparse_) {
+    sparse_ = true;
+    calculate_hash_ = false;
+    secure_hash_.reset();
+  }
+
+  int64 seek_result = file_stream_->SeekSync(net::FROM_BEGIN, offset);
+  if (seek_result < 0)
+    return LogNetError("Seek", static_cast<net::Error>(seek_result));
+
+  return AppendDataToFile(data, data_len);
+}
+
 DownloadInterruptReason BaseFile::Rename(const base::FilePath& new_path) {
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::FILE));
   DownloadInterruptReason rename_result = DOWNLOAD_INTERRUPT_REASON_NONE;
@@ -295,6 +319,11 @@ DownloadInterruptReason BaseFile::Open() {
     file_stream_->SetBoundNetLogSource(bound_net_log_);
   }
 
+  // The writes of a sparse file are positioned explicitly, and its size says
+  // nothing about how much of it was written.
+  if (sparse_)
+    return DOWNLOAD_INTERRUPT_REASON_NONE;
+
   int64 file_size = file_stream_->SeekSync(net::FROM_END, 0);
   if (file_size > bytes_so_far_) {
     // The file is larger than we expected.
@@ -57,6 +57,14 @@ class CONTENT_EXPORT BaseFile {
   // indicating the result of the operation.
   DownloadInterruptReason AppendDataToFile(const char* data, size_t data_len);
 
+  // Write a chunk of data at |offset| of the file rather than at its end, for
+  // downloads fetched with several range requests at once. Since the writes
+  // are no longer in file order, this stops the hash calculation, and the
+  // file is no longer truncated to bytes_so_far() when it is reopened.
+  DownloadInterruptReason WriteDataToFileAtOffset(const char* data,
+                                                  size_t data_len,
+                                                  int64 offset);
+
   // Rename the download file. Returns a DownloadInterruptReason indicating the
   // result of the operation.
   virtual DownloadInterruptReason Rename(const base::FilePath& full_path);
@@ -173,6 +181,10 @@ class CONTENT_EXPORT BaseFile {
   // won't delete it on destruction.
   bool detached_;
 
+  // Whether data was written with WriteDataToFileAtOffset(), so that the file
+  // may have holes and extend past bytes_so_far_.
+  bool sparse_;
+
   net::BoundNetLog bound_net_log_;
 
   DISALLOW_COPY_AND_ASSIGN(BaseFile);
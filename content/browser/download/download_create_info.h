@@ -78,6 +78,10 @@ struct CONTENT_EXPORT DownloadCreateInfo {
   // For continuing a download, the ETAG of the file.
   std::string etag;
 
+  // The Accept-Ranges header of the response, which says whether the
+  // download can be fetched with several range requests.
+  std::string accept_ranges;
+
   // The download file save info.
   scoped_ptr<DownloadSaveInfo> save_info;
 
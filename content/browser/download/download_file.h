@@ -10,11 +10,13 @@
 #include "base/basictypes.h"
 #include "base/callback_forward.h"
 #include "base/files/file_path.h"
+#include "base/memory/scoped_ptr.h"
 #include "content/common/content_export.h"
 #include "content/public/browser/download_interrupt_reasons.h"
 
 namespace content {
 
+class ByteStreamReader;
 class DownloadManager;
 
 // These objects live exclusively on the file thread and handle the writing
@@ -56,6 +58,17 @@ class CONTENT_EXPORT DownloadFile {
   virtual void RenameAndAnnotate(const base::FilePath& full_path,
                                  const RenameCompletionCallback& callback) = 0;
 
+  // Splits what is left of the download, which is |total_bytes| long, across
+  // several range requests. The observer is asked to start each of them with
+  // DestinationRequestsSlice(), and their data is passed to AddByteStream().
+  // Does nothing if the download is too small to be worth splitting.
+  virtual void StartParallelDownload(int64 total_bytes) = 0;
+
+  // Writes the data of |stream| to the file from |offset|, which must be one
+  // that was passed to DestinationRequestsSlice().
+  virtual void AddByteStream(scoped_ptr<ByteStreamReader> stream,
+                             int64 offset) = 0;
+
   // Detach the file so it is not deleted on destruction.
   virtual void Detach() = 0;
 
@@ -4,6 +4,7 @@
 
 #include "content/browser/download/download_file_impl.h"
 
+#include <algorithm>
 #include <string>
 
 #include "base/bind.h"
@@ -26,6 +27,11 @@ namespace content {
 const int kUpdatePeriodMs = 500;
 const int kMaxTimeBlockingFileThreadMs = 1000;
 
+// The most requests a download is fetched with at once, and the smallest
+// slice worth a request of its own.
+const int kMaxParallelStreams = 4;
+const int64 kMinSliceLength = 1024 * 1024;
+
 int DownloadFile::number_active_objects_ = 0;
 
 DownloadFileImpl::DownloadFileImpl(
@@ -47,12 +53,14 @@ DownloadFileImpl::DownloadFileImpl(
                 save_info->file_stream.Pass(),
                 bound_net_log),
           default_download_directory_(default_download_directory),
-          stream_reader_(stream.Pass()),
           bytes_seen_(0),
           bound_net_log_(bound_net_log),
           observer_(observer),
           weak_factory_(this),
           power_save_blocker_(power_save_blocker.Pass()) {
+  linked_ptr<SourceStream> source(new SourceStream(save_info->offset, 0));
+  source->reader = stream.Pass();
+  source_streams_[source->offset] = source;
 }
 
 DownloadFileImpl::~DownloadFileImpl() {
@@ -72,8 +80,11 @@ void DownloadFileImpl::Initialize(const InitializeCallback& callback) {
     return;
   }
 
-  stream_reader_->RegisterCallback(
-      base::Bind(&DownloadFileImpl::StreamActive, weak_factory_.GetWeakPtr()));
+  DCHECK_EQ(1u, source_streams_.size());
+  int64 offset = source_streams_.begin()->first;
+  source_streams_.begin()->second->reader->RegisterCallback(
+      base::Bind(&DownloadFileImpl::StreamActive, weak_factory_.GetWeakPtr(),
+                 offset));
 
   download_start_ = base::TimeTicks::Now();
 
@@ -81,7 +92,7 @@ void DownloadFileImpl::Initialize(const InitializeCallback& callback) {
   SendUpdate();
 
   // Initial pull from the straw.
-  StreamActive();
+  StreamActive(offset);
 
   BrowserThread::PostTask(
       BrowserThread::UI, FROM_HERE, base::Bind(
@@ -123,8 +134,8 @@ void DownloadFileImpl::RenameAndUniquify(
     // error out.
     SendUpdate();
 
-    // Null out callback so that we don't do any more stream processing.
-    stream_reader_->RegisterCallback(base::Closure());
+    // Stop the streams so that we don't do any more stream processing.
+    ClearSourceStreams();
 
     new_path.clear();
   }
@@ -161,8 +172,8 @@ void DownloadFileImpl::RenameAndAnnotate(
     // error out.
     SendUpdate();
 
-    // Null out callback so that we don't do any more stream processing.
-    stream_reader_->RegisterCallback(base::Closure());
+    // Stop the streams so that we don't do any more stream processing.
+    ClearSourceStreams();
 
     new_path.clear();
   }
@@ -172,6 +183,51 @@ void DownloadFileImpl::RenameAndAnnotate(
       base::Bind(callback, reason, new_path));
 }
 
+void DownloadFileImpl::StartParallelDownload(int64 total_bytes) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::FILE));
+
+  if (source_streams_.size() != 1)
+    return;
+  SourceStream* source = source_streams_.begin()->second.get();
+  if (source->finished || source->length)
+    return;
+
+  int64 start = source->offset + source->bytes_written;
+  int64 remaining = total_bytes - start;
+  int num_slices = static_cast<int>(
+      std::min<int64>(kMaxParallelStreams, remaining / kMinSliceLength));
+  if (num_slices < 2)
+    return;
+
+  // The original request keeps the first slice, as it is already under way.
+  int64 slice_length = remaining / num_slices;
+  source->length = source->bytes_written + slice_length;
+  for (int i = 1; i < num_slices; ++i) {
+    int64 offset = start + i * slice_length;
+    AddSlice(offset,
+             i == num_slices - 1 ? total_bytes - offset : slice_length);
+  }
+}
+
+void DownloadFileImpl::AddByteStream(scoped_ptr<ByteStreamReader> stream,
+                                     int64 offset) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::FILE));
+
+  SourceStreamMap::iterator it = source_streams_.find(offset);
+  // The download may have failed since the slice was asked for.
+  if (it == source_streams_.end() || it->second->finished ||
+      it->second->reader) {
+    return;
+  }
+
+  SourceStream* source = it->second.get();
+  source->reader = stream.Pass();
+  source->reader->RegisterCallback(
+      base::Bind(&DownloadFileImpl::StreamActive, weak_factory_.GetWeakPtr(),
+                 offset));
+  StreamActive(offset);
+}
+
 void DownloadFileImpl::Detach() {
   file_.Detach();
 }
@@ -204,7 +260,28 @@ void DownloadFileImpl::SetClientGuid(const std::string& guid) {
   file_.SetClientGuid(guid);
 }
 
-void DownloadFileImpl::StreamActive() {
+DownloadFileImpl::SourceStream::SourceStream(int64 offset, int64 length)
+    : offset(offset),
+      length(length),
+      bytes_written(0),
+      finished(false) {
+}
+
+DownloadFileImpl::SourceStream::~SourceStream() {
+}
+
+bool DownloadFileImpl::SourceStream::IsComplete() const {
+  return length && bytes_written == length;
+}
+
+void DownloadFileImpl::StreamActive(int64 offset) {
+  SourceStreamMap::iterator it = source_streams_.find(offset);
+  DCHECK(it != source_streams_.end());
+  SourceStream* source = it->second.get();
+  // The stream may have been stopped since this task was posted.
+  if (source->finished)
+    return;
+
   base::TimeTicks start(base::TimeTicks::Now());
   base::TimeTicks now;
   scoped_refptr<net::IOBuffer> incoming_data;
@@ -218,7 +295,7 @@ void DownloadFileImpl::StreamActive() {
 
   // Take care of any file local activity required.
   do {
-    state = stream_reader_->Read(&incoming_data, &incoming_data_size);
+    state = source->reader->Read(&incoming_data, &incoming_data_size);
 
     switch (state) {
       case ByteStreamReader::STREAM_EMPTY:
@@ -226,26 +303,28 @@ void DownloadFileImpl::StreamActive() {
       case ByteStreamReader::STREAM_HAS_DATA:
         {
           ++num_buffers;
+          // A stream whose slice was split keeps receiving the data that
+          // the next stream writes; drop it.
+          size_t write_size = incoming_data_size;
+          if (source->length) {
+            write_size = static_cast<size_t>(std::min<int64>(
+                write_size, source->length - source->bytes_written));
+          }
           base::TimeTicks write_start(base::TimeTicks::Now());
-          reason = AppendDataToFile(
-              incoming_data.get()->data(), incoming_data_size);
+          reason = WriteSourceData(
+              source, incoming_data.get()->data(), write_size);
           disk_writes_time_ += (base::TimeTicks::Now() - write_start);
-          bytes_seen_ += incoming_data_size;
-          total_incoming_data_size += incoming_data_size;
+          bytes_seen_ += write_size;
+          total_incoming_data_size += write_size;
         }
         break;
       case ByteStreamReader::STREAM_COMPLETE:
-        {
-          reason = static_cast<DownloadInterruptReason>(
-              stream_reader_->GetStatus());
-          SendUpdate();
-          base::TimeTicks close_start(base::TimeTicks::Now());
-          file_.Finish();
-          base::TimeTicks now(base::TimeTicks::Now());
-          disk_writes_time_ += (now - close_start);
-          RecordFileBandwidth(
-              bytes_seen_, disk_writes_time_, now - download_start_);
-          update_timer_.reset();
+        reason = static_cast<DownloadInterruptReason>(
+            source->reader->GetStatus());
+        // The server sent less than the slice.
+        if (reason == DOWNLOAD_INTERRUPT_REASON_NONE &&
+            source->bytes_written < source->length) {
+          reason = DOWNLOAD_INTERRUPT_REASON_NETWORK_FAILED;
         }
         break;
       default:
@@ -255,15 +334,49 @@ void DownloadFileImpl::StreamActive() {
     now = base::TimeTicks::Now();
   } while (state == ByteStreamReader::STREAM_HAS_DATA &&
            reason == DOWNLOAD_INTERRUPT_REASON_NONE &&
+           !source->IsComplete() &&
            now - start <= delta);
 
+  bool source_finished = state == ByteStreamReader::STREAM_COMPLETE ||
+      (reason == DOWNLOAD_INTERRUPT_REASON_NONE && source->IsComplete());
+
   // If we're stopping to yield the thread, post a task so we come back.
-  if (state == ByteStreamReader::STREAM_HAS_DATA &&
+  if (state == ByteStreamReader::STREAM_HAS_DATA && !source_finished &&
       now - start > delta) {
     BrowserThread::PostTask(
         BrowserThread::FILE, FROM_HERE,
         base::Bind(&DownloadFileImpl::StreamActive,
-                   weak_factory_.GetWeakPtr()));
+                   weak_factory_.GetWeakPtr(), offset));
+  }
+
+  if (source_finished) {
+    source->reader->RegisterCallback(base::Closure());
+    source->finished = true;
+    if (source_streams_.size() > 1) {
+      BrowserThread::PostTask(
+          BrowserThread::UI, FROM_HERE,
+          base::Bind(&DownloadDestinationObserver::DestinationSliceCompleted,
+                     observer_, offset));
+    }
+  }
+
+  bool all_finished = source_finished;
+  for (SourceStreamMap::const_iterator iter = source_streams_.begin();
+       all_finished && iter != source_streams_.end(); ++iter) {
+    all_finished = iter->second->finished;
+  }
+
+  if (all_finished) {
+    SendUpdate();
+    base::TimeTicks close_start(base::TimeTicks::Now());
+    file_.Finish();
+    base::TimeTicks now(base::TimeTicks::Now());
+    disk_writes_time_ += (now - close_start);
+    RecordFileBandwidth(
+        bytes_seen_, disk_writes_time_, now - download_start_);
+    update_timer_.reset();
+  } else if (source_finished && reason == DOWNLOAD_INTERRUPT_REASON_NONE) {
+    SplitSlowestSlice();
   }
 
   if (total_incoming_data_size)
@@ -276,16 +389,15 @@ void DownloadFileImpl::StreamActive() {
     // Error case for both upstream source and file write.
     // Shut down processing and signal an error to our observer.
     // Our observer will clean us up.
-    stream_reader_->RegisterCallback(base::Closure());
+    ClearSourceStreams();
     weak_factory_.InvalidateWeakPtrs();
     SendUpdate();                       // Make info up to date before error.
     BrowserThread::PostTask(
         BrowserThread::UI, FROM_HERE,
         base::Bind(&DownloadDestinationObserver::DestinationError,
                    observer_, reason));
-  } else if (state == ByteStreamReader::STREAM_COMPLETE) {
+  } else if (all_finished) {
     // Signal successful completion and shut down processing.
-    stream_reader_->RegisterCallback(base::Closure());
     weak_factory_.InvalidateWeakPtrs();
     std::string hash;
     if (!GetHash(&hash) || file_.IsEmptyHash(hash))
@@ -305,6 +417,78 @@ void DownloadFileImpl::StreamActive() {
   }
 }
 
+DownloadInterruptReason DownloadFileImpl::WriteSourceData(
+    SourceStream* source, const char* data, size_t data_len) {
+  source->rate_estimator.Increment(data_len);
+  int64 position = source->offset + source->bytes_written;
+  source->bytes_written += data_len;
+
+  // Until the download is split, the data is written in file order.
+  if (source_streams_.size() == 1)
+    return AppendDataToFile(data, data_len);
+
+  if (!update_timer_->IsRunning()) {
+    update_timer_->Start(FROM_HERE,
+                         base::TimeDelta::FromMilliseconds(kUpdatePeriodMs),
+                         this, &DownloadFileImpl::SendUpdate);
+  }
+  rate_estimator_.Increment(data_len);
+  return file_.WriteDataToFileAtOffset(data, data_len, position);
+}
+
+void DownloadFileImpl::AddSlice(int64 offset, int64 length) {
+  DCHECK(source_streams_.find(offset) == source_streams_.end());
+  source_streams_[offset] = make_linked_ptr(new SourceStream(offset, length));
+  BrowserThread::PostTask(
+      BrowserThread::UI, FROM_HERE,
+      base::Bind(&DownloadDestinationObserver::DestinationRequestsSlice,
+                 observer_, offset, length));
+}
+
+void DownloadFileImpl::SplitSlowestSlice() {
+  int num_unfinished = 0;
+  SourceStream* slowest = NULL;
+  double slowest_seconds_left = 0;
+  for (SourceStreamMap::iterator it = source_streams_.begin();
+       it != source_streams_.end(); ++it) {
+    SourceStream* source = it->second.get();
+    if (source->finished)
+      continue;
+    ++num_unfinished;
+    // Streams that haven't started yet have no rate to go by.
+    int64 bytes_left = source->length - source->bytes_written;
+    if (!source->reader || bytes_left < 2 * kMinSliceLength)
+      continue;
+    double seconds_left = static_cast<double>(bytes_left) /
+        std::max<int64>(source->rate_estimator.GetCountPerSecond(), 1);
+    if (seconds_left > slowest_seconds_left) {
+      slowest = source;
+      slowest_seconds_left = seconds_left;
+    }
+  }
+  if (!slowest || num_unfinished >= kMaxParallelStreams)
+    return;
+
+  // Hand the second half of what the slowest stream has left to a new one.
+  int64 end = slowest->offset + slowest->length;
+  int64 split = slowest->offset + slowest->bytes_written +
+      (slowest->length - slowest->bytes_written) / 2;
+  slowest->length = split - slowest->offset;
+  AddSlice(split, end - split);
+}
+
+void DownloadFileImpl::ClearSourceStreams() {
+  for (SourceStreamMap::iterator it = source_streams_.begin();
+       it != source_streams_.end(); ++it) {
+    SourceStream* source = it->second.get();
+    if (source->finished)
+      continue;
+    if (source->reader)
+      source->reader->RegisterCallback(base::Closure());
+    source->finished = true;
+  }
+}
+
 void DownloadFileImpl::SendUpdate() {
   BrowserThread::PostTask(
       BrowserThread::UI, FROM_HERE,
@@ -7,6 +7,9 @@
 
 #include "content/browser/download/download_file.h"
 
+#include <map>
+
+#include "base/memory/linked_ptr.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/memory/weak_ptr.h"
@@ -56,6 +59,9 @@ class CONTENT_EXPORT DownloadFileImpl : virtual public DownloadFile {
   virtual void RenameAndAnnotate(
       const base::FilePath& full_path,
       const RenameCompletionCallback& callback) OVERRIDE;
+  virtual void StartParallelDownload(int64 total_bytes) OVERRIDE;
+  virtual void AddByteStream(scoped_ptr<ByteStreamReader> stream,
+                             int64 offset) OVERRIDE;
   virtual void Detach() OVERRIDE;
   virtual void Cancel() OVERRIDE;
   virtual base::FilePath FullPath() const OVERRIDE;
@@ -71,12 +77,59 @@ class CONTENT_EXPORT DownloadFileImpl : virtual public DownloadFile {
       const char* data, size_t data_len);
 
  private:
+  // One of the requests the download is fetched with. The original request
+  // is the only one unless StartParallelDownload() splits the download, after
+  // which each stream writes the slice of the file that starts at |offset|.
+  struct SourceStream {
+    SourceStream(int64 offset, int64 length);
+    ~SourceStream();
+
+    // Whether all of the slice has been written.
+    bool IsComplete() const;
+
+    int64 offset;
+
+    // The number of bytes of the slice, or 0 if the stream runs to the end of
+    // the download.
+    int64 length;
+
+    int64 bytes_written;
+
+    // NULL until the request for the slice is started.
+    scoped_ptr<ByteStreamReader> reader;
+
+    // Whether nothing more is read from the stream, either because all of
+    // the slice is written or because the download stopped.
+    bool finished;
+
+    // The rate of this stream alone, to find the slowest one.
+    RateEstimator rate_estimator;
+  };
+
+  typedef std::map<int64, linked_ptr<SourceStream> > SourceStreamMap;
+
   // Send an update on our progress.
   void SendUpdate();
 
-  // Called when there's some activity on stream_reader_ that needs to be
-  // handled.
-  void StreamActive();
+  // Called when there's some activity on the stream that writes from
+  // |offset| that needs to be handled.
+  void StreamActive(int64 offset);
+
+  // Writes |data| where |source| is at in the file.
+  DownloadInterruptReason WriteSourceData(SourceStream* source,
+                                          const char* data,
+                                          size_t data_len);
+
+  // Reserves the |length| bytes at |offset| for a new stream and asks the
+  // observer to start its request.
+  void AddSlice(int64 offset, int64 length);
+
+  // Splits the slice that is expected to take longest to finish, so that
+  // the stream that just finished helps with it.
+  void SplitSlowestSlice();
+
+  // Stops reading from every stream.
+  void ClearSourceStreams();
 
   // The base file instance.
   BaseFile file_;
@@ -84,11 +137,11 @@ class CONTENT_EXPORT DownloadFileImpl : virtual public DownloadFile {
   // The default directory for creating the download file.
   base::FilePath default_download_directory_;
 
-  // The stream through which data comes.
+  // The streams through which data comes, by the offset they write from.
   // TODO(rdsmith): Move this into BaseFile; requires using the same
   // stream semantics in SavePackage.  Alternatively, replace SaveFile
   // with DownloadFile and get rid of BaseFile.
-  scoped_ptr<ByteStreamReader> stream_reader_;
+  SourceStreamMap source_streams_;
 
   // Used to trigger progress updates.
   scoped_ptr<base::RepeatingTimer<DownloadFileImpl> > update_timer_;
@@ -27,6 +27,7 @@ using ::testing::AnyNumber;
 using ::testing::DoAll;
 using ::testing::InSequence;
 using ::testing::Return;
+using ::testing::SaveArg;
 using ::testing::SetArgPointee;
 using ::testing::StrictMock;
 
@@ -50,6 +51,8 @@ class MockDownloadDestinationObserver : public DownloadDestinationObserver {
   MOCK_METHOD3(DestinationUpdate, void(int64, int64, const std::string&));
   MOCK_METHOD1(DestinationError, void(DownloadInterruptReason));
   MOCK_METHOD1(DestinationCompleted, void(const std::string&));
+  MOCK_METHOD2(DestinationRequestsSlice, void(int64, int64));
+  MOCK_METHOD1(DestinationSliceCompleted, void(int64));
 
   // Doesn't override any methods in the base class.  Used to make sure
   // that the last DestinationUpdate before a Destination{Completed,Error}
@@ -602,4 +605,68 @@ TEST_F(DownloadFileTest, ConfirmUpdate) {
   DestroyDownloadFile(0);
 }
 
+// Split the download in two and make sure that each stream writes its own
+// slice of the file, and that the download completes once both are done.
+TEST_F(DownloadFileTest, ParallelStreams) {
+  ASSERT_TRUE(CreateDownloadFile(0, true));
+
+  // Large enough for two slices.
+  const int64 kSliceLength = 1024 * 1024;
+  EXPECT_CALL(*(observer_.get()),
+              DestinationRequestsSlice(kSliceLength, kSliceLength));
+  download_file_->StartParallelDownload(2 * kSliceLength);
+  loop_.RunUntilIdle();
+  ::testing::Mock::VerifyAndClearExpectations(observer_.get());
+  EXPECT_CALL(*(observer_.get()), DestinationUpdate(_, _, _))
+      .Times(AnyNumber());
+
+  StrictMock<MockByteStreamReader>* slice_stream =
+      new StrictMock<MockByteStreamReader>();
+  base::Closure slice_callback;
+  EXPECT_CALL(*slice_stream, RegisterCallback(_))
+      .WillOnce(SaveArg<0>(&slice_callback))
+      .RetiresOnSaturation();
+  EXPECT_CALL(*slice_stream, Read(_, _))
+      .WillOnce(Return(ByteStreamReader::STREAM_EMPTY))
+      .RetiresOnSaturation();
+  download_file_->AddByteStream(
+      scoped_ptr<ByteStreamReader>(slice_stream), kSliceLength);
+  ::testing::Mock::VerifyAndClearExpectations(slice_stream);
+
+  // The original request sends more than its slice; the rest is dropped.
+  scoped_refptr<net::IOBuffer> first_data =
+      new net::IOBuffer(kSliceLength + 10);
+  memset(first_data->data(), 'a', kSliceLength + 10);
+  EXPECT_CALL(*input_stream_, Read(_, _))
+      .WillOnce(DoAll(SetArgPointee<0>(first_data),
+                      SetArgPointee<1>(kSliceLength + 10),
+                      Return(ByteStreamReader::STREAM_HAS_DATA)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(*input_stream_, RegisterCallback(_))
+      .RetiresOnSaturation();
+  EXPECT_CALL(*(observer_.get()), DestinationSliceCompleted(0));
+  sink_callback_.Run();
+  loop_.RunUntilIdle();
+  expected_data_ += std::string(kSliceLength, 'a');
+
+  scoped_refptr<net::IOBuffer> second_data = new net::IOBuffer(kSliceLength);
+  memset(second_data->data(), 'b', kSliceLength);
+  // The stream is done once it has written its slice, without waiting for
+  // the end of its response.
+  EXPECT_CALL(*slice_stream, Read(_, _))
+      .WillOnce(DoAll(SetArgPointee<0>(second_data),
+                      SetArgPointee<1>(kSliceLength),
+                      Return(ByteStreamReader::STREAM_HAS_DATA)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(*slice_stream, RegisterCallback(_))
+      .RetiresOnSaturation();
+  EXPECT_CALL(*(observer_.get()), DestinationSliceCompleted(kSliceLength));
+  EXPECT_CALL(*(observer_.get()), DestinationCompleted(_));
+  slice_callback.Run();
+  loop_.RunUntilIdle();
+  expected_data_ += std::string(kSliceLength, 'b');
+
+  DestroyDownloadFile(0);
+}
+
 }  // namespace content
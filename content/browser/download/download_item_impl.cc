@@ -35,6 +35,7 @@
 #include "base/stl_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
+#include "content/browser/byte_stream.h"
 #include "content/browser/download/download_create_info.h"
 #include "content/browser/download/download_file.h"
 #include "content/browser/download/download_interrupt_reasons_impl.h"
@@ -146,6 +147,7 @@ DownloadItemImpl::DownloadItemImpl(DownloadItemImplDelegate* delegate,
       end_time_(end_time),
       delegate_(delegate),
       is_paused_(false),
+      parallel_download_(false),
       auto_resume_count_(0),
       open_when_complete_(false),
       file_externally_removed_(false),
@@ -188,6 +190,7 @@ DownloadItemImpl::DownloadItemImpl(
       bytes_per_sec_(0),
       last_modified_time_(info.last_modified),
       etag_(info.etag),
+      accept_ranges_(info.accept_ranges),
       last_reason_(DOWNLOAD_INTERRUPT_REASON_NONE),
       start_tick_(base::TimeTicks::Now()),
       state_(IN_PROGRESS_INTERNAL),
@@ -195,6 +198,7 @@ DownloadItemImpl::DownloadItemImpl(
       start_time_(info.start_time),
       delegate_(delegate),
       is_paused_(false),
+      parallel_download_(false),
       auto_resume_count_(0),
       open_when_complete_(false),
       file_externally_removed_(false),
@@ -250,6 +254,7 @@ DownloadItemImpl::DownloadItemImpl(
       start_time_(base::Time::Now()),
       delegate_(delegate),
       is_paused_(false),
+      parallel_download_(false),
       auto_resume_count_(0),
       open_when_complete_(false),
       file_externally_removed_(false),
@@ -346,6 +351,11 @@ void DownloadItemImpl::Pause() {
     return;
 
   request_handle_->PauseRequest();
+  for (SliceRequestMap::iterator it = slice_requests_.begin();
+       it != slice_requests_.end(); ++it) {
+    if (it->second)
+      it->second->PauseRequest();
+  }
   is_paused_ = true;
   UpdateObservers();
 }
@@ -357,6 +367,11 @@ void DownloadItemImpl::Resume() {
       if (!is_paused_)
         return;
       request_handle_->ResumeRequest();
+      for (SliceRequestMap::iterator it = slice_requests_.begin();
+           it != slice_requests_.end(); ++it) {
+        if (it->second)
+          it->second->ResumeRequest();
+      }
       is_paused_ = false;
       UpdateObservers();
       return;
@@ -412,6 +427,7 @@ void DownloadItemImpl::Cancel(bool user_cancel) {
     // Cancel the originating URL request unless it's already been cancelled
     // by interrupt.
     request_handle_->CancelRequest();
+    CancelSliceRequests();
   }
 
   // Remove the intermediate file if we are cancelling an interrupted download.
@@ -958,6 +974,7 @@ void DownloadItemImpl::MergeOriginInfoOnResume(
       url_chain_.end(), chain_iter, new_create_info.url_chain.end());
   etag_ = new_create_info.etag;
   last_modified_time_ = new_create_info.last_modified;
+  accept_ranges_ = new_create_info.accept_ranges;
   content_disposition_ = new_create_info.content_disposition;
 
   // Don't update observers. This method is expected to be called just before a
@@ -1066,6 +1083,51 @@ void DownloadItemImpl::DestinationCompleted(const std::string& final_hash) {
   MaybeCompleteDownload();
 }
 
+void DownloadItemImpl::DestinationRequestsSlice(int64 offset, int64 length) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  VLOG(20) << __FUNCTION__ << " offset=" << offset << " length=" << length
+           << " download=" << DebugString(true);
+  if (state_ != IN_PROGRESS_INTERNAL || !parallel_download_)
+    return;
+
+  // The slice can't be fetched without a web contents, and the download
+  // can't complete without it.
+  if (!GetWebContents()) {
+    Interrupt(DOWNLOAD_INTERRUPT_REASON_NETWORK_FAILED);
+    return;
+  }
+
+  // The validators make sure that every slice comes from the same file.
+  scoped_ptr<DownloadUrlParameters> slice_params(
+      DownloadUrlParameters::FromWebContents(GetWebContents(), GetURL()));
+  slice_params->set_offset(offset);
+  slice_params->set_length(length);
+  slice_params->set_last_modified(GetLastModifiedTime());
+  slice_params->set_etag(GetETag());
+  slice_params->set_callback(
+      base::Bind(&DownloadItemImpl::OnSliceRequestStarted,
+                 weak_ptr_factory_.GetWeakPtr(), offset));
+
+  slice_requests_[offset] = linked_ptr<DownloadRequestHandleInterface>();
+  delegate_->StartSliceRequest(slice_params.Pass(), GetId());
+}
+
+void DownloadItemImpl::DestinationSliceCompleted(int64 offset) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  SliceRequestMap::iterator it = slice_requests_.find(offset);
+  if (it != slice_requests_.end()) {
+    if (it->second)
+      it->second->CancelRequest();
+    slice_requests_.erase(it);
+    return;
+  }
+
+  // The original request, which starts at the beginning of the file, has
+  // written its own slice; what it would send next belongs to another one.
+  if (offset == 0 && parallel_download_ && state_ == IN_PROGRESS_INTERNAL)
+    request_handle_->CancelRequest();
+}
+
 // **** Download progression cascade
 
 void DownloadItemImpl::Init(bool active,
@@ -1124,6 +1186,7 @@ void DownloadItemImpl::Start(
   }
 
   TransitionTo(IN_PROGRESS_INTERNAL, UPDATE_OBSERVERS);
+  parallel_download_ = ShouldDownloadInParallel();
 
   BrowserThread::PostTask(
       BrowserThread::FILE, FROM_HERE,
@@ -1134,6 +1197,36 @@ void DownloadItemImpl::Start(
                             weak_ptr_factory_.GetWeakPtr())));
 }
 
+void DownloadItemImpl::AddSliceStream(const DownloadCreateInfo& info,
+                                      scoped_ptr<ByteStreamReader> stream) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  scoped_ptr<DownloadRequestHandleInterface> request_handle(
+      new DownloadRequestHandle(info.request_handle));
+  int64 offset = info.save_info->offset;
+
+  SliceRequestMap::iterator it = slice_requests_.find(offset);
+  if (state_ != IN_PROGRESS_INTERNAL || !download_file_ ||
+      it == slice_requests_.end() || it->second) {
+    request_handle->CancelRequest();
+    // A response that isn't for a range has its offset reset to 0; the
+    // server doesn't honor range requests after all.
+    if (state_ == IN_PROGRESS_INTERNAL && offset == 0)
+      Interrupt(DOWNLOAD_INTERRUPT_REASON_SERVER_NO_RANGE);
+    return;
+  }
+
+  if (is_paused_)
+    request_handle->PauseRequest();
+  it->second.reset(request_handle.release());
+
+  BrowserThread::PostTask(
+      BrowserThread::FILE, FROM_HERE,
+      base::Bind(&DownloadFile::AddByteStream,
+                 // Safe because we control download file lifetime.
+                 base::Unretained(download_file_.get()),
+                 base::Passed(&stream), offset));
+}
+
 void DownloadItemImpl::OnDownloadFileInitialized(
     DownloadInterruptReason result) {
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
@@ -1150,6 +1243,15 @@ void DownloadItemImpl::OnDownloadFileInitialized(
     return;
   }
 
+  if (parallel_download_) {
+    BrowserThread::PostTask(
+        BrowserThread::FILE, FROM_HERE,
+        base::Bind(&DownloadFile::StartParallelDownload,
+                   // Safe because we control download file lifetime.
+                   base::Unretained(download_file_.get()),
+                   total_bytes_));
+  }
+
   delegate_->DetermineDownloadTarget(
       this, base::Bind(&DownloadItemImpl::OnDownloadTargetDetermined,
                        weak_ptr_factory_.GetWeakPtr()));
@@ -1419,6 +1521,43 @@ void DownloadItemImpl::OnResumeRequestStarted(
   Interrupt(interrupt_reason);
 }
 
+void DownloadItemImpl::OnSliceRequestStarted(
+    int64 offset,
+    DownloadItem* item,
+    DownloadInterruptReason interrupt_reason) {
+  // If |item| is not NULL, then AddSliceStream() has been called already.
+  if (item)
+    return;
+  // Otherwise the request failed without a response, and the download can't
+  // complete without its slice.
+  if (state_ == IN_PROGRESS_INTERNAL &&
+      slice_requests_.find(offset) != slice_requests_.end()) {
+    Interrupt(interrupt_reason);
+  }
+}
+
+bool DownloadItemImpl::ShouldDownloadInParallel() const {
+  const CommandLine& command_line = *CommandLine::ForCurrentProcess();
+  if (!command_line.HasSwitch(switches::kEnableParallelDownloading))
+    return false;
+
+  // Only fresh downloads of a known size are split, and only when the server
+  // supports range requests and sends validators to make sure every slice
+  // comes from the same file.
+  return received_bytes_ == 0 && total_bytes_ > 0 &&
+      accept_ranges_ == "bytes" &&
+      (!etag_.empty() || !last_modified_time_.empty());
+}
+
+void DownloadItemImpl::CancelSliceRequests() {
+  for (SliceRequestMap::iterator it = slice_requests_.begin();
+       it != slice_requests_.end(); ++it) {
+    if (it->second)
+      it->second->CancelRequest();
+  }
+  slice_requests_.clear();
+}
+
 // **** End of Download progression cascade
 
 // An error occurred somewhere.
@@ -1452,6 +1591,7 @@ void DownloadItemImpl::Interrupt(DownloadInterruptReason reason) {
 
     // Cancel the originating URL request.
     request_handle_->CancelRequest();
+    CancelSliceRequests();
   } else {
     DCHECK(!download_file_.get());
   }
@@ -1678,9 +1818,10 @@ void DownloadItemImpl::ResumeInterruptedDownload() {
     return;
 
   // Reset the appropriate state if restarting.
+  // A download fetched in parallel has holes in its file, so it restarts.
   ResumeMode mode = GetResumeMode();
   if (mode == RESUME_MODE_IMMEDIATE_RESTART ||
-      mode == RESUME_MODE_USER_RESTART) {
+      mode == RESUME_MODE_USER_RESTART || parallel_download_) {
     received_bytes_ = 0;
     hash_state_ = "";
     last_modified_time_ = "";
@@ -5,11 +5,13 @@
 #ifndef CONTENT_BROWSER_DOWNLOAD_DOWNLOAD_ITEM_IMPL_H_
 #define CONTENT_BROWSER_DOWNLOAD_DOWNLOAD_ITEM_IMPL_H_
 
+#include <map>
 #include <string>
 
 #include "base/basictypes.h"
 #include "base/callback_forward.h"
 #include "base/files/file_path.h"
+#include "base/memory/linked_ptr.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
@@ -25,6 +27,7 @@
 #include "url/gurl.h"
 
 namespace content {
+class ByteStreamReader;
 class DownloadFile;
 class DownloadItemImplDelegate;
 
@@ -176,6 +179,11 @@ class CONTENT_EXPORT DownloadItemImpl
   virtual void Start(scoped_ptr<DownloadFile> download_file,
                      scoped_ptr<DownloadRequestHandleInterface> req_handle);
 
+  // Called when one of the requests started for DestinationRequestsSlice()
+  // has a response; |info| describes the response and |stream| its data.
+  virtual void AddSliceStream(const DownloadCreateInfo& info,
+                              scoped_ptr<ByteStreamReader> stream);
+
   // Needed because of intertwining with DownloadManagerImpl -------------------
 
   // TODO(rdsmith): Unwind DownloadManagerImpl and DownloadItemImpl,
@@ -211,6 +219,8 @@ class CONTENT_EXPORT DownloadItemImpl
                                  const std::string& hash_state) OVERRIDE;
   virtual void DestinationError(DownloadInterruptReason reason) OVERRIDE;
   virtual void DestinationCompleted(const std::string& final_hash) OVERRIDE;
+  virtual void DestinationRequestsSlice(int64 offset, int64 length) OVERRIDE;
+  virtual void DestinationSliceCompleted(int64 offset) OVERRIDE;
 
  private:
   // Fine grained states of a download. Note that active downloads are created
@@ -337,12 +347,29 @@ class CONTENT_EXPORT DownloadItemImpl
 
   // Called when the entire download operation (including renaming etc)
   // is completed.
+  // The requests that fetch the slices of a download fetched in parallel, by
+  // the offset of their slice. A request is NULL until it has a response.
+  typedef std::map<int64, linked_ptr<DownloadRequestHandleInterface> >
+      SliceRequestMap;
+
   void Completed();
 
   // Callback invoked when the URLRequest for a download resumption has started.
   void OnResumeRequestStarted(DownloadItem* item,
                               DownloadInterruptReason interrupt_reason);
 
+  // Callback invoked when the URLRequest for the slice at |offset| of a
+  // download fetched in parallel has started.
+  void OnSliceRequestStarted(int64 offset,
+                             DownloadItem* item,
+                             DownloadInterruptReason interrupt_reason);
+
+  // Whether the download should be split across several range requests.
+  bool ShouldDownloadInParallel() const;
+
+  // Cancels the requests started for DestinationRequestsSlice().
+  void CancelSliceRequests();
+
   // Helper routines -----------------------------------------------------------
 
   // Indicate that an error has occurred on the download.
@@ -391,6 +418,9 @@ class CONTENT_EXPORT DownloadItemImpl
   // download system.
   scoped_ptr<DownloadRequestHandleInterface> request_handle_;
 
+  // The other requests of a download fetched in parallel.
+  SliceRequestMap slice_requests_;
+
   uint32 download_id_;
 
   // Display name for the download. If this is empty, then the display name is
@@ -472,6 +502,9 @@ class CONTENT_EXPORT DownloadItemImpl
   // Server's ETAG for the file.
   std::string etag_;
 
+  // Server's Accept-Ranges header for the file.
+  std::string accept_ranges_;
+
   // Last reason.
   DownloadInterruptReason last_reason_;
 
@@ -499,6 +532,11 @@ class CONTENT_EXPORT DownloadItemImpl
   // In progress downloads may be paused by the user, we note it here.
   bool is_paused_;
 
+  // Whether the download is fetched with several range requests at once.
+  // Its file has holes until it is complete, so it can't be continued from
+  // where it was interrupted.
+  bool parallel_download_;
+
   // The number of times this download has been resumed automatically.
   int auto_resume_count_;
 
@@ -71,6 +71,12 @@ class CONTENT_EXPORT DownloadItemImplDelegate {
       scoped_ptr<content::DownloadUrlParameters> params,
       uint32 id);
 
+  // Called to fetch a slice of a download that is fetched with several
+  // requests at once. The response is passed to the item's AddSliceStream().
+  virtual void StartSliceRequest(
+      scoped_ptr<content::DownloadUrlParameters> params,
+      uint32 id);
+
   // For contextual issues like language and prefs.
   virtual BrowserContext* GetBrowserContext() const;
 
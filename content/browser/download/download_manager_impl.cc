@@ -89,10 +89,15 @@ void BeginDownload(scoped_ptr<DownloadUrlParameters> params,
   DCHECK(params->offset() == 0 || has_etag || has_last_modified);
 
   if (params->offset() > 0) {
-    request->SetExtraRequestHeaderByName(
-        "Range",
-        base::StringPrintf("bytes=%" PRId64 "-", params->offset()),
-        true);
+    std::string range;
+    if (params->length() > 0) {
+      range = base::StringPrintf("bytes=%" PRId64 "-%" PRId64,
+                                 params->offset(),
+                                 params->offset() + params->length() - 1);
+    } else {
+      range = base::StringPrintf("bytes=%" PRId64 "-", params->offset());
+    }
+    request->SetExtraRequestHeaderByName("Range", range, true);
 
     if (has_last_modified) {
       request->SetExtraRequestHeaderByName("If-Unmodified-Since",
@@ -116,6 +121,7 @@ void BeginDownload(scoped_ptr<DownloadUrlParameters> params,
   save_info->file_path = params->file_path();
   save_info->suggested_name = params->suggested_name();
   save_info->offset = params->offset();
+  save_info->length = params->length();
   save_info->hash_state = params->hash_state();
   save_info->prompt_for_save_location = params->prompt();
   save_info->file_stream = params->GetFileStream();
@@ -397,6 +403,13 @@ void DownloadManagerImpl::StartDownloadWithId(
       return;
     }
     download = item_iterator->second;
+    if (info->save_info->length > 0) {
+      // One of the requests of a download fetched in parallel.
+      download->AddSliceStream(*info, stream.Pass());
+      if (!on_started.is_null())
+        on_started.Run(download, DOWNLOAD_INTERRUPT_REASON_NONE);
+      return;
+    }
     DCHECK_EQ(DownloadItem::INTERRUPTED, download->GetState());
     download->MergeOriginInfoOnResume(*info);
   }
@@ -527,6 +540,15 @@ void DownloadManagerImpl::OnSavePackageSuccessfullyFinished(
 // Resume a download of a specific URL. We send the request to the
 // ResourceDispatcherHost, and let it send us responses like a regular
 // download.
+void DownloadManagerImpl::StartSliceRequest(
+    scoped_ptr<content::DownloadUrlParameters> params,
+    uint32 id) {
+  BrowserThread::PostTask(
+      BrowserThread::IO,
+      FROM_HERE,
+      base::Bind(&BeginDownload, base::Passed(&params), id));
+}
+
 void DownloadManagerImpl::ResumeInterruptedDownload(
     scoped_ptr<content::DownloadUrlParameters> params,
     uint32 id) {
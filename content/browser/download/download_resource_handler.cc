@@ -177,6 +177,8 @@ bool DownloadResourceHandler::OnResponseStarted(
       if (!headers->EnumerateHeader(NULL, "ETag", &info->etag))
         info->etag.clear();
     }
+    if (!headers->EnumerateHeader(NULL, "Accept-Ranges", &info->accept_ranges))
+      info->accept_ranges.clear();
 
     int status = headers->response_code();
     if (2 == status / 100  && status != net::HTTP_PARTIAL_CONTENT) {
@@ -391,8 +393,11 @@ void DownloadResourceHandler::OnResponseCompleted(
 
   // Send the info down the stream.  Conditional is in case we get
   // OnResponseCompleted without OnResponseStarted.
-  if (stream_writer_)
+  if (stream_writer_) {
+    RecordByteStreamStats(stream_writer_->GetStallCount(),
+                          stream_writer_->GetBufferSize());
     stream_writer_->Close(reason);
+  }
 
   // If the error mapped to something unknown, record it so that
   // we can drill down.
@@ -591,6 +591,12 @@ void RecordNetworkBlockage(base::TimeDelta resource_handler_lifetime,
                            percentage);
 }
 
+void RecordByteStreamStats(int stall_count, size_t buffer_size) {
+  UMA_HISTOGRAM_COUNTS_10000("Download.ByteStreamStallCount", stall_count);
+  UMA_HISTOGRAM_CUSTOM_COUNTS("Download.ByteStreamBufferSize",
+                              buffer_size / 1024, 1, 10 * 1024, 50);
+}
+
 void RecordFileBandwidth(size_t length,
                          base::TimeDelta disk_write_time,
                          base::TimeDelta elapsed_time) {
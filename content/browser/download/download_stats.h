@@ -195,6 +195,10 @@ void RecordContiguousWriteTime(base::TimeDelta time_blocked);
 void RecordNetworkBlockage(base::TimeDelta resource_handler_lifetime,
                            base::TimeDelta resource_handler_blocked_time);
 
+// Record how often the resource handler found the byte stream to the file
+// full, and how large the stream had grown by the end of the download.
+void RecordByteStreamStats(int stall_count, size_t buffer_size);
+
 // Record overall bandwidth stats at the file end.
 void RecordFileBandwidth(size_t length,
                          base::TimeDelta disk_write_time,
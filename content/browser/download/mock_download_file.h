@@ -35,6 +35,14 @@ class MockDownloadFile : virtual public DownloadFile {
   MOCK_METHOD2(RenameAndAnnotate,
                void(const base::FilePath& full_path,
                     const RenameCompletionCallback& callback));
+  MOCK_METHOD1(StartParallelDownload, void(int64 total_bytes));
+  // Gmock can't take a scoped_ptr<> argument, so AddByteStream() is mocked
+  // through AddByteStreamPtr().
+  virtual void AddByteStream(scoped_ptr<ByteStreamReader> stream,
+                             int64 offset) OVERRIDE {
+    AddByteStreamPtr(stream.get(), offset);
+  }
+  MOCK_METHOD2(AddByteStreamPtr, void(ByteStreamReader* stream, int64 offset));
   MOCK_METHOD0(Detach, void());
   MOCK_METHOD0(Cancel, void());
   MOCK_METHOD0(Finish, void());
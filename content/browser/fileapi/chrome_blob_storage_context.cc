@@ -41,6 +41,8 @@ ChromeBlobStorageContext* ChromeBlobStorageContext::GetFor(
 void ChromeBlobStorageContext::InitializeOnIOThread() {
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
   context_.reset(new BlobStorageContext());
+  context_->EnablePaging(
+      BrowserThread::GetMessageLoopProxyForThread(BrowserThread::FILE).get());
 }
 
 ChromeBlobStorageContext::~ChromeBlobStorageContext() {}
@@ -76,9 +76,11 @@ void BrowserGpuChannelHostFactory::EstablishRequest::EstablishOnIO() {
     reused_gpu_process_ = true;
   }
 
+  // The browser compositor's channel preempts those of the renderers.
   host->EstablishGpuChannel(
       gpu_client_id_,
       true,
+      true,
       base::Bind(
           &BrowserGpuChannelHostFactory::EstablishRequest::OnEstablishedOnIO,
           this));
@@ -680,6 +680,7 @@ void GpuProcessHost::OnChannelConnected(int32 peer_pid) {
 void GpuProcessHost::EstablishGpuChannel(
     int client_id,
     bool share_context,
+    bool preempts,
     const EstablishChannelCallback& callback) {
   DCHECK(CalledOnValidThread());
   TRACE_EVENT0("gpu", "GpuProcessHost::EstablishGpuChannel");
@@ -690,7 +691,8 @@ void GpuProcessHost::EstablishGpuChannel(
     return;
   }
 
-  if (Send(new GpuMsg_EstablishChannel(client_id, share_context))) {
+  if (Send(new GpuMsg_EstablishChannel(client_id, share_context,
+                                         preempts))) {
     channel_requests_.push(callback);
   } else {
     callback.Run(IPC::ChannelHandle(), gpu::GPUInfo());
@@ -1086,6 +1088,7 @@ bool GpuProcessHost::LaunchGpuProcess(const std::string& channel_id) {
     switches::kDisableGpuWatchdog,
     switches::kDisableLogging,
     switches::kDisableSeccompFilterSandbox,
+    switches::kDisableShareGroupAsyncTextureUpload,
 #if defined(ENABLE_WEBRTC)
     switches::kDisableWebRtcHWEncoding,
 #endif
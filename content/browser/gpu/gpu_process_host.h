@@ -100,9 +100,11 @@ class GpuProcessHost : public BrowserChildProcessHostDelegate,
 
   // Tells the GPU process to create a new channel for communication with a
   // client. Once the GPU process responds asynchronously with the IPC handle
-  // and GPUInfo, we call the callback.
+  // and GPUInfo, we call the callback. The command buffers of a channel which
+  // |preempts| are given priority over those of all the other channels.
   void EstablishGpuChannel(int client_id,
                            bool share_context,
+                           bool preempts,
                            const EstablishChannelCallback& callback);
 
   // Tells the GPU process to create a new command buffer that draws into the
@@ -6,7 +6,9 @@
 
 #include "base/command_line.h"
 #include "base/metrics/histogram.h"
+#include "base/metrics/shared_histogram_allocator.h"
 #include "base/metrics/statistics_recorder.h"
+#include "base/process/process_handle.h"
 #include "content/browser/histogram_controller.h"
 #include "content/browser/tcmalloc_internals_request_job.h"
 #include "content/common/child_process_messages.h"
@@ -14,8 +16,39 @@
 
 namespace content {
 
+namespace {
+
+// The size of the shared memory segment each child keeps its histograms in.
+const size_t kHistogramMemorySize = 512 * 1024;
+
+}  // namespace
+
 HistogramMessageFilter::HistogramMessageFilter() {}
 
+void HistogramMessageFilter::OnChannelConnected(int32 peer_pid) {
+  // In single process mode the histograms are already the browser's.
+  if (peer_pid == base::GetCurrentProcId())
+    return;
+
+  scoped_ptr<base::SharedHistogramAllocator> allocator =
+      base::SharedHistogramAllocator::Create(kHistogramMemorySize);
+  base::SharedMemoryHandle handle;
+  if (!allocator ||
+      !allocator->shared_memory()->ShareToProcess(PeerHandle(), &handle)) {
+    return;
+  }
+  if (Send(new ChildProcessMsg_SetHistogramMemory(handle,
+                                                  kHistogramMemorySize))) {
+    histogram_allocator_ = allocator.Pass();
+  }
+}
+
+void HistogramMessageFilter::OnChannelClosing() {
+  // Pick up what the child recorded since the last synchronization, even if
+  // it crashed.
+  MergeSharedHistograms();
+}
+
 bool HistogramMessageFilter::OnMessageReceived(const IPC::Message& message,
                                               bool* message_was_ok) {
   bool handled = true;
@@ -34,10 +67,19 @@ HistogramMessageFilter::~HistogramMessageFilter() {}
 void HistogramMessageFilter::OnChildHistogramData(
     int sequence_number,
     const std::vector<std::string>& pickled_histograms) {
+  // The histograms in shared memory are merged before the synchronizer is
+  // told that the data of this process has arrived.
+  MergeSharedHistograms();
   HistogramController::GetInstance()->OnHistogramDataCollected(
       sequence_number, pickled_histograms);
 }
 
+void HistogramMessageFilter::MergeSharedHistograms() {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  if (histogram_allocator_)
+    histogram_allocator_->MergeChangedSamples();
+}
+
 void HistogramMessageFilter::OnGetBrowserHistogram(
     const std::string& name,
     std::string* histogram_json) {
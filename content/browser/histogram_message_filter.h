@@ -8,9 +8,14 @@
 #include <string>
 #include <vector>
 
+#include "base/memory/scoped_ptr.h"
 #include "content/public/browser/browser_message_filter.h"
 #include "content/public/common/process_type.h"
 
+namespace base {
+class SharedHistogramAllocator;
+}
+
 namespace content {
 
 // This class sends and receives histogram messages in the browser process.
@@ -19,18 +24,28 @@ class HistogramMessageFilter : public BrowserMessageFilter {
   HistogramMessageFilter();
 
   // BrowserMessageFilter implementation.
+  virtual void OnChannelConnected(int32 peer_pid) OVERRIDE;
+  virtual void OnChannelClosing() OVERRIDE;
   virtual bool OnMessageReceived(const IPC::Message& message,
                                  bool* message_was_ok) OVERRIDE;
 
  private:
   virtual ~HistogramMessageFilter();
 
+  // Adds the samples the child recorded in |histogram_allocator_| since the
+  // last call to the histograms of the browser.
+  void MergeSharedHistograms();
+
   // Message handlers.
   void OnChildHistogramData(int sequence_number,
                             const std::vector<std::string>& pickled_histograms);
   void OnGetBrowserHistogram(const std::string& name,
                              std::string* histogram_json);
 
+  // The shared memory segment the child keeps its histograms in, or NULL if
+  // it could not be created or shared.
+  scoped_ptr<base::SharedHistogramAllocator> histogram_allocator_;
+
   DISALLOW_COPY_AND_ASSIGN(HistogramMessageFilter);
 };
 
@@ -7,6 +7,7 @@
 #include "base/file_util.h"
 #include "base/logging.h"
 #include "base/metrics/histogram.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
@@ -41,6 +42,12 @@ static base::FilePath ComputeFileName(const GURL& origin_url) {
       .AddExtension(FILE_PATH_LITERAL(".indexeddb.leveldb"));
 }
 
+static base::FilePath ComputeBlobPath(const GURL& origin_url) {
+  return base::FilePath()
+      .AppendASCII(webkit_database::GetIdentifierFromOrigin(origin_url))
+      .AddExtension(FILE_PATH_LITERAL(".indexeddb.blob"));
+}
+
 }  // namespace
 
 static const int64 kKeyGeneratorInitialNumber =
@@ -223,7 +230,8 @@ class Comparator : public LevelDBComparator {
 // 0 - Initial version.
 // 1 - Adds UserIntVersion to DatabaseMetaData.
 // 2 - Adds DataVersion to to global metadata.
-static const int64 kLatestKnownSchemaVersion = 2;
+// 3 - Adds ExternalValueKey entries for values stored in files.
+static const int64 kLatestKnownSchemaVersion = 3;
 WARN_UNUSED_RESULT static bool IsSchemaKnown(LevelDBDatabase* db, bool* known) {
   int64 db_schema_version = 0;
   bool found = false;
@@ -323,6 +331,12 @@ WARN_UNUSED_RESULT static bool SetUpMetadata(
       db_data_version = blink::kSerializedScriptValueVersion;
       PutInt(transaction.get(), data_version_key, db_data_version);
     }
+    if (db_schema_version < 3) {
+      // Existing values stay inline; the bump only keeps older versions,
+      // which cannot compare external value keys, from opening the store.
+      db_schema_version = 3;
+      PutInt(transaction.get(), schema_version_key, db_schema_version);
+    }
   }
 
   // All new values will be written using this serialization version.
@@ -543,6 +557,8 @@ scoped_refptr<IndexedDBBackingStore> IndexedDBBackingStore::Open(
 
   const base::FilePath file_path =
       path_base.Append(ComputeFileName(origin_url));
+  const base::FilePath blob_path =
+      path_base.Append(ComputeBlobPath(origin_url));
 
   if (IsPathTooLong(file_path)) {
     HistogramOpenStatus(INDEXED_DB_BACKING_STORE_OPEN_ORIGIN_TOO_LONG,
@@ -607,6 +623,8 @@ scoped_refptr<IndexedDBBackingStore> IndexedDBBackingStore::Open(
                           origin_url);
       return scoped_refptr<IndexedDBBackingStore>();
     }
+    // The external values belonged to the records that were just destroyed.
+    base::DeleteFile(blob_path, true);
 
     LOG(ERROR) << "IndexedDB backing store cleanup succeeded, reopening";
     leveldb_factory->OpenLevelDB(file_path, comparator.get(), &db, NULL);
@@ -627,7 +645,7 @@ scoped_refptr<IndexedDBBackingStore> IndexedDBBackingStore::Open(
     return scoped_refptr<IndexedDBBackingStore>();
   }
 
-  return Create(origin_url, db.Pass(), comparator.Pass());
+  return Create(origin_url, blob_path, db.Pass(), comparator.Pass());
 }
 
 // static
@@ -654,18 +672,20 @@ scoped_refptr<IndexedDBBackingStore> IndexedDBBackingStore::OpenInMemory(
   }
   HistogramOpenStatus(INDEXED_DB_BACKING_STORE_OPEN_MEMORY_SUCCESS, origin_url);
 
-  return Create(origin_url, db.Pass(), comparator.Pass());
+  return Create(origin_url, base::FilePath(), db.Pass(), comparator.Pass());
 }
 
 // static
 scoped_refptr<IndexedDBBackingStore> IndexedDBBackingStore::Create(
     const GURL& origin_url,
+    const base::FilePath& blob_path,
     scoped_ptr<LevelDBDatabase> db,
     scoped_ptr<LevelDBComparator> comparator) {
   // TODO(jsbell): Handle comparator name changes.
 
   scoped_refptr<IndexedDBBackingStore> backing_store(
       new IndexedDBBackingStore(origin_url, db.Pass(), comparator.Pass()));
+  backing_store->blob_path_ = blob_path;
   if (!SetUpMetadata(backing_store->db_.get(),
                      backing_store->origin_identifier_))
     return scoped_refptr<IndexedDBBackingStore>();
@@ -822,6 +842,115 @@ bool IndexedDBBackingStore::UpdateIDBDatabaseIntVersion(
   return true;
 }
 
+// Values at least this large are stored in their own files rather than in
+// LevelDB, where every compaction would copy them again.
+static const size_t kMinExternalValueBytes = 64 * 1024;
+
+// External values are stored as <blob path>/<database id>/<object store
+// id>/<version>. Versions are never reused within an object store, so a
+// rewritten record never overwrites a file that a committed record uses.
+static base::FilePath ExternalValueDirectory(const base::FilePath& blob_path,
+                                             int64 database_id,
+                                             int64 object_store_id) {
+  return blob_path.AppendASCII(base::Int64ToString(database_id))
+      .AppendASCII(base::Int64ToString(object_store_id));
+}
+
+static base::FilePath ExternalValuePath(const base::FilePath& blob_path,
+                                        int64 database_id,
+                                        int64 object_store_id,
+                                        int64 version) {
+  return ExternalValueDirectory(blob_path, database_id, object_store_id)
+      .AppendASCII(base::Int64ToString(version));
+}
+
+// If the record with |encoded_primary_key| has an external value entry,
+// replaces |*value| with the contents of its file.
+WARN_UNUSED_RESULT static leveldb::Status ReadExternalValue(
+    LevelDBTransaction* transaction,
+    const base::FilePath& blob_path,
+    int64 database_id,
+    int64 object_store_id,
+    const std::string& encoded_primary_key,
+    std::string* value) {
+  if (blob_path.empty())
+    return leveldb::Status::OK();
+
+  int64 version = 0;
+  bool found = false;
+  leveldb::Status s = GetVarInt(
+      transaction,
+      ExternalValueKey::Encode(
+          database_id, object_store_id, encoded_primary_key),
+      &version,
+      &found);
+  if (!s.ok() || !found)
+    return s;
+
+  if (!base::ReadFileToString(
+          ExternalValuePath(blob_path, database_id, object_store_id, version),
+          value))
+    return leveldb::Status::IOError("Unable to read external value");
+  return s;
+}
+
+static void DeleteExternalFiles(const std::vector<base::FilePath>& files) {
+  for (size_t i = 0; i < files.size(); ++i)
+    base::DeleteFile(files[i], true);
+}
+
+leveldb::Status IndexedDBBackingStore::WriteExternalValue(
+    Transaction* transaction,
+    int64 database_id,
+    int64 object_store_id,
+    const std::string& encoded_key,
+    int64 version,
+    const std::string& value) {
+  DCHECK(!blob_path_.empty());
+  const base::FilePath path =
+      ExternalValuePath(blob_path_, database_id, object_store_id, version);
+  const int size = static_cast<int>(value.size());
+  if (!base::CreateDirectory(path.DirName()) ||
+      file_util::WriteFile(path, value.data(), size) != size) {
+    LOG(ERROR) << "Unable to write IndexedDB external value "
+               << path.AsUTF8Unsafe();
+    base::DeleteFile(path, false);
+    return leveldb::Status::IOError("Unable to write external value");
+  }
+  transaction->external_files_written_.push_back(path);
+
+  std::string version_encoded;
+  EncodeVarInt(version, &version_encoded);
+  transaction->transaction()->Put(
+      ExternalValueKey::Encode(database_id, object_store_id, encoded_key),
+      &version_encoded);
+  return leveldb::Status::OK();
+}
+
+leveldb::Status IndexedDBBackingStore::RemoveExternalValue(
+    Transaction* transaction,
+    int64 database_id,
+    int64 object_store_id,
+    const std::string& encoded_key) {
+  if (blob_path_.empty())
+    return leveldb::Status::OK();
+
+  LevelDBTransaction* leveldb_transaction = transaction->transaction();
+  const std::string external_value_key =
+      ExternalValueKey::Encode(database_id, object_store_id, encoded_key);
+  int64 version = 0;
+  bool found = false;
+  leveldb::Status s =
+      GetVarInt(leveldb_transaction, external_value_key, &version, &found);
+  if (!s.ok() || !found)
+    return s;
+
+  transaction->external_files_to_delete_.push_back(
+      ExternalValuePath(blob_path_, database_id, object_store_id, version));
+  leveldb_transaction->Remove(external_value_key);
+  return s;
+}
+
 static void DeleteRange(LevelDBTransaction* transaction,
                         const std::string& begin,
                         const std::string& end) {
@@ -863,6 +992,10 @@ leveldb::Status IndexedDBBackingStore::DeleteDatabase(
     INTERNAL_WRITE_ERROR(DELETE_DATABASE);
     return s;
   }
+  if (!blob_path_.empty()) {
+    base::DeleteFile(
+        blob_path_.AppendASCII(base::Int64ToString(metadata.id)), true);
+  }
   db_->Compact(start_key, stop_key);
   return s;
 }
@@ -1162,7 +1295,12 @@ leveldb::Status IndexedDBBackingStore::DeleteObjectStore(
               IndexMetaDataKey::Encode(database_id, object_store_id, 0, 0),
               IndexMetaDataKey::EncodeMaxKey(database_id, object_store_id));
 
-  return ClearObjectStore(transaction, database_id, object_store_id);
+  s = ClearObjectStore(transaction, database_id, object_store_id);
+  if (s.ok() && !blob_path_.empty()) {
+    transaction->external_files_to_delete_.push_back(
+        ExternalValueDirectory(blob_path_, database_id, object_store_id));
+  }
+  return s;
 }
 
 leveldb::Status IndexedDBBackingStore::GetRecord(
@@ -1203,6 +1341,18 @@ leveldb::Status IndexedDBBackingStore::GetRecord(
   }
 
   *record = slice.as_string();
+  if (record->empty()) {
+    std::string encoded_key;
+    EncodeIDBKey(key, &encoded_key);
+    s = ReadExternalValue(leveldb_transaction,
+                          blob_path_,
+                          database_id,
+                          object_store_id,
+                          encoded_key,
+                          record);
+    if (!s.ok())
+      INTERNAL_READ_ERROR(GET_RECORD);
+  }
   return s;
 }
 
@@ -1259,10 +1409,26 @@ leveldb::Status IndexedDBBackingStore::PutRecord(
   DCHECK_GE(version, 0);
   const std::string object_storedata_key =
       ObjectStoreDataKey::Encode(database_id, object_store_id, key);
+  std::string key_encoded;
+  EncodeIDBKey(key, &key_encoded);
+
+  s = RemoveExternalValue(
+      transaction, database_id, object_store_id, key_encoded);
+  if (!s.ok())
+    return s;
 
   std::string v;
   EncodeVarInt(version, &v);
-  v.append(value);
+  if (!blob_path_.empty() && value.size() >= kMinExternalValueBytes) {
+    // Only the version stays in LevelDB; readers find the value through the
+    // external value entry.
+    s = WriteExternalValue(
+        transaction, database_id, object_store_id, key_encoded, version, value);
+    if (!s.ok())
+      return s;
+  } else {
+    v.append(value);
+  }
 
   leveldb_transaction->Put(object_storedata_key, &v);
 
@@ -1272,8 +1438,6 @@ leveldb::Status IndexedDBBackingStore::PutRecord(
   EncodeInt(version, &version_encoded);
   leveldb_transaction->Put(exists_entry_key, &version_encoded);
 
-  std::string key_encoded;
-  EncodeIDBKey(key, &key_encoded);
   record_identifier->Reset(key_encoded, version);
   return s;
 }
@@ -1289,8 +1453,25 @@ leveldb::Status IndexedDBBackingStore::ClearObjectStore(
       KeyPrefix(database_id, object_store_id).Encode();
   const std::string stop_key =
       KeyPrefix(database_id, object_store_id + 1).Encode();
+  LevelDBTransaction* leveldb_transaction = transaction->transaction();
+
+  if (!blob_path_.empty()) {
+    const std::string external_stop_key =
+        ExternalValueKey::EncodeMaxKey(database_id, object_store_id);
+    scoped_ptr<LevelDBIterator> it = leveldb_transaction->CreateIterator();
+    for (it->Seek(ExternalValueKey::EncodeMinKey(database_id, object_store_id));
+         it->IsValid() && CompareKeys(it->Key(), external_stop_key) < 0;
+         it->Next()) {
+      int64 version = 0;
+      StringPiece slice(it->Value());
+      if (!DecodeVarInt(&slice, &version))
+        return InternalInconsistencyStatus();
+      transaction->external_files_to_delete_.push_back(ExternalValuePath(
+          blob_path_, database_id, object_store_id, version));
+    }
+  }
 
-  DeleteRange(transaction->transaction(), start_key, stop_key);
+  DeleteRange(leveldb_transaction, start_key, stop_key);
   return leveldb::Status::OK();
 }
 
@@ -1311,7 +1492,10 @@ leveldb::Status IndexedDBBackingStore::DeleteRecord(
   const std::string exists_entry_key = ExistsEntryKey::Encode(
       database_id, object_store_id, record_identifier.primary_key());
   leveldb_transaction->Remove(exists_entry_key);
-  return leveldb::Status::OK();
+  return RemoveExternalValue(transaction,
+                             database_id,
+                             object_store_id,
+                             record_identifier.primary_key());
 }
 
 leveldb::Status IndexedDBBackingStore::GetKeyGeneratorCurrentNumber(
@@ -2163,6 +2347,18 @@ bool ObjectStoreCursorImpl::LoadCurrentRow() {
   record_identifier_.Reset(encoded_key, version);
 
   current_value_ = slice.as_string();
+  if (current_value_.empty()) {
+    leveldb::Status s = ReadExternalValue(transaction_,
+                                          cursor_options_.blob_path,
+                                          cursor_options_.database_id,
+                                          cursor_options_.object_store_id,
+                                          encoded_key,
+                                          &current_value_);
+    if (!s.ok()) {
+      INTERNAL_READ_ERROR(LOAD_CURRENT_ROW);
+      return false;
+    }
+  }
   return true;
 }
 
@@ -2378,6 +2574,20 @@ bool IndexCursorImpl::LoadCurrentRow() {
   }
 
   current_value_ = slice.as_string();
+  if (current_value_.empty()) {
+    std::string encoded_primary_key;
+    EncodeIDBKey(*primary_key_, &encoded_primary_key);
+    s = ReadExternalValue(transaction_,
+                          cursor_options_.blob_path,
+                          index_data_key.DatabaseId(),
+                          index_data_key.ObjectStoreId(),
+                          encoded_primary_key,
+                          &current_value_);
+    if (!s.ok()) {
+      INTERNAL_READ_ERROR(LOAD_CURRENT_ROW);
+      return false;
+    }
+  }
   return true;
 }
 
@@ -2534,6 +2744,7 @@ IndexedDBBackingStore::OpenObjectStoreCursor(
                                 direction,
                                 &cursor_options))
     return scoped_ptr<IndexedDBBackingStore::Cursor>();
+  cursor_options.blob_path = blob_path_;
   scoped_ptr<ObjectStoreCursorImpl> cursor(
       new ObjectStoreCursorImpl(leveldb_transaction, cursor_options));
   if (!cursor->FirstSeek())
@@ -2613,6 +2824,7 @@ IndexedDBBackingStore::OpenIndexCursor(
                           direction,
                           &cursor_options))
     return scoped_ptr<IndexedDBBackingStore::Cursor>();
+  cursor_options.blob_path = blob_path_;
   scoped_ptr<IndexCursorImpl> cursor(
       new IndexCursorImpl(leveldb_transaction, cursor_options));
   if (!cursor->FirstSeek())
@@ -2638,8 +2850,15 @@ leveldb::Status IndexedDBBackingStore::Transaction::Commit() {
   DCHECK(transaction_.get());
   leveldb::Status s = transaction_->Commit();
   transaction_ = NULL;
-  if (!s.ok())
+  if (!s.ok()) {
     INTERNAL_WRITE_ERROR(TRANSACTION_COMMIT_METHOD);
+    DeleteExternalFiles(external_files_written_);
+  } else {
+    // A crash before this point only leaks the replaced files.
+    DeleteExternalFiles(external_files_to_delete_);
+  }
+  external_files_written_.clear();
+  external_files_to_delete_.clear();
   return s;
 }
 
@@ -2648,6 +2867,9 @@ void IndexedDBBackingStore::Transaction::Rollback() {
   DCHECK(transaction_.get());
   transaction_->Rollback();
   transaction_ = NULL;
+  DeleteExternalFiles(external_files_written_);
+  external_files_written_.clear();
+  external_files_to_delete_.clear();
 }
 
 }  // namespace content
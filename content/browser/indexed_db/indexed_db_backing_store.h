@@ -220,6 +220,9 @@ class CONTENT_EXPORT IndexedDBBackingStore
       bool high_open;
       bool forward;
       bool unique;
+      // Directory of the backing store's external value files, or empty if
+      // all values are stored inline.
+      base::FilePath blob_path;
     };
 
     const IndexedDBKey& key() const { return *current_key_; }
@@ -300,8 +303,16 @@ class CONTENT_EXPORT IndexedDBBackingStore
     LevelDBTransaction* transaction() { return transaction_; }
 
    private:
+    friend class IndexedDBBackingStore;
+
     IndexedDBBackingStore* backing_store_;
     scoped_refptr<LevelDBTransaction> transaction_;
+
+    // External value files written by this transaction, which are removed if
+    // it does not commit, and files it replaced or deleted, which are removed
+    // once it has committed.
+    std::vector<base::FilePath> external_files_written_;
+    std::vector<base::FilePath> external_files_to_delete_;
   };
 
  protected:
@@ -314,9 +325,27 @@ class CONTENT_EXPORT IndexedDBBackingStore
  private:
   static scoped_refptr<IndexedDBBackingStore> Create(
       const GURL& origin_url,
+      const base::FilePath& blob_path,
       scoped_ptr<LevelDBDatabase> db,
       scoped_ptr<LevelDBComparator> comparator);
 
+  // Writes |value| to the external value file of the record with |version|
+  // and |encoded_key|, and records that file in |transaction|.
+  leveldb::Status WriteExternalValue(Transaction* transaction,
+                                     int64 database_id,
+                                     int64 object_store_id,
+                                     const std::string& encoded_key,
+                                     int64 version,
+                                     const std::string& value)
+      WARN_UNUSED_RESULT;
+  // Removes the external value entry of the record with |encoded_key|, if
+  // any, and schedules its file for deletion when |transaction| commits.
+  leveldb::Status RemoveExternalValue(Transaction* transaction,
+                                      int64 database_id,
+                                      int64 object_store_id,
+                                      const std::string& encoded_key)
+      WARN_UNUSED_RESULT;
+
   leveldb::Status FindKeyInIndex(
       IndexedDBBackingStore::Transaction* transaction,
       int64 database_id,
@@ -340,6 +369,10 @@ class CONTENT_EXPORT IndexedDBBackingStore
   // provides for future flexibility.
   const std::string origin_identifier_;
 
+  // Values of at least kMinExternalValueBytes are stored in files under this
+  // directory rather than in |db_|. Empty for in-memory backing stores.
+  base::FilePath blob_path_;
+
   scoped_ptr<LevelDBDatabase> db_;
   scoped_ptr<LevelDBComparator> comparator_;
   base::OneShotTimer<IndexedDBBackingStore> close_timer_;
@@ -4,6 +4,8 @@
 
 #include "content/browser/indexed_db/indexed_db_backing_store.h"
 
+#include "base/files/file_enumerator.h"
+#include "base/files/scoped_temp_dir.h"
 #include "base/logging.h"
 #include "base/strings/string16.h"
 #include "base/strings/utf_string_conversions.h"
@@ -318,6 +320,112 @@ TEST_F(IndexedDBBackingStoreTest, CreateDatabase) {
   }
 }
 
+static int CountFiles(const base::FilePath& path) {
+  int count = 0;
+  base::FileEnumerator enumerator(path, true, base::FileEnumerator::FILES);
+  for (base::FilePath file = enumerator.Next(); !file.empty();
+       file = enumerator.Next())
+    ++count;
+  return count;
+}
+
+TEST(IndexedDBBackingStoreOnDiskTest, ExternalValues) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const GURL origin("http://localhost:81");
+  const base::FilePath blob_path =
+      temp_dir.path().AppendASCII("http_localhost_81.indexeddb.blob");
+  blink::WebIDBDataLoss data_loss;
+  std::string data_loss_message;
+  bool disk_full = false;
+  scoped_refptr<IndexedDBBackingStore> backing_store =
+      IndexedDBBackingStore::Open(
+          origin, temp_dir.path(), &data_loss, &data_loss_message, &disk_full);
+  ASSERT_TRUE(backing_store);
+
+  const IndexedDBKey key(ASCIIToUTF16("key"));
+  const std::string large_value(256 * 1024, 'x');
+  const std::string small_value("small");
+
+  // A large value goes to a file, and is read back through both GetRecord and
+  // a cursor.
+  {
+    IndexedDBBackingStore::Transaction transaction(backing_store);
+    transaction.Begin();
+    IndexedDBBackingStore::RecordIdentifier record;
+    EXPECT_TRUE(backing_store->PutRecord(
+        &transaction, 1, 1, key, large_value, &record).ok());
+    EXPECT_TRUE(transaction.Commit().ok());
+  }
+  EXPECT_EQ(1, CountFiles(blob_path));
+  {
+    IndexedDBBackingStore::Transaction transaction(backing_store);
+    transaction.Begin();
+    std::string result;
+    EXPECT_TRUE(
+        backing_store->GetRecord(&transaction, 1, 1, key, &result).ok());
+    EXPECT_EQ(large_value, result);
+
+    scoped_ptr<IndexedDBBackingStore::Cursor> cursor =
+        backing_store->OpenObjectStoreCursor(
+            &transaction, 1, 1, IndexedDBKeyRange(), indexed_db::CURSOR_NEXT);
+    ASSERT_TRUE(cursor);
+    EXPECT_EQ(large_value, *cursor->value());
+    EXPECT_TRUE(transaction.Commit().ok());
+  }
+
+  // A rolled back write leaves the committed file alone and removes its own.
+  {
+    IndexedDBBackingStore::Transaction transaction(backing_store);
+    transaction.Begin();
+    IndexedDBBackingStore::RecordIdentifier record;
+    EXPECT_TRUE(backing_store->PutRecord(
+        &transaction, 1, 1, key, large_value, &record).ok());
+    EXPECT_EQ(2, CountFiles(blob_path));
+    transaction.Rollback();
+  }
+  EXPECT_EQ(1, CountFiles(blob_path));
+
+  // Replacing the value with a small one deletes the file on commit.
+  {
+    IndexedDBBackingStore::Transaction transaction(backing_store);
+    transaction.Begin();
+    IndexedDBBackingStore::RecordIdentifier record;
+    EXPECT_TRUE(backing_store->PutRecord(
+        &transaction, 1, 1, key, small_value, &record).ok());
+    EXPECT_EQ(1, CountFiles(blob_path));
+    EXPECT_TRUE(transaction.Commit().ok());
+  }
+  EXPECT_EQ(0, CountFiles(blob_path));
+  {
+    IndexedDBBackingStore::Transaction transaction(backing_store);
+    transaction.Begin();
+    std::string result;
+    EXPECT_TRUE(
+        backing_store->GetRecord(&transaction, 1, 1, key, &result).ok());
+    EXPECT_EQ(small_value, result);
+    EXPECT_TRUE(transaction.Commit().ok());
+  }
+
+  // Clearing the object store deletes its files.
+  {
+    IndexedDBBackingStore::Transaction transaction(backing_store);
+    transaction.Begin();
+    IndexedDBBackingStore::RecordIdentifier record;
+    EXPECT_TRUE(backing_store->PutRecord(
+        &transaction, 1, 1, key, large_value, &record).ok());
+    EXPECT_TRUE(transaction.Commit().ok());
+  }
+  EXPECT_EQ(1, CountFiles(blob_path));
+  {
+    IndexedDBBackingStore::Transaction transaction(backing_store);
+    transaction.Begin();
+    EXPECT_TRUE(backing_store->ClearObjectStore(&transaction, 1, 1).ok());
+    EXPECT_TRUE(transaction.Commit().ok());
+  }
+  EXPECT_EQ(0, CountFiles(blob_path));
+}
+
 }  // namespace
 
 }  // namespace content
@@ -48,6 +48,9 @@ static const base::FilePath::CharType kIndexedDBExtension[] =
 static const base::FilePath::CharType kLevelDBExtension[] =
     FILE_PATH_LITERAL(".leveldb");
 
+static const base::FilePath::CharType kBlobExtension[] =
+    FILE_PATH_LITERAL(".blob");
+
 namespace {
 
 // This may be called after the IndexedDBContext is destroyed.
@@ -93,6 +96,8 @@ void ClearSessionOnlyOrigins(
     if (special_storage_policy->IsStorageProtected(*iter))
       continue;
     base::DeleteFile(*file_path_iter, true);
+    base::DeleteFile(
+        file_path_iter->RemoveExtension().AddExtension(kBlobExtension), true);
   }
 }
 
@@ -322,6 +327,7 @@ void IndexedDBContextImpl::DeleteForOrigin(const GURL& origin_url) {
     // https://code.google.com/p/leveldb/issues/detail?id=209
     const bool kNonRecursive = false;
     base::DeleteFile(idb_directory, kNonRecursive);
+    base::DeleteFile(GetBlobPath(origin_url), true);
   }
 
   QueryDiskAndUpdateQuotaUsage(origin_url);
@@ -469,7 +475,14 @@ int64 IndexedDBContextImpl::ReadUsageFromDisk(const GURL& origin_url) const {
   if (data_path_.empty())
     return 0;
   base::FilePath file_path = GetFilePath(origin_url);
-  return base::ComputeDirectorySize(file_path);
+  return base::ComputeDirectorySize(file_path) +
+         base::ComputeDirectorySize(GetBlobPath(origin_url));
+}
+
+base::FilePath IndexedDBContextImpl::GetBlobPath(const GURL& origin_url) const {
+  std::string origin_id = webkit_database::GetIdentifierFromOrigin(origin_url);
+  return data_path_.AppendASCII(origin_id).AddExtension(kIndexedDBExtension)
+      .AddExtension(kBlobExtension);
 }
 
 void IndexedDBContextImpl::EnsureDiskUsageCacheInitialized(
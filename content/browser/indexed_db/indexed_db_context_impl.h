@@ -106,6 +106,7 @@ class CONTENT_EXPORT IndexedDBContextImpl
   class IndexedDBGetUsageAndQuotaCallback;
 
   base::FilePath GetIndexedDBFilePath(const std::string& origin_id) const;
+  base::FilePath GetBlobPath(const GURL& origin_url) const;
   int64 ReadUsageFromDisk(const GURL& origin_url) const;
   void EnsureDiskUsageCacheInitialized(const GURL& origin_url);
   void QueryDiskAndUpdateQuotaUsage(const GURL& origin_url);
@@ -133,6 +133,16 @@
 // <database id, object store id, 2, user key> => "version"
 //
 //
+// External value entry: [ExternalValueKey]
+// ----------------------------------------
+// The prefix is followed by a type byte and the encoded IDB primary key. The
+// entry exists only for records whose serialized script value was too large
+// to store inline; the object store data then holds just the "version" and
+// the value lives in a file named after it, see IndexedDBBackingStore.
+//
+// <database id, object store id, 3, user key> => "version" (var int)
+//
+//
 // Index data
 // ----------
 // The prefix is followed by a type byte, the encoded IDB index key, a
@@ -181,6 +191,7 @@ static const unsigned char kIndexedDBKeyPathTypeCodedByte2 = 0;
 
 static const unsigned char kObjectStoreDataIndexId = 1;
 static const unsigned char kExistsEntryIndexId = 2;
+static const unsigned char kExternalValueIndexId = 3;
 
 static const unsigned char kSchemaVersionTypeByte = 0;
 static const unsigned char kMaxDatabaseIdTypeByte = 1;
@@ -869,6 +880,16 @@ int CompareSuffix<ExistsEntryKey>(StringPiece* slice_a,
   return CompareEncodedIDBKeys(slice_a, slice_b, ok);
 }
 
+template <>
+int CompareSuffix<ExternalValueKey>(StringPiece* slice_a,
+                                    StringPiece* slice_b,
+                                    bool only_compare_index_keys,
+                                    bool* ok) {
+  DCHECK(!slice_a->empty());
+  DCHECK(!slice_b->empty());
+  return CompareEncodedIDBKeys(slice_a, slice_b, ok);
+}
+
 template <>
 int CompareSuffix<ObjectStoreDataKey>(StringPiece* slice_a,
                                       StringPiece* slice_b,
@@ -1038,6 +1059,15 @@ int Compare(const StringPiece& a,
           &slice_a, &slice_b, /*only_compare_index_keys*/ false, ok);
     }
 
+    case KeyPrefix::EXTERNAL_VALUE: {
+      // Provide a stable ordering for invalid data.
+      if (slice_a.empty() || slice_b.empty())
+        return CompareSizes(slice_a.size(), slice_b.size());
+
+      return CompareSuffix<ExternalValueKey>(
+          &slice_a, &slice_b, /*only_compare_index_keys*/ false, ok);
+    }
+
     case KeyPrefix::INDEX_DATA: {
       // Provide a stable ordering for invalid data.
       if (slice_a.empty() || slice_b.empty())
@@ -1239,6 +1269,8 @@ KeyPrefix::Type KeyPrefix::type() const {
     return OBJECT_STORE_DATA;
   if (index_id_ == kExistsEntryIndexId)
     return EXISTS_ENTRY;
+  if (index_id_ == kExternalValueIndexId)
+    return EXTERNAL_VALUE;
   if (index_id_ >= kMinimumIndexId)
     return INDEX_DATA;
 
@@ -1747,6 +1779,51 @@ scoped_ptr<IndexedDBKey> ExistsEntryKey::user_key() const {
 
 const int64 ExistsEntryKey::kSpecialIndexNumber = kExistsEntryIndexId;
 
+ExternalValueKey::ExternalValueKey() {}
+ExternalValueKey::~ExternalValueKey() {}
+
+bool ExternalValueKey::Decode(StringPiece* slice, ExternalValueKey* result) {
+  KeyPrefix prefix;
+  if (!KeyPrefix::Decode(slice, &prefix))
+    return false;
+  DCHECK(prefix.database_id_);
+  DCHECK(prefix.object_store_id_);
+  DCHECK_EQ(prefix.index_id_, kSpecialIndexNumber);
+  if (!ExtractEncodedIDBKey(slice, &result->encoded_user_key_))
+    return false;
+  return true;
+}
+
+std::string ExternalValueKey::Encode(int64 database_id,
+                                     int64 object_store_id,
+                                     const std::string& encoded_key) {
+  KeyPrefix prefix(KeyPrefix::CreateWithSpecialIndex(
+      database_id, object_store_id, kSpecialIndexNumber));
+  std::string ret = prefix.Encode();
+  ret.append(encoded_key);
+  return ret;
+}
+
+std::string ExternalValueKey::Encode(int64 database_id,
+                                     int64 object_store_id,
+                                     const IndexedDBKey& user_key) {
+  std::string encoded_key;
+  EncodeIDBKey(user_key, &encoded_key);
+  return Encode(database_id, object_store_id, encoded_key);
+}
+
+std::string ExternalValueKey::EncodeMinKey(int64 database_id,
+                                           int64 object_store_id) {
+  return Encode(database_id, object_store_id, MinIDBKey());
+}
+
+std::string ExternalValueKey::EncodeMaxKey(int64 database_id,
+                                           int64 object_store_id) {
+  return Encode(database_id, object_store_id, MaxIDBKey());
+}
+
+const int64 ExternalValueKey::kSpecialIndexNumber = kExternalValueIndexId;
+
 IndexDataKey::IndexDataKey()
     : database_id_(-1),
       object_store_id_(-1),
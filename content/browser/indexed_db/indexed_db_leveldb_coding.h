@@ -97,6 +97,7 @@ class KeyPrefix {
     DATABASE_METADATA,
     OBJECT_STORE_DATA,
     EXISTS_ENTRY,
+    EXTERNAL_VALUE,
     INDEX_DATA,
     INVALID_TYPE
   };
@@ -384,6 +385,29 @@ class ExistsEntryKey {
   DISALLOW_COPY_AND_ASSIGN(ExistsEntryKey);
 };
 
+class ExternalValueKey {
+ public:
+  ExternalValueKey();
+  ~ExternalValueKey();
+
+  static bool Decode(base::StringPiece* slice, ExternalValueKey* result);
+  CONTENT_EXPORT static std::string Encode(int64 database_id,
+                                           int64 object_store_id,
+                                           const std::string& encoded_key);
+  static std::string Encode(int64 database_id,
+                            int64 object_store_id,
+                            const IndexedDBKey& user_key);
+  static std::string EncodeMinKey(int64 database_id, int64 object_store_id);
+  static std::string EncodeMaxKey(int64 database_id, int64 object_store_id);
+  const std::string& encoded_user_key() const { return encoded_user_key_; }
+
+  static const int64 kSpecialIndexNumber;
+
+ private:
+  std::string encoded_user_key_;
+  DISALLOW_COPY_AND_ASSIGN(ExternalValueKey);
+};
+
 class IndexDataKey {
  public:
   IndexDataKey();
@@ -0,0 +1,100 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// This measures bulk inserts through a LevelDBTransaction, which buffers all
+// of its writes and commits them in one batch, and iteration over the result.
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "content/browser/indexed_db/leveldb/leveldb_comparator.h"
+#include "content/browser/indexed_db/leveldb/leveldb_database.h"
+#include "content/browser/indexed_db/leveldb/leveldb_iterator.h"
+#include "content/browser/indexed_db/leveldb/leveldb_transaction.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace content {
+
+namespace {
+
+const int kNumRecords = 10000;
+
+class SimpleComparator : public LevelDBComparator {
+ public:
+  virtual int Compare(const base::StringPiece& a,
+                      const base::StringPiece& b) const OVERRIDE {
+    size_t len = std::min(a.size(), b.size());
+    int result = memcmp(a.begin(), b.begin(), len);
+    if (result)
+      return result;
+    return a.size() < b.size() ? -1 : (a.size() > b.size() ? 1 : 0);
+  }
+  virtual const char* Name() const OVERRIDE { return "perf_comparator"; }
+};
+
+// Puts |kNumRecords| values of |value_size| bytes in one transaction, commits
+// it, then reads everything back with an iterator.
+void RunBulkBenchmark(LevelDBDatabase* db, size_t value_size) {
+  const std::string value(value_size, 'x');
+  const std::string trace = base::StringPrintf("%ubytes",
+      static_cast<unsigned>(value_size));
+
+  // Insert in reverse order so that the transaction's buffer does not only
+  // see appends.
+  scoped_refptr<LevelDBTransaction> transaction = new LevelDBTransaction(db);
+  base::TimeTicks start = base::TimeTicks::HighResNow();
+  for (int i = kNumRecords - 1; i >= 0; --i) {
+    std::string copy(value);
+    transaction->Put(base::StringPrintf("key%08d", i), &copy);
+  }
+  base::TimeDelta put_time = base::TimeTicks::HighResNow() - start;
+
+  start = base::TimeTicks::HighResNow();
+  ASSERT_TRUE(transaction->Commit().ok());
+  base::TimeDelta commit_time = base::TimeTicks::HighResNow() - start;
+
+  start = base::TimeTicks::HighResNow();
+  scoped_ptr<LevelDBIterator> it = db->CreateIterator();
+  int count = 0;
+  for (it->Seek(base::StringPiece()); it->IsValid(); it->Next()) {
+    EXPECT_EQ(value_size, it->Value().size());
+    ++count;
+  }
+  base::TimeDelta iterate_time = base::TimeTicks::HighResNow() - start;
+  EXPECT_EQ(kNumRecords, count);
+
+  perf_test::PrintResult("leveldb_transaction_put", "", trace,
+                         kNumRecords / put_time.InMillisecondsF(),
+                         "records/ms", true);
+  perf_test::PrintResult("leveldb_transaction_commit", "", trace,
+                         commit_time.InMillisecondsF(), "ms", true);
+  perf_test::PrintResult("leveldb_iterate", "", trace,
+                         kNumRecords / iterate_time.InMillisecondsF(),
+                         "records/ms", true);
+}
+
+}  // namespace
+
+TEST(LevelDBTransactionPerfTest, BulkInsertAndIterate) {
+  static const size_t kValueSizes[] = { 16, 1024, 16 * 1024 };
+  for (size_t i = 0; i < arraysize(kValueSizes); ++i) {
+    base::ScopedTempDir temp_directory;
+    ASSERT_TRUE(temp_directory.CreateUniqueTempDir());
+    SimpleComparator comparator;
+    scoped_ptr<LevelDBDatabase> db;
+    ASSERT_TRUE(
+        LevelDBDatabase::Open(temp_directory.path(), &comparator, &db).ok());
+    RunBulkBenchmark(db.get(), kValueSizes[i]);
+  }
+}
+
+}  // namespace content
@@ -11,6 +11,7 @@
 #include "base/containers/hash_tables.h"
 #include "base/debug/alias.h"
 #include "base/logging.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/shared_memory.h"
 #include "base/metrics/histogram.h"
 #include "base/strings/string_number_conversions.h"
@@ -40,6 +41,28 @@ static int kBufferSize = 1024 * 512;
 static int kMinAllocationSize = 1024 * 4;
 static int kMaxAllocationSize = 1024 * 32;
 
+// Exposes a response's cached metadata as RefCountedMemory, so that it can be
+// sent to the renderer without being copied.
+class CachedMetadata : public base::RefCountedMemory {
+ public:
+  explicit CachedMetadata(net::IOBufferWithSize* buffer) : buffer_(buffer) {}
+
+  // Overridden from RefCountedMemory:
+  virtual const unsigned char* front() const OVERRIDE {
+    return reinterpret_cast<const unsigned char*>(buffer_->data());
+  }
+  virtual size_t size() const OVERRIDE {
+    return buffer_->size();
+  }
+
+ private:
+  virtual ~CachedMetadata() {}
+
+  scoped_refptr<net::IOBufferWithSize> buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(CachedMetadata);
+};
+
 void GetNumericArg(const std::string& name, int* result) {
   const std::string& value =
       CommandLine::ForCurrentProcess()->GetSwitchValueASCII(name);
@@ -207,11 +230,10 @@ bool AsyncResourceHandler::OnResponseStarted(int request_id,
   sent_received_response_msg_ = true;
 
   if (request()->response_info().metadata.get()) {
-    std::vector<char> copy(request()->response_info().metadata->data(),
-                           request()->response_info().metadata->data() +
-                               request()->response_info().metadata->size());
+    scoped_refptr<base::RefCountedMemory> metadata(
+        new CachedMetadata(request()->response_info().metadata.get()));
     info->filter()->Send(new ResourceMsg_ReceivedCachedMetadata(request_id,
-                                                                copy));
+                                                                metadata));
   }
 
   return true;
@@ -1321,6 +1321,13 @@ void ResourceDispatcherHostImpl::OnRenderViewHostDeleted(
   CancelRequestsForRoute(child_id, route_id);
 }
 
+void ResourceDispatcherHostImpl::OnRenderViewHostVisibilityChanged(
+    int child_id,
+    int route_id,
+    bool is_visible) {
+  scheduler_->OnVisibilityChanged(child_id, route_id, is_visible);
+}
+
 // This function is only used for saving feature.
 void ResourceDispatcherHostImpl::BeginSaveFile(
     const GURL& url,
@@ -167,6 +167,11 @@ class CONTENT_EXPORT ResourceDispatcherHostImpl
   // Called when a RenderViewHost is deleted.
   void OnRenderViewHostDeleted(int child_id, int route_id);
 
+  // Called when a RenderViewHost is hidden or shown.
+  void OnRenderViewHostVisibilityChanged(int child_id,
+                                         int route_id,
+                                         bool is_visible);
+
   // Force cancels any pending requests for the given process.
   void CancelRequestsForProcess(int child_id);
 
@@ -85,7 +85,10 @@ class CONTENT_EXPORT ResourceHandler
   // Data will be read for the response.  Upon success, this method places the
   // size and address of the buffer where the data is to be written in its
   // out-params.  This call will be followed by either OnReadCompleted or
-  // OnResponseCompleted, at which point the buffer may be recycled.
+  // OnResponseCompleted, at which point the buffer may be recycled.  The
+  // buffer is passed to net::URLRequest::Read as is, so a handler that
+  // returns memory shared with the renderer has the response body written
+  // straight into it.
   //
   // If the handler returns false, then the request is cancelled.  Otherwise,
   // once data is available, OnReadCompleted will be called.
@@ -4,19 +4,27 @@
 
 #include "content/browser/loader/resource_loader.h"
 
+#include <set>
+#include <string>
+#include <vector>
+
 #include "base/run_loop.h"
 #include "content/browser/browser_thread_impl.h"
+#include "content/browser/loader/resource_buffer.h"
 #include "content/browser/loader/resource_loader_delegate.h"
 #include "content/public/browser/resource_request_info.h"
 #include "content/public/test/mock_resource_context.h"
 #include "content/public/test/test_browser_thread_bundle.h"
 #include "content/test/test_content_browser_client.h"
 #include "ipc/ipc_message.h"
+#include "net/base/io_buffer.h"
 #include "net/base/request_priority.h"
 #include "net/cert/x509_certificate.h"
 #include "net/ssl/client_cert_store.h"
 #include "net/ssl/ssl_cert_request_info.h"
 #include "net/url_request/url_request.h"
+#include "net/url_request/url_request_job_factory_impl.h"
+#include "net/url_request/url_request_test_job.h"
 #include "net/url_request/url_request_test_util.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -123,6 +131,102 @@ class ResourceHandlerStub : public ResourceHandler {
                                 int bytes_downloaded) OVERRIDE {}
 };
 
+// Handler that, like AsyncResourceHandler, hands out buffers allocated from a
+// ResourceBuffer, and records the allocations and the data written to them.
+class ResourceBufferHandlerStub : public ResourceHandlerStub {
+ public:
+  ResourceBufferHandlerStub()
+      : buffer_(new ResourceBuffer()),
+        last_allocation_(NULL),
+        completed_(false) {
+    CHECK(buffer_->Initialize(64, 4, 16));
+  }
+
+  virtual bool OnWillRead(int request_id,
+                          scoped_refptr<net::IOBuffer>* buf,
+                          int* buf_size,
+                          int min_size) OVERRIDE {
+    last_allocation_ = buffer_->Allocate(buf_size);
+    if (!last_allocation_)
+      return false;
+    allocations_.insert(last_allocation_);
+    *buf = new net::WrappedIOBuffer(last_allocation_);
+    return true;
+  }
+
+  virtual bool OnReadCompleted(int request_id,
+                               int bytes_read,
+                               bool* defer) OVERRIDE {
+    if (!bytes_read)
+      return true;
+    buffer_->ShrinkLastAllocation(bytes_read);
+    data_.append(last_allocation_, bytes_read);
+    return true;
+  }
+
+  virtual void OnResponseCompleted(int request_id,
+                                   const net::URLRequestStatus& status,
+                                   const std::string& security_info,
+                                   bool* defer) OVERRIDE {
+    completed_ = true;
+  }
+
+  const std::set<char*>& allocations() const { return allocations_; }
+  const std::string& data() const { return data_; }
+  bool completed() const { return completed_; }
+
+ private:
+  scoped_refptr<ResourceBuffer> buffer_;
+  char* last_allocation_;
+  std::set<char*> allocations_;
+  std::string data_;
+  bool completed_;
+};
+
+// Job that records the buffers its raw data is read into.
+class BufferRecordingJob : public net::URLRequestTestJob {
+ public:
+  BufferRecordingJob(net::URLRequest* request,
+                     net::NetworkDelegate* network_delegate,
+                     std::vector<char*>* read_buffers)
+      : net::URLRequestTestJob(request,
+                               network_delegate,
+                               net::URLRequestTestJob::test_headers(),
+                               net::URLRequestTestJob::test_data_1(),
+                               true),
+        read_buffers_(read_buffers) {
+  }
+
+  virtual bool ReadRawData(net::IOBuffer* buf,
+                           int buf_size,
+                           int* bytes_read) OVERRIDE {
+    read_buffers_->push_back(buf->data());
+    return net::URLRequestTestJob::ReadRawData(buf, buf_size, bytes_read);
+  }
+
+ private:
+  virtual ~BufferRecordingJob() {}
+
+  std::vector<char*>* read_buffers_;
+};
+
+class BufferRecordingProtocolHandler
+    : public net::URLRequestJobFactory::ProtocolHandler {
+ public:
+  explicit BufferRecordingProtocolHandler(std::vector<char*>* read_buffers)
+      : read_buffers_(read_buffers) {
+  }
+
+  virtual net::URLRequestJob* MaybeCreateJob(
+      net::URLRequest* request,
+      net::NetworkDelegate* network_delegate) const OVERRIDE {
+    return new BufferRecordingJob(request, network_delegate, read_buffers_);
+  }
+
+ private:
+  std::vector<char*>* read_buffers_;
+};
+
 // Test browser client that captures calls to SelectClientCertificates and
 // records the arguments of the most recent call for later inspection.
 class SelectCertificateBrowserClient : public TestContentBrowserClient {
@@ -319,4 +423,44 @@ TEST_F(ResourceLoaderTest, ClientCertStoreNull) {
   EXPECT_EQ(net::CertificateList(), test_client.passed_certs());
 }
 
+// Verifies that the response body is read straight into the memory handed out
+// by the ResourceHandler, with no intermediate copy.
+TEST_F(ResourceLoaderTest, ReadsIntoHandlerBuffer) {
+  std::vector<char*> read_buffers;
+  net::URLRequestJobFactoryImpl job_factory;
+  job_factory.SetProtocolHandler(
+      "test", new BufferRecordingProtocolHandler(&read_buffers));
+  test_url_request_context_.set_job_factory(&job_factory);
+
+  scoped_ptr<net::URLRequest> request(
+      new net::URLRequest(net::URLRequestTestJob::test_url_1(),
+                          net::DEFAULT_PRIORITY,
+                          NULL,
+                          resource_context_.GetRequestContext()));
+  ResourceRequestInfo::AllocateForTesting(request.get(),
+                                          ResourceType::MAIN_FRAME,
+                                          &resource_context_,
+                                          1,
+                                          2,
+                                          MSG_ROUTING_NONE,
+                                          false);
+
+  ResourceBufferHandlerStub* handler = new ResourceBufferHandlerStub();
+  ResourceLoader loader(request.Pass(),
+                        scoped_ptr<ResourceHandler>(handler),
+                        this);
+  loader.StartRequest();
+  base::RunLoop().RunUntilIdle();
+
+  ASSERT_TRUE(handler->completed());
+  EXPECT_EQ(net::URLRequestTestJob::test_data_1(), handler->data());
+  // The body spans several allocations, each of which the job read into.
+  EXPECT_LT(1u, handler->allocations().size());
+  ASSERT_FALSE(read_buffers.empty());
+  for (size_t i = 0; i < read_buffers.size(); ++i)
+    EXPECT_EQ(1u, handler->allocations().count(read_buffers[i]));
+
+  test_url_request_context_.set_job_factory(NULL);
+}
+
 }  // namespace content
@@ -4,6 +4,8 @@
 
 #include "content/browser/loader/resource_scheduler.h"
 
+#include <algorithm>
+
 #include "base/stl_util.h"
 #include "content/common/resource_messages.h"
 #include "content/browser/loader/resource_message_delegate.h"
@@ -23,6 +25,32 @@ namespace content {
 static const size_t kMaxNumDelayableRequestsPerClient = 10;
 static const size_t kMaxNumDelayableRequestsPerHost = 6;
 
+// Hidden clients are limited further, so that they don't compete with the
+// visible one for bandwidth.
+static const size_t kMaxNumDelayableRequestsPerBackgroundClient = 4;
+static const size_t kMaxNumDelayableRequestsPerBackgroundHost = 2;
+
+// On slow connections, loading many resources in parallel only delays each of
+// them, so the limits are divided by this factor.
+static const size_t kSlowNetworkLimitDivisor = 2;
+
+static bool IsSlowConnectionType(
+    net::NetworkChangeNotifier::ConnectionType type) {
+  return type == net::NetworkChangeNotifier::CONNECTION_2G;
+}
+
+// Returns true if requests to |host_port_pair| share one connection, and so
+// don't compete for the connections to the host.
+static bool IsMultiplexed(
+    const net::HttpServerProperties& http_server_properties,
+    const net::HostPortPair& host_port_pair) {
+  if (http_server_properties.SupportsSpdy(host_port_pair))
+    return true;
+  return http_server_properties.HasAlternateProtocol(host_port_pair) &&
+         http_server_properties.GetAlternateProtocol(host_port_pair).protocol ==
+             net::QUIC;
+}
+
 // A thin wrapper around net::PriorityQueue that deals with
 // ScheduledResourceRequests instead of PriorityQueue::Pointers.
 class ResourceScheduler::RequestQueue {
@@ -178,19 +206,24 @@ class ResourceScheduler::ScheduledResourceRequest
 
 // Each client represents a tab.
 struct ResourceScheduler::Client {
-  Client() : has_body(false), using_spdy_proxy(false) {}
+  Client() : has_body(false), using_spdy_proxy(false), is_visible(true) {}
   ~Client() {}
 
   bool has_body;
   bool using_spdy_proxy;
+  bool is_visible;
   RequestQueue pending_requests;
   RequestSet in_flight_requests;
 };
 
-ResourceScheduler::ResourceScheduler() {
+ResourceScheduler::ResourceScheduler()
+    : on_slow_network_(IsSlowConnectionType(
+          net::NetworkChangeNotifier::GetConnectionType())) {
+  net::NetworkChangeNotifier::AddConnectionTypeObserver(this);
 }
 
 ResourceScheduler::~ResourceScheduler() {
+  net::NetworkChangeNotifier::RemoveConnectionTypeObserver(this);
   DCHECK(unowned_requests_.empty());
   DCHECK(client_map_.empty());
 }
@@ -281,6 +314,26 @@ void ResourceScheduler::OnClientDeleted(int child_id, int route_id) {
   client_map_.erase(it);
 }
 
+void ResourceScheduler::OnVisibilityChanged(int child_id,
+                                            int route_id,
+                                            bool is_visible) {
+  DCHECK(CalledOnValidThread());
+  ClientId client_id = MakeClientId(child_id, route_id);
+
+  ClientMap::iterator it = client_map_.find(client_id);
+  if (it == client_map_.end()) {
+    // The client was likely deleted shortly before we received this IPC.
+    return;
+  }
+
+  Client* client = it->second;
+  if (client->is_visible == is_visible)
+    return;
+  client->is_visible = is_visible;
+  if (is_visible)
+    LoadAnyStartablePendingRequests(client);
+}
+
 void ResourceScheduler::OnNavigate(int child_id, int route_id) {
   DCHECK(CalledOnValidThread());
   ClientId client_id = MakeClientId(child_id, route_id);
@@ -329,6 +382,23 @@ void ResourceScheduler::OnReceivedSpdyProxiedHttpResponse(
   }
 }
 
+void ResourceScheduler::OnConnectionTypeChanged(
+    net::NetworkChangeNotifier::ConnectionType type) {
+  DCHECK(CalledOnValidThread());
+  bool on_slow_network = IsSlowConnectionType(type);
+  if (on_slow_network == on_slow_network_)
+    return;
+  on_slow_network_ = on_slow_network;
+  if (on_slow_network_)
+    return;
+
+  // The limits were raised, so more requests may be able to start.
+  for (ClientMap::iterator it = client_map_.begin(); it != client_map_.end();
+       ++it) {
+    LoadAnyStartablePendingRequests(it->second);
+  }
+}
+
 void ResourceScheduler::StartRequest(ScheduledResourceRequest* request,
                                      Client* client) {
   client->in_flight_requests.insert(request);
@@ -406,6 +476,26 @@ void ResourceScheduler::LoadAnyStartablePendingRequests(Client* client) {
   }
 }
 
+size_t ResourceScheduler::GetMaxDelayableRequestsPerClient(
+    const Client* client) const {
+  size_t limit = client->is_visible ?
+      kMaxNumDelayableRequestsPerClient :
+      kMaxNumDelayableRequestsPerBackgroundClient;
+  if (on_slow_network_)
+    limit = std::max<size_t>(1, limit / kSlowNetworkLimitDivisor);
+  return limit;
+}
+
+size_t ResourceScheduler::GetMaxDelayableRequestsPerHost(
+    const Client* client) const {
+  size_t limit = client->is_visible ?
+      kMaxNumDelayableRequestsPerHost :
+      kMaxNumDelayableRequestsPerBackgroundHost;
+  if (on_slow_network_)
+    limit = std::max<size_t>(1, limit / kSlowNetworkLimitDivisor);
+  return limit;
+}
+
 void ResourceScheduler::GetNumDelayableRequestsInFlight(
     Client* client,
     const net::HostPortPair& active_request_host,
@@ -429,7 +519,7 @@ void ResourceScheduler::GetNumDelayableRequestsInFlight(
       const net::HttpServerProperties& http_server_properties =
           *(*it)->url_request()->context()->http_server_properties();
 
-      if (!http_server_properties.SupportsSpdy(host_port_pair)) {
+      if (!IsMultiplexed(http_server_properties, host_port_pair)) {
         ++total_delayable_count;
       }
     }
@@ -446,7 +536,8 @@ void ResourceScheduler::GetNumDelayableRequestsInFlight(
 //
 //   * Higher priority requests (>= net::LOW).
 //   * Synchronous requests.
-//   * Requests to SPDY-capable origin servers.
+//   * Requests to SPDY-capable origin servers, or to origin servers with a
+//     QUIC alternate protocol.
 //   * Non-HTTP[S] requests.
 //
 // 2. The remainder are delayable requests, which follow these rules:
@@ -454,8 +545,11 @@ void ResourceScheduler::GetNumDelayableRequestsInFlight(
 //   * If no high priority requests are in flight, start loading low priority
 //     requests.
 //   * Once the renderer has a <body>, start loading delayable requests.
-//   * Never exceed 10 delayable requests in flight per client.
-//   * Never exceed 6 delayable requests for a given host.
+//   * Never exceed 10 delayable requests in flight per client, or 4 if the
+//     client is hidden.
+//   * Never exceed 6 delayable requests for a given host, or 2 if the client
+//     is hidden.
+//   * Halve these limits on slow (2G) connections.
 //   * Prior to <body>, allow one delayable request to load at a time.
 ResourceScheduler::ShouldStartReqResult ResourceScheduler::ShouldStartRequest(
     ScheduledResourceRequest* request,
@@ -486,7 +580,7 @@ ResourceScheduler::ShouldStartReqResult ResourceScheduler::ShouldStartRequest(
   // TODO(willchan): We should really improve this algorithm as described in
   // crbug.com/164101. Also, theoretically we should not count a SPDY request
   // against the delayable requests limit.
-  if (http_server_properties.SupportsSpdy(host_port_pair)) {
+  if (IsMultiplexed(http_server_properties, host_port_pair)) {
     return START_REQUEST;
   }
 
@@ -496,11 +590,13 @@ ResourceScheduler::ShouldStartReqResult ResourceScheduler::ShouldStartRequest(
                                   &num_delayable_requests_in_flight,
                                   &num_requests_in_flight_for_host);
 
-  if (num_delayable_requests_in_flight >= kMaxNumDelayableRequestsPerClient) {
+  if (num_delayable_requests_in_flight >=
+      GetMaxDelayableRequestsPerClient(client)) {
     return DO_NOT_START_REQUEST_AND_STOP_SEARCHING;
   }
 
-  if (num_requests_in_flight_for_host >= kMaxNumDelayableRequestsPerHost) {
+  if (num_requests_in_flight_for_host >=
+      GetMaxDelayableRequestsPerHost(client)) {
     // There may be other requests for other hosts we'd allow, so keep checking.
     return DO_NOT_START_REQUEST_AND_KEEP_SEARCHING;
   }
@@ -13,11 +13,13 @@
 #include "base/memory/scoped_ptr.h"
 #include "base/threading/non_thread_safe.h"
 #include "content/common/content_export.h"
+#include "net/base/network_change_notifier.h"
 #include "net/base/priority_queue.h"
 #include "net/base/request_priority.h"
 
 namespace net {
 class HostPortPair;
+class HttpServerProperties;
 class URLRequest;
 }
 
@@ -50,10 +52,17 @@ class ResourceThrottle;
 // The scheduler may defer issuing the request via the ResourceThrottle
 // interface or it may alter the request's priority by calling set_priority() on
 // the URLRequest.
-class CONTENT_EXPORT ResourceScheduler : public base::NonThreadSafe {
+//
+// The number of delayable requests a Client may have in flight depends on
+// whether it is visible and on the type of the network connection: hidden
+// Clients and slow connections get fewer of them, so that the visible tab
+// gets most of the bandwidth.
+class CONTENT_EXPORT ResourceScheduler
+    : public base::NonThreadSafe,
+      public net::NetworkChangeNotifier::ConnectionTypeObserver {
  public:
   ResourceScheduler();
-  ~ResourceScheduler();
+  virtual ~ResourceScheduler();
 
   // Requests that this ResourceScheduler schedule, and eventually loads, the
   // specified |url_request|. Caller should delete the returned ResourceThrottle
@@ -69,6 +78,9 @@ class CONTENT_EXPORT ResourceScheduler : public base::NonThreadSafe {
   // Called when a renderer is destroyed.
   void OnClientDeleted(int child_id, int route_id);
 
+  // Called when a renderer is hidden or shown. Clients start out visible.
+  void OnVisibilityChanged(int child_id, int route_id, bool is_visible);
+
   // Signals from IPC messages directly from the renderers:
 
   // Called when a client navigates to a new main document.
@@ -84,6 +96,10 @@ class CONTENT_EXPORT ResourceScheduler : public base::NonThreadSafe {
   // from a proxy using SPDY.
   void OnReceivedSpdyProxiedHttpResponse(int child_id, int route_id);
 
+  // net::NetworkChangeNotifier::ConnectionTypeObserver implementation.
+  virtual void OnConnectionTypeChanged(
+      net::NetworkChangeNotifier::ConnectionType type) OVERRIDE;
+
  private:
   class RequestQueue;
   class ScheduledResourceRequest;
@@ -112,6 +128,11 @@ class CONTENT_EXPORT ResourceScheduler : public base::NonThreadSafe {
   // results of ShouldStartRequest().
   void LoadAnyStartablePendingRequests(Client* client);
 
+  // Returns the limits on the delayable requests |client| may have in flight,
+  // in total and to a single host.
+  size_t GetMaxDelayableRequestsPerClient(const Client* client) const;
+  size_t GetMaxDelayableRequestsPerHost(const Client* client) const;
+
   // Returns the number of requests with priority < LOW that are currently in
   // flight.
   void GetNumDelayableRequestsInFlight(
@@ -136,6 +157,9 @@ class CONTENT_EXPORT ResourceScheduler : public base::NonThreadSafe {
 
   ClientMap client_map_;
   RequestSet unowned_requests_;
+
+  // Whether the connection is too slow to load many resources in parallel.
+  bool on_slow_network_;
 };
 
 }  // namespace content
@@ -478,6 +478,70 @@ TEST_F(ResourceSchedulerTest, SpdyProxySchedulesImmediately) {
   EXPECT_TRUE(after->started());
 }
 
+TEST_F(ResourceSchedulerTest, QuicHostSchedulesImmediately) {
+  http_server_properties_.SetAlternateProtocol(
+      net::HostPortPair("quichost", 80), 443, net::QUIC);
+  scoped_ptr<TestRequest> high(NewRequest("http://host/high", net::HIGHEST));
+  scoped_ptr<TestRequest> low(NewRequest("http://host/low", net::LOWEST));
+
+  scoped_ptr<TestRequest> quic(NewRequest("http://quichost/req", net::LOWEST));
+  scoped_ptr<TestRequest> request(NewRequest("http://host/req", net::LOWEST));
+  EXPECT_TRUE(quic->started());
+  EXPECT_FALSE(request->started());
+}
+
+TEST_F(ResourceSchedulerTest, HiddenClientHasLowerLimits) {
+  scheduler_.OnWillInsertBody(kChildId, kRouteId);
+  scheduler_.OnVisibilityChanged(kChildId, kRouteId, false);
+
+  const int kMaxNumDelayableRequestsPerBackgroundClient = 4;  // As in the .cc.
+  const int kMaxNumDelayableRequestsPerBackgroundHost = 2;
+  ScopedVector<TestRequest> lows;
+  for (int i = 0; i < kMaxNumDelayableRequestsPerBackgroundHost; ++i) {
+    string url = "http://host/low" + base::IntToString(i);
+    lows.push_back(NewRequest(url.c_str(), net::LOWEST));
+    EXPECT_TRUE(lows.back()->started());
+  }
+  scoped_ptr<TestRequest> same_host(NewRequest("http://host/last",
+                                               net::LOWEST));
+  EXPECT_FALSE(same_host->started());
+
+  for (int i = kMaxNumDelayableRequestsPerBackgroundHost;
+       i < kMaxNumDelayableRequestsPerBackgroundClient; ++i) {
+    string url = "http://host" + base::IntToString(i) + "/low";
+    lows.push_back(NewRequest(url.c_str(), net::LOWEST));
+    EXPECT_TRUE(lows.back()->started());
+  }
+  scoped_ptr<TestRequest> other_host(NewRequest("http://host_new/last",
+                                                net::LOWEST));
+  EXPECT_FALSE(other_host->started());
+
+  // Showing the client raises the limits again.
+  scheduler_.OnVisibilityChanged(kChildId, kRouteId, true);
+  EXPECT_TRUE(same_host->started());
+  EXPECT_TRUE(other_host->started());
+}
+
+TEST_F(ResourceSchedulerTest, SlowNetworkHasLowerLimits) {
+  scheduler_.OnWillInsertBody(kChildId, kRouteId);
+  scheduler_.OnConnectionTypeChanged(net::NetworkChangeNotifier::CONNECTION_2G);
+
+  // Half of the per-host limit of 6.
+  const int kMaxNumDelayableRequestsPerHostOnSlowNetwork = 3;
+  ScopedVector<TestRequest> lows;
+  for (int i = 0; i < kMaxNumDelayableRequestsPerHostOnSlowNetwork; ++i) {
+    string url = "http://host/low" + base::IntToString(i);
+    lows.push_back(NewRequest(url.c_str(), net::LOWEST));
+    EXPECT_TRUE(lows.back()->started());
+  }
+  scoped_ptr<TestRequest> last(NewRequest("http://host/last", net::LOWEST));
+  EXPECT_FALSE(last->started());
+
+  scheduler_.OnConnectionTypeChanged(
+      net::NetworkChangeNotifier::CONNECTION_WIFI);
+  EXPECT_TRUE(last->started());
+}
+
 }  // unnamed namespace
 
 }  // namespace content
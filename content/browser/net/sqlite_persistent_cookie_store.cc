@@ -67,7 +67,8 @@ namespace content {
 // Subsequent to loading, mutations may be queued by any thread using
 // AddCookie, UpdateCookieAccessTime, and DeleteCookie. These are flushed to
 // disk on the BG runner every 30 seconds, 512 operations, or call to Flush(),
-// whichever occurs first.
+// whichever occurs first.  The database is journaled with a write-ahead log,
+// which is checkpointed into the database every few commits and on close.
 class SQLitePersistentCookieStore::Backend
     : public base::RefCountedThreadSafe<SQLitePersistentCookieStore::Backend> {
  public:
@@ -80,6 +81,7 @@ class SQLitePersistentCookieStore::Backend
       CookieCryptoDelegate* crypto_delegate)
       : path_(path),
         num_pending_(0),
+        commits_since_checkpoint_(0),
         force_keep_session_state_(false),
         initialized_(false),
         corruption_detected_(false),
@@ -129,6 +131,9 @@ class SQLitePersistentCookieStore::Backend
   // Database upgrade statements.
   bool EnsureDatabaseVersion();
 
+  // Creates |db_|, configured for the many small writes of the cookie store.
+  void CreateConnection();
+
   class PendingOperation {
    public:
     typedef enum {
@@ -220,6 +225,9 @@ class SQLitePersistentCookieStore::Backend
   typedef std::list<PendingOperation*> PendingOperationsList;
   PendingOperationsList pending_;
   PendingOperationsList::size_type num_pending_;
+  // The number of commits to the write-ahead log since it was last
+  // checkpointed.  Only accessed on the background runner.
+  int commits_since_checkpoint_;
   // True if the persistent store should skip delete on exit rules.
   bool force_keep_session_state_;
   // Guard |cookies_|, |pending_|, |num_pending_|, |force_keep_session_state_|
@@ -312,6 +320,12 @@ namespace {
 const int kCurrentVersionNumber = 7;
 const int kCompatibleVersionNumber = 5;
 
+// Commits only append to the write-ahead log, and checkpoints are left to the
+// backend, which runs one after this many commits.  With a commit at most
+// every 30 seconds under light use, this syncs the database every few minutes
+// instead of on every commit.
+const int kCommitsPerCheckpoint = 10;
+
 // Possible values for the 'priority' column.
 enum DBCookiePriority {
   kCookiePriorityLow = 0,
@@ -570,13 +584,7 @@ bool SQLitePersistentCookieStore::Backend::InitializeDatabase() {
   if (base::GetFileSize(path_, &db_size))
     UMA_HISTOGRAM_COUNTS("Cookie.DBSizeInKB", db_size / 1024 );
 
-  db_.reset(new sql::Connection);
-  db_->set_histogram_tag("Cookie");
-
-  // Unretained to avoid a ref loop with |db_|.
-  db_->set_error_callback(
-      base::Bind(&SQLitePersistentCookieStore::Backend::DatabaseErrorCallback,
-                 base::Unretained(this)));
+  CreateConnection();
 
   if (!db_->Open(path_)) {
     NOTREACHED() << "Unable to open cookie DB.";
@@ -889,8 +897,8 @@ bool SQLitePersistentCookieStore::Backend::EnsureDatabaseVersion() {
     UMA_HISTOGRAM_COUNTS_100("Cookie.CorruptMetaTable", 1);
 
     meta_table_.Reset();
-    db_.reset(new sql::Connection);
-    if (!base::DeleteFile(path_, false) ||
+    CreateConnection();
+    if (!sql::Connection::Delete(path_) ||
         !db_->Open(path_) ||
         !meta_table_.Init(
             db_.get(), kCurrentVersionNumber, kCompatibleVersionNumber)) {
@@ -952,6 +960,18 @@ void SQLitePersistentCookieStore::Backend::BatchOperation(
   }
 }
 
+void SQLitePersistentCookieStore::Backend::CreateConnection() {
+  db_.reset(new sql::Connection);
+  db_->set_histogram_tag("Cookie");
+  db_->set_wal_mode();
+  db_->set_wal_autocheckpoint(0);
+
+  // Unretained to avoid a ref loop with |db_|.
+  db_->set_error_callback(
+      base::Bind(&SQLitePersistentCookieStore::Backend::DatabaseErrorCallback,
+                 base::Unretained(this)));
+}
+
 void SQLitePersistentCookieStore::Backend::Commit() {
   DCHECK(background_task_runner_->RunsTasksOnCurrentThread());
 
@@ -1051,6 +1071,11 @@ void SQLitePersistentCookieStore::Backend::Commit() {
   bool succeeded = transaction.Commit();
   UMA_HISTOGRAM_ENUMERATION("Cookie.BackingStoreUpdateResults",
                             succeeded ? 0 : 1, 2);
+
+  if (succeeded && ++commits_since_checkpoint_ >= kCommitsPerCheckpoint) {
+    ignore_result(db_->CheckpointWAL());
+    commits_since_checkpoint_ = 0;
+  }
 }
 
 void SQLitePersistentCookieStore::Backend::Flush(
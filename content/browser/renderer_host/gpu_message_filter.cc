@@ -149,6 +149,7 @@ void GpuMessageFilter::OnEstablishGpuChannel(
   host->EstablishGpuChannel(
       render_process_id_,
       share_contexts_,
+      false,
       base::Bind(&GpuMessageFilter::EstablishChannelCallback,
                  weak_ptr_factory_.GetWeakPtr(),
                  base::Passed(&reply)));
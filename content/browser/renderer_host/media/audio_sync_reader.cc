@@ -29,7 +29,10 @@ AudioSyncReader::AudioSyncReader(base::SharedMemory* shared_memory,
       maximum_wait_time_(params.GetBufferDuration() / 2),
 #else
       // TODO(dalecurtis): Investigate if we can reduce this on all platforms.
-      maximum_wait_time_(base::TimeDelta::FromMilliseconds(20)),
+      // Never wait longer than a buffer though: by then the device needs the
+      // next one, so waiting longer turns one late buffer into several.
+      maximum_wait_time_(std::min(base::TimeDelta::FromMilliseconds(20),
+                                  params.GetBufferDuration())),
 #endif
       buffer_index_(0) {
   DCHECK_EQ(packet_size_, AudioBus::CalculateMemorySize(params));
@@ -22,6 +22,9 @@ namespace {
 const int kReadBufferSize = 65536;
 // Socket receive buffer size.
 const int kRecvSocketBufferSize = 65536;  // 64K
+// Maximum number of packets sent to the renderer in one
+// P2PMsg_OnDataReceivedBatch message.
+const size_t kMaxPacketsPerBatch = 32;
 
 // Defines set of transient errors. These errors are ignored when we get them
 // from sendto() or recvfrom() calls.
@@ -128,6 +131,9 @@ bool P2PSocketHostUdp::Init(const net::IPEndPoint& local_address,
 }
 
 void P2PSocketHostUdp::OnError() {
+  // Deliver what was received before the error first.
+  SendReceivedPackets();
+
   socket_.reset();
   send_queue_.clear();
 
@@ -145,8 +151,10 @@ void P2PSocketHostUdp::DoRead() {
         kReadBufferSize,
         &recv_address_,
         base::Bind(&P2PSocketHostUdp::OnRecv, base::Unretained(this)));
-    if (result == net::ERR_IO_PENDING)
+    if (result == net::ERR_IO_PENDING) {
+      SendReceivedPackets();
       return;
+    }
     HandleReadResult(result);
   } while (state_ == STATE_OPEN);
 }
@@ -162,11 +170,9 @@ void P2PSocketHostUdp::HandleReadResult(int result) {
   DCHECK_EQ(STATE_OPEN, state_);
 
   if (result > 0) {
-    std::vector<char> data(recv_buffer_->data(), recv_buffer_->data() + result);
-
     if (!ContainsKey(connected_peers_, recv_address_)) {
       P2PSocketHost::StunMessageType type;
-      bool stun = GetStunPacketType(&*data.begin(), data.size(), &type);
+      bool stun = GetStunPacketType(recv_buffer_->data(), result, &type);
       if ((stun && IsRequestOrResponse(type)) || AllowUDPWithoutSTUN()) {
         connected_peers_.insert(recv_address_);
       } else if (!stun || type == STUN_DATA_INDICATION) {
@@ -177,14 +183,34 @@ void P2PSocketHostUdp::HandleReadResult(int result) {
       }
     }
 
-    message_sender_->Send(new P2PMsg_OnDataReceived(
-        id_, recv_address_, data, base::TimeTicks::Now()));
+    received_packets_.push_back(P2PMsg_ReceivedPacket());
+    P2PMsg_ReceivedPacket& packet = received_packets_.back();
+    packet.socket_address = recv_address_;
+    packet.data.assign(recv_buffer_->data(), recv_buffer_->data() + result);
+    packet.timestamp = base::TimeTicks::Now();
+    if (received_packets_.size() >= kMaxPacketsPerBatch)
+      SendReceivedPackets();
   } else if (result < 0 && !IsTransientError(result)) {
     LOG(ERROR) << "Error when reading from UDP socket: " << result;
     OnError();
   }
 }
 
+void P2PSocketHostUdp::SendReceivedPackets() {
+  if (received_packets_.empty())
+    return;
+
+  if (received_packets_.size() == 1) {
+    const P2PMsg_ReceivedPacket& packet = received_packets_.front();
+    message_sender_->Send(new P2PMsg_OnDataReceived(
+        id_, packet.socket_address, packet.data, packet.timestamp));
+  } else {
+    message_sender_->Send(
+        new P2PMsg_OnDataReceivedBatch(id_, received_packets_));
+  }
+  received_packets_.clear();
+}
+
 void P2PSocketHostUdp::Send(const net::IPEndPoint& to,
                             const std::vector<char>& data,
                             const talk_base::PacketOptions& options,
@@ -15,6 +15,7 @@
 #include "base/message_loop/message_loop.h"
 #include "content/browser/renderer_host/p2p/socket_host.h"
 #include "content/common/content_export.h"
+#include "content/common/p2p_messages.h"
 #include "content/public/common/p2p_socket_type.h"
 #include "net/base/ip_endpoint.h"
 #include "net/udp/udp_server_socket.h"
@@ -65,6 +66,9 @@ class CONTENT_EXPORT P2PSocketHostUdp : public P2PSocketHost {
   void OnRecv(int result);
   void HandleReadResult(int result);
 
+  // Sends the packets collected in |received_packets_| to the renderer.
+  void SendReceivedPackets();
+
   void DoSend(const PendingPacket& packet);
   void OnSend(uint64 packet_id, int result);
   void HandleSendResult(uint64 packet_id, int result);
@@ -73,6 +77,10 @@ class CONTENT_EXPORT P2PSocketHostUdp : public P2PSocketHost {
   scoped_refptr<net::IOBuffer> recv_buffer_;
   net::IPEndPoint recv_address_;
 
+  // Packets read by the current DoRead() loop that haven't been sent to the
+  // renderer yet.
+  std::vector<P2PMsg_ReceivedPacket> received_packets_;
+
   std::deque<PendingPacket> send_queue_;
   bool send_pending_;
   net::DiffServCodePoint last_dscp_;
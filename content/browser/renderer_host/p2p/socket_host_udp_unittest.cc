@@ -102,6 +102,13 @@ class FakeDatagramServerSocket : public net::DatagramServerSocket {
     return true;
   }
 
+  // Queues a packet to be returned by a later RecvFrom() call without
+  // completing a pending read.
+  void QueuePacket(const net::IPEndPoint& address,
+                   const std::vector<char>& data) {
+    incoming_packets_.push_back(UDPPacket(address, data));
+  }
+
   void ReceivePacket(const net::IPEndPoint& address, std::vector<char> data) {
     if (!recv_callback_.is_null()) {
       int size = std::min(recv_size_, static_cast<int>(data.size()));
@@ -382,4 +389,23 @@ TEST_F(P2PSocketHostUdpTest, ThrottleAfterLimitAfterReceive) {
   ASSERT_EQ(sent_packets_.size(), 4U);
 }
 
+// Verify that packets that are ready at the same time are sent to the
+// renderer in a single message.
+TEST_F(P2PSocketHostUdpTest, ReceiveBatch) {
+  std::vector<char> request_packet;
+  CreateStunRequest(&request_packet);
+  std::vector<char> packet1;
+  CreateRandomPacket(&packet1);
+  std::vector<char> packet2;
+  CreateRandomPacket(&packet2);
+
+  socket_->QueuePacket(dest1_, packet1);
+  socket_->QueuePacket(dest1_, packet2);
+
+  EXPECT_CALL(sender_, Send(
+      MatchMessage(static_cast<uint32>(P2PMsg_OnDataReceivedBatch::ID))))
+      .WillOnce(DoAll(DeleteArg<0>(), Return(true)));
+  socket_->ReceivePacket(dest1_, request_packet);
+}
+
 }  // namespace content
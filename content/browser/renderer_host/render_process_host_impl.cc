@@ -320,6 +320,15 @@ base::MessageLoop*
 // create.
 static size_t g_max_renderer_count_override = 0;
 
+// A renderer process launched ahead of time, with no listeners, so that the
+// next navigation needing a new process does not wait for one to start. See
+// PrelaunchSpareHostSoon().
+static RenderProcessHostImpl* g_spare_host = NULL;
+
+// How long after a process has been handed out to launch its replacement, so
+// that the launch does not compete with the navigation that needed it.
+static const int kSpareHostLaunchDelayMs = 1000;
+
 // static
 size_t RenderProcessHost::GetMaxRendererProcessCount() {
   if (g_max_renderer_count_override)
@@ -421,6 +430,86 @@ RenderProcessHostImpl::RenderProcessHostImpl(
   //       creation.
 }
 
+// static
+void RenderProcessHostImpl::PrelaunchSpareHostSoon(
+    BrowserContext* browser_context) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  // Off the record contexts can be destroyed while the browser runs, which
+  // would leave the spare with a dangling context, so they never get one.
+  if (g_spare_host || run_renderer_in_process() ||
+      browser_context->IsOffTheRecord() ||
+      !CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kEnableSpareRendererProcess)) {
+    return;
+  }
+  base::MessageLoop::current()->PostDelayedTask(
+      FROM_HERE,
+      base::Bind(&RenderProcessHostImpl::PrelaunchSpareHost, browser_context),
+      base::TimeDelta::FromMilliseconds(kSpareHostLaunchDelayMs));
+}
+
+// static
+void RenderProcessHostImpl::PrelaunchSpareHost(
+    BrowserContext* browser_context) {
+  if (g_spare_host || g_exited_main_message_loop)
+    return;
+
+  // The spare counts against the process limit, which scales with the amount
+  // of installed memory. Launching it must not push the following navigations
+  // into sharing processes.
+  if (g_all_hosts.Get().size() + 1 >= GetMaxRendererProcessCount())
+    return;
+
+  StoragePartitionImpl* partition = static_cast<StoragePartitionImpl*>(
+      BrowserContext::GetStoragePartitionForSite(browser_context, GURL()));
+  bool supports_browser_plugin = GetContentClient()->browser()->
+      SupportsBrowserPlugin(browser_context, GURL());
+  g_spare_host = new RenderProcessHostImpl(browser_context,
+                                           partition,
+                                           supports_browser_plugin,
+                                           false);
+  if (!g_spare_host->Init())
+    DiscardSpareHost();
+}
+
+// static
+RenderProcessHost* RenderProcessHostImpl::TakeSpareHost(
+    BrowserContext* browser_context,
+    StoragePartition* partition,
+    bool supports_browser_plugin) {
+  if (!CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kEnableSpareRendererProcess)) {
+    return NULL;
+  }
+
+  RenderProcessHostImpl* host = g_spare_host;
+  if (host && !host->HasConnection()) {
+    // The spare process died before it was needed.
+    DiscardSpareHost();
+    host = NULL;
+  }
+  if (host && (host->GetBrowserContext() != browser_context ||
+               !host->InSameStoragePartition(partition) ||
+               host->supports_browser_plugin_ != supports_browser_plugin)) {
+    host = NULL;
+  }
+  UMA_HISTOGRAM_BOOLEAN("BrowserRenderProcessHost.SpareProcessUsed",
+                        host != NULL);
+
+  if (host)
+    g_spare_host = NULL;
+  return host;
+}
+
+// static
+void RenderProcessHostImpl::DiscardSpareHost() {
+  if (!g_spare_host)
+    return;
+  RenderProcessHostImpl* host = g_spare_host;
+  g_spare_host = NULL;
+  host->Cleanup();
+}
+
 // static
 void RenderProcessHostImpl::ShutDownInProcessRenderer() {
   DCHECK(g_run_renderer_in_process_);
@@ -1035,6 +1124,7 @@ void RenderProcessHostImpl::PropagateBrowserCommandLineToRenderer(
     switches::kEnablePinch,
     switches::kEnablePreparsedJsCaching,
     switches::kEnablePruneGpuCommandBuffers,
+    switches::kEnableRasterWorkStealing,
     switches::kEnableRepaintAfterLayout,
     switches::kEnableServiceWorker,
     switches::kEnableSkiaBenchmarking,
@@ -1057,6 +1147,7 @@ void RenderProcessHostImpl::PropagateBrowserCommandLineToRenderer(
     switches::kEnableWebMIDI,
     switches::kForceDeviceScaleFactor,
     switches::kFullMemoryCrashReport,
+    switches::kIPCSendBatching,
     switches::kJavaScriptFlags,
     switches::kLoggingLevel,
     switches::kMaxUntiledLayerWidth,
@@ -1098,6 +1189,7 @@ void RenderProcessHostImpl::PropagateBrowserCommandLineToRenderer(
     cc::switches::kDisableLCDText,
     cc::switches::kDisableMapImage,
     cc::switches::kDisableThreadedAnimation,
+    cc::switches::kEnableCompressedPrepaintTiles,
     cc::switches::kEnableGpuBenchmarking,
     cc::switches::kEnableGPURasterization,
     cc::switches::kEnableImplSidePainting,
@@ -1452,6 +1544,8 @@ void RenderProcessHostImpl::Cleanup() {
     DCHECK(!deleting_soon_);
 
     DCHECK_EQ(0, pending_views_);
+    if (g_spare_host == this)
+      g_spare_host = NULL;
     FOR_EACH_OBSERVER(RenderProcessHostObserver,
                       observers_,
                       RenderProcessHostDestroyed(this));
@@ -1632,6 +1726,10 @@ bool RenderProcessHostImpl::IsSuitableHost(
   if (run_renderer_in_process())
     return true;
 
+  // The spare process is only handed out whole, by TakeSpareHost().
+  if (host == g_spare_host)
+    return false;
+
   if (host->GetBrowserContext() != browser_context)
     return false;
 
@@ -208,6 +208,23 @@ class CONTENT_EXPORT RenderProcessHostImpl
   // This forces a renderer that is running "in process" to shut down.
   static void ShutDownInProcessRenderer();
 
+  // With --enable-spare-renderer-process, schedules the launch of a spare
+  // renderer process for the default StoragePartition of |browser_context|,
+  // unless one already exists. Does nothing for off the record contexts.
+  static void PrelaunchSpareHostSoon(BrowserContext* browser_context);
+
+  // Returns the spare renderer process and gives up its ownership if it was
+  // launched for |browser_context| and |partition| with the same browser
+  // plugin support. Otherwise returns NULL and a new RenderProcessHost should
+  // be created.
+  static RenderProcessHost* TakeSpareHost(BrowserContext* browser_context,
+                                          StoragePartition* partition,
+                                          bool supports_browser_plugin);
+
+  // Shuts down the spare renderer process, if any. Called before the browser
+  // contexts are torn down at shutdown.
+  static void DiscardSpareHost();
+
 #if defined(OS_ANDROID)
   const scoped_refptr<BrowserDemuxerAndroid>& browser_demuxer_android() {
     return browser_demuxer_android_;
@@ -276,6 +293,9 @@ class CONTENT_EXPORT RenderProcessHostImpl
   // Handle termination of our process.
   void ProcessDied(bool already_dead);
 
+  // Launches the spare renderer process scheduled by PrelaunchSpareHostSoon().
+  static void PrelaunchSpareHost(BrowserContext* browser_context);
+
   virtual void OnGpuSwitching() OVERRIDE;
 
 #if defined(ENABLE_WEBRTC)
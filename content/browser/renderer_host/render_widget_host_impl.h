@@ -654,6 +654,10 @@ class CONTENT_EXPORT RenderWidgetHostImpl : virtual public RenderWidgetHost,
   // NotifyRendererResponsive.
   void RendererIsResponsive();
 
+  // Tells the ResourceDispatcherHost whether a RenderView is visible, so that
+  // the loads of hidden views can be throttled.
+  void NotifyResourceDispatcherHostOfVisibility(bool is_visible);
+
   // IPC message handlers
   void OnRenderViewReady();
   void OnRenderProcessGone(int status, int error_code);
@@ -4,6 +4,7 @@
 
 #include "content/browser/service_worker/embedded_worker_instance.h"
 
+#include "base/stl_util.h"
 #include "content/browser/service_worker/embedded_worker_registry.h"
 #include "content/common/service_worker/embedded_worker_messages.h"
 #include "ipc/ipc_message.h"
@@ -77,7 +78,8 @@ EmbeddedWorkerInstance::EmbeddedWorkerInstance(
       embedded_worker_id_(embedded_worker_id),
       status_(STOPPED),
       process_id_(-1),
-      thread_id_(-1) {
+      thread_id_(-1),
+      last_process_id_(-1) {
 }
 
 void EmbeddedWorkerInstance::OnStarted(int thread_id) {
@@ -91,6 +93,7 @@ void EmbeddedWorkerInstance::OnStarted(int thread_id) {
 }
 
 void EmbeddedWorkerInstance::OnStopped() {
+  last_process_id_ = process_id_;
   status_ = STOPPED;
   process_id_ = -1;
   thread_id_ = -1;
@@ -113,8 +116,17 @@ void EmbeddedWorkerInstance::RemoveObserver(Observer* observer) {
 
 bool EmbeddedWorkerInstance::ChooseProcess() {
   DCHECK_EQ(-1, process_id_);
-  // Naive implementation; chooses a process which has the biggest number of
-  // associated providers (so that hopefully likely live longer).
+  // Restarting in the same process lets the renderer reuse the script from
+  // its HTTP cache and V8's compilation cache instead of fetching and
+  // compiling it again.
+  if (ContainsKey(process_refs_, last_process_id_)) {
+    process_id_ = last_process_id_;
+    return true;
+  }
+
+  // Otherwise a naive implementation; chooses a process which has the
+  // biggest number of associated providers (so that hopefully likely live
+  // longer).
   ProcessRefMap::iterator max_ref_iter = process_refs_.end();
   for (ProcessRefMap::iterator iter = process_refs_.begin();
        iter != process_refs_.end(); ++iter) {
@@ -110,7 +110,8 @@ class CONTENT_EXPORT EmbeddedWorkerInstance {
   void OnMessageReceived(int request_id, const IPC::Message& message);
 
   // Chooses a process to start this worker and populate process_id_.
-  // Returns false when no process is available.
+  // Prefers the process the worker last ran in, whose caches likely still
+  // hold the script. Returns false when no process is available.
   bool ChooseProcess();
 
   scoped_refptr<EmbeddedWorkerRegistry> registry_;
@@ -121,6 +122,9 @@ class CONTENT_EXPORT EmbeddedWorkerInstance {
   int process_id_;
   int thread_id_;
 
+  // The process the worker ran in when it was last stopped, or -1.
+  int last_process_id_;
+
   ProcessRefMap process_refs_;
   ObserverList<Observer> observer_list_;
 
@@ -115,4 +115,32 @@ TEST_F(EmbeddedWorkerInstanceTest, ChooseProcess) {
   EXPECT_EQ(EmbeddedWorkerInstance::RUNNING, worker->status());
 }
 
+TEST_F(EmbeddedWorkerInstanceTest, ChooseLastProcess) {
+  scoped_ptr<EmbeddedWorkerInstance> worker =
+      embedded_worker_registry()->CreateWorker();
+  const int embedded_worker_id = worker->embedded_worker_id();
+  const GURL url("http://example.com/worker.js");
+
+  // Process 1 has 1 ref and 2 has 2 refs, so process 2 is chosen.
+  helper_->SimulateAddProcessToWorker(embedded_worker_id, 1);
+  helper_->SimulateAddProcessToWorker(embedded_worker_id, 2);
+  helper_->SimulateAddProcessToWorker(embedded_worker_id, 2);
+  EXPECT_EQ(SERVICE_WORKER_OK, worker->Start(1L, url));
+  EXPECT_EQ(2, worker->process_id());
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(EmbeddedWorkerInstance::RUNNING, worker->status());
+
+  EXPECT_EQ(SERVICE_WORKER_OK, worker->Stop());
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(EmbeddedWorkerInstance::STOPPED, worker->status());
+
+  // Process 1 now has more refs, but the worker last ran in process 2.
+  helper_->SimulateAddProcessToWorker(embedded_worker_id, 1);
+  helper_->SimulateAddProcessToWorker(embedded_worker_id, 1);
+  EXPECT_EQ(SERVICE_WORKER_OK, worker->Start(1L, url));
+  EXPECT_EQ(2, worker->process_id());
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(EmbeddedWorkerInstance::RUNNING, worker->status());
+}
+
 }  // namespace content
@@ -106,10 +106,19 @@ RenderProcessHost* SiteInstanceImpl::GetProcess() {
                 BrowserContext::GetStoragePartition(browser_context, this));
         bool supports_browser_plugin = GetContentClient()->browser()->
             SupportsBrowserPlugin(browser_context, site_);
-        process_ = new RenderProcessHostImpl(browser_context,
-                                             partition,
-                                             supports_browser_plugin,
-                                             site_.SchemeIs(kGuestScheme));
+        bool is_guest = site_.SchemeIs(kGuestScheme);
+        if (!is_guest) {
+          process_ = RenderProcessHostImpl::TakeSpareHost(
+              browser_context, partition, supports_browser_plugin);
+        }
+        if (!process_) {
+          process_ = new RenderProcessHostImpl(browser_context,
+                                               partition,
+                                               supports_browser_plugin,
+                                               is_guest);
+        }
+        // Have a process ready for the next navigation that needs one.
+        RenderProcessHostImpl::PrelaunchSpareHostSoon(browser_context);
       }
     }
     CHECK(process_);
@@ -6,6 +6,7 @@
 
 #include "base/bind.h"
 #include "base/debug/trace_event.h"
+#include "base/debug/trace_event_binary.h"
 #include "base/file_util.h"
 #include "base/json/string_escape.h"
 #include "base/strings/string_number_conversions.h"
@@ -29,6 +30,11 @@ namespace {
 base::LazyInstance<TracingControllerImpl>::Leaky g_controller =
     LAZY_INSTANCE_INITIALIZER;
 
+bool IsBinaryOutput() {
+  return (TraceLog::GetInstance()->trace_options() &
+          TraceLog::BINARY_OUTPUT) != 0;
+}
+
 }  // namespace
 
 TracingController* TracingController::GetInstance() {
@@ -37,7 +43,9 @@ TracingController* TracingController::GetInstance() {
 
 class TracingControllerImpl::ResultFile {
  public:
-  explicit ResultFile(const base::FilePath& path);
+  // A |binary| file holds the binary trace segments as they are flushed,
+  // otherwise the batches of JSON events are wrapped in a JSON trace.
+  ResultFile(const base::FilePath& path, bool binary);
   void Write(const scoped_refptr<base::RefCountedString>& events_str_ptr) {
     BrowserThread::PostTask(BrowserThread::FILE, FROM_HERE,
         base::Bind(&TracingControllerImpl::ResultFile::WriteTask,
@@ -65,18 +73,22 @@ class TracingControllerImpl::ResultFile {
   void WriteSystemTraceTask(
       const scoped_refptr<base::RefCountedString>& events_str_ptr);
   void CloseTask(const base::Closure& callback);
+  void CloseBinaryTask();
 
   FILE* file_;
   base::FilePath path_;
+  bool binary_;
   bool has_at_least_one_result_;
   scoped_refptr<base::RefCountedString> system_trace_;
 
   DISALLOW_COPY_AND_ASSIGN(ResultFile);
 };
 
-TracingControllerImpl::ResultFile::ResultFile(const base::FilePath& path)
+TracingControllerImpl::ResultFile::ResultFile(const base::FilePath& path,
+                                              bool binary)
     : file_(NULL),
       path_(path),
+      binary_(binary),
       has_at_least_one_result_(false) {
   BrowserThread::PostTask(BrowserThread::FILE, FROM_HERE,
       base::Bind(&TracingControllerImpl::ResultFile::OpenTask,
@@ -86,11 +98,13 @@ TracingControllerImpl::ResultFile::ResultFile(const base::FilePath& path)
 void TracingControllerImpl::ResultFile::OpenTask() {
   if (path_.empty())
     base::CreateTemporaryFile(&path_);
-  file_ = base::OpenFile(path_, "w");
+  file_ = base::OpenFile(path_, binary_ ? "wb" : "w");
   if (!file_) {
     LOG(ERROR) << "Failed to open " << path_.value();
     return;
   }
+  if (binary_)
+    return;
   const char* preamble = "{\"traceEvents\": [";
   size_t written = fwrite(preamble, strlen(preamble), 1, file_);
   DCHECK(written == 1);
@@ -103,7 +117,7 @@ void TracingControllerImpl::ResultFile::WriteTask(
 
   // If there is already a result in the file, then put a commma
   // before the next batch of results.
-  if (has_at_least_one_result_) {
+  if (has_at_least_one_result_ && !binary_) {
     size_t written = fwrite(",", 1, 1, file_);
     DCHECK(written == 1);
   }
@@ -124,6 +138,12 @@ void TracingControllerImpl::ResultFile::CloseTask(
   if (!file_)
     return;
 
+  if (binary_) {
+    CloseBinaryTask();
+    BrowserThread::PostTask(BrowserThread::UI, FROM_HERE, callback);
+    return;
+  }
+
   const char* trailevents = "]";
   size_t written = fwrite(trailevents, strlen(trailevents), 1, file_);
   DCHECK(written == 1);
@@ -150,6 +170,22 @@ void TracingControllerImpl::ResultFile::CloseTask(
   BrowserThread::PostTask(BrowserThread::UI, FROM_HERE, callback);
 }
 
+void TracingControllerImpl::ResultFile::CloseBinaryTask() {
+  // The system trace goes in a segment of its own.
+  if (system_trace_) {
+    base::debug::TraceEventBinaryWriter writer(
+        TraceLog::GetInstance()->process_id());
+    writer.AppendSystemTrace(system_trace_->data());
+    std::string segment;
+    writer.FinishSegment(&segment);
+    size_t written = fwrite(segment.data(), segment.size(), 1, file_);
+    DCHECK(written == 1);
+    system_trace_ = NULL;
+  }
+  base::CloseFile(file_);
+  file_ = NULL;
+}
+
 
 TracingControllerImpl::TracingControllerImpl() :
     pending_disable_recording_ack_count_(0),
@@ -236,6 +272,8 @@ bool TracingControllerImpl::EnableRecording(
   if (options & ENABLE_SAMPLING) {
     trace_options |=  TraceLog::ENABLE_SAMPLING;
   }
+  if (options & BINARY_FORMAT)
+    trace_options |= TraceLog::BINARY_OUTPUT;
 #if defined(OS_CHROMEOS)
   if (options & ENABLE_SYSTRACE) {
     DCHECK(!is_system_tracing_);
@@ -311,7 +349,7 @@ void TracingControllerImpl::OnDisableRecordingDone(
 #endif
 
   if (!callback.is_null() || !result_file_path.empty())
-    result_file_.reset(new ResultFile(result_file_path));
+    result_file_.reset(new ResultFile(result_file_path, IsBinaryOutput()));
 
   // Count myself (local trace) in pending_disable_recording_ack_count_,
   // acked below.
@@ -353,6 +391,8 @@ bool TracingControllerImpl::EnableMonitoring(
   int trace_options = 0;
   if (options & ENABLE_SAMPLING)
     trace_options |= TraceLog::ENABLE_SAMPLING;
+  if (options & BINARY_FORMAT)
+    trace_options |= TraceLog::BINARY_OUTPUT;
 
   base::Closure on_enable_monitoring_done_callback =
       base::Bind(&TracingControllerImpl::OnEnableMonitoringDone,
@@ -441,7 +481,8 @@ bool TracingControllerImpl::CaptureMonitoringSnapshot(
     return false;
 
   pending_capture_monitoring_snapshot_done_callback_ = callback;
-  monitoring_snapshot_file_.reset(new ResultFile(result_file_path));
+  monitoring_snapshot_file_.reset(
+      new ResultFile(result_file_path, IsBinaryOutput()));
 
   // Count myself in pending_capture_monitoring_snapshot_ack_count_,
   // acked below.
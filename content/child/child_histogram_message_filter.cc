@@ -9,6 +9,7 @@
 #include "base/bind.h"
 #include "base/message_loop/message_loop.h"
 #include "base/metrics/histogram_delta_serialization.h"
+#include "base/metrics/shared_histogram_allocator.h"
 #include "content/child/child_process.h"
 #include "content/child/child_thread.h"
 #include "content/common/child_process_messages.h"
@@ -36,6 +37,8 @@ bool ChildHistogramMessageFilter::OnMessageReceived(
   IPC_BEGIN_MESSAGE_MAP(ChildHistogramMessageFilter, message)
     IPC_MESSAGE_HANDLER(ChildProcessMsg_GetChildHistogramData,
                         OnGetChildHistogramData)
+    IPC_MESSAGE_HANDLER(ChildProcessMsg_SetHistogramMemory,
+                        OnSetHistogramMemory)
     IPC_MESSAGE_UNHANDLED(handled = false)
   IPC_END_MESSAGE_MAP()
   return handled;
@@ -51,6 +54,20 @@ void ChildHistogramMessageFilter::OnGetChildHistogramData(int sequence_number) {
   UploadAllHistograms(sequence_number);
 }
 
+void ChildHistogramMessageFilter::OnSetHistogramMemory(
+    base::SharedMemoryHandle handle,
+    uint32 size) {
+  if (base::SharedHistogramAllocator::GetGlobal()) {
+    base::SharedMemory::CloseHandle(handle);
+    return;
+  }
+  // Histograms created before this keep sending their samples as deltas.
+  scoped_ptr<base::SharedHistogramAllocator> allocator =
+      base::SharedHistogramAllocator::Open(handle, size);
+  if (allocator)
+    base::SharedHistogramAllocator::SetGlobal(allocator.Pass());
+}
+
 void ChildHistogramMessageFilter::UploadAllHistograms(int sequence_number) {
   if (!histogram_delta_serialization_) {
     histogram_delta_serialization_.reset(
@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "base/basictypes.h"
+#include "base/memory/shared_memory.h"
 #include "ipc/ipc_channel_proxy.h"
 
 namespace base {
@@ -36,6 +37,7 @@ class ChildHistogramMessageFilter : public IPC::ChannelProxy::MessageFilter {
 
   // Message handlers.
   virtual void OnGetChildHistogramData(int sequence_number);
+  void OnSetHistogramMemory(base::SharedMemoryHandle handle, uint32 size);
 
   // Extract snapshot data and then send it off the the Browser process.
   // Send only a delta to what we have already sent.
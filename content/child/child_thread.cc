@@ -221,6 +221,8 @@ void ChildThread::Init() {
                            ChildProcess::current()->io_message_loop_proxy(),
                            true,
                            ChildProcess::current()->GetShutDownEvent()));
+  if (CommandLine::ForCurrentProcess()->HasSwitch(switches::kIPCSendBatching))
+    channel_->EnableSendBatching();
 #ifdef IPC_MESSAGE_LOG_ENABLED
   if (!in_browser_process_)
     IPC::Logging::GetInstance()->SetIPCSender(this);
@@ -294,7 +296,7 @@ void ChildThread::Init() {
 #if defined(TCMALLOC_TRACE_MEMORY_SUPPORTED)
   trace_memory_controller_.reset(new base::debug::TraceMemoryController(
       message_loop_->message_loop_proxy(),
-      ::HeapProfilerWithPseudoStackStart,
+      ::HeapProfilerWithPseudoStackStartSampled,
       ::HeapProfilerStop,
       ::GetHeapProfile));
 #endif
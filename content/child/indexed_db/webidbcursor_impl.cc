@@ -4,6 +4,7 @@
 
 #include "content/child/indexed_db/webidbcursor_impl.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "content/child/indexed_db/indexed_db_dispatcher.h"
@@ -127,6 +128,19 @@ void WebIDBCursorImpl::SetPrefetchData(
   prefetch_primary_keys_.assign(primary_keys.begin(), primary_keys.end());
   prefetch_values_.assign(values.begin(), values.end());
 
+  // Keep the next prefetch from returning much more than kMaxPrefetchBytes,
+  // assuming its values are about as large as the ones just received.
+  size_t total_bytes = 0;
+  for (size_t i = 0; i < values.size(); ++i)
+    total_bytes += values[i].size();
+  if (total_bytes) {
+    size_t average_bytes = std::max<size_t>(1, total_bytes / values.size());
+    int limit = static_cast<int>(std::min<size_t>(
+        kMaxPrefetchAmount, kMaxPrefetchBytes / average_bytes));
+    prefetch_amount_ =
+        std::max<int>(kMinPrefetchAmount, std::min(prefetch_amount_, limit));
+  }
+
   used_prefetches_ = 0;
   pending_onsuccess_callbacks_ = 0;
 }
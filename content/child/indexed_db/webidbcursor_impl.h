@@ -55,6 +55,7 @@ class CONTENT_EXPORT WebIDBCursorImpl
   FRIEND_TEST_ALL_PREFIXES(IndexedDBDispatcherTest, CursorTransactionId);
   FRIEND_TEST_ALL_PREFIXES(WebIDBCursorImplTest, AdvancePrefetchTest);
   FRIEND_TEST_ALL_PREFIXES(WebIDBCursorImplTest, PrefetchReset);
+  FRIEND_TEST_ALL_PREFIXES(WebIDBCursorImplTest, PrefetchSizeLimit);
   FRIEND_TEST_ALL_PREFIXES(WebIDBCursorImplTest, PrefetchTest);
 
   int32 ipc_cursor_id_;
@@ -82,7 +83,9 @@ class CONTENT_EXPORT WebIDBCursorImpl
   enum { kInvalidCursorId = -1 };
   enum { kPrefetchContinueThreshold = 2 };
   enum { kMinPrefetchAmount = 5 };
-  enum { kMaxPrefetchAmount = 100 };
+  enum { kMaxPrefetchAmount = 1000 };
+  // Upper bound on the total size of the values requested by one prefetch.
+  enum { kMaxPrefetchBytes = 1024 * 1024 };
 };
 
 }  // namespace content
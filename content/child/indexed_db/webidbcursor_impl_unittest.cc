@@ -312,4 +312,41 @@ TEST_F(WebIDBCursorImplTest, PrefetchReset) {
   EXPECT_EQ(1, dispatcher_->last_used_count());
 }
 
+TEST_F(WebIDBCursorImplTest, PrefetchSizeLimit) {
+  const int64 transaction_id = 1;
+  WebIDBCursorImpl cursor(WebIDBCursorImpl::kInvalidCursorId,
+                          transaction_id,
+                          thread_safe_sender_.get());
+
+  // Call continue() until prefetching should kick in.
+  for (int i = 0; i < WebIDBCursorImpl::kPrefetchContinueThreshold; ++i)
+    cursor.continueFunction(null_key_, new MockContinueCallbacks());
+
+  // Values this large cap the prefetch count at 8.
+  const size_t kValueSize = 128 * 1024;
+  const std::string value_data(kValueSize, 'x');
+  const int kExpectedCounts[] = {
+    WebIDBCursorImpl::kMinPrefetchAmount, 8, 8
+  };
+
+  for (size_t repetition = 0; repetition < arraysize(kExpectedCounts);
+       ++repetition) {
+    // Initiate the prefetch.
+    cursor.continueFunction(null_key_, new MockContinueCallbacks());
+    EXPECT_EQ(static_cast<int>(repetition + 1),
+              dispatcher_->prefetch_calls());
+    int prefetch_count = dispatcher_->last_prefetch_count();
+    EXPECT_EQ(kExpectedCounts[repetition], prefetch_count);
+
+    // Fill the prefetch cache with large values, then use all of it.
+    std::vector<IndexedDBKey> keys(prefetch_count);
+    std::vector<IndexedDBKey> primary_keys(prefetch_count);
+    std::vector<WebData> values(
+        prefetch_count, WebData(value_data.data(), value_data.size()));
+    cursor.SetPrefetchData(keys, primary_keys, values);
+    for (int i = 0; i < prefetch_count; ++i)
+      cursor.continueFunction(null_key_, new MockContinueCallbacks());
+  }
+}
+
 }  // namespace content
@@ -11,6 +11,7 @@
 #include "base/compiler_specific.h"
 #include "base/debug/alias.h"
 #include "base/files/file_path.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/shared_memory.h"
 #include "base/message_loop/message_loop.h"
 #include "base/metrics/histogram.h"
@@ -371,13 +372,15 @@ void ResourceDispatcher::OnReceivedResponse(
 }
 
 void ResourceDispatcher::OnReceivedCachedMetadata(
-      int request_id, const std::vector<char>& data) {
+      int request_id, const scoped_refptr<base::RefCountedMemory>& data) {
   PendingRequestInfo* request_info = GetPendingRequestInfo(request_id);
   if (!request_info)
     return;
 
-  if (data.size())
-    request_info->peer->OnReceivedCachedMetadata(&data.front(), data.size());
+  if (data->size()) {
+    request_info->peer->OnReceivedCachedMetadata(
+        reinterpret_cast<const char*>(data->front()), data->size());
+  }
 }
 
 void ResourceDispatcher::OnSetDataBuffer(int request_id,
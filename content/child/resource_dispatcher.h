@@ -12,6 +12,7 @@
 
 #include "base/containers/hash_tables.h"
 #include "base/memory/linked_ptr.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/shared_memory.h"
 #include "base/memory/weak_ptr.h"
 #include "base/time/time.h"
@@ -22,6 +23,10 @@
 
 struct ResourceMsg_RequestCompleteData;
 
+namespace base {
+class RefCountedMemory;
+}
+
 namespace content {
 class ResourceDispatcherDelegate;
 struct ResourceResponseHead;
@@ -131,7 +136,8 @@ class CONTENT_EXPORT ResourceDispatcher : public IPC::Listener {
       int64 position,
       int64 size);
   void OnReceivedResponse(int request_id, const ResourceResponseHead&);
-  void OnReceivedCachedMetadata(int request_id, const std::vector<char>& data);
+  void OnReceivedCachedMetadata(
+      int request_id, const scoped_refptr<base::RefCountedMemory>& data);
   void OnReceivedRedirect(
       int request_id,
       const GURL& new_url,
@@ -31,12 +31,15 @@ IPC_STRUCT_TRAITS_END()
 
 IPC_STRUCT_TRAITS_BEGIN(tracked_objects::DeathDataSnapshot)
   IPC_STRUCT_TRAITS_MEMBER(count)
+  IPC_STRUCT_TRAITS_MEMBER(timed_count)
   IPC_STRUCT_TRAITS_MEMBER(run_duration_sum)
   IPC_STRUCT_TRAITS_MEMBER(run_duration_max)
   IPC_STRUCT_TRAITS_MEMBER(run_duration_sample)
   IPC_STRUCT_TRAITS_MEMBER(queue_duration_sum)
   IPC_STRUCT_TRAITS_MEMBER(queue_duration_max)
   IPC_STRUCT_TRAITS_MEMBER(queue_duration_sample)
+  IPC_STRUCT_TRAITS_MEMBER(run_duration_sum_of_squares)
+  IPC_STRUCT_TRAITS_MEMBER(queue_duration_sum_of_squares)
 IPC_STRUCT_TRAITS_END()
 
 IPC_STRUCT_TRAITS_BEGIN(tracked_objects::TaskSnapshot)
@@ -97,6 +100,13 @@ IPC_MESSAGE_CONTROL1(ChildProcessMsg_GetChildProfilerData,
 IPC_MESSAGE_CONTROL1(ChildProcessMsg_GetChildHistogramData,
                      int /* sequence_number */)
 
+// Sent to child processes to have the samples of the histograms they create
+// from then on kept in a shared memory segment of |size| bytes, which the
+// browser reads instead of receiving the samples as pickled deltas.
+IPC_MESSAGE_CONTROL2(ChildProcessMsg_SetHistogramMemory,
+                     base::SharedMemoryHandle /* handle */,
+                     uint32 /* size */)
+
 // Sent to child processes to dump their handle table.
 IPC_MESSAGE_CONTROL0(ChildProcessMsg_DumpHandles)
 
@@ -12,6 +12,7 @@
 #include "content/common/gpu/gpu_messages.h"
 #include "content/common/gpu/sync_point_manager.h"
 #include "gpu/command_buffer/service/feature_info.h"
+#include "gpu/command_buffer/service/gpu_scheduler.h"
 #include "gpu/command_buffer/service/gpu_switches.h"
 #include "gpu/command_buffer/service/mailbox_manager.h"
 #include "gpu/command_buffer/service/memory_program_cache.h"
@@ -113,7 +114,9 @@ bool GpuChannelManager::Send(IPC::Message* msg) {
   return gpu_child_thread_->Send(msg);
 }
 
-void GpuChannelManager::OnEstablishChannel(int client_id, bool share_context) {
+void GpuChannelManager::OnEstablishChannel(int client_id,
+                                           bool share_context,
+                                           bool preempts) {
   IPC::ChannelHandle channel_handle;
 
   gfx::GLShareGroup* share_group = NULL;
@@ -138,6 +141,21 @@ void GpuChannelManager::OnEstablishChannel(int client_id, bool share_context) {
     gpu_channels_[client_id] = channel;
     channel_handle.name = channel->GetChannelName();
 
+    // The GpuSchedulers of the preempted channels yield at the next command
+    // boundary while the preempting channel has messages that have been
+    // waiting for too long, so that a busy client can't make the browser
+    // compositor miss frames.
+    if (preempts) {
+      preemption_flag_ = channel->GetPreemptionFlag();
+      for (GpuChannelMap::iterator iter = gpu_channels_.begin();
+           iter != gpu_channels_.end(); ++iter) {
+        if (iter->second.get() != channel.get())
+          iter->second->SetPreemptByFlag(preemption_flag_);
+      }
+    } else if (preemption_flag_.get()) {
+      channel->SetPreemptByFlag(preemption_flag_);
+    }
+
 #if defined(OS_POSIX)
     // On POSIX, pass the renderer-side FD. Also mark it as auto-close so
     // that it gets closed after it has been sent.
@@ -31,6 +31,7 @@ class GLShareGroup;
 }
 
 namespace gpu {
+class PreemptionFlag;
 namespace gles2 {
 class MailboxManager;
 class ProgramCache;
@@ -114,7 +115,7 @@ class GpuChannelManager : public IPC::Listener,
   typedef std::deque<ImageOperation*> ImageOperationQueue;
 
   // Message handlers.
-  void OnEstablishChannel(int client_id, bool share_context);
+  void OnEstablishChannel(int client_id, bool share_context, bool preempts);
   void OnCloseChannel(const IPC::ChannelHandle& channel_handle);
   void OnVisibilityChanged(
       int32 render_view_id, int32 client_id, bool visible);
@@ -144,6 +145,8 @@ class GpuChannelManager : public IPC::Listener,
   // one channel for each renderer process that has connected to this GPU
   // process.
   GpuChannelMap gpu_channels_;
+  // Set by the channel which preempts all the other channels, if any.
+  scoped_refptr<gpu::PreemptionFlag> preemption_flag_;
   scoped_refptr<gfx::GLShareGroup> share_group_;
   scoped_refptr<gpu::gles2::MailboxManager> mailbox_manager_;
   GpuMemoryManager gpu_memory_manager_;
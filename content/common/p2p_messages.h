@@ -43,6 +43,14 @@ IPC_STRUCT_TRAITS_BEGIN(talk_base::PacketOptions)
   IPC_STRUCT_TRAITS_MEMBER(packet_time_params)
 IPC_STRUCT_TRAITS_END()
 
+// A packet received on a UDP socket, as delivered in
+// P2PMsg_OnDataReceivedBatch.
+IPC_STRUCT_BEGIN(P2PMsg_ReceivedPacket)
+  IPC_STRUCT_MEMBER(net::IPEndPoint, socket_address)
+  IPC_STRUCT_MEMBER(std::vector<char>, data)
+  IPC_STRUCT_MEMBER(base::TimeTicks, timestamp)
+IPC_STRUCT_END()
+
 // P2P Socket messages sent from the browser to the renderer.
 
 IPC_MESSAGE_CONTROL1(P2PMsg_NetworkListChanged,
@@ -72,6 +80,12 @@ IPC_MESSAGE_CONTROL4(P2PMsg_OnDataReceived,
                      std::vector<char> /* data */,
                      base::TimeTicks /* timestamp */ )
 
+// Sent instead of P2PMsg_OnDataReceived when a UDP socket has several
+// packets ready at once, so that a burst costs a single IPC.
+IPC_MESSAGE_CONTROL2(P2PMsg_OnDataReceivedBatch,
+                     int /* socket_id */,
+                     std::vector<P2PMsg_ReceivedPacket> /* packets */)
+
 // P2P Socket messages sent from the renderer to the browser.
 
 // Start/stop sending P2PMsg_NetworkListChanged messages when network
@@ -7,6 +7,7 @@
 // NOTE: All messages must send an |int request_id| as their first parameter.
 
 // Multiply-included message file, hence no include guard.
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/shared_memory.h"
 #include "base/process/process.h"
 #include "content/common/content_param_traits_macros.h"
@@ -241,10 +242,11 @@ IPC_MESSAGE_CONTROL2(ResourceMsg_ReceivedResponse,
                      int /* request_id */,
                      content::ResourceResponseHead)
 
-// Sent when cached metadata from a resource request is ready.
+// Sent when cached metadata from a resource request is ready.  The metadata
+// is not copied into the message.
 IPC_MESSAGE_CONTROL2(ResourceMsg_ReceivedCachedMetadata,
                      int /* request_id */,
-                     std::vector<char> /* data */)
+                     scoped_refptr<base::RefCountedMemory> /* data */)
 
 // Sent as upload progress is being made.
 IPC_MESSAGE_CONTROL3(ResourceMsg_UploadProgress,
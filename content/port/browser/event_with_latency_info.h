@@ -5,6 +5,8 @@
 #ifndef CONTENT_PORT_BROWSER_EVENT_WITH_LATENCY_INFO_H_
 #define CONTENT_PORT_BROWSER_EVENT_WITH_LATENCY_INFO_H_
 
+#include <algorithm>
+
 #include "ui/events/latency_info.h"
 
 #include "content/common/input/web_input_event_traits.h"
@@ -39,9 +41,18 @@ class EventWithLatencyInfo {
     // When coalescing two input events, we keep the oldest LatencyInfo
     // for Telemetry latency test since it will represent the longest
     // latency.
+    ui::LatencyInfo coalesced_latency(other.latency);
     if (other.latency.trace_id >= 0 &&
         (latency.trace_id < 0 || other.latency.trace_id < latency.trace_id))
-      latency = other.latency;
+      std::swap(latency, coalesced_latency);
+    // The other LatencyInfo won't reach a terminal component on its own, so
+    // terminate it here to end its trace.
+    if (coalesced_latency.trace_id >= 0 &&
+        coalesced_latency.trace_id != latency.trace_id &&
+        !coalesced_latency.terminated) {
+      coalesced_latency.AddLatencyNumber(
+          ui::INPUT_EVENT_LATENCY_TERMINATED_COALESCED_COMPONENT, 0, 0);
+    }
   }
 };
 
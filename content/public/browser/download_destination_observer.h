@@ -30,6 +30,15 @@ class DownloadDestinationObserver {
   virtual void DestinationError(DownloadInterruptReason reason) = 0;
 
   virtual void DestinationCompleted(const std::string& final_hash) = 0;
+
+  // Asks for the |length| bytes at |offset| of the download to be fetched
+  // with a range request of their own, to be written in parallel with the
+  // data of the other requests.
+  virtual void DestinationRequestsSlice(int64 offset, int64 length) = 0;
+
+  // Called once the destination has all it wants from the request that
+  // fetches the data at |offset|, which may then be cancelled.
+  virtual void DestinationSliceCompleted(int64 offset) = 0;
 };
 
 }  // namespace content
@@ -7,7 +7,7 @@
 namespace content {
 
 DownloadSaveInfo::DownloadSaveInfo()
-    : offset(0), prompt_for_save_location(false) {
+    : offset(0), length(0), prompt_for_save_location(false) {
 }
 
 DownloadSaveInfo::~DownloadSaveInfo() {
@@ -35,6 +35,11 @@ struct CONTENT_EXPORT DownloadSaveInfo {
   // The file offset at which to start the download.  May be 0.
   int64 offset;
 
+  // The number of bytes to download from |offset|, or 0 to download to the
+  // end of the file. Set for the requests that fetch a slice of a download
+  // in parallel with its other requests.
+  int64 length;
+
   // The state of the hash at the start of the download.  May be empty.
   std::string hash_state;
 
@@ -94,6 +94,7 @@ class CONTENT_EXPORT DownloadUrlParameters {
     save_info_.suggested_name = suggested_name;
   }
   void set_offset(int64 offset) { save_info_.offset = offset; }
+  void set_length(int64 length) { save_info_.length = length; }
   void set_hash_state(std::string hash_state) {
     save_info_.hash_state = hash_state;
   }
@@ -131,6 +132,7 @@ class CONTENT_EXPORT DownloadUrlParameters {
     return save_info_.suggested_name;
   }
   int64 offset() const { return save_info_.offset; }
+  int64 length() const { return save_info_.length; }
   const std::string& hash_state() const { return save_info_.hash_state; }
   bool prompt() const { return save_info_.prompt_for_save_location; }
   const GURL& url() const { return url_; }
@@ -30,6 +30,10 @@ class TracingController {
     ENABLE_SYSTRACE = 1 << 0,
     ENABLE_SAMPLING = 1 << 1,
     RECORD_CONTINUOUSLY = 1 << 2,  // For EnableRecording() only.
+    // Writes the result file in the binary format of
+    // base::debug::TraceEventBinaryWriter instead of JSON. Convert it with
+    // tools/tracing/binary_trace_to_json.py.
+    BINARY_FORMAT = 1 << 3,
   };
 
   CONTENT_EXPORT static TracingController* GetInstance();
@@ -500,6 +500,10 @@ const char kEnableOverlayScrollbar[]        = "enable-overlay-scrollbar";
 const char kEnableOverscrollNotifications[] = "enable-overscroll-notifications";
 
 // Enables compositor-accelerated touch-screen pinch gestures.
+// Enables fetching large downloads with several range requests at once, when
+// the server supports them.
+const char kEnableParallelDownloading[]     = "enable-parallel-downloading";
+
 const char kEnablePinch[]                   = "enable-pinch";
 
 // Enable caching of pre-parsed JS script data.  See http://crbug.com/32407.
@@ -514,6 +518,10 @@ const char kEnablePrivilegedWebGLExtensions[] =
 const char kEnablePruneGpuCommandBuffers[] =
     "enable-prune-gpu-command-buffers";
 
+// Makes each raster worker thread run tasks from its own queue, taking tasks
+// from the other queues when it runs out.
+const char kEnableRasterWorkStealing[]      = "enable-raster-work-stealing";
+
 // Enables the CSS multicol implementation that uses the regions implementation.
 const char kEnableRegionBasedColumns[] =
     "enable-region-based-columns";
@@ -539,6 +547,10 @@ const char kEnableSmoothScrolling[]         = "enable-smooth-scrolling";
 // Allow the compositor to use its software implementation if GL fails.
 const char kEnableSoftwareCompositing[]     = "enable-software-compositing";
 
+// Keeps a spare renderer process launched, so that new tabs and navigations
+// needing a new process do not wait for one to start.
+const char kEnableSpareRendererProcess[]    = "enable-spare-renderer-process";
+
 // Enable spatial navigation
 const char kEnableSpatialNavigation[]       = "enable-spatial-navigation";
 
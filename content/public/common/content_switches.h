@@ -150,16 +150,19 @@ CONTENT_EXPORT extern const char kEnableOverlayFullscreenVideo[];
 extern const char kEnableOverlayFullscreenVideoSubtitle[];
 CONTENT_EXPORT extern const char kEnableOverlayScrollbar[];
 CONTENT_EXPORT extern const char kEnableOverscrollNotifications[];
+CONTENT_EXPORT extern const char kEnableParallelDownloading[];
 CONTENT_EXPORT extern const char kEnablePinch[];
 extern const char kEnablePreparsedJsCaching[];
 CONTENT_EXPORT extern const char kEnablePrivilegedWebGLExtensions[];
 extern const char kEnablePruneGpuCommandBuffers[];
+CONTENT_EXPORT extern const char kEnableRasterWorkStealing[];
 CONTENT_EXPORT extern const char kEnableRegionBasedColumns[];
 CONTENT_EXPORT extern const char kEnableRepaintAfterLayout[];
 CONTENT_EXPORT extern const char kEnableSandboxLogging[];
 extern const char kEnableSkiaBenchmarking[];
 CONTENT_EXPORT extern const char kEnableSmoothScrolling[];
 CONTENT_EXPORT extern const char kEnableSoftwareCompositing[];
+CONTENT_EXPORT extern const char kEnableSpareRendererProcess[];
 CONTENT_EXPORT extern const char kEnableSpatialNavigation[];
 CONTENT_EXPORT extern const char kEnableSpeechSynthesis[];
 CONTENT_EXPORT extern const char kEnableStatsTable[];
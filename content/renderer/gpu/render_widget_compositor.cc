@@ -236,6 +236,8 @@ scoped_ptr<RenderWidgetCompositor> RenderWidgetCompositor::Create(
       cmd->HasSwitch(cc::switches::kStrictLayerPropertyChangeChecking);
 
   settings.use_map_image = cc::switches::IsMapImageEnabled();
+  settings.use_compressed_prepaint_tiles =
+      cmd->HasSwitch(cc::switches::kEnableCompressedPrepaintTiles);
 
 #if defined(OS_ANDROID)
   // TODO(danakj): Move these to the android code.
@@ -7,6 +7,7 @@
 #include "base/bind.h"
 #include "base/debug/trace_event.h"
 #include "base/logging.h"
+#include "base/memory/shared_memory.h"
 #include "base/message_loop/message_loop.h"
 #include "cc/resources/texture_mailbox.h"
 #include "content/public/renderer/render_thread.h"
@@ -619,10 +620,6 @@ int32_t PepperGraphics2DHost::OnHostMsgReadImageData(
   return ReadImageData(image, &top_left) ? PP_OK : PP_ERROR_FAILED;
 }
 
-void ReleaseCallback(scoped_ptr<base::SharedMemory> memory,
-                     uint32 sync_point,
-                     bool lost_resource) {}
-
 bool PepperGraphics2DHost::PrepareTextureMailbox(
     cc::TextureMailbox* mailbox,
     scoped_ptr<cc::SingleReleaseCallback>* release_callback) {
@@ -631,21 +628,42 @@ bool PepperGraphics2DHost::PrepareTextureMailbox(
   // TODO(jbauman): Send image_data_ through mailbox to avoid copy.
   gfx::Size pixel_image_size(image_data_->width(), image_data_->height());
   int buffer_size = pixel_image_size.GetArea() * 4;
-  scoped_ptr<base::SharedMemory> memory =
-      RenderThread::Get()->HostAllocateSharedMemoryBuffer(buffer_size);
-  if (!memory || !memory->Map(buffer_size))
-    return false;
+  scoped_ptr<base::SharedMemory> memory;
+  if (!cached_bitmaps_.empty() && cached_bitmap_size_ == pixel_image_size) {
+    memory.reset(cached_bitmaps_.back());
+    cached_bitmaps_.weak_erase(cached_bitmaps_.end() - 1);
+  } else {
+    memory = RenderThread::Get()->HostAllocateSharedMemoryBuffer(buffer_size);
+    if (!memory || !memory->Map(buffer_size))
+      return false;
+  }
   void* src = image_data_->Map();
   memcpy(memory->memory(), src, buffer_size);
   image_data_->Unmap();
 
   *mailbox = cc::TextureMailbox(memory.get(), pixel_image_size);
   *release_callback = cc::SingleReleaseCallback::Create(
-      base::Bind(&ReleaseCallback, base::Passed(&memory)));
+      base::Bind(&PepperGraphics2DHost::ReleaseSoftwareBitmap, AsWeakPtr(),
+                 base::Passed(&memory), pixel_image_size));
   texture_mailbox_modified_ = false;
   return true;
 }
 
+void PepperGraphics2DHost::ReleaseSoftwareBitmap(
+    scoped_ptr<base::SharedMemory> memory,
+    const gfx::Size& bitmap_size,
+    uint32 sync_point,
+    bool lost_resource) {
+  if (lost_resource || !image_data_ ||
+      bitmap_size != gfx::Size(image_data_->width(), image_data_->height()))
+    return;
+  if (cached_bitmap_size_ != bitmap_size) {
+    cached_bitmaps_.clear();
+    cached_bitmap_size_ = bitmap_size;
+  }
+  cached_bitmaps_.push_back(memory.release());
+}
+
 void PepperGraphics2DHost::AttachedToNewLayer() {
   texture_mailbox_modified_ = true;
 }
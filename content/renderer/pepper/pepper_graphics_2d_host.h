@@ -9,6 +9,8 @@
 
 #include "base/basictypes.h"
 #include "base/compiler_specific.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
 #include "base/memory/weak_ptr.h"
 #include "content/common/content_export.h"
 #include "ppapi/c/dev/ppb_graphics_2d_dev.h"
@@ -19,6 +21,10 @@
 #include "ui/gfx/point.h"
 #include "ui/gfx/size.h"
 
+namespace base {
+class SharedMemory;
+}
+
 namespace cc {
 class SingleReleaseCallback;
 class TextureMailbox;
@@ -168,6 +174,14 @@ class CONTENT_EXPORT PepperGraphics2DHost
                                      gfx::Rect* op_rect,
                                      gfx::Point* delta);
 
+  // Called when the compositor is done with a bitmap handed out by
+  // PrepareTextureMailbox(). Keeps |memory| for the next frame if it still
+  // matches the size of |image_data_|.
+  void ReleaseSoftwareBitmap(scoped_ptr<base::SharedMemory> memory,
+                             const gfx::Size& bitmap_size,
+                             uint32 sync_point,
+                             bool lost_resource);
+
   RendererPpapiHost* renderer_ppapi_host_;
 
   scoped_refptr<PPB_ImageData_Impl> image_data_;
@@ -204,6 +218,12 @@ class CONTENT_EXPORT PepperGraphics2DHost
   bool texture_mailbox_modified_;
   bool is_using_texture_layer_;
 
+  // Bitmaps released by the compositor, all of |cached_bitmap_size_|. Reusing
+  // them saves a synchronous shared memory allocation through the browser on
+  // every frame.
+  ScopedVector<base::SharedMemory> cached_bitmaps_;
+  gfx::Size cached_bitmap_size_;
+
   // The offset into the plugin area at which to draw the contents of the
   // graphics context.
   gfx::Point plugin_offset_;
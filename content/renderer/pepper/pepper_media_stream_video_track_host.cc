@@ -110,6 +110,13 @@ void PepperMediaStreamVideoTrackHost::OnVideoFrame(
     const size_t row_bytes = frame->row_bytes(i);
     const size_t src_stride = frame->stride(i);
     int rows = frame->rows(i);
+    if (src_stride == row_bytes) {
+      // The plane has no row padding (as is usual for camera frames), so it
+      // can be copied in one go.
+      memcpy(dst, src, row_bytes * rows);
+      dst += row_bytes * rows;
+      continue;
+    }
     for (int j = 0; j < rows; ++j) {
       memcpy(dst, src, row_bytes);
       dst += row_bytes;
@@ -442,6 +442,9 @@ void RenderThreadImpl::Init() {
     }
   }
 
+  if (command_line.HasSwitch(switches::kEnableRasterWorkStealing))
+    cc::RasterWorkerPool::SetUseWorkStealing(true);
+
   TRACE_EVENT_END_ETW("RenderThreadImpl::Init", 0, "");
 }
 
@@ -664,10 +667,11 @@ void RenderThreadImpl::EnsureWebKitInitialized() {
 #endif
     if (!compositor_message_loop_proxy_.get()) {
       compositor_thread_.reset(new base::Thread("Compositor"));
-      compositor_thread_->Start();
+      base::Thread::Options options;
 #if defined(OS_ANDROID)
-      compositor_thread_->SetPriority(base::kThreadPriority_Display);
+      options.priority = base::kThreadPriority_Display;
 #endif
+      compositor_thread_->StartWithOptions(options);
       compositor_message_loop_proxy_ =
           compositor_thread_->message_loop_proxy();
       compositor_message_loop_proxy_->PostTask(
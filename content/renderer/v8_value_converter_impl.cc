@@ -22,6 +22,21 @@ namespace {
 // For the sake of the storage API, make this quite large.
 const int kMaxRecursionDepth = 100;
 
+// Writes the UTF-8 form of |string| straight into the buffer of the returned
+// value, rather than going through a v8::String::Utf8Value and two copies.
+// Large strings are common in chrome.storage and extension messages.
+base::StringValue* StringValueFromV8String(v8::Handle<v8::String> string) {
+  base::StringValue* result = new base::StringValue(std::string());
+  int length = string->Utf8Length();
+  if (length > 0) {
+    std::string* out = result->GetString();
+    out->resize(length);
+    string->WriteUtf8(&(*out)[0], length, NULL,
+                      v8::String::NO_NULL_TERMINATION);
+  }
+  return result;
+}
+
 }  // namespace
 
 // The state of a call to FromV8Value.
@@ -183,15 +198,14 @@ v8::Handle<v8::Value> V8ValueConverterImpl::ToV8Array(
     const base::ListValue* val) const {
   v8::Handle<v8::Array> result(v8::Array::New(isolate, val->GetSize()));
 
-  for (size_t i = 0; i < val->GetSize(); ++i) {
-    const base::Value* child = NULL;
-    CHECK(val->Get(i, &child));
-
-    v8::Handle<v8::Value> child_v8 = ToV8ValueImpl(isolate, child);
+  uint32 i = 0;
+  for (base::ListValue::const_iterator it = val->begin(); it != val->end();
+       ++it, ++i) {
+    v8::Handle<v8::Value> child_v8 = ToV8ValueImpl(isolate, *it);
     CHECK(!child_v8.IsEmpty());
 
     v8::TryCatch try_catch;
-    result->Set(static_cast<uint32>(i), child_v8);
+    result->Set(i, child_v8);
     if (try_catch.HasCaught())
       LOG(ERROR) << "Setter for index " << i << " threw an exception.";
   }
@@ -258,10 +272,8 @@ base::Value* V8ValueConverterImpl::FromV8ValueImpl(
     return new base::FundamentalValue(val_as_double);
   }
 
-  if (val->IsString()) {
-    v8::String::Utf8Value utf8(val->ToString());
-    return new base::StringValue(std::string(*utf8, utf8.length()));
-  }
+  if (val->IsString())
+    return StringValueFromV8String(val.As<v8::String>());
 
   if (val->IsUndefined())
     // JSON.stringify ignores undefined.
@@ -330,7 +342,8 @@ base::Value* V8ValueConverterImpl::FromV8Array(
   base::ListValue* result = new base::ListValue();
 
   // Only fields with integer keys are carried over to the ListValue.
-  for (uint32 i = 0; i < val->Length(); ++i) {
+  const uint32 length = val->Length();
+  for (uint32 i = 0; i < length; ++i) {
     v8::TryCatch try_catch;
     v8::Handle<v8::Value> child_v8 = val->Get(i);
     if (try_catch.HasCaught()) {
@@ -416,7 +429,8 @@ base::Value* V8ValueConverterImpl::FromV8Object(
   scoped_ptr<base::DictionaryValue> result(new base::DictionaryValue());
   v8::Handle<v8::Array> property_names(val->GetOwnPropertyNames());
 
-  for (uint32 i = 0; i < property_names->Length(); ++i) {
+  const uint32 num_properties = property_names->Length();
+  for (uint32 i = 0; i < num_properties; ++i) {
     v8::Handle<v8::Value> key(property_names->Get(i));
 
     // Extend this test to cover more types as necessary and if sensible.
@@ -0,0 +1,133 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "base/memory/scoped_ptr.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "content/renderer/v8_value_converter_impl.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+#include "v8/include/v8.h"
+
+namespace content {
+
+namespace {
+
+// Every value converted is roughly this large once serialized, like a big
+// chrome.storage item or extension message.
+const size_t kValueSize = 1024 * 1024;
+const int kNumIterations = 10;
+
+// Returns a dictionary of |kValueSize| bytes spread over records of a few
+// small fields each.
+base::Value* CreateRecords() {
+  const std::string kPayload(100, 'x');
+  base::ListValue* records = new base::ListValue();
+  size_t size = 0;
+  for (int i = 0; size < kValueSize; ++i) {
+    base::DictionaryValue* record = new base::DictionaryValue();
+    record->SetInteger("id", i);
+    record->SetDouble("score", i / 3.0);
+    record->SetBoolean("done", i % 2 == 0);
+    record->SetString("name", base::StringPrintf("record %d", i));
+    record->SetString("payload", kPayload);
+    records->Append(record);
+    size += kPayload.size() + 32;
+  }
+  base::DictionaryValue* result = new base::DictionaryValue();
+  result->Set("records", records);
+  return result;
+}
+
+// Returns a list of |kValueSize| bytes worth of integers.
+base::Value* CreateIntegers() {
+  base::ListValue* result = new base::ListValue();
+  for (size_t i = 0; i < kValueSize / sizeof(int); ++i)
+    result->AppendInteger(static_cast<int>(i));
+  return result;
+}
+
+// Returns a single string of |kValueSize| bytes.
+base::Value* CreateString() {
+  return new base::StringValue(std::string(kValueSize, 's'));
+}
+
+}  // namespace
+
+class V8ValueConverterImplPerfTest : public testing::Test {
+ public:
+  V8ValueConverterImplPerfTest()
+      : isolate_(v8::Isolate::GetCurrent()) {
+  }
+
+ protected:
+  virtual void SetUp() {
+    v8::HandleScope handle_scope(isolate_);
+    context_.Reset(isolate_, v8::Context::New(isolate_));
+  }
+
+  virtual void TearDown() {
+    context_.Reset();
+  }
+
+  // Converts |value| to V8 and back |kNumIterations| times and reports the
+  // distribution of the throughput of each direction.
+  void MeasureRoundTrip(const base::Value& value, const std::string& trace) {
+    v8::HandleScope handle_scope(isolate_);
+    v8::Local<v8::Context> context =
+        v8::Local<v8::Context>::New(isolate_, context_);
+    V8ValueConverterImpl converter;
+
+    const double megabytes = kValueSize / (1024.0 * 1024.0);
+    std::vector<double> to_v8_throughput;
+    std::vector<double> from_v8_throughput;
+    for (int i = 0; i < kNumIterations; ++i) {
+      v8::HandleScope iteration_scope(isolate_);
+
+      base::TimeTicks start = base::TimeTicks::HighResNow();
+      v8::Handle<v8::Value> v8_value = converter.ToV8Value(&value, context);
+      base::TimeTicks converted = base::TimeTicks::HighResNow();
+      scoped_ptr<base::Value> result(
+          converter.FromV8Value(v8_value, context));
+      base::TimeTicks end = base::TimeTicks::HighResNow();
+
+      ASSERT_TRUE(result.get());
+      to_v8_throughput.push_back(
+          megabytes / (converted - start).InSecondsF());
+      from_v8_throughput.push_back(
+          megabytes / (end - converted).InSecondsF());
+    }
+
+    perf_test::PrintResultSummary("v8_value_converter_to_v8", "", trace,
+                                  to_v8_throughput, "MB/s", true);
+    perf_test::PrintResultSummary("v8_value_converter_from_v8", "", trace,
+                                  from_v8_throughput, "MB/s", true);
+  }
+
+  v8::Isolate* isolate_;
+
+  // Context for the JavaScript in the test.
+  v8::Persistent<v8::Context> context_;
+};
+
+TEST_F(V8ValueConverterImplPerfTest, Records) {
+  scoped_ptr<base::Value> value(CreateRecords());
+  MeasureRoundTrip(*value, "records");
+}
+
+TEST_F(V8ValueConverterImplPerfTest, Integers) {
+  scoped_ptr<base::Value> value(CreateIntegers());
+  MeasureRoundTrip(*value, "integers");
+}
+
+TEST_F(V8ValueConverterImplPerfTest, String) {
+  scoped_ptr<base::Value> value(CreateString());
+  MeasureRoundTrip(*value, "string");
+}
+
+}  // namespace content
@@ -41,6 +41,8 @@
 #include "crypto/nss_util.h"
 #include "sandbox/linux/services/libc_urandom_override.h"
 #include "sandbox/linux/suid/client/setuid_sandbox_client.h"
+#include "third_party/icu/source/common/unicode/brkiter.h"
+#include "third_party/icu/source/common/unicode/locid.h"
 #include "third_party/icu/source/i18n/unicode/timezone.h"
 #include "third_party/skia/include/ports/SkFontConfigInterface.h"
 
@@ -304,6 +306,20 @@ static void PreSandboxInit() {
   // cached and there's no more need to access the file system.
   scoped_ptr<icu::TimeZone> zone(icu::TimeZone::createDefault());
 
+  // Every renderer creates word and line break iterators for the default
+  // locale early on. Doing it once here loads the locale's resource bundles
+  // into ICU's caches in the zygote, so renderers share those pages
+  // copy-on-write instead of each dirtying its own copy.
+  UErrorCode status = U_ZERO_ERROR;
+  scoped_ptr<icu::BreakIterator> word_iterator(
+      icu::BreakIterator::createWordInstance(icu::Locale::getDefault(),
+                                             status));
+  scoped_ptr<icu::BreakIterator> line_iterator(
+      icu::BreakIterator::createLineInstance(icu::Locale::getDefault(),
+                                             status));
+  DLOG_IF(WARNING, U_FAILURE(status)) << "Unable to warm up ICU break "
+                                         "iterators: " << u_errorName(status);
+
 #if defined(USE_NSS)
   // NSS libraries are loaded before sandbox is activated. This is to allow
   // successful initialization of NSS which tries to load extra library files.
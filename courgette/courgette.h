@@ -84,6 +84,17 @@ Status ApplyEnsemblePatch(const base::FilePath::CharType* old_file_name,
                           const base::FilePath::CharType* patch_file_name,
                           const base::FilePath::CharType* new_file_name);
 
+// Like the above, for devices that are short of memory.  The elements are
+// transformed one at a time unless more of them fit in |memory_limit| bytes,
+// and the old and patch files are unmapped before the new file is written.
+// The peak heap usage is then about the size of the new file plus the
+// reformed ensemble plus one transformed element.
+Status ApplyEnsemblePatchWithMemoryLimit(
+    const base::FilePath::CharType* old_file_name,
+    const base::FilePath::CharType* patch_file_name,
+    const base::FilePath::CharType* new_file_name,
+    size_t memory_limit);
+
 // Generates a patch that will transform the bytes in |old| into the bytes in
 // |target|.
 // Returns C_OK unless something when wrong (unexpected).
@@ -14,6 +14,7 @@
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/time/time.h"
 #include "courgette/courgette.h"
 #include "courgette/streams.h"
 #include "courgette/third_party/bsdiff.h"
@@ -28,6 +29,7 @@ void PrintHelp() {
     "  courgette -disadj <executable_file> <reference> <binary_assembly_file>\n"
     "  courgette -gen <v1> <v2> <patch>\n"
     "  courgette -apply <v1> <patch> <v2>\n"
+    "  courgette -apply -memory-limit=<bytes> <v1> <patch> <v2>\n"
     "\n");
 }
 
@@ -310,8 +312,11 @@ void Assemble(const base::FilePath& input_file,
 void GenerateEnsemblePatch(const base::FilePath& old_file,
                            const base::FilePath& new_file,
                            const base::FilePath& patch_file) {
+  base::Time start_read_time = base::Time::Now();
   std::string old_buffer = ReadOrFail(old_file, "'old' input");
   std::string new_buffer = ReadOrFail(new_file, "'new' input");
+  VLOG(1) << "done reading inputs "
+          << (base::Time::Now() - start_read_time).InSecondsF() << "s";
 
   courgette::SourceStream old_stream;
   courgette::SourceStream new_stream;
@@ -324,23 +329,39 @@ void GenerateEnsemblePatch(const base::FilePath& old_file,
 
   if (status != courgette::C_OK) Problem("-gen failed.");
 
+  base::Time start_write_time = base::Time::Now();
   WriteSinkToFile(&patch_stream, patch_file);
+  VLOG(1) << "done writing patch "
+          << (base::Time::Now() - start_write_time).InSecondsF() << "s";
 }
 
 void ApplyEnsemblePatch(const base::FilePath& old_file,
                         const base::FilePath& patch_file,
-                        const base::FilePath& new_file) {
+                        const base::FilePath& new_file,
+                        size_t memory_limit) {
   // We do things a little differently here in order to call the same Courgette
   // entry point as the installer.  That entry point point takes file names and
   // returns an status code but does not output any diagnostics.
 
-  courgette::Status status =
-      courgette::ApplyEnsemblePatch(old_file.value().c_str(),
-                                    patch_file.value().c_str(),
-                                    new_file.value().c_str());
+  base::Time start_time = base::Time::Now();
+  courgette::Status status;
+  if (memory_limit > 0) {
+    status = courgette::ApplyEnsemblePatchWithMemoryLimit(
+        old_file.value().c_str(),
+        patch_file.value().c_str(),
+        new_file.value().c_str(),
+        memory_limit);
+  } else {
+    status = courgette::ApplyEnsemblePatch(old_file.value().c_str(),
+                                           patch_file.value().c_str(),
+                                           new_file.value().c_str());
+  }
 
-  if (status == courgette::C_OK)
+  if (status == courgette::C_OK) {
+    VLOG(1) << "done ApplyEnsemblePatch "
+            << (base::Time::Now() - start_time).InSecondsF() << "s";
     return;
+  }
 
   // Diagnose the error.
   switch (status) {
@@ -460,6 +481,15 @@ int main(int argc, const char* argv[]) {
     if (!base::StringToInt(repeat_switch, &repeat_count))
       repeat_count = 1;
 
+  // '-memory-limit=N' applies with elements transformed within N bytes, to
+  // check the peak memory use of a low-memory device.
+  size_t memory_limit = 0;
+  std::string memory_limit_switch =
+      command_line.GetSwitchValueASCII("memory-limit");
+  if (!memory_limit_switch.empty())
+    if (!base::StringToSizeT(memory_limit_switch, &memory_limit))
+      UsageProblem("-memory-limit=<bytes>");
+
   if (cmd_sup + cmd_dis + cmd_asm + cmd_disadj + cmd_make_patch +
       cmd_apply_patch + cmd_make_bsdiff_patch + cmd_apply_bsdiff_patch +
       cmd_spread_1_adjusted + cmd_spread_1_unadjusted
@@ -493,7 +523,7 @@ int main(int argc, const char* argv[]) {
     } else if (cmd_apply_patch) {
       if (values.size() != 3)
         UsageProblem("-apply <old_file> <patch_file> <new_file>");
-      ApplyEnsemblePatch(values[0], values[1], values[2]);
+      ApplyEnsemblePatch(values[0], values[1], values[2], memory_limit);
     } else if (cmd_make_bsdiff_patch) {
       if (values.size() != 3)
         UsageProblem("-genbsdiff <old_file> <new_file> <patch_file>");
@@ -4,8 +4,11 @@
 
 #include "courgette/ensemble.h"
 
+#include <algorithm>
+
 #include "base/basictypes.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/sys_info.h"
 
 #include "courgette/region.h"
 #include "courgette/simple_delta.h"
@@ -13,6 +16,9 @@
 
 namespace courgette {
 
+// Upper bound on the memory taken by the elements transformed at once.
+static const uint64 kTransformMemoryBudget = 512 * 1024 * 1024;
+
 Element::Element(ExecutableType kind,
                  Ensemble* ensemble,
                  const Region& region)
@@ -63,4 +69,12 @@ Ensemble::~Ensemble() {
     delete owned_elements_[i];
 }
 
+int TransformThreadCount(size_t element_count, uint64 bytes_per_element) {
+  uint64 threads = base::SysInfo::NumberOfProcessors();
+  threads = std::min(threads, static_cast<uint64>(element_count));
+  if (bytes_per_element > 0)
+    threads = std::min(threads, kTransformMemoryBudget / bytes_per_element);
+  return std::max(static_cast<int>(threads), 1);
+}
+
 }  // namespace
@@ -91,6 +91,12 @@ inline size_t Element::offset_in_ensemble() const {
   return region().start() - ensemble_->region().start();
 }
 
+// Returns how many of |element_count| elements to transform at once when
+// transforming one element can take up to |bytes_per_element| bytes.  This is
+// at most the number of processors, and small enough that the elements being
+// transformed together stay within a fixed memory budget.
+int TransformThreadCount(size_t element_count, uint64 bytes_per_element);
+
 // The 'CourgettePatchFile' is class is a 'namespace' for the constants that
 // appear in a Courgette patch file.
 struct CourgettePatchFile {
@@ -179,6 +185,10 @@ class TransformationPatcher {
   // original representation.
   virtual Status Reform(SourceStreamSet* transformed_element,
                         SinkStream* reformed_element) = 0;
+
+  // Returns the length of the element in the original ensemble.  Valid after
+  // Init.  Used to bound the memory taken by concurrent Transform steps.
+  virtual size_t ElementLength() = 0;
 };
 
 // TransformationPatchGenerator is the interface which abstracts out the actual
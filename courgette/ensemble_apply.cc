@@ -6,10 +6,16 @@
 
 #include "courgette/ensemble.h"
 
+#include <algorithm>
+
 #include "base/basictypes.h"
 #include "base/file_util.h"
 #include "base/files/memory_mapped_file.h"
 #include "base/logging.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
+#include "base/threading/simple_thread.h"
+#include "base/time/time.h"
 #include "courgette/crc.h"
 #include "courgette/region.h"
 #include "courgette/streams.h"
@@ -18,6 +24,41 @@
 
 namespace courgette {
 
+namespace {
+
+// Rough number of bytes of disassembled and encoded program that transforming
+// an element takes per byte of the element.
+const uint64 kTransformMemoryPerByte = 16;
+
+// Runs the Transform step of one patcher.  Elements are independent, so jobs
+// for different patchers can run on different threads.
+class TransformJob : public base::DelegateSimpleThread::Delegate {
+ public:
+  explicit TransformJob(TransformationPatcher* patcher)
+      : patcher_(patcher), status_(C_OK) {
+  }
+
+  virtual void Run() OVERRIDE {
+    status_ = patcher_->Transform(&parameters_, &transformed_element_);
+    if (status_ == C_OK && !parameters_.Empty())
+      status_ = C_STREAM_NOT_CONSUMED;
+  }
+
+  SourceStreamSet* parameters() { return &parameters_; }
+  SinkStreamSet* transformed_element() { return &transformed_element_; }
+  Status status() const { return status_; }
+
+ private:
+  TransformationPatcher* patcher_;
+  SourceStreamSet parameters_;
+  SinkStreamSet transformed_element_;
+  Status status_;
+
+  DISALLOW_COPY_AND_ASSIGN(TransformJob);
+};
+
+}  // namespace
+
 // EnsemblePatchApplication is all the logic and data required to apply the
 // multi-stage patch.
 class EnsemblePatchApplication {
@@ -53,6 +94,10 @@ class EnsemblePatchApplication {
                              SourceStream* correction,
                              SinkStream* corrected_ensemble);
 
+  // Bounds the memory taken by the elements transformed at once by TransformUp
+  // to |memory_limit| bytes.  Zero means the default budget.
+  void set_memory_limit(size_t memory_limit) { memory_limit_ = memory_limit; }
+
  private:
   Status SubpatchStreamSets(SinkStreamSet* predicted_items,
                             SourceStream* correction,
@@ -64,6 +109,7 @@ class EnsemblePatchApplication {
   uint32 source_checksum_;
   uint32 target_checksum_;
   uint32 final_patch_input_size_prediction_;
+  size_t memory_limit_;
 
   std::vector<TransformationPatcher*> patchers_;
 
@@ -75,7 +121,7 @@ class EnsemblePatchApplication {
 
 EnsemblePatchApplication::EnsemblePatchApplication()
     : source_checksum_(0), target_checksum_(0),
-      final_patch_input_size_prediction_(0) {
+      final_patch_input_size_prediction_(0), memory_limit_(0) {
 }
 
 EnsemblePatchApplication::~EnsemblePatchApplication() {
@@ -199,23 +245,45 @@ Status EnsemblePatchApplication::SubpatchTransformParameters(
 Status EnsemblePatchApplication::TransformUp(
     SourceStreamSet* parameters,
     SinkStreamSet* transformed_elements) {
+  ScopedVector<TransformJob> jobs;
+  size_t longest_element = 0;
   for (size_t i = 0;  i < patchers_.size();  ++i) {
-    SourceStreamSet single_parameters;
-    if (!parameters->ReadSet(&single_parameters))
-      return C_STREAM_ERROR;
-    SinkStreamSet single_transformed_element;
-    Status status = patchers_[i]->Transform(&single_parameters,
-                                            &single_transformed_element);
-    if (status != C_OK)
-      return status;
-    if (!single_parameters.Empty())
-      return C_STREAM_NOT_CONSUMED;
-    if (!transformed_elements->WriteSet(&single_transformed_element))
+    jobs.push_back(new TransformJob(patchers_[i]));
+    if (!parameters->ReadSet(jobs.back()->parameters()))
       return C_STREAM_ERROR;
+    longest_element = std::max(longest_element, patchers_[i]->ElementLength());
   }
 
   if (!parameters->Empty())
     return C_STREAM_NOT_CONSUMED;
+
+  uint64 bytes_per_element = kTransformMemoryPerByte * longest_element;
+  int thread_count = TransformThreadCount(jobs.size(), bytes_per_element);
+  if (memory_limit_ > 0 && bytes_per_element > 0) {
+    thread_count = std::max(1, static_cast<int>(std::min<uint64>(
+        thread_count, memory_limit_ / bytes_per_element)));
+  }
+  if (thread_count > 1) {
+    base::DelegateSimpleThreadPool pool("CourgetteTransform", thread_count);
+    for (size_t i = 0;  i < jobs.size();  ++i)
+      pool.AddWork(jobs[i]);
+    pool.Start();
+    pool.JoinAll();
+  } else {
+    for (size_t i = 0;  i < jobs.size();  ++i)
+      jobs[i]->Run();
+  }
+
+  // Written in patcher order so the output matches what the generator wrote.
+  for (size_t i = 0;  i < jobs.size();  ++i) {
+    if (jobs[i]->status() != C_OK)
+      return jobs[i]->status();
+    if (!transformed_elements->WriteSet(jobs[i]->transformed_element()))
+      return C_STREAM_ERROR;
+  }
+  // The jobs have consumed all the parameters, so the storage to which they
+  // referred can be freed.
+  corrected_parameters_storage_.Retire();
   return C_OK;
 }
 
@@ -304,11 +372,15 @@ Status EnsemblePatchApplication::SubpatchStreamSets(
   return C_OK;
 }
 
-Status ApplyEnsemblePatch(SourceStream* base,
-                          SourceStream* patch,
-                          SinkStream* output) {
+// Applies |patch| to |base|, writing to |output|.  Each stage's storage is
+// released as soon as the next stage has consumed it.
+static Status ApplyEnsemblePatchToStreams(SourceStream* base,
+                                          SourceStream* patch,
+                                          SinkStream* output,
+                                          size_t memory_limit) {
   Status status;
   EnsemblePatchApplication patch_process;
+  patch_process.set_memory_limit(memory_limit);
 
   status = patch_process.ReadHeader(patch);
   if (status != C_OK)
@@ -346,13 +418,18 @@ Status ApplyEnsemblePatch(SourceStream* base,
                                                      &corrected_parameters);
   if (status != C_OK)
     return status;
+  predicted_parameters.Retire();
 
+  base::Time start_transform_time = base::Time::Now();
   SinkStreamSet transformed_elements;
   status = patch_process.TransformUp(&corrected_parameters,
                                      &transformed_elements);
   if (status != C_OK)
     return status;
+  VLOG(1) << "done transform "
+          << (base::Time::Now() - start_transform_time).InSecondsF() << "s";
 
+  base::Time start_elements_delta_time = base::Time::Now();
   SourceStreamSet corrected_transformed_elements;
   status = patch_process.SubpatchTransformedElements(
           &transformed_elements,
@@ -360,37 +437,59 @@ Status ApplyEnsemblePatch(SourceStream* base,
           &corrected_transformed_elements);
   if (status != C_OK)
     return status;
+  transformed_elements.Retire();
+  VLOG(1) << "done transformed elements delta "
+          << (base::Time::Now() - start_elements_delta_time).InSecondsF()
+          << "s";
 
+  base::Time start_reform_time = base::Time::Now();
   SinkStream original_ensemble_and_corrected_base_elements;
   status = patch_process.TransformDown(
       &corrected_transformed_elements,
       &original_ensemble_and_corrected_base_elements);
   if (status != C_OK)
     return status;
+  VLOG(1) << "done reform "
+          << (base::Time::Now() - start_reform_time).InSecondsF() << "s";
 
+  base::Time start_ensemble_delta_time = base::Time::Now();
   SourceStream final_patch_prediction;
   final_patch_prediction.Init(original_ensemble_and_corrected_base_elements);
   status = patch_process.SubpatchFinalOutput(&final_patch_prediction,
                                              ensemble_correction, output);
   if (status != C_OK)
     return status;
+  VLOG(1) << "done ensemble delta "
+          << (base::Time::Now() - start_ensemble_delta_time).InSecondsF()
+          << "s";
 
   return C_OK;
 }
 
-Status ApplyEnsemblePatch(const base::FilePath::CharType* old_file_name,
-                          const base::FilePath::CharType* patch_file_name,
-                          const base::FilePath::CharType* new_file_name) {
+Status ApplyEnsemblePatch(SourceStream* base,
+                          SourceStream* patch,
+                          SinkStream* output) {
+  return ApplyEnsemblePatchToStreams(base, patch, output, 0);
+}
+
+// Applies the patch in |patch_file_name| to |old_file_name|, writing to
+// |new_file_name|.  Both inputs are memory-mapped, and are unmapped before the
+// new file is written.
+static Status ApplyEnsemblePatchToFiles(
+    const base::FilePath::CharType* old_file_name,
+    const base::FilePath::CharType* patch_file_name,
+    const base::FilePath::CharType* new_file_name,
+    size_t memory_limit) {
   // First read enough of the patch file to validate the header is well-formed.
   // A few varint32 numbers should fit in 100.
   base::FilePath patch_file_path(patch_file_name);
-  base::MemoryMappedFile patch_file;
-  if (!patch_file.Initialize(patch_file_path))
+  scoped_ptr<base::MemoryMappedFile> patch_file(new base::MemoryMappedFile);
+  if (!patch_file->Initialize(patch_file_path))
     return C_READ_OPEN_ERROR;
 
   // 'Dry-run' the first step of the patch process to validate format of header.
   SourceStream patch_header_stream;
-  patch_header_stream.Init(patch_file.data(), patch_file.length());
+  patch_header_stream.Init(patch_file->data(), patch_file->length());
   EnsemblePatchApplication patch_process;
   Status status = patch_process.ReadHeader(&patch_header_stream);
   if (status != C_OK)
@@ -398,21 +497,27 @@ Status ApplyEnsemblePatch(const base::FilePath::CharType* old_file_name,
 
   // Read the old_file.
   base::FilePath old_file_path(old_file_name);
-  base::MemoryMappedFile old_file;
-  if (!old_file.Initialize(old_file_path))
+  scoped_ptr<base::MemoryMappedFile> old_file(new base::MemoryMappedFile);
+  if (!old_file->Initialize(old_file_path))
     return C_READ_ERROR;
 
   // Apply patch on streams.
   SourceStream old_source_stream;
   SourceStream patch_source_stream;
-  old_source_stream.Init(old_file.data(), old_file.length());
-  patch_source_stream.Init(patch_file.data(), patch_file.length());
+  old_source_stream.Init(old_file->data(), old_file->length());
+  patch_source_stream.Init(patch_file->data(), patch_file->length());
   SinkStream new_sink_stream;
-  status = ApplyEnsemblePatch(&old_source_stream, &patch_source_stream,
-                              &new_sink_stream);
+  status = ApplyEnsemblePatchToStreams(&old_source_stream,
+                                       &patch_source_stream,
+                                       &new_sink_stream,
+                                       memory_limit);
   if (status != C_OK)
     return status;
 
+  // Nothing refers to the inputs any more.
+  old_file.reset();
+  patch_file.reset();
+
   // Write the patched data to |new_file_name|.
   base::FilePath new_file_path(new_file_name);
   int written =
@@ -428,4 +533,20 @@ Status ApplyEnsemblePatch(const base::FilePath::CharType* old_file_name,
   return C_OK;
 }
 
+Status ApplyEnsemblePatch(const base::FilePath::CharType* old_file_name,
+                          const base::FilePath::CharType* patch_file_name,
+                          const base::FilePath::CharType* new_file_name) {
+  return ApplyEnsemblePatchToFiles(old_file_name, patch_file_name,
+                                   new_file_name, 0);
+}
+
+Status ApplyEnsemblePatchWithMemoryLimit(
+    const base::FilePath::CharType* old_file_name,
+    const base::FilePath::CharType* patch_file_name,
+    const base::FilePath::CharType* new_file_name,
+    size_t memory_limit) {
+  return ApplyEnsemblePatchToFiles(old_file_name, patch_file_name,
+                                   new_file_name, memory_limit);
+}
+
 }  // namespace
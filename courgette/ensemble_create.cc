@@ -14,11 +14,14 @@
 
 #include "courgette/ensemble.h"
 
+#include <algorithm>
 #include <limits>
 #include <vector>
 
 #include "base/basictypes.h"
 #include "base/logging.h"
+#include "base/memory/scoped_vector.h"
+#include "base/threading/simple_thread.h"
 #include "base/time/time.h"
 
 #include "courgette/crc.h"
@@ -238,6 +241,58 @@ void FreeGenerators(std::vector<TransformationPatchGenerator*>* generators) {
   generators->clear();
 }
 
+namespace {
+
+// Rough number of bytes of disassembled, adjusted and encoded programs that
+// transforming an element takes per byte of the old and new elements.
+const uint64 kTransformMemoryPerByte = 16;
+
+// Runs the Transform step of one generator, which disassembles, adjusts and
+// encodes its pair of elements.  The elements are independent, so jobs for
+// different generators can run on different threads.
+class TransformJob : public base::DelegateSimpleThread::Delegate {
+ public:
+  explicit TransformJob(TransformationPatchGenerator* generator)
+      : generator_(generator), status_(C_OK) {
+  }
+
+  virtual void Run() OVERRIDE {
+    status_ = generator_->Transform(&parameters_,
+                                    &predicted_transformed_element_,
+                                    &corrected_transformed_element_);
+    if (status_ == C_OK && !parameters_.Empty())
+      status_ = C_STREAM_NOT_CONSUMED;
+  }
+
+  SourceStreamSet* parameters() { return &parameters_; }
+  SinkStreamSet* predicted_transformed_element() {
+    return &predicted_transformed_element_;
+  }
+  SinkStreamSet* corrected_transformed_element() {
+    return &corrected_transformed_element_;
+  }
+  Status status() const { return status_; }
+
+ private:
+  TransformationPatchGenerator* generator_;
+  SourceStreamSet parameters_;
+  SinkStreamSet predicted_transformed_element_;
+  SinkStreamSet corrected_transformed_element_;
+  Status status_;
+
+  DISALLOW_COPY_AND_ASSIGN(TransformJob);
+};
+
+// Returns the length of the longest element in |ensemble|.
+size_t LongestElementLength(Ensemble* ensemble) {
+  size_t longest = 0;
+  for (size_t i = 0;  i < ensemble->elements().size();  ++i)
+    longest = std::max(longest, ensemble->elements()[i]->region().length());
+  return longest;
+}
+
+}  // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Status GenerateEnsemblePatch(SourceStream* base,
@@ -283,6 +338,7 @@ Status GenerateEnsemblePatch(SourceStream* base,
   //
   // Generate sub-patch for parameters.
   //
+  base::Time start_parameters_time = base::Time::Now();
   SinkStreamSet predicted_parameters_sink;
   SinkStreamSet corrected_parameters_sink;
 
@@ -323,43 +379,66 @@ Status GenerateEnsemblePatch(SourceStream* base,
                                              parameter_correction);
   if (delta1_status != C_OK)
     return delta1_status;
+  VLOG(1) << "done parameters "
+          << (base::Time::Now() - start_parameters_time).InSecondsF() << "s";
 
   //
   // Generate sub-patch for elements.
   //
+  base::Time start_transform_time = base::Time::Now();
   corrected_parameters_source.Init(linearized_corrected_parameters);
   SourceStreamSet corrected_parameters_source_set;
   if (!corrected_parameters_source_set.Init(&corrected_parameters_source))
     return C_STREAM_ERROR;
 
+  // The parameters are read here, in order, so that the jobs only touch
+  // their own streams.
+  ScopedVector<TransformJob> jobs;
+  for (size_t i = 0;  i < number_of_transformations;  ++i) {
+    jobs.push_back(new TransformJob(generators[i]));
+    if (!corrected_parameters_source_set.ReadSet(jobs.back()->parameters()))
+      return C_STREAM_ERROR;
+  }
+
+  if (!corrected_parameters_source_set.Empty())
+    return C_STREAM_NOT_CONSUMED;
+
+  uint64 bytes_per_element = kTransformMemoryPerByte *
+      (LongestElementLength(&old_ensemble) +
+       LongestElementLength(&new_ensemble));
+  int thread_count = TransformThreadCount(jobs.size(), bytes_per_element);
+  if (thread_count > 1) {
+    base::DelegateSimpleThreadPool pool("CourgetteTransform", thread_count);
+    for (size_t i = 0;  i < jobs.size();  ++i)
+      pool.AddWork(jobs[i]);
+    pool.Start();
+    pool.JoinAll();
+  } else {
+    for (size_t i = 0;  i < jobs.size();  ++i)
+      jobs[i]->Run();
+  }
+
+  // The transformed elements are written in generator order, whatever order
+  // the jobs finished in, so the patch does not depend on the thread count.
   SinkStreamSet predicted_transformed_elements;
   SinkStreamSet corrected_transformed_elements;
 
-  for (size_t i = 0;  i < number_of_transformations;  ++i) {
-    SourceStreamSet single_parameters;
-    if (!corrected_parameters_source_set.ReadSet(&single_parameters))
-      return C_STREAM_ERROR;
-    SinkStreamSet single_predicted_transformed_element;
-    SinkStreamSet single_corrected_transformed_element;
-    Status status = generators[i]->Transform(
-        &single_parameters,
-        &single_predicted_transformed_element,
-        &single_corrected_transformed_element);
-    if (status != C_OK)
-      return status;
-    if (!single_parameters.Empty())
-      return C_STREAM_NOT_CONSUMED;
+  for (size_t i = 0;  i < jobs.size();  ++i) {
+    if (jobs[i]->status() != C_OK)
+      return jobs[i]->status();
     if (!predicted_transformed_elements.WriteSet(
-            &single_predicted_transformed_element))
+            jobs[i]->predicted_transformed_element()))
       return C_STREAM_ERROR;
     if (!corrected_transformed_elements.WriteSet(
-            &single_corrected_transformed_element))
+            jobs[i]->corrected_transformed_element()))
       return C_STREAM_ERROR;
   }
+  jobs.clear();
+  VLOG(1) << "done transform of " << number_of_transformations
+          << " elements on " << thread_count << " threads "
+          << (base::Time::Now() - start_transform_time).InSecondsF() << "s";
 
-  if (!corrected_parameters_source_set.Empty())
-    return C_STREAM_NOT_CONSUMED;
-
+  base::Time start_elements_delta_time = base::Time::Now();
   SinkStream linearized_predicted_transformed_elements;
   SinkStream linearized_corrected_transformed_elements;
 
@@ -386,10 +465,14 @@ Status GenerateEnsemblePatch(SourceStream* base,
 
   // Last use, free storage.
   linearized_predicted_transformed_elements.Retire();
+  VLOG(1) << "done transformed elements delta "
+          << (base::Time::Now() - start_elements_delta_time).InSecondsF()
+          << "s";
 
   //
   // Generate sub-patch for whole enchilada.
   //
+  base::Time start_reform_time = base::Time::Now();
   SinkStream predicted_ensemble;
 
   if (!predicted_ensemble.Write(base->Buffer(), base->Remaining()))
@@ -422,7 +505,10 @@ Status GenerateEnsemblePatch(SourceStream* base,
   linearized_corrected_transformed_elements.Retire();
 
   FreeGenerators(&generators);
+  VLOG(1) << "done reform "
+          << (base::Time::Now() - start_reform_time).InSecondsF() << "s";
 
+  base::Time start_ensemble_delta_time = base::Time::Now();
   size_t final_patch_input_size = predicted_ensemble.Length();
   SourceStream predicted_ensemble_source;
   predicted_ensemble_source.Init(predicted_ensemble);
@@ -431,6 +517,9 @@ Status GenerateEnsemblePatch(SourceStream* base,
                                              ensemble_correction);
   if (delta3_status != C_OK)
     return delta3_status;
+  VLOG(1) << "done ensemble delta "
+          << (base::Time::Now() - start_ensemble_delta_time).InSecondsF()
+          << "s";
 
   //
   // Final output stream has a header followed by a StreamSet.
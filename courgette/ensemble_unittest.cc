@@ -2,8 +2,12 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+
+#include "base/sys_info.h"
 #include "courgette/base_test_unittest.h"
 #include "courgette/courgette.h"
+#include "courgette/ensemble.h"
 #include "courgette/streams.h"
 
 class EnsembleTest : public BaseTest {
@@ -117,3 +121,14 @@ TEST_F(EnsembleTest, DISABLED_PE64) {
 TEST_F(EnsembleTest, DISABLED_Elf32) {
   Elf32Ensemble();
 }
+
+TEST_F(EnsembleTest, TransformThreadCount) {
+  int processors = base::SysInfo::NumberOfProcessors();
+  EXPECT_EQ(1, courgette::TransformThreadCount(0, 0));
+  EXPECT_EQ(1, courgette::TransformThreadCount(1, 0));
+  EXPECT_EQ(std::min(processors, 3), courgette::TransformThreadCount(3, 0));
+  EXPECT_EQ(std::min(processors, 2),
+            courgette::TransformThreadCount(100, 256 * 1024 * 1024));
+  // An element too large for the budget on its own still gets a thread.
+  EXPECT_EQ(1, courgette::TransformThreadCount(100, 4096ULL * 1024 * 1024));
+}
@@ -90,6 +90,10 @@ class PatcherX86_32 : public TransformationPatcher {
     return C_OK;
   }
 
+  size_t ElementLength() {
+    return base_length_;
+  }
+
  private:
   Region ensemble_region_;
 
@@ -327,6 +327,11 @@ void SinkStreamSet::Init(size_t stream_index_limit) {
   count_ = stream_index_limit;
 }
 
+void SinkStreamSet::Retire() {
+  for (size_t i = 0;  i < count_;  ++i)
+    streams_[i].Retire();
+}
+
 // The header for a stream set for N streams is serialized as
 //   <version><N><length1><length2>...<lengthN>
 CheckBool SinkStreamSet::CopyHeaderTo(SinkStream* header) {
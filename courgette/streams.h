@@ -223,6 +223,9 @@ class SinkStreamSet {
   // Partner to SourceStreamSet::ReadSet.
   CheckBool WriteSet(SinkStreamSet* set) WARN_UNUSED_RESULT;
 
+  // Finished with all the streams and any storage they have.
+  void Retire();
+
  private:
   CheckBool CopyHeaderTo(SinkStream* stream) WARN_UNUSED_RESULT;
 
@@ -201,3 +201,19 @@ TEST(StreamsTest, StreamSetReadWrite) {
   EXPECT_EQ(60000U, datum);
   EXPECT_TRUE(subset2.Empty());
 }
+
+TEST(StreamsTest, StreamSetRetire) {
+  courgette::SinkStreamSet out;
+  out.Init(3);
+  EXPECT_TRUE(out.stream(0)->WriteVarint32(1));
+  EXPECT_TRUE(out.stream(2)->Write("Hello", 5));
+
+  out.Retire();
+  EXPECT_EQ(0U, out.stream(0)->Length());
+  EXPECT_EQ(0U, out.stream(1)->Length());
+  EXPECT_EQ(0U, out.stream(2)->Length());
+
+  // A retired set can be reused.
+  EXPECT_TRUE(out.stream(1)->WriteVarint32(2));
+  EXPECT_EQ(1U, out.stream(1)->Length());
+}
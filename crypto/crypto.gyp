@@ -35,6 +35,11 @@
         4018,
       ],
       'conditions': [
+        [ 'target_arch == "ia32" or target_arch == "x64"', {
+          'dependencies': [
+            'crypto_pclmul',
+          ],
+        }],
         [ 'os_posix == 1 and OS != "mac" and OS != "ios" and OS != "android"', {
           'dependencies': [
             '../build/linux/system.gyp:ssl',
@@ -179,6 +184,7 @@
         'curve25519-donna.c',
         'ghash.cc',
         'ghash.h',
+        'ghash_pclmul.h',
         'ec_private_key.h',
         'ec_private_key_nss.cc',
         'ec_private_key_openssl.cc',
@@ -316,8 +322,74 @@
         }],
       ],
     },
+    {
+      'target_name': 'crypto_perftests',
+      'type': '<(gtest_target_type)',
+      'sources': [
+        'encryptor_perftest.cc',
+        'ghash_perftest.cc',
+      ],
+      'dependencies': [
+        'crypto',
+        '../base/base.gyp:base',
+        '../base/base.gyp:test_support_base',
+        '../base/base.gyp:test_support_perf',
+        '../testing/gtest.gyp:gtest',
+        '../testing/perf/perf_test.gyp:perf_test',
+      ],
+      'conditions': [
+        [ 'os_posix == 1 and OS != "mac" and OS != "android" and OS != "ios"', {
+          'dependencies': [
+            '../build/linux/system.gyp:ssl',
+          ],
+        }],
+        [ 'OS == "mac" or OS == "ios" or OS == "win"', {
+          'dependencies': [
+            '../third_party/nss/nss.gyp:nss',
+          ],
+        }],
+      ],
+    },
   ],
   'conditions': [
+    ['target_arch == "ia32" or target_arch == "x64"', {
+      'targets': [
+        {
+          # The PCLMULQDQ path of GaloisHash. It is a separate target so that
+          # only this file is built with -mpclmul; GaloisHash calls it only
+          # after checking that the CPU supports the instruction.
+          'target_name': 'crypto_pclmul',
+          'type': 'static_library',
+          'dependencies': [
+            '../base/base.gyp:base',
+          ],
+          'defines': [
+            'CRYPTO_IMPLEMENTATION',
+          ],
+          'include_dirs': [
+            '..',
+          ],
+          'sources': [
+            'ghash_pclmul.cc',
+            'ghash_pclmul.h',
+          ],
+          'conditions': [
+            ['os_posix == 1 and OS != "mac" and OS != "ios"', {
+              'cflags': [
+                '-mpclmul',
+              ],
+            }],
+            ['OS == "mac" or OS == "ios"', {
+              'xcode_settings': {
+                'OTHER_CFLAGS': [
+                  '-mpclmul',
+                ],
+              },
+            }],
+          ],
+        },
+      ],
+    }],
     ['OS == "win" and target_arch=="ia32"', {
       'targets': [
         {
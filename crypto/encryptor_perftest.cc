@@ -0,0 +1,70 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "crypto/encryptor.h"
+
+#include <string>
+
+#include "base/format_macros.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "crypto/symmetric_key.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace {
+
+// Every message size is encrypted until this many bytes have been processed.
+const size_t kBytesPerSize = 16 * 1024 * 1024;
+
+// A small record, a full QUIC packet and a large TLS record.
+const size_t kMessageSizes[] = { 64, 1350, 16384 };
+
+// Encrypts messages of each of |kMessageSizes| with |encryptor| and reports
+// the throughput under |trace|.
+void MeasureEncrypt(crypto::Encryptor* encryptor,
+                    const std::string& trace) {
+  for (size_t i = 0; i < arraysize(kMessageSizes); ++i) {
+    const size_t size = kMessageSizes[i];
+    const std::string plaintext(size, 'p');
+    const size_t iterations = kBytesPerSize / size;
+
+    std::string ciphertext;
+    base::TimeTicks start = base::TimeTicks::HighResNow();
+    for (size_t j = 0; j < iterations; ++j)
+      ASSERT_TRUE(encryptor->Encrypt(plaintext, &ciphertext));
+    base::TimeDelta elapsed = base::TimeTicks::HighResNow() - start;
+
+    perf_test::PrintResult(
+        "encryptor_throughput", base::StringPrintf("_%" PRIuS, size), trace,
+        iterations * size / elapsed.InSecondsF() / (1024 * 1024 * 1024),
+        "GB/s", true);
+  }
+}
+
+}  // namespace
+
+TEST(EncryptorPerfTest, AES128CBC) {
+  scoped_ptr<crypto::SymmetricKey> key(crypto::SymmetricKey::Import(
+      crypto::SymmetricKey::AES, std::string(16, 'k')));
+  ASSERT_TRUE(key.get());
+
+  crypto::Encryptor encryptor;
+  ASSERT_TRUE(encryptor.Init(key.get(), crypto::Encryptor::CBC,
+                             std::string(16, 'i')));
+  MeasureEncrypt(&encryptor, "aes_128_cbc");
+}
+
+TEST(EncryptorPerfTest, AES128CTR) {
+  scoped_ptr<crypto::SymmetricKey> key(crypto::SymmetricKey::Import(
+      crypto::SymmetricKey::AES, std::string(16, 'k')));
+  ASSERT_TRUE(key.get());
+
+  crypto::Encryptor encryptor;
+  ASSERT_TRUE(encryptor.Init(key.get(), crypto::Encryptor::CTR,
+                             std::string()));
+  ASSERT_TRUE(encryptor.SetCounter(std::string(16, '\0')));
+  MeasureEncrypt(&encryptor, "aes_128_ctr");
+}
@@ -6,8 +6,15 @@
 
 #include <algorithm>
 
+#include "base/lazy_instance.h"
 #include "base/logging.h"
 #include "base/sys_byteorder.h"
+#include "build/build_config.h"
+
+#if defined(ARCH_CPU_X86_FAMILY)
+#include "base/cpu.h"
+#include "crypto/ghash_pclmul.h"
+#endif
 
 namespace crypto {
 
@@ -46,11 +53,26 @@ int Reverse(int i) {
   return i;
 }
 
+#if defined(ARCH_CPU_X86_FAMILY)
+// Querying the CPU is slow compared to hashing a packet, so it is done once.
+struct PCLMULSupport {
+  PCLMULSupport() : available(base::CPU().has_pclmul()) {}
+  bool available;
+};
+
+base::LazyInstance<PCLMULSupport>::Leaky g_pclmul_support =
+    LAZY_INSTANCE_INITIALIZER;
+#endif
+
 }  // namespace
 
-GaloisHash::GaloisHash(const uint8 key[16]) {
+GaloisHash::GaloisHash(const uint8 key[16]) : use_pclmul_(false) {
   Reset();
 
+#if defined(ARCH_CPU_X86_FAMILY)
+  use_pclmul_ = g_pclmul_support.Get().available;
+#endif
+
   // We precompute 16 multiples of |key|. However, when we do lookups into this
   // table we'll be using bits from a field element and therefore the bits will
   // be in the reverse order. So normally one would expect, say, 4*key to be in
@@ -220,6 +242,18 @@ void GaloisHash::Mul16(FieldElement* x) {
 }
 
 void GaloisHash::UpdateBlocks(const uint8* bytes, size_t num_blocks) {
+#if defined(ARCH_CPU_X86_FAMILY)
+  if (use_pclmul_) {
+    // 1*key is at index Reverse(1) = 8 of the table.
+    const uint64 h[2] = {product_table_[8].low, product_table_[8].hi};
+    uint64 y[2] = {y_.low, y_.hi};
+    internal::GHashUpdateBlocksPCLMUL(h, y, bytes, num_blocks);
+    y_.low = y[0];
+    y_.hi = y[1];
+    return;
+  }
+#endif
+
   for (size_t i = 0; i < num_blocks; i++) {
     y_.low ^= Get64(bytes);
     bytes += 8;
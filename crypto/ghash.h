@@ -23,6 +23,9 @@ namespace crypto {
 // authenticators must be used in the correct manner and any use outside of GCM
 // requires careful consideration.
 //
+// On x86 CPUs that support PCLMULQDQ the blocks are multiplied with that
+// instruction instead of the table below.
+//
 // WARNING: this code is not constant time. However, in all likelihood, nor is
 // the implementation of AES that is used.
 class CRYPTO_EXPORT_PRIVATE GaloisHash {
@@ -81,6 +84,8 @@ class CRYPTO_EXPORT_PRIVATE GaloisHash {
   uint8 buf_[16];
   size_t buf_used_;
   FieldElement product_table_[16];
+  // True if UpdateBlocks should use GHashUpdateBlocksPCLMUL.
+  bool use_pclmul_;
 };
 
 }  // namespace crypto
@@ -0,0 +1,89 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "crypto/ghash_pclmul.h"
+
+#include <emmintrin.h>
+#include <wmmintrin.h>
+
+#include <string.h>
+
+#include "base/sys_byteorder.h"
+
+namespace crypto {
+namespace internal {
+
+namespace {
+
+// Get64 reads a 64-bit, big-endian number from |bytes|.
+uint64 Get64(const uint8 bytes[8]) {
+  uint64 t;
+  memcpy(&t, bytes, sizeof(t));
+  return base::NetToHost64(t);
+}
+
+// GaloisHash's {low, hi} pair is the byte-reversed block, so loading |hi|
+// into the low lane and |low| into the high lane gives the operand order
+// that the carry-less multiplication below expects.
+__m128i Load(uint64 low, uint64 hi) {
+  return _mm_set_epi64x(low, hi);
+}
+
+// Mul returns |a|*|b| in GF(2^128). This is the carry-less multiplication
+// and reduction from Intel's "Carry-Less Multiplication and Its Usage for
+// Computing the GCM Mode" white paper, algorithm 5: the 256-bit product is
+// shifted left by one bit to account for GCM's reflected bit order and then
+// reduced modulo x^128 + x^7 + x^2 + x + 1.
+__m128i Mul(__m128i a, __m128i b) {
+  __m128i lo = _mm_clmulepi64_si128(a, b, 0x00);
+  __m128i mid = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10),
+                              _mm_clmulepi64_si128(a, b, 0x01));
+  __m128i hi = _mm_clmulepi64_si128(a, b, 0x11);
+  lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+  hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+
+  // Shift the 256-bit value |hi|:|lo| left by one bit.
+  __m128i lo_carry = _mm_srli_epi32(lo, 31);
+  __m128i hi_carry = _mm_srli_epi32(hi, 31);
+  lo = _mm_slli_epi32(lo, 1);
+  hi = _mm_slli_epi32(hi, 1);
+  __m128i cross_carry = _mm_srli_si128(lo_carry, 12);
+  lo = _mm_or_si128(lo, _mm_slli_si128(lo_carry, 4));
+  hi = _mm_or_si128(hi, _mm_slli_si128(hi_carry, 4));
+  hi = _mm_or_si128(hi, cross_carry);
+
+  // Reduce.
+  __m128i t = _mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30));
+  t = _mm_xor_si128(t, _mm_slli_epi32(lo, 25));
+  __m128i t_hi = _mm_srli_si128(t, 4);
+  lo = _mm_xor_si128(lo, _mm_slli_si128(t, 12));
+  __m128i u = _mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2));
+  u = _mm_xor_si128(u, _mm_srli_epi32(lo, 7));
+  u = _mm_xor_si128(u, t_hi);
+  lo = _mm_xor_si128(lo, u);
+  return _mm_xor_si128(hi, lo);
+}
+
+}  // namespace
+
+void GHashUpdateBlocksPCLMUL(const uint64 h[2],
+                             uint64 y[2],
+                             const uint8* bytes,
+                             size_t num_blocks) {
+  const __m128i key = Load(h[0], h[1]);
+  __m128i acc = Load(y[0], y[1]);
+  for (size_t i = 0; i < num_blocks; i++) {
+    acc = _mm_xor_si128(acc, Load(Get64(bytes), Get64(bytes + 8)));
+    acc = Mul(acc, key);
+    bytes += 16;
+  }
+
+  uint64 result[2];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(result), acc);
+  y[0] = result[1];
+  y[1] = result[0];
+}
+
+}  // namespace internal
+}  // namespace crypto
@@ -0,0 +1,25 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CRYPTO_GHASH_PCLMUL_H_
+#define CRYPTO_GHASH_PCLMUL_H_
+
+#include "base/basictypes.h"
+
+namespace crypto {
+namespace internal {
+
+// GHashUpdateBlocksPCLMUL hashes |num_blocks| 16-byte blocks from |bytes|
+// into |y| with key |h| using the PCLMULQDQ instruction. |y| and |h| are
+// field elements in GaloisHash's representation, {low, hi}. The caller must
+// check that the CPU supports PCLMULQDQ.
+void GHashUpdateBlocksPCLMUL(const uint64 h[2],
+                             uint64 y[2],
+                             const uint8* bytes,
+                             size_t num_blocks);
+
+}  // namespace internal
+}  // namespace crypto
+
+#endif  // CRYPTO_GHASH_PCLMUL_H_
@@ -0,0 +1,63 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "crypto/ghash.h"
+
+#include <string>
+#include <vector>
+
+#include "base/cpu.h"
+#include "base/format_macros.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace crypto {
+
+namespace {
+
+// Every message size is hashed until this many bytes have been processed.
+const size_t kBytesPerSize = 64 * 1024 * 1024;
+
+// A small record, a full QUIC packet and a large TLS record.
+const size_t kMessageSizes[] = { 64, 1350, 16384 };
+
+const uint8 kKey[16] = {
+  0x66, 0xe9, 0x4b, 0xd4, 0xef, 0x8a, 0x2c, 0x3b,
+  0x88, 0x4c, 0xfa, 0x59, 0xca, 0x34, 0x2b, 0x2e,
+};
+
+}  // namespace
+
+TEST(GaloisHashPerfTest, Throughput) {
+  base::CPU cpu;
+  const std::string implementation = cpu.has_pclmul() ? "pclmul" : "table";
+
+  for (size_t i = 0; i < arraysize(kMessageSizes); ++i) {
+    const size_t size = kMessageSizes[i];
+    const std::vector<uint8> message(size, 0x5a);
+    const uint8 additional[13] = { 0 };
+    const size_t iterations = kBytesPerSize / size;
+
+    GaloisHash hash(kKey);
+    uint8 tag[16];
+    base::TimeTicks start = base::TimeTicks::HighResNow();
+    for (size_t j = 0; j < iterations; ++j) {
+      hash.Reset();
+      hash.UpdateAdditional(additional, sizeof(additional));
+      hash.UpdateCiphertext(&message[0], message.size());
+      hash.Finish(tag, sizeof(tag));
+    }
+    base::TimeDelta elapsed = base::TimeTicks::HighResNow() - start;
+
+    perf_test::PrintResult(
+        "ghash_throughput", base::StringPrintf("_%" PRIuS, size),
+        implementation,
+        iterations * size / elapsed.InSecondsF() / (1024 * 1024 * 1024),
+        "GB/s", true);
+  }
+}
+
+}  // namespace crypto
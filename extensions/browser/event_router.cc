@@ -455,6 +455,10 @@ void EventRouter::DispatchEventImpl(const std::string& restrict_to_extension_id,
     }
   }
 
+  // An extension can have several filtered listeners in the same process that
+  // match the event. The renderer matches the event against all of its
+  // listeners, so a single message to each process is enough.
+  std::set<ListenerProcess> dispatched_to_processes;
   for (std::set<const EventListener*>::iterator it = listeners.begin();
        it != listeners.end(); it++) {
     const EventListener* listener = *it;
@@ -463,7 +467,9 @@ void EventRouter::DispatchEventImpl(const std::string& restrict_to_extension_id,
       if (listener->process) {
         EventDispatchIdentifier dispatch_id(
             listener->process->GetBrowserContext(), listener->extension_id);
-        if (!ContainsKey(already_dispatched, dispatch_id)) {
+        if (!ContainsKey(already_dispatched, dispatch_id) &&
+            dispatched_to_processes.insert(ListenerProcess(
+                listener->process, listener->extension_id)).second) {
           DispatchEventToProcess(listener->extension_id, listener->process,
               event);
         }
@@ -15,6 +15,15 @@ namespace gpu {
 AlignedRingBuffer::~AlignedRingBuffer() {
 }
 
+TransferBuffer::RetiredRingBuffer::RetiredRingBuffer(
+    AlignedRingBuffer* ring_buffer, int32 token)
+    : ring_buffer(ring_buffer),
+      token(token) {
+}
+
+TransferBuffer::RetiredRingBuffer::~RetiredRingBuffer() {
+}
+
 TransferBuffer::TransferBuffer(
     CommandBufferHelper* helper)
     : helper_(helper),
@@ -56,6 +65,7 @@ void TransferBuffer::Free() {
   if (HaveBuffer()) {
     TRACE_EVENT0("gpu", "TransferBuffer::Free");
     helper_->Finish();
+    FreeRetiredRingBuffers(true);
     helper_->command_buffer()->DestroyTransferBuffer(buffer_id_);
     buffer_id_ = -1;
     buffer_.ptr = NULL;
@@ -83,6 +93,36 @@ void TransferBuffer::FreePendingToken(void* p, unsigned int token) {
   }
 }
 
+void TransferBuffer::RetireRingBuffer() {
+  DCHECK(HaveBuffer());
+  // Everything allocated from the ring buffer has been freed pending a token
+  // before it could be replaced, so it can go once a new token has passed.
+  retired_ring_buffers_.push_back(
+      new RetiredRingBuffer(ring_buffer_.release(), helper_->InsertToken()));
+  buffer_id_ = -1;
+  buffer_.ptr = NULL;
+  buffer_.size = 0;
+  result_buffer_ = NULL;
+  result_shm_offset_ = 0;
+}
+
+void TransferBuffer::FreeRetiredRingBuffers(bool wait_for_tokens) {
+  int32 last_token_read = helper_->last_token_read();
+  size_t num_freed = 0;
+  for (; num_freed < retired_ring_buffers_.size(); ++num_freed) {
+    RetiredRingBuffer* retired = retired_ring_buffers_[num_freed];
+    // A token of -1 means the service has shut down.
+    if (!wait_for_tokens && retired->token > last_token_read)
+      break;
+    // The ring buffer has to go first since it waits for its blocks' tokens.
+    int32 id = retired->ring_buffer->GetShmId();
+    retired->ring_buffer.reset();
+    helper_->command_buffer()->DestroyTransferBuffer(id);
+  }
+  retired_ring_buffers_.erase(retired_ring_buffers_.begin(),
+                              retired_ring_buffers_.begin() + num_freed);
+}
+
 void TransferBuffer::AllocateRingBuffer(unsigned int size) {
   for (;size >= min_buffer_size_; size /= 2) {
     int32 id = -1;
@@ -149,10 +189,22 @@ void TransferBuffer::ReallocateRingBuffer(unsigned int size) {
 
   if (usable_ && (!HaveBuffer() || needed_buffer_size > buffer_.size)) {
     if (HaveBuffer()) {
-      Free();
+      TRACE_EVENT0("gpu", "TransferBuffer::ReallocateRingBuffer");
+      RetireRingBuffer();
     }
     AllocateRingBuffer(needed_buffer_size);
   }
+  FreeRetiredRingBuffers(false);
+}
+
+void TransferBuffer::GrowRingBufferIfFull(unsigned int size) {
+  if (!HaveBuffer() || buffer_.size >= max_buffer_size_)
+    return;
+  size = std::min(size, ring_buffer_->GetLargestFreeOrPendingSize());
+  if (size <= ring_buffer_->GetLargestFreeSizeNoWaiting())
+    return;
+  // Ask for the next power of two up from the current size.
+  ReallocateRingBuffer(buffer_.size + 1 - result_size_);
 }
 
 void* TransferBuffer::AllocUpTo(
@@ -160,6 +212,7 @@ void* TransferBuffer::AllocUpTo(
   DCHECK(size_allocated);
 
   ReallocateRingBuffer(size);
+  GrowRingBufferIfFull(size);
 
   if (!HaveBuffer()) {
     return NULL;
@@ -173,6 +226,7 @@ void* TransferBuffer::AllocUpTo(
 
 void* TransferBuffer::Alloc(unsigned int size) {
   ReallocateRingBuffer(size);
+  GrowRingBufferIfFull(size);
 
   if (!HaveBuffer()) {
     return NULL;
@@ -210,6 +264,10 @@ unsigned int TransferBuffer::GetMaxAllocation() const {
   return HaveBuffer() ? max_buffer_size_ - result_size_ : 0;
 }
 
+size_t TransferBuffer::GetNumRetiredRingBuffers() const {
+  return retired_ring_buffers_.size();
+}
+
 void ScopedTransferBufferPtr::Release() {
   if (buffer_) {
     transfer_buffer_->FreePendingToken(buffer_, helper_->InsertToken());
@@ -7,6 +7,7 @@
 
 #include "base/compiler_specific.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
 #include "gpu/command_buffer/client/ring_buffer.h"
 #include "gpu/command_buffer/common/buffer.h"
 #include "gpu/command_buffer/common/gles2_cmd_utils.h"
@@ -84,7 +85,10 @@ class GPU_EXPORT TransferBufferInterface {
   virtual void FreePendingToken(void* p, unsigned int token) = 0;
 };
 
-// Class that manages the transfer buffer.
+// Class that manages the transfer buffer. The buffer grows, up to its maximum
+// size, when an allocation does not fit or would have to wait for the service
+// to free space. The replaced ring buffer is kept until the service is done
+// with it instead of waiting for that.
 class GPU_EXPORT TransferBuffer : public TransferBufferInterface {
  public:
   TransferBuffer(CommandBufferHelper* helper);
@@ -112,13 +116,36 @@ class GPU_EXPORT TransferBuffer : public TransferBufferInterface {
   // These are for testing.
   unsigned int GetCurrentMaxAllocationWithoutRealloc() const;
   unsigned int GetMaxAllocation() const;
+  size_t GetNumRetiredRingBuffers() const;
 
  private:
+  // A ring buffer that was replaced by a larger one, which is destroyed once
+  // |token| has passed.
+  struct RetiredRingBuffer {
+    RetiredRingBuffer(AlignedRingBuffer* ring_buffer, int32 token);
+    ~RetiredRingBuffer();
+
+    scoped_ptr<AlignedRingBuffer> ring_buffer;
+    int32 token;
+  };
+
   // Tries to reallocate the ring buffer if it's not large enough for size.
   void ReallocateRingBuffer(unsigned int size);
 
+  // Tries to reallocate the ring buffer if an allocation of size would have
+  // to wait for space to be freed.
+  void GrowRingBufferIfFull(unsigned int size);
+
   void AllocateRingBuffer(unsigned int size);
 
+  // Replaces the current ring buffer without waiting for the service to be
+  // done with it.
+  void RetireRingBuffer();
+
+  // Destroys the retired ring buffers the service is done with. If
+  // |wait_for_tokens| is true, destroys all of them.
+  void FreeRetiredRingBuffers(bool wait_for_tokens);
+
   CommandBufferHelper* helper_;
   scoped_ptr<AlignedRingBuffer> ring_buffer_;
 
@@ -157,6 +184,9 @@ class GPU_EXPORT TransferBuffer : public TransferBufferInterface {
 
   // false if we failed to allocate min_buffer_size
   bool usable_;
+
+  // Oldest first.
+  ScopedVector<RetiredRingBuffer> retired_ring_buffers_;
 };
 
 // A class that will manage the lifetime of a transferbuffer allocation.
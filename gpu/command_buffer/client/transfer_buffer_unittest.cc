@@ -358,6 +358,38 @@ TEST_F(TransferBufferExpandContractTest, Expand) {
   transfer_buffer_->FreePendingToken(ptr, 1);
 }
 
+TEST_F(TransferBufferExpandContractTest, GrowsInsteadOfWaiting) {
+  // Fill half of the buffer and free it pending a token that has not passed.
+  command_buffer()->SetToken(0);
+  const size_t kSize1 = (kStartTransferBufferSize - kStartingOffset) / 2;
+  void* ptr = transfer_buffer_->Alloc(kSize1);
+  ASSERT_TRUE(ptr != NULL);
+  transfer_buffer_->FreePendingToken(ptr, 1);
+
+  // An allocation that would have to wait gets a larger buffer instead, and
+  // the old one is kept until the service is done with it.
+  EXPECT_CALL(*command_buffer(),
+              CreateTransferBuffer(kStartTransferBufferSize * 2, _))
+      .WillOnce(Invoke(
+          command_buffer(),
+          &MockClientCommandBufferCanFail::RealCreateTransferBuffer))
+      .RetiresOnSaturation();
+  ptr = transfer_buffer_->Alloc(kSize1 + 1);
+  ASSERT_TRUE(ptr != NULL);
+  EXPECT_EQ(1u, transfer_buffer_->GetNumRetiredRingBuffers());
+  transfer_buffer_->FreePendingToken(ptr, 1);
+
+  // Once its token has passed the old buffer is destroyed.
+  command_buffer()->SetToken(10000);
+  EXPECT_CALL(*command_buffer(), DestroyTransferBuffer(_))
+      .Times(1)
+      .RetiresOnSaturation();
+  ptr = transfer_buffer_->Alloc(kSize1);
+  ASSERT_TRUE(ptr != NULL);
+  EXPECT_EQ(0u, transfer_buffer_->GetNumRetiredRingBuffers());
+  transfer_buffer_->FreePendingToken(ptr, 1);
+}
+
 TEST_F(TransferBufferExpandContractTest, Contract) {
   // Check it starts at starting size.
   EXPECT_EQ(
@@ -25,8 +25,16 @@ AsyncPixelTransferManager* AsyncPixelTransferManager::Create(
   }
 
   switch (gfx::GetGLImplementation()) {
-    case gfx::kGLImplementationOSMesaGL:
     case gfx::kGLImplementationDesktopGL:
+      // Desktop GL drivers share textures between the contexts of a share
+      // group, so uploads can run on a thread with its own context.
+      DCHECK(context);
+      if (!CommandLine::ForCurrentProcess()->HasSwitch(
+              switches::kDisableShareGroupAsyncTextureUpload)) {
+        return new AsyncPixelTransferManagerShareGroup(context);
+      }
+      return new AsyncPixelTransferManagerIdle;
+    case gfx::kGLImplementationOSMesaGL:
     case gfx::kGLImplementationEGLGLES2:
       return new AsyncPixelTransferManagerIdle;
     case gfx::kGLImplementationMockGL:
@@ -172,8 +172,9 @@ class PendingTask : public base::RefCountedThreadSafe<PendingTask> {
       task_.Run();
       task_.Reset();
       glBindTexture(GL_TEXTURE_2D, 0);
-      // Flush for synchronization between threads.
-      glFlush();
+      // Other contexts are only guaranteed to see the upload once it has
+      // completed, so wait for it here rather than on the main thread.
+      glFinish();
       task_pending_.Signal();
     }
   }
@@ -24,6 +24,7 @@ BufferManager::BufferManager(
       feature_info_(feature_info),
       allow_buffers_on_multiple_targets_(false),
       buffer_count_(0),
+      size_serial_(0),
       have_context_(true),
       use_client_side_arrays_for_stream_buffers_(
           feature_info ? feature_info->workarounds(
@@ -251,6 +252,8 @@ void BufferManager::SetInfo(
     Buffer* buffer, GLsizeiptr size, GLenum usage, const GLvoid* data) {
   DCHECK(buffer);
   memory_tracker_->TrackMemFree(buffer->size());
+  if (size != buffer->size())
+    ++size_serial_;
   bool is_client_side_array = IsUsageClientSideArray(usage);
   bool shadow = buffer->target() == GL_ELEMENT_ARRAY_BUFFER ||
                 allow_buffers_on_multiple_targets_ ||
@@ -228,6 +228,11 @@ class GPU_EXPORT BufferManager {
   // set to a non-zero size.
   bool UseNonZeroSizeForClientSideArrayBuffer();
 
+  // Changes every time the size of any buffer of this manager changes.
+  uint32 size_serial() const {
+    return size_serial_;
+  }
+
  private:
   friend class Buffer;
   friend class TestHelper;  // Needs access to DoBufferData.
@@ -274,6 +279,9 @@ class GPU_EXPORT BufferManager {
   // Allows to check no Buffer will outlive this.
   unsigned int buffer_count_;
 
+  // See size_serial().
+  uint32 size_serial_;
+
   bool have_context_;
   bool use_client_side_arrays_for_stream_buffers_;
 
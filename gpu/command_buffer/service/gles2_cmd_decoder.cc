@@ -6108,6 +6108,7 @@ bool GLES2DecoderImpl::IsDrawValid(
       ->ValidateBindings(function_name,
                          this,
                          feature_info_.get(),
+                         buffer_manager(),
                          state_.current_program.get(),
                          max_vertex_accessed,
                          primcount);
@@ -64,6 +64,11 @@ const char kDisableGpuShaderDiskCache[]     = "disable-gpu-shader-disk-cache";
 const char kEnableShareGroupAsyncTextureUpload[] =
     "enable-share-group-async-texture-upload";
 
+// Disables async texture uploads via GL context sharing where they are on by
+// default.
+const char kDisableShareGroupAsyncTextureUpload[] =
+    "disable-share-group-async-texture-upload";
+
 const char* kGpuSwitches[] = {
   kCompileShaderAlwaysSucceeds,
   kDisableGLErrorLimit,
@@ -82,6 +87,7 @@ const char* kGpuSwitches[] = {
   kGpuProgramCacheSizeKb,
   kDisableGpuShaderDiskCache,
   kEnableShareGroupAsyncTextureUpload,
+  kDisableShareGroupAsyncTextureUpload,
 };
 
 const int kNumGpuSwitches = arraysize(kGpuSwitches);
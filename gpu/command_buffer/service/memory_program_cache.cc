@@ -156,6 +156,9 @@ ProgramCache::ProgramLoadResult MemoryProgramCache::LoadLinkedProgram(
   GLint success = 0;
   glGetProgramiv(program, GL_LINK_STATUS, &success);
   if (success == GL_FALSE) {
+    // The binary is most likely from a different driver version, so drop it
+    // to have it replaced after the program is linked.
+    store_.Erase(found);
     return PROGRAM_LOAD_FAILURE;
   }
   shader_a->set_attrib_map(value->attrib_map_0());
@@ -223,16 +226,7 @@ void MemoryProgramCache::SaveLinkedProgram(
   UMA_HISTOGRAM_COUNTS("GPU.ProgramCache.MemorySizeBeforeKb",
                        curr_size_bytes_ / 1024);
 
-  // Evict any cached program with the same key in favor of the least recently
-  // accessed.
-  ProgramMRUCache::iterator existing = store_.Peek(sha_string);
-  if(existing != store_.end())
-    store_.Erase(existing);
-
-  while (curr_size_bytes_ + length > max_size_bytes_) {
-    DCHECK(!store_.empty());
-    store_.Erase(store_.rbegin());
-  }
+  MakeRoomForProgram(sha_string, length);
 
   if (!shader_callback.is_null() &&
       !CommandLine::ForCurrentProcess()->HasSwitch(
@@ -270,6 +264,11 @@ void MemoryProgramCache::SaveLinkedProgram(
 void MemoryProgramCache::LoadProgram(const std::string& program) {
   scoped_ptr<GpuProgramProto> proto(GpuProgramProto::default_instance().New());
   if (proto->ParseFromString(program)) {
+    // Programs saved by a build with a larger cache may not fit.
+    if (proto->program().length() > max_size_bytes_)
+      return;
+
+
     ShaderTranslator::VariableMap vertex_attribs;
     ShaderTranslator::VariableMap vertex_uniforms;
     ShaderTranslator::VariableMap vertex_varyings;
@@ -308,6 +307,7 @@ void MemoryProgramCache::LoadProgram(const std::string& program) {
     scoped_ptr<char[]> binary(new char[proto->program().length()]);
     memcpy(binary.get(), proto->program().c_str(), proto->program().length());
 
+    MakeRoomForProgram(proto->sha(), proto->program().length());
     store_.Put(proto->sha(),
                new ProgramCacheValue(proto->program().length(),
                                      proto->format(),
@@ -330,6 +330,20 @@ void MemoryProgramCache::LoadProgram(const std::string& program) {
   }
 }
 
+void MemoryProgramCache::MakeRoomForProgram(const std::string& program_hash,
+                                            size_t length) {
+  // Evict any cached program with the same key in favor of the least recently
+  // accessed.
+  ProgramMRUCache::iterator existing = store_.Peek(program_hash);
+  if (existing != store_.end())
+    store_.Erase(existing);
+
+  while (curr_size_bytes_ + length > max_size_bytes_) {
+    DCHECK(!store_.empty());
+    store_.Erase(store_.rbegin());
+  }
+}
+
 MemoryProgramCache::ProgramCacheValue::ProgramCacheValue(
     GLsizei length,
     GLenum format,
@@ -135,6 +135,10 @@ class GPU_EXPORT MemoryProgramCache : public ProgramCache {
   typedef base::MRUCache<std::string,
                          scoped_refptr<ProgramCacheValue> > ProgramMRUCache;
 
+  // Removes any program cached under |program_hash| and evicts the least
+  // recently used programs until |length| more bytes fit in the cache.
+  void MakeRoomForProgram(const std::string& program_hash, size_t length);
+
   const size_t max_size_bytes_;
   size_t curr_size_bytes_;
   ProgramMRUCache store_;
@@ -156,6 +156,7 @@ Program::Program(
       valid_(false),
       link_status_(false),
       uniforms_cleared_(false),
+      attrib_serial_(manager->NextAttribSerial()),
       num_uniforms_(0) {
   manager_->StartTracking(this);
 }
@@ -170,6 +171,7 @@ void Program::Reset() {
   uniform_infos_.clear();
   sampler_indices_.clear();
   attrib_location_to_index_map_.clear();
+  attrib_serial_ = manager_->NextAttribSerial();
 }
 
 std::string Program::ProcessLogInfo(
@@ -1252,6 +1254,7 @@ Program::~Program() {
 ProgramManager::ProgramManager(ProgramCache* program_cache,
                                uint32 max_varying_vectors)
     : program_count_(0),
+      last_attrib_serial_(0),
       have_context_(true),
       program_cache_(program_cache),
       max_varying_vectors_(max_varying_vectors) { }
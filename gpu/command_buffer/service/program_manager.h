@@ -176,6 +176,13 @@ class GPU_EXPORT Program : public base::RefCounted<Program> {
     return use_count_ != 0;
   }
 
+  // Changes every time the attribs of this program are updated, and is unique
+  // among the programs of its ProgramManager, so that a cached check of the
+  // attribs can be compared against it.
+  uint32 attrib_serial() const {
+    return attrib_serial_;
+  }
+
   // Sets attribute-location binding from a glBindAttribLocation() call.
   void SetAttribLocationBinding(const std::string& attrib, GLint location) {
     bind_attrib_location_map_[attrib] = location;
@@ -321,6 +328,9 @@ class GPU_EXPORT Program : public base::RefCounted<Program> {
   // True if the uniforms have been cleared.
   bool uniforms_cleared_;
 
+  // See attrib_serial().
+  uint32 attrib_serial_;
+
   // This is different than uniform_infos_.size() because
   // that is a sparce array.
   GLint num_uniforms_;
@@ -400,6 +410,10 @@ class GPU_EXPORT ProgramManager {
   void StartTracking(Program* program);
   void StopTracking(Program* program);
 
+  uint32 NextAttribSerial() {
+    return ++last_attrib_serial_;
+  }
+
   void RemoveProgramInfoIfUnused(
       ShaderManager* shader_manager, Program* program);
 
@@ -412,6 +426,9 @@ class GPU_EXPORT ProgramManager {
   // Allows to check no Program will outlive this.
   unsigned int program_count_;
 
+  // The last serial handed out by NextAttribSerial().
+  uint32 last_attrib_serial_;
+
   bool have_context_;
 
   // Used to clear uniforms.
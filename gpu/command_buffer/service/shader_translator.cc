@@ -10,6 +10,7 @@
 #include "base/at_exit.h"
 #include "base/debug/trace_event.h"
 #include "base/logging.h"
+#include "base/sha1.h"
 #include "base/strings/string_number_conversions.h"
 
 namespace {
@@ -38,6 +39,18 @@ typedef int ANGLEGetInfoType;
 typedef size_t ANGLEGetInfoType;
 #endif
 
+// The number of translations each translator remembers.
+const size_t kMaxCachedTranslations = 64;
+
+// Returns a copy of |str|, or NULL if it is empty.
+char* CopyStringOrNull(const std::string& str) {
+  if (str.empty())
+    return NULL;
+  char* copy = new char[str.size() + 1];
+  memcpy(copy, str.c_str(), str.size() + 1);
+  return copy;
+}
+
 void GetVariableInfo(ShHandle compiler, ShShaderInfo var_type,
                      ShaderTranslator::VariableMap* var_map) {
   ANGLEGetInfoType name_len = 0, mapped_name_len = 0;
@@ -115,10 +128,17 @@ ShaderTranslator::DestructionObserver::DestructionObserver() {
 ShaderTranslator::DestructionObserver::~DestructionObserver() {
 }
 
+ShaderTranslator::TranslationResults::TranslationResults() {
+}
+
+ShaderTranslator::TranslationResults::~TranslationResults() {
+}
+
 ShaderTranslator::ShaderTranslator()
     : compiler_(NULL),
       implementation_is_glsl_es_(false),
-      driver_bug_workarounds_(static_cast<ShCompileOptions>(0)) {
+      driver_bug_workarounds_(static_cast<ShCompileOptions>(0)),
+      translation_cache_(kMaxCachedTranslations) {
 }
 
 bool ShaderTranslator::Init(
@@ -169,6 +189,13 @@ bool ShaderTranslator::Translate(const char* shader) {
   DCHECK(shader != NULL);
   ClearResults();
 
+  const std::string source_hash = base::SHA1HashString(shader);
+  TranslationCache::iterator cached = translation_cache_.Get(source_hash);
+  if (cached != translation_cache_.end()) {
+    RestoreResults(cached->second);
+    return true;
+  }
+
   bool success = false;
   {
     TRACE_EVENT0("gpu", "ShCompile");
@@ -200,6 +227,11 @@ bool ShaderTranslator::Translate(const char* shader) {
     info_log_.reset();
   }
 
+  if (success) {
+    TranslationResults results;
+    SaveResults(&results);
+    translation_cache_.Put(source_hash, results);
+  }
   return success;
 }
 
@@ -315,6 +347,26 @@ void ShaderTranslator::ClearResults() {
   name_map_.clear();
 }
 
+void ShaderTranslator::SaveResults(TranslationResults* results) const {
+  if (translated_shader_)
+    results->translated_shader = translated_shader_.get();
+  if (info_log_)
+    results->info_log = info_log_.get();
+  results->attrib_map = attrib_map_;
+  results->uniform_map = uniform_map_;
+  results->varying_map = varying_map_;
+  results->name_map = name_map_;
+}
+
+void ShaderTranslator::RestoreResults(const TranslationResults& results) {
+  translated_shader_.reset(CopyStringOrNull(results.translated_shader));
+  info_log_.reset(CopyStringOrNull(results.info_log));
+  attrib_map_ = results.attrib_map;
+  uniform_map_ = results.uniform_map;
+  varying_map_ = results.varying_map;
+  name_map_ = results.name_map;
+}
+
 }  // namespace gles2
 }  // namespace gpu
 
@@ -9,6 +9,7 @@
 
 #include "base/basictypes.h"
 #include "base/containers/hash_tables.h"
+#include "base/containers/mru_cache.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/observer_list.h"
@@ -96,7 +97,9 @@ class ShaderTranslatorInterface {
   virtual ~ShaderTranslatorInterface() {}
 };
 
-// Implementation of ShaderTranslatorInterface
+// Implementation of ShaderTranslatorInterface. Since its options never change
+// after Init, it remembers the results of recent successful translations and
+// returns them for the same source without running the compiler again.
 class GPU_EXPORT ShaderTranslator
     : public base::RefCounted<ShaderTranslator>,
       NON_EXPORTED_BASE(public ShaderTranslatorInterface) {
@@ -144,10 +147,30 @@ class GPU_EXPORT ShaderTranslator
  private:
   friend class base::RefCounted<ShaderTranslator>;
 
+  // The results of a successful translation.
+  struct TranslationResults {
+    TranslationResults();
+    ~TranslationResults();
+
+    std::string translated_shader;
+    std::string info_log;
+    VariableMap attrib_map;
+    VariableMap uniform_map;
+    VariableMap varying_map;
+    NameMap name_map;
+  };
+
+  // Translations cached by the SHA-1 hash of their source.
+  typedef base::MRUCache<std::string, TranslationResults> TranslationCache;
+
   virtual ~ShaderTranslator();
   void ClearResults();
   int GetCompileOptions() const;
 
+  // Copies the current results to or from |results|.
+  void SaveResults(TranslationResults* results) const;
+  void RestoreResults(const TranslationResults& results);
+
   ShHandle compiler_;
   ShBuiltInResources compiler_options_;
   scoped_ptr<char[]> translated_shader_;
@@ -158,6 +181,7 @@ class GPU_EXPORT ShaderTranslator
   NameMap name_map_;
   bool implementation_is_glsl_es_;
   ShCompileOptions driver_bug_workarounds_;
+  TranslationCache translation_cache_;
   ObserverList<DestructionObserver> destruction_observers_;
 
   DISALLOW_COPY_AND_ASSIGN(ShaderTranslator);
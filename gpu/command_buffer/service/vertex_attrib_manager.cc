@@ -94,7 +94,12 @@ VertexAttribManager::VertexAttribManager()
       element_array_buffer_(NULL),
       manager_(NULL),
       deleted_(false),
-      service_id_(0) {
+      service_id_(0),
+      validated_program_(NULL),
+      validated_program_attrib_serial_(0),
+      validated_buffer_size_serial_(0),
+      validated_max_vertex_accessed_(0),
+      validated_primcount_(0) {
 }
 
 VertexAttribManager::VertexAttribManager(
@@ -103,7 +108,12 @@ VertexAttribManager::VertexAttribManager(
       element_array_buffer_(NULL),
       manager_(manager),
       deleted_(false),
-      service_id_(service_id) {
+      service_id_(service_id),
+      validated_program_(NULL),
+      validated_program_attrib_serial_(0),
+      validated_buffer_size_serial_(0),
+      validated_max_vertex_accessed_(0),
+      validated_primcount_(0) {
   manager_->StartTracking(this);
   Initialize(num_vertex_attribs, false);
 }
@@ -147,6 +157,7 @@ bool VertexAttribManager::Enable(GLuint index, bool enable) {
   if (info.enabled() != enable) {
     info.set_enabled(enable);
     info.SetList(enable ? &enabled_vertex_attribs_ : &disabled_vertex_attribs_);
+    InvalidateValidatedBindings();
   }
   return true;
 }
@@ -158,22 +169,48 @@ void VertexAttribManager::Unbind(Buffer* buffer) {
   for (uint32 vv = 0; vv < vertex_attribs_.size(); ++vv) {
     vertex_attribs_[vv].Unbind(buffer);
   }
+  InvalidateValidatedBindings();
+}
+
+bool VertexAttribManager::AreBindingsValidated(
+    BufferManager* buffer_manager,
+    Program* current_program,
+    GLuint max_vertex_accessed,
+    GLsizei primcount) const {
+  // Instanced attribs access |max_vertex_accessed| vertices in a non-instanced
+  // draw, so an instanced check does not cover a non-instanced draw or vice
+  // versa.
+  return validated_program_ == current_program &&
+         validated_program_attrib_serial_ ==
+             current_program->attrib_serial() &&
+         validated_buffer_size_serial_ == buffer_manager->size_serial() &&
+         max_vertex_accessed <= validated_max_vertex_accessed_ &&
+         primcount <= validated_primcount_ &&
+         (primcount == 0) == (validated_primcount_ == 0);
 }
 
 bool VertexAttribManager::ValidateBindings(
     const char* function_name,
     GLES2Decoder* decoder,
     FeatureInfo* feature_info,
+    BufferManager* buffer_manager,
     Program* current_program,
     GLuint max_vertex_accessed,
     GLsizei primcount) {
+  bool use_client_side_arrays_for_stream_buffers = feature_info->workarounds(
+      ).use_client_side_arrays_for_stream_buffers;
+  // The client side array workaround has to set up the attribs for every draw.
+  if (!use_client_side_arrays_for_stream_buffers &&
+      AreBindingsValidated(buffer_manager, current_program,
+                           max_vertex_accessed, primcount)) {
+    return true;
+  }
+
   ErrorState* error_state = decoder->GetErrorState();
   // true if any enabled, used divisor is zero
   bool divisor0 = false;
   const GLuint kInitialBufferId = 0xFFFFFFFFU;
   GLuint current_buffer_id = kInitialBufferId;
-  bool use_client_side_arrays_for_stream_buffers = feature_info->workarounds(
-      ).use_client_side_arrays_for_stream_buffers;
   // Validate all attribs currently enabled. If they are used by the current
   // program then check that they have enough elements to handle the draw call.
   // If they are not used by the current program check that they have a buffer
@@ -267,6 +304,11 @@ bool VertexAttribManager::ValidateBindings(
     decoder->RestoreBufferBindings();
   }
 
+  validated_program_ = current_program;
+  validated_program_attrib_serial_ = current_program->attrib_serial();
+  validated_buffer_size_serial_ = buffer_manager->size_serial();
+  validated_max_vertex_accessed_ = max_vertex_accessed;
+  validated_primcount_ = primcount;
   return true;
 }
 
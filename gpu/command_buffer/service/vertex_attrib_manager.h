@@ -209,6 +209,7 @@ class GPU_EXPORT VertexAttribManager :
       }
       attrib->SetInfo(
           buffer, size, type, normalized, gl_stride, real_stride, offset);
+      InvalidateValidatedBindings();
     }
   }
 
@@ -216,6 +217,7 @@ class GPU_EXPORT VertexAttribManager :
     VertexAttrib* attrib = GetVertexAttrib(index);
     if (attrib) {
       attrib->SetDivisor(divisor);
+      InvalidateValidatedBindings();
     }
   }
 
@@ -241,10 +243,15 @@ class GPU_EXPORT VertexAttribManager :
     return vertex_attribs_.size();
   }
 
+  // Checks that the enabled attribs can be drawn with |current_program|.
+  // The last successful check is remembered, so drawing no more vertices and
+  // instances than it with the same program, attribs and buffer sizes is only
+  // a comparison.
   bool ValidateBindings(
       const char* function_name,
       GLES2Decoder* decoder,
       FeatureInfo* feature_info,
+      BufferManager* buffer_manager,
       Program* current_program,
       GLuint max_vertex_accessed,
       GLsizei primcount);
@@ -264,6 +271,17 @@ class GPU_EXPORT VertexAttribManager :
     deleted_ = true;
   }
 
+  void InvalidateValidatedBindings() {
+    validated_program_ = NULL;
+  }
+
+  // Returns true if a draw with the given arguments is covered by the last
+  // successful ValidateBindings.
+  bool AreBindingsValidated(BufferManager* buffer_manager,
+                            Program* current_program,
+                            GLuint max_vertex_accessed,
+                            GLsizei primcount) const;
+
   // number of attribs using type GL_FIXED.
   int num_fixed_attribs_;
 
@@ -287,6 +305,16 @@ class GPU_EXPORT VertexAttribManager :
 
   // Service side vertex array object id.
   GLuint service_id_;
+
+  // The arguments of the last successful ValidateBindings, or NULL
+  // |validated_program_| if there was none since the attribs last changed.
+  // Accessing fewer vertices or instances is valid as well, unless the program
+  // or the size of a buffer changed since.
+  Program* validated_program_;
+  uint32 validated_program_attrib_serial_;
+  uint32 validated_buffer_size_serial_;
+  GLuint validated_max_vertex_accessed_;
+  GLsizei validated_primcount_;
 };
 
 }  // namespace gles2
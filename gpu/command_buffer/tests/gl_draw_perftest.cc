@@ -0,0 +1,127 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// This measures how many draw calls the client and the decoder get through,
+// which is dominated by the validation of each draw when nothing is rendered.
+
+#include <GLES2/gl2.h>
+#include <GLES2/gl2ext.h>
+
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "gpu/command_buffer/tests/gl_manager.h"
+#include "gpu/command_buffer/tests/gl_test_utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+#define SHADER(Src) #Src
+
+namespace gpu {
+
+class GLDrawPerfTest : public testing::Test {
+ protected:
+  static const int kSize = 1;
+  static const int kNumDraws = 10000;
+
+  virtual void SetUp() {
+    GLManager::Options options;
+    options.size = gfx::Size(kSize, kSize);
+    gl_.Initialize(options);
+  }
+
+  virtual void TearDown() {
+    gl_.Destroy();
+  }
+
+  // Issues |kNumDraws| draw calls with the current state and reports the
+  // number of draw calls per second.
+  void MeasureDraws(const std::string& trace, bool elements) {
+    // Draw once so that the first draw of the state is not measured.
+    Draw(elements);
+    glFinish();
+
+    base::TimeTicks start = base::TimeTicks::HighResNow();
+    for (int i = 0; i < kNumDraws; ++i)
+      Draw(elements);
+    glFinish();
+    base::TimeDelta elapsed = base::TimeTicks::HighResNow() - start;
+    GLTestHelper::CheckGLError("no errors", __LINE__);
+
+    perf_test::PrintResult(
+        "draw_calls", "", trace, kNumDraws / elapsed.InSecondsF(),
+        "draws/s", true);
+  }
+
+  void Draw(bool elements) {
+    if (elements)
+      glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0);
+    else
+      glDrawArrays(GL_TRIANGLES, 0, 6);
+  }
+
+  GLManager gl_;
+};
+
+namespace {
+
+// Sets up a program with |num_attribs| attribs, each reading from a unit quad
+// in its own buffer.
+void SetupProgram(int num_attribs) {
+  std::string v_shader_str;
+  std::string sum;
+  for (int i = 0; i < num_attribs; ++i) {
+    v_shader_str += base::StringPrintf("attribute vec4 a_%d;\n", i);
+    sum += base::StringPrintf("%sa_%d", i ? " + " : "", i);
+  }
+  v_shader_str += "void main() {\n  gl_Position = " + sum + ";\n}\n";
+
+  static const char* f_shader_str = SHADER(
+      precision mediump float;
+      void main()
+      {
+        gl_FragColor = vec4(1.0, 0.0, 0.0, 1.0);
+      }
+  );
+
+  GLuint program = GLTestHelper::LoadProgram(v_shader_str.c_str(),
+                                             f_shader_str);
+  glUseProgram(program);
+  for (int i = 0; i < num_attribs; ++i) {
+    GLint location = glGetAttribLocation(
+        program, base::StringPrintf("a_%d", i).c_str());
+    GLTestHelper::SetupUnitQuad(location);
+  }
+}
+
+void SetupIndices() {
+  static const GLushort kIndices[] = { 0, 1, 2, 3, 4, 5, };
+  GLuint buffer = 0;
+  glGenBuffers(1, &buffer);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(kIndices), kIndices,
+               GL_STATIC_DRAW);
+}
+
+}  // anonymous namespace
+
+TEST_F(GLDrawPerfTest, DrawArrays) {
+  static const int kNumAttribs[] = { 1, 4, 8 };
+  for (size_t i = 0; i < arraysize(kNumAttribs); ++i) {
+    SetupProgram(kNumAttribs[i]);
+    MeasureDraws(base::StringPrintf("arrays_%d_attribs", kNumAttribs[i]),
+                 false);
+  }
+}
+
+TEST_F(GLDrawPerfTest, DrawElements) {
+  SetupIndices();
+  static const int kNumAttribs[] = { 1, 4, 8 };
+  for (size_t i = 0; i < arraysize(kNumAttribs); ++i) {
+    SetupProgram(kNumAttribs[i]);
+    MeasureDraws(base::StringPrintf("elements_%d_attribs", kNumAttribs[i]),
+                 true);
+  }
+}
+
+}  // namespace gpu
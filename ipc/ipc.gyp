@@ -57,6 +57,7 @@
         'ipc_test_base.cc',
         'ipc_test_base.h',
         'run_all_unittests.cc',
+        'shared_memory_ring_posix_unittest.cc',
         'sync_socket_unittest.cc',
         'unix_domain_socket_util_unittest.cc',
       ],
@@ -12,6 +12,7 @@
 #endif
 
 #include "base/compiler_specific.h"
+#include "base/memory/scoped_vector.h"
 #include "base/process/process.h"
 #include "ipc/ipc_channel_handle.h"
 #include "ipc/ipc_message.h"
@@ -90,7 +91,11 @@ class IPC_EXPORT Channel : public Sender {
     // The client will return the message with hops = 1, *after* it
     // has received the message that contains the FD. When we
     // receive it again on the sender side, we close the FD.
-    CLOSE_FD_MESSAGE_TYPE = HELLO_MESSAGE_TYPE - 1
+    CLOSE_FD_MESSAGE_TYPE = HELLO_MESSAGE_TYPE - 1,
+    // The SHARED_MEMORY_RING_MESSAGE_TYPE is used on POSIX to move the
+    // message bytes from the socket to shared memory rings, see
+    // ipc_channel_posix.h.
+    SHARED_MEMORY_RING_MESSAGE_TYPE = HELLO_MESSAGE_TYPE - 2
   };
 
   // The maximum message size in bytes. Attempting to receive a message of this
@@ -149,6 +154,11 @@ class IPC_EXPORT Channel : public Sender {
   // deleted once the contents of the Message have been sent.
   virtual bool Send(Message* message) OVERRIDE;
 
+  // Sends |messages| in order, the same as calling Send() for each of them,
+  // but lets the channel write them out together. Takes ownership of the
+  // messages and clears |messages|.
+  bool SendBatch(ScopedVector<Message>* messages);
+
 #if defined(OS_POSIX)
   // On POSIX an IPC::Channel wraps a socketpair(), this method returns the
   // FD # for the client end of the socket.
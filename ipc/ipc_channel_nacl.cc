@@ -265,6 +265,7 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
     DCHECK(num_fds <= FileDescriptorSet::kMaxDescriptorsPerMessage);
     msg->file_descriptor_set()->GetDescriptors(fds);
 
+    msg->Flatten();
     NaClAbiNaClImcMsgIoVec iov = {
       const_cast<void*>(msg->data()), msg->size()
     };
@@ -381,4 +382,12 @@ bool Channel::Send(Message* message) {
   return channel_impl_->Send(message);
 }
 
+bool Channel::SendBatch(ScopedVector<Message>* messages) {
+  bool result = true;
+  for (size_t i = 0; i < messages->size(); ++i)
+    result = channel_impl_->Send((*messages)[i]) && result;
+  messages->weak_clear();
+  return result;
+}
+
 }  // namespace IPC
@@ -6,19 +6,18 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <limits.h>
 #include <stddef.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 #include <unistd.h>
 
-#if defined(OS_OPENBSD)
-#include <sys/uio.h>
-#endif
-
 #include <map>
 #include <string>
+#include <vector>
 
 #include "base/command_line.h"
 #include "base/file_util.h"
@@ -40,6 +39,7 @@
 #include "ipc/ipc_logging.h"
 #include "ipc/ipc_message_utils.h"
 #include "ipc/ipc_switches.h"
+#include "ipc/shared_memory_ring_posix.h"
 #include "ipc/unix_domain_socket_util.h"
 
 namespace IPC {
@@ -158,6 +158,41 @@ bool SocketWriteErrorIsRecoverable() {
 #endif  // OS_MACOSX
 }
 
+// Fills |iov| with the part of |msg| that follows its first |bytes_written|
+// bytes.  A message with external data is written straight from its
+// segments, without copying them together first.  At most IOV_MAX vectors
+// are filled in, so they may not cover the whole remainder of the message.
+void GetUnwrittenSegments(const Message& msg,
+                          size_t bytes_written,
+                          std::vector<struct iovec>* iov) {
+  std::vector<Pickle::Segment> segments;
+  msg.GetSegments(&segments);
+  for (size_t i = 0;
+       i < segments.size() && iov->size() < static_cast<size_t>(IOV_MAX);
+       ++i) {
+    if (bytes_written >= segments[i].size) {
+      bytes_written -= segments[i].size;
+      continue;
+    }
+    struct iovec segment = {
+      const_cast<char*>(segments[i].data) + bytes_written,
+      segments[i].size - bytes_written
+    };
+    iov->push_back(segment);
+    bytes_written = 0;
+  }
+}
+
+#if defined(IPC_USES_READWRITE)
+// The longest a channel spins on its empty input ring before blocking.
+const int kMaxRingSpinMicroseconds = 50;
+
+void CloseDescriptor(int fd) {
+  if (IGNORE_EINTR(close(fd)) < 0)
+    PLOG(ERROR) << "close";
+}
+#endif  // IPC_USES_READWRITE
+
 }  // namespace
 //------------------------------------------------------------------------------
 
@@ -179,6 +214,12 @@ Channel::ChannelImpl::ChannelImpl(const IPC::ChannelHandle& channel_handle,
 #if defined(IPC_USES_READWRITE)
       fd_pipe_(-1),
       remote_fd_pipe_(-1),
+      output_ring_switch_message_(NULL),
+      output_ring_active_(false),
+      input_ring_active_(false),
+      input_ring_failed_(false),
+      pipe_readable_(false),
+      peer_closed_(false),
 #endif  // IPC_USES_READWRITE
       pipe_name_(channel_handle.name),
       must_unlink_(false) {
@@ -368,6 +409,39 @@ void Channel::ChannelImpl::CloseFileDescriptors(Message* msg) {
 #endif
 }
 
+// static
+void Channel::ChannelImpl::AttachFileDescriptors(Message* msg,
+                                                 char* buf,
+                                                 struct msghdr* msgh) {
+  struct cmsghdr *cmsg;
+  const unsigned num_fds = msg->file_descriptor_set()->size();
+
+  DCHECK(num_fds <= FileDescriptorSet::kMaxDescriptorsPerMessage);
+  if (msg->file_descriptor_set()->ContainsDirectoryDescriptor()) {
+    LOG(FATAL) << "Panic: attempting to transport directory descriptor over"
+                  " IPC. Aborting to maintain sandbox isolation.";
+    // If you have hit this then something tried to send a file descriptor
+    // to a directory over an IPC channel. Since IPC channels span
+    // sandboxes this is very bad: the receiving process can use openat
+    // with ".." elements in the path in order to reach the real
+    // filesystem.
+  }
+
+  msgh->msg_control = buf;
+  msgh->msg_controllen = CMSG_SPACE(sizeof(int) * num_fds);
+  cmsg = CMSG_FIRSTHDR(msgh);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(int) * num_fds);
+  msg->file_descriptor_set()->GetDescriptors(
+      reinterpret_cast<int*>(CMSG_DATA(cmsg)));
+  msgh->msg_controllen = cmsg->cmsg_len;
+
+  // DCHECK_LE above already checks that
+  // num_fds < kMaxDescriptorsPerMessage so no danger of overflow.
+  msg->header()->num_fds = static_cast<uint16>(num_fds);
+}
+
 bool Channel::ChannelImpl::ProcessOutgoingMessages() {
   DCHECK(!waiting_connect_);  // Why are we trying to send messages if there's
                               // no connection?
@@ -380,17 +454,20 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
   // Write out all the messages we can till the write blocks or there are no
   // more outgoing messages.
   while (!output_queue_.empty()) {
+#if defined(IPC_USES_READWRITE)
+    if (output_ring_active_)
+      return ProcessOutgoingMessagesToRing();
+#endif  // IPC_USES_READWRITE
     Message* msg = output_queue_.front();
 
     size_t amt_to_write = msg->size() - message_send_bytes_written_;
     DCHECK_NE(0U, amt_to_write);
-    const char* out_bytes = reinterpret_cast<const char*>(msg->data()) +
-        message_send_bytes_written_;
+    std::vector<struct iovec> iov;
+    GetUnwrittenSegments(*msg, message_send_bytes_written_, &iov);
 
     struct msghdr msgh = {0};
-    struct iovec iov = {const_cast<char*>(out_bytes), amt_to_write};
-    msgh.msg_iov = &iov;
-    msgh.msg_iovlen = 1;
+    msgh.msg_iov = &iov[0];
+    msgh.msg_iovlen = iov.size();
     char buf[CMSG_SPACE(
         sizeof(int) * FileDescriptorSet::kMaxDescriptorsPerMessage)];
 
@@ -400,33 +477,7 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
     if (message_send_bytes_written_ == 0 &&
         !msg->file_descriptor_set()->empty()) {
       // This is the first chunk of a message which has descriptors to send
-      struct cmsghdr *cmsg;
-      const unsigned num_fds = msg->file_descriptor_set()->size();
-
-      DCHECK(num_fds <= FileDescriptorSet::kMaxDescriptorsPerMessage);
-      if (msg->file_descriptor_set()->ContainsDirectoryDescriptor()) {
-        LOG(FATAL) << "Panic: attempting to transport directory descriptor over"
-                      " IPC. Aborting to maintain sandbox isolation.";
-        // If you have hit this then something tried to send a file descriptor
-        // to a directory over an IPC channel. Since IPC channels span
-        // sandboxes this is very bad: the receiving process can use openat
-        // with ".." elements in the path in order to reach the real
-        // filesystem.
-      }
-
-      msgh.msg_control = buf;
-      msgh.msg_controllen = CMSG_SPACE(sizeof(int) * num_fds);
-      cmsg = CMSG_FIRSTHDR(&msgh);
-      cmsg->cmsg_level = SOL_SOCKET;
-      cmsg->cmsg_type = SCM_RIGHTS;
-      cmsg->cmsg_len = CMSG_LEN(sizeof(int) * num_fds);
-      msg->file_descriptor_set()->GetDescriptors(
-          reinterpret_cast<int*>(CMSG_DATA(cmsg)));
-      msgh.msg_controllen = cmsg->cmsg_len;
-
-      // DCHECK_LE above already checks that
-      // num_fds < kMaxDescriptorsPerMessage so no danger of overflow.
-      msg->header()->num_fds = static_cast<uint16>(num_fds);
+      AttachFileDescriptors(msg, buf, &msgh);
 
 #if defined(IPC_USES_READWRITE)
       if (!IsHelloMessage(*msg)) {
@@ -435,9 +486,11 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
         // fd_pipe_ which makes Seccomp sandbox operation more efficient.
         struct iovec fd_pipe_iov = { const_cast<char *>(""), 1 };
         msgh.msg_iov = &fd_pipe_iov;
+        msgh.msg_iovlen = 1;
         fd_written = fd_pipe_;
         bytes_written = HANDLE_EINTR(sendmsg(fd_pipe_, &msgh, MSG_DONTWAIT));
-        msgh.msg_iov = &iov;
+        msgh.msg_iov = &iov[0];
+        msgh.msg_iovlen = iov.size();
         msgh.msg_controllen = 0;
         if (bytes_written > 0) {
           CloseFileDescriptors(msg);
@@ -446,6 +499,14 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
 #endif  // IPC_USES_READWRITE
     }
 
+    // The messages queued behind this one go out in the same write, unless
+    // this one passes descriptors on the pipe_ itself.
+    if (bytes_written == 1 && !msgh.msg_controllen) {
+      amt_to_write += AppendQueuedMessages(&iov);
+      msgh.msg_iov = &iov[0];
+      msgh.msg_iovlen = iov.size();
+    }
+
     if (bytes_written == 1) {
       fd_written = pipe_;
 #if defined(IPC_USES_READWRITE)
@@ -453,7 +514,7 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
         DCHECK_EQ(msg->file_descriptor_set()->size(), 1U);
       }
       if (!msgh.msg_controllen) {
-        bytes_written = HANDLE_EINTR(write(pipe_, out_bytes, amt_to_write));
+        bytes_written = HANDLE_EINTR(writev(pipe_, &iov[0], iov.size()));
       } else
 #endif  // IPC_USES_READWRITE
       {
@@ -486,12 +547,19 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
       return false;
     }
 
-    if (static_cast<size_t>(bytes_written) != amt_to_write) {
-      if (bytes_written > 0) {
-        // If write() fails with EAGAIN then bytes_written will be -1.
-        message_send_bytes_written_ += bytes_written;
-      }
+    // Retire the messages this write completed. If write() fails with
+    // EAGAIN then bytes_written will be -1.
+    size_t bytes_left = bytes_written > 0 ? bytes_written : 0;
+    while (bytes_left > 0 && !output_queue_.empty() &&
+           bytes_left >= output_queue_.front()->size() -
+                             message_send_bytes_written_) {
+      bytes_left -= output_queue_.front()->size() - message_send_bytes_written_;
+      if (!PopSentMessage())
+        return false;
+    }
+    message_send_bytes_written_ += bytes_left;
 
+    if (static_cast<size_t>(bytes_written) != amt_to_write) {
       // Tell libevent to call us back once things are unblocked.
       is_blocked_on_write_ = true;
       base::MessageLoopForIO::current()->WatchFileDescriptor(
@@ -501,20 +569,170 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
           &write_watcher_,
           this);
       return true;
-    } else {
-      message_send_bytes_written_ = 0;
+    }
+  }
+  return true;
+}
+
+size_t Channel::ChannelImpl::AppendQueuedMessages(
+    std::vector<struct iovec>* iov) {
+  size_t old_size = iov->size();
+  for (std::deque<Message*>::const_iterator it = output_queue_.begin();
+       it + 1 != output_queue_.end() &&
+       iov->size() < static_cast<size_t>(IOV_MAX);
+       ++it) {
+#if defined(IPC_USES_READWRITE)
+    // The messages after the switch go to output_ring_.
+    if (*it == output_ring_switch_message_)
+      break;
+#endif  // IPC_USES_READWRITE
+    const Message* next = *(it + 1);
+    // Descriptors have to be sent ahead of the first chunk of their message.
+    if (next->HasFileDescriptors())
+      break;
+    GetUnwrittenSegments(*next, 0, iov);
+  }
+
+  size_t appended_size = 0;
+  for (size_t i = old_size; i < iov->size(); ++i)
+    appended_size += (*iov)[i].iov_len;
+  return appended_size;
+}
 
-      // Message sent OK!
-      DVLOG(2) << "sent message @" << msg << " on channel @" << this
-               << " with type " << msg->type() << " on fd " << pipe_;
-      delete output_queue_.front();
-      output_queue_.pop();
+bool Channel::ChannelImpl::PopSentMessage() {
+  Message* msg = output_queue_.front();
+  message_send_bytes_written_ = 0;
+
+  // Message sent OK!
+  DVLOG(2) << "sent message @" << msg << " on channel @" << this
+           << " with type " << msg->type() << " on fd " << pipe_;
+#if defined(IPC_USES_READWRITE)
+  bool switched_to_ring = msg == output_ring_switch_message_;
+#endif  // IPC_USES_READWRITE
+  delete msg;
+  output_queue_.pop_front();
+
+#if defined(IPC_USES_READWRITE)
+  if (switched_to_ring) {
+    output_ring_switch_message_ = NULL;
+    output_ring_active_ = true;
+    // The peer may have blocked on a full input_ring_ while the pipe_ still
+    // carried messages.
+    if (input_ring_active_ && input_ring_->ProducerIsWaiting())
+      return WakeUpPeer();
+  }
+#endif  // IPC_USES_READWRITE
+  return true;
+}
+
+#if defined(IPC_USES_READWRITE)
+bool Channel::ChannelImpl::ProcessOutgoingMessagesToRing() {
+  bool wrote = false;
+  while (!output_queue_.empty()) {
+    Message* msg = output_queue_.front();
+
+    if (message_send_bytes_written_ == 0 &&
+        !msg->file_descriptor_set()->empty()) {
+      // The descriptors go ahead of the message on the fd_pipe_, the same as
+      // in ProcessOutgoingMessages().
+      char buf[CMSG_SPACE(
+          sizeof(int) * FileDescriptorSet::kMaxDescriptorsPerMessage)];
+      struct iovec fd_pipe_iov = { const_cast<char *>(""), 1 };
+      struct msghdr msgh = {0};
+      msgh.msg_iov = &fd_pipe_iov;
+      msgh.msg_iovlen = 1;
+      AttachFileDescriptors(msg, buf, &msgh);
+      if (HANDLE_EINTR(sendmsg(fd_pipe_, &msgh, MSG_DONTWAIT)) < 0) {
+        if (!SocketWriteErrorIsRecoverable()) {
+          if (errno != EPIPE)
+            PLOG(ERROR) << "pipe error on " << fd_pipe_;
+          return false;
+        }
+        // Retry once the pipe_ is writable, as ProcessOutgoingMessages()
+        // does.
+        is_blocked_on_write_ = true;
+        base::MessageLoopForIO::current()->WatchFileDescriptor(
+            pipe_,
+            false,  // One shot
+            base::MessageLoopForIO::WATCH_WRITE,
+            &write_watcher_,
+            this);
+        break;
+      }
+      CloseFileDescriptors(msg);
+    }
+
+    std::vector<struct iovec> iov;
+    GetUnwrittenSegments(*msg, message_send_bytes_written_, &iov);
+    bool ring_full = false;
+    for (size_t i = 0; i < iov.size() && !ring_full; ++i) {
+      int written = output_ring_->Write(
+          static_cast<const char*>(iov[i].iov_base), iov[i].iov_len);
+      if (written < 0) {
+        LOG(ERROR) << "Peer corrupted the shared memory ring";
+        return false;
+      }
+      wrote |= written > 0;
+      message_send_bytes_written_ += written;
+      ring_full = static_cast<size_t>(written) != iov[i].iov_len;
+    }
+
+    if (message_send_bytes_written_ != msg->size()) {
+      // Either more segments than one iovec batch, or a full ring. The
+      // consumer wakes us up once it frees space, unless it did so already.
+      if (!ring_full || !output_ring_->WaitForSpace())
+        continue;
+      is_blocked_on_write_ = true;
+      break;
     }
+
+    message_send_bytes_written_ = 0;
+    DVLOG(2) << "sent message @" << msg << " on channel @" << this
+             << " with type " << msg->type() << " to shared memory";
+    delete output_queue_.front();
+    output_queue_.pop_front();
+  }
+
+  if (wrote && output_ring_->ConsumerIsWaiting())
+    return WakeUpPeer();
+  return true;
+}
+
+bool Channel::ChannelImpl::WakeUpPeer() {
+  // The peer reads all wakeups at once, so a full socket buffer already
+  // holds enough of them.
+  char wakeup = 0;
+  if (HANDLE_EINTR(write(pipe_, &wakeup, 1)) < 0 &&
+      !SocketWriteErrorIsRecoverable()) {
+    if (errno != EPIPE)
+      PLOG(ERROR) << "pipe error on " << pipe_;
+    return false;
   }
   return true;
 }
+#endif  // IPC_USES_READWRITE
 
 bool Channel::ChannelImpl::Send(Message* message) {
+  QueueOutgoingMessage(message);
+  if (!is_blocked_on_write_ && !waiting_connect_) {
+    return ProcessOutgoingMessages();
+  }
+
+  return true;
+}
+
+bool Channel::ChannelImpl::SendBatch(ScopedVector<Message>* messages) {
+  for (size_t i = 0; i < messages->size(); ++i)
+    QueueOutgoingMessage((*messages)[i]);
+  messages->weak_clear();
+  if (!is_blocked_on_write_ && !waiting_connect_) {
+    return ProcessOutgoingMessages();
+  }
+
+  return true;
+}
+
+void Channel::ChannelImpl::QueueOutgoingMessage(Message* message) {
   DVLOG(2) << "sending message @" << message << " on channel @" << this
            << " with type " << message->type()
            << " (" << output_queue_.size() << " in queue)";
@@ -524,12 +742,7 @@ bool Channel::ChannelImpl::Send(Message* message) {
 #endif  // IPC_MESSAGE_LOG_ENABLED
 
   message->TraceMessageBegin();
-  output_queue_.push(message);
-  if (!is_blocked_on_write_ && !waiting_connect_) {
-    return ProcessOutgoingMessages();
-  }
-
-  return true;
+  output_queue_.push_back(message);
 }
 
 int Channel::ChannelImpl::GetClientFileDescriptor() {
@@ -590,11 +803,21 @@ void Channel::ChannelImpl::ResetToAcceptingConnectionState() {
       PLOG(ERROR) << "close remote_fd_pipe_ " << pipe_name_;
     remote_fd_pipe_ = -1;
   }
+  output_ring_.reset();
+  input_ring_.reset();
+  output_ring_switch_message_ = NULL;
+  output_ring_active_ = false;
+  input_ring_active_ = false;
+  input_ring_failed_ = false;
+  pipe_readable_ = false;
+  peer_closed_ = false;
+  ring_spin_time_ = base::TimeDelta();
+  ring_wait_start_ = base::TimeTicks();
 #endif  // IPC_USES_READWRITE
 
   while (!output_queue_.empty()) {
     Message* m = output_queue_.front();
-    output_queue_.pop();
+    output_queue_.pop_front();
     delete m;
   }
 
@@ -671,12 +894,20 @@ void Channel::ChannelImpl::OnFileCanReadWithoutBlocking(int fd) {
     if (waiting_connect_ && (mode_ & MODE_SERVER_FLAG)) {
       waiting_connect_ = false;
     }
+#if defined(IPC_USES_READWRITE)
+    pipe_readable_ = true;
+#endif  // IPC_USES_READWRITE
     if (!ProcessIncomingMessages()) {
       // ClosePipeOnError may delete this object, so we mustn't call
       // ProcessOutgoingMessages.
       ClosePipeOnError();
       return;
     }
+#if defined(IPC_USES_READWRITE)
+    // The wakeup may also mean that the peer freed space in output_ring_.
+    if (output_ring_active_)
+      is_blocked_on_write_ = false;
+#endif  // IPC_USES_READWRITE
   } else {
     NOTREACHED() << "Unknown pipe " << fd;
   }
@@ -705,6 +936,15 @@ bool Channel::ChannelImpl::AcceptConnection() {
   base::MessageLoopForIO::current()->WatchFileDescriptor(
       pipe_, true, base::MessageLoopForIO::WATCH_READ, &read_watcher_, this);
   QueueHelloMessage();
+#if defined(IPC_USES_READWRITE)
+  if ((mode_ & MODE_SERVER_FLAG) &&
+      CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kIPCSharedMemoryRing)) {
+    output_ring_ = internal::SharedMemoryRing::Create();
+    if (output_ring_ && !QueueSharedMemoryRingMessage(true))
+      output_ring_.reset();
+  }
+#endif  // IPC_USES_READWRITE
 
   if (mode_ & MODE_CLIENT_FLAG) {
     // If we are a client we want to send a hello message out immediately.
@@ -764,15 +1004,159 @@ void Channel::ChannelImpl::QueueHelloMessage() {
     DCHECK_EQ(msg->file_descriptor_set()->size(), 1U);
   }
 #endif  // IPC_USES_READWRITE
-  output_queue_.push(msg.release());
+  output_queue_.push_back(msg.release());
+}
+
+#if defined(IPC_USES_READWRITE)
+Message* Channel::ChannelImpl::QueueSharedMemoryRingMessage(bool offer) {
+  scoped_ptr<Message> msg(new Message(MSG_ROUTING_NONE,
+                                      SHARED_MEMORY_RING_MESSAGE_TYPE,
+                                      IPC::Message::PRIORITY_NORMAL));
+  if (!msg->WriteBool(offer)) {
+    NOTREACHED() << "Unable to pickle shared memory ring message";
+  }
+  if (offer) {
+    int fd = output_ring_->DuplicateFileDescriptor();
+    if (fd < 0)
+      return NULL;
+    if (!msg->WriteFileDescriptor(base::FileDescriptor(fd, true))) {
+      NOTREACHED() << "Unable to pickle shared memory ring descriptor";
+      CloseDescriptor(fd);
+      return NULL;
+    }
+  }
+  output_queue_.push_back(msg.get());
+  return msg.release();
 }
 
+void Channel::ChannelImpl::OnSharedMemoryRingMessage(const Message& msg,
+                                                     PickleIterator* iter) {
+  bool offer;
+  base::FileDescriptor descriptor;
+  if (!msg.ReadBool(iter, &offer) ||
+      (offer && !msg.ReadFileDescriptor(iter, &descriptor))) {
+    input_ring_failed_ = true;
+    return;
+  }
+
+  if (mode_ & MODE_SERVER_FLAG) {
+    // The client answered our offer with its ring, which we read from at
+    // once, since the client writes all later messages to it.
+    if (!offer || !output_ring_ || input_ring_) {
+      if (offer)
+        CloseDescriptor(descriptor.fd);
+      input_ring_failed_ = true;
+      return;
+    }
+    input_ring_ = internal::SharedMemoryRing::Map(descriptor.fd);
+    if (!input_ring_) {
+      input_ring_failed_ = true;
+      return;
+    }
+    input_ring_active_ = true;
+    output_ring_switch_message_ = QueueSharedMemoryRingMessage(false);
+    return;
+  }
+
+  if (!offer) {
+    // The server mapped our ring and writes all later messages to its own.
+    if (!input_ring_ || input_ring_active_) {
+      input_ring_failed_ = true;
+      return;
+    }
+    input_ring_active_ = true;
+    return;
+  }
+  if (input_ring_) {
+    CloseDescriptor(descriptor.fd);
+    input_ring_failed_ = true;
+    return;
+  }
+  // Without an answer, the server keeps writing to the pipe_.
+  input_ring_ = internal::SharedMemoryRing::Map(descriptor.fd);
+  if (input_ring_)
+    output_ring_ = internal::SharedMemoryRing::Create();
+  if (output_ring_)
+    output_ring_switch_message_ = QueueSharedMemoryRingMessage(true);
+  if (!output_ring_switch_message_) {
+    LOG(WARNING) << "Unable to set up shared memory rings";
+    input_ring_.reset();
+    output_ring_.reset();
+  }
+}
+
+Channel::ChannelImpl::ReadState Channel::ChannelImpl::ReadDataFromRing(
+    char* buffer,
+    int buffer_len,
+    int* bytes_read) {
+  if (pipe_readable_) {
+    pipe_readable_ = false;
+    char wakeups[64];
+    ssize_t rv = HANDLE_EINTR(read(pipe_, wakeups, sizeof(wakeups)));
+    if (rv == 0) {
+      peer_closed_ = true;
+    } else if (rv < 0 && errno != EAGAIN) {
+      if (errno != ECONNRESET && errno != EPIPE)
+        PLOG(ERROR) << "pipe error (" << pipe_ << ")";
+      peer_closed_ = true;
+    }
+    if (!ring_wait_start_.is_null()) {
+      // Spin next time only if the peer answered about as fast as spinning
+      // would have caught, and back off otherwise.
+      const base::TimeDelta max_spin_time =
+          base::TimeDelta::FromMicroseconds(kMaxRingSpinMicroseconds);
+      if (base::TimeTicks::Now() - ring_wait_start_ < max_spin_time)
+        ring_spin_time_ = max_spin_time;
+      else
+        ring_spin_time_ = ring_spin_time_ / 2;
+      ring_wait_start_ = base::TimeTicks();
+    }
+  }
+
+  if (!input_ring_->HasData() && !peer_closed_ &&
+      ring_spin_time_ > base::TimeDelta()) {
+    base::TimeTicks spin_end = base::TimeTicks::Now() + ring_spin_time_;
+    while (!input_ring_->HasData() && base::TimeTicks::Now() < spin_end) {
+    }
+  }
+
+  if (!input_ring_->HasData()) {
+    if (peer_closed_)
+      return READ_FAILED;
+    if (input_ring_->WaitForData()) {
+      ring_wait_start_ = base::TimeTicks::Now();
+      return READ_PENDING;
+    }
+  }
+
+  *bytes_read = input_ring_->Read(buffer, buffer_len);
+  if (*bytes_read < 0) {
+    LOG(ERROR) << "Peer corrupted the shared memory ring";
+    return READ_FAILED;
+  }
+  DCHECK(*bytes_read);
+  // Wakeups of the producer go on the pipe_ only once it stopped carrying
+  // messages; until then ProcessOutgoingMessages() defers them.
+  if (output_ring_active_ && input_ring_->ProducerIsWaiting() &&
+      !WakeUpPeer()) {
+    return READ_FAILED;
+  }
+  return READ_SUCCEEDED;
+}
+#endif  // IPC_USES_READWRITE
+
 Channel::ChannelImpl::ReadState Channel::ChannelImpl::ReadData(
     char* buffer,
     int buffer_len,
     int* bytes_read) {
   if (pipe_ == -1)
     return READ_FAILED;
+#if defined(IPC_USES_READWRITE)
+  if (input_ring_failed_)
+    return READ_FAILED;
+  if (input_ring_active_)
+    return ReadDataFromRing(buffer, buffer_len, bytes_read);
+#endif  // IPC_USES_READWRITE
 
   struct msghdr msg = {0};
 
@@ -949,7 +1333,7 @@ void Channel::ChannelImpl::QueueCloseFDMessage(int fd, int hops) {
         NOTREACHED() << "Unable to pickle close fd.";
       }
       // Send(msg.release());
-      output_queue_.push(msg.release());
+      output_queue_.push_back(msg.release());
       break;
     }
 
@@ -991,6 +1375,12 @@ void Channel::ChannelImpl::HandleInternalMessage(const Message& msg) {
       listener()->OnChannelConnected(pid);
       break;
 
+#if defined(IPC_USES_READWRITE)
+    case Channel::SHARED_MEMORY_RING_MESSAGE_TYPE:
+      OnSharedMemoryRingMessage(msg, &iter);
+      break;
+#endif  // IPC_USES_READWRITE
+
 #if defined(OS_MACOSX)
     case Channel::CLOSE_FD_MESSAGE_TYPE:
       int fd, hops;
@@ -1062,6 +1452,10 @@ bool Channel::Send(Message* message) {
   return channel_impl_->Send(message);
 }
 
+bool Channel::SendBatch(ScopedVector<Message>* messages) {
+  return channel_impl_->SendBatch(messages);
+}
+
 int Channel::GetClientFileDescriptor() const {
   return channel_impl_->GetClientFileDescriptor();
 }
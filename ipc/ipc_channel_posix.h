@@ -9,13 +9,16 @@
 
 #include <sys/socket.h>  // for CMSG macros
 
-#include <queue>
+#include <deque>
 #include <set>
 #include <string>
 #include <vector>
 
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
 #include "base/message_loop/message_loop.h"
 #include "base/process/process.h"
+#include "base/time/time.h"
 #include "ipc/file_descriptor_set_posix.h"
 #include "ipc/ipc_channel_reader.h"
 
@@ -44,11 +47,29 @@
 // The HELLO message from the client to the server is always sent using
 // sendmsg because it will contain the file descriptor that the server
 // needs to send file descriptors in later messages.
+//
+// With IPC_USES_READWRITE, the server can also offer the client to move the
+// message bytes to a pair of shared memory rings, see
+// switches::kIPCSharedMemoryRing. Both sides announce their ring with a
+// SHARED_MEMORY_RING_MESSAGE_TYPE message: the server offers its ring after
+// its Hello message, the client answers with its own ring and the server
+// confirms that it has mapped the ring of the client. Each side writes all
+// messages after its last ring message to its ring. From then on the socket
+// only carries single byte wakeups, and file descriptors still travel on the
+// fd_pipe_. A side which finds its input ring empty spins for a short,
+// adaptive while before it asks the peer for a wakeup, since the answer to a
+// message often arrives sooner than blocking and waking up would take.
 #define IPC_USES_READWRITE 1
 #endif
 
 namespace IPC {
 
+#if defined(IPC_USES_READWRITE)
+namespace internal {
+class SharedMemoryRing;
+}  // namespace internal
+#endif
+
 class Channel::ChannelImpl : public internal::ChannelReader,
                              public base::MessageLoopForIO::Watcher {
  public:
@@ -59,6 +80,7 @@ class Channel::ChannelImpl : public internal::ChannelReader,
   bool Connect();
   void Close();
   bool Send(Message* message);
+  bool SendBatch(ScopedVector<Message>* messages);
   int GetClientFileDescriptor();
   int TakeClientFileDescriptor();
   void CloseClientFileDescriptor();
@@ -75,8 +97,22 @@ class Channel::ChannelImpl : public internal::ChannelReader,
  private:
   bool CreatePipe(const IPC::ChannelHandle& channel_handle);
 
+  void QueueOutgoingMessage(Message* message);
   bool ProcessOutgoingMessages();
 
+  // Attaches the descriptors of |msg| to |msgh| in |buf|, which must hold
+  // CMSG_SPACE(sizeof(int) * FileDescriptorSet::kMaxDescriptorsPerMessage)
+  // bytes, and records their number in the header of |msg|.
+  static void AttachFileDescriptors(Message* msg, char* buf, msghdr* msgh);
+
+  // Appends the unwritten segments of the messages queued behind the front
+  // one which can go out in the same write to |iov|, and returns their size.
+  size_t AppendQueuedMessages(std::vector<struct iovec>* iov);
+
+  // Deletes the front message of output_queue_ once it was written out.
+  // Returns false if the channel failed.
+  bool PopSentMessage();
+
   bool AcceptConnection();
   void ClosePipeOnError();
   int GetHelloMessageProcId();
@@ -84,6 +120,23 @@ class Channel::ChannelImpl : public internal::ChannelReader,
   void CloseFileDescriptors(Message* msg);
   void QueueCloseFDMessage(int fd, int hops);
 
+#if defined(IPC_USES_READWRITE)
+  // Queues a SHARED_MEMORY_RING_MESSAGE_TYPE message, which carries the
+  // descriptor of output_ring_ if |offer| is true. Returns the message, or
+  // NULL on failure.
+  Message* QueueSharedMemoryRingMessage(bool offer);
+  void OnSharedMemoryRingMessage(const Message& msg, PickleIterator* iter);
+
+  // Counterparts of ProcessOutgoingMessages() and ReadData() once the
+  // messages travel in the shared memory rings.
+  bool ProcessOutgoingMessagesToRing();
+  ReadState ReadDataFromRing(char* buffer, int buffer_len, int* bytes_read);
+
+  // Writes a wakeup to the pipe_ once the socket only carries wakeups.
+  // Returns false if the pipe is broken.
+  bool WakeUpPeer();
+#endif
+
   // ChannelReader implementation.
   virtual ReadState ReadData(char* buffer,
                              int buffer_len,
@@ -150,6 +203,24 @@ class Channel::ChannelImpl : public internal::ChannelReader,
   // Linux/BSD use a dedicated socketpair() for passing file descriptors.
   int fd_pipe_;
   int remote_fd_pipe_;
+
+  // The rings which carry the messages instead of the pipe_ once both sides
+  // agreed on them, see the comment on IPC_USES_READWRITE.
+  scoped_ptr<internal::SharedMemoryRing> output_ring_;
+  scoped_ptr<internal::SharedMemoryRing> input_ring_;
+  // The last message to write to the pipe_ before switching to output_ring_.
+  const Message* output_ring_switch_message_;
+  bool output_ring_active_;
+  bool input_ring_active_;
+  // Set if the peer sent an invalid ring message, which fails the next read.
+  bool input_ring_failed_;
+  // Set when the pipe_ may hold wakeups or the end of the connection.
+  bool pipe_readable_;
+  bool peer_closed_;
+  // How long to spin on an empty input ring before blocking, and when the
+  // last block started.
+  base::TimeDelta ring_spin_time_;
+  base::TimeTicks ring_wait_start_;
 #endif
 
   // The "name" of our pipe.  On Windows this is the global identifier for
@@ -157,7 +228,7 @@ class Channel::ChannelImpl : public internal::ChannelReader,
   std::string pipe_name_;
 
   // Messages to be sent are queued here.
-  std::queue<Message*> output_queue_;
+  std::deque<Message*> output_queue_;
 
   // We assume a worst case: kReadBufferSize bytes of messages, where each
   // message has no payload and a full complement of descriptors.
@@ -8,6 +8,7 @@
 #include "base/location.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/message_loop/message_loop.h"
 #include "base/single_thread_task_runner.h"
 #include "base/thread_task_runner_handle.h"
 #include "ipc/ipc_channel_proxy.h"
@@ -179,6 +180,16 @@ void ChannelProxy::Context::OnSendMessage(scoped_ptr<Message> message) {
     OnChannelError();
 }
 
+// Called on the IPC::Channel thread
+void ChannelProxy::Context::OnSendMessages(ScopedVector<Message> messages) {
+  if (!channel_.get()) {
+    OnChannelClosed();
+    return;
+  }
+  if (!channel_->SendBatch(&messages))
+    OnChannelError();
+}
+
 // Called on the IPC::Channel thread
 void ChannelProxy::Context::OnAddFilter() {
   std::vector<scoped_refptr<MessageFilter> > new_filters;
@@ -279,6 +290,38 @@ void ChannelProxy::Context::OnDispatchError() {
 
 //-----------------------------------------------------------------------------
 
+// Holds the messages sent on the listener thread until the task which sent
+// them finishes.
+class ChannelProxy::SendBatcher : public base::MessageLoop::TaskObserver {
+ public:
+  explicit SendBatcher(ChannelProxy* proxy) : proxy_(proxy) {
+    base::MessageLoop::current()->AddTaskObserver(this);
+  }
+
+  virtual ~SendBatcher() {
+    if (base::MessageLoop::current())
+      base::MessageLoop::current()->RemoveTaskObserver(this);
+  }
+
+  ScopedVector<Message>* messages() { return &messages_; }
+
+  // base::MessageLoop::TaskObserver implementation.
+  virtual void WillProcessTask(const base::PendingTask& pending_task) OVERRIDE {
+  }
+
+  virtual void DidProcessTask(const base::PendingTask& pending_task) OVERRIDE {
+    proxy_->FlushSendBatch();
+  }
+
+ private:
+  ChannelProxy* proxy_;
+  ScopedVector<Message> messages_;
+
+  DISALLOW_COPY_AND_ASSIGN(SendBatcher);
+};
+
+//-----------------------------------------------------------------------------
+
 ChannelProxy::ChannelProxy(const IPC::ChannelHandle& channel_handle,
                            Channel::Mode mode,
                            Listener* listener,
@@ -341,6 +384,9 @@ void ChannelProxy::Close() {
   // possible that the channel could be closed while it is receiving messages!
   context_->Clear();
 
+  // The messages sent before closing still go out.
+  FlushSendBatch();
+
   if (context_->ipc_task_runner()) {
     context_->ipc_task_runner()->PostTask(
         FROM_HERE, base::Bind(&Context::OnChannelClosed, context_.get()));
@@ -357,6 +403,15 @@ bool ChannelProxy::Send(Message* message) {
   Logging::GetInstance()->OnSendMessage(message, context_->channel_id());
 #endif
 
+  if (send_batcher_ &&
+      context_->listener_task_runner_->BelongsToCurrentThread()) {
+    if (!message->is_sync() && !message->is_reply()) {
+      send_batcher_->messages()->push_back(message);
+      return true;
+    }
+    FlushSendBatch();
+  }
+
   context_->ipc_task_runner()->PostTask(
       FROM_HERE,
       base::Bind(&ChannelProxy::Context::OnSendMessage,
@@ -364,6 +419,26 @@ bool ChannelProxy::Send(Message* message) {
   return true;
 }
 
+void ChannelProxy::EnableSendBatching() {
+  DCHECK(CalledOnValidThread());
+  DCHECK(base::MessageLoop::current());
+  if (!send_batcher_)
+    send_batcher_.reset(new SendBatcher(this));
+}
+
+void ChannelProxy::FlushSendBatch() {
+  if (!send_batcher_ || send_batcher_->messages()->empty())
+    return;
+  if (!context_->ipc_task_runner()) {
+    send_batcher_->messages()->clear();
+    return;
+  }
+  context_->ipc_task_runner()->PostTask(
+      FROM_HERE,
+      base::Bind(&Context::OnSendMessages, context_,
+                 base::Passed(send_batcher_->messages())));
+}
+
 void ChannelProxy::AddFilter(MessageFilter* filter) {
   DCHECK(CalledOnValidThread());
 
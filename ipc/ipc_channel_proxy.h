@@ -9,6 +9,7 @@
 
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
 #include "base/synchronization/lock.h"
 #include "base/threading/non_thread_safe.h"
 #include "ipc/ipc_channel.h"
@@ -131,6 +132,14 @@ class IPC_EXPORT ChannelProxy : public Sender, public base::NonThreadSafe {
   // thread where it is passed to the IPC::Channel's Send method.
   virtual bool Send(Message* message) OVERRIDE;
 
+  // Makes Send() on this thread hold the messages back until the current task
+  // finishes, and then route them to the background thread together, where
+  // the channel writes them out at once.  Sync messages and replies to them
+  // are sent right away, after the messages held before them, so that nested
+  // message loops cannot deadlock.  Messages sent on other threads are never
+  // held; their order relative to this thread is not defined anyway.
+  void EnableSendBatching();
+
   // Used to intercept messages as they are received on the background thread.
   //
   // Ordinarily, messages sent to the ChannelProxy are routed to the matching
@@ -212,6 +221,7 @@ class IPC_EXPORT ChannelProxy : public Sender, public base::NonThreadSafe {
 
     // Methods called on the IO thread.
     void OnSendMessage(scoped_ptr<Message> message_ptr);
+    void OnSendMessages(ScopedVector<Message> messages);
     void OnAddFilter();
     void OnRemoveFilter(MessageFilter* filter);
 
@@ -245,6 +255,10 @@ class IPC_EXPORT ChannelProxy : public Sender, public base::NonThreadSafe {
 
  private:
   friend class SendCallbackHelper;
+  class SendBatcher;
+
+  // Routes the messages held back by |send_batcher_| to the IPC thread.
+  void FlushSendBatch();
 
   // By maintaining this indirection (ref-counted) to our internal state, we
   // can safely be destroyed while the background thread continues to do stuff
@@ -253,6 +267,9 @@ class IPC_EXPORT ChannelProxy : public Sender, public base::NonThreadSafe {
 
   // Whether the channel has been initialized.
   bool did_init_;
+
+  // Holds the messages sent during the current task, if batching is enabled.
+  scoped_ptr<SendBatcher> send_batcher_;
 };
 
 }  // namespace IPC
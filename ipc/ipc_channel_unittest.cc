@@ -9,17 +9,25 @@
 #endif
 
 #include <string>
+#include <vector>
 
+#include "base/bind.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/message_loop/message_loop.h"
 #include "base/pickle.h"
 #include "base/threading/thread.h"
 #include "ipc/ipc_message.h"
+#include "ipc/ipc_message_utils.h"
 #include "ipc/ipc_test_base.h"
 
 namespace {
 
 const size_t kLongMessageStringNumBytes = 50000;
 
+// Larger than a socket buffer, so that the message goes out in several writes.
+const size_t kExternalDataNumBytes = 1024 * 1024 + 3;
+const int kExternalDataTrailer = 0x1234;
+
 static void Send(IPC::Sender* sender, const char* text) {
   static int message_index = 0;
 
@@ -85,6 +93,68 @@ class GenericChannelListener : public IPC::Listener {
   int messages_left_;
 };
 
+// Sends a message whose large payload is referenced by the message rather
+// than copied into it, followed by some inline data.
+static void SendExternalData(IPC::Sender* sender) {
+  std::vector<unsigned char> bytes(kExternalDataNumBytes);
+  for (size_t i = 0; i < bytes.size(); ++i)
+    bytes[i] = static_cast<unsigned char>(i % 251);
+  scoped_refptr<base::RefCountedMemory> data(
+      base::RefCountedBytes::TakeVector(&bytes));
+
+  IPC::Message* message = new IPC::Message(0,
+                                           3,
+                                           IPC::Message::PRIORITY_NORMAL);
+  IPC::WriteParam(message, data);
+  message->WriteInt(kExternalDataTrailer);
+  EXPECT_TRUE(message->has_external_data());
+  sender->Send(message);
+}
+
+// Checks each message it gets against what SendExternalData() sends.  The
+// client echoes the message back; the server quits once it has the echo.
+class ExternalDataListener : public IPC::Listener {
+ public:
+  explicit ExternalDataListener(bool echo) : sender_(NULL), echo_(echo) {}
+  virtual ~ExternalDataListener() {}
+
+  virtual bool OnMessageReceived(const IPC::Message& message) OVERRIDE {
+    PickleIterator iter(message);
+
+    scoped_refptr<base::RefCountedMemory> data;
+    EXPECT_TRUE(IPC::ReadParam(&message, &iter, &data));
+    EXPECT_TRUE(data.get());
+    EXPECT_EQ(kExternalDataNumBytes, data.get() ? data->size() : 0);
+    for (size_t i = 0; data.get() && i < data->size(); ++i) {
+      if (data->front()[i] != static_cast<unsigned char>(i % 251)) {
+        ADD_FAILURE() << "mismatch at byte " << i;
+        break;
+      }
+    }
+    int trailer = 0;
+    EXPECT_TRUE(iter.ReadInt(&trailer));
+    EXPECT_EQ(kExternalDataTrailer, trailer);
+
+    if (echo_)
+      SendExternalData(sender_);
+    else
+      base::MessageLoop::current()->Quit();
+    return true;
+  }
+
+  virtual void OnChannelError() OVERRIDE {
+    base::MessageLoop::current()->Quit();
+  }
+
+  void Init(IPC::Sender* s) {
+    sender_ = s;
+  }
+
+ private:
+  IPC::Sender* sender_;
+  bool echo_;
+};
+
 class IPCChannelTest : public IPCTestBase {
 };
 
@@ -209,6 +279,36 @@ TEST_F(IPCChannelTest, ChannelProxyTest) {
   thread.Stop();
 }
 
+TEST_F(IPCChannelTest, ChannelProxyBatchingTest) {
+  Init("GenericClient");
+
+  base::Thread thread("ChannelProxyTestServer");
+  base::Thread::Options options;
+  options.message_loop_type = base::MessageLoop::TYPE_IO;
+  thread.StartWithOptions(options);
+
+  // Set up IPC channel proxy. Every message goes out when the task which
+  // sent it finishes.
+  GenericChannelListener listener;
+  CreateChannelProxy(&listener, thread.message_loop_proxy().get());
+  channel_proxy()->EnableSendBatching();
+  listener.Init(sender());
+
+  ASSERT_TRUE(StartClient());
+
+  base::MessageLoop::current()->PostTask(
+      FROM_HERE, base::Bind(&Send, sender(), "hello from parent"));
+
+  // Run message loop.
+  base::MessageLoop::current()->Run();
+
+  EXPECT_TRUE(WaitForClientShutdown());
+
+  // Destroy the channel proxy before shutting down the thread.
+  DestroyChannelProxy();
+  thread.Stop();
+}
+
 class ChannelListenerWithOnConnectedSend : public GenericChannelListener {
  public:
   ChannelListenerWithOnConnectedSend() {}
@@ -249,6 +349,45 @@ TEST_F(IPCChannelTest, MAYBE_SendMessageInChannelConnected) {
   DestroyChannel();
 }
 
+// Tests that a message with external data arrives as if it had been written
+// inline.
+TEST_F(IPCChannelTest, ExternalDataTest) {
+  Init("ExternalDataClient");
+
+  // Set up IPC channel and start client.
+  ExternalDataListener listener(false);
+  CreateChannel(&listener);
+  listener.Init(sender());
+  ASSERT_TRUE(ConnectChannel());
+  ASSERT_TRUE(StartClient());
+
+  SendExternalData(sender());
+
+  // Run message loop until the echo arrives.
+  base::MessageLoop::current()->Run();
+
+  // Close the channel so the client's OnChannelError() gets fired.
+  channel()->Close();
+
+  EXPECT_TRUE(WaitForClientShutdown());
+  DestroyChannel();
+}
+
+MULTIPROCESS_IPC_TEST_CLIENT_MAIN(ExternalDataClient) {
+  base::MessageLoopForIO main_message_loop;
+  ExternalDataListener listener(true);
+
+  // Set up IPC channel.
+  IPC::Channel channel(IPCTestBase::GetChannelName("ExternalDataClient"),
+                       IPC::Channel::MODE_CLIENT,
+                       &listener);
+  CHECK(channel.Connect());
+  listener.Init(&channel);
+
+  base::MessageLoop::current()->Run();
+  return 0;
+}
+
 MULTIPROCESS_IPC_TEST_CLIENT_MAIN(GenericClient) {
   base::MessageLoopForIO main_message_loop;
   GenericChannelListener listener;
@@ -386,6 +386,8 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages(
 
   // Write to pipe...
   Message* m = output_queue_.front();
+  // Overlapped writes take a single buffer.
+  m->Flatten();
   DCHECK(m->size() <= INT_MAX);
   BOOL ok = WriteFile(pipe_,
                       m->data(),
@@ -490,6 +492,16 @@ bool Channel::Send(Message* message) {
   return channel_impl_->Send(message);
 }
 
+bool Channel::SendBatch(ScopedVector<Message>* messages) {
+  // The pipe only has one overlapped write in flight, so the messages still
+  // go out one at a time.
+  bool result = true;
+  for (size_t i = 0; i < messages->size(); ++i)
+    result = channel_impl_->Send((*messages)[i]) && result;
+  messages->weak_clear();
+  return result;
+}
+
 // static
 bool Channel::IsNamedServerInitialized(const std::string& channel_id) {
   return ChannelImpl::IsNamedServerInitialized(channel_id);
@@ -154,6 +154,14 @@
 // less typical case where the enum must be in the range minvalue..maxvalue
 // inclusive.
 //
+// Externally-defined structs which are trivially copyable can be registered
+// with a single IPC_POD_STRUCT_TRAITS_VALIDATE() macro instead, which writes
+// and reads the whole struct with one memcpy(). The struct must neither have
+// padding, whose uninitialized bytes would leak to the other process, nor
+// members whose size differs between 32 and 64 bit processes. Pass an
+// expression in terms of the read struct |value| to check its enum and bool
+// members. IPC_POD_STRUCT_TRAITS() performs no checking.
+//
 // Do not place semicolons following these IPC_ macro invocations.  There
 // is no reason to expect that their expansion corresponds one-to-one with
 // C++ statements.
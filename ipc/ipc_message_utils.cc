@@ -6,6 +6,7 @@
 
 #include "base/files/file_path.h"
 #include "base/json/json_writer.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/strings/nullable_string16.h"
 #include "base/strings/string_number_conversions.h"
@@ -402,6 +403,35 @@ void ParamTraits<std::vector<unsigned char> >::Log(const param_type& p,
   LogBytes(p, l);
 }
 
+void ParamTraits<scoped_refptr<base::RefCountedMemory> >::Write(
+    Message* m, const param_type& p) {
+  if (!p.get() || !p->size()) {
+    m->WriteData(NULL, 0);
+  } else {
+    m->WriteExternalData(p);
+  }
+}
+
+bool ParamTraits<scoped_refptr<base::RefCountedMemory> >::Read(
+    const Message* m, PickleIterator* iter, param_type* r) {
+  const char *data;
+  int data_size = 0;
+  if (!m->ReadData(iter, &data, &data_size) || data_size < 0)
+    return false;
+  std::vector<unsigned char> bytes(data, data + data_size);
+  *r = base::RefCountedBytes::TakeVector(&bytes);
+  return true;
+}
+
+void ParamTraits<scoped_refptr<base::RefCountedMemory> >::Log(
+    const param_type& p, std::string* l) {
+  if (!p.get()) {
+    l->append("NULL");
+    return;
+  }
+  LogBytes(std::vector<unsigned char>(p->front(), p->front() + p->size()), l);
+}
+
 void ParamTraits<std::vector<bool> >::Write(Message* m, const param_type& p) {
   WriteParam(m, static_cast<int>(p.size()));
   // Cast to bool below is required because libc++'s
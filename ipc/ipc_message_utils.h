@@ -13,6 +13,7 @@
 
 #include "base/files/file.h"
 #include "base/format_macros.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/scoped_vector.h"
 #include "base/strings/string16.h"
 #include "base/strings/string_util.h"
@@ -50,6 +51,7 @@ class DictionaryValue;
 class FilePath;
 class ListValue;
 class NullableString16;
+class RefCountedMemory;
 class Time;
 class TimeDelta;
 class TimeTicks;
@@ -294,6 +296,18 @@ struct IPC_EXPORT ParamTraits<std::vector<unsigned char> > {
   static void Log(const param_type& p, std::string* l);
 };
 
+// The bytes are referenced by the message rather than copied into it, see
+// Pickle::WriteExternalData(), so large blobs go to the channel as they are.
+// They are read back into a RefCountedBytes.  A NULL pointer is written as an
+// empty blob.
+template <>
+struct IPC_EXPORT ParamTraits<scoped_refptr<base::RefCountedMemory> > {
+  typedef scoped_refptr<base::RefCountedMemory> param_type;
+  static void Write(Message* m, const param_type& p);
+  static bool Read(const Message* m, PickleIterator* iter, param_type* r);
+  static void Log(const param_type& p, std::string* l);
+};
+
 template <>
 struct IPC_EXPORT ParamTraits<std::vector<bool> > {
   typedef std::vector<bool> param_type;
@@ -4,10 +4,52 @@
 
 #include "ipc/ipc_message_utils.h"
 
+#include <string.h>
+
+#include <string>
+#include <vector>
+
 #include "base/files/file_path.h"
+#include "base/memory/ref_counted_memory.h"
 #include "ipc/ipc_message.h"
+#include "ipc/ipc_message_macros.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
+namespace {
+
+// A struct without padding, registered for memcpy() serialization.
+struct PodStruct {
+  int32 id;
+  uint8 flag;
+  uint8 kind;
+  uint16 count;
+  float value;
+};
+
+}  // namespace
+
+// Expands to the traits of PodStruct in each of the passes below, the way the
+// XXX_messages.h files are included over and over.
+#define POD_STRUCT_TRAITS() \
+  IPC_POD_STRUCT_TRAITS_VALIDATE(PodStruct, value.flag <= 1)
+
+POD_STRUCT_TRAITS()
+
+#include "ipc/param_traits_write_macros.h"
+namespace IPC {
+POD_STRUCT_TRAITS()
+}  // namespace IPC
+
+#include "ipc/param_traits_read_macros.h"
+namespace IPC {
+POD_STRUCT_TRAITS()
+}  // namespace IPC
+
+#include "ipc/param_traits_log_macros.h"
+namespace IPC {
+POD_STRUCT_TRAITS()
+}  // namespace IPC
+
 namespace IPC {
 namespace {
 
@@ -70,5 +112,76 @@ TEST(IPCMessageUtilsTest, ParameterValidation) {
   ASSERT_FALSE(ParamTraits<base::FilePath>::Read(&message, &iter, &bad_path));
 }
 
+TEST(IPCMessageUtilsTest, PodStruct) {
+  PodStruct input = { 12, 1, 3, 7, 2.5f };
+  IPC::Message message;
+  ParamTraits<PodStruct>::Write(&message, input);
+
+  PickleIterator iter(message);
+  PodStruct output;
+  memset(&output, 0, sizeof(output));
+  ASSERT_TRUE(ParamTraits<PodStruct>::Read(&message, &iter, &output));
+  EXPECT_EQ(0, memcmp(&input, &output, sizeof(input)));
+}
+
+TEST(IPCMessageUtilsTest, PodStructValidation) {
+  // The validation expression runs on the read struct.
+  PodStruct bad_flag = { 12, 2, 3, 7, 2.5f };
+  IPC::Message message;
+  message.WriteData(reinterpret_cast<const char*>(&bad_flag),
+                    sizeof(bad_flag));
+  // The size of the data has to match the struct.
+  message.WriteData("abc", 3);
+
+  PickleIterator iter(message);
+  PodStruct output;
+  EXPECT_FALSE(ParamTraits<PodStruct>::Read(&message, &iter, &output));
+  EXPECT_FALSE(ParamTraits<PodStruct>::Read(&message, &iter, &output));
+}
+
+TEST(IPCMessageUtilsTest, RefCountedMemory) {
+  std::string contents("some cached metadata");
+  scoped_refptr<base::RefCountedMemory> input(
+      base::RefCountedString::TakeString(&contents));
+  IPC::Message message;
+  ParamTraits<scoped_refptr<base::RefCountedMemory> >::Write(&message, input);
+  ParamTraits<int>::Write(&message, 42);
+  // The bytes are referenced, not copied.
+  EXPECT_TRUE(message.has_external_data());
+
+  // Rebuild the message the way the receiving channel sees it.
+  std::vector<Pickle::Segment> segments;
+  message.GetSegments(&segments);
+  std::string wire;
+  for (size_t i = 0; i < segments.size(); ++i)
+    wire.append(segments[i].data, segments[i].size);
+  ASSERT_EQ(message.size(), wire.size());
+  IPC::Message received(wire.data(), static_cast<int>(wire.size()));
+
+  PickleIterator iter(received);
+  scoped_refptr<base::RefCountedMemory> output;
+  ASSERT_TRUE(ParamTraits<scoped_refptr<base::RefCountedMemory> >::Read(
+      &received, &iter, &output));
+  ASSERT_TRUE(output.get());
+  EXPECT_TRUE(input->Equals(output));
+  int trailer = 0;
+  ASSERT_TRUE(ParamTraits<int>::Read(&received, &iter, &trailer));
+  EXPECT_EQ(42, trailer);
+}
+
+TEST(IPCMessageUtilsTest, NullRefCountedMemory) {
+  IPC::Message message;
+  ParamTraits<scoped_refptr<base::RefCountedMemory> >::Write(
+      &message, scoped_refptr<base::RefCountedMemory>());
+  EXPECT_FALSE(message.has_external_data());
+
+  PickleIterator iter(message);
+  scoped_refptr<base::RefCountedMemory> output;
+  ASSERT_TRUE(ParamTraits<scoped_refptr<base::RefCountedMemory> >::Read(
+      &message, &iter, &output));
+  ASSERT_TRUE(output.get());
+  EXPECT_EQ(0U, output->size());
+}
+
 }  // namespace
 }  // namespace IPC
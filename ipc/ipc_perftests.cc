@@ -8,6 +8,7 @@
 #include <string>
 
 #include "base/basictypes.h"
+#include "base/command_line.h"
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/pickle.h"
@@ -20,6 +21,7 @@
 #include "ipc/ipc_descriptors.h"
 #include "ipc/ipc_message_utils.h"
 #include "ipc/ipc_sender.h"
+#include "ipc/ipc_switches.h"
 #include "ipc/ipc_test_base.h"
 
 namespace {
@@ -29,6 +31,10 @@ namespace {
 // TODO(brettw): Make this test run by default.
 
 class IPCChannelPerfTest : public IPCTestBase {
+ protected:
+  // Times the ping-pong of messages of increasing size with a client, and
+  // names the results after |test_name_prefix|.
+  void RunPerformanceTest(const char* test_name_prefix);
 };
 
 // This class simply collects stats about abstract "events" (each of which has a
@@ -137,8 +143,10 @@ class ChannelReflectorListener : public IPC::Listener {
 
 class PerformanceChannelListener : public IPC::Listener {
  public:
-  PerformanceChannelListener()
-      : channel_(NULL),
+  // |test_name_prefix| names the transport in the results.
+  explicit PerformanceChannelListener(const char* test_name_prefix)
+      : test_name_prefix_(test_name_prefix),
+        channel_(NULL),
         msg_count_(0),
         msg_size_(0),
         count_down_(0),
@@ -183,7 +191,8 @@ class PerformanceChannelListener : public IPC::Listener {
       latency_tracker_.Reset();
       DCHECK(!perf_logger_.get());
       std::string test_name = base::StringPrintf(
-          "IPC_Perf_%dx_%u", msg_count_, static_cast<unsigned>(msg_size_));
+          "%s_%dx_%u", test_name_prefix_, msg_count_,
+          static_cast<unsigned>(msg_size_));
       perf_logger_.reset(new base::PerfTimeLogger(test_name.c_str()));
     } else {
       DCHECK_EQ(payload_.size(), reflected_payload.size());
@@ -210,6 +219,7 @@ class PerformanceChannelListener : public IPC::Listener {
   }
 
  private:
+  const char* test_name_prefix_;
   IPC::Channel* channel_;
   int msg_count_;
   size_t msg_size_;
@@ -220,11 +230,11 @@ class PerformanceChannelListener : public IPC::Listener {
   scoped_ptr<base::PerfTimeLogger> perf_logger_;
 };
 
-TEST_F(IPCChannelPerfTest, Performance) {
+void IPCChannelPerfTest::RunPerformanceTest(const char* test_name_prefix) {
   Init("PerformanceClient");
 
   // Set up IPC channel and start client.
-  PerformanceChannelListener listener;
+  PerformanceChannelListener listener(test_name_prefix);
   CreateChannel(&listener);
   listener.Init(channel());
   ASSERT_TRUE(ConnectChannel());
@@ -262,6 +272,39 @@ TEST_F(IPCChannelPerfTest, Performance) {
   DestroyChannel();
 }
 
+TEST_F(IPCChannelPerfTest, Performance) {
+  RunPerformanceTest("IPC_Perf");
+}
+
+#if defined(OS_POSIX) && !defined(OS_MACOSX)
+// Repeats the test with the messages in shared memory rings; the client
+// always accepts the rings the server offers.
+class IPCChannelRingPerfTest : public IPCChannelPerfTest {
+ protected:
+  IPCChannelRingPerfTest()
+      : saved_command_line_(*CommandLine::ForCurrentProcess()) {
+  }
+
+  virtual void SetUp() OVERRIDE {
+    IPCChannelPerfTest::SetUp();
+    CommandLine::ForCurrentProcess()->AppendSwitch(
+        switches::kIPCSharedMemoryRing);
+  }
+
+  virtual void TearDown() OVERRIDE {
+    *CommandLine::ForCurrentProcess() = saved_command_line_;
+    IPCChannelPerfTest::TearDown();
+  }
+
+ private:
+  const CommandLine saved_command_line_;
+};
+
+TEST_F(IPCChannelRingPerfTest, Performance) {
+  RunPerformanceTest("IPC_RingPerf");
+}
+#endif  // defined(OS_POSIX) && !defined(OS_MACOSX)
+
 // This message loop bounces all messages back to the sender.
 MULTIPROCESS_IPC_TEST_CLIENT_MAIN(PerformanceClient) {
   base::MessageLoopForIO main_message_loop;
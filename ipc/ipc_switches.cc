@@ -20,5 +20,13 @@ const char kProcessChannelID[]              = "channel";
 // kDebugOnStart flag passed on or not.
 const char kDebugChildren[]                 = "debug-children";
 
+// Makes child processes batch the messages they send to the browser within a
+// task, see IPC::ChannelProxy::EnableSendBatching().
+const char kIPCSendBatching[]               = "ipc-send-batching";
+
+// Makes POSIX IPC channel servers offer their clients to carry the messages
+// in shared memory rings instead of the socket.
+const char kIPCSharedMemoryRing[]           = "ipc-shared-memory-ring";
+
 }  // namespace switches
 
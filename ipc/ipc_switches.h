@@ -13,6 +13,8 @@ namespace switches {
 
 IPC_EXPORT extern const char kProcessChannelID[];
 IPC_EXPORT extern const char kDebugChildren[];
+IPC_EXPORT extern const char kIPCSendBatching[];
+IPC_EXPORT extern const char kIPCSharedMemoryRing[];
 
 }  // namespace switches
 
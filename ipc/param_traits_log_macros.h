@@ -48,5 +48,11 @@
     LogParam(static_cast<int>(p), l); \
   }
 
+#undef IPC_POD_STRUCT_TRAITS_VALIDATE
+#define IPC_POD_STRUCT_TRAITS_VALIDATE(struct_name, validation_expression) \
+  void ParamTraits<struct_name>::Log(const param_type& p, std::string* l) { \
+    l->append("<" #struct_name ">"); \
+  }
+
 #endif  // IPC_PARAM_TRAITS_LOG_MACROS_H_
 
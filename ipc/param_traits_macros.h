@@ -42,6 +42,25 @@
 #define IPC_ENUM_TRAITS_MIN_MAX_VALUE(type, minvalue, maxvalue)  \
   IPC_ENUM_TRAITS_VALIDATE(type, (value >= (minvalue) && value <= (maxvalue)))
 
+// Convenience macro for defining traits for trivially copyable structs which
+// are not validated by the IPC system. This macro should not need to be
+// subsequently redefined.
+#define IPC_POD_STRUCT_TRAITS(struct_name) \
+  IPC_POD_STRUCT_TRAITS_VALIDATE(struct_name, true)
+
+// Traits generation for trivially copyable structs. This macro may be
+// redefined later.
+#define IPC_POD_STRUCT_TRAITS_VALIDATE(struct_name, validation_expression) \
+  namespace IPC { \
+    template <> \
+    struct IPC_MESSAGE_EXPORT ParamTraits<struct_name> { \
+      typedef struct_name param_type; \
+      static void Write(Message* m, const param_type& p); \
+      static bool Read(const Message* m, PickleIterator* iter, param_type* p); \
+      static void Log(const param_type& p, std::string* l); \
+    }; \
+  }
+
 // Traits generation for enums. This macro may be redefined later.
 #define IPC_ENUM_TRAITS_VALIDATE(enum_name, validation_expression) \
   namespace IPC { \
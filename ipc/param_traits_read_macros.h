@@ -5,6 +5,8 @@
 #ifndef IPC_PARAM_TRAITS_READ_MACROS_H_
 #define IPC_PARAM_TRAITS_READ_MACROS_H_
 
+#include <string.h>
+
 // Null out all the macros that need nulling.
 #include "ipc/ipc_message_null_macros.h"
 
@@ -43,5 +45,22 @@
     return true; \
   }
 
+#undef IPC_POD_STRUCT_TRAITS_VALIDATE
+#define IPC_POD_STRUCT_TRAITS_VALIDATE(struct_name, validation_expression) \
+  bool ParamTraits<struct_name>:: \
+      Read(const Message* m, PickleIterator* iter, param_type* p) { \
+    const char* data; \
+    int data_size; \
+    if (!m->ReadData(iter, &data, &data_size) || \
+        data_size != static_cast<int>(sizeof(param_type))) \
+      return false; \
+    param_type value; \
+    memcpy(&value, data, sizeof(param_type)); \
+    if (!(validation_expression)) \
+      return false; \
+    *p = value; \
+    return true; \
+  }
+
 #endif  // IPC_PARAM_TRAITS_READ_MACROS_H_
 
@@ -5,6 +5,8 @@
 #ifndef IPC_PARAM_TRAITS_WRITE_MACROS_H_
 #define IPC_PARAM_TRAITS_WRITE_MACROS_H_
 
+#include "base/template_util.h"
+
 // Null out all the macros that need nulling.
 #include "ipc/ipc_message_null_macros.h"
 
@@ -35,5 +37,14 @@
     m->WriteInt(static_cast<int>(value)); \
   }
 
+#undef IPC_POD_STRUCT_TRAITS_VALIDATE
+#define IPC_POD_STRUCT_TRAITS_VALIDATE(struct_name, validation_expression) \
+  void ParamTraits<struct_name>::Write(Message* m, const param_type& value) { \
+    COMPILE_ASSERT(base::is_trivially_copyable<param_type>::value, \
+                   pod_struct_traits_need_a_trivially_copyable_type); \
+    DCHECK(validation_expression); \
+    m->WriteData(reinterpret_cast<const char*>(&value), sizeof(param_type)); \
+  }
+
 #endif  // IPC_PARAM_TRAITS_WRITE_MACROS_H_
 
@@ -0,0 +1,166 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ipc/shared_memory_ring_posix.h"
+
+#include <string.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+
+#include "base/atomicops.h"
+#include "base/logging.h"
+#include "base/process/process_handle.h"
+
+namespace IPC {
+namespace internal {
+
+// The control block at the start of the shared memory. Each position is only
+// advanced by its own side. Each flag is set by a side which is about to
+// block, and cleared by the side which wakes it up, or by the blocking side
+// itself if it does not block after all.
+struct SharedMemoryRing::Header {
+  base::subtle::Atomic32 write_position;
+  base::subtle::Atomic32 read_position;
+  base::subtle::Atomic32 consumer_waiting;
+  base::subtle::Atomic32 producer_waiting;
+};
+
+namespace {
+
+COMPILE_ASSERT((SharedMemoryRing::kCapacity &
+                (SharedMemoryRing::kCapacity - 1)) == 0,
+               ring_capacity_must_be_a_power_of_two);
+
+// The data starts at a cache line boundary, away from the control block.
+const size_t kDataOffset = 64;
+
+const size_t kMappedSize = kDataOffset + SharedMemoryRing::kCapacity;
+
+uint32 LoadPosition(const base::subtle::Atomic32* position) {
+  return static_cast<uint32>(base::subtle::Acquire_Load(position));
+}
+
+void StorePosition(base::subtle::Atomic32* position, uint32 value) {
+  base::subtle::Release_Store(position,
+                              static_cast<base::subtle::Atomic32>(value));
+}
+
+}  // namespace
+
+const size_t SharedMemoryRing::kCapacity;
+
+SharedMemoryRing::SharedMemoryRing(scoped_ptr<base::SharedMemory> memory)
+    : memory_(memory.Pass()),
+      header_(static_cast<Header*>(memory_->memory())),
+      data_(static_cast<char*>(memory_->memory()) + kDataOffset),
+      position_(0) {
+  COMPILE_ASSERT(sizeof(Header) <= kDataOffset, header_overlaps_data);
+}
+
+SharedMemoryRing::~SharedMemoryRing() {
+}
+
+// static
+scoped_ptr<SharedMemoryRing> SharedMemoryRing::Create() {
+  scoped_ptr<base::SharedMemory> memory(new base::SharedMemory);
+  if (!memory->CreateAndMapAnonymous(kMappedSize))
+    return scoped_ptr<SharedMemoryRing>();
+  return make_scoped_ptr(new SharedMemoryRing(memory.Pass()));
+}
+
+// static
+scoped_ptr<SharedMemoryRing> SharedMemoryRing::Map(int fd) {
+  scoped_ptr<base::SharedMemory> memory(
+      new base::SharedMemory(base::FileDescriptor(fd, true), false));
+  // Mapping beyond the end of the file would fault on access.
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(kMappedSize) ||
+      !memory->Map(kMappedSize)) {
+    return scoped_ptr<SharedMemoryRing>();
+  }
+  return make_scoped_ptr(new SharedMemoryRing(memory.Pass()));
+}
+
+int SharedMemoryRing::DuplicateFileDescriptor() const {
+  base::SharedMemoryHandle handle;
+  if (!memory_->ShareToProcess(base::GetCurrentProcessHandle(), &handle))
+    return -1;
+  return handle.fd;
+}
+
+int SharedMemoryRing::Write(const char* data, size_t length) {
+  uint32 used = position_ - LoadPosition(&header_->read_position);
+  if (used > kCapacity)
+    return -1;
+
+  size_t count = std::min(length, kCapacity - used);
+  size_t offset = position_ & (kCapacity - 1);
+  size_t first = std::min(count, kCapacity - offset);
+  memcpy(data_ + offset, data, first);
+  memcpy(data_, data + first, count - first);
+
+  position_ += static_cast<uint32>(count);
+  StorePosition(&header_->write_position, position_);
+  return static_cast<int>(count);
+}
+
+bool SharedMemoryRing::WaitForSpace() {
+  base::subtle::NoBarrier_Store(&header_->producer_waiting, 1);
+  // Pairs with the barrier in ProducerIsWaiting(), so that either the
+  // consumer sees the announcement or this side sees the freed space.
+  base::subtle::MemoryBarrier();
+  if (position_ - LoadPosition(&header_->read_position) < kCapacity) {
+    base::subtle::NoBarrier_Store(&header_->producer_waiting, 0);
+    return false;
+  }
+  return true;
+}
+
+bool SharedMemoryRing::ConsumerIsWaiting() {
+  base::subtle::MemoryBarrier();
+  return base::subtle::NoBarrier_AtomicExchange(&header_->consumer_waiting,
+                                                0) != 0;
+}
+
+int SharedMemoryRing::Read(char* buffer, size_t length) {
+  uint32 available = LoadPosition(&header_->write_position) - position_;
+  if (available > kCapacity)
+    return -1;
+
+  size_t count = std::min(length, static_cast<size_t>(available));
+  size_t offset = position_ & (kCapacity - 1);
+  size_t first = std::min(count, kCapacity - offset);
+  memcpy(buffer, data_ + offset, first);
+  memcpy(buffer + first, data_, count - first);
+
+  position_ += static_cast<uint32>(count);
+  StorePosition(&header_->read_position, position_);
+  return static_cast<int>(count);
+}
+
+bool SharedMemoryRing::HasData() const {
+  return LoadPosition(&header_->write_position) != position_;
+}
+
+bool SharedMemoryRing::WaitForData() {
+  base::subtle::NoBarrier_Store(&header_->consumer_waiting, 1);
+  // Pairs with the barrier in ConsumerIsWaiting(), so that either the
+  // producer sees the announcement or this side sees the data.
+  base::subtle::MemoryBarrier();
+  if (HasData()) {
+    base::subtle::NoBarrier_Store(&header_->consumer_waiting, 0);
+    return false;
+  }
+  return true;
+}
+
+bool SharedMemoryRing::ProducerIsWaiting() {
+  base::subtle::MemoryBarrier();
+  return base::subtle::NoBarrier_AtomicExchange(&header_->producer_waiting,
+                                                0) != 0;
+}
+
+}  // namespace internal
+}  // namespace IPC
@@ -0,0 +1,98 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef IPC_SHARED_MEMORY_RING_POSIX_H_
+#define IPC_SHARED_MEMORY_RING_POSIX_H_
+
+#include "base/basictypes.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/shared_memory.h"
+#include "ipc/ipc_export.h"
+
+namespace IPC {
+namespace internal {
+
+// SharedMemoryRing is a byte queue in shared memory with one producer and one
+// consumer, which usually live in different processes. Each side keeps its
+// own position privately and validates the position published by the peer on
+// every use, so a misbehaving peer can garble the bytes in transit but cannot
+// make this side access memory outside of the ring.
+//
+// The ring does not wake up the other side. A consumer which is about to
+// block on an empty ring announces it with WaitForData(), and a producer which
+// is about to block on a full ring with WaitForSpace(). The other side checks
+// for the announcement with ConsumerIsWaiting() after writing, or with
+// ProducerIsWaiting() after reading, and then wakes the waiting side up by
+// some other means.
+class IPC_EXPORT SharedMemoryRing {
+ public:
+  // The number of bytes the ring holds.
+  static const size_t kCapacity = 128 * 1024;
+
+  ~SharedMemoryRing();
+
+  // Creates a new ring for this process to produce into. Returns NULL on
+  // failure.
+  static scoped_ptr<SharedMemoryRing> Create();
+
+  // Maps the ring the peer created, for this process to consume from. Takes
+  // ownership of |fd|. Returns NULL if |fd| does not refer to a ring.
+  static scoped_ptr<SharedMemoryRing> Map(int fd);
+
+  // Returns a new descriptor of the ring, to be sent to the consumer, or -1 on
+  // failure.
+  int DuplicateFileDescriptor() const;
+
+  // Appends up to |length| bytes from |data| to the ring. Returns the number
+  // of bytes appended, which is less than |length| if the ring is full, or -1
+  // if the consumer corrupted the ring.
+  int Write(const char* data, size_t length);
+
+  // Announces that the producer blocks until the consumer frees some space.
+  // Returns false if space was freed in the meantime, in which case the
+  // producer should write again instead of blocking.
+  bool WaitForSpace();
+
+  // Returns true if the consumer announced that it blocks, and clears the
+  // announcement. Must be called after Write().
+  bool ConsumerIsWaiting();
+
+  // Removes up to |length| bytes from the ring and copies them to |buffer|.
+  // Returns the number of bytes copied, or -1 if the producer corrupted the
+  // ring.
+  int Read(char* buffer, size_t length);
+
+  // Returns true if there is data to Read().
+  bool HasData() const;
+
+  // Announces that the consumer blocks until the producer writes more data.
+  // Returns false if data was written in the meantime, in which case the
+  // consumer should read again instead of blocking.
+  bool WaitForData();
+
+  // Returns true if the producer announced that it blocks, and clears the
+  // announcement. Must be called after Read().
+  bool ProducerIsWaiting();
+
+ private:
+  struct Header;
+
+  explicit SharedMemoryRing(scoped_ptr<base::SharedMemory> memory);
+
+  scoped_ptr<base::SharedMemory> memory_;
+  Header* header_;
+  char* data_;
+
+  // The number of bytes this side wrote to the ring as the producer or read
+  // from it as the consumer, modulo 2^32. The copy in |header_| is only
+  // published for the peer.
+  uint32 position_;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedMemoryRing);
+};
+
+}  // namespace internal
+}  // namespace IPC
+
+#endif  // IPC_SHARED_MEMORY_RING_POSIX_H_
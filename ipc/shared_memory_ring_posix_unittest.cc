@@ -0,0 +1,120 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ipc/shared_memory_ring_posix.h"
+
+#include <string>
+
+#include "base/memory/shared_memory.h"
+#include "base/process/process_handle.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace IPC {
+namespace internal {
+namespace {
+
+const size_t kCapacity = SharedMemoryRing::kCapacity;
+
+// Maps another view of |ring|, as the process at the other end does.
+scoped_ptr<SharedMemoryRing> MapPeer(const SharedMemoryRing& ring) {
+  return SharedMemoryRing::Map(ring.DuplicateFileDescriptor());
+}
+
+TEST(SharedMemoryRingTest, WrapsAround) {
+  scoped_ptr<SharedMemoryRing> producer(SharedMemoryRing::Create());
+  ASSERT_TRUE(producer.get());
+  scoped_ptr<SharedMemoryRing> consumer(MapPeer(*producer));
+  ASSERT_TRUE(consumer.get());
+
+  std::string filler(kCapacity - 10, 'a');
+  EXPECT_EQ(static_cast<int>(filler.size()),
+            producer->Write(filler.data(), filler.size()));
+  std::string buffer(kCapacity, '\0');
+  EXPECT_EQ(static_cast<int>(filler.size()),
+            consumer->Read(&buffer[0], buffer.size()));
+  EXPECT_FALSE(consumer->HasData());
+
+  std::string data;
+  for (int i = 0; i < 100; ++i)
+    data.push_back(static_cast<char>(i));
+  EXPECT_EQ(100, producer->Write(data.data(), data.size()));
+  EXPECT_TRUE(consumer->HasData());
+  EXPECT_EQ(100, consumer->Read(&buffer[0], buffer.size()));
+  EXPECT_EQ(data, buffer.substr(0, 100));
+}
+
+TEST(SharedMemoryRingTest, FullRing) {
+  scoped_ptr<SharedMemoryRing> producer(SharedMemoryRing::Create());
+  ASSERT_TRUE(producer.get());
+  scoped_ptr<SharedMemoryRing> consumer(MapPeer(*producer));
+  ASSERT_TRUE(consumer.get());
+
+  std::string data(kCapacity + 1, 'a');
+  EXPECT_EQ(static_cast<int>(kCapacity),
+            producer->Write(data.data(), data.size()));
+  EXPECT_EQ(0, producer->Write(data.data(), data.size()));
+  EXPECT_TRUE(producer->WaitForSpace());
+
+  char buffer[1];
+  EXPECT_EQ(1, consumer->Read(buffer, sizeof(buffer)));
+  EXPECT_TRUE(consumer->ProducerIsWaiting());
+  EXPECT_FALSE(consumer->ProducerIsWaiting());
+
+  // Space freed before the producer blocks cancels the announcement.
+  EXPECT_EQ(1, producer->Write(data.data(), data.size()));
+  EXPECT_EQ(1, consumer->Read(buffer, sizeof(buffer)));
+  EXPECT_FALSE(producer->WaitForSpace());
+  EXPECT_FALSE(consumer->ProducerIsWaiting());
+}
+
+TEST(SharedMemoryRingTest, EmptyRing) {
+  scoped_ptr<SharedMemoryRing> producer(SharedMemoryRing::Create());
+  ASSERT_TRUE(producer.get());
+  scoped_ptr<SharedMemoryRing> consumer(MapPeer(*producer));
+  ASSERT_TRUE(consumer.get());
+
+  EXPECT_FALSE(consumer->HasData());
+  EXPECT_TRUE(consumer->WaitForData());
+  EXPECT_EQ(1, producer->Write("a", 1));
+  EXPECT_TRUE(producer->ConsumerIsWaiting());
+  EXPECT_FALSE(producer->ConsumerIsWaiting());
+
+  // Data written before the consumer blocks cancels the announcement.
+  EXPECT_FALSE(consumer->WaitForData());
+  EXPECT_FALSE(producer->ConsumerIsWaiting());
+}
+
+TEST(SharedMemoryRingTest, RejectsCorruptPositions) {
+  scoped_ptr<SharedMemoryRing> producer(SharedMemoryRing::Create());
+  ASSERT_TRUE(producer.get());
+  scoped_ptr<SharedMemoryRing> consumer(MapPeer(*producer));
+  ASSERT_TRUE(consumer.get());
+  // The control block starts with the write position, followed by the read
+  // position.
+  base::SharedMemory control(
+      base::FileDescriptor(producer->DuplicateFileDescriptor(), true), false);
+  ASSERT_TRUE(control.Map(2 * sizeof(int32)));
+  volatile int32* positions = static_cast<int32*>(control.memory());
+
+  char buffer[16];
+  EXPECT_EQ(10, producer->Write("0123456789", 10));
+  // More data than the ring holds.
+  positions[0] = static_cast<int32>(10 + kCapacity + 1);
+  EXPECT_EQ(-1, consumer->Read(buffer, sizeof(buffer)));
+  // More data read than written.
+  positions[1] = 11;
+  EXPECT_EQ(-1, producer->Write("a", 1));
+}
+
+TEST(SharedMemoryRingTest, RejectsSmallMemory) {
+  base::SharedMemory memory;
+  ASSERT_TRUE(memory.CreateAndMapAnonymous(64));
+  base::SharedMemoryHandle handle;
+  ASSERT_TRUE(memory.ShareToProcess(base::GetCurrentProcessHandle(), &handle));
+  EXPECT_FALSE(SharedMemoryRing::Map(handle.fd));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace IPC
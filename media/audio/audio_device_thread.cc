@@ -113,8 +113,13 @@ void AudioDeviceThread::Thread::Start() {
   // This reference will be released when the thread exists.
   AddRef();
 
-  PlatformThread::CreateWithPriority(0, this, &thread_,
-                                     base::kThreadPriority_RealtimeAudio);
+  // The thread wakes up once per buffer, which lets the realtime scheduler
+  // budget for it.
+  base::ThreadSchedulingParams params;
+  params.priority = base::kThreadPriority_RealtimeAudio;
+  if (callback_->audio_parameters().IsValid())
+    params.realtime_period = callback_->audio_parameters().GetBufferDuration();
+  PlatformThread::CreateWithSchedulingParams(0, this, &thread_, params);
   CHECK(!thread_.is_null());
 }
 
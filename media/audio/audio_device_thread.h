@@ -53,6 +53,10 @@ class MEDIA_EXPORT AudioDeviceThread {
     // Called whenever we receive notifications about pending data.
     virtual void Process(int pending_data) = 0;
 
+    const AudioParameters& audio_parameters() const {
+      return audio_parameters_;
+    }
+
    protected:
     // Protected so that derived classes can access directly.
     // The variables are 'const' since values are calculated/set in the
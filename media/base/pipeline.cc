@@ -10,6 +10,7 @@
 #include "base/callback.h"
 #include "base/callback_helpers.h"
 #include "base/compiler_specific.h"
+#include "base/debug/trace_event.h"
 #include "base/location.h"
 #include "base/metrics/histogram.h"
 #include "base/single_thread_task_runner.h"
@@ -32,6 +33,41 @@ using base::TimeDelta;
 
 namespace media {
 
+namespace {
+
+// Runs |done_cb| once Run() has been called |count| times, with the first
+// error reported or PIPELINE_OK if there was none.
+class PipelineStatusBarrier
+    : public base::RefCounted<PipelineStatusBarrier> {
+ public:
+  PipelineStatusBarrier(int count, const PipelineStatusCB& done_cb)
+      : count_(count),
+        status_(PIPELINE_OK),
+        done_cb_(done_cb) {
+    DCHECK_GT(count_, 0);
+  }
+
+  void Run(PipelineStatus status) {
+    DCHECK_GT(count_, 0);
+    if (status_ == PIPELINE_OK)
+      status_ = status;
+    if (--count_ == 0)
+      base::ResetAndReturn(&done_cb_).Run(status_);
+  }
+
+ private:
+  friend class base::RefCounted<PipelineStatusBarrier>;
+  ~PipelineStatusBarrier() {}
+
+  int count_;
+  PipelineStatus status_;
+  PipelineStatusCB done_cb_;
+
+  DISALLOW_COPY_AND_ASSIGN(PipelineStatusBarrier);
+};
+
+}  // namespace
+
 Pipeline::Pipeline(
     const scoped_refptr<base::SingleThreadTaskRunner>& task_runner,
     MediaLog* media_log)
@@ -53,7 +89,8 @@ Pipeline::Pipeline(
       text_ended_(false),
       audio_disabled_(false),
       demuxer_(NULL),
-      creation_time_(default_tick_clock_.NowTicks()) {
+      creation_time_(default_tick_clock_.NowTicks()),
+      state_start_time_(creation_time_) {
   media_log_->AddEvent(media_log_->CreatePipelineStateChangedEvent(kCreated));
   media_log_->AddEvent(
       media_log_->CreateEvent(MediaLogEvent::PIPELINE_CREATED));
@@ -214,19 +251,55 @@ void Pipeline::SetErrorForTesting(PipelineStatus status) {
 }
 
 void Pipeline::SetState(State next_state) {
+  base::TimeTicks now = default_tick_clock_.NowTicks();
+  if (!creation_time_.is_null())
+    RecordStartupStateTime(state_, now - state_start_time_);
+  state_start_time_ = now;
+
   if (state_ != kStarted && next_state == kStarted &&
       !creation_time_.is_null()) {
-    UMA_HISTOGRAM_TIMES("Media.TimeToPipelineStarted",
-                        default_tick_clock_.NowTicks() - creation_time_);
+    UMA_HISTOGRAM_TIMES("Media.TimeToPipelineStarted", now - creation_time_);
     creation_time_ = base::TimeTicks();
   }
 
   DVLOG(2) << GetStateString(state_) << " -> " << GetStateString(next_state);
+  if (state_ != kCreated)
+    TRACE_EVENT_ASYNC_END0("media", GetStateString(state_), this);
+  if (next_state != kStopped)
+    TRACE_EVENT_ASYNC_BEGIN0("media", GetStateString(next_state), this);
 
   state_ = next_state;
   media_log_->AddEvent(media_log_->CreatePipelineStateChangedEvent(next_state));
 }
 
+void Pipeline::RecordStartupStateTime(State state,
+                                      base::TimeDelta time_in_state) {
+  // Each histogram needs its own call site since the macros cache the
+  // histogram they log to.
+  switch (state) {
+    case kInitDemuxer:
+      UMA_HISTOGRAM_TIMES("Media.PipelineStartup.InitDemuxerTime",
+                          time_in_state);
+      break;
+    case kInitAudioRenderer:
+      UMA_HISTOGRAM_TIMES("Media.PipelineStartup.InitAudioRendererTime",
+                          time_in_state);
+      break;
+    case kInitVideoRenderer:
+      UMA_HISTOGRAM_TIMES("Media.PipelineStartup.InitVideoRendererTime",
+                          time_in_state);
+      break;
+    case kInitPrerolling:
+      UMA_HISTOGRAM_TIMES("Media.PipelineStartup.PrerollTime", time_in_state);
+      break;
+    case kStarting:
+      UMA_HISTOGRAM_TIMES("Media.PipelineStartup.StartingTime", time_in_state);
+      break;
+    default:
+      break;
+  }
+}
+
 #define RETURN_STRING(state) case state: return #state;
 
 const char* Pipeline::GetStateString(State state) {
@@ -525,22 +598,32 @@ void Pipeline::DoInitialPreroll(const PipelineStatusCB& done_cb) {
 
   base::TimeDelta seek_timestamp = demuxer_->GetStartTime();
 
-  // Preroll renderers.
-  if (audio_renderer_) {
-    bound_fns.Push(base::Bind(
-        &AudioRenderer::Preroll, base::Unretained(audio_renderer_.get()),
-        seek_timestamp));
-  }
-
-  if (video_renderer_) {
-    bound_fns.Push(base::Bind(
-        &VideoRenderer::Preroll, base::Unretained(video_renderer_.get()),
-        seek_timestamp));
-  }
+  // Preroll renderers. The renderers read from separate demuxer streams, so
+  // time to first frame is bounded by the slower of the two rather than by
+  // their sum.
+  bound_fns.Push(base::Bind(
+      &Pipeline::PrerollRenderersInParallel, base::Unretained(this),
+      seek_timestamp));
 
   pending_callbacks_ = SerialRunner::Run(bound_fns, done_cb);
 }
 
+void Pipeline::PrerollRenderersInParallel(base::TimeDelta seek_timestamp,
+                                          const PipelineStatusCB& done_cb) {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+  DCHECK(audio_renderer_ || video_renderer_);
+
+  scoped_refptr<PipelineStatusBarrier> barrier(new PipelineStatusBarrier(
+      (audio_renderer_ ? 1 : 0) + (video_renderer_ ? 1 : 0), done_cb));
+  PipelineStatusCB barrier_cb =
+      base::Bind(&PipelineStatusBarrier::Run, barrier);
+
+  if (audio_renderer_)
+    audio_renderer_->Preroll(seek_timestamp, barrier_cb);
+  if (video_renderer_)
+    video_renderer_->Preroll(seek_timestamp, barrier_cb);
+}
+
 void Pipeline::DoSeek(
     base::TimeDelta seek_timestamp,
     const PipelineStatusCB& done_cb) {
@@ -323,9 +323,18 @@ class MEDIA_EXPORT Pipeline : public DemuxerHost {
   void StateTransitionTask(PipelineStatus status);
 
   // Initiates an asynchronous preroll call sequence executing |done_cb|
-  // with the final status when completed.
+  // with the final status when completed. The audio and video renderers
+  // preroll in parallel.
   void DoInitialPreroll(const PipelineStatusCB& done_cb);
 
+  // Prerolls every renderer to |seek_timestamp| at the same time, executing
+  // |done_cb| once all of them have finished.
+  void PrerollRenderersInParallel(base::TimeDelta seek_timestamp,
+                                  const PipelineStatusCB& done_cb);
+
+  // Records how long the pipeline spent in |state| during startup.
+  void RecordStartupStateTime(State state, base::TimeDelta time_in_state);
+
   // Initiates an asynchronous pause-flush-seek-preroll call sequence
   // executing |done_cb| with the final status when completed.
   //
@@ -453,6 +462,9 @@ class MEDIA_EXPORT Pipeline : public DemuxerHost {
   // reaches "kStarted", at which point it is used & zeroed out.
   base::TimeTicks creation_time_;
 
+  // Time of the last state transition.
+  base::TimeTicks state_start_time_;
+
   scoped_ptr<SerialRunner> pending_callbacks_;
 
   base::ThreadChecker thread_checker_;
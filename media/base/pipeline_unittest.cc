@@ -466,6 +466,60 @@ TEST_F(PipelineTest, AudioVideoStream) {
   EXPECT_TRUE(pipeline_->HasVideo());
 }
 
+TEST_F(PipelineTest, AudioAndVideoPrerollInParallel) {
+  CreateAudioStream();
+  CreateVideoStream();
+  MockDemuxerStreamVector streams;
+  streams.push_back(audio_stream());
+  streams.push_back(video_stream());
+
+  InitializeDemuxer(&streams);
+  InitializeAudioRenderer(audio_stream(), false);
+  EXPECT_CALL(*video_renderer_, Initialize(video_stream(), _, _, _, _, _, _, _))
+      .WillOnce(RunCallback<1>(PIPELINE_OK));
+  EXPECT_CALL(callbacks_, OnBufferingState(Pipeline::kHaveMetadata));
+
+  // Hold on to both preroll callbacks.
+  PipelineStatusCB audio_preroll_cb;
+  PipelineStatusCB video_preroll_cb;
+  EXPECT_CALL(*audio_renderer_, Preroll(base::TimeDelta(), _))
+      .WillOnce(SaveArg<1>(&audio_preroll_cb));
+  EXPECT_CALL(*video_renderer_, Preroll(base::TimeDelta(), _))
+      .WillOnce(SaveArg<1>(&video_preroll_cb));
+
+  pipeline_->Start(
+      filter_collection_.Pass(),
+      base::Bind(&CallbackHelper::OnEnded, base::Unretained(&callbacks_)),
+      base::Bind(&CallbackHelper::OnError, base::Unretained(&callbacks_)),
+      base::Bind(&CallbackHelper::OnStart, base::Unretained(&callbacks_)),
+      base::Bind(&CallbackHelper::OnBufferingState,
+                 base::Unretained(&callbacks_)),
+      base::Bind(&CallbackHelper::OnDurationChange,
+                 base::Unretained(&callbacks_)));
+  message_loop_.RunUntilIdle();
+
+  // The video renderer started prerolling without waiting for the audio
+  // renderer to finish.
+  ASSERT_FALSE(audio_preroll_cb.is_null());
+  ASSERT_FALSE(video_preroll_cb.is_null());
+
+  // The pipeline doesn't start until both have finished.
+  audio_preroll_cb.Run(PIPELINE_OK);
+  message_loop_.RunUntilIdle();
+
+  EXPECT_CALL(*audio_renderer_, SetPlaybackRate(0.0f));
+  EXPECT_CALL(*video_renderer_, SetPlaybackRate(0.0f));
+  EXPECT_CALL(*audio_renderer_, SetVolume(1.0f));
+  EXPECT_CALL(*audio_renderer_, Play(_))
+      .WillOnce(RunClosure<0>());
+  EXPECT_CALL(*video_renderer_, Play(_))
+      .WillOnce(RunClosure<0>());
+  EXPECT_CALL(callbacks_, OnBufferingState(Pipeline::kPrerollCompleted));
+  EXPECT_CALL(callbacks_, OnStart(PIPELINE_OK));
+  video_preroll_cb.Run(PIPELINE_OK);
+  message_loop_.RunUntilIdle();
+}
+
 TEST_F(PipelineTest, VideoTextStream) {
   CreateVideoStream();
   CreateTextStream();
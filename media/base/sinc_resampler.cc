@@ -110,13 +110,9 @@ static double SincScaleFactor(double io_ratio) {
 // Force NaCl code to use C routines since (at present) nothing there uses these
 // methods and plumbing the -msse built library is non-trivial.
 #if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
-#if defined(__SSE__)
-#define CONVOLVE_FUNC Convolve_SSE
-void SincResampler::InitializeCPUSpecificFeatures() {}
-#else
 // X86 CPU detection required.  Functions will be set by
-// InitializeCPUSpecificFeatures().
-// TODO(dalecurtis): Once Chrome moves to an SSE baseline this can be removed.
+// InitializeCPUSpecificFeatures().  Even with an SSE baseline, AVX support is
+// only known at runtime.
 #define CONVOLVE_FUNC g_convolve_proc_
 
 typedef float (*ConvolveProc)(const float*, const float*, const float*, double);
@@ -124,9 +120,14 @@ static ConvolveProc g_convolve_proc_ = NULL;
 
 void SincResampler::InitializeCPUSpecificFeatures() {
   CHECK(!g_convolve_proc_);
-  g_convolve_proc_ = base::CPU().has_sse() ? Convolve_SSE : Convolve_C;
+  base::CPU cpu;
+  if (cpu.has_avx())
+    g_convolve_proc_ = Convolve_AVX;
+  else if (cpu.has_sse())
+    g_convolve_proc_ = Convolve_SSE;
+  else
+    g_convolve_proc_ = Convolve_C;
 }
-#endif
 #elif defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
 #define CONVOLVE_FUNC Convolve_NEON
 void SincResampler::InitializeCPUSpecificFeatures() {}
@@ -143,13 +144,14 @@ SincResampler::SincResampler(double io_sample_rate_ratio,
       read_cb_(read_cb),
       request_frames_(request_frames),
       input_buffer_size_(request_frames_ + kKernelSize),
-      // Create input buffers with a 16-byte alignment for SSE optimizations.
+      // Create kernel buffers with a 32-byte alignment for AVX optimizations
+      // and input buffers with a 16-byte alignment for SSE optimizations.
       kernel_storage_(static_cast<float*>(
-          base::AlignedAlloc(sizeof(float) * kKernelStorageSize, 16))),
+          base::AlignedAlloc(sizeof(float) * kKernelStorageSize, 32))),
       kernel_pre_sinc_storage_(static_cast<float*>(
-          base::AlignedAlloc(sizeof(float) * kKernelStorageSize, 16))),
+          base::AlignedAlloc(sizeof(float) * kKernelStorageSize, 32))),
       kernel_window_storage_(static_cast<float*>(
-          base::AlignedAlloc(sizeof(float) * kKernelStorageSize, 16))),
+          base::AlignedAlloc(sizeof(float) * kKernelStorageSize, 32))),
       input_buffer_(static_cast<float*>(
           base::AlignedAlloc(sizeof(float) * input_buffer_size_, 16))),
       r1_(input_buffer_.get()),
@@ -82,14 +82,19 @@ class MEDIA_EXPORT SincResampler {
 
   // Compute convolution of |k1| and |k2| over |input_ptr|, resultant sums are
   // linearly interpolated using |kernel_interpolation_factor|.  On x86, the
-  // underlying implementation is chosen at run time based on SSE support.  On
-  // ARM, NEON support is chosen at compile time based on compilation flags.
+  // underlying implementation is chosen at run time based on SSE and AVX
+  // support.  On ARM, NEON support is chosen at compile time based on
+  // compilation flags.
   static float Convolve_C(const float* input_ptr, const float* k1,
                           const float* k2, double kernel_interpolation_factor);
 #if defined(ARCH_CPU_X86_FAMILY)
   static float Convolve_SSE(const float* input_ptr, const float* k1,
                             const float* k2,
                             double kernel_interpolation_factor);
+  // |k1| and |k2| must be 32-byte aligned.
+  static float Convolve_AVX(const float* input_ptr, const float* k1,
+                            const float* k2,
+                            double kernel_interpolation_factor);
 #elif defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
   static float Convolve_NEON(const float* input_ptr, const float* k1,
                              const float* k2,
@@ -0,0 +1,85 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <vector>
+
+#include "base/time/time.h"
+#include "media/base/stream_parser_buffer.h"
+#include "media/base/test_helpers.h"
+#include "media/filters/source_buffer_stream.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace media {
+
+static const int kFramesPerSecond = 30;
+static const int kFramesPerKeyframe = 15;
+static const int kFramesPerAppend = 30;
+static const int kFrameSize = 4096;
+static const int kBenchmarkAppends = 2000;
+
+// Appends |kBenchmarkAppends| one second media segments of video to a
+// SourceBufferStream with the given memory limit (or the default one if
+// |memory_limit| is 0) and reports the append throughput. With a small limit
+// most appends also garbage collect GOPs from the front of the stream.
+static void RunAppendBenchmark(int memory_limit,
+                               const std::string& trace_name) {
+  SourceBufferStream stream(TestVideoConfig::Normal(), LogCB());
+  if (memory_limit > 0)
+    stream.set_memory_limit_for_testing(memory_limit);
+
+  const base::TimeDelta frame_duration =
+      base::TimeDelta::FromMicroseconds(
+          base::Time::kMicrosecondsPerSecond / kFramesPerSecond);
+  const uint8 data[kFrameSize] = { 0 };
+
+  // Build the buffers up front so that only the stream itself is measured.
+  std::vector<SourceBufferStream::BufferQueue> appends(kBenchmarkAppends);
+  for (int i = 0; i < kBenchmarkAppends; ++i) {
+    for (int j = 0; j < kFramesPerAppend; ++j) {
+      int position = i * kFramesPerAppend + j;
+      scoped_refptr<StreamParserBuffer> buffer = StreamParserBuffer::CopyFrom(
+          data, kFrameSize, position % kFramesPerKeyframe == 0,
+          DemuxerStream::VIDEO, 0);
+      buffer->set_timestamp(frame_duration * position);
+      buffer->SetDecodeTimestamp(frame_duration * position);
+      buffer->set_duration(frame_duration);
+      appends[i].push_back(buffer);
+    }
+  }
+
+  base::TimeTicks start = base::TimeTicks::HighResNow();
+  for (int i = 0; i < kBenchmarkAppends; ++i) {
+    stream.OnNewMediaSegment(appends[i].front()->GetDecodeTimestamp());
+    ASSERT_TRUE(stream.Append(appends[i]));
+  }
+  double total_time_milliseconds =
+      (base::TimeTicks::HighResNow() - start).InMillisecondsF();
+
+  perf_test::PrintResult("source_buffer_stream_append",
+                         "",
+                         trace_name,
+                         kBenchmarkAppends * kFramesPerAppend /
+                             total_time_milliseconds,
+                         "buffers/ms",
+                         true);
+  perf_test::PrintResult("source_buffer_stream_ranges",
+                         "",
+                         trace_name,
+                         stream.GetBufferedTime().size(),
+                         "ranges",
+                         false);
+}
+
+// Benchmark for appending to a SourceBufferStream.  Make sure to build with
+// branding=Chrome so that DCHECKs are compiled out when benchmarking.
+TEST(SourceBufferStreamPerfTest, Append) {
+  // Large enough that nothing is garbage collected.
+  RunAppendBenchmark(
+      kBenchmarkAppends * kFramesPerAppend * kFrameSize, "no_eviction");
+  // Ten seconds of media, so that every append evicts GOPs.
+  RunAppendBenchmark(10 * kFramesPerSecond * kFrameSize, "eviction");
+}
+
+}  // namespace media
@@ -15,9 +15,9 @@ namespace vector_math {
 // Required alignment for inputs and outputs to all vector math functions
 enum { kRequiredAlignment = 16 };
 
-// Selects runtime specific optimizations such as SSE.  Must be called prior to
-// calling FMAC() or FMUL().  Called during media library initialization; most
-// users should never have to call this.
+// Selects runtime specific optimizations such as SSE or AVX.  Must be called
+// prior to calling FMAC(), FMUL() or EWMAAndMaxPower().  Called during media
+// library initialization; most users should never have to call this.
 MEDIA_EXPORT void Initialize();
 
 // Multiply each element of |src| (up to |len|) by |scale| and add to |dest|.
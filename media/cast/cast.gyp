@@ -66,6 +66,8 @@
       'sources': [
         'logging/encoding_event_subscriber.cc',
         'logging/encoding_event_subscriber.h',
+        'logging/latency_event_subscriber.cc',
+        'logging/latency_event_subscriber.h',
         'logging/log_serializer.cc',
         'logging/log_serializer.h',
       ], # source
@@ -106,6 +108,7 @@
             'framer/frame_buffer_unittest.cc',
             'framer/framer_unittest.cc',
             'logging/encoding_event_subscriber_unittest.cc',
+            'logging/latency_event_subscriber_unittest.cc',
             'logging/logging_impl_unittest.cc',
             'logging/logging_raw_unittest.cc',
             'logging/simple_event_subscriber_unittest.cc',
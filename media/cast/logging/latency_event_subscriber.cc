@@ -0,0 +1,89 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "media/cast/logging/latency_event_subscriber.h"
+
+#include "base/logging.h"
+
+namespace media {
+namespace cast {
+
+FrameLatency::FrameLatency() : rtp_timestamp(0), frame_id(kFrameIdUnknown) {}
+FrameLatency::~FrameLatency() {}
+
+LatencyEventSubscriber::LatencyEventSubscriber(size_t max_pending_frames)
+    : max_pending_frames_(max_pending_frames) {
+  DCHECK_GT(max_pending_frames_, 0u);
+}
+
+LatencyEventSubscriber::~LatencyEventSubscriber() {
+  DCHECK(thread_checker_.CalledOnValidThread());
+}
+
+void LatencyEventSubscriber::OnReceiveFrameEvent(
+    const FrameEvent& frame_event) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  switch (frame_event.type) {
+    case kVideoFrameReceived: {
+      PendingFrame& frame = pending_frames_[frame_event.rtp_timestamp];
+      frame.received_time = frame_event.timestamp;
+      frame.sent_to_encoder_time = base::TimeTicks();
+      // Drop the oldest frames, which the encoder must have skipped.
+      while (pending_frames_.size() > max_pending_frames_)
+        pending_frames_.erase(pending_frames_.begin());
+      break;
+    }
+    case kVideoFrameSentToEncoder: {
+      PendingFrameMap::iterator it =
+          pending_frames_.find(frame_event.rtp_timestamp);
+      if (it != pending_frames_.end())
+        it->second.sent_to_encoder_time = frame_event.timestamp;
+      break;
+    }
+    case kVideoFrameEncoded: {
+      // kVideoFrameEncoded may be logged more than once for a frame; only the
+      // first one is measured since the frame is no longer pending after it.
+      PendingFrameMap::iterator it =
+          pending_frames_.find(frame_event.rtp_timestamp);
+      if (it == pending_frames_.end())
+        break;
+      FrameLatency latency;
+      latency.rtp_timestamp = frame_event.rtp_timestamp;
+      latency.frame_id = frame_event.frame_id;
+      if (!it->second.sent_to_encoder_time.is_null()) {
+        latency.queueing_delay =
+            it->second.sent_to_encoder_time - it->second.received_time;
+      }
+      latency.total_delay = frame_event.timestamp - it->second.received_time;
+      frame_latencies_.push_back(latency);
+      pending_frames_.erase(it);
+      break;
+    }
+    default:
+      // Not interested in other events.
+      break;
+  }
+}
+
+void LatencyEventSubscriber::OnReceivePacketEvent(
+    const PacketEvent& packet_event) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  // Do nothing as packet events are logged per packet, not per frame.
+}
+
+void LatencyEventSubscriber::OnReceiveGenericEvent(
+    const GenericEvent& generic_event) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  // Do nothing as we are not interested in generic events.
+}
+
+void LatencyEventSubscriber::GetFrameLatenciesAndReset(
+    std::vector<FrameLatency>* frame_latencies) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  frame_latencies->swap(frame_latencies_);
+  frame_latencies_.clear();
+}
+
+}  // namespace cast
+}  // namespace media
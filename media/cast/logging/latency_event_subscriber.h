@@ -0,0 +1,78 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MEDIA_CAST_LOGGING_LATENCY_EVENT_SUBSCRIBER_H_
+#define MEDIA_CAST_LOGGING_LATENCY_EVENT_SUBSCRIBER_H_
+
+#include <map>
+#include <vector>
+
+#include "base/compiler_specific.h"
+#include "base/threading/thread_checker.h"
+#include "base/time/time.h"
+#include "media/cast/logging/raw_event_subscriber.h"
+
+namespace media {
+namespace cast {
+
+// The time a video frame spent in the cast sender, measured from the
+// kVideoFrameReceived event to the first kVideoFrameEncoded event with the
+// same RTP timestamp, at which point the frame is handed to the transport.
+struct FrameLatency {
+  FrameLatency();
+  ~FrameLatency();
+
+  RtpTimestamp rtp_timestamp;
+  uint32 frame_id;
+
+  // Time from kVideoFrameReceived to kVideoFrameSentToEncoder. Zero if the
+  // encoder did not log kVideoFrameSentToEncoder.
+  base::TimeDelta queueing_delay;
+  // Time from kVideoFrameReceived to kVideoFrameEncoded.
+  base::TimeDelta total_delay;
+};
+
+// RawEventSubscriber implementation that matches up the video sender's frame
+// events by RTP timestamp and records the latency of each encoded frame.
+// Frames which never get encoded are forgotten once more than
+// |max_pending_frames| frames are waiting to be encoded.
+// The user of this class can call GetFrameLatenciesAndReset() to get the
+// latencies of the frames encoded since the last invocation.
+class LatencyEventSubscriber : public RawEventSubscriber {
+ public:
+  explicit LatencyEventSubscriber(size_t max_pending_frames);
+
+  virtual ~LatencyEventSubscriber();
+
+  // RawEventSubscriber implementations.
+  virtual void OnReceiveFrameEvent(const FrameEvent& frame_event) OVERRIDE;
+  virtual void OnReceivePacketEvent(const PacketEvent& packet_event) OVERRIDE;
+  virtual void OnReceiveGenericEvent(const GenericEvent& generic_event)
+      OVERRIDE;
+
+  // Assigns the latencies of the frames encoded so far, in the order they were
+  // encoded, to |frame_latencies| and clears them from this object.
+  void GetFrameLatenciesAndReset(std::vector<FrameLatency>* frame_latencies);
+
+ private:
+  struct PendingFrame {
+    base::TimeTicks received_time;
+    base::TimeTicks sent_to_encoder_time;
+  };
+  typedef std::map<RtpTimestamp, PendingFrame> PendingFrameMap;
+
+  const size_t max_pending_frames_;
+  PendingFrameMap pending_frames_;
+  std::vector<FrameLatency> frame_latencies_;
+
+  // All functions must be called on the main thread.
+  base::ThreadChecker thread_checker_;
+
+  DISALLOW_COPY_AND_ASSIGN(LatencyEventSubscriber);
+};
+
+}  // namespace cast
+}  // namespace media
+
+#endif  // MEDIA_CAST_LOGGING_LATENCY_EVENT_SUBSCRIBER_H_
@@ -0,0 +1,102 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/test/simple_test_tick_clock.h"
+#include "base/time/tick_clock.h"
+#include "media/cast/cast_environment.h"
+#include "media/cast/logging/latency_event_subscriber.h"
+#include "media/cast/logging/logging_defines.h"
+#include "media/cast/test/fake_single_thread_task_runner.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace media {
+namespace cast {
+
+namespace {
+
+const size_t kMaxPendingFrames = 10u;
+
+}  // namespace
+
+class LatencyEventSubscriberTest : public ::testing::Test {
+ protected:
+  LatencyEventSubscriberTest()
+      : testing_clock_(new base::SimpleTestTickClock()),
+        task_runner_(new test::FakeSingleThreadTaskRunner(testing_clock_)),
+        cast_environment_(new CastEnvironment(
+            scoped_ptr<base::TickClock>(testing_clock_).Pass(), task_runner_,
+            task_runner_, task_runner_, task_runner_, task_runner_,
+            task_runner_, GetLoggingConfigWithRawEventsAndStatsEnabled())),
+        event_subscriber_(kMaxPendingFrames) {
+    cast_environment_->Logging()->AddRawEventSubscriber(&event_subscriber_);
+  }
+
+  virtual ~LatencyEventSubscriberTest() {
+    cast_environment_->Logging()->RemoveRawEventSubscriber(&event_subscriber_);
+  }
+
+  void InsertFrameEvent(CastLoggingEvent event, RtpTimestamp rtp_timestamp,
+                        uint32 frame_id) {
+    cast_environment_->Logging()->InsertFrameEvent(
+        testing_clock_->NowTicks(), event, rtp_timestamp, frame_id);
+  }
+
+  base::SimpleTestTickClock* testing_clock_;  // Owned by CastEnvironment.
+  scoped_refptr<test::FakeSingleThreadTaskRunner> task_runner_;
+  scoped_refptr<CastEnvironment> cast_environment_;
+  LatencyEventSubscriber event_subscriber_;
+};
+
+TEST_F(LatencyEventSubscriberTest, ReportsLatencyOfEncodedFrames) {
+  InsertFrameEvent(kVideoFrameReceived, 100u, kFrameIdUnknown);
+  testing_clock_->Advance(base::TimeDelta::FromMilliseconds(5));
+  InsertFrameEvent(kVideoFrameSentToEncoder, 100u, kFrameIdUnknown);
+  InsertFrameEvent(kVideoFrameReceived, 200u, kFrameIdUnknown);
+  testing_clock_->Advance(base::TimeDelta::FromMilliseconds(20));
+  InsertFrameEvent(kVideoFrameEncoded, 100u, 0u);
+  // A second kVideoFrameEncoded for the same frame is not measured again.
+  InsertFrameEvent(kVideoFrameEncoded, 100u, 0u);
+  testing_clock_->Advance(base::TimeDelta::FromMilliseconds(10));
+  InsertFrameEvent(kVideoFrameEncoded, 200u, 1u);
+
+  std::vector<FrameLatency> frame_latencies;
+  event_subscriber_.GetFrameLatenciesAndReset(&frame_latencies);
+  ASSERT_EQ(2u, frame_latencies.size());
+  EXPECT_EQ(100u, frame_latencies[0].rtp_timestamp);
+  EXPECT_EQ(0u, frame_latencies[0].frame_id);
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(5),
+            frame_latencies[0].queueing_delay);
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(25),
+            frame_latencies[0].total_delay);
+  EXPECT_EQ(200u, frame_latencies[1].rtp_timestamp);
+  EXPECT_EQ(1u, frame_latencies[1].frame_id);
+  EXPECT_EQ(base::TimeDelta(), frame_latencies[1].queueing_delay);
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(30),
+            frame_latencies[1].total_delay);
+
+  // Calling this function again should result in an empty vector because no
+  // frames were encoded since the last call.
+  event_subscriber_.GetFrameLatenciesAndReset(&frame_latencies);
+  EXPECT_TRUE(frame_latencies.empty());
+}
+
+TEST_F(LatencyEventSubscriberTest, ForgetsOldestSkippedFrames) {
+  // None of these frames get encoded.
+  for (uint32 i = 0; i <= kMaxPendingFrames; ++i)
+    InsertFrameEvent(kVideoFrameReceived, i * 10, kFrameIdUnknown);
+
+  InsertFrameEvent(kVideoFrameEncoded, 0u, 0u);
+  InsertFrameEvent(kVideoFrameEncoded, 10u, 1u);
+
+  // The first frame was dropped to keep the number of pending frames bounded.
+  std::vector<FrameLatency> frame_latencies;
+  event_subscriber_.GetFrameLatenciesAndReset(&frame_latencies);
+  ASSERT_EQ(1u, frame_latencies.size());
+  EXPECT_EQ(10u, frame_latencies[0].rtp_timestamp);
+}
+
+}  // namespace cast
+}  // namespace media
@@ -13,6 +13,7 @@
 #include "base/location.h"
 #include "base/single_thread_task_runner.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/sys_info.h"
 #include "media/base/bind_to_current_loop.h"
 #include "media/base/decoder_buffer.h"
 #include "media/base/limits.h"
@@ -38,16 +39,31 @@ namespace media {
 static const int kDecodeThreads = 2;
 static const int kMaxDecodeThreads = 16;
 
-// Returns the number of threads given the FFmpeg CodecID. Also inspects the
+// Returns the number of threads given the decoder config. Also inspects the
 // command line for a valid --video-threads flag.
-static int GetThreadCount(AVCodecID codec_id) {
+static int GetThreadCount(const VideoDecoderConfig& config) {
   // Refer to http://crbug.com/93932 for tsan suppressions on decoding.
   int decode_threads = kDecodeThreads;
 
   const CommandLine* cmd_line = CommandLine::ForCurrentProcess();
   std::string threads(cmd_line->GetSwitchValueASCII(switches::kVideoThreads));
-  if (threads.empty() || !base::StringToInt(threads, &decode_threads))
+  if (threads.empty() || !base::StringToInt(threads, &decode_threads)) {
+    if (config.codec() == kCodecH264) {
+      // FFmpeg decodes H.264 with frame threading, where each thread works on
+      // its own frame.  Two threads keep up with 1080p on most machines, so
+      // scale with the number of pixels beyond that, e.g. 4K gets eight.
+      // Leave one core for the rest of the pipeline.
+      decode_threads = std::max(
+          decode_threads,
+          config.coded_size().GetArea() * kDecodeThreads / (1920 * 1080));
+      decode_threads = std::min(
+          decode_threads,
+          std::max(kDecodeThreads, base::SysInfo::NumberOfProcessors() - 1));
+      decode_threads = std::min(decode_threads, kMaxDecodeThreads);
+    }
+
     return decode_threads;
+  }
 
   decode_threads = std::max(decode_threads, 0);
   decode_threads = std::min(decode_threads, kMaxDecodeThreads);
@@ -368,7 +384,7 @@ bool FFmpegVideoDecoder::ConfigureDecoder() {
   // Enable motion vector search (potentially slow), strong deblocking filter
   // for damaged macroblocks, and set our error detection sensitivity.
   codec_context_->error_concealment = FF_EC_GUESS_MVS | FF_EC_DEBLOCK;
-  codec_context_->thread_count = GetThreadCount(codec_context_->codec_id);
+  codec_context_->thread_count = GetThreadCount(config_);
   codec_context_->opaque = this;
   codec_context_->flags |= CODEC_FLAG_EMU_EDGE;
   codec_context_->get_buffer = GetVideoBufferImpl;
@@ -4,7 +4,14 @@
 
 #include "media/filters/skcanvas_video_renderer.h"
 
+#include <algorithm>
+
+#include "base/atomic_ref_count.h"
+#include "base/bind.h"
+#include "base/location.h"
 #include "base/logging.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/worker_pool.h"
 #include "media/base/video_frame.h"
 #include "media/base/yuv_convert.h"
 #include "third_party/skia/include/core/SkCanvas.h"
@@ -183,47 +190,37 @@ static void FastPaint(
   bitmap.unlockPixels();
 }
 
-// Converts a VideoFrame containing YUV data to a SkBitmap containing RGB data.
-//
-// |bitmap| will be (re)allocated to match the dimensions of |video_frame|.
-static void ConvertVideoFrameToBitmap(
-    const scoped_refptr<media::VideoFrame>& video_frame,
-    SkBitmap* bitmap) {
-  DCHECK(IsEitherYV12OrYV12AOrYV16OrNative(video_frame->format()))
-      << video_frame->format();
-  if (IsEitherYV12OrYV12AOrYV16(video_frame->format())) {
-    DCHECK_EQ(video_frame->stride(media::VideoFrame::kUPlane),
-              video_frame->stride(media::VideoFrame::kVPlane));
-  }
+// Frames with at least this many visible pixels are converted to RGB in
+// stripes, all but the first of which are converted on the worker pool.
+static const int kMinAreaForParallelConversion = 1280 * 720;
+static const int kNumConversionStripes = 4;
 
-  // Check if |bitmap| needs to be (re)allocated.
-  if (bitmap->isNull() ||
-      bitmap->width() != video_frame->visible_rect().width() ||
-      bitmap->height() != video_frame->visible_rect().height()) {
-    bitmap->setConfig(SkBitmap::kARGB_8888_Config,
-                      video_frame->visible_rect().width(),
-                      video_frame->visible_rect().height());
-    bitmap->allocPixels();
-    bitmap->setIsVolatile(true);
-  }
-
-  bitmap->lockPixels();
-
-  size_t y_offset = 0;
-  size_t uv_offset = 0;
-  if (IsEitherYV12OrYV12AOrYV16(video_frame->format())) {
-    int y_shift = (video_frame->format() == media::VideoFrame::YV16) ? 0 : 1;
-    // Use the "left" and "top" of the destination rect to locate the offset
-    // in Y, U and V planes.
-    y_offset = (video_frame->stride(media::VideoFrame::kYPlane) *
-                video_frame->visible_rect().y()) +
-                video_frame->visible_rect().x();
-    // For format YV12, there is one U, V value per 2x2 block.
-    // For format YV16, there is one U, V value per 2x1 block.
-    uv_offset = (video_frame->stride(media::VideoFrame::kUPlane) *
-                (video_frame->visible_rect().y() >> y_shift)) +
-                (video_frame->visible_rect().x() >> 1);
-  }
+// Converts |num_rows| rows of the visible area of |video_frame|, starting at
+// |first_row|, from YUV to RGB.  |rgb_pixels| points at the RGB data for the
+// first row of the visible area.
+static void ConvertVideoFrameRows(
+    const scoped_refptr<media::VideoFrame>& video_frame,
+    uint8* rgb_pixels,
+    size_t rgb_stride,
+    int first_row,
+    int num_rows) {
+  int y_shift = (video_frame->format() == media::VideoFrame::YV16) ? 0 : 1;
+  // Rows that share U and V samples must be converted together.
+  DCHECK_EQ(0, first_row & y_shift);
+
+  const gfx::Rect& visible_rect = video_frame->visible_rect();
+  const int y_stride = video_frame->stride(media::VideoFrame::kYPlane);
+  const int uv_stride = video_frame->stride(media::VideoFrame::kUPlane);
+  // Use the "left" and "top" of the destination rect to locate the offset
+  // in Y, U and V planes.
+  size_t y_offset =
+      y_stride * (visible_rect.y() + first_row) + visible_rect.x();
+  // For format YV12, there is one U, V value per 2x2 block.
+  // For format YV16, there is one U, V value per 2x1 block.
+  size_t uv_offset =
+      uv_stride * ((visible_rect.y() >> y_shift) + (first_row >> y_shift)) +
+      (visible_rect.x() >> 1);
+  uint8* rgb_row = rgb_pixels + rgb_stride * first_row;
 
   switch (video_frame->format()) {
     case media::VideoFrame::YV12:
@@ -232,12 +229,12 @@ static void ConvertVideoFrameToBitmap(
           video_frame->data(media::VideoFrame::kYPlane) + y_offset,
           video_frame->data(media::VideoFrame::kUPlane) + uv_offset,
           video_frame->data(media::VideoFrame::kVPlane) + uv_offset,
-          static_cast<uint8*>(bitmap->getPixels()),
-          video_frame->visible_rect().width(),
-          video_frame->visible_rect().height(),
-          video_frame->stride(media::VideoFrame::kYPlane),
-          video_frame->stride(media::VideoFrame::kUPlane),
-          bitmap->rowBytes(),
+          rgb_row,
+          visible_rect.width(),
+          num_rows,
+          y_stride,
+          uv_stride,
+          rgb_stride,
           media::YV12);
       break;
 
@@ -246,12 +243,12 @@ static void ConvertVideoFrameToBitmap(
           video_frame->data(media::VideoFrame::kYPlane) + y_offset,
           video_frame->data(media::VideoFrame::kUPlane) + uv_offset,
           video_frame->data(media::VideoFrame::kVPlane) + uv_offset,
-          static_cast<uint8*>(bitmap->getPixels()),
-          video_frame->visible_rect().width(),
-          video_frame->visible_rect().height(),
-          video_frame->stride(media::VideoFrame::kYPlane),
-          video_frame->stride(media::VideoFrame::kUPlane),
-          bitmap->rowBytes(),
+          rgb_row,
+          visible_rect.width(),
+          num_rows,
+          y_stride,
+          uv_stride,
+          rgb_stride,
           media::YV16);
       break;
 
@@ -260,26 +257,100 @@ static void ConvertVideoFrameToBitmap(
           video_frame->data(media::VideoFrame::kYPlane) + y_offset,
           video_frame->data(media::VideoFrame::kUPlane) + uv_offset,
           video_frame->data(media::VideoFrame::kVPlane) + uv_offset,
-          video_frame->data(media::VideoFrame::kAPlane),
-          static_cast<uint8*>(bitmap->getPixels()),
-          video_frame->visible_rect().width(),
-          video_frame->visible_rect().height(),
-          video_frame->stride(media::VideoFrame::kYPlane),
-          video_frame->stride(media::VideoFrame::kUPlane),
+          video_frame->data(media::VideoFrame::kAPlane) +
+              video_frame->stride(media::VideoFrame::kAPlane) * first_row,
+          rgb_row,
+          visible_rect.width(),
+          num_rows,
+          y_stride,
+          uv_stride,
           video_frame->stride(media::VideoFrame::kAPlane),
-          bitmap->rowBytes(),
+          rgb_stride,
           media::YV12);
       break;
 
-    case media::VideoFrame::NATIVE_TEXTURE:
-      DCHECK_EQ(video_frame->format(), media::VideoFrame::NATIVE_TEXTURE);
-      video_frame->ReadPixelsFromNativeTexture(*bitmap);
-      break;
-
     default:
       NOTREACHED();
       break;
   }
+}
+
+// Converts a stripe on a worker thread and signals |done| once the last of the
+// |pending_stripes| has been converted.
+static void ConvertVideoFrameStripe(
+    const scoped_refptr<media::VideoFrame>& video_frame,
+    uint8* rgb_pixels,
+    size_t rgb_stride,
+    int first_row,
+    int num_rows,
+    base::AtomicRefCount* pending_stripes,
+    base::WaitableEvent* done) {
+  ConvertVideoFrameRows(
+      video_frame, rgb_pixels, rgb_stride, first_row, num_rows);
+  if (!base::AtomicRefCountDec(pending_stripes))
+    done->Signal();
+}
+
+// Converts a VideoFrame containing YUV data to a SkBitmap containing RGB data.
+//
+// |bitmap| will be (re)allocated to match the dimensions of |video_frame|.
+static void ConvertVideoFrameToBitmap(
+    const scoped_refptr<media::VideoFrame>& video_frame,
+    SkBitmap* bitmap) {
+  DCHECK(IsEitherYV12OrYV12AOrYV16OrNative(video_frame->format()))
+      << video_frame->format();
+  if (IsEitherYV12OrYV12AOrYV16(video_frame->format())) {
+    DCHECK_EQ(video_frame->stride(media::VideoFrame::kUPlane),
+              video_frame->stride(media::VideoFrame::kVPlane));
+  }
+
+  // Check if |bitmap| needs to be (re)allocated.
+  if (bitmap->isNull() ||
+      bitmap->width() != video_frame->visible_rect().width() ||
+      bitmap->height() != video_frame->visible_rect().height()) {
+    bitmap->setConfig(SkBitmap::kARGB_8888_Config,
+                      video_frame->visible_rect().width(),
+                      video_frame->visible_rect().height());
+    bitmap->allocPixels();
+    bitmap->setIsVolatile(true);
+  }
+
+  bitmap->lockPixels();
+
+  if (video_frame->format() == media::VideoFrame::NATIVE_TEXTURE) {
+    video_frame->ReadPixelsFromNativeTexture(*bitmap);
+  } else {
+    uint8* rgb_pixels = static_cast<uint8*>(bitmap->getPixels());
+    const size_t rgb_stride = bitmap->rowBytes();
+    const int height = video_frame->visible_rect().height();
+    const int num_stripes =
+        video_frame->visible_rect().size().GetArea() >=
+            kMinAreaForParallelConversion ? kNumConversionStripes : 1;
+    // Round the stripe height up to an even number of rows, so that no two
+    // stripes share U and V samples.
+    const int stripe_height =
+        std::max(2, ((height + num_stripes - 1) / num_stripes + 1) & ~1);
+    const int num_worker_stripes = (height - 1) / stripe_height;
+
+    base::AtomicRefCount pending_stripes = 0;
+    base::WaitableEvent done(false, false);
+    base::AtomicRefCountIncN(&pending_stripes, num_worker_stripes);
+    for (int i = 1; i <= num_worker_stripes; ++i) {
+      const int first_row = i * stripe_height;
+      base::Closure task = base::Bind(
+          &ConvertVideoFrameStripe, video_frame, rgb_pixels, rgb_stride,
+          first_row, std::min(stripe_height, height - first_row),
+          &pending_stripes, &done);
+      if (!base::WorkerPool::PostTask(FROM_HERE, task, false))
+        task.Run();
+    }
+
+    ConvertVideoFrameRows(video_frame, rgb_pixels, rgb_stride, 0,
+                          std::min(stripe_height, height));
+    if (num_worker_stripes > 0)
+      done.Wait();
+  }
+
   bitmap->notifyPixelsChanged();
   bitmap->unlockPixels();
 }
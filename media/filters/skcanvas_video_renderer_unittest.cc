@@ -345,4 +345,18 @@ TEST_F(SkCanvasVideoRendererTest, SlowPaint_CroppedFrame) {
                                                           kHeight * 3 / 6));
 }
 
+// Frames this large are converted in stripes on several threads.
+TEST_F(SkCanvasVideoRendererTest, SlowPaint_HighResolutionFrame) {
+  scoped_refptr<VideoFrame> frame =
+      VideoFrame::CreateBlackFrame(gfx::Size(1920, 1080));
+  frame->SetTimestamp(base::TimeDelta::FromMilliseconds(5));
+
+  Paint(frame.get(), slow_path_canvas(), kRed);
+  EXPECT_EQ(SK_ColorRED, GetColorAt(slow_path_canvas(), 0, 0));
+  EXPECT_EQ(SK_ColorRED, GetColorAt(slow_path_canvas(), kWidth / 2,
+                                                        kHeight / 2));
+  EXPECT_EQ(SK_ColorRED, GetColorAt(slow_path_canvas(), kWidth - 1,
+                                                        kHeight - 1));
+}
+
 }  // namespace media
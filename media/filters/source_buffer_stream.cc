@@ -1607,8 +1607,11 @@ void SourceBufferRange::AppendBuffersToEnd(const BufferQueue& new_buffers) {
     buffers_.push_back(*itr);
     size_in_bytes_ += (*itr)->data_size();
 
+    // Keyframes arrive in increasing decode order, so hinting the insertion
+    // at the end keeps appends from paying a full map lookup per keyframe.
     if ((*itr)->IsKeyframe()) {
       keyframe_map_.insert(
+          keyframe_map_.end(),
           std::make_pair((*itr)->GetDecodeTimestamp(),
                          buffers_.size() - 1 + keyframe_map_index_base_));
     }
@@ -1760,15 +1763,15 @@ int SourceBufferRange::DeleteGOPFromFront(BufferQueue* deleted_buffers) {
       buffers_.size();
 
   // Delete buffers from the beginning of the buffered range up until (but not
-  // including) the next keyframe.
-  for (int i = 0; i < end_index; i++) {
-    int bytes_deleted = buffers_.front()->data_size();
-    size_in_bytes_ -= bytes_deleted;
-    total_bytes_deleted += bytes_deleted;
-    deleted_buffers->push_back(buffers_.front());
-    buffers_.pop_front();
-    ++buffers_deleted;
-  }
+  // including) the next keyframe. The whole GOP is moved to |deleted_buffers|
+  // and erased from |buffers_| in one step rather than one buffer at a time.
+  BufferQueue::iterator gop_end = buffers_.begin() + end_index;
+  for (BufferQueue::iterator itr = buffers_.begin(); itr != gop_end; ++itr)
+    total_bytes_deleted += (*itr)->data_size();
+  size_in_bytes_ -= total_bytes_deleted;
+  deleted_buffers->insert(deleted_buffers->end(), buffers_.begin(), gop_end);
+  buffers_.erase(buffers_.begin(), gop_end);
+  buffers_deleted = end_index;
 
   // Update |keyframe_map_index_base_| to account for the deleted buffers.
   keyframe_map_index_base_ += buffers_deleted;
@@ -1801,16 +1804,15 @@ int SourceBufferRange::DeleteGOPFromBack(BufferQueue* deleted_buffers) {
   keyframe_map_.erase(back);
 
   int total_bytes_deleted = 0;
-  while (buffers_.size() != goal_size) {
-    int bytes_deleted = buffers_.back()->data_size();
-    size_in_bytes_ -= bytes_deleted;
-    total_bytes_deleted += bytes_deleted;
-    // We're removing buffers from the back, so push each removed buffer to the
-    // front of |deleted_buffers| so that |deleted_buffers| are in nondecreasing
-    // order.
-    deleted_buffers->push_front(buffers_.back());
-    buffers_.pop_back();
-  }
+  BufferQueue::iterator gop_start = buffers_.begin() + goal_size;
+  for (BufferQueue::iterator itr = gop_start; itr != buffers_.end(); ++itr)
+    total_bytes_deleted += (*itr)->data_size();
+  size_in_bytes_ -= total_bytes_deleted;
+  // We're removing buffers from the back, so insert the removed GOP at the
+  // front of |deleted_buffers| so that |deleted_buffers| are in nondecreasing
+  // order.
+  deleted_buffers->insert(deleted_buffers->begin(), gop_start, buffers_.end());
+  buffers_.erase(gop_start, buffers_.end());
 
   return total_bytes_deleted;
 }
@@ -0,0 +1,206 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// This tests the throughput of message pipes across processes.
+
+// TODO(vtl): Enable this on non-POSIX once we have a non-POSIX implementation.
+#include "build/build_config.h"
+#if defined(OS_POSIX)
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/bind.h"
+#include "base/bind_helpers.h"
+#include "base/location.h"
+#include "base/logging.h"
+#include "base/message_loop/message_loop.h"
+#include "base/threading/thread.h"
+#include "mojo/common/test/multiprocess_test_base.h"
+#include "mojo/public/system/core.h"
+#include "mojo/public/tests/test_support.h"
+#include "mojo/system/embedder/embedder.h"
+#include "mojo/system/embedder/scoped_platform_handle.h"
+#include "mojo/system/test_utils.h"
+
+namespace mojo {
+namespace system {
+namespace {
+
+const char kQuitMessage[] = "quitquitquit";
+
+void StoreChannelInfo(embedder::ChannelInfo** store_channel_info_here,
+                      embedder::ChannelInfo* channel_info) {
+  CHECK(channel_info);
+  *store_channel_info_here = channel_info;
+}
+
+// Runs a channel on its own I/O thread, and provides the handle of the
+// bootstrap message pipe on it.
+class ChannelThread {
+ public:
+  ChannelThread()
+      : io_thread_("io_thread"),
+        channel_info_(NULL),
+        message_pipe_(MOJO_HANDLE_INVALID) {}
+  ~ChannelThread() {
+    CHECK_EQ(message_pipe_, MOJO_HANDLE_INVALID);
+    CHECK(!io_thread_.IsRunning());
+  }
+
+  MojoHandle Start(embedder::ScopedPlatformHandle platform_handle) {
+    io_thread_.StartWithOptions(
+        base::Thread::Options(base::MessageLoop::TYPE_IO, 0));
+    message_pipe_ = embedder::CreateChannel(
+        platform_handle.Pass(), io_thread_.message_loop_proxy(),
+        base::Bind(&StoreChannelInfo, &channel_info_));
+    CHECK_NE(message_pipe_, MOJO_HANDLE_INVALID);
+    return message_pipe_;
+  }
+
+  void Stop() {
+    CHECK_EQ(MojoClose(message_pipe_), MOJO_RESULT_OK);
+    message_pipe_ = MOJO_HANDLE_INVALID;
+    // Wait for the channel to have been created, then destroy it.
+    test::PostTaskAndWait(io_thread_.message_loop_proxy(), FROM_HERE,
+                          base::Bind(&base::DoNothing));
+    CHECK(channel_info_);
+    test::PostTaskAndWait(io_thread_.message_loop_proxy(), FROM_HERE,
+                          base::Bind(&embedder::DestroyChannelOnIOThread,
+                                     channel_info_));
+    io_thread_.Stop();
+  }
+
+ private:
+  base::Thread io_thread_;
+  embedder::ChannelInfo* channel_info_;
+  MojoHandle message_pipe_;
+
+  DISALLOW_COPY_AND_ASSIGN(ChannelThread);
+};
+
+// Waits for a message on |message_pipe| and reads it into |message|. Returns
+// false if the other end was closed.
+bool ReadMessage(MojoHandle message_pipe, std::string* message) {
+  MojoResult result = MojoWait(message_pipe, MOJO_WAIT_FLAG_READABLE,
+                               MOJO_DEADLINE_INDEFINITE);
+  if (result != MOJO_RESULT_OK) {
+    CHECK_EQ(result, MOJO_RESULT_FAILED_PRECONDITION);
+    return false;
+  }
+
+  uint32_t num_bytes = static_cast<uint32_t>(message->size());
+  result = MojoReadMessage(message_pipe, &(*message)[0], &num_bytes, NULL,
+                           NULL, MOJO_READ_MESSAGE_FLAG_NONE);
+  if (result == MOJO_RESULT_RESOURCE_EXHAUSTED) {
+    message->resize(num_bytes);
+    result = MojoReadMessage(message_pipe, &(*message)[0], &num_bytes, NULL,
+                             NULL, MOJO_READ_MESSAGE_FLAG_NONE);
+  }
+  CHECK_EQ(result, MOJO_RESULT_OK);
+  message->resize(num_bytes);
+  return true;
+}
+
+void WriteMessage(MojoHandle message_pipe, const std::string& message) {
+  CHECK_EQ(MojoWriteMessage(message_pipe, message.data(),
+                            static_cast<uint32_t>(message.size()), NULL, 0,
+                            MOJO_WRITE_MESSAGE_FLAG_NONE),
+           MOJO_RESULT_OK);
+}
+
+// Echoes each message it receives, until it receives |kQuitMessage|.
+MOJO_MULTIPROCESS_TEST_CHILD_MAIN(PingPong) {
+  ChannelThread channel_thread;
+  MojoHandle message_pipe = channel_thread.Start(
+      mojo::test::MultiprocessTestBase::client_platform_handle.Pass());
+
+  std::string message(1000, '\0');
+  while (ReadMessage(message_pipe, &message) && message != kQuitMessage)
+    WriteMessage(message_pipe, message);
+
+  channel_thread.Stop();
+  return 0;
+}
+
+class MultiprocessMessagePipePerfTest
+    : public mojo::test::MultiprocessTestBase {
+ public:
+  MultiprocessMessagePipePerfTest() : message_pipe_(MOJO_HANDLE_INVALID) {}
+  virtual ~MultiprocessMessagePipePerfTest() {}
+
+  virtual void SetUp() OVERRIDE {
+    mojo::test::MultiprocessTestBase::SetUp();
+    StartChild("PingPong");
+    message_pipe_ = channel_thread_.Start(server_platform_handle.Pass());
+  }
+
+  virtual void TearDown() OVERRIDE {
+    WriteMessage(message_pipe_, kQuitMessage);
+    EXPECT_EQ(0, WaitForChildShutdown());
+    channel_thread_.Stop();
+    mojo::test::MultiprocessTestBase::TearDown();
+  }
+
+ protected:
+  // Sends |num_messages| messages of |message_size| bytes to the child, with
+  // up to |window| of them in flight, and waits for all of them to be echoed.
+  void Measure(const char* name,
+               size_t message_size,
+               size_t num_messages,
+               size_t window) {
+    const std::string message(message_size, 'x');
+    std::string reply(message_size, '\0');
+
+    test::Stopwatch stopwatch;
+    stopwatch.Start();
+    size_t num_sent = 0;
+    for (size_t num_received = 0; num_received < num_messages;
+         num_received++) {
+      for (; num_sent < num_messages && num_sent - num_received < window;
+           num_sent++)
+        WriteMessage(message_pipe_, message);
+      CHECK(ReadMessage(message_pipe_, &reply));
+      CHECK_EQ(message_size, reply.size());
+    }
+    int64_t elapsed_microseconds = stopwatch.Elapsed();
+
+    char test_name[200];
+    sprintf(test_name, "MultiprocessMessagePipe_%s_%ubytes", name,
+            static_cast<unsigned>(message_size));
+    mojo::test::LogPerfResult(
+        test_name,
+        1000000.0 * static_cast<double>(num_messages) / elapsed_microseconds,
+        "round trips/second");
+  }
+
+ private:
+  ChannelThread channel_thread_;
+  MojoHandle message_pipe_;
+
+  DISALLOW_COPY_AND_ASSIGN(MultiprocessMessagePipePerfTest);
+};
+
+// One message in flight at a time, which measures the latency.
+TEST_F(MultiprocessMessagePipePerfTest, PingPong) {
+  static const size_t kMessageSizes[] = { 8, 64, 1024, 16 * 1024 };
+  for (size_t i = 0; i < arraysize(kMessageSizes); i++)
+    Measure("PingPong", kMessageSizes[i], 10000, 1);
+}
+
+// Many messages in flight, which lets the channel coalesce writes and reads.
+TEST_F(MultiprocessMessagePipePerfTest, Burst) {
+  static const size_t kMessageSizes[] = { 8, 64, 1024, 16 * 1024 };
+  for (size_t i = 0; i < arraysize(kMessageSizes); i++)
+    Measure("Burst", kMessageSizes[i], 10000, 100);
+}
+
+}  // namespace
+}  // namespace system
+}  // namespace mojo
+
+#endif  // defined(OS_POSIX)
@@ -6,6 +6,7 @@
 
 #include <errno.h>
 #include <string.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include <algorithm>
@@ -22,6 +23,7 @@
 #include "base/message_loop/message_loop.h"
 #include "base/posix/eintr_wrapper.h"
 #include "base/synchronization/lock.h"
+#include "mojo/system/constants.h"
 #include "mojo/system/embedder/platform_handle.h"
 #include "mojo/system/message_in_transit.h"
 
@@ -30,7 +32,13 @@ namespace system {
 
 namespace {
 
+// The minimum number of bytes to make room for before a |read()|.
 const size_t kReadSize = 4096;
+// The initial size of the read buffer, which is reused for all reads. It only
+// grows if a single message doesn't fit.
+const size_t kInitialReadBufferSize = 64 * 1024;
+// The maximum number of queued messages to write with a single |writev()|.
+const size_t kMaxMessagesPerWrite = 16;
 
 class RawChannelPosix : public RawChannel,
                         public base::MessageLoopForIO::Watcher {
@@ -57,11 +65,17 @@ class RawChannelPosix : public RawChannel,
   // thread WITHOUT |write_lock_| held.
   void CallOnFatalError(Delegate::FatalError fatal_error);
 
-  // Writes the message at the front of |write_message_queue_|, starting at
-  // |write_message_offset_|. It removes and destroys if the write completes and
-  // otherwise updates |write_message_offset_|. Returns true on success. Must be
-  // called under |write_lock_|.
-  bool WriteFrontMessageNoLock();
+  // Makes room for at least |num_bytes| more bytes after the valid data in
+  // |read_buffer_|, moving the valid data to the start of the buffer only if
+  // there isn't enough room after it.
+  void EnsureReadBufferSpace(size_t num_bytes);
+
+  // Writes as many of the messages in |write_message_queue_| as possible with
+  // a single |writev()|, starting at |write_message_offset_| in the front
+  // message. It removes and destroys the messages which were written
+  // completely and updates |write_message_offset_|. Returns true on success.
+  // Must be called under |write_lock_|.
+  bool WriteQueuedMessagesNoLock();
 
   // Cancels all pending writes and destroys the contents of
   // |write_message_queue_|. Should only be called if |write_stopped_| is false;
@@ -74,11 +88,12 @@ class RawChannelPosix : public RawChannel,
   scoped_ptr<base::MessageLoopForIO::FileDescriptorWatcher> read_watcher_;
   scoped_ptr<base::MessageLoopForIO::FileDescriptorWatcher> write_watcher_;
 
-  // We store data from |read()|s in |read_buffer_|. The start of |read_buffer_|
-  // is always aligned with a message boundary (we will copy memory to ensure
-  // this), but |read_buffer_| may be larger than the actual number of bytes we
-  // have.
+  // We store data from |read()|s in |read_buffer_|. |read_buffer_start_| is
+  // always aligned with a message boundary, and is the offset of the first
+  // undispatched message. Data is only moved back to the start of the buffer
+  // when there isn't enough room after it for the next |read()|.
   std::vector<char> read_buffer_;
+  size_t read_buffer_start_;
   size_t read_buffer_num_valid_bytes_;
 
   base::Lock write_lock_;  // Protects the following members.
@@ -98,6 +113,7 @@ RawChannelPosix::RawChannelPosix(embedder::ScopedPlatformHandle handle,
                                  base::MessageLoopForIO* message_loop_for_io)
     : RawChannel(delegate, message_loop_for_io),
       fd_(handle.Pass()),
+      read_buffer_start_(0),
       read_buffer_num_valid_bytes_(0),
       write_stopped_(false),
       write_message_offset_(0),
@@ -176,7 +192,7 @@ bool RawChannelPosix::WriteMessage(MessageInTransit* message) {
 
   write_message_queue_.push_front(message);
   DCHECK_EQ(write_message_offset_, 0u);
-  bool result = WriteFrontMessageNoLock();
+  bool result = WriteQueuedMessagesNoLock();
   DCHECK(result || write_message_queue_.empty());
 
   if (!result) {
@@ -208,30 +224,26 @@ void RawChannelPosix::OnFileCanReadWithoutBlocking(int fd) {
   DCHECK_EQ(base::MessageLoop::current(), message_loop_for_io());
 
   bool did_dispatch_message = false;
-  // Tracks the offset of the first undispatched message in |read_buffer_|.
-  // Currently, we copy data to ensure that this is zero at the beginning.
-  size_t read_buffer_start = 0;
   for (;;) {
-    if (read_buffer_.size() - (read_buffer_start + read_buffer_num_valid_bytes_)
-            < kReadSize) {
-      // Use power-of-2 buffer sizes.
-      // TODO(vtl): Make sure the buffer doesn't get too large (and enforce the
-      // maximum message size to whatever extent necessary).
-      // TODO(vtl): We may often be able to peek at the header and get the real
-      // required extra space (which may be much bigger than |kReadSize|).
-      size_t new_size = std::max(read_buffer_.size(), kReadSize);
-      while (new_size <
-                 read_buffer_start + read_buffer_num_valid_bytes_ + kReadSize)
-        new_size *= 2;
-
-      // TODO(vtl): It's suboptimal to zero out the fresh memory.
-      read_buffer_.resize(new_size, 0);
-    }
-
+    // If the header of the next message is already here, make room for all of
+    // it, so that it's read into place (instead of growing the buffer and
+    // copying the partial message repeatedly). Don't trust the size of huge
+    // messages, though, since it comes from the other side.
+    size_t num_bytes_needed = kReadSize;
+    size_t message_size;
+    if (read_buffer_num_valid_bytes_ > 0 &&
+        MessageInTransit::GetNextMessageSize(&read_buffer_[read_buffer_start_],
+                                             read_buffer_num_valid_bytes_,
+                                             &message_size) &&
+        message_size <= kMaxMessageNumBytes &&
+        message_size > read_buffer_num_valid_bytes_ + kReadSize)
+      num_bytes_needed = message_size - read_buffer_num_valid_bytes_;
+    EnsureReadBufferSpace(num_bytes_needed);
+
+    size_t read_offset = read_buffer_start_ + read_buffer_num_valid_bytes_;
+    size_t bytes_to_read = read_buffer_.size() - read_offset;
     ssize_t bytes_read = HANDLE_EINTR(
-        read(fd_.get().fd,
-             &read_buffer_[read_buffer_start + read_buffer_num_valid_bytes_],
-             kReadSize));
+        read(fd_.get().fd, &read_buffer_[read_offset], bytes_to_read));
     if (bytes_read < 0) {
       if (errno != EAGAIN && errno != EWOULDBLOCK) {
         PLOG(ERROR) << "read";
@@ -250,21 +262,18 @@ void RawChannelPosix::OnFileCanReadWithoutBlocking(int fd) {
     read_buffer_num_valid_bytes_ += static_cast<size_t>(bytes_read);
 
     // Dispatch all the messages that we can.
-    size_t message_size;
     // Note that we rely on short-circuit evaluation here:
-    //   - |read_buffer_start| may be an invalid index into |read_buffer_| if
+    //   - |read_buffer_start_| may be an invalid index into |read_buffer_| if
     //     |read_buffer_num_valid_bytes_| is zero.
     //   - |message_size| is only valid if |GetNextMessageSize()| returns true.
-    // TODO(vtl): Use |message_size| more intelligently (e.g., to request the
-    // next read).
     while (read_buffer_num_valid_bytes_ > 0 &&
            MessageInTransit::GetNextMessageSize(
-               &read_buffer_[read_buffer_start], read_buffer_num_valid_bytes_,
+               &read_buffer_[read_buffer_start_], read_buffer_num_valid_bytes_,
                &message_size) &&
            read_buffer_num_valid_bytes_ >= message_size) {
       const MessageInTransit* message =
           MessageInTransit::CreateReadOnlyFromBuffer(
-              &read_buffer_[read_buffer_start]);
+              &read_buffer_[read_buffer_start_]);
       DCHECK_EQ(message->main_buffer_size(), message_size);
 
       // Dispatch the message.
@@ -277,9 +286,13 @@ void RawChannelPosix::OnFileCanReadWithoutBlocking(int fd) {
       did_dispatch_message = true;
 
       // Update our state.
-      read_buffer_start += message_size;
+      read_buffer_start_ += message_size;
       read_buffer_num_valid_bytes_ -= message_size;
     }
+    // Once everything has been dispatched, the next read can start at the
+    // start of the buffer without moving anything.
+    if (read_buffer_num_valid_bytes_ == 0)
+      read_buffer_start_ = 0;
 
     // If we dispatched any messages, stop reading for now (and let the message
     // loop do its thing for another round).
@@ -290,21 +303,12 @@ void RawChannelPosix::OnFileCanReadWithoutBlocking(int fd) {
     if (did_dispatch_message)
       break;
 
-    // If we didn't max out |kReadSize|, stop reading for now.
-    if (static_cast<size_t>(bytes_read) < kReadSize)
+    // If we didn't fill the buffer, stop reading for now.
+    if (static_cast<size_t>(bytes_read) < bytes_to_read)
       break;
 
     // Else try to read some more....
   }
-
-  // Move data back to start.
-  if (read_buffer_start > 0) {
-    if (read_buffer_num_valid_bytes_ > 0) {
-      memmove(&read_buffer_[0], &read_buffer_[read_buffer_start],
-              read_buffer_num_valid_bytes_);
-    }
-    read_buffer_start = 0;
-  }
 }
 
 void RawChannelPosix::OnFileCanWriteWithoutBlocking(int fd) {
@@ -321,7 +325,7 @@ void RawChannelPosix::OnFileCanWriteWithoutBlocking(int fd) {
       return;
     }
 
-    bool result = WriteFrontMessageNoLock();
+    bool result = WriteQueuedMessagesNoLock();
     DCHECK(result || write_message_queue_.empty());
 
     if (!result) {
@@ -351,20 +355,59 @@ void RawChannelPosix::CallOnFatalError(Delegate::FatalError fatal_error) {
   delegate()->OnFatalError(fatal_error);
 }
 
-bool RawChannelPosix::WriteFrontMessageNoLock() {
+void RawChannelPosix::EnsureReadBufferSpace(size_t num_bytes) {
+  size_t end = read_buffer_start_ + read_buffer_num_valid_bytes_;
+  if (read_buffer_.size() - end >= num_bytes)
+    return;
+
+  // Move the partial message back to the start. (This keeps the alignment,
+  // since |read_buffer_start_| is at a message boundary.)
+  if (read_buffer_start_ > 0) {
+    if (read_buffer_num_valid_bytes_ > 0) {
+      memmove(&read_buffer_[0], &read_buffer_[read_buffer_start_],
+              read_buffer_num_valid_bytes_);
+    }
+    read_buffer_start_ = 0;
+    end = read_buffer_num_valid_bytes_;
+  }
+  if (read_buffer_.size() - end >= num_bytes)
+    return;
+
+  // Use power-of-2 buffer sizes.
+  // TODO(vtl): Make sure the buffer doesn't get too large (and enforce the
+  // maximum message size to whatever extent necessary).
+  size_t new_size = std::max(read_buffer_.size(), kInitialReadBufferSize);
+  while (new_size < end + num_bytes)
+    new_size *= 2;
+
+  // TODO(vtl): It's suboptimal to zero out the fresh memory.
+  read_buffer_.resize(new_size, 0);
+}
+
+bool RawChannelPosix::WriteQueuedMessagesNoLock() {
   write_lock_.AssertAcquired();
 
   DCHECK(!write_stopped_);
   DCHECK(!write_message_queue_.empty());
 
-  MessageInTransit* message = write_message_queue_.front();
-  DCHECK_LT(write_message_offset_, message->main_buffer_size());
-  size_t bytes_to_write = message->main_buffer_size() - write_message_offset_;
+  // Gather the queued messages, starting with what's left of the front one.
+  struct iovec iov[kMaxMessagesPerWrite];
+  size_t num_iov = 0;
+  size_t bytes_to_write = 0;
+  for (std::deque<MessageInTransit*>::const_iterator it =
+           write_message_queue_.begin();
+       it != write_message_queue_.end() && num_iov < kMaxMessagesPerWrite;
+       ++it, ++num_iov) {
+    size_t offset = (num_iov == 0) ? write_message_offset_ : 0;
+    DCHECK_LT(offset, (*it)->main_buffer_size());
+    iov[num_iov].iov_base = const_cast<char*>(
+        static_cast<const char*>((*it)->main_buffer()) + offset);
+    iov[num_iov].iov_len = (*it)->main_buffer_size() - offset;
+    bytes_to_write += iov[num_iov].iov_len;
+  }
+
   ssize_t bytes_written = HANDLE_EINTR(
-      write(fd_.get().fd,
-            static_cast<const char*>(message->main_buffer()) +
-                write_message_offset_,
-            bytes_to_write));
+      writev(fd_.get().fd, iov, static_cast<int>(num_iov)));
   if (bytes_written < 0) {
     if (errno != EAGAIN && errno != EWOULDBLOCK) {
       PLOG(ERROR) << "write of size " << bytes_to_write;
@@ -378,12 +421,21 @@ bool RawChannelPosix::WriteFrontMessageNoLock() {
   }
 
   DCHECK_GE(bytes_written, 0);
-  if (static_cast<size_t>(bytes_written) < bytes_to_write) {
-    // Partial (or no) write.
-    write_message_offset_ += static_cast<size_t>(bytes_written);
-  } else {
-    // Complete write.
-    DCHECK_EQ(static_cast<size_t>(bytes_written), bytes_to_write);
+  DCHECK_LE(static_cast<size_t>(bytes_written), bytes_to_write);
+  // Destroy the messages that were written completely, and remember how much
+  // of the next one was written.
+  size_t bytes_remaining = static_cast<size_t>(bytes_written);
+  while (bytes_remaining > 0) {
+    MessageInTransit* message = write_message_queue_.front();
+    size_t message_bytes_remaining =
+        message->main_buffer_size() - write_message_offset_;
+    if (bytes_remaining < message_bytes_remaining) {
+      // Partial write.
+      write_message_offset_ += bytes_remaining;
+      break;
+    }
+
+    bytes_remaining -= message_bytes_remaining;
     write_message_queue_.pop_front();
     write_message_offset_ = 0;
     message->Destroy();
@@ -0,0 +1,372 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "mojo/system/shared_memory_data_pipe.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "base/atomicops.h"
+#include "base/logging.h"
+#include "mojo/system/constants.h"
+
+namespace mojo {
+namespace system {
+
+// The start of the shared memory. Each position is only written by its own
+// side.
+struct SharedMemoryDataPipe::Header {
+  base::subtle::Atomic32 write_position;
+  base::subtle::Atomic32 read_position;
+};
+
+namespace {
+
+// The buffer starts at a cache line boundary, away from the |Header|.
+const size_t kBufferOffset = 64;
+
+COMPILE_ASSERT(kBufferOffset % kDataPipeBufferAlignmentBytes == 0,
+               data_pipe_buffer_is_misaligned);
+// Positions run up to twice the capacity.
+COMPILE_ASSERT(kMaxDataPipeCapacityBytes <= 0x7fffffff,
+               data_pipe_positions_may_overflow);
+
+uint32_t LoadPosition(const base::subtle::Atomic32* position) {
+  return static_cast<uint32_t>(base::subtle::Acquire_Load(position));
+}
+
+void StorePosition(base::subtle::Atomic32* position, uint32_t value) {
+  base::subtle::Release_Store(position,
+                              static_cast<base::subtle::Atomic32>(value));
+}
+
+}  // namespace
+
+SharedMemoryDataPipe::SharedMemoryDataPipe(
+    const MojoCreateDataPipeOptions& options)
+    : DataPipe(true, true, options),
+      header_(NULL),
+      buffer_(NULL),
+      write_position_(0),
+      read_position_(0) {
+  DCHECK(!may_discard());
+}
+
+bool SharedMemoryDataPipe::Init() {
+  scoped_ptr<base::SharedMemory> shared_memory(new base::SharedMemory());
+  // Note: Anonymous shared memory is zero-filled, so both positions start out
+  // at zero.
+  if (!shared_memory->CreateAndMapAnonymous(kBufferOffset +
+                                            capacity_num_bytes()))
+    return false;
+
+  shared_memory_ = shared_memory.Pass();
+  header_ = static_cast<Header*>(shared_memory_->memory());
+  buffer_ = static_cast<char*>(shared_memory_->memory()) + kBufferOffset;
+  COMPILE_ASSERT(sizeof(Header) <= kBufferOffset, header_overlaps_buffer);
+  return true;
+}
+
+SharedMemoryDataPipe::~SharedMemoryDataPipe() {
+}
+
+void SharedMemoryDataPipe::ProducerCloseImplNoLock() {
+  // The consumer may still read the data which is left in the buffer.
+  if (!consumer_open_no_lock())
+    DestroyBufferNoLock();
+}
+
+MojoResult SharedMemoryDataPipe::ProducerWriteDataImplNoLock(
+    const void* elements,
+    uint32_t* num_bytes,
+    bool all_or_none) {
+  DCHECK_EQ(*num_bytes % element_num_bytes(), 0u);
+  DCHECK_GT(*num_bytes, 0u);
+  DCHECK(consumer_open_no_lock());
+
+  size_t num_bytes_free =
+      capacity_num_bytes() - GetNumBytesStoredForProducerNoLock();
+  if (all_or_none && *num_bytes > num_bytes_free) {
+    // Don't return "should wait" since you can't wait for a specified amount
+    // of data.
+    return MOJO_RESULT_OUT_OF_RANGE;
+  }
+
+  size_t num_bytes_to_write =
+      std::min(static_cast<size_t>(*num_bytes), num_bytes_free);
+  if (num_bytes_to_write == 0)
+    return MOJO_RESULT_SHOULD_WAIT;
+
+  // The amount we can write in our first |memcpy()|.
+  size_t write_index = PositionToIndex(write_position_);
+  size_t num_bytes_to_write_first =
+      std::min(num_bytes_to_write, capacity_num_bytes() - write_index);
+  // Do the first (and possibly only) |memcpy()|.
+  memcpy(buffer_ + write_index, elements, num_bytes_to_write_first);
+
+  if (num_bytes_to_write_first < num_bytes_to_write) {
+    // The "second write index" is zero.
+    memcpy(buffer_,
+           static_cast<const char*>(elements) + num_bytes_to_write_first,
+           num_bytes_to_write - num_bytes_to_write_first);
+  }
+
+  MarkDataAsWrittenNoLock(num_bytes_to_write);
+  *num_bytes = static_cast<uint32_t>(num_bytes_to_write);
+  return MOJO_RESULT_OK;
+}
+
+MojoResult SharedMemoryDataPipe::ProducerBeginWriteDataImplNoLock(
+    void** buffer,
+    uint32_t* buffer_num_bytes,
+    bool all_or_none) {
+  DCHECK(consumer_open_no_lock());
+
+  // The index we need to start writing at.
+  size_t write_index = PositionToIndex(write_position_);
+
+  size_t max_num_bytes_to_write =
+      std::min(capacity_num_bytes() - GetNumBytesStoredForProducerNoLock(),
+               capacity_num_bytes() - write_index);
+  if (all_or_none && *buffer_num_bytes > max_num_bytes_to_write) {
+    // Don't return "should wait" since you can't wait for a specified amount
+    // of data.
+    return MOJO_RESULT_OUT_OF_RANGE;
+  }
+
+  // Don't go into a two-phase write if there's no room.
+  if (max_num_bytes_to_write == 0)
+    return MOJO_RESULT_SHOULD_WAIT;
+
+  *buffer = buffer_ + write_index;
+  *buffer_num_bytes = static_cast<uint32_t>(max_num_bytes_to_write);
+  set_producer_two_phase_max_num_bytes_written_no_lock(
+      static_cast<uint32_t>(max_num_bytes_to_write));
+  return MOJO_RESULT_OK;
+}
+
+MojoResult SharedMemoryDataPipe::ProducerEndWriteDataImplNoLock(
+    uint32_t num_bytes_written) {
+  DCHECK_LE(num_bytes_written,
+            producer_two_phase_max_num_bytes_written_no_lock());
+  MarkDataAsWrittenNoLock(num_bytes_written);
+  set_producer_two_phase_max_num_bytes_written_no_lock(0);
+  return MOJO_RESULT_OK;
+}
+
+MojoWaitFlags SharedMemoryDataPipe::ProducerSatisfiedFlagsNoLock() {
+  MojoWaitFlags rv = MOJO_WAIT_FLAG_NONE;
+  if (consumer_open_no_lock() &&
+      GetNumBytesStoredForProducerNoLock() < capacity_num_bytes() &&
+      !producer_in_two_phase_write_no_lock())
+    rv |= MOJO_WAIT_FLAG_WRITABLE;
+  return rv;
+}
+
+MojoWaitFlags SharedMemoryDataPipe::ProducerSatisfiableFlagsNoLock() {
+  MojoWaitFlags rv = MOJO_WAIT_FLAG_NONE;
+  if (consumer_open_no_lock())
+    rv |= MOJO_WAIT_FLAG_WRITABLE;
+  return rv;
+}
+
+void SharedMemoryDataPipe::ConsumerCloseImplNoLock() {
+  // If the producer is still open, it may be in a two-phase write into the
+  // buffer (and will not be able to start another one).
+  if (!producer_open_no_lock())
+    DestroyBufferNoLock();
+}
+
+MojoResult SharedMemoryDataPipe::ConsumerReadDataImplNoLock(
+    void* elements,
+    uint32_t* num_bytes,
+    bool all_or_none) {
+  DCHECK_EQ(*num_bytes % element_num_bytes(), 0u);
+  DCHECK_GT(*num_bytes, 0u);
+
+  size_t num_bytes_stored = GetNumBytesStoredForConsumerNoLock();
+  if (all_or_none && *num_bytes > num_bytes_stored) {
+    // Don't return "should wait" since you can't wait for a specified amount of
+    // data.
+    return producer_open_no_lock() ? MOJO_RESULT_OUT_OF_RANGE :
+                                     MOJO_RESULT_FAILED_PRECONDITION;
+  }
+
+  size_t num_bytes_to_read =
+      std::min(static_cast<size_t>(*num_bytes), num_bytes_stored);
+  if (num_bytes_to_read == 0) {
+    return producer_open_no_lock() ? MOJO_RESULT_SHOULD_WAIT :
+                                     MOJO_RESULT_FAILED_PRECONDITION;
+  }
+
+  // The amount we can read in our first |memcpy()|.
+  size_t read_index = PositionToIndex(read_position_);
+  size_t num_bytes_to_read_first =
+      std::min(num_bytes_to_read, capacity_num_bytes() - read_index);
+  memcpy(elements, buffer_ + read_index, num_bytes_to_read_first);
+
+  if (num_bytes_to_read_first < num_bytes_to_read) {
+    // The "second read index" is zero.
+    memcpy(static_cast<char*>(elements) + num_bytes_to_read_first,
+           buffer_,
+           num_bytes_to_read - num_bytes_to_read_first);
+  }
+
+  MarkDataAsConsumedNoLock(num_bytes_to_read);
+  *num_bytes = static_cast<uint32_t>(num_bytes_to_read);
+  return MOJO_RESULT_OK;
+}
+
+MojoResult SharedMemoryDataPipe::ConsumerDiscardDataImplNoLock(
+    uint32_t* num_bytes,
+    bool all_or_none) {
+  DCHECK_EQ(*num_bytes % element_num_bytes(), 0u);
+  DCHECK_GT(*num_bytes, 0u);
+
+  size_t num_bytes_stored = GetNumBytesStoredForConsumerNoLock();
+  if (all_or_none && *num_bytes > num_bytes_stored) {
+    // Don't return "should wait" since you can't wait for a specified amount of
+    // data.
+    return producer_open_no_lock() ? MOJO_RESULT_OUT_OF_RANGE :
+                                     MOJO_RESULT_FAILED_PRECONDITION;
+  }
+
+  // Be consistent with other operations; error if no data available.
+  if (num_bytes_stored == 0) {
+    return producer_open_no_lock() ? MOJO_RESULT_SHOULD_WAIT :
+                                     MOJO_RESULT_FAILED_PRECONDITION;
+  }
+
+  size_t num_bytes_to_discard =
+      std::min(static_cast<size_t>(*num_bytes), num_bytes_stored);
+  MarkDataAsConsumedNoLock(num_bytes_to_discard);
+  *num_bytes = static_cast<uint32_t>(num_bytes_to_discard);
+  return MOJO_RESULT_OK;
+}
+
+MojoResult SharedMemoryDataPipe::ConsumerQueryDataImplNoLock(
+    uint32_t* num_bytes) {
+  // Note: This cast is safe, since the capacity fits into a |uint32_t|.
+  *num_bytes = static_cast<uint32_t>(GetNumBytesStoredForConsumerNoLock());
+  return MOJO_RESULT_OK;
+}
+
+MojoResult SharedMemoryDataPipe::ConsumerBeginReadDataImplNoLock(
+    const void** buffer,
+    uint32_t* buffer_num_bytes,
+    bool all_or_none) {
+  size_t read_index = PositionToIndex(read_position_);
+  size_t max_num_bytes_to_read =
+      std::min(GetNumBytesStoredForConsumerNoLock(),
+               capacity_num_bytes() - read_index);
+  if (all_or_none && *buffer_num_bytes > max_num_bytes_to_read) {
+    // Don't return "should wait" since you can't wait for a specified amount of
+    // data.
+    return producer_open_no_lock() ? MOJO_RESULT_OUT_OF_RANGE :
+                                     MOJO_RESULT_FAILED_PRECONDITION;
+  }
+
+  // Don't go into a two-phase read if there's no data.
+  if (max_num_bytes_to_read == 0) {
+    return producer_open_no_lock() ? MOJO_RESULT_SHOULD_WAIT :
+                                     MOJO_RESULT_FAILED_PRECONDITION;
+  }
+
+  *buffer = buffer_ + read_index;
+  *buffer_num_bytes = static_cast<uint32_t>(max_num_bytes_to_read);
+  set_consumer_two_phase_max_num_bytes_read_no_lock(
+      static_cast<uint32_t>(max_num_bytes_to_read));
+  return MOJO_RESULT_OK;
+}
+
+MojoResult SharedMemoryDataPipe::ConsumerEndReadDataImplNoLock(
+    uint32_t num_bytes_read) {
+  DCHECK_LE(num_bytes_read, consumer_two_phase_max_num_bytes_read_no_lock());
+  MarkDataAsConsumedNoLock(num_bytes_read);
+  set_consumer_two_phase_max_num_bytes_read_no_lock(0);
+  return MOJO_RESULT_OK;
+}
+
+MojoWaitFlags SharedMemoryDataPipe::ConsumerSatisfiedFlagsNoLock() {
+  MojoWaitFlags rv = MOJO_WAIT_FLAG_NONE;
+  if (GetNumBytesStoredForConsumerNoLock() > 0 &&
+      !consumer_in_two_phase_read_no_lock())
+    rv |= MOJO_WAIT_FLAG_READABLE;
+  return rv;
+}
+
+MojoWaitFlags SharedMemoryDataPipe::ConsumerSatisfiableFlagsNoLock() {
+  MojoWaitFlags rv = MOJO_WAIT_FLAG_NONE;
+  if (GetNumBytesStoredForConsumerNoLock() > 0 || producer_open_no_lock())
+    rv |= MOJO_WAIT_FLAG_READABLE;
+  return rv;
+}
+
+void SharedMemoryDataPipe::DestroyBufferNoLock() {
+  header_ = NULL;
+  buffer_ = NULL;
+  shared_memory_.reset();
+}
+
+size_t SharedMemoryDataPipe::GetNumBytesStoredForProducerNoLock() const {
+  DCHECK(header_);
+  uint32_t read_position = LoadPosition(&header_->read_position);
+  if (read_position >= 2 * capacity_num_bytes() ||
+      Distance(read_position, write_position_) > capacity_num_bytes()) {
+    LOG(ERROR) << "Invalid data pipe read position";
+    return capacity_num_bytes();
+  }
+  return Distance(read_position, write_position_);
+}
+
+size_t SharedMemoryDataPipe::GetNumBytesStoredForConsumerNoLock() const {
+  // Once both sides have been closed, there is nothing left to read.
+  if (!header_)
+    return 0;
+  uint32_t write_position = LoadPosition(&header_->write_position);
+  if (write_position >= 2 * capacity_num_bytes() ||
+      Distance(read_position_, write_position) > capacity_num_bytes()) {
+    LOG(ERROR) << "Invalid data pipe write position";
+    return 0;
+  }
+  return Distance(read_position_, write_position);
+}
+
+size_t SharedMemoryDataPipe::PositionToIndex(uint32_t position) const {
+  DCHECK_LT(position, 2 * capacity_num_bytes());
+  return position < capacity_num_bytes() ? position :
+                                           position - capacity_num_bytes();
+}
+
+uint32_t SharedMemoryDataPipe::AdvancePosition(uint32_t position,
+                                               size_t num_bytes) const {
+  DCHECK_LE(num_bytes, capacity_num_bytes());
+  return static_cast<uint32_t>((position + num_bytes) %
+                               (2 * capacity_num_bytes()));
+}
+
+size_t SharedMemoryDataPipe::Distance(uint32_t start,
+                                      uint32_t position) const {
+  return (position + 2 * capacity_num_bytes() - start) %
+         (2 * capacity_num_bytes());
+}
+
+void SharedMemoryDataPipe::MarkDataAsWrittenNoLock(size_t num_bytes) {
+  DCHECK_LE(GetNumBytesStoredForProducerNoLock() + num_bytes,
+            capacity_num_bytes());
+  write_position_ = AdvancePosition(write_position_, num_bytes);
+  // Publish the data only after it has been copied into the buffer.
+  StorePosition(&header_->write_position, write_position_);
+}
+
+void SharedMemoryDataPipe::MarkDataAsConsumedNoLock(size_t num_bytes) {
+  DCHECK_LE(num_bytes, GetNumBytesStoredForConsumerNoLock());
+  read_position_ = AdvancePosition(read_position_, num_bytes);
+  // Release the space only after the data has been copied out of the buffer.
+  StorePosition(&header_->read_position, read_position_);
+}
+
+}  // namespace system
+}  // namespace mojo
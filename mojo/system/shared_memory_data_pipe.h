@@ -0,0 +1,113 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MOJO_SYSTEM_SHARED_MEMORY_DATA_PIPE_H_
+#define MOJO_SYSTEM_SHARED_MEMORY_DATA_PIPE_H_
+
+#include "base/basictypes.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/shared_memory.h"
+#include "mojo/system/data_pipe.h"
+#include "mojo/system/system_impl_export.h"
+
+namespace mojo {
+namespace system {
+
+// |SharedMemoryDataPipe| is a subclass that "implements" |DataPipe| with its
+// circular buffer in shared memory, so that two-phase reads and writes operate
+// directly on memory which can be mapped by another process. Unlike
+// |LocalDataPipe|, all of its state which the other side needs lives in the
+// shared memory: the producer and the consumer each advance only their own
+// position there, keep their own copy of it, and validate the position of the
+// other side on every use. (So the producer cannot discard data, i.e.,
+// "may discard" mode isn't supported.) This class is thread-safe (with
+// protection provided by |DataPipe|'s |lock_|).
+//
+// TODO(vtl): Both the producer and the consumer are currently local, since
+// dispatchers can't be sent over remote message pipes yet. Once they can, the
+// producer and consumer dispatchers should be serialized by sending the shared
+// memory handle over the |Channel| instead of proxying the data through
+// |MessageInTransit|s.
+class MOJO_SYSTEM_IMPL_EXPORT SharedMemoryDataPipe : public DataPipe {
+ public:
+  // |validated_options| should be the output of |DataPipe::ValidateOptions()|
+  // and must not have |MOJO_CREATE_DATA_PIPE_OPTIONS_FLAG_MAY_DISCARD| set.
+  explicit SharedMemoryDataPipe(
+      const MojoCreateDataPipeOptions& validated_options);
+
+  // This must be called before any other methods. Returns false if the shared
+  // memory could not be created.
+  bool Init();
+
+ private:
+  friend class base::RefCountedThreadSafe<SharedMemoryDataPipe>;
+  virtual ~SharedMemoryDataPipe();
+
+  struct Header;
+
+  // |DataPipe| implementation:
+  virtual void ProducerCloseImplNoLock() OVERRIDE;
+  virtual MojoResult ProducerWriteDataImplNoLock(const void* elements,
+                                                 uint32_t* num_bytes,
+                                                 bool all_or_none) OVERRIDE;
+  virtual MojoResult ProducerBeginWriteDataImplNoLock(
+      void** buffer,
+      uint32_t* buffer_num_bytes,
+      bool all_or_none) OVERRIDE;
+  virtual MojoResult ProducerEndWriteDataImplNoLock(
+      uint32_t num_bytes_written) OVERRIDE;
+  virtual MojoWaitFlags ProducerSatisfiedFlagsNoLock() OVERRIDE;
+  virtual MojoWaitFlags ProducerSatisfiableFlagsNoLock() OVERRIDE;
+  virtual void ConsumerCloseImplNoLock() OVERRIDE;
+  virtual MojoResult ConsumerReadDataImplNoLock(void* elements,
+                                                uint32_t* num_bytes,
+                                                bool all_or_none) OVERRIDE;
+  virtual MojoResult ConsumerDiscardDataImplNoLock(uint32_t* num_bytes,
+                                                   bool all_or_none) OVERRIDE;
+  virtual MojoResult ConsumerQueryDataImplNoLock(uint32_t* num_bytes) OVERRIDE;
+  virtual MojoResult ConsumerBeginReadDataImplNoLock(const void** buffer,
+                                                     uint32_t* buffer_num_bytes,
+                                                     bool all_or_none) OVERRIDE;
+  virtual MojoResult ConsumerEndReadDataImplNoLock(
+      uint32_t num_bytes_read) OVERRIDE;
+  virtual MojoWaitFlags ConsumerSatisfiedFlagsNoLock() OVERRIDE;
+  virtual MojoWaitFlags ConsumerSatisfiableFlagsNoLock() OVERRIDE;
+
+  void DestroyBufferNoLock();
+
+  // Get the number of bytes in the buffer, as seen by the producer and the
+  // consumer, respectively. If the other side published an invalid position,
+  // the buffer is treated as full and empty, respectively.
+  size_t GetNumBytesStoredForProducerNoLock() const;
+  size_t GetNumBytesStoredForConsumerNoLock() const;
+
+  // Positions run from 0 to |2 * capacity_num_bytes()| (exclusive), which
+  // distinguishes a full buffer from an empty one.
+  size_t PositionToIndex(uint32_t position) const;
+  uint32_t AdvancePosition(uint32_t position, size_t num_bytes) const;
+  // Returns |position| minus |start| (modulo the range of positions).
+  size_t Distance(uint32_t start, uint32_t position) const;
+
+  // Marks the given number of bytes as written/consumed.
+  void MarkDataAsWrittenNoLock(size_t num_bytes);
+  void MarkDataAsConsumedNoLock(size_t num_bytes);
+
+  // The members below are protected by |DataPipe|'s |lock_|:
+  scoped_ptr<base::SharedMemory> shared_memory_;
+  Header* header_;
+  char* buffer_;
+  // The positions of the producer and the consumer. Only the producer's side
+  // writes |write_position_| and only the consumer's side |read_position_|;
+  // the copies in |header_| are only published for the other side.
+  uint32_t write_position_;
+  uint32_t read_position_;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedMemoryDataPipe);
+};
+
+}  // namespace system
+}  // namespace mojo
+
+#endif  // MOJO_SYSTEM_SHARED_MEMORY_DATA_PIPE_H_
@@ -0,0 +1,185 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "mojo/system/shared_memory_data_pipe.h"
+
+#include <string.h>
+
+#include "base/basictypes.h"
+#include "base/memory/ref_counted.h"
+#include "mojo/system/data_pipe.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace mojo {
+namespace system {
+namespace {
+
+const uint32_t kSizeOfOptions =
+    static_cast<uint32_t>(sizeof(MojoCreateDataPipeOptions));
+
+scoped_refptr<SharedMemoryDataPipe> CreateDataPipe(
+    uint32_t element_num_bytes,
+    uint32_t capacity_num_bytes) {
+  const MojoCreateDataPipeOptions options = {
+    kSizeOfOptions,  // |struct_size|.
+    MOJO_CREATE_DATA_PIPE_OPTIONS_FLAG_NONE,  // |flags|.
+    element_num_bytes,  // |element_num_bytes|.
+    capacity_num_bytes  // |capacity_num_bytes|.
+  };
+  MojoCreateDataPipeOptions validated_options = { 0 };
+  EXPECT_EQ(MOJO_RESULT_OK,
+            DataPipe::ValidateOptions(&options, &validated_options));
+  scoped_refptr<SharedMemoryDataPipe> dp(
+      new SharedMemoryDataPipe(validated_options));
+  EXPECT_TRUE(dp->Init());
+  return dp;
+}
+
+TEST(SharedMemoryDataPipeTest, SimpleReadWrite) {
+  scoped_refptr<SharedMemoryDataPipe> dp(
+      CreateDataPipe(static_cast<uint32_t>(sizeof(int32_t)),
+                     10 * sizeof(int32_t)));
+
+  int32_t elements[12] = { 0 };
+  uint32_t num_bytes = static_cast<uint32_t>(sizeof(elements));
+
+  // Try reading; nothing there yet.
+  EXPECT_EQ(MOJO_RESULT_SHOULD_WAIT,
+            dp->ConsumerReadData(elements, &num_bytes, false));
+
+  // Write more than fits; only the capacity is written.
+  for (size_t i = 0; i < arraysize(elements); i++)
+    elements[i] = static_cast<int32_t>(i);
+  num_bytes = static_cast<uint32_t>(sizeof(elements));
+  EXPECT_EQ(MOJO_RESULT_OK, dp->ProducerWriteData(elements, &num_bytes, false));
+  EXPECT_EQ(10u * sizeof(int32_t), num_bytes);
+  num_bytes = static_cast<uint32_t>(sizeof(elements[0]));
+  EXPECT_EQ(MOJO_RESULT_SHOULD_WAIT,
+            dp->ProducerWriteData(elements, &num_bytes, false));
+
+  // Read some, then write across the end of the buffer.
+  int32_t read_elements[12] = { 0 };
+  num_bytes = 6u * sizeof(int32_t);
+  EXPECT_EQ(MOJO_RESULT_OK,
+            dp->ConsumerReadData(read_elements, &num_bytes, true));
+  EXPECT_EQ(6u * sizeof(int32_t), num_bytes);
+  for (size_t i = 0; i < 6; i++)
+    EXPECT_EQ(static_cast<int32_t>(i), read_elements[i]);
+
+  num_bytes = 7u * sizeof(int32_t);
+  EXPECT_EQ(MOJO_RESULT_OUT_OF_RANGE,
+            dp->ProducerWriteData(elements, &num_bytes, true));
+  num_bytes = 6u * sizeof(int32_t);
+  EXPECT_EQ(MOJO_RESULT_OK, dp->ProducerWriteData(elements, &num_bytes, true));
+
+  num_bytes = 0;
+  EXPECT_EQ(MOJO_RESULT_OK, dp->ConsumerQueryData(&num_bytes));
+  EXPECT_EQ(10u * sizeof(int32_t), num_bytes);
+
+  memset(read_elements, 0, sizeof(read_elements));
+  num_bytes = static_cast<uint32_t>(sizeof(read_elements));
+  EXPECT_EQ(MOJO_RESULT_OK,
+            dp->ConsumerReadData(read_elements, &num_bytes, false));
+  EXPECT_EQ(10u * sizeof(int32_t), num_bytes);
+  for (size_t i = 0; i < 4; i++)
+    EXPECT_EQ(static_cast<int32_t>(6 + i), read_elements[i]);
+  for (size_t i = 4; i < 10; i++)
+    EXPECT_EQ(static_cast<int32_t>(i - 4), read_elements[i]);
+
+  dp->ProducerClose();
+  dp->ConsumerClose();
+}
+
+TEST(SharedMemoryDataPipeTest, TwoPhaseWriteRead) {
+  scoped_refptr<SharedMemoryDataPipe> dp(CreateDataPipe(1, 100));
+
+  // The two-phase buffer ends at the end of the shared buffer.
+  void* write_ptr = NULL;
+  uint32_t num_bytes = 0;
+  EXPECT_EQ(MOJO_RESULT_OK,
+            dp->ProducerBeginWriteData(&write_ptr, &num_bytes, false));
+  EXPECT_EQ(100u, num_bytes);
+  memset(write_ptr, 'a', 80);
+  EXPECT_EQ(MOJO_RESULT_OK, dp->ProducerEndWriteData(80));
+
+  const void* read_ptr = NULL;
+  num_bytes = 0;
+  EXPECT_EQ(MOJO_RESULT_OK,
+            dp->ConsumerBeginReadData(&read_ptr, &num_bytes, false));
+  EXPECT_EQ(80u, num_bytes);
+  // The consumer reads the memory the producer wrote to.
+  EXPECT_EQ(write_ptr, read_ptr);
+  EXPECT_EQ(MOJO_RESULT_OK, dp->ConsumerEndReadData(50));
+
+  // Only the rest of the buffer is available to the next two-phase write.
+  num_bytes = 30;
+  EXPECT_EQ(MOJO_RESULT_OUT_OF_RANGE,
+            dp->ProducerBeginWriteData(&write_ptr, &num_bytes, true));
+  num_bytes = 0;
+  EXPECT_EQ(MOJO_RESULT_OK,
+            dp->ProducerBeginWriteData(&write_ptr, &num_bytes, false));
+  EXPECT_EQ(20u, num_bytes);
+  memset(write_ptr, 'b', 20);
+  EXPECT_EQ(MOJO_RESULT_OK, dp->ProducerEndWriteData(20));
+  num_bytes = 0;
+  EXPECT_EQ(MOJO_RESULT_OK,
+            dp->ProducerBeginWriteData(&write_ptr, &num_bytes, false));
+  EXPECT_EQ(50u, num_bytes);
+  EXPECT_EQ(MOJO_RESULT_OK, dp->ProducerEndWriteData(0));
+
+  // Discard the remaining 'a's; the 'b's follow.
+  num_bytes = 30;
+  EXPECT_EQ(MOJO_RESULT_OK, dp->ConsumerDiscardData(&num_bytes, true));
+  char buffer[20] = { 0 };
+  num_bytes = static_cast<uint32_t>(sizeof(buffer));
+  EXPECT_EQ(MOJO_RESULT_OK, dp->ConsumerReadData(buffer, &num_bytes, true));
+  for (size_t i = 0; i < sizeof(buffer); i++)
+    EXPECT_EQ('b', buffer[i]);
+
+  dp->ProducerClose();
+  dp->ConsumerClose();
+}
+
+TEST(SharedMemoryDataPipeTest, CloseProducerWithData) {
+  scoped_refptr<SharedMemoryDataPipe> dp(CreateDataPipe(1, 10));
+
+  uint32_t num_bytes = 3;
+  EXPECT_EQ(MOJO_RESULT_OK, dp->ProducerWriteData("abc", &num_bytes, true));
+  dp->ProducerClose();
+
+  // The data is still readable after the producer is gone.
+  char buffer[10] = { 0 };
+  num_bytes = static_cast<uint32_t>(sizeof(buffer));
+  EXPECT_EQ(MOJO_RESULT_OK, dp->ConsumerReadData(buffer, &num_bytes, false));
+  EXPECT_EQ(3u, num_bytes);
+  EXPECT_EQ(0, memcmp(buffer, "abc", 3));
+  num_bytes = static_cast<uint32_t>(sizeof(buffer));
+  EXPECT_EQ(MOJO_RESULT_FAILED_PRECONDITION,
+            dp->ConsumerReadData(buffer, &num_bytes, false));
+
+  dp->ConsumerClose();
+}
+
+TEST(SharedMemoryDataPipeTest, CloseConsumerDuringTwoPhaseWrite) {
+  scoped_refptr<SharedMemoryDataPipe> dp(CreateDataPipe(1, 10));
+
+  void* write_ptr = NULL;
+  uint32_t num_bytes = 0;
+  EXPECT_EQ(MOJO_RESULT_OK,
+            dp->ProducerBeginWriteData(&write_ptr, &num_bytes, false));
+  dp->ConsumerClose();
+
+  // The buffer stays mapped until the two-phase write ends.
+  memset(write_ptr, 'a', num_bytes);
+  EXPECT_EQ(MOJO_RESULT_OK, dp->ProducerEndWriteData(num_bytes));
+  num_bytes = 1;
+  EXPECT_EQ(MOJO_RESULT_FAILED_PRECONDITION,
+            dp->ProducerWriteData("a", &num_bytes, false));
+
+  dp->ProducerClose();
+}
+
+}  // namespace
+}  // namespace system
+}  // namespace mojo
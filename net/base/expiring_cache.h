@@ -136,6 +136,20 @@ class ExpiringCache {
     return &it->second.first;
   }
 
+  // Returns the value matching |key| even if it has expired, and stores when
+  // it expires in |*expiration|. Returns NULL if the item is not found.
+  // Note: The returned pointer remains owned by the ExpiringCache and is
+  // invalidated by a call to a non-const method.
+  const ValueType* GetIgnoringExpiration(const KeyType& key,
+                                         ExpirationType* expiration) const {
+    typename EntryMap::const_iterator it = entries_.find(key);
+    if (it == entries_.end())
+      return NULL;
+
+    *expiration = it->second.second;
+    return &it->second.first;
+  }
+
   // Updates or replaces the value associated with |key|.
   void Put(const KeyType& key,
            const ValueType& value,
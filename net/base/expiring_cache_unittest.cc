@@ -254,6 +254,30 @@ TEST(ExpiringCacheTest, GetTruncatesExpiredEntries) {
   EXPECT_EQ(6U, cache.size());
 }
 
+TEST(ExpiringCacheTest, GetIgnoringExpirationKeepsExpiredEntries) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(10);
+
+  Cache cache(kMaxCacheEntries);
+
+  // Start at t=0.
+  base::TimeTicks now;
+  base::TimeTicks expiration;
+  EXPECT_FALSE(cache.GetIgnoringExpiration("test1", &expiration));
+
+  cache.Put("test1", "foo1", now, now + kTTL);
+
+  // Advance past the expiration; the entry is still returned.
+  now += kTTL + kTTL;
+  EXPECT_THAT(cache.GetIgnoringExpiration("test1", &expiration),
+              Pointee(StrEq("foo1")));
+  EXPECT_EQ(kTTL, expiration - base::TimeTicks());
+  EXPECT_EQ(1U, cache.size());
+
+  // A regular Get still evicts it.
+  EXPECT_FALSE(cache.Get("test1", now));
+  EXPECT_EQ(0U, cache.size());
+}
+
 TEST(ExpiringCacheTest, CustomFunctor) {
   ExpiringCache<std::string, std::string, std::string, TestFunctor> cache(5);
 
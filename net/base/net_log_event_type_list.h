@@ -102,6 +102,11 @@ EVENT_TYPE(HOST_RESOLVER_IMPL_JOB)
 // Jobs was reached.
 EVENT_TYPE(HOST_RESOLVER_IMPL_JOB_EVICTED)
 
+// This event is created when the Requests of a HostResolverImpl::Job are
+// served a stale cache entry because the Job took too long. The Job keeps
+// running to refresh the cache.
+EVENT_TYPE(HOST_RESOLVER_IMPL_JOB_SERVED_STALE)
+
 // This event is created when a HostResolverImpl::Job is started by
 // PriorityDispatch.
 EVENT_TYPE(HOST_RESOLVER_IMPL_JOB_STARTED)
@@ -683,6 +688,22 @@ EVENT_TYPE(SOCKET_POOL_STALLED_MAX_SOCKETS_PER_GROUP)
 //   }
 EVENT_TYPE(SOCKET_POOL_REUSED_AN_EXISTING_SOCKET)
 
+// Indicates that we were handed a socket which had been connected with no
+// request waiting for it, normally by a preconnect, and had never been used.
+// Attached to the event are the parameters:
+//   {
+//     "idle_ms": <The number of milliseconds the socket was sitting idle for>,
+//   }
+EVENT_TYPE(SOCKET_POOL_PRECONNECT_HIT)
+
+// Logged on a socket which was connected with no request waiting for it,
+// normally by a preconnect, when the pool closes it without it ever having
+// been used. Attached to the event are the parameters:
+//   {
+//     "idle_ms": <The number of milliseconds the socket was sitting idle for>,
+//   }
+EVENT_TYPE(SOCKET_POOL_PRECONNECT_WASTED)
+
 // This event simply describes the host:port that were requested from the
 // socket pool. Its parameters are:
 //   {
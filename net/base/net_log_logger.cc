@@ -23,7 +23,11 @@ namespace net {
 static const int kLogFormatVersion = 1;
 
 NetLogLogger::NetLogLogger(FILE* file, const base::Value& constants)
-    : file_(file), added_events_(false) {
+    : file_(file),
+      added_events_(false),
+      bytes_written_(0),
+      max_file_size_(-1),
+      dropped_events_(0) {
   DCHECK(file);
 
   // Write constants to the output file.  This allows loading files that have
@@ -31,8 +35,9 @@ NetLogLogger::NetLogLogger(FILE* file, const base::Value& constants)
   // between Chrome versions.
   std::string json;
   base::JSONWriter::Write(&constants, &json);
-  fprintf(file_.get(), "{\"constants\": %s,\n", json.c_str());
-  fprintf(file_.get(), "\"events\": [\n");
+  bytes_written_ +=
+      fprintf(file_.get(), "{\"constants\": %s,\n", json.c_str());
+  bytes_written_ += fprintf(file_.get(), "\"events\": [\n");
 }
 
 NetLogLogger::~NetLogLogger() {
@@ -52,12 +57,16 @@ void NetLogLogger::OnAddEntry(const net::NetLog::Entry& entry) {
   // Add a comma and newline for every event but the first.  Newlines are needed
   // so can load partial log files by just ignoring the last line.  For this to
   // work, lines cannot be pretty printed.
+  if (max_file_size_ >= 0 && bytes_written_ >= max_file_size_) {
+    ++dropped_events_;
+    return;
+  }
   scoped_ptr<base::Value> value(entry.ToValue());
   std::string json;
   base::JSONWriter::Write(value.get(), &json);
-  fprintf(file_.get(), "%s%s",
-          (added_events_ ? ",\n" : ""),
-          json.c_str());
+  bytes_written_ += fprintf(file_.get(), "%s%s",
+                            (added_events_ ? ",\n" : ""),
+                            json.c_str());
   added_events_ = true;
 }
 
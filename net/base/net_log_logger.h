@@ -36,6 +36,17 @@ class NET_EXPORT NetLogLogger : public NetLog::ThreadSafeObserver {
   // Stops observing net_log().  Must already be watching.
   void StopObserving();
 
+  // Stops logging events once |max_file_size| bytes have been written, so
+  // that long captures keep a bounded file.  Events past the cap are dropped
+  // before they are serialized.  The file is still valid JSON.  By default
+  // there is no cap.
+  void set_max_file_size(int64 max_file_size) {
+    max_file_size_ = max_file_size;
+  }
+
+  // Number of events dropped because the file reached |max_file_size_|.
+  int dropped_events() const { return dropped_events_; }
+
   // net::NetLog::ThreadSafeObserver implementation:
   virtual void OnAddEntry(const NetLog::Entry& entry) OVERRIDE;
 
@@ -49,6 +60,13 @@ class NET_EXPORT NetLogLogger : public NetLog::ThreadSafeObserver {
   // True if OnAddEntry() has been called at least once.
   bool added_events_;
 
+  // Bytes written to |file_| so far, and the maximum to write, or -1 for no
+  // maximum.  OnAddEntry() is called with the NetLog's lock held, so these
+  // need no locking of their own.
+  int64 bytes_written_;
+  int64 max_file_size_;
+  int dropped_events_;
+
   DISALLOW_COPY_AND_ASSIGN(NetLogLogger);
 };
 
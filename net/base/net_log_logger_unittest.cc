@@ -115,4 +115,40 @@ TEST_F(NetLogLoggerTest, GeneratesValidJSONWithMultipleEvents) {
   ASSERT_EQ(2u, events->GetSize());
 }
 
+TEST_F(NetLogLoggerTest, DropsEventsPastMaxFileSize) {
+  {
+    FILE* file = base::OpenFile(log_path_, "w");
+    ASSERT_TRUE(file);
+    scoped_ptr<base::Value> constants(NetLogLogger::GetConstants());
+    NetLogLogger logger(file, *constants);
+    // The constants alone are larger than this, so every event is dropped.
+    logger.set_max_file_size(1);
+
+    const int kDummyId = 1;
+    NetLog::Source source(NetLog::SOURCE_SPDY_SESSION, kDummyId);
+    NetLog::Entry entry(NetLog::TYPE_PROXY_SERVICE,
+                        source,
+                        NetLog::PHASE_BEGIN,
+                        base::TimeTicks::Now(),
+                        NULL,
+                        NetLog::LOG_BASIC);
+    logger.OnAddEntry(entry);
+    logger.OnAddEntry(entry);
+    EXPECT_EQ(2, logger.dropped_events());
+  }
+
+  std::string input;
+  ASSERT_TRUE(base::ReadFileToString(log_path_, &input));
+
+  base::JSONReader reader;
+  scoped_ptr<base::Value> root(reader.ReadToValue(input));
+  ASSERT_TRUE(root) << reader.GetErrorMessage();
+
+  base::DictionaryValue* dict;
+  ASSERT_TRUE(root->GetAsDictionary(&dict));
+  base::ListValue* events;
+  ASSERT_TRUE(dict->GetList("events", &events));
+  ASSERT_EQ(0u, events->GetSize());
+}
+
 }  // namespace net
@@ -275,6 +275,10 @@ int CertVerifyProc::Verify(X509Certificate* cert,
   return rv;
 }
 
+bool CertVerifyProc::VerifiesChainIndependentlyOfHostname() const {
+  return true;
+}
+
 // static
 bool CertVerifyProc::IsBlacklisted(X509Certificate* cert) {
   static const unsigned kComodoSerialBytes = 16;
@@ -66,6 +66,13 @@ class NET_EXPORT CertVerifyProc
   // passed to Verify() is ignored when this returns false.
   virtual bool SupportsAdditionalTrustAnchors() const = 0;
 
+  // Returns true if Verify() only uses |hostname| to match it against the
+  // names of the certificate and to flag non-unique names, so that the chain
+  // verified for one hostname may be reused for another hostname the
+  // certificate is valid for. Implementations which let the platform apply
+  // host specific policies return false.
+  virtual bool VerifiesChainIndependentlyOfHostname() const;
+
  protected:
   CertVerifyProc();
   virtual ~CertVerifyProc();
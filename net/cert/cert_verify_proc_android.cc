@@ -122,6 +122,11 @@ bool CertVerifyProcAndroid::SupportsAdditionalTrustAnchors() const {
   return false;
 }
 
+bool CertVerifyProcAndroid::VerifiesChainIndependentlyOfHostname() const {
+  // The hostname is passed to the platform X509TrustManager.
+  return false;
+}
+
 int CertVerifyProcAndroid::VerifyInternal(
     X509Certificate* cert,
     const std::string& hostname,
@@ -16,6 +16,7 @@ class CertVerifyProcAndroid : public CertVerifyProc {
   CertVerifyProcAndroid();
 
   virtual bool SupportsAdditionalTrustAnchors() const OVERRIDE;
+  virtual bool VerifiesChainIndependentlyOfHostname() const OVERRIDE;
 
  protected:
   virtual ~CertVerifyProcAndroid();
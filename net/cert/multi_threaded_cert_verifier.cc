@@ -17,6 +17,8 @@
 #include "base/time/time.h"
 #include "net/base/net_errors.h"
 #include "net/base/net_log.h"
+#include "net/base/net_util.h"
+#include "net/cert/cert_status_flags.h"
 #include "net/cert/cert_trust_anchor_provider.h"
 #include "net/cert/cert_verify_proc.h"
 #include "net/cert/crl_set.h"
@@ -68,7 +70,8 @@ namespace net {
 //
 //
 // On a cache hit, MultiThreadedCertVerifier::Verify() returns synchronously
-// without posting a task to a worker thread.
+// without posting a task to a worker thread. This includes hits in the chain
+// cache, which only cost a match of the hostname against the certificate.
 
 namespace {
 
@@ -134,13 +137,20 @@ bool MultiThreadedCertVerifier::CacheExpirationFunctor::operator()(
 
 
 // Represents the output and result callback of a request.
+// |common_name_fallback_used| is the outcome of matching |hostname| against
+// the certificate; it is only used when the request joins a job verifying the
+// same chain for another hostname.
 class CertVerifierRequest {
  public:
   CertVerifierRequest(const CompletionCallback& callback,
                       CertVerifyResult* verify_result,
+                      const std::string& hostname,
+                      bool common_name_fallback_used,
                       const BoundNetLog& net_log)
       : callback_(callback),
         verify_result_(verify_result),
+        hostname_(hostname),
+        common_name_fallback_used_(common_name_fallback_used),
         net_log_(net_log) {
     net_log_.BeginEvent(NetLog::TYPE_CERT_VERIFIER_REQUEST);
   }
@@ -169,11 +179,19 @@ class CertVerifierRequest {
 
   bool canceled() const { return callback_.is_null(); }
 
+  const std::string& hostname() const { return hostname_; }
+
+  bool common_name_fallback_used() const {
+    return common_name_fallback_used_;
+  }
+
   const BoundNetLog& net_log() const { return net_log_; }
 
  private:
   CompletionCallback callback_;
   CertVerifyResult* verify_result_;
+  const std::string hostname_;
+  const bool common_name_fallback_used_;
   const BoundNetLog net_log_;
 };
 
@@ -206,6 +224,8 @@ class CertVerifierWorker {
   // Start() is called.
   X509Certificate* certificate() const { return cert_.get(); }
 
+  const std::string& hostname() const { return hostname_; }
+
   bool Start() {
     DCHECK_EQ(base::MessageLoop::current(), origin_loop_);
 
@@ -322,6 +342,7 @@ class CertVerifierJob {
   CertVerifierJob(CertVerifierWorker* worker,
                   const BoundNetLog& net_log)
       : start_time_(base::TimeTicks::Now()),
+        hostname_(worker->hostname()),
         worker_(worker),
         net_log_(net_log) {
     net_log_.BeginEvent(
@@ -366,7 +387,18 @@ class CertVerifierJob {
 
     for (std::vector<CertVerifierRequest*>::iterator
          i = requests.begin(); i != requests.end(); i++) {
-      (*i)->Post(verify_result);
+      if ((*i)->hostname() == hostname_) {
+        (*i)->Post(verify_result);
+      } else {
+        // The request joined the verification of the same chain for another
+        // hostname. Both hostnames matched the certificate, so only the
+        // hostname specific bits of the result differ. Should the platform
+        // have disagreed about the name match, the result stays an error.
+        MultiThreadedCertVerifier::CachedResult result = verify_result;
+        MultiThreadedCertVerifier::AdaptResultToHostname(
+            (*i)->hostname(), (*i)->common_name_fallback_used(), &result);
+        (*i)->Post(result);
+      }
       // Post() causes the CertVerifierRequest to delete itself.
     }
   }
@@ -383,6 +415,7 @@ class CertVerifierJob {
   }
 
   const base::TimeTicks start_time_;
+  const std::string hostname_;
   std::vector<CertVerifierRequest*> requests_;
   CertVerifierWorker* worker_;
   const BoundNetLog net_log_;
@@ -391,9 +424,12 @@ class CertVerifierJob {
 MultiThreadedCertVerifier::MultiThreadedCertVerifier(
     CertVerifyProc* verify_proc)
     : cache_(kMaxCacheEntries),
+      chain_cache_(kMaxCacheEntries),
       requests_(0),
       cache_hits_(0),
+      chain_cache_hits_(0),
       inflight_joins_(0),
+      chain_inflight_joins_(0),
       verify_proc_(verify_proc),
       trust_anchor_provider_(NULL) {
   CertDatabase::GetInstance()->AddObserver(this);
@@ -444,7 +480,12 @@ int MultiThreadedCertVerifier::Verify(X509Certificate* cert,
   }
 
   // No cache hit. See if an identical request is currently in flight.
-  CertVerifierJob* job;
+  CertVerifierJob* job = NULL;
+  bool common_name_fallback_used = false;
+  bool chain_reusable = false;
+  const RequestParams chain_key(cert->fingerprint(), cert->ca_fingerprint(),
+                                std::string(), flags,
+                                additional_trust_anchors);
   std::map<RequestParams, CertVerifierJob*>::const_iterator j;
   j = inflight_.find(key);
   if (j != inflight_.end()) {
@@ -453,6 +494,35 @@ int MultiThreadedCertVerifier::Verify(X509Certificate* cert,
     inflight_joins_++;
     job = j->second;
   } else {
+    // The chain may have been verified for another hostname already. Its
+    // result can be reused if |hostname| matches the certificate too; for
+    // mismatching names the full verification sets the error status.
+    chain_reusable = verify_proc_->VerifiesChainIndependentlyOfHostname() &&
+                     cert->VerifyNameMatch(hostname,
+                                           &common_name_fallback_used);
+  }
+
+  if (chain_reusable) {
+    const CertVerifierCache::value_type* chain_entry =
+        chain_cache_.Get(chain_key, CacheValidityPeriod(base::Time::Now()));
+    j = chain_inflight_.find(chain_key);
+    UMA_HISTOGRAM_BOOLEAN("Net.CertVerifier_ChainReused",
+                          chain_entry || j != chain_inflight_.end());
+    if (chain_entry) {
+      ++chain_cache_hits_;
+      CachedResult result = *chain_entry;
+      AdaptResultToHostname(hostname, common_name_fallback_used, &result);
+      *out_req = NULL;
+      *verify_result = result.result;
+      return result.error;
+    }
+    if (j != chain_inflight_.end()) {
+      chain_inflight_joins_++;
+      job = j->second;
+    }
+  }
+
+  if (!job) {
     // Need to make a new request.
     CertVerifierWorker* worker =
         new CertVerifierWorker(verify_proc_.get(),
@@ -474,10 +544,13 @@ int MultiThreadedCertVerifier::Verify(X509Certificate* cert,
       return ERR_INSUFFICIENT_RESOURCES;  // Just a guess.
     }
     inflight_.insert(std::make_pair(key, job));
+    if (chain_reusable)
+      chain_inflight_.insert(std::make_pair(chain_key, job));
   }
 
   CertVerifierRequest* request =
-      new CertVerifierRequest(callback, verify_result, net_log);
+      new CertVerifierRequest(callback, verify_result, hostname,
+                              common_name_fallback_used, net_log);
   job->AddRequest(request);
   *out_req = request;
   return ERR_IO_PENDING;
@@ -521,6 +594,19 @@ bool MultiThreadedCertVerifier::RequestParams::operator<(
       net::SHA1HashValueLessThan());
 }
 
+// static
+void MultiThreadedCertVerifier::AdaptResultToHostname(
+    const std::string& hostname,
+    bool common_name_fallback_used,
+    CachedResult* result) {
+  // Mirrors the hostname dependent parts of CertVerifyProc::Verify().
+  CertVerifyResult* verify_result = &result->result;
+  verify_result->common_name_fallback_used = common_name_fallback_used;
+  verify_result->cert_status &= ~CERT_STATUS_NON_UNIQUE_NAME;
+  if (verify_result->is_issued_by_known_root && IsHostnameNonUnique(hostname))
+    verify_result->cert_status |= CERT_STATUS_NON_UNIQUE_NAME;
+}
+
 // HandleResult is called by CertVerifierWorker on the origin message loop.
 // It deletes CertVerifierJob.
 void MultiThreadedCertVerifier::HandleResult(
@@ -552,6 +638,21 @@ void MultiThreadedCertVerifier::HandleResult(
   CertVerifierJob* job = j->second;
   inflight_.erase(j);
 
+  const RequestParams chain_key(cert->fingerprint(), cert->ca_fingerprint(),
+                                std::string(), flags,
+                                additional_trust_anchors);
+  j = chain_inflight_.find(chain_key);
+  if (j != chain_inflight_.end() && j->second == job) {
+    chain_inflight_.erase(j);
+    // |hostname| matched the certificate when the job was started, so the
+    // result only describes the chain unless the platform disagreed.
+    if (!(verify_result.cert_status & CERT_STATUS_COMMON_NAME_INVALID)) {
+      chain_cache_.Put(chain_key, cached_result, CacheValidityPeriod(now),
+                       CacheValidityPeriod(
+                           now, now + base::TimeDelta::FromSeconds(kTTLSecs)));
+    }
+  }
+
   job->HandleResult(cached_result);
   delete job;
 }
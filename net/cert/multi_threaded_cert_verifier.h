@@ -32,6 +32,11 @@ class CertVerifyProc;
 
 // MultiThreadedCertVerifier is a CertVerifier implementation that runs
 // synchronous CertVerifier implementations on worker threads.
+//
+// Results are cached per certificate chain and hostname. Since servers which
+// shard their content across many hostnames usually present the same chain
+// for all of them, results are also cached per chain when the CertVerifyProc
+// allows it, so that only the name matching is repeated for each hostname.
 class NET_EXPORT_PRIVATE MultiThreadedCertVerifier
     : public CertVerifier,
       NON_EXPORTED_BASE(public base::NonThreadSafe),
@@ -78,6 +83,8 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier
                            RequestParamsComparators);
   FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest,
                            CertTrustAnchorProvider);
+  FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest, ChainCacheHit);
+  FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest, ChainInflightJoin);
 
   // Input parameters of a certificate verification request.
   struct NET_EXPORT_PRIVATE RequestParams {
@@ -129,6 +136,13 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier
   typedef ExpiringCache<RequestParams, CachedResult, CacheValidityPeriod,
                         CacheExpirationFunctor> CertVerifierCache;
 
+  // Adjusts |result|, which was verified for a different hostname with the
+  // same chain, to |hostname|. |common_name_fallback_used| is the outcome of
+  // matching |hostname| against the certificate.
+  static void AdaptResultToHostname(const std::string& hostname,
+                                    bool common_name_fallback_used,
+                                    CachedResult* result);
+
   void HandleResult(X509Certificate* cert,
                     const std::string& hostname,
                     int flags,
@@ -140,22 +154,39 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier
   virtual void OnCACertChanged(const X509Certificate* cert) OVERRIDE;
 
   // For unit testing.
-  void ClearCache() { cache_.Clear(); }
+  void ClearCache() {
+    cache_.Clear();
+    chain_cache_.Clear();
+  }
   size_t GetCacheSize() const { return cache_.size(); }
+  size_t GetChainCacheSize() const { return chain_cache_.size(); }
   uint64 cache_hits() const { return cache_hits_; }
+  uint64 chain_cache_hits() const { return chain_cache_hits_; }
   uint64 requests() const { return requests_; }
   uint64 inflight_joins() const { return inflight_joins_; }
+  uint64 chain_inflight_joins() const { return chain_inflight_joins_; }
 
   // cache_ maps from a request to a cached result.
   CertVerifierCache cache_;
 
+  // chain_cache_ maps from a request with an empty hostname to the result of
+  // verifying the chain for a hostname the certificate is valid for.
+  CertVerifierCache chain_cache_;
+
   // inflight_ maps from a request to an active verification which is taking
   // place.
   std::map<RequestParams, CertVerifierJob*> inflight_;
 
+  // chain_inflight_ maps from a request with an empty hostname to an active
+  // verification for a hostname the certificate is valid for. The jobs are
+  // owned by |inflight_|.
+  std::map<RequestParams, CertVerifierJob*> chain_inflight_;
+
   uint64 requests_;
   uint64 cache_hits_;
+  uint64 chain_cache_hits_;
   uint64 inflight_joins_;
+  uint64 chain_inflight_joins_;
 
   scoped_refptr<CertVerifyProc> verify_proc_;
 
@@ -17,6 +17,7 @@
 #include "net/cert/cert_verify_result.h"
 #include "net/cert/x509_certificate.h"
 #include "net/test/cert_test_util.h"
+#include "net/test/test_certificate_data.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -56,6 +57,37 @@ class MockCertVerifyProc : public CertVerifyProc {
   }
 };
 
+// Accepts every chain, but matches the hostname like the platform
+// implementations do.
+class NameMatchingCertVerifyProc : public CertVerifyProc {
+ public:
+  NameMatchingCertVerifyProc() {}
+
+ private:
+  virtual ~NameMatchingCertVerifyProc() {}
+
+  // CertVerifyProc implementation
+  virtual bool SupportsAdditionalTrustAnchors() const OVERRIDE {
+    return false;
+  }
+
+  virtual int VerifyInternal(X509Certificate* cert,
+                             const std::string& hostname,
+                             int flags,
+                             CRLSet* crl_set,
+                             const CertificateList& additional_trust_anchors,
+                             CertVerifyResult* verify_result) OVERRIDE {
+    verify_result->Reset();
+    verify_result->verified_cert = cert;
+    if (!cert->VerifyNameMatch(hostname,
+                               &verify_result->common_name_fallback_used)) {
+      verify_result->cert_status = CERT_STATUS_COMMON_NAME_INVALID;
+      return ERR_CERT_COMMON_NAME_INVALID;
+    }
+    return OK;
+  }
+};
+
 class MockCertTrustAnchorProvider : public CertTrustAnchorProvider {
  public:
   MockCertTrustAnchorProvider() {}
@@ -482,4 +514,121 @@ TEST_F(MultiThreadedCertVerifierTest, CertTrustAnchorProvider) {
   ASSERT_EQ(1u, verifier_.cache_hits());
 }
 
+// Tests that a chain verified for one hostname is reused for the other
+// hostnames the certificate is valid for.
+TEST_F(MultiThreadedCertVerifierTest, ChainCacheHit) {
+  MultiThreadedCertVerifier verifier(new NameMatchingCertVerifyProc());
+  scoped_refptr<X509Certificate> webkit_cert(X509Certificate::CreateFromBytes(
+      reinterpret_cast<const char*>(webkit_der), sizeof(webkit_der)));
+  ASSERT_TRUE(webkit_cert.get());
+
+  int error;
+  CertVerifyResult verify_result;
+  TestCompletionCallback callback;
+  CertVerifier::RequestHandle request_handle;
+
+  error = verifier.Verify(webkit_cert.get(),
+                          "www.webkit.org",
+                          0,
+                          NULL,
+                          &verify_result,
+                          callback.callback(),
+                          &request_handle,
+                          BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  EXPECT_TRUE(request_handle);
+  EXPECT_EQ(OK, callback.WaitForResult());
+  ASSERT_EQ(1u, verifier.GetCacheSize());
+  ASSERT_EQ(1u, verifier.GetChainCacheSize());
+
+  // Another hostname covered by the certificate completes synchronously.
+  error = verifier.Verify(webkit_cert.get(),
+                          "foo.webkit.org",
+                          0,
+                          NULL,
+                          &verify_result,
+                          callback.callback(),
+                          &request_handle,
+                          BoundNetLog());
+  EXPECT_EQ(OK, error);
+  EXPECT_TRUE(request_handle == NULL);
+  EXPECT_EQ(0u, verifier.cache_hits());
+  EXPECT_EQ(1u, verifier.chain_cache_hits());
+
+  // A hostname the certificate is not valid for is verified in full.
+  error = verifier.Verify(webkit_cert.get(),
+                          "www.webkit.com",
+                          0,
+                          NULL,
+                          &verify_result,
+                          callback.callback(),
+                          &request_handle,
+                          BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  EXPECT_TRUE(request_handle);
+  EXPECT_EQ(ERR_CERT_COMMON_NAME_INVALID, callback.WaitForResult());
+  EXPECT_TRUE(verify_result.cert_status & CERT_STATUS_COMMON_NAME_INVALID);
+  EXPECT_EQ(1u, verifier.chain_cache_hits());
+  EXPECT_EQ(2u, verifier.GetCacheSize());
+  EXPECT_EQ(1u, verifier.GetChainCacheSize());
+
+  // Different flags are a different chain verification.
+  error = verifier.Verify(webkit_cert.get(),
+                          "webkit.org",
+                          CertVerifier::VERIFY_REV_CHECKING_ENABLED,
+                          NULL,
+                          &verify_result,
+                          callback.callback(),
+                          &request_handle,
+                          BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  EXPECT_EQ(OK, callback.WaitForResult());
+  EXPECT_EQ(1u, verifier.chain_cache_hits());
+  EXPECT_EQ(2u, verifier.GetChainCacheSize());
+}
+
+// Tests that requests for different hostnames with the same chain join the
+// same verification.
+TEST_F(MultiThreadedCertVerifierTest, ChainInflightJoin) {
+  MultiThreadedCertVerifier verifier(new NameMatchingCertVerifyProc());
+  scoped_refptr<X509Certificate> webkit_cert(X509Certificate::CreateFromBytes(
+      reinterpret_cast<const char*>(webkit_der), sizeof(webkit_der)));
+  ASSERT_TRUE(webkit_cert.get());
+
+  int error;
+  CertVerifyResult verify_result;
+  TestCompletionCallback callback;
+  CertVerifier::RequestHandle request_handle;
+  CertVerifyResult verify_result2;
+  TestCompletionCallback callback2;
+  CertVerifier::RequestHandle request_handle2;
+
+  error = verifier.Verify(webkit_cert.get(),
+                          "www.webkit.org",
+                          0,
+                          NULL,
+                          &verify_result,
+                          callback.callback(),
+                          &request_handle,
+                          BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  EXPECT_TRUE(request_handle);
+  error = verifier.Verify(webkit_cert.get(),
+                          "foo.webkit.org",
+                          0,
+                          NULL,
+                          &verify_result2,
+                          callback2.callback(),
+                          &request_handle2,
+                          BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  EXPECT_TRUE(request_handle2);
+  EXPECT_EQ(OK, callback.WaitForResult());
+  EXPECT_EQ(OK, callback2.WaitForResult());
+  EXPECT_EQ(0u, verify_result2.cert_status);
+  EXPECT_EQ(0u, verifier.inflight_joins());
+  EXPECT_EQ(1u, verifier.chain_inflight_joins());
+  EXPECT_EQ(1u, verifier.GetCacheSize());
+}
+
 }  // namespace net
@@ -151,6 +151,11 @@ bool CookieSorter(CanonicalCookie* cc1, CanonicalCookie* cc2) {
   return cc1->Path().length() > cc2->Path().length();
 }
 
+bool CookieItSorter(const CookieMonster::CookieMap::iterator& it1,
+                    const CookieMonster::CookieMap::iterator& it2) {
+  return CookieSorter(it1->second, it2->second);
+}
+
 bool LRACookieSorter(const CookieMonster::CookieMap::iterator& it1,
                      const CookieMonster::CookieMap::iterator& it2) {
   // Cookies accessed less recently should be deleted first.
@@ -1154,7 +1159,6 @@ CookieList CookieMonster::GetAllCookiesForURLWithOptions(
 
   std::vector<CanonicalCookie*> cookie_ptrs;
   FindCookiesForHostAndDomain(url, options, false, &cookie_ptrs);
-  std::sort(cookie_ptrs.begin(), cookie_ptrs.end(), CookieSorter);
 
   CookieList cookies;
   for (std::vector<CanonicalCookie*>::const_iterator it = cookie_ptrs.begin();
@@ -1318,7 +1322,6 @@ std::string CookieMonster::GetCookiesWithOptions(const GURL& url,
 
   std::vector<CanonicalCookie*> cookies;
   FindCookiesForHostAndDomain(url, options, true, &cookies);
-  std::sort(cookies.begin(), cookies.end(), CookieSorter);
 
   std::string cookie_line = BuildCookieLine(cookies);
 
@@ -1699,15 +1702,21 @@ void CookieMonster::FindCookiesForKey(const std::string& key,
                                       std::vector<CanonicalCookie*>* cookies) {
   lock_.AssertAcquired();
 
-  for (CookieMapItPair its = cookies_.equal_range(key);
-       its.first != its.second; ) {
-    CookieMap::iterator curit = its.first;
-    CanonicalCookie* cc = curit->second;
-    ++its.first;
+  if (cookies_.find(key) == cookies_.end())
+    return;
+
+  // The cookies come out in the order they are sent in.  Expired ones are
+  // deleted once the lookup is done, as deleting them drops the sorted
+  // iterators.
+  CookieItVector expired_cookies;
+  const CookieItVector& sorted_cookies = GetSortedCookieIts(key);
+  for (CookieItVector::const_iterator it = sorted_cookies.begin();
+       it != sorted_cookies.end(); ++it) {
+    CanonicalCookie* cc = (*it)->second;
 
     // If the cookie is expired, delete it.
     if (cc->IsExpired(current) && !keep_expired_cookies_) {
-      InternalDeleteCookie(curit, true, DELETE_COOKIE_EXPIRED);
+      expired_cookies.push_back(*it);
       continue;
     }
 
@@ -1724,6 +1733,29 @@ void CookieMonster::FindCookiesForKey(const std::string& key,
     }
     cookies->push_back(cc);
   }
+
+  for (CookieItVector::const_iterator it = expired_cookies.begin();
+       it != expired_cookies.end(); ++it) {
+    InternalDeleteCookie(*it, true, DELETE_COOKIE_EXPIRED);
+  }
+}
+
+const CookieMonster::CookieItVector& CookieMonster::GetSortedCookieIts(
+    const std::string& key) {
+  lock_.AssertAcquired();
+
+  SortedCookieItMap::iterator found = sorted_cookie_its_.find(key);
+  if (found != sorted_cookie_its_.end())
+    return found->second;
+
+  CookieItVector* sorted_cookies = &sorted_cookie_its_[key];
+  for (CookieMapItPair its = cookies_.equal_range(key);
+       its.first != its.second; ++its.first) {
+    sorted_cookies->push_back(its.first);
+  }
+  DCHECK(!sorted_cookies->empty());
+  std::sort(sorted_cookies->begin(), sorted_cookies->end(), CookieItSorter);
+  return *sorted_cookies;
 }
 
 bool CookieMonster::DeleteAnyEquivalentCookie(const std::string& key,
@@ -1768,6 +1800,7 @@ CookieMonster::CookieMap::iterator CookieMonster::InternalInsertCookie(
     store_->AddCookie(*cc);
   CookieMap::iterator inserted =
       cookies_.insert(CookieMap::value_type(key, cc));
+  sorted_cookie_its_.erase(key);
   if (delegate_.get()) {
     delegate_->OnCookieChanged(
         *cc, false, CookieMonsterDelegate::CHANGE_COOKIE_EXPLICIT);
@@ -1888,6 +1921,7 @@ void CookieMonster::InternalDeleteCookie(CookieMap::iterator it,
     if (mapping.notify)
       delegate_->OnCookieChanged(*cc, true, mapping.cause);
   }
+  sorted_cookie_its_.erase(it->first);
   cookies_.erase(it);
   delete cc;
 }
@@ -510,6 +510,11 @@ class NET_EXPORT CookieMonster : public CookieStore {
                          bool update_access_time,
                          std::vector<CanonicalCookie*>* cookies);
 
+  // Returns the iterators to the cookies for the CookieMap key |key| in the
+  // order they are sent in, building them on the first lookup of |key| since
+  // a cookie for it was inserted or deleted.  |key| must have cookies.
+  const CookieItVector& GetSortedCookieIts(const std::string& key);
+
   // Delete any cookies that are equivalent to |ecc| (same path, domain, etc).
   // If |skip_httponly| is true, httponly cookies will not be deleted.  The
   // return value with be true if |skip_httponly| skipped an httponly cookie.
@@ -621,6 +626,13 @@ class NET_EXPORT CookieMonster : public CookieStore {
 
   CookieMap cookies_;
 
+  // A cache of the iterators to the cookies of each key in the order that
+  // they are sent in, so that repeated lookups on a key with many cookies do
+  // not sort them again.  The entry for a key is dropped whenever a cookie
+  // for it is inserted or deleted.
+  typedef std::map<std::string, CookieItVector> SortedCookieItMap;
+  SortedCookieItMap sorted_cookie_its_;
+
   // Indicates whether the cookie store has been initialized. This happens
   // lazily in InitStoreIfNecessary().
   bool initialized_;
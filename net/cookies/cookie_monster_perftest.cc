@@ -5,10 +5,12 @@
 #include <algorithm>
 
 #include "base/bind.h"
+#include "base/memory/scoped_vector.h"
 #include "base/message_loop/message_loop.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/test/perf_time_logger.h"
+#include "base/threading/thread.h"
 #include "net/cookies/canonical_cookie.h"
 #include "net/cookies/cookie_monster.h"
 #include "net/cookies/cookie_monster_store_test.h"
@@ -93,6 +95,18 @@ class GetCookiesCallback : public BaseCallback {
   net::CookieOptions options_;
 };
 
+void IgnoreCookieLine(const std::string& cookie_line) {}
+
+// Queries the cookies for |gurl| |count| times.  The store is loaded, so every
+// query completes synchronously on the calling thread.
+void QueryCookies(CookieMonster* cm, const GURL& gurl, int count) {
+  CookieOptions options;
+  for (int i = 0; i < count; ++i) {
+    cm->GetCookiesWithOptionsAsync(gurl, options,
+                                   base::Bind(&IgnoreCookieLine));
+  }
+}
+
 }  // namespace
 
 TEST(ParsedCookieTest, TestParseCookies) {
@@ -276,6 +290,46 @@ TEST_F(CookieMonsterTest, TestDomainLine) {
   timer2.Done();
 }
 
+TEST_F(CookieMonsterTest, TestConcurrentQueries) {
+  const int kNumThreads = 4;
+  const int kCookiesPerHost = 150;
+  scoped_refptr<CookieMonster> cm(new CookieMonster(NULL, NULL));
+  SetCookieCallback setCookieCallback;
+
+  // Each thread queries its own host, which has a lot of cookies.
+  std::vector<GURL> gurls;
+  for (int i = 0; i < kNumThreads; ++i) {
+    gurls.push_back(GURL(base::StringPrintf("https://www.host%d.izzle", i)));
+    for (int j = 0; j < kCookiesPerHost; ++j) {
+      setCookieCallback.SetCookie(cm.get(), gurls.back(),
+                                  base::StringPrintf("a%03d=b", j));
+    }
+  }
+
+  base::PerfTimeLogger timer("Cookie_monster_query_single_thread");
+  for (int i = 0; i < kNumThreads; ++i)
+    QueryCookies(cm.get(), gurls[i], kNumCookies / kNumThreads);
+  timer.Done();
+
+  ScopedVector<base::Thread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    const std::string name = base::StringPrintf("CookieQueryThread%d", i);
+    threads.push_back(new base::Thread(name.c_str()));
+    ASSERT_TRUE(threads.back()->Start());
+  }
+
+  base::PerfTimeLogger timer2("Cookie_monster_query_concurrent");
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads[i]->message_loop()->PostTask(
+        FROM_HERE,
+        base::Bind(&QueryCookies, cm, gurls[i], kNumCookies / kNumThreads));
+  }
+  // Stopping a thread waits for the tasks posted to it.
+  for (int i = 0; i < kNumThreads; ++i)
+    threads[i]->Stop();
+  timer2.Done();
+}
+
 TEST_F(CookieMonsterTest, TestImport) {
   scoped_refptr<MockPersistentCookieStore> store(new MockPersistentCookieStore);
   std::vector<CanonicalCookie*> initial_cookies;
@@ -2041,6 +2041,28 @@ TEST_F(CookieMonsterTest, CookieListOrdering) {
   }
 }
 
+TEST_F(CookieMonsterTest, CookieOrderingAfterChanges) {
+  // Lookups reuse the sorted cookies of a key, which must be dropped when the
+  // cookies of the key change.
+  scoped_refptr<CookieMonster> cm(new CookieMonster(NULL, NULL));
+  GURL url("http://www.google.com/aa/bb/x.html");
+  EXPECT_TRUE(SetCookie(cm.get(), GURL("http://www.google.com/x.html"),
+                        "a=1"));
+  EXPECT_TRUE(SetCookie(cm.get(), GURL("http://www.google.com/aa/x.html"),
+                        "b=1"));
+  EXPECT_EQ("b=1; a=1", GetCookies(cm.get(), url));
+
+  EXPECT_TRUE(SetCookie(cm.get(), url, "c=1"));
+  EXPECT_EQ("c=1; b=1; a=1", GetCookies(cm.get(), url));
+
+  DeleteCookie(cm.get(), url, "b");
+  EXPECT_EQ("c=1; a=1", GetCookies(cm.get(), url));
+
+  EXPECT_TRUE(SetCookie(cm.get(), GURL("http://www.google.com/aa/x.html"),
+                        "b=2"));
+  EXPECT_EQ("c=1; b=2; a=1", GetCookies(cm.get(), url));
+}
+
 // This test and CookieMonstertest.TestGCTimes (in cookie_monster_perftest.cc)
 // are somewhat complementary twins.  This test is probing for whether
 // garbage collection always happens when it should (i.e. that we actually
@@ -3,12 +3,14 @@
 // found in the LICENSE file.
 
 #include <string>
+#include <vector>
 
 #include "base/basictypes.h"
 #include "base/bind.h"
 #include "base/bind_helpers.h"
 #include "base/hash.h"
 #include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
 #include "base/test/perf_time_logger.h"
 #include "base/test/test_file_util.h"
 #include "base/threading/thread.h"
@@ -22,6 +24,7 @@
 #include "net/disk_cache/disk_cache.h"
 #include "net/disk_cache/disk_cache_test_base.h"
 #include "net/disk_cache/disk_cache_test_util.h"
+#include "net/disk_cache/simple/simple_util.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/platform_test.h"
 
@@ -248,3 +251,142 @@ TEST_F(DiskCacheTest, BlockFilesPerformance) {
   base::MessageLoop::current()->RunUntilIdle();
   delete[] address;
 }
+
+// Media entries are written to the cache in many small appends, and replayed
+// with sequential reads. This measures both on a single large entry of the
+// simple cache, whose files should end up contiguous on disk.
+TEST_F(DiskCacheTest, SimpleCacheLargeEntryPerformance) {
+  base::Thread cache_thread("CacheThread");
+  ASSERT_TRUE(cache_thread.StartWithOptions(
+                  base::Thread::Options(base::MessageLoop::TYPE_IO, 0)));
+
+  ASSERT_TRUE(CleanupCacheDir());
+  net::TestCompletionCallback cb;
+  scoped_ptr<disk_cache::Backend> cache;
+  int rv = disk_cache::CreateCacheBackend(
+      net::MEDIA_CACHE, net::CACHE_BACKEND_SIMPLE, cache_path_, 0, false,
+      cache_thread.message_loop_proxy().get(), NULL, &cache, cb.callback());
+  ASSERT_EQ(net::OK, cb.GetResult(rv));
+
+  const int kChunkSize = 32 * 1024;
+  const int kEntrySize = 16 * 1024 * 1024;
+  scoped_refptr<net::IOBuffer> buffer(new net::IOBuffer(kChunkSize));
+  CacheTestFillBuffer(buffer->data(), kChunkSize, false);
+  const std::string key = GenerateKey(true);
+
+  base::PerfTimeLogger write_timer("Append to large simple cache entry");
+  disk_cache::Entry* entry;
+  rv = cache->CreateEntry(key, &entry, cb.callback());
+  ASSERT_EQ(net::OK, cb.GetResult(rv));
+  for (int offset = 0; offset < kEntrySize; offset += kChunkSize) {
+    // Like HttpCache::Transaction, each append truncates the stream.
+    rv = entry->WriteData(
+        1, offset, buffer.get(), kChunkSize, cb.callback(), true);
+    ASSERT_EQ(kChunkSize, cb.GetResult(rv));
+  }
+  entry->Close();
+  base::MessageLoop::current()->RunUntilIdle();
+  cache.reset();
+  write_timer.Done();
+
+  ASSERT_TRUE(file_util::EvictFileFromSystemCache(cache_path_.AppendASCII(
+      disk_cache::simple_util::GetFilenameFromKeyAndFileIndex(key, 0))));
+
+  rv = disk_cache::CreateCacheBackend(
+      net::MEDIA_CACHE, net::CACHE_BACKEND_SIMPLE, cache_path_, 0, false,
+      cache_thread.message_loop_proxy().get(), NULL, &cache, cb.callback());
+  ASSERT_EQ(net::OK, cb.GetResult(rv));
+
+  base::PerfTimeLogger read_timer("Read large simple cache entry (cold)");
+  rv = cache->OpenEntry(key, &entry, cb.callback());
+  ASSERT_EQ(net::OK, cb.GetResult(rv));
+  for (int offset = 0; offset < kEntrySize; offset += kChunkSize) {
+    rv = entry->ReadData(1, offset, buffer.get(), kChunkSize, cb.callback());
+    ASSERT_EQ(kChunkSize, cb.GetResult(rv));
+  }
+  entry->Close();
+  read_timer.Done();
+
+  base::MessageLoop::current()->RunUntilIdle();
+}
+
+// Reads small ranges of random entries of the simple cache, with more and more
+// reads in flight. The entries are spread over the threads of the worker pool,
+// so the number of reads per second should grow with the number in flight
+// until the disk is saturated.
+TEST_F(DiskCacheTest, SimpleCacheRandomReadPerformance) {
+  base::Thread cache_thread("CacheThread");
+  ASSERT_TRUE(cache_thread.StartWithOptions(
+                  base::Thread::Options(base::MessageLoop::TYPE_IO, 0)));
+
+  ASSERT_TRUE(CleanupCacheDir());
+  net::TestCompletionCallback cb;
+  scoped_ptr<disk_cache::Backend> cache;
+  int rv = disk_cache::CreateCacheBackend(
+      net::DISK_CACHE, net::CACHE_BACKEND_SIMPLE, cache_path_, 0, false,
+      cache_thread.message_loop_proxy().get(), NULL, &cache, cb.callback());
+  ASSERT_EQ(net::OK, cb.GetResult(rv));
+
+  int seed = static_cast<int>(Time::Now().ToInternalValue());
+  srand(seed);
+
+  const int kNumEntries = 500;
+  const int kEntrySize = 64 * 1024;
+  const int kReadSize = 4 * 1024;
+  const int kNumReads = 2000;
+  scoped_refptr<net::IOBuffer> buffer(new net::IOBuffer(kEntrySize));
+  CacheTestFillBuffer(buffer->data(), kEntrySize, false);
+
+  std::vector<std::string> keys;
+  std::vector<disk_cache::Entry*> entries;
+  for (int i = 0; i < kNumEntries; i++) {
+    keys.push_back(GenerateKey(true));
+    disk_cache::Entry* entry;
+    rv = cache->CreateEntry(keys.back(), &entry, cb.callback());
+    ASSERT_EQ(net::OK, cb.GetResult(rv));
+    rv = entry->WriteData(1, 0, buffer.get(), kEntrySize, cb.callback(), false);
+    ASSERT_EQ(kEntrySize, cb.GetResult(rv));
+    entries.push_back(entry);
+  }
+
+  static const int kReadsInFlight[] = { 1, 4, 16, 64 };
+  for (size_t i = 0; i < arraysize(kReadsInFlight); i++) {
+    const int reads_in_flight = kReadsInFlight[i];
+    for (int j = 0; j < kNumEntries; j++) {
+      ASSERT_TRUE(file_util::EvictFileFromSystemCache(cache_path_.AppendASCII(
+          disk_cache::simple_util::GetFilenameFromKeyAndFileIndex(keys[j],
+                                                                  0))));
+    }
+    std::vector<scoped_refptr<net::IOBuffer> > read_buffers;
+    for (int j = 0; j < reads_in_flight; j++)
+      read_buffers.push_back(new net::IOBuffer(kReadSize));
+
+    MessageLoopHelper helper;
+    CallbackTest callback(&helper, true);
+    int expected = 0;
+
+    base::PerfTimeLogger timer(base::StringPrintf(
+        "Random reads of simple cache entries, %d in flight",
+        reads_in_flight).c_str());
+    for (int read = 0; read < kNumReads; read += reads_in_flight) {
+      for (int j = 0; j < reads_in_flight; j++) {
+        disk_cache::Entry* entry = entries[rand() % kNumEntries];
+        int offset = (rand() % (kEntrySize / kReadSize)) * kReadSize;
+        int ret = entry->ReadData(
+            1, offset, read_buffers[j].get(), kReadSize,
+            base::Bind(&CallbackTest::Run, base::Unretained(&callback)));
+        if (net::ERR_IO_PENDING == ret)
+          expected++;
+        else
+          EXPECT_EQ(kReadSize, ret);
+      }
+      helper.WaitUntilCacheIoFinished(expected);
+    }
+    timer.Done();
+    EXPECT_EQ(expected, helper.callbacks_called());
+  }
+
+  for (int i = 0; i < kNumEntries; i++)
+    entries[i]->Close();
+  base::MessageLoop::current()->RunUntilIdle();
+}
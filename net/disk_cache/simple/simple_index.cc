@@ -48,6 +48,10 @@ const uint32 kEvictionMarginDivisor = 20;
 
 const uint32 kBytesInKb = 1024;
 
+// The index file is written again once its journal would hold more records
+// than this fraction of the entries.
+const size_t kJournalCompactionDivisor = 4;
+
 // Utility class used for timestamp comparisons in entry metadata while sorting.
 class CompareHashesForTimestamp {
   typedef disk_cache::SimpleIndex SimpleIndex;
@@ -147,6 +151,8 @@ SimpleIndex::SimpleIndex(base::SingleThreadTaskRunner* io_thread,
       low_watermark_(0),
       eviction_in_progress_(false),
       initialized_(false),
+      can_append_to_journal_(false),
+      journal_record_count_(0),
       index_file_(index_file.Pass()),
       io_thread_(io_thread),
       // Creating the callback once so it is reused every time
@@ -266,6 +272,7 @@ void SimpleIndex::Insert(uint64 entry_hash) {
       entry_hash, EntryMetadata(base::Time::Now(), 0), &entries_set_);
   if (!initialized_)
     removed_entries_.erase(entry_hash);
+  changed_entries_.insert(entry_hash);
   PostponeWritingToDisk();
 }
 
@@ -279,6 +286,7 @@ void SimpleIndex::Remove(uint64 entry_hash) {
 
   if (!initialized_)
     removed_entries_.insert(entry_hash);
+  changed_entries_.insert(entry_hash);
   PostponeWritingToDisk();
 }
 
@@ -297,6 +305,7 @@ bool SimpleIndex::UseIfExists(uint64 entry_hash) {
     // If not initialized, always return true, forcing it to go to the disk.
     return !initialized_;
   it->second.SetLastUsedTime(base::Time::Now());
+  changed_entries_.insert(entry_hash);
   PostponeWritingToDisk();
   return true;
 }
@@ -357,6 +366,7 @@ bool SimpleIndex::UpdateEntrySize(uint64 entry_hash, int entry_size) {
     return false;
 
   UpdateEntryIteratorSize(&it, entry_size);
+  changed_entries_.insert(entry_hash);
   PostponeWritingToDisk();
   StartEvictionIfNeeded();
   return true;
@@ -437,6 +447,10 @@ void SimpleIndex::MergeInitializingSet(
   entries_set_.swap(*index_file_entries);
   cache_size_ = merged_cache_size;
   initialized_ = true;
+  // The changes made during initialization are relative to the loaded index
+  // file, so they can be appended to its journal.
+  can_append_to_journal_ = load_result->journal_loaded;
+  journal_record_count_ = load_result->journal_record_count;
 
   // The actual IO is asynchronous, so calling WriteToDisk() shouldn't slow the
   // merge down much.
@@ -491,8 +505,20 @@ void SimpleIndex::WriteToDisk() {
   }
   last_write_to_disk_ = start;
 
-  index_file_->WriteToDisk(entries_set_, cache_size_,
-                           start, app_on_background_);
+  // Each append adds a record for every change, and one ending the batch.
+  const size_t journal_record_count =
+      journal_record_count_ + changed_entries_.size() + 1;
+  if (can_append_to_journal_ &&
+      journal_record_count <= entries_set_.size() / kJournalCompactionDivisor) {
+    index_file_->AppendToJournal(entries_set_, changed_entries_);
+    journal_record_count_ = journal_record_count;
+  } else {
+    index_file_->WriteToDisk(entries_set_, cache_size_,
+                             start, app_on_background_);
+    can_append_to_journal_ = true;
+    journal_record_count_ = 0;
+  }
+  changed_entries_.clear();
 }
 
 }  // namespace disk_cache
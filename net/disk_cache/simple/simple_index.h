@@ -137,6 +137,8 @@ class NET_EXPORT_PRIVATE SimpleIndex
   FRIEND_TEST_ALL_PREFIXES(SimpleIndexTest, DiskWriteQueued);
   FRIEND_TEST_ALL_PREFIXES(SimpleIndexTest, DiskWriteExecuted);
   FRIEND_TEST_ALL_PREFIXES(SimpleIndexTest, DiskWritePostponed);
+  FRIEND_TEST_ALL_PREFIXES(SimpleIndexTest, DiskWriteAppendsToJournal);
+  FRIEND_TEST_ALL_PREFIXES(SimpleIndexTest, DiskWriteCompactsJournal);
 
   void StartEvictionIfNeeded();
   void EvictionDone(int result);
@@ -172,6 +174,15 @@ class NET_EXPORT_PRIVATE SimpleIndex
   base::hash_set<uint64> removed_entries_;
   bool initialized_;
 
+  // The entries inserted, removed or updated since the index was last written
+  // to disk.
+  base::hash_set<uint64> changed_entries_;
+
+  // True if the changes can be appended to the journal of the index file on
+  // disk, which holds |journal_record_count_| records.
+  bool can_append_to_journal_;
+  size_t journal_record_count_;
+
   scoped_ptr<SimpleIndexFile> index_file_;
 
   scoped_refptr<base::SingleThreadTaskRunner> io_thread_;
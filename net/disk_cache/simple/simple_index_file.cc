@@ -7,11 +7,13 @@
 #include <vector>
 
 #include "base/file_util.h"
+#include "base/files/file.h"
 #include "base/files/memory_mapped_file.h"
 #include "base/hash.h"
 #include "base/logging.h"
 #include "base/pickle.h"
 #include "base/single_thread_task_runner.h"
+#include "base/stl_util.h"
 #include "base/task_runner_util.h"
 #include "base/threading/thread_restrictions.h"
 #include "net/disk_cache/simple/simple_backend_version.h"
@@ -30,12 +32,19 @@ const int kEntryFilesSuffixLength = 2;
 
 const uint64 kMaxEntiresInIndex = 100000000;
 
+const uint64 kSimpleIndexJournalMagicNumber = GG_UINT64_C(0x6a6f75726e616c31);
+
 uint32 CalculatePickleCRC(const Pickle& pickle) {
   return crc32(crc32(0, Z_NULL, 0),
                reinterpret_cast<const Bytef*>(pickle.payload()),
                pickle.payload_size());
 }
 
+uint32 CalculateRecordsCRC(const void* records, size_t size) {
+  return crc32(crc32(0, Z_NULL, 0),
+               reinterpret_cast<const Bytef*>(records), size);
+}
+
 // Used in histograms. Please only add new values at the end.
 enum IndexFileState {
   INDEX_STATE_CORRUPT = 0,
@@ -125,7 +134,9 @@ void ProcessEntryFile(SimpleIndex::EntrySet* entries,
 }  // namespace
 
 SimpleIndexLoadResult::SimpleIndexLoadResult() : did_load(false),
-                                                 flush_required(false) {
+                                                 flush_required(false),
+                                                 journal_loaded(false),
+                                                 journal_record_count(0) {
 }
 
 SimpleIndexLoadResult::~SimpleIndexLoadResult() {
@@ -134,6 +145,8 @@ SimpleIndexLoadResult::~SimpleIndexLoadResult() {
 void SimpleIndexLoadResult::Reset() {
   did_load = false;
   flush_required = false;
+  journal_loaded = false;
+  journal_record_count = 0;
   entries.clear();
 }
 
@@ -143,6 +156,8 @@ const char SimpleIndexFile::kIndexFileName[] = "the-real-index";
 const char SimpleIndexFile::kIndexDirectory[] = "index-dir";
 // static
 const char SimpleIndexFile::kTempIndexFileName[] = "temp-index";
+// static
+const char SimpleIndexFile::kJournalFileName[] = "the-real-index-journal";
 
 SimpleIndexFile::IndexMetadata::IndexMetadata()
     : magic_number_(kSimpleIndexMagicNumber),
@@ -201,6 +216,13 @@ void SimpleIndexFile::SyncWriteToDisk(net::CacheType cache_type,
     return;
   }
   SerializeFinalData(cache_dir_mtime, pickle.get());
+
+  // The journal applies to the index file being replaced. If writing the new
+  // one fails, no more changes can be appended until the next write succeeds.
+  const base::FilePath journal_filename =
+      index_filename.DirName().AppendASCII(kJournalFileName);
+  base::DeleteFile(journal_filename, /* recursive = */ false);
+
   if (!WritePickleFile(pickle.get(), temp_index_filename)) {
     if (!base::CreateDirectory(temp_index_filename.DirName())) {
       LOG(ERROR) << "Could not create a directory to hold the index file";
@@ -216,6 +238,17 @@ void SimpleIndexFile::SyncWriteToDisk(net::CacheType cache_type,
   bool result = base::ReplaceFile(temp_index_filename, index_filename, NULL);
   DCHECK(result);
 
+  JournalHeader journal_header;
+  journal_header.magic_number = kSimpleIndexJournalMagicNumber;
+  journal_header.version = kSimpleVersion;
+  journal_header.index_crc = pickle->headerT<PickleHeader>()->crc;
+  if (file_util::WriteFile(journal_filename,
+                           reinterpret_cast<const char*>(&journal_header),
+                           sizeof(journal_header)) !=
+      implicit_cast<int>(sizeof(journal_header))) {
+    base::DeleteFile(journal_filename, /* recursive = */ false);
+  }
+
   if (app_on_background) {
     SIMPLE_CACHE_UMA(TIMES,
                      "IndexWriteToDiskTime.Background", cache_type,
@@ -227,6 +260,41 @@ void SimpleIndexFile::SyncWriteToDisk(net::CacheType cache_type,
   }
 }
 
+// static
+void SimpleIndexFile::SyncAppendToJournal(
+    net::CacheType cache_type,
+    const base::FilePath& cache_directory,
+    const base::FilePath& journal_filename,
+    scoped_ptr<JournalRecords> records) {
+  base::Time cache_dir_mtime;
+  if (!simple_util::GetMTime(cache_directory, &cache_dir_mtime)) {
+    LOG(ERROR) << "Could obtain information about cache age";
+    return;
+  }
+  base::File journal_file(journal_filename,
+                          base::File::FLAG_OPEN | base::File::FLAG_APPEND);
+  if (!journal_file.IsValid())
+    return;
+
+  JournalRecord batch_end;
+  batch_end.type = JournalRecord::BATCH_END;
+  batch_end.entry_size = static_cast<int32>(records->size());
+  batch_end.entry_hash = CalculateRecordsCRC(
+      vector_as_array(records.get()), records->size() * sizeof(JournalRecord));
+  batch_end.time = cache_dir_mtime.ToInternalValue();
+  records->push_back(batch_end);
+
+  const int size = records->size() * sizeof(JournalRecord);
+  if (journal_file.WriteAtCurrentPos(
+          reinterpret_cast<const char*>(vector_as_array(records.get())),
+          size) != size) {
+    // A partially written batch is ignored on load.
+    LOG(ERROR) << "Failed to append to the index journal";
+  }
+  SIMPLE_CACHE_UMA(COUNTS,
+                   "IndexJournalRecordsAppended", cache_type, records->size());
+}
+
 bool SimpleIndexFile::IndexMetadata::CheckIndexMetadata() {
   return number_of_entries_ <= kMaxEntiresInIndex &&
       magic_number_ == kSimpleIndexMagicNumber &&
@@ -245,7 +313,9 @@ SimpleIndexFile::SimpleIndexFile(
       index_file_(cache_directory_.AppendASCII(kIndexDirectory)
                       .AppendASCII(kIndexFileName)),
       temp_index_file_(cache_directory_.AppendASCII(kIndexDirectory)
-                           .AppendASCII(kTempIndexFileName)) {
+                           .AppendASCII(kTempIndexFileName)),
+      journal_file_(cache_directory_.AppendASCII(kIndexDirectory)
+                        .AppendASCII(kJournalFileName)) {
 }
 
 SimpleIndexFile::~SimpleIndexFile() {}
@@ -256,7 +326,7 @@ void SimpleIndexFile::LoadIndexEntries(base::Time cache_last_modified,
   base::Closure task = base::Bind(&SimpleIndexFile::SyncLoadIndexEntries,
                                   cache_type_,
                                   cache_last_modified, cache_directory_,
-                                  index_file_, out_result);
+                                  index_file_, journal_file_, out_result);
   worker_pool_->PostTaskAndReply(FROM_HERE, task, callback);
 }
 
@@ -277,16 +347,47 @@ void SimpleIndexFile::WriteToDisk(const SimpleIndex::EntrySet& entry_set,
       app_on_background));
 }
 
+void SimpleIndexFile::AppendToJournal(
+    const SimpleIndex::EntrySet& entry_set,
+    const base::hash_set<uint64>& changed_entries) {
+  scoped_ptr<JournalRecords> records(new JournalRecords());
+  records->reserve(changed_entries.size() + 1);
+  for (base::hash_set<uint64>::const_iterator it = changed_entries.begin();
+       it != changed_entries.end(); ++it) {
+    JournalRecord record;
+    record.entry_hash = *it;
+    SimpleIndex::EntrySet::const_iterator entry = entry_set.find(*it);
+    if (entry == entry_set.end()) {
+      record.type = JournalRecord::ENTRY_REMOVED;
+      record.entry_size = 0;
+      record.time = 0;
+    } else {
+      record.type = JournalRecord::ENTRY_UPDATED;
+      record.entry_size = entry->second.GetEntrySize();
+      record.time = entry->second.GetLastUsedTime().ToInternalValue();
+    }
+    records->push_back(record);
+  }
+  cache_thread_->PostTask(FROM_HERE, base::Bind(
+      &SimpleIndexFile::SyncAppendToJournal,
+      cache_type_,
+      cache_directory_,
+      journal_file_,
+      base::Passed(&records)));
+}
+
 // static
 void SimpleIndexFile::SyncLoadIndexEntries(
     net::CacheType cache_type,
     base::Time cache_last_modified,
     const base::FilePath& cache_directory,
     const base::FilePath& index_file_path,
+    const base::FilePath& journal_file_path,
     SimpleIndexLoadResult* out_result) {
   // Load the index and find its age.
   base::Time last_cache_seen_by_index;
-  SyncLoadFromDisk(index_file_path, &last_cache_seen_by_index, out_result);
+  SyncLoadFromDisk(index_file_path, journal_file_path,
+                   &last_cache_seen_by_index, out_result);
 
   // Consider the index loaded if it is fresh.
   const bool index_file_existed = base::PathExists(index_file_path);
@@ -328,6 +429,7 @@ void SimpleIndexFile::SyncLoadIndexEntries(
 
 // static
 void SimpleIndexFile::SyncLoadFromDisk(const base::FilePath& index_filename,
+                                       const base::FilePath& journal_filename,
                                        base::Time* out_last_cache_seen_by_index,
                                        SimpleIndexLoadResult* out_result) {
   out_result->Reset();
@@ -345,8 +447,69 @@ void SimpleIndexFile::SyncLoadFromDisk(const base::FilePath& index_filename,
       out_last_cache_seen_by_index,
       out_result);
 
-  if (!out_result->did_load)
+  if (!out_result->did_load) {
     base::DeleteFile(index_filename, false);
+    return;
+  }
+
+  const uint32 index_crc =
+      reinterpret_cast<const PickleHeader*>(index_file_map.data())->crc;
+  ApplyJournal(journal_filename, index_crc, out_last_cache_seen_by_index,
+               out_result);
+}
+
+// static
+void SimpleIndexFile::ApplyJournal(const base::FilePath& journal_filename,
+                                   uint32 index_crc,
+                                   base::Time* out_last_cache_seen_by_index,
+                                   SimpleIndexLoadResult* out_result) {
+  base::MemoryMappedFile journal_file_map;
+  if (!journal_file_map.Initialize(journal_filename) ||
+      journal_file_map.length() < sizeof(JournalHeader)) {
+    return;
+  }
+  const JournalHeader* header =
+      reinterpret_cast<const JournalHeader*>(journal_file_map.data());
+  if (header->magic_number != kSimpleIndexJournalMagicNumber ||
+      header->version != kSimpleVersion || header->index_crc != index_crc) {
+    return;
+  }
+
+  const size_t record_count = (journal_file_map.length() -
+                               sizeof(JournalHeader)) / sizeof(JournalRecord);
+  const JournalRecord* records = reinterpret_cast<const JournalRecord*>(
+      journal_file_map.data() + sizeof(JournalHeader));
+  size_t batch_start = 0;
+  for (size_t i = 0; i < record_count; ++i) {
+    if (records[i].type != JournalRecord::BATCH_END)
+      continue;
+    const size_t batch_size = i - batch_start;
+    if (implicit_cast<size_t>(records[i].entry_size) != batch_size ||
+        records[i].entry_hash !=
+            CalculateRecordsCRC(records + batch_start,
+                                batch_size * sizeof(JournalRecord))) {
+      break;
+    }
+    for (size_t j = batch_start; j < i; ++j) {
+      const JournalRecord& record = records[j];
+      if (record.type == JournalRecord::ENTRY_REMOVED) {
+        out_result->entries.erase(record.entry_hash);
+      } else {
+        out_result->entries[record.entry_hash] = EntryMetadata(
+            base::Time::FromInternalValue(record.time), record.entry_size);
+      }
+    }
+    *out_last_cache_seen_by_index =
+        base::Time::FromInternalValue(records[i].time);
+    batch_start = i + 1;
+  }
+
+  // Appending after a partially written batch would hide the later batches,
+  // so the index file needs to be written again first.
+  out_result->journal_loaded =
+      journal_file_map.length() ==
+      sizeof(JournalHeader) + batch_start * sizeof(JournalRecord);
+  out_result->journal_record_count = batch_start;
 }
 
 // static
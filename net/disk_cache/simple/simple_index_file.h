@@ -37,6 +37,11 @@ struct NET_EXPORT_PRIVATE SimpleIndexLoadResult {
   bool did_load;
   SimpleIndex::EntrySet entries;
   bool flush_required;
+
+  // True if the index was loaded from a file whose journal can be appended to,
+  // and which holds |journal_record_count| records.
+  bool journal_loaded;
+  int journal_record_count;
 };
 
 // Simple Index File format is a pickle serialized data of IndexMetadata and
@@ -46,6 +51,13 @@ struct NET_EXPORT_PRIVATE SimpleIndexLoadResult {
 // see SimpleIndexFile::Serialize() and SeeSimpleIndexFile::LoadFromDisk()
 // methods.
 //
+// Rewriting the whole index file on every flush is expensive for large caches,
+// so the changes made after a write of the index file can be appended to its
+// journal instead. The journal is a JournalHeader naming the index file by its
+// CRC, followed by batches of fixed size JournalRecords, each batch ending in
+// a BATCH_END record. Loading the index replays the complete batches of the
+// journal over the entries of the index file.
+//
 // The non-static methods must run on the IO thread. All the real
 // work is done in the static methods, which are run on the cache thread
 // or in worker threads. Synchronization between methods is the
@@ -91,6 +103,11 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
                            const base::TimeTicks& start,
                            bool app_on_background);
 
+  // Appends the metadata of |changed_entries| in |entry_set|, or their removal
+  // if they aren't in it, to the journal of the index file written last.
+  virtual void AppendToJournal(const SimpleIndex::EntrySet& entry_set,
+                               const base::hash_set<uint64>& changed_entries);
+
  private:
   friend class WrappedSimpleIndexFile;
 
@@ -101,18 +118,52 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
   // prevent reallocation on the IO thread when merging in new live entries.
   static const int kExtraSizeForMerge = 512;
 
+  struct JournalHeader {
+    uint64 magic_number;
+    uint32 version;
+    // The CRC of the index file the journal applies to.
+    uint32 index_crc;
+  };
+
+  struct JournalRecord {
+    enum Type {
+      ENTRY_UPDATED = 1,
+      ENTRY_REMOVED = 2,
+      // Holds the number of records of the batch in |entry_size|, their CRC
+      // in |entry_hash|, and the modification time of the cache directory when
+      // the batch was written in |time|.
+      BATCH_END = 3,
+    };
+
+    uint32 type;
+    int32 entry_size;
+    uint64 entry_hash;
+    // The internal value of a base::Time.
+    int64 time;
+  };
+  typedef std::vector<JournalRecord> JournalRecords;
+
   // Synchronous (IO performing) implementation of LoadIndexEntries.
   static void SyncLoadIndexEntries(net::CacheType cache_type,
                                    base::Time cache_last_modified,
                                    const base::FilePath& cache_directory,
                                    const base::FilePath& index_file_path,
+                                   const base::FilePath& journal_file_path,
                                    SimpleIndexLoadResult* out_result);
 
-  // Load the index file from disk returning an EntrySet.
+  // Load the index file and its journal from disk returning an EntrySet.
   static void SyncLoadFromDisk(const base::FilePath& index_filename,
+                               const base::FilePath& journal_filename,
                                base::Time* out_last_cache_seen_by_index,
                                SimpleIndexLoadResult* out_result);
 
+  // Replays the complete batches of the journal of the index file whose CRC
+  // is |index_crc| over |out_result|.
+  static void ApplyJournal(const base::FilePath& journal_filename,
+                           uint32 index_crc,
+                           base::Time* out_last_cache_seen_by_index,
+                           SimpleIndexLoadResult* out_result);
+
   // Returns a scoped_ptr for a newly allocated Pickle containing the serialized
   // data to be written to a file. Note: the pickle is not in a consistent state
   // immediately after calling this menthod, one needs to call
@@ -142,7 +193,7 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
       const base::FilePath& cache_path,
       const EntryFileCallback& entry_file_callback);
 
-  // Writes the index file to disk atomically.
+  // Writes the index file to disk atomically, with an empty journal.
   static void SyncWriteToDisk(net::CacheType cache_type,
                               const base::FilePath& cache_directory,
                               const base::FilePath& index_filename,
@@ -151,6 +202,12 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
                               const base::TimeTicks& start_time,
                               bool app_on_background);
 
+  // Appends |records| to the journal as a batch, if the journal exists.
+  static void SyncAppendToJournal(net::CacheType cache_type,
+                                  const base::FilePath& cache_directory,
+                                  const base::FilePath& journal_filename,
+                                  scoped_ptr<JournalRecords> records);
+
   // Scan the index directory for entries, returning an EntrySet of all entries
   // found.
   static void SyncRestoreFromDisk(const base::FilePath& cache_directory,
@@ -174,10 +231,12 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
   const base::FilePath cache_directory_;
   const base::FilePath index_file_;
   const base::FilePath temp_index_file_;
+  const base::FilePath journal_file_;
 
   static const char kIndexDirectory[];
   static const char kIndexFileName[];
   static const char kTempIndexFileName[];
+  static const char kJournalFileName[];
 
   DISALLOW_COPY_AND_ASSIGN(SimpleIndexFile);
 };
@@ -73,6 +73,7 @@ class WrappedSimpleIndexFile : public SimpleIndexFile {
   using SimpleIndexFile::LegacyIsIndexFileStale;
   using SimpleIndexFile::Serialize;
   using SimpleIndexFile::SerializeFinalData;
+  using SimpleIndexFile::SyncLoadFromDisk;
 
   explicit WrappedSimpleIndexFile(const base::FilePath& index_file_directory)
       : SimpleIndexFile(base::MessageLoopProxy::current().get(),
@@ -86,6 +87,10 @@ class WrappedSimpleIndexFile : public SimpleIndexFile {
     return index_file_;
   }
 
+  const base::FilePath& GetJournalFilePath() const {
+    return journal_file_;
+  }
+
   bool CreateIndexFileDirectory() const {
     return base::CreateDirectory(index_file_.DirName());
   }
@@ -263,6 +268,64 @@ TEST_F(SimpleIndexFileTest, LoadCorruptIndex) {
   EXPECT_TRUE(load_index_result.flush_required);
 }
 
+TEST_F(SimpleIndexFileTest, WriteJournalThenLoadIndex) {
+  base::ScopedTempDir cache_dir;
+  ASSERT_TRUE(cache_dir.CreateUniqueTempDir());
+
+  SimpleIndex::EntrySet entries;
+  static const uint64 kHashes[] = { 11, 22, 33 };
+  for (size_t i = 0; i < arraysize(kHashes); ++i) {
+    SimpleIndex::InsertInEntrySet(
+        kHashes[i], EntryMetadata(Time(), kHashes[i]), &entries);
+  }
+  WrappedSimpleIndexFile simple_index_file(cache_dir.path());
+  simple_index_file.WriteToDisk(entries, 66U, base::TimeTicks(), false);
+  base::RunLoop().RunUntilIdle();
+
+  base::hash_set<uint64> changed_entries;
+  changed_entries.insert(22);
+  changed_entries.insert(33);
+  changed_entries.insert(44);
+  entries[22].SetEntrySize(99);
+  entries.erase(33);
+  SimpleIndex::InsertInEntrySet(44, EntryMetadata(Time(), 44), &entries);
+  simple_index_file.AppendToJournal(entries, changed_entries);
+  base::RunLoop().RunUntilIdle();
+
+  base::Time when_index_last_saw_cache;
+  SimpleIndexLoadResult load_index_result;
+  WrappedSimpleIndexFile::SyncLoadFromDisk(
+      simple_index_file.GetIndexFilePath(),
+      simple_index_file.GetJournalFilePath(),
+      &when_index_last_saw_cache,
+      &load_index_result);
+  EXPECT_TRUE(load_index_result.did_load);
+  EXPECT_TRUE(load_index_result.journal_loaded);
+  // The three changes and the end of their batch.
+  EXPECT_EQ(4, load_index_result.journal_record_count);
+  ASSERT_EQ(3U, load_index_result.entries.size());
+  EXPECT_EQ(44, load_index_result.entries[44].GetEntrySize());
+  EXPECT_EQ(99, load_index_result.entries[22].GetEntrySize());
+  EXPECT_EQ(0U, load_index_result.entries.count(33));
+
+  // The changes of a partially written batch are ignored, and no more can be
+  // appended after it.
+  const std::string kPartialRecord = "partial";
+  EXPECT_EQ(implicit_cast<int>(kPartialRecord.size()),
+            file_util::AppendToFile(simple_index_file.GetJournalFilePath(),
+                                    kPartialRecord.data(),
+                                    kPartialRecord.size()));
+  WrappedSimpleIndexFile::SyncLoadFromDisk(
+      simple_index_file.GetIndexFilePath(),
+      simple_index_file.GetJournalFilePath(),
+      &when_index_last_saw_cache,
+      &load_index_result);
+  EXPECT_TRUE(load_index_result.did_load);
+  EXPECT_FALSE(load_index_result.journal_loaded);
+  EXPECT_EQ(3U, load_index_result.entries.size());
+  EXPECT_EQ(99, load_index_result.entries[22].GetEntrySize());
+}
+
 // Tests that after an upgrade the backend has the index file put in place.
 TEST_F(SimpleIndexFileTest, SimpleCacheUpgrade) {
   base::ScopedTempDir cache_dir;
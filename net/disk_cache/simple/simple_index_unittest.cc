@@ -55,7 +55,8 @@ class MockSimpleIndexFile : public SimpleIndexFile,
       : SimpleIndexFile(NULL, NULL, net::DISK_CACHE, base::FilePath()),
         load_result_(NULL),
         load_index_entries_calls_(0),
-        disk_writes_(0) {}
+        disk_writes_(0),
+        journal_appends_(0) {}
 
   virtual void LoadIndexEntries(
       base::Time cache_last_modified,
@@ -74,6 +75,13 @@ class MockSimpleIndexFile : public SimpleIndexFile,
     disk_write_entry_set_ = entry_set;
   }
 
+  virtual void AppendToJournal(
+      const SimpleIndex::EntrySet& entry_set,
+      const base::hash_set<uint64>& changed_entries) OVERRIDE {
+    journal_appends_++;
+    journal_changed_entries_ = changed_entries;
+  }
+
   void GetAndResetDiskWriteEntrySet(SimpleIndex::EntrySet* entry_set) {
     entry_set->swap(disk_write_entry_set_);
   }
@@ -82,6 +90,10 @@ class MockSimpleIndexFile : public SimpleIndexFile,
   SimpleIndexLoadResult* load_result() const { return load_result_; }
   int load_index_entries_calls() const { return load_index_entries_calls_; }
   int disk_writes() const { return disk_writes_; }
+  int journal_appends() const { return journal_appends_; }
+  const base::hash_set<uint64>& journal_changed_entries() const {
+    return journal_changed_entries_;
+  }
 
  private:
   base::Closure load_callback_;
@@ -89,6 +101,8 @@ class MockSimpleIndexFile : public SimpleIndexFile,
   int load_index_entries_calls_;
   int disk_writes_;
   SimpleIndex::EntrySet disk_write_entry_set_;
+  int journal_appends_;
+  base::hash_set<uint64> journal_changed_entries_;
 };
 
 class SimpleIndexTest  : public testing::Test, public SimpleIndexDelegate {
@@ -626,4 +640,52 @@ TEST_F(SimpleIndexTest, DiskWritePostponed) {
   index()->write_to_disk_timer_.Stop();
 }
 
+TEST_F(SimpleIndexTest, DiskWriteAppendsToJournal) {
+  for (size_t i = 0; i < hashes_.size; ++i)
+    InsertIntoIndexFileReturn(HashesInitializer(i), base::Time::Now(), 10);
+  index_file_->load_result()->journal_loaded = true;
+  ReturnIndexFile();
+
+  index()->UseIfExists(hashes_.at<1>());
+  index()->Remove(hashes_.at<2>());
+  index()->write_to_disk_timer_.Stop();
+  index()->WriteToDisk();
+
+  EXPECT_EQ(0, index_file_->disk_writes());
+  EXPECT_EQ(1, index_file_->journal_appends());
+  EXPECT_EQ(2u, index_file_->journal_changed_entries().size());
+  EXPECT_EQ(1u, index_file_->journal_changed_entries().count(hashes_.at<1>()));
+  EXPECT_EQ(1u, index_file_->journal_changed_entries().count(hashes_.at<2>()));
+}
+
+TEST_F(SimpleIndexTest, DiskWriteCompactsJournal) {
+  for (size_t i = 0; i < hashes_.size; ++i)
+    InsertIntoIndexFileReturn(HashesInitializer(i), base::Time::Now(), 10);
+  index_file_->load_result()->journal_loaded = true;
+  ReturnIndexFile();
+
+  // Each write appends a change and the end of its batch.
+  index()->UseIfExists(hashes_.at<1>());
+  index()->WriteToDisk();
+  index()->UseIfExists(hashes_.at<2>());
+  index()->WriteToDisk();
+  EXPECT_EQ(0, index_file_->disk_writes());
+  EXPECT_EQ(2, index_file_->journal_appends());
+  EXPECT_EQ(1u, index_file_->journal_changed_entries().size());
+  EXPECT_EQ(1u, index_file_->journal_changed_entries().count(hashes_.at<2>()));
+
+  // More records than a quarter of the entries rewrite the index file, which
+  // has an empty journal.
+  index()->UseIfExists(hashes_.at<3>());
+  index()->WriteToDisk();
+  EXPECT_EQ(1, index_file_->disk_writes());
+  EXPECT_EQ(2, index_file_->journal_appends());
+
+  index()->UseIfExists(hashes_.at<4>());
+  index()->WriteToDisk();
+  EXPECT_EQ(1, index_file_->disk_writes());
+  EXPECT_EQ(3, index_file_->journal_appends());
+  index()->write_to_disk_timer_.Stop();
+}
+
 }  // namespace disk_cache
@@ -103,6 +103,13 @@ void RecordCloseResult(net::CacheType cache_type, CloseResult result) {
                    "SyncCloseResult", cache_type, result, WRITE_RESULT_MAX);
 }
 
+// Streams growing past this size are likely to be media, and get disk space
+// preallocated ahead of their writes so that they are stored contiguously.
+const int64 kMinPreallocatedFileLength = 1024 * 1024;
+
+// The most disk space preallocated for a file at once.
+const int64 kMaxPreallocationLength = 16 * 1024 * 1024;
+
 bool CanOmitEmptyFile(int file_index) {
   DCHECK_LE(0, file_index);
   DCHECK_GT(disk_cache::kSimpleEntryFileCount, file_index);
@@ -347,14 +354,22 @@ void SimpleSynchronousEntry::WriteData(const EntryOperationData& in_entry_op,
   DCHECK(!empty_file_omitted_[file_index]);
 
   if (extending_by_write) {
-    // The EOF record and the eventual stream afterward need to be zeroed out.
+    // The EOF record and the eventual stream afterward need to be zeroed out,
+    // unless the write overwrites all of them, as appends of stream data
+    // usually do. Skipping the truncation then keeps preallocated space.
     const int64 file_eof_offset =
         out_entry_stat->GetEOFOffsetInFile(key_, index);
-    if (!files_[file_index].SetLength(file_eof_offset)) {
-      RecordWriteResult(cache_type_, WRITE_RESULT_PRETRUNCATE_FAILURE);
-      Doom();
-      *out_result = net::ERR_CACHE_WRITE_FAILURE;
-      return;
+    const int64 file_length = files_[file_index].GetLength();
+    if (file_length < 0 || offset > out_entry_stat->data_size(index) ||
+        file_offset + buf_len < file_length) {
+      if (!files_[file_index].SetLength(file_eof_offset)) {
+        RecordWriteResult(cache_type_, WRITE_RESULT_PRETRUNCATE_FAILURE);
+        Doom();
+        *out_result = net::ERR_CACHE_WRITE_FAILURE;
+        return;
+      }
+      if (file_index == 0)
+        preallocated_file_0_length_ = 0;
     }
   }
   if (buf_len > 0) {
@@ -378,7 +393,12 @@ void SimpleSynchronousEntry::WriteData(const EntryOperationData& in_entry_op,
       *out_result = net::ERR_CACHE_WRITE_FAILURE;
       return;
     }
+    // Extending writes only grow the file here.
+    if (file_index == 0 && !extending_by_write)
+      preallocated_file_0_length_ = 0;
   }
+  if (index == 1 && extending_by_write)
+    MaybePreallocateFile0(out_entry_stat->GetFileSize(key_, 0));
 
   RecordWriteResult(cache_type_, WRITE_RESULT_SUCCESS);
   base::Time modification_time = Time::Now();
@@ -668,6 +688,11 @@ void SimpleSynchronousEntry::Close(
       break;
     }
   }
+  // Release the space preallocated past the end of file 0.
+  const int64 file_0_size = entry_stat.GetFileSize(key_, 0);
+  if (preallocated_file_0_length_ > file_0_size)
+    files_[0].SetLength(file_0_size);
+
   for (int i = 0; i < kSimpleEntryFileCount; ++i) {
     if (empty_file_omitted_[i])
       continue;
@@ -705,7 +730,8 @@ SimpleSynchronousEntry::SimpleSynchronousEntry(net::CacheType cache_type,
       entry_hash_(entry_hash),
       key_(key),
       have_open_files_(false),
-      initialized_(false) {
+      initialized_(false),
+      preallocated_file_0_length_(0) {
   for (int i = 0; i < kSimpleEntryFileCount; ++i)
     empty_file_omitted_[i] = false;
 }
@@ -1431,4 +1457,21 @@ bool SimpleSynchronousEntry::AppendSparseRange(int64 offset,
   return true;
 }
 
+void SimpleSynchronousEntry::MaybePreallocateFile0(int64 file_length) {
+  if (file_length < kMinPreallocatedFileLength ||
+      file_length <= preallocated_file_0_length_) {
+    return;
+  }
+  // Growing the preallocation with the file keeps the number of extents of
+  // even very large streams low, and their unused space bounded until Close().
+  const int64 length = std::min(file_length, kMaxPreallocationLength);
+  bool preallocated =
+      simple_util::PreallocateFileSpace(&files_[0], file_length, length);
+  SIMPLE_CACHE_UMA(BOOLEAN, "PreallocateFileSuccess", cache_type_,
+                   preallocated);
+  // Failures aren't retried, as they are mostly file systems that don't
+  // support preallocation.
+  preallocated_file_0_length_ = file_length + length;
+}
+
 }  // namespace disk_cache
@@ -294,6 +294,11 @@ class SimpleSynchronousEntry {
   // Appends a new sparse range to the sparse data file.
   bool AppendSparseRange(int64 offset, int len, const char* buf);
 
+  // Preallocates disk space ahead of |file_length|, the new length of file 0
+  // after a write extending stream 1, once the file is large enough that the
+  // stream is likely to be media.
+  void MaybePreallocateFile0(int64 file_length);
+
   static bool DeleteFileForEntryHash(const base::FilePath& path,
                                      uint64 entry_hash,
                                      int file_index);
@@ -333,6 +338,10 @@ class SimpleSynchronousEntry {
   // True if the entry was created, or false if it was opened. Used to log
   // SimpleCache.*.EntryCreatedWithStream2Omitted only for created entries.
   bool files_created_;
+
+  // The length of file 0 up to which disk space has been preallocated, or 0.
+  // Truncating the file releases the preallocated space.
+  int64 preallocated_file_0_length_;
 };
 
 }  // namespace disk_cache
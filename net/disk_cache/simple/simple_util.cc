@@ -7,6 +7,7 @@
 #include <limits>
 
 #include "base/file_util.h"
+#include "base/files/file.h"
 #include "base/format_macros.h"
 #include "base/logging.h"
 #include "base/sha1.h"
@@ -16,6 +17,13 @@
 #include "base/time/time.h"
 #include "net/disk_cache/simple/simple_entry_format.h"
 
+#if defined(OS_LINUX)
+#include <fcntl.h>
+#include <linux/falloc.h>
+
+#include "base/posix/eintr_wrapper.h"
+#endif
+
 namespace {
 
 // Size of the uint64 hash_key number in Hex format in a string.
@@ -132,6 +140,19 @@ bool GetMTime(const base::FilePath& path, base::Time* out_mtime) {
   return true;
 }
 
+bool PreallocateFileSpace(base::File* file, int64 offset, int64 length) {
+  DCHECK(file->IsValid());
+#if defined(OS_LINUX)
+  base::ThreadRestrictions::AssertIOAllowed();
+  return HANDLE_EINTR(fallocate(file->GetPlatformFile(),
+                                FALLOC_FL_KEEP_SIZE,
+                                offset,
+                                length)) == 0;
+#else
+  return false;
+#endif
+}
+
 }  // namespace simple_backend
 
 }  // namespace disk_cache
@@ -12,6 +12,7 @@
 #include "net/base/net_export.h"
 
 namespace base {
+class File;
 class FilePath;
 class Time;
 }
@@ -69,6 +70,14 @@ NET_EXPORT_PRIVATE int GetFileIndexFromStreamIndex(int stream_index);
 // functions in file.h, the time resolution is milliseconds.
 NET_EXPORT_PRIVATE bool GetMTime(const base::FilePath& path,
                                  base::Time* out_mtime);
+
+// Reserves disk space for the |length| bytes of |file| after |offset|, without
+// changing the size of the file, so that a file growing by many small writes
+// is stored contiguously. Returns false if the platform or the file system
+// doesn't support preallocation.
+NET_EXPORT_PRIVATE bool PreallocateFileSpace(base::File* file,
+                                             int64 offset,
+                                             int64 length);
 }  // namespace simple_backend
 
 }  // namespace disk_cache
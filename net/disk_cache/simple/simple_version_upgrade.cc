@@ -76,6 +76,10 @@ FakeIndexData::FakeIndexData() {
 //   V5: $cachedir/the-real-index
 //   V6: $cachedir/index-dir/the-real-index
 //
+// V6 index files may be followed by $cachedir/index-dir/the-real-index-journal,
+// which names the index file it applies to by its CRC. Index files without a
+// journal remain valid, so the journal needs no upgrade.
+//
 // Pickled file format:
 //   Both formats extend Pickle::Header by 32bit value of the CRC-32 of the
 //   pickled data.
@@ -8,10 +8,23 @@
 #include "base/metrics/field_trial.h"
 #include "base/metrics/histogram.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/values.h"
 #include "net/base/net_errors.h"
+#include "net/base/net_util.h"
 
 namespace net {
 
+namespace {
+
+// Keys of the dictionaries written by HostCache::GetAsListValue().
+const char kHostnameKey[] = "hostname";
+const char kAddressFamilyKey[] = "address_family";
+const char kFlagsKey[] = "flags";
+const char kExpirationKey[] = "expiration";
+const char kAddressesKey[] = "addresses";
+
+}  // namespace
+
 //-----------------------------------------------------------------------------
 
 HostCache::Entry::Entry(int error, const AddressList& addrlist,
@@ -49,6 +62,20 @@ const HostCache::Entry* HostCache::Lookup(const Key& key,
   return entries_.Get(key, now);
 }
 
+const HostCache::Entry* HostCache::LookupStale(const Key& key,
+                                               base::TimeTicks now,
+                                               bool* is_stale) const {
+  DCHECK(CalledOnValidThread());
+  if (caching_is_disabled())
+    return NULL;
+
+  base::TimeTicks expiration;
+  const Entry* entry = entries_.GetIgnoringExpiration(key, &expiration);
+  if (entry)
+    *is_stale = now >= expiration;
+  return entry;
+}
+
 void HostCache::Set(const Key& key,
                     const Entry& entry,
                     base::TimeTicks now,
@@ -70,6 +97,90 @@ size_t HostCache::size() const {
   return entries_.size();
 }
 
+void HostCache::GetAsListValue(base::TimeTicks now,
+                               base::Time wall_now,
+                               base::ListValue* entries) const {
+  DCHECK(CalledOnValidThread());
+
+  for (EntryMap::Iterator it(entries_); it.HasNext(); it.Advance()) {
+    const Key& key = it.key();
+    const Entry& entry = it.value();
+    // Failures are cached only briefly and are not worth keeping.
+    if (entry.error != OK)
+      continue;
+
+    base::ListValue* addresses = new base::ListValue();
+    for (size_t i = 0; i < entry.addrlist.size(); ++i)
+      addresses->AppendString(entry.addrlist[i].ToStringWithoutPort());
+
+    base::DictionaryValue* value = new base::DictionaryValue();
+    value->SetString(kHostnameKey, key.hostname);
+    value->SetInteger(kAddressFamilyKey,
+                      static_cast<int>(key.address_family));
+    value->SetInteger(kFlagsKey, key.host_resolver_flags);
+    value->SetDouble(kExpirationKey,
+                     (wall_now + (it.expiration() - now)).ToDoubleT());
+    value->Set(kAddressesKey, addresses);
+    entries->Append(value);
+  }
+}
+
+bool HostCache::RestoreFromListValue(const base::ListValue& entries,
+                                     base::TimeTicks now,
+                                     base::Time wall_now) {
+  DCHECK(CalledOnValidThread());
+  if (caching_is_disabled())
+    return true;
+
+  bool success = true;
+  for (size_t i = 0; i < entries.GetSize(); ++i) {
+    if (entries_.size() >= entries_.max_entries())
+      break;
+
+    const base::DictionaryValue* value = NULL;
+    std::string hostname;
+    int address_family;
+    int flags;
+    double expiration;
+    const base::ListValue* addresses = NULL;
+    if (!entries.GetDictionary(i, &value) ||
+        !value->GetString(kHostnameKey, &hostname) ||
+        !value->GetInteger(kAddressFamilyKey, &address_family) ||
+        !value->GetInteger(kFlagsKey, &flags) ||
+        !value->GetDouble(kExpirationKey, &expiration) ||
+        !value->GetList(kAddressesKey, &addresses) ||
+        address_family < ADDRESS_FAMILY_UNSPECIFIED ||
+        address_family > ADDRESS_FAMILY_LAST) {
+      success = false;
+      continue;
+    }
+
+    AddressList addrlist;
+    for (size_t j = 0; j < addresses->GetSize(); ++j) {
+      std::string address_string;
+      IPAddressNumber address;
+      if (!addresses->GetString(j, &address_string) ||
+          !ParseIPLiteralToNumber(address_string, &address)) {
+        success = false;
+        addrlist = AddressList();
+        break;
+      }
+      addrlist.push_back(IPEndPoint(address, 0));
+    }
+    if (addrlist.empty())
+      continue;
+
+    Key key(hostname, static_cast<AddressFamily>(address_family), flags);
+    base::TimeTicks expiration_ticks;
+    if (entries_.GetIgnoringExpiration(key, &expiration_ticks))
+      continue;
+
+    expiration_ticks = now + (base::Time::FromDoubleT(expiration) - wall_now);
+    entries_.Put(key, Entry(OK, addrlist), now, expiration_ticks);
+  }
+  return success;
+}
+
 size_t HostCache::max_entries() const {
   DCHECK(CalledOnValidThread());
   return entries_.max_entries();
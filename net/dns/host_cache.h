@@ -17,6 +17,10 @@
 #include "net/base/expiring_cache.h"
 #include "net/base/net_export.h"
 
+namespace base {
+class ListValue;
+}
+
 namespace net {
 
 // Cache used by HostResolver to map hostnames to their resolved result.
@@ -82,6 +86,14 @@ class NET_EXPORT HostCache : NON_EXPORTED_BASE(public base::NonThreadSafe) {
   // |now|. If there is no such entry, returns NULL.
   const Entry* Lookup(const Key& key, base::TimeTicks now);
 
+  // Like Lookup(), but also returns the entry for |key| if it expired before
+  // |now|, in which case |*is_stale| is set to true. Unlike Lookup(), this
+  // does not remove expired entries, which stay in the cache until it needs
+  // room for new ones.
+  const Entry* LookupStale(const Key& key,
+                           base::TimeTicks now,
+                           bool* is_stale) const;
+
   // Overwrites or creates an entry for |key|.
   // |entry| is the value to set, |now| is the current time
   // |ttl| is the "time to live".
@@ -96,6 +108,20 @@ class NET_EXPORT HostCache : NON_EXPORTED_BASE(public base::NonThreadSafe) {
   // Returns the number of entries in the cache.
   size_t size() const;
 
+  // Appends a dictionary to |entries| for each successful entry in the
+  // cache, including expired ones. Expiration times are converted to wall
+  // clock time using the current times |now| and |wall_now|.
+  void GetAsListValue(base::TimeTicks now,
+                      base::Time wall_now,
+                      base::ListValue* entries) const;
+
+  // Adds the entries serialized by GetAsListValue() to the cache, keeping the
+  // existing entry for a key and stopping once the cache is full. Returns
+  // false if any of |entries| could not be parsed.
+  bool RestoreFromListValue(const base::ListValue& entries,
+                            base::TimeTicks now,
+                            base::Time wall_now);
+
   // Following are used by net_internals UI.
   size_t max_entries() const;
 
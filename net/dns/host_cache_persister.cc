@@ -0,0 +1,85 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/dns/host_cache_persister.h"
+
+#include "base/bind.h"
+#include "base/file_util.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/sequenced_task_runner.h"
+#include "base/task_runner_util.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "net/dns/host_cache.h"
+
+namespace net {
+
+namespace {
+
+std::string LoadEntriesFromFile(const base::FilePath& path) {
+  std::string result;
+  if (!base::ReadFileToString(path, &result))
+    return std::string();
+  return result;
+}
+
+}  // namespace
+
+HostCachePersister::HostCachePersister(
+    HostCache* cache,
+    const base::FilePath& path,
+    base::SequencedTaskRunner* background_runner)
+    : cache_(cache),
+      writer_(path, background_runner),
+      weak_ptr_factory_(this) {
+  DCHECK(cache_);
+  base::PostTaskAndReplyWithResult(
+      background_runner,
+      FROM_HERE,
+      base::Bind(&LoadEntriesFromFile, path),
+      base::Bind(&HostCachePersister::CompleteLoad,
+                 weak_ptr_factory_.GetWeakPtr()));
+}
+
+HostCachePersister::~HostCachePersister() {
+  DCHECK(CalledOnValidThread());
+
+  std::string data;
+  if (SerializeData(&data))
+    writer_.WriteNow(data);
+}
+
+bool HostCachePersister::SerializeData(std::string* data) {
+  DCHECK(CalledOnValidThread());
+
+  base::ListValue entries;
+  cache_->GetAsListValue(base::TimeTicks::Now(), base::Time::Now(), &entries);
+  return base::JSONWriter::Write(&entries, data);
+}
+
+bool HostCachePersister::LoadEntries(const std::string& serialized) {
+  DCHECK(CalledOnValidThread());
+
+  scoped_ptr<base::Value> value(base::JSONReader::Read(serialized));
+  base::ListValue* entries = NULL;
+  if (!value || !value->GetAsList(&entries))
+    return false;
+  return cache_->RestoreFromListValue(*entries, base::TimeTicks::Now(),
+                                      base::Time::Now());
+}
+
+void HostCachePersister::CompleteLoad(const std::string& serialized) {
+  DCHECK(CalledOnValidThread());
+
+  if (serialized.empty())
+    return;
+
+  if (!LoadEntries(serialized))
+    LOG(WARNING) << "Failed to load some of the persisted host cache entries";
+}
+
+}  // namespace net
@@ -0,0 +1,69 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_DNS_HOST_CACHE_PERSISTER_H_
+#define NET_DNS_HOST_CACHE_PERSISTER_H_
+
+#include <string>
+
+#include "base/compiler_specific.h"
+#include "base/files/file_path.h"
+#include "base/files/important_file_writer.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/threading/non_thread_safe.h"
+#include "net/base/net_export.h"
+
+namespace base {
+class SequencedTaskRunner;
+}
+
+namespace net {
+
+class HostCache;
+
+// Keeps the successful entries of a HostCache across restarts, so that the
+// first resolutions after a restart can be answered, possibly with stale
+// addresses, without waiting for the network.
+//
+// The file is read on |background_runner| when the persister is created, and
+// the entries it contains are added to the cache once the read completes. The
+// cache is written back when the persister is destroyed, which must happen
+// before |cache| is destroyed. The file contains the hostnames which were
+// resolved, so it should only be used for profiles whose history is kept.
+class NET_EXPORT HostCachePersister
+    : public base::ImportantFileWriter::DataSerializer,
+      NON_EXPORTED_BASE(public base::NonThreadSafe) {
+ public:
+  HostCachePersister(HostCache* cache,
+                     const base::FilePath& path,
+                     base::SequencedTaskRunner* background_runner);
+  virtual ~HostCachePersister();
+
+  // ImportantFileWriter::DataSerializer:
+  //
+  // Serializes the entries of the cache as a JSON list, in the format of
+  // HostCache::GetAsListValue().
+  virtual bool SerializeData(std::string* data) OVERRIDE;
+
+  // Adds the entries of the JSON list |serialized| to the cache. Returns
+  // false if it could not be parsed.
+  bool LoadEntries(const std::string& serialized);
+
+ private:
+  void CompleteLoad(const std::string& serialized);
+
+  HostCache* cache_;
+
+  // Helper for safely writing the data.
+  base::ImportantFileWriter writer_;
+
+  base::WeakPtrFactory<HostCachePersister> weak_ptr_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(HostCachePersister);
+};
+
+}  // namespace net
+
+#endif  // NET_DNS_HOST_CACHE_PERSISTER_H_
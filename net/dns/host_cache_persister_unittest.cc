@@ -0,0 +1,112 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/dns/host_cache_persister.h"
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/message_loop/message_loop.h"
+#include "base/message_loop/message_loop_proxy.h"
+#include "base/time/time.h"
+#include "net/base/net_errors.h"
+#include "net/base/net_util.h"
+#include "net/dns/host_cache.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const size_t kMaxCacheEntries = 10;
+
+HostCache::Key Key(const std::string& hostname) {
+  return HostCache::Key(hostname, ADDRESS_FAMILY_UNSPECIFIED, 0);
+}
+
+class HostCachePersisterTest : public testing::Test {
+ public:
+  virtual void SetUp() OVERRIDE {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    path_ = temp_dir_.path().AppendASCII("HostCache");
+  }
+
+  virtual void TearDown() OVERRIDE {
+    base::MessageLoop::current()->RunUntilIdle();
+  }
+
+ protected:
+  scoped_ptr<HostCachePersister> CreatePersister(HostCache* cache) {
+    return make_scoped_ptr(new HostCachePersister(
+        cache, path_, base::MessageLoop::current()->message_loop_proxy()));
+  }
+
+  base::MessageLoopForIO message_loop_;
+  base::ScopedTempDir temp_dir_;
+  base::FilePath path_;
+};
+
+TEST_F(HostCachePersisterTest, SerializeAndLoadEntries) {
+  HostCache cache(kMaxCacheEntries);
+  scoped_ptr<HostCachePersister> persister = CreatePersister(&cache);
+
+  IPAddressNumber address;
+  ASSERT_TRUE(ParseIPLiteralToNumber("1.2.3.4", &address));
+  AddressList addrlist;
+  addrlist.push_back(IPEndPoint(address, 0));
+  cache.Set(Key("foobar.com"), HostCache::Entry(OK, addrlist),
+            base::TimeTicks::Now(), base::TimeDelta::FromSeconds(60));
+
+  std::string serialized;
+  EXPECT_TRUE(persister->SerializeData(&serialized));
+
+  HostCache other_cache(kMaxCacheEntries);
+  scoped_ptr<HostCachePersister> other_persister =
+      CreatePersister(&other_cache);
+  EXPECT_TRUE(other_persister->LoadEntries(serialized));
+  const HostCache::Entry* entry =
+      other_cache.Lookup(Key("foobar.com"), base::TimeTicks::Now());
+  ASSERT_TRUE(entry);
+  ASSERT_EQ(1u, entry->addrlist.size());
+  EXPECT_EQ("1.2.3.4", entry->addrlist[0].ToStringWithoutPort());
+
+  EXPECT_FALSE(other_persister->LoadEntries("{ not json"));
+}
+
+TEST_F(HostCachePersisterTest, EntriesSurviveRestart) {
+  IPAddressNumber address;
+  ASSERT_TRUE(ParseIPLiteralToNumber("1.2.3.4", &address));
+  AddressList addrlist;
+  addrlist.push_back(IPEndPoint(address, 0));
+
+  {
+    HostCache cache(kMaxCacheEntries);
+    scoped_ptr<HostCachePersister> persister = CreatePersister(&cache);
+    base::MessageLoop::current()->RunUntilIdle();
+    // An entry which expires right away is kept for stale lookups.
+    cache.Set(Key("foobar.com"), HostCache::Entry(OK, addrlist),
+              base::TimeTicks::Now(), base::TimeDelta());
+    // Destroying the persister writes the cache.
+    persister.reset();
+    base::MessageLoop::current()->RunUntilIdle();
+  }
+
+  HostCache cache(kMaxCacheEntries);
+  scoped_ptr<HostCachePersister> persister = CreatePersister(&cache);
+  EXPECT_EQ(0u, cache.size());
+  base::MessageLoop::current()->RunUntilIdle();
+
+  bool is_stale = false;
+  const HostCache::Entry* entry =
+      cache.LookupStale(Key("foobar.com"), base::TimeTicks::Now(), &is_stale);
+  ASSERT_TRUE(entry);
+  EXPECT_TRUE(is_stale);
+  EXPECT_EQ(OK, entry->error);
+}
+
+}  // namespace
+
+}  // namespace net
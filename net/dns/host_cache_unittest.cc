@@ -8,7 +8,9 @@
 #include "base/stl_util.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
+#include "base/values.h"
 #include "net/base/net_errors.h"
+#include "net/base/net_util.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace net {
@@ -296,6 +298,111 @@ TEST(HostCacheTest, Clear) {
   EXPECT_EQ(0u, cache.size());
 }
 
+TEST(HostCacheTest, LookupStale) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(10);
+
+  HostCache cache(kMaxCacheEntries);
+
+  // Set t=0.
+  base::TimeTicks now;
+
+  HostCache::Entry entry = HostCache::Entry(OK, AddressList());
+  bool is_stale = true;
+  EXPECT_FALSE(cache.LookupStale(Key("foobar.com"), now, &is_stale));
+
+  cache.Set(Key("foobar.com"), entry, now, kTTL);
+  EXPECT_TRUE(cache.LookupStale(Key("foobar.com"), now, &is_stale));
+  EXPECT_FALSE(is_stale);
+
+  // Advance to t=10; the entry is stale but still returned.
+  now += kTTL;
+  EXPECT_TRUE(cache.LookupStale(Key("foobar.com"), now, &is_stale));
+  EXPECT_TRUE(is_stale);
+  EXPECT_EQ(1u, cache.size());
+
+  // Lookup() does not return it, and removes it.
+  EXPECT_FALSE(cache.Lookup(Key("foobar.com"), now));
+  EXPECT_FALSE(cache.LookupStale(Key("foobar.com"), now, &is_stale));
+}
+
+TEST(HostCacheTest, SerializeAndRestore) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(10);
+
+  HostCache cache(kMaxCacheEntries);
+
+  // Set t=0.
+  base::TimeTicks now;
+  base::Time wall_now = base::Time::Now();
+
+  IPAddressNumber address;
+  ASSERT_TRUE(ParseIPLiteralToNumber("1.2.3.4", &address));
+  AddressList addrlist;
+  addrlist.push_back(IPEndPoint(address, 0));
+  ASSERT_TRUE(ParseIPLiteralToNumber("::1", &address));
+  addrlist.push_back(IPEndPoint(address, 0));
+
+  cache.Set(Key("foobar.com"), HostCache::Entry(OK, addrlist), now, kTTL);
+  cache.Set(HostCache::Key("foobar.com", ADDRESS_FAMILY_IPV4, 0),
+            HostCache::Entry(OK, addrlist), now, kTTL + kTTL);
+  // Failures are not serialized.
+  cache.Set(Key("failure.com"),
+            HostCache::Entry(ERR_NAME_NOT_RESOLVED, AddressList()), now,
+            kTTL);
+
+  base::ListValue serialized;
+  cache.GetAsListValue(now, wall_now, &serialized);
+  EXPECT_EQ(2u, serialized.GetSize());
+
+  // Restore an hour later, after a restart which reset the tick clock, into
+  // a cache which already has a fresher entry for one of the keys.
+  HostCache restored_cache(kMaxCacheEntries);
+  base::TimeTicks restored_now;
+  base::Time restored_wall_now = wall_now + base::TimeDelta::FromHours(1);
+  restored_cache.Set(Key("foobar.com"), HostCache::Entry(OK, AddressList()),
+                     restored_now, kTTL);
+  EXPECT_TRUE(restored_cache.RestoreFromListValue(serialized, restored_now,
+                                                  restored_wall_now));
+  EXPECT_EQ(2u, restored_cache.size());
+
+  bool is_stale = false;
+  const HostCache::Entry* entry =
+      restored_cache.LookupStale(Key("foobar.com"), restored_now, &is_stale);
+  ASSERT_TRUE(entry);
+  EXPECT_FALSE(is_stale);
+  EXPECT_TRUE(entry->addrlist.empty());
+
+  entry = restored_cache.LookupStale(
+      HostCache::Key("foobar.com", ADDRESS_FAMILY_IPV4, 0),
+      restored_now, &is_stale);
+  ASSERT_TRUE(entry);
+  EXPECT_TRUE(is_stale);
+  EXPECT_EQ(OK, entry->error);
+  ASSERT_EQ(2u, entry->addrlist.size());
+  EXPECT_EQ("1.2.3.4", entry->addrlist[0].ToStringWithoutPort());
+  EXPECT_EQ("::1", entry->addrlist[1].ToStringWithoutPort());
+  EXPECT_FALSE(restored_cache.Lookup(Key("failure.com"), restored_now));
+}
+
+TEST(HostCacheTest, RestoreRejectsInvalidEntries) {
+  HostCache cache(kMaxCacheEntries);
+
+  base::ListValue serialized;
+  serialized.AppendString("not a dictionary");
+  base::DictionaryValue* entry = new base::DictionaryValue();
+  entry->SetString("hostname", "foobar.com");
+  entry->SetInteger("address_family", ADDRESS_FAMILY_UNSPECIFIED);
+  entry->SetInteger("flags", 0);
+  entry->SetDouble("expiration", base::Time::Now().ToDoubleT());
+  base::ListValue* addresses = new base::ListValue();
+  addresses->AppendString("not an address");
+  entry->Set("addresses", addresses);
+  serialized.Append(entry);
+
+  EXPECT_FALSE(cache.RestoreFromListValue(serialized, base::TimeTicks(),
+                                          base::Time::Now()));
+  EXPECT_EQ(0u, cache.size());
+}
+
 // Tests the less than and equal operators for HostCache::Key work.
 TEST(HostCacheTest, KeyComparators) {
   struct {
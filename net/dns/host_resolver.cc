@@ -121,11 +121,13 @@ HostResolver::CreateSystemResolver(const Options& options, NetLog* net_log) {
   scoped_ptr<HostCache> cache;
   if (options.enable_caching)
     cache = HostCache::CreateDefaultCache();
-  return scoped_ptr<HostResolver>(new HostResolverImpl(
+  scoped_ptr<HostResolverImpl> resolver(new HostResolverImpl(
       cache.Pass(),
       GetDispatcherLimits(options),
       HostResolverImpl::ProcTaskParams(NULL, options.max_retry_attempts),
       net_log));
+  resolver->set_stale_result_delay(options.stale_result_delay);
+  return resolver.PassAs<HostResolver>();
 }
 
 // static
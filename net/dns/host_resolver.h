@@ -8,6 +8,7 @@
 #include <string>
 
 #include "base/memory/scoped_ptr.h"
+#include "base/time/time.h"
 #include "net/base/address_family.h"
 #include "net/base/completion_callback.h"
 #include "net/base/host_port_pair.h"
@@ -45,12 +46,16 @@ class NET_EXPORT HostResolver {
   // resolution. Pass HostResolver::kDefaultRetryAttempts to choose a default
   // value.
   // |enable_caching| controls whether a HostCache is used.
+  // |stale_result_delay|, if positive, is how long a request waits for a
+  // resolution before it is answered with an expired cache entry instead.
+  // Pass base::TimeDelta() to never serve expired entries.
   struct NET_EXPORT Options {
     Options();
 
     size_t max_concurrent_resolves;
     size_t max_retry_attempts;
     bool enable_caching;
+    base::TimeDelta stale_result_delay;
   };
 
   // The parameters for doing a Resolve(). A hostname and port are
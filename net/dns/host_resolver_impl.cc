@@ -29,6 +29,7 @@
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/worker_pool.h"
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "base/values.h"
 #include "net/base/address_family.h"
 #include "net/base/address_list.h"
@@ -1207,10 +1208,12 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
         had_dns_config_(false),
         num_occupied_job_slots_(0),
         dns_task_error_(OK),
+        served_stale_entry_(false),
         creation_time_(base::TimeTicks::Now()),
         priority_change_time_(creation_time_),
         net_log_(BoundNetLog::Make(request_net_log.net_log(),
-                                   NetLog::SOURCE_HOST_RESOLVER_IMPL_JOB)) {
+                                   NetLog::SOURCE_HOST_RESOLVER_IMPL_JOB)),
+        weak_ptr_factory_(this) {
     request_net_log.AddEvent(NetLog::TYPE_HOST_RESOLVER_IMPL_CREATE_JOB);
 
     net_log_.BeginEvent(
@@ -1316,7 +1319,8 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
                                  req->request_net_log().source(),
                                  priority()));
 
-    if (num_active_requests() > 0) {
+    if (num_active_requests() > 0 || served_stale_entry_) {
+      // A Job which served a stale entry keeps running to refresh it.
       UpdatePriority();
     } else {
       // If we were called from a Request's callback within CompleteRequests,
@@ -1326,6 +1330,16 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
     }
   }
 
+  // Serves the Requests which are still waiting with the addresses of the
+  // expired |stale_entry| if this Job has not completed within |delay|.
+  void ServeStaleEntryAfter(const HostCache::Entry& stale_entry,
+                            base::TimeDelta delay) {
+    DCHECK_EQ(OK, stale_entry.error);
+    stale_addresses_ = stale_entry.addrlist;
+    if (!stale_timer_.IsRunning())
+      stale_timer_.Start(FROM_HERE, delay, this, &Job::OnStaleTimer);
+  }
+
   // Called from AbortAllInProgressJobs. Completes all requests and destroys
   // the job. This currently assumes the abort is due to a network change.
   void Abort() {
@@ -1408,6 +1422,39 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
     DCHECK_EQ(1u, num_occupied_job_slots_);
   }
 
+  // Completes the waiting Requests with |stale_addresses_|. The Job keeps
+  // running without them so that it caches the fresh result.
+  void OnStaleTimer() {
+    served_stale_entry_ = true;
+    net_log_.AddEvent(NetLog::TYPE_HOST_RESOLVER_IMPL_JOB_SERVED_STALE);
+
+    std::vector<Request*> waiting_requests;
+    for (RequestsList::const_iterator it = requests_.begin();
+         it != requests_.end(); ++it) {
+      if (!(*it)->was_canceled())
+        waiting_requests.push_back(*it);
+    }
+
+    // A callback could destroy the resolver, and this Job with it, or evict
+    // this Job from the queue.
+    base::WeakPtr<Job> self = weak_ptr_factory_.GetWeakPtr();
+    for (size_t i = 0; i < waiting_requests.size(); ++i) {
+      Request* req = waiting_requests[i];
+      // An earlier callback could have cancelled it.
+      if (req->was_canceled())
+        continue;
+
+      DCHECK_EQ(this, req->job());
+      priority_tracker_.Remove(req->priority());
+      LogFinishRequest(req->source_net_log(), req->request_net_log(),
+                       req->info(), OK);
+      req->OnComplete(OK, stale_addresses_);
+      if (!self.get())
+        return;
+    }
+    UpdatePriority();
+  }
+
   void UpdatePriority() {
     if (is_queued()) {
       if (priority() != static_cast<RequestPriority>(handle_.priority()))
@@ -1665,7 +1712,14 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
       handle_.Reset();
     }
 
+    bool did_complete = (entry.error != ERR_NETWORK_CHANGED) &&
+                        (entry.error != ERR_HOST_RESOLVER_QUEUE_TOO_LARGE);
+
     if (num_active_requests() == 0) {
+      // Refresh the stale entry the Requests were served, but keep it if the
+      // resolution failed.
+      if (served_stale_entry_ && did_complete && entry.error == OK)
+        resolver_->CacheResult(key_, entry, ttl);
       net_log_.AddEvent(NetLog::TYPE_CANCELLED);
       net_log_.EndEventWithNetErrorCode(NetLog::TYPE_HOST_RESOLVER_IMPL_JOB,
                                         OK);
@@ -1684,8 +1738,6 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
                             resolver_->received_dns_config_);
     }
 
-    bool did_complete = (entry.error != ERR_NETWORK_CHANGED) &&
-                        (entry.error != ERR_HOST_RESOLVER_QUEUE_TOO_LARGE);
     if (did_complete)
       resolver_->CacheResult(key_, entry, ttl);
 
@@ -1756,6 +1808,13 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
   // Result of DnsTask.
   int dns_task_error_;
 
+  // Addresses of the expired cache entry served by |stale_timer_|.
+  AddressList stale_addresses_;
+  base::OneShotTimer<Job> stale_timer_;
+
+  // True once Requests were served |stale_addresses_|.
+  bool served_stale_entry_;
+
   const base::TimeTicks creation_time_;
   base::TimeTicks priority_change_time_;
 
@@ -1772,6 +1831,8 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
 
   // A handle used in |HostResolverImpl::dispatcher_|.
   PrioritizedDispatcher::Handle handle_;
+
+  base::WeakPtrFactory<Job> weak_ptr_factory_;
 };
 
 //-----------------------------------------------------------------------------
@@ -1922,6 +1983,19 @@ int HostResolverImpl::Resolve(const RequestInfo& info,
     *out_req = reinterpret_cast<RequestHandle>(req.get());
 
   job->AddRequest(req.Pass());
+
+  // An expired entry answers the request if the resolution is slow.
+  if (stale_result_delay_ > base::TimeDelta() &&
+      info.allow_cached_response() && cache_.get()) {
+    bool is_stale = false;
+    const HostCache::Entry* stale_entry =
+        cache_->LookupStale(key, base::TimeTicks::Now(), &is_stale);
+    if (stale_entry && stale_entry->error == OK) {
+      DCHECK(is_stale);
+      job->ServeStaleEntryAfter(*stale_entry, stale_result_delay_);
+    }
+  }
+
   // Completion happens during Job::CompleteRequests().
   return ERR_IO_PENDING;
 }
@@ -2056,9 +2130,14 @@ bool HostResolverImpl::ServeFromCache(const Key& key,
   if (!info.allow_cached_response() || !cache_.get())
     return false;
 
-  const HostCache::Entry* cache_entry = cache_->Lookup(
-      key, base::TimeTicks::Now());
-  if (!cache_entry)
+  // Expired entries are kept for Resolve() to serve if the resolution is
+  // slow.
+  bool is_stale = false;
+  const HostCache::Entry* cache_entry =
+      stale_result_delay_ > base::TimeDelta() ?
+          cache_->LookupStale(key, base::TimeTicks::Now(), &is_stale) :
+          cache_->Lookup(key, base::TimeTicks::Now());
+  if (!cache_entry || is_stale)
     return false;
 
   *net_error = cache_entry->error;
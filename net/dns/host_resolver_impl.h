@@ -123,6 +123,14 @@ class NET_EXPORT HostResolverImpl
   // Only allowed when the queue is empty.
   void SetMaxQueuedJobs(size_t value);
 
+  // Answers requests which miss the cache with an expired entry for their
+  // host, if the cache still has one, once they have waited |delay| for the
+  // resolution. The resolution carries on and refreshes the cache. A zero
+  // |delay|, the default, never serves expired entries.
+  void set_stale_result_delay(base::TimeDelta delay) {
+    stale_result_delay_ = delay;
+  }
+
   // Set the DnsClient to be used for resolution. In case of failure, the
   // HostResolverProc from ProcTaskParams will be queried. If the DnsClient is
   // not pre-configured with a valid DnsConfig, a new config is fetched from
@@ -253,6 +261,10 @@ class NET_EXPORT HostResolverImpl
   // Limit on the maximum number of jobs queued in |dispatcher_|.
   size_t max_queued_jobs_;
 
+  // How long a Request waits before it is served an expired cache entry.
+  // Expired entries are never served if zero.
+  base::TimeDelta stale_result_delay_;
+
   // Parameters for ProcTask.
   ProcTaskParams proc_params_;
 
@@ -887,6 +887,68 @@ TEST_F(HostResolverImplTest, BypassCache) {
   EXPECT_EQ(2u, proc_->GetCaptureList().size());
 }
 
+// Test that a request for which the resolution is slow is answered with an
+// expired cache entry, and that the resolution still refreshes the cache.
+TEST_F(HostResolverImplTest, ServeStaleEntryOnSlowResolution) {
+  resolver_->set_stale_result_delay(base::TimeDelta::FromMilliseconds(1));
+  proc_->AddRule("just.testing", ADDRESS_FAMILY_IPV4, "192.168.1.42");
+
+  // An entry which expired a second ago.
+  const HostCache::Key key("just.testing", ADDRESS_FAMILY_IPV4, 0);
+  IPAddressNumber stale_address;
+  ASSERT_TRUE(ParseIPLiteralToNumber("192.168.1.1", &stale_address));
+  resolver_->GetHostCache()->Set(
+      key,
+      HostCache::Entry(OK, AddressList::CreateFromIPAddress(stale_address, 0)),
+      base::TimeTicks::Now() - base::TimeDelta::FromSeconds(2),
+      base::TimeDelta::FromSeconds(1));
+
+  // |proc_| is blocked, so the stale entry answers the request.
+  Request* req = CreateRequest("just.testing", 80, MEDIUM,
+                               ADDRESS_FAMILY_IPV4);
+  EXPECT_EQ(ERR_IO_PENDING, req->Resolve());
+  EXPECT_EQ(OK, req->WaitForResult());
+  EXPECT_TRUE(req->HasOneAddress("192.168.1.1", 80));
+
+  // A request which bypasses the cache attaches to the resolution, which is
+  // still running.
+  HostResolver::RequestInfo info(HostPortPair("just.testing", 81));
+  info.set_address_family(ADDRESS_FAMILY_IPV4);
+  info.set_allow_cached_response(false);
+  req = CreateRequest(info, MEDIUM);
+  EXPECT_EQ(ERR_IO_PENDING, req->Resolve());
+  proc_->SignalMultiple(1u);
+  EXPECT_EQ(OK, req->WaitForResult());
+  EXPECT_TRUE(req->HasOneAddress("192.168.1.42", 81));
+  EXPECT_EQ(1u, proc_->GetCaptureList().size());
+
+  // The fresh result replaced the stale entry.
+  req = CreateRequest("just.testing", 82, MEDIUM, ADDRESS_FAMILY_IPV4);
+  EXPECT_EQ(OK, req->Resolve());
+  EXPECT_TRUE(req->HasOneAddress("192.168.1.42", 82));
+}
+
+// Test that expired entries are not served without a stale result delay.
+TEST_F(HostResolverImplTest, StaleEntryNotServedByDefault) {
+  proc_->AddRule("just.testing", ADDRESS_FAMILY_IPV4, "192.168.1.42");
+
+  const HostCache::Key key("just.testing", ADDRESS_FAMILY_IPV4, 0);
+  IPAddressNumber stale_address;
+  ASSERT_TRUE(ParseIPLiteralToNumber("192.168.1.1", &stale_address));
+  resolver_->GetHostCache()->Set(
+      key,
+      HostCache::Entry(OK, AddressList::CreateFromIPAddress(stale_address, 0)),
+      base::TimeTicks::Now() - base::TimeDelta::FromSeconds(2),
+      base::TimeDelta::FromSeconds(1));
+
+  Request* req = CreateRequest("just.testing", 80, MEDIUM,
+                               ADDRESS_FAMILY_IPV4);
+  EXPECT_EQ(ERR_IO_PENDING, req->Resolve());
+  proc_->SignalMultiple(1u);
+  EXPECT_EQ(OK, req->WaitForResult());
+  EXPECT_TRUE(req->HasOneAddress("192.168.1.42", 80));
+}
+
 // Test that IP address changes flush the cache.
 TEST_F(HostResolverImplTest, FlushCacheOnIPAddressChange) {
   proc_->SignalMultiple(2u);  // One before the flush, one after.
@@ -28,8 +28,10 @@ const char kApplicationGzip[]      = "application/gzip";
 const char kApplicationXGunzip[]   = "application/x-gunzip";
 const char kTextHtml[]             = "text/html";
 
-// Buffer size allocated when de-compressing data.
-const int kFilterBufSize = 32 * 1024;
+// Buffer size allocated when de-compressing data. This bounds how much raw
+// data each network read hands to the filter, and so how many inflate calls
+// a response takes; 64KB lets one read take a full TCP receive window.
+const int kFilterBufSize = 64 * 1024;
 
 }  // namespace
 
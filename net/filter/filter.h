@@ -197,6 +197,7 @@ class NET_EXPORT_PRIVATE Filter {
                                  std::vector<FilterType>* encoding_types);
 
  protected:
+  friend class GZipFilterPerfTest;
   friend class GZipUnitTest;
   friend class SdchFilterChainingTest;
 
@@ -0,0 +1,155 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/file_util.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/path_service.h"
+#include "base/rand_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "net/base/io_buffer.h"
+#include "net/filter/gzip_filter.h"
+#include "net/filter/mock_filter_context.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+#include "third_party/zlib/zlib.h"
+
+namespace net {
+
+namespace {
+
+const int kNumIterations = 50;
+
+// Roughly the size of a large page's compressed HTML.
+const size_t kPageSize = 512 * 1024;
+
+// Markup fragments that generated pages are made of, so that they compress
+// about as well as real HTML does.
+const char* const kFragments[] = {
+  "<div class=\"result\">", "</div>\n", "<a href=\"http://www.example.com/",
+  "\">", "</a>", "<span class=\"title\">", "</span>", "<li>", "</li>\n",
+  "<script type=\"text/javascript\">var x = ", ";</script>\n",
+  "<img src=\"/images/", ".png\" width=\"", "\" height=\"", "\">",
+};
+
+// Returns a page of |size| bytes of markup with random words and numbers.
+std::string MakePage(size_t size) {
+  std::string page;
+  while (page.size() < size) {
+    page += kFragments[base::RandGenerator(arraysize(kFragments))];
+    page += base::StringPrintf("item%d", base::RandInt(0, 5000));
+  }
+  page.resize(size);
+  return page;
+}
+
+// Compresses |source| with a gzip header, as a server would.
+std::string GZip(const std::string& source) {
+  z_stream zlib_stream;
+  memset(&zlib_stream, 0, sizeof(zlib_stream));
+  // Window bits of 16 + MAX_WBITS ask zlib to write a gzip wrapper.
+  EXPECT_EQ(Z_OK, deflateInit2(&zlib_stream, Z_DEFAULT_COMPRESSION,
+                               Z_DEFLATED, 16 + MAX_WBITS, 8,
+                               Z_DEFAULT_STRATEGY));
+  std::string compressed(deflateBound(&zlib_stream, source.size()), '\0');
+  zlib_stream.next_in =
+      reinterpret_cast<Bytef*>(const_cast<char*>(source.data()));
+  zlib_stream.avail_in = source.size();
+  zlib_stream.next_out = reinterpret_cast<Bytef*>(&compressed[0]);
+  zlib_stream.avail_out = compressed.size();
+  EXPECT_EQ(Z_STREAM_END, deflate(&zlib_stream, Z_FINISH));
+  compressed.resize(compressed.size() - zlib_stream.avail_out);
+  deflateEnd(&zlib_stream);
+  return compressed;
+}
+
+}  // namespace
+
+// Not in the anonymous namespace so that it can be a friend of Filter.
+class GZipFilterPerfTest : public testing::Test {
+ protected:
+  virtual void SetUp() {
+    // The real page used by the GZipFilter unit tests, and a larger
+    // generated one.
+    base::FilePath file_path;
+    PathService::Get(base::DIR_SOURCE_ROOT, &file_path);
+    file_path = file_path.AppendASCII("net").AppendASCII("data")
+        .AppendASCII("filter_unittests").AppendASCII("google.txt");
+    std::string google;
+    ASSERT_TRUE(base::ReadFileToString(file_path, &google));
+    pages_.push_back(google);
+    pages_.push_back(MakePage(kPageSize));
+  }
+
+  // Decodes each page |kNumIterations| times through a fresh filter, feeding
+  // it the way URLRequestJob does, and reports the decoded throughput.
+  void MeasureDecode(int stream_buffer_size, int output_buffer_size,
+                     const std::string& trace) {
+    std::vector<std::string> compressed;
+    size_t total_size = 0;
+    for (size_t i = 0; i < pages_.size(); ++i) {
+      compressed.push_back(GZip(pages_[i]));
+      total_size += pages_[i].size();
+    }
+
+    std::vector<Filter::FilterType> filter_types;
+    filter_types.push_back(Filter::FILTER_TYPE_GZIP);
+    std::vector<char> output(output_buffer_size);
+    size_t read_data_calls = 0;
+
+    base::TimeTicks start = base::TimeTicks::HighResNow();
+    for (int iteration = 0; iteration < kNumIterations; ++iteration) {
+      for (size_t i = 0; i < compressed.size(); ++i) {
+        scoped_ptr<Filter> filter(Filter::FactoryForTests(
+            filter_types, filter_context_, stream_buffer_size));
+        ASSERT_TRUE(filter.get());
+        size_t decoded = 0;
+        size_t offset = 0;
+        Filter::FilterStatus status = Filter::FILTER_NEED_MORE_DATA;
+        while (status != Filter::FILTER_DONE) {
+          if (status == Filter::FILTER_NEED_MORE_DATA) {
+            ASSERT_LT(offset, compressed[i].size());
+            int len = std::min(compressed[i].size() - offset,
+                               static_cast<size_t>(stream_buffer_size));
+            memcpy(filter->stream_buffer()->data(),
+                   compressed[i].data() + offset, len);
+            filter->FlushStreamBuffer(len);
+            offset += len;
+          }
+          int output_len = output_buffer_size;
+          status = filter->ReadData(&output[0], &output_len);
+          ASSERT_NE(Filter::FILTER_ERROR, status);
+          decoded += output_len;
+          ++read_data_calls;
+        }
+        EXPECT_EQ(pages_[i].size(), decoded);
+      }
+    }
+    base::TimeDelta elapsed = base::TimeTicks::HighResNow() - start;
+
+    perf_test::PrintResult("gzip_filter_decode", "", trace,
+                           total_size * kNumIterations /
+                               (elapsed.InSecondsF() * 1024 * 1024),
+                           "MB/s", true);
+    perf_test::PrintResult("gzip_filter_read_data_calls", "", trace,
+                           read_data_calls / kNumIterations, "calls", false);
+  }
+
+  MockFilterContext filter_context_;
+  std::vector<std::string> pages_;
+};
+
+TEST_F(GZipFilterPerfTest, Decode) {
+  MeasureDecode(32 * 1024, 4 * 1024, "32k_input_4k_output");
+  MeasureDecode(32 * 1024, 32 * 1024, "32k_input_32k_output");
+  MeasureDecode(64 * 1024, 32 * 1024, "64k_input_32k_output");
+  MeasureDecode(64 * 1024, 64 * 1024, "64k_input_64k_output");
+}
+
+}  // namespace net
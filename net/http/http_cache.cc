@@ -269,6 +269,66 @@ void HttpCache::MetadataWriter::OnIOComplete(int result) {
 
 //-----------------------------------------------------------------------------
 
+// This class opens a disk cache entry and reads its response info, which
+// brings the entry into the caches of the backend and of the OS.
+class HttpCache::EntryPreloader {
+ public:
+  EntryPreloader() : entry_(NULL) {}
+
+  ~EntryPreloader() {
+    if (entry_)
+      entry_->Close();
+  }
+
+  // Implements the bulk of HttpCache::PreloadEntries for one entry. Deletes
+  // itself when done.
+  void Preload(disk_cache::Backend* backend, const std::string& key);
+
+ private:
+  void OnOpenComplete(int result);
+  void OnReadComplete(int result);
+
+  disk_cache::Entry* entry_;
+  scoped_refptr<IOBuffer> buf_;
+  DISALLOW_COPY_AND_ASSIGN(EntryPreloader);
+};
+
+void HttpCache::EntryPreloader::Preload(disk_cache::Backend* backend,
+                                        const std::string& key) {
+  int rv = backend->OpenEntry(
+      key, &entry_,
+      base::Bind(&EntryPreloader::OnOpenComplete, base::Unretained(this)));
+  if (rv != ERR_IO_PENDING)
+    OnOpenComplete(rv);
+}
+
+void HttpCache::EntryPreloader::OnOpenComplete(int result) {
+  if (result != OK) {
+    entry_ = NULL;
+    delete this;
+    return;
+  }
+
+  int size = entry_->GetDataSize(kResponseInfoIndex);
+  if (size <= 0) {
+    delete this;
+    return;
+  }
+
+  buf_ = new IOBuffer(size);
+  int rv = entry_->ReadData(
+      kResponseInfoIndex, 0, buf_.get(), size,
+      base::Bind(&EntryPreloader::OnReadComplete, base::Unretained(this)));
+  if (rv != ERR_IO_PENDING)
+    OnReadComplete(rv);
+}
+
+void HttpCache::EntryPreloader::OnReadComplete(int result) {
+  delete this;
+}
+
+//-----------------------------------------------------------------------------
+
 class HttpCache::QuicServerInfoFactoryAdaptor : public QuicServerInfoFactory {
  public:
   QuicServerInfoFactoryAdaptor(HttpCache* http_cache)
@@ -433,6 +493,24 @@ void HttpCache::OnExternalCacheHit(const GURL& url,
   disk_cache_->OnExternalCacheHit(key);
 }
 
+void HttpCache::PreloadEntries(const std::vector<GURL>& urls) {
+  if (!disk_cache_.get())
+    return;
+
+  for (size_t i = 0; i < urls.size(); ++i) {
+    HttpRequestInfo request_info;
+    request_info.url = urls[i];
+    request_info.method = "GET";
+    std::string key = GenerateCacheKey(&request_info);
+    if (FindActiveEntry(key))
+      continue;
+
+    // The preloader will self destruct when done.
+    EntryPreloader* preloader = new EntryPreloader();
+    preloader->Preload(disk_cache_.get(), key);
+  }
+}
+
 void HttpCache::InitializeInfiniteCache(const base::FilePath& path) {
   if (base::FieldTrialList::FindFullName("InfiniteCache") != "Yes")
     return;
@@ -17,6 +17,7 @@
 #include <list>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "base/basictypes.h"
 #include "base/containers/hash_tables.h"
@@ -186,6 +187,13 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory,
   // referred to by |url| and |http_method|.
   void OnExternalCacheHit(const GURL& url, const std::string& http_method);
 
+  // Opens the entries of GET requests for |urls| and reads their response
+  // info, so that the disk reads are done before the requests are issued, for
+  // example for the subresources of a page which is expected to be loaded.
+  // Entries which are already active are skipped. This method returns without
+  // blocking and there is no completion notification.
+  void PreloadEntries(const std::vector<GURL>& urls);
+
   // Initializes the Infinite Cache, if selected by the field trial.
   void InitializeInfiniteCache(const base::FilePath& path);
 
@@ -218,6 +226,7 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory,
  private:
   // Types --------------------------------------------------------------------
 
+  class EntryPreloader;
   class MetadataWriter;
   class QuicServerInfoFactoryAdaptor;
   class Transaction;
@@ -5866,6 +5866,33 @@ TEST(HttpCache, ReadMetadata) {
   EXPECT_EQ(1, cache.disk_cache()->create_count());
 }
 
+// Tests that PreloadEntries opens the entries of cached URLs, and doesn't
+// create entries for the others.
+TEST(HttpCache, PreloadEntries) {
+  MockHttpCache cache;
+
+  // Write to the cache.
+  RunTransactionTest(cache.http_cache(), kSimpleGET_Transaction);
+  EXPECT_EQ(0, cache.disk_cache()->open_count());
+  EXPECT_EQ(1, cache.disk_cache()->create_count());
+
+  std::vector<GURL> urls;
+  urls.push_back(GURL(kSimpleGET_Transaction.url));
+  urls.push_back(GURL("http://www.google.com/not_cached"));
+  cache.http_cache()->PreloadEntries(urls);
+
+  // Makes sure we finish pending operations.
+  base::MessageLoop::current()->RunUntilIdle();
+
+  EXPECT_EQ(1, cache.disk_cache()->open_count());
+  EXPECT_EQ(1, cache.disk_cache()->create_count());
+
+  // The entry is still usable by a request.
+  RunTransactionTest(cache.http_cache(), kSimpleGET_Transaction);
+  EXPECT_EQ(1, cache.network_layer()->transaction_count());
+  EXPECT_EQ(2, cache.disk_cache()->open_count());
+}
+
 // Tests that we don't mark entries as truncated when a filter detects the end
 // of the stream.
 TEST(HttpCache, FilterCompletion) {
@@ -11,6 +11,7 @@
 
 #include <algorithm>
 
+#include "base/lazy_instance.h"
 #include "base/logging.h"
 #include "base/metrics/histogram.h"
 #include "base/pickle.h"
@@ -121,6 +122,98 @@ bool ShouldShowHttpHeaderValue(const std::string& header_name) {
   return true;
 }
 
+// The headers which are looked up often enough to be indexed.  Their position
+// in this list is their identifier.
+const char* const kCommonHeaders[] = {
+  "accept-ranges",
+  "access-control-allow-origin",
+  "age",
+  "alternate-protocol",
+  "cache-control",
+  "connection",
+  "content-disposition",
+  "content-encoding",
+  "content-language",
+  "content-length",
+  "content-location",
+  "content-range",
+  "content-type",
+  "date",
+  "etag",
+  "expires",
+  "keep-alive",
+  "last-modified",
+  "link",
+  "location",
+  "pragma",
+  "proxy-authenticate",
+  "proxy-connection",
+  "public-key-pins",
+  "refresh",
+  "retry-after",
+  "server",
+  "set-cookie",
+  "strict-transport-security",
+  "transfer-encoding",
+  "vary",
+  "via",
+  "www-authenticate",
+  "x-content-type-options",
+  "x-frame-options",
+  "x-xss-protection",
+};
+
+// Maps the names in kCommonHeaders, in any case, to their identifiers with
+// an open addressed hash table, without copying the name being looked up.
+class CommonHeaderTable {
+ public:
+  CommonHeaderTable() {
+    COMPILE_ASSERT(arraysize(kCommonHeaders) < kNumSlots / 2,
+                   common_header_table_too_full);
+    std::fill(slots_, slots_ + kNumSlots, -1);
+    for (size_t id = 0; id < arraysize(kCommonHeaders); ++id) {
+      const char* name = kCommonHeaders[id];
+      size_t slot = Hash(name, name + strlen(name));
+      while (slots_[slot] != -1)
+        slot = (slot + 1) % kNumSlots;
+      slots_[slot] = static_cast<int>(id);
+    }
+  }
+
+  // Returns the identifier of the header named [|begin|, |end|), or -1 if it
+  // is not a common header.
+  template <typename Iterator>
+  int Lookup(Iterator begin, Iterator end) const {
+    if (begin == end)
+      return -1;
+    for (size_t slot = Hash(begin, end); slots_[slot] != -1;
+         slot = (slot + 1) % kNumSlots) {
+      const char* name = kCommonHeaders[slots_[slot]];
+      if (LowerCaseEqualsASCII(begin, end, name))
+        return slots_[slot];
+    }
+    return -1;
+  }
+
+ private:
+  static const size_t kNumSlots = 128;
+
+  template <typename Iterator>
+  static size_t Hash(Iterator begin, Iterator end) {
+    size_t hash = 0;
+    for (Iterator it = begin; it != end; ++it)
+      hash = hash * 31 + base::ToLowerASCII(*it);
+    return hash % kNumSlots;
+  }
+
+  int slots_[kNumSlots];
+
+  DISALLOW_COPY_AND_ASSIGN(CommonHeaderTable);
+};
+
+base::LazyInstance<CommonHeaderTable>::Leaky g_common_headers =
+    LAZY_INSTANCE_INITIALIZER;
+
 }  // namespace
 
 const char HttpResponseHeaders::kContentRange[] = "Content-Range";
@@ -134,6 +227,13 @@ struct HttpResponseHeaders::ParsedHeader {
   std::string::const_iterator name_end;
   std::string::const_iterator value_begin;
   std::string::const_iterator value_end;
+
+  // The index in kCommonHeaders of the name, or -1 if it is not a common
+  // header or this is a continuation.
+  int common_header_id;
+  // The index in parsed_ of the next header with the same common name, or
+  // string::npos.
+  size_t next_common_header;
 };
 
 //-----------------------------------------------------------------------------
@@ -376,6 +476,7 @@ void HttpResponseHeaders::ReplaceStatusLine(const std::string& new_status) {
 
 void HttpResponseHeaders::Parse(const std::string& raw_input) {
   raw_headers_.reserve(raw_input.size());
+  common_headers_.assign(arraysize(kCommonHeaders), std::string::npos);
 
   // ParseStatusLine adds a normalized status line to raw_headers_
   std::string::const_iterator line_begin = raw_input.begin();
@@ -718,8 +819,20 @@ void HttpResponseHeaders::ParseStatusLine(
 
 size_t HttpResponseHeaders::FindHeader(size_t from,
                                        const base::StringPiece& search) const {
+  int common_header_id =
+      g_common_headers.Get().Lookup(search.begin(), search.end());
+  if (common_header_id != -1) {
+    if (common_headers_.empty())
+      return std::string::npos;
+    size_t i = common_headers_[common_header_id];
+    while (i < from)
+      i = parsed_[i].next_common_header;
+    return i;
+  }
+
   for (size_t i = from; i < parsed_.size(); ++i) {
-    if (parsed_[i].is_continuation())
+    // Common headers can only match a common name.
+    if (parsed_[i].is_continuation() || parsed_[i].common_header_id != -1)
       continue;
     const std::string::const_iterator& name_begin = parsed_[i].name_begin;
     const std::string::const_iterator& name_end = parsed_[i].name_end;
@@ -759,6 +872,17 @@ void HttpResponseHeaders::AddToParsed(std::string::const_iterator name_begin,
   header.name_end = name_end;
   header.value_begin = value_begin;
   header.value_end = value_end;
+  header.common_header_id =
+      g_common_headers.Get().Lookup(name_begin, name_end);
+  header.next_common_header = std::string::npos;
+
+  // Append the header to the chain of headers with its name.
+  if (header.common_header_id != -1) {
+    size_t* next = &common_headers_[header.common_header_id];
+    while (*next != std::string::npos)
+      next = &parsed_[*next].next_common_header;
+    *next = parsed_.size();
+  }
   parsed_.push_back(header);
 }
 
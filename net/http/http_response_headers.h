@@ -331,7 +331,8 @@ class NET_EXPORT HttpResponseHeaders
                        bool has_headers);
 
   // Find the header in our list (case-insensitive) starting with parsed_ at
-  // index |from|.  Returns string::npos if not found.
+  // index |from|.  Returns string::npos if not found.  Common headers are
+  // found through |common_headers_| instead of a scan.
   size_t FindHeader(size_t from, const base::StringPiece& name) const;
 
   // Add a header->value pair to our list.  If we already have header in our
@@ -386,6 +387,12 @@ class NET_EXPORT HttpResponseHeaders
   // header-value pairs within raw_headers_.
   HeaderList parsed_;
 
+  // For each of a fixed set of common header names, the index in parsed_ of
+  // the first header with the name, or string::npos.  The headers with the
+  // same name are chained through their ParsedHeader.  Built by Parse(), so
+  // it is also built when the headers are restored from a Pickle.
+  std::vector<size_t> common_headers_;
+
   // The raw_headers_ consists of the normalized status line (terminated with a
   // null byte) and then followed by the raw null-terminated headers from the
   // input that was passed to our constructor.  We preserve the input [*] to
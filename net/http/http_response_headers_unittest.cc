@@ -509,6 +509,56 @@ TEST(HttpResponseHeadersTest, EnumerateHeader_Coalesced) {
   EXPECT_FALSE(parsed->EnumerateHeader(&iter, "cache-control", &value));
 }
 
+TEST(HttpResponseHeadersTest, EnumerateHeader_Interleaved) {
+  // Common headers are found through an index, which must agree with a scan
+  // over the other headers.
+  std::string headers =
+      "HTTP/1.1 200 OK\n"
+      "Vary: Accept\n"
+      "Content: a\n"
+      "X-Custom: 1\n"
+      "vary: Cookie, User-Agent\n"
+      "x-custom: 2\n"
+      "Content-Type: text/html\n";
+  HeadersToRaw(&headers);
+  scoped_refptr<net::HttpResponseHeaders> original(
+      new net::HttpResponseHeaders(headers));
+
+  // Restoring from a pickle builds the same index.
+  Pickle pickle;
+  original->Persist(&pickle, net::HttpResponseHeaders::PERSIST_RAW);
+  PickleIterator pickle_iter(pickle);
+  scoped_refptr<net::HttpResponseHeaders> restored(
+      new net::HttpResponseHeaders(pickle, &pickle_iter));
+
+  net::HttpResponseHeaders* parsed[] = { original.get(), restored.get() };
+  for (size_t i = 0; i < arraysize(parsed); ++i) {
+    void* iter = NULL;
+    std::string value;
+    EXPECT_TRUE(parsed[i]->EnumerateHeader(&iter, "VARY", &value));
+    EXPECT_EQ("Accept", value);
+    EXPECT_TRUE(parsed[i]->EnumerateHeader(&iter, "VARY", &value));
+    EXPECT_EQ("Cookie", value);
+    EXPECT_TRUE(parsed[i]->EnumerateHeader(&iter, "VARY", &value));
+    EXPECT_EQ("User-Agent", value);
+    EXPECT_FALSE(parsed[i]->EnumerateHeader(&iter, "VARY", &value));
+
+    iter = NULL;
+    EXPECT_TRUE(parsed[i]->EnumerateHeader(&iter, "X-CUSTOM", &value));
+    EXPECT_EQ("1", value);
+    EXPECT_TRUE(parsed[i]->EnumerateHeader(&iter, "X-CUSTOM", &value));
+    EXPECT_EQ("2", value);
+    EXPECT_FALSE(parsed[i]->EnumerateHeader(&iter, "X-CUSTOM", &value));
+
+    EXPECT_TRUE(parsed[i]->GetNormalizedHeader("content", &value));
+    EXPECT_EQ("a", value);
+    EXPECT_TRUE(parsed[i]->GetNormalizedHeader("content-type", &value));
+    EXPECT_EQ("text/html", value);
+    EXPECT_FALSE(parsed[i]->HasHeader("content-length"));
+    EXPECT_FALSE(parsed[i]->HasHeader("x-other"));
+  }
+}
+
 TEST(HttpResponseHeadersTest, EnumerateHeader_Challenge) {
   // Even though WWW-Authenticate has commas, it should not be treated as
   // coalesced values.
@@ -573,8 +623,9 @@ TEST(HttpResponseHeadersTest, DefaultDateToGMT) {
   // If an unknown timezone is present, treat like a missing timezone and
   // default to GMT.  The only example of a web server not specifying "GMT"
   // used "UTC" which is equivalent to GMT.
-  if (parsed->GetExpiresValue(&value))
+  if (parsed->GetExpiresValue(&value)) {
     EXPECT_EQ(expected_value, value);
+  }
 }
 
 TEST(HttpResponseHeadersTest, GetMimeType) {
@@ -54,6 +54,8 @@ class MultiThreadedProxyResolver::Executor
 
   ProxyResolver* resolver() { return resolver_.get(); }
 
+  MultiThreadedProxyResolver* coordinator() { return coordinator_; }
+
   int thread_number() const { return thread_number_; }
 
  private:
@@ -268,6 +270,7 @@ class MultiThreadedProxyResolver::GetProxyForURLJob
       RecordPerformanceMetrics();
       if (result_code >= OK) {  // Note: unit-tests use values > 0.
         results_->Use(results_buf_);
+        executor()->coordinator()->OnProxyResolved(url_, results_buf_);
       }
       RunUserCallback(result_code);
     }
@@ -393,7 +396,8 @@ MultiThreadedProxyResolver::MultiThreadedProxyResolver(
     size_t max_num_threads)
     : ProxyResolver(resolver_factory->resolvers_expect_pac_bytes()),
       resolver_factory_(resolver_factory),
-      max_num_threads_(max_num_threads) {
+      max_num_threads_(max_num_threads),
+      max_cached_results_(0) {
   DCHECK_GE(max_num_threads, 1u);
 }
 
@@ -403,6 +407,14 @@ MultiThreadedProxyResolver::~MultiThreadedProxyResolver() {
   ReleaseAllExecutors();
 }
 
+void MultiThreadedProxyResolver::EnableOriginResultCache(
+    size_t max_entries, base::TimeDelta ttl) {
+  DCHECK(CalledOnValidThread());
+  max_cached_results_ = max_entries;
+  cached_result_ttl_ = ttl;
+  result_cache_.clear();
+}
+
 int MultiThreadedProxyResolver::GetProxyForURL(
     const GURL& url, ProxyInfo* results, const CompletionCallback& callback,
     RequestHandle* request, const BoundNetLog& net_log) {
@@ -411,6 +423,9 @@ int MultiThreadedProxyResolver::GetProxyForURL(
   DCHECK(current_script_data_.get())
       << "Resolver is un-initialized. Must call SetPacScript() first!";
 
+  if (GetCachedResult(url, results))
+    return OK;
+
   scoped_refptr<GetProxyForURLJob> job(
       new GetProxyForURLJob(url, results, callback, net_log));
 
@@ -485,6 +500,7 @@ void MultiThreadedProxyResolver::CancelSetPacScript() {
 
 void MultiThreadedProxyResolver::PurgeMemory() {
   DCHECK(CalledOnValidThread());
+  result_cache_.clear();
   for (ExecutorList::iterator it = executors_.begin();
        it != executors_.end(); ++it) {
     Executor* executor = it->get();
@@ -501,6 +517,9 @@ int MultiThreadedProxyResolver::SetPacScript(
   // Save the script details, so we can provision new executors later.
   current_script_data_ = script_data;
 
+  // Results of the previous script no longer apply.
+  result_cache_.clear();
+
   // The user should not have any outstanding requests when they call
   // SetPacScript().
   CheckNoOutstandingUserRequests();
@@ -580,4 +599,46 @@ void MultiThreadedProxyResolver::OnExecutorReady(Executor* executor) {
   executor->StartJob(job.get());
 }
 
+bool MultiThreadedProxyResolver::GetCachedResult(const GURL& url,
+                                                 ProxyInfo* results) {
+  DCHECK(CalledOnValidThread());
+  if (!max_cached_results_)
+    return false;
+
+  ResultCache::iterator it = result_cache_.find(url.GetOrigin().spec());
+  if (it == result_cache_.end())
+    return false;
+  if (base::TimeTicks::Now() >= it->second.expiration) {
+    result_cache_.erase(it);
+    return false;
+  }
+  results->Use(it->second.info);
+  return true;
+}
+
+void MultiThreadedProxyResolver::OnProxyResolved(const GURL& url,
+                                                 const ProxyInfo& results) {
+  DCHECK(CalledOnValidThread());
+  if (!max_cached_results_)
+    return;
+
+  base::TimeTicks now = base::TimeTicks::Now();
+  if (result_cache_.size() >= max_cached_results_) {
+    // Drop the expired entries, and everything if that was not enough.
+    for (ResultCache::iterator it = result_cache_.begin();
+         it != result_cache_.end();) {
+      if (now >= it->second.expiration)
+        result_cache_.erase(it++);
+      else
+        ++it;
+    }
+    if (result_cache_.size() >= max_cached_results_)
+      result_cache_.clear();
+  }
+
+  CachedResult& entry = result_cache_[url.GetOrigin().spec()];
+  entry.info.Use(results);
+  entry.expiration = now + cached_result_ttl_;
+}
+
 }  // namespace net
@@ -6,13 +6,17 @@
 #define NET_PROXY_MULTI_THREADED_PROXY_RESOLVER_H_
 
 #include <deque>
+#include <map>
+#include <string>
 #include <vector>
 
 #include "base/basictypes.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/threading/non_thread_safe.h"
+#include "base/time/time.h"
 #include "net/base/net_export.h"
+#include "net/proxy/proxy_info.h"
 #include "net/proxy/proxy_resolver.h"
 
 namespace base {
@@ -90,6 +94,18 @@ class NET_EXPORT_PRIVATE MultiThreadedProxyResolver
 
   virtual ~MultiThreadedProxyResolver();
 
+  // Enables caching of successful GetProxyForURL() results by origin (scheme,
+  // host and port) for up to |ttl|, keeping at most |max_entries| of them.
+  // Requests that hit the cache complete synchronously without running the
+  // PAC script. The cache is dropped by SetPacScript() and PurgeMemory().
+  //
+  // This is only safe for scripts whose FindProxyForURL() result depends on
+  // nothing but the origin of the URL. It must not be enabled for scripts
+  // that look at the URL path, the time of day (timeRange() and friends) or
+  // results of DNS resolution that may change within |ttl| (isInNet(),
+  // dnsResolve(), myIpAddress()).
+  void EnableOriginResultCache(size_t max_entries, base::TimeDelta ttl);
+
   // ProxyResolver implementation:
   virtual int GetProxyForURL(const GURL& url,
                              ProxyInfo* results,
@@ -114,6 +130,13 @@ class NET_EXPORT_PRIVATE MultiThreadedProxyResolver
   typedef std::deque<scoped_refptr<Job> > PendingJobsQueue;
   typedef std::vector<scoped_refptr<Executor> > ExecutorList;
 
+  struct CachedResult {
+    ProxyInfo info;
+    base::TimeTicks expiration;
+  };
+  // Maps the origin of a URL to the cached result for it.
+  typedef std::map<std::string, CachedResult> ResultCache;
+
   // Asserts that there are no outstanding user-initiated jobs on any of the
   // worker threads.
   void CheckNoOutstandingUserRequests() const;
@@ -131,11 +154,24 @@ class NET_EXPORT_PRIVATE MultiThreadedProxyResolver
   // Starts the next job from |pending_jobs_| if possible.
   void OnExecutorReady(Executor* executor);
 
+  // Copies the cached result for |url| into |results|. Returns false if the
+  // cache is disabled or has no unexpired entry for the origin of |url|.
+  bool GetCachedResult(const GURL& url, ProxyInfo* results);
+
+  // Stores |results| as the result for the origin of |url|, if the cache is
+  // enabled.
+  void OnProxyResolved(const GURL& url, const ProxyInfo& results);
+
   const scoped_ptr<ProxyResolverFactory> resolver_factory_;
   const size_t max_num_threads_;
   PendingJobsQueue pending_jobs_;
   ExecutorList executors_;
   scoped_refptr<ProxyResolverScriptData> current_script_data_;
+
+  // Zero when the result cache is disabled.
+  size_t max_cached_results_;
+  base::TimeDelta cached_result_ttl_;
+  ResultCache result_cache_;
 };
 
 }  // namespace net
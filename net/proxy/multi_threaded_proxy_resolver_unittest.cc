@@ -432,6 +432,66 @@ TEST(MultiThreadedProxyResolverTest,
 
 // Cancel a request which is in progress, and then cancel a request which
 // is pending.
+// Tests that with the origin result cache enabled, a second request for the
+// same origin completes synchronously without reaching the wrapped resolver,
+// and that SetPacScript() drops the cached results.
+TEST(MultiThreadedProxyResolverTest, SingleThread_OriginResultCache) {
+  const size_t kNumThreads = 1u;
+  scoped_ptr<MockProxyResolver> mock(new MockProxyResolver);
+  MultiThreadedProxyResolver resolver(
+      new ForwardingProxyResolverFactory(mock.get()), kNumThreads);
+  resolver.EnableOriginResultCache(10u, base::TimeDelta::FromHours(1));
+
+  int rv;
+
+  TestCompletionCallback set_script_callback;
+  rv = resolver.SetPacScript(
+      ProxyResolverScriptData::FromUTF8("pac script bytes"),
+      set_script_callback.callback());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+  EXPECT_EQ(OK, set_script_callback.WaitForResult());
+
+  // The first request runs the script.
+  TestCompletionCallback callback0;
+  ProxyInfo results0;
+  rv = resolver.GetProxyForURL(GURL("http://request0/a"), &results0,
+                               callback0.callback(), NULL, BoundNetLog());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+  EXPECT_EQ(0, callback0.WaitForResult());
+  EXPECT_EQ("PROXY request0:80", results0.ToPacString());
+
+  // Another URL on the same origin is served from the cache.
+  TestCompletionCallback callback1;
+  ProxyInfo results1;
+  rv = resolver.GetProxyForURL(GURL("http://request0/b"), &results1,
+                               callback1.callback(), NULL, BoundNetLog());
+  EXPECT_EQ(OK, rv);
+  EXPECT_EQ("PROXY request0:80", results1.ToPacString());
+  EXPECT_EQ(1, mock->request_count());
+
+  // A different origin is not.
+  TestCompletionCallback callback2;
+  ProxyInfo results2;
+  rv = resolver.GetProxyForURL(GURL("https://request0/a"), &results2,
+                               callback2.callback(), NULL, BoundNetLog());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+  EXPECT_EQ(1, callback2.WaitForResult());
+
+  // Loading a new script drops the cached results.
+  rv = resolver.SetPacScript(
+      ProxyResolverScriptData::FromUTF8("new pac script bytes"),
+      set_script_callback.callback());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+  EXPECT_EQ(OK, set_script_callback.WaitForResult());
+
+  TestCompletionCallback callback3;
+  ProxyInfo results3;
+  rv = resolver.GetProxyForURL(GURL("http://request0/a"), &results3,
+                               callback3.callback(), NULL, BoundNetLog());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+  EXPECT_EQ(2, callback3.WaitForResult());
+}
+
 TEST(MultiThreadedProxyResolverTest, SingleThread_CancelRequest) {
   const size_t kNumThreads = 1u;
   scoped_ptr<BlockableProxyResolver> mock(new BlockableProxyResolver);
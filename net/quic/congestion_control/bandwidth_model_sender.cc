@@ -0,0 +1,350 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/quic/congestion_control/bandwidth_model_sender.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+
+using std::make_pair;
+using std::max;
+using std::min;
+
+namespace net {
+
+namespace {
+// The gain of startup, 2/ln(2), is the smallest which doubles the delivery
+// rate every round trip.
+const float kStartupGain = 2.885f;
+const float kDrainGain = 1 / kStartupGain;
+// The pacing gains of the rounds of PROBE_BANDWIDTH. The round above 1 probes
+// for more bandwidth, and the round below 1 drains what the probe queued.
+const float kGainCycle[] = { 1.25f, 0.75f, 1, 1, 1, 1, 1, 1 };
+// Allowing twice the bandwidth-delay product in flight keeps the pipe full
+// when acks are delayed or aggregated.
+const float kCongestionWindowGain = 2;
+// The number of rounds the maximum bandwidth is taken over.
+const int64 kBandwidthWindowRounds = 10;
+// Startup ends once the bandwidth hasn't grown by a quarter for three rounds.
+const float kStartupGrowthTarget = 1.25f;
+const int kRoundsWithoutGrowthBeforeExit = 3;
+const QuicByteCount kInitialCongestionWindow =
+    kDefaultInitialWindow * kMaxPacketSize;
+const QuicByteCount kMinimumCongestionWindow = 4 * kMaxPacketSize;
+const QuicByteCount kDefaultReceiveWindow = 64000;
+const int kAlarmGranularityMs = 1;
+// Constants used for RTT calculation.
+const int kInitialRttMs = 100;
+const float kAlpha = 0.125f;
+const float kOneMinusAlpha = (1 - kAlpha);
+const float kBeta = 0.25f;
+const float kOneMinusBeta = (1 - kBeta);
+}  // namespace
+
+BandwidthModelSender::SentPacket::SentPacket(QuicTime sent_time,
+                                             QuicByteCount delivered,
+                                             QuicTime delivered_time,
+                                             QuicTime last_acked_sent_time)
+    : sent_time(sent_time),
+      delivered(delivered),
+      delivered_time(delivered_time),
+      last_acked_sent_time(last_acked_sent_time) {
+}
+
+BandwidthModelSender::BandwidthSample::BandwidthSample(QuicBandwidth bandwidth,
+                                                       int64 round)
+    : bandwidth(bandwidth),
+      round(round) {
+}
+
+BandwidthModelSender::BandwidthModelSender(const QuicClock* clock)
+    : clock_(clock),
+      mode_(STARTUP),
+      bytes_in_flight_(0),
+      delivered_(0),
+      delivered_time_(QuicTime::Zero()),
+      last_acked_sent_time_(QuicTime::Zero()),
+      round_count_(0),
+      largest_sent_sequence_number_(0),
+      end_of_round_sequence_number_(0),
+      full_bandwidth_(QuicBandwidth::Zero()),
+      rounds_without_growth_(0),
+      cycle_index_(0),
+      cycle_start_(QuicTime::Zero()),
+      next_send_time_(QuicTime::Zero()),
+      initial_congestion_window_(kInitialCongestionWindow),
+      receive_window_(kDefaultReceiveWindow),
+      min_rtt_(QuicTime::Delta::Zero()),
+      smoothed_rtt_(QuicTime::Delta::Zero()),
+      mean_deviation_(QuicTime::Delta::Zero()) {
+}
+
+BandwidthModelSender::~BandwidthModelSender() {
+}
+
+void BandwidthModelSender::SetFromConfig(const QuicConfig& config,
+                                         bool is_server) {
+  if (is_server) {
+    // The initial window is negotiated in packets.
+    initial_congestion_window_ =
+        config.server_initial_congestion_window() * kMaxPacketSize;
+  }
+}
+
+void BandwidthModelSender::OnIncomingQuicCongestionFeedbackFrame(
+    const QuicCongestionFeedbackFrame& feedback,
+    QuicTime feedback_receive_time) {
+  receive_window_ = feedback.tcp.receive_window;
+}
+
+void BandwidthModelSender::OnPacketAcked(
+    QuicPacketSequenceNumber acked_sequence_number,
+    QuicByteCount acked_bytes) {
+  SentPacketMap::iterator it = sent_packets_.find(acked_sequence_number);
+  if (it == sent_packets_.end()) {
+    // The packet was sent before the last retransmission timeout, or before
+    // this sender took over the connection.
+    return;
+  }
+  DCHECK_GE(bytes_in_flight_, acked_bytes);
+  bytes_in_flight_ -= acked_bytes;
+
+  const QuicTime now = clock_->ApproximateNow();
+  const SentPacket& packet = it->second;
+  delivered_ += acked_bytes;
+  delivered_time_ = now;
+  last_acked_sent_time_ = packet.sent_time;
+
+  // The delivery rate is the data acked while the packet was in flight over
+  // the longer of the time it took to send and to ack it, since acks which
+  // are compressed in time would otherwise overestimate the bandwidth.
+  QuicTime::Delta interval = QuicTime::Delta::Max(
+      now.Subtract(packet.delivered_time),
+      packet.sent_time.Subtract(packet.last_acked_sent_time));
+  if (!interval.IsZero()) {
+    QuicBandwidth bandwidth = QuicBandwidth::FromBytesAndTimeDelta(
+        delivered_ - packet.delivered, interval);
+    if (!bandwidth.IsZero()) {
+      UpdateMaxBandwidth(bandwidth);
+    }
+  }
+  sent_packets_.erase(it);
+
+  if (acked_sequence_number >= end_of_round_sequence_number_) {
+    end_of_round_sequence_number_ = largest_sent_sequence_number_;
+    OnRoundEnd();
+  }
+  UpdateMode(now);
+}
+
+void BandwidthModelSender::OnPacketLost(
+    QuicPacketSequenceNumber sequence_number,
+    QuicTime /*ack_receive_time*/) {
+  // Losses don't change the model; a congested bottleneck shows up as a
+  // delivery rate which stops growing. The bytes in flight are updated when
+  // the packet is abandoned.
+  DVLOG(1) << "Lost packet " << sequence_number << " with bandwidth estimate "
+           << BandwidthEstimate().ToKBitsPerSecond() << " kbps.";
+}
+
+bool BandwidthModelSender::OnPacketSent(
+    QuicTime sent_time,
+    QuicPacketSequenceNumber sequence_number,
+    QuicByteCount bytes,
+    TransmissionType /*transmission_type*/,
+    HasRetransmittableData is_retransmittable) {
+  // Only data packets are counted in flight and paced.
+  if (is_retransmittable != HAS_RETRANSMITTABLE_DATA) {
+    return false;
+  }
+
+  if (bytes_in_flight_ == 0) {
+    // Don't count the time the connection was idle towards the delivery rate.
+    delivered_time_ = sent_time;
+    last_acked_sent_time_ = sent_time;
+  }
+  sent_packets_.insert(make_pair(
+      sequence_number,
+      SentPacket(sent_time, delivered_, delivered_time_,
+                 last_acked_sent_time_)));
+  bytes_in_flight_ += bytes;
+  largest_sent_sequence_number_ = max(largest_sent_sequence_number_,
+                                      sequence_number);
+
+  // Time the connection spent without data to send can't be made up for.
+  if (next_send_time_ < sent_time) {
+    next_send_time_ = sent_time;
+  }
+  next_send_time_ = next_send_time_.Add(PacingRate().TransferTime(bytes));
+  return true;
+}
+
+void BandwidthModelSender::OnRetransmissionTimeout(
+    bool /*packets_retransmitted*/) {
+  // All the packets in flight were abandoned.
+  bytes_in_flight_ = 0;
+  sent_packets_.clear();
+}
+
+void BandwidthModelSender::OnPacketAbandoned(
+    QuicPacketSequenceNumber sequence_number,
+    QuicByteCount abandoned_bytes) {
+  if (sent_packets_.erase(sequence_number) == 0) {
+    return;
+  }
+  DCHECK_GE(bytes_in_flight_, abandoned_bytes);
+  bytes_in_flight_ -= abandoned_bytes;
+}
+
+QuicTime::Delta BandwidthModelSender::TimeUntilSend(
+    QuicTime now,
+    TransmissionType transmission_type,
+    HasRetransmittableData has_retransmittable_data,
+    IsHandshake handshake) {
+  if (transmission_type == TLP_RETRANSMISSION ||
+      has_retransmittable_data == NO_RETRANSMITTABLE_DATA ||
+      handshake == IS_HANDSHAKE) {
+    // As in TcpCubicSender, acks, handshake packets and tail loss probes are
+    // neither limited by the window nor paced.
+    return QuicTime::Delta::Zero();
+  }
+  if (bytes_in_flight_ >= min(receive_window_, GetCongestionWindow())) {
+    return QuicTime::Delta::Infinite();
+  }
+  const QuicTime::Delta granularity =
+      QuicTime::Delta::FromMilliseconds(kAlarmGranularityMs);
+  if (next_send_time_ > now.Add(granularity)) {
+    return next_send_time_.Subtract(now);
+  }
+  return QuicTime::Delta::Zero();
+}
+
+QuicBandwidth BandwidthModelSender::BandwidthEstimate() const {
+  if (max_bandwidth_samples_.empty()) {
+    return QuicBandwidth::FromBytesAndTimeDelta(GetCongestionWindow(),
+                                                SmoothedRtt());
+  }
+  return max_bandwidth_samples_.front().bandwidth;
+}
+
+void BandwidthModelSender::UpdateRtt(QuicTime::Delta rtt) {
+  if (rtt.IsInfinite() || rtt.IsZero()) {
+    DVLOG(1) << "Ignoring rtt, because it's "
+             << (rtt.IsZero() ? "Zero" : "Infinite");
+    return;
+  }
+  // Queueing only adds to the RTT, so the smallest sample is the closest to
+  // the propagation delay.
+  if (min_rtt_.IsZero() || min_rtt_ > rtt) {
+    min_rtt_ = rtt;
+  }
+  if (smoothed_rtt_.IsZero()) {
+    smoothed_rtt_ = rtt;
+    mean_deviation_ = QuicTime::Delta::FromMicroseconds(
+        rtt.ToMicroseconds() / 2);
+    return;
+  }
+  mean_deviation_ = QuicTime::Delta::FromMicroseconds(
+      kOneMinusBeta * mean_deviation_.ToMicroseconds() +
+      kBeta * std::abs(smoothed_rtt_.ToMicroseconds() - rtt.ToMicroseconds()));
+  smoothed_rtt_ = QuicTime::Delta::FromMicroseconds(
+      kOneMinusAlpha * smoothed_rtt_.ToMicroseconds() +
+      kAlpha * rtt.ToMicroseconds());
+}
+
+QuicTime::Delta BandwidthModelSender::SmoothedRtt() const {
+  if (smoothed_rtt_.IsZero()) {
+    return QuicTime::Delta::FromMilliseconds(kInitialRttMs);
+  }
+  return smoothed_rtt_;
+}
+
+QuicTime::Delta BandwidthModelSender::RetransmissionDelay() const {
+  return QuicTime::Delta::FromMicroseconds(
+      smoothed_rtt_.ToMicroseconds() + 4 * mean_deviation_.ToMicroseconds());
+}
+
+QuicByteCount BandwidthModelSender::GetCongestionWindow() const {
+  if (max_bandwidth_samples_.empty()) {
+    return initial_congestion_window_;
+  }
+  const float gain = mode_ == PROBE_BANDWIDTH ? kCongestionWindowGain
+                                              : kStartupGain;
+  return max(kMinimumCongestionWindow,
+             static_cast<QuicByteCount>(gain * BandwidthDelayProduct()));
+}
+
+void BandwidthModelSender::UpdateMaxBandwidth(QuicBandwidth bandwidth) {
+  // Samples which are smaller than a newer one can never be the maximum.
+  while (!max_bandwidth_samples_.empty() &&
+         max_bandwidth_samples_.back().bandwidth <= bandwidth) {
+    max_bandwidth_samples_.pop_back();
+  }
+  max_bandwidth_samples_.push_back(BandwidthSample(bandwidth, round_count_));
+  while (max_bandwidth_samples_.front().round + kBandwidthWindowRounds <=
+             round_count_) {
+    max_bandwidth_samples_.pop_front();
+  }
+}
+
+void BandwidthModelSender::OnRoundEnd() {
+  ++round_count_;
+  if (mode_ != STARTUP || max_bandwidth_samples_.empty()) {
+    return;
+  }
+  QuicBandwidth bandwidth = BandwidthEstimate();
+  if (bandwidth >= full_bandwidth_.Scale(kStartupGrowthTarget)) {
+    full_bandwidth_ = bandwidth;
+    rounds_without_growth_ = 0;
+    return;
+  }
+  if (++rounds_without_growth_ >= kRoundsWithoutGrowthBeforeExit) {
+    DVLOG(1) << "Leaving startup with bandwidth estimate "
+             << bandwidth.ToKBitsPerSecond() << " kbps.";
+    mode_ = DRAIN;
+  }
+}
+
+void BandwidthModelSender::UpdateMode(QuicTime now) {
+  if (mode_ == DRAIN && bytes_in_flight_ <= BandwidthDelayProduct()) {
+    mode_ = PROBE_BANDWIDTH;
+    cycle_index_ = 0;
+    cycle_start_ = now;
+    return;
+  }
+  if (mode_ == PROBE_BANDWIDTH && now.Subtract(cycle_start_) > MinRtt()) {
+    cycle_index_ = (cycle_index_ + 1) % arraysize(kGainCycle);
+    cycle_start_ = now;
+  }
+}
+
+float BandwidthModelSender::PacingGain() const {
+  switch (mode_) {
+    case STARTUP:
+      return kStartupGain;
+    case DRAIN:
+      return kDrainGain;
+    case PROBE_BANDWIDTH:
+      return kGainCycle[cycle_index_];
+  }
+  return 1;
+}
+
+QuicBandwidth BandwidthModelSender::PacingRate() const {
+  return BandwidthEstimate().Scale(PacingGain());
+}
+
+QuicTime::Delta BandwidthModelSender::MinRtt() const {
+  if (min_rtt_.IsZero()) {
+    return QuicTime::Delta::FromMilliseconds(kInitialRttMs);
+  }
+  return min_rtt_;
+}
+
+QuicByteCount BandwidthModelSender::BandwidthDelayProduct() const {
+  return BandwidthEstimate().ToBytesPerPeriod(MinRtt());
+}
+
+}  // namespace net
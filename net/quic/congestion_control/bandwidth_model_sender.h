@@ -0,0 +1,157 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Send side congestion control which models the path instead of reacting to
+// loss. The sender estimates the bottleneck bandwidth from the delivery rate
+// of acked packets and the propagation delay from the minimum RTT, paces its
+// packets at a multiple of the estimated bandwidth and limits the bytes in
+// flight to a multiple of the bandwidth-delay product. Random losses, which
+// do not reduce the delivery rate, do not reduce the sending rate either.
+
+#ifndef NET_QUIC_CONGESTION_CONTROL_BANDWIDTH_MODEL_SENDER_H_
+#define NET_QUIC_CONGESTION_CONTROL_BANDWIDTH_MODEL_SENDER_H_
+
+#include <deque>
+#include <map>
+
+#include "base/basictypes.h"
+#include "base/compiler_specific.h"
+#include "net/base/net_export.h"
+#include "net/quic/congestion_control/send_algorithm_interface.h"
+#include "net/quic/quic_bandwidth.h"
+#include "net/quic/quic_protocol.h"
+#include "net/quic/quic_time.h"
+
+namespace net {
+
+namespace test {
+class BandwidthModelSenderPeer;
+}  // namespace test
+
+class NET_EXPORT_PRIVATE BandwidthModelSender : public SendAlgorithmInterface {
+ public:
+  explicit BandwidthModelSender(const QuicClock* clock);
+  virtual ~BandwidthModelSender();
+
+  // Start implementation of SendAlgorithmInterface.
+  virtual void SetFromConfig(const QuicConfig& config, bool is_server) OVERRIDE;
+  virtual void OnIncomingQuicCongestionFeedbackFrame(
+      const QuicCongestionFeedbackFrame& feedback,
+      QuicTime feedback_receive_time) OVERRIDE;
+  virtual void OnPacketAcked(QuicPacketSequenceNumber acked_sequence_number,
+                             QuicByteCount acked_bytes) OVERRIDE;
+  virtual void OnPacketLost(QuicPacketSequenceNumber sequence_number,
+                            QuicTime ack_receive_time) OVERRIDE;
+  virtual bool OnPacketSent(QuicTime sent_time,
+                            QuicPacketSequenceNumber sequence_number,
+                            QuicByteCount bytes,
+                            TransmissionType transmission_type,
+                            HasRetransmittableData is_retransmittable) OVERRIDE;
+  virtual void OnRetransmissionTimeout(bool packets_retransmitted) OVERRIDE;
+  virtual void OnPacketAbandoned(QuicPacketSequenceNumber sequence_number,
+                                 QuicByteCount abandoned_bytes) OVERRIDE;
+  virtual QuicTime::Delta TimeUntilSend(
+      QuicTime now,
+      TransmissionType transmission_type,
+      HasRetransmittableData has_retransmittable_data,
+      IsHandshake handshake) OVERRIDE;
+  virtual QuicBandwidth BandwidthEstimate() const OVERRIDE;
+  virtual void UpdateRtt(QuicTime::Delta rtt_sample) OVERRIDE;
+  virtual QuicTime::Delta SmoothedRtt() const OVERRIDE;
+  virtual QuicTime::Delta RetransmissionDelay() const OVERRIDE;
+  virtual QuicByteCount GetCongestionWindow() const OVERRIDE;
+  // End implementation of SendAlgorithmInterface.
+
+ private:
+  friend class test::BandwidthModelSenderPeer;
+
+  enum Mode {
+    // Doubles the sending rate every round trip until the bandwidth estimate
+    // stops growing.
+    STARTUP,
+    // Drains the queue built up during startup.
+    DRAIN,
+    // Cycles the pacing gain around 1 to probe for more bandwidth and then
+    // to drain the queue the probe may have created.
+    PROBE_BANDWIDTH,
+  };
+
+  // The state of the connection when a packet was sent, from which the
+  // delivery rate is computed once the packet is acked.
+  struct SentPacket {
+    SentPacket(QuicTime sent_time,
+               QuicByteCount delivered,
+               QuicTime delivered_time,
+               QuicTime last_acked_sent_time);
+
+    QuicTime sent_time;
+    QuicByteCount delivered;
+    QuicTime delivered_time;
+    // When the packet acked last before this one was sent had been sent.
+    QuicTime last_acked_sent_time;
+  };
+  typedef std::map<QuicPacketSequenceNumber, SentPacket> SentPacketMap;
+
+  struct BandwidthSample {
+    BandwidthSample(QuicBandwidth bandwidth, int64 round);
+
+    QuicBandwidth bandwidth;
+    int64 round;
+  };
+
+  // Adds |bandwidth| to the windowed maximum of the recent rounds.
+  void UpdateMaxBandwidth(QuicBandwidth bandwidth);
+  void OnRoundEnd();
+  void UpdateMode(QuicTime now);
+  float PacingGain() const;
+  QuicBandwidth PacingRate() const;
+  QuicTime::Delta MinRtt() const;
+  QuicByteCount BandwidthDelayProduct() const;
+
+  const QuicClock* clock_;
+  Mode mode_;
+
+  SentPacketMap sent_packets_;
+  QuicByteCount bytes_in_flight_;
+
+  // Bytes acked so far and when the last of them was acked.
+  QuicByteCount delivered_;
+  QuicTime delivered_time_;
+  // When the last acked packet was sent.
+  QuicTime last_acked_sent_time_;
+
+  // A round ends when the largest packet sent at its start is acked.
+  int64 round_count_;
+  QuicPacketSequenceNumber largest_sent_sequence_number_;
+  QuicPacketSequenceNumber end_of_round_sequence_number_;
+
+  // Decreasing bandwidth samples of the last rounds; the front holds the
+  // maximum.
+  std::deque<BandwidthSample> max_bandwidth_samples_;
+
+  // The bandwidth startup last grew by a significant amount to, and the
+  // number of rounds it has not grown since.
+  QuicBandwidth full_bandwidth_;
+  int rounds_without_growth_;
+
+  // Position in the gain cycle of PROBE_BANDWIDTH and when it was entered.
+  size_t cycle_index_;
+  QuicTime cycle_start_;
+
+  // When the pacing rate allows the next packet to be sent.
+  QuicTime next_send_time_;
+
+  QuicByteCount initial_congestion_window_;
+  QuicByteCount receive_window_;
+
+  QuicTime::Delta min_rtt_;
+  QuicTime::Delta smoothed_rtt_;
+  QuicTime::Delta mean_deviation_;
+
+  DISALLOW_COPY_AND_ASSIGN(BandwidthModelSender);
+};
+
+}  // namespace net
+
+#endif  // NET_QUIC_CONGESTION_CONTROL_BANDWIDTH_MODEL_SENDER_H_
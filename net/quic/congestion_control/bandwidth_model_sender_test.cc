@@ -0,0 +1,217 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/quic/congestion_control/bandwidth_model_sender.h"
+
+#include <deque>
+
+#include "base/logging.h"
+#include "base/memory/scoped_ptr.h"
+#include "net/quic/congestion_control/tcp_receiver.h"
+#include "net/quic/test_tools/mock_clock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+namespace test {
+
+class BandwidthModelSenderPeer {
+ public:
+  static bool InStartup(const BandwidthModelSender& sender) {
+    return sender.mode_ == BandwidthModelSender::STARTUP;
+  }
+};
+
+namespace {
+
+// Simulates a bottleneck link with a fixed bandwidth and round trip time,
+// which drops every |loss_interval|th packet.
+class SimulatedLink {
+ public:
+  SimulatedLink(MockClock* clock,
+                QuicBandwidth bandwidth,
+                QuicTime::Delta rtt,
+                int loss_interval)
+      : clock_(clock),
+        bandwidth_(bandwidth),
+        rtt_(rtt),
+        loss_interval_(loss_interval),
+        link_free_time_(QuicTime::Zero()),
+        packets_sent_(0),
+        bytes_delivered_(0) {
+  }
+
+  // Feeds the acks and losses which are due to |sender|, and returns the
+  // time of the next one.
+  QuicTime DeliverEvents(SendAlgorithmInterface* sender) {
+    QuicTime now = clock_->Now();
+    while (!events_.empty() && events_.front().time <= now) {
+      const Event& event = events_.front();
+      if (event.lost) {
+        sender->OnPacketLost(event.sequence_number, now);
+        sender->OnPacketAbandoned(event.sequence_number, kMaxPacketSize);
+      } else {
+        sender->UpdateRtt(now.Subtract(event.sent_time));
+        sender->OnPacketAcked(event.sequence_number, kMaxPacketSize);
+        bytes_delivered_ += kMaxPacketSize;
+      }
+      events_.pop_front();
+    }
+    return events_.empty() ? QuicTime::Zero() : events_.front().time;
+  }
+
+  void SendPacket(QuicPacketSequenceNumber sequence_number) {
+    QuicTime now = clock_->Now();
+    // The packet waits for the packets queued before it to cross the link.
+    link_free_time_ = QuicTime::Max(link_free_time_, now).Add(
+        bandwidth_.TransferTime(kMaxPacketSize));
+    // The receiver notices a loss when the next packet arrives.
+    bool lost = ++packets_sent_ % loss_interval_ == 0;
+    events_.push_back(
+        Event(sequence_number, now, link_free_time_.Add(rtt_), lost));
+  }
+
+  QuicByteCount bytes_delivered() const { return bytes_delivered_; }
+
+ private:
+  struct Event {
+    Event(QuicPacketSequenceNumber sequence_number,
+          QuicTime sent_time,
+          QuicTime time,
+          bool lost)
+        : sequence_number(sequence_number),
+          sent_time(sent_time),
+          time(time),
+          lost(lost) {
+    }
+
+    QuicPacketSequenceNumber sequence_number;
+    QuicTime sent_time;
+    QuicTime time;
+    bool lost;
+  };
+
+  MockClock* clock_;
+  const QuicBandwidth bandwidth_;
+  const QuicTime::Delta rtt_;
+  const int loss_interval_;
+  QuicTime link_free_time_;
+  int packets_sent_;
+  QuicByteCount bytes_delivered_;
+  std::deque<Event> events_;
+};
+
+class BandwidthModelSenderTest : public ::testing::Test {
+ protected:
+  BandwidthModelSenderTest()
+      : sender_(new BandwidthModelSender(&clock_)),
+        sequence_number_(1) {
+    TcpReceiver receiver;
+    QuicCongestionFeedbackFrame feedback;
+    receiver.GenerateCongestionFeedback(&feedback);
+    sender_->OnIncomingQuicCongestionFeedbackFrame(feedback, clock_.Now());
+  }
+
+  // Sends as much as |sender_| allows over |link| for |duration|.
+  void RunTransfer(SimulatedLink* link, QuicTime::Delta duration) {
+    QuicTime end_time = clock_.Now().Add(duration);
+    while (clock_.Now() < end_time) {
+      QuicTime next_event_time = link->DeliverEvents(sender_.get());
+      QuicTime::Delta time_until_send = sender_->TimeUntilSend(
+          clock_.Now(), NOT_RETRANSMISSION, HAS_RETRANSMITTABLE_DATA,
+          NOT_HANDSHAKE);
+      if (time_until_send.IsZero()) {
+        sender_->OnPacketSent(clock_.Now(), sequence_number_, kMaxPacketSize,
+                              NOT_RETRANSMISSION, HAS_RETRANSMITTABLE_DATA);
+        link->SendPacket(sequence_number_++);
+        continue;
+      }
+      QuicTime next_time = next_event_time;
+      if (!time_until_send.IsInfinite() &&
+          (!next_time.IsInitialized() ||
+           clock_.Now().Add(time_until_send) < next_time)) {
+        next_time = clock_.Now().Add(time_until_send);
+      }
+      ASSERT_TRUE(next_time.IsInitialized());
+      clock_.AdvanceTime(next_time.Subtract(clock_.Now()));
+    }
+  }
+
+  MockClock clock_;
+  scoped_ptr<BandwidthModelSender> sender_;
+  QuicPacketSequenceNumber sequence_number_;
+};
+
+TEST_F(BandwidthModelSenderTest, InitialWindowLimitsSending) {
+  EXPECT_EQ(10 * kMaxPacketSize, sender_->GetCongestionWindow());
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(sender_->TimeUntilSend(clock_.Now(), NOT_RETRANSMISSION,
+                                       HAS_RETRANSMITTABLE_DATA,
+                                       NOT_HANDSHAKE).IsZero());
+    sender_->OnPacketSent(clock_.Now(), sequence_number_++, kMaxPacketSize,
+                          NOT_RETRANSMISSION, HAS_RETRANSMITTABLE_DATA);
+    // The initial pacing rate spreads the window over less than an RTT.
+    clock_.AdvanceTime(QuicTime::Delta::FromMilliseconds(5));
+  }
+  EXPECT_TRUE(sender_->TimeUntilSend(clock_.Now(), NOT_RETRANSMISSION,
+                                     HAS_RETRANSMITTABLE_DATA,
+                                     NOT_HANDSHAKE).IsInfinite());
+  // Acks are never limited.
+  EXPECT_TRUE(sender_->TimeUntilSend(clock_.Now(), NOT_RETRANSMISSION,
+                                     NO_RETRANSMITTABLE_DATA,
+                                     NOT_HANDSHAKE).IsZero());
+}
+
+TEST_F(BandwidthModelSenderTest, AbandonedPacketsLeaveTheWindow) {
+  for (int i = 0; i < 10; ++i) {
+    sender_->OnPacketSent(clock_.Now(), sequence_number_++, kMaxPacketSize,
+                          NOT_RETRANSMISSION, HAS_RETRANSMITTABLE_DATA);
+  }
+  clock_.AdvanceTime(QuicTime::Delta::FromMilliseconds(100));
+  EXPECT_TRUE(sender_->TimeUntilSend(clock_.Now(), NOT_RETRANSMISSION,
+                                     HAS_RETRANSMITTABLE_DATA,
+                                     NOT_HANDSHAKE).IsInfinite());
+  sender_->OnPacketLost(1, clock_.Now());
+  sender_->OnPacketAbandoned(1, kMaxPacketSize);
+  EXPECT_TRUE(sender_->TimeUntilSend(clock_.Now(), NOT_RETRANSMISSION,
+                                     HAS_RETRANSMITTABLE_DATA,
+                                     NOT_HANDSHAKE).IsZero());
+
+  sender_->OnRetransmissionTimeout(true);
+  EXPECT_TRUE(sender_->TimeUntilSend(clock_.Now(), NOT_RETRANSMISSION,
+                                     HAS_RETRANSMITTABLE_DATA,
+                                     NOT_HANDSHAKE).IsZero());
+  // Acks of packets sent before the timeout are ignored.
+  sender_->OnPacketAcked(2, kMaxPacketSize);
+}
+
+TEST_F(BandwidthModelSenderTest, LossyLongRttLink) {
+  // A satellite link with a 600 ms RTT and 1% random loss, on which loss
+  // based senders keep backing off.
+  const QuicBandwidth kLinkBandwidth = QuicBandwidth::FromKBitsPerSecond(2000);
+  SimulatedLink link(&clock_, kLinkBandwidth,
+                     QuicTime::Delta::FromMilliseconds(600), 100);
+
+  RunTransfer(&link, QuicTime::Delta::FromSeconds(10));
+  EXPECT_FALSE(BandwidthModelSenderPeer::InStartup(*sender_));
+
+  // Once the startup is over, the link stays busy despite the losses.
+  QuicByteCount bytes_delivered = link.bytes_delivered();
+  RunTransfer(&link, QuicTime::Delta::FromSeconds(60));
+  QuicBandwidth goodput = QuicBandwidth::FromBytesAndTimeDelta(
+      link.bytes_delivered() - bytes_delivered,
+      QuicTime::Delta::FromSeconds(60));
+  EXPECT_LE(kLinkBandwidth.Scale(0.9f).ToKBitsPerSecond(),
+            goodput.ToKBitsPerSecond());
+  EXPECT_NEAR(kLinkBandwidth.ToKBitsPerSecond(),
+              sender_->BandwidthEstimate().ToKBitsPerSecond(),
+              kLinkBandwidth.ToKBitsPerSecond() / 10);
+  // The window covers the pipe without queueing much more than an RTT.
+  EXPECT_GE(kLinkBandwidth.ToBytesPerPeriod(
+                QuicTime::Delta::FromMilliseconds(1800)),
+            sender_->GetCongestionWindow());
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace net
@@ -322,6 +322,9 @@ bool QuicConfig::negotiated() {
 
 void QuicConfig::SetDefaults() {
   QuicTagVector congestion_control;
+  if (FLAGS_enable_quic_bandwidth_model) {
+    congestion_control.push_back(kTBBR);
+  }
   if (FLAGS_enable_quic_pacing) {
     congestion_control.push_back(kPACE);
   }
@@ -69,6 +69,20 @@ TEST_F(QuicConfigTest, ToHandshakeMessageWithPacing) {
   EXPECT_EQ(kQBIC, out[1]);
 }
 
+TEST_F(QuicConfigTest, ToHandshakeMessageWithBandwidthModel) {
+  ValueRestore<bool> old_flag(&FLAGS_enable_quic_bandwidth_model, true);
+
+  config_.SetDefaults();
+  CryptoHandshakeMessage msg;
+  config_.ToHandshakeMessage(&msg);
+
+  const QuicTag* out;
+  size_t out_len;
+  EXPECT_EQ(QUIC_NO_ERROR, msg.GetTaglist(kCGST, &out, &out_len));
+  EXPECT_EQ(kTBBR, out[0]);
+  EXPECT_EQ(kQBIC, out[out_len - 1]);
+}
+
 TEST_F(QuicConfigTest, ProcessClientHello) {
   QuicConfig client_config;
   QuicTagVector cgst;
@@ -6,6 +6,7 @@
 
 #include "base/logging.h"
 #include "base/stl_util.h"
+#include "net/quic/congestion_control/bandwidth_model_sender.h"
 #include "net/quic/congestion_control/pacing_sender.h"
 #include "net/quic/crypto/crypto_protocol.h"
 #include "net/quic/quic_ack_notifier_manager.h"
@@ -31,6 +32,11 @@ bool FLAGS_track_retransmission_history = false;
 // request pacing for the server to enable it.
 bool FLAGS_enable_quic_pacing = false;
 
+// If true, QUIC connections will support the bandwidth model congestion
+// control, which paces packets at its estimate of the bottleneck bandwidth
+// instead of backing off on every loss.  The peer must also request it.
+bool FLAGS_enable_quic_bandwidth_model = false;
+
 namespace net {
 namespace {
 static const int kDefaultRetransmissionTimeMs = 500;
@@ -88,6 +94,9 @@ QuicSentPacketManager::~QuicSentPacketManager() {
 }
 
 void QuicSentPacketManager::SetFromConfig(const QuicConfig& config) {
+  if (config.congestion_control() == kTBBR) {
+    MaybeEnableBandwidthModel();
+  }
   if (config.initial_round_trip_time_us() > 0 &&
       rtt_sample_.IsInfinite()) {
     // The initial rtt should already be set on the client side.
@@ -770,4 +779,17 @@ void QuicSentPacketManager::MaybeEnablePacing() {
                        QuicTime::Delta::FromMicroseconds(1)));
 }
 
+void QuicSentPacketManager::MaybeEnableBandwidthModel() {
+  if (!FLAGS_enable_quic_bandwidth_model) {
+    return;
+  }
+
+  // The bandwidth model paces by itself, so it replaces any PacingSender.
+  using_pacing_ = true;
+  send_algorithm_.reset(new BandwidthModelSender(clock_));
+  if (!rtt_sample_.IsInfinite()) {
+    send_algorithm_->UpdateRtt(rtt_sample_);
+  }
+}
+
 }  // namespace net
@@ -23,6 +23,7 @@
 
 NET_EXPORT_PRIVATE extern bool FLAGS_track_retransmission_history;
 NET_EXPORT_PRIVATE extern bool FLAGS_enable_quic_pacing;
+NET_EXPORT_PRIVATE extern bool FLAGS_enable_quic_bandwidth_model;
 
 namespace net {
 
@@ -233,6 +234,10 @@ class NET_EXPORT_PRIVATE QuicSentPacketManager {
   void MarkForRetransmission(QuicPacketSequenceNumber sequence_number,
                              TransmissionType transmission_type);
 
+  // Replaces the send algorithm with a BandwidthModelSender, if
+  // FLAGS_enable_quic_bandwidth_model is set.
+  void MaybeEnableBandwidthModel();
+
   static SequenceNumberSet DetectLostPackets(
       const QuicUnackedPacketMap& unacked_packets,
       const QuicTime& time,
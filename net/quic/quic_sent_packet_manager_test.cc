@@ -5,6 +5,7 @@
 #include "net/quic/quic_sent_packet_manager.h"
 
 #include "base/stl_util.h"
+#include "net/quic/crypto/crypto_protocol.h"
 #include "net/quic/test_tools/quic_sent_packet_manager_peer.h"
 #include "net/quic/test_tools/quic_test_utils.h"
 #include "testing/gmock/include/gmock/gmock.h"
@@ -1276,6 +1277,18 @@ TEST_F(QuicSentPacketManagerTest, GetTransmissionDelay) {
   }
 }
 
+TEST_F(QuicSentPacketManagerTest, NegotiateBandwidthModel) {
+  ValueRestore<bool> old_flag(&FLAGS_enable_quic_bandwidth_model, true);
+  QuicConfig config;
+  config.set_congestion_control(QuicTagVector(1, kTBBR), kTBBR);
+  manager_.SetFromConfig(config);
+
+  // The bandwidth model replaces the mock send algorithm and paces itself.
+  EXPECT_TRUE(manager_.using_pacing());
+  EXPECT_EQ(kDefaultInitialWindow * kMaxPacketSize,
+            manager_.GetCongestionWindow());
+}
+
 }  // namespace
 }  // namespace test
 }  // namespace net
@@ -133,8 +133,14 @@ bool QuicStreamSequencer::OnStreamFrame(const QuicStreamFrame& frame) {
   for (size_t i = 0; i < data.Size(); ++i) {
     DVLOG(1) << "Buffering stream data at offset " << byte_offset;
     const iovec& iov = data.iovec()[i];
-    frames_.insert(make_pair(
-        byte_offset, string(static_cast<char*>(iov.iov_base), iov.iov_len)));
+    // Copy the data straight into the map's string, since inserting a
+    // filled string would copy it twice more.
+    std::pair<FrameMap::iterator, bool> inserted =
+        frames_.insert(make_pair(byte_offset, string()));
+    if (inserted.second) {
+      inserted.first->second.assign(static_cast<char*>(iov.iov_base),
+                                    iov.iov_len);
+    }
     byte_offset += iov.iov_len;
     num_bytes_buffered_ += iov.iov_len;
   }
@@ -225,9 +231,7 @@ int QuicStreamSequencer::Readv(const struct iovec* iov, size_t iov_len) {
   }
   // We've finished copying.  If we have a partial frame, update it.
   if (frame_offset != 0) {
-    frames_.insert(make_pair(it->first + frame_offset,
-                             it->second.substr(frame_offset)));
-    frames_.erase(frames_.begin());
+    ReplaceWithUnconsumedData(it, frame_offset);
     RecordBytesConsumed(frame_offset);
   }
   return num_bytes_consumed_ - initial_bytes_consumed;
@@ -259,8 +263,7 @@ void QuicStreamSequencer::MarkConsumed(size_t num_bytes_consumed) {
     // Partially consume this frame.
     size_t delta = end_offset - it->first;
     RecordBytesConsumed(delta);
-    frames_.insert(make_pair(end_offset, it->second.substr(delta)));
-    frames_.erase(it);
+    ReplaceWithUnconsumedData(it, delta);
     break;
   }
 }
@@ -307,15 +310,25 @@ void QuicStreamSequencer::FlushBufferedFrames() {
       frames_.erase(it);
       it = frames_.find(num_bytes_consumed_);
     } else {
-      string new_data = it->second.substr(bytes_consumed);
-      frames_.erase(it);
-      frames_.insert(make_pair(num_bytes_consumed_, new_data));
+      ReplaceWithUnconsumedData(it, bytes_consumed);
       return;
     }
   }
   MaybeCloseStream();
 }
 
+void QuicStreamSequencer::ReplaceWithUnconsumedData(FrameMap::iterator it,
+                                                    size_t num_bytes) {
+  DCHECK_LT(num_bytes, it->second.size());
+  std::pair<FrameMap::iterator, bool> inserted =
+      frames_.insert(make_pair(it->first + num_bytes, string()));
+  if (inserted.second) {
+    inserted.first->second.swap(it->second);
+    inserted.first->second.erase(0, num_bytes);
+  }
+  frames_.erase(it);
+}
+
 void QuicStreamSequencer::RecordBytesConsumed(size_t bytes_consumed) {
   num_bytes_consumed_ += bytes_consumed;
   num_bytes_buffered_ -= bytes_consumed;
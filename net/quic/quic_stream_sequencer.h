@@ -104,6 +104,11 @@ class NET_EXPORT_PRIVATE QuicStreamSequencer {
   // TODO(alyssar) use something better than strings.
   typedef map<QuicStreamOffset, string> FrameMap;
 
+  // Replaces the frame at |it|, whose first |num_bytes| bytes have been
+  // consumed, with the rest of its data at its new offset.  The data is
+  // moved within its string rather than copied into a new one.
+  void ReplaceWithUnconsumedData(FrameMap::iterator it, size_t num_bytes);
+
   // Stores buffered frames (maps from sequence number -> frame data as string).
   FrameMap frames_;
 
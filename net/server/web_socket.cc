@@ -167,6 +167,41 @@ const size_t kTwoBytePayloadLengthField = 126;
 const size_t kEightBytePayloadLengthField = 127;
 const size_t kMaskingKeyWidthInBytes = 4;
 
+// Payloads at least this large are sent after their frame header instead of
+// being copied into a single frame buffer first. Smaller ones go out in one
+// send() so that the header doesn't end up in a segment of its own.
+const size_t kMinPayloadLengthToSendSeparately = 16 * 1024;
+
+// Returns the header of a final text frame with a payload of |data_length|
+// bytes, including the masking key if |masking_key| isn't 0.
+std::string EncodeFrameHeaderHybi17(size_t data_length, int masking_key) {
+  std::string header;
+  header.push_back(kFinalBit | kOpCodeText);
+  char mask_key_bit = masking_key != 0 ? kMaskBit : 0;
+  if (data_length <= kMaxSingleBytePayloadLength)
+    header.push_back(data_length | mask_key_bit);
+  else if (data_length <= 0xFFFF) {
+    header.push_back(kTwoBytePayloadLengthField | mask_key_bit);
+    header.push_back((data_length & 0xFF00) >> 8);
+    header.push_back(data_length & 0xFF);
+  } else {
+    header.push_back(kEightBytePayloadLengthField | mask_key_bit);
+    char extended_payload_length[8];
+    size_t remaining = data_length;
+    // Fill the length into extended_payload_length in the network byte order.
+    for (int i = 0; i < 8; ++i) {
+      extended_payload_length[7 - i] = remaining & 0xFF;
+      remaining >>= 8;
+    }
+    header.append(extended_payload_length, 8);
+    DCHECK(!remaining);
+  }
+
+  if (masking_key != 0)
+    header.append(reinterpret_cast<char*>(&masking_key), 4);
+  return header;
+}
+
 class WebSocketHybi17 : public WebSocket {
  public:
   static WebSocket* Create(HttpConnection* connection,
@@ -220,8 +255,12 @@ class WebSocketHybi17 : public WebSocket {
   virtual void Send(const std::string& message) OVERRIDE {
     if (closed_)
       return;
-    std::string data = WebSocket::EncodeFrameHybi17(message, 0);
-    connection_->Send(data);
+    if (message.length() >= kMinPayloadLengthToSendSeparately) {
+      connection_->Send(EncodeFrameHeaderHybi17(message.length(), 0));
+      connection_->Send(message);
+      return;
+    }
+    connection_->Send(WebSocket::EncodeFrameHybi17(message, 0));
   }
 
  private:
@@ -361,43 +400,22 @@ WebSocket::ParseResult WebSocket::DecodeFrameHybi17(const std::string& frame,
 // static
 std::string WebSocket::EncodeFrameHybi17(const std::string& message,
                                          int masking_key) {
-  std::vector<char> frame;
-  OpCode op_code = kOpCodeText;
   size_t data_length = message.length();
-
-  frame.push_back(kFinalBit | op_code);
-  char mask_key_bit = masking_key != 0 ? kMaskBit : 0;
-  if (data_length <= kMaxSingleBytePayloadLength)
-    frame.push_back(data_length | mask_key_bit);
-  else if (data_length <= 0xFFFF) {
-    frame.push_back(kTwoBytePayloadLengthField | mask_key_bit);
-    frame.push_back((data_length & 0xFF00) >> 8);
-    frame.push_back(data_length & 0xFF);
-  } else {
-    frame.push_back(kEightBytePayloadLengthField | mask_key_bit);
-    char extended_payload_length[8];
-    size_t remaining = data_length;
-    // Fill the length into extended_payload_length in the network byte order.
-    for (int i = 0; i < 8; ++i) {
-      extended_payload_length[7 - i] = remaining & 0xFF;
-      remaining >>= 8;
-    }
-    frame.insert(frame.end(),
-                 extended_payload_length,
-                 extended_payload_length + 8);
-    DCHECK(!remaining);
+  std::string frame = EncodeFrameHeaderHybi17(data_length, masking_key);
+  if (masking_key == 0) {
+    frame.append(message);
+    return frame;
   }
 
-  const char* data = const_cast<char*>(message.data());
-  if (masking_key != 0) {
-    const char* mask_bytes = reinterpret_cast<char*>(&masking_key);
-    frame.insert(frame.end(), mask_bytes, mask_bytes + 4);
-    for (size_t i = 0; i < data_length; ++i)  // Mask the payload.
-      frame.push_back(data[i] ^ mask_bytes[i % kMaskingKeyWidthInBytes]);
-  } else {
-    frame.insert(frame.end(), data, data + data_length);
+  const size_t header_length = frame.length();
+  frame.resize(header_length + data_length);
+  const char* data = message.data();
+  const char* mask_bytes = reinterpret_cast<char*>(&masking_key);
+  for (size_t i = 0; i < data_length; ++i) {  // Mask the payload.
+    frame[header_length + i] =
+        data[i] ^ mask_bytes[i % kMaskingKeyWidthInBytes];
   }
-  return std::string(&frame[0], frame.size());
+  return frame;
 }
 
 WebSocket::WebSocket(HttpConnection* connection) : connection_(connection) {
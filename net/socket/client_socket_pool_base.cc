@@ -451,7 +451,7 @@ bool ClientSocketPoolBaseHelper::AssignIdleSocketToRequest(
        it != idle_sockets->end();) {
     if (!it->socket->IsConnectedAndIdle()) {
       DecrementIdleCount();
-      delete it->socket;
+      it->DeleteSocket(base::TimeTicks::Now());
       it = idle_sockets->erase(it);
       continue;
     }
@@ -476,6 +476,12 @@ bool ClientSocketPoolBaseHelper::AssignIdleSocketToRequest(
         base::TimeTicks::Now() - idle_socket_it->start_time;
     IdleSocket idle_socket = *idle_socket_it;
     idle_sockets->erase(idle_socket_it);
+    if (!idle_socket.socket->WasEverUsed()) {
+      request.net_log().AddEvent(
+          NetLog::TYPE_SOCKET_POOL_PRECONNECT_HIT,
+          NetLog::IntegerCallback(
+              "idle_ms", static_cast<int>(idle_time.InMilliseconds())));
+    }
     HandOutSocket(
         scoped_ptr<StreamSocket>(idle_socket.socket),
         idle_socket.socket->WasEverUsed(),
@@ -653,6 +659,18 @@ bool ClientSocketPoolBaseHelper::IdleSocket::ShouldCleanup(
   return !socket->IsConnected();
 }
 
+void ClientSocketPoolBaseHelper::IdleSocket::DeleteSocket(
+    base::TimeTicks now) {
+  if (!socket->WasEverUsed()) {
+    int idle_ms = static_cast<int>((now - start_time).InMilliseconds());
+    socket->NetLog().AddEvent(
+        NetLog::TYPE_SOCKET_POOL_PRECONNECT_WASTED,
+        NetLog::IntegerCallback("idle_ms", idle_ms));
+  }
+  delete socket;
+  socket = NULL;
+}
+
 void ClientSocketPoolBaseHelper::CleanupIdleSockets(bool force) {
   if (idle_socket_count_ == 0)
     return;
@@ -671,7 +689,7 @@ void ClientSocketPoolBaseHelper::CleanupIdleSockets(bool force) {
           j->socket->WasEverUsed() ?
           used_idle_socket_timeout_ : unused_idle_socket_timeout_;
       if (force || j->ShouldCleanup(now, timeout)) {
-        delete j->socket;
+        j->DeleteSocket(now);
         j = group->mutable_idle_sockets()->erase(j);
         DecrementIdleCount();
       } else {
@@ -1066,24 +1084,33 @@ bool ClientSocketPoolBaseHelper::CloseOneIdleSocketExceptInGroup(
     const Group* exception_group) {
   CHECK_GT(idle_socket_count(), 0);
 
+  // Close the socket that has been idle the longest, so that the sockets of
+  // recently used hosts survive. Each group's idle list is in the order the
+  // sockets became idle, so only the front of each list needs checking.
+  GroupMap::iterator oldest = group_map_.end();
   for (GroupMap::iterator i = group_map_.begin(); i != group_map_.end(); ++i) {
     Group* group = i->second;
-    if (exception_group == group)
+    if (exception_group == group || group->idle_sockets().empty())
       continue;
-    std::list<IdleSocket>* idle_sockets = group->mutable_idle_sockets();
-
-    if (!idle_sockets->empty()) {
-      delete idle_sockets->front().socket;
-      idle_sockets->pop_front();
-      DecrementIdleCount();
-      if (group->IsEmpty())
-        RemoveGroup(i);
-
-      return true;
+    if (oldest == group_map_.end() ||
+        group->idle_sockets().front().start_time <
+            oldest->second->idle_sockets().front().start_time) {
+      oldest = i;
     }
   }
 
-  return false;
+  if (oldest == group_map_.end())
+    return false;
+
+  Group* group = oldest->second;
+  std::list<IdleSocket>* idle_sockets = group->mutable_idle_sockets();
+  idle_sockets->front().DeleteSocket(base::TimeTicks::Now());
+  idle_sockets->pop_front();
+  DecrementIdleCount();
+  if (group->IsEmpty())
+    RemoveGroup(oldest);
+
+  return true;
 }
 
 bool ClientSocketPoolBaseHelper::CloseOneIdleConnectionInHigherLayeredPool() {
@@ -348,6 +348,10 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
     // socket for a new request.
     bool ShouldCleanup(base::TimeTicks now, base::TimeDelta timeout) const;
 
+    // Deletes |socket|, logging a SOCKET_POOL_PRECONNECT_WASTED event on it if
+    // it was never used.
+    void DeleteSocket(base::TimeTicks now);
+
     StreamSocket* socket;
     base::TimeTicks start_time;
   };
@@ -563,8 +567,8 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
       const NetLog::Source& connect_job_source, const Request& request);
 
   // Same as CloseOneIdleSocket() except it won't close an idle socket in
-  // |group|.  If |group| is NULL, it is ignored.  Returns true if it closed a
-  // socket.
+  // |group|.  If |group| is NULL, it is ignored.  Closes the socket that has
+  // been idle the longest.  Returns true if it closed a socket.
   bool CloseOneIdleSocketExceptInGroup(const Group* group);
 
   // Checks if there are stalled socket groups that should be notified
@@ -3431,6 +3431,39 @@ TEST_F(ClientSocketPoolBaseTest, RequestSocketsSynchronousError) {
   ASSERT_FALSE(pool_->HasGroup("a"));
 }
 
+TEST_F(ClientSocketPoolBaseTest, RequestSocketsLogsHitsAndWaste) {
+  CreatePool(kDefaultMaxSockets, kDefaultMaxSocketsPerGroup);
+  connect_job_factory_->set_job_type(TestConnectJob::kMockJob);
+
+  pool_->RequestSockets("a", &params_, 2, BoundNetLog());
+  ASSERT_EQ(2, pool_->IdleSocketCountInGroup("a"));
+
+  // A request takes one of the preconnected sockets.
+  ClientSocketHandle handle;
+  TestCompletionCallback callback;
+  CapturingBoundNetLog log;
+  EXPECT_EQ(OK, handle.Init("a", params_, DEFAULT_PRIORITY,
+                            callback.callback(), pool_.get(), log.bound()));
+  EXPECT_FALSE(handle.is_reused());
+
+  CapturingNetLog::CapturedEntryList entries;
+  log.GetEntries(&entries);
+  EXPECT_TRUE(LogContainsEntryWithType(
+      entries, 1, NetLog::TYPE_SOCKET_POOL_PRECONNECT_HIT));
+
+  // The other one is closed without ever having been used.
+  pool_->CloseIdleSockets();
+  EXPECT_EQ(0, pool_->IdleSocketCountInGroup("a"));
+
+  net_log_.GetEntries(&entries);
+  size_t wasted_count = 0;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    if (entries[i].type == NetLog::TYPE_SOCKET_POOL_PRECONNECT_WASTED)
+      ++wasted_count;
+  }
+  EXPECT_EQ(1u, wasted_count);
+}
+
 TEST_F(ClientSocketPoolBaseTest, RequestSocketsMultipleTimesDoesNothing) {
   CreatePool(4, 4);
   connect_job_factory_->set_job_type(TestConnectJob::kMockPendingJob);
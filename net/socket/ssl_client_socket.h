@@ -112,6 +112,18 @@ class NET_EXPORT SSLClientSocket : public SSLSocket {
   // sessions.
   static void ClearSessionCache();
 
+  // SerializeSessionCache writes the resumable sessions of the SSL session
+  // cache to |data|, so that a later run can restore them with
+  // RestoreSessionCache(). |data| holds the master secrets of the sessions
+  // and must be protected accordingly. Returns false if the SSL library does
+  // not support saving its sessions.
+  static bool SerializeSessionCache(std::string* data);
+
+  // RestoreSessionCache adds the unexpired sessions of |data|, as written by
+  // SerializeSessionCache(), to the SSL session cache. Returns the number of
+  // sessions added.
+  static size_t RestoreSessionCache(const std::string& data);
+
   virtual bool set_was_npn_negotiated(bool negotiated);
 
   virtual bool was_spdy_negotiated() const;
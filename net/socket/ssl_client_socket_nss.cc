@@ -2811,6 +2811,17 @@ void SSLClientSocket::ClearSessionCache() {
   SSL_ClearSessionCache();
 }
 
+// static
+bool SSLClientSocket::SerializeSessionCache(std::string* data) {
+  // NSS keeps its client session cache private.
+  return false;
+}
+
+// static
+size_t SSLClientSocket::RestoreSessionCache(const std::string& data) {
+  return 0;
+}
+
 bool SSLClientSocketNSS::GetSSLInfo(SSLInfo* ssl_info) {
   EnterFunction("");
   ssl_info->Reset();
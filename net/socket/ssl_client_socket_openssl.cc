@@ -336,6 +336,21 @@ void SSLClientSocket::ClearSessionCache() {
   OpenSSLClientKeyStore::GetInstance()->Flush();
 }
 
+// static
+bool SSLClientSocket::SerializeSessionCache(std::string* data) {
+  SSLClientSocketOpenSSL::SSLContext* context =
+      SSLClientSocketOpenSSL::SSLContext::GetInstance();
+  context->session_cache()->Serialize(data);
+  return true;
+}
+
+// static
+size_t SSLClientSocket::RestoreSessionCache(const std::string& data) {
+  SSLClientSocketOpenSSL::SSLContext* context =
+      SSLClientSocketOpenSSL::SSLContext::GetInstance();
+  return context->session_cache()->Deserialize(data);
+}
+
 SSLClientSocketOpenSSL::SSLClientSocketOpenSSL(
     scoped_ptr<ClientSocketHandle> transport_socket,
     const HostPortPair& host_and_port,
@@ -6,6 +6,8 @@
 
 #include <list>
 #include <map>
+#include <utility>
+#include <vector>
 
 #include <openssl/rand.h>
 #include <openssl/ssl.h>
@@ -13,12 +15,16 @@
 #include "base/containers/hash_tables.h"
 #include "base/lazy_instance.h"
 #include "base/logging.h"
+#include "base/pickle.h"
 #include "base/synchronization/lock.h"
 
 namespace net {
 
 namespace {
 
+// Version of the data written by SSLSessionCacheOpenSSL::Serialize().
+const int kSerializationVersion = 1;
+
 // A helper class to lazily create a new EX_DATA index to map SSL_CTX handles
 // to their corresponding SSLSessionCacheOpenSSLImpl object.
 class SSLContextExIndex {
@@ -54,6 +60,23 @@ static int GetSSLSessionExIndex() {
   return s_ssl_context_ex_instance.Get().session_index();
 }
 
+// Returns true if |session| can no longer be resumed at time |now|, either
+// because it timed out or because the lifetime of its ticket is over.
+bool IsSessionExpired(const SSL_SESSION* session, long now) {
+  // Use <= rather than < so that sessions with a timeout of 0 seconds expire
+  // immediately, which unit tests rely on.
+  if (session->time + session->timeout <= now)
+    return true;
+#if !defined(OPENSSL_NO_TLSEXT)
+  if (session->tlsext_tick && session->tlsext_tick_lifetime_hint > 0 &&
+      session->time + static_cast<long>(session->tlsext_tick_lifetime_hint) <=
+          now) {
+    return true;
+  }
+#endif
+  return false;
+}
+
 // Helper struct used to store session IDs in a SessionIdIndex container
 // (see definition below). To save memory each entry only holds a pointer
 // to the session ID buffer, which must outlive the entry itself. On the
@@ -258,6 +281,100 @@ class SSLSessionCacheOpenSSLImpl {
     }
   }
 
+  void Serialize(std::string* data) {
+    base::AutoLock locked(lock_);
+    long now = static_cast<long>(::time(NULL));
+
+    std::vector<std::pair<std::string, std::string> > entries;
+    for (MRUSessionList::const_iterator it = ordering_.begin();
+         it != ordering_.end(); ++it) {
+      SSL_SESSION* session = *it;
+      if (!SSL_SESSION_get_ex_data(session, GetSSLSessionExIndex()) ||
+          IsSessionExpired(session, now)) {
+        continue;
+      }
+      SessionIdIndex::iterator id_it = id_index_.find(SessionId(session));
+      DCHECK(id_it != id_index_.end());
+
+      int length = i2d_SSL_SESSION(session, NULL);
+      if (length <= 0)
+        continue;
+      std::string der(length, '\0');
+      unsigned char* der_data = reinterpret_cast<unsigned char*>(&der[0]);
+      if (i2d_SSL_SESSION(session, &der_data) != length)
+        continue;
+
+      entries.push_back(std::make_pair(id_it->second->first, der));
+    }
+
+    Pickle pickle;
+    pickle.WriteInt(kSerializationVersion);
+    pickle.WriteInt(static_cast<int>(entries.size()));
+    for (size_t n = 0; n < entries.size(); ++n) {
+      pickle.WriteString(entries[n].first);
+      pickle.WriteString(entries[n].second);
+    }
+    data->assign(static_cast<const char*>(pickle.data()), pickle.size());
+  }
+
+  size_t Deserialize(const std::string& data) {
+    Pickle pickle(data.data(), static_cast<int>(data.size()));
+    PickleIterator iter(pickle);
+    int version = 0;
+    int count = 0;
+    if (!pickle.ReadInt(&iter, &version) ||
+        version != kSerializationVersion ||
+        !pickle.ReadInt(&iter, &count)) {
+      return 0;
+    }
+
+    base::AutoLock locked(lock_);
+    long now = static_cast<long>(::time(NULL));
+    size_t added = 0;
+    for (int n = 0; n < count; ++n) {
+      std::string cache_key;
+      std::string der;
+      if (!pickle.ReadString(&iter, &cache_key) ||
+          !pickle.ReadString(&iter, &der)) {
+        break;
+      }
+      if (cache_key.empty() || key_index_.find(cache_key) != key_index_.end())
+        continue;
+
+      const unsigned char* der_data =
+          reinterpret_cast<const unsigned char*>(der.data());
+      SSL_SESSION* session =
+          d2i_SSL_SESSION(NULL, &der_data, static_cast<long>(der.size()));
+      if (!session)
+        continue;
+      if (session->session_id_length == 0 || IsSessionExpired(session, now) ||
+          id_index_.find(SessionId(session)) != id_index_.end()) {
+        SSL_SESSION_free(session);
+        continue;
+      }
+
+      // The session was validated when it was first established.
+      SSL_SESSION_set_ex_data(
+          session, GetSSLSessionExIndex(), reinterpret_cast<void*>(1));
+
+      // Entries are read most recently used first, so append them to keep
+      // their order behind the sessions of this run.
+      ordering_.push_back(session);
+      MRUSessionList::iterator node = ordering_.end();
+      --node;
+      std::pair<KeyIndex::iterator, bool> ret =
+          key_index_.insert(std::make_pair(cache_key, node));
+      DCHECK(ret.second);
+      id_index_[SessionId(session)] = ret.first;
+      ++added;
+    }
+
+    if (key_index_.size() > config_.max_entries)
+      ShrinkCacheLocked();
+    DCHECK_EQ(key_index_.size(), id_index_.size());
+    return added;
+  }
+
  private:
   // Type for list of SSL_SESSION handles, ordered in MRU order.
   typedef std::list<SSL_SESSION*> MRUSessionList;
@@ -317,10 +434,7 @@ class SSLSessionCacheOpenSSLImpl {
     while (it != ordering_.end()) {
       SSL_SESSION* session = *it++;
 
-      // Important, use <= instead of < here to allow unit testing to
-      // work properly. That's because unit tests that check the expiration
-      // behaviour will use a session timeout of 0 seconds.
-      if (session->time + session->timeout <= timeout_secs) {
+      if (IsSessionExpired(session, timeout_secs)) {
         DVLOG(2) << "Expiring session " << session << " for "
                  << SessionKey(session);
         RemoveSessionLocked(session);
@@ -505,4 +619,12 @@ void SSLSessionCacheOpenSSL::MarkSSLSessionAsGood(SSL* ssl) {
 
 void SSLSessionCacheOpenSSL::Flush() { impl_->Flush(); }
 
+void SSLSessionCacheOpenSSL::Serialize(std::string* data) const {
+  impl_->Serialize(data);
+}
+
+size_t SSLSessionCacheOpenSSL::Deserialize(const std::string& data) {
+  return impl_->Deserialize(data);
+}
+
 }  // namespace net
@@ -44,6 +44,9 @@ class SSLSessionCacheOpenSSLImpl;
 //  - Clients can call Flush() to remove all sessions from the cache, this is
 //    useful when the system's certificate store has changed.
 //
+//  - Clients can call Serialize() to save the resumable sessions, and
+//    Deserialize() to add them back to a cache in a later run.
+//
 // This class is thread-safe. There shouldn't be any issue with multiple
 // SSL connections being performed in parallel in multiple threads.
 class NET_EXPORT SSLSessionCacheOpenSSL {
@@ -125,6 +128,17 @@ class NET_EXPORT SSLSessionCacheOpenSSL {
   // the system's certificate store has changed.
   void Flush();
 
+  // Writes the sessions of the cache that are marked good and have not
+  // expired to |data|, most recently used first. Note that |data| holds the
+  // master secrets of the sessions.
+  void Serialize(std::string* data) const;
+
+  // Adds the unexpired sessions of |data|, as written by Serialize(), to the
+  // cache as good sessions which are less recently used than the ones already
+  // in it. Sessions whose key already has one in the cache are skipped.
+  // Returns the number of sessions added.
+  size_t Deserialize(const std::string& data);
+
   // TODO(digit): Move to client code.
   static const int kDefaultTimeoutSeconds = 60 * 60;
   static const size_t kMaxEntries = 1024;
@@ -375,4 +375,61 @@ TEST_F(SSLSessionCacheOpenSSLTest, CheckExpiration) {
   EXPECT_EQ(1U, cache_.size());
 }
 
+// Check that good sessions survive serialization, and other ones don't.
+TEST_F(SSLSessionCacheOpenSSLTest, SerializeAndDeserialize) {
+  const std::string key("good-key");
+  ScopedSSL ssl(NewSSL(key));
+  // Sessions can only be encoded once a cipher was negotiated.
+  ssl.get()->session->cipher = sk_SSL_CIPHER_value(SSL_get_ciphers(ssl.get()),
+                                                   0);
+  AddToCache(ssl.get());
+  cache_.MarkSSLSessionAsGood(ssl.get());
+  ssl.reset(NULL);
+
+  ScopedSSL not_good_ssl(NewSSL("not-good-key"));
+  not_good_ssl.get()->session->cipher =
+      sk_SSL_CIPHER_value(SSL_get_ciphers(not_good_ssl.get()), 0);
+  AddToCache(not_good_ssl.get());
+  not_good_ssl.reset(NULL);
+  EXPECT_EQ(2U, cache_.size());
+
+  std::string data;
+  cache_.Serialize(&data);
+  cache_.Flush();
+  EXPECT_EQ(0U, cache_.size());
+
+  EXPECT_EQ(1U, cache_.Deserialize(data));
+  EXPECT_EQ(1U, cache_.size());
+  ScopedSSL ssl2(NewSSL(key));
+  EXPECT_TRUE(cache_.SetSSLSessionWithKey(ssl2.get(), key));
+
+  // Sessions whose key is already in the cache are not added again.
+  EXPECT_EQ(0U, cache_.Deserialize(data));
+  EXPECT_EQ(1U, cache_.size());
+
+  // Invalid data is ignored.
+  cache_.Flush();
+  EXPECT_EQ(0U, cache_.Deserialize("garbage"));
+  EXPECT_EQ(0U, cache_.Deserialize(data.substr(0, data.size() / 2)));
+}
+
+// Check that expired sessions are neither serialized nor restored.
+TEST_F(SSLSessionCacheOpenSSLTest, SerializeSkipsExpiredSessions) {
+  ScopedSSL ssl(NewSSL("expired-key"));
+  ssl.get()->session->cipher = sk_SSL_CIPHER_value(SSL_get_ciphers(ssl.get()),
+                                                   0);
+  // Like in CheckExpiration, a time this close to the epoch has expired.
+  ssl.get()->session->time = 1;
+  AddToCache(ssl.get());
+  cache_.MarkSSLSessionAsGood(ssl.get());
+  ssl.reset(NULL);
+  EXPECT_EQ(1U, cache_.size());
+
+  std::string data;
+  cache_.Serialize(&data);
+  cache_.Flush();
+  EXPECT_EQ(0U, cache_.Deserialize(data));
+  EXPECT_EQ(0U, cache_.size());
+}
+
 }  // namespace net
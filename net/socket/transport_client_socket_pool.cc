@@ -28,10 +28,11 @@ using base::TimeDelta;
 
 namespace net {
 
-// TODO(willchan): Base this off RTT instead of statically setting it. Note we
-// choose a timeout that is different from the backup connect job timer so they
-// don't synchronize.
+// The longest and the shortest IPv6 fallback delays. Note we choose a maximum
+// that is different from the backup connect job timer so they don't
+// synchronize.
 const int TransportConnectJob::kIPv6FallbackTimerInMs = 300;
+const int IPv6FallbackDelayEstimator::kMinIPv6FallbackDelayInMs = 50;
 
 namespace {
 
@@ -56,6 +57,49 @@ static base::LazyInstance<base::Lock>::Leaky
 static base::LazyInstance<base::TimeTicks>::Leaky
     g_last_connect_time = LAZY_INSTANCE_INITIALIZER;
 
+IPv6FallbackDelayEstimator::IPv6FallbackDelayEstimator()
+    : consecutive_ipv6_failures_(0) {
+  NetworkChangeNotifier::AddIPAddressObserver(this);
+}
+
+IPv6FallbackDelayEstimator::~IPv6FallbackDelayEstimator() {
+  NetworkChangeNotifier::RemoveIPAddressObserver(this);
+}
+
+base::TimeDelta IPv6FallbackDelayEstimator::GetFallbackDelay() const {
+  TimeDelta delay = TimeDelta::FromMilliseconds(
+      TransportConnectJob::kIPv6FallbackTimerInMs);
+  // Leave a working IPv6 path room for a slower than usual connect.
+  if (smoothed_ipv6_connect_time_ > TimeDelta())
+    delay = std::min(delay, smoothed_ipv6_connect_time_ * 2);
+  // Halve the delay each time IPv6 let us down in a row.
+  for (int i = 0; i < consecutive_ipv6_failures_; ++i)
+    delay /= 2;
+  return std::max(delay,
+                  TimeDelta::FromMilliseconds(kMinIPv6FallbackDelayInMs));
+}
+
+void IPv6FallbackDelayEstimator::OnIPv6ConnectSucceeded(TimeDelta duration) {
+  consecutive_ipv6_failures_ = 0;
+  if (smoothed_ipv6_connect_time_ == TimeDelta()) {
+    smoothed_ipv6_connect_time_ = duration;
+  } else {
+    smoothed_ipv6_connect_time_ =
+        (smoothed_ipv6_connect_time_ * 7 + duration) / 8;
+  }
+}
+
+void IPv6FallbackDelayEstimator::OnIPv6ConnectFailed() {
+  // Past a few failures the delay is at its minimum anyway.
+  if (consecutive_ipv6_failures_ < 8)
+    ++consecutive_ipv6_failures_;
+}
+
+void IPv6FallbackDelayEstimator::OnIPAddressChanged() {
+  smoothed_ipv6_connect_time_ = TimeDelta();
+  consecutive_ipv6_failures_ = 0;
+}
+
 TransportSocketParams::TransportSocketParams(
     const HostPortPair& host_port_pair,
     bool disable_resolver_cache,
@@ -88,6 +132,7 @@ TransportConnectJob::TransportConnectJob(
     base::TimeDelta timeout_duration,
     ClientSocketFactory* client_socket_factory,
     HostResolver* host_resolver,
+    IPv6FallbackDelayEstimator* fallback_delay_estimator,
     Delegate* delegate,
     NetLog* net_log)
     : ConnectJob(group_name, timeout_duration, priority, delegate,
@@ -95,6 +140,7 @@ TransportConnectJob::TransportConnectJob(
       params_(params),
       client_socket_factory_(client_socket_factory),
       resolver_(host_resolver),
+      fallback_delay_estimator_(fallback_delay_estimator),
       next_state_(STATE_NONE),
       interval_between_connects_(CONNECT_INTERVAL_GT_20MS) {
 }
@@ -224,9 +270,14 @@ int TransportConnectJob::DoTransportConnect() {
   if (rv == ERR_IO_PENDING &&
       addresses_.front().GetFamily() == ADDRESS_FAMILY_IPV6 &&
       !AddressListOnlyContainsIPv6(addresses_)) {
-    fallback_timer_.Start(FROM_HERE,
-        base::TimeDelta::FromMilliseconds(kIPv6FallbackTimerInMs),
-        this, &TransportConnectJob::DoIPv6FallbackTransportConnect);
+    fallback_delay_ = fallback_delay_estimator_->GetFallbackDelay();
+    UMA_HISTOGRAM_CUSTOM_TIMES("Net.TCP_Connection_IPv6_Fallback_Delay",
+                               fallback_delay_,
+                               base::TimeDelta::FromMilliseconds(1),
+                               base::TimeDelta::FromSeconds(1),
+                               50);
+    fallback_timer_.Start(FROM_HERE, fallback_delay_, this,
+                          &TransportConnectJob::DoIPv6FallbackTransportConnect);
   }
   return rv;
 }
@@ -302,10 +353,21 @@ int TransportConnectJob::DoTransportConnectComplete(int result) {
                                    base::TimeDelta::FromMinutes(10),
                                    100);
       }
+      fallback_delay_estimator_->OnIPv6ConnectSucceeded(connect_duration);
     }
     SetSocket(transport_socket_.Pass());
     fallback_timer_.Stop();
   } else {
+    if (addresses_.front().GetFamily() == ADDRESS_FAMILY_IPV6)
+      fallback_delay_estimator_->OnIPv6ConnectFailed();
+
+    // The IPv4 connect may still win the race.
+    if (fallback_transport_socket_.get()) {
+      transport_socket_.reset();
+      next_state_ = STATE_TRANSPORT_CONNECT_COMPLETE;
+      return ERR_IO_PENDING;
+    }
+
     // Be a bit paranoid and kill off the fallback members to prevent reuse.
     fallback_transport_socket_.reset();
     fallback_addresses_.reset();
@@ -374,6 +436,19 @@ void TransportConnectJob::DoIPv6FallbackTransportConnectComplete(int result) {
         base::TimeDelta::FromMilliseconds(1),
         base::TimeDelta::FromMinutes(10),
         100);
+
+    // How much sooner than with the fixed delay the race was started.
+    UMA_HISTOGRAM_CUSTOM_TIMES(
+        "Net.TCP_Connection_IPv6_Fallback_Delay_Saved",
+        base::TimeDelta::FromMilliseconds(kIPv6FallbackTimerInMs) -
+            fallback_delay_,
+        base::TimeDelta::FromMilliseconds(1),
+        base::TimeDelta::FromSeconds(1),
+        50);
+
+    // The IPv6 connect was still running, so it lost the race.
+    if (transport_socket_.get())
+      fallback_delay_estimator_->OnIPv6ConnectFailed();
     SetSocket(fallback_transport_socket_.Pass());
     next_state_ = STATE_NONE;
     transport_socket_.reset();
@@ -381,6 +456,10 @@ void TransportConnectJob::DoIPv6FallbackTransportConnectComplete(int result) {
     // Be a bit paranoid and kill off the fallback members to prevent reuse.
     fallback_transport_socket_.reset();
     fallback_addresses_.reset();
+
+    // The IPv6 connect may still win the race.
+    if (transport_socket_.get())
+      return;
   }
   NotifyDelegateOfCompletion(result);  // Deletes |this|
 }
@@ -402,6 +481,7 @@ scoped_ptr<ConnectJob>
                               ConnectionTimeout(),
                               client_socket_factory_,
                               host_resolver_,
+                              fallback_delay_estimator_,
                               delegate,
                               net_log_));
 }
@@ -423,7 +503,9 @@ TransportClientSocketPool::TransportClientSocketPool(
             ClientSocketPool::unused_idle_socket_timeout(),
             ClientSocketPool::used_idle_socket_timeout(),
             new TransportConnectJobFactory(client_socket_factory,
-                                           host_resolver, net_log)) {
+                                           host_resolver,
+                                           &fallback_delay_estimator_,
+                                           net_log)) {
   base_.EnableConnectBackupJobs();
 }
 
@@ -13,6 +13,7 @@
 #include "base/time/time.h"
 #include "base/timer/timer.h"
 #include "net/base/host_port_pair.h"
+#include "net/base/network_change_notifier.h"
 #include "net/dns/host_resolver.h"
 #include "net/dns/single_request_host_resolver.h"
 #include "net/socket/client_socket_pool.h"
@@ -55,14 +56,52 @@ class NET_EXPORT_PRIVATE TransportSocketParams
   DISALLOW_COPY_AND_ASSIGN(TransportSocketParams);
 };
 
+// Learns how long a TransportConnectJob should let an IPv6 connect() run
+// before racing it against an IPv4 one, from the IPv6 connects seen on the
+// current network. A network with fast IPv6 gets a delay of a couple of its
+// connect times, and one on which IPv6 keeps failing or losing races gets a
+// shorter delay each time. The estimate starts over when the IP address
+// changes, which usually means a different network.
+class NET_EXPORT_PRIVATE IPv6FallbackDelayEstimator
+    : public NetworkChangeNotifier::IPAddressObserver {
+ public:
+  IPv6FallbackDelayEstimator();
+  virtual ~IPv6FallbackDelayEstimator();
+
+  // Returns how long to wait before starting the IPv4 connect().
+  base::TimeDelta GetFallbackDelay() const;
+
+  // Records an IPv6 connect() which won its race after |duration|.
+  void OnIPv6ConnectSucceeded(base::TimeDelta duration);
+
+  // Records an IPv6 connect() which failed or lost its race.
+  void OnIPv6ConnectFailed();
+
+  // NetworkChangeNotifier::IPAddressObserver methods.
+  virtual void OnIPAddressChanged() OVERRIDE;
+
+  static const int kMinIPv6FallbackDelayInMs;
+
+ private:
+  // Smoothed duration of the IPv6 connects which succeeded, zero if none did.
+  base::TimeDelta smoothed_ipv6_connect_time_;
+
+  // Number of IPv6 connects in a row which failed or lost their race.
+  int consecutive_ipv6_failures_;
+
+  DISALLOW_COPY_AND_ASSIGN(IPv6FallbackDelayEstimator);
+};
+
 // TransportConnectJob handles the host resolution necessary for socket creation
 // and the transport (likely TCP) connect. TransportConnectJob also has fallback
 // logic for IPv6 connect() timeouts (which may happen due to networks / routers
 // with broken IPv6 support). Those timeouts take 20s, so rather than make the
-// user wait 20s for the timeout to fire, we use a fallback timer
-// (kIPv6FallbackTimerInMs) and start a connect() to a IPv4 address if the timer
-// fires. Then we race the IPv4 connect() against the IPv6 connect() (which has
-// a headstart) and return the one that completes first to the socket pool.
+// user wait 20s for the timeout to fire, we use a fallback timer, whose delay
+// comes from |fallback_delay_estimator| and is at most kIPv6FallbackTimerInMs,
+// and start a connect() to a IPv4 address if the timer fires. Then we race the
+// IPv4 connect() against the IPv6 connect() (which has a headstart) and return
+// the one that completes first to the socket pool. The job only fails once
+// both have failed.
 class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
  public:
   TransportConnectJob(const std::string& group_name,
@@ -71,6 +110,7 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
                       base::TimeDelta timeout_duration,
                       ClientSocketFactory* client_socket_factory,
                       HostResolver* host_resolver,
+                      IPv6FallbackDelayEstimator* fallback_delay_estimator,
                       Delegate* delegate,
                       NetLog* net_log);
   virtual ~TransportConnectJob();
@@ -121,6 +161,7 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
   scoped_refptr<TransportSocketParams> params_;
   ClientSocketFactory* const client_socket_factory_;
   SingleRequestHostResolver resolver_;
+  IPv6FallbackDelayEstimator* const fallback_delay_estimator_;
   AddressList addresses_;
   State next_state_;
 
@@ -130,6 +171,8 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
   scoped_ptr<AddressList> fallback_addresses_;
   base::TimeTicks fallback_connect_start_time_;
   base::OneShotTimer<TransportConnectJob> fallback_timer_;
+  // How long |fallback_timer_| was started for.
+  base::TimeDelta fallback_delay_;
 
   // Track the interval between this connect and previous connect.
   ConnectInterval interval_between_connects_;
@@ -193,11 +236,14 @@ class NET_EXPORT_PRIVATE TransportClientSocketPool : public ClientSocketPool {
   class TransportConnectJobFactory
       : public PoolBase::ConnectJobFactory {
    public:
-    TransportConnectJobFactory(ClientSocketFactory* client_socket_factory,
-                         HostResolver* host_resolver,
-                         NetLog* net_log)
+    TransportConnectJobFactory(
+        ClientSocketFactory* client_socket_factory,
+        HostResolver* host_resolver,
+        IPv6FallbackDelayEstimator* fallback_delay_estimator,
+        NetLog* net_log)
         : client_socket_factory_(client_socket_factory),
           host_resolver_(host_resolver),
+          fallback_delay_estimator_(fallback_delay_estimator),
           net_log_(net_log) {}
 
     virtual ~TransportConnectJobFactory() {}
@@ -214,11 +260,15 @@ class NET_EXPORT_PRIVATE TransportClientSocketPool : public ClientSocketPool {
    private:
     ClientSocketFactory* const client_socket_factory_;
     HostResolver* const host_resolver_;
+    IPv6FallbackDelayEstimator* const fallback_delay_estimator_;
     NetLog* net_log_;
 
     DISALLOW_COPY_AND_ASSIGN(TransportConnectJobFactory);
   };
 
+  // Shared by the jobs of |base_|, so it is declared first.
+  IPv6FallbackDelayEstimator fallback_delay_estimator_;
+
   PoolBase base_;
 
   DISALLOW_COPY_AND_ASSIGN(TransportClientSocketPool);
@@ -1370,6 +1370,77 @@ TEST_F(TransportClientSocketPoolTest, IPv4HasNoFallback) {
   EXPECT_EQ(1, client_socket_factory_.allocation_count());
 }
 
+// Test the case of the IPv4 fallback failing while the slow IPv6 connect is
+// still running, which then wins the race.
+TEST_F(TransportClientSocketPoolTest, IPv6FallbackSocketIPv4Fails) {
+  // Create a pool without backup jobs.
+  ClientSocketPoolBaseHelper::set_connect_backup_jobs_enabled(false);
+  TransportClientSocketPool pool(kMaxSockets,
+                                 kMaxSocketsPerGroup,
+                                 histograms_.get(),
+                                 host_resolver_.get(),
+                                 &client_socket_factory_,
+                                 NULL);
+
+  MockClientSocketFactory::ClientSocketType case_types[] = {
+    // This is the IPv6 socket.
+    MockClientSocketFactory::MOCK_DELAYED_CLIENT_SOCKET,
+    // This is the IPv4 socket.
+    MockClientSocketFactory::MOCK_PENDING_FAILING_CLIENT_SOCKET
+  };
+
+  client_socket_factory_.set_client_socket_types(case_types, 2);
+  client_socket_factory_.set_delay(base::TimeDelta::FromMilliseconds(
+      TransportConnectJob::kIPv6FallbackTimerInMs + 50));
+
+  // Resolve an AddressList with a IPv6 address first and then a IPv4 address.
+  host_resolver_->rules()
+      ->AddIPLiteralRule("*", "2:abcd::3:4:ff,2.2.2.2", std::string());
+
+  TestCompletionCallback callback;
+  ClientSocketHandle handle;
+  int rv = handle.Init("a", params_, LOW, callback.callback(), &pool,
+                       BoundNetLog());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+
+  EXPECT_EQ(OK, callback.WaitForResult());
+  EXPECT_TRUE(handle.is_initialized());
+  EXPECT_TRUE(handle.socket());
+  IPEndPoint endpoint;
+  handle.socket()->GetLocalAddress(&endpoint);
+  EXPECT_EQ(kIPv6AddressSize, endpoint.address().size());
+  EXPECT_EQ(2, client_socket_factory_.allocation_count());
+}
+
+TEST(IPv6FallbackDelayEstimatorTest, AdaptsToTheNetwork) {
+  const base::TimeDelta kMaxDelay = base::TimeDelta::FromMilliseconds(
+      TransportConnectJob::kIPv6FallbackTimerInMs);
+  const base::TimeDelta kMinDelay = base::TimeDelta::FromMilliseconds(
+      IPv6FallbackDelayEstimator::kMinIPv6FallbackDelayInMs);
+  IPv6FallbackDelayEstimator estimator;
+  EXPECT_EQ(kMaxDelay, estimator.GetFallbackDelay());
+
+  // Fast IPv6 connects shorten the delay to twice their duration.
+  estimator.OnIPv6ConnectSucceeded(base::TimeDelta::FromMilliseconds(40));
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(80),
+            estimator.GetFallbackDelay());
+
+  // Slow ones never make it longer than the default.
+  estimator.OnIPv6ConnectSucceeded(base::TimeDelta::FromSeconds(5));
+  EXPECT_EQ(kMaxDelay, estimator.GetFallbackDelay());
+
+  // Each IPv6 failure in a row halves it, down to the minimum.
+  estimator.OnIPv6ConnectFailed();
+  EXPECT_EQ(kMaxDelay / 2, estimator.GetFallbackDelay());
+  for (int i = 0; i < 10; ++i)
+    estimator.OnIPv6ConnectFailed();
+  EXPECT_EQ(kMinDelay, estimator.GetFallbackDelay());
+
+  // A new network starts over.
+  estimator.OnIPAddressChanged();
+  EXPECT_EQ(kMaxDelay, estimator.GetFallbackDelay());
+}
+
 }  // namespace
 
 }  // namespace net
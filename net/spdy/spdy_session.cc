@@ -5,6 +5,7 @@
 #include "net/spdy/spdy_session.h"
 
 #include <algorithm>
+#include <cstring>
 #include <map>
 
 #include "base/basictypes.h"
@@ -44,6 +45,9 @@ namespace net {
 namespace {
 
 const int kReadBufferSize = 8 * 1024;
+// Queued frames are coalesced into a single socket write until it holds at
+// least this many bytes.
+const size_t kMaxCoalescedWriteSize = 16 * 1024;
 const int kDefaultConnectionAtRiskOfLossSeconds = 10;
 const int kHungIntervalSeconds = 10;
 
@@ -425,6 +429,17 @@ SpdySession::PushedStreamInfo::PushedStreamInfo(
 
 SpdySession::PushedStreamInfo::~PushedStreamInfo() {}
 
+SpdySession::InFlightWrite::InFlightWrite(
+    SpdyFrameType frame_type,
+    scoped_ptr<SpdyBuffer> buffer,
+    const base::WeakPtr<SpdyStream>& stream)
+    : frame_type(frame_type),
+      frame_size(buffer->GetRemainingSize()),
+      buffer(buffer.Pass()),
+      stream(stream) {}
+
+SpdySession::InFlightWrite::~InFlightWrite() {}
+
 SpdySession::SpdySession(
     const SpdySessionKey& spdy_session_key,
     const base::WeakPtr<HttpServerProperties>& http_server_properties,
@@ -446,8 +461,6 @@ SpdySession::SpdySession(
       http_server_properties_(http_server_properties),
       read_buffer_(new IOBuffer(kReadBufferSize)),
       stream_hi_water_mark_(kFirstStreamId),
-      in_flight_write_frame_type_(DATA),
-      in_flight_write_frame_size_(0),
       is_secure_(false),
       certificate_error_code_(OK),
       availability_state_(STATE_AVAILABLE),
@@ -1347,44 +1360,53 @@ int SpdySession::DoWrite() {
   DCHECK_NE(availability_state_, STATE_CLOSED);
 
   DCHECK(buffered_spdy_framer_);
-  if (in_flight_write_) {
-    DCHECK_GT(in_flight_write_->GetRemainingSize(), 0u);
+  if (!in_flight_writes_.empty()) {
+    DCHECK_GT(in_flight_writes_.front()->buffer->GetRemainingSize(), 0u);
   } else {
-    // Grab the next frame to send.
-    SpdyFrameType frame_type = DATA;
-    scoped_ptr<SpdyBufferProducer> producer;
-    base::WeakPtr<SpdyStream> stream;
-    if (!write_queue_.Dequeue(&frame_type, &producer, &stream)) {
-      write_state_ = WRITE_STATE_IDLE;
-      return ERR_IO_PENDING;
-    }
+    // Grab the next frames to send. Frames which are queued together
+    // (e.g. the SYN_STREAMs of a page's subresources, or the DATA
+    // frames of an upload) are written with a single socket write, to
+    // save system calls and TLS records.
+    size_t coalesced_write_size = 0;
+    while (coalesced_write_size < kMaxCoalescedWriteSize) {
+      SpdyFrameType frame_type = DATA;
+      scoped_ptr<SpdyBufferProducer> producer;
+      base::WeakPtr<SpdyStream> stream;
+      if (!write_queue_.Dequeue(&frame_type, &producer, &stream))
+        break;
 
-    if (stream.get())
-      DCHECK(!stream->IsClosed());
-
-    // Activate the stream only when sending the SYN_STREAM frame to
-    // guarantee monotonically-increasing stream IDs.
-    if (frame_type == SYN_STREAM) {
-      if (stream.get() && stream->stream_id() == 0) {
-        scoped_ptr<SpdyStream> owned_stream =
-            ActivateCreatedStream(stream.get());
-        InsertActivatedStream(owned_stream.Pass());
-      } else {
+      if (stream.get())
+        DCHECK(!stream->IsClosed());
+
+      // Activate the stream only when sending the SYN_STREAM frame to
+      // guarantee monotonically-increasing stream IDs.
+      if (frame_type == SYN_STREAM) {
+        if (stream.get() && stream->stream_id() == 0) {
+          scoped_ptr<SpdyStream> owned_stream =
+              ActivateCreatedStream(stream.get());
+          InsertActivatedStream(owned_stream.Pass());
+        } else {
+          NOTREACHED();
+          return ERR_UNEXPECTED;
+        }
+      }
+
+      scoped_ptr<SpdyBuffer> buffer = producer->ProduceBuffer();
+      if (!buffer) {
         NOTREACHED();
         return ERR_UNEXPECTED;
       }
+      DCHECK_GE(buffer->GetRemainingSize(),
+                buffered_spdy_framer_->GetFrameMinimumSize());
+      coalesced_write_size += buffer->GetRemainingSize();
+      in_flight_writes_.push_back(
+          new InFlightWrite(frame_type, buffer.Pass(), stream));
     }
 
-    in_flight_write_ = producer->ProduceBuffer();
-    if (!in_flight_write_) {
-      NOTREACHED();
-      return ERR_UNEXPECTED;
+    if (in_flight_writes_.empty()) {
+      write_state_ = WRITE_STATE_IDLE;
+      return ERR_IO_PENDING;
     }
-    in_flight_write_frame_type_ = frame_type;
-    in_flight_write_frame_size_ = in_flight_write_->GetRemainingSize();
-    DCHECK_GE(in_flight_write_frame_size_,
-              buffered_spdy_framer_->GetFrameMinimumSize());
-    in_flight_write_stream_ = stream;
   }
 
   write_state_ = WRITE_STATE_DO_WRITE_COMPLETE;
@@ -1392,11 +1414,27 @@ int SpdySession::DoWrite() {
   // Explicitly store in a scoped_refptr<IOBuffer> to avoid problems
   // with Socket implementations that don't store their IOBuffer
   // argument in a scoped_refptr<IOBuffer> (see crbug.com/232345).
-  scoped_refptr<IOBuffer> write_io_buffer =
-      in_flight_write_->GetIOBufferForRemainingData();
+  scoped_refptr<IOBuffer> write_io_buffer;
+  size_t write_size = 0;
+  if (in_flight_writes_.size() == 1) {
+    // A lone frame is written without a copy.
+    SpdyBuffer* buffer = in_flight_writes_.front()->buffer.get();
+    write_io_buffer = buffer->GetIOBufferForRemainingData();
+    write_size = buffer->GetRemainingSize();
+  } else {
+    for (size_t i = 0; i < in_flight_writes_.size(); ++i)
+      write_size += in_flight_writes_[i]->buffer->GetRemainingSize();
+    write_io_buffer = new IOBuffer(write_size);
+    char* dst = write_io_buffer->data();
+    for (size_t i = 0; i < in_flight_writes_.size(); ++i) {
+      SpdyBuffer* buffer = in_flight_writes_[i]->buffer.get();
+      memcpy(dst, buffer->GetRemainingData(), buffer->GetRemainingSize());
+      dst += buffer->GetRemainingSize();
+    }
+  }
   return connection_->socket()->Write(
       write_io_buffer.get(),
-      in_flight_write_->GetRemainingSize(),
+      write_size,
       base::Bind(&SpdySession::PumpWriteLoop,
                  weak_factory_.GetWeakPtr(), WRITE_STATE_DO_WRITE_COMPLETE));
 }
@@ -1405,16 +1443,13 @@ int SpdySession::DoWriteComplete(int result) {
   CHECK(in_io_loop_);
   DCHECK_NE(availability_state_, STATE_CLOSED);
   DCHECK_NE(result, ERR_IO_PENDING);
-  DCHECK_GT(in_flight_write_->GetRemainingSize(), 0u);
+  DCHECK(!in_flight_writes_.empty());
 
   last_activity_time_ = time_func_();
 
   if (result < 0) {
     DCHECK_NE(result, ERR_IO_PENDING);
-    in_flight_write_.reset();
-    in_flight_write_frame_type_ = DATA;
-    in_flight_write_frame_size_ = 0;
-    in_flight_write_stream_.reset();
+    in_flight_writes_.clear();
     CloseSessionResult close_session_result =
         DoCloseSession(static_cast<Error>(result), "Write error");
     DCHECK_EQ(close_session_result, SESSION_CLOSED_BUT_NOT_REMOVED);
@@ -1423,30 +1458,31 @@ int SpdySession::DoWriteComplete(int result) {
     return result;
   }
 
-  // It should not be possible to have written more bytes than our
-  // in_flight_write_.
-  DCHECK_LE(static_cast<size_t>(result),
-            in_flight_write_->GetRemainingSize());
-
-  if (result > 0) {
-    in_flight_write_->Consume(static_cast<size_t>(result));
+  size_t bytes_written = static_cast<size_t>(result);
+  while (bytes_written > 0) {
+    // It should not be possible to have written more bytes than our
+    // in-flight frames.
+    DCHECK(!in_flight_writes_.empty());
+    SpdyBuffer* buffer = in_flight_writes_.front()->buffer.get();
+    size_t consume_size = std::min(bytes_written, buffer->GetRemainingSize());
+    buffer->Consume(consume_size);
+    bytes_written -= consume_size;
 
     // We only notify the stream when we've fully written the pending frame.
-    if (in_flight_write_->GetRemainingSize() == 0) {
-      // It is possible that the stream was cancelled while we were
-      // writing to the socket.
-      if (in_flight_write_stream_.get()) {
-        DCHECK_GT(in_flight_write_frame_size_, 0u);
-        in_flight_write_stream_->OnFrameWriteComplete(
-            in_flight_write_frame_type_,
-            in_flight_write_frame_size_);
-      }
+    if (buffer->GetRemainingSize() > 0)
+      break;
 
-      // Cleanup the write which just completed.
-      in_flight_write_.reset();
-      in_flight_write_frame_type_ = DATA;
-      in_flight_write_frame_size_ = 0;
-      in_flight_write_stream_.reset();
+    // Cleanup the write which just completed.
+    SpdyFrameType frame_type = in_flight_writes_.front()->frame_type;
+    size_t frame_size = in_flight_writes_.front()->frame_size;
+    base::WeakPtr<SpdyStream> stream = in_flight_writes_.front()->stream;
+    in_flight_writes_.erase(in_flight_writes_.begin());
+
+    // It is possible that the stream was cancelled while we were
+    // writing to the socket.
+    if (stream.get()) {
+      DCHECK_GT(frame_size, 0u);
+      stream->OnFrameWriteComplete(frame_type, frame_size);
     }
   }
 
@@ -1735,7 +1771,7 @@ void SpdySession::EnqueueWrite(RequestPriority priority,
   write_queue_.Enqueue(priority, frame_type, producer.Pass(), stream);
   if (write_state_ == WRITE_STATE_IDLE) {
     DCHECK(was_idle);
-    DCHECK(!in_flight_write_);
+    DCHECK(in_flight_writes_.empty());
     write_state_ = WRITE_STATE_DO_WRITE;
     base::MessageLoop::current()->PostTask(
         FROM_HERE,
@@ -1773,12 +1809,13 @@ void SpdySession::InsertActivatedStream(scoped_ptr<SpdyStream> stream) {
 }
 
 void SpdySession::DeleteStream(scoped_ptr<SpdyStream> stream, int status) {
-  if (in_flight_write_stream_.get() == stream.get()) {
-    // If we're deleting the stream for the in-flight write, we still
-    // need to let the write complete, so we clear
-    // |in_flight_write_stream_| and let the write finish on its own
-    // without notifying |in_flight_write_stream_|.
-    in_flight_write_stream_.reset();
+  for (size_t i = 0; i < in_flight_writes_.size(); ++i) {
+    if (in_flight_writes_[i]->stream.get() == stream.get()) {
+      // If we're deleting the stream of an in-flight write, we still
+      // need to let the write complete, so we clear its stream and let
+      // the write finish on its own without notifying the stream.
+      in_flight_writes_[i]->stream.reset();
+    }
   }
 
   write_queue_.RemovePendingWritesForStream(stream->GetWeakPtr());
@@ -14,6 +14,7 @@
 #include "base/gtest_prod_util.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
 #include "base/memory/weak_ptr.h"
 #include "base/time/time.h"
 #include "net/base/io_buffer.h"
@@ -511,6 +512,24 @@ class NET_EXPORT SpdySession : public BufferedSpdyFramerVisitorInterface,
   };
   typedef std::map<GURL, PushedStreamInfo> PushedStreamMap;
 
+  // A frame taken from the write queue which is being written to the
+  // socket.
+  struct InFlightWrite {
+    InFlightWrite(SpdyFrameType frame_type,
+                  scoped_ptr<SpdyBuffer> buffer,
+                  const base::WeakPtr<SpdyStream>& stream);
+    ~InFlightWrite();
+
+    const SpdyFrameType frame_type;
+    // The size of the whole frame.
+    const size_t frame_size;
+    // The frame, which is consumed as it is written.
+    const scoped_ptr<SpdyBuffer> buffer;
+    // The stream to notify when the frame has been written to the
+    // socket completely.
+    base::WeakPtr<SpdyStream> stream;
+  };
+
   typedef std::set<SpdyStream*> CreatedStreamSet;
 
   enum AvailabilityState {
@@ -980,17 +999,10 @@ class NET_EXPORT SpdySession : public BufferedSpdyFramerVisitorInterface,
   // The write queue.
   SpdyWriteQueue write_queue_;
 
-  // Data for the frame we are currently sending.
-
-  // The buffer we're currently writing.
-  scoped_ptr<SpdyBuffer> in_flight_write_;
-  // The type of the frame in |in_flight_write_|.
-  SpdyFrameType in_flight_write_frame_type_;
-  // The size of the frame in |in_flight_write_|.
-  size_t in_flight_write_frame_size_;
-  // The stream to notify when |in_flight_write_| has been written to
-  // the socket completely.
-  base::WeakPtr<SpdyStream> in_flight_write_stream_;
+  // The frames we're currently writing, in order. Frames which are
+  // queued together are coalesced into a single socket write, and only
+  // the first one may have been partially written.
+  ScopedVector<InFlightWrite> in_flight_writes_;
 
   // Flag if we're using an SSL connection for this SpdySession.
   bool is_secure_;
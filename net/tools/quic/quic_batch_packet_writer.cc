@@ -0,0 +1,125 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/tools/quic/quic_batch_packet_writer.h"
+
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "net/tools/quic/quic_socket_utils.h"
+
+namespace net {
+namespace tools {
+
+const size_t QuicBatchPacketWriter::kMaxBatchSize;
+
+QuicBatchPacketWriter::BufferedPacket::BufferedPacket(
+    const char* buffer, size_t buf_len,
+    const IPAddressNumber& self_address,
+    const IPEndPoint& peer_address)
+    : data(buffer, buf_len),
+      self_address(self_address),
+      peer_address(peer_address) {}
+
+QuicBatchPacketWriter::BufferedPacket::~BufferedPacket() {}
+
+QuicBatchPacketWriter::QuicBatchPacketWriter(int fd)
+    : fd_(fd),
+      write_blocked_(false) {}
+
+QuicBatchPacketWriter::~QuicBatchPacketWriter() {}
+
+WriteResult QuicBatchPacketWriter::WritePacket(
+    const char* buffer, size_t buf_len,
+    const net::IPAddressNumber& self_address,
+    const net::IPEndPoint& peer_address) {
+  DCHECK(!IsWriteBlocked());
+  buffered_packets_.push_back(
+      BufferedPacket(buffer, buf_len, self_address, peer_address));
+  if (buffered_packets_.size() >= kMaxBatchSize && !SendBatch())
+    write_blocked_ = true;
+  return WriteResult(WRITE_STATUS_OK, buf_len);
+}
+
+bool QuicBatchPacketWriter::IsWriteBlockedDataBuffered() const {
+  // WritePacket() never reports WRITE_STATUS_BLOCKED.
+  return false;
+}
+
+bool QuicBatchPacketWriter::IsWriteBlocked() const {
+  return write_blocked_;
+}
+
+void QuicBatchPacketWriter::SetWritable() {
+  write_blocked_ = false;
+  Flush();
+}
+
+bool QuicBatchPacketWriter::Flush() {
+  while (!buffered_packets_.empty()) {
+    if (!SendBatch()) {
+      write_blocked_ = true;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool QuicBatchPacketWriter::SendBatch() {
+  size_t batch_size = std::min(buffered_packets_.size(), kMaxBatchSize);
+#if MMSG_MORE
+  struct sockaddr_storage raw_addresses[kMaxBatchSize];
+  iovec iovs[kMaxBatchSize];
+  char cbufs[kMaxBatchSize][QuicSocketUtils::kSpaceForIp];
+  mmsghdr mmsgs[kMaxBatchSize];
+  memset(mmsgs, 0, sizeof(mmsgs));
+  for (size_t i = 0; i < batch_size; ++i) {
+    const BufferedPacket& packet = buffered_packets_[i];
+    socklen_t address_len = sizeof(raw_addresses[i]);
+    CHECK(packet.peer_address.ToSockAddr(
+        reinterpret_cast<struct sockaddr*>(&raw_addresses[i]),
+        &address_len));
+    iovs[i].iov_base = const_cast<char*>(packet.data.data());
+    iovs[i].iov_len = packet.data.size();
+
+    msghdr* hdr = &mmsgs[i].msg_hdr;
+    hdr->msg_name = &raw_addresses[i];
+    hdr->msg_namelen = address_len;
+    hdr->msg_iov = &iovs[i];
+    hdr->msg_iovlen = 1;
+    hdr->msg_flags = 0;
+    QuicSocketUtils::SetIpInfoInMsghdr(packet.self_address, cbufs[i], hdr);
+  }
+
+  int rc = sendmmsg(fd_, mmsgs, batch_size, 0);
+  if (rc < 0) {
+    if (errno == EAGAIN || errno == EWOULDBLOCK)
+      return false;
+    // The first packet failed; drop it so the rest can be sent.
+    DVLOG(1) << "sendmmsg failed: " << strerror(errno);
+    rc = 1;
+  }
+  buffered_packets_.erase(buffered_packets_.begin(),
+                          buffered_packets_.begin() + rc);
+#else
+  for (size_t i = 0; i < batch_size; ++i) {
+    const BufferedPacket& packet = buffered_packets_.front();
+    WriteResult result = QuicSocketUtils::WritePacket(
+        fd_, packet.data.data(), packet.data.size(), packet.self_address,
+        packet.peer_address);
+    if (result.status == WRITE_STATUS_BLOCKED)
+      return false;
+    buffered_packets_.pop_front();
+  }
+#endif
+  return true;
+}
+
+}  // namespace tools
+}  // namespace net
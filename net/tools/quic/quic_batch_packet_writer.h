@@ -0,0 +1,83 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_TOOLS_QUIC_QUIC_BATCH_PACKET_WRITER_H_
+#define NET_TOOLS_QUIC_QUIC_BATCH_PACKET_WRITER_H_
+
+#include <deque>
+#include <string>
+
+#include "base/basictypes.h"
+#include "net/base/ip_endpoint.h"
+#include "net/quic/quic_packet_writer.h"
+
+namespace net {
+
+struct WriteResult;
+
+namespace tools {
+
+// A packet writer which buffers the packets written to it until Flush() is
+// called, and then sends them with as few sendmmsg calls as possible.  The
+// server flushes once per read burst and once per iteration of its event
+// loop, which saves a system call for most packets at high bandwidth.
+//
+// WritePacket() always buffers the packet and never reports
+// WRITE_STATUS_BLOCKED, since the writer can't tell the packet's connection
+// when it is sent later.  Instead, if the socket becomes write blocked, the
+// unsent packets are kept for SetWritable() and IsWriteBlocked() stops the
+// connections from writing more.
+class QuicBatchPacketWriter : public QuicPacketWriter {
+ public:
+  // The largest number of packets sent with one sendmmsg call.
+  static const size_t kMaxBatchSize = 16;
+
+  explicit QuicBatchPacketWriter(int fd);
+  virtual ~QuicBatchPacketWriter();
+
+  // QuicPacketWriter
+  virtual WriteResult WritePacket(
+      const char* buffer, size_t buf_len,
+      const net::IPAddressNumber& self_address,
+      const net::IPEndPoint& peer_address) OVERRIDE;
+  virtual bool IsWriteBlockedDataBuffered() const OVERRIDE;
+  virtual bool IsWriteBlocked() const OVERRIDE;
+  virtual void SetWritable() OVERRIDE;
+
+  // Sends the buffered packets.  Packets which fail to send for reasons other
+  // than the socket being write blocked are dropped, and are handled like
+  // packets lost on the network.  Returns false if the socket became write
+  // blocked before all the packets were sent.
+  bool Flush();
+
+  size_t buffered_packet_count() const { return buffered_packets_.size(); }
+
+ private:
+  struct BufferedPacket {
+    BufferedPacket(const char* buffer, size_t buf_len,
+                   const IPAddressNumber& self_address,
+                   const IPEndPoint& peer_address);
+    ~BufferedPacket();
+
+    std::string data;
+    IPAddressNumber self_address;
+    IPEndPoint peer_address;
+  };
+
+  // Sends up to kMaxBatchSize of the buffered packets with one system call,
+  // and removes the ones which were sent or failed.  Returns false if the
+  // socket is write blocked.
+  bool SendBatch();
+
+  int fd_;
+  bool write_blocked_;
+  std::deque<BufferedPacket> buffered_packets_;
+
+  DISALLOW_COPY_AND_ASSIGN(QuicBatchPacketWriter);
+};
+
+}  // namespace tools
+}  // namespace net
+
+#endif  // NET_TOOLS_QUIC_QUIC_BATCH_PACKET_WRITER_H_
@@ -0,0 +1,101 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/tools/quic/quic_batch_packet_writer.h"
+
+#include <errno.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "base/strings/string_number_conversions.h"
+#include "net/base/net_util.h"
+#include "net/quic/quic_protocol.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+namespace tools {
+namespace test {
+namespace {
+
+// Sends packets over the loopback interface.
+class QuicBatchPacketWriterTest : public ::testing::Test {
+ protected:
+  QuicBatchPacketWriterTest() {
+    IPAddressNumber loopback;
+    CHECK(ParseIPLiteralToNumber("127.0.0.1", &loopback));
+
+    read_fd_ = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, IPPROTO_UDP);
+    CHECK_GE(read_fd_, 0);
+    SockaddrStorage storage;
+    CHECK(IPEndPoint(loopback, 0).ToSockAddr(storage.addr,
+                                             &storage.addr_len));
+    CHECK_EQ(0, bind(read_fd_, storage.addr, storage.addr_len));
+    CHECK_EQ(0, getsockname(read_fd_, storage.addr, &storage.addr_len));
+    CHECK(read_address_.FromSockAddr(storage.addr, storage.addr_len));
+
+    write_fd_ = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, IPPROTO_UDP);
+    CHECK_GE(write_fd_, 0);
+  }
+
+  virtual ~QuicBatchPacketWriterTest() {
+    close(read_fd_);
+    close(write_fd_);
+  }
+
+  void WritePacket(QuicBatchPacketWriter* writer, const std::string& data) {
+    WriteResult result = writer->WritePacket(
+        data.data(), data.size(), IPAddressNumber(), read_address_);
+    EXPECT_EQ(WRITE_STATUS_OK, result.status);
+    EXPECT_EQ(static_cast<int>(data.size()), result.bytes_written);
+  }
+
+  // Returns the next packet received, or an empty string if there is none.
+  std::string ReadPacket() {
+    char buf[kMaxPacketSize];
+    ssize_t bytes_read = recv(read_fd_, buf, sizeof(buf), 0);
+    if (bytes_read < 0) {
+      EXPECT_EQ(EAGAIN, errno);
+      return std::string();
+    }
+    return std::string(buf, bytes_read);
+  }
+
+  int read_fd_;
+  int write_fd_;
+  IPEndPoint read_address_;
+};
+
+TEST_F(QuicBatchPacketWriterTest, PacketsAreSentOnFlush) {
+  QuicBatchPacketWriter writer(write_fd_);
+  WritePacket(&writer, "first");
+  WritePacket(&writer, "second");
+  WritePacket(&writer, "third");
+  EXPECT_EQ(3u, writer.buffered_packet_count());
+  EXPECT_EQ("", ReadPacket());
+
+  EXPECT_TRUE(writer.Flush());
+  EXPECT_EQ(0u, writer.buffered_packet_count());
+  EXPECT_FALSE(writer.IsWriteBlocked());
+  EXPECT_EQ("first", ReadPacket());
+  EXPECT_EQ("second", ReadPacket());
+  EXPECT_EQ("third", ReadPacket());
+  EXPECT_EQ("", ReadPacket());
+}
+
+TEST_F(QuicBatchPacketWriterTest, FullBatchIsSentWithoutFlush) {
+  QuicBatchPacketWriter writer(write_fd_);
+  for (size_t i = 0; i < QuicBatchPacketWriter::kMaxBatchSize; ++i)
+    WritePacket(&writer, base::Uint64ToString(i));
+  EXPECT_EQ(0u, writer.buffered_packet_count());
+
+  for (size_t i = 0; i < QuicBatchPacketWriter::kMaxBatchSize; ++i)
+    EXPECT_EQ(base::Uint64ToString(i), ReadPacket());
+  EXPECT_EQ("", ReadPacket());
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace tools
+}  // namespace net
@@ -69,6 +69,9 @@ class QuicDispatcher : public QuicServerSessionVisitor {
 
   void Initialize(int fd);
 
+  // Replaces the packet writer with |writer|. Takes ownership of |writer|.
+  void set_writer(QuicPacketWriter* writer);
+
   // Process the incoming packet by creating a new session, passing it to
   // an existing session, or passing it to the TimeWaitListManager.
   virtual void ProcessPacket(const IPEndPoint& server_address,
@@ -118,9 +121,6 @@ class QuicDispatcher : public QuicServerSessionVisitor {
                                        const IPEndPoint& server_address,
                                        const IPEndPoint& client_address);
 
-  // Replaces the packet writer with |writer|. Takes ownership of |writer|.
-  void set_writer(QuicPacketWriter* writer);
-
   QuicTimeWaitListManager* time_wait_list_manager() {
     return time_wait_list_manager_.get();
   }
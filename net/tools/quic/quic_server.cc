@@ -10,6 +10,7 @@
 #include <string.h>
 #include <sys/epoll.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 
 #include "net/base/ip_endpoint.h"
 #include "net/quic/crypto/crypto_handshake.h"
@@ -18,11 +19,10 @@
 #include "net/quic/quic_crypto_stream.h"
 #include "net/quic/quic_data_reader.h"
 #include "net/quic/quic_protocol.h"
+#include "net/tools/quic/quic_batch_packet_writer.h"
 #include "net/tools/quic/quic_in_memory_cache.h"
 #include "net/tools/quic/quic_socket_utils.h"
 
-#define MMSG_MORE 0
-
 #ifndef SO_RXQ_OVFL
 #define SO_RXQ_OVFL 40
 #endif
@@ -39,6 +39,7 @@ QuicServer::QuicServer()
       packets_dropped_(0),
       overflow_supported_(false),
       use_recvmmsg_(false),
+      batch_writer_(NULL),
       crypto_config_(kSourceAddressTokenSecret, QuicRandom::GetInstance()),
       supported_versions_(QuicSupportedVersions()) {
   // Use hardcoded crypto parameters for now.
@@ -56,6 +57,7 @@ QuicServer::QuicServer(const QuicConfig& config,
       packets_dropped_(0),
       overflow_supported_(false),
       use_recvmmsg_(false),
+      batch_writer_(NULL),
       config_(config),
       crypto_config_(kSourceAddressTokenSecret, QuicRandom::GetInstance()),
       supported_versions_(supported_versions) {
@@ -150,18 +152,26 @@ bool QuicServer::Listen(const IPEndPoint& address) {
   dispatcher_.reset(new QuicDispatcher(
       config_, crypto_config_, supported_versions_, &epoll_server_));
   dispatcher_->Initialize(fd_);
+#if MMSG_MORE
+  // Send the packets written while handling each burst of reads, and during
+  // each iteration of the event loop, together.
+  batch_writer_ = new QuicBatchPacketWriter(fd_);
+  dispatcher_->set_writer(batch_writer_);
+#endif
 
   return true;
 }
 
 void QuicServer::WaitForEvents() {
   epoll_server_.WaitForEventsAndExecuteCallbacks();
+  FlushWrites();
 }
 
 void QuicServer::Shutdown() {
   // Before we shut down the epoll server, give all active sessions a chance to
   // notify clients that they're closing.
   dispatcher_->Shutdown();
+  FlushWrites();
 
   close(fd_);
   fd_ = -1;
@@ -175,10 +185,15 @@ void QuicServer::OnEvent(int fd, EpollEvent* event) {
     DVLOG(1) << "EPOLLIN";
     bool read = true;
     while (read) {
+      if (use_recvmmsg_) {
+        read = ReadAndDispatchPackets();
+      } else {
         read = ReadAndDispatchSinglePacket(
             fd_, port_, dispatcher_.get(),
             overflow_supported_ ? &packets_dropped_ : NULL);
+      }
     }
+    FlushWrites();
   }
   if (event->in_events & EPOLLOUT) {
     dispatcher_->OnCanWrite();
@@ -218,5 +233,64 @@ bool QuicServer::ReadAndDispatchSinglePacket(int fd,
   return true;
 }
 
+bool QuicServer::ReadAndDispatchPackets() {
+#if MMSG_MORE
+  const int kSpaceForOverflowAndIp =
+      CMSG_SPACE(sizeof(int)) + CMSG_SPACE(sizeof(in6_pktinfo));
+  char cbufs[kNumPacketsPerReadMmsgCall][kSpaceForOverflowAndIp];
+  memset(cbufs, 0, sizeof(cbufs));
+  iovec iovs[kNumPacketsPerReadMmsgCall];
+  sockaddr_storage raw_addresses[kNumPacketsPerReadMmsgCall];
+  mmsghdr mmsgs[kNumPacketsPerReadMmsgCall];
+  memset(mmsgs, 0, sizeof(mmsgs));
+  for (int i = 0; i < kNumPacketsPerReadMmsgCall; ++i) {
+    iovs[i].iov_base = packet_buffers_[i];
+    iovs[i].iov_len = arraysize(packet_buffers_[i]);
+
+    msghdr* hdr = &mmsgs[i].msg_hdr;
+    hdr->msg_name = &raw_addresses[i];
+    hdr->msg_namelen = sizeof(raw_addresses[i]);
+    hdr->msg_iov = &iovs[i];
+    hdr->msg_iovlen = 1;
+    hdr->msg_control = cbufs[i];
+    hdr->msg_controllen = arraysize(cbufs[i]);
+  }
+
+  int packets_read =
+      recvmmsg(fd_, mmsgs, kNumPacketsPerReadMmsgCall, 0, NULL);
+  if (packets_read <= 0) {
+    if (packets_read < 0 && errno != EAGAIN)
+      LOG(ERROR) << "Error reading " << strerror(errno);
+    return false;
+  }
+
+  for (int i = 0; i < packets_read; ++i) {
+    msghdr* hdr = &mmsgs[i].msg_hdr;
+    if (overflow_supported_)
+      QuicSocketUtils::GetOverflowFromMsghdr(hdr, &packets_dropped_);
+
+    IPEndPoint client_address;
+    if (!client_address.FromSockAddr(
+            reinterpret_cast<const sockaddr*>(&raw_addresses[i]),
+            hdr->msg_namelen)) {
+      continue;
+    }
+    IPEndPoint server_address(QuicSocketUtils::GetAddressFromMsghdr(hdr),
+                              port_);
+    QuicEncryptedPacket packet(packet_buffers_[i], mmsgs[i].msg_len, false);
+    dispatcher_->ProcessPacket(server_address, client_address, packet);
+  }
+  return true;
+#else
+  NOTREACHED();
+  return false;
+#endif
+}
+
+void QuicServer::FlushWrites() {
+  if (batch_writer_)
+    batch_writer_->Flush();
+}
+
 }  // namespace tools
 }  // namespace net
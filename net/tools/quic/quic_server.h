@@ -14,6 +14,7 @@
 #include "net/quic/crypto/quic_crypto_server_config.h"
 #include "net/quic/quic_config.h"
 #include "net/quic/quic_framer.h"
+#include "net/quic/quic_protocol.h"
 #include "net/tools/epoll_server/epoll_server.h"
 #include "net/tools/quic/quic_dispatcher.h"
 
@@ -25,6 +26,7 @@ namespace test {
 class QuicServerPeer;
 }  // namespace test
 
+class QuicBatchPacketWriter;
 class QuicDispatcher;
 
 class QuicServer : public EpollCallbackInterface {
@@ -62,6 +64,11 @@ class QuicServer : public EpollCallbackInterface {
                                           QuicDispatcher* dispatcher,
                                           uint32* packets_dropped);
 
+  // Reads up to kNumPacketsPerReadMmsgCall packets from the socket with a
+  // single recvmmsg call, and passes them off to the QuicDispatcher.  Returns
+  // true if any packet is read, false otherwise.
+  bool ReadAndDispatchPackets();
+
   virtual void OnShutdown(EpollServer* eps, int fd) OVERRIDE {}
 
   void SetStrikeRegisterNoStartupPeriod() {
@@ -77,9 +84,15 @@ class QuicServer : public EpollCallbackInterface {
  private:
   friend class net::tools::test::QuicServerPeer;
 
+  // The number of packets read by each recvmmsg call.
+  static const int kNumPacketsPerReadMmsgCall = 16;
+
   // Initialize the internal state of the server.
   void Initialize();
 
+  // Sends the packets buffered by |batch_writer_|, if any.
+  void FlushWrites();
+
   // Accepts data from the framer and demuxes clients to sessions.
   scoped_ptr<QuicDispatcher> dispatcher_;
   // Frames incoming packets and hands them to the dispatcher.
@@ -103,6 +116,14 @@ class QuicServer : public EpollCallbackInterface {
   // If true, use recvmmsg for reading.
   bool use_recvmmsg_;
 
+  // The buffers recvmmsg reads packets into.  Extra space is allocated so
+  // that we can send an error if a client goes over the limit.
+  char packet_buffers_[kNumPacketsPerReadMmsgCall][2 * kMaxPacketSize];
+
+  // Buffers the packets written by the dispatcher if sendmmsg is available,
+  // NULL otherwise.  Owned by |dispatcher_|.
+  QuicBatchPacketWriter* batch_writer_;
+
   // config_ contains non-crypto parameters that are negotiated in the crypto
   // handshake.
   QuicConfig config_;
@@ -7,6 +7,7 @@
 #ifndef NET_TOOLS_QUIC_QUIC_SOCKET_UTILS_H_
 #define NET_TOOLS_QUIC_QUIC_SOCKET_UTILS_H_
 
+#include <netinet/in.h>
 #include <stddef.h>
 #include <sys/socket.h>
 #include <string>
@@ -14,11 +15,23 @@
 #include "net/base/ip_endpoint.h"
 #include "net/quic/quic_protocol.h"
 
+// recvmmsg() and sendmmsg() are available since glibc 2.12 and 2.14.
+#if defined(__GLIBC__) && \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 14))
+#define MMSG_MORE 1
+#else
+#define MMSG_MORE 0
+#endif
+
 namespace net {
 namespace tools {
 
 class QuicSocketUtils {
  public:
+  // The size of a control message buffer which can hold either an
+  // IP_PKTINFO or an IPV6_PKTINFO, the larger of the two.
+  static const size_t kSpaceForIp = CMSG_SPACE(sizeof(in6_pktinfo));
+
   // If the msghdr contains IP_PKTINFO or IPV6_PKTINFO, this will return the
   // IPAddressNumber in that header.  Returns an uninitialized IPAddress on
   // failure.
@@ -33,6 +46,14 @@ class QuicSocketUtils {
   // address_family.  Returns the return code from setsockopt.
   static int SetGetAddressInfo(int fd, int address_family);
 
+  // Points the control message of hdr at cbuf, which must hold kSpaceForIp
+  // bytes, and fills it in with the IP_PKTINFO or IPV6_PKTINFO which sends
+  // the packet from self_address.  If self_address is empty, hdr is left
+  // without a control message.
+  static void SetIpInfoInMsghdr(const IPAddressNumber& self_address,
+                                char* cbuf,
+                                struct msghdr* hdr);
+
   // Reads buf_len from the socket.  If reading is successful, returns bytes
   // read and sets peer_address to the peer address.  Otherwise returns -1.
   //
@@ -283,6 +283,9 @@ class NET_EXPORT URLRequestJob
   // URLRequestStatus::IO_PENDING, and buf must remain available until the
   // operation is completed.  See comments on URLRequest::Read for more
   // info.
+  // Unless the response is filtered, buf is the buffer passed to
+  // URLRequest::Read, so jobs should read into it directly rather than
+  // through a buffer of their own.
   virtual bool ReadRawData(IOBuffer* buf, int buf_size, int *bytes_read);
 
   // Called to tell the job that a filter has successfully reached the end of
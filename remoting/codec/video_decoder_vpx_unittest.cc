@@ -43,6 +43,12 @@ TEST_F(VideoDecoderVpxTest, Gradient) {
   TestGradient(320, 240, 320, 240, 0.04, 0.02);
 }
 
+// A full-screen update this large is converted to YUV in bands on multiple
+// threads, which must not add visible errors.
+TEST_F(VideoDecoderVpxTest, GradientLargeScreen) {
+  TestGradient(1920, 1080, 1920, 1080, 0.04, 0.02);
+}
+
 TEST_F(VideoDecoderVpxTest, GradientScaleUpEvenToEven) {
   TestGradient(320, 240, 640, 480, 0.04, 0.02);
 }
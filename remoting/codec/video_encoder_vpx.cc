@@ -4,9 +4,15 @@
 
 #include "remoting/codec/video_encoder_vpx.h"
 
+#include <algorithm>
+
+#include "base/atomic_ref_count.h"
 #include "base/bind.h"
+#include "base/location.h"
 #include "base/logging.h"
+#include "base/synchronization/waitable_event.h"
 #include "base/sys_info.h"
+#include "base/threading/worker_pool.h"
 #include "base/time/time.h"
 #include "media/base/yuv_convert.h"
 #include "remoting/base/util.h"
@@ -29,6 +35,67 @@ namespace {
 // map for the encoder.
 const int kMacroBlockSize = 16;
 
+// Upper bound on the number of encoder threads; VP8 can't use more token
+// partitions than this.
+const int kMaxEncoderThreads = 8;
+
+// Updated regions with at least this many pixels are converted to YUV in
+// horizontal bands, all but the first of which are converted on the worker
+// pool.
+const int kMinAreaForParallelConversion = 1280 * 720;
+const int kNumConversionBands = 4;
+
+// Converts the rectangles of |region| in |frame| to YUV, writing them into the
+// planes of |image|.
+void ConvertRegionToYUV(const webrtc::DesktopFrame& frame,
+                        const webrtc::DesktopRegion& region,
+                        vpx_image_t* image) {
+  const uint8* rgb_data = frame.data();
+  const int rgb_stride = frame.stride();
+  const int y_stride = image->stride[0];
+  DCHECK_EQ(image->stride[1], image->stride[2]);
+  const int uv_stride = image->stride[1];
+  uint8* y_data = image->planes[0];
+  uint8* u_data = image->planes[1];
+  uint8* v_data = image->planes[2];
+  for (webrtc::DesktopRegion::Iterator r(region); !r.IsAtEnd(); r.Advance()) {
+    const webrtc::DesktopRect& rect = r.rect();
+    ConvertRGB32ToYUVWithRect(
+        rgb_data, y_data, u_data, v_data,
+        rect.left(), rect.top(), rect.width(), rect.height(),
+        rgb_stride, y_stride, uv_stride);
+  }
+}
+
+// Converts a band on a worker thread and signals |done| once the last of the
+// |pending_bands| has been converted.
+void ConvertBandToYUV(const webrtc::DesktopFrame* frame,
+                      const webrtc::DesktopRegion* band,
+                      vpx_image_t* image,
+                      base::AtomicRefCount* pending_bands,
+                      base::WaitableEvent* done) {
+  ConvertRegionToYUV(*frame, *band, image);
+  if (!base::AtomicRefCountDec(pending_bands))
+    done->Signal();
+}
+
+// Returns the number of threads to encode frames of |size| with.
+int GetEncoderThreadCount(const webrtc::DesktopSize& size) {
+  // Using 2 threads gives a great boost in performance for most systems with
+  // adequate processing power. NB: Going to multiple threads on low end
+  // windows systems can really hurt performance.
+  // http://crbug.com/99179
+  int num_processors = base::SysInfo::NumberOfProcessors();
+  if (num_processors <= 2)
+    return 1;
+
+  // Frames larger than 1080p get two more threads per 1080p worth of pixels,
+  // but at most half of the cores are used so that capturing isn't starved.
+  int threads = 2 * std::max(1, size.width() * size.height() / (1920 * 1080));
+  threads = std::min(threads, std::max(2, num_processors / 2));
+  return std::min(threads, kMaxEncoderThreads);
+}
+
 ScopedVpxCodec CreateVP8Codec(const webrtc::DesktopSize& size) {
   ScopedVpxCodec codec(new vpx_codec_ctx_t);
 
@@ -51,11 +118,8 @@ ScopedVpxCodec CreateVP8Codec(const webrtc::DesktopSize& size) {
   // encoding.
   config.g_profile = 2;
 
-  // Using 2 threads gives a great boost in performance for most systems with
-  // adequate processing power. NB: Going to multiple threads on low end
-  // windows systems can really hurt performance.
-  // http://crbug.com/99179
-  config.g_threads = (base::SysInfo::NumberOfProcessors() > 2) ? 2 : 1;
+  const int threads = GetEncoderThreadCount(size);
+  config.g_threads = threads;
   config.rc_min_quantizer = 20;
   config.rc_max_quantizer = 30;
   config.g_timebase.num = 1;
@@ -74,6 +138,16 @@ ScopedVpxCodec CreateVP8Codec(const webrtc::DesktopSize& size) {
   if (vpx_codec_control(codec.get(), VP8E_SET_NOISE_SENSITIVITY, 0))
     return ScopedVpxCodec();
 
+  // Split the residual tokens into one partition per thread (rounded down to a
+  // power of two), so that tokenization of large frames runs in parallel.
+  int log2_partitions = 0;
+  while (log2_partitions < 3 && (2 << log2_partitions) <= threads)
+    ++log2_partitions;
+  if (vpx_codec_control(codec.get(), VP8E_SET_TOKEN_PARTITIONS,
+                        log2_partitions)) {
+    return ScopedVpxCodec();
+  }
+
   return codec.Pass();
 }
 
@@ -275,22 +349,42 @@ void VideoEncoderVpx::PrepareImage(const webrtc::DesktopFrame& frame,
       webrtc::DesktopRect::MakeWH(image_->w, image_->h));
 
   // Convert the updated region to YUV ready for encoding.
-  const uint8* rgb_data = frame.data();
-  const int rgb_stride = frame.stride();
-  const int y_stride = image_->stride[0];
-  DCHECK_EQ(image_->stride[1], image_->stride[2]);
-  const int uv_stride = image_->stride[1];
-  uint8* y_data = image_->planes[0];
-  uint8* u_data = image_->planes[1];
-  uint8* v_data = image_->planes[2];
+  int updated_area = 0;
   for (webrtc::DesktopRegion::Iterator r(*updated_region); !r.IsAtEnd();
        r.Advance()) {
-    const webrtc::DesktopRect& rect = r.rect();
-    ConvertRGB32ToYUVWithRect(
-        rgb_data, y_data, u_data, v_data,
-        rect.left(), rect.top(), rect.width(), rect.height(),
-        rgb_stride, y_stride, uv_stride);
+    updated_area += r.rect().width() * r.rect().height();
+  }
+  if (updated_area < kMinAreaForParallelConversion) {
+    ConvertRegionToYUV(frame, *updated_region, image_.get());
+    return;
   }
+
+  // Large updates, e.g. full-screen changes on high resolution hosts, are
+  // split into horizontal bands. The band height is rounded up to whole
+  // macroblocks, so that no two bands share U and V samples.
+  const int band_height =
+      ((image_->h + kNumConversionBands - 1) / kNumConversionBands +
+       kMacroBlockSize - 1) / kMacroBlockSize * kMacroBlockSize;
+  webrtc::DesktopRegion bands[kNumConversionBands];
+  for (int i = 0; i < kNumConversionBands; ++i) {
+    const int top = std::min(static_cast<int>(image_->h), i * band_height);
+    const int bottom = std::min(static_cast<int>(image_->h), top + band_height);
+    bands[i].SetRect(webrtc::DesktopRect::MakeLTRB(0, top, image_->w, bottom));
+    bands[i].IntersectWith(*updated_region);
+  }
+
+  base::AtomicRefCount pending_bands = 0;
+  base::WaitableEvent done(false, false);
+  base::AtomicRefCountIncN(&pending_bands, kNumConversionBands - 1);
+  for (int i = 1; i < kNumConversionBands; ++i) {
+    base::Closure task = base::Bind(&ConvertBandToYUV, &frame, &bands[i],
+                                    image_.get(), &pending_bands, &done);
+    if (!base::WorkerPool::PostTask(FROM_HERE, task, false))
+      task.Run();
+  }
+
+  ConvertRegionToYUV(frame, bands[0], image_.get());
+  done.Wait();
 }
 
 void VideoEncoderVpx::PrepareActiveMap(
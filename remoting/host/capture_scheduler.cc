@@ -34,7 +34,8 @@ CaptureScheduler::CaptureScheduler()
           base::TimeDelta::FromMilliseconds(kDefaultMinimumIntervalMs)),
       num_of_processors_(base::SysInfo::NumberOfProcessors()),
       capture_time_(kStatisticsWindow),
-      encode_time_(kStatisticsWindow) {
+      encode_time_(kStatisticsWindow),
+      send_time_(kStatisticsWindow) {
   DCHECK(num_of_processors_);
 }
 
@@ -49,6 +50,12 @@ base::TimeDelta CaptureScheduler::NextCaptureDelay() {
       (capture_time_.Average() + encode_time_.Average()) /
       (kRecordingCpuConsumption * num_of_processors_));
 
+  // Don't capture frames faster than they can be sent, otherwise they queue up
+  // in the network buffers and add latency, which is most visible on large
+  // screens over slower links.
+  delay = std::max(delay,
+                   base::TimeDelta::FromMilliseconds(send_time_.Average()));
+
   if (delay < minimum_interval_)
     return minimum_interval_;
   return delay;
@@ -62,6 +69,10 @@ void CaptureScheduler::RecordEncodeTime(base::TimeDelta encode_time) {
   encode_time_.Record(encode_time.InMilliseconds());
 }
 
+void CaptureScheduler::RecordSendTime(base::TimeDelta send_time) {
+  send_time_.Record(send_time.InMilliseconds());
+}
+
 void CaptureScheduler::SetNumOfProcessorsForTest(int num_of_processors) {
   num_of_processors_ = num_of_processors;
 }
@@ -4,7 +4,9 @@
 
 // This class chooses a capture interval so as to limit CPU usage to not exceed
 // a specified %age. It bases this on the CPU usage of recent capture and encode
-// operations, and on the number of available CPUs.
+// operations, and on the number of available CPUs. The interval is also kept
+// no shorter than the time recent frames took to be sent, so that frames are
+// not captured faster than the network can deliver them.
 
 #ifndef REMOTING_HOST_CAPTURE_SCHEDULER_H_
 #define REMOTING_HOST_CAPTURE_SCHEDULER_H_
@@ -27,6 +29,9 @@ class CaptureScheduler {
   void RecordCaptureTime(base::TimeDelta capture_time);
   void RecordEncodeTime(base::TimeDelta encode_time);
 
+  // Records time spent sending a frame to the client.
+  void RecordSendTime(base::TimeDelta send_time);
+
   // Sets minimum interval between frames.
   void set_minimum_interval(base::TimeDelta minimum_interval) {
     minimum_interval_ = minimum_interval;
@@ -40,6 +45,7 @@ class CaptureScheduler {
   int num_of_processors_;
   RunningAverage capture_time_;
   RunningAverage encode_time_;
+  RunningAverage send_time_;
 
   DISALLOW_COPY_AND_ASSIGN(CaptureScheduler);
 };
@@ -84,4 +84,23 @@ TEST(CaptureSchedulerTest, RollingAverageDifferentTimes) {
   }
 }
 
+// The send time bounds the delay when the network is slower than the CPU.
+TEST(CaptureSchedulerTest, RollingAverageSendTimes) {
+  const int kTestResults[arraysize(kTestInputs)] = {
+    100, 75, 60, 50, 50, 50, 50, 56
+  };
+
+  CaptureScheduler scheduler;
+  scheduler.SetNumOfProcessorsForTest(8);
+  scheduler.set_minimum_interval(
+      base::TimeDelta::FromMilliseconds(kMinumumFrameIntervalMs));
+  for (size_t i = 0; i < arraysize(kTestInputs); ++i) {
+    scheduler.RecordCaptureTime(base::TimeDelta::FromMilliseconds(10));
+    scheduler.RecordEncodeTime(base::TimeDelta::FromMilliseconds(10));
+    scheduler.RecordSendTime(
+        base::TimeDelta::FromMilliseconds(kTestInputs[i]));
+    EXPECT_EQ(kTestResults[i], scheduler.NextCaptureDelay().InMilliseconds());
+  }
+}
+
 }  // namespace remoting
@@ -228,9 +228,11 @@ void VideoScheduler::CaptureNextFrame() {
   capturer_->Capture(webrtc::DesktopRegion());
 }
 
-void VideoScheduler::FrameCaptureCompleted() {
+void VideoScheduler::FrameCaptureCompleted(base::TimeDelta send_time) {
   DCHECK(capture_task_runner_->BelongsToCurrentThread());
 
+  scheduler_.RecordSendTime(send_time);
+
   // Decrement the pending capture count.
   pending_frames_--;
   DCHECK_GE(pending_frames_, 0);
@@ -250,17 +252,19 @@ void VideoScheduler::SendVideoPacket(scoped_ptr<VideoPacket> packet) {
     return;
 
   video_stub_->ProcessVideoPacket(
-      packet.Pass(), base::Bind(&VideoScheduler::VideoFrameSentCallback, this));
+      packet.Pass(), base::Bind(&VideoScheduler::VideoFrameSentCallback, this,
+                                base::TimeTicks::Now()));
 }
 
-void VideoScheduler::VideoFrameSentCallback() {
+void VideoScheduler::VideoFrameSentCallback(base::TimeTicks send_start_time) {
   DCHECK(network_task_runner_->BelongsToCurrentThread());
 
   if (!video_stub_)
     return;
 
   capture_task_runner_->PostTask(
-      FROM_HERE, base::Bind(&VideoScheduler::FrameCaptureCompleted, this));
+      FROM_HERE, base::Bind(&VideoScheduler::FrameCaptureCompleted, this,
+                            base::TimeTicks::Now() - send_start_time));
 }
 
 void VideoScheduler::SendCursorShape(
@@ -576,8 +576,9 @@ SandboxBPF::Program* SandboxBPF::AssembleFilter(bool force_verification) {
     FindRanges(&ranges);
 
     // Compile the system call ranges to an optimized BPF jumptable
+    Handlers handlers;
     Instruction* jumptable =
-        AssembleJumpTable(gen, ranges.begin(), ranges.end());
+        AssembleJumpTable(gen, ranges.begin(), ranges.end(), &handlers);
 
     // If there is at least one UnsafeTrap() in our program, the entire sandbox
     // is unsafe. We need to modify the program so that all non-
@@ -761,7 +762,8 @@ void SandboxBPF::FindRanges(Ranges* ranges) {
 
 Instruction* SandboxBPF::AssembleJumpTable(CodeGen* gen,
                                            Ranges::const_iterator start,
-                                           Ranges::const_iterator stop) {
+                                           Ranges::const_iterator stop,
+                                           Handlers* handlers) {
   // We convert the list of system call ranges into jump table that performs
   // a binary search over the ranges.
   // As a sanity check, we need to have at least one distinct ranges for us
@@ -770,8 +772,17 @@ Instruction* SandboxBPF::AssembleJumpTable(CodeGen* gen,
     SANDBOX_DIE("Invalid set of system call ranges");
   } else if (stop - start == 1) {
     // If we have narrowed things down to a single range object, we can
-    // return from the BPF filter program.
-    return RetExpression(gen, start->err);
+    // return from the BPF filter program. Policies typically map many
+    // disjoint ranges to the same ErrorCode, and conditional ErrorCodes can
+    // expand to long instruction sequences, so each distinct ErrorCode is
+    // only compiled once and then shared by all of its ranges.
+    Handlers::const_iterator iter = handlers->find(start->err);
+    if (iter != handlers->end()) {
+      return iter->second;
+    }
+    Instruction* handler = RetExpression(gen, start->err);
+    handlers->insert(std::make_pair(start->err, handler));
+    return handler;
   }
 
   // Pick the range object that is located at the mid point of our list.
@@ -781,8 +792,12 @@ Instruction* SandboxBPF::AssembleJumpTable(CodeGen* gen,
   Ranges::const_iterator mid = start + (stop - start) / 2;
 
   // Sub-divide the list of ranges and continue recursively.
-  Instruction* jf = AssembleJumpTable(gen, start, mid);
-  Instruction* jt = AssembleJumpTable(gen, mid, stop);
+  Instruction* jf = AssembleJumpTable(gen, start, mid, handlers);
+  Instruction* jt = AssembleJumpTable(gen, mid, stop, handlers);
+  if (jt == jf) {
+    // Both halves ended up with the same handler; no need to compare.
+    return jt;
+  }
   return gen->MakeInstruction(BPF_JMP + BPF_JGE + BPF_K, mid->from, jt, jf);
 }
 
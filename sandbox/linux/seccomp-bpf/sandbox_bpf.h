@@ -206,6 +206,8 @@ class SandboxBPF {
   typedef std::vector<Range> Ranges;
   typedef std::map<uint32_t, ErrorCode> ErrMap;
   typedef std::set<ErrorCode, struct ErrorCode::LessThan> Conds;
+  typedef std::map<ErrorCode, Instruction*, struct ErrorCode::LessThan>
+      Handlers;
 
   // Get a file descriptor pointing to "/proc", if currently available.
   int proc_fd() { return proc_fd_; }
@@ -243,9 +245,13 @@ class SandboxBPF {
 
   // Returns a BPF program snippet that implements a jump table for the
   // given range of system call numbers. This function runs recursively.
+  // The jump table is a balanced binary search over the ranges. Ranges that
+  // share an ErrorCode also share the snippet that handles it; "handlers"
+  // remembers the snippets that have been emitted so far.
   Instruction* AssembleJumpTable(CodeGen* gen,
                                  Ranges::const_iterator start,
-                                 Ranges::const_iterator stop);
+                                 Ranges::const_iterator stop,
+                                 Handlers* handlers);
 
   // Returns a BPF program snippet that makes the BPF filter program exit
   // with the given ErrorCode "err". N.B. the ErrorCode may very well be a
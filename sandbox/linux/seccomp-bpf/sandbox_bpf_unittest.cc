@@ -4,6 +4,7 @@
 
 #include <errno.h>
 #include <pthread.h>
+#include <stdio.h>
 #include <sched.h>
 #include <sys/prctl.h>
 #include <sys/syscall.h>
@@ -21,6 +22,7 @@
 #include <ostream>
 
 #include "base/memory/scoped_ptr.h"
+#include "base/time/time.h"
 #include "build/build_config.h"
 #include "sandbox/linux/seccomp-bpf/bpf_tests.h"
 #include "sandbox/linux/seccomp-bpf/syscall.h"
@@ -391,6 +393,65 @@ BPF_TEST(SandboxBPF, SyntheticPolicy, SyntheticPolicy) {
   }
 }
 
+// A policy that is shaped like the renderer and GPU policies: most system
+// calls are denied, some are allowed and some depend on their first
+// argument. The same few ErrorCodes recur in many disjoint ranges.
+ErrorCode InterleavedPolicy(SandboxBPF* sandbox, int sysno, void*) {
+  if (!SandboxBPF::IsValidSyscallNumber(sysno)) {
+    return ErrorCode(ENOSYS);
+  }
+  if (sysno % 7 == 0) {
+    return sandbox->Cond(0, ErrorCode::TP_32BIT, ErrorCode::OP_EQUAL, 0,
+                         ErrorCode(ErrorCode::ERR_ALLOWED),
+                         sandbox->Cond(0, ErrorCode::TP_32BIT,
+                                       ErrorCode::OP_EQUAL, 1,
+                                       ErrorCode(EACCES),
+                                       ErrorCode(EPERM)));
+  } else if (sysno % 3 == 0) {
+    return ErrorCode(ErrorCode::ERR_ALLOWED);
+  } else {
+    return ErrorCode(EPERM);
+  }
+}
+
+// Compiles "policy" and reports the size of the BPF program and the time
+// the BPF interpreter takes to evaluate it, on average, for a system call.
+void MeasurePolicy(SandboxBPF::EvaluateSyscall policy, const char* trace) {
+  SandboxBPF sandbox;
+  sandbox.SetSandboxPolicyDeprecated(policy, NULL);
+  scoped_ptr<SandboxBPF::Program> program(
+      sandbox.AssembleFilter(true /* force_verification */));
+
+  const int kIterations = 20;
+  int evaluations = 0;
+  base::TimeTicks start = base::TimeTicks::HighResNow();
+  for (int i = 0; i < kIterations; ++i) {
+    for (uint32_t sysnum = MIN_SYSCALL; sysnum <= MAX_PUBLIC_SYSCALL;
+         ++sysnum) {
+      struct arch_seccomp_data data = { static_cast<int>(sysnum),
+                                        SECCOMP_ARCH };
+      const char* err = NULL;
+      Verifier::EvaluateBPF(*program, data, &err);
+      BPF_ASSERT(!err);
+      ++evaluations;
+    }
+  }
+  base::TimeDelta elapsed = base::TimeTicks::HighResNow() - start;
+
+  // Results go to stdout; anything on stderr would fail the test.
+  printf("RESULT bpf_program_size: %s= %u instructions\n",
+         trace, static_cast<unsigned>(program->size()));
+  printf("RESULT bpf_evaluation_time: %s= %f ns/syscall\n",
+         trace, elapsed.InMicroseconds() * 1000.0 / evaluations);
+  fflush(stdout);
+}
+
+SANDBOX_TEST(SandboxBPF, CompiledPolicyBenchmark) {
+  MeasurePolicy(BlacklistNanosleepPolicy, "blacklist");
+  MeasurePolicy(SyntheticPolicy, "synthetic");
+  MeasurePolicy(InterleavedPolicy, "interleaved");
+}
+
 #if defined(__arm__)
 // A simple policy that tests whether ARM private system calls are supported
 // by our BPF compiler and by the BPF interpreter in the kernel.
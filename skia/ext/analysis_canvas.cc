@@ -76,7 +76,8 @@ AnalysisDevice::AnalysisDevice(const SkBitmap& bitmap)
       is_forced_not_transparent_(false),
       is_solid_color_(true),
       is_transparent_(true),
-      has_text_(false) {}
+      has_text_(false),
+      slow_path_count_(0) {}
 
 AnalysisDevice::~AnalysisDevice() {}
 
@@ -96,6 +97,10 @@ bool AnalysisDevice::HasText() const {
   return has_text_;
 }
 
+int AnalysisDevice::GetSlowPathCount() const {
+  return slow_path_count_;
+}
+
 void AnalysisDevice::SetForceNotSolid(bool flag) {
   is_forced_not_solid_ = flag;
   if (is_forced_not_solid_)
@@ -199,6 +204,9 @@ void AnalysisDevice::drawPath(const SkDraw& draw,
                               bool path_is_mutable) {
   is_solid_color_ = false;
   is_transparent_ = false;
+
+  if (paint.isAntiAlias() && !path.isConvex())
+    ++slow_path_count_;
 }
 
 void AnalysisDevice::drawBitmap(const SkDraw& draw,
@@ -303,6 +311,10 @@ bool AnalysisCanvas::HasText() const {
   return (static_cast<AnalysisDevice*>(getDevice()))->HasText();
 }
 
+int AnalysisCanvas::GetSlowPathCount() const {
+  return (static_cast<AnalysisDevice*>(getDevice()))->GetSlowPathCount();
+}
+
 bool AnalysisCanvas::abortDrawing() {
   // Early out as soon as we have detected that the tile has text.
   return HasText();
@@ -28,6 +28,9 @@ class SK_API AnalysisCanvas : public SkCanvas, public SkDrawPictureCallback {
   // Returns true when a SkColor can be used to represent result.
   bool GetColorIfSolid(SkColor* color) const;
   bool HasText() const;
+  // Returns the number of anti-aliased concave paths drawn, which are slow
+  // to rasterize on the GPU.
+  int GetSlowPathCount() const;
 
   // SkDrawPictureCallback override.
   virtual bool abortDrawing() OVERRIDE;
@@ -68,6 +71,7 @@ class SK_API AnalysisDevice : public SkBitmapDevice {
 
   bool GetColorIfSolid(SkColor* color) const;
   bool HasText() const;
+  int GetSlowPathCount() const;
 
   void SetForceNotSolid(bool flag);
   void SetForceNotTransparent(bool flag);
@@ -154,6 +158,7 @@ class SK_API AnalysisDevice : public SkBitmapDevice {
   SkColor color_;
   bool is_transparent_;
   bool has_text_;
+  int slow_path_count_;
 };
 
 }  // namespace skia
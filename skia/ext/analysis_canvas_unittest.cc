@@ -404,4 +404,41 @@ TEST(AnalysisCanvasTest, HasText) {
   }
 }
 
+TEST(AnalysisCanvasTest, SlowPathCount) {
+  SkBitmap bitmap;
+  bitmap.setConfig(SkBitmap::kNo_Config, 255, 255);
+  skia::AnalysisDevice device(bitmap);
+  skia::AnalysisCanvas canvas(&device);
+  EXPECT_EQ(0, canvas.GetSlowPathCount());
+
+  SkPath convex_path;
+  convex_path.moveTo(0, 0);
+  convex_path.lineTo(100, 0);
+  convex_path.lineTo(100, 100);
+  convex_path.close();
+
+  SkPath concave_path;
+  concave_path.moveTo(0, 0);
+  concave_path.lineTo(100, 0);
+  concave_path.lineTo(50, 50);
+  concave_path.lineTo(100, 100);
+  concave_path.lineTo(0, 100);
+  concave_path.close();
+
+  SkPaint paint;
+  canvas.drawPath(concave_path, paint);
+  EXPECT_EQ(0, canvas.GetSlowPathCount());
+
+  // Only anti-aliased concave paths are slow.
+  paint.setAntiAlias(true);
+  canvas.drawPath(convex_path, paint);
+  EXPECT_EQ(0, canvas.GetSlowPathCount());
+  canvas.drawPath(concave_path, paint);
+  EXPECT_EQ(1, canvas.GetSlowPathCount());
+
+  // Unlike HasText(), clearing the canvas doesn't reset the count.
+  canvas.clear(SK_ColorWHITE);
+  EXPECT_EQ(1, canvas.GetSlowPathCount());
+}
+
 }  // namespace skia
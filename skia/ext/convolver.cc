@@ -4,10 +4,16 @@
 
 #include <algorithm>
 
+#include "base/bind.h"
+#include "base/location.h"
 #include "base/logging.h"
+#include "base/memory/scoped_vector.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/worker_pool.h"
 #include "skia/ext/convolver.h"
 #include "skia/ext/convolver_SSE2.h"
 #include "skia/ext/convolver_mips_dspr2.h"
+#include "skia/ext/convolver_neon.h"
 #include "third_party/skia/include/core/SkSize.h"
 #include "third_party/skia/include/core/SkTypes.h"
 
@@ -373,25 +379,63 @@ void SetupSIMD(ConvolveProcs *procs) {
   procs->extra_horizontal_reads = 3;
   procs->convolve_vertically = &ConvolveVertically_mips_dspr2;
   procs->convolve_horizontally = &ConvolveHorizontally_mips_dspr2;
+#elif defined SIMD_NEON
+  procs->extra_horizontal_reads = 0;
+  procs->convolve_vertically = &ConvolveVertically_Neon;
+  procs->convolve_horizontally = &ConvolveHorizontally_Neon;
 #endif
 }
 
-void BGRAConvolve2D(const unsigned char* source_data,
-                    int source_byte_row_stride,
-                    bool source_has_alpha,
-                    const ConvolutionFilter1D& filter_x,
-                    const ConvolutionFilter1D& filter_y,
-                    int output_byte_row_stride,
-                    unsigned char* output,
-                    bool use_simd_if_possible) {
+namespace {
+
+// The arguments of a BGRAConvolve2D() call, so that bands of its output rows
+// can be convolved separately.
+struct ConvolveJob {
+  const unsigned char* source_data;
+  int source_byte_row_stride;
+  bool source_has_alpha;
+  const ConvolutionFilter1D* filter_x;
+  const ConvolutionFilter1D* filter_y;
+  int output_byte_row_stride;
+  unsigned char* output;
   ConvolveProcs simd;
-  simd.extra_horizontal_reads = 0;
-  simd.convolve_vertically = NULL;
-  simd.convolve_4rows_horizontally = NULL;
-  simd.convolve_horizontally = NULL;
+};
+
+void InitConvolveJob(const unsigned char* source_data,
+                     int source_byte_row_stride,
+                     bool source_has_alpha,
+                     const ConvolutionFilter1D& filter_x,
+                     const ConvolutionFilter1D& filter_y,
+                     int output_byte_row_stride,
+                     unsigned char* output,
+                     bool use_simd_if_possible,
+                     ConvolveJob* job) {
+  job->source_data = source_data;
+  job->source_byte_row_stride = source_byte_row_stride;
+  job->source_has_alpha = source_has_alpha;
+  job->filter_x = &filter_x;
+  job->filter_y = &filter_y;
+  job->output_byte_row_stride = output_byte_row_stride;
+  job->output = output;
+  job->simd.extra_horizontal_reads = 0;
+  job->simd.convolve_vertically = NULL;
+  job->simd.convolve_4rows_horizontally = NULL;
+  job->simd.convolve_horizontally = NULL;
   if (use_simd_if_possible) {
-    SetupSIMD(&simd);
+    SetupSIMD(&job->simd);
   }
+}
+
+// Convolves the output rows [first_out_row, end_out_row) of |job|.
+void ConvolveRows(const ConvolveJob& job, int first_out_row, int end_out_row) {
+  const unsigned char* source_data = job.source_data;
+  int source_byte_row_stride = job.source_byte_row_stride;
+  bool source_has_alpha = job.source_has_alpha;
+  const ConvolutionFilter1D& filter_x = *job.filter_x;
+  const ConvolutionFilter1D& filter_y = *job.filter_y;
+  int output_byte_row_stride = job.output_byte_row_stride;
+  unsigned char* output = job.output;
+  const ConvolveProcs& simd = job.simd;
 
   int max_y_filter_size = filter_y.max_filter();
 
@@ -399,10 +443,11 @@ void BGRAConvolve2D(const unsigned char* source_data,
   // convolved row for. If the filter doesn't start at the beginning of the
   // image (this is the case when we are only resizing a subset), then we
   // don't want to generate any output rows before that. Compute the starting
-  // row for convolution as the first pixel for the first vertical filter.
+  // row for convolution as the first pixel for the first vertical filter of
+  // this band.
   int filter_offset, filter_length;
   const ConvolutionFilter1D::Fixed* filter_values =
-      filter_y.FilterForValue(0, &filter_offset, &filter_length);
+      filter_y.FilterForValue(first_out_row, &filter_offset, &filter_length);
   int next_x_row = filter_offset;
 
   // We loop over each row in the input doing a horizontal convolution. This
@@ -446,7 +491,7 @@ void BGRAConvolve2D(const unsigned char* source_data,
   filter_y.FilterForValue(num_output_rows - 1, &last_filter_offset,
                           &last_filter_length);
 
-  for (int out_y = 0; out_y < num_output_rows; out_y++) {
+  for (int out_y = first_out_row; out_y < end_out_row; out_y++) {
     filter_values = filter_y.FilterForValue(out_y,
                                             &filter_offset, &filter_length);
 
@@ -513,6 +558,85 @@ void BGRAConvolve2D(const unsigned char* source_data,
   }
 }
 
+void ConvolveRowsAndSignal(const ConvolveJob* job,
+                           int first_out_row,
+                           int end_out_row,
+                           base::WaitableEvent* done) {
+  ConvolveRows(*job, first_out_row, end_out_row);
+  done->Signal();
+}
+
+}  // namespace
+
+void BGRAConvolve2D(const unsigned char* source_data,
+                    int source_byte_row_stride,
+                    bool source_has_alpha,
+                    const ConvolutionFilter1D& filter_x,
+                    const ConvolutionFilter1D& filter_y,
+                    int output_byte_row_stride,
+                    unsigned char* output,
+                    bool use_simd_if_possible) {
+  ConvolveJob job;
+  InitConvolveJob(source_data, source_byte_row_stride, source_has_alpha,
+                  filter_x, filter_y, output_byte_row_stride, output,
+                  use_simd_if_possible, &job);
+  ConvolveRows(job, 0, filter_y.num_values());
+}
+
+void BGRAConvolve2DParallel(const unsigned char* source_data,
+                            int source_byte_row_stride,
+                            bool source_has_alpha,
+                            const ConvolutionFilter1D& filter_x,
+                            const ConvolutionFilter1D& filter_y,
+                            int output_byte_row_stride,
+                            unsigned char* output,
+                            bool use_simd_if_possible,
+                            int max_threads) {
+  ConvolveJob job;
+  InitConvolveJob(source_data, source_byte_row_stride, source_has_alpha,
+                  filter_x, filter_y, output_byte_row_stride, output,
+                  use_simd_if_possible, &job);
+
+  // Each band convolves up to max_filter() source rows horizontally that the
+  // band before it needs too. Keep that under a quarter of the source rows
+  // each band really covers.
+  int num_output_rows = filter_y.num_values();
+  int first_offset, first_length, last_offset, last_length;
+  filter_y.FilterForValue(0, &first_offset, &first_length);
+  filter_y.FilterForValue(num_output_rows - 1, &last_offset, &last_length);
+  int num_source_rows = std::max(last_offset + last_length - first_offset, 1);
+  int min_band_rows = std::max(
+      4 * filter_y.max_filter() * num_output_rows / num_source_rows, 16);
+  int num_bands = std::min(max_threads, num_output_rows / min_band_rows);
+  if (num_bands <= 1) {
+    ConvolveRows(job, 0, num_output_rows);
+    return;
+  }
+
+  // The first band is convolved on this thread, the others on the worker
+  // pool.
+  ScopedVector<base::WaitableEvent> band_done;
+  int band_rows = (num_output_rows + num_bands - 1) / num_bands;
+  for (int first_row = band_rows; first_row < num_output_rows;
+       first_row += band_rows) {
+    int end_row = std::min(first_row + band_rows, num_output_rows);
+    base::WaitableEvent* done = new base::WaitableEvent(false, false);
+    band_done.push_back(done);
+    if (!base::WorkerPool::PostTask(
+            FROM_HERE,
+            base::Bind(&ConvolveRowsAndSignal, &job, first_row, end_row,
+                       done),
+            false)) {
+      ConvolveRows(job, first_row, end_row);
+      done->Signal();
+    }
+  }
+  ConvolveRows(job, 0, std::min(band_rows, num_output_rows));
+
+  for (size_t i = 0; i < band_done.size(); ++i)
+    band_done[i]->Wait();
+}
+
 void SingleChannelConvolveX1D(const unsigned char* source_data,
                               int source_byte_row_stride,
                               int input_channel_index,
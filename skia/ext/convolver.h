@@ -24,6 +24,12 @@
     defined(__mips_dsp) && (__mips_dsp_rev >= 2)
 #define SIMD_MIPS_DSPR2 1
 #endif
+
+// NEON is only used when the whole build targets it, as there is no runtime
+// detection here.
+#if defined(ARCH_CPU_ARM_FAMILY) && defined(__ARM_NEON__)
+#define SIMD_NEON 1
+#endif
 // avoid confusion with Mac OS X's math library (Carbon)
 #if defined(__APPLE__)
 #undef FloatToFixed
@@ -191,6 +197,22 @@ SK_API void BGRAConvolve2D(const unsigned char* source_data,
                            unsigned char* output,
                            bool use_simd_if_possible);
 
+// Same as BGRAConvolve2D(), but splits the output rows into up to
+// |max_threads| bands which are convolved in parallel on the worker pool and
+// the calling thread. Each band convolves the few source rows it shares with
+// the next one again, so this only pays off for large images; small ones are
+// convolved on the calling thread only. Returns when the whole output has
+// been written, so it must not be called on threads that disallow waiting.
+SK_API void BGRAConvolve2DParallel(const unsigned char* source_data,
+                                   int source_byte_row_stride,
+                                   bool source_has_alpha,
+                                   const ConvolutionFilter1D& xfilter,
+                                   const ConvolutionFilter1D& yfilter,
+                                   int output_byte_row_stride,
+                                   unsigned char* output,
+                                   bool use_simd_if_possible,
+                                   int max_threads);
+
 // Does a 1D convolution of the given source image along the X dimension on
 // a single channel of the bitmap.
 //
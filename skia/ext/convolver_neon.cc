@@ -0,0 +1,143 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "skia/ext/convolver.h"
+#include "skia/ext/convolver_neon.h"
+
+#if defined(SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace skia {
+
+#if defined(SIMD_NEON)
+namespace {
+
+// Brings the 32-bit fixed point sums of two pixels back to 8 bits per channel,
+// saturating to the range 0-255 like ClampTo8() does.
+inline uint8x8_t Accumulators2ToPixels(int32x4_t accum0, int32x4_t accum1) {
+  accum0 = vshrq_n_s32(accum0, ConvolutionFilter1D::kShiftBits);
+  accum1 = vshrq_n_s32(accum1, ConvolutionFilter1D::kShiftBits);
+  return vqmovun_s16(vcombine_s16(vqmovn_s32(accum0), vqmovn_s32(accum1)));
+}
+
+// Makes sure the alpha channel of each pixel in |pixels| is not smaller than
+// any of its color channels, or sets it to 0xff if the image is opaque. See
+// ConvolveVertically() in convolver.cc for why.
+inline uint8x8_t FixUpAlpha(uint8x8_t pixels, bool has_alpha) {
+  const uint32x2_t alpha_mask = vdup_n_u32(0xff000000);
+  uint32x2_t pixels32 = vreinterpret_u32_u8(pixels);
+  if (!has_alpha)
+    return vreinterpret_u8_u32(vorr_u32(pixels32, alpha_mask));
+
+  // Shift each of B, G and R into the alpha byte of its pixel and take the
+  // maximum of all four channels there.
+  uint8x8_t max = vmax_u8(pixels,
+                          vreinterpret_u8_u32(vshl_n_u32(pixels32, 8)));
+  max = vmax_u8(max, vreinterpret_u8_u32(vshl_n_u32(pixels32, 16)));
+  max = vmax_u8(max, vreinterpret_u8_u32(vshl_n_u32(pixels32, 24)));
+  return vreinterpret_u8_u32(
+      vbsl_u32(alpha_mask, vreinterpret_u32_u8(max), pixels32));
+}
+
+}  // namespace
+#endif
+
+// Convolves horizontally along a single row. The row data is given in
+// |src_data| and continues for the num_values() of the filter. Unlike the SSE2
+// version, this never reads past the last pixel a filter touches.
+void ConvolveHorizontally_Neon(const unsigned char* src_data,
+                               const ConvolutionFilter1D& filter,
+                               unsigned char* out_row,
+                               bool /*has_alpha*/) {
+#if defined(SIMD_NEON)
+  int num_values = filter.num_values();
+  for (int out_x = 0; out_x < num_values; out_x++) {
+    int filter_offset, filter_length;
+    const ConvolutionFilter1D::Fixed* filter_values =
+        filter.FilterForValue(out_x, &filter_offset, &filter_length);
+    const unsigned char* row_to_filter = &src_data[filter_offset << 2];
+
+    // Accumulate two pixels per iteration, one in each accumulator, and sum
+    // the accumulators at the end.
+    int32x4_t accum0 = vdupq_n_s32(0);
+    int32x4_t accum1 = vdupq_n_s32(0);
+    int filter_x = 0;
+    for (; filter_x + 1 < filter_length; filter_x += 2) {
+      int16x8_t src16 = vreinterpretq_s16_u16(
+          vmovl_u8(vld1_u8(&row_to_filter[filter_x << 2])));
+      accum0 = vmlal_n_s16(accum0, vget_low_s16(src16),
+                           filter_values[filter_x]);
+      accum1 = vmlal_n_s16(accum1, vget_high_s16(src16),
+                           filter_values[filter_x + 1]);
+    }
+    if (filter_x < filter_length) {
+      uint32x2_t src32 = vld1_dup_u32(
+          reinterpret_cast<const uint32_t*>(&row_to_filter[filter_x << 2]));
+      int16x8_t src16 =
+          vreinterpretq_s16_u16(vmovl_u8(vreinterpret_u8_u32(src32)));
+      accum0 = vmlal_n_s16(accum0, vget_low_s16(src16),
+                           filter_values[filter_x]);
+    }
+    accum0 = vaddq_s32(accum0, accum1);
+
+    uint8x8_t pixel = Accumulators2ToPixels(accum0, accum0);
+    vst1_lane_u32(reinterpret_cast<uint32_t*>(&out_row[out_x << 2]),
+                  vreinterpret_u32_u8(pixel), 0);
+  }
+#endif
+}
+
+// Does vertical convolution to produce one output row, two pixels at a time.
+// The filter values and length are given in the first two parameters. These
+// are applied to each of the rows pointed to in the |source_data_rows| array,
+// with each row being |pixel_width| wide.
+//
+// The output must have room for |pixel_width * 4| bytes.
+void ConvolveVertically_Neon(const ConvolutionFilter1D::Fixed* filter_values,
+                             int filter_length,
+                             unsigned char* const* source_data_rows,
+                             int pixel_width,
+                             unsigned char* out_row,
+                             bool has_alpha) {
+#if defined(SIMD_NEON)
+  int out_x = 0;
+  for (; out_x + 1 < pixel_width; out_x += 2) {
+    int byte_offset = out_x << 2;
+    int32x4_t accum0 = vdupq_n_s32(0);
+    int32x4_t accum1 = vdupq_n_s32(0);
+    for (int filter_y = 0; filter_y < filter_length; filter_y++) {
+      int16x8_t src16 = vreinterpretq_s16_u16(
+          vmovl_u8(vld1_u8(&source_data_rows[filter_y][byte_offset])));
+      accum0 = vmlal_n_s16(accum0, vget_low_s16(src16),
+                           filter_values[filter_y]);
+      accum1 = vmlal_n_s16(accum1, vget_high_s16(src16),
+                           filter_values[filter_y]);
+    }
+    uint8x8_t pixels =
+        FixUpAlpha(Accumulators2ToPixels(accum0, accum1), has_alpha);
+    vst1_u8(&out_row[byte_offset], pixels);
+  }
+
+  // Handle the last pixel of odd widths.
+  if (out_x < pixel_width) {
+    int byte_offset = out_x << 2;
+    int32x4_t accum = vdupq_n_s32(0);
+    for (int filter_y = 0; filter_y < filter_length; filter_y++) {
+      uint32x2_t src32 = vld1_dup_u32(reinterpret_cast<const uint32_t*>(
+          &source_data_rows[filter_y][byte_offset]));
+      int16x8_t src16 =
+          vreinterpretq_s16_u16(vmovl_u8(vreinterpret_u8_u32(src32)));
+      accum = vmlal_n_s16(accum, vget_low_s16(src16),
+                          filter_values[filter_y]);
+    }
+    uint8x8_t pixel = FixUpAlpha(Accumulators2ToPixels(accum, accum),
+                                 has_alpha);
+    vst1_lane_u32(reinterpret_cast<uint32_t*>(&out_row[byte_offset]),
+                  vreinterpret_u32_u8(pixel), 0);
+  }
+#endif
+}
+
+}  // namespace skia
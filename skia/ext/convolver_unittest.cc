@@ -339,6 +339,35 @@ TEST(Convolver, MAYBE_SIMDVerification) {
   }
 }
 
+// Verifies that convolving bands of rows in parallel gives the same output as
+// convolving the whole image at once.
+TEST(Convolver, ParallelMatchesSerial) {
+  const int kSourceSize = 600;
+  const int kDestSize = 300;
+  const float kFilter[] = { 0.125f, 0.375f, 0.375f, 0.125f };
+
+  ConvolutionFilter1D filter;
+  for (int p = 0; p < kDestSize; ++p) {
+    int offset = std::min(p * 2, kSourceSize - 4);
+    filter.AddFilter(offset, kFilter, arraysize(kFilter));
+  }
+  filter.PaddingForSIMD();
+
+  std::vector<unsigned char> source(kSourceSize * kSourceSize * 4);
+  for (size_t i = 0; i < source.size(); ++i)
+    source[i] = static_cast<unsigned char>(rand() % 255);
+
+  for (int alpha = 0; alpha < 2; alpha++) {
+    std::vector<unsigned char> serial(kDestSize * kDestSize * 4);
+    std::vector<unsigned char> parallel(kDestSize * kDestSize * 4);
+    BGRAConvolve2D(&source[0], kSourceSize * 4, alpha != 0, filter, filter,
+                   kDestSize * 4, &serial[0], true);
+    BGRAConvolve2DParallel(&source[0], kSourceSize * 4, alpha != 0, filter,
+                           filter, kDestSize * 4, &parallel[0], true, 4);
+    EXPECT_TRUE(serial == parallel);
+  }
+}
+
 TEST(Convolver, SeparableSingleConvolution) {
   static const int kImgWidth = 1024;
   static const int kImgHeight = 1024;
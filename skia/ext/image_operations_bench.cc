@@ -13,9 +13,15 @@
 // source surface + destination surface and dividing by the elapsed time.
 // This number is somewhat reasonable way to measure this, given our current
 // implementation which somewhat scales this way.
+// With -threads or -nosimd, it instead convolves with a box filter directly,
+// to compare the SIMD and C convolvers and the parallel convolution mode.
 
 #include <stdio.h>
 
+#include <algorithm>
+#include <vector>
+
+#include "base/at_exit.h"
 #include "base/basictypes.h"
 #include "base/command_line.h"
 #include "base/format_macros.h"
@@ -24,6 +30,7 @@
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/time/time.h"
+#include "skia/ext/convolver.h"
 #include "skia/ext/image_operations.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkRect.h"
@@ -141,7 +148,9 @@ class Benchmark {
 
   Benchmark()
       : num_iterations_(kDefaultNumberIterations),
-        method_(kDefaultResizeMethod) {}
+        method_(kDefaultResizeMethod),
+        num_threads_(0),
+        use_simd_(true) {}
 
   // Returns true if command line parsing was successful, false otherwise.
   bool ParseArgs(const CommandLine* command_line);
@@ -151,8 +160,16 @@ class Benchmark {
 
   static void Usage();
  private:
+  // Convolves |source| into |dest| with box filters, using |num_threads_|
+  // threads and SIMD if |use_simd_|.
+  void Convolve(const SkBitmap& source, SkBitmap* dest) const;
+
   int num_iterations_;
   skia::ImageOperations::ResizeMethod method_;
+  // 0 unless -threads or -nosimd was given, and ImageOperations::Resize()
+  // is benchmarked.
+  int num_threads_;
+  bool use_simd_;
   Dimensions source_;
   Dimensions dest_;
 };
@@ -165,7 +182,7 @@ const skia::ImageOperations::ResizeMethod Benchmark::kDefaultResizeMethod =
 // argument management
 void Benchmark::Usage() {
   printf("image_operations_bench -source wxh -destination wxh "
-         "[-iterations i] [-method m] [-help]\n"
+         "[-iterations i] [-method m] [-threads t] [-nosimd] [-help]\n"
          "  -source wxh: specify source width and height\n"
          "  -destination wxh: specify destination width and height\n"
          "  -iter i: perform i iterations (default:%d)\n"
@@ -173,7 +190,9 @@ void Benchmark::Usage() {
          Benchmark::kDefaultNumberIterations,
          MethodToString(Benchmark::kDefaultResizeMethod));
   PrintMethods();
-  printf("\n  -help: prints this help and exits\n");
+  printf("\n  -threads t: convolve directly on t threads\n"
+         "  -nosimd: convolve directly without SIMD\n"
+         "  -help: prints this help and exits\n");
 }
 
 bool Benchmark::ParseArgs(const CommandLine* command_line) {
@@ -198,6 +217,16 @@ bool Benchmark::ParseArgs(const CommandLine* command_line) {
       if (base::StringToInt(value, &num_iterations_) == false) {
         fNeedHelp = true;
       }
+    } else if (s == "threads") {
+      if (base::StringToInt(value, &num_threads_) == false ||
+          num_threads_ <= 0) {
+        printf("Invalid number of threads: %s\n", value.c_str());
+        fNeedHelp = true;
+      }
+    } else if (s == "nosimd") {
+      use_simd_ = false;
+      if (num_threads_ == 0)
+        num_threads_ = 1;
     } else if (s == "method") {
       if (!StringToMethod(value, &method_)) {
         printf("Invalid method '%s' specified\n", value.c_str());
@@ -226,6 +255,34 @@ bool Benchmark::ParseArgs(const CommandLine* command_line) {
   return true;
 }
 
+void Benchmark::Convolve(const SkBitmap& source, SkBitmap* dest) const {
+  // Box filters covering every source pixel once, like RESIZE_BOX for
+  // downscales.
+  skia::ConvolutionFilter1D filters[2];
+  const int source_sizes[2] = { source_.width(), source_.height() };
+  const int dest_sizes[2] = { dest_.width(), dest_.height() };
+  for (int i = 0; i < 2; ++i) {
+    for (int p = 0; p < dest_sizes[i]; ++p) {
+      int start = p * source_sizes[i] / dest_sizes[i];
+      int end = std::max((p + 1) * source_sizes[i] / dest_sizes[i], start + 1);
+      end = std::min(end, source_sizes[i]);
+      std::vector<float> values(end - start, 1.0f / (end - start));
+      filters[i].AddFilter(start, &values[0], static_cast<int>(values.size()));
+    }
+    filters[i].PaddingForSIMD();
+  }
+
+  dest->setConfig(SkBitmap::kARGB_8888_Config,
+                  dest_.width(), dest_.height());
+  dest->allocPixels();
+  skia::BGRAConvolve2DParallel(
+      static_cast<const unsigned char*>(source.getPixels()),
+      static_cast<int>(source.rowBytes()), true, filters[0], filters[1],
+      static_cast<int>(dest->rowBytes()),
+      static_cast<unsigned char*>(dest->getPixels()), use_simd_,
+      num_threads_);
+}
+
 // actual benchmark.
 bool Benchmark::Run() const {
   SkBitmap source;
@@ -239,9 +296,13 @@ bool Benchmark::Run() const {
   const base::TimeTicks start = base::TimeTicks::Now();
 
   for (int i = 0; i < num_iterations_; ++i) {
-    dest = skia::ImageOperations::Resize(source,
-                                         method_,
-                                         dest_.width(), dest_.height());
+    if (num_threads_) {
+      Convolve(source, &dest);
+    } else {
+      dest = skia::ImageOperations::Resize(source,
+                                           method_,
+                                           dest_.width(), dest_.height());
+    }
   }
 
   const int64 elapsed_us = (base::TimeTicks::Now() - start).InMicroseconds();
@@ -276,6 +337,8 @@ class CommandLineAutoReset {
 }  // namespace
 
 int main(int argc, char** argv) {
+  // The worker pool used by -threads needs one.
+  base::AtExitManager at_exit;
   Benchmark bench;
   CommandLineAutoReset command_line(argc, argv);
 
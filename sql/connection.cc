@@ -8,6 +8,7 @@
 
 #include "base/files/file_path.h"
 #include "base/file_util.h"
+#include "base/format_macros.h"
 #include "base/lazy_instance.h"
 #include "base/logging.h"
 #include "base/metrics/histogram.h"
@@ -216,6 +217,9 @@ Connection::Connection()
       cache_size_(0),
       exclusive_locking_(false),
       restrict_to_user_(false),
+      wal_mode_(false),
+      wal_autocheckpoint_(-1),
+      mmap_size_(0),
       transaction_nesting_(0),
       needs_rollback_(false),
       in_memory_(false),
@@ -552,13 +556,16 @@ bool Connection::Delete(const base::FilePath& path) {
 
   base::FilePath journal_path(path.value() + FILE_PATH_LITERAL("-journal"));
   base::FilePath wal_path(path.value() + FILE_PATH_LITERAL("-wal"));
+  base::FilePath shm_path(path.value() + FILE_PATH_LITERAL("-shm"));
 
   base::DeleteFile(journal_path, false);
   base::DeleteFile(wal_path, false);
+  base::DeleteFile(shm_path, false);
   base::DeleteFile(path, false);
 
   return !base::PathExists(journal_path) &&
       !base::PathExists(wal_path) &&
+      !base::PathExists(shm_path) &&
       !base::PathExists(path);
 }
 
@@ -917,8 +924,10 @@ bool Connection::OpenInternal(const std::string& file_name,
       // be fatal unless the file doesn't exist.
       base::FilePath journal_path(file_name + FILE_PATH_LITERAL("-journal"));
       base::FilePath wal_path(file_name + FILE_PATH_LITERAL("-wal"));
+      base::FilePath shm_path(file_name + FILE_PATH_LITERAL("-shm"));
       base::SetPosixFilePermissions(journal_path, mode);
       base::SetPosixFilePermissions(wal_path, mode);
+      base::SetPosixFilePermissions(shm_path, mode);
     }
   }
 #endif  // defined(OS_POSIX)
@@ -977,7 +986,29 @@ bool Connection::OpenInternal(const std::string& file_name,
   // TODO(shess): Figure out if PERSIST and journal_size_limit really
   // matter.  In theory, it keeps pages pre-allocated, so if
   // transactions usually fit, it should be faster.
-  ignore_result(Execute("PRAGMA journal_mode = PERSIST"));
+  // WAL - append to -wal file to commit, see set_wal_mode().  In WAL
+  // mode, journal_size_limit provides the size to trim the log to after
+  // a checkpoint.
+  bool use_wal = false;
+  if (wal_mode_ && !in_memory_) {
+    // The pragma returns the journal mode in effect, which stays the old one
+    // if the log cannot be used (for instance if the VFS lacks shared memory
+    // support).  Fall back to the rollback journal in that case.
+    Statement s(GetUniqueStatement("PRAGMA journal_mode = WAL"));
+    use_wal = s.Step() && LowerCaseEqualsASCII(s.ColumnString(0), "wal");
+    DLOG_IF(WARNING, !use_wal) << "Unable to enable WAL, using PERSIST.";
+  }
+  if (use_wal) {
+    // The log is only synced at checkpoints.
+    ignore_result(Execute("PRAGMA synchronous = NORMAL"));
+    if (wal_autocheckpoint_ >= 0) {
+      const std::string sql = base::StringPrintf(
+          "PRAGMA wal_autocheckpoint = %d", wal_autocheckpoint_);
+      ignore_result(Execute(sql.c_str()));
+    }
+  } else {
+    ignore_result(Execute("PRAGMA journal_mode = PERSIST"));
+  }
   ignore_result(Execute("PRAGMA journal_size_limit = 16384"));
 
   const base::TimeDelta kBusyTimeout =
@@ -1000,6 +1031,16 @@ bool Connection::OpenInternal(const std::string& file_name,
     ignore_result(ExecuteWithTimeout(sql.c_str(), kBusyTimeout));
   }
 
+  // http://www.sqlite.org/pragma.html#pragma_mmap_size
+  // Unknown pragmas are a no-op, so this is safe with an SQLite which
+  // predates memory-mapped I/O.  The size is also clamped to the
+  // compile-time SQLITE_MAX_MMAP_SIZE.
+  if (mmap_size_ > 0) {
+    const std::string sql =
+        base::StringPrintf("PRAGMA mmap_size=%" PRId64, mmap_size_);
+    ignore_result(ExecuteWithTimeout(sql.c_str(), kBusyTimeout));
+  }
+
   if (!ExecuteWithTimeout("PRAGMA secure_delete=ON", kBusyTimeout)) {
     bool was_poisoned = poisoned_;
     Close();
@@ -1011,6 +1052,21 @@ bool Connection::OpenInternal(const std::string& file_name,
   return true;
 }
 
+bool Connection::CheckpointWAL() {
+  AssertIOAllowed();
+  if (!db_) {
+    DLOG_IF(FATAL, !poisoned_) << "Illegal use of connection without a db";
+    return false;
+  }
+  DCHECK(wal_mode_);
+
+  int rc = sqlite3_wal_checkpoint_v2(db_, NULL, SQLITE_CHECKPOINT_PASSIVE,
+                                     NULL, NULL);
+  if (rc != SQLITE_OK)
+    rc = OnSqliteError(rc, NULL, "PRAGMA wal_checkpoint");
+  return rc == SQLITE_OK;
+}
+
 void Connection::DoRollback() {
   Statement rollback(GetCachedStatement(SQL_FROM_HERE, "ROLLBACK"));
   rollback.Run();
@@ -117,6 +117,36 @@ class SQL_EXPORT Connection {
   // This must be called before Open() to have an effect.
   void set_exclusive_locking() { exclusive_locking_ = true; }
 
+  // Call to journal the database with a write-ahead log instead of the
+  // default rollback journal.  Commits then append to the -wal file instead
+  // of rewriting pages of the database and its journal, and only sync the
+  // log at checkpoints, which copy the log back into the database.  This
+  // makes frequent small transactions much cheaper, at the cost of possibly
+  // losing the last transactions (but not consistency) on power loss.
+  //
+  // This must be called before Open() to have an effect, and has none on
+  // in-memory databases.
+  void set_wal_mode() { wal_mode_ = true; }
+
+  // Sets the number of pages the write-ahead log may hold before a commit
+  // checkpoints it.  0 disables automatic checkpoints, in which case the
+  // caller is responsible for calling CheckpointWAL() periodically.  Without
+  // a call SQLite's default of 1000 pages is used.
+  //
+  // This must be called before Open() to have an effect, and only has one
+  // with set_wal_mode().
+  void set_wal_autocheckpoint(int pages) { wal_autocheckpoint_ = pages; }
+
+  // Sets the number of bytes of the database file SQLite may read through a
+  // memory mapping instead of read() calls, which saves copying pages into
+  // the page cache.  An I/O error on a mapped page faults instead of
+  // returning an error, so only opt in databases which are not expected to
+  // live on unreliable storage.  SQLite versions without memory-mapped I/O
+  // ignore the setting.
+  //
+  // This must be called before Open() to have an effect.
+  void set_mmap_size(int64 mmap_size) { mmap_size_ = mmap_size; }
+
   // Call to cause Open() to restrict access permissions of the
   // database file to only the owner.
   // TODO(shess): Currently only supported on OS_POSIX, is a noop on
@@ -200,6 +230,12 @@ class SQL_EXPORT Connection {
   // everything else.
   void Preload();
 
+  // Copies as much of the write-ahead log into the database as is possible
+  // without waiting for readers, so that the log can be reused from its
+  // start.  Returns false on error.  It is an error to call this on a
+  // database not in WAL mode (see set_wal_mode()).
+  bool CheckpointWAL() WARN_UNUSED_RESULT;
+
   // Try to trim the cache memory used by the database.  If |aggressively| is
   // true, this function will try to free all of the cache memory it can. If
   // |aggressively| is false, this function will try to cut cache memory
@@ -557,6 +593,10 @@ class SQL_EXPORT Connection {
   int cache_size_;
   bool exclusive_locking_;
   bool restrict_to_user_;
+  bool wal_mode_;
+  // Negative means the SQLite default.
+  int wal_autocheckpoint_;
+  int64 mmap_size_;
 
   // All cached statements. Keeping a reference to these statements means that
   // they'll remain active.
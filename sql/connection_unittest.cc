@@ -663,6 +663,71 @@ TEST_F(SQLConnectionTest, Delete) {
   EXPECT_FALSE(base::PathExists(journal));
 }
 
+TEST_F(SQLConnectionTest, WALMode) {
+  db().Close();
+  sql::Connection::Delete(db_path());
+
+  sql::Connection db;
+  db.set_wal_mode();
+  // Leave checkpoints to CheckpointWAL().
+  db.set_wal_autocheckpoint(0);
+  ASSERT_TRUE(db.Open(db_path()));
+  {
+    sql::Statement s(db.GetUniqueStatement("PRAGMA journal_mode"));
+    ASSERT_TRUE(s.Step());
+    EXPECT_EQ("wal", s.ColumnString(0));
+  }
+
+  ASSERT_TRUE(db.Execute("CREATE TABLE x (x)"));
+  ASSERT_TRUE(db.Execute("INSERT INTO x VALUES (1)"));
+  base::FilePath wal(db_path().value() + FILE_PATH_LITERAL("-wal"));
+  EXPECT_TRUE(base::PathExists(wal));
+  EXPECT_TRUE(db.CheckpointWAL());
+
+  // The data survives reopening the database.
+  db.Close();
+  ASSERT_TRUE(db.Open(db_path()));
+  {
+    sql::Statement s(db.GetUniqueStatement("SELECT COUNT(*) FROM x"));
+    ASSERT_TRUE(s.Step());
+    EXPECT_EQ(1, s.ColumnInt(0));
+  }
+  db.Close();
+
+  sql::Connection::Delete(db_path());
+  EXPECT_FALSE(base::PathExists(db_path()));
+  EXPECT_FALSE(base::PathExists(wal));
+}
+
+// Memory-mapped I/O is only a hint, so opening and using the database must
+// work whether or not SQLite supports it.
+TEST_F(SQLConnectionTest, MmapSize) {
+  db().Close();
+  sql::Connection::Delete(db_path());
+
+  sql::Connection db;
+  db.set_mmap_size(256 * 1024 * 1024);
+  ASSERT_TRUE(db.Open(db_path()));
+  ASSERT_TRUE(db.Execute("CREATE TABLE x (x)"));
+  ASSERT_TRUE(db.Execute("INSERT INTO x VALUES (1)"));
+  db.Close();
+
+  ASSERT_TRUE(db.Open(db_path()));
+  sql::Statement s(db.GetUniqueStatement("SELECT COUNT(*) FROM x"));
+  ASSERT_TRUE(s.Step());
+  EXPECT_EQ(1, s.ColumnInt(0));
+}
+
+// Asking for WAL on an in-memory database keeps the default journal.
+TEST_F(SQLConnectionTest, WALModeInMemory) {
+  sql::Connection db;
+  db.set_wal_mode();
+  ASSERT_TRUE(db.OpenInMemory());
+  sql::Statement s(db.GetUniqueStatement("PRAGMA journal_mode"));
+  ASSERT_TRUE(s.Step());
+  EXPECT_EQ("memory", s.ColumnString(0));
+}
+
 #if defined(OS_POSIX)
 // Test that set_restrict_to_user() trims database permissions so that
 // only the owner (and root) can read.
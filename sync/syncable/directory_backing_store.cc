@@ -6,6 +6,8 @@
 
 #include "build/build_config.h"
 
+#include <string.h>
+
 #include <limits>
 
 #include "base/base64.h"
@@ -60,13 +62,14 @@ void BindFields(const EntryKernel& entry,
   for ( ; i < STRING_FIELDS_END; ++i) {
     statement->BindString(index++, entry.ref(static_cast<StringField>(i)));
   }
+  // The blobs are copied by BindBlob, so one buffer serves all the proto
+  // columns.
+  std::string temp;
   for ( ; i < PROTO_FIELDS_END; ++i) {
-    std::string temp;
     entry.ref(static_cast<ProtoField>(i)).SerializeToString(&temp);
     statement->BindBlob(index++, temp.data(), temp.length());
   }
   for ( ; i < UNIQUE_POSITION_FIELDS_END; ++i) {
-    std::string temp;
     entry.ref(static_cast<UniquePositionField>(i)).SerializeToString(&temp);
     statement->BindBlob(index++, temp.data(), temp.length());
   }
@@ -98,8 +101,25 @@ scoped_ptr<EntryKernel> UnpackEntry(sql::Statement* statement) {
                 statement->ColumnString(i));
   }
   for ( ; i < PROTO_FIELDS_END; ++i) {
-    kernel->mutable_ref(static_cast<ProtoField>(i)).ParseFromArray(
-        statement->ColumnBlob(i), statement->ColumnByteLength(i));
+    // Synced entries usually have the same specifics in several columns;
+    // copying an already parsed one is much cheaper than parsing it again.
+    const void* blob = statement->ColumnBlob(i);
+    int length = statement->ColumnByteLength(i);
+    int same = PROTO_FIELDS_BEGIN;
+    for ( ; same < i; ++same) {
+      if (statement->ColumnByteLength(same) == length &&
+          (length == 0 ||
+           memcmp(statement->ColumnBlob(same), blob, length) == 0)) {
+        break;
+      }
+    }
+    if (same < i) {
+      kernel->mutable_ref(static_cast<ProtoField>(i)).CopyFrom(
+          kernel->ref(static_cast<ProtoField>(same)));
+    } else {
+      kernel->mutable_ref(static_cast<ProtoField>(i)).ParseFromArray(
+          blob, length);
+    }
   }
   for ( ; i < UNIQUE_POSITION_FIELDS_END; ++i) {
     std::string temp;
@@ -1544,6 +1544,59 @@ TEST_F(SyncableDirectoryTest, PositionWithNullSurvivesSaveAndReload) {
   }
 }
 
+// Specifics columns that hold the same blob are copied rather than parsed
+// on load; make sure each of them still comes back with its own value.
+TEST_F(SyncableDirectoryTest, SharedSpecificsSurviveSaveAndReload) {
+  TestIdFactory id_factory;
+  sync_pb::EntitySpecifics specifics;
+  specifics.mutable_bookmark()->set_url("http://www.google.com/");
+  sync_pb::EntitySpecifics other_specifics;
+  other_specifics.mutable_bookmark()->set_url("http://www.example.com/");
+  Id same_id;
+  Id different_id;
+
+  {
+    WriteTransaction trans(FROM_HERE, UNITTEST, dir_.get());
+
+    MutableEntry same(&trans, CREATE, BOOKMARKS, id_factory.root(), "same");
+    same.PutIsUnsynced(true);
+    same.PutSpecifics(specifics);
+    same.PutServerSpecifics(specifics);
+    same.PutBaseServerSpecifics(specifics);
+    same_id = same.GetId();
+
+    MutableEntry different(
+        &trans, CREATE, BOOKMARKS, id_factory.root(), "different");
+    different.PutIsUnsynced(true);
+    different.PutSpecifics(specifics);
+    different.PutServerSpecifics(other_specifics);
+    different.PutBaseServerSpecifics(specifics);
+    different_id = different.GetId();
+  }
+
+  EXPECT_EQ(OPENED, SimulateSaveAndReloadDir());
+
+  {
+    ReadTransaction trans(FROM_HERE, dir_.get());
+
+    Entry same(&trans, GET_BY_ID, same_id);
+    EXPECT_EQ(specifics.SerializeAsString(),
+              same.GetSpecifics().SerializeAsString());
+    EXPECT_EQ(specifics.SerializeAsString(),
+              same.GetServerSpecifics().SerializeAsString());
+    EXPECT_EQ(specifics.SerializeAsString(),
+              same.GetBaseServerSpecifics().SerializeAsString());
+
+    Entry different(&trans, GET_BY_ID, different_id);
+    EXPECT_EQ(specifics.SerializeAsString(),
+              different.GetSpecifics().SerializeAsString());
+    EXPECT_EQ(other_specifics.SerializeAsString(),
+              different.GetServerSpecifics().SerializeAsString());
+    EXPECT_EQ(specifics.SerializeAsString(),
+              different.GetBaseServerSpecifics().SerializeAsString());
+  }
+}
+
 // An OnDirectoryBackingStore that can be set to always fail SaveChanges.
 class TestBackingStore : public OnDiskDirectoryBackingStore {
  public:
@@ -6,9 +6,15 @@
 
 #include <stdio.h>
 
+#include <algorithm>
+#include <cmath>
+
+#include "base/basictypes.h"
+#include "base/callback.h"
 #include "base/logging.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/stringprintf.h"
+#include "base/time/time.h"
 
 namespace {
 
@@ -43,6 +49,14 @@ void PrintResultsImpl(const std::string& measurement,
   fflush(stdout);
 }
 
+// Returns the |percentile|th percentile of |sorted_values| using the
+// nearest-rank method.
+double Percentile(const std::vector<double>& sorted_values, int percentile) {
+  size_t rank = static_cast<size_t>(
+      std::ceil(percentile / 100.0 * sorted_values.size()));
+  return sorted_values[std::max<size_t>(rank, 1) - 1];
+}
+
 }  // namespace
 
 namespace perf_test {
@@ -172,6 +186,52 @@ void AppendResultList(std::string& output,
                             "[", "]", units, important);
 }
 
+void PrintResultSummary(const std::string& measurement,
+                        const std::string& modifier,
+                        const std::string& trace,
+                        const std::vector<double>& values,
+                        const std::string& units,
+                        bool important) {
+  CHECK(!values.empty());
+
+  double sum = 0;
+  for (size_t i = 0; i < values.size(); ++i)
+    sum += values[i];
+  const double mean = sum / values.size();
+  double sum_of_squares = 0;
+  for (size_t i = 0; i < values.size(); ++i)
+    sum_of_squares += (values[i] - mean) * (values[i] - mean);
+  const double std_dev = std::sqrt(sum_of_squares / values.size());
+  PrintResultMeanAndError(measurement, modifier, trace,
+                          base::StringPrintf("%f,%f", mean, std_dev),
+                          units, important);
+
+  std::vector<double> sorted_values(values);
+  std::sort(sorted_values.begin(), sorted_values.end());
+  const int kPercentiles[] = { 50, 90, 99 };
+  for (size_t i = 0; i < arraysize(kPercentiles); ++i) {
+    PrintResult(measurement,
+                base::StringPrintf("%s_p%d", modifier.c_str(),
+                                   kPercentiles[i]),
+                trace, Percentile(sorted_values, kPercentiles[i]), units,
+                false);
+  }
+}
+
+void MeasureRepeatedly(const base::Closure& task,
+                       int warmup_runs,
+                       int runs,
+                       std::vector<double>* durations_ms) {
+  for (int i = 0; i < warmup_runs; ++i)
+    task.Run();
+  for (int i = 0; i < runs; ++i) {
+    base::TimeTicks start = base::TimeTicks::HighResNow();
+    task.Run();
+    durations_ms->push_back(
+        (base::TimeTicks::HighResNow() - start).InMillisecondsF());
+  }
+}
+
 void PrintSystemCommitCharge(const std::string& test_name,
                              size_t charge,
                              bool important) {
@@ -6,6 +6,9 @@
 #define TESTING_PERF_PERF_TEST_H_
 
 #include <string>
+#include <vector>
+
+#include "base/callback_forward.h"
 
 namespace perf_test {
 
@@ -97,6 +100,27 @@ void AppendResultList(std::string& output,
                       const std::string& units,
                       bool important);
 
+// Like PrintResultMeanAndError(), but computes the mean and standard
+// deviation of |values| itself. Also prints the 50th, 90th and 99th
+// percentiles of |values| as the "_p50", "_p90" and "_p99" graphs of
+// |measurement| + |modifier|, which show tail latency that the mean hides.
+// |values| must not be empty.
+void PrintResultSummary(const std::string& measurement,
+                        const std::string& modifier,
+                        const std::string& trace,
+                        const std::vector<double>& values,
+                        const std::string& units,
+                        bool important);
+
+// Runs |task| |warmup_runs| times without timing it, so that caches and lazy
+// initialization don't skew the results, then |runs| more times. Appends the
+// duration of each timed run in milliseconds to |durations_ms|, ready for
+// PrintResultSummary().
+void MeasureRepeatedly(const base::Closure& task,
+                       int warmup_runs,
+                       int runs,
+                       std::vector<double>* durations_ms);
+
 // Prints memory commit charge stats for use by perf graphs.
 void PrintSystemCommitCharge(const std::string& test_name,
                              size_t charge,
@@ -93,6 +93,17 @@ typedef int (*StackGeneratorFunction)(int skip_count, void** stack);
 PERFTOOLS_DLL_DECL void HeapProfilerWithPseudoStackStart(
     StackGeneratorFunction callback);
 
+/* Like HeapProfilerWithPseudoStackStart(), but only records a sample of the
+ * allocations: on average one every |sampling_interval| bytes allocated, as a
+ * Poisson process over the allocated bytes. Each sampled allocation is
+ * recorded with its size scaled up so that the in-use byte totals of the
+ * profile are unbiased estimates of the real ones, while the allocation
+ * counts are the number of samples. A |sampling_interval| of zero records
+ * every allocation.
+ */
+PERFTOOLS_DLL_DECL void HeapProfilerWithPseudoStackStartSampled(
+    StackGeneratorFunction callback, size_t sampling_interval);
+
 /* Returns non-zero if we are currently profiling the heap.  (Returns
  * an int rather than a bool so it's usable from C.)  This is true
  * between calls to HeapProfilerStart() and HeapProfilerStop(), and
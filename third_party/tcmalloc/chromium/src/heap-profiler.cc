@@ -50,6 +50,7 @@
 #endif
 #include <errno.h>
 #include <assert.h>
+#include <math.h>     // for log()
 #include <sys/types.h>
 
 #include <algorithm>
@@ -227,6 +228,12 @@ static DeepHeapProfile* deep_profile = NULL;  // deep memory profiler
 static StackGeneratorFunction stack_generator_function =
     HeapProfileTable::GetCallerStackTrace;
 
+// If non-zero, only a sample of the allocations is recorded, on average one
+// every |sampling_interval| bytes allocated.
+static size_t sampling_interval = 0;
+static int64 bytes_until_sample = 0;  // Countdown to the next sample
+static uint64 sampling_rnd = 0;       // State of the sampling PRNG
+
 //----------------------------------------------------------------------
 // Profile generation
 //----------------------------------------------------------------------
@@ -375,6 +382,40 @@ static void MaybeDumpProfileLocked() {
   }
 }
 
+// Returns the number of bytes to allocate until the next sample, drawn from
+// an exponential distribution with mean |sampling_interval| so that the
+// samples form a Poisson process over the allocated bytes.
+static int64 PickNextSamplingPointLocked() {
+  // The same 48-bit linear congruential generator as drand48().
+  const uint64 kPrngMult = 0x5DEECE66DULL;
+  const uint64 kPrngAdd = 0xB;
+  const uint64 kPrngModMask = (static_cast<uint64>(1) << 48) - 1;
+  sampling_rnd = (kPrngMult * sampling_rnd + kPrngAdd) & kPrngModMask;
+  // Take the top 26 bits to get a uniform value in (0, 1].
+  const double q = static_cast<double>((sampling_rnd >> 22) + 1) / (1 << 26);
+  return static_cast<int64>(-log(q) * sampling_interval) + 1;
+}
+
+// Returns true if an allocation of |bytes| is to be recorded, and sets
+// |recorded_bytes| to the size to record it with. An allocation of |bytes|
+// is sampled with a probability of 1 - exp(-bytes / sampling_interval), so
+// its size is scaled by the inverse of that.
+static bool ShouldSampleAllocation(size_t bytes, size_t* recorded_bytes) {
+  SpinLockHolder l(&heap_lock);
+  if (sampling_interval == 0) {
+    *recorded_bytes = bytes;
+    return true;
+  }
+  bytes_until_sample -= bytes;
+  if (bytes_until_sample > 0)
+    return false;
+  bytes_until_sample = PickNextSamplingPointLocked();
+  const double probability =
+      1 - exp(-static_cast<double>(bytes) / sampling_interval);
+  *recorded_bytes = static_cast<size_t>(bytes / probability);
+  return true;
+}
+
 // Record an allocation in the profile.
 static void RecordAlloc(const void* ptr, size_t bytes, int skip_count) {
   // Take the stack trace outside the critical section.
@@ -402,7 +443,9 @@ static void RecordFree(const void* ptr) {
 
 // static
 void NewHook(const void* ptr, size_t size) {
-  if (ptr != NULL) RecordAlloc(ptr, size, 0);
+  size_t recorded_size;
+  if (ptr != NULL && ShouldSampleAllocation(size, &recorded_size))
+    RecordAlloc(ptr, recorded_size, 0);
 }
 
 // static
@@ -567,6 +610,19 @@ extern "C" void HeapProfilerWithPseudoStackStart(
   HeapProfilerStart(NULL);
 }
 
+extern "C" void HeapProfilerWithPseudoStackStartSampled(
+    StackGeneratorFunction callback, size_t interval) {
+  {
+    // Ensure the sampling state is set before allocations can be recorded.
+    SpinLockHolder l(&heap_lock);
+    sampling_interval = interval;
+    sampling_rnd = static_cast<uint64>(getpid());
+    if (interval > 0)
+      bytes_until_sample = PickNextSamplingPointLocked();
+  }
+  HeapProfilerWithPseudoStackStart(callback);
+}
+
 extern "C" void IterateAllocatedObjects(AddressVisitor visitor, void* data) {
   SpinLockHolder l(&heap_lock);
 
@@ -625,6 +681,7 @@ extern "C" void HeapProfilerStop() {
     MemoryRegionMap::Shutdown();
   }
 
+  sampling_interval = 0;
   is_on = false;
 }
 
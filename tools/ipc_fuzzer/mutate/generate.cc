@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "base/command_line.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/pickle.h"
 #include "base/strings/string_util.h"
 #include "base/strings/string_number_conversions.h"
@@ -443,6 +444,18 @@ struct GenerateTraits<base::FileDescriptor> {
   }
 };
 
+template <>
+struct GenerateTraits<scoped_refptr<base::RefCountedMemory> > {
+  static bool Generate(scoped_refptr<base::RefCountedMemory>* p,
+                       Generator* generator) {
+    std::vector<unsigned char> bytes;
+    if (!GenerateParam(&bytes, generator))
+      return false;
+    *p = base::RefCountedBytes::TakeVector(&bytes);
+    return true;
+  }
+};
+
 template <>
 struct GenerateTraits<base::FilePath> {
   static bool Generate(base::FilePath* p, Generator* generator) {
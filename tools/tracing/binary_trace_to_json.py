@@ -0,0 +1,204 @@
+#!/usr/bin/env python
+# Copyright 2014 The Chromium Authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+"""Converts a binary trace to the JSON trace format.
+
+Binary traces are written by base::debug::TraceEventBinaryWriter, see
+base/debug/trace_event_binary.h for the format, when tracing with the
+TraceLog::BINARY_OUTPUT option.  The output can be loaded in about:tracing.
+
+Usage: binary_trace_to_json.py <binary trace> [<json output>]
+"""
+
+import json
+import struct
+import sys
+
+MAGIC = b'CrTB'
+VERSION = 1
+
+RECORD_STRING = 1
+RECORD_EVENT = 2
+RECORD_SYSTEM_TRACE = 3
+
+FIELD_THREAD_TIMESTAMP = 1 << 0
+FIELD_DURATION = 1 << 1
+FIELD_THREAD_DURATION = 1 << 2
+FIELD_ID = 1 << 3
+
+# From base/debug/trace_event.h.
+TRACE_VALUE_TYPE_BOOL = 1
+TRACE_VALUE_TYPE_UINT = 2
+TRACE_VALUE_TYPE_INT = 3
+TRACE_VALUE_TYPE_DOUBLE = 4
+TRACE_VALUE_TYPE_POINTER = 5
+TRACE_VALUE_TYPE_STRING = 6
+TRACE_VALUE_TYPE_COPY_STRING = 7
+TRACE_VALUE_TYPE_CONVERTABLE = 8
+TRACE_EVENT_FLAG_SCOPE_MASK = 3 << 3
+SCOPE_NAMES = {0 << 3: 'g', 1 << 3: 'p', 2 << 3: 't'}
+
+
+class TraceFormatError(Exception):
+  pass
+
+
+class Reader(object):
+  def __init__(self, data, pos=0, end=None):
+    self._data = data
+    self.pos = pos
+    self.end = len(data) if end is None else end
+
+  def ReadByte(self):
+    if self.pos >= self.end:
+      raise TraceFormatError('Truncated record at %d' % self.pos)
+    value = bytearray(self._data[self.pos:self.pos + 1])[0]
+    self.pos += 1
+    return value
+
+  def ReadBytes(self, length):
+    if length > self.end - self.pos:
+      raise TraceFormatError('Truncated string at %d' % self.pos)
+    value = self._data[self.pos:self.pos + length]
+    self.pos += length
+    return value
+
+  def ReadVarint(self):
+    value = 0
+    shift = 0
+    while True:
+      byte = self.ReadByte()
+      value |= (byte & 0x7f) << shift
+      if not byte & 0x80:
+        return value
+      shift += 7
+
+  def ReadSignedVarint(self):
+    value = self.ReadVarint()
+    return (value >> 1) ^ -(value & 1)
+
+  def ReadString(self):
+    return self.ReadBytes(self.ReadVarint()).decode('utf-8', 'replace')
+
+
+def ReadArgValue(reader, arg_type):
+  if arg_type == TRACE_VALUE_TYPE_BOOL:
+    return bool(reader.ReadByte())
+  if arg_type == TRACE_VALUE_TYPE_UINT:
+    return reader.ReadVarint()
+  if arg_type == TRACE_VALUE_TYPE_INT:
+    return reader.ReadSignedVarint()
+  if arg_type == TRACE_VALUE_TYPE_DOUBLE:
+    value = struct.unpack('<d', reader.ReadBytes(8))[0]
+    # Like TraceEvent::AppendValueAsJSON().
+    if value != value:
+      return 'NaN'
+    if value in (float('inf'), float('-inf')):
+      return 'Infinity' if value > 0 else '-Infinity'
+    return value
+  if arg_type == TRACE_VALUE_TYPE_POINTER:
+    return '0x%x' % reader.ReadVarint()
+  if arg_type in (TRACE_VALUE_TYPE_STRING, TRACE_VALUE_TYPE_COPY_STRING):
+    return reader.ReadString()
+  if arg_type == TRACE_VALUE_TYPE_CONVERTABLE:
+    return json.loads(reader.ReadString())
+  raise TraceFormatError('Unknown argument type %d' % arg_type)
+
+
+def ReadEvent(reader, pid, strings, last_timestamp):
+  phase = chr(reader.ReadByte())
+  flags = reader.ReadByte()
+  fields = reader.ReadByte()
+  event = {
+    'cat': strings[reader.ReadVarint()],
+    'name': strings[reader.ReadVarint()],
+    'pid': pid,
+    'tid': reader.ReadSignedVarint(),
+    'ts': last_timestamp + reader.ReadSignedVarint(),
+    'ph': phase,
+  }
+  if fields & FIELD_THREAD_TIMESTAMP:
+    event['tts'] = reader.ReadSignedVarint()
+  if fields & FIELD_DURATION:
+    event['dur'] = reader.ReadSignedVarint()
+  if fields & FIELD_THREAD_DURATION:
+    event['tdur'] = reader.ReadSignedVarint()
+  if fields & FIELD_ID:
+    event['id'] = '0x%x' % reader.ReadVarint()
+  if phase == 'i':
+    event['s'] = SCOPE_NAMES.get(flags & TRACE_EVENT_FLAG_SCOPE_MASK, '?')
+
+  args = {}
+  for _ in range(reader.ReadByte()):
+    name = strings[reader.ReadVarint()]
+    args[name] = ReadArgValue(reader, reader.ReadByte())
+  event['args'] = args
+  return event
+
+
+def ReadSegment(data, pos, events, system_traces):
+  """Decodes the segment at |pos| and returns the position after it."""
+  if data[pos:pos + len(MAGIC)] != MAGIC:
+    raise TraceFormatError('Bad segment magic at %d' % pos)
+  header = Reader(data, pos + len(MAGIC))
+  version = header.ReadVarint()
+  if version != VERSION:
+    raise TraceFormatError('Unsupported version %d' % version)
+  pid = header.ReadSignedVarint()
+  size = header.ReadVarint()
+  if size > len(data) - header.pos:
+    raise TraceFormatError('Truncated segment at %d' % pos)
+
+  reader = Reader(data, header.pos, header.pos + size)
+  strings = []
+  timestamp = 0
+  while reader.pos < reader.end:
+    record_type = reader.ReadByte()
+    if record_type == RECORD_STRING:
+      strings.append(reader.ReadString())
+    elif record_type == RECORD_EVENT:
+      event = ReadEvent(reader, pid, strings, timestamp)
+      timestamp = event['ts']
+      events.append(event)
+    elif record_type == RECORD_SYSTEM_TRACE:
+      system_traces.append(reader.ReadString())
+    else:
+      raise TraceFormatError('Unknown record type %d' % record_type)
+  return reader.end
+
+
+def ConvertToJSON(data):
+  events = []
+  system_traces = []
+  pos = 0
+  while pos < len(data):
+    pos = ReadSegment(data, pos, events, system_traces)
+  result = {'traceEvents': events}
+  if system_traces:
+    result['systemTraceEvents'] = ''.join(system_traces)
+  return json.dumps(result)
+
+
+def main(argv):
+  if len(argv) not in (2, 3):
+    sys.stderr.write(__doc__)
+    return 1
+  with open(argv[1], 'rb') as f:
+    data = f.read()
+  try:
+    output = ConvertToJSON(data)
+  except TraceFormatError as e:
+    sys.stderr.write('%s: %s\n' % (argv[1], e))
+    return 1
+  if len(argv) == 3:
+    with open(argv[2], 'w') as f:
+      f.write(output)
+  else:
+    sys.stdout.write(output)
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main(sys.argv))
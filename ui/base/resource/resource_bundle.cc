@@ -32,6 +32,7 @@
 #include "ui/gfx/image/image_skia_source.h"
 #include "ui/gfx/safe_integer_conversions.h"
 #include "ui/gfx/screen.h"
+#include "ui/gfx/size.h"
 #include "ui/gfx/size_conversions.h"
 #include "ui/gfx/skbitmap_operations.h"
 
@@ -61,11 +62,35 @@ const int kLargeFontSizeDelta = 8;
 // PNG-related constants.
 const unsigned char kPngMagic[8] = { 0x89, 'P', 'N', 'G', 13, 10, 26, 10 };
 const size_t kPngChunkMetadataSize = 12;  // length, type, crc32
+const unsigned char kPngIHDRChunkType[4] = { 'I', 'H', 'D', 'R' };
 const unsigned char kPngScaleChunkType[4] = { 'c', 's', 'C', 'l' };
 const unsigned char kPngDataChunkType[4] = { 'I', 'D', 'A', 'T' };
 
 ResourceBundle* g_shared_instance_ = NULL;
 
+// Reads the size of the PNG in |buf| from its IHDR chunk, which is always the
+// first one. Returns false if |buf| does not start like a PNG.
+bool GetPNGSize(const unsigned char* buf, size_t size, gfx::Size* image_size) {
+  const size_t kIHDRTypeOffset = arraysize(kPngMagic) + sizeof(uint32);
+  const size_t kIHDRDataOffset = kIHDRTypeOffset + arraysize(kPngIHDRChunkType);
+  if (size < kIHDRDataOffset + 2 * sizeof(uint32) ||
+      memcmp(buf, kPngMagic, arraysize(kPngMagic)) != 0 ||
+      memcmp(buf + kIHDRTypeOffset, kPngIHDRChunkType,
+             arraysize(kPngIHDRChunkType)) != 0) {
+    return false;
+  }
+  uint32 width = 0;
+  uint32 height = 0;
+  const char* data = reinterpret_cast<const char*>(buf + kIHDRDataOffset);
+  net::ReadBigEndian(data, &width);
+  net::ReadBigEndian(data + sizeof(uint32), &height);
+  // PNG limits both to 2^31 - 1.
+  if (width == 0 || height == 0 || width > kint32max || height > kint32max)
+    return false;
+  image_size->SetSize(static_cast<int>(width), static_cast<int>(height));
+  return true;
+}
+
 void InitDefaultFontList() {
 #if defined(OS_CHROMEOS)
   ResourceBundle& rb = ResourceBundle::GetSharedInstance();
@@ -357,14 +382,25 @@ gfx::Image& ResourceBundle::GetImageNamed(int resource_id) {
     ui::ScaleFactor scale_factor_to_load = ui::SCALE_FACTOR_100P;
 #endif
 
-    float scale = GetImageScale(scale_factor_to_load);
-    // TODO(oshima): Consider reading the image size from png IHDR chunk and
-    // skip decoding here and remove #ifdef below.
     // ResourceBundle::GetSharedInstance() is destroyed after the
     // BrowserMainLoop has finished running. |image_skia| is guaranteed to be
     // destroyed before the resource bundle is destroyed.
-    gfx::ImageSkia image_skia(new ResourceBundleImageSource(this, resource_id),
-                              scale);
+    gfx::ImageSkia image_skia;
+    gfx::Size size;
+    if (scale_factor_to_load == ui::SCALE_FACTOR_100P &&
+        GetPNGSizeAt1x(resource_id, &size)) {
+      // The size is known from the PNG header, so decoding waits until the
+      // image is first drawn. Many images are requested long before that, or
+      // are never drawn at all.
+      image_skia = gfx::ImageSkia(
+          new ResourceBundleImageSource(this, resource_id), size);
+    } else {
+      // TODO(oshima): Read the size of images at other scales from their
+      // header too and remove the #ifdef above.
+      float scale = GetImageScale(scale_factor_to_load);
+      image_skia = gfx::ImageSkia(
+          new ResourceBundleImageSource(this, resource_id), scale);
+    }
     if (image_skia.isNull()) {
       LOG(WARNING) << "Unable to load image with id " << resource_id;
       NOTREACHED();  // Want to assert in debug mode.
@@ -741,6 +777,22 @@ bool ResourceBundle::LoadBitmap(int resource_id,
   return false;
 }
 
+bool ResourceBundle::GetPNGSizeAt1x(int resource_id, gfx::Size* size) const {
+  // Look the data up the same way LoadBitmap() does for SCALE_FACTOR_100P.
+  for (size_t i = 0; i < data_packs_.size(); ++i) {
+    ScaleFactor pack_scale_factor = data_packs_[i]->GetScaleFactor();
+    if (pack_scale_factor != ui::SCALE_FACTOR_NONE &&
+        pack_scale_factor != ui::SCALE_FACTOR_100P) {
+      continue;
+    }
+    scoped_refptr<base::RefCountedMemory> memory(
+        data_packs_[i]->GetStaticMemory(resource_id));
+    if (memory.get())
+      return GetPNGSize(memory->front(), memory->size(), size);
+  }
+  return false;
+}
+
 gfx::Image& ResourceBundle::GetEmptyImage() {
   base::AutoLock lock(*images_and_fonts_lock_);
 
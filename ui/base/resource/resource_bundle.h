@@ -30,6 +30,10 @@ class Lock;
 class RefCountedStaticMemory;
 }
 
+namespace gfx {
+class Size;
+}
+
 namespace ui {
 
 class DataPack;
@@ -330,6 +334,10 @@ class UI_BASE_EXPORT ResourceBundle {
                   SkBitmap* bitmap,
                   bool* fell_back_to_1x) const;
 
+  // Returns true and sets |size| to the size of the 1x image |resource_id| if
+  // it is a PNG, whose size can be read without decoding it.
+  bool GetPNGSizeAt1x(int resource_id, gfx::Size* size) const;
+
   // Returns true if missing scaled resources should be visually indicated when
   // drawing the fallback (e.g., by tinting the image).
   static bool ShouldHighlightMissingScaledResources();
@@ -465,6 +465,10 @@ TEST_F(ResourceBundleImageTest, GetImageNamed) {
   EXPECT_EQ(ui::SCALE_FACTOR_200P,
             GetSupportedScaleFactor(image_skia->image_reps()[0].scale()));
 #else
+  // The 1x image is decoded the first time it is used.
+  EXPECT_TRUE(image_skia->image_reps().empty());
+  EXPECT_EQ(10, image_skia->width());
+  image_skia->GetRepresentation(GetImageScale(ui::SCALE_FACTOR_100P));
   EXPECT_EQ(ui::SCALE_FACTOR_100P,
             GetSupportedScaleFactor(image_skia->image_reps()[0].scale()));
 #endif
@@ -579,6 +583,9 @@ TEST_F(ResourceBundleImageTest, MAYBE_FallbackToNone) {
   resource_bundle->AddDataPackFromPath(data_default_path, SCALE_FACTOR_NONE);
 
   gfx::ImageSkia* image_skia = resource_bundle->GetImageSkiaNamed(3);
+  EXPECT_TRUE(image_skia->image_reps().empty());
+  EXPECT_EQ(gfx::Size(10, 10), image_skia->size());
+  image_skia->GetRepresentation(GetImageScale(ui::SCALE_FACTOR_100P));
   EXPECT_EQ(1u, image_skia->image_reps().size());
   EXPECT_EQ(ui::SCALE_FACTOR_100P,
             GetSupportedScaleFactor(image_skia->image_reps()[0].scale()));
@@ -281,7 +281,9 @@ void Compositor::Initialize() {
 #endif
   if (use_thread) {
     g_compositor_thread = new base::Thread("Browser Compositor");
-    g_compositor_thread->Start();
+    base::Thread::Options options;
+    options.priority = base::kThreadPriority_Display;
+    g_compositor_thread->StartWithOptions(options);
   }
 
   DCHECK(!g_compositor_initialized) << "Compositor initialized twice.";
@@ -7,6 +7,7 @@
 #include "base/debug/trace_event.h"
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/time/time.h"
 #include "cc/animation/animation_id_provider.h"
 #include "cc/output/begin_frame_args.h"
 #include "ui/compositor/compositor.h"
@@ -36,7 +37,10 @@ class LayerAnimator;
 namespace {
 
 const int kDefaultTransitionDurationMs = 120;
-const int kTimerIntervalMs = 10;
+// Step at the display refresh rate. Stepping faster only produces property
+// updates that the compositor coalesces into the same frame, at the cost of
+// extra UI thread wakeups.
+const int kStepsPerSecond = 60;
 
 // Returns the AnimationContainer we're added to.
 gfx::AnimationContainer* GetAnimationContainer() {
@@ -401,7 +405,8 @@ void LayerAnimator::SetStartTime(base::TimeTicks start_time) {
 }
 
 base::TimeDelta LayerAnimator::GetTimerInterval() const {
-  return base::TimeDelta::FromMilliseconds(kTimerIntervalMs);
+  return base::TimeDelta::FromMicroseconds(
+      base::Time::kMicrosecondsPerSecond / kStepsPerSecond);
 }
 
 void LayerAnimator::StopAnimatingInternal(bool abort) {
@@ -95,17 +95,19 @@ void EventTarget::OnGestureEvent(GestureEvent* event) {
 }
 
 void EventTarget::GetPreTargetHandlers(EventHandlerList* list) {
+  // This runs for every event, including each mouse move. Inserting every
+  // handler at the front is quadratic in the depth of the hierarchy, so the
+  // chain is appended innermost first and reversed once instead.
+  const size_t old_size = list->size();
   EventTarget* target = this;
   while (target) {
-    EventHandlerList::reverse_iterator it, rend;
-    for (it = target->pre_target_list_.rbegin(),
-            rend = target->pre_target_list_.rend();
-        it != rend;
-        ++it) {
-      list->insert(list->begin(), *it);
-    }
+    list->insert(list->end(),
+                 target->pre_target_list_.rbegin(),
+                 target->pre_target_list_.rend());
     target = target->GetParentTarget();
   }
+  std::reverse(list->begin() + old_size, list->end());
+  std::rotate(list->begin(), list->begin() + old_size, list->end());
 }
 
 void EventTarget::GetPostTargetHandlers(EventHandlerList* list) {
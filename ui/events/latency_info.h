@@ -42,6 +42,9 @@ enum LatencyComponentType {
   // Frame number when a window snapshot was requested. The snapshot
   // is taken when the rendering results actually reach the screen.
   WINDOW_SNAPSHOT_FRAME_NUMBER_COMPONENT,
+  // Timestamp when the frame containing the rendering caused by the input
+  // event is swapped by the compositor that scheduled it.
+  INPUT_EVENT_LATENCY_RENDERER_SWAP_COMPONENT,
   // ---------------------------TERMINAL COMPONENT-----------------------------
   // TERMINAL COMPONENT is when we show the latency end in chrome://tracing.
   // Timestamp when the mouse event is acked from renderer and it does not
@@ -62,6 +65,9 @@ enum LatencyComponentType {
   // This component indicates that the input causes a swap to be scheduled
   // but the swap failed.
   INPUT_EVENT_LATENCY_TERMINATED_SWAP_FAILED_COMPONENT,
+  // Timestamp when the input event was coalesced into another input event, and
+  // so will not be delivered on its own.
+  INPUT_EVENT_LATENCY_TERMINATED_COALESCED_COMPONENT,
   // This component indicates that the cached LatencyInfo number exceeds the
   // maximal allowed size.
   LATENCY_INFO_LIST_TERMINATED_OVERFLOW_COMPONENT,
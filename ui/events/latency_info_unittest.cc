@@ -78,4 +78,13 @@ TEST(LatencyInfoTest, ClearEvents) {
   EXPECT_EQ(info.latency_components.size(), 0u);
 }
 
+TEST(LatencyInfoTest, CoalescedComponentTerminates) {
+  LatencyInfo info;
+  info.AddLatencyNumber(INPUT_EVENT_LATENCY_BEGIN_RWH_COMPONENT, 0, 1);
+  EXPECT_FALSE(info.terminated);
+  info.AddLatencyNumber(INPUT_EVENT_LATENCY_TERMINATED_COALESCED_COMPONENT,
+                        0, 0);
+  EXPECT_TRUE(info.terminated);
+}
+
 }  // namespace ui
@@ -0,0 +1,69 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/gfx/render_text.h"
+
+#include <vector>
+
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
+#include "base/strings/stringprintf.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+#include "ui/gfx/rect.h"
+
+namespace gfx {
+
+namespace {
+
+// Like a tab strip with a lot of tabs open.
+const int kNumTitles = 100;
+const int kNumLayouts = 20;
+
+// Returns the titles of |kNumTitles| tabs, some of which are repeated like
+// the titles of tabs of the same site.
+std::vector<base::string16> TabTitles() {
+  std::vector<base::string16> titles;
+  for (int i = 0; i < kNumTitles; ++i) {
+    titles.push_back(base::UTF8ToUTF16(base::StringPrintf(
+        "Example Domain - Page %d of the example site", i % 30)));
+  }
+  return titles;
+}
+
+// Lays out |titles| in new RenderText instances, as views do when they are
+// created or their titles change, and reports the time per layout of all
+// titles.
+void MeasureLayouts(const std::vector<base::string16>& titles,
+                    const std::string& trace) {
+  base::TimeTicks start = base::TimeTicks::HighResNow();
+  for (int i = 0; i < kNumLayouts; ++i) {
+    ScopedVector<RenderText> render_texts;
+    for (size_t j = 0; j < titles.size(); ++j) {
+      RenderText* render_text = RenderText::CreateInstance();
+      render_text->SetText(titles[j]);
+      render_text->SetDisplayRect(Rect(0, 0, 200, 20));
+      EXPECT_GT(render_text->GetStringSize().width(), 0);
+      render_texts.push_back(render_text);
+    }
+  }
+  base::TimeDelta elapsed = base::TimeTicks::HighResNow() - start;
+
+  perf_test::PrintResult("render_text_layout", "", trace,
+                         elapsed.InMillisecondsF() / kNumLayouts,
+                         "ms/layout", true);
+}
+
+}  // namespace
+
+TEST(RenderTextPerfTest, TabTitles) {
+  const std::vector<base::string16> titles = TabTitles();
+  // The first layout also shapes the runs that later ones may find cached.
+  MeasureLayouts(titles, "first");
+  MeasureLayouts(titles, "repeated");
+}
+
+}  // namespace gfx
@@ -1215,6 +1215,33 @@ TEST_F(RenderTextTest, Win_LogicalClusters) {
   for (size_t i = 0; i < test_string.length(); ++i)
     EXPECT_EQ(i, logical_clusters[i]);
 }
+
+// Ensure that a run laid out from the shaped run cache matches a shaped one.
+TEST_F(RenderTextTest, Win_ShapedRunCache) {
+  const base::string16 test_string = WideToUTF16(L"abc \x05d0\x05d1 def");
+  scoped_ptr<RenderTextWin> shaped(
+      static_cast<RenderTextWin*>(RenderText::CreateInstance()));
+  shaped->SetText(test_string);
+  shaped->EnsureLayout();
+  scoped_ptr<RenderTextWin> cached(
+      static_cast<RenderTextWin*>(RenderText::CreateInstance()));
+  cached->SetText(test_string);
+  cached->EnsureLayout();
+
+  ASSERT_EQ(shaped->runs_.size(), cached->runs_.size());
+  EXPECT_EQ(shaped->GetStringSize(), cached->GetStringSize());
+  for (size_t i = 0; i < shaped->runs_.size(); ++i) {
+    const internal::TextRun* shaped_run = shaped->runs_[i];
+    const internal::TextRun* cached_run = cached->runs_[i];
+    EXPECT_EQ(shaped_run->font.GetFontName(), cached_run->font.GetFontName());
+    EXPECT_EQ(shaped_run->width, cached_run->width);
+    ASSERT_EQ(shaped_run->glyph_count, cached_run->glyph_count);
+    for (int j = 0; j < shaped_run->glyph_count; ++j) {
+      EXPECT_EQ(shaped_run->glyphs[j], cached_run->glyphs[j]);
+      EXPECT_EQ(shaped_run->advance_widths[j], cached_run->advance_widths[j]);
+    }
+  }
+}
 #endif  // defined(OS_WIN)
 
 TEST_F(RenderTextTest, StringSizeSanity) {
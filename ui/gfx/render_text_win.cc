@@ -6,10 +6,14 @@
 
 #include <algorithm>
 
+#include "base/bind.h"
+#include "base/containers/mru_cache.h"
 #include "base/i18n/break_iterator.h"
 #include "base/i18n/char_iterator.h"
 #include "base/i18n/rtl.h"
+#include "base/lazy_instance.h"
 #include "base/logging.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/win/windows_version.h"
@@ -264,6 +268,144 @@ bool IsUnusualBlockCode(const UBlockCode block_code) {
          block_code == UBLOCK_MISCELLANEOUS_SYMBOLS;
 }
 
+// The maximum number of runs kept in the shaped run cache. Tab titles, menu
+// items and the like are short, so this holds the text of a busy window.
+const size_t kMaxShapedRuns = 1000;
+
+// Identifies the inputs of shaping and placing a run: its text, the font as
+// derived for its style, and the script analysis from itemization.
+struct ShapedRunKey {
+  ShapedRunKey(const base::string16& layout_text,
+               const internal::TextRun& run)
+      : text(layout_text, run.range.start(), run.range.length()),
+        font_name(run.font.GetFontName()),
+        font_size(run.font.GetFontSize()),
+        font_style(run.font_style) {
+    COMPILE_ASSERT(sizeof(script_analysis) == sizeof(run.script_analysis),
+                   script_analysis_size_mismatch);
+    memcpy(&script_analysis, &run.script_analysis, sizeof(script_analysis));
+  }
+
+  bool operator<(const ShapedRunKey& other) const {
+    if (script_analysis != other.script_analysis)
+      return script_analysis < other.script_analysis;
+    if (font_size != other.font_size)
+      return font_size < other.font_size;
+    if (font_style != other.font_style)
+      return font_style < other.font_style;
+    if (font_name != other.font_name)
+      return font_name < other.font_name;
+    return text < other.text;
+  }
+
+  base::string16 text;
+  std::string font_name;
+  int font_size;
+  int font_style;
+  uint32 script_analysis;
+};
+
+// The outputs of laying out a run with LayoutTextRun() and ScriptPlace().
+struct ShapedRun {
+  explicit ShapedRun(const internal::TextRun& run)
+      : font(run.font),
+        script_analysis(run.script_analysis),
+        glyph_count(run.glyph_count),
+        glyphs(run.glyphs.get(), run.glyphs.get() + run.glyph_count),
+        logical_clusters(run.logical_clusters.get(),
+                         run.logical_clusters.get() + run.range.length()),
+        visible_attributes(run.visible_attributes.get(),
+                           run.visible_attributes.get() + run.glyph_count),
+        abc_widths(run.abc_widths) {
+    if (glyph_count > 0) {
+      advance_widths.assign(run.advance_widths.get(),
+                            run.advance_widths.get() + glyph_count);
+      offsets.assign(run.offsets.get(), run.offsets.get() + glyph_count);
+    }
+  }
+
+  // Sets the layout of |run| to this one.
+  void CopyTo(internal::TextRun* run) const {
+    run->font = font;
+    run->script_analysis = script_analysis;
+    run->glyph_count = glyph_count;
+    run->glyphs.reset(new WORD[glyphs.size()]);
+    std::copy(glyphs.begin(), glyphs.end(), run->glyphs.get());
+    run->logical_clusters.reset(new WORD[logical_clusters.size()]);
+    std::copy(logical_clusters.begin(), logical_clusters.end(),
+              run->logical_clusters.get());
+    run->visible_attributes.reset(
+        new SCRIPT_VISATTR[visible_attributes.size()]);
+    std::copy(visible_attributes.begin(), visible_attributes.end(),
+              run->visible_attributes.get());
+    if (glyph_count > 0) {
+      run->advance_widths.reset(new int[glyph_count]);
+      std::copy(advance_widths.begin(), advance_widths.end(),
+                run->advance_widths.get());
+      run->offsets.reset(new GOFFSET[glyph_count]);
+      std::copy(offsets.begin(), offsets.end(), run->offsets.get());
+    }
+    run->abc_widths = abc_widths;
+  }
+
+  Font font;
+  SCRIPT_ANALYSIS script_analysis;
+  int glyph_count;
+  std::vector<WORD> glyphs;
+  std::vector<WORD> logical_clusters;
+  std::vector<SCRIPT_VISATTR> visible_attributes;
+  std::vector<int> advance_widths;
+  std::vector<GOFFSET> offsets;
+  ABC abc_widths;
+};
+
+// Runs shaped by any RenderTextWin, so that the many views showing the same
+// strings (tab titles, bookmarks, menus) don't reshape them on every layout.
+// Like |cached_hdc_|, this is only used on the UI thread.
+class ShapedRunCache {
+ public:
+  ShapedRunCache() : cache_(kMaxShapedRuns) {
+    // There is no message loop in some tests, and the listener is then inert.
+    memory_pressure_listener_.reset(new base::MemoryPressureListener(
+        base::Bind(&ShapedRunCache::OnMemoryPressure,
+                   base::Unretained(this))));
+  }
+
+  // Lays out |run| from the cache and returns true, or returns false.
+  bool Get(const ShapedRunKey& key, internal::TextRun* run) {
+    Cache::iterator it = cache_.Get(key);
+    if (it == cache_.end())
+      return false;
+    it->second->CopyTo(run);
+    return true;
+  }
+
+  void Put(const ShapedRunKey& key, const internal::TextRun& run) {
+    cache_.Put(key, new ShapedRun(run));
+  }
+
+ private:
+  typedef base::OwningMRUCache<ShapedRunKey, ShapedRun*> Cache;
+
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel level) {
+    // Keep the most recently used half on moderate pressure, which is likely
+    // to cover what is on screen.
+    if (level == base::MemoryPressureListener::MEMORY_PRESSURE_CRITICAL)
+      cache_.Clear();
+    else
+      cache_.ShrinkToSize(cache_.size() / 2);
+  }
+
+  Cache cache_;
+  scoped_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShapedRunCache);
+};
+
+base::LazyInstance<ShapedRunCache>::Leaky g_shaped_run_cache =
+    LAZY_INSTANCE_INITIALIZER;
+
 }  // namespace
 
 namespace internal {
@@ -997,28 +1139,33 @@ void RenderTextWin::LayoutVisualText() {
   // ensures that the text baseline does not shift.
   int ascent = font_list().GetBaseline();
   int descent = font_list().GetHeight() - font_list().GetBaseline();
+  ShapedRunCache* shaped_run_cache = g_shaped_run_cache.Pointer();
   for (size_t i = 0; i < runs_.size(); ++i) {
     internal::TextRun* run = runs_[i];
-    LayoutTextRun(run);
+    const ShapedRunKey key(GetLayoutText(), *run);
+    if (!shaped_run_cache->Get(key, run)) {
+      LayoutTextRun(run);
+
+      if (run->glyph_count > 0) {
+        run->advance_widths.reset(new int[run->glyph_count]);
+        run->offsets.reset(new GOFFSET[run->glyph_count]);
+        hr = ScriptPlace(cached_hdc_,
+                         &run->script_cache,
+                         run->glyphs.get(),
+                         run->glyph_count,
+                         run->visible_attributes.get(),
+                         &(run->script_analysis),
+                         run->advance_widths.get(),
+                         run->offsets.get(),
+                         &(run->abc_widths));
+        DCHECK(SUCCEEDED(hr));
+      }
+      shaped_run_cache->Put(key, *run);
+    }
 
     ascent = std::max(ascent, run->font.GetBaseline());
     descent = std::max(descent,
                        run->font.GetHeight() - run->font.GetBaseline());
-
-    if (run->glyph_count > 0) {
-      run->advance_widths.reset(new int[run->glyph_count]);
-      run->offsets.reset(new GOFFSET[run->glyph_count]);
-      hr = ScriptPlace(cached_hdc_,
-                       &run->script_cache,
-                       run->glyphs.get(),
-                       run->glyph_count,
-                       run->visible_attributes.get(),
-                       &(run->script_analysis),
-                       run->advance_widths.get(),
-                       run->offsets.get(),
-                       &(run->abc_widths));
-      DCHECK(SUCCEEDED(hr));
-    }
   }
 
   // Build the array of bidirectional embedding levels.
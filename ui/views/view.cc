@@ -15,6 +15,7 @@
 #include "base/message_loop/message_loop.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
+#include "third_party/skia/include/core/SkPicture.h"
 #include "third_party/skia/include/core/SkRect.h"
 #include "ui/base/accessibility/accessibility_types.h"
 #include "ui/base/dragdrop/drag_drop_types.h"
@@ -42,6 +43,7 @@
 #include "ui/views/layout/layout_manager.h"
 #include "ui/views/rect_based_targeting_utils.h"
 #include "ui/views/views_delegate.h"
+#include "ui/views/views_switches.h"
 #include "ui/views/widget/native_widget_private.h"
 #include "ui/views/widget/root_view.h"
 #include "ui/views/widget/tooltip_manager.h"
@@ -162,6 +164,7 @@ View::View()
       registered_for_visible_bounds_notification_(false),
       clip_insets_(0, 0, 0, 0),
       needs_layout_(true),
+      paint_cache_scale_(0.0f),
       flip_canvas_on_paint_for_rtl_ui_(false),
       paint_to_layer_(false),
       accelerator_focus_manager_(NULL),
@@ -763,6 +766,9 @@ void View::SchedulePaint() {
 }
 
 void View::SchedulePaintInRect(const gfx::Rect& rect) {
+  // Drop the cached paint even while hidden, as it may be stale when shown.
+  // This also drops the caches of the ancestors the paint goes through.
+  paint_cache_.clear();
   if (!visible_)
     return;
 
@@ -1801,17 +1807,52 @@ void View::PaintCommon(gfx::Canvas* canvas) {
     // don't pass the canvas with the mirrored transform to Views that didn't
     // request the canvas to be flipped.
     gfx::ScopedCanvas scoped(canvas);
-    if (FlipCanvasOnPaintForRTLUI()) {
-      canvas->Translate(gfx::Vector2d(width(), 0));
-      canvas->Scale(-1, 1);
-    }
-
-    OnPaint(canvas);
+    // Views with a layer are already cached by it. The RootView, which has
+    // no parent, overrides SchedulePaintInRect() and is never cached.
+    if (!layer() && parent_ && switches::IsPaintCachingEnabled())
+      PaintSelfFromCache(canvas);
+    else
+      PaintSelf(canvas);
   }
 
   PaintChildren(canvas);
 }
 
+void View::PaintSelf(gfx::Canvas* canvas) {
+  if (FlipCanvasOnPaintForRTLUI()) {
+    canvas->Translate(gfx::Vector2d(width(), 0));
+    canvas->Scale(-1, 1);
+  }
+
+  OnPaint(canvas);
+}
+
+void View::PaintSelfFromCache(gfx::Canvas* canvas) {
+  gfx::Rect clip_rect;
+  if (!canvas->GetClipBounds(&clip_rect))
+    return;
+
+  if (!paint_cache_ || paint_cache_scale_ != canvas->image_scale() ||
+      !paint_cache_rect_.Contains(clip_rect)) {
+    TRACE_EVENT1("views", "View::PaintSelfFromCache record",
+                 "class", GetClassName());
+    // Record only what is clipped in, like a direct paint would paint. Views
+    // such as tables only paint the rows within the clip.
+    paint_cache_rect_ = clip_rect;
+    paint_cache_scale_ = canvas->image_scale();
+    paint_cache_ = skia::AdoptRef(new SkPicture);
+    SkCanvas* recording_canvas =
+        paint_cache_->beginRecording(width(), height());
+    recording_canvas->clipRect(gfx::RectToSkRect(paint_cache_rect_));
+    scoped_ptr<gfx::Canvas> recording(gfx::Canvas::CreateCanvasWithoutScaling(
+        recording_canvas, paint_cache_scale_));
+    PaintSelf(recording.get());
+    paint_cache_->endRecording();
+  }
+
+  canvas->sk_canvas()->drawPicture(*paint_cache_);
+}
+
 // Tree operations -------------------------------------------------------------
 
 void View::DoRemoveChildView(View* view,
@@ -1916,6 +1957,8 @@ void View::ViewHierarchyChangedImpl(
 void View::PropagateNativeThemeChanged(const ui::NativeTheme* theme) {
   for (int i = 0, count = child_count(); i < count; ++i)
     child_at(i)->PropagateNativeThemeChanged(theme);
+  // Not all views schedule a paint when the theme changes.
+  paint_cache_.clear();
   OnNativeThemeChanged(theme);
 }
 
@@ -16,6 +16,7 @@
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
 #include "build/build_config.h"
+#include "skia/ext/refptr.h"
 #include "ui/base/accelerators/accelerator.h"
 #include "ui/base/accessibility/accessibility_types.h"
 #include "ui/base/dragdrop/drag_drop_types.h"
@@ -38,6 +39,8 @@
 
 using ui::OSExchangeData;
 
+class SkPicture;
+
 namespace gfx {
 class Canvas;
 class Insets;
@@ -1243,6 +1246,13 @@ class VIEWS_EXPORT View : public ui::LayerDelegate,
   // invoke OnPaint() on the View.
   void PaintCommon(gfx::Canvas* canvas);
 
+  // Invokes OnPaint(), flipping the canvas for RTL if requested.
+  void PaintSelf(gfx::Canvas* canvas);
+
+  // Replays |paint_cache_| into |canvas|, recording it again first if it does
+  // not cover the clip of |canvas|.
+  void PaintSelfFromCache(gfx::Canvas* canvas);
+
   // Tree operations -----------------------------------------------------------
 
   // Removes |view| from the hierarchy tree.  If |update_focus_cycle| is true,
@@ -1505,6 +1515,13 @@ class VIEWS_EXPORT View : public ui::LayerDelegate,
   // Border.
   scoped_ptr<Border> border_;
 
+  // What OnPaint() last painted within |paint_cache_rect_|, at an image scale
+  // of |paint_cache_scale_|, when paint caching is enabled. Cleared whenever
+  // this View or a descendant schedules a paint.
+  skia::RefPtr<SkPicture> paint_cache_;
+  gfx::Rect paint_cache_rect_;
+  float paint_cache_scale_;
+
   // RTL painting --------------------------------------------------------------
 
   // Indicates whether or not the gfx::Canvas object passed to View::Paint()
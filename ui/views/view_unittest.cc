@@ -4,6 +4,7 @@
 
 #include <map>
 
+#include "base/command_line.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/rand_util.h"
 #include "base/strings/string_util.h"
@@ -20,6 +21,7 @@
 #include "ui/events/keycodes/keyboard_codes.h"
 #include "ui/gfx/canvas.h"
 #include "ui/gfx/path.h"
+#include "ui/gfx/scoped_canvas.h"
 #include "ui/gfx/transform.h"
 #include "ui/views/background.h"
 #include "ui/views/controls/native/native_view_host.h"
@@ -29,6 +31,7 @@
 #include "ui/views/test/views_test_base.h"
 #include "ui/views/view.h"
 #include "ui/views/views_delegate.h"
+#include "ui/views/views_switches.h"
 #include "ui/views/widget/native_widget.h"
 #include "ui/views/widget/root_view.h"
 #include "ui/views/window/dialog_client_view.h"
@@ -3399,6 +3402,49 @@ class PaintTrackingView : public View {
   DISALLOW_COPY_AND_ASSIGN(PaintTrackingView);
 };
 
+#if !defined(OS_WIN)
+// Makes sure cached paints are replayed until the view schedules a paint.
+TEST_F(ViewLayerTest, PaintCaching) {
+  CommandLine original_command_line = *CommandLine::ForCurrentProcess();
+  CommandLine::ForCurrentProcess()->AppendSwitch(
+      switches::kEnableViewsPaintCaching);
+
+  View parent;
+  parent.SetBoundsRect(gfx::Rect(0, 0, 100, 100));
+  PaintTrackingView* child = new PaintTrackingView;
+  child->SetBoundsRect(gfx::Rect(10, 10, 50, 50));
+  parent.AddChildView(child);
+  gfx::Canvas canvas(gfx::Size(100, 100), 1.0f, true);
+
+  parent.Paint(&canvas);
+  EXPECT_TRUE(child->painted());
+
+  // Nothing changed, so the recorded paint is replayed.
+  child->set_painted(false);
+  parent.Paint(&canvas);
+  EXPECT_FALSE(child->painted());
+
+  child->SchedulePaint();
+  parent.Paint(&canvas);
+  EXPECT_TRUE(child->painted());
+
+  // A larger clip than the recorded one records again.
+  child->set_painted(false);
+  {
+    gfx::ScopedCanvas scoped_canvas(&canvas);
+    canvas.ClipRect(gfx::Rect(0, 0, 20, 20));
+    child->SchedulePaint();
+    parent.Paint(&canvas);
+    EXPECT_TRUE(child->painted());
+  }
+  child->set_painted(false);
+  parent.Paint(&canvas);
+  EXPECT_TRUE(child->painted());
+
+  *CommandLine::ForCurrentProcess() = original_command_line;
+}
+#endif
+
 // Makes sure child views with layers aren't painted when paint starts at an
 // ancestor.
 TEST_F(ViewLayerTest, DontPaintChildrenWithLayers) {
@@ -16,6 +16,10 @@ namespace switches {
 const char kDisableViewsRectBasedTargeting[] =
     "disable-views-rect-based-targeting";
 
+// Records what each view without a layer paints in an SkPicture, which is
+// replayed until the view schedules a paint.
+const char kEnableViewsPaintCaching[] = "enable-views-paint-caching";
+
 bool IsRectBasedTargetingEnabled() {
 #if defined(OS_CHROMEOS) || defined(OS_WIN)
   return !CommandLine::ForCurrentProcess()->
@@ -25,5 +29,14 @@ bool IsRectBasedTargetingEnabled() {
 #endif
 }
 
+bool IsPaintCachingEnabled() {
+#if defined(OS_WIN)
+  // Native theme parts are painted with GDI, which a picture can't record.
+  return false;
+#else
+  return CommandLine::ForCurrentProcess()->HasSwitch(kEnableViewsPaintCaching);
+#endif
+}
+
 }  // namespace switches
 }  // namespace views
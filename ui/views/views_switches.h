@@ -14,10 +14,14 @@ namespace switches {
 
 // Please keep alphabetized.
 VIEWS_EXPORT extern const char kDisableViewsRectBasedTargeting[];
+VIEWS_EXPORT extern const char kEnableViewsPaintCaching[];
 
 // Returns true if rect-based targeting in views should be used.
 VIEWS_EXPORT bool IsRectBasedTargetingEnabled();
 
+// Returns true if views should record and replay what they paint.
+VIEWS_EXPORT bool IsPaintCachingEnabled();
+
 }  // namespace switches
 }  // namespace views
 
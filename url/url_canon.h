@@ -112,8 +112,7 @@ class CanonOutputT {
       if (!Grow(cur_len_ + str_len - buffer_len_))
         return;
     }
-    for (int i = 0; i < str_len; i++)
-      buffer_[cur_len_ + i] = str[i];
+    memcpy(buffer_ + cur_len_, str, sizeof(T) * str_len);
     cur_len_ += str_len;
   }
 
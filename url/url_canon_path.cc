@@ -75,6 +75,28 @@ const unsigned char kPathCharLookup[0x100] = {
      ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,
      ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE};
 
+// Returns true if |ch| is copied to the canonical path as is, whatever the
+// characters around it.
+template<typename CHAR, typename UCHAR>
+inline bool IsPlainPathChar(CHAR ch) {
+  UCHAR uch = static_cast<UCHAR>(ch);
+  if (sizeof(CHAR) > sizeof(char) && uch >= 0x80)
+    return false;
+  return !(kPathCharLookup[static_cast<unsigned char>(uch)] & SPECIAL);
+}
+
+// Appends the |len| plain path characters at |run| to |output|.
+inline void AppendPathRun(const char* run, int len, CanonOutput* output) {
+  output->Append(run, len);
+}
+
+inline void AppendPathRun(const base::char16* run,
+                          int len,
+                          CanonOutput* output) {
+  for (int i = 0; i < len; i++)
+    output->push_back(static_cast<char>(run[i]));
+}
+
 enum DotDisposition {
   // The given dot is just part of a filename and is not special.
   NOT_A_DIRECTORY,
@@ -285,8 +307,14 @@ bool DoPartialPath(const CHAR* spec,
           AppendEscapedChar(out_ch, output);
         }
       } else {
-        // Nothing special about this character, just append it.
-        output->push_back(out_ch);
+        // Nothing special about this character. Append it along with the
+        // plain characters following it at once, since most paths are made of
+        // long runs of them.
+        int run_end = i + 1;
+        while (run_end < end && IsPlainPathChar<CHAR, UCHAR>(spec[run_end]))
+          run_end++;
+        AppendPathRun(&spec[i], run_end - i, output);
+        i = run_end - 1;
       }
     }
   }
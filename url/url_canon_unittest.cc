@@ -1105,6 +1105,8 @@ TEST(URLCanonTest, Path) {
     {"/foo", L"/foo", "/foo", url_parse::Component(0, 4), true},
       // Valid escape sequence
     {"/%20foo", L"/%20foo", "/%20foo", url_parse::Component(0, 7), true},
+      // Runs of plain characters interrupted by ones needing handling
+    {"/foo_bar/b~z%41 x.html", L"/foo_bar/b~z%41 x.html", "/foo_bar/b~zA%20x.html", url_parse::Component(0, 22), true},
       // Invalid escape sequence we should pass through unchanged.
     {"/foo%", L"/foo%", "/foo%", url_parse::Component(0, 5), true},
     {"/foo%2", L"/foo%2", "/foo%2", url_parse::Component(0, 6), true},
@@ -4,6 +4,8 @@
 
 #include "webkit/browser/appcache/appcache_histograms.h"
 
+#include <algorithm>
+
 #include "base/metrics/histogram.h"
 
 namespace appcache {
@@ -88,6 +90,14 @@ void AppCacheHistograms::AddAppCacheJobStartDelaySample(
   UMA_HISTOGRAM_TIMES("appcache.JobStartDelay.AppCache", duration);
 }
 
+void AppCacheHistograms::AddUpdateJobDownloadSample(
+    size_t num_entries, const base::TimeDelta& duration) {
+  UMA_HISTOGRAM_LONG_TIMES("appcache.UpdateJobDownloadTime", duration);
+  int64 milliseconds = std::max<int64>(duration.InMilliseconds(), 1);
+  UMA_HISTOGRAM_COUNTS_10000("appcache.UpdateJobEntriesPerSecond",
+                             num_entries * 1000 / milliseconds);
+}
+
 void AppCacheHistograms::AddMissingManifestEntrySample() {
   UMA_HISTOGRAM_BOOLEAN("appcache.MissingManifestEntry", true);
 }
@@ -39,6 +39,8 @@ class AppCacheHistograms {
   static void AddNetworkJobStartDelaySample(const base::TimeDelta& duration);
   static void AddErrorJobStartDelaySample(const base::TimeDelta& duration);
   static void AddAppCacheJobStartDelaySample(const base::TimeDelta& duration);
+  static void AddUpdateJobDownloadSample(size_t num_entries,
+                                         const base::TimeDelta& duration);
   static void AddMissingManifestEntrySample();
 
   enum MissingManifestCallsiteType {
@@ -23,7 +23,9 @@
 namespace appcache {
 
 static const int kBufferSize = 32768;
-static const size_t kMaxConcurrentUrlFetches = 2;
+// As many as the network stack runs to one host at once, since the entries
+// of a manifest usually come from the same origin.
+static const size_t kMaxConcurrentUrlFetches = 6;
 static const int kMax503Retries = 3;
 
 static std::string FormatUrlErrorMessage(
@@ -544,6 +546,7 @@ void AppCacheUpdateJob::ContinueHandleManifestFetchCompleted(bool changed) {
 
   // Proceed with update process. Section 6.9.4 steps 8-20.
   internal_state_ = DOWNLOADING;
+  download_start_time_ = base::TimeTicks::Now();
   inprogress_cache_ = new AppCache(storage_, storage_->NewCacheId());
   BuildUrlFileList(manifest);
   inprogress_cache_->InitializeWithManifest(&manifest);
@@ -1315,6 +1318,9 @@ void AppCacheUpdateJob::MaybeCompleteUpdate() {
       internal_state_ = COMPLETED;
       AppCacheHistograms::CountUpdateJobResult(
           UPDATE_OK, manifest_url_.GetOrigin());
+      AppCacheHistograms::AddUpdateJobDownloadSample(
+          url_file_list_.size(),
+          base::TimeTicks::Now() - download_start_time_);
       break;
     case CACHE_FAILURE:
       NOTREACHED();  // See HandleCacheFailure
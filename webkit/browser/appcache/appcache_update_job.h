@@ -13,6 +13,7 @@
 
 #include "base/gtest_prod_util.h"
 #include "base/memory/ref_counted.h"
+#include "base/time/time.h"
 #include "net/base/completion_callback.h"
 #include "net/http/http_response_headers.h"
 #include "net/url_request/url_request.h"
@@ -281,6 +282,9 @@ class WEBKIT_STORAGE_BROWSER_EXPORT AppCacheUpdateJob
   AppCache::EntryMap url_file_list_;
   size_t url_fetches_completed_;
 
+  // When the job started fetching the files of the new cache.
+  base::TimeTicks download_start_time_;
+
   // Helper container to track which urls have not been fetched yet. URLs are
   // removed when the fetch is initiated. Flag indicates whether an attempt
   // to load the URL from storage has already been tried and failed.
@@ -4,13 +4,21 @@
 
 #include "webkit/browser/blob/blob_storage_context.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "base/bind.h"
+#include "base/file_util.h"
+#include "base/files/file.h"
 #include "base/location.h"
 #include "base/logging.h"
 #include "base/message_loop/message_loop_proxy.h"
+#include "base/task_runner.h"
+#include "base/task_runner_util.h"
 #include "url/gurl.h"
 #include "webkit/browser/blob/blob_data_handle.h"
 #include "webkit/common/blob/blob_data.h"
+#include "webkit/common/blob/shareable_file_reference.h"
 
 namespace webkit_blob {
 
@@ -36,22 +44,74 @@ GURL ClearBlobUrlRef(const GURL& url) {
 // way to come up with a better limit.
 static const int64 kMaxMemoryUsage = 500 * 1024 * 1024;  // Half a gig.
 
+// When paging is enabled, finished blobs are paged out beyond this.
+static const int64 kDefaultMemoryQuota = 100 * 1024 * 1024;
+
+// Runs on the file task runner.  Writes the bytes items of |blob_data| one
+// after the other to a new temporary file.  |blob_data| is finished, so it
+// doesn't change while this runs.
+bool WriteBytesItemsToFile(const BlobData* blob_data,
+                           base::FilePath* file_path,
+                           base::Time* modification_time) {
+  if (!base::CreateTemporaryFile(file_path))
+    return false;
+
+  base::File file(*file_path, base::File::FLAG_OPEN | base::File::FLAG_WRITE);
+  bool success = file.IsValid();
+  int64 file_offset = 0;
+  for (std::vector<BlobData::Item>::const_iterator iter =
+           blob_data->items().begin();
+       success && iter != blob_data->items().end(); ++iter) {
+    if (iter->type() != BlobData::Item::TYPE_BYTES)
+      continue;
+    const char* bytes = iter->bytes() + iter->offset();
+    uint64 remaining = iter->length();
+    while (remaining > 0) {
+      int written = file.Write(
+          file_offset, bytes,
+          static_cast<int>(std::min<uint64>(
+              remaining, std::numeric_limits<int>::max())));
+      if (written <= 0) {
+        success = false;
+        break;
+      }
+      file_offset += written;
+      bytes += written;
+      remaining -= written;
+    }
+  }
+
+  base::File::Info info;
+  if (success)
+    success = file.GetInfo(&info);
+  file.Close();
+  if (!success) {
+    base::DeleteFile(*file_path, false);
+    return false;
+  }
+  *modification_time = info.last_modified;
+  return true;
+}
+
 }  // namespace
 
 BlobStorageContext::BlobMapEntry::BlobMapEntry()
-    : refcount(0), flags(0) {
+    : refcount(0), flags(0), last_access(0) {
 }
 
 BlobStorageContext::BlobMapEntry::BlobMapEntry(
     int refcount, int flags, BlobData* data)
-    : refcount(refcount), flags(flags), data(data) {
+    : refcount(refcount), flags(flags), data(data), last_access(0) {
 }
 
 BlobStorageContext::BlobMapEntry::~BlobMapEntry() {
 }
 
 BlobStorageContext::BlobStorageContext()
-    : memory_usage_(0) {
+    : memory_usage_(0),
+      memory_quota_(kDefaultMemoryQuota),
+      paging_usage_(0),
+      access_count_(0) {
 }
 
 BlobStorageContext::~BlobStorageContext() {
@@ -66,6 +126,7 @@ scoped_ptr<BlobDataHandle> BlobStorageContext::GetBlobDataFromUUID(
   if (found->second.flags & EXCEEDED_MEMORY)
     return result.Pass();
   DCHECK(!(found->second.flags & BEING_BUILT));
+  found->second.last_access = ++access_count_;
   result.reset(new BlobDataHandle(
       found->second.data.get(), this, base::MessageLoopProxy::current().get()));
   return result.Pass();
@@ -114,6 +175,11 @@ void BlobStorageContext::RevokePublicBlobURL(const GURL& blob_url) {
   public_blob_urls_.erase(blob_url);
 }
 
+void BlobStorageContext::EnablePaging(base::TaskRunner* file_task_runner) {
+  file_task_runner_ = file_task_runner;
+  PageOutBlobsIfNeeded();
+}
+
 void BlobStorageContext::StartBuildingBlob(const std::string& uuid) {
   DCHECK(!IsInUse(uuid) && !uuid.empty());
   blob_map_[uuid] = BlobMapEntry(1, BEING_BUILT, new BlobData(uuid));
@@ -188,6 +254,8 @@ void BlobStorageContext::AppendBlobDataItem(
     found->second.data = new BlobData(uuid);
     return;
   }
+
+  PageOutBlobsIfNeeded();
 }
 
 void BlobStorageContext::FinishBuildingBlob(
@@ -198,6 +266,8 @@ void BlobStorageContext::FinishBuildingBlob(
     return;
   found->second.data->set_content_type(content_type);
   found->second.flags &= ~BEING_BUILT;
+  found->second.last_access = ++access_count_;
+  PageOutBlobsIfNeeded();
 }
 
 void BlobStorageContext::CancelBuildingBlob(const std::string& uuid) {
@@ -307,6 +377,98 @@ void BlobStorageContext::AppendFileSystemFileItem(
                                          expected_modification_time);
 }
 
+void BlobStorageContext::PageOutBlobsIfNeeded() {
+  if (!file_task_runner_.get())
+    return;
+  while (memory_usage_ - paging_usage_ > memory_quota_) {
+    BlobMap::iterator coldest = blob_map_.end();
+    for (BlobMap::iterator iter = blob_map_.begin(); iter != blob_map_.end();
+         ++iter) {
+      if (iter->second.flags & (BEING_BUILT | EXCEEDED_MEMORY | PAGING_OUT))
+        continue;
+      if (!iter->second.data->GetMemoryUsage())
+        continue;
+      if (coldest == blob_map_.end() ||
+          iter->second.last_access < coldest->second.last_access) {
+        coldest = iter;
+      }
+    }
+    if (coldest == blob_map_.end())
+      return;
+
+    coldest->second.flags |= PAGING_OUT;
+    scoped_refptr<BlobData> data = coldest->second.data;
+    paging_usage_ += data->GetMemoryUsage();
+    base::FilePath* file_path = new base::FilePath;
+    base::Time* modification_time = new base::Time;
+    // The reply holds a reference to |data| until the file is written.
+    base::PostTaskAndReplyWithResult(
+        file_task_runner_.get(), FROM_HERE,
+        base::Bind(&WriteBytesItemsToFile, base::Unretained(data.get()),
+                   file_path, modification_time),
+        base::Bind(&BlobStorageContext::OnBlobPagedOut, AsWeakPtr(),
+                   coldest->first, data, base::Owned(file_path),
+                   base::Owned(modification_time)));
+  }
+}
+
+void BlobStorageContext::OnBlobPagedOut(const std::string& uuid,
+                                        scoped_refptr<BlobData> data,
+                                        base::FilePath* file_path,
+                                        base::Time* modification_time,
+                                        bool success) {
+  paging_usage_ -= data->GetMemoryUsage();
+  BlobMap::iterator found = blob_map_.find(uuid);
+  bool is_current = found != blob_map_.end() &&
+      found->second.data.get() == data.get();
+  if (is_current)
+    found->second.flags &= ~PAGING_OUT;
+  if (!success)
+    return;
+
+  // If the blob is gone, releasing this deletes the file.
+  scoped_refptr<ShareableFileReference> paged_file =
+      ShareableFileReference::GetOrCreate(
+          *file_path, ShareableFileReference::DELETE_ON_FINAL_RELEASE,
+          file_task_runner_.get());
+  if (!is_current)
+    return;
+
+  // Handles out there keep the in-memory data until they go away; new ones
+  // get the paged data.
+  scoped_refptr<BlobData> paged_data(new BlobData(uuid));
+  paged_data->set_content_type(data->content_type());
+  paged_data->set_content_disposition(data->content_disposition());
+  uint64 file_offset = 0;
+  for (std::vector<BlobData::Item>::const_iterator iter =
+           data->items().begin();
+       iter != data->items().end(); ++iter) {
+    switch (iter->type()) {
+      case BlobData::Item::TYPE_BYTES:
+        paged_data->AppendFile(*file_path, file_offset, iter->length(),
+                               *modification_time);
+        file_offset += iter->length();
+        break;
+      case BlobData::Item::TYPE_FILE:
+        AppendFileItem(paged_data.get(), iter->path(), iter->offset(),
+                       iter->length(), iter->expected_modification_time());
+        break;
+      case BlobData::Item::TYPE_FILE_FILESYSTEM:
+        AppendFileSystemFileItem(paged_data.get(), iter->filesystem_url(),
+                                 iter->offset(), iter->length(),
+                                 iter->expected_modification_time());
+        break;
+      default:
+        NOTREACHED();
+        break;
+    }
+  }
+  paged_data->AttachShareableFileReference(paged_file.get());
+
+  memory_usage_ -= data->GetMemoryUsage();
+  found->second.data = paged_data;
+}
+
 bool BlobStorageContext::IsInUse(const std::string& uuid) {
   return blob_map_.find(uuid) != blob_map_.end();
 }
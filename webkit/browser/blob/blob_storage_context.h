@@ -19,6 +19,7 @@ class GURL;
 
 namespace base {
 class FilePath;
+class TaskRunner;
 class Time;
 }
 
@@ -30,6 +31,11 @@ class BlobDataHandle;
 // and maintains a mapping from blob uuid to the data. The class is single
 // threaded and should only be used on the IO thread.
 // In chromium, there is one instance per profile.
+//
+// Once paging is enabled, the bytes of finished blobs are written out to
+// temporary files whenever blobs use more memory than the quota, starting
+// with the blobs least recently looked up; the paged blobs then refer to
+// the files instead.
 class WEBKIT_STORAGE_BROWSER_EXPORT BlobStorageContext
     : public base::SupportsWeakPtr<BlobStorageContext> {
  public:
@@ -47,6 +53,14 @@ class WEBKIT_STORAGE_BROWSER_EXPORT BlobStorageContext
   bool RegisterPublicBlobURL(const GURL& url, const std::string& uuid);
   void RevokePublicBlobURL(const GURL& url);
 
+  // Enables paging blob data out to temporary files, which are written and
+  // deleted on |file_task_runner|.
+  void EnablePaging(base::TaskRunner* file_task_runner);
+
+  void set_memory_quota_for_testing(int64 memory_quota) {
+    memory_quota_ = memory_quota;
+  }
+
  private:
   friend class BlobDataHandle;
   friend class BlobStorageHost;
@@ -55,12 +69,15 @@ class WEBKIT_STORAGE_BROWSER_EXPORT BlobStorageContext
   enum EntryFlags {
     BEING_BUILT = 1 << 0,
     EXCEEDED_MEMORY = 1 << 1,
+    PAGING_OUT = 1 << 2,
   };
 
   struct BlobMapEntry {
     int refcount;
     int flags;
     scoped_refptr<BlobData> data;
+    // When the blob was last looked up, as a value of |access_count_|.
+    int64 last_access;
 
     BlobMapEntry();
     BlobMapEntry(int refcount, int flags, BlobData* data);
@@ -94,6 +111,15 @@ class WEBKIT_STORAGE_BROWSER_EXPORT BlobStorageContext
       const GURL& url, uint64 offset, uint64 length,
       const base::Time& expected_modification_time);
 
+  // Pages out the coldest finished blobs until the blobs which aren't
+  // already being paged out fit in the memory quota.
+  void PageOutBlobsIfNeeded();
+  void OnBlobPagedOut(const std::string& uuid,
+                      scoped_refptr<BlobData> data,
+                      base::FilePath* file_path,
+                      base::Time* modification_time,
+                      bool success);
+
   bool IsInUse(const std::string& uuid);
   bool IsBeingBuilt(const std::string& uuid);
   bool IsUrlRegistered(const GURL& blob_url);
@@ -106,6 +132,13 @@ class WEBKIT_STORAGE_BROWSER_EXPORT BlobStorageContext
   // items of TYPE_FILE.
   int64 memory_usage_;
 
+  // Paging is enabled when |file_task_runner_| is set.  |paging_usage_| is
+  // the part of |memory_usage_| being written out.
+  scoped_refptr<base::TaskRunner> file_task_runner_;
+  int64 memory_quota_;
+  int64 paging_usage_;
+  int64 access_count_;
+
   DISALLOW_COPY_AND_ASSIGN(BlobStorageContext);
 };
 
@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "base/file_util.h"
 #include "base/files/file_path.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
@@ -131,6 +132,70 @@ TEST(BlobStorageContextTest, CompoundBlobs) {
   EXPECT_TRUE(*(blob_data_handle->data()) == *canonicalized_blob_data2.get());
 }
 
+TEST(BlobStorageContextTest, PageOut) {
+  const std::string kId1("id1");
+  const std::string kId2("id2");
+
+  base::MessageLoop fake_io_message_loop;
+  base::Time time1;
+  base::Time::FromString("Tue, 15 Nov 1994, 12:45:26 GMT", &time1);
+
+  BlobStorageContext context;
+  context.EnablePaging(fake_io_message_loop.message_loop_proxy().get());
+  context.set_memory_quota_for_testing(12);
+
+  scoped_refptr<BlobData> blob_data1(new BlobData(kId1));
+  blob_data1->AppendData("Data1");
+  blob_data1->AppendFile(base::FilePath(FILE_PATH_LITERAL("File1.txt")),
+      10, 1024, time1);
+  blob_data1->AppendData("Data2");
+  scoped_ptr<BlobDataHandle> blob_data_handle1 =
+      context.AddFinishedBlob(blob_data1.get());
+
+  // Within the quota, nothing is paged out.
+  fake_io_message_loop.RunUntilIdle();
+  blob_data_handle1 = context.GetBlobDataFromUUID(kId1);
+  ASSERT_TRUE(blob_data_handle1.get());
+  EXPECT_TRUE(*(blob_data_handle1->data()) == *blob_data1.get());
+
+  // Going over the quota pages out the colder blob.
+  scoped_refptr<BlobData> blob_data2(new BlobData(kId2));
+  blob_data2->AppendData("Data3");
+  scoped_ptr<BlobDataHandle> blob_data_handle2 =
+      context.AddFinishedBlob(blob_data2.get());
+  fake_io_message_loop.RunUntilIdle();
+
+  // Existing handles keep the data in memory, new ones refer to the file.
+  EXPECT_TRUE(*(blob_data_handle1->data()) == *blob_data1.get());
+  blob_data_handle1 = context.GetBlobDataFromUUID(kId1);
+  ASSERT_TRUE(blob_data_handle1.get());
+  const std::vector<BlobData::Item>& items =
+      blob_data_handle1->data()->items();
+  ASSERT_EQ(3U, items.size());
+  EXPECT_EQ(BlobData::Item::TYPE_FILE, items[0].type());
+  EXPECT_EQ(0U, items[0].offset());
+  EXPECT_EQ(5U, items[0].length());
+  EXPECT_TRUE(items[1] == blob_data1->items()[1]);
+  EXPECT_EQ(BlobData::Item::TYPE_FILE, items[2].type());
+  EXPECT_EQ(items[0].path(), items[2].path());
+  EXPECT_EQ(5U, items[2].offset());
+  EXPECT_EQ(5U, items[2].length());
+  EXPECT_EQ(0, blob_data_handle1->data()->GetMemoryUsage());
+
+  const base::FilePath paged_file_path = items[0].path();
+  std::string contents;
+  EXPECT_TRUE(base::ReadFileToString(paged_file_path, &contents));
+  EXPECT_EQ("Data1Data2", contents);
+
+  // The newer blob stays in memory.
+  EXPECT_TRUE(*(blob_data_handle2->data()) == *blob_data2.get());
+
+  // The file goes away with the blob.
+  blob_data_handle1.reset();
+  fake_io_message_loop.RunUntilIdle();
+  EXPECT_FALSE(base::PathExists(paged_file_path));
+}
+
 TEST(BlobStorageContextTest, PublicBlobUrls) {
   BlobStorageContext context;
   BlobStorageHost host(&context);
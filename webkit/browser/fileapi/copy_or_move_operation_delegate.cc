@@ -4,6 +4,8 @@
 
 #include "webkit/browser/fileapi/copy_or_move_operation_delegate.h"
 
+#include <algorithm>
+
 #include "base/bind.h"
 #include "base/files/file_path.h"
 #include "net/base/io_buffer.h"
@@ -351,8 +353,10 @@ class SnapshotCopyOrMoveImpl
   DISALLOW_COPY_AND_ASSIGN(SnapshotCopyOrMoveImpl);
 };
 
-// The size of buffer for StreamCopyHelper.
+// The size of buffer for StreamCopyHelper. Large files get a buffer of up to
+// kMaxReadBufferSize so that they take fewer read/write round trips.
 const int kReadBufferSize = 32768;
+const int kMaxReadBufferSize = 1024 * 1024;
 
 // To avoid too many progress callbacks, it should be called less
 // frequently than 50ms.
@@ -427,12 +431,13 @@ class StreamCopyOrMoveImpl
         dest_url_, false /* exclusive */,
         base::Bind(&StreamCopyOrMoveImpl::RunAfterCreateFileForDestination,
                    weak_factory_.GetWeakPtr(),
-                   callback, file_info.last_modified));
+                   callback, file_info.last_modified, file_info.size));
   }
 
   void RunAfterCreateFileForDestination(
       const CopyOrMoveOperationDelegate::StatusCallback& callback,
       const base::Time& last_modified,
+      int64 file_size,
       base::File::Error error) {
     if (cancel_requested_)
       error = base::File::FILE_ERROR_ABORT;
@@ -445,12 +450,16 @@ class StreamCopyOrMoveImpl
     const bool need_flush = dest_url_.mount_option().copy_sync_option() ==
         fileapi::COPY_SYNC_OPTION_SYNC;
 
+    const int buffer_size = static_cast<int>(std::max<int64>(
+        kReadBufferSize,
+        std::min<int64>(file_size, kMaxReadBufferSize)));
+
     DCHECK(!copy_helper_);
     copy_helper_.reset(
         new CopyOrMoveOperationDelegate::StreamCopyHelper(
             reader_.Pass(), writer_.Pass(),
             need_flush,
-            kReadBufferSize,
+            buffer_size,
             file_progress_callback_,
             base::TimeDelta::FromMilliseconds(
                 kMinProgressCallbackInvocationSpanInMilliseconds)));
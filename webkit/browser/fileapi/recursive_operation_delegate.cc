@@ -11,8 +11,10 @@
 namespace fileapi {
 
 namespace {
-// Don't start too many inflight operations.
-const int kMaxInflightOperations = 5;
+// Don't start too many inflight operations. Each one spends most of its time
+// hopping between threads, so a directory of small files needs many in flight
+// to keep the file thread busy.
+const int kMaxInflightOperations = 16;
 }
 
 RecursiveOperationDelegate::RecursiveOperationDelegate(
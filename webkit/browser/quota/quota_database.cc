@@ -23,11 +23,12 @@ namespace {
 
 // Definitions for database schema.
 
-const int kCurrentVersion = 4;
+const int kCurrentVersion = 5;
 const int kCompatibleVersion = 2;
 
 const char kHostQuotaTable[] = "HostQuotaTable";
 const char kOriginInfoTable[] = "OriginInfoTable";
+const char kOriginUsageTable[] = "OriginUsageTable";
 const char kIsOriginTableBootstrapped[] = "IsOriginTableBootstrapped";
 
 bool VerifyValidQuotaConfig(const char* key) {
@@ -58,6 +59,12 @@ const QuotaDatabase::TableSchema QuotaDatabase::kTables[] = {
     " last_access_time INTEGER DEFAULT 0,"
     " last_modified_time INTEGER DEFAULT 0,"
     " UNIQUE(origin, type))" },
+  { kOriginUsageTable,
+    "(origin TEXT NOT NULL,"
+    " type INTEGER NOT NULL,"
+    " client_id INTEGER NOT NULL,"
+    " usage INTEGER DEFAULT 0,"
+    " UNIQUE(origin, type, client_id))" },
 };
 
 // static
@@ -121,6 +128,23 @@ QuotaDatabase::OriginInfoTableEntry::OriginInfoTableEntry(
       last_modified_time(last_modified_time) {
 }
 
+QuotaDatabase::OriginUsageTableEntry::OriginUsageTableEntry()
+    : type(kStorageTypeUnknown),
+      client_id(0),
+      usage(0) {
+}
+
+QuotaDatabase::OriginUsageTableEntry::OriginUsageTableEntry(
+    const GURL& origin,
+    StorageType type,
+    int client_id,
+    int64 usage)
+    : origin(origin),
+      type(type),
+      client_id(client_id),
+      usage(usage) {
+}
+
 // QuotaDatabase ------------------------------------------------------------
 QuotaDatabase::QuotaDatabase(const base::FilePath& path)
     : db_file_path_(path),
@@ -571,6 +595,16 @@ bool QuotaDatabase::ResetSchema() {
 }
 
 bool QuotaDatabase::UpgradeSchema(int current_version) {
+  if (current_version == 4) {
+    // Version 5 only adds OriginUsageTable.
+    std::string sql("CREATE TABLE ");
+    sql += kOriginUsageTable;
+    sql += kTables[ARRAYSIZE_UNSAFE(kTables) - 1].columns;
+    if (!db_->Execute(sql.c_str()))
+      return false;
+    meta_table_->SetVersionNumber(kCurrentVersion);
+    return true;
+  }
   if (current_version == 2) {
     QuotaTableImporter importer;
     typedef std::vector<QuotaTableEntry> QuotaTableEntries;
@@ -590,6 +624,57 @@ bool QuotaDatabase::UpgradeSchema(int current_version) {
   return false;
 }
 
+bool QuotaDatabase::GetOriginUsageEntries(OriginUsageTableEntries* entries) {
+  DCHECK(entries);
+  if (!LazyOpen(false))
+    return false;
+
+  const char* kSql =
+      "SELECT origin, type, client_id, usage FROM OriginUsageTable";
+  sql::Statement statement(db_->GetCachedStatement(SQL_FROM_HERE, kSql));
+
+  while (statement.Step()) {
+    entries->push_back(OriginUsageTableEntry(
+        GURL(statement.ColumnString(0)),
+        static_cast<StorageType>(statement.ColumnInt(1)),
+        statement.ColumnInt(2),
+        statement.ColumnInt64(3)));
+  }
+  return statement.Succeeded();
+}
+
+bool QuotaDatabase::SetOriginUsageEntries(
+    const OriginUsageTableEntries& entries) {
+  if (!LazyOpen(true))
+    return false;
+
+  const char* kDeleteSql = "DELETE FROM OriginUsageTable";
+  sql::Statement delete_statement(
+      db_->GetCachedStatement(SQL_FROM_HERE, kDeleteSql));
+  if (!delete_statement.Run())
+    return false;
+
+  const char* kInsertSql =
+      "INSERT INTO OriginUsageTable"
+      " (origin, type, client_id, usage)"
+      " VALUES (?, ?, ?, ?)";
+  for (OriginUsageTableEntries::const_iterator iter = entries.begin();
+       iter != entries.end(); ++iter) {
+    sql::Statement statement(
+        db_->GetCachedStatement(SQL_FROM_HERE, kInsertSql));
+    statement.BindString(0, iter->origin.spec());
+    statement.BindInt(1, static_cast<int>(iter->type));
+    statement.BindInt(2, iter->client_id);
+    statement.BindInt64(3, iter->usage);
+    if (!statement.Run())
+      return false;
+  }
+
+  // Committed with the rest of the long-running transaction.
+  ScheduleCommit();
+  return true;
+}
+
 bool QuotaDatabase::DumpQuotaTable(const QuotaTableCallback& callback) {
   if (!LazyOpen(true))
     return false;
@@ -7,6 +7,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "base/basictypes.h"
 #include "base/callback.h"
@@ -37,6 +38,20 @@ class WEBKIT_STORAGE_BROWSER_EXPORT_PRIVATE QuotaDatabase {
   static const char kDesiredAvailableSpaceKey[];
   static const char kTemporaryQuotaOverrideKey[];
 
+  // The usage a quota client last reported for an origin.
+  struct WEBKIT_STORAGE_BROWSER_EXPORT_PRIVATE OriginUsageTableEntry {
+    OriginUsageTableEntry();
+    OriginUsageTableEntry(const GURL& origin,
+                          StorageType type,
+                          int client_id,
+                          int64 usage);
+    GURL origin;
+    StorageType type;
+    int client_id;
+    int64 usage;
+  };
+  typedef std::vector<OriginUsageTableEntry> OriginUsageTableEntries;
+
   // If 'path' is empty, an in memory database will be used.
   explicit QuotaDatabase(const base::FilePath& path);
   ~QuotaDatabase();
@@ -87,6 +102,10 @@ class WEBKIT_STORAGE_BROWSER_EXPORT_PRIVATE QuotaDatabase {
   bool IsOriginDatabaseBootstrapped();
   bool SetOriginDatabaseBootstrapped(bool bootstrap_flag);
 
+  // Reads all the saved origin usage, or replaces it with |entries|.
+  bool GetOriginUsageEntries(OriginUsageTableEntries* entries);
+  bool SetOriginUsageEntries(const OriginUsageTableEntries& entries);
+
  private:
   struct WEBKIT_STORAGE_BROWSER_EXPORT_PRIVATE QuotaTableEntry {
     QuotaTableEntry();
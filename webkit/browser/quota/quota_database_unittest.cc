@@ -18,6 +18,7 @@
 #include "testing/gtest/include/gtest/gtest.h"
 #include "url/gurl.h"
 #include "webkit/browser/quota/mock_special_storage_policy.h"
+#include "webkit/browser/quota/quota_client.h"
 #include "webkit/browser/quota/quota_database.h"
 
 namespace quota {
@@ -311,6 +312,50 @@ class QuotaDatabaseTest : public testing::Test {
     EXPECT_EQ(1, used_count);
   }
 
+  void OriginUsage(const base::FilePath& kDbFile) {
+    typedef QuotaDatabase::OriginUsageTableEntry Entry;
+    QuotaDatabase db(kDbFile);
+
+    QuotaDatabase::OriginUsageTableEntries entries;
+    EXPECT_FALSE(db.GetOriginUsageEntries(&entries));
+
+    entries.push_back(Entry(GURL("http://a/"), kStorageTypeTemporary,
+                            QuotaClient::kFileSystem, 10));
+    entries.push_back(Entry(GURL("http://a/"), kStorageTypeTemporary,
+                            QuotaClient::kIndexedDatabase, 20));
+    entries.push_back(Entry(GURL("http://b/"), kStorageTypePersistent,
+                            QuotaClient::kFileSystem, 30));
+    EXPECT_TRUE(db.SetOriginUsageEntries(entries));
+
+    QuotaDatabase::OriginUsageTableEntries saved_entries;
+    EXPECT_TRUE(db.GetOriginUsageEntries(&saved_entries));
+    ASSERT_EQ(3U, saved_entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+      bool found = false;
+      for (size_t j = 0; j < saved_entries.size(); ++j) {
+        if (saved_entries[j].origin == entries[i].origin &&
+            saved_entries[j].type == entries[i].type &&
+            saved_entries[j].client_id == entries[i].client_id) {
+          EXPECT_EQ(entries[i].usage, saved_entries[j].usage);
+          found = true;
+        }
+      }
+      EXPECT_TRUE(found);
+    }
+
+    // Setting the entries again replaces them all.
+    entries.erase(entries.begin());
+    entries[0].usage = 40;
+    EXPECT_TRUE(db.SetOriginUsageEntries(entries));
+    saved_entries.clear();
+    EXPECT_TRUE(db.GetOriginUsageEntries(&saved_entries));
+    ASSERT_EQ(2U, saved_entries.size());
+    for (size_t i = 0; i < saved_entries.size(); ++i) {
+      if (saved_entries[i].client_id == QuotaClient::kIndexedDatabase)
+        EXPECT_EQ(40, saved_entries[i].usage);
+    }
+  }
+
   template <typename EntryType>
   struct EntryVerifier {
     std::set<EntryType> table;
@@ -545,6 +590,14 @@ TEST_F(QuotaDatabaseTest, RegisterInitialOriginInfo) {
   RegisterInitialOriginInfo(base::FilePath());
 }
 
+TEST_F(QuotaDatabaseTest, OriginUsage) {
+  base::ScopedTempDir data_dir;
+  ASSERT_TRUE(data_dir.CreateUniqueTempDir());
+  const base::FilePath kDbFile = data_dir.path().AppendASCII(kDBFileName);
+  OriginUsage(kDbFile);
+  OriginUsage(base::FilePath());
+}
+
 TEST_F(QuotaDatabaseTest, DumpQuotaTable) {
   base::ScopedTempDir data_dir;
   ASSERT_TRUE(data_dir.CreateUniqueTempDir());
@@ -42,6 +42,8 @@ const int64 kMBytes = 1024 * 1024;
 const int kMinutesInMilliSeconds = 60 * 1000;
 
 const int64 kReportHistogramInterval = 60 * 60 * 1000;  // 1 hour
+const int64 kSaveUsageCacheInterval = 5 * kMinutesInMilliSeconds;
+const int64 kReconcileUsageCacheInterval = 6 * 60 * kMinutesInMilliSeconds;
 const double kTemporaryQuotaRatioToAvail = 1.0 / 3.0;  // 33%
 
 }  // namespace
@@ -133,15 +135,24 @@ bool SetPersistentHostQuotaOnDBThread(const std::string& host,
 
 bool InitializeOnDBThread(int64* temporary_quota_override,
                           int64* desired_available_space,
+                          QuotaDatabase::OriginUsageTableEntries* usage_entries,
                           QuotaDatabase* database) {
   DCHECK(database);
   database->GetQuotaConfigValue(QuotaDatabase::kTemporaryQuotaOverrideKey,
                                 temporary_quota_override);
   database->GetQuotaConfigValue(QuotaDatabase::kDesiredAvailableSpaceKey,
                                 desired_available_space);
+  database->GetOriginUsageEntries(usage_entries);
   return true;
 }
 
+bool SetOriginUsageEntriesOnDBThread(
+    const QuotaDatabase::OriginUsageTableEntries* entries,
+    QuotaDatabase* database) {
+  DCHECK(database);
+  return database->SetOriginUsageEntries(*entries);
+}
+
 bool GetLRUOriginOnDBThread(StorageType type,
                             std::set<GURL>* exceptions,
                             SpecialStoragePolicy* policy,
@@ -1177,6 +1188,15 @@ bool QuotaManager::ResetUsageTracker(StorageType type) {
 
 QuotaManager::~QuotaManager() {
   proxy_->manager_ = NULL;
+  if (database_ && temporary_quota_initialized_ && !db_disabled_ &&
+      !is_incognito_) {
+    // Save the usage caches one last time before the database goes away.
+    db_thread_->PostTask(
+        FROM_HERE,
+        base::Bind(base::IgnoreResult(&SetOriginUsageEntriesOnDBThread),
+                   base::Owned(GetCachedUsageEntries().release()),
+                   base::Unretained(database_.get())));
+  }
   std::for_each(clients_.begin(), clients_.end(),
                 std::mem_fun(&QuotaClient::OnQuotaManagerDestroyed));
   if (database_)
@@ -1210,15 +1230,19 @@ void QuotaManager::LazyInitialize() {
 
   int64* temporary_quota_override = new int64(-1);
   int64* desired_available_space = new int64(-1);
+  QuotaDatabase::OriginUsageTableEntries* usage_entries =
+      new QuotaDatabase::OriginUsageTableEntries;
   PostTaskAndReplyWithResultForDBThread(
       FROM_HERE,
       base::Bind(&InitializeOnDBThread,
                  base::Unretained(temporary_quota_override),
-                 base::Unretained(desired_available_space)),
+                 base::Unretained(desired_available_space),
+                 base::Unretained(usage_entries)),
       base::Bind(&QuotaManager::DidInitialize,
                  weak_factory_.GetWeakPtr(),
                  base::Owned(temporary_quota_override),
-                 base::Owned(desired_available_space)));
+                 base::Owned(desired_available_space),
+                 base::Owned(usage_entries)));
 }
 
 void QuotaManager::RegisterClient(QuotaClient* client) {
@@ -1349,6 +1373,85 @@ void QuotaManager::DidOriginDataEvicted(QuotaStatusCode status) {
   eviction_context_.evict_origin_data_callback.Reset();
 }
 
+void QuotaManager::SeedUsageCaches(
+    const QuotaDatabase::OriginUsageTableEntries& entries) {
+  typedef std::map<std::pair<StorageType, int>, std::map<GURL, int64> >
+      UsageByClient;
+  UsageByClient usage_by_client;
+  for (QuotaDatabase::OriginUsageTableEntries::const_iterator iter =
+           entries.begin();
+       iter != entries.end(); ++iter) {
+    usage_by_client[std::make_pair(iter->type, iter->client_id)]
+        [iter->origin] = iter->usage;
+  }
+
+  for (UsageByClient::const_iterator iter = usage_by_client.begin();
+       iter != usage_by_client.end(); ++iter) {
+    StorageType type = iter->first.first;
+    if (type != kStorageTypeTemporary && type != kStorageTypePersistent &&
+        type != kStorageTypeSyncable)
+      continue;
+    ClientUsageTracker* client_tracker = GetUsageTracker(type)->
+        GetClientTracker(static_cast<QuotaClient::ID>(iter->first.second));
+    if (client_tracker)
+      client_tracker->SeedUsageCache(iter->second);
+  }
+}
+
+scoped_ptr<QuotaDatabase::OriginUsageTableEntries>
+QuotaManager::GetCachedUsageEntries() {
+  scoped_ptr<QuotaDatabase::OriginUsageTableEntries> entries(
+      new QuotaDatabase::OriginUsageTableEntries);
+  const StorageType kTypes[] = {
+    kStorageTypeTemporary, kStorageTypePersistent, kStorageTypeSyncable,
+  };
+  for (size_t i = 0; i < arraysize(kTypes); ++i) {
+    for (QuotaClientList::const_iterator iter = clients_.begin();
+         iter != clients_.end(); ++iter) {
+      ClientUsageTracker* client_tracker =
+          GetUsageTracker(kTypes[i])->GetClientTracker((*iter)->id());
+      if (!client_tracker)
+        continue;
+      std::map<GURL, int64> usage_by_origin;
+      client_tracker->GetCachedUsageByOrigin(&usage_by_origin);
+      for (std::map<GURL, int64>::const_iterator usage_iter =
+               usage_by_origin.begin();
+           usage_iter != usage_by_origin.end(); ++usage_iter) {
+        entries->push_back(QuotaDatabase::OriginUsageTableEntry(
+            usage_iter->first, kTypes[i], (*iter)->id(),
+            usage_iter->second));
+      }
+    }
+  }
+  return entries.Pass();
+}
+
+void QuotaManager::SaveUsageCaches() {
+  if (db_disabled_)
+    return;
+  PostTaskAndReplyWithResultForDBThread(
+      FROM_HERE,
+      base::Bind(&SetOriginUsageEntriesOnDBThread,
+                 base::Owned(GetCachedUsageEntries().release())),
+      base::Bind(&QuotaManager::DidDatabaseWork,
+                 weak_factory_.GetWeakPtr()));
+}
+
+void QuotaManager::ReconcileUsageCaches() {
+  const StorageType kTypes[] = {
+    kStorageTypeTemporary, kStorageTypePersistent, kStorageTypeSyncable,
+  };
+  for (size_t i = 0; i < arraysize(kTypes); ++i) {
+    for (QuotaClientList::const_iterator iter = clients_.begin();
+         iter != clients_.end(); ++iter) {
+      ClientUsageTracker* client_tracker =
+          GetUsageTracker(kTypes[i])->GetClientTracker((*iter)->id());
+      if (client_tracker)
+        client_tracker->ReconcileUsageCache();
+    }
+  }
+}
+
 void QuotaManager::ReportHistogram() {
   GetGlobalUsage(kStorageTypeTemporary,
                  base::Bind(
@@ -1511,18 +1614,32 @@ void QuotaManager::DidSetPersistentHostQuota(const std::string& host,
   callback.Run(success ? kQuotaStatusOk : kQuotaErrorInvalidAccess, *new_quota);
 }
 
-void QuotaManager::DidInitialize(int64* temporary_quota_override,
-                                 int64* desired_available_space,
-                                 bool success) {
+void QuotaManager::DidInitialize(
+    int64* temporary_quota_override,
+    int64* desired_available_space,
+    QuotaDatabase::OriginUsageTableEntries* usage_entries,
+    bool success) {
   temporary_quota_override_ = *temporary_quota_override;
   desired_available_space_ = *desired_available_space;
   temporary_quota_initialized_ = true;
   DidDatabaseWork(success);
+  SeedUsageCaches(*usage_entries);
 
   histogram_timer_.Start(FROM_HERE,
                          base::TimeDelta::FromMilliseconds(
                              kReportHistogramInterval),
                          this, &QuotaManager::ReportHistogram);
+  if (!is_incognito_) {
+    usage_cache_save_timer_.Start(FROM_HERE,
+                                  base::TimeDelta::FromMilliseconds(
+                                      kSaveUsageCacheInterval),
+                                  this, &QuotaManager::SaveUsageCaches);
+  }
+  usage_cache_reconcile_timer_.Start(FROM_HERE,
+                                     base::TimeDelta::FromMilliseconds(
+                                         kReconcileUsageCacheInterval),
+                                     this,
+                                     &QuotaManager::ReconcileUsageCaches);
 
   db_initialization_callbacks_.Run(MakeTuple());
   GetTemporaryGlobalQuota(
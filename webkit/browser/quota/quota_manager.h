@@ -332,6 +332,14 @@ class WEBKIT_STORAGE_BROWSER_EXPORT QuotaManager
 
   void DidOriginDataEvicted(QuotaStatusCode status);
 
+  // The usage caches of the trackers are saved to the database from time to
+  // time, so that the next session starts with them instead of asking the
+  // clients, and reconciled with the clients less often.
+  void SeedUsageCaches(const QuotaDatabase::OriginUsageTableEntries& entries);
+  scoped_ptr<QuotaDatabase::OriginUsageTableEntries> GetCachedUsageEntries();
+  void SaveUsageCaches();
+  void ReconcileUsageCaches();
+
   void ReportHistogram();
   void DidGetTemporaryGlobalUsageForHistogram(int64 usage,
                                               int64 unlimited_usage);
@@ -361,6 +369,7 @@ class WEBKIT_STORAGE_BROWSER_EXPORT QuotaManager
                                  bool success);
   void DidInitialize(int64* temporary_quota_override,
                      int64* desired_available_space,
+                     QuotaDatabase::OriginUsageTableEntries* usage_entries,
                      bool success);
   void DidGetLRUOrigin(const GURL* origin,
                        bool success);
@@ -419,6 +428,8 @@ class WEBKIT_STORAGE_BROWSER_EXPORT QuotaManager
   scoped_refptr<SpecialStoragePolicy> special_storage_policy_;
 
   base::RepeatingTimer<QuotaManager> histogram_timer_;
+  base::RepeatingTimer<QuotaManager> usage_cache_save_timer_;
+  base::RepeatingTimer<QuotaManager> usage_cache_reconcile_timer_;
 
   // Pointer to the function used to get the available disk space. This is
   // overwritten by QuotaManagerTest in order to attain a deterministic reported
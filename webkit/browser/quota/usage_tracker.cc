@@ -431,6 +431,52 @@ void ClientUsageTracker::SetUsageCacheEnabled(const GURL& origin,
   }
 }
 
+void ClientUsageTracker::SeedUsageCache(
+    const std::map<GURL, int64>& usage_by_origin) {
+  HostUsageMap usage_by_host;
+  for (std::map<GURL, int64>::const_iterator iter = usage_by_origin.begin();
+       iter != usage_by_origin.end(); ++iter) {
+    usage_by_host[net::GetHostOrSpecFromURL(iter->first)][iter->first] =
+        iter->second;
+  }
+
+  for (HostUsageMap::const_iterator host_iter = usage_by_host.begin();
+       host_iter != usage_by_host.end(); ++host_iter) {
+    const std::string& host = host_iter->first;
+    if (ContainsKey(cached_hosts_, host) ||
+        host_usage_accumulators_.HasCallbacks(host))
+      continue;
+    for (UsageMap::const_iterator origin_iter = host_iter->second.begin();
+         origin_iter != host_iter->second.end(); ++origin_iter) {
+      if (IsUsageCacheEnabledForOrigin(origin_iter->first)) {
+        AddCachedOrigin(origin_iter->first,
+                        std::max<int64>(origin_iter->second, 0));
+      }
+    }
+    AddCachedHost(host);
+  }
+}
+
+void ClientUsageTracker::GetCachedUsageByOrigin(
+    std::map<GURL, int64>* usage_by_origin) const {
+  DCHECK(usage_by_origin);
+  for (HostUsageMap::const_iterator host_iter = cached_usage_by_host_.begin();
+       host_iter != cached_usage_by_host_.end(); ++host_iter) {
+    if (!ContainsKey(cached_hosts_, host_iter->first))
+      continue;
+    usage_by_origin->insert(host_iter->second.begin(),
+                            host_iter->second.end());
+  }
+}
+
+void ClientUsageTracker::ReconcileUsageCache() {
+  for (HostSet::const_iterator iter = cached_hosts_.begin();
+       iter != cached_hosts_.end(); ++iter) {
+    client_->GetOriginsForHost(type_, *iter, base::Bind(
+        &ClientUsageTracker::DidGetOriginsForReconcile, AsWeakPtr(), *iter));
+  }
+}
+
 void ClientUsageTracker::AccumulateLimitedOriginUsage(
     AccumulateInfo* info,
     const UsageCallback& callback,
@@ -549,6 +595,44 @@ void ClientUsageTracker::AccumulateOriginUsage(AccumulateInfo* info,
       host, MakeTuple(info->limited_usage, info->unlimited_usage));
 }
 
+void ClientUsageTracker::DidGetOriginsForReconcile(
+    const std::string& host,
+    const std::set<GURL>& origins) {
+  if (!ContainsKey(cached_hosts_, host))
+    return;
+
+  // Origins the client doesn't have anymore use nothing.
+  HostUsageMap::const_iterator found = cached_usage_by_host_.find(host);
+  if (found != cached_usage_by_host_.end()) {
+    std::vector<GURL> removed_origins;
+    for (UsageMap::const_iterator iter = found->second.begin();
+         iter != found->second.end(); ++iter) {
+      if (!ContainsKey(origins, iter->first))
+        removed_origins.push_back(iter->first);
+    }
+    for (size_t i = 0; i < removed_origins.size(); ++i)
+      AddCachedOrigin(removed_origins[i], 0);
+  }
+
+  for (std::set<GURL>::const_iterator iter = origins.begin();
+       iter != origins.end(); ++iter) {
+    if (!IsUsageCacheEnabledForOrigin(*iter))
+      continue;
+    client_->GetOriginUsage(*iter, type_, base::Bind(
+        &ClientUsageTracker::DidGetOriginUsageForReconcile, AsWeakPtr(),
+        *iter));
+  }
+}
+
+void ClientUsageTracker::DidGetOriginUsageForReconcile(const GURL& origin,
+                                                       int64 usage) {
+  // The host may have been dropped from the cache meanwhile.
+  if (!ContainsKey(cached_hosts_, net::GetHostOrSpecFromURL(origin)) ||
+      !IsUsageCacheEnabledForOrigin(origin))
+    return;
+  AddCachedOrigin(origin, std::max<int64>(usage, 0));
+}
+
 void ClientUsageTracker::AddCachedOrigin(
     const GURL& origin, int64 new_usage) {
   DCHECK(IsUsageCacheEnabledForOrigin(origin));
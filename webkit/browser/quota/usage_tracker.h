@@ -115,6 +115,17 @@ class ClientUsageTracker : public SpecialStoragePolicy::Observer,
   bool IsUsageCacheEnabledForOrigin(const GURL& origin) const;
   void SetUsageCacheEnabled(const GURL& origin, bool enabled);
 
+  // Seeds the cache with the usage saved by an earlier session, for the
+  // hosts that aren't cached or being looked up yet.  The saved usage of a
+  // host is complete, as only cached hosts are saved.
+  void SeedUsageCache(const std::map<GURL, int64>& usage_by_origin);
+  void GetCachedUsageByOrigin(std::map<GURL, int64>* usage_by_origin) const;
+
+  // Asks the client again for the origins and usage of the cached hosts and
+  // corrects the cache, in case the saved usage was stale or the client
+  // changed its data without notifying the quota manager.
+  void ReconcileUsageCache();
+
  private:
   typedef CallbackQueueMap<HostUsageAccumulator, std::string,
                            Tuple2<int64, int64> > HostUsageAccumulatorMap;
@@ -152,6 +163,10 @@ class ClientUsageTracker : public SpecialStoragePolicy::Observer,
                              const GURL& origin,
                              int64 usage);
 
+  void DidGetOriginsForReconcile(const std::string& host,
+                                 const std::set<GURL>& origins);
+  void DidGetOriginUsageForReconcile(const GURL& origin, int64 usage);
+
   // Methods used by our GatherUsage tasks, as a task makes progress
   // origins and hosts are added incrementally to the cache.
   void AddCachedOrigin(const GURL& origin, int64 usage);
@@ -188,6 +188,15 @@ class UsageTrackerTest : public testing::Test {
         quota_client_.id(), origin, enabled);
   }
 
+  ClientUsageTracker* client_tracker() {
+    return usage_tracker_.GetClientTracker(quota_client_.id());
+  }
+
+  void ReconcileUsageCache() {
+    client_tracker()->ReconcileUsageCache();
+    base::RunLoop().RunUntilIdle();
+  }
+
  private:
   QuotaClientList GetUsageTrackerList() {
     QuotaClientList client_list;
@@ -287,6 +296,50 @@ TEST_F(UsageTrackerTest, CacheDisabledClientTest) {
   EXPECT_EQ(500, host_usage);
 }
 
+TEST_F(UsageTrackerTest, SeedAndReconcileUsageCache) {
+  const GURL origin1("http://example.com");
+  const GURL origin2("http://example.com:8080");
+  const std::string host(net::GetHostOrSpecFromURL(origin1));
+  UpdateUsageWithoutNotification(origin1, 100);
+  UpdateUsageWithoutNotification(origin2, 200);
+
+  // The saved usage is used without asking the client.
+  std::map<GURL, int64> saved_usage;
+  saved_usage[origin1] = 10;
+  saved_usage[origin2] = 20;
+  client_tracker()->SeedUsageCache(saved_usage);
+  int64 host_usage = 0;
+  GetHostUsage(host, &host_usage);
+  EXPECT_EQ(30, host_usage);
+
+  std::map<GURL, int64> cached_usage;
+  client_tracker()->GetCachedUsageByOrigin(&cached_usage);
+  EXPECT_EQ(saved_usage, cached_usage);
+
+  // Hosts which are already cached aren't seeded again.
+  saved_usage[origin1] = 1000;
+  client_tracker()->SeedUsageCache(saved_usage);
+  GetHostUsage(host, &host_usage);
+  EXPECT_EQ(30, host_usage);
+
+  // Reconciling picks up what the client really has.
+  ReconcileUsageCache();
+  GetHostUsage(host, &host_usage);
+  EXPECT_EQ(300, host_usage);
+  int64 usage = 0;
+  int64 unlimited_usage = 0;
+  GetGlobalUsage(&usage, &unlimited_usage);
+  EXPECT_EQ(300, usage);
+
+  // Data the client lost is dropped as well.
+  UpdateUsageWithoutNotification(origin2, -200);
+  ReconcileUsageCache();
+  GetHostUsage(host, &host_usage);
+  EXPECT_EQ(100, host_usage);
+  GetGlobalUsage(&usage, &unlimited_usage);
+  EXPECT_EQ(100, usage);
+}
+
 TEST_F(UsageTrackerTest, LimitedGlobalUsageTest) {
   const GURL kNormal("http://normal");
   const GURL kUnlimited("http://unlimited");